@@ -0,0 +1,94 @@
+/**
+ * Tests the $approxCountDistinct and $percentile accumulators, which estimate distinct counts and
+ * quantiles with sketches of bounded size, including when their partial states are merged across
+ * shards.
+ *
+ * @tags: [
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For assertErrorCode.
+
+const coll = db.approximate_accumulators;
+coll.drop();
+
+const kNumDocs = 10000;
+const docs = [];
+for (let i = 0; i < kNumDocs; ++i) {
+    docs.push({_id: i, group: i % 2, word: "w" + (i % 500), maybeNumber: i % 3 ? i : "x"});
+}
+assert.commandWorked(coll.insert(docs));
+
+function assertClose(expected, actual, tolerance, result) {
+    assert.lte(Math.abs(actual - expected), tolerance, result);
+}
+
+const results = coll.aggregate([
+                        {
+                            $group: {
+                                _id: "$group",
+                                distinctWords: {$approxCountDistinct: "$word"},
+                                distinctIds: {$approxCountDistinct: "$_id"},
+                                percentiles: {
+                                    $percentile: {
+                                        input: "$_id",
+                                        p: [0, 0.5, 0.99, 1],
+                                        method: "approximate",
+                                    }
+                                },
+                                numericPercentiles: {
+                                    $percentile: {
+                                        input: "$maybeNumber",
+                                        p: [0.5],
+                                        method: "approximate",
+                                    }
+                                },
+                            }
+                        },
+                        {$sort: {_id: 1}}
+                    ])
+                    .toArray();
+assert.eq(2, results.length, results);
+
+for (const result of results) {
+    // Each group holds 250 of the words and half of the ids.
+    assertClose(250, result.distinctWords, 250 * 0.05, result);
+    assertClose(kNumDocs / 2, result.distinctIds, kNumDocs * 0.05, result);
+
+    const [min, median, p99, max] = result.percentiles;
+    assert.eq(result._id, min, result);
+    assert.eq(kNumDocs - 2 + result._id, max, result);
+    assertClose(kNumDocs / 2, median, kNumDocs * 0.01, result);
+    assertClose(kNumDocs * 0.99, p99, kNumDocs * 0.01, result);
+
+    // Non-numeric values are ignored.
+    assert.eq(1, result.numericPercentiles.length, result);
+    assertClose(kNumDocs / 2, result.numericPercentiles[0], kNumDocs * 0.01, result);
+}
+
+// A group without numeric values has no percentiles.
+assert.eq([{_id: null, p: null}],
+          coll.aggregate([
+                  {$match: {maybeNumber: "x"}},
+                  {
+                      $group: {
+                          _id: null,
+                          p: {$percentile: {input: "$maybeNumber", p: [0.5], method: "approximate"}}
+                      }
+                  }
+              ])
+              .toArray());
+
+// Invalid specifications of $percentile are rejected.
+function assertPercentileError(spec, code) {
+    assertErrorCode(coll, [{$group: {_id: null, p: {$percentile: spec}}}], code);
+}
+assertPercentileError("$value", 5843109);
+assertPercentileError({input: "$value", p: 0.5, method: "approximate"}, 5843110);
+assertPercentileError({input: "$value", p: [2], method: "approximate"}, 5843111);
+assertPercentileError({input: "$value", p: [0.5], method: "exact"}, 5843112);
+assertPercentileError({input: "$value", p: [0.5]}, 5843116);
+}());
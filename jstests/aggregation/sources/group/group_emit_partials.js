@@ -0,0 +1,104 @@
+/**
+ * Tests that a $group with '$emitPartials' outputs partial accumulator states which a later
+ * '$doingMerge' $group can combine, which allows maintaining a rollup collection incrementally.
+ *
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   do_not_wrap_aggregations_in_facets,
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+
+const events = db.group_emit_partials_events;
+const rollup = db.group_emit_partials_rollup;
+events.drop();
+rollup.drop();
+
+const accumulators = {
+    total: {$sum: "$amount"},
+    avg: {$avg: "$amount"},
+    lo: {$min: "$amount"},
+    spread: {$stdDevPop: "$amount"},
+    tags: {$addToSet: "$tag"}
+};
+
+// Merges the partial accumulator states found in the fields named after each accumulator.
+function mergingGroup(emitPartials) {
+    const spec = {_id: "$_id", $doingMerge: true};
+    for (let field of Object.keys(accumulators)) {
+        const op = Object.keys(accumulators[field])[0];
+        spec[field] = {[op]: "$" + field};
+    }
+    if (emitPartials) {
+        spec.$emitPartials = true;
+    }
+    return {$group: spec};
+}
+
+// Folds the events matching 'filter' into the partial states stored in the rollup collection.
+function rollUp(filter) {
+    const partial = {_id: "$_id"};
+    for (let field of Object.keys(accumulators)) {
+        partial[field] = "$" + field;
+    }
+    events.aggregate([
+        {$match: filter},
+        {$group: Object.assign({_id: "$day", $emitPartials: true}, accumulators)},
+        {$lookup: {from: rollup.getName(), localField: "_id", foreignField: "_id", as: "previous"}},
+        {$project: {partials: {$concatArrays: ["$previous", [partial]]}}},
+        {$unwind: "$partials"},
+        {$replaceRoot: {newRoot: "$partials"}},
+        mergingGroup(true),
+        {$merge: {into: rollup.getName(), whenMatched: "replace"}}
+    ]);
+}
+
+function assertRollupMatchesFullRecomputation() {
+    const expected =
+        events.aggregate([{$group: Object.assign({_id: "$day"}, accumulators)}]).toArray();
+    const actual = rollup.aggregate([mergingGroup(false)]).toArray();
+    assert.eq(expected.length, actual.length, tojson({expected, actual}));
+    for (let expectedDoc of expected) {
+        const actualDoc = actual.find((doc) => doc._id === expectedDoc._id);
+        assert.neq(undefined, actualDoc, tojson({expectedDoc, actual}));
+        assert.eq(expectedDoc.total, actualDoc.total);
+        assert.close(expectedDoc.avg, actualDoc.avg);
+        assert.eq(expectedDoc.lo, actualDoc.lo);
+        assert.close(expectedDoc.spread, actualDoc.spread);
+        assert(arrayEq(expectedDoc.tags, actualDoc.tags), tojson({expectedDoc, actualDoc}));
+    }
+}
+
+let batch = 0;
+function insertBatch() {
+    const docs = [];
+    for (let i = 0; i < 30; ++i) {
+        docs.push({batch, day: i % 3, amount: (i * 7 + batch * 13) % 17, tag: "t" + (i % 5)});
+    }
+    assert.commandWorked(events.insert(docs));
+    return batch++;
+}
+
+// Each run only reads the new events and the rollup documents of the days they touch.
+rollUp({batch: insertBatch()});
+assertRollupMatchesFullRecomputation();
+
+rollUp({batch: insertBatch()});
+assertRollupMatchesFullRecomputation();
+
+// A batch which touches a new day adds a rollup document for it.
+assert.commandWorked(events.insert({batch, day: 10, amount: 5, tag: "t0"}));
+rollUp({batch: batch++});
+assertRollupMatchesFullRecomputation();
+
+// '$emitPartials' must be true if present.
+assert.commandFailedWithCode(
+    db.runCommand(
+        {aggregate: events.getName(), pipeline: [{$group: {_id: null, $emitPartials: false}}],
+         cursor: {}}),
+    5843105);
+}());
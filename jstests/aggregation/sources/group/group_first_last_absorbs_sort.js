@@ -0,0 +1,85 @@
+/**
+ * Tests that a $sort followed by a $group computing only $first and $last accumulators is folded
+ * into the $group when no index can provide the sort, and that the results are the same as
+ * sorting the input first.
+ *
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   do_not_wrap_aggregations_in_facets,
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+load("jstests/libs/analyze_plan.js");         // For getAggPlanStage.
+
+const coll = db.group_first_last_absorbs_sort;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 200; ++i) {
+    docs.push({
+        key: i % 7,
+        ts: (i * 37) % 50,
+        nested: {ts: (i * 11) % 13},
+        payload: "p" + i,
+        maybe: i % 3 == 0 ? undefined : i
+    });
+}
+docs.push({ts: 1, payload: "noKey"});
+docs.push({key: 0, payload: "noTs"});
+docs.push({key: 1, ts: [5, 100], payload: "arrayTs"});
+assert.commandWorked(coll.insert(docs));
+
+// Runs 'pipeline' with the $sort kept as a separate, blocking stage.
+function resultsWithSeparateSort(pipeline) {
+    const [sort, ...rest] = pipeline;
+    return coll.aggregate([sort, {$_internalInhibitOptimization: {}}, ...rest]).toArray();
+}
+
+function assertSortIsAbsorbed(pipeline) {
+    const explain = coll.explain().aggregate(pipeline);
+    assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
+    const groupStage = getAggPlanStage(explain, "$group");
+    assert.neq(null, groupStage, explain);
+    assert.eq(pipeline[0].$sort, groupStage.$group.$_internalSortBy, explain);
+
+    const expected = resultsWithSeparateSort(pipeline);
+    const results = coll.aggregate(pipeline).toArray();
+    assert(arrayEq(expected, results), tojson({pipeline, expected, results}));
+}
+
+const latestPerKey = {
+    $group: {
+        _id: "$key",
+        latest: {$first: "$payload"},
+        earliest: {$last: "$payload"},
+        latestTs: {$first: "$ts"},
+        maybe: {$first: "$maybe"}
+    }
+};
+assertSortIsAbsorbed([{$sort: {ts: -1, payload: 1}}, latestPerKey]);
+assertSortIsAbsorbed([{$sort: {"nested.ts": 1, ts: -1, payload: -1}}, latestPerKey]);
+assertSortIsAbsorbed([
+    {$sort: {ts: 1, payload: 1}},
+    {$group: {_id: {k: "$key", n: "$nested.ts"}, p: {$last: "$payload"}}}
+]);
+
+// The sort fields are still read from the documents when the $group does not use them.
+assertSortIsAbsorbed(
+    [{$sort: {ts: 1, payload: 1}}, {$group: {_id: "$key", n: {$first: "$nested"}}}]);
+
+// Groups with other accumulators still need the $sort.
+let pipeline = [{$sort: {ts: 1}}, {$group: {_id: "$key", p: {$push: "$payload"}}}];
+let explain = coll.explain().aggregate(pipeline);
+assert.neq(null, getAggPlanStage(explain, "SORT"), explain);
+
+// An index that may provide the sort is preferred over absorbing it.
+assert.commandWorked(coll.createIndex({ts: 1}));
+pipeline = [{$sort: {ts: -1, payload: 1}}, latestPerKey];
+explain = coll.explain().aggregate(pipeline);
+assert.eq(undefined, getAggPlanStage(explain, "$group").$group.$_internalSortBy, explain);
+assert(arrayEq(resultsWithSeparateSort(pipeline), coll.aggregate(pipeline).toArray()));
+}());
@@ -125,4 +125,11 @@ const finalStats =
 replTest.stopSet();
 
 printjson(finalStats);
+
+// Every SCRAM conversation above took at least two server-side SASL steps.
+for (let mech of ['SCRAM-SHA-1', 'SCRAM-SHA-256']) {
+    const mechStats = finalStats[mech];
+    assert.gte(mechStats.saslSteps.count, 2 * mechStats.authenticate.successful, finalStats);
+    assert.gte(mechStats.saslSteps.totalMicros, 0, finalStats);
+}
 })();
@@ -0,0 +1,67 @@
+/**
+ * Tests that dbHash can hash a collection in ranges of documents, and hash only a range of _ids,
+ * so that two collections can be compared piece by piece.
+ * @tags: [
+ *   # dbhash command is not available on embedded
+ *   incompatible_with_embedded,
+ *   assumes_superuser_permissions,
+ *   assumes_unsharded_collection,
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+const a = db.dbhash_ranges_a;
+const b = db.dbhash_ranges_b;
+a.drop();
+b.drop();
+
+const docs = Array.from({length: 500}, (_, i) => ({_id: i, x: "x" + i}));
+assert.commandWorked(a.insert(docs));
+assert.commandWorked(b.insert(docs));
+
+function dbHash(options) {
+    return assert.commandWorked(db.runCommand(
+        Object.assign({dbHash: 1, collections: [a.getName(), b.getName()]}, options)));
+}
+
+// Ranging doesn't change the hash of a collection. The ranges cover every document in _id order.
+const plain = dbHash({});
+let res = dbHash({rangeSize: 20});
+assert.eq(plain.collections, res.collections, res);
+let ranges = res.ranges[a.getName()];
+assert.gt(ranges.length, 1, res);
+assert.eq(500, ranges.reduce((total, range) => total + range.count, 0), res);
+assert.eq(0, ranges[0].min, res);
+for (let i = 1; i < ranges.length; ++i) {
+    assert.lt(ranges[i - 1].min, ranges[i].min, res);
+}
+assert.eq(ranges, res.ranges[b.getName()], res);
+
+// A document missing from one collection only changes the hash of its own range.
+assert.commandWorked(b.remove({_id: 250}));
+res = dbHash({rangeSize: 20});
+const rangesB = res.ranges[b.getName()];
+assert.eq(ranges.length, rangesB.length, res);
+const mismatches = [];
+for (let i = 0; i < ranges.length; ++i) {
+    if (ranges[i].md5 !== rangesB[i].md5) {
+        mismatches.push(i);
+    }
+}
+assert.eq(1, mismatches.length, res);
+const bad = ranges[mismatches[0]];
+assert.lte(bad.min, 250, res);
+
+// Hashing the mismatched range on its own narrows it down further.
+const max = mismatches[0] + 1 < ranges.length ? ranges[mismatches[0] + 1].min : MaxKey;
+res = dbHash({min: bad.min, max: max});
+assert.neq(res.collections[a.getName()], res.collections[b.getName()], res);
+res = dbHash({min: bad.min, max: 250});
+assert.eq(res.collections[a.getName()], res.collections[b.getName()], res);
+res = dbHash({min: 251, max: max});
+assert.eq(res.collections[a.getName()], res.collections[b.getName()], res);
+
+assert.commandFailedWithCode(db.runCommand({dbHash: 1, rangeSize: 0}), ErrorCodes.BadValue);
+})();
@@ -0,0 +1,88 @@
+/**
+ * Tests that a $text query sorted by text score with a limit, for which the TEXT_OR stage scores
+ * only the highest-scoring documents, returns the same documents and scores as one without.
+ * @tags: [
+ *   assumes_read_concern_local,
+ *   assumes_unsharded_collection,
+ *   requires_fcv_49,
+ *   sbe_incompatible,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const coll = db.fts_score_sort_topk;
+coll.drop();
+
+const words = ["apple", "banana", "cherry", "date", "elder", "fig", "grape"];
+const docs = [];
+for (let i = 0; i < 200; ++i) {
+    // Vary which words each document has, how often, and how long it is, so that their scores
+    // differ from one search term to another.
+    const text = [];
+    for (let j = 0; j < words.length; ++j) {
+        for (let k = 0; k < (i * (j + 1)) % 4; ++k) {
+            text.push(words[j]);
+        }
+    }
+    for (let k = 0; k < i % 9; ++k) {
+        text.push("filler" + k);
+    }
+    docs.push({_id: i, t: text.join(" "), n: i % 3});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({t: "text"}));
+
+const searches = [
+    "apple",
+    "apple banana",
+    "cherry date elder fig",
+    "apple grape -banana",
+    "\"apple apple\" cherry",
+    "nosuchword",
+];
+const proj = {score: {$meta: "textScore"}};
+const sort = {score: {$meta: "textScore"}};
+
+for (let search of searches) {
+    const filter = {$text: {$search: search}};
+    const all = coll.find(filter, proj).sort(sort).toArray();
+    const scores = {};
+    for (let doc of all) {
+        scores[doc._id] = doc.score;
+    }
+
+    for (let limit of [1, 5, 20, 500]) {
+        const limited = coll.find(filter, proj).sort(sort).limit(limit).toArray();
+        assert.eq(Math.min(limit, all.length), limited.length, {search, limit});
+
+        // Documents with equal scores may be returned in any order, so compare the scores and
+        // check that every document returned has the score which it has without a limit.
+        assert.eq(all.slice(0, limit).map(doc => doc.score),
+                  limited.map(doc => doc.score),
+                  {search, limit});
+        for (let doc of limited) {
+            assert.eq(scores[doc._id], doc.score, {search, limit, doc});
+        }
+
+        const explain = coll.find(filter, proj).sort(sort).limit(limit).explain();
+        const textOr = getPlanStage(explain.queryPlanner.winningPlan, "TEXT_OR");
+        if (textOr) {
+            assert.eq(limit, textOr.topK, explain);
+        }
+    }
+
+    // A skip is added to the number of documents kept.
+    assert.eq(all.slice(3, 8).map(doc => doc.score),
+              coll.find(filter, proj).sort(sort).skip(3).limit(5).toArray().map(doc => doc.score),
+              search);
+}
+
+// Any other sort, or none, keeps every document.
+const explain = coll.find({$text: {$search: "apple"}}, proj).sort({n: 1}).limit(5).explain();
+const textOr = getPlanStage(explain.queryPlanner.winningPlan, "TEXT_OR");
+assert.neq(null, textOr, explain);
+assert(!textOr.hasOwnProperty("topK"), explain);
+})();
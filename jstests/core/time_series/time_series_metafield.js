@@ -0,0 +1,92 @@
+/**
+ * Tests that the measurements of a time-series collection are bucketed by their metaField value,
+ * that a batch of measurements is inserted into a bucket together, and that queries on the
+ * metaField and time field are answered by filtering buckets before they are unpacked.
+ * @tags: [
+ *     requires_fcv_49,
+ *     requires_find_command,
+ *     requires_getmore,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/core/time_series/libs/time_series.js");
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(db.getMongo())) {
+    jsTestLog("Skipping test because the time-series collection feature flag is disabled");
+    return;
+}
+
+const testDB = db.getSiblingDB(jsTestName());
+assert.commandWorked(testDB.dropDatabase());
+
+const coll = testDB.getCollection('t');
+const bucketsColl = testDB.getCollection('system.buckets.' + coll.getName());
+
+const timeFieldName = 'time';
+const metaFieldName = 'tags';
+assert.commandWorked(testDB.createCollection(
+    coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+
+// Interleave the measurements of several meta values, including a null and a missing one, which
+// must not share a bucket.
+const start = ISODate("2021-01-01T00:00:00Z");
+const metaValues = [{host: 'a'}, {host: 'b'}, null, undefined];
+const numDocs = 100;
+const docs = [];
+for (let i = 0; i < numDocs; i++) {
+    const doc = {_id: i, [timeFieldName]: new Date(start.getTime() + i * 1000), x: i};
+    const meta = metaValues[i % metaValues.length];
+    if (meta !== undefined) {
+        doc[metaFieldName] = meta;
+    }
+    docs.push(doc);
+}
+
+// The first half is inserted ordered and the second unordered. Either way, each meta value ends up
+// in a single bucket.
+assert.commandWorked(coll.insert(docs.slice(0, numDocs / 2), {ordered: true}));
+assert.commandWorked(coll.insert(docs.slice(numDocs / 2), {ordered: false}));
+
+const bucketDocs = bucketsColl.find().toArray();
+assert.eq(metaValues.length, bucketDocs.length, bucketDocs);
+for (const bucketDoc of bucketDocs) {
+    assert.eq(numDocs / metaValues.length, bucketDoc.control.count, bucketDoc);
+    assert(!bucketDoc.data.hasOwnProperty(metaFieldName), bucketDoc);
+    assert(!bucketDoc.control.min.hasOwnProperty(metaFieldName), bucketDoc);
+
+    // The bucket holds its measurements in insertion order.
+    const ids = Object.keys(bucketDoc.data._id).map((key) => bucketDoc.data._id[key]);
+    assert.eq(ids.slice().sort((a, b) => a - b), ids, bucketDoc);
+}
+assert.eq(1, bucketsColl.find({meta: {host: 'a'}}).itcount());
+assert.eq(1, bucketsColl.find({meta: {$type: 'null'}}).itcount());
+assert.eq(1, bucketsColl.find({meta: {$exists: false}}).itcount());
+
+// The view returns the measurements as they were inserted.
+assert.docEq(docs, coll.find().sort({_id: 1}).toArray());
+
+// Predicates on the metaField apply to the buckets' 'meta' field, and predicates on the time field
+// to the buckets' bounds, so that only the buckets which can hold a match are unpacked.
+const lower = new Date(start.getTime() + 10 * 1000);
+const upper = new Date(start.getTime() + 20 * 1000);
+const filter = {
+    [metaFieldName + '.host']: 'b',
+    [timeFieldName]: {$gte: lower, $lt: upper}
+};
+const expected = docs.filter((doc) => doc[metaFieldName] && doc[metaFieldName].host === 'b' &&
+                                 doc[timeFieldName] >= lower && doc[timeFieldName] < upper);
+assert.eq(2, expected.length, expected);
+assert.docEq(expected, coll.find(filter).sort({_id: 1}).toArray());
+
+const explain = tojson(coll.explain().find(filter).finish());
+assert(explain.includes('meta.host'), explain);
+assert(explain.includes('control.max.' + timeFieldName), explain);
+assert(explain.includes('control.min.' + timeFieldName), explain);
+
+// Every measurement must have a date in the time field, and the metaField can't be an array.
+assert.commandFailedWithCode(coll.insert({[timeFieldName]: 1}), 5843128);
+assert.commandFailedWithCode(coll.insert({[timeFieldName]: ISODate(), [metaFieldName]: [1, 2]}),
+                             5843129);
+})();
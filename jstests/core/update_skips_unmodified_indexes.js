@@ -0,0 +1,67 @@
+/**
+ * Tests that an update which modifies the paths of only some of a collection's indexes keeps all of
+ * them consistent with the documents, including partial, wildcard and multikey indexes.
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   requires_fcv_49,
+ *   requires_non_retryable_writes,
+ * ]
+ */
+(function() {
+"use strict";
+
+const coll = db.update_skips_unmodified_indexes;
+coll.drop();
+
+const indexes = [
+    {a: 1},
+    {b: 1, c: 1},
+    {"d.e": 1},
+    {"f.$**": 1},
+];
+for (let keyPattern of indexes) {
+    assert.commandWorked(coll.createIndex(keyPattern));
+}
+assert.commandWorked(coll.createIndex({g: 1}, {partialFilterExpression: {a: {$gte: 50}}}));
+
+const docs = [];
+for (let i = 0; i < 100; ++i) {
+    docs.push({_id: i, a: i, b: i % 3, c: i % 5, d: [{e: i}], f: {x: i}, g: i});
+}
+assert.commandWorked(coll.insert(docs));
+
+// Each update only modifies the paths of some of the indexes.
+const updates = [
+    {filter: {_id: {$lt: 30}}, update: {$inc: {a: 100}}},
+    {filter: {_id: {$gte: 30}}, update: {$set: {c: "c"}}},
+    {filter: {b: 1}, update: {$set: {"d.1.e": "new"}}},
+    {filter: {b: 2}, update: {$set: {"d.0.z": 1, "f.y": 1}}},
+    {filter: {b: 0}, update: {$rename: {g: "h"}}},
+    {filter: {_id: {$gte: 90}}, update: {$set: {a: 0}}},
+    {filter: {}, update: {$set: {unindexed: 1}}},
+];
+for (let {filter, update} of updates) {
+    assert.commandWorked(coll.updateMany(filter, update));
+}
+
+// Every index must return the same documents as a collection scan.
+const queries = [
+    {hint: {a: 1}, filter: {a: {$gte: 0}}},
+    {hint: {a: 1}, filter: {a: {$gte: 100}}},
+    {hint: {b: 1, c: 1}, filter: {b: {$gte: 0}}},
+    {hint: {b: 1, c: 1}, filter: {b: {$gte: 0}, c: "c"}},
+    {hint: {"d.e": 1}, filter: {"d.e": {$gte: 0}}},
+    {hint: {"d.e": 1}, filter: {"d.e": "new"}},
+    {hint: {"d.e": 1}, filter: {"d.e": null}},
+    {hint: {"f.$**": 1}, filter: {"f.y": 1}},
+    {hint: {"f.$**": 1}, filter: {"f.x": {$gte: 0}}},
+    {hint: {g: 1}, filter: {g: {$gte: 0}, a: {$gte: 50}}},
+];
+for (let {hint, filter} of queries) {
+    const expected = coll.find(filter).sort({_id: 1}).hint({$natural: 1}).toArray();
+    assert.eq(expected, coll.find(filter).sort({_id: 1}).hint(hint).toArray(), {hint, filter});
+}
+
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, validateRes);
+})();
@@ -0,0 +1,58 @@
+/**
+ * Tests that updates which modify only some paths of a document keep a wildcard index consistent
+ * with the documents, including when they modify array elements, empty objects and arrays, or
+ * paths excluded from the index.
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   requires_fcv_49,
+ *   requires_non_retryable_writes,
+ * ]
+ */
+(function() {
+"use strict";
+
+const coll = db.wildcard_index_update;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({"$**": 1}, {wildcardProjection: {"a.x": 0}}));
+
+const docs = [];
+for (let i = 0; i < 20; ++i) {
+    docs.push({_id: i, a: {b: i, x: i}, c: [{d: i}, {d: i + 1, e: [i]}], f: {}, g: [], h: i});
+}
+assert.commandWorked(coll.insert(docs));
+
+const updates = [
+    {filter: {_id: {$lt: 5}}, update: {$inc: {"a.b": 100}}},
+    {filter: {_id: {$lt: 10}}, update: {$set: {"a.x": "excluded"}}},
+    {filter: {_id: {$gte: 5}}, update: {$set: {"c.1.d": "new", "f.y": 1}}},
+    {filter: {_id: {$gte: 10}}, update: {$push: {g: {z: 1}}, $unset: {"c.0": 1}}},
+    {filter: {_id: {$gte: 15}}, update: {$pull: {c: {d: {$gte: 15}}}}},
+    {filter: {h: {$lt: 3}}, update: {$set: {"c.5": 1}}},
+    {filter: {h: {$gte: 18}}, update: {$rename: {h: "i"}}},
+];
+for (let {filter, update} of updates) {
+    assert.commandWorked(coll.updateMany(filter, update));
+}
+
+// The wildcard index must return the same documents as a collection scan.
+const queries = [
+    {"a.b": {$gte: 0}},
+    {"a.b": {$gte: 100}},
+    {"c.d": {$gte: 0}},
+    {"c.d": "new"},
+    {"c.e": {$gte: 0}},
+    {c: {$gte: 0}},
+    {"f.y": 1},
+    {"g.z": 1},
+    {h: {$gte: 0}},
+    {i: {$gte: 0}},
+];
+for (let filter of queries) {
+    const expected = coll.find(filter).sort({_id: 1}).hint({$natural: 1}).toArray();
+    assert.eq(expected, coll.find(filter).sort({_id: 1}).hint({"$**": 1}).toArray(), filter);
+}
+
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, validateRes);
+})();
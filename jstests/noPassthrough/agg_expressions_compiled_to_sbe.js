@@ -0,0 +1,46 @@
+/**
+ * Tests that the pipelines executed by the classic engine return the same results when their
+ * $project, $addFields and $group stages evaluate their expressions through SBE.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.coll;
+
+const docs = [];
+for (let i = 0; i < 100; ++i) {
+    docs.push({_id: i, a: i % 7, b: {c: i % 3}, arr: [i, i + 1], s: "str" + (i % 5)});
+}
+docs.push({_id: 100});
+docs.push({_id: 101, a: null, b: 2.5});
+assert.commandWorked(coll.insert(docs));
+
+const pipelines = [
+    [{$project: {x: {$add: ["$a", {$multiply: ["$b.c", 2]}]}, y: {$gt: ["$a", 3]}}}],
+    [{$addFields: {z: {$cond: [{$eq: ["$b.c", 1]}, "$s", {$ifNull: ["$a", "none"]}]}}}],
+    [{$set: {l: {$let: {vars: {v: "$a"}, in: {$and: ["$$v", {$lt: ["$$v", 5]}]}}}}}],
+    [
+        {$group: {_id: {$mod: ["$_id", 4]}, total: {$sum: {$add: ["$a", 1]}}}},
+        {$sort: {_id: 1}}
+    ],
+    [{$project: {f: {$filter: {input: "$arr", cond: {$gt: ["$$this", 50]}}}}}],
+];
+
+function runPipelines() {
+    return pipelines.map(
+        pipeline => coll.aggregate(pipeline.concat([{$sort: {_id: 1}}])).toArray());
+}
+
+const expected = runPipelines();
+assert.commandWorked(
+    testDB.adminCommand({setParameter: 1, internalQueryCompileAggExpressionsToSBE: true}));
+const actual = runPipelines();
+for (let i = 0; i < pipelines.length; ++i) {
+    assert.eq(expected[i], actual[i], pipelines[i]);
+}
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,95 @@
+/**
+ * Tests that the results of read-only aggregations returned in a single batch are cached when the
+ * aggregation result cache is enabled, and that writes to any of the collections they read
+ * invalidate them.
+ * @tags: [
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQueryAggregationResultCacheMaxBytes: 16 * 1024 * 1024}});
+const db = conn.getDB("test");
+const coll = db.aggregation_result_cache;
+const foreignColl = db.aggregation_result_cache_foreign;
+
+assert.commandWorked(coll.insert([{_id: 0, a: 1}, {_id: 1, a: 2}, {_id: 2, a: 2}]));
+assert.commandWorked(foreignColl.insert([{_id: 0, b: 2}]));
+
+function getCacheMetrics() {
+    return assert.commandWorked(db.serverStatus()).metrics.query.aggregationResultCache;
+}
+
+// Runs 'pipeline' against 'coll' and returns its results, and by how much it incremented the hits
+// and misses of the cache.
+function runAndGetMetricsDelta(pipeline) {
+    const before = getCacheMetrics();
+    const results = coll.aggregate(pipeline).toArray();
+    const after = getCacheMetrics();
+    return {results: results, hits: after.hits - before.hits, misses: after.misses - before.misses};
+}
+
+const pipeline = [
+    {$lookup: {from: foreignColl.getName(), localField: "a", foreignField: "b", as: "matches"}},
+    {$group: {_id: {$size: "$matches"}, count: {$sum: 1}}},
+    {$sort: {_id: 1}}
+];
+const expected = [{_id: 0, count: 1}, {_id: 1, count: 2}];
+
+let run = runAndGetMetricsDelta(pipeline);
+assert.eq(run.results, expected);
+assert.eq(run.misses, 1);
+
+// Repeating the aggregation returns the cached results.
+run = runAndGetMetricsDelta(pipeline);
+assert.eq(run.results, expected);
+assert.eq(run.hits, 1);
+
+// A pipeline differing only by a literal is cached separately.
+run = runAndGetMetricsDelta([{$match: {a: 2}}]);
+assert.eq(run.misses, 1);
+assert.eq(run.results.length, 2);
+
+// Writing to the foreign collection invalidates the cached results.
+assert.commandWorked(foreignColl.insert({_id: 1, b: 1}));
+run = runAndGetMetricsDelta(pipeline);
+assert.eq(run.results, [{_id: 1, count: 3}]);
+assert.eq(run.misses, 1);
+
+// Writing to the collection itself does too.
+assert.commandWorked(coll.remove({_id: 0}));
+run = runAndGetMetricsDelta(pipeline);
+assert.eq(run.results, [{_id: 1, count: 2}]);
+assert.eq(run.misses, 1);
+run = runAndGetMetricsDelta(pipeline);
+assert.eq(run.hits, 1);
+
+// Results which do not fit in the first batch are not cached.
+assert.eq(coll.aggregate([{$match: {}}], {cursor: {batchSize: 1}}).itcount(), 2);
+run = runAndGetMetricsDelta([{$match: {}}]);
+assert.eq(run.misses, 1);
+const before = getCacheMetrics();
+assert.eq(coll.aggregate([{$match: {}}], {cursor: {batchSize: 1}}).itcount(), 2);
+assert.eq(getCacheMetrics().hits, before.hits);
+
+// Non-deterministic pipelines never use the cache.
+run = runAndGetMetricsDelta([{$addFields: {now: "$$NOW"}}]);
+assert.eq(run.hits + run.misses, 0);
+run = runAndGetMetricsDelta([{$sample: {size: 1}}]);
+assert.eq(run.hits + run.misses, 0);
+
+// Neither do aggregations which write.
+coll.aggregate([{$out: "aggregation_result_cache_out"}]);
+coll.aggregate([{$out: "aggregation_result_cache_out"}]);
+assert.eq(getCacheMetrics().hits, before.hits);
+
+// Disabling the cache makes it unused.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryAggregationResultCacheMaxBytes: 0}));
+run = runAndGetMetricsDelta(pipeline);
+assert.eq(run.hits + run.misses, 0);
+
+MongoRunner.stopMongod(conn);
+})();
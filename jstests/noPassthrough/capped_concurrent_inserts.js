@@ -0,0 +1,59 @@
+/**
+ * Tests that a tailable cursor over a capped collection returns every document, in insertion order
+ * for each writer, when inserts into the collection run concurrently. Only capped collections which
+ * are not replicated, such as those in the local database, take inserts concurrently.
+ * @tags: [
+ *   requires_capped,
+ *   requires_fcv_49,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/parallel_shell_helpers.js");  // For funWithArgs.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("local");
+const coll = db.capped_concurrent_inserts;
+assert.commandWorked(db.createCollection(coll.getName(), {capped: true, size: 16 * 1024 * 1024}));
+
+const kWriters = 4;
+const kDocsPerWriter = 500;
+
+// A tailable cursor over an empty collection would be closed, so start it from a first document.
+assert.commandWorked(coll.insert({_id: "start"}));
+const cursor = coll.find().tailable({awaitData: true});
+assert.eq("start", cursor.next()._id);
+
+const writers = [];
+for (let writer = 0; writer < kWriters; ++writer) {
+    writers.push(startParallelShell(
+        funWithArgs(function(collName, writer, numDocs) {
+            for (let i = 0; i < numDocs; ++i) {
+                assert.commandWorked(
+                    db.getSiblingDB("local")[collName].insert({writer: writer, i: i}));
+            }
+        }, coll.getName(), writer, kDocsPerWriter), conn.port));
+}
+
+const lastSeen = new Array(kWriters).fill(-1);
+let numSeen = 0;
+assert.soon(() => {
+    while (cursor.hasNext()) {
+        const doc = cursor.next();
+        assert.eq(lastSeen[doc.writer] + 1, doc.i, doc);
+        lastSeen[doc.writer] = doc.i;
+        ++numSeen;
+    }
+    return numSeen === kWriters * kDocsPerWriter;
+});
+
+for (let awaitShell of writers) {
+    awaitShell();
+}
+assert.eq(kWriters * kDocsPerWriter + 1, coll.find().itcount());
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,98 @@
+/**
+ * Tests that a collection created with 'clustered: true' stores its documents keyed by _id: it has
+ * no _id index, rejects duplicate and non-integral _id values, answers _id lookups, updates and
+ * deletes with a single record store seek, and keeps the option across a restart.
+ * @tags: [
+ *   requires_fcv_49,
+ *   requires_persistence,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const dbpath = MongoRunner.dataPath + "clustered_collection";
+resetDbpath(dbpath);
+
+let conn = MongoRunner.runMongod({dbpath: dbpath});
+assert.neq(null, conn, "mongod was unable to start up");
+let db = conn.getDB("test");
+
+for (let options of [{capped: true, size: 4096},
+                     {autoIndexId: true},
+                     {idIndex: {key: {_id: 1}, name: "_id_"}},
+                     {viewOn: "other"}]) {
+    const res = db.createCollection(
+        "bad", Object.assign({clustered: true, clusteredIdType: "long"}, options));
+    assert.commandFailedWithCode(res, ErrorCodes.InvalidOptions, tojson(options));
+}
+
+// The restriction on _id values must be acknowledged.
+for (let options of [{clustered: true},
+                     {clustered: true, clusteredIdType: "objectId"},
+                     {clusteredIdType: "long"}]) {
+    assert.commandFailedWithCode(
+        db.createCollection("bad", options), ErrorCodes.InvalidOptions, tojson(options));
+}
+
+assert.commandWorked(db.createCollection("coll", {clustered: true, clusteredIdType: "long"}));
+const coll = db.coll;
+
+assert.commandWorked(coll.insert([{_id: 3, a: 3}, {_id: 1, a: 1}, {_id: NumberLong(2), a: 2}]));
+for (let id of [0, -1, 1.5, "1", ObjectId()]) {
+    assert.commandFailedWithCode(coll.insert({_id: id}), ErrorCodes.BadValue, tojson(id));
+}
+assert.commandFailedWithCode(coll.insert({a: 4}), ErrorCodes.BadValue);
+
+// Numbers which compare equal are the same _id.
+assert.commandFailedWithCode(coll.insert({_id: 1.0}), ErrorCodes.DuplicateKey);
+assert.commandFailedWithCode(coll.insert({_id: NumberLong(3)}), ErrorCodes.DuplicateKey);
+
+function checkCollection() {
+    const info = db.getCollectionInfos({name: "coll"})[0];
+    assert.eq(true, info.options.clustered, info);
+    assert.eq([], coll.getIndexes());
+
+    // A collection scan returns the documents in _id order.
+    assert.eq([1, 2, 3], coll.find().toArray().map(doc => doc._id));
+
+    assert.eq({_id: 2, a: 2}, coll.findOne({_id: 2}));
+    assert.eq({_id: 2, a: 2}, coll.findOne({_id: 2.0}));
+    assert.eq(null, coll.findOne({_id: 4}));
+    assert.eq(null, coll.findOne({_id: "2"}));
+
+    const explain = coll.find({_id: 2}).explain("executionStats");
+    assert(isIdhack(db, explain.queryPlanner.winningPlan), explain);
+    assert.eq(0, explain.executionStats.totalKeysExamined, explain);
+    assert.eq(1, explain.executionStats.totalDocsExamined, explain);
+
+    const inQuery = {_id: {$in: [3, 1, 1.0, 9, "x"]}};
+    const inExplain = coll.find(inQuery).explain("executionStats");
+    assert(isIdhack(db, inExplain.queryPlanner.winningPlan), inExplain);
+    assert.eq(2, inExplain.executionStats.nReturned, inExplain);
+    assert.sameMembers([1, 3], coll.find(inQuery).toArray().map(doc => doc._id));
+
+    assert.commandWorked(coll.validate({full: true}));
+}
+
+checkCollection();
+
+assert.commandWorked(coll.update({_id: 1}, {$set: {b: 1}}));
+assert.eq({_id: 1, a: 1, b: 1}, coll.findOne({_id: 1}));
+assert.commandFailed(coll.update({_id: 1}, {$set: {_id: 5}}));
+assert.commandWorked(coll.update({_id: 5}, {$set: {a: 5}}, {upsert: true}));
+assert.eq({_id: 5, a: 5}, coll.findOne({_id: 5}));
+assert.commandWorked(coll.remove({_id: 5}));
+assert.commandWorked(coll.update({_id: 1}, {$unset: {b: 1}}));
+
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod({dbpath: dbpath, noCleanData: true});
+assert.neq(null, conn, "mongod was unable to restart");
+db = conn.getDB("test");
+checkCollection();
+
+MongoRunner.stopMongod(conn);
+})();
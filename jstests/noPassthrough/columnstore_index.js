@@ -0,0 +1,111 @@
+/**
+ * Tests that a "columnstore" index can stand in for a collection scan when a query only reads
+ * fields which the index stores, in both the classic and the slot-based execution engines.
+ * @tags: [
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryExecYieldIterations: 3}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.columnstore_index;
+coll.drop();
+
+// Only top-level fields may be stored, and the index can't filter or constrain documents.
+const kSpec = {a: "columnstore", b: "columnstore", c: "columnstore"};
+assert.commandFailedWithCode(coll.createIndex({"a.b": "columnstore"}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore", b: 1}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailed(coll.createIndex(kSpec, {unique: true}));
+assert.commandFailed(coll.createIndex(kSpec, {sparse: true}));
+assert.commandFailed(coll.createIndex(kSpec, {partialFilterExpression: {a: 1}}));
+assert.commandFailed(coll.createIndex(kSpec, {expireAfterSeconds: 10}));
+
+const docs = [
+    {_id: 0, a: 1, b: "x", c: [1, 2], d: 0},
+    {_id: 1, b: {y: 1}, a: 2, d: 1},
+    {_id: 2, d: 2},
+    {_id: 3, c: null, a: 3},
+    {_id: 4, a: [{b: 1}, {b: 2}], c: 1.5},
+];
+for (let i = 5; i < 100; ++i) {
+    docs.push(i % 2 ? {_id: i, a: i, c: -i} : {_id: i, b: i % 7, a: i % 5});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex(kSpec, {name: "cs"}));
+
+// Changes made after the index is built must be reflected in it.
+assert.commandWorked(coll.update({_id: 6}, {$set: {c: "new"}, $unset: {b: 1}}));
+assert.commandWorked(coll.update({_id: 7}, {$set: {d: 7}}));
+assert.commandWorked(coll.remove({_id: 8}));
+assert.commandWorked(coll.insert({_id: 100, c: 1, a: 2}));
+
+const queries = [
+    {filter: {}, proj: {_id: 0, a: 1, b: 1, c: 1}},
+    {filter: {}, proj: {_id: 0, b: 1}},
+    {filter: {a: {$gt: 1}}, proj: {_id: 0, c: 1, a: 1}},
+    {filter: {"a.b": 2}, proj: {_id: 0, a: 1}},
+    {filter: {c: {$exists: false}}, proj: {_id: 0, a: 1, b: 1}, sort: {a: 1, b: 1}},
+];
+
+function runQuery(query, hint) {
+    let cursor = coll.find(query.filter, query.proj);
+    if (query.sort) {
+        cursor = cursor.sort(query.sort);
+    }
+    return cursor.hint(hint).toArray();
+}
+
+function assertUsesColumnScan(query, expected) {
+    const explain = coll.find(query.filter, query.proj).explain();
+    assert.eq(expected, planHasStage(db, explain, "COLUMN_SCAN"), explain);
+    assert.eq(!expected, planHasStage(db, explain, "COLLSCAN"), explain);
+}
+
+for (let sbe of [false, true]) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableSlotBasedExecutionEngine: sbe}));
+
+    for (let query of queries) {
+        assertUsesColumnScan(query, true);
+
+        // The rows are rebuilt in the order of the fields in the documents, and in RecordId order,
+        // so they should match those of a collection scan exactly.
+        const expected = runQuery(query, {$natural: 1});
+        assert.eq(expected, runQuery(query, {}), query);
+        assert.eq(expected, runQuery(query, "cs"), query);
+    }
+
+    // A query which needs a field the index doesn't store, or the whole document, falls back to a
+    // collection scan. A hint to the columnstore index fails.
+    for (let query of [{filter: {d: 1}, proj: {_id: 0, a: 1}},
+                       {filter: {}, proj: {a: 1}},
+                       {filter: {a: 1}, proj: null}]) {
+        assertUsesColumnScan(query, false);
+        assert.throwsWithCode(() => runQuery(query, "cs"), ErrorCodes.NoQueryExecutionPlans);
+    }
+
+    // The columnstore index can't be used to answer a predicate.
+    const explain = coll.find({a: 1}).explain();
+    assert(!planHasStage(db, explain, "IXSCAN"), explain);
+
+    // Explain reports the index and the fields read.
+    const execStats = coll.find({a: {$gt: 1}}, {_id: 0, a: 1}).explain("executionStats");
+    const columnScan = getPlanStage(execStats, "COLUMN_SCAN");
+    assert.eq("cs", columnScan.indexName, execStats);
+    assert.eq(["a"], columnScan.fields, execStats);
+    assert.eq(0, execStats.executionStats.totalDocsExamined, execStats);
+}
+
+// Validation accepts the index, which is never marked multikey.
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, validateRes);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,54 @@
+/**
+ * Tests that the sampling CPU profiler charges its samples to the operations consuming CPU, and
+ * reports them in currentOp and serverStatus.
+ * @tags: [
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+if (_isWindows()) {
+    return;
+}
+
+const conn = MongoRunner.runMongod({setParameter: {cpuSamplingProfilerIntervalMicros: 1000}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.cpu_sampling_profiler;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 1000; ++i) {
+    docs.push({_id: i, s: "x".repeat(100)});
+}
+assert.commandWorked(coll.insert(docs));
+
+function getProfilerStats() {
+    return assert.commandWorked(db.adminCommand({serverStatus: 1})).cpuSamplingProfiler;
+}
+
+// Burn some CPU in an aggregation.
+const before = getProfilerStats();
+assert.eq(1000, before.intervalMicros, before);
+for (let i = 0; i < 20; ++i) {
+    coll.aggregate([
+            {$project: {s: 1, r: {$range: [0, 50]}}},
+            {$unwind: "$r"},
+            {$group: {_id: {$mod: ["$_id", 7]}, n: {$sum: {$strLenCP: "$s"}}}},
+        ])
+        .itcount();
+}
+
+assert.soon(() => {
+    const after = getProfilerStats();
+    return after.samples > before.samples &&
+        (after.commands.aggregate || 0) > (before.commands.aggregate || 0);
+}, () => tojson(getProfilerStats()));
+
+// Disabling the profiler stops sampling.
+assert.commandWorked(db.adminCommand({setParameter: 1, cpuSamplingProfilerIntervalMicros: 0}));
+assert.eq(0, getProfilerStats().intervalMicros);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,51 @@
+/**
+ * Tests that find and getMore return a batch early once internalQueryFindBatchTimeBudgetMillis
+ * has elapsed, as long as the batch holds at least one document.
+ * @tags: [
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.find_batch_time_budget;
+
+const kNumDocs = 20;
+const docs = [];
+for (let i = 0; i < kNumDocs; ++i) {
+    docs.push({_id: i});
+}
+assert.commandWorked(coll.insert(docs));
+
+// Each document takes at least 5ms to produce.
+const filter = {$where: "sleep(5); return true;"};
+
+function getBatchSizes(batchSize) {
+    let res = assert.commandWorked(db.runCommand({find: coll.getName(), filter, batchSize}));
+    const sizes = [res.cursor.firstBatch.length];
+    while (res.cursor.id != 0) {
+        res = assert.commandWorked(
+            db.runCommand({getMore: res.cursor.id, collection: coll.getName(), batchSize}));
+        sizes.push(res.cursor.nextBatch.length);
+    }
+    return sizes.filter(size => size > 0);
+}
+
+// By default, the batches are filled up to their batchSize.
+assert.eq([10, 10], getBatchSizes(10));
+
+// With a time budget shorter than it takes to produce a single document, every batch holds one.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryFindBatchTimeBudgetMillis: 1}));
+const sizes = getBatchSizes(10);
+assert.eq(kNumDocs, sizes.length, sizes);
+assert(sizes.every(size => size == 1), sizes);
+
+// Disabling the time budget restores the previous behavior.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryFindBatchTimeBudgetMillis: 0}));
+assert.eq([10, 10], getBatchSizes(10));
+
+MongoRunner.stopMongod(conn);
+})();
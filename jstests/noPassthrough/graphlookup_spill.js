@@ -0,0 +1,70 @@
+/**
+ * Tests that $graphLookup spills its visited set to disk when allowDiskUse is set, instead of
+ * failing once it reaches its memory limit.
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq and assertErrorCode.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const local = db.graphlookup_spill_local;
+const foreign = db.graphlookup_spill_foreign;
+
+assert.commandWorked(local.insert([{_id: 0, start: 0}, {_id: 1, start: 150}, {_id: 2}]));
+
+// A chain of documents, each connecting to the next one.
+const padding = "x".repeat(500);
+const bulk = foreign.initializeUnorderedBulkOp();
+for (let i = 0; i < 300; ++i) {
+    bulk.insert({_id: i, next: i + 1, padding});
+}
+assert.commandWorked(bulk.execute());
+
+function setMaxMemoryBytes(value) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalDocumentSourceGraphLookupMaxMemoryBytes: value}));
+}
+
+const graphLookup = {
+    $graphLookup: {
+        from: foreign.getName(),
+        startWith: "$start",
+        connectFromField: "next",
+        connectToField: "_id",
+        depthField: "depth",
+        as: "chain"
+    }
+};
+
+function assertSameResults(pipeline) {
+    setMaxMemoryBytes(100 * 1024 * 1024);
+    const expected = local.aggregate(pipeline).toArray();
+
+    setMaxMemoryBytes(16 * 1024);
+    const actual = local.aggregate(pipeline, {allowDiskUse: true}).toArray();
+    assert(arrayEq(expected, actual), tojson({expected, actual}));
+    return actual;
+}
+
+const results = assertSameResults([graphLookup, {$sort: {_id: 1}}]);
+assert.eq(300, results[0].chain.length);
+assert.eq(150, results[1].chain.length);
+assert.eq(0, results[2].chain.length);
+
+// The results of an absorbed $unwind are also read back from disk.
+assertSameResults([
+    graphLookup,
+    {$unwind: {path: "$chain", includeArrayIndex: "index", preserveNullAndEmptyArrays: true}},
+    {$project: {"chain.padding": 0, index: 0}}
+]);
+
+// Without allowDiskUse, the stage still fails once it reaches its memory limit.
+setMaxMemoryBytes(16 * 1024);
+assertErrorCode(local, [graphLookup], 40099);
+
+MongoRunner.stopMongod(conn);
+}());
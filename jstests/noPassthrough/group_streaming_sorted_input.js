@@ -0,0 +1,67 @@
+/**
+ * Tests that a $group which directly follows a $sort on its group key returns each group as it is
+ * read, so that it does not run into the $group memory limit however many groups there are.
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalDocumentSourceGroupMaxMemoryBytes: 10 * 1024}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.group_streaming_sorted_input;
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 2000; ++i) {
+    bulk.insert({day: Math.floor(i / 10), hour: i % 10, amount: i});
+}
+// Keys which do not necessarily sort next to the rest of their group.
+bulk.insert({day: null, hour: 1, amount: 1});
+bulk.insert({hour: 2, amount: 2});
+bulk.insert({day: [3, 1500], hour: 3, amount: 3});
+bulk.insert({day: [3, 1500], hour: 4, amount: 4});
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({day: 1, hour: 1}));
+
+const groupByDay = {$group: {_id: "$day", total: {$sum: "$amount"}, maxHour: {$max: "$hour"}}};
+const expected = coll.aggregate([{$sort: {day: 1, hour: 1}}, groupByDay], {allowDiskUse: true})
+                     .toArray();
+assert.eq(expected.length, 202, expected);
+
+// Without a preceding $sort the groups are collected in the hash table, which is too small.
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: coll.getName(), pipeline: [groupByDay], cursor: {}}),
+    ErrorCodes.QueryExceededMemoryLimitNoDiskUseAllowed);
+
+// A $sort on a prefix of the index, which the query layer provides, lets the $group stream.
+for (let sort of [{day: 1}, {day: -1}, {day: 1, hour: 1}, {day: -1, hour: -1}]) {
+    const results = coll.aggregate([{$sort: sort}, groupByDay]).toArray();
+    assert(arrayEq(expected, results), tojson({sort, expected, results}));
+}
+
+// Streamed groups are returned in sort order.
+const results = coll.aggregate([
+                        {$match: {day: {$type: "number"}}},
+                        {$sort: {day: -1}},
+                        {$group: {_id: "$day", n: {$sum: 1}}}
+                    ])
+                    .toArray();
+assert.eq(results.length, 200, results);
+for (let i = 0; i < results.length; ++i) {
+    assert.eq(results[i], {_id: 199 - i, n: 10}, results);
+}
+
+// A compound group key must cover a prefix of the sort.
+const groupByDayAndHour = {$group: {_id: {h: "$hour", d: "$day"}, n: {$sum: 1}}};
+assert.eq(coll.aggregate([{$sort: {day: 1, hour: 1}}, groupByDayAndHour]).itcount(), 2004);
+assert.commandFailedWithCode(db.runCommand({
+    aggregate: coll.getName(),
+    pipeline: [{$sort: {hour: 1}}, {$group: {_id: "$day"}}],
+    cursor: {}
+}),
+                             ErrorCodes.QueryExceededMemoryLimitNoDiskUseAllowed);
+
+MongoRunner.stopMongod(conn);
+}());
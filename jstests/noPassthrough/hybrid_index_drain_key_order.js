@@ -0,0 +1,80 @@
+/**
+ * Tests that side writes drained into a hybrid index build in key order, rather than in the order
+ * they were observed, leave both regular and unique indexes consistent, including when the same
+ * key moves between documents during the build.
+ *
+ * @tags: [
+ *   requires_fcv_49,
+ *   requires_replication,
+ * ]
+ */
+(function() {
+'use strict';
+
+load('jstests/noPassthrough/libs/index_build.js');
+
+const rst = new ReplSetTest({
+    nodes: [
+        {},
+        {
+            // Disallow elections on secondary.
+            rsConfig: {
+                priority: 0,
+                votes: 0,
+            },
+        },
+    ]
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const testDB = primary.getDB('test');
+const coll = testDB.getCollection('test');
+
+const docs = [];
+for (let i = 0; i < 100; ++i) {
+    docs.push({_id: i, a: 'x' + i, b: i});
+}
+assert.commandWorked(coll.insert(docs));
+
+IndexBuildTest.pauseIndexBuilds(primary);
+const createUniqueIdx =
+    IndexBuildTest.startIndexBuild(primary, coll.getFullName(), {a: 1}, {unique: true});
+const createIdx = IndexBuildTest.startIndexBuild(primary, coll.getFullName(), {b: 1});
+IndexBuildTest.waitForIndexBuildToScanCollection(testDB, coll.getName(), 'a_1');
+IndexBuildTest.waitForIndexBuildToScanCollection(testDB, coll.getName(), 'b_1');
+
+// Side writes are observed in descending key order.
+for (let i = 99; i >= 50; --i) {
+    assert.commandWorked(coll.update({_id: i}, {$set: {a: i, b: -i}}));
+}
+
+// Move each key to a document with a lower RecordId, after removing it from the document which
+// held it. Reordering these by RecordId would briefly leave two documents with the same key.
+for (let i = 99; i > 50; --i) {
+    assert.commandWorked(coll.update({_id: i}, {$set: {a: 'moved' + i}}));
+    assert.commandWorked(coll.update({_id: i - 50}, {$set: {a: i}}));
+}
+assert.commandWorked(coll.remove({_id: {$gte: 90}}));
+assert.commandWorked(coll.insert({_id: 1000, a: 'x95', b: 95}));
+
+IndexBuildTest.resumeIndexBuilds(primary);
+createUniqueIdx();
+createIdx();
+IndexBuildTest.assertIndexes(coll, 3, ['_id_', 'a_1', 'b_1']);
+
+for (let hint of [{a: 1}, {b: 1}]) {
+    assert.eq(coll.find().sort({_id: 1}).hint({$natural: 1}).toArray(),
+              coll.find().sort({_id: 1}).hint(hint).toArray(),
+              hint);
+}
+
+rst.awaitReplication();
+for (let node of rst.nodes) {
+    const res = assert.commandWorked(node.getDB('test').test.validate({full: true}));
+    assert(res.valid, 'validation failed on ' + node.host + ': ' + tojson(res));
+}
+
+rst.stopSet();
+})();
@@ -0,0 +1,51 @@
+/**
+ * Tests that createIndexes commands on the same collection that arrive within
+ * 'indexBuildCoalescingWindowMillis' of each other are built by a single index build.
+ * @tags: [
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/parallel_shell_helpers.js");
+
+const conn = MongoRunner.runMongod({setParameter: {indexBuildCoalescingWindowMillis: 10 * 1000}});
+assert.neq(null, conn, "mongod was unable to start up");
+const testDB = conn.getDB("test");
+const coll = testDB.index_build_coalescing;
+coll.drop();
+
+for (let i = 0; i < 100; ++i) {
+    assert.commandWorked(coll.insert({a: i, b: -i, c: [i, i + 1]}));
+}
+
+function createIndex(collName, key) {
+    assert.commandWorked(db.getCollection(collName).createIndex(key));
+}
+
+// The first command leads the group and waits out the window before starting the build.
+const awaitFirst = startParallelShell(funWithArgs(createIndex, coll.getName(), {a: 1}), conn.port);
+assert.soon(() => testDB.getSiblingDB("admin")
+                      .aggregate([
+                          {$currentOp: {}},
+                          {$match: {"command.createIndexes": coll.getName()}},
+                      ])
+                      .itcount() === 1);
+
+// The second command joins the waiting build instead of starting its own.
+const awaitSecond = startParallelShell(funWithArgs(createIndex, coll.getName(), {b: 1}), conn.port);
+checkLog.containsJson(conn, 5843212);
+
+awaitFirst();
+awaitSecond();
+
+// Both indexes come from a single registered build.
+assert(checkLog.checkContainsOnceJson(conn, 20438, {indexes: 2}));
+const indexNames = coll.getIndexes().map(index => index.name).sort();
+assert.eq(["_id_", "a_1", "b_1"], indexNames);
+assert.eq(1, coll.find({b: -1}).hint({b: 1}).itcount());
+
+assert.commandWorked(coll.validate({full: true}));
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,92 @@
+/**
+ * Tests that a localField/foreignField $lookup returns the same results when it queries the foreign
+ * collection for a batch of input documents at a time as when it queries it for each input
+ * document.
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const local = db.lookup_batched_local;
+const foreign = db.lookup_batched_foreign;
+
+assert.commandWorked(local.insert([
+    {_id: 0, a: 1},
+    {_id: 1, a: 1.0},
+    {_id: 2, a: [1, 2]},
+    {_id: 3, a: [[1, 2]]},
+    {_id: 4, a: null},
+    {_id: 5},
+    {_id: 6, a: "abc"},
+    {_id: 7, a: /abc/},
+    {_id: 8, a: {x: 1}},
+    {_id: 9, a: [{x: 1}, 3]},
+    {_id: 10, a: "ABC"},
+    {_id: 11, a: 42},
+]));
+
+assert.commandWorked(foreign.insert([
+    {_id: 0, b: 1},
+    {_id: 1, b: NumberLong(2)},
+    {_id: 2, b: [1, 2]},
+    {_id: 3, b: [[1, 2]]},
+    {_id: 4, b: null},
+    {_id: 5},
+    {_id: 6, b: "abc"},
+    {_id: 7, b: /abc/},
+    {_id: 8, b: {x: 1}},
+    {_id: 9, b: [null, 3]},
+    {_id: 10, c: [{b: 1}, {}]},
+    {_id: 11, c: [{b: [1, 2]}, {b: "abc"}]},
+    {_id: 12, c: {b: null}},
+]));
+
+function setBatchSize(value) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalDocumentSourceLookupBatchSize: value}));
+}
+
+function runLookup(foreignField, options) {
+    return local
+        .aggregate([
+            {$sort: {_id: 1}},
+            {$lookup: {from: foreign.getName(), localField: "a", foreignField, as: "joined"}}
+        ],
+                   options)
+        .toArray();
+}
+
+function assertSameResults(foreignField, options) {
+    setBatchSize(0);
+    const expected = runLookup(foreignField, options);
+
+    // Exercise both full batches and a partial final batch.
+    for (let batchSize of [2, 5, 100]) {
+        setBatchSize(batchSize);
+        const actual = runLookup(foreignField, options);
+
+        assert.eq(expected.length, actual.length);
+        for (let i = 0; i < expected.length; ++i) {
+            assert.eq(expected[i]._id, actual[i]._id);
+            assert(arrayEq(expected[i].joined, actual[i].joined),
+                   tojson({batchSize, foreignField, expected: expected[i], actual: actual[i]}));
+        }
+    }
+}
+
+assertSameResults("b");
+assertSameResults("c.b");
+assertSameResults("b", {collation: {locale: "en_US", strength: 2}});
+
+// A batch whose foreign documents exceed the memory budget is queried per input document.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalDocumentSourceLookupHashJoinMaxMemoryBytes: 1}));
+assertSameResults("b");
+
+MongoRunner.stopMongod(conn);
+}());
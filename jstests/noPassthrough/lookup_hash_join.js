@@ -0,0 +1,91 @@
+/**
+ * Tests that a localField/foreignField $lookup returns the same results when it reads the foreign
+ * collection into a hash table as when it queries the foreign collection for each input document.
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const local = db.lookup_hash_join_local;
+const foreign = db.lookup_hash_join_foreign;
+
+assert.commandWorked(local.insert([
+    {_id: 0, a: 1},
+    {_id: 1, a: 1.0},
+    {_id: 2, a: [1, 2]},
+    {_id: 3, a: [[1, 2]]},
+    {_id: 4, a: null},
+    {_id: 5},
+    {_id: 6, a: "abc"},
+    {_id: 7, a: /abc/},
+    {_id: 8, a: {x: 1}},
+    {_id: 9, a: [{x: 1}, 3]},
+]));
+
+assert.commandWorked(foreign.insert([
+    {_id: 0, b: 1},
+    {_id: 1, b: NumberLong(2)},
+    {_id: 2, b: [1, 2]},
+    {_id: 3, b: [[1, 2]]},
+    {_id: 4, b: null},
+    {_id: 5},
+    {_id: 6, b: "abc"},
+    {_id: 7, b: /abc/},
+    {_id: 8, b: {x: 1}},
+    {_id: 9, b: [null, 3]},
+    {_id: 10, c: [{b: 1}, {}]},
+    {_id: 11, c: [{b: [1, 2]}, {b: "abc"}]},
+    {_id: 12, c: {b: null}},
+]));
+
+function setMaxForeignDocs(value) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalDocumentSourceLookupHashJoinMaxForeignDocs: value}));
+}
+
+function runLookup(foreignField, options) {
+    return local
+        .aggregate([
+            {$lookup: {from: foreign.getName(), localField: "a", foreignField, as: "joined"}},
+            {$sort: {_id: 1}}
+        ],
+                   options)
+        .toArray();
+}
+
+function assertSameResults(foreignField, options) {
+    setMaxForeignDocs(0);
+    const expected = runLookup(foreignField, options);
+
+    setMaxForeignDocs(1000);
+    const actual = runLookup(foreignField, options);
+
+    assert.eq(expected.length, actual.length);
+    for (let i = 0; i < expected.length; ++i) {
+        assert.eq(expected[i]._id, actual[i]._id);
+        assert(arrayEq(expected[i].joined, actual[i].joined),
+               tojson({foreignField, expected: expected[i], actual: actual[i]}));
+    }
+}
+
+assertSameResults("b");
+assertSameResults("c.b");
+assertSameResults("b", {collation: {locale: "en_US", strength: 2}});
+
+// A foreign collection larger than the limit is queried per input document.
+setMaxForeignDocs(1);
+assert.eq(local.count(), runLookup("b").length);
+
+// A foreign collection larger than the memory budget is abandoned and queried per input document.
+setMaxForeignDocs(1000);
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalDocumentSourceLookupHashJoinMaxMemoryBytes: 1}));
+assertSameResults("b");
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,49 @@
+/**
+ * Tests that the operations of the applications listed in 'lowPriorityAppNames' are admitted with
+ * low priority when they acquire tickets.
+ * @tags: [
+ *   requires_fcv_49,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {lowPriorityAppNames: "analytics,reporting"}});
+assert.neq(null, conn, "mongod was unable to start up");
+const adminDB = conn.getDB("admin");
+
+function getLowPriorityReadTicketsOut() {
+    const status = assert.commandWorked(adminDB.runCommand({serverStatus: 1}));
+    return status.wiredTiger.concurrentTransactions.read.lowPriority.out;
+}
+
+// Holds a read ticket for a few seconds from a connection with the given application name, and
+// checks whether the ticket was taken from the low priority share.
+function checkAdmissionPriority(appName, expectLowPriority) {
+    const awaitSleep = startParallelShell(
+        funWithArgs(function(host, appName) {
+            const conn = new Mongo(`mongodb://${host}/?appName=${appName}`);
+            assert.commandWorked(
+                conn.adminCommand({sleep: 1, lock: "ir", secs: 3, comment: "holdTicket"}));
+        }, conn.host, appName), conn.port);
+
+    const pipeline = [{$currentOp: {}}, {$match: {"command.comment": "holdTicket"}}];
+    assert.soon(() => adminDB.aggregate(pipeline).itcount() === 1);
+    assert.eq(expectLowPriority ? 1 : 0, getLowPriorityReadTicketsOut());
+    awaitSleep();
+}
+
+checkAdmissionPriority("analytics", true);
+checkAdmissionPriority("oltp", false);
+
+// The parameter can be changed at runtime.
+assert.commandWorked(adminDB.runCommand({setParameter: 1, lowPriorityAppNames: "oltp"}));
+checkAdmissionPriority("oltp", true);
+checkAdmissionPriority("analytics", false);
+
+assert.commandWorked(adminDB.runCommand({setParameter: 1, lowPriorityAppNames: ""}));
+checkAdmissionPriority("oltp", false);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,143 @@
+/**
+ * Tests that materialized views store their results in a backing collection, which is refreshed
+ * incrementally from the oplog when the pipeline allows it and recomputed otherwise.
+ * @tags: [
+ *   requires_fcv_49,
+ *   requires_replication,
+ * ]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const db = rst.getPrimary().getDB("test");
+const source = db.materialized_view_source;
+assert.commandWorked(source.insert([{_id: 0, k: "a", v: 1}, {_id: 1, k: "b", v: 2}]));
+
+function getMetrics() {
+    return assert.commandWorked(db.serverStatus()).metrics.query.materializedViews;
+}
+
+// Reads 'view' sorted by _id and returns the results, and how many full and incremental refreshes
+// the read caused.
+function readAndGetRefreshes(view) {
+    const before = getMetrics();
+    const results = view.find().sort({_id: 1}).toArray();
+    const after = getMetrics();
+    return {
+        results: results,
+        full: after.fullRefreshes - before.fullRefreshes,
+        incremental: after.incrementalRefreshes - before.incrementalRefreshes
+    };
+}
+
+// Create a view whose stages preserve the _id of the source documents.
+assert.commandWorked(db.runCommand({
+    create: "per_document",
+    viewOn: source.getName(),
+    pipeline: [{$match: {v: {$gt: 0}}}, {$set: {double: {$multiply: ["$v", 2]}}}],
+    materialized: true
+}));
+const perDocument = db.per_document;
+const backing = db.getCollection("system.materialized.per_document");
+
+// The first read populates the backing collection.
+let read = readAndGetRefreshes(perDocument);
+assert.eq(read.results,
+          [{_id: 0, k: "a", v: 1, double: 2}, {_id: 1, k: "b", v: 2, double: 4}],
+          read);
+assert.eq(read.full, 1, read);
+assert.eq(backing.find().itcount(), 2);
+
+// Reading again without intervening writes does not refresh the view.
+read = readAndGetRefreshes(perDocument);
+assert.eq(read.full + read.incremental, 0, read);
+
+// Inserts, updates and deletes are applied to the affected documents only.
+assert.commandWorked(source.insert({_id: 2, k: "a", v: 3}));
+assert.commandWorked(source.update({_id: 0}, {$set: {v: 5}}));
+assert.commandWorked(source.update({_id: 1}, {$set: {v: -1}}));
+read = readAndGetRefreshes(perDocument);
+assert.eq(read.results,
+          [{_id: 0, k: "a", v: 5, double: 10}, {_id: 2, k: "a", v: 3, double: 6}],
+          read);
+assert.eq(read.full, 0, read);
+assert.eq(read.incremental, 1, read);
+
+assert.commandWorked(source.remove({_id: 2}));
+read = readAndGetRefreshes(perDocument);
+assert.eq(read.results, [{_id: 0, k: "a", v: 5, double: 10}], read);
+assert.eq(read.incremental, 1, read);
+
+// Queries on the view see the materialized results.
+assert.eq(perDocument.count({double: 10}), 1);
+assert.eq(perDocument.aggregate([{$project: {_id: 0, v: 1}}]).toArray(), [{v: 5}]);
+
+// A view with a final $group of mergeable accumulators merges the groups of inserted documents.
+assert.commandWorked(db.runCommand({
+    create: "grouped",
+    viewOn: source.getName(),
+    pipeline: [{$group: {_id: "$k", n: {$sum: 1}, total: {$sum: "$v"}, hi: {$max: "$v"}}}],
+    materialized: true
+}));
+const grouped = db.grouped;
+read = readAndGetRefreshes(grouped);
+assert.eq(read.results, [{_id: "a", n: 1, total: 5, hi: 5}, {_id: "b", n: 1, total: -1, hi: -1}]);
+assert.eq(read.full, 1, read);
+
+assert.commandWorked(source.insert([{_id: 3, k: "a", v: 7}, {_id: 4, k: "c", v: 1}]));
+read = readAndGetRefreshes(grouped);
+assert.eq(read.results, [
+    {_id: "a", n: 2, total: 12, hi: 7},
+    {_id: "b", n: 1, total: -1, hi: -1},
+    {_id: "c", n: 1, total: 1, hi: 1}
+]);
+assert.eq(read.full, 0, read);
+assert.eq(read.incremental, 1, read);
+
+// An update to the source cannot be merged into the groups, so the view is recomputed.
+assert.commandWorked(source.update({_id: 3}, {$set: {v: 1}}));
+read = readAndGetRefreshes(grouped);
+assert.eq(read.results, [
+    {_id: "a", n: 2, total: 6, hi: 5},
+    {_id: "b", n: 1, total: -1, hi: -1},
+    {_id: "c", n: 1, total: 1, hi: 1}
+]);
+assert.eq(read.full, 1, read);
+
+// Materialized views are listed with the options they were created with.
+const listed = db.getCollectionInfos({name: "grouped"});
+assert.eq(listed.length, 1, listed);
+assert.eq(listed[0].type, "view", listed);
+assert.eq(listed[0].options.viewOn, source.getName(), listed);
+assert.eq(listed[0].options.materialized, true, listed);
+
+// Materialized views cannot be modified, and must be defined on a collection in the same database
+// without reading from other namespaces.
+assert.commandFailedWithCode(
+    db.runCommand({collMod: "grouped", viewOn: source.getName(), pipeline: []}),
+    ErrorCodes.OptionNotSupportedOnView);
+assert.commandFailedWithCode(
+    db.runCommand({create: "of_view", viewOn: "grouped", pipeline: [], materialized: true}),
+    ErrorCodes.OptionNotSupportedOnView);
+const lookupStage = {$lookup: {from: "other", localField: "k", foreignField: "k", as: "o"}};
+assert.commandFailedWithCode(
+    db.runCommand({
+        create: "with_lookup",
+        viewOn: source.getName(),
+        pipeline: [lookupStage],
+        materialized: true
+    }),
+    ErrorCodes.OptionNotSupportedOnView);
+assert.commandFailedWithCode(db.runCommand({create: "no_view_on", materialized: true}),
+                             ErrorCodes.InvalidOptions);
+
+// Dropping a materialized view also drops its backing collection.
+assert(perDocument.drop());
+assert.eq(db.getCollectionInfos({name: "system.materialized.per_document"}).length, 0);
+
+rst.stopSet();
+})();
@@ -0,0 +1,38 @@
+/**
+ * Tests that serverStatus reports how long oplog writes take to become visible to oplog readers.
+ * @tags: [
+ *   requires_fcv_49,
+ *   requires_replication,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const coll = primary.getDB("test").oplog_visibility_delay_stats;
+
+function getVisibilityDelayStats() {
+    return assert.commandWorked(primary.adminCommand({serverStatus: 1}))
+        .wiredTiger.oplog["visibility delay"];
+}
+
+const before = getVisibilityDelayStats();
+for (let i = 0; i < 10; ++i) {
+    assert.commandWorked(coll.insert({_id: i}, {writeConcern: {w: "majority"}}));
+}
+
+assert.soon(() => getVisibilityDelayStats().ops > before.ops);
+const after = getVisibilityDelayStats();
+assert.gte(after.latency, before.latency, after);
+assert.eq(after.ops, after.histogram.reduce((total, bucket) => total + bucket.count, 0), after);
+for (let bucket of after.histogram) {
+    assert.gt(bucket.count, 0, after);
+}
+
+rst.stopSet();
+})();
@@ -0,0 +1,54 @@
+/**
+ * Tests that profile entries are written to system.profile in the background when the profiler
+ * write buffer is enabled, and that entries which don't fit into the buffer are dropped and counted.
+ * @tags: [
+ *   requires_fcv_49,
+ *   requires_profiling,
+ * ]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {profilerWriteBufferSize: 1000, profilerWriteBufferFlushIntervalMillis: 50}
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.profile_write_buffer;
+
+function getProfilerMetrics() {
+    return assert.commandWorked(db.adminCommand({serverStatus: 1})).metrics.profiler;
+}
+
+assert.commandWorked(coll.insert({_id: 0}));
+assert.commandWorked(db.setProfilingLevel(2));
+
+// The entries end up in system.profile, in the order in which the operations ran.
+const kNumQueries = 50;
+for (let i = 0; i < kNumQueries; ++i) {
+    assert.eq(1, coll.find({_id: 0}).comment("buffered" + i).itcount());
+}
+assert.soon(() => db.system.profile.find({"command.comment": /^buffered/}).itcount() ===
+                kNumQueries);
+const comments = db.system.profile.find({"command.comment": /^buffered/})
+                     .sort({$natural: 1})
+                     .toArray()
+                     .map(entry => entry.command.comment);
+assert.eq(Array.from({length: kNumQueries}, (_, i) => "buffered" + i), comments);
+assert.gte(getProfilerMetrics().bufferedEntries, kNumQueries);
+assert.eq(0, getProfilerMetrics().droppedEntries);
+
+// With a full buffer, entries are dropped instead of slowing down the operations.
+assert.commandWorked(db.adminCommand({setParameter: 1, profilerWriteBufferSize: 1}));
+for (let i = 0; i < kNumQueries; ++i) {
+    assert.eq(1, coll.find({_id: 0}).comment("dropped" + i).itcount());
+}
+assert.gt(getProfilerMetrics().droppedEntries, 0);
+
+// Disabling the buffer makes the writes synchronous again.
+assert.commandWorked(db.adminCommand({setParameter: 1, profilerWriteBufferSize: 0}));
+assert.eq(1, coll.find({_id: 0}).comment("synchronous").itcount());
+assert.eq(1, db.system.profile.find({"command.comment": "synchronous"}).itcount());
+
+MongoRunner.stopMongod(conn);
+})();
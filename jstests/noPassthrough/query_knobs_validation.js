@@ -35,6 +35,16 @@ const expectedParamDefaults = {
     internalQueryFacetBufferSizeBytes: 100 * 1024 * 1024,
     internalDocumentSourceCursorBatchSizeBytes: 4 * 1024 * 1024,
     internalDocumentSourceLookupCacheSizeBytes: 100 * 1024 * 1024,
+    internalDocumentSourceLookupHashJoinMaxForeignDocs: 0,
+    internalDocumentSourceLookupHashJoinMaxMemoryBytes: 100 * 1024 * 1024,
+    internalDocumentSourceLookupBatchSize: 0,
+    internalDocumentSourceGraphLookupMaxMemoryBytes: 100 * 1024 * 1024,
+    internalChangeStreamSharedEventCacheMaxBytes: 0,
+    internalChangeStreamPostImageCacheMaxBytes: 0,
+    internalChangeStreamPostImageCacheExpiryMillis: 1000,
+    internalQueryAggregationResultCacheMaxBytes: 0,
+    internalQueryAggregationResultCacheExpiryMillis: 0,
+    internalQueryMaterializedViewMaxIncrementalDocuments: 1000,
     internalLookupStageIntermediateDocumentMaxSizeBytes: 100 * 1024 * 1024,
     internalDocumentSourceGroupMaxMemoryBytes: 100 * 1024 * 1024,
     internalPipelineLengthLimit: 1000,
@@ -183,6 +193,47 @@ assertSetParameterSucceeds("internalDocumentSourceLookupCacheSizeBytes", 11);
 assertSetParameterSucceeds("internalDocumentSourceLookupCacheSizeBytes", 0);
 assertSetParameterFails("internalDocumentSourceLookupCacheSizeBytes", -1);
 
+assertSetParameterSucceeds("internalDocumentSourceLookupHashJoinMaxForeignDocs", 10000);
+assertSetParameterSucceeds("internalDocumentSourceLookupHashJoinMaxForeignDocs", 0);
+assertSetParameterFails("internalDocumentSourceLookupHashJoinMaxForeignDocs", -1);
+
+assertSetParameterSucceeds("internalDocumentSourceLookupHashJoinMaxMemoryBytes", 11);
+assertSetParameterSucceeds("internalDocumentSourceLookupHashJoinMaxMemoryBytes", 0);
+assertSetParameterFails("internalDocumentSourceLookupHashJoinMaxMemoryBytes", -1);
+
+assertSetParameterSucceeds("internalDocumentSourceLookupBatchSize", 10000);
+assertSetParameterSucceeds("internalDocumentSourceLookupBatchSize", 0);
+assertSetParameterFails("internalDocumentSourceLookupBatchSize", -1);
+assertSetParameterFails("internalDocumentSourceLookupBatchSize", 10001);
+
+assertSetParameterSucceeds("internalDocumentSourceGraphLookupMaxMemoryBytes", 11);
+assertSetParameterFails("internalDocumentSourceGraphLookupMaxMemoryBytes", 0);
+assertSetParameterFails("internalDocumentSourceGraphLookupMaxMemoryBytes", -1);
+
+assertSetParameterSucceeds("internalChangeStreamSharedEventCacheMaxBytes", 11);
+assertSetParameterSucceeds("internalChangeStreamSharedEventCacheMaxBytes", 0);
+assertSetParameterFails("internalChangeStreamSharedEventCacheMaxBytes", -1);
+
+assertSetParameterSucceeds("internalChangeStreamPostImageCacheMaxBytes", 11);
+assertSetParameterSucceeds("internalChangeStreamPostImageCacheMaxBytes", 0);
+assertSetParameterFails("internalChangeStreamPostImageCacheMaxBytes", -1);
+
+assertSetParameterSucceeds("internalChangeStreamPostImageCacheExpiryMillis", 1);
+assertSetParameterFails("internalChangeStreamPostImageCacheExpiryMillis", 0);
+assertSetParameterFails("internalChangeStreamPostImageCacheExpiryMillis", -1);
+
+assertSetParameterSucceeds("internalQueryAggregationResultCacheMaxBytes", 11);
+assertSetParameterSucceeds("internalQueryAggregationResultCacheMaxBytes", 0);
+assertSetParameterFails("internalQueryAggregationResultCacheMaxBytes", -1);
+
+assertSetParameterSucceeds("internalQueryAggregationResultCacheExpiryMillis", 1);
+assertSetParameterSucceeds("internalQueryAggregationResultCacheExpiryMillis", 0);
+assertSetParameterFails("internalQueryAggregationResultCacheExpiryMillis", -1);
+
+assertSetParameterSucceeds("internalQueryMaterializedViewMaxIncrementalDocuments", 1);
+assertSetParameterSucceeds("internalQueryMaterializedViewMaxIncrementalDocuments", 0);
+assertSetParameterFails("internalQueryMaterializedViewMaxIncrementalDocuments", -1);
+
 assertSetParameterSucceeds("internalQuerySlotBasedExecutionMaxStaticIndexScanIntervals", 1001);
 assertSetParameterFails("internalQuerySlotBasedExecutionMaxStaticIndexScanIntervals", 0);
 assertSetParameterFails("internalQuerySlotBasedExecutionMaxStaticIndexScanIntervals", -1);
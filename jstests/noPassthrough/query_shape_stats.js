@@ -0,0 +1,68 @@
+/**
+ * Tests that the $queryShapeStats aggregation stage reports the statistics aggregated for each
+ * query shape of a collection.
+ * @tags: [
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.query_shape_stats;
+coll.drop();
+
+assert.commandWorked(coll.insert([{_id: 0, a: 1}, {_id: 1, a: 2}, {_id: 2, a: 2}]));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+function getShapeStats(ns) {
+    return db.getCollection(ns).aggregate([{$queryShapeStats: {}}]).toArray();
+}
+
+// Queries which differ only by their constants share a shape.
+for (let i = 0; i < 3; ++i) {
+    assert.eq(i, coll.find({a: i}).itcount());
+}
+assert.eq(3, coll.find({_id: {$gte: 0}}, {_id: 1}).itcount());
+
+const stats = getShapeStats(coll.getName());
+assert.eq(2, stats.length, stats);
+
+const queryHash = coll.find({a: 1}).explain().queryPlanner.queryHash;
+const [shape] = stats.filter((s) => s.queryHash == queryHash);
+assert(shape, stats);
+assert.eq(coll.getFullName(), shape.ns, shape);
+assert.eq(3, shape.count, shape);
+assert.eq(3, shape.nreturned, shape);
+assert.gte(shape.keysExamined, 3, shape);
+assert.eq(3, shape.docsExamined, shape);
+assert.gte(shape.maxExecMicros * shape.count, shape.totalExecMicros, shape);
+assert.eq(3, shape.latencyHistogram.reduce((total, bucket) => total + bucket.count, 0), shape);
+assert(shape.hasOwnProperty("host"), shape);
+
+// Other collections have their own shapes.
+assert.eq([], getShapeStats("other"));
+
+// The stage takes no parameters and must be first in the pipeline.
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: coll.getName(), pipeline: [{$queryShapeStats: {a: 1}}], cursor: {}}),
+    ErrorCodes.FailedToParse);
+assert.commandFailedWithCode(db.runCommand({
+    aggregate: coll.getName(),
+    pipeline: [{$match: {}}, {$queryShapeStats: {}}],
+    cursor: {}
+}),
+                             40602);
+
+MongoRunner.stopMongod(conn);
+
+// A cache size of zero disables the collection of query shape statistics.
+const disabledConn = MongoRunner.runMongod({setParameter: {queryShapeStatsCacheSize: 0}});
+const disabledColl = disabledConn.getDB("test").query_shape_stats;
+assert.commandWorked(disabledColl.insert({a: 1}));
+assert.eq(1, disabledColl.find({a: 1}).itcount());
+assert.eq([], disabledColl.aggregate([{$queryShapeStats: {}}]).toArray());
+MongoRunner.stopMongod(disabledConn);
+})();
@@ -0,0 +1,79 @@
+/**
+ * Tests that the SBE plan built from a plan cache entry for a parameterized query is reused by the
+ * queries of the same shape with other literals, and returns their results. A plan whose index
+ * bounds can't be rebound is not reused.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {internalQueryEnableSlotBasedExecutionEngine: true},
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_compiled_plan_cache_parameterized;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 1000; ++i) {
+    docs.push({_id: i, a: i % 100, b: i % 7});
+}
+assert.commandWorked(coll.insert(docs));
+
+function getCompiledPlanCacheMetrics() {
+    return db.serverStatus().metrics.query.sbeCompiledPlanCache;
+}
+
+function expectedIds(predicate) {
+    return docs.filter(predicate).map(doc => doc._id).sort((x, y) => x - y);
+}
+
+function runQuery(filter) {
+    return coll.find(filter).toArray().map(doc => doc._id).sort((x, y) => x - y);
+}
+
+// Runs the query shape enough times for its plan cache entry to become active and for the plan
+// built from it to be cached.
+function warmUp(makeFilter) {
+    for (let i = 0; i < 4; ++i) {
+        runQuery(makeFilter(1, 1));
+    }
+}
+
+// Each query of the shape binds its own values to the cached plan, since the index bounds on 'a'
+// are read from the plan's environment.
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+warmUp((a, b) => ({a: a, b: {$gte: b}}));
+
+let before = getCompiledPlanCacheMetrics();
+const kNumQueries = 10;
+for (let i = 0; i < kNumQueries; ++i) {
+    const a = 10 + i, b = i % 4;
+    assert.eq(expectedIds(doc => doc.a === a && doc.b >= b),
+              runQuery({a: a, b: {$gte: b}}),
+              {a: a, b: b});
+}
+let after = getCompiledPlanCacheMetrics();
+assert.eq(before.hits + kNumQueries, after.hits, {before: before, after: after});
+assert.eq(before.misses, after.misses, {before: before, after: after});
+
+// Ranges on both fields of a compound index can't be decomposed into single intervals, so their
+// bounds are baked into the plan, which is therefore never cached for reuse by other queries.
+assert.commandWorked(coll.dropIndexes());
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+warmUp((a, b) => ({a: {$gt: 90 + a}, b: {$gt: b}}));
+
+before = getCompiledPlanCacheMetrics();
+for (let i = 0; i < kNumQueries; ++i) {
+    const a = 90 + (i % 5), b = i % 3;
+    assert.eq(expectedIds(doc => doc.a > a && doc.b > b),
+              runQuery({a: {$gt: a}, b: {$gt: b}}),
+              {a: a, b: b});
+}
+after = getCompiledPlanCacheMetrics();
+assert.eq(before.hits, after.hits, {before: before, after: after});
+
+MongoRunner.stopMongod(conn);
+})();
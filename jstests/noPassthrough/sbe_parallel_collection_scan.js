@@ -0,0 +1,40 @@
+/**
+ * Tests that SBE collection scans run across several threads when 'internalQueryDefaultDOP' is
+ * greater than 1, and return the same documents as the serial scan.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {internalQueryEnableSlotBasedExecutionEngine: true, internalQueryDefaultDOP: 4}
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_parallel_collection_scan;
+coll.drop();
+
+// Insert enough documents for the scan to be split into several record ranges.
+const kNumDocs = 50000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; ++i) {
+    bulk.insert({_id: i, a: i % 10});
+}
+assert.commandWorked(bulk.execute());
+
+function runQueries() {
+    return {
+        all: coll.find().itcount(),
+        filtered: coll.find({a: {$lt: 3}}).toArray().map(doc => doc._id).sort((x, y) => x - y),
+    };
+}
+
+const parallelResults = runQueries();
+assert.eq(kNumDocs, parallelResults.all);
+assert.eq(kNumDocs * 3 / 10, parallelResults.filtered.length);
+
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryDefaultDOP: 1}));
+const serialResults = runQueries();
+assert.eq(serialResults, parallelResults);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,70 @@
+/**
+ * Tests that a collection created with a 'storageTier' has its data files, and those of its
+ * indexes, placed under the 'tier-<storageTier>' directory of the dbpath, and that the tier
+ * survives a restart.
+ * @tags: [
+ *   requires_fcv_49,
+ *   requires_persistence,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+const dbpath = MongoRunner.dataPath + "storage_tier";
+resetDbpath(dbpath);
+
+let conn = MongoRunner.runMongod({dbpath: dbpath});
+assert.neq(null, conn, "mongod was unable to start up");
+let db = conn.getDB("test");
+
+assert.commandFailedWithCode(db.createCollection("bad", {storageTier: ""}), ErrorCodes.BadValue);
+assert.commandFailedWithCode(db.createCollection("bad", {storageTier: "../up"}),
+                             ErrorCodes.BadValue);
+assert.commandFailedWithCode(db.createCollection("bad", {viewOn: "cold", storageTier: "cold"}),
+                             ErrorCodes.InvalidOptions);
+
+assert.commandWorked(db.createCollection("cold", {storageTier: "archive"}));
+assert.commandWorked(db.createCollection("hot"));
+assert.commandWorked(db.cold.insert({_id: 0, a: 1}));
+assert.commandWorked(db.hot.insert({_id: 0, a: 1}));
+assert.commandWorked(db.cold.createIndex({a: 1}));
+
+// The tier can't be changed once the collection exists.
+assert.commandFailed(db.runCommand({collMod: "cold", storageTier: "other"}));
+
+function tierFiles() {
+    return listFiles(dbpath + "/tier-archive").map(file => file.baseName).sort();
+}
+
+function checkTier() {
+    const info = db.getCollectionInfos({name: "cold"})[0];
+    assert.eq("archive", info.options.storageTier, info);
+    assert.eq(undefined, db.getCollectionInfos({name: "hot"})[0].options.storageTier);
+
+    // The collection and both of its indexes live on the tier, the other collection does not.
+    const files = tierFiles();
+    assert.eq(1, files.filter(name => name.startsWith("collection-")).length, files);
+    assert.eq(2, files.filter(name => name.startsWith("index-")).length, files);
+
+    const hotUri = db.hot.stats().wiredTiger.uri;
+    assert(!hotUri.includes("tier-"), hotUri);
+    assert(db.cold.stats().wiredTiger.uri.includes("tier-archive/collection-"));
+    assert.eq({_id: 0, a: 1}, db.cold.findOne({a: 1}));
+}
+
+checkTier();
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod({dbpath: dbpath, noCleanData: true});
+assert.neq(null, conn, "mongod was unable to restart");
+db = conn.getDB("test");
+checkTier();
+
+// Dropping the collection removes its files from the tier.
+assert(db.cold.drop());
+assert.soon(() => tierFiles().filter(name => name.endsWith(".wt")).length == 0,
+            () => tojson(tierFiles()));
+
+MongoRunner.stopMongod(conn);
+})();
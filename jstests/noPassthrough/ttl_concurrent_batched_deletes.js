@@ -0,0 +1,68 @@
+/**
+ * Tests that the TTL monitor removes the expired documents of several collections at the same time
+ * in batches, and reports the last pass over each TTL index in the 'ttlIndexes' serverStatus
+ * section.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter:
+        {ttlMonitorSleepSecs: 1, ttlMonitorMaxConcurrentCollections: 3, ttlMonitorBatchSize: 7}
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const kNumCollections = 5;
+const kNumDocs = 100;
+const expired = new Date(new Date().getTime() - 60 * 1000);
+const notExpired = new Date(new Date().getTime() + 60 * 60 * 1000);
+
+// Stop the TTL monitor while the collections are set up.
+assert.commandWorked(db.adminCommand({setParameter: 1, ttlMonitorEnabled: false}));
+for (let i = 0; i < kNumCollections; ++i) {
+    const coll = db["ttl_" + i];
+    assert.commandWorked(coll.createIndex({x: i % 2 ? -1 : 1}, {expireAfterSeconds: 0}));
+    const docs = [];
+    for (let j = 0; j < kNumDocs; ++j) {
+        docs.push({x: j % 10 ? expired : notExpired});
+    }
+    assert.commandWorked(coll.insert(docs));
+}
+
+const deletedBefore = db.serverStatus().metrics.ttl.deletedDocuments;
+assert.commandWorked(db.adminCommand({setParameter: 1, ttlMonitorEnabled: true}));
+
+assert.soon(() => {
+    for (let i = 0; i < kNumCollections; ++i) {
+        if (db["ttl_" + i].count() != kNumDocs / 10) {
+            return false;
+        }
+    }
+    return true;
+}, "TTL monitor didn't remove the expired documents before timing out");
+
+assert.eq(kNumCollections * kNumDocs * 9 / 10,
+          db.serverStatus().metrics.ttl.deletedDocuments - deletedBefore);
+for (let i = 0; i < kNumCollections; ++i) {
+    assert.eq(kNumDocs / 10, db["ttl_" + i].find({x: notExpired}).itcount());
+}
+
+// The section is only reported when requested, with an entry for each TTL index.
+assert(!db.serverStatus().hasOwnProperty("ttlIndexes"));
+const indexes = db.serverStatus({ttlIndexes: 1}).ttlIndexes.indexes;
+assert.eq(kNumCollections, indexes.length, tojson(indexes));
+for (let index of indexes) {
+    assert.eq(0, index.ns.indexOf("test.ttl_"), tojson(index));
+    assert.gte(index.lagMillis, 0, tojson(index));
+    assert.gte(index.durationMillis, 0, tojson(index));
+}
+
+// Dropped TTL indexes are no longer reported after the next pass.
+assert(db.ttl_0.drop());
+const passes = db.serverStatus().metrics.ttl.passes;
+assert.soon(() => db.serverStatus().metrics.ttl.passes >= passes + 2);
+assert.eq(kNumCollections - 1, db.serverStatus({ttlIndexes: 1}).ttlIndexes.indexes.length);
+
+MongoRunner.stopMongod(conn);
+})();
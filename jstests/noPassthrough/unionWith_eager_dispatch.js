@@ -0,0 +1,75 @@
+/**
+ * Tests that $unionWith returns the same results, in the same order, when it dispatches its
+ * sub-pipeline before reading its input as when it dispatches it once the input is exhausted.
+ *
+ * @tags: [
+ *   requires_replication,
+ *   requires_sharding,
+ * ]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2, mongos: 1, config: 1});
+const dbName = jsTestName();
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+const testDB = st.s.getDB(dbName);
+
+// Twelve monthly collections, alternately sharded and unsharded, plus a view over one of them.
+const colls = [];
+for (let month = 0; month < 12; ++month) {
+    const coll = testDB["month" + month];
+    const docs = [];
+    for (let i = 0; i < 20; ++i) {
+        docs.push({_id: i, month, val: i * month});
+    }
+    assert.commandWorked(coll.insert(docs));
+    if (month % 2 == 0) {
+        st.shardColl(coll, {_id: 1}, {_id: 10}, {_id: 10}, dbName);
+    }
+    colls.push(coll);
+}
+assert.commandWorked(
+    testDB.createView("monthView", colls[1].getName(), [{$match: {val: {$gt: 5}}}]));
+
+function setEagerDispatch(value) {
+    for (let conn of [st.rs0.getPrimary(), st.rs1.getPrimary()]) {
+        assert.commandWorked(conn.adminCommand(
+            {setParameter: 1, internalQueryUnionWithEagerSubPipelineDispatch: value}));
+    }
+}
+
+function runUnion(extraStages) {
+    const pipeline =
+        colls.slice(1).map((coll) => ({$unionWith: coll.getName()})).concat(extraStages);
+    return colls[0].aggregate(pipeline).toArray();
+}
+
+function assertSameResults(extraStages) {
+    setEagerDispatch(false);
+    const expected = runUnion(extraStages);
+    setEagerDispatch(true);
+    const actual = runUnion(extraStages);
+    assert.eq(expected, actual);
+}
+
+// The branches are returned in order.
+setEagerDispatch(true);
+const months = runUnion([]).map((doc) => doc.month);
+assert.eq(12 * 20, months.length);
+for (let i = 1; i < months.length; ++i) {
+    assert.lte(months[i - 1], months[i], tojson(months));
+}
+assertSameResults([{$group: {_id: "$month", count: {$sum: 1}}}, {$sort: {_id: 1}}]);
+assertSameResults([{$sort: {month: 1, _id: 1}}]);
+
+// A $limit which is satisfied by the first branch disposes of the dispatched ones.
+assert.eq(5, runUnion([{$limit: 5}]).length);
+
+// A sub-pipeline over a view is resolved before it is dispatched.
+assertSameResults([{$unionWith: {coll: "monthView", pipeline: [{$match: {_id: {$lt: 15}}}]}},
+                   {$sort: {month: 1, _id: 1}}]);
+
+st.stop();
+}());
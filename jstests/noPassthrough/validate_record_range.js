@@ -0,0 +1,54 @@
+/**
+ * Tests that the validate command can validate a collection incrementally, a range of records per
+ * run, with the 'maxRecords' and 'resumeAfter' options.
+ *
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.validate_record_range;
+
+assert.commandWorked(coll.insert(Array.from({length: 25}, (_, i) => ({_id: i, a: i % 4}))));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+function validate(options) {
+    return assert.commandWorked(db.runCommand(Object.assign({validate: coll.getName()}, options)));
+}
+
+for (let background of [false, true]) {
+    let nrecords = [];
+    let options = {maxRecords: 10, background};
+    while (true) {
+        const res = validate(options);
+        assert(res.valid, res);
+        nrecords.push(res.nrecords);
+        if (!res.hasOwnProperty("resumeAfter")) {
+            break;
+        }
+        options.resumeAfter = res.resumeAfter;
+    }
+    assert.eq([10, 10, 5], nrecords);
+}
+
+// Validation resumes after a record which has since been deleted.
+let res = validate({maxRecords: 10});
+assert.commandWorked(coll.remove({_id: 9}));
+res = validate({resumeAfter: res.resumeAfter});
+assert(res.valid, res);
+assert.eq(15, res.nrecords, res);
+assert(!res.hasOwnProperty("resumeAfter"), res);
+
+// A range can't be combined with full validation or repair, and its bounds must be positive.
+assert.commandFailedWithCode(db.runCommand({validate: coll.getName(), maxRecords: 1, full: true}),
+                             ErrorCodes.CommandNotSupported);
+assert.commandFailedWithCode(
+    db.runCommand({validate: coll.getName(), maxRecords: 1, enforceFastCount: true}),
+    ErrorCodes.CommandNotSupported);
+assert.commandFailedWithCode(db.runCommand({validate: coll.getName(), maxRecords: 0}), 5843133);
+assert.commandFailedWithCode(db.runCommand({validate: coll.getName(), resumeAfter: "x"}), 5843132);
+
+MongoRunner.stopMongod(conn);
+})();
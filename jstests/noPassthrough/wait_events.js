@@ -0,0 +1,63 @@
+/**
+ * Tests that the time operations spend waiting for locks is reported in currentOp, in the
+ * profiler and in serverStatus.
+ * @tags: [
+ *   requires_fcv_49,
+ *   requires_profiling,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/parallel_shell_helpers.js");  // For funWithArgs.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.wait_events;
+coll.drop();
+assert.commandWorked(db.setProfilingLevel(2));
+
+function getLockWaits() {
+    return assert.commandWorked(db.adminCommand({serverStatus: 1})).waitEvents.lock;
+}
+const before = getLockWaits();
+
+// Hold the global lock in exclusive mode, so that the insert has to wait for it.
+const awaitSleep = startParallelShell(() => {
+    assert.commandWorked(
+        db.adminCommand({sleep: 1, millis: 3000, lock: "w", $comment: "wait_events sleep"}));
+}, conn.port);
+assert.soon(() => db.getSiblingDB("admin")
+                      .aggregate([
+                          {$currentOp: {}},
+                          {$match: {"command.$comment": "wait_events sleep"}},
+                      ])
+                      .itcount() == 1);
+
+const awaitInsert = startParallelShell(
+    funWithArgs(function(collName) {
+        assert.commandWorked(db.getCollection(collName).insert({_id: 0}));
+    }, coll.getName()), conn.port);
+
+// The wait is charged to the insert while it waits.
+assert.soon(() => db.getSiblingDB("admin")
+                      .aggregate([
+                          {$currentOp: {}},
+                          {$match: {ns: coll.getFullName(), "waitTimeMicros.lock": {$gt: 0}}},
+                      ])
+                      .itcount() == 1);
+
+awaitSleep();
+awaitInsert();
+
+const profileEntry = db.system.profile.findOne({op: "insert", ns: coll.getFullName()});
+assert.neq(null, profileEntry);
+assert.gt(profileEntry.waitTimeMicros.lock, 0, profileEntry);
+
+const after = getLockWaits();
+assert.gt(after.count, before.count, after);
+assert.gt(after.totalMicros, before.totalMicros, after);
+
+MongoRunner.stopMongod(conn);
+})();
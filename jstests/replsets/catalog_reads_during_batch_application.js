@@ -0,0 +1,44 @@
+/**
+ * Tests that commands which only read the catalog can run on a secondary while it is applying an
+ * oplog batch, rather than waiting behind the ParallelBatchWriterMode lock.
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+
+const rst = new ReplSetTest({nodes: [{}, {rsConfig: {priority: 0}}]});
+rst.startSet();
+rst.initiate();
+
+const dbName = "test";
+const primaryDB = rst.getPrimary().getDB(dbName);
+const secondary = rst.getSecondary();
+const secondaryDB = secondary.getDB(dbName);
+secondaryDB.getMongo().setSecondaryOk();
+
+assert.commandWorked(primaryDB.coll.insert({_id: 0}));
+rst.awaitReplication();
+
+// Hold the PBWM lock in exclusive mode for the next batch.
+const fp = configureFailPoint(secondary, "pauseBatchApplicationBeforeCompletion");
+assert.commandWorked(primaryDB.coll.insert({_id: 1}));
+fp.wait();
+
+const kMaxTimeMS = 10 * 1000;
+let res = assert.commandWorked(secondaryDB.runCommand({listCollections: 1, maxTimeMS: kMaxTimeMS}));
+assert.eq(["coll"], res.cursor.firstBatch.map(collection => collection.name), res);
+res = assert.commandWorked(secondaryDB.adminCommand({listDatabases: 1, maxTimeMS: kMaxTimeMS}));
+assert(res.databases.some(database => database.name === dbName), res);
+assert.commandWorked(secondaryDB.runCommand({dbStats: 1, maxTimeMS: kMaxTimeMS}));
+
+// Reads at lastApplied don't see the batch being applied.
+assert.eq([{_id: 0}], secondaryDB.coll.find().maxTimeMS(kMaxTimeMS).toArray());
+
+fp.off();
+rst.awaitReplication();
+assert.eq(2, secondaryDB.coll.find().itcount());
+
+rst.stopSet();
+})();
@@ -0,0 +1,70 @@
+/**
+ * Tests that with 'internalInsertGroupOplogEntries' enabled, the documents of an insert batch are
+ * logged as the operations of a single applyOps oplog entry, which secondaries and change streams
+ * expand back into the individual inserts.
+ *
+ * @tags: [
+ *   requires_fcv_49,
+ *   requires_majority_read_concern,
+ *   uses_change_streams,
+ * ]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: 2,
+    nodeOptions: {setParameter: {internalInsertGroupOplogEntries: true}},
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const coll = db.insert_group_oplog_entries;
+const oplog = primary.getDB("local").oplog.rs;
+assert.commandWorked(db.createCollection(coll.getName()));
+
+const changeStream = coll.watch();
+
+const docs = [];
+for (let i = 0; i < 10; ++i) {
+    docs.push({_id: i, x: i});
+}
+assert.commandWorked(coll.insert(docs));
+
+// The batch is logged in one applyOps entry, without any insert entries of its own.
+const entries = oplog.find({"o.applyOps.ns": coll.getFullName()}).toArray();
+assert.eq(1, entries.length, entries);
+assert.eq(docs, entries[0].o.applyOps.map(op => op.o), entries);
+assert(!entries[0].hasOwnProperty("lsid"), entries);
+assert.eq(0, oplog.find({op: "i", ns: coll.getFullName()}).itcount());
+
+// A single document is still logged on its own.
+assert.commandWorked(coll.insert({_id: 10, x: 10}));
+assert.eq(1, oplog.find({op: "i", ns: coll.getFullName()}).itcount());
+
+// Retryable writes keep one entry per statement, so that each can be looked up on retry.
+const session = primary.startSession({retryWrites: true});
+assert.commandWorked(session.getDatabase("test")[coll.getName()].insert(
+    [{_id: 11, x: 11}, {_id: 12, x: 12}]));
+assert.eq(3, oplog.find({op: "i", ns: coll.getFullName()}).itcount());
+assert.eq(1, oplog.find({"o.applyOps.ns": coll.getFullName()}).itcount());
+
+// The secondary expands the entry into the individual inserts.
+rst.awaitReplication();
+const secondaryColl = rst.getSecondary().getDB("test")[coll.getName()];
+assert.eq(coll.find().sort({_id: 1}).toArray(), secondaryColl.find().sort({_id: 1}).toArray());
+
+// A change stream reports each of the grouped inserts.
+for (let i = 0; i <= 12; ++i) {
+    assert.soon(() => changeStream.hasNext());
+    const event = changeStream.next();
+    assert.eq("insert", event.operationType, event);
+    assert.eq({_id: i, x: i}, event.fullDocument, event);
+    assert(!event.hasOwnProperty("lsid") || i > 10, event);
+}
+changeStream.close();
+
+rst.stopSet();
+})();
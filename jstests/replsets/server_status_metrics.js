@@ -45,6 +45,8 @@ function _testSecondaryMetricsHelper(secondary, opCount, baseOpsApplied, baseOps
 
     assert.gt(ss.metrics.repl.syncSource.numSelections, 0, "num selections not incremented");
     assert.gt(ss.metrics.repl.syncSource.numTimesChoseDifferent, 0, "no new sync source chosen");
+    assert.gt(ss.metrics.repl.syncSource.numResumes, 0, "replication never resumed");
+    assert(ss.metrics.repl.syncSource.totalResumeMillis >= 0, "resume time missing");
 
     assert(ss.metrics.repl.buffer.count >= 0, "buffer count missing");
     assert(ss.metrics.repl.buffer.sizeBytes >= 0, "size (bytes)] missing");
@@ -56,6 +58,17 @@ function _testSecondaryMetricsHelper(secondary, opCount, baseOpsApplied, baseOps
     assert(ss.metrics.repl.apply.batches.num > 0, "no batches");
     assert(ss.metrics.repl.apply.batches.totalMillis >= 0, "missing batch time");
     assert.eq(ss.metrics.repl.apply.ops, opCount + baseOpsApplied, "wrong number of applied ops");
+
+    const stages = ss.metrics.repl.apply.stages;
+    for (let stage of ["waitForBatchMicros",
+                       "fillWriterVectorsMicros",
+                       "writeOplogWaitMicros",
+                       "applyMicros",
+                       "finalizeMicros",
+                       "journalFlushMicros"]) {
+        assert(stages[stage] >= 0, "missing " + stage + " apply stage time");
+    }
+    assert.gt(stages.applyMicros, 0, "no apply stage time");
 }
 
 // Metrics are racy, e.g. repl.buffer.count could over- or under-reported briefly. Retry on error.
@@ -0,0 +1,60 @@
+/**
+ * Tests that chunks get split as they grow when the chunk splitter estimates split points from a
+ * sample of the collection instead of scanning the shard key index over the chunk.
+ *
+ * @tags: [
+ *   requires_fcv_49,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+'use strict';
+load('jstests/sharding/autosplit_include.js');
+
+const st = new ShardingTest({
+    shards: 1,
+    mongos: 1,
+    other: {
+        enableAutoSplit: true,
+        chunkSize: 1,
+        shardOptions: {setParameter: {autoSplitSampleSize: 1000}},
+    },
+});
+
+const dbName = 'test';
+const ns = dbName + '.foo';
+assert.commandWorked(st.s0.adminCommand({enableSharding: dbName}));
+assert.commandWorked(st.s0.adminCommand({shardCollection: ns, key: {num: 1}}));
+
+const coll = st.s0.getCollection(ns);
+const bigString = 'x'.repeat(10 * 1024);
+
+// Insert in random order so that every chunk keeps receiving writes as it is split.
+let nums = [];
+for (let i = 0; i < 1000; ++i) {
+    nums.push(i);
+}
+nums.sort(() => Math.random() - 0.5);
+
+for (let batch = 0; batch < 10; ++batch) {
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let num of nums.slice(batch * 100, (batch + 1) * 100)) {
+        bulk.insert({num: num, s: bigString});
+    }
+    assert.commandWorked(bulk.execute());
+    waitForOngoingChunkSplits(st);
+}
+
+const chunks = st.config.chunks.find({ns: ns}).sort({min: 1}).toArray();
+assert.gt(chunks.length, 1, chunks);
+
+// The chunks must still cover the whole key space without gaps, and every document must be found.
+assert.eq({num: MinKey}, chunks[0].min, chunks);
+assert.eq({num: MaxKey}, chunks[chunks.length - 1].max, chunks);
+for (let i = 1; i < chunks.length; ++i) {
+    assert.eq(chunks[i - 1].max, chunks[i].min, chunks);
+}
+assert.eq(1000, coll.find().itcount());
+
+st.stop();
+})();
@@ -0,0 +1,62 @@
+/**
+ * Tests that a $lookup between two collections sharded on the same key, whose chunks are owned by
+ * the same shards, returns the same results whether the shards read the foreign collection locally
+ * or through the router code path, and that orphaned foreign documents are filtered out.
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+load("jstests/noPassthrough/libs/server_parameter_helpers.js");  // For setParameterOnAllHosts.
+load("jstests/libs/discover_topology.js");                       // For findNonConfigNodes.
+
+const st = new ShardingTest({mongos: 1, shards: 2});
+const dbName = "test";
+const mongosDB = st.s.getDB(dbName);
+
+setParameterOnAllHosts(
+    DiscoverTopology.findNonConfigNodes(st.s), "internalQueryAllowShardedLookup", true);
+
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+
+// Both collections are split at {key: 0}, with the chunk [0, MaxKey) on shard1.
+for (let collName of ["local", "foreign"]) {
+    st.shardColl(collName, {key: 1}, {key: 0}, {key: 0}, dbName, true);
+}
+
+const localColl = mongosDB.local;
+const foreignColl = mongosDB.foreign;
+for (let i = -10; i < 10; ++i) {
+    assert.commandWorked(localColl.insert({_id: i, key: i}));
+    assert.commandWorked(foreignColl.insert({_id: 2 * i, key: i}));
+    assert.commandWorked(foreignColl.insert({_id: 2 * i + 1, key: i}));
+}
+
+// An orphaned foreign document on shard1, in the range owned by shard0, must not be joined.
+assert.commandWorked(st.shard1.getDB(dbName).foreign.insert({_id: 1000, key: -5}));
+
+const pipeline = [
+    {$lookup: {from: "foreign", localField: "key", foreignField: "key", as: "joined"}},
+    {$sort: {_id: 1}},
+];
+
+function runLookup(readLocally) {
+    setParameterOnAllHosts(DiscoverTopology.findNonConfigNodes(st.s),
+                           "internalQueryReadCoLocatedSubPipelinesLocally",
+                           readLocally);
+    return localColl.aggregate(pipeline).toArray();
+}
+
+const localResults = runLookup(true);
+assert.eq(20, localResults.length, localResults);
+for (let result of localResults) {
+    assert.eq(2, result.joined.length, result);
+    for (let joined of result.joined) {
+        assert.eq(result.key, joined.key, result);
+    }
+}
+assert.eq(runLookup(false), localResults);
+
+st.stop();
+})();
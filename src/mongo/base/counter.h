@@ -29,9 +29,11 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 
 #include "mongo/platform/atomic_word.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 /**
@@ -65,4 +67,69 @@ public:
 private:
     AtomicWord<long long> _counter;
 };
+
+/**
+ * A 64bit counter for values incremented by many threads at once, such as per-operation metrics.
+ *
+ * The count is spread over several cache-aligned stripes, and each thread increments the stripe it
+ * was assigned on first use, so threads running on different cores rarely write to the same cache
+ * line. Reads sum all the stripes: they are more expensive than increments, and concurrent
+ * increments may or may not be included.
+ */
+class StripedCounter64 {
+public:
+    static constexpr size_t kNumStripes = 16;
+
+    /** Atomically increment the calling thread's stripe. */
+    void increment(uint64_t n = 1) {
+        incrementStripe(n);
+    }
+
+    /** Atomically decrement the calling thread's stripe. */
+    void decrement(uint64_t n = 1) {
+        _stripes[_stripeIndex()].fetchAndAddRelaxed(-static_cast<long long>(n));
+    }
+
+    /**
+     * Increments the calling thread's stripe, and returns its previous value. This lets hot paths
+     * enforce a bound on the counter without reading the other stripes.
+     */
+    long long incrementStripe(uint64_t n) {
+        return _stripes[_stripeIndex()].fetchAndAddRelaxed(n);
+    }
+
+    /** Return the current value */
+    long long get() const {
+        long long sum = 0;
+        for (const auto& stripe : _stripes) {
+            sum += stripe.loadRelaxed();
+        }
+        return sum;
+    }
+
+    /** Same as get(), for the users of the AtomicWord interface. */
+    long long load() const {
+        return get();
+    }
+
+    operator long long() const {
+        return get();
+    }
+
+    /** Resets the counter to zero. Concurrent increments may survive the reset. */
+    void reset() {
+        for (auto& stripe : _stripes) {
+            stripe.store(0);
+        }
+    }
+
+private:
+    static size_t _stripeIndex() {
+        static AtomicWord<unsigned> nextStripe;
+        thread_local const size_t stripe = nextStripe.fetchAndAddRelaxed(1) % kNumStripes;
+        return stripe;
+    }
+
+    std::array<CacheAligned<AtomicWord<long long>>, kNumStripes> _stripes{};
+};
 }  // namespace mongo
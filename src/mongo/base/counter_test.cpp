@@ -34,6 +34,7 @@
 #include <iostream>
 
 #include "mongo/base/counter.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -55,5 +56,38 @@ TEST(CounterTest, Test1) {
     ASSERT_EQUALS(static_cast<long long>(c), 0);
 }
 
+TEST(StripedCounterTest, Test1) {
+    StripedCounter64 c;
+    ASSERT_EQUALS(c.get(), 0);
+    c.increment();
+    ASSERT_EQUALS(c.get(), 1);
+    c.decrement(3);
+    ASSERT_EQUALS(c.get(), -2);
+    ASSERT_EQUALS(c.incrementStripe(5), -2);
+    ASSERT_EQUALS(static_cast<long long>(c), 3);
+    c.reset();
+    ASSERT_EQUALS(c.load(), 0);
+}
+
+TEST(StripedCounterTest, SumsTheIncrementsOfAllThreads) {
+    constexpr int kThreads = 2 * StripedCounter64::kNumStripes;
+    constexpr int kIncrements = 1000;
+
+    StripedCounter64 c;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kIncrements; ++j) {
+                c.increment();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQUALS(c.get(), kThreads * kIncrements);
+}
+
 }  // namespace
 }  // namespace mongo
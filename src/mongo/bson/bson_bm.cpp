@@ -33,6 +33,8 @@
 
 #include <benchmark/benchmark.h>
 
+#include "mongo/bson/bson_field_index.h"
+#include "mongo/bson/bson_field_scan.h"
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/log.h"
@@ -112,8 +114,91 @@ void BM_validate(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+// A wide document, with the fields that are looked up near its end.
+BSONObj buildWideObj(int numFields) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < numFields; ++i) {
+        builder.append(fmt::format("field_{}", i), i);
+    }
+    return builder.obj();
+}
+
+// Validates documents whose field names are of the given length, which is where the cost of
+// scanning for NUL terminators dominates.
+void BM_validateFieldNames(benchmark::State& state) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 100; ++i) {
+        builder.append(fmt::format("{:x<{}}", i, state.range(0)), i);
+    }
+    BSONObj obj = builder.obj();
+    invariant(validateBSON(obj.objdata(), obj.objsize()).isOK());
+
+    size_t totalSize = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize()));
+        totalSize += obj.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
+void BM_getFieldWide(benchmark::State& state) {
+    const auto numFields = state.range(0);
+    BSONObj obj = buildWideObj(numFields);
+    const auto name = fmt::format("field_{}", numFields - 1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(obj.getField(name));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Looks up every field of a wide document, both by scanning and through a BSONFieldIndex, which is
+// built anew for each pass as it would be for each document matched.
+void BM_getEveryFieldWide(benchmark::State& state) {
+    const auto numFields = state.range(0);
+    BSONObj obj = buildWideObj(numFields);
+    std::vector<std::string> names;
+    for (auto i = 0; i < numFields; ++i) {
+        names.push_back(fmt::format("field_{}", i));
+    }
+
+    for (auto _ : state) {
+        if (state.range(1)) {
+            BSONFieldIndex index(obj);
+            for (auto&& name : names) {
+                benchmark::DoNotOptimize(index.getField(name));
+            }
+        } else {
+            for (auto&& name : names) {
+                benchmark::DoNotOptimize(obj.getField(name));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numFields);
+}
+
+void BM_fieldScannerWide(benchmark::State& state) {
+    const auto numFields = state.range(0);
+    BSONObj obj = buildWideObj(numFields);
+    std::vector<std::string> names;
+    for (auto i = numFields - 5; i < numFields; ++i) {
+        names.push_back(fmt::format("field_{}", i));
+    }
+    BSONFieldScanner scanner(names);
+    std::vector<const char*> elements(scanner.numFields());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scanner.scan(obj.objdata(), elements.data()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateFieldNames)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_getFieldWide)->Arg(10)->Arg(80);
+BENCHMARK(BM_fieldScannerWide)->Arg(10)->Arg(80);
+BENCHMARK(BM_getEveryFieldWide)->Ranges({{10, 2000}, {0, 1}});
 
 }  // namespace mongo
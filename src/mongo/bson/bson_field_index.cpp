@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+uint32_t hashFieldName(StringData name) {
+    return static_cast<uint32_t>(StringMapHasher{}(name));
+}
+
+}  // namespace
+
+void BSONFieldIndex::_build() const {
+    _built = true;
+
+    std::vector<Slot> elements;
+    for (auto&& elem : _obj) {
+        elements.push_back({hashFieldName(elem.fieldNameStringData()),
+                            static_cast<uint32_t>(elem.rawdata() - _obj.objdata())});
+    }
+    if (elements.size() < kMinIndexedFields) {
+        return;
+    }
+
+    size_t capacity = 2 * kMinIndexedFields;
+    while (capacity < 2 * elements.size()) {
+        capacity *= 2;
+    }
+    _slots.resize(capacity);
+
+    const size_t mask = capacity - 1;
+    for (auto&& elem : elements) {
+        auto name = BSONElement(_obj.objdata() + elem.offset).fieldNameStringData();
+        for (size_t i = elem.hash & mask;; i = (i + 1) & mask) {
+            auto& slot = _slots[i];
+            if (!slot.offset) {
+                slot = elem;
+                break;
+            }
+            // Keep the first of duplicated fields, like a scan would find.
+            if (slot.hash == elem.hash &&
+                BSONElement(_obj.objdata() + slot.offset).fieldNameStringData() == name) {
+                break;
+            }
+        }
+    }
+}
+
+BSONElement BSONFieldIndex::getField(StringData name) const {
+    if (!_built && ++_numLookups >= kMinLookups && _obj.objsize() >= kMinIndexedSize) {
+        _build();
+    }
+    if (_slots.empty()) {
+        return _obj.getField(name);
+    }
+
+    const auto hash = hashFieldName(name);
+    const size_t mask = _slots.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        auto& slot = _slots[i];
+        if (!slot.offset) {
+            return BSONElement();
+        }
+        if (slot.hash == hash) {
+            BSONElement elem(_obj.objdata() + slot.offset);
+            if (elem.fieldNameStringData() == name) {
+                return elem;
+            }
+        }
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * Answers repeated top-level field lookups on a single BSON object. Once enough lookups have been
+ * made on a large enough object, a hash table from field name to element offset is built in one
+ * pass over the object, after which each lookup costs a hash and usually a single name compare
+ * rather than a scan of the preceding elements. Small objects, and objects looked up only once,
+ * are never indexed and behave exactly like BSONObj::getField().
+ *
+ * As with BSONObj::getField(), only the first occurrence of a duplicated field is found. Not
+ * thread safe: the index is built lazily by getField().
+ */
+class BSONFieldIndex {
+public:
+    explicit BSONFieldIndex(BSONObj obj) : _obj(std::move(obj)) {}
+
+    /**
+     * Returns the first element named 'name', or an EOO element if there is none.
+     */
+    BSONElement getField(StringData name) const;
+
+    const BSONObj& obj() const {
+        return _obj;
+    }
+
+    /**
+     * Whether the lookups made so far have caused the hash table to be built.
+     */
+    bool isIndexed() const {
+        return !_slots.empty();
+    }
+
+    // The object is only indexed on this many lookups, and only if it is at least kMinIndexedSize
+    // bytes with at least kMinIndexedFields fields, below which scanning is as fast.
+    static constexpr int kMinLookups = 2;
+    static constexpr int kMinIndexedSize = 1024;
+    static constexpr size_t kMinIndexedFields = 16;
+
+private:
+    struct Slot {
+        uint32_t hash;
+        uint32_t offset;  // From objdata(). Elements never start at 0, so 0 marks an empty slot.
+    };
+
+    void _build() const;
+
+    BSONObj _obj;
+
+    mutable int _numLookups = 0;
+    mutable bool _built = false;
+
+    // Open-addressed with linear probing, sized to a power of two at most half full.
+    mutable std::vector<Slot> _slots;
+};
+
+}  // namespace mongo
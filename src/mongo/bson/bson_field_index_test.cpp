@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+#include <string>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj buildWideObj(int numFields) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < numFields; ++i) {
+        builder.append("field_" + std::to_string(i), std::string(20, 'x'));
+    }
+    builder.append("", -1);
+    builder.append("field_0", -2);
+    return builder.obj();
+}
+
+void assertMatchesGetField(const BSONFieldIndex& index, StringData name) {
+    auto expected = index.obj().getField(name);
+    auto found = index.getField(name);
+    ASSERT_EQ(expected.rawdata(), found.rawdata());
+    ASSERT_EQ(expected.eoo(), found.eoo());
+}
+
+TEST(BSONFieldIndexTest, LookupsMatchGetFieldOnWideObject) {
+    BSONFieldIndex index(buildWideObj(200));
+    for (auto&& elem : index.obj()) {
+        assertMatchesGetField(index, elem.fieldNameStringData());
+    }
+    ASSERT(index.isIndexed());
+
+    // Only the first of duplicated fields is found.
+    ASSERT_EQ(index.getField("field_0").String(), std::string(20, 'x'));
+
+    assertMatchesGetField(index, "field_");
+    assertMatchesGetField(index, "field_200");
+    assertMatchesGetField(index, "missing");
+    assertMatchesGetField(index, StringData("field_1\0", 8));
+}
+
+TEST(BSONFieldIndexTest, SmallObjectsAreNotIndexed) {
+    BSONFieldIndex index(BSON("a" << 1 << "b" << std::string(2000, 'x') << "a" << 3));
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(index.getField("a").numberInt(), 1);
+        ASSERT(index.getField("c").eoo());
+    }
+    ASSERT_FALSE(index.isIndexed());
+}
+
+TEST(BSONFieldIndexTest, SingleLookupDoesNotBuildIndex) {
+    BSONFieldIndex index(buildWideObj(200));
+    ASSERT_EQ(index.getField("field_199").String(), std::string(20, 'x'));
+    ASSERT_FALSE(index.isIndexed());
+    ASSERT_EQ(index.getField("field_198").String(), std::string(20, 'x'));
+    ASSERT(index.isIndexed());
+}
+
+TEST(BSONFieldIndexTest, EmptyObject) {
+    BSONFieldIndex index{BSONObj()};
+    ASSERT(index.getField("a").eoo());
+    ASSERT(index.getField("").eoo());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_scan.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * The field name of the element currently being examined, along with the vector holding its
+ * first bytes when it could be loaded in one go.
+ */
+struct FieldNameProbe {
+    FieldNameProbe(const char* name, const char* end) : name(name) {
+#if defined(__SSE2__)
+        if (name + BSONFieldScanner::kVectorWidth <= end) {
+            loaded = true;
+            chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(name));
+            uint32_t zeros = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_setzero_si128()));
+            size = zeros ? countTrailingZeros64(zeros)
+                         : BSONFieldScanner::kVectorWidth +
+                    std::strlen(name + BSONFieldScanner::kVectorWidth);
+            return;
+        }
+#endif
+        size = std::strlen(name);
+    }
+
+    bool matches(const BSONFieldScanner::Pattern& pattern, StringData fieldName) const {
+        if (pattern.size != size || !pattern.matchable) {
+            return false;
+        }
+#if defined(__SSE2__)
+        if (loaded && pattern.vectorizable) {
+            uint32_t equal = _mm_movemask_epi8(_mm_cmpeq_epi8(
+                chunk, _mm_load_si128(reinterpret_cast<const __m128i*>(pattern.bytes))));
+            return (equal & pattern.mask) == pattern.mask;
+        }
+#endif
+        return std::memcmp(name, fieldName.rawData(), size) == 0;
+    }
+
+    const char* name;
+    size_t size;
+#if defined(__SSE2__)
+    bool loaded{false};
+    __m128i chunk;
+#endif
+};
+
+const char* objectEnd(const char* objdata) {
+    return objdata + ConstDataView(objdata).read<LittleEndian<int32_t>>();
+}
+
+const char* nextElement(const char* elem, size_t fieldNameSize) {
+    return elem +
+        BSONElement(elem, fieldNameSize + 1, -1, BSONElement::CachedSizeTag{}).size();
+}
+
+}  // namespace
+
+BSONFieldScanner::Pattern::Pattern(StringData name) : size(name.size()) {
+    std::memset(bytes, 0, sizeof(bytes));
+    matchable = name.find('\0') == std::string::npos;
+    vectorizable = matchable && name.size() < kVectorWidth;
+    if (vectorizable) {
+        std::memcpy(bytes, name.rawData(), name.size());
+        mask = (1u << (name.size() + 1)) - 1;
+    }
+}
+
+BSONFieldScanner::BSONFieldScanner(std::vector<std::string> fieldNames)
+    : _fieldNames(std::move(fieldNames)) {
+    _patterns.reserve(_fieldNames.size());
+    for (auto&& name : _fieldNames) {
+        _patterns.emplace_back(name);
+    }
+}
+
+const char* BSONFieldScanner::findField(const char* objdata, StringData fieldName) {
+    const Pattern pattern(fieldName);
+    if (!pattern.matchable) {
+        return nullptr;
+    }
+
+    const auto end = objectEnd(objdata);
+    for (auto elem = objdata + 4; elem < end && *elem != EOO;) {
+        FieldNameProbe probe(elem + 1, end);
+        if (probe.matches(pattern, fieldName)) {
+            return elem;
+        }
+        elem = nextElement(elem, probe.size);
+    }
+    return nullptr;
+}
+
+size_t BSONFieldScanner::scan(const char* objdata, const char** elements) const {
+    const auto numWanted = _fieldNames.size();
+    std::fill(elements, elements + numWanted, nullptr);
+
+    size_t numFound = 0;
+    if (numWanted == 0) {
+        return numFound;
+    }
+
+    const auto end = objectEnd(objdata);
+    for (auto elem = objdata + 4; elem < end && *elem != EOO;) {
+        FieldNameProbe probe(elem + 1, end);
+        for (size_t idx = 0; idx < numWanted; ++idx) {
+            if (!elements[idx] && probe.matches(_patterns[idx], _fieldNames[idx])) {
+                elements[idx] = elem;
+                if (++numFound == numWanted) {
+                    return numFound;
+                }
+            }
+        }
+        elem = nextElement(elem, probe.size);
+    }
+    return numFound;
+}
+
+}  // namespace mongo
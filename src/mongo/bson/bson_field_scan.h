@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * Locates a fixed set of top-level fields in BSON objects, finding all of them in a single pass
+ * over each object's elements and stopping as soon as the last one has been found.
+ *
+ * Where SSE2 is available, field names are examined 16 bytes at a time: one unaligned load of an
+ * element's field name yields both its length and whether it equals each wanted name of that
+ * length, without a separate strlen and compare. Names that do not fit in 16 bytes, and elements
+ * too close to the end of the object for a full load, fall back to scalar code.
+ *
+ * As with BSONObj::getField(), only the first occurrence of a duplicated field is reported.
+ */
+class BSONFieldScanner {
+public:
+    explicit BSONFieldScanner(std::vector<std::string> fieldNames);
+
+    /**
+     * Returns a pointer to the first element named 'fieldName' in the BSON object 'objdata', or
+     * nullptr if there is no such element.
+     */
+    static const char* findField(const char* objdata, StringData fieldName);
+
+    /**
+     * Sets 'elements[i]' to the element named fieldName(i) in the BSON object 'objdata', or to
+     * nullptr if it is absent. 'elements' must have room for numFields() entries. Returns the
+     * number of fields that were found.
+     */
+    size_t scan(const char* objdata, const char** elements) const;
+
+    size_t numFields() const {
+        return _fieldNames.size();
+    }
+
+    const std::string& fieldName(size_t idx) const {
+        return _fieldNames[idx];
+    }
+
+    /**
+     * Field names strictly shorter than this, so that the name and its terminating NUL fit in a
+     * single vector, are compared with vector instructions.
+     */
+    static constexpr size_t kVectorWidth = 16;
+
+    /**
+     * A wanted field name laid out for comparison against the raw bytes of an element's name.
+     */
+    struct Pattern {
+        explicit Pattern(StringData name);
+
+        // The name followed by its NUL terminator and zero padding. Only meaningful when
+        // 'vectorizable' is set.
+        alignas(kVectorWidth) char bytes[kVectorWidth];
+
+        // The bits of a byte-wise comparison mask that must be set for the name to match,
+        // covering the name and its NUL terminator.
+        uint32_t mask{0};
+
+        uint32_t size{0};
+
+        // A name with an embedded NUL byte can never equal a BSON field name.
+        bool matchable{true};
+
+        bool vectorizable{false};
+    };
+
+private:
+    std::vector<std::string> _fieldNames;
+    std::vector<Pattern> _patterns;
+};
+
+}  // namespace mongo
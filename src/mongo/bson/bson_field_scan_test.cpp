@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_scan.h"
+
+#include <string>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+// Builds an object whose field names cover short names, names that need more than one vector, and
+// elements that end too close to the end of the object to be loaded as a whole vector.
+BSONObj buildObj() {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 40; ++i) {
+        std::string name = "f" + std::to_string(i);
+        if (i % 5 == 0) {
+            name += "_with_a_name_longer_than_a_vector";
+        }
+        builder.append(name, i);
+    }
+    builder.append("", -1);
+    builder.append("z", -2);
+    return builder.obj();
+}
+
+TEST(BSONFieldScannerTest, FindFieldMatchesGetFieldIteration) {
+    BSONObj obj = buildObj();
+    for (auto&& elem : obj) {
+        auto found = BSONFieldScanner::findField(obj.objdata(), elem.fieldNameStringData());
+        ASSERT_EQ(found, elem.rawdata());
+    }
+}
+
+TEST(BSONFieldScannerTest, FindFieldMissing) {
+    BSONObj obj = buildObj();
+    ASSERT_EQ(BSONFieldScanner::findField(obj.objdata(), "f1_"), nullptr);
+    ASSERT_EQ(BSONFieldScanner::findField(obj.objdata(), "f"), nullptr);
+    ASSERT_EQ(BSONFieldScanner::findField(obj.objdata(), "zz"), nullptr);
+    ASSERT_EQ(BSONFieldScanner::findField(obj.objdata(), StringData("z\0", 2)), nullptr);
+    ASSERT_EQ(BSONFieldScanner::findField(BSONObj().objdata(), "z"), nullptr);
+}
+
+TEST(BSONFieldScannerTest, FindFieldReturnsFirstDuplicate) {
+    BSONObj obj = BSON("a" << 1 << "b" << 2 << "a" << 3);
+    auto found = BSONFieldScanner::findField(obj.objdata(), "a");
+    ASSERT(found);
+    ASSERT_EQ(BSONElement(found).numberInt(), 1);
+}
+
+TEST(BSONFieldScannerTest, ScanFindsAllFields) {
+    BSONObj obj = buildObj();
+    BSONFieldScanner scanner({"z",
+                              "f38",
+                              "missing",
+                              "f35_with_a_name_longer_than_a_vector",
+                              "f0_with_a_name_longer_than_a_vector",
+                              "z"});
+    std::vector<const char*> elements(scanner.numFields());
+
+    ASSERT_EQ(scanner.scan(obj.objdata(), elements.data()), 5u);
+    ASSERT_EQ(elements[0], obj["z"].rawdata());
+    ASSERT_EQ(elements[1], obj["f38"].rawdata());
+    ASSERT_EQ(elements[2], nullptr);
+    ASSERT_EQ(elements[3], obj["f35_with_a_name_longer_than_a_vector"].rawdata());
+    ASSERT_EQ(elements[4], obj["f0_with_a_name_longer_than_a_vector"].rawdata());
+    ASSERT_EQ(elements[5], elements[0]);
+}
+
+TEST(BSONFieldScannerTest, ScanResetsElementsBetweenObjects) {
+    BSONFieldScanner scanner({"a", "b"});
+    std::vector<const char*> elements(scanner.numFields());
+
+    BSONObj first = BSON("a" << 1 << "b" << 2);
+    ASSERT_EQ(scanner.scan(first.objdata(), elements.data()), 2u);
+
+    BSONObj second = BSON("b" << 3);
+    ASSERT_EQ(scanner.scan(second.objdata(), elements.data()), 1u);
+    ASSERT_EQ(elements[0], nullptr);
+    ASSERT_EQ(BSONElement(elements[1]).numberInt(), 3);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonelement.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/bits.h"
 
 namespace mongo {
 namespace {
@@ -147,9 +148,16 @@ private:
         }
 
         size_t strlen() const {
-            // This is actually by far the hottest code in all of BSON validation.
+            // This is actually by far the hottest code in all of BSON validation, so scan 8 bytes
+            // at a time while a whole word fits before the end, and only finish byte by byte.
+            // The lowest byte flagged by the zero-byte test is always the first NUL.
             dassert(ptr < end);
             size_t len = 0;
+            for (; end - (ptr + len) >= 8; len += 8) {
+                auto word = ConstDataView(ptr + len).read<LittleEndian<uint64_t>>();
+                if (auto zeros = (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL)
+                    return len + countTrailingZeros64(zeros) / 8;
+            }
             while (ptr[len])
                 ++len;
             return len;
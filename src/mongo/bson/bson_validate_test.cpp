@@ -361,6 +361,20 @@ TEST(BSONValidateFast, ErrorInNestedObjectWithId) {
                   "in object with _id: 1");
 }
 
+TEST(BSONValidateFast, FieldNamesOfAllLengths) {
+    // Field names and strings ending at every offset within and across 8-byte words, including in
+    // the last word of the buffer.
+    for (int len = 1; len <= 40; ++len) {
+        BSONObjBuilder b;
+        b.append(std::string(len, 'a'), 1);
+        b.appendRegex(std::string(len, 'b'), std::string(len, 'c'), "i");
+        b.append(std::string(len, 'd'), std::string(len, 'e'));
+        b.appendMinKey(std::string(len, 'f'));
+        BSONObj x = b.obj();
+        ASSERT_OK(validateBSON(x.objdata(), x.objsize()));
+    }
+}
+
 TEST(BSONValidateFast, StringHasSomething) {
     BufBuilder bb;
     BSONObjBuilder ob(bb);
@@ -32,6 +32,7 @@
 #include "mongo/db/jsobj.h"
 
 #include "mongo/base/data_range.h"
+#include "mongo/bson/bson_field_scan.h"
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonelement_comparator_interface.h"
 #include "mongo/bson/generator_extended_canonical_2_0_0.h"
@@ -561,15 +562,8 @@ void BSONObj::getFields(unsigned n, const char** fieldNames, BSONElement* fields
 }
 
 BSONElement BSONObj::getField(StringData name) const {
-    BSONObjIterator i(*this);
-    while (i.more()) {
-        BSONElement e = i.next();
-        // We know that e has a cached field length since BSONObjIterator::next internally
-        // called BSONElement::size on the BSONElement that it returned, so it is more
-        // efficient to re-use that information by obtaining the field name as a
-        // StringData, which will be pre-populated with the cached length.
-        if (name == e.fieldNameStringData())
-            return e;
+    if (auto elem = BSONFieldScanner::findField(objdata(), name)) {
+        return BSONElement(elem, name.size() + 1, -1, BSONElement::CachedSizeTag{});
     }
     return BSONElement();
 }
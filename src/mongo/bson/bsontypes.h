@@ -330,6 +330,9 @@ struct BSONObjAppendFormat<long long> : FormatKind<NumberLong> {};
 template <>
 struct BSONObjAppendFormat<Counter64> : FormatKind<NumberLong> {};
 
+template <>
+struct BSONObjAppendFormat<StripedCounter64> : FormatKind<NumberLong> {};
+
 template <>
 struct BSONObjAppendFormat<Decimal128> : FormatKind<NumberDecimal> {};
 
@@ -187,6 +187,15 @@ boost::optional<std::vector<ServerDescriptionPtr>> SdamServerSelector::selectSer
         // latency window should always leave at least one result
         invariant(results.size());
         std::shuffle(std::begin(results), std::end(results), _random.urbg());
+
+        // A hedged read is sent to the first two servers, and only the request to the second one
+        // has its time limited by 'maxTimeMSForHedgedReads'. Of this random pair, send the request
+        // which isn't limited to the server with the lower round trip time, so that reads favor
+        // faster servers while still being spread over the whole latency window.
+        if (criteria.hedgingMode && criteria.hedgingMode->getEnabled() && results.size() > 1 &&
+            LatencyWindow::rttCompareFn(results[1], results[0])) {
+            std::swap(results[0], results[1]);
+        }
         return results;
     }
 
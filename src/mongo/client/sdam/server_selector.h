@@ -66,6 +66,10 @@ class SdamServerSelector : public ServerSelector {
 public:
     explicit SdamServerSelector(const SdamConfiguration& config);
 
+    /**
+     * Returns the servers within the latency window which match 'criteria', in random order. For
+     * hedged reads, the faster of the first two servers is placed first.
+     */
     boost::optional<std::vector<ServerDescriptionPtr>> selectServers(
         const TopologyDescriptionPtr topologyDescription,
         const ReadPreferenceSetting& criteria) override;
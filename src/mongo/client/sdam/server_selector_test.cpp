@@ -265,6 +265,50 @@ TEST_F(ServerSelectorTestFixture, ShouldSelectRandomlyWhenMultipleOptionsAreAvai
     ASSERT_FALSE(frequencyInfo[HostAndPort("s3")]);
 }
 
+TEST_F(ServerSelectorTestFixture, ShouldPlaceFasterServerFirstForHedgedReads) {
+    TopologyStateMachine stateMachine(sdamConfiguration);
+    auto topologyDescription = std::make_shared<TopologyDescription>(sdamConfiguration);
+
+    auto primary = ServerDescriptionBuilder()
+                       .withAddress(HostAndPort("s0"))
+                       .withType(ServerType::kRSPrimary)
+                       .withLastUpdateTime(Date_t::now())
+                       .withLastWriteDate(Date_t::now())
+                       .withRtt(sdamConfiguration.getLocalThreshold())
+                       .withSetName("set")
+                       .withHost(HostAndPort("s0"))
+                       .withHost(HostAndPort("s1"))
+                       .withMinWireVersion(WireVersion::SUPPORTS_OP_MSG)
+                       .withMaxWireVersion(WireVersion::LATEST_WIRE_VERSION)
+                       .instance();
+    stateMachine.onServerDescription(*topologyDescription, primary);
+
+    // Both servers are within the latency window, s1 being the faster one.
+    auto fasterSecondary =
+        make_with_latency(Milliseconds(1), HostAndPort("s1"), ServerType::kRSSecondary);
+    stateMachine.onServerDescription(*topologyDescription, fasterSecondary);
+
+    const ReadPreferenceSetting hedgedReadPref(
+        ReadPreference::Nearest, TagSet(), Seconds(0), HedgingMode());
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        auto servers = selector.selectServers(topologyDescription, hedgedReadPref);
+        ASSERT(servers);
+        ASSERT_EQ(2, servers->size());
+        ASSERT_EQ(HostAndPort("s1"), (*servers)[0]->getAddress());
+    }
+
+    // Reads which aren't hedged are sent to either server.
+    std::map<HostAndPort, int> frequencyInfo;
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        auto servers = selector.selectServers(topologyDescription,
+                                              ReadPreferenceSetting(ReadPreference::Nearest));
+        ASSERT(servers);
+        frequencyInfo[(*servers)[0]->getAddress()]++;
+    }
+    ASSERT(frequencyInfo[HostAndPort("s0")]);
+    ASSERT(frequencyInfo[HostAndPort("s1")]);
+}
+
 TEST_F(ServerSelectorTestFixture, ShouldFilterByLastWriteTime) {
     TopologyStateMachine stateMachine(sdamConfiguration);
     auto topologyDescription = std::make_shared<TopologyDescription>(sdamConfiguration);
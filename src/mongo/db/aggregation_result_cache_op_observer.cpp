@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/aggregation_result_cache_op_observer.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/aggregation_result_cache.h"
+
+namespace mongo {
+
+void AggregationResultCacheOpObserver::_onWrite(OperationContext* opCtx,
+                                                const NamespaceString& nss) {
+    // The write version is bumped after the write is visible, so that an aggregation which takes
+    // the versions after the bump is guaranteed to read the write.
+    opCtx->recoveryUnit()->onCommit(
+        [nss](boost::optional<Timestamp>) { AggregationResultCache::get().onWrite(nss); });
+}
+
+void AggregationResultCacheOpObserver::onInserts(OperationContext* opCtx,
+                                                 const NamespaceString& nss,
+                                                 OptionalCollectionUUID uuid,
+                                                 std::vector<InsertStatement>::const_iterator first,
+                                                 std::vector<InsertStatement>::const_iterator last,
+                                                 bool fromMigrate) {
+    _onWrite(opCtx, nss);
+}
+
+void AggregationResultCacheOpObserver::onUpdate(OperationContext* opCtx,
+                                                const OplogUpdateEntryArgs& args) {
+    _onWrite(opCtx, args.nss);
+}
+
+void AggregationResultCacheOpObserver::onDelete(OperationContext* opCtx,
+                                                const NamespaceString& nss,
+                                                OptionalCollectionUUID uuid,
+                                                StmtId stmtId,
+                                                bool fromMigrate,
+                                                const boost::optional<BSONObj>& deletedDoc) {
+    _onWrite(opCtx, nss);
+}
+
+void AggregationResultCacheOpObserver::onCreateCollection(OperationContext* opCtx,
+                                                          const CollectionPtr& coll,
+                                                          const NamespaceString& collectionName,
+                                                          const CollectionOptions& options,
+                                                          const BSONObj& idIndex,
+                                                          const OplogSlot& createOpTime) {
+    _onWrite(opCtx, collectionName);
+}
+
+void AggregationResultCacheOpObserver::onDropDatabase(OperationContext* opCtx,
+                                                      const std::string& dbName) {
+    opCtx->recoveryUnit()->onCommit(
+        [](boost::optional<Timestamp>) { AggregationResultCache::get().invalidateAll(); });
+}
+
+repl::OpTime AggregationResultCacheOpObserver::onDropCollection(
+    OperationContext* opCtx,
+    const NamespaceString& collectionName,
+    OptionalCollectionUUID uuid,
+    std::uint64_t numRecords,
+    const CollectionDropType dropType) {
+    _onWrite(opCtx, collectionName);
+    return {};
+}
+
+void AggregationResultCacheOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                          const NamespaceString& fromCollection,
+                                                          const NamespaceString& toCollection,
+                                                          OptionalCollectionUUID uuid,
+                                                          OptionalCollectionUUID dropTargetUUID,
+                                                          std::uint64_t numRecords,
+                                                          bool stayTemp) {
+    _onWrite(opCtx, fromCollection);
+    _onWrite(opCtx, toCollection);
+}
+
+void AggregationResultCacheOpObserver::onImportCollection(OperationContext* opCtx,
+                                                          const UUID& importUUID,
+                                                          const NamespaceString& nss,
+                                                          long long numRecords,
+                                                          long long dataSize,
+                                                          const BSONObj& catalogEntry,
+                                                          const BSONObj& storageMetadata,
+                                                          bool isDryRun) {
+    _onWrite(opCtx, nss);
+}
+
+repl::OpTime AggregationResultCacheOpObserver::preRenameCollection(
+    OperationContext* opCtx,
+    const NamespaceString& fromCollection,
+    const NamespaceString& toCollection,
+    OptionalCollectionUUID uuid,
+    OptionalCollectionUUID dropTargetUUID,
+    std::uint64_t numRecords,
+    bool stayTemp) {
+    _onWrite(opCtx, fromCollection);
+    _onWrite(opCtx, toCollection);
+    return {};
+}
+
+void AggregationResultCacheOpObserver::postRenameCollection(OperationContext* opCtx,
+                                                            const NamespaceString& fromCollection,
+                                                            const NamespaceString& toCollection,
+                                                            OptionalCollectionUUID uuid,
+                                                            OptionalCollectionUUID dropTargetUUID,
+                                                            bool stayTemp) {
+    _onWrite(opCtx, fromCollection);
+    _onWrite(opCtx, toCollection);
+}
+
+void AggregationResultCacheOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                                     const NamespaceString& collectionName,
+                                                     OptionalCollectionUUID uuid) {
+    _onWrite(opCtx, collectionName);
+}
+
+void AggregationResultCacheOpObserver::onReplicationRollback(OperationContext* opCtx,
+                                                             const RollbackObserverInfo& rbInfo) {
+    // Rollback changes the contents of collections without going through the write paths.
+    AggregationResultCache::get().invalidateAll();
+}
+
+}  // namespace mongo
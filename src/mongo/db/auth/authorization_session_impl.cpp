@@ -897,38 +897,64 @@ bool AuthorizationSessionImpl::isAuthorizedForAnyActionOnResource(const Resource
 bool AuthorizationSessionImpl::_isAuthorizedForPrivilege(const Privilege& privilege) {
     const ResourcePattern& target(privilege.getResourcePattern());
 
-    ResourcePattern resourceSearchList[resourceSearchListCapacity];
-    const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
-
     ActionSet unmetRequirements = privilege.getActions();
 
     PrivilegeVector defaultPrivileges = getDefaultPrivileges();
-    for (PrivilegeVector::iterator it = defaultPrivileges.begin(); it != defaultPrivileges.end();
-         ++it) {
-        for (int i = 0; i < resourceSearchListLength; ++i) {
-            if (!(it->getResourcePattern() == resourceSearchList[i]))
-                continue;
+    if (!defaultPrivileges.empty()) {
+        ResourcePattern resourceSearchList[resourceSearchListCapacity];
+        const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
+
+        for (PrivilegeVector::iterator it = defaultPrivileges.begin();
+             it != defaultPrivileges.end();
+             ++it) {
+            for (int i = 0; i < resourceSearchListLength; ++i) {
+                if (!(it->getResourcePattern() == resourceSearchList[i]))
+                    continue;
+
+                ActionSet userActions = it->getActions();
+                unmetRequirements.removeAllActionsFromSet(userActions);
+
+                if (unmetRequirements.empty())
+                    return true;
+            }
+        }
+    }
 
-            ActionSet userActions = it->getActions();
-            unmetRequirements.removeAllActionsFromSet(userActions);
+    if (_authenticatedUsers.begin() == _authenticatedUsers.end()) {
+        return false;
+    }
 
-            if (unmetRequirements.empty())
-                return true;
-        }
+    unmetRequirements.removeAllActionsFromSet(_getUserActionsForResource(target));
+    return unmetRequirements.empty();
+}
+
+ActionSet AuthorizationSessionImpl::_getUserActionsForResource(const ResourcePattern& target) {
+    // The number of resources for which the actions are cached, beyond which the cache is reset.
+    static constexpr size_t kMaxCachedResources = 128;
+
+    if (_userActionsCacheGeneration != _authenticatedUsers.getGeneration() ||
+        _userActionsCache.size() >= kMaxCachedResources) {
+        _userActionsCache.clear();
+        _userActionsCacheGeneration = _authenticatedUsers.getGeneration();
+    }
+
+    auto it = _userActionsCache.find(target);
+    if (it != _userActionsCache.end()) {
+        return it->second;
     }
 
+    ResourcePattern resourceSearchList[resourceSearchListCapacity];
+    const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
+
+    ActionSet actions;
     for (const auto& user : _authenticatedUsers) {
         for (int i = 0; i < resourceSearchListLength; ++i) {
-            ActionSet userActions = user->getActionsForResource(resourceSearchList[i]);
-            unmetRequirements.removeAllActionsFromSet(userActions);
-
-            if (unmetRequirements.empty()) {
-                return true;
-            }
+            actions.addAllActionsFromSet(user->getActionsForResource(resourceSearchList[i]));
         }
     }
 
-    return false;
+    _userActionsCache.emplace(target, actions);
+    return actions;
 }
 
 void AuthorizationSessionImpl::setImpersonatedUserData(std::vector<UserName> usernames,
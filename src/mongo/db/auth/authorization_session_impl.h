@@ -43,6 +43,7 @@
 #include "mongo/db/auth/user_set.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -215,6 +216,12 @@ private:
     // lock on the admin database (to update out-of-date user privilege information).
     bool _isAuthorizedForPrivilege(const Privilege& privilege);
 
+    // Returns the union of the actions which the authenticated users are granted on 'target' and
+    // on every pattern matching it. The result is cached until the set of authenticated users
+    // changes, so that repeated checks against the same resource skip building the resource
+    // search list and looking it up in the privileges of every user.
+    ActionSet _getUserActionsForResource(const ResourcePattern& target);
+
     std::tuple<std::vector<UserName>*, std::vector<RoleName>*> _getImpersonations() override {
         return std::make_tuple(&_impersonatedUserNames, &_impersonatedRoleNames);
     }
@@ -226,5 +233,11 @@ private:
     std::vector<UserName> _impersonatedUserNames;
     std::vector<RoleName> _impersonatedRoleNames;
     bool _impersonationFlag;
+
+    // Cache of _getUserActionsForResource, which is valid for the generation
+    // '_userActionsCacheGeneration' of _authenticatedUsers. Only accessed by the thread which owns
+    // the client.
+    stdx::unordered_map<ResourcePattern, ActionSet> _userActionsCache;
+    uint64_t _userActionsCacheGeneration = 0;
 };
 }  // namespace mongo
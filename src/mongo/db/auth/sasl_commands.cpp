@@ -57,6 +57,7 @@
 #include "mongo/util/base64.h"
 #include "mongo/util/sequence_util.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -191,7 +192,9 @@ Status doSaslStep(OperationContext* opCtx,
     auto& mechanism = session->getMechanism();
 
     // Passing in a payload and extracting a responsePayload
+    Timer stepTimer;
     StatusWith<std::string> swResponse = mechanism.step(opCtx, payload);
+    authCounter.incSaslStep(mechanism.mechanismName().toString(), stepTimer.micros()).ignore();
 
     if (!swResponse.isOK()) {
         LOGV2(20249,
@@ -73,6 +73,7 @@ private:
 UserSet::UserSet() = default;
 
 void UserSet::add(UserHandle user) {
+    ++_generation;
     auto it = std::find_if(_users.begin(), _users.end(), [&](const auto& storedUser) {
         return user->getName().getDB() == storedUser->getName().getDB();
     });
@@ -84,6 +85,7 @@ void UserSet::add(UserHandle user) {
 }
 
 void UserSet::removeByDBName(StringData dbname) {
+    ++_generation;
     auto it = std::find_if(_users.begin(), _users.end(), [&](const auto& user) {
         return user->getName().getDB() == dbname;
     });
@@ -93,10 +95,12 @@ void UserSet::removeByDBName(StringData dbname) {
 }
 
 void UserSet::replaceAt(iterator it, UserHandle replacement) {
+    ++_generation;
     *it = std::move(replacement);
 }
 
 void UserSet::removeAt(iterator it) {
+    ++_generation;
     _users.erase(it);
 }
 
@@ -105,10 +105,18 @@ public:
         return _users.end();
     }
 
+    // Returns a counter which changes whenever a User is added to, replaced in or removed from
+    // the set, so that state derived from the Users can be cached until the set changes.
+    uint64_t getGeneration() const {
+        return _generation;
+    }
+
 private:
     // The UserSet maintains ownership of the Users in it, and is responsible for
     // returning them to the AuthorizationManager when done with them.
     std::list<UserHandle> _users;
+
+    uint64_t _generation = 0;
 };
 
 }  // namespace mongo
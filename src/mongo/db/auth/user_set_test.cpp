@@ -108,5 +108,36 @@ TEST(UserSetTest, IterateNames) {
     ASSERT(!iter.more());
 }
 
+TEST(UserSetTest, GenerationChangesWithUsers) {
+    UserSet set;
+    auto generation = set.getGeneration();
+    auto assertGenerationChanged = [&] {
+        ASSERT_NE(generation, set.getGeneration());
+        generation = set.getGeneration();
+    };
+
+    set.add(UserHandle(User(UserName("Bob", "test"))));
+    assertGenerationChanged();
+
+    set.add(UserHandle(User(UserName("George", "test"))));
+    assertGenerationChanged();
+
+    set.replaceAt(set.begin(), UserHandle(User(UserName("Bob", "test"))));
+    assertGenerationChanged();
+
+    set.removeAt(set.begin());
+    assertGenerationChanged();
+
+    set.add(UserHandle(User(UserName("Bob", "test2"))));
+    assertGenerationChanged();
+    set.removeByDBName("test2"_sd);
+    assertGenerationChanged();
+
+    // Lookups leave the generation unchanged.
+    set.lookup(UserName("Bob", "test2"));
+    set.lookupByDBName("test");
+    ASSERT_EQ(generation, set.getGeneration());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -61,6 +61,7 @@ namespace mongo {
 
 class CappedCallback;
 class CollectionPtr;
+class FieldRefSetWithStorage;
 class IndexCatalog;
 class IndexCatalogEntry;
 class MatchExpression;
@@ -96,6 +97,10 @@ struct CollectionUpdateArgs {
 
     // Set if an OpTime was reserved for the update ahead of time.
     boost::optional<OplogSlot> oplogSlot = boost::none;
+
+    // If set, every path the update modified. Indexes which index none of these paths are left
+    // as they are. Not owned.
+    const FieldRefSetWithStorage* modifiedPaths = nullptr;
 };
 
 /**
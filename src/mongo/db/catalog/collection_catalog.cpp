@@ -40,13 +40,71 @@
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/snapshot_helper.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/spin_lock.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
 namespace {
-struct LatestCollectionCatalog {
-    std::shared_ptr<CollectionCatalog> catalog = std::make_shared<CollectionCatalog>();
+/**
+ * Publishes the latest catalog to readers without a process wide mutex. The catalog is referenced
+ * from a number of cache line aligned slots, and each thread only ever reads the slot assigned to
+ * it.
+ * Every slot references the catalog through a control block of its own, so that the reference
+ * counting of concurrent readers on different threads is spread over the slots as well.
+ */
+class LatestCollectionCatalog {
+public:
+    LatestCollectionCatalog() {
+        store(std::make_shared<CollectionCatalog>());
+    }
+
+    std::shared_ptr<const CollectionCatalog> load() const {
+        auto& slot = _slots[_slotForThisThread()];
+        stdx::lock_guard<SpinLock> lk(slot.lock);
+        return slot.catalog;
+    }
+
+    void store(std::shared_ptr<const CollectionCatalog> catalog) {
+        // Allocate the control blocks first. The catalog stays alive for as long as any slot's
+        // reference, or a copy of it, does.
+        std::array<std::shared_ptr<const CollectionCatalog>, kNumSlots> published;
+        for (auto& slotCatalog : published) {
+            slotCatalog = std::shared_ptr<const CollectionCatalog>(
+                catalog.get(), [catalog](const CollectionCatalog*) {});
+        }
+
+        // Swap every slot while holding all of their locks, so that no reader can observe the new
+        // catalog on one thread and then the previous one on another. The previous catalogs are
+        // released outside of the locks.
+        std::array<std::unique_lock<SpinLock>, kNumSlots> locks;
+        for (size_t i = 0; i < kNumSlots; ++i) {
+            locks[i] = std::unique_lock<SpinLock>(_slots[i].lock);
+        }
+        for (size_t i = 0; i < kNumSlots; ++i) {
+            std::swap(_slots[i].catalog, published[i]);
+        }
+        for (auto&& lk : locks) {
+            lk.unlock();
+        }
+    }
+
+private:
+    static constexpr size_t kNumSlots = 32;
+
+    static size_t _slotForThisThread() {
+        static AtomicWord<unsigned> nextSlot{0};
+        thread_local const size_t slot = nextSlot.fetchAndAddRelaxed(1) % kNumSlots;
+        return slot;
+    }
+
+    struct alignas(stdx::hardware_destructive_interference_size) Slot {
+        mutable SpinLock lock;
+        std::shared_ptr<const CollectionCatalog> catalog;
+    };
+
+    std::array<Slot, kNumSlots> _slots;
 };
 const ServiceContext::Decoration<LatestCollectionCatalog> getCatalog =
     ServiceContext::declareDecoration<LatestCollectionCatalog>();
@@ -310,7 +368,7 @@ bool CollectionCatalog::iterator::_exhausted() {
 }
 
 std::shared_ptr<const CollectionCatalog> CollectionCatalog::get(ServiceContext* svcCtx) {
-    return atomic_load(&getCatalog(svcCtx).catalog);
+    return getCatalog(svcCtx).load();
 }
 
 std::shared_ptr<const CollectionCatalog> CollectionCatalog::get(OperationContext* opCtx) {
@@ -395,7 +453,7 @@ void CollectionCatalog::write(ServiceContext* svcCtx, CatalogWriteFn job) {
 
     auto& storage = getCatalog(svcCtx);
     // hold onto base so if we need to delete it we can do it outside of the lock
-    auto base = atomic_load(&storage.catalog);
+    auto base = storage.load();
     // copy the collection catalog, this could be expensive, but we will only have one pending
     // collection in flight at a given time
     auto clone = std::make_shared<CollectionCatalog>(*base);
@@ -419,7 +477,7 @@ void CollectionCatalog::write(ServiceContext* svcCtx, CatalogWriteFn job) {
         stdx::lock_guard lock(mutex);
         if (queue.empty()) {
             // Queue is empty, store catalog and relinquish responsibility of being worker thread
-            atomic_store(&storage.catalog, std::move(clone));
+            storage.store(std::move(clone));
             workerExists = false;
             break;
         }
@@ -257,7 +257,7 @@ CollectionImpl::SharedState::SharedState(CollectionImpl* collection,
                           ? std::make_shared<CappedInsertNotifier>()
                           : nullptr),
       _needCappedLock(_recordStore && _recordStore->isCapped() &&
-                      collection->ns().db() != "local") {
+                      collection->ns().isReplicated()) {
     if (_cappedNotifier) {
         _recordStore->setCappedCallback(this);
     }
@@ -388,6 +388,11 @@ bool CollectionImpl::requiresIdIndex() const {
         return false;
     }
 
+    if (_shared->_recordStore->isClustered()) {
+        // The documents are keyed by _id in the record store itself.
+        return false;
+    }
+
     if (_ns.isSystem()) {
         StringData shortName = _ns.coll().substr(_ns.coll().find('.') + 1);
         if (shortName == "indexes" || shortName == "namespaces" || shortName == "profile") {
@@ -900,6 +905,7 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
                                                     *args->preImageDoc,
                                                     newDoc,
                                                     oldLocation,
+                                                    args->modifiedPaths,
                                                     &keysInserted,
                                                     &keysDeleted));
 
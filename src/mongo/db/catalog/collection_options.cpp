@@ -131,6 +131,8 @@ StatusWith<CollectionOptions> CollectionOptions::parse(const BSONObj& options, P
             collectionOptions.temp = e.trueValue();
         } else if (fieldName == "recordPreImages") {
             collectionOptions.recordPreImages = e.trueValue();
+        } else if (fieldName == "clustered") {
+            collectionOptions.clustered = e.trueValue();
         } else if (fieldName == "storageEngine") {
             if (e.type() != mongo::Object) {
                 return {ErrorCodes::TypeMismatch, "'storageEngine' must be a document"};
@@ -142,6 +144,17 @@ StatusWith<CollectionOptions> CollectionOptions::parse(const BSONObj& options, P
             }
 
             collectionOptions.storageEngine = e.Obj().getOwned();
+        } else if (fieldName == "storageTier") {
+            if (e.type() != mongo::String) {
+                return {ErrorCodes::TypeMismatch, "'storageTier' must be a string"};
+            }
+
+            auto status = create_command_validation::validateStorageTier(e.str());
+            if (!status.isOK()) {
+                return status;
+            }
+
+            collectionOptions.storageTier = e.str();
         } else if (fieldName == "indexOptionDefaults") {
             if (e.type() != mongo::Object) {
                 return {ErrorCodes::TypeMismatch, "'indexOptionDefaults' has to be a document."};
@@ -196,6 +209,11 @@ StatusWith<CollectionOptions> CollectionOptions::parse(const BSONObj& options, P
             }
 
             collectionOptions.pipeline = e.Obj().getOwned();
+        } else if (fieldName == "clusteredIdType" && kind == parseForCommand) {
+            // Only checked by the create command, the collection is stored as 'clustered'.
+            continue;
+        } else if (fieldName == "materialized" && kind == parseForCommand) {
+            collectionOptions.materialized = e.trueValue();
         } else if (fieldName == "idIndex" && kind == parseForCommand) {
             if (e.type() != mongo::Object) {
                 return Status(ErrorCodes::TypeMismatch, "'idIndex' has to be an object.");
@@ -230,6 +248,19 @@ StatusWith<CollectionOptions> CollectionOptions::parse(const BSONObj& options, P
         return Status(ErrorCodes::BadValue, "'pipeline' cannot be specified without 'viewOn'");
     }
 
+    if (collectionOptions.viewOn.empty() && collectionOptions.materialized) {
+        return Status(ErrorCodes::BadValue, "'materialized' cannot be specified without 'viewOn'");
+    }
+
+    if (collectionOptions.clustered) {
+        if (collectionOptions.capped) {
+            return Status(ErrorCodes::BadValue, "'clustered' cannot be specified with 'capped'");
+        }
+        if (collectionOptions.autoIndexId == YES || !collectionOptions.idIndex.isEmpty()) {
+            return Status(ErrorCodes::BadValue, "A clustered collection cannot have an _id index");
+        }
+    }
+
     return collectionOptions;
 }
 
@@ -252,6 +283,9 @@ CollectionOptions CollectionOptions::parse(const CreateCommand& cmd) {
     if (auto storageEngine = cmd.getStorageEngine()) {
         options.storageEngine = std::move(*storageEngine);
     }
+    if (auto storageTier = cmd.getStorageTier()) {
+        options.storageTier = storageTier->toString();
+    }
     if (auto validator = cmd.getValidator()) {
         options.validator = std::move(*validator);
     }
@@ -274,12 +308,18 @@ CollectionOptions CollectionOptions::parse(const CreateCommand& cmd) {
         }
         options.pipeline = std::move(builder.arr());
     }
+    if (auto materialized = cmd.getMaterialized()) {
+        options.materialized = *materialized;
+    }
     if (auto collation = cmd.getCollation()) {
         options.collation = std::move(*collation);
     }
     if (auto recordPreImages = cmd.getRecordPreImages()) {
         options.recordPreImages = *recordPreImages;
     }
+    if (auto clustered = cmd.getClustered()) {
+        options.clustered = *clustered;
+    }
     if (auto timeseries = cmd.getTimeseries()) {
         options.timeseries = std::move(*timeseries);
     }
@@ -319,10 +359,18 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
         builder->appendBool("recordPreImages", true);
     }
 
+    if (clustered) {
+        builder->appendBool("clustered", true);
+    }
+
     if (!storageEngine.isEmpty()) {
         builder->append("storageEngine", storageEngine);
     }
 
+    if (!storageTier.empty()) {
+        builder->append("storageTier", storageTier);
+    }
+
     if (indexOptionDefaults.getStorageEngine()) {
         builder->append("indexOptionDefaults", indexOptionDefaults.toBSON());
     }
@@ -351,6 +399,10 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
         builder->appendArray("pipeline", pipeline);
     }
 
+    if (materialized) {
+        builder->appendBool("materialized", true);
+    }
+
     if (!idIndex.isEmpty()) {
         builder->append("idIndex", idIndex);
     }
@@ -382,6 +434,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (clustered != other.clustered) {
+        return false;
+    }
+
     if (temp != other.temp) {
         return false;
     }
@@ -390,6 +446,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (storageTier != other.storageTier) {
+        return false;
+    }
+
     if (indexOptionDefaults.toBSON().woCompare(other.indexOptionDefaults.toBSON()) != 0) {
         return false;
     }
@@ -426,6 +486,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (materialized != other.materialized) {
+        return false;
+    }
+
     if ((timeseries && other.timeseries &&
          timeseries->toBSON().woCompare(other.timeseries->toBSON()) != 0) ||
         (timeseries == boost::none) != (other.timeseries == boost::none)) {
@@ -118,9 +118,17 @@ struct CollectionOptions {
     bool temp = false;
     bool recordPreImages = false;
 
+    // Whether the documents are stored keyed by their _id rather than by a generated RecordId. A
+    // clustered collection has no _id index.
+    bool clustered = false;
+
     // Storage engine collection options. Always owned or empty.
     BSONObj storageEngine;
 
+    // The storage tier on which the collection and its indexes are placed. Empty for the default
+    // tier. Only set at creation time, as existing data files are never moved between tiers.
+    std::string storageTier;
+
     // Default options for indexes created on the collection.
     IndexOptionDefaults indexOptionDefaults;
 
@@ -141,6 +149,8 @@ struct CollectionOptions {
     std::string viewOn;
     // The aggregation pipeline that defines this view.
     BSONObj pipeline;
+    // Whether the results of the view are stored in a backing collection.
+    bool materialized = false;
 
     // The options that define the time-series collection, or boost::none if not a time-series
     // collection.
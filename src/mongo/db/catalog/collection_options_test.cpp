@@ -161,6 +161,37 @@ TEST(CollectionOptions, ParseEngineField) {
     ASSERT_EQUALS(2, storageEngine2.getIntField("b"));
 }
 
+TEST(CollectionOptions, ParseStorageTierField) {
+    auto opts = assertGet(CollectionOptions::parse(fromjson("{storageTier: 'cold_1-a'}")));
+    ASSERT_EQUALS("cold_1-a", opts.storageTier);
+    checkRoundTrip(opts);
+    ASSERT_FALSE(opts.matchesStorageOptions(CollectionOptions{}, nullptr));
+
+    // The tier is used as a directory name, so it must be a short, non-empty, path-safe string.
+    ASSERT_NOT_OK(CollectionOptions::parse(fromjson("{storageTier: 1}")).getStatus());
+    ASSERT_NOT_OK(CollectionOptions::parse(fromjson("{storageTier: ''}")).getStatus());
+    ASSERT_NOT_OK(CollectionOptions::parse(fromjson("{storageTier: '../cold'}")).getStatus());
+    ASSERT_NOT_OK(CollectionOptions::parse(fromjson("{storageTier: 'a/b'}")).getStatus());
+    ASSERT_NOT_OK(
+        CollectionOptions::parse(BSON("storageTier" << std::string(65, 'a'))).getStatus());
+}
+
+TEST(CollectionOptions, ParseClusteredField) {
+    auto opts = assertGet(CollectionOptions::parse(fromjson("{clustered: true}")));
+    ASSERT_TRUE(opts.clustered);
+    checkRoundTrip(opts);
+    ASSERT_FALSE(opts.matchesStorageOptions(CollectionOptions{}, nullptr));
+
+    // A clustered collection is keyed by _id, so it can't be capped or have an _id index.
+    ASSERT_NOT_OK(CollectionOptions::parse(fromjson("{clustered: true, capped: true, size: 1024}"))
+                      .getStatus());
+    ASSERT_NOT_OK(
+        CollectionOptions::parse(fromjson("{clustered: true, autoIndexId: true}")).getStatus());
+    ASSERT_NOT_OK(CollectionOptions::parse(
+                      fromjson("{clustered: true, idIndex: {key: {_id: 1}, name: '_id_'}}"))
+                      .getStatus());
+}
+
 TEST(CollectionOptions, ResetStorageEngineField) {
 
     auto opts =
@@ -418,12 +418,16 @@ Status validate(OperationContext* opCtx,
                 RepairMode repairMode,
                 ValidateResults* results,
                 BSONObjBuilder* output,
-                bool turnOnExtraLoggingForTest) {
+                bool turnOnExtraLoggingForTest,
+                const boost::optional<RecordRange>& recordRange) {
     invariant(!opCtx->lockState()->isLocked() || storageGlobalParams.repair);
 
     // This is deliberately outside of the try-catch block, so that any errors thrown in the
     // constructor fail the cmd, as opposed to returning OK with valid:false.
     ValidateState validateState(opCtx, nss, mode, repairMode, turnOnExtraLoggingForTest);
+    if (recordRange) {
+        validateState.setRecordRange(*recordRange);
+    }
 
     const auto replCoord = repl::ReplicationCoordinator::get(opCtx);
     // Check whether we are allowed to read from this node after acquiring our locks. If we are
@@ -503,6 +507,11 @@ Status validate(OperationContext* opCtx,
         // the collection.
         indexValidator.traverseRecordStore(opCtx, results, output);
 
+        // Tell the caller where to resume validating a range of records on its next run.
+        if (const auto resumeAfter = indexValidator.getResumeAfter(); !resumeAfter.isNull()) {
+            output->append("resumeAfter", static_cast<long long>(resumeAfter.repr()));
+        }
+
         // Pause collection validation while a lock is held and between collection and index data
         // validation.
         //
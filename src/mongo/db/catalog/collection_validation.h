@@ -29,8 +29,11 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/catalog/validate_results.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/record_id.h"
 
 namespace mongo {
 
@@ -74,6 +77,22 @@ enum class RepairMode {
     kRepair,
 };
 
+/**
+ * Restricts validation to a range of the collection's records, so that a large collection can be
+ * validated incrementally over several runs. Only the records in the range, and the index entries
+ * which point to them, are checked against each other. The indexes are still traversed in full,
+ * but the documents outside of the range are neither read nor have their keys generated.
+ */
+struct RecordRange {
+    // Validation starts with the first record after this one, or with the first record of the
+    // collection if it is null.
+    RecordId resumeAfter;
+
+    // The maximum number of records to validate, or 0 to validate through the end of the
+    // collection.
+    long long maxRecords = 0;
+};
+
 /**
  * Expects the caller to hold no locks.
  *
@@ -81,6 +100,10 @@ enum class RepairMode {
  * The combination of background = true and options of anything other than kNoFullValidation is
  * prohibited.
  *
+ * If 'recordRange' is set, only that range of records is validated, and 'output' gets a
+ * "resumeAfter" field if there are records after it. A range can't be combined with full
+ * validation or repair.
+ *
  * @return OK if the validate run successfully
  *         OK will be returned even if corruption is found
  *         details will be in 'results'.
@@ -91,7 +114,8 @@ Status validate(OperationContext* opCtx,
                 RepairMode repairMode,
                 ValidateResults* results,
                 BSONObjBuilder* output,
-                bool turnOnExtraLoggingForTest = false);
+                bool turnOnExtraLoggingForTest = false,
+                const boost::optional<RecordRange>& recordRange = boost::none);
 
 /**
  * Checks whether a failpoint has been hit in the above validate() code..
@@ -266,6 +266,93 @@ TEST_F(CollectionValidationTest, ValidateEnforceFastCount) {
                        {CollectionValidation::ValidateMode::kForegroundFullEnforceFastCount});
 }
 
+/**
+ * Calls validate on the 'recordRange' of collection kNss and returns the output, after checking
+ * that the validation result is 'valid'.
+ */
+BSONObj validateRange(OperationContext* opCtx,
+                      bool valid,
+                      const CollectionValidation::RecordRange& recordRange) {
+    ValidateResults validateResults;
+    BSONObjBuilder output;
+    ASSERT_OK(CollectionValidation::validate(opCtx,
+                                             kNss,
+                                             CollectionValidation::ValidateMode::kForeground,
+                                             CollectionValidation::RepairMode::kNone,
+                                             &validateResults,
+                                             &output,
+                                             /*turnOnExtraLoggingForTest*/ false,
+                                             recordRange));
+    ASSERT_EQ(validateResults.valid, valid);
+    return output.obj();
+}
+
+/**
+ * Inserts a document with '_id' 'idNum' into the record store of collection kNss, without adding
+ * its key to the _id index. Returns its RecordId.
+ */
+RecordId insertUnindexedDocument(OperationContext* opCtx, int idNum) {
+    AutoGetCollection coll(opCtx, kNss, MODE_IX);
+    auto doc = BSON("_id" << idNum);
+
+    WriteUnitOfWork wuow(opCtx);
+    auto recordId =
+        coll->getRecordStore()->insertRecord(opCtx, doc.objdata(), doc.objsize(), Timestamp::min());
+    ASSERT_OK(recordId.getStatus());
+    wuow.commit();
+    return recordId.getValue();
+}
+
+// Verify that validating a collection in ranges of records covers each record exactly once.
+TEST_F(CollectionValidationTest, ValidateRecordRanges) {
+    auto opCtx = operationContext();
+    const int numRecords = insertDataRange(opCtx, 0, 5);
+
+    CollectionValidation::RecordRange recordRange;
+    recordRange.maxRecords = 2;
+    std::vector<int> rangeSizes;
+    while (true) {
+        auto obj = validateRange(opCtx, /*valid*/ true, recordRange);
+        rangeSizes.push_back(obj.getIntField("nrecords"));
+        if (!obj.hasField("resumeAfter")) {
+            break;
+        }
+        recordRange.resumeAfter = RecordId(obj["resumeAfter"].numberLong());
+    }
+    ASSERT(std::vector<int>({2, 2, 1}) == rangeSizes);
+
+    // A range without a limit continues through the end of the collection.
+    recordRange = {};
+    auto obj = validateRange(opCtx, /*valid*/ true, recordRange);
+    ASSERT_EQ(numRecords, obj.getIntField("nrecords"));
+    ASSERT_FALSE(obj.hasField("resumeAfter"));
+}
+
+// Verify that validating a range of records finds the missing index entries of the records in the
+// range, but not those of other records.
+TEST_F(CollectionValidationTest, ValidateRecordRangeChecksOnlyItsIndexEntries) {
+    auto opCtx = operationContext();
+    insertDataRange(opCtx, 0, 3);
+    auto unindexedRecordId = insertUnindexedDocument(opCtx, 3);
+    insertDataRange(opCtx, 4, 6);
+
+    CollectionValidation::RecordRange recordRange;
+    recordRange.maxRecords = 3;
+    auto obj = validateRange(opCtx, /*valid*/ true, recordRange);
+    ASSERT_EQ(3, obj.getIntField("nrecords"));
+
+    recordRange.resumeAfter = RecordId(obj["resumeAfter"].numberLong());
+    obj = validateRange(opCtx, /*valid*/ false, recordRange);
+    ASSERT_EQ(3, obj.getIntField("nrecords"));
+    ASSERT_FALSE(obj.hasField("resumeAfter"));
+
+    // Nothing after the unindexed record is missing its index entries.
+    recordRange.resumeAfter = unindexedRecordId;
+    recordRange.maxRecords = 0;
+    obj = validateRange(opCtx, /*valid*/ true, recordRange);
+    ASSERT_EQ(2, obj.getIntField("nrecords"));
+}
+
 /**
  * Waits for a parallel running collection validation operation to start and then hang at a
  * failpoint.
@@ -50,6 +50,7 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/insert.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/idl/command_generic_argument.h"
@@ -124,39 +125,15 @@ Status _createTimeseries(OperationContext* opCtx,
 
     options.viewOn = bucketsNs.coll().toString();
 
-    // The time field cannot be sparse, so we use it as the exit condition for the loop.
-    auto assembleData =
-        "function(dataArray) { \
-                const assembledData = []; \
-                if (dataArray.length === 0) { \
-                    return assembledData; \
-                } \
-                for (let i = 0;;i++) { \
-                    const assembledObj = {}; \
-                    for (const elem of dataArray) { \
-                        if (elem.v.hasOwnProperty(i)) { \
-                            assembledObj[elem.k] = elem.v[i]; \
-                        } else if (elem.k === '" +
-        options.timeseries->getTimeField() +
-        "') { \
-                            return assembledData; \
-                        } \
-                    } \
-                    assembledData.push(assembledObj); \
-                } \
-            }";
+    // The view presents each measurement held by the buckets as a document of its own.
+    BSONObjBuilder unpackSpec;
+    unpackSpec.append(DocumentSourceInternalUnpackBucket::kTimeFieldName,
+                      options.timeseries->getTimeField());
+    if (auto metaField = options.timeseries->getMetaField()) {
+        unpackSpec.append(DocumentSourceInternalUnpackBucket::kMetaFieldName, *metaField);
+    }
     options.pipeline =
-        BSON_ARRAY(BSON("$project" << BSON("dataArray" << BSON("$objectToArray"
-                                                               << "$data")))
-                   << BSON("$project" << BSON(
-                               "assembledData" << BSON(
-                                   "$function" << BSON("body" << assembleData << "args"
-                                                              << BSON_ARRAY("$dataArray") << "lang"
-                                                              << "js"))))
-                   << BSON("$unwind"
-                           << "$assembledData")
-                   << BSON("$replaceWith"
-                           << "$assembledData"));
+        BSON_ARRAY(BSON(DocumentSourceInternalUnpackBucket::kStageName << unpackSpec.obj()));
 
     return writeConflictRetry(opCtx, "create", ns.ns(), [&]() -> Status {
         AutoGetCollection autoColl(opCtx, ns, MODE_IX, AutoGetCollectionViewMode::kViewsPermitted);
@@ -298,6 +275,87 @@ Status _createTimeseries(OperationContext* opCtx,
     });
 }
 
+Status _createMaterializedView(OperationContext* opCtx,
+                               const NamespaceString& ns,
+                               CollectionOptions&& options) {
+    auto backingNs = ns.makeMaterializedViewNamespace();
+    uassert(ErrorCodes::InvalidNamespace,
+            str::stream() << "Materialized view name is too long: " << ns,
+            backingNs.size() <= NamespaceString::MaxNsCollectionLen);
+
+    return writeConflictRetry(opCtx, "create", ns.ns(), [&]() -> Status {
+        AutoGetCollection autoColl(opCtx, ns, MODE_IX, AutoGetCollectionViewMode::kViewsPermitted);
+        Lock::CollectionLock backingCollLock(opCtx, backingNs, MODE_IX);
+        Lock::CollectionLock systemDotViewsLock(
+            opCtx,
+            NamespaceString(ns.db(), NamespaceString::kSystemDotViewsCollectionName),
+            MODE_X);
+
+        auto catalog = CollectionCatalog::get(opCtx);
+        if (catalog->lookupCollectionByNamespace(opCtx, ns)) {
+            return Status(ErrorCodes::NamespaceExists,
+                          str::stream() << "Collection already exists. NS: " << ns);
+        }
+        if (catalog->lookupCollectionByNamespace(opCtx, backingNs)) {
+            return Status(ErrorCodes::NamespaceExists,
+                          str::stream() << "Collection already exists. NS: " << backingNs);
+        }
+
+        auto db = autoColl.ensureDbExists();
+        if (ViewCatalog::get(db)->lookup(opCtx, ns.ns())) {
+            return {ErrorCodes::NamespaceExists,
+                    str::stream() << "A view already exists. NS: " << ns};
+        }
+
+        if (opCtx->writesAreReplicated() &&
+            !repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, ns)) {
+            return {ErrorCodes::NotWritablePrimary,
+                    str::stream() << "Not primary while creating collection " << ns};
+        }
+
+        _createSystemDotViewsIfNecessary(opCtx, db);
+
+        WriteUnitOfWork wuow(opCtx);
+
+        AutoStatsTracker statsTracker(opCtx,
+                                      ns,
+                                      Top::LockType::NotLocked,
+                                      AutoStatsTracker::LogMode::kUpdateTopAndCurOp,
+                                      catalog->getDatabaseProfileLevel(ns.db()));
+
+        AutoStatsTracker backingStatsTracker(opCtx,
+                                             backingNs,
+                                             Top::LockType::NotLocked,
+                                             AutoStatsTracker::LogMode::kUpdateTopAndCurOp,
+                                             catalog->getDatabaseProfileLevel(ns.db()));
+
+        opCtx->recoveryUnit()->onRollback(
+            [serviceContext = opCtx->getServiceContext(), &ns, &backingNs]() {
+                Top::get(serviceContext).collectionDropped(ns);
+                Top::get(serviceContext).collectionDropped(backingNs);
+            });
+
+        // Create the empty backing collection. It is populated the first time the view is read.
+        CollectionOptions backingOptions;
+        backingOptions.collation = options.collation;
+        invariant(db->createCollection(opCtx, backingNs, backingOptions),
+                  str::stream() << "Failed to create backing collection " << backingNs
+                                << " for materialized view " << ns);
+
+        // Even though 'options' is passed by rvalue reference, it is not safe to move because
+        // 'userCreateNS' may throw a WriteConflictException.
+        auto status = db->userCreateNS(opCtx, ns, options);
+        if (!status.isOK()) {
+            return status.withContext(str::stream() << "Failed to create materialized view " << ns
+                                                    << " with options " << options.toBSON());
+        }
+
+        wuow.commit();
+
+        return Status::OK();
+    });
+}
+
 Status _createCollection(OperationContext* opCtx,
                          const NamespaceString& nss,
                          CollectionOptions&& collectionOptions,
@@ -367,6 +425,9 @@ Status createCollection(OperationContext* opCtx,
                 str::stream() << "Cannot create a view in a multi-document "
                                  "transaction.",
                 !opCtx->inMultiDocumentTransaction());
+        if (options.materialized) {
+            return _createMaterializedView(opCtx, ns, std::move(options));
+        }
         return _createView(opCtx, ns, std::move(options), idIndex);
     } else if (options.timeseries) {
         uassert(ErrorCodes::OperationNotSupportedInTransaction,
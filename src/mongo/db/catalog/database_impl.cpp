@@ -594,6 +594,11 @@ void DatabaseImpl::_checkCanCreateCollection(OperationContext* opCtx,
     }
 
     uassert(28838, "cannot create a non-capped oplog collection", options.capped || !nss.isOplog());
+    uassert(ErrorCodes::InvalidOptions,
+            str::stream() << "Cannot create collection " << nss
+                          << " - the storage engine does not support clustered collections.",
+            !options.clustered ||
+                opCtx->getServiceContext()->getStorageEngine()->supportsClusteredCollections());
     uassert(ErrorCodes::DatabaseDropPending,
             str::stream() << "Cannot create collection " << nss
                           << " - database is in the process of being dropped.",
@@ -613,13 +618,27 @@ Status DatabaseImpl::createView(OperationContext* opCtx,
     _checkCanCreateCollection(opCtx, viewName, options);
 
     BSONArray pipeline(options.pipeline);
+
+    // A materialized view is a view with an empty pipeline on its backing collection. The
+    // requested 'viewOn' and 'pipeline' instead define how the backing collection is computed.
+    boost::optional<ViewDefinition::Materialization> materialization;
+    if (options.materialized) {
+        materialization.emplace();
+        materialization->from = viewOnNss;
+        for (auto&& stage : pipeline) {
+            materialization->pipeline.push_back(stage.Obj().getOwned());
+        }
+        viewOnNss = viewName.makeMaterializedViewNamespace();
+        pipeline = BSONArray();
+    }
+
     auto status = Status::OK();
     if (viewName.isOplog()) {
         status = {ErrorCodes::InvalidNamespace,
                   str::stream() << "invalid namespace name for a view: " + viewName.toString()};
     } else {
         status = ViewCatalog::get(this)->createView(
-            opCtx, viewName, viewOnNss, pipeline, options.collation);
+            opCtx, viewName, viewOnNss, pipeline, options.collation, std::move(materialization));
     }
 
     audit::logCreateView(&cc(), viewName.toString(), viewOnNss.toString(), pipeline, status.code());
@@ -322,7 +322,9 @@ Status dropCollection(OperationContext* opCtx,
                 return Status(ErrorCodes::NamespaceNotFound, "ns not found");
             }
 
-            if (!view->isTimeseries()) {
+            // Time-series collections and materialized views also drop the collection that backs
+            // the view.
+            if (!view->isTimeseries() && !view->materialization()) {
                 return _dropView(opCtx, db, collectionName, &result);
             }
 
@@ -338,8 +340,8 @@ Status dropCollection(OperationContext* opCtx,
                     }
                     wuow.commit();
 
-                    // Drop the buckets collection in its own writeConflictRetry so that
-                    // if it throws a WCE, only the buckets collection drop is retried.
+                    // Drop the backing collection in its own writeConflictRetry so that
+                    // if it throws a WCE, only the backing collection drop is retried.
                     writeConflictRetry(opCtx, "drop", bucketsNs.ns(), [opCtx, db, &bucketsNs] {
                         WriteUnitOfWork wuow(opCtx);
                         db->dropCollectionEvenIfSystem(opCtx, bucketsNs).ignore();
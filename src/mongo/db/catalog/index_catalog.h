@@ -46,6 +46,7 @@ namespace mongo {
 class Client;
 class Collection;
 class CollectionPtr;
+class FieldRefSetWithStorage;
 
 class IndexDescriptor;
 struct InsertDeleteOptions;
@@ -438,6 +439,9 @@ public:
      * Both 'keysInsertedOut' and 'keysDeletedOut' are required and will be set to the number of
      * index keys inserted and deleted by this operation, respectively.
      *
+     * If 'modifiedPaths' is not null, the keys of indexes which index none of those paths are
+     * neither generated nor updated.
+     *
      * This method may throw.
      */
     virtual Status updateRecord(OperationContext* const opCtx,
@@ -445,6 +449,7 @@ public:
                                 const BSONObj& oldDoc,
                                 const BSONObj& newDoc,
                                 const RecordId& recordId,
+                                const FieldRefSetWithStorage* modifiedPaths,
                                 int64_t* const keysInsertedOut,
                                 int64_t* const keysDeletedOut) = 0;
 
@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/index_catalog_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/init.h"
@@ -49,6 +50,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/field_ref_set.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
@@ -660,8 +662,11 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
                                   << collationElement.fieldNameStringData() << "' option"};
         }
 
+        // A columnstore index stores values without applying any collation, so it serves queries
+        // under any collation and accepts the collection default.
         if ((pluginName != IndexNames::BTREE) && (pluginName != IndexNames::GEO_2DSPHERE) &&
-            (pluginName != IndexNames::HASHED) && (pluginName != IndexNames::WILDCARD)) {
+            (pluginName != IndexNames::HASHED) && (pluginName != IndexNames::WILDCARD) &&
+            (pluginName != IndexNames::COLUMN)) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream()
                               << "Index type '" << pluginName
@@ -671,7 +676,7 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
 
     const bool isSparse = spec["sparse"].trueValue();
 
-    if (pluginName == IndexNames::WILDCARD) {
+    if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
         if (isSparse) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream() << "Index type '" << pluginName
@@ -691,6 +696,14 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
         }
     }
 
+    // A columnstore index must hold every document, since a scan of it stands in for a scan of the
+    // collection.
+    if (pluginName == IndexNames::COLUMN && spec.getField("partialFilterExpression")) {
+        return Status(ErrorCodes::CannotCreateIndex,
+                      str::stream() << "Index type '" << pluginName
+                                    << "' does not support the partialFilterExpression option");
+    }
+
     // Create an ExpressionContext, used to parse the match expression and to house the collator for
     // the remaining checks.
     boost::intrusive_ptr<ExpressionContext> expCtx(
@@ -1344,6 +1357,21 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, coll->ns(), index->descriptor(), &options);
 
+    // When the documents all share a timestamp and their keys need no duplicate checks, insert the
+    // keys of the whole batch in key order rather than document by document.
+    if (bsonRecords.size() > 1 && !index->isHybridBuilding() && !index->descriptor()->unique() &&
+        std::all_of(bsonRecords.begin(), bsonRecords.end(), [&](const auto& bsonRecord) {
+            return bsonRecord.ts == bsonRecords.front().ts;
+        })) {
+        if (!bsonRecords.front().ts.isNull()) {
+            Status status = opCtx->recoveryUnit()->setTimestamp(bsonRecords.front().ts);
+            if (!status.isOK())
+                return status;
+        }
+        return index->accessMethod()->insertBatch(
+            opCtx, coll, bsonRecords, options, keysInsertedOut);
+    }
+
     for (auto bsonRecord : bsonRecords) {
         invariant(bsonRecord.id != RecordId());
 
@@ -1413,6 +1441,7 @@ Status IndexCatalogImpl::_updateRecord(OperationContext* const opCtx,
                                        const BSONObj& oldDoc,
                                        const BSONObj& newDoc,
                                        const RecordId& recordId,
+                                       const FieldRefSetWithStorage* modifiedPaths,
                                        int64_t* const keysInsertedOut,
                                        int64_t* const keysDeletedOut) {
     IndexAccessMethod* iam = index->accessMethod();
@@ -1422,7 +1451,8 @@ Status IndexCatalogImpl::_updateRecord(OperationContext* const opCtx,
 
     UpdateTicket updateTicket;
 
-    iam->prepareUpdate(opCtx, index, oldDoc, newDoc, recordId, options, &updateTicket);
+    iam->prepareUpdate(
+        opCtx, index, oldDoc, newDoc, recordId, modifiedPaths, options, &updateTicket);
 
     int64_t keysInserted = 0;
     int64_t keysDeleted = 0;
@@ -1576,18 +1606,47 @@ Status IndexCatalogImpl::updateRecord(OperationContext* const opCtx,
                                       const BSONObj& oldDoc,
                                       const BSONObj& newDoc,
                                       const RecordId& recordId,
+                                      const FieldRefSetWithStorage* modifiedPaths,
                                       int64_t* const keysInsertedOut,
                                       int64_t* const keysDeletedOut) {
     *keysInsertedOut = 0;
     *keysDeletedOut = 0;
 
+    // Generating the keys of the old and the new document is the bulk of the work for an index, so
+    // it is skipped for indexes none of whose paths were modified. Indexes unknown to the
+    // CollectionQueryInfo are always updated.
+    const auto& queryInfo = CollectionQueryInfo::get(coll);
+    auto mightBeAffected = [&](const IndexCatalogEntry* entry) {
+        if (!modifiedPaths) {
+            return true;
+        }
+        const auto* indexedPaths =
+            queryInfo.getIndexKeys(opCtx, entry->descriptor()->indexName());
+        if (!indexedPaths) {
+            return true;
+        }
+        return std::any_of(modifiedPaths->begin(), modifiedPaths->end(), [&](const auto* path) {
+            return indexedPaths->mightBeIndexed(*path);
+        });
+    };
+
     // Ready indexes go directly through the IndexAccessMethod.
     for (IndexCatalogEntryContainer::const_iterator it = _readyIndexes.begin();
          it != _readyIndexes.end();
          ++it) {
         IndexCatalogEntry* entry = it->get();
-        auto status = _updateRecord(
-            opCtx, coll, entry, oldDoc, newDoc, recordId, keysInsertedOut, keysDeletedOut);
+        if (!mightBeAffected(entry)) {
+            continue;
+        }
+        auto status = _updateRecord(opCtx,
+                                    coll,
+                                    entry,
+                                    oldDoc,
+                                    newDoc,
+                                    recordId,
+                                    modifiedPaths,
+                                    keysInsertedOut,
+                                    keysDeletedOut);
         if (!status.isOK())
             return status;
     }
@@ -1597,8 +1656,18 @@ Status IndexCatalogImpl::updateRecord(OperationContext* const opCtx,
          it != _buildingIndexes.end();
          ++it) {
         IndexCatalogEntry* entry = it->get();
-        auto status = _updateRecord(
-            opCtx, coll, entry, oldDoc, newDoc, recordId, keysInsertedOut, keysDeletedOut);
+        if (!mightBeAffected(entry)) {
+            continue;
+        }
+        auto status = _updateRecord(opCtx,
+                                    coll,
+                                    entry,
+                                    oldDoc,
+                                    newDoc,
+                                    recordId,
+                                    modifiedPaths,
+                                    keysInsertedOut,
+                                    keysDeletedOut);
         if (!status.isOK())
             return status;
     }
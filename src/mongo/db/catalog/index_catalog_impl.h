@@ -47,6 +47,7 @@ namespace mongo {
 class Client;
 class Collection;
 class CollectionPtr;
+class FieldRefSetWithStorage;
 
 class IndexDescriptor;
 struct InsertDeleteOptions;
@@ -264,6 +265,7 @@ public:
                         const BSONObj& oldDoc,
                         const BSONObj& newDoc,
                         const RecordId& recordId,
+                        const FieldRefSetWithStorage* modifiedPaths,
                         int64_t* const keysInsertedOut,
                         int64_t* const keysDeletedOut) override;
     /**
@@ -341,6 +343,7 @@ private:
                          const BSONObj& oldDoc,
                          const BSONObj& newDoc,
                          const RecordId& recordId,
+                         const FieldRefSetWithStorage* modifiedPaths,
                          int64_t* const keysInsertedOut,
                          int64_t* const keysDeletedOut);
 
@@ -137,7 +137,7 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                           << static_cast<int>(indexVersion)};
                 }
 
-                if (pluginName == IndexNames::WILDCARD) {
+                if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
                     return {code,
                             str::stream() << "'" << pluginName
                                           << "' index plugin is not allowed with index version v:"
@@ -184,6 +184,21 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
             return Status(code, "wildcard indexes do not allow compounding");
         }
 
+        // A columnstore index stores whole top-level fields.
+        if (pluginName == IndexNames::COLUMN && keyElement.type() != String) {
+            return Status(code,
+                          str::stream() << "Every field of a '" << IndexNames::COLUMN
+                                        << "' index key pattern must have the value '"
+                                        << IndexNames::COLUMN << "'");
+        }
+        if (pluginName == IndexNames::COLUMN &&
+            keyElement.fieldNameStringData().find('.') != std::string::npos) {
+            return Status(code,
+                          str::stream() << "'" << IndexNames::COLUMN
+                                        << "' indexes may only name top-level fields, not '"
+                                        << keyElement.fieldNameStringData() << "'");
+        }
+
         // Ensure that the fields on which we are building the index are valid: a field must not
         // begin with a '$' unless it is part of a wildcard, DBRef or text index, and a field path
         // cannot contain an empty field. If a field cannot be created or updated, it should not be
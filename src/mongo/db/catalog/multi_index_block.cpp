@@ -56,9 +56,12 @@
 #include "mongo/db/storage/execution_context.h"
 #include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/quick_exit.h"
@@ -204,11 +207,21 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(
 
         std::vector<BSONObj> indexInfoObjs;
         indexInfoObjs.reserve(indexSpecs.size());
+        auto maxMemoryUsageBytes =
+            static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024;
+
+        // Documents batched for parallel key generation, and the keys generated from them before
+        // they reach the sorters, take an eighth of the budget away from the sorters.
+        _keyGenerationThreads = static_cast<std::size_t>(maxIndexBuildKeyGenerationThreads.load());
+        _collectionScanBatchMaxBytes = 0;
+        if (_keyGenerationThreads > 1) {
+            _collectionScanBatchMaxBytes = maxMemoryUsageBytes / 16;
+            maxMemoryUsageBytes -= 2 * _collectionScanBatchMaxBytes;
+        }
+
         std::size_t eachIndexBuildMaxMemoryUsageBytes = 0;
         if (!indexSpecs.empty()) {
-            eachIndexBuildMaxMemoryUsageBytes =
-                static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024 /
-                indexSpecs.size();
+            eachIndexBuildMaxMemoryUsageBytes = maxMemoryUsageBytes / indexSpecs.size();
         }
         _eachIndexBuildMaxMemoryUsageBytes = eachIndexBuildMaxMemoryUsageBytes;
 
@@ -443,6 +456,34 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
     bool readOnce = useReadOnceCursorsForIndexBuilds.load();
     opCtx->recoveryUnit()->setReadOnce(readOnce);
 
+    // Generate keys on several threads by batching the documents read by the scan. The failpoints
+    // which pause the scan at a particular document expect each document to be inserted before the
+    // scan moves on, so they disable batching.
+    auto isFailPointSet = [](const FailPoint& fp) {
+        return fp.toBSON()["mode"].numberInt() != FailPoint::off;
+    };
+    const bool useBatches = _collectionScanBatchMaxBytes > 0 &&
+        !isFailPointSet(hangIndexBuildDuringCollectionScanPhaseBeforeInsertion) &&
+        !isFailPointSet(hangIndexBuildDuringCollectionScanPhaseAfterInsertion);
+    std::unique_ptr<ThreadPool> keyGenerationPool;
+    if (useBatches) {
+        ThreadPool::Options options;
+        options.poolName = "IndexBuildKeyGenerationThreadPool";
+        options.threadNamePrefix = "IndexBuildKeyGeneration-";
+        options.minThreads = 0;
+        options.maxThreads = _keyGenerationThreads - 1;
+        options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+        keyGenerationPool = std::make_unique<ThreadPool>(options);
+        keyGenerationPool->startup();
+    }
+    ON_BLOCK_EXIT([&] {
+        if (keyGenerationPool) {
+            keyGenerationPool->shutdown();
+            keyGenerationPool->join();
+        }
+    });
+    CollectionScanBatch batch;
+
     try {
         // The phase will be kCollectionScan when resuming an index build from the collection scan
         // phase.
@@ -473,7 +514,16 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
 
             // The external sorter is not part of the storage engine and therefore does not need a
             // WriteUnitOfWork to write keys.
-            uassertStatusOK(_insert(opCtx, objToIndex, loc));
+            if (!useBatches) {
+                uassertStatusOK(_insert(opCtx, objToIndex, loc));
+            } else {
+                // The document must outlive a yield of the scan before its keys are generated.
+                batch.documents.emplace_back(objToIndex.getOwned(), loc);
+                batch.bytes += objToIndex.objsize();
+                if (batch.bytes >= _collectionScanBatchMaxBytes) {
+                    uassertStatusOK(_insertBatch(opCtx, keyGenerationPool.get(), &batch));
+                }
+            }
 
             _failPointHangDuringBuild(opCtx,
                                       &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
@@ -486,6 +536,9 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
             progress->hit();
             n++;
         }
+        if (useBatches) {
+            uassertStatusOK(_insertBatch(opCtx, keyGenerationPool.get(), &batch));
+        }
     } catch (DBException& ex) {
         if (ex.isA<ErrorCategory::Interruption>() || ex.isA<ErrorCategory::ShutdownError>() ||
             ErrorCodes::IndexBuildAborted == ex.code()) {
@@ -595,6 +648,102 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx, const BSONObj& doc, con
     return Status::OK();
 }
 
+Status MultiIndexBlock::_insertBatch(OperationContext* opCtx,
+                                     ThreadPool* pool,
+                                     CollectionScanBatch* batch) {
+    invariant(!_buildIsCleanedUp);
+    auto& documents = batch->documents;
+    const auto numIndexes = _indexes.size();
+
+    // The keys of each document for each index, or boost::none when the document doesn't pass the
+    // index's filter.
+    using GeneratedKeys = IndexAccessMethod::BulkBuilder::GeneratedKeys;
+    std::vector<boost::optional<GeneratedKeys>> generated(documents.size() * numIndexes);
+    std::vector<Status> statuses(documents.size() * numIndexes, Status::OK());
+
+    auto generateKeys = [&](size_t begin, size_t end) {
+        SharedBufferFragmentBuilder pooledBufferBuilder(
+            gOperationMemoryPoolBlockInitialSizeKB.loadRelaxed() * static_cast<size_t>(1024),
+            SharedBufferFragmentBuilder::DoubleGrowStrategy(
+                gOperationMemoryPoolBlockMaxSizeKB.loadRelaxed() * static_cast<size_t>(1024)));
+        for (size_t doc = begin; doc < end; ++doc) {
+            const auto& [obj, loc] = documents[doc];
+            for (size_t i = 0; i < numIndexes; ++i) {
+                const auto& index = _indexes[i];
+                auto slot = doc * numIndexes + i;
+                try {
+                    if (index.filterExpression && !index.filterExpression->matchesBSON(obj)) {
+                        continue;
+                    }
+                    generated[slot].emplace();
+                    statuses[slot] = index.bulk->generateKeys(
+                        pooledBufferBuilder, obj, loc, index.options, &*generated[slot]);
+                } catch (...) {
+                    statuses[slot] = exceptionToStatus();
+                }
+            }
+        }
+    };
+
+    // Split the batch into contiguous ranges of documents, one per thread, and generate the keys
+    // of the first range on this thread while the pool takes the others.
+    const auto numRanges = std::min(_keyGenerationThreads, std::max<size_t>(documents.size(), 1));
+    const auto rangeSize = (documents.size() + numRanges - 1) / numRanges;
+    auto mutex = MONGO_MAKE_LATCH("MultiIndexBlock::_insertBatch");
+    stdx::condition_variable rangeDone;
+    size_t rangesPending = numRanges - 1;
+    for (size_t range = 1; range < numRanges; ++range) {
+        auto begin = std::min(range * rangeSize, documents.size());
+        auto end = std::min(begin + rangeSize, documents.size());
+        // If the pool is shutting down, the task runs on this thread with a non-OK status, and the
+        // keys are generated here instead.
+        pool->schedule([&, begin, end](Status) {
+            generateKeys(begin, end);
+            stdx::lock_guard<Latch> lk(mutex);
+            if (--rangesPending == 0) {
+                rangeDone.notify_one();
+            }
+        });
+    }
+    generateKeys(0, std::min(rangeSize, documents.size()));
+    {
+        // The wait isn't interruptible, since the pool's tasks refer to this stack frame. Each
+        // range is a bounded amount of work.
+        stdx::unique_lock<Latch> lk(mutex);
+        rangeDone.wait(lk, [&] { return rangesPending == 0; });
+    }
+
+    // The sorters aren't thread-safe, so the keys are added here, in the order of the documents.
+    for (size_t doc = 0; doc < documents.size(); ++doc) {
+        const auto& [obj, loc] = documents[doc];
+        for (size_t i = 0; i < numIndexes; ++i) {
+            auto slot = doc * numIndexes + i;
+            if (!statuses[slot].isOK()) {
+                return statuses[slot];
+            }
+            if (!generated[slot]) {
+                continue;
+            }
+
+            // When adding keys, BulkBuilderImpl's Sorter performs file I/O that may result in an
+            // exception.
+            try {
+                auto status = _indexes[i].bulk->insertKeys(opCtx, obj, loc, &*generated[slot]);
+                if (!status.isOK()) {
+                    return status;
+                }
+            } catch (...) {
+                return exceptionToStatus();
+            }
+        }
+        _lastRecordIdInserted = loc;
+    }
+
+    documents.clear();
+    batch->bytes = 0;
+    return Status::OK();
+}
+
 Status MultiIndexBlock::dumpInsertsFromBulk(OperationContext* opCtx,
                                             const CollectionPtr& collection) {
     return dumpInsertsFromBulk(opCtx, collection, nullptr);
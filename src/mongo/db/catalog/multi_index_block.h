@@ -60,6 +60,7 @@ class CollectionPtr;
 class MatchExpression;
 class NamespaceString;
 class OperationContext;
+class ThreadPool;
 
 /**
  * Builds one or more indexes.
@@ -319,6 +320,23 @@ private:
 
     Status _insert(OperationContext* opCtx, const BSONObj& wholeDocument, const RecordId& loc);
 
+    /**
+     * Documents read by the collection scan, in RecordId order, waiting for their keys to be
+     * generated.
+     */
+    struct CollectionScanBatch {
+        std::vector<std::pair<BSONObj, RecordId>> documents;
+        size_t bytes = 0;
+    };
+
+    /**
+     * Inserts the documents of 'batch' as _insert() would and empties it. The keys of the documents
+     * are generated by up to '_keyGenerationThreads' threads, one of which is this thread and the
+     * rest of which come from 'pool'. The keys are added to the BulkBuilders in RecordId order on
+     * this thread.
+     */
+    Status _insertBatch(OperationContext* opCtx, ThreadPool* pool, CollectionScanBatch* batch);
+
     // Is set during init() and ensures subsequent function calls act on the same Collection.
     boost::optional<UUID> _collectionUUID;
 
@@ -330,6 +348,12 @@ private:
 
     std::size_t _eachIndexBuildMaxMemoryUsageBytes = 0;
 
+    // The number of threads generating keys during the collection scan, and the share of the
+    // memory budget for the documents they are given at once. Set during init(). Key generation
+    // is single threaded, and documents aren't batched, when '_collectionScanBatchMaxBytes' is 0.
+    std::size_t _keyGenerationThreads = 1;
+    std::size_t _collectionScanBatchMaxBytes = 0;
+
     // Set to true when no work remains to be done, the object can safely destruct without leaving
     // incorrect state set anywhere.
     bool _buildIsCleanedUp = true;
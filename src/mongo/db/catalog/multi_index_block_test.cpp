@@ -32,8 +32,10 @@
 #include "mongo/db/catalog/multi_index_block.h"
 
 #include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/catalog/multi_index_block_gen.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/unittest/unittest.h"
 
@@ -183,5 +185,66 @@ TEST_F(MultiIndexBlockTest, InitWriteConflictException) {
     indexer->abortIndexBuild(operationContext(), coll, MultiIndexBlock::kNoopOnCleanUpFn);
 }
 
+TEST_F(MultiIndexBlockTest, InsertAllDocumentsGeneratesKeysOnSeveralThreads) {
+    auto indexer = getIndexer();
+
+    const auto originalThreads = maxIndexBuildKeyGenerationThreads.load();
+    maxIndexBuildKeyGenerationThreads.store(4);
+    ON_BLOCK_EXIT([&] { maxIndexBuildKeyGenerationThreads.store(originalThreads); });
+
+    AutoGetCollection autoColl(operationContext(), getNSS(), MODE_X);
+    CollectionWriter coll(autoColl);
+
+    // Every tenth document holds an array, so the index must end up multikey whichever thread
+    // generated the keys for it.
+    const int kNumDocs = 1000;
+    long long expectedKeys = 0;
+    {
+        std::vector<InsertStatement> inserts;
+        for (int i = 0; i < kNumDocs; ++i) {
+            if (i % 10 == 0) {
+                inserts.push_back(InsertStatement(BSON("_id" << i << "a" << BSON_ARRAY(i << -i))));
+                expectedKeys += 2;
+            } else {
+                inserts.push_back(InsertStatement(BSON("_id" << i << "a" << i)));
+                expectedKeys += 1;
+            }
+        }
+        WriteUnitOfWork wuow(operationContext());
+        ASSERT_OK(coll->insertDocuments(
+            operationContext(), inserts.begin(), inserts.end(), nullptr, false));
+        wuow.commit();
+    }
+
+    BSONObj spec = BSON("key" << BSON("a" << 1) << "name"
+                              << "a_1"
+                              << "v" << static_cast<int>(IndexDescriptor::kLatestIndexVersion));
+    {
+        WriteUnitOfWork wuow(operationContext());
+        ASSERT_OK(indexer->init(operationContext(), coll, {spec}, MultiIndexBlock::kNoopOnInitFn)
+                      .getStatus());
+        wuow.commit();
+    }
+
+    ASSERT_OK(indexer->insertAllDocumentsInCollection(operationContext(), coll.get()));
+    ASSERT_OK(indexer->checkConstraints(operationContext(), coll.get()));
+
+    {
+        WriteUnitOfWork wunit(operationContext());
+        ASSERT_OK(indexer->commit(operationContext(),
+                                  coll.getWritableCollection(),
+                                  MultiIndexBlock::kNoopOnCreateEachFn,
+                                  MultiIndexBlock::kNoopOnCommitFn));
+        wunit.commit();
+    }
+
+    auto desc = coll->getIndexCatalog()->findIndexByName(operationContext(), "a_1");
+    ASSERT(desc);
+    auto entry = coll->getIndexCatalog()->getEntry(desc);
+    ASSERT(entry->isMultikey());
+    ASSERT_EQ(expectedKeys,
+              entry->accessMethod()->getSortedDataInterface()->numEntries(operationContext()));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -297,16 +297,18 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
             numKeys++;
             continue;
         }
-        try {
-            _indexConsistency->addIndexKey(
-                opCtx, indexEntry->keyString, &indexInfo, indexEntry->loc, results);
-        } catch (const DBException& e) {
-            StringBuilder ss;
-            ss << "Parsing index key for " << indexInfo.indexName << " recId " << indexEntry->loc
-               << " threw exception " << e.toString();
-            results->errors.push_back(ss.str());
-            results->valid = false;
-            continue;
+        if (_isInRecordRange(indexEntry->loc)) {
+            try {
+                _indexConsistency->addIndexKey(
+                    opCtx, indexEntry->keyString, &indexInfo, indexEntry->loc, results);
+            } catch (const DBException& e) {
+                StringBuilder ss;
+                ss << "Parsing index key for " << indexInfo.indexName << " recId "
+                   << indexEntry->loc << " threw exception " << e.toString();
+                results->errors.push_back(ss.str());
+                results->valid = false;
+                continue;
+            }
         }
 
         _progress->hit();
@@ -337,6 +339,9 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
                                           ValidateResults* results,
                                           BSONObjBuilder* output) {
     _numRecords = 0;  // need to reset it because this function can be called more than once.
+    _lastRecordIdInRange = RecordId();
+    _hasRecordsAfterRange = false;
+    const auto& recordRange = _validateState->getRecordRange();
     long long dataSizeTotal = 0;
     long long interruptIntervalNumBytes = 0;
     long long nInvalid = 0;
@@ -438,7 +443,13 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
                 interruptIntervalNumBytes = 0;
             }
         }
+
+        if (recordRange && recordRange->maxRecords && _numRecords >= recordRange->maxRecords) {
+            _hasRecordsAfterRange = bool(traverseRecordStoreCursor->next(opCtx));
+            break;
+        }
     }
+    _lastRecordIdInRange = prevRecordId;
 
     if (results->numRemovedCorruptRecords > 0) {
         results->warnings.push_back(str::stream() << "Removed " << results->numRemovedCorruptRecords
@@ -456,8 +467,9 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
     }
 
     // Do not update the record store stats if we're in the background as we've validated a
-    // checkpoint and it may not have the most up-to-date changes.
-    if (results->valid && !_validateState->isBackground()) {
+    // checkpoint and it may not have the most up-to-date changes, or if we've only validated a
+    // range of the records.
+    if (results->valid && !_validateState->isBackground() && !recordRange) {
         _validateState->getCollection()->getRecordStore()->updateStatsAfterRepair(
             opCtx, _numRecords, dataSizeTotal);
     }
@@ -468,6 +480,15 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
     output->appendNumber("nrecords", _numRecords);
 }
 
+bool ValidateAdaptor::_isInRecordRange(const RecordId& id) const {
+    const auto& recordRange = _validateState->getRecordRange();
+    if (!recordRange) {
+        return true;
+    }
+    return (recordRange->resumeAfter.isNull() || id > recordRange->resumeAfter) &&
+        !_lastRecordIdInRange.isNull() && id <= _lastRecordIdInRange;
+}
+
 void ValidateAdaptor::validateIndexKeyCount(const IndexCatalogEntry* index,
                                             IndexValidateResults& results) {
     // Fetch the total number of index entries we previously found traversing the index.
@@ -495,10 +516,11 @@ void ValidateAdaptor::validateIndexKeyCount(const IndexCatalogEntry* index,
 
     // Confirm that the number of index entries is not greater than the number of documents in the
     // collection. This check is only valid for indexes that are not multikey (indexed arrays
-    // produce an index key per array entry) and not $** indexes which can produce index keys for
-    // multiple paths within a single document.
+    // produce an index key per array entry) and not $** or columnstore indexes which can produce
+    // index keys for multiple paths within a single document.
     if (results.valid && !index->isMultikey() &&
-        desc->getIndexType() != IndexType::INDEX_WILDCARD && numTotalKeys > _numRecords) {
+        desc->getIndexType() != IndexType::INDEX_WILDCARD &&
+        desc->getIndexType() != IndexType::INDEX_COLUMN && numTotalKeys > _numRecords) {
         std::string err = str::stream()
             << "index " << desc->indexName() << " is not multi-key, but has more entries ("
             << numTotalKeys << ") than documents in the index (" << _numRecords << ")";
@@ -82,7 +82,21 @@ public:
      */
     void validateIndexKeyCount(const IndexCatalogEntry* index, IndexValidateResults& results);
 
+    /**
+     * When validating a range of records, returns the last record traversed by
+     * traverseRecordStore() if there are records after it, or a null RecordId otherwise.
+     */
+    RecordId getResumeAfter() const {
+        return _hasRecordsAfterRange ? _lastRecordIdInRange : RecordId();
+    }
+
 private:
+    /**
+     * Returns whether the record 'id' is among those traversed by traverseRecordStore(), so that
+     * the index entries which point to it should be checked.
+     */
+    bool _isInRecordRange(const RecordId& id) const;
+
     IndexConsistency* _indexConsistency;
     CollectionValidation::ValidateState* _validateState;
 
@@ -96,5 +110,10 @@ private:
     // The total number of index keys is stored during the first validation phase, since this
     // count may change during a second phase.
     uint64_t _totalIndexKeys = 0;
+
+    // The last record traversed by traverseRecordStore() when validating a range of records, and
+    // whether there are records after it.
+    RecordId _lastRecordIdInRange;
+    bool _hasRecordsAfterRange = false;
 };
 }  // namespace mongo
@@ -195,6 +195,12 @@ void ValidateState::_yieldCursors(OperationContext* opCtx) {
             _seekRecordStoreCursor->restore());
 }
 
+void ValidateState::setRecordRange(const RecordRange& recordRange) {
+    invariant(!_traverseRecordStoreCursor);
+    invariant(!isFullValidation() && !shouldRunRepair());
+    _recordRange = recordRange;
+}
+
 void ValidateState::initializeCursors(OperationContext* opCtx) {
     invariant(!_traverseRecordStoreCursor && !_seekRecordStoreCursor && _indexCursors.size() == 0 &&
               _indexes.size() == 0);
@@ -263,7 +269,20 @@ void ValidateState::initializeCursors(OperationContext* opCtx) {
     // use cursor->next() to get subsequent Records. However, if the Record Store is empty,
     // there is no first record. In this case, we set the first Record Id to an invalid RecordId
     // (RecordId()), which will halt iteration at the initialization step.
-    const boost::optional<Record> record = _traverseRecordStoreCursor->next(opCtx);
+    //
+    // When validating a range of records, the first Record is the one after 'resumeAfter'. If that
+    // record has been deleted since the last run, the records before it are skipped.
+    const RecordId resumeAfter = _recordRange ? _recordRange->resumeAfter : RecordId();
+    boost::optional<Record> record;
+    if (!resumeAfter.isNull() && _seekRecordStoreCursor->seekExact(opCtx, resumeAfter)) {
+        _traverseRecordStoreCursor->seekExact(opCtx, resumeAfter);
+        record = _traverseRecordStoreCursor->next(opCtx);
+    } else {
+        record = _traverseRecordStoreCursor->next(opCtx);
+        while (record && !resumeAfter.isNull() && record->id <= resumeAfter) {
+            record = _traverseRecordStoreCursor->next(opCtx);
+        }
+    }
     _firstRecordId = record ? record->id : RecordId();
 }
 
@@ -127,6 +127,15 @@ public:
         return _firstRecordId;
     }
 
+    /**
+     * Limits validation to 'recordRange'. Must be called before initializeCursors().
+     */
+    void setRecordRange(const RecordRange& recordRange);
+
+    const boost::optional<RecordRange>& getRecordRange() const {
+        return _recordRange;
+    }
+
     /**
      * Yields locks for background validation; or cursors for foreground validation. Locks are
      * yielded to allow DDL ops to run concurrently with background validation. Cursors are yielded
@@ -217,6 +226,8 @@ private:
 
     RecordId _firstRecordId;
 
+    boost::optional<RecordRange> _recordRange;
+
     DataThrottle _dataThrottle;
 
     // Used to detect when the catalog is re-opened while yielding locks.
@@ -42,12 +42,12 @@
 
 namespace mongo {
 namespace {
-Counter64 collectionScansCounter;
-Counter64 collectionScansNonTailableCounter;
+StripedCounter64 collectionScansCounter;
+StripedCounter64 collectionScansNonTailableCounter;
 
-ServerStatusMetricField<Counter64> displayCollectionScans("queryExecutor.collectionScans.total",
-                                                          &collectionScansCounter);
-ServerStatusMetricField<Counter64> displayCollectionScansNonTailable(
+ServerStatusMetricField<StripedCounter64> displayCollectionScans(
+    "queryExecutor.collectionScans.total", &collectionScansCounter);
+ServerStatusMetricField<StripedCounter64> displayCollectionScansNonTailable(
     "queryExecutor.collectionScans.nonTailable", &collectionScansNonTailableCounter);
 }  // namespace
 
@@ -69,18 +69,18 @@ void CollectionIndexUsageTracker::recordIndexAccess(StringData indexName) {
         return;
     }
 
-    // Increment the index usage atomic counter.
-    it->second->accesses.fetchAndAdd(1);
+    // Increment the index usage counter.
+    it->second->accesses.increment();
 }
 
 void CollectionIndexUsageTracker::recordCollectionScans(unsigned long long collectionScans) {
-    _collectionScans.fetchAndAdd(collectionScans);
+    _collectionScans.increment(collectionScans);
     collectionScansCounter.increment(collectionScans);
 }
 
 void CollectionIndexUsageTracker::recordCollectionScansNonTailable(
     unsigned long long collectionScansNonTailable) {
-    _collectionScansNonTailable.fetchAndAdd(collectionScansNonTailable);
+    _collectionScansNonTailable.increment(collectionScansNonTailable);
     collectionScansNonTailableCounter.increment(collectionScansNonTailable);
 }
 
@@ -123,6 +123,7 @@ CollectionIndexUsageTracker::getUsageStats() const {
 
 CollectionIndexUsageTracker::CollectionScanStats
 CollectionIndexUsageTracker::getCollectionScanStats() const {
-    return {_collectionScans.load(), _collectionScansNonTailable.load()};
+    return {static_cast<unsigned long long>(_collectionScans.get()),
+            static_cast<unsigned long long>(_collectionScansNonTailable.get())};
 }
 }  // namespace mongo
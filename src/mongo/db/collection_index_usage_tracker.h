@@ -31,6 +31,7 @@
 
 #include <boost/intrusive_ptr.hpp>
 
+#include "mongo/base/counter.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/platform/atomic_word.h"
@@ -72,19 +73,21 @@ public:
             : trackerStartTime(now), indexKey(key.getOwned()) {}
 
         IndexUsageStats(const IndexUsageStats& other)
-            : accesses(other.accesses.load()),
-              trackerStartTime(other.trackerStartTime),
-              indexKey(other.indexKey) {}
+            : trackerStartTime(other.trackerStartTime), indexKey(other.indexKey) {
+            accesses.increment(other.accesses.get());
+        }
 
         IndexUsageStats& operator=(const IndexUsageStats& other) {
-            accesses.store(other.accesses.load());
+            accesses.reset();
+            accesses.increment(other.accesses.get());
             trackerStartTime = other.trackerStartTime;
             indexKey = other.indexKey;
             return *this;
         }
 
-        // Number of operations that have used this index.
-        AtomicWord<long long> accesses;
+        // Number of operations that have used this index. Striped, since the indexes of a hot
+        // collection are used by operations running on every core at once.
+        StripedCounter64 accesses;
 
         // Date/Time that we started tracking index usage.
         Date_t trackerStartTime;
@@ -167,8 +170,8 @@ private:
     // be set.
     ClockSource* _clockSource;
 
-    AtomicWord<unsigned long long> _collectionScans{0};
-    AtomicWord<unsigned long long> _collectionScansNonTailable{0};
+    StripedCounter64 _collectionScans;
+    StripedCounter64 _collectionScansNonTailable;
 };
 
 }  // namespace mongo
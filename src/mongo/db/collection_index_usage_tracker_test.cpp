@@ -31,6 +31,7 @@
 
 #include "mongo/db/collection_index_usage_tracker.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 
@@ -71,7 +72,7 @@ TEST_F(CollectionIndexUsageTrackerTest, SingleHit) {
     getTracker()->recordIndexAccess("foo");
     auto statsMap = getTracker()->getUsageStats();
     ASSERT(statsMap->find("foo") != statsMap->end());
-    ASSERT_EQUALS(1, statsMap->at("foo")->accesses.loadRelaxed());
+    ASSERT_EQUALS(1, statsMap->at("foo")->accesses.get());
 }
 
 // Test that recording of multiple index hits are reflected in stats map.
@@ -81,7 +82,32 @@ TEST_F(CollectionIndexUsageTrackerTest, MultipleHit) {
     getTracker()->recordIndexAccess("foo");
     auto statsMap = getTracker()->getUsageStats();
     ASSERT(statsMap->find("foo") != statsMap->end());
-    ASSERT_EQUALS(2, statsMap->at("foo")->accesses.loadRelaxed());
+    ASSERT_EQUALS(2, statsMap->at("foo")->accesses.get());
+}
+
+// Test that hits recorded by concurrent threads are all counted, as are collection scans.
+TEST_F(CollectionIndexUsageTrackerTest, ConcurrentHits) {
+    constexpr int kNumThreads = 8;
+    constexpr int kNumHits = 1000;
+    getTracker()->registerIndex("foo", BSON("foo" << 1));
+
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kNumHits; ++j) {
+                getTracker()->recordIndexAccess("foo");
+                getTracker()->recordCollectionScans(1);
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    auto statsMap = getTracker()->getUsageStats();
+    ASSERT_EQUALS(kNumThreads * kNumHits, statsMap->at("foo")->accesses.get());
+    ASSERT_EQUALS(static_cast<unsigned long long>(kNumThreads * kNumHits),
+                  getTracker()->getCollectionScanStats().collectionScans);
 }
 
 // Test that an index is registered correctly with indexKey.
@@ -118,7 +144,7 @@ TEST_F(CollectionIndexUsageTrackerTest, HitAfterDeregister) {
     getTracker()->recordIndexAccess("foo");
     auto statsMap = getTracker()->getUsageStats();
     ASSERT(statsMap->find("foo") != statsMap->end());
-    ASSERT_EQUALS(2, statsMap->at("foo")->accesses.loadRelaxed());
+    ASSERT_EQUALS(2, statsMap->at("foo")->accesses.get());
 
     getTracker()->unregisterIndex("foo");
     statsMap = getTracker()->getUsageStats();
@@ -128,7 +154,7 @@ TEST_F(CollectionIndexUsageTrackerTest, HitAfterDeregister) {
     getTracker()->recordIndexAccess("foo");
     statsMap = getTracker()->getUsageStats();
     ASSERT(statsMap->find("foo") != statsMap->end());
-    ASSERT_EQUALS(1, statsMap->at("foo")->accesses.loadRelaxed());
+    ASSERT_EQUALS(1, statsMap->at("foo")->accesses.get());
 }
 
 // Test that index tracker start date/time is reset on index deregistration/registration.
@@ -159,7 +185,7 @@ TEST_F(CollectionIndexUsageTrackerTest, UsageStatsMapRemainsValidAfterIndexErasu
     getTracker()->recordIndexAccess("foo");
     auto statsMap = getTracker()->getUsageStats();
     ASSERT(statsMap->find("foo") != statsMap->end());
-    ASSERT_EQUALS(2, statsMap->at("foo")->accesses.loadRelaxed());
+    ASSERT_EQUALS(2, statsMap->at("foo")->accesses.get());
 
     // Fetch the map with the index and then erase the index from the map. The previously fetched
     // map should still safely retain the index.
@@ -170,7 +196,7 @@ TEST_F(CollectionIndexUsageTrackerTest, UsageStatsMapRemainsValidAfterIndexErasu
     ASSERT(statsMap->find("foo") == statsMap->end());
 
     ASSERT(staleStatsMap->find("foo") != staleStatsMap->end());
-    ASSERT_EQUALS(2, staleStatsMap->at("foo")->accesses.loadRelaxed());
+    ASSERT_EQUALS(2, staleStatsMap->at("foo")->accesses.get());
 }
 
 // Test that a stale stats map copy's index remains unmodified after the up-to-date map removes and
@@ -181,7 +207,7 @@ TEST_F(CollectionIndexUsageTrackerTest, StaleUsageStatsMapEntryIsNotUpdatedAfter
     getTracker()->recordIndexAccess("foo");
     auto statsMap = getTracker()->getUsageStats();
     ASSERT(statsMap->find("foo") != statsMap->end());
-    ASSERT_EQUALS(1, statsMap->at("foo")->accesses.loadRelaxed());
+    ASSERT_EQUALS(1, statsMap->at("foo")->accesses.get());
 
     // Fetch a copy of the map with the index and then erase and recreate the index in the map with
     // a different usage count. The previously fetched copy of the map should still safely retain
@@ -194,10 +220,10 @@ TEST_F(CollectionIndexUsageTrackerTest, StaleUsageStatsMapEntryIsNotUpdatedAfter
     getTracker()->recordIndexAccess("foo");
     statsMap = getTracker()->getUsageStats();
     ASSERT(statsMap->find("foo") != statsMap->end());
-    ASSERT_EQUALS(2, statsMap->at("foo")->accesses.loadRelaxed());
+    ASSERT_EQUALS(2, statsMap->at("foo")->accesses.get());
 
     ASSERT(staleStatsMap->find("foo") != staleStatsMap->end());
-    ASSERT_EQUALS(1, staleStatsMap->at("foo")->accesses.loadRelaxed());
+    ASSERT_EQUALS(1, staleStatsMap->at("foo")->accesses.get());
 }
 
 }  // namespace
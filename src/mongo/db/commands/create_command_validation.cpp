@@ -29,6 +29,8 @@
 
 #include "mongo/db/commands/create_command_validation.h"
 
+#include "mongo/util/ctype.h"
+
 namespace mongo::create_command_validation {
 namespace {
 Status validateNotEmpty(StringData name, bool isEmpty) {
@@ -70,4 +72,24 @@ Status validateStorageEngineOptions(const BSONObj& storageEngine) {
     }
     return Status::OK();
 }
+
+Status validateStorageTier(const std::string& storageTier) {
+    // The tier names a directory under the dbpath, so it is limited to characters which are safe
+    // in a path component on every platform.
+    const size_t kMaxStorageTierLength = 64;
+    if (storageTier.empty() || storageTier.size() > kMaxStorageTierLength) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "'storageTier' must be between 1 and " << kMaxStorageTierLength
+                              << " characters long"};
+    }
+    for (char c : storageTier) {
+        if (!ctype::isAlnum(c) && c != '_' && c != '-') {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "'storageTier' may only contain letters, digits, '_' and "
+                                     "'-': "
+                                  << storageTier};
+        }
+    }
+    return Status::OK();
+}
 }  // namespace mongo::create_command_validation
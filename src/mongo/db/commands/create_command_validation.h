@@ -38,4 +38,6 @@ Status validateCollationNotEmpty(const BSONObj& collation);
 Status validateViewOnNotEmpty(const std::string& viewOn);
 
 Status validateStorageEngineOptions(const BSONObj& storageEngine);
+
+Status validateStorageTier(const std::string& storageTier);
 }  // namespace mongo::create_command_validation
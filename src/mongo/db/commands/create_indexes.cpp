@@ -63,7 +63,10 @@
 #include "mongo/idl/command_generic_argument.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/compiler.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/s/shard_key_pattern.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/future.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/uuid.h"
 
@@ -433,6 +436,92 @@ BSONObj runCreateIndexesOnNewCollection(OperationContext* opCtx,
     return createResult.obj();
 }
 
+/**
+ * Lets createIndexes commands on the same collection that arrive within
+ * 'indexBuildCoalescingWindowMillis' of each other share one index build, and so one collection
+ * scan. The first command to arrive leads the group: it waits out the window, then starts a single
+ * index build for the union of the specs that joined. The other commands wait for that build and
+ * report its outcome as their own.
+ */
+class IndexBuildCoalescer {
+public:
+    struct Group {
+        explicit Group(boost::optional<CommitQuorumOptions> commitQuorum)
+            : commitQuorum(std::move(commitQuorum)) {}
+
+        const UUID buildUUID = UUID::gen();
+        const boost::optional<CommitQuorumOptions> commitQuorum;
+
+        // Guarded by the coalescer's mutex until the leader closes the group.
+        std::vector<BSONObj> specs;
+
+        SharedPromise<ReplIndexBuildState::IndexCatalogStats> promise;
+    };
+
+    /**
+     * Adds 'specs' to the open group for 'collectionUUID', or opens a new one. Returns the group
+     * and whether the caller leads it. A group with a different commit quorum, or with a spec
+     * sharing a name or key pattern with one of 'specs', is not joined because the combined build
+     * would fail for every member.
+     */
+    std::pair<std::shared_ptr<Group>, bool> join(
+        const UUID& collectionUUID,
+        const std::vector<BSONObj>& specs,
+        const boost::optional<CommitQuorumOptions>& commitQuorum) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _openGroups.find(collectionUUID);
+        if (it != _openGroups.end() && _canJoin(*it->second, specs, commitQuorum)) {
+            auto& group = it->second;
+            group->specs.insert(group->specs.end(), specs.begin(), specs.end());
+            return {group, false};
+        }
+
+        // A group that can't be joined keeps running; the new group only takes its place for
+        // commands arriving later.
+        auto group = std::make_shared<Group>(commitQuorum);
+        group->specs = specs;
+        _openGroups[collectionUUID] = group;
+        return {group, true};
+    }
+
+    /**
+     * Stops 'group' accepting new members and returns the specs it will build.
+     */
+    std::vector<BSONObj> close(const UUID& collectionUUID, const std::shared_ptr<Group>& group) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _openGroups.find(collectionUUID);
+        if (it != _openGroups.end() && it->second == group) {
+            _openGroups.erase(it);
+        }
+        return group->specs;
+    }
+
+private:
+    static bool _canJoin(const Group& group,
+                         const std::vector<BSONObj>& specs,
+                         const boost::optional<CommitQuorumOptions>& commitQuorum) {
+        if (group.commitQuorum != commitQuorum) {
+            return false;
+        }
+        for (const auto& spec : specs) {
+            for (const auto& groupSpec : group.specs) {
+                if (spec[IndexDescriptor::kIndexNameFieldName].valueStringDataSafe() ==
+                        groupSpec[IndexDescriptor::kIndexNameFieldName].valueStringDataSafe() ||
+                    spec[IndexDescriptor::kKeyPatternFieldName].Obj().woCompare(
+                        groupSpec[IndexDescriptor::kKeyPatternFieldName].Obj()) == 0) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("IndexBuildCoalescer::_mutex");
+    stdx::unordered_map<UUID, std::shared_ptr<Group>, UUID::Hash> _openGroups;
+};
+
+IndexBuildCoalescer indexBuildCoalescer;
+
 bool runCreateIndexesWithCoordinator(OperationContext* opCtx,
                                      const std::string& dbname,
                                      const BSONObj& cmdObj,
@@ -531,10 +620,63 @@ bool runCreateIndexesWithCoordinator(OperationContext* opCtx,
                          AutoStatsTracker::LogMode::kUpdateTopAndCurOp,
                          CollectionCatalog::get(opCtx)->getDatabaseProfileLevel(ns.db()));
 
+    const int numSpecs = specs.size();
     auto buildUUID = UUID::gen();
     ReplIndexBuildState::IndexCatalogStats stats;
     IndexBuildsCoordinator::IndexBuildOptions indexBuildOptions = {commitQuorum};
 
+    std::shared_ptr<IndexBuildCoalescer::Group> coalescedGroup;
+    if (const Milliseconds coalescingWindow{indexBuildCoalescingWindowMillis.load()};
+        coalescingWindow > Milliseconds(0)) {
+        bool isLeader;
+        std::tie(coalescedGroup, isLeader) =
+            indexBuildCoalescer.join(*collectionUUID, specs, commitQuorum);
+        buildUUID = coalescedGroup->buildUUID;
+
+        if (!isLeader) {
+            LOGV2(5843212,
+                  "Index build: joining an index build that is waiting to start",
+                  "buildUUID"_attr = buildUUID,
+                  "namespace"_attr = ns,
+                  "collectionUUID"_attr = *collectionUUID,
+                  "indexes"_attr = specs.size());
+            try {
+                // Interrupting this command leaves the shared build running for the other members
+                // of the group. It can still be aborted through dropIndexes.
+                stats = coalescedGroup->promise.getFuture().get(opCtx);
+            } catch (DBException& ex) {
+                if (ErrorCodes::NamespaceNotFound == ex.code()) {
+                    return true;
+                }
+                ex.addContext(str::stream()
+                              << "Index build failed: " << buildUUID << ": Collection " << ns
+                              << " ( " << *collectionUUID << " )");
+                repl::ReplClientInfo::forClient(opCtx->getClient())
+                    .setLastOpToSystemLastOpTime(opCtx);
+                throw;
+            }
+
+            repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
+            appendFinalIndexFieldsToResult(
+                stats.numIndexesBefore, stats.numIndexesAfter, result, numSpecs, commitQuorum);
+            return true;
+        }
+
+        // Close the group whether or not the wait is interrupted, so that its members are not left
+        // waiting for a build that never starts.
+        ON_BLOCK_EXIT([&] { specs = indexBuildCoalescer.close(*collectionUUID, coalescedGroup); });
+        opCtx->sleepFor(coalescingWindow);
+    }
+
+    // Members which joined a coalesced build see the same outcome as this command.
+    auto notifyGroup = makeGuard([&] {
+        if (coalescedGroup) {
+            coalescedGroup->promise.setError(
+                {ErrorCodes::IndexBuildAborted,
+                 str::stream() << "Index build " << buildUUID << " did not complete"});
+        }
+    });
+
     LOGV2(20438,
           "Index build: registering",
           "buildUUID"_attr = buildUUID,
@@ -647,6 +789,10 @@ bool runCreateIndexesWithCoordinator(OperationContext* opCtx,
                   "namespace"_attr = ns,
                   "collectionUUID"_attr = *collectionUUID,
                   "exception"_attr = ex);
+            if (coalescedGroup) {
+                coalescedGroup->promise.setError(ex.toStatus());
+                notifyGroup.dismiss();
+            }
             return true;
         }
 
@@ -659,6 +805,11 @@ bool runCreateIndexesWithCoordinator(OperationContext* opCtx,
         }
 
         // All other errors should be forwarded to the caller with index build information included.
+        if (coalescedGroup) {
+            coalescedGroup->promise.setError(ex.toStatus());
+            notifyGroup.dismiss();
+        }
+
         ex.addContext(str::stream() << "Index build failed: " << buildUUID << ": Collection " << ns
                                     << " ( " << *collectionUUID << " )");
 
@@ -674,8 +825,13 @@ bool runCreateIndexesWithCoordinator(OperationContext* opCtx,
     // getLastError results as the previous non-IndexBuildsCoordinator behavior.
     repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
 
+    if (coalescedGroup) {
+        coalescedGroup->promise.emplaceValue(stats);
+        notifyGroup.dismiss();
+    }
+
     appendFinalIndexFieldsToResult(
-        stats.numIndexesBefore, stats.numIndexesAfter, result, int(specs.size()), commitQuorum);
+        stats.numIndexesBefore, stats.numIndexesAfter, result, numSpecs, commitQuorum);
 
     return true;
 }
@@ -381,6 +381,56 @@ public:
                     cmd.getViewOn());
         }
 
+        if (cmd.getStorageTier()) {
+            uassert(ErrorCodes::InvalidOptions,
+                    "'storageTier' is not allowed with 'viewOn'",
+                    !cmd.getViewOn());
+        }
+
+        if (cmd.getClustered().value_or(false)) {
+            const auto clusteredNotAllowedWith = [&nsToCreate](StringData option) -> std::string {
+                return str::stream()
+                    << nsToCreate << ": 'clustered' is not allowed with '" << option << "'";
+            };
+
+            uassert(
+                ErrorCodes::InvalidOptions, clusteredNotAllowedWith("capped"), !cmd.getCapped());
+            uassert(ErrorCodes::InvalidOptions,
+                    clusteredNotAllowedWith("autoIndexId"),
+                    !cmd.getAutoIndexId());
+            uassert(
+                ErrorCodes::InvalidOptions, clusteredNotAllowedWith("idIndex"), !cmd.getIdIndex());
+            uassert(
+                ErrorCodes::InvalidOptions, clusteredNotAllowedWith("viewOn"), !cmd.getViewOn());
+            uassert(ErrorCodes::InvalidOptions,
+                    clusteredNotAllowedWith("timeseries"),
+                    !cmd.getTimeseries());
+
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream()
+                        << nsToCreate
+                        << ": the documents of a clustered collection are keyed by their _id, "
+                           "which must be a positive 64-bit integer. Inserts of documents with "
+                           "any other _id, including the ObjectId generated for documents "
+                           "without one, will fail. Specify clusteredIdType: 'long' to create "
+                           "the collection anyway",
+                    cmd.getClusteredIdType() == "long"_sd);
+        } else {
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << nsToCreate
+                                  << ": 'clusteredIdType' requires 'clustered' to be set",
+                    !cmd.getClusteredIdType());
+        }
+
+        if (cmd.getMaterialized().value_or(false)) {
+            uassert(ErrorCodes::InvalidOptions,
+                    "'materialized' requires 'viewOn' to also be specified",
+                    cmd.getViewOn());
+            uassert(ErrorCodes::InvalidOptions,
+                    "'materialized' cannot be used with a sharded cluster",
+                    serverGlobalParams.clusterRole == ClusterRole::None);
+        }
+
         if (auto timeseries = cmd.getTimeseries()) {
             uassert(ErrorCodes::InvalidOptions,
                     "Time-series collection is not enabled",
@@ -804,6 +854,10 @@ public:
             CurOp::get(opCtx)->setNS_inlock(dbname);
         }
 
+        // The statistics are read from the catalog and the storage engine's size counters, which
+        // are approximate anyway, so there is no need to wait for an oplog batch to finish
+        // applying.
+        ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWMBlock(opCtx->lockState());
         AutoGetDb autoDb(opCtx, ns, MODE_IS);
 
         result.append("db", ns);
@@ -32,6 +32,7 @@
 #include "mongo/platform/basic.h"
 
 #include <boost/optional.hpp>
+#include <cstring>
 #include <map>
 #include <set>
 #include <string>
@@ -59,6 +60,38 @@ namespace mongo {
 
 namespace {
 
+/**
+ * Options which narrow down or break up the hash of each collection, so that the members of a
+ * replica set can compare large collections piece by piece.
+ */
+struct HashOptions {
+    // If set, the _id index is scanned over [min, max) instead of in full.
+    BSONElement min;
+    BSONElement max;
+
+    // If non-zero, each collection's documents are also hashed in ranges of about this many
+    // documents. A range ends after each document whose _id hashes to a multiple of 'rangeSize',
+    // so a document missing from one member only changes the hash of its own range.
+    long long rangeSize = 0;
+};
+
+/**
+ * Returns whether a range of documents ends with the document whose _id is 'id'.
+ */
+bool isRangeBoundary(const BSONElement& id, long long rangeSize) {
+    md5_state_t st;
+    md5_init(&st);
+    const char type = id.type();
+    md5_append(&st, reinterpret_cast<const md5_byte_t*>(&type), sizeof(type));
+    md5_append(&st, reinterpret_cast<const md5_byte_t*>(id.value()), id.valuesize());
+    md5digest d;
+    md5_finish(&st, d);
+
+    uint32_t prefix;
+    std::memcpy(&prefix, d, sizeof(prefix));
+    return prefix % static_cast<uint64_t>(rangeSize) == 0;
+}
+
 class DBHashCmd : public ErrmsgCommandDeprecated {
 public:
     DBHashCmd() : ErrmsgCommandDeprecated("dbHash", "dbhash") {}
@@ -131,6 +164,16 @@ public:
             }
         }
 
+        HashOptions hashOptions;
+        hashOptions.min = cmdObj["min"];
+        hashOptions.max = cmdObj["max"];
+        if (auto rangeSize = cmdObj["rangeSize"]) {
+            uassert(ErrorCodes::BadValue,
+                    "'rangeSize' must be a positive number",
+                    rangeSize.isNumber() && rangeSize.safeNumberLong() > 0);
+            hashOptions.rangeSize = rangeSize.safeNumberLong();
+        }
+
         const std::string ns = parseNs(dbname, cmdObj);
         uassert(ErrorCodes::InvalidNamespace,
                 str::stream() << "Invalid db name: " << ns,
@@ -227,6 +270,7 @@ public:
         md5_init(&globalState);
 
         std::map<std::string, std::string> collectionToHashMap;
+        std::map<std::string, BSONArray> collectionToRangesMap;
         std::map<std::string, OptionalCollectionUUID> collectionToUUIDMap;
         std::set<std::string> cappedCollectionSet;
 
@@ -269,9 +313,14 @@ public:
                 }
 
                 // Compute the hash for this collection.
-                std::string hash = _hashCollection(opCtx, db, collNss);
+                BSONArrayBuilder ranges;
+                std::string hash = _hashCollection(
+                    opCtx, db, collNss, hashOptions, hashOptions.rangeSize ? &ranges : nullptr);
 
                 collectionToHashMap[collNss.coll().toString()] = hash;
+                if (hashOptions.rangeSize) {
+                    collectionToRangesMap[collNss.coll().toString()] = ranges.arr();
+                }
 
                 return true;
             });
@@ -304,6 +353,13 @@ public:
         result.append("capped", BSONArray(cappedCollections.done()));
         result.append("uuids", collectionsByUUID.done());
 
+        if (hashOptions.rangeSize) {
+            BSONObjBuilder rangesBuilder(result.subobjStart("ranges"));
+            for (const auto& [collName, ranges] : collectionToRangesMap) {
+                rangesBuilder.append(collName, ranges);
+            }
+        }
+
         md5digest d;
         md5_finish(&globalState, d);
         std::string hash = digestToString(d);
@@ -315,7 +371,15 @@ public:
     }
 
 private:
-    std::string _hashCollection(OperationContext* opCtx, Database* db, const NamespaceString& nss) {
+    /**
+     * Returns the hash of the documents of the collection 'nss'. If 'ranges' is set, also appends
+     * to it the first _id, number of documents and hash of each range of documents.
+     */
+    std::string _hashCollection(OperationContext* opCtx,
+                                Database* db,
+                                const NamespaceString& nss,
+                                const HashOptions& hashOptions,
+                                BSONArrayBuilder* ranges) {
 
         CollectionPtr collection =
             CollectionCatalog::get(opCtx)->lookupCollectionByNamespace(opCtx, nss);
@@ -347,18 +411,48 @@ private:
 
         auto desc = collection->getIndexCatalog()->findIdIndex(opCtx);
 
+        const bool hasBounds = hashOptions.min || hashOptions.max;
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "dbHash can only hash a range of _ids of a collection with a "
+                                 "simple collation _id index, which "
+                              << nss << " doesn't have",
+                !hasBounds || (desc && !collection->getDefaultCollator()));
+
+        BSONObj startKey;
+        BSONObj endKey;
+        auto boundInclusion = BoundInclusion::kIncludeStartKeyOnly;
+        if (hasBounds) {
+            BSONObjBuilder startKeyBuilder;
+            if (hashOptions.min) {
+                startKeyBuilder.appendAs(hashOptions.min, "");
+            } else {
+                startKeyBuilder.appendMinKey("");
+            }
+            startKey = startKeyBuilder.obj();
+
+            BSONObjBuilder endKeyBuilder;
+            if (hashOptions.max) {
+                endKeyBuilder.appendAs(hashOptions.max, "");
+            } else {
+                endKeyBuilder.appendMaxKey("");
+                boundInclusion = BoundInclusion::kIncludeBothStartAndEndKeys;
+            }
+            endKey = endKeyBuilder.obj();
+        }
+
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
         if (desc) {
             exec = InternalPlanner::indexScan(opCtx,
                                               &collection,
                                               desc,
-                                              BSONObj(),
-                                              BSONObj(),
-                                              BoundInclusion::kIncludeStartKeyOnly,
+                                              startKey,
+                                              endKey,
+                                              boundInclusion,
                                               PlanYieldPolicy::YieldPolicy::NO_YIELD,
                                               InternalPlanner::FORWARD,
                                               InternalPlanner::IXSCAN_FETCH);
-        } else if (collection->isCapped()) {
+        } else if (collection->isCapped() || collection->getRecordStore()->isClustered()) {
+            // A clustered collection is scanned in _id order, as it is keyed by _id.
             exec = InternalPlanner::collectionScan(
                 opCtx, nss.ns(), &collection, PlanYieldPolicy::YieldPolicy::NO_YIELD);
         } else {
@@ -372,6 +466,18 @@ private:
         md5_state_t st;
         md5_init(&st);
 
+        md5_state_t rangeState;
+        boost::optional<BSONObjBuilder> range;
+        long long rangeCount = 0;
+        auto finishRange = [&] {
+            md5digest d;
+            md5_finish(&rangeState, d);
+            range->appendNumber("count", rangeCount);
+            range->append("md5", digestToString(d));
+            ranges->append(range->obj());
+            range.reset();
+        };
+
         try {
             long long n = 0;
             BSONObj c;
@@ -379,6 +485,28 @@ private:
             while (exec->getNext(&c, nullptr) == PlanExecutor::ADVANCED) {
                 md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
                 n++;
+
+                if (ranges) {
+                    const auto id = c["_id"];
+                    if (!range) {
+                        range.emplace();
+                        if (id) {
+                            range->appendAs(id, "min");
+                        } else {
+                            range->appendNull("min");
+                        }
+                        md5_init(&rangeState);
+                        rangeCount = 0;
+                    }
+                    md5_append(&rangeState, (const md5_byte_t*)c.objdata(), c.objsize());
+                    ++rangeCount;
+                    if (id && isRangeBoundary(id, hashOptions.rangeSize)) {
+                        finishRange();
+                    }
+                }
+            }
+            if (range) {
+                finishRange();
             }
         } catch (DBException& exception) {
             LOGV2_WARNING(
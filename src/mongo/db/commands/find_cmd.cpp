@@ -56,6 +56,7 @@
 #include "mongo/db/transaction_participant.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -465,9 +466,11 @@ public:
             PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
             std::uint64_t numResults = 0;
             bool stashedResult = false;
+            Timer batchTimer;
 
             try {
                 while (!FindCommon::enoughForFirstBatch(originalQR, numResults) &&
+                       !FindCommon::batchTimeBudgetExhausted(batchTimer, numResults) &&
                        PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
                     // If we can't fit this result inside the current batch, then we stash it for
                     // later.
@@ -62,6 +62,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -311,8 +312,10 @@ public:
             // timeout to the user.
             BSONObj obj;
             PlanExecutor::ExecState state;
+            Timer batchTimer;
             try {
                 while (!FindCommon::enoughForGetMore(request.batchSize.value_or(0), *numResults) &&
+                       !FindCommon::batchTimeBudgetExhausted(batchTimer, *numResults) &&
                        PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
                     // If adding this object will cause us to exceed the message size limit, then we
                     // stash it for later.
@@ -151,8 +151,16 @@ BSONObj buildViewBson(const ViewDefinition& view, bool nameOnly) {
     }
 
     BSONObjBuilder optionsBuilder(b.subobjStart("options"));
-    optionsBuilder.append("viewOn", view.viewOn().coll());
-    optionsBuilder.append("pipeline", view.pipeline());
+    // Report a materialized view with the options it was created with rather than as a view on
+    // its backing collection.
+    if (auto&& materialization = view.materialization()) {
+        optionsBuilder.append("viewOn", materialization->from.coll());
+        optionsBuilder.append("pipeline", materialization->pipeline);
+        optionsBuilder.append("materialized", true);
+    } else {
+        optionsBuilder.append("viewOn", view.viewOn().coll());
+        optionsBuilder.append("pipeline", view.pipeline());
+    }
     if (view.defaultCollator()) {
         optionsBuilder.append("collation", view.defaultCollator()->getSpec().toBSON());
     }
@@ -296,6 +304,9 @@ public:
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
         std::vector<mongo::ListCollectionsReplyItem> firstBatch;
         {
+            // Only the catalog is read, which oplog application changes in batches of their own
+            // under exclusive locks, so there is no need to wait for a batch to finish applying.
+            ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWMBlock(opCtx->lockState());
             AutoGetDb autoDb(opCtx, dbname, MODE_IS);
             Database* db = autoDb.getDb();
 
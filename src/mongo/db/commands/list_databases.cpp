@@ -137,6 +137,10 @@ public:
             filter = std::move(matcher);
         }
 
+        // Only the catalog and storage sizes are read, so there is no need to wait for an oplog
+        // batch to finish applying.
+        ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWMBlock(opCtx->lockState());
+
         vector<string> dbNames;
         StorageEngine* storageEngine = getGlobalServiceContext()->getStorageEngine();
         {
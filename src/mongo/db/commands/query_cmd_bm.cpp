@@ -0,0 +1,211 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/client.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("query_bm.coll");
+const NamespaceString kForeignNss("query_bm.foreign");
+
+constexpr int kNumDocs = 10000;
+constexpr int kNumForeignDocs = 100;
+
+// Large enough for every benchmarked query to return all of its results in the first batch, so
+// that no cursor is left open.
+constexpr int kBatchSize = kNumDocs * 3 + 1;
+
+/**
+ * Starts a mongod service context on the ephemeralForTest storage engine and fills 'kNss' and
+ * 'kForeignNss' with documents to query. The unit test fixture does the storage engine setup in its
+ * constructor, so it is reused here without running it as a test.
+ */
+class QueryBenchmarkFixture : public ServiceContextMongoDTest {
+public:
+    QueryBenchmarkFixture() {
+        auto service = getServiceContext();
+        repl::ReplicationCoordinator::set(
+            service, std::make_unique<repl::ReplicationCoordinatorMock>(service));
+        _opCtx = cc().makeOperationContext();
+
+        DBDirectClient client(_opCtx.get());
+        client.createIndex(kNss.ns(), BSON("a" << 1));
+
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < kNumDocs; ++i) {
+            docs.push_back(BSON("_id" << i << "a" << i << "b" << i % kNumForeignDocs << "c"
+                                      << "padding"
+                                      << "arr" << BSON_ARRAY(i << i + 1 << i + 2)));
+            if (docs.size() == 1000) {
+                client.insert(kNss.ns(), docs);
+                docs.clear();
+            }
+        }
+
+        for (int i = 0; i < kNumForeignDocs; ++i) {
+            docs.push_back(BSON("_id" << i << "name"
+                                      << "foreign"));
+        }
+        client.insert(kForeignNss.ns(), docs);
+    }
+
+    ~QueryBenchmarkFixture() {
+        _opCtx.reset();
+        tearDown();
+    }
+
+    /**
+     * Runs 'cmdObj' against the benchmark database and returns the number of documents in the
+     * first batch of the resulting cursor.
+     */
+    size_t runQuery(const BSONObj& cmdObj) {
+        auto request = OpMsgRequest::fromDBAndBody(kNss.db(), cmdObj);
+        auto result = CommandHelpers::runCommandDirectly(_opCtx.get(), request);
+        invariant(getStatusFromCommandResult(result));
+        return result["cursor"]["firstBatch"].Obj().nFields();
+    }
+
+private:
+    void _doTest() override {}
+
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+/**
+ * Runs 'cmdObj' in the execution engine selected by the benchmark argument, and reports the cost
+ * per examined document, of which each run of the query examines 'docsPerQuery'.
+ */
+void runQueryBenchmark(benchmark::State& state, const BSONObj& cmdObj, int docsPerQuery) {
+    const bool useSbe = state.range(0);
+    state.SetLabel(useSbe ? "sbe" : "classic");
+
+    const auto originalUseSbe = internalQueryEnableSlotBasedExecutionEngine.load();
+    ON_BLOCK_EXIT([&] { internalQueryEnableSlotBasedExecutionEngine.store(originalUseSbe); });
+    internalQueryEnableSlotBasedExecutionEngine.store(useSbe);
+
+    QueryBenchmarkFixture fixture;
+    size_t numResults = 0;
+    for (auto _ : state) {
+        numResults += fixture.runQuery(cmdObj);
+    }
+    benchmark::DoNotOptimize(numResults);
+    state.SetItemsProcessed(state.iterations() * docsPerQuery);
+}
+
+BSONObj makeFind(BSONObj filter, BSONObj sort = BSONObj()) {
+    return BSON("find" << kNss.coll() << "filter" << filter << "sort" << sort << "batchSize"
+                       << kBatchSize);
+}
+
+BSONObj makeAggregate(BSONArray pipeline) {
+    return BSON("aggregate" << kNss.coll() << "pipeline" << pipeline << "cursor"
+                            << BSON("batchSize" << kBatchSize));
+}
+
+void BM_FindPointLookup(benchmark::State& state) {
+    runQueryBenchmark(state, makeFind(BSON("a" << kNumDocs / 2)), 1);
+}
+
+void BM_FindIndexedRange(benchmark::State& state) {
+    runQueryBenchmark(state, makeFind(BSON("a" << BSON("$gte" << 1000 << "$lt" << 2000))), 1000);
+}
+
+void BM_FindCollScan(benchmark::State& state) {
+    runQueryBenchmark(state, makeFind(BSON("b" << 7)), kNumDocs);
+}
+
+void BM_FindSort(benchmark::State& state) {
+    runQueryBenchmark(state, makeFind(BSONObj(), BSON("b" << 1 << "a" << -1)), kNumDocs);
+}
+
+void BM_AggregateGroup(benchmark::State& state) {
+    runQueryBenchmark(
+        state,
+        makeAggregate(BSON_ARRAY(BSON(
+            "$group" << BSON("_id"
+                             << "$b"
+                             << "total" << BSON("$sum"
+                                                << "$a"))))),
+        kNumDocs);
+}
+
+void BM_AggregateSort(benchmark::State& state) {
+    runQueryBenchmark(state,
+                      makeAggregate(BSON_ARRAY(BSON("$sort" << BSON("c" << 1 << "a" << -1)))),
+                      kNumDocs);
+}
+
+void BM_AggregateUnwind(benchmark::State& state) {
+    // Count the unwound documents, rather than returning all of them.
+    auto count = BSON("$group" << BSON("_id" << BSONNULL << "n" << BSON("$sum" << 1)));
+    runQueryBenchmark(state,
+                      makeAggregate(BSON_ARRAY(BSON("$unwind"
+                                                    << "$arr")
+                                               << count)),
+                      kNumDocs);
+}
+
+void BM_AggregateLookup(benchmark::State& state) {
+    runQueryBenchmark(
+        state,
+        makeAggregate(BSON_ARRAY(
+            BSON("$match" << BSON("a" << BSON("$lt" << 500)))
+            << BSON("$lookup" << BSON("from" << kForeignNss.coll() << "localField"
+                                             << "b"
+                                             << "foreignField"
+                                             << "_id"
+                                             << "as"
+                                             << "joined")))),
+        500);
+}
+
+// Each benchmark runs once with the classic engine (0) and once with SBE (1).
+BENCHMARK(BM_FindPointLookup)->Arg(0)->Arg(1);
+BENCHMARK(BM_FindIndexedRange)->Arg(0)->Arg(1);
+BENCHMARK(BM_FindCollScan)->Arg(0)->Arg(1);
+BENCHMARK(BM_FindSort)->Arg(0)->Arg(1);
+BENCHMARK(BM_AggregateGroup)->Arg(0)->Arg(1);
+BENCHMARK(BM_AggregateSort)->Arg(0)->Arg(1);
+BENCHMARK(BM_AggregateUnwind)->Arg(0)->Arg(1);
+BENCHMARK(BM_AggregateLookup)->Arg(0)->Arg(1);
+
+}  // namespace
+}  // namespace mongo
@@ -56,6 +56,7 @@
 #include "mongo/db/pipeline/pipeline_d.h"
 #include "mongo/db/pipeline/plan_executor_pipeline.h"
 #include "mongo/db/pipeline/process_interface/mongo_process_interface.h"
+#include "mongo/db/query/aggregation_result_cache.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/cursor_response.h"
@@ -71,10 +72,13 @@
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/views/materialized_view_maintenance.h"
 #include "mongo/db/views/view.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/clock_source.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/string_map.h"
 
@@ -111,7 +115,8 @@ bool canOptimizeAwayPipeline(const Pipeline* pipeline,
  * Returns true if we need to keep a ClientCursor saved for this pipeline (for future getMore
  * requests). Otherwise, returns false. The passed 'nsForCursor' is only used to determine the
  * namespace used in the returned cursor, which will be registered with the global cursor manager,
- * and thus will be different from that in 'request'.
+ * and thus will be different from that in 'request'. If 'batchToCache' is not null, the documents
+ * returned in the first batch are also copied to it.
  */
 bool handleCursorCommand(OperationContext* opCtx,
                          boost::intrusive_ptr<ExpressionContext> expCtx,
@@ -119,7 +124,8 @@ bool handleCursorCommand(OperationContext* opCtx,
                          std::vector<ClientCursor*> cursors,
                          const AggregationRequest& request,
                          const BSONObj& cmdObj,
-                         rpc::ReplyBuilderInterface* result) {
+                         rpc::ReplyBuilderInterface* result,
+                         std::vector<BSONObj>* batchToCache) {
     invariant(!cursors.empty());
     long long batchSize = request.getBatchSize();
 
@@ -221,6 +227,9 @@ bool handleCursorCommand(OperationContext* opCtx,
         // If this executor produces a postBatchResumeToken, add it to the cursor response.
         responseBuilder.setPostBatchResumeToken(exec->getPostBatchResumeToken());
         responseBuilder.append(nextDoc);
+        if (batchToCache) {
+            batchToCache->push_back(nextDoc.getOwned());
+        }
     }
 
     if (cursor) {
@@ -251,6 +260,98 @@ bool handleCursorCommand(OperationContext* opCtx,
     return static_cast<bool>(cursor);
 }
 
+/**
+ * Returns whether the results of 'request' may be looked up in, and added to, the aggregation
+ * result cache: its pipeline must only read collections, and read the latest committed data
+ * without being versioned by a router, so that its results can only change through writes to
+ * the collections it reads.
+ */
+bool canUseResultCache(OperationContext* opCtx,
+                       const NamespaceString& nss,
+                       const AggregationRequest& request,
+                       const LiteParsedPipeline& liteParsedPipeline) {
+    if (!AggregationResultCache::enabled()) {
+        return false;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    return !request.getExplain() && !request.getExchangeSpec() && !request.getCollectionUUID() &&
+        !request.getRuntimeConstants() && !request.isFromMongos() && request.getBatchSize() > 0 &&
+        !nss.isCollectionlessAggregateNS() && !liteParsedPipeline.hasChangeStream() &&
+        !liteParsedPipeline.startsWithInitialSource() && !opCtx->inMultiDocumentTransaction() &&
+        !ShardingState::get(opCtx)->enabled() &&
+        readConcernArgs.getLevel() == repl::ReadConcernLevel::kLocalReadConcern &&
+        !readConcernArgs.getArgsOpTime() && !readConcernArgs.getArgsAfterClusterTime() &&
+        !readConcernArgs.getArgsAtClusterTime() &&
+        AggregationResultCache::isCacheablePipeline(request.getPipeline(),
+                                                    request.getLetParameters());
+}
+
+/**
+ * Returns the key under which the results of 'request' are cached. It identifies the pipeline by
+ * its stages as specified, literals included, along with the options which may affect the results.
+ */
+BSONObj makeResultCacheKey(const NamespaceString& nsForCursor, const AggregationRequest& request) {
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("ns", nsForCursor.ns());
+    keyBuilder.append("executionNs", request.getNamespaceString().ns());
+    keyBuilder.append("pipeline", request.getPipeline());
+    keyBuilder.append("collation", request.getCollation());
+    keyBuilder.append("hint", request.getHint());
+    keyBuilder.append("let", request.getLetParameters());
+    keyBuilder.append("batchSize", request.getBatchSize());
+    keyBuilder.append("allowDiskUse", request.shouldAllowDiskUse());
+    return keyBuilder.obj();
+}
+
+/**
+ * Returns whether the results of an aggregation reading 'collection', once its locks are acquired,
+ * may be cached. Its reads must not be from a timestamp, which may predate the latest committed
+ * writes, and neither the collections it reads nor the foreign ones may be views or capped
+ * collections, since documents age out of capped collections without being observed as writes.
+ */
+bool canCacheResultsOf(OperationContext* opCtx,
+                       const CollectionPtr& collection,
+                       const ExpressionContext& expCtx,
+                       const LiteParsedPipeline& liteParsedPipeline) {
+    if (opCtx->recoveryUnit()->getTimestampReadSource() !=
+            RecoveryUnit::ReadSource::kNoTimestamp ||
+        !collection || collection->isCapped()) {
+        return false;
+    }
+
+    const auto& involvedNamespaces = liteParsedPipeline.getInvolvedNamespaces();
+    return std::all_of(involvedNamespaces.begin(), involvedNamespaces.end(), [&](auto&& nss) {
+        const auto& resolvedNs = expCtx.getResolvedNamespace(nss);
+        if (!resolvedNs.pipeline.empty()) {
+            return false;
+        }
+        auto foreignCollection =
+            CollectionCatalog::get(opCtx)->lookupCollectionByNamespace(opCtx, resolvedNs.ns);
+        return !foreignCollection || !foreignCollection->isCapped();
+    });
+}
+
+/**
+ * Replies to an aggregation with the results cached for it, as an exhausted cursor.
+ */
+void replyWithCachedResults(OperationContext* opCtx,
+                            const NamespaceString& nsForCursor,
+                            const std::vector<BSONObj>& results,
+                            rpc::ReplyBuilderInterface* result) {
+    CursorResponseBuilder::Options options;
+    options.isInitialResponse = true;
+    CursorResponseBuilder responseBuilder(result, options);
+    for (auto&& doc : results) {
+        responseBuilder.append(doc);
+    }
+    responseBuilder.done(0LL, nsForCursor.ns());
+
+    auto curOp = CurOp::get(opCtx);
+    curOp->debug().nreturned = results.size();
+    curOp->debug().cursorExhausted = true;
+}
+
 StatusWith<StringMap<ExpressionContext::ResolvedNamespace>> resolveInvolvedNamespaces(
     OperationContext* opCtx, const AggregationRequest& request) {
     const LiteParsedPipeline liteParsedPipeline(request);
@@ -507,6 +608,35 @@ Status runAggregate(OperationContext* opCtx,
     std::vector<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> execs;
     boost::intrusive_ptr<ExpressionContext> expCtx;
     auto curOp = CurOp::get(opCtx);
+
+    // If the results of this aggregation can be cached, look them up before taking any lock. On a
+    // miss, take the write versions of the namespaces it reads before any of them is read, so that
+    // its results are only cached if none of them is written to in the meantime.
+    boost::optional<BSONObj> resultCacheKey;
+    AggregationResultCache::ReadVersions resultCacheReadVersions;
+    if (canUseResultCache(opCtx, nss, request, liteParsedPipeline)) {
+        auto& resultCache = AggregationResultCache::get();
+        resultCacheKey = makeResultCacheKey(origNss, request);
+        if (auto cachedResults = resultCache.find(
+                *resultCacheKey, opCtx->getServiceContext()->getFastClockSource()->now())) {
+            AutoStatsTracker statsTracker(
+                opCtx,
+                nss,
+                Top::LockType::NotLocked,
+                AutoStatsTracker::LogMode::kUpdateTopAndCurOp,
+                CollectionCatalog::get(opCtx)->getDatabaseProfileLevel(nss.db()));
+            replyWithCachedResults(opCtx, origNss, *cachedResults, result);
+            liteParsedPipeline.tickGlobalStageCounters();
+            return Status::OK();
+        }
+
+        std::vector<NamespaceString> readNamespaces{nss};
+        const auto& involvedNamespaces = liteParsedPipeline.getInvolvedNamespaces();
+        readNamespaces.insert(
+            readNamespaces.end(), involvedNamespaces.begin(), involvedNamespaces.end());
+        resultCacheReadVersions = resultCache.getReadVersions(readNamespaces);
+    }
+
     {
         // If we are in a transaction, check whether the parsed pipeline supports
         // being in a transaction.
@@ -598,16 +728,42 @@ Status runAggregate(OperationContext* opCtx,
             }
 
 
-            auto resolvedView = uassertStatusOK(DatabaseHolder::get(opCtx)
-                                                    ->getSharedViewCatalog(opCtx, nss.db())
-                                                    ->resolveView(opCtx, nss));
+            auto viewCatalog = DatabaseHolder::get(opCtx)->getSharedViewCatalog(opCtx, nss.db());
+            auto resolvedView = uassertStatusOK(viewCatalog->resolveView(opCtx, nss));
             uassert(std::move(resolvedView),
                     "On sharded systems, resolved views must be executed by mongos",
                     !ShardingState::get(opCtx)->enabled());
 
+            // If the view is, or is defined on, a materialized view, its backing collection must be
+            // refreshed before it is read.
+            std::shared_ptr<ViewDefinition> materializedView;
+            if (resolvedView.getNamespace().isMaterializedViewCollection()) {
+                const auto& backingNss = resolvedView.getNamespace();
+                materializedView = viewCatalog->lookup(
+                    opCtx,
+                    NamespaceString(backingNss.db(),
+                                    backingNss.coll().substr(
+                                        NamespaceString::kMaterializedViewCollectionPrefix.size()))
+                        .ns());
+            }
+
             // With the view & collation resolved, we can relinquish locks.
             ctx.reset();
 
+            // If the backing collection cannot be refreshed for this operation, compute the
+            // materialized view from its source collection instead.
+            if (materializedView && materializedView->materialization() &&
+                !materialized_view_maintenance::refresh(opCtx, *materializedView).isOK()) {
+                const auto& materialization = *materializedView->materialization();
+                auto pipeline = materialization.pipeline;
+                pipeline.insert(pipeline.end(),
+                                resolvedView.getPipeline().begin(),
+                                resolvedView.getPipeline().end());
+                resolvedView = ResolvedView(materialization.from,
+                                            std::move(pipeline),
+                                            resolvedView.getDefaultCollation());
+            }
+
             // Parse the resolved view into a new aggregation request.
             auto newRequest = resolvedView.asExpandedViewAggregation(request);
             auto newCmd = newRequest.serializeToCommandObj().toBson();
@@ -635,6 +791,11 @@ Status runAggregate(OperationContext* opCtx,
         invariant(collatorToUse);
         expCtx = makeExpressionContext(opCtx, request, std::move(*collatorToUse), uuid);
 
+        if (resultCacheKey &&
+            !canCacheResultsOf(opCtx, collection, *expCtx, liteParsedPipeline)) {
+            resultCacheKey.reset();
+        }
+
         auto pipeline = Pipeline::parse(request.getPipeline(), expCtx);
 
         // Check that the view's collation matches the collation of any views involved in the
@@ -779,10 +940,24 @@ Status runAggregate(OperationContext* opCtx,
         }
     } else {
         // Cursor must be specified, if explain is not.
-        const bool keepCursor = handleCursorCommand(
-            opCtx, expCtx, origNss, std::move(cursors), request, cmdObj, result);
+        std::vector<BSONObj> batchToCache;
+        const bool keepCursor = handleCursorCommand(opCtx,
+                                                    expCtx,
+                                                    origNss,
+                                                    std::move(cursors),
+                                                    request,
+                                                    cmdObj,
+                                                    result,
+                                                    resultCacheKey ? &batchToCache : nullptr);
         if (keepCursor) {
             cursorFreer.dismiss();
+        } else if (resultCacheKey) {
+            // All the results were returned in the first batch.
+            AggregationResultCache::get().add(
+                *resultCacheKey,
+                std::move(resultCacheReadVersions),
+                std::move(batchToCache),
+                opCtx->getServiceContext()->getFastClockSource()->now());
         }
 
         PlanSummaryStats stats;
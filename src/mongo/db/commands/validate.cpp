@@ -70,6 +70,9 @@ stdx::condition_variable _validationNotifier;
  *       validate: "collectionNameWithoutTheDBPart",
  *       full: <bool>  // If true, a more thorough (and slower) collection validation is performed.
  *       background: <bool>  // If true, performs validation on the checkpoint of the collection.
+ *       resumeAfter: <long>  // Validates only the records after the one with this RecordId.
+ *       maxRecords: <long>  // Validates at most this many records. The response's 'resumeAfter'
+ *                           // is where to resume validation if there are more.
  *   }
  */
 class ValidateCmd : public BasicCommand {
@@ -86,6 +89,8 @@ public:
                              << "\tAdd {full: true} option to do a more thorough check.\n"
                              << "\tAdd {background: true} to validate in the background.\n"
                              << "\tAdd {repair: true} to run repair mode.\n"
+                             << "\tAdd {maxRecords: <n>} to validate only part of the collection, "
+                             << "and {resumeAfter: <RecordId>} to validate the next part.\n"
                              << "Cannot specify both {full: true, background: true}.";
     }
 
@@ -168,6 +173,29 @@ public:
                           << " performed in standalone mode.");
         }
 
+        boost::optional<CollectionValidation::RecordRange> recordRange;
+        if (cmdObj.hasField("resumeAfter") || cmdObj.hasField("maxRecords")) {
+            if (fullValidate || enforceFastCount || repair) {
+                uasserted(ErrorCodes::CommandNotSupported,
+                          str::stream() << "Running the validate command with { resumeAfter } or "
+                                        << "{ maxRecords } is not supported with { full: true }, "
+                                        << "{ enforceFastCount: true } or { repair: true }.");
+            }
+            recordRange.emplace();
+            if (auto resumeAfter = cmdObj["resumeAfter"]) {
+                uassert(5843132,
+                        "'resumeAfter' must be a positive number",
+                        resumeAfter.isNumber() && resumeAfter.safeNumberLong() > 0);
+                recordRange->resumeAfter = RecordId(resumeAfter.safeNumberLong());
+            }
+            if (auto maxRecords = cmdObj["maxRecords"]) {
+                uassert(5843133,
+                        "'maxRecords' must be a positive number",
+                        maxRecords.isNumber() && maxRecords.safeNumberLong() > 0);
+                recordRange->maxRecords = maxRecords.safeNumberLong();
+            }
+        }
+
         if (!serverGlobalParams.quiet.load()) {
             LOGV2(20514,
                   "CMD: validate",
@@ -221,8 +249,14 @@ public:
         }
 
         ValidateResults validateResults;
-        Status status =
-            CollectionValidation::validate(opCtx, nss, mode, repairMode, &validateResults, &result);
+        Status status = CollectionValidation::validate(opCtx,
+                                                       nss,
+                                                       mode,
+                                                       repairMode,
+                                                       &validateResults,
+                                                       &result,
+                                                       /*turnOnExtraLoggingForTest=*/false,
+                                                       recordRange);
         if (!status.isOK()) {
             return CommandHelpers::appendCommandStatusNoThrow(result, status);
         }
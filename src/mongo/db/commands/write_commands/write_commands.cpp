@@ -31,6 +31,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/bson/mutable/element.h"
+#include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/client.h"
@@ -49,6 +50,7 @@
 #include "mongo/db/ops/parsed_update.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/ops/write_ops_exec.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/get_executor.h"
@@ -59,10 +61,13 @@
 #include "mongo/db/repl/tenant_migration_conflict_info.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/storage/duplicate_key_error_info.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/db/views/view.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 namespace {
@@ -93,116 +98,283 @@ bool shouldSkipOutput(OperationContext* opCtx) {
 }
 
 /**
- * Returns true if 'ns' refers to a time-series collection.
+ * Returns the view which presents the time-series collection 'ns', or nullptr if 'ns' doesn't refer
+ * to a time-series collection.
  */
-bool isTimeseries(OperationContext* opCtx, const NamespaceString& ns) {
+std::shared_ptr<ViewDefinition> getTimeseriesView(OperationContext* opCtx,
+                                                  const NamespaceString& ns) {
     auto viewCatalog = DatabaseHolder::get(opCtx)->getSharedViewCatalog(opCtx, ns.db());
     if (!viewCatalog) {
-        return false;
+        return nullptr;
     }
 
     auto view = viewCatalog->lookupWithoutValidatingDurableViews(opCtx, ns.ns());
-    if (!view) {
-        return false;
+    if (!view || !view->isTimeseries()) {
+        return nullptr;
     }
+    return view;
+}
+
+/**
+ * The fields by which the measurements of a time-series collection are bucketed.
+ */
+struct TimeseriesBucketing {
+    std::string timeField;
+    boost::optional<std::string> metaField;
+};
 
-    return view->isTimeseries();
+/**
+ * Reads the time-series options of a collection from the unpacking stage of its view. Views created
+ * before that stage existed always used a time field named 'time' and had no metaField.
+ */
+TimeseriesBucketing getTimeseriesBucketing(const ViewDefinition& view) {
+    TimeseriesBucketing bucketing{"time", boost::none};
+    const auto& pipeline = view.pipeline();
+    if (pipeline.empty()) {
+        return bucketing;
+    }
+    auto spec = pipeline.front()[DocumentSourceInternalUnpackBucket::kStageName];
+    if (spec.type() != BSONType::Object) {
+        return bucketing;
+    }
+    bucketing.timeField = spec.Obj()[DocumentSourceInternalUnpackBucket::kTimeFieldName].str();
+    if (auto metaField = spec.Obj()[DocumentSourceInternalUnpackBucket::kMetaFieldName]) {
+        bucketing.metaField = metaField.str();
+    }
+    return bucketing;
 }
 
-// Default for control.version in time-series bucket collection.
-const int kTimeseriesControlVersion = 1;
-const int kTimeseriesBucketMaxCount = 1000;
-const int kTimeseriesBucketMaxSizeKB = 125;
-const Hours kTimeseriesBucketMaxTimeRange(1);
+/**
+ * Measurements of a time-series insert batch which share a meta value and fit in one bucket
+ * together, so that they are inserted into the same bucket by a single upsert.
+ */
+struct TimeseriesBucketBatch {
+    // Positions of the measurements in the insert batch, in increasing order.
+    std::vector<size_t> measurements;
+    // The meta value of the measurements, or EOO if they don't have one.
+    BSONElement meta;
+    Date_t minTime;
+    Date_t maxTime;
+    int size = 0;
+
+    bool canAdd(Date_t time, int measurementSize) const {
+        return measurements.size() < size_t(timeseries::kBucketMaxCount) &&
+            size + measurementSize <= timeseries::kBucketMaxSizeBytes &&
+            std::max(maxTime, time) - std::min(minTime, time) <= timeseries::kBucketMaxTimeRange;
+    }
+
+    void add(size_t measurement, Date_t time, int measurementSize) {
+        minTime = measurements.empty() ? time : std::min(minTime, time);
+        maxTime = measurements.empty() ? time : std::max(maxTime, time);
+        measurements.push_back(measurement);
+        size += measurementSize;
+    }
+};
+
+/**
+ * Groups the measurements of 'docs' into bucket batches. Measurements with the same meta value are
+ * batched together, up to the limits of a bucket. If 'ordered' is true, only consecutive
+ * measurements are batched together, so that the batches are inserted in measurement order. If
+ * 'canBatch' is false, every measurement is a batch of its own.
+ */
+std::vector<TimeseriesBucketBatch> makeTimeseriesBucketBatches(const std::vector<BSONObj>& docs,
+                                                               const TimeseriesBucketing& bucketing,
+                                                               bool ordered,
+                                                               bool canBatch) {
+    std::vector<TimeseriesBucketBatch> batches;
+    // The batch which is open for further measurements of each meta value.
+    auto openBatches =
+        SimpleBSONElementComparator::kInstance.makeBSONEltIndexedMap<size_t>();
+
+    for (size_t i = 0; i < docs.size(); ++i) {
+        const auto& doc = docs[i];
+        auto time = doc[bucketing.timeField];
+        uassert(5843128,
+                str::stream() << "'" << bucketing.timeField
+                              << "' must be present and contain a valid BSON UTC datetime value",
+                time.type() == BSONType::Date);
+        auto meta = bucketing.metaField ? doc[*bucketing.metaField] : BSONElement();
+        uassert(5843129,
+                str::stream() << "'" << *bucketing.metaField << "' cannot be an array",
+                meta.type() != BSONType::Array);
+
+        auto openBatch = canBatch ? openBatches.find(meta) : openBatches.end();
+        if (openBatch == openBatches.end() ||
+            !batches[openBatch->second].canAdd(time.Date(), doc.objsize())) {
+            if (ordered) {
+                openBatches.clear();
+            }
+            openBatch = openBatches.insert_or_assign(meta, batches.size()).first;
+            batches.emplace_back();
+            batches.back().meta = meta;
+        }
+        batches[openBatch->second].add(i, time.Date(), doc.objsize());
+    }
+    return batches;
+}
 
 /**
- * Returns min/max $set expressions for the bucket's control field.
+ * Returns the $set of the 'control.min' and 'control.max' bounds of a bucket which adds the
+ * measurements of 'batch' to them.
  */
-BSONObj makeTimeseriesControlMinMaxStages(const BSONObj& doc) {
+BSONObj makeTimeseriesControlMinMaxStage(const std::vector<BSONObj>& docs,
+                                         const TimeseriesBucketBatch& batch,
+                                         const TimeseriesBucketing& bucketing) {
+    // Collect the extremes of each field in the batch, in the order in which the fields appear.
+    // Like $min and $max, prefer any value over null or undefined.
+    auto isNullish = [](const BSONElement& elem) {
+        return elem.isNull() || elem.type() == BSONType::Undefined;
+    };
+    auto less = [&](const BSONElement& lhs, const BSONElement& rhs) {
+        return isNullish(rhs) || (!isNullish(lhs) && lhs.woCompare(rhs, false) < 0);
+    };
+    auto greater = [&](const BSONElement& lhs, const BSONElement& rhs) {
+        return isNullish(rhs) || (!isNullish(lhs) && lhs.woCompare(rhs, false) > 0);
+    };
+    std::vector<std::pair<BSONElement, BSONElement>> bounds;
+    StringMap<size_t> boundsByField;
+    for (auto measurement : batch.measurements) {
+        for (const auto& elem : docs[measurement]) {
+            auto key = elem.fieldNameStringData();
+            if (bucketing.metaField && key == *bucketing.metaField) {
+                continue;
+            }
+            auto [it, inserted] = boundsByField.try_emplace(key, bounds.size());
+            if (inserted) {
+                bounds.emplace_back(elem, elem);
+                continue;
+            }
+            auto& [min, max] = bounds[it->second];
+            min = less(elem, min) ? elem : min;
+            max = greater(elem, max) ? elem : max;
+        }
+    }
+
     BSONObjBuilder builder;
-    for (const auto& elem : doc) {
-        auto key = elem.fieldNameStringData();
-        builder.append("control.min." + key,
-                       BSON("$min" << BSON_ARRAY(("$control.min." + key) << elem)));
-        builder.append("control.max." + key,
-                       BSON("$max" << BSON_ARRAY(("$control.max." + key) << elem)));
+    for (const auto& [min, max] : bounds) {
+        auto key = min.fieldNameStringData();
+        builder.append(
+            "control.min." + key,
+            BSON("$min" << BSON_ARRAY(("$control.min." + key) << BSON("$literal" << min))));
+        builder.append(
+            "control.max." + key,
+            BSON("$max" << BSON_ARRAY(("$control.max." + key) << BSON("$literal" << max))));
     }
     return builder.obj();
 }
 
 /**
- * Returns $set expressions for the bucket's data field.
+ * Returns the $set of the 'data' columns of a bucket which appends the measurements of 'batch' to
+ * them, after the 'control.count' measurements the bucket already holds.
  */
-BSONObj makeTimeseriesDataStages(const BSONObj& doc) {
+BSONObj makeTimeseriesDataStage(const std::vector<BSONObj>& docs,
+                                const TimeseriesBucketBatch& batch,
+                                const TimeseriesBucketing& bucketing) {
+    std::vector<std::pair<std::string, BSONArrayBuilder>> columns;
+    StringMap<size_t> columnsByField;
+    for (size_t position = 0; position < batch.measurements.size(); ++position) {
+        for (const auto& elem : docs[batch.measurements[position]]) {
+            auto key = elem.fieldNameStringData();
+            if (bucketing.metaField && key == *bucketing.metaField) {
+                continue;
+            }
+            auto [it, inserted] = columnsByField.try_emplace(key, columns.size());
+            if (inserted) {
+                columns.emplace_back(key.toString(), BSONArrayBuilder());
+            }
+            columns[it->second].second.append(BSON(
+                "k" << BSON("$toString" << BSON(
+                                "$add" << BSON_ARRAY(
+                                    BSON("$ifNull" << BSON_ARRAY("$control.count" << 0))
+                                    << int(position))))
+                    << "v" << BSON("$literal" << elem)));
+        }
+    }
+
     BSONObjBuilder builder;
-    for (const auto& elem : doc) {
-        auto key = elem.fieldNameStringData();
+    for (auto& [key, values] : columns) {
         builder.append(
             "data." + key,
             BSON("$arrayToObject" << BSON(
-                     "$setUnion" << BSON_ARRAY(
+                     "$concatArrays" << BSON_ARRAY(
                          BSON("$objectToArray"
                               << BSON("$ifNull" << BSON_ARRAY(("$data." + key) << BSONObj())))
-                         << BSON_ARRAY(BSON(
-                                "k" << BSON("$toString"
-                                            << BSON("$ifNull" << BSON_ARRAY("$control.count" << 0)))
-                                    << elem.wrap("v").firstElement()))))));
+                         << values.arr()))));
     }
     return builder.obj();
 }
 
 /**
- * Transforms a single time-series insert to an upsert request.
+ * Transforms a bucket batch of a time-series insert to an upsert request which adds its
+ * measurements to a bucket with room for them, or to a new bucket.
  */
-BSONObj makeTimeseriesUpsertRequest(const BSONObj& doc) {
+BSONObj makeTimeseriesUpsertRequest(const std::vector<BSONObj>& docs,
+                                    const TimeseriesBucketBatch& batch,
+                                    const TimeseriesBucketing& bucketing) {
     BSONObjBuilder builder;
-    // TODO(SERVER-52523): Obtain _id of bucket to update  and name of time field from in-memory
-    // catalog.
-    const auto timeField = "time"_sd;
+    const auto& timeField = bucketing.timeField;
+    const int count = batch.measurements.size();
     {
         BSONObjBuilder queryBuilder(builder.subobjStart(write_ops::UpdateOpEntry::kQFieldName));
         BSONArrayBuilder andBuilder(queryBuilder.subarrayStart("$and"));
-        // Each bucket can hold up to 'kTimeseriesBucketMaxCount' measurements.
+        // The bucket must hold exactly the same meta value. A missing or null meta value would
+        // otherwise match both, and a scalar would match an array holding it.
+        if (bucketing.metaField && !batch.meta) {
+            andBuilder.append(BSON("meta" << BSON("$exists" << false)));
+        } else if (batch.meta.isNull()) {
+            andBuilder.append(BSON("meta" << BSON("$type"
+                                                  << "null")));
+        } else if (batch.meta) {
+            andBuilder.append(BSON("meta" << BSON("$eq" << batch.meta)));
+            andBuilder.append(BSON("meta" << BSON("$not" << BSON("$type"
+                                                                 << "array"))));
+        }
+        // Each bucket can hold up to 'kBucketMaxCount' measurements.
         andBuilder.append(BSON(std::string(str::stream() << "data." << timeField << "."
-                                                         << (kTimeseriesBucketMaxCount - 1))
+                                                         << (timeseries::kBucketMaxCount - count))
                                << BSON("$exists" << false)));
-        // The total size of measurements in a bucket cannot exceed 'kTimeseriesBucketMaxSizeKB'.
+        // The total size of measurements in a bucket cannot exceed 'kBucketMaxSizeBytes'.
         // Ideally, we would use the following expression to avoid relying on 'control.size':
-        //     {$expr: {$lte: [{$bsonSize: '$data'}, (bucketMaxSizeKB * 1024 - doc.objsize())]}}
+        //     {$expr: {$lte: [{$bsonSize: '$data'}, (bucketMaxSizeBytes - batch.size)]}}
         // but $expr is not allowed in an upsert. See SERVER-30731.
-        andBuilder.append(BSON(
-            "control.size" << BSON("$lte" << (kTimeseriesBucketMaxSizeKB * 1024 - doc.objsize()))));
+        andBuilder.append(
+            BSON("control.size" << BSON("$lte" << (timeseries::kBucketMaxSizeBytes - batch.size))));
         // The maximum time-range of a bucket is limited, so index scans looking for buckets
         // containing a time T only need to consider buckets that are newer than
-        // T - 'kTimeseriesBucketMaxTimeRange'.
-        auto docTime = doc[timeField].Date();
+        // T - 'kBucketMaxTimeRange'.
         const std::string minTimeFieldName = str::stream() << "control.min." << timeField;
-        andBuilder.append(BSON(minTimeFieldName << BSON("$lte" << docTime)));
-        andBuilder.append(
-            BSON(minTimeFieldName << BSON("$gte" << (docTime - kTimeseriesBucketMaxTimeRange))));
+        andBuilder.append(BSON(minTimeFieldName << BSON("$lte" << batch.minTime)));
+        auto earliestMinTime = batch.maxTime - timeseries::kBucketMaxTimeRange;
+        andBuilder.append(BSON(minTimeFieldName << BSON("$gte" << earliestMinTime)));
     }
     builder.append(write_ops::UpdateOpEntry::kMultiFieldName, false);
     builder.append(write_ops::UpdateOpEntry::kUpsertFieldName, true);
     {
         BSONArrayBuilder stagesBuilder(
             builder.subarrayStart(write_ops::UpdateOpEntry::kUFieldName));
+        if (batch.meta) {
+            stagesBuilder.append(BSON("$set" << BSON("meta" << BSON("$literal" << batch.meta))));
+        }
         stagesBuilder.append(
             BSON("$set" << BSON("control.version"
-                                << BSON("$ifNull" << BSON_ARRAY("$control.version"
-                                                                << kTimeseriesControlVersion)))));
+                                << BSON("$ifNull" << BSON_ARRAY(
+                                            "$control.version"
+                                            << timeseries::kBucketControlVersion)))));
         stagesBuilder.append(BSON(
             "$set" << BSON("control.size"
                            << BSON("$sum"
                                    << BSON_ARRAY(BSON("$ifNull" << BSON_ARRAY("$control.size" << 0))
-                                                 << doc.objsize())))));
-        stagesBuilder.append(BSON("$set" << makeTimeseriesControlMinMaxStages(doc)));
-        stagesBuilder.append(BSON("$set" << makeTimeseriesDataStages(doc)));
+                                                 << batch.size)))));
+        stagesBuilder.append(
+            BSON("$set" << makeTimeseriesControlMinMaxStage(docs, batch, bucketing)));
+        stagesBuilder.append(BSON("$set" << makeTimeseriesDataStage(docs, batch, bucketing)));
         // Update 'control.count' last because it is referenced in preceding $set stages in this
         // aggregation pipeline.
         stagesBuilder.append(BSON(
-            "$set" << BSON("control.count" << BSON(
-                               "$sum" << BSON_ARRAY(
-                                   BSON("$ifNull" << BSON_ARRAY("$control.count" << 0)) << 1)))));
+            "$set" << BSON("control.count"
+                           << BSON("$sum" << BSON_ARRAY(
+                                       BSON("$ifNull" << BSON_ARRAY("$control.count" << 0))
+                                       << count)))));
     }
     return builder.obj();
 }
@@ -466,28 +638,41 @@ private:
         }
 
         /**
-         * Writes to the underlying system.buckets collection.
+         * Writes to the underlying system.buckets collection. The measurements are batched by
+         * bucket, and each batch is inserted by a single upsert.
          */
-        void _performTimeseriesWrites(OperationContext* opCtx, BSONObjBuilder& result) const {
+        void _performTimeseriesWrites(OperationContext* opCtx,
+                                      const ViewDefinition& view,
+                                      BSONObjBuilder& result) const {
             auto ns = _batch.getNamespace();
             auto bucketsNs = ns.makeTimeseriesBucketsNamespace();
+            const auto& docs = _batch.getDocuments();
+            const bool ordered = _batch.getOrdered();
+
+            // A retryable write records the outcome of each statement, so each measurement must
+            // remain an upsert of its own.
+            const bool canBatch = !opCtx->getTxnNumber();
+            auto bucketing = getTimeseriesBucketing(view);
+            auto batches = makeTimeseriesBucketBatches(docs, bucketing, ordered, canBatch);
 
             BSONObjBuilder builder;
             builder.append(write_ops::Update::kCommandName, bucketsNs.coll());
             // The schema validation configured in the bucket collection is intended for direct
             // operations by end users and is not applicable here.
             builder.append(write_ops::Update::kBypassDocumentValidationFieldName, true);
-            builder.append(write_ops::Update::kOrderedFieldName, _batch.getOrdered());
-            if (auto stmtId = _batch.getStmtId()) {
-                builder.append(write_ops::Update::kStmtIdFieldName, *stmtId);
-            } else if (auto stmtIds = _batch.getStmtIds()) {
-                builder.append(write_ops::Update::kStmtIdsFieldName, *stmtIds);
+            builder.append(write_ops::Update::kOrderedFieldName, ordered);
+            if (!canBatch) {
+                if (auto stmtId = _batch.getStmtId()) {
+                    builder.append(write_ops::Update::kStmtIdFieldName, *stmtId);
+                } else if (auto stmtIds = _batch.getStmtIds()) {
+                    builder.append(write_ops::Update::kStmtIdsFieldName, *stmtIds);
+                }
             }
             {
                 BSONArrayBuilder updatesBuilder(
                     builder.subarrayStart(write_ops::Update::kUpdatesFieldName));
-                for (const auto& doc : _batch.getDocuments()) {
-                    updatesBuilder.append(makeTimeseriesUpsertRequest(doc));
+                for (const auto& batch : batches) {
+                    updatesBuilder.append(makeTimeseriesUpsertRequest(docs, batch, bucketing));
                 }
             }
             auto request = OpMsgRequest::fromDBAndBody(bucketsNs.db(), builder.obj());
@@ -495,20 +680,56 @@ private:
             auto timeseriesUpsertBatch = UpdateOp::parse(request);
 
             auto reply = write_ops_exec::performUpdates(opCtx, timeseriesUpsertBatch);
+            invariant(!reply.results.empty());
+
+            // Report the outcome of each upsert for each measurement it inserted.
+            std::vector<boost::optional<StatusWith<SingleWriteResult>>> measurementResults(
+                docs.size());
+            for (size_t i = 0; i < reply.results.size(); ++i) {
+                for (auto measurement : batches[i].measurements) {
+                    if (reply.results[i].isOK()) {
+                        SingleWriteResult inserted;
+                        inserted.setN(1);
+                        measurementResults[measurement] = inserted;
+                    } else {
+                        measurementResults[measurement] = reply.results[i].getStatus();
+                    }
+                }
+            }
+
+            // An ordered insert stops at the first error. The batches of an ordered insert hold
+            // consecutive measurements, so the measurements which were attempted are a prefix.
+            // An unordered insert only stops early on errors which apply to the remaining
+            // measurements too.
+            write_ops_exec::WriteResult measurementReply;
+            for (auto& measurementResult : measurementResults) {
+                if (!measurementResult) {
+                    if (ordered) {
+                        break;
+                    }
+                    invariant(!reply.results.back().isOK());
+                    measurementResult = reply.results.back().getStatus();
+                }
+                measurementReply.results.push_back(std::move(*measurementResult));
+                if (ordered && !measurementReply.results.back().isOK()) {
+                    break;
+                }
+            }
+
             serializeReply(opCtx,
-                           ReplyStyle::kUpdate,
-                           !timeseriesUpsertBatch.getWriteCommandBase().getOrdered(),
-                           timeseriesUpsertBatch.getUpdates().size(),
-                           std::move(reply),
+                           ReplyStyle::kNotUpdate,
+                           !ordered,
+                           docs.size(),
+                           std::move(measurementReply),
                            &result);
         }
 
         void runImpl(OperationContext* opCtx, BSONObjBuilder& result) const override {
-            if (isTimeseries(opCtx, ns())) {
+            if (auto view = getTimeseriesView(opCtx, ns())) {
                 // Re-throw parsing exceptions to be consistent with CmdInsert::Invocation's
                 // constructor.
                 try {
-                    _performTimeseriesWrites(opCtx, result);
+                    _performTimeseriesWrites(opCtx, *view, result);
                 } catch (DBException& ex) {
                     ex.addContext(str::stream() << "time-series insert failed: " << ns().ns());
                     throw;
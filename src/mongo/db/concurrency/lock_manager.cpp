@@ -45,6 +45,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
 #include "mongo/util/timer.h"
@@ -413,9 +414,27 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+namespace {
+
+/**
+ * Balance scalability of intent locks against potential added cost of conflicting locks, which
+ * must migrate the granted requests out of every partition that holds the resource. Lockers pick
+ * their partition by id, so with at least twice as many partitions as CPUs the threads running
+ * concurrently rarely share a partition mutex or its cache line. Should be a power of two.
+ */
+unsigned numPartitionsForHardware() {
+    const unsigned kMinPartitions = 32;
+    const unsigned kMaxPartitions = 1024;
+
+    unsigned numPartitions = kMinPartitions;
+    while (numPartitions < 2 * stdx::thread::hardware_concurrency() &&
+           numPartitions < kMaxPartitions) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
+}
+
+}  // namespace
 
 // static
 std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serviceContext) {
@@ -443,7 +462,7 @@ std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serv
     return lockToClientMap;
 }
 
-LockManager::LockManager() {
+LockManager::LockManager() : _numPartitions(numPartitionsForHardware()) {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
 }
@@ -40,6 +40,7 @@
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/db/storage/flow_control.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/compiler.h"
@@ -360,11 +361,17 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
             invariant(!opCtx->recoveryUnit()->isTimestamped());
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
-        if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
-            return false;
+        const auto priority = getAdmissionPriority();
+        if (!holder->tryAcquire(priority)) {
+            // Only read the clock when the ticket can't be acquired immediately.
+            WaitEventTimer waitTimer(opCtx, WaitClass::kTicket);
+            if (deadline == Date_t::max()) {
+                holder->waitForTicket(interruptible, priority);
+            } else if (!holder->waitForTicketUntil(interruptible, deadline, priority)) {
+                return false;
+            }
         }
+        _priorityForTicket = priority;
         restoreStateOnErrorGuard.dismiss();
     }
     _clientState.store(reader ? kActiveReader : kActiveWriter);
@@ -955,6 +962,7 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
 
         globalStats.recordWaitTime(_id, resId, mode, elapsedTimeMicros);
         _stats.recordWaitTime(resId, mode, elapsedTimeMicros);
+        recordWaitTime(opCtx, WaitClass::kLock, Microseconds(int64_t(elapsedTimeMicros)));
 
         if (result == LOCK_OK)
             break;
@@ -1031,7 +1039,7 @@ void LockerImpl::releaseTicket() {
 void LockerImpl::_releaseTicket() {
     auto holder = shouldAcquireTicket() ? ticketHolders[_modeForTicket] : nullptr;
     if (holder) {
-        holder->release();
+        holder->release(_priorityForTicket);
     }
     _clientState.store(kInactive);
 }
@@ -346,6 +346,9 @@ private:
     // Mode for which the Locker acquired a ticket, or MODE_NONE if no ticket was acquired.
     LockMode _modeForTicket = MODE_NONE;
 
+    // The priority the currently held ticket was acquired with, so it is released the same way.
+    AdmissionPriority _priorityForTicket = AdmissionPriority::kNormal;
+
     // Indicates whether the client is active reader/writer or is queued.
     AtomicWord<ClientState> _clientState{kInactive};
 
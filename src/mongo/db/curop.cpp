@@ -50,6 +50,9 @@
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/stats/cpu_sampling_profiler.h"
+#include "mongo/db/stats/query_shape_stats.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
@@ -490,6 +493,38 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
         oplogGetMoreStats.recordMillis(executionTimeMillis);
     }
 
+    const auto cpuSamples = CPUSamplingProfiler::getOperationSamples(opCtx);
+    if (_command) {
+        CPUSamplingProfiler::get().recordCommandSamples(_command->getName(), cpuSamples);
+    }
+
+    // Only the queries which are eligible for the plan cache have a known shape.
+    if (_debug.queryHash) {
+        auto& queryShapeStats = QueryShapeStatsStore::get(opCtx->getServiceContext());
+        if (queryShapeStats.isEnabled()) {
+            QueryShapeStatsStore::Sample sample;
+            sample.latency = _debug.executionTime;
+            sample.docsExamined = _debug.additiveMetrics.docsExamined.value_or(0);
+            sample.keysExamined = _debug.additiveMetrics.keysExamined.value_or(0);
+            sample.nreturned = std::max(_debug.nreturned, 0LL);
+            sample.cpuSamples = cpuSamples;
+
+            const auto& waitTimes = OperationWaitTimes::get(opCtx);
+            for (size_t i = 0; i < kNumWaitClasses; ++i) {
+                sample.waitMicros[i] =
+                    durationCount<Microseconds>(waitTimes.getWaitTime(static_cast<WaitClass>(i)));
+            }
+
+            auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
+            if (metricsCollector.hasCollectedMetrics()) {
+                sample.docBytesRead = metricsCollector.getMetrics().readMetrics.docBytesRead;
+            }
+
+            invariant(_debug.planCacheKey);
+            queryShapeStats.record(getNSS(), *_debug.queryHash, *_debug.planCacheKey, sample);
+        }
+    }
+
     bool shouldLogSlowOp, shouldProfileAtLevel1;
 
     if (auto filter =
@@ -736,6 +771,18 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
 
     builder->append("numYields", _numYields.load());
 
+    if (auto n = CPUSamplingProfiler::getOperationSamples(opCtx); n > 0) {
+        builder->append("cpuSamples", n);
+    }
+
+    {
+        BSONObjBuilder waitTimeBuilder;
+        OperationWaitTimes::get(opCtx).appendNonZero(&waitTimeBuilder);
+        if (auto waitTimes = waitTimeBuilder.obj(); !waitTimes.isEmpty()) {
+            builder->append("waitTimeMicros", waitTimes);
+        }
+    }
+
     if (_debug.dataThroughputLastSecond) {
         builder->append("dataThroughputLastSecond", *_debug.dataThroughputLastSecond);
     }
@@ -1079,6 +1126,14 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("storage", storageStats->toBSON());
     }
 
+    {
+        BSONObjBuilder waitTimeBuilder;
+        OperationWaitTimes::get(opCtx).appendNonZero(&waitTimeBuilder);
+        if (auto waitTimes = waitTimeBuilder.obj(); !waitTimes.isEmpty()) {
+            pAttrs->add("waitTimeMicros", waitTimes);
+        }
+    }
+
     if (operationMetrics) {
         BSONObjBuilder builder;
         operationMetrics->toBsonNonZeroFields(&builder);
@@ -1199,6 +1254,14 @@ void OpDebug::append(OperationContext* opCtx,
         b.append("storage", storageStats->toBSON());
     }
 
+    {
+        BSONObjBuilder waitTimeBuilder;
+        OperationWaitTimes::get(opCtx).appendNonZero(&waitTimeBuilder);
+        if (auto waitTimes = waitTimeBuilder.obj(); !waitTimes.isEmpty()) {
+            b.append("waitTimeMicros", waitTimes);
+        }
+    }
+
     if (!errInfo.isOK()) {
         b.appendNumber("ok", 0.0);
         if (!errInfo.reason().empty()) {
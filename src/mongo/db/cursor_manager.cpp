@@ -159,33 +159,43 @@ std::size_t CursorManager::timeoutCursors(OperationContext* opCtx, Date_t now) {
 StatusWith<ClientCursorPin> CursorManager::pinCursor(OperationContext* opCtx,
                                                      CursorId id,
                                                      AuthCheck checkSessionAuth) {
-    auto lockedPartition = _cursorMap->lockOnePartition(id);
-    auto it = lockedPartition->find(id);
-    if (it == lockedPartition->end()) {
-        return {ErrorCodes::CursorNotFound, str::stream() << "cursor id " << id << " not found"};
-    }
+    ClientCursor* cursor;
+    {
+        auto lockedPartition = _cursorMap->lockOnePartition(id);
+        auto it = lockedPartition->find(id);
+        if (it == lockedPartition->end()) {
+            return {ErrorCodes::CursorNotFound,
+                    str::stream() << "cursor id " << id << " not found"};
+        }
 
-    ClientCursor* cursor = it->second;
-    uassert(ErrorCodes::CursorInUse,
-            str::stream() << "cursor id " << id << " is already in use",
-            !cursor->_operationUsingCursor);
-    if (cursor->getExecutor()->isMarkedAsKilled()) {
-        // This cursor was killed while it was idle.
-        Status error = cursor->getExecutor()->getKillStatus();
-        deregisterAndDestroyCursor(std::move(lockedPartition),
-                                   opCtx,
-                                   std::unique_ptr<ClientCursor, ClientCursor::Deleter>(cursor));
-        return error;
-    }
+        cursor = it->second;
+        uassert(ErrorCodes::CursorInUse,
+                str::stream() << "cursor id " << id << " is already in use",
+                !cursor->_operationUsingCursor);
+        if (cursor->getExecutor()->isMarkedAsKilled()) {
+            // This cursor was killed while it was idle.
+            Status error = cursor->getExecutor()->getKillStatus();
+            deregisterAndDestroyCursor(
+                std::move(lockedPartition),
+                opCtx,
+                std::unique_ptr<ClientCursor, ClientCursor::Deleter>(cursor));
+            return error;
+        }
 
-    if (checkSessionAuth == kCheckSession) {
-        auto cursorPrivilegeStatus = checkCursorSessionPrivilege(opCtx, cursor->getSessionId());
-        if (!cursorPrivilegeStatus.isOK()) {
-            return cursorPrivilegeStatus;
+        if (checkSessionAuth == kCheckSession) {
+            auto cursorPrivilegeStatus = checkCursorSessionPrivilege(opCtx, cursor->getSessionId());
+            if (!cursorPrivilegeStatus.isOK()) {
+                return cursorPrivilegeStatus;
+            }
         }
+
+        cursor->_operationUsingCursor = opCtx;
     }
 
-    cursor->_operationUsingCursor = opCtx;
+    // Once pinned, the cursor can't be destroyed or timed out by another thread, so the rest of
+    // the work is done without holding the partition's mutex. If it fails, 'pin' returns the
+    // cursor to this manager.
+    ClientCursorPin pin(opCtx, cursor, this);
 
     // We use pinning of a cursor as a proxy for active, user-initiated use of a cursor.  Therefore,
     // we pass down to the logical session cache and vivify the record (updating last use).
@@ -197,7 +207,7 @@ StatusWith<ClientCursorPin> CursorManager::pinCursor(OperationContext* opCtx,
         }
     }
 
-    return ClientCursorPin(opCtx, cursor, this);
+    return std::move(pin);
 }
 
 void CursorManager::unpin(OperationContext* opCtx,
@@ -47,6 +47,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/storage/clustered_key.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
@@ -56,6 +57,22 @@ using std::set;
 using std::string;
 using std::unique_ptr;
 
+namespace {
+/**
+ * Looks up a document by _id in the record store of a clustered collection, which is keyed by _id.
+ */
+RecordId findClusteredById(OperationContext* opCtx,
+                           const CollectionPtr& collection,
+                           const BSONElement& id) {
+    auto key = clustered_key::keyForId(id);
+    RecordData unused;
+    if (!key || !collection->getRecordStore()->findRecord(opCtx, *key, &unused)) {
+        return RecordId();
+    }
+    return *key;
+}
+}  // namespace
+
 /* fetch a single object from collection ns that matches query
    set your db SavedContext first
 */
@@ -141,13 +158,15 @@ bool Helpers::findById(OperationContext* opCtx,
     const IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
 
-    if (!desc)
+    if (!desc && !collection->getRecordStore()->isClustered())
         return false;
 
     if (indexFound)
         *indexFound = 1;
 
-    RecordId loc = catalog->getEntry(desc)->accessMethod()->findSingle(opCtx, query["_id"].wrap());
+    RecordId loc = desc
+        ? catalog->getEntry(desc)->accessMethod()->findSingle(opCtx, query["_id"].wrap())
+        : findClusteredById(opCtx, collection, query["_id"]);
     if (loc.isNull())
         return false;
     result = collection->docFor(opCtx, loc).value();
@@ -160,6 +179,9 @@ RecordId Helpers::findById(OperationContext* opCtx,
     verify(collection);
     const IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
+    if (!desc && collection->getRecordStore()->isClustered()) {
+        return findClusteredById(opCtx, collection, idquery["_id"]);
+    }
     uassert(13430, "no _id index", desc);
     return catalog->getEntry(desc)->accessMethod()->findSingle(opCtx, idquery["_id"].wrap());
 }
@@ -198,7 +198,8 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
     // with no record id.
     invariant(member->hasRecordId());
 
-    DataMap::iterator it = _dataMap.find(member->recordId);
+    DataMap::iterator it =
+        filterMayContain(member->recordId) ? _dataMap.find(member->recordId) : _dataMap.end();
     if (_dataMap.end() == it) {
         // Child's output wasn't in every previous child.  Throw it out.
         _ws->free(*out);
@@ -206,7 +207,7 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
     } else {
         // Child's output was in every previous child.  Merge any key data in
         // the child's output and free the child's just-outputted WSM.
-        WorkingSetID hashID = it->second;
+        WorkingSetID hashID = it->second.id;
         _dataMap.erase(it);
 
         AndCommon::mergeFrom(_ws, hashID, *member);
@@ -241,7 +242,7 @@ PlanStage::StageState AndHashStage::readFirstChild(WorkingSetID* out) {
         // with no record id.
         invariant(member->hasRecordId());
 
-        if (!_dataMap.insert(std::make_pair(member->recordId, id)).second) {
+        if (!_dataMap.insert(std::make_pair(member->recordId, DataEntry{id, 0})).second) {
             // Didn't insert because we already had this RecordId inside the map. This should only
             // happen if we're seeing a newer copy of the same doc in a more recent snapshot.
             // Throw out the newer copy of the doc.
@@ -267,6 +268,7 @@ PlanStage::StageState AndHashStage::readFirstChild(WorkingSetID* out) {
         }
 
         _specificStats.mapAfterChild.push_back(_dataMap.size());
+        buildFilter();
 
         return PlanStage::NEED_TIME;
     } else {
@@ -292,12 +294,14 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         // WSM with no record id.
         invariant(member->hasRecordId());
 
-        if (_dataMap.end() == _dataMap.find(member->recordId)) {
+        DataMap::iterator it =
+            filterMayContain(member->recordId) ? _dataMap.find(member->recordId) : _dataMap.end();
+        if (_dataMap.end() == it) {
             // Ignore.  It's not in any previous child.
         } else {
             // We have a hit.  Copy data into the WSM we already have.
-            _seenMap.insert(member->recordId);
-            WorkingSetID olderMemberID = _dataMap[member->recordId];
+            it->second.lastChildSeen = _currentChild;
+            WorkingSetID olderMemberID = it->second.id;
             WorkingSetMember* olderMember = _ws->get(olderMemberID);
             size_t memUsageBefore = olderMember->getMemUsage();
 
@@ -309,30 +313,29 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         _ws->free(id);
         return PlanStage::NEED_TIME;
     } else if (PlanStage::IS_EOF == childStatus) {
-        // Finished with a child.
-        ++_currentChild;
-
-        // Keep elements of _dataMap that are in _seenMap.
+        // Keep elements of _dataMap that this child has seen.
         DataMap::iterator it = _dataMap.begin();
         while (it != _dataMap.end()) {
-            if (_seenMap.end() == _seenMap.find(it->first)) {
+            if (it->second.lastChildSeen != _currentChild) {
                 DataMap::iterator toErase = it;
                 ++it;
 
                 // Update memory stats.
-                WorkingSetMember* member = _ws->get(toErase->second);
+                WorkingSetMember* member = _ws->get(toErase->second.id);
                 _memUsage -= member->getMemUsage();
 
-                _ws->free(toErase->second);
+                _ws->free(toErase->second.id);
                 _dataMap.erase(toErase);
             } else {
                 ++it;
             }
         }
 
-        _specificStats.mapAfterChild.push_back(_dataMap.size());
+        // Finished with a child.
+        ++_currentChild;
 
-        _seenMap.clear();
+        _specificStats.mapAfterChild.push_back(_dataMap.size());
+        buildFilter();
 
         // _dataMap is now the intersection of the first _currentChild nodes.
 
@@ -357,6 +360,21 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
     }
 }
 
+void AndHashStage::buildFilter() {
+    _filter.emplace(_dataMap.size());
+    for (auto&& entry : _dataMap) {
+        _filter->insert(entry.first);
+    }
+}
+
+bool AndHashStage::filterMayContain(const RecordId& rid) {
+    if (_filter->mayContain(rid)) {
+        return true;
+    }
+    ++_specificStats.filterRejects;
+    return false;
+}
+
 unique_ptr<PlanStageStats> AndHashStage::getStats() {
     _commonStats.isEOF = isEOF();
 
@@ -29,20 +29,22 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/record_id_bloom_filter.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
 #include "mongo/stdx/unordered_map.h"
-#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
 /**
  * Reads from N children, each of which must have a valid RecordId. Uses a hash table to intersect
- * the outputs of the N children based on their record ids, and outputs the intersection.
+ * the outputs of the N children based on their record ids, and outputs the intersection. A Bloom
+ * filter over the hash table rejects most of the record ids which are not in it before probing it.
  *
  * Preconditions: Valid RecordId. More than one child.
  */
@@ -83,6 +85,16 @@ private:
     StageState hashOtherChildren(WorkingSetID* out);
     StageState workChild(size_t childNo, WorkingSetID* out);
 
+    /**
+     * Rebuilds _filter from the record ids in _dataMap.
+     */
+    void buildFilter();
+
+    /**
+     * Returns false if 'rid' is definitely not in _dataMap.
+     */
+    bool filterMayContain(const RecordId& rid);
+
     // Not owned by us.
     WorkingSet* _ws;
 
@@ -91,15 +103,23 @@ private:
     // we place that result here.
     std::vector<WorkingSetID> _lookAheadResults;
 
+    // An entry of _dataMap holds the member produced by the first child for its record id, and the
+    // index of the last child which also produced the record id.
+    struct DataEntry {
+        WorkingSetID id;
+        size_t lastChildSeen;
+    };
+
     // _dataMap is filled out by the first child and probed by subsequent children.  This is the
-    // hash table that we create by intersecting _children and probe with the last child.
-    typedef stdx::unordered_map<RecordId, WorkingSetID, RecordId::Hasher> DataMap;
+    // hash table that we create by intersecting _children and probe with the last child. Each
+    // subsequent child marks the entries it produces, so that the unmarked ones can be dropped
+    // once it is EOF.
+    typedef stdx::unordered_map<RecordId, DataEntry, RecordId::Hasher> DataMap;
     DataMap _dataMap;
 
-    // Keeps track of what elements from _dataMap subsequent children have seen.
-    // Only used while _hashingChildren.
-    typedef stdx::unordered_set<RecordId, RecordId::Hasher> SeenMap;
-    SeenMap _seenMap;
+    // Filters the record ids probing _dataMap. Built once the first child is EOF, and rebuilt as
+    // subsequent children shrink _dataMap.
+    boost::optional<RecordIdBloomFilter> _filter;
 
     // True if we're still intersecting _children[0..._children.size()-1].
     bool _hashingChildren;
@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/clustered_idhack.h"
+
+#include <algorithm>
+
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/storage/clustered_key.h"
+#include "mongo/db/storage/index_entry_comparison.h"
+
+namespace mongo {
+
+// static
+const char* ClusteredIdHackStage::kStageType = "IDHACK";
+
+ClusteredIdHackStage::ClusteredIdHackStage(ExpressionContext* expCtx,
+                                           CanonicalQuery* query,
+                                           WorkingSet* ws,
+                                           const CollectionPtr& collection)
+    : RequiresCollectionStage(kStageType, expCtx, collection), _workingSet(ws) {
+    invariant(collection->getRecordStore()->isClustered());
+    _addKeyMetadata = query->getQueryRequest().returnKey();
+
+    if (query->root()->matchType() != MatchExpression::MATCH_IN) {
+        addRecordIdFor(query->getQueryObj()["_id"]);
+        return;
+    }
+
+    // Numbers which compare equal map to the same RecordId, so dropping the duplicate RecordIds
+    // ensures that no document is returned twice.
+    const auto inExpr = static_cast<const InMatchExpression*>(query->root());
+    for (auto&& equality : inExpr->getEqualities()) {
+        addRecordIdFor(equality);
+    }
+    std::sort(_recordIds.begin(), _recordIds.end());
+    _recordIds.erase(std::unique(_recordIds.begin(), _recordIds.end()), _recordIds.end());
+}
+
+ClusteredIdHackStage::ClusteredIdHackStage(ExpressionContext* expCtx,
+                                           const BSONObj& key,
+                                           WorkingSet* ws,
+                                           const CollectionPtr& collection)
+    : RequiresCollectionStage(kStageType, expCtx, collection), _workingSet(ws) {
+    invariant(collection->getRecordStore()->isClustered());
+    addRecordIdFor(key.firstElement());
+}
+
+void ClusteredIdHackStage::addRecordIdFor(const BSONElement& id) {
+    if (auto recordId = clustered_key::keyForId(id)) {
+        _recordIds.push_back(*recordId);
+    }
+}
+
+bool ClusteredIdHackStage::isEOF() {
+    return _pos == _recordIds.size();
+}
+
+PlanStage::StageState ClusteredIdHackStage::doWork(WorkingSetID* out) {
+    if (isEOF()) {
+        return PlanStage::IS_EOF;
+    }
+
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    try {
+        ++_specificStats.docsExamined;
+
+        // Create a new WSM for the result document.
+        id = _workingSet->allocate();
+        WorkingSetMember* member = _workingSet->get(id);
+        member->recordId = _recordIds[_pos];
+        _workingSet->transitionToRecordIdAndIdx(id);
+
+        if (!_recordCursor)
+            _recordCursor = collection()->getCursor(opCtx());
+
+        // Find the document associated with 'id' in the collection's record store.
+        const bool fetched =
+            WorkingSetCommon::fetch(opCtx(), _workingSet, id, _recordCursor, collection()->ns());
+        ++_pos;
+        if (!fetched) {
+            // There is no document with this _id.
+            _workingSet->free(id);
+            return isEOF() ? PlanStage::IS_EOF : PlanStage::NEED_TIME;
+        }
+
+        if (_addKeyMetadata) {
+            BSONObj ownedKeyObj = member->doc.value().toBson()["_id"].wrap().getOwned();
+            member->metadata().setIndexKey(
+                IndexKeyEntry::rehydrateKey(BSON("_id" << 1), ownedKeyObj));
+        }
+
+        *out = id;
+        return PlanStage::ADVANCED;
+    } catch (const WriteConflictException&) {
+        // Retry the same document.
+        _recordCursor.reset();
+        if (id != WorkingSet::INVALID_ID)
+            _workingSet->free(id);
+
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+}
+
+void ClusteredIdHackStage::doSaveStateRequiresCollection() {
+    if (_recordCursor)
+        _recordCursor->saveUnpositioned();
+}
+
+void ClusteredIdHackStage::doRestoreStateRequiresCollection() {
+    if (_recordCursor) {
+        auto couldRestore = _recordCursor->restore();
+        uassert(5843122, "ClusteredIdHackStage could not restore cursor", couldRestore);
+    }
+}
+
+void ClusteredIdHackStage::doDetachFromOperationContext() {
+    if (_recordCursor)
+        _recordCursor->detachFromOperationContext();
+}
+
+void ClusteredIdHackStage::doReattachToOperationContext() {
+    if (_recordCursor)
+        _recordCursor->reattachToOperationContext(opCtx());
+}
+
+std::unique_ptr<PlanStageStats> ClusteredIdHackStage::getStats() {
+    _commonStats.isEOF = isEOF();
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_IDHACK);
+    ret->specific = std::make_unique<IDHackStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* ClusteredIdHackStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
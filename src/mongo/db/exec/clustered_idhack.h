@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+class RecordCursor;
+
+/**
+ * The fast path for key-value retrievals on a clustered collection. The documents of a clustered
+ * collection are stored keyed by _id and the collection has no _id index, so the stage seeks the
+ * record store directly for the RecordIds the _id values map to. Like the IDHackStage, this
+ * answers either a single _id equality or an _id $in, which is fetched in RecordId order.
+ *
+ * The stage reports itself as an IDHACK stage. Its stats have no index name.
+ */
+class ClusteredIdHackStage final : public RequiresCollectionStage {
+public:
+    ClusteredIdHackStage(ExpressionContext* expCtx,
+                         CanonicalQuery* query,
+                         WorkingSet* ws,
+                         const CollectionPtr& collection);
+
+    ClusteredIdHackStage(ExpressionContext* expCtx,
+                         const BSONObj& key,
+                         WorkingSet* ws,
+                         const CollectionPtr& collection);
+
+    bool isEOF() final;
+    StageState doWork(WorkingSetID* out) final;
+
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_IDHACK;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats();
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+protected:
+    void doSaveStateRequiresCollection() final;
+
+    void doRestoreStateRequiresCollection() final;
+
+private:
+    /**
+     * Adds the RecordId that the _id value 'id' maps to, if any, to '_recordIds'.
+     */
+    void addRecordIdFor(const BSONElement& id);
+
+    std::unique_ptr<SeekableRecordCursor> _recordCursor;
+
+    // The WorkingSet we annotate with results.  Not owned by us.
+    WorkingSet* _workingSet;
+
+    // The RecordIds to fetch in RecordId order and without duplicates, and the position of the next
+    // one to fetch. The _id values which no document of a clustered collection can have are left
+    // out.
+    std::vector<RecordId> _recordIds;
+    size_t _pos = 0;
+
+    // Do we need to add index key metadata for returnKey?
+    bool _addKeyMetadata = false;
+
+    IDHackStats _specificStats;
+};
+
+}  // namespace mongo
@@ -41,6 +41,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/logv2/log.h"
@@ -131,6 +132,9 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             }
 
             _cursor = collection()->getCursor(opCtx(), forward);
+            if (_params.fieldsToReturn) {
+                _cursor->setFieldsToReturn(*_params.fieldsToReturn);
+            }
 
             if (!_lastSeenId.isNull()) {
                 invariant(_params.tailable);
@@ -278,6 +282,18 @@ void CollectionScan::doSaveStateRequiresCollection() {
     if (_cursor) {
         _cursor->save();
     }
+
+    // A scan which yields is long running. Admit it with low priority from now on so that it can't
+    // hold all of the tickets which short operations need. Tailable and oplog scans are left alone
+    // as they are used by replication and change streams, as are internal clients.
+    if (!_params.tailable && !collection()->ns().isOplog() &&
+        internalQueryDeprioritizeYieldingCollectionScans.load()) {
+        auto client = opCtx()->getClient();
+        if (client->isFromUserConnection() && client->session() &&
+            !(client->session()->getTags() & transport::Session::kInternalClient)) {
+            opCtx()->lockState()->setAdmissionPriority(AdmissionPriority::kLow);
+        }
+    }
 }
 
 void CollectionScan::doRestoreStateRequiresCollection() {
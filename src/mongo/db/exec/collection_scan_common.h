@@ -29,6 +29,10 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <set>
+#include <string>
+
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/record_id.h"
 
@@ -78,6 +82,10 @@ struct CollectionScanParams {
 
     // Whether or not to wait for oplog visibility on oplog collection scans.
     bool shouldWaitForOplogVisibility = false;
+
+    // If present, the top-level fields of each document read by the stages consuming the scan. The
+    // record cursor may return documents trimmed down to these fields.
+    boost::optional<std::set<std::string>> fieldsToReturn;
 };
 
 }  // namespace mongo
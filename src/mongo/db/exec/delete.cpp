@@ -43,6 +43,7 @@
 #include "mongo/db/exec/write_stage_common.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/util/scopeguard.h"
@@ -66,6 +67,15 @@ bool shouldRestartDeleteIfNoLongerMatches(const DeleteStageParams* params) {
     return params->returnDeleted && !params->sort.isEmpty();
 };
 
+size_t getBatchSize(const DeleteStageParams& params) {
+    // Batches can be retried, so a delete which hands each removed document to its caller or to
+    // the RemoveSaver has to remove them one at a time.
+    if (!params.isMulti || params.isExplain || params.returnDeleted || params.removeSaver) {
+        return 1;
+    }
+    return static_cast<size_t>(internalQueryMultiDeleteBatchSize.load());
+}
+
 }  // namespace
 
 DeleteStage::DeleteStage(ExpressionContext* expCtx,
@@ -77,7 +87,8 @@ DeleteStage::DeleteStage(ExpressionContext* expCtx,
       _params(std::move(params)),
       _ws(ws),
       _idRetrying(WorkingSet::INVALID_ID),
-      _idReturning(WorkingSet::INVALID_ID) {
+      _idReturning(WorkingSet::INVALID_ID),
+      _batchSize(getBatchSize(*_params)) {
     _children.emplace_back(child);
 }
 
@@ -86,7 +97,7 @@ bool DeleteStage::isEOF() {
         return true;
     }
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
-        child()->isEOF();
+        _batch.empty() && child()->isEOF();
 }
 
 PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
@@ -94,6 +105,10 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_batchSize > 1) {
+        return doBatchedWork(out);
+    }
+
     // It is possible that after a delete was executed, a WriteConflictException occurred
     // and prevented us from returning ADVANCED with the old version of the document.
     if (_idReturning != WorkingSet::INVALID_ID) {
@@ -250,6 +265,106 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
     return PlanStage::NEED_TIME;
 }
 
+PlanStage::StageState DeleteStage::doBatchedWork(WorkingSetID* out) {
+    // A full batch, or the last one, is only left in place when its delete has to be retried.
+    if (!_batch.empty() && (_batch.size() >= _batchSize || child()->isEOF())) {
+        return deleteBatch(out);
+    }
+
+    WorkingSetID id;
+    auto status = child()->work(&id);
+    switch (status) {
+        case PlanStage::ADVANCED:
+            break;
+
+        case PlanStage::NEED_TIME:
+            return status;
+
+        case PlanStage::NEED_YIELD:
+            *out = id;
+            return status;
+
+        case PlanStage::IS_EOF:
+            return _batch.empty() ? status : deleteBatch(out);
+
+        default:
+            MONGO_UNREACHABLE;
+    }
+
+    // Whether the document still exists and matches the predicate is checked when the batch is
+    // deleted, as the snapshot can change while the rest of the batch is gathered. The BSONObj
+    // must be owned to survive the yields in between.
+    WorkingSetMember* member = _ws->get(id);
+    invariant(member->hasRecordId());
+    invariant(member->hasObj());
+    member->makeObjOwnedIfNeeded();
+    _batch.push_back(id);
+
+    if (_batch.size() < _batchSize) {
+        return PlanStage::NEED_TIME;
+    }
+    return deleteBatch(out);
+}
+
+PlanStage::StageState DeleteStage::deleteBatch(WorkingSetID* out) {
+    try {
+        child()->saveState();
+    } catch (const WriteConflictException&) {
+        std::terminate();
+    }
+
+    // Removing the documents in RecordId order lets the record store delete them with mostly
+    // sequential accesses.
+    std::sort(_batch.begin(), _batch.end(), [&](WorkingSetID lhs, WorkingSetID rhs) {
+        return _ws->get(lhs)->recordId < _ws->get(rhs)->recordId;
+    });
+
+    size_t docsDeleted = 0;
+    try {
+        WriteUnitOfWork wunit(opCtx());
+        for (auto id : _batch) {
+            if (!write_stage_common::ensureStillMatches(
+                    collection(), opCtx(), _ws, id, _params->canonicalQuery)) {
+                // Either the document has already been deleted, or it has been updated such that
+                // it no longer matches the predicate.
+                continue;
+            }
+
+            WorkingSetMember* member = _ws->get(id);
+            Snapshotted<Document> memberDoc = member->doc;
+            collection()->deleteDocument(opCtx(),
+                                         Snapshotted(memberDoc.snapshotId(),
+                                                     memberDoc.value().toBson()),
+                                         _params->stmtId,
+                                         member->recordId,
+                                         _params->opDebug,
+                                         _params->fromMigrate);
+            ++docsDeleted;
+        }
+        wunit.commit();
+    } catch (const WriteConflictException&) {
+        // Keep the batch around so we can retry deleting it.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+    _specificStats.docsDeleted += docsDeleted;
+
+    for (auto id : _batch) {
+        _ws->free(id);
+    }
+    _batch.clear();
+
+    // As in the unbatched case, make sure to restore the state outside of the WriteUnitOfWork.
+    try {
+        child()->restoreState(&collection());
+    } catch (const WriteConflictException&) {
+        // The batch was committed, there is nothing to retry.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+    return PlanStage::NEED_TIME;
+}
+
 void DeleteStage::doRestoreStateRequiresCollection() {
     const NamespaceString& ns = collection()->ns();
     uassert(ErrorCodes::PrimarySteppedDown,
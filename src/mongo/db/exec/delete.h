@@ -130,6 +130,20 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * The work() of a delete which removes '_batchSize' documents per WriteUnitOfWork. The members
+     * returned by the child are buffered in '_batch', and deleted by deleteBatch() once the batch
+     * is full or the child is exhausted.
+     */
+    StageState doBatchedWork(WorkingSetID* out);
+
+    /**
+     * Deletes the members of '_batch' which still exist and match the predicate in a single
+     * WriteUnitOfWork, in RecordId order. Returns NEED_YIELD with '_batch' left intact if the
+     * delete has to be retried, and NEED_TIME otherwise.
+     */
+    StageState deleteBatch(WorkingSetID* out);
+
     std::unique_ptr<DeleteStageParams> _params;
 
     // Not owned by us.
@@ -141,6 +155,13 @@ private:
     // If not WorkingSet::INVALID_ID, we return this member to our caller.
     WorkingSetID _idReturning;
 
+    // The number of documents deleted per WriteUnitOfWork. Only multi deletes which don't return
+    // or save the deleted documents remove more than one at a time.
+    const size_t _batchSize;
+
+    // The members waiting to be deleted in the next WriteUnitOfWork when '_batchSize' is above 1.
+    std::vector<WorkingSetID> _batch;
+
     // Stats
     DeleteStats _specificStats;
 };
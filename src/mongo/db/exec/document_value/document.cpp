@@ -44,6 +44,96 @@ using boost::intrusive_ptr;
 using std::string;
 using std::vector;
 
+namespace {
+
+/**
+ * A per-thread cache of recently freed DocumentStorage buffers. Pipeline stages such as $project
+ * build a new document for every input, and the document they built for the previous input has
+ * usually been released by the time the next one is started, so a buffer of the right size class
+ * is almost always waiting here instead of having to come from the general heap.
+ *
+ * Only buffers whose size is a power of two between kMinPooledBytes and kMaxPooledBytes are
+ * kept, at most kMaxBuffersPerSize of each size, which bounds the memory a thread holds on to.
+ */
+class StorageBufferPool {
+public:
+    static constexpr size_t kMinPooledBytes = 128;
+    static constexpr size_t kMaxPooledBytes = 4096;
+    static constexpr size_t kMaxBuffersPerSize = 8;
+
+    ~StorageBufferPool() {
+        _destroyed = true;
+        for (size_t sizeClass = 0; sizeClass < kNumSizeClasses; ++sizeClass) {
+            for (size_t i = 0; i < _counts[sizeClass]; ++i) {
+                delete[] _buffers[sizeClass][i];
+            }
+        }
+    }
+
+    /**
+     * Returns a buffer of at least 'bytes' bytes, which must be released with release().
+     */
+    static char* allocate(size_t bytes) {
+        const auto sizeClass = sizeClassFor(bytes);
+        if (sizeClass && !_destroyed) {
+            auto& pool = get();
+            if (pool._counts[*sizeClass] > 0) {
+                return pool._buffers[*sizeClass][--pool._counts[*sizeClass]];
+            }
+        }
+        return new char[bytes];
+    }
+
+    /**
+     * Frees 'buffer', which must have been allocated with at least 'bytes' bytes.
+     */
+    static void release(char* buffer, size_t bytes) {
+        if (!buffer) {
+            return;
+        }
+
+        const auto sizeClass = sizeClassFor(bytes);
+        if (sizeClass && !_destroyed) {
+            auto& pool = get();
+            if (pool._counts[*sizeClass] < kMaxBuffersPerSize) {
+                pool._buffers[*sizeClass][pool._counts[*sizeClass]++] = buffer;
+                return;
+            }
+        }
+        delete[] buffer;
+    }
+
+private:
+    static constexpr size_t kNumSizeClasses = 6;
+    static_assert(kMinPooledBytes << (kNumSizeClasses - 1) == kMaxPooledBytes);
+
+    static StorageBufferPool& get() {
+        thread_local StorageBufferPool pool;
+        return pool;
+    }
+
+    static boost::optional<size_t> sizeClassFor(size_t bytes) {
+        size_t classBytes = kMinPooledBytes;
+        for (size_t sizeClass = 0; sizeClass < kNumSizeClasses; ++sizeClass, classBytes *= 2) {
+            if (bytes == classBytes) {
+                return sizeClass;
+            }
+        }
+        return boost::none;
+    }
+
+    // Set once this thread's pool has been destroyed, so that documents released later during
+    // thread exit free their buffers directly.
+    static thread_local bool _destroyed;
+
+    char* _buffers[kNumSizeClasses][kMaxBuffersPerSize];
+    size_t _counts[kNumSizeClasses] = {};
+};
+
+thread_local bool StorageBufferPool::_destroyed = false;
+
+}  // namespace
+
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
 const StringDataSet Document::allMetadataFieldNames{Document::metaFieldTextScore,
@@ -242,6 +332,7 @@ void DocumentStorage::alloc(unsigned newSize) {
     const bool firstAlloc = !_cache;
     const bool doingRehash = needRehash();
     const size_t oldCapacity = _cacheEnd - _cache;
+    const size_t oldAllocatedBytes = allocatedBytes();
 
     // make new bucket count big enough
     while (needRehash() || hashTabBuckets() < HASH_TAB_INIT_SIZE)
@@ -254,13 +345,13 @@ void DocumentStorage::alloc(unsigned newSize) {
 
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_cache);
-    _cache = new char[capacity];
+    char* oldBuf = _cache;
+    _cache = StorageBufferPool::allocate(capacity);
     _cacheEnd = _cache + capacity - hashTabBytes();
 
     if (!firstAlloc) {
         // This just copies the elements
-        memcpy(_cache, oldBuf.get(), _usedBytes);
+        memcpy(_cache, oldBuf, _usedBytes);
 
         if (_numFields >= HASH_TAB_MIN) {
             // if we were hashing, deal with the hash table
@@ -268,10 +359,12 @@ void DocumentStorage::alloc(unsigned newSize) {
                 rehash();
             } else {
                 // no rehash needed so just slide table down to new position
-                memcpy(_hashTab, oldBuf.get() + oldCapacity, hashTabBytes());
+                memcpy(_hashTab, oldBuf + oldCapacity, hashTabBytes());
             }
         }
     }
+
+    StorageBufferPool::release(oldBuf, oldAllocatedBytes);
 }
 
 void DocumentStorage::reserveFields(size_t expectedFields) {
@@ -287,7 +380,7 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _cache = new char[newSize + hashTabBytes()];
+    _cache = StorageBufferPool::allocate(newSize + hashTabBytes());
     _cacheEnd = _cache + newSize;
 }
 
@@ -298,7 +391,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         // Make a copy of the buffer with the fields.
         // It is very important that the positions of each field are the same after cloning.
         const size_t bufferBytes = allocatedBytes();
-        out->_cache = new char[bufferBytes];
+        out->_cache = StorageBufferPool::allocate(bufferBytes);
         out->_cacheEnd = out->_cache + (_cacheEnd - _cache);
         memcpy(out->_cache, _cache, bufferBytes);
 
@@ -330,11 +423,11 @@ size_t DocumentStorage::getMetadataApproximateSize() const {
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_cache);
-
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
+
+    StorageBufferPool::release(_cache, allocatedBytes());
 }
 
 void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
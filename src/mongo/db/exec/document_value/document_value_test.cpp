@@ -137,6 +137,44 @@ TEST(DocumentConstruction, FromBsonReset) {
     ASSERT_BSONOBJ_EQ(bson, toBson(newDocument));
 }
 
+TEST(DocumentConstruction, RecycledStorageBuffersStartEmpty) {
+    // Documents of many sizes are built and released in turn, so that later documents reuse the
+    // buffers of earlier ones, including after buffer growth, reset and clone.
+    std::vector<std::pair<int, Document>> retained;
+    for (int round = 0; round < 3; ++round) {
+        for (int numFields = 1; numFields <= 80; ++numFields) {
+            MutableDocument md;
+            for (int i = 0; i < numFields; ++i) {
+                md.addField("field" + std::to_string(i), Value(round * 1000 + i));
+            }
+            Document doc = md.freeze();
+            Document clone = doc.clone();
+
+            ASSERT_EQUALS(static_cast<size_t>(numFields), clone.computeSize());
+            for (int i = 0; i < numFields; ++i) {
+                ASSERT_VALUE_EQ(clone["field" + std::to_string(i)], Value(round * 1000 + i));
+            }
+            ASSERT_TRUE(clone["field" + std::to_string(numFields)].missing());
+
+            if (numFields % 7 == 0) {
+                retained.emplace_back(round, std::move(doc));
+            }
+
+            MutableDocument resetDoc(Document{{"a", 1}, {"b", 2}, {"c", 3}, {"d", 4}});
+            resetDoc.reset(BSON("x" << numFields), false);
+            resetDoc.addField("y", Value(round));
+            ASSERT_BSONOBJ_EQ(BSON("x" << numFields << "y" << round), resetDoc.freeze().toBson());
+        }
+    }
+
+    for (auto&& [round, doc] : retained) {
+        const int numFields = doc.computeSize();
+        ASSERT_EQUALS(0, numFields % 7);
+        ASSERT_VALUE_EQ(doc["field" + std::to_string(numFields - 1)],
+                        Value(round * 1000 + numFields - 1));
+    }
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
@@ -38,6 +38,7 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/str.h"
 
@@ -57,7 +58,8 @@ FetchStage::FetchStage(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ws(ws),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _idRetrying(WorkingSet::INVALID_ID),
+      _prefetchWindow(internalQueryFetchPrefetchWindow.load()) {
     _children.emplace_back(std::move(child));
 }
 
@@ -69,7 +71,7 @@ bool FetchStage::isEOF() {
         return false;
     }
 
-    return child()->isEOF();
+    return _window.empty() && child()->isEOF();
 }
 
 PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
@@ -81,7 +83,7 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     WorkingSetID id;
     StageState status;
     if (_idRetrying == WorkingSet::INVALID_ID) {
-        status = child()->work(&id);
+        status = _prefetchWindow > 0 ? workChildIntoWindow(&id) : child()->work(&id);
     } else {
         status = ADVANCED;
         id = _idRetrying;
@@ -125,6 +127,47 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::workChildIntoWindow(WorkingSetID* id) {
+    if (_window.size() < _prefetchWindow && !child()->isEOF()) {
+        WorkingSetID childId = WorkingSet::INVALID_ID;
+        const auto status = child()->work(&childId);
+        if (status == ADVANCED) {
+            WorkingSetMember* member = _ws->get(childId);
+            // The member stays in the window across yields.
+            member->makeObjOwnedIfNeeded();
+            if (!member->hasObj()) {
+                _toPrefetch.push_back(member->recordId);
+            }
+            _window.push_back(childId);
+        } else if (status == NEED_YIELD) {
+            *id = childId;
+            return status;
+        }
+
+        if (_window.size() < _prefetchWindow && !child()->isEOF()) {
+            return NEED_TIME;
+        }
+    }
+
+    if (_window.empty()) {
+        return child()->isEOF() ? IS_EOF : NEED_TIME;
+    }
+
+    // Hand the records to the cursor in batches of half the window. The member about to be fetched
+    // is always in the older half, whose records have already been handed over.
+    if (!_toPrefetch.empty() &&
+        (_toPrefetch.size() * 2 >= _prefetchWindow || child()->isEOF())) {
+        if (!_cursor)
+            _cursor = collection()->getCursor(opCtx());
+        _cursor->prefetch(std::move(_toPrefetch));
+        _toPrefetch.clear();
+    }
+
+    *id = _window.front();
+    _window.pop_front();
+    return ADVANCED;
+}
+
 void FetchStage::doSaveStateRequiresCollection() {
     if (_cursor) {
         _cursor->saveUnpositioned();
@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
@@ -86,6 +88,13 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Works the child to keep '_window' filled with members ahead of the one being fetched. Sets
+     * '*id' to the member to fetch next and returns ADVANCED once the window is full or the child
+     * is exhausted; otherwise returns the state to propagate to the parent.
+     */
+    StageState workChildIntoWindow(WorkingSetID* id);
+
     // Used to fetch Records from _collection.
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
@@ -98,6 +107,13 @@ private:
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // When prefetching, the number of members taken from the child ahead of the one being fetched,
+    // the members themselves in the order the child returned them, and the RecordIds of the
+    // members which have not yet been handed to the cursor for prefetching.
+    const size_t _prefetchWindow;
+    std::deque<WorkingSetID> _window;
+    std::vector<RecordId> _toPrefetch;
+
     // Stats
     FetchStats _specificStats;
 };
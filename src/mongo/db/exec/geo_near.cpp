@@ -964,7 +964,15 @@ std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
     scanParams.bounds.fields[s2FieldPosition].intervals.clear();
     std::unique_ptr<S2Region> region(buildS2Region(_currBounds));
 
-    std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(*region);
+    // The annulus is determined by its center and radii. The leading tag keeps the key from being
+    // mistaken for that of a serialized predicate, whose length is its leading four bytes.
+    const double annulus[] = {_currBounds.center().x,
+                              _currBounds.center().y,
+                              _currBounds.getInner(),
+                              _currBounds.getOuter()};
+    std::string regionKey("n");
+    regionKey.append(reinterpret_cast<const char*>(annulus), sizeof(annulus));
+    std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(*region, regionKey);
 
     // Generate a covering that does not intersect with any previous coverings
     S2CellUnion coverUnion;
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/idhack.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/index_catalog.h"
@@ -40,6 +41,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/btree_access_method.h"
+#include "mongo/db/matcher/expression_leaf.h"
 
 namespace mongo {
 
@@ -54,11 +56,33 @@ IDHackStage::IDHackStage(ExpressionContext* expCtx,
                          WorkingSet* ws,
                          const CollectionPtr& collection,
                          const IndexDescriptor* descriptor)
-    : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws),
-      _workingSet(ws),
-      _key(query->getQueryObj()["_id"].wrap()) {
+    : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws), _workingSet(ws) {
     _specificStats.indexName = descriptor->indexName();
     _addKeyMetadata = query->getQueryRequest().returnKey();
+
+    if (query->root()->matchType() != MatchExpression::MATCH_IN) {
+        _key = query->getQueryObj()["_id"].wrap();
+        return;
+    }
+
+    // Order the keys of the _id $in as the index does, dropping the ones which compare equal (e.g.
+    // 1 and 1.0) so that no document is returned twice.
+    const auto inExpr = static_cast<const InMatchExpression*>(query->root());
+    const auto sdi = indexAccessMethod()->getSortedDataInterface();
+    for (auto&& equality : inExpr->getEqualities()) {
+        KeyString::HeapBuilder keyString(sdi->getKeyStringVersion(), sdi->getOrdering());
+        keyString.appendBSONElement(equality);
+        _batchKeys.push_back(keyString.release());
+    }
+    std::sort(_batchKeys.begin(), _batchKeys.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.compare(rhs) < 0;
+    });
+    _batchKeys.erase(std::unique(_batchKeys.begin(),
+                                 _batchKeys.end(),
+                                 [](const auto& lhs, const auto& rhs) {
+                                     return lhs.compare(rhs) == 0;
+                                 }),
+                     _batchKeys.end());
 }
 
 IDHackStage::IDHackStage(ExpressionContext* expCtx,
@@ -85,16 +109,28 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
 
     WorkingSetID id = WorkingSet::INVALID_ID;
     try {
-        // Look up the key by going directly to the index.
-        RecordId recordId = indexAccessMethod()->findSingle(opCtx(), _key);
-
-        // Key not found.
-        if (recordId.isNull()) {
+        RecordId recordId;
+        if (!isBatched()) {
+            // Look up the key by going directly to the index.
+            recordId = indexAccessMethod()->findSingle(opCtx(), _key);
+
+            // Key not found.
+            if (recordId.isNull()) {
+                _done = true;
+                return PlanStage::IS_EOF;
+            }
+
+            ++_specificStats.keysExamined;
+        } else if (!_batchLookedUp) {
+            lookUpBatch();
+            return PlanStage::NEED_TIME;
+        } else if (_batchPos == _batchRecordIds.size()) {
             _done = true;
             return PlanStage::IS_EOF;
+        } else {
+            recordId = _batchRecordIds[_batchPos];
         }
 
-        ++_specificStats.keysExamined;
         ++_specificStats.docsExamined;
 
         // Create a new WSM for the result document.
@@ -107,9 +143,18 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
             _recordCursor = collection()->getCursor(opCtx());
 
         // Find the document associated with 'id' in the collection's record store.
-        if (!WorkingSetCommon::fetch(opCtx(), _workingSet, id, _recordCursor, collection()->ns())) {
-            // We didn't find a document with RecordId 'id'.
+        const bool fetched =
+            WorkingSetCommon::fetch(opCtx(), _workingSet, id, _recordCursor, collection()->ns());
+        if (isBatched()) {
+            ++_batchPos;
+        }
+        if (!fetched) {
+            // We didn't find a document with RecordId 'id'. A document of the batch may have been
+            // deleted while yielding, in which case we move on to the next one.
             _workingSet->free(id);
+            if (isBatched()) {
+                return PlanStage::NEED_TIME;
+            }
             _commonStats.isEOF = true;
             _done = true;
             return IS_EOF;
@@ -127,6 +172,24 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
     }
 }
 
+void IDHackStage::lookUpBatch() {
+    _batchRecordIds.clear();
+
+    // The keys are sorted, so the seeks move forward through the index.
+    auto cursor = indexAccessMethod()->getSortedDataInterface()->newCursor(opCtx());
+    for (auto&& key : _batchKeys) {
+        if (auto kv = cursor->seekExact(key, SortedDataInterface::Cursor::kWantLoc)) {
+            ++_specificStats.keysExamined;
+            _batchRecordIds.push_back(kv->loc);
+        }
+    }
+
+    // Fetching in RecordId order reads the record store sequentially, rather than in the order of
+    // the _id values.
+    std::sort(_batchRecordIds.begin(), _batchRecordIds.end());
+    _batchLookedUp = true;
+}
+
 PlanStage::StageState IDHackStage::advance(WorkingSetID id,
                                            WorkingSetMember* member,
                                            WorkingSetID* out) {
@@ -134,10 +197,11 @@ PlanStage::StageState IDHackStage::advance(WorkingSetID id,
 
     if (_addKeyMetadata) {
         BSONObj ownedKeyObj = member->doc.value().toBson()["_id"].wrap().getOwned();
-        member->metadata().setIndexKey(IndexKeyEntry::rehydrateKey(_key, ownedKeyObj));
+        member->metadata().setIndexKey(IndexKeyEntry::rehydrateKey(
+            isBatched() ? indexDescriptor()->keyPattern() : _key, ownedKeyObj));
     }
 
-    _done = true;
+    _done = !isBatched();
     *out = id;
     return PlanStage::ADVANCED;
 }
@@ -34,6 +34,7 @@
 #include "mongo/db/exec/requires_index_stage.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
 
 namespace mongo {
 
@@ -44,6 +45,11 @@ class RecordCursor;
  * A standalone stage implementing the fast path for key-value retrievals via the _id index. Since
  * the _id index always has the collection default collation, the IDHackStage can only be used when
  * the query's collation is equal to the collection default.
+ *
+ * When the query is an _id $in, the stage looks up the whole batch of _id values at once: the keys
+ * are sought in index order through a single index cursor, and the documents they point to are
+ * then fetched in RecordId order through a single record cursor. Batched lookups are only used
+ * when the collection has the simple collation.
  */
 class IDHackStage final : public RequiresIndexStage {
 public:
@@ -91,6 +97,16 @@ private:
      */
     StageState advance(WorkingSetID id, WorkingSetMember* member, WorkingSetID* out);
 
+    /**
+     * Seeks the index for every key of '_batchKeys', and fills '_batchRecordIds' with the RecordIds
+     * of the keys which were found, in RecordId order.
+     */
+    void lookUpBatch();
+
+    bool isBatched() const {
+        return !_batchKeys.empty();
+    }
+
     std::unique_ptr<SeekableRecordCursor> _recordCursor;
 
     // The WorkingSet we annotate with results.  Not owned by us.
@@ -99,7 +115,17 @@ private:
     // The value to match against the _id field.
     BSONObj _key;
 
-    // Have we returned our one document?
+    // The _id values to look up when answering an _id $in, in index order and without duplicates.
+    // Empty when looking up the single '_key'.
+    std::vector<KeyString::Value> _batchKeys;
+
+    // The RecordIds found for '_batchKeys' in RecordId order, and the position of the next one to
+    // fetch. Filled on the first call to doWork().
+    std::vector<RecordId> _batchRecordIds;
+    size_t _batchPos = 0;
+    bool _batchLookedUp = false;
+
+    // Have we returned all of our documents?
     bool _done = false;
 
     // Do we need to add index key metadata for returnKey?
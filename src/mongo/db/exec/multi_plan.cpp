@@ -50,6 +50,7 @@
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/plan_ranker_util.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
 
@@ -70,6 +71,15 @@ void markShouldCollectTimingInfoOnSubtree(PlanStage* root) {
         markShouldCollectTimingInfoOnSubtree(child.get());
     }
 }
+
+/**
+ * The number of results per work of a candidate plan so far, which is how the plan ranker measures
+ * its productivity.
+ */
+double trialProductivity(const plan_ranker::CandidatePlan& candidate) {
+    const auto* stats = candidate.root->getCommonStats();
+    return stats->works ? static_cast<double>(stats->advanced) / stats->works : 0.0;
+}
 }  // namespace
 
 MultiPlanStage::MultiPlanStage(ExpressionContext* expCtx,
@@ -166,6 +176,9 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
 
     size_t numWorks = trial_period::getTrialPeriodMaxWorks(opCtx(), collection());
     size_t numResults = trial_period::getTrialPeriodNumToReturn(*_query);
+    const double pruneGap = internalQueryPlanEvaluationPruneGap.load();
+    const size_t minWorksBeforePruning =
+        static_cast<size_t>(internalQueryPlanEvaluationMinWorksBeforePruning.load());
 
     try {
         // Work the plans, stopping when a plan hits EOF or returns some fixed number of results.
@@ -174,6 +187,10 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
             if (!moreToDo) {
                 break;
             }
+
+            if (pruneGap > 0 && ix + 1 >= minWorksBeforePruning) {
+                pruneLosingPlans(pruneGap);
+            }
         }
     } catch (DBException& e) {
         return e.toStatus().withContext("error while multiplanner was selecting best plan");
@@ -224,12 +241,14 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
 
 bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolicy) {
     bool doneWorking = false;
+    bool workedAnyPlan = false;
 
     for (size_t ix = 0; ix < _candidates.size(); ++ix) {
         auto& candidate = _candidates[ix];
-        if (candidate.failed) {
+        if (candidate.failed || candidate.pruned) {
             continue;
         }
+        workedAnyPlan = true;
 
         // Might need to yield between calls to work due to the timer elapsing.
         tryYield(yieldPolicy);
@@ -285,13 +304,43 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
         }
     }
 
-    return !doneWorking;
+    // Stop once every candidate plan which was not pruned has failed.
+    return !doneWorking && workedAnyPlan;
+}
+
+void MultiPlanStage::pruneLosingPlans(double pruneGap) {
+    double bestProductivity = 0.0;
+    for (auto&& candidate : _candidates) {
+        if (!candidate.failed && !candidate.pruned) {
+            bestProductivity = std::max(bestProductivity, trialProductivity(candidate));
+        }
+    }
+
+    // Since 'pruneGap' is positive, the best candidate plan is never pruned.
+    for (size_t ix = 0; ix < _candidates.size(); ++ix) {
+        auto& candidate = _candidates[ix];
+        if (!candidate.failed && !candidate.pruned &&
+            bestProductivity - trialProductivity(candidate) >= pruneGap) {
+            LOGV2_DEBUG(5843201,
+                        5,
+                        "Pruning candidate plan",
+                        "candidateIdx"_attr = ix,
+                        "works"_attr = candidate.root->getCommonStats()->works);
+            candidate.pruned = true;
+            ++_specificStats.candidatesPruned;
+        }
+    }
 }
 
 bool MultiPlanStage::hasBackupPlan() const {
     return kNoSuchPlan != _backupPlanIdx;
 }
 
+bool MultiPlanStage::candidatePruned(size_t candidateIdx) const {
+    invariant(candidateIdx < _candidates.size());
+    return _candidates[candidateIdx].pruned;
+}
+
 bool MultiPlanStage::bestPlanChosen() const {
     return kNoSuchPlan != _bestPlanIdx;
 }
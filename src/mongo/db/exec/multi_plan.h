@@ -126,6 +126,12 @@ public:
      */
     bool hasBackupPlan() const;
 
+    /**
+     * Returns true if the trial period stopped working the candidate plan at 'candidateIdx'
+     * before the end of the trial period.
+     */
+    bool candidatePruned(size_t candidateIdx) const;
+
     //
     // Used by explain.
     //
@@ -152,6 +158,12 @@ private:
      */
     bool workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Stops working the candidate plans whose productivity is at least 'pruneGap' below the
+     * productivity of the best candidate plan.
+     */
+    void pruneLosingPlans(double pruneGap);
+
     /**
      * Checks whether we need to perform either a timing-based yield or a yield for a document
      * fetch. If so, then uses 'yieldPolicy' to actually perform the yield.
@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/normalized_sort_key.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+namespace {
+Ordering makeOrdering(const SortPattern& sortPattern) {
+    BSONObjBuilder builder;
+    for (auto&& part : sortPattern) {
+        builder.append(""_sd, part.isAscending ? 1 : -1);
+    }
+    return Ordering::make(builder.obj());
+}
+}  // namespace
+
+void NormalizedSortKey::serializeForSorter(BufBuilder& buf) const {
+    buf.appendChar(isNormalized());
+    if (_normalizedKey) {
+        _normalizedKey->serializeForSorter(buf);
+    }
+    _sortKey.serializeForSorter(buf);
+}
+
+NormalizedSortKey NormalizedSortKey::deserializeForSorter(BufReader& buf,
+                                                          const SorterDeserializeSettings&) {
+    boost::optional<KeyString::Value> normalizedKey;
+    if (buf.read<char>()) {
+        // The spill files of a Sorter are only read by the process which wrote them.
+        normalizedKey = KeyString::Value::deserializeForSorter(
+            buf, KeyString::Value::SorterDeserializeSettings{KeyString::Version::kLatestVersion});
+    }
+    auto sortKey = Value::deserializeForSorter(buf, Value::SorterDeserializeSettings{});
+    return NormalizedSortKey{std::move(sortKey), std::move(normalizedKey)};
+}
+
+SortKeyNormalizer::SortKeyNormalizer(const SortPattern& sortPattern)
+    : _ordering(makeOrdering(sortPattern)), _numParts(sortPattern.size()) {}
+
+NormalizedSortKey SortKeyNormalizer::operator()(Value sortKey) const {
+    // A sort key with a single component is the value of that component, otherwise it is an array
+    // of the values of each component.
+    BSONObjBuilder builder;
+    auto appendPart = [&builder](const Value& part) {
+        // A missing component compares equal to undefined, like in SortKeyComparator.
+        if (part.missing()) {
+            builder.appendUndefined(""_sd);
+        } else {
+            part.addToBsonObj(&builder, ""_sd);
+        }
+    };
+    if (_numParts == 1) {
+        appendPart(sortKey);
+    } else {
+        for (size_t idx = 0; idx < _numParts; ++idx) {
+            appendPart(sortKey[idx]);
+        }
+    }
+
+    KeyString::Builder normalizedKey(KeyString::Version::kLatestVersion, builder.obj(), _ordering);
+    return NormalizedSortKey{std::move(sortKey), normalizedKey.getValueCopy()};
+}
+}  // namespace mongo
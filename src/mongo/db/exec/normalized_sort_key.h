@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/ordering.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/query/sort_pattern.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+/**
+ * The key type of the Sorter used by the SortExecutor. It holds the sort key of a document and,
+ * if the SortExecutor normalizes its sort keys, the encoding of that sort key as a KeyString whose
+ * binary order is the order the SortPattern defines on the sort keys. Comparing two normalized
+ * sort keys is then a single memcmp() rather than a comparison of each component of the keys.
+ */
+class NormalizedSortKey {
+public:
+    NormalizedSortKey() = default;
+
+    explicit NormalizedSortKey(Value sortKey,
+                               boost::optional<KeyString::Value> normalizedKey = boost::none)
+        : _sortKey(std::move(sortKey)), _normalizedKey(std::move(normalizedKey)) {}
+
+    const Value& sortKey() const {
+        return _sortKey;
+    }
+
+    Value releaseSortKey() {
+        return std::move(_sortKey);
+    }
+
+    bool isNormalized() const {
+        return _normalizedKey.has_value();
+    }
+
+    /**
+     * Compares the normalized forms of this key and 'other', both of which must be normalized.
+     */
+    int compare(const NormalizedSortKey& other) const {
+        return _normalizedKey->compare(*other._normalizedKey);
+    }
+
+    /// Members for Sorter
+    struct SorterDeserializeSettings {};  // unused
+    void serializeForSorter(BufBuilder& buf) const;
+    static NormalizedSortKey deserializeForSorter(BufReader& buf,
+                                                  const SorterDeserializeSettings&);
+    int memUsageForSorter() const {
+        return sizeof(NormalizedSortKey) - sizeof(Value) + _sortKey.memUsageForSorter() +
+            (_normalizedKey ? _normalizedKey->memUsageForSorter() - sizeof(KeyString::Value) : 0);
+    }
+    NormalizedSortKey getOwned() const {
+        return NormalizedSortKey{_sortKey.getOwned(), _normalizedKey};
+    }
+
+private:
+    Value _sortKey;
+    boost::optional<KeyString::Value> _normalizedKey;
+};
+
+/**
+ * Encodes the sort keys generated for a SortPattern into normalized sort keys.
+ */
+class SortKeyNormalizer {
+public:
+    /**
+     * Returns true if the sort keys generated for 'sortPattern' can be normalized. A KeyString
+     * Ordering can only describe the directions of a limited number of components.
+     */
+    static bool canNormalize(const SortPattern& sortPattern) {
+        return sortPattern.size() <= Ordering::kMaxCompoundIndexKeys;
+    }
+
+    explicit SortKeyNormalizer(const SortPattern& sortPattern);
+
+    NormalizedSortKey operator()(Value sortKey) const;
+
+private:
+    const Ordering _ordering;
+    const size_t _numParts;
+};
+}  // namespace mongo
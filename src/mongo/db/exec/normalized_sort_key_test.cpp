@@ -0,0 +1,154 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/normalized_sort_key.h"
+
+#include <limits>
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/exec/sort_key_comparator.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/platform/decimal128.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+int sign(int cmp) {
+    return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+}
+
+std::vector<Value> makeScalars() {
+    return {Value(),
+            Value(BSONUndefined),
+            Value(BSONNULL),
+            Value(MINKEY),
+            Value(MAXKEY),
+            Value(-1),
+            Value(0),
+            Value(-0.0),
+            Value(1),
+            Value(1LL),
+            Value(1.5),
+            Value(std::numeric_limits<double>::quiet_NaN()),
+            Value(std::numeric_limits<double>::infinity()),
+            Value(Decimal128("1.25")),
+            Value(""_sd),
+            Value("a"_sd),
+            Value("a\0b"_sd),
+            Value("ab"_sd),
+            Value(BSON("a" << 1)),
+            Value(BSON("a" << 2)),
+            Value(BSON("b" << 1)),
+            Value(BSONArray(BSON_ARRAY(1))),
+            Value(BSONArray(BSON_ARRAY(1 << 2))),
+            Value(true),
+            Value(false),
+            Value(Date_t::fromMillisSinceEpoch(5)),
+            Value(Timestamp(1, 2)),
+            Value(OID("000000000000000000000001"))};
+}
+
+/**
+ * Asserts that the normalized sort keys generated for 'sortPattern' compare like the sort keys they
+ * were generated from do under SortKeyComparator.
+ */
+void assertOrderMatchesComparator(const BSONObj& sortPattern, const std::vector<Value>& keys) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    SortPattern pattern{sortPattern, expCtx};
+    SortKeyComparator comparator{pattern};
+    SortKeyNormalizer normalizer{pattern};
+
+    for (auto&& lhs : keys) {
+        auto normalizedLhs = normalizer(lhs);
+        ASSERT(normalizedLhs.isNormalized());
+        for (auto&& rhs : keys) {
+            ASSERT_EQ(sign(normalizedLhs.compare(normalizer(rhs))), sign(comparator(lhs, rhs)))
+                << "lhs: " << lhs.toString() << ", rhs: " << rhs.toString();
+        }
+    }
+}
+
+TEST(NormalizedSortKeyTest, SingleComponentOrderMatchesSortKeyComparator) {
+    assertOrderMatchesComparator(BSON("a" << 1), makeScalars());
+    assertOrderMatchesComparator(BSON("a" << -1), makeScalars());
+}
+
+TEST(NormalizedSortKeyTest, CompoundOrderMatchesSortKeyComparator) {
+    auto scalars = makeScalars();
+    std::vector<Value> keys;
+    for (size_t idx = 0; idx < scalars.size(); ++idx) {
+        keys.push_back(Value(std::vector<Value>{scalars[idx], scalars[scalars.size() - idx - 1]}));
+        keys.push_back(Value(std::vector<Value>{scalars[idx], scalars[idx]}));
+    }
+    assertOrderMatchesComparator(BSON("a" << 1 << "b" << 1), keys);
+    assertOrderMatchesComparator(BSON("a" << 1 << "b" << -1), keys);
+    assertOrderMatchesComparator(BSON("a" << -1 << "b" << 1), keys);
+}
+
+TEST(NormalizedSortKeyTest, RoundTripsThroughSorterSerialization) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    SortKeyNormalizer normalizer{SortPattern{BSON("a" << 1 << "b" << -1), expCtx}};
+
+    std::vector<NormalizedSortKey> keys{
+        normalizer(Value(std::vector<Value>{Value(1), Value("x"_sd)})),
+        NormalizedSortKey{Value(std::vector<Value>{Value(2), Value()})}};
+
+    BufBuilder buf;
+    for (auto&& key : keys) {
+        key.serializeForSorter(buf);
+    }
+
+    BufReader reader(buf.buf(), buf.len());
+    for (auto&& key : keys) {
+        auto deserialized = NormalizedSortKey::deserializeForSorter(
+            reader, NormalizedSortKey::SorterDeserializeSettings{});
+        ASSERT_EQ(deserialized.isNormalized(), key.isNormalized());
+        ASSERT_VALUE_EQ(deserialized.sortKey(), key.sortKey());
+        if (key.isNormalized()) {
+            ASSERT_EQ(deserialized.compare(key), 0);
+        }
+    }
+    ASSERT(reader.atEof());
+}
+
+TEST(NormalizedSortKeyTest, CannotNormalizeTooManyComponents) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    BSONObjBuilder builder;
+    for (size_t idx = 0; idx <= Ordering::kMaxCompoundIndexKeys; ++idx) {
+        builder.append(str::stream() << "a" << idx, 1);
+    }
+    ASSERT_FALSE(SortKeyNormalizer::canNormalize(SortPattern{builder.obj(), expCtx}));
+    ASSERT_TRUE(SortKeyNormalizer::canNormalize(SortPattern{BSON("a" << 1), expCtx}));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -186,6 +186,10 @@ struct AndHashStats : public SpecificStats {
     // mapAfterChild[mapAfterChild.size() - 1] WSMswere match tested.
     // commonstats.advanced is how many passed.
 
+    // How many record ids produced by the children after the first one were rejected by the Bloom
+    // filter over the map, without probing the map?
+    size_t filterRejects = 0u;
+
     // What's our current memory usage?
     size_t memUsage = 0u;
 
@@ -273,6 +277,34 @@ struct CountStats : public SpecificStats {
     long long nSkipped;
 };
 
+struct ColumnScanStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        ColumnScanStats* specific = new ColumnScanStats(*this);
+        // BSON objects have to be explicitly copied.
+        specific->keyPattern = keyPattern.getOwned();
+        return specific;
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return container_size_helper::estimateObjectSizeInBytes(
+                   fields,
+                   [](const std::string& field) { return field.capacity(); },
+                   true) +
+            keyPattern.objsize() + indexName.capacity() + sizeof(*this);
+    }
+
+    std::string indexName;
+
+    BSONObj keyPattern;
+
+    // The fields read from the index.
+    std::vector<std::string> fields;
+
+    // The number of index entries read, and the number of documents rebuilt from them.
+    size_t keysExamined = 0u;
+    size_t docsReturned = 0u;
+};
+
 struct CountScanStats : public SpecificStats {
     CountScanStats()
         : indexVersion(0),
@@ -576,6 +608,9 @@ struct MultiPlanStats : public SpecificStats {
     uint64_t estimateObjectSizeInBytes() const {
         return sizeof(*this);
     }
+
+    // The number of candidate plans which the trial period stopped working early.
+    size_t candidatesPruned = 0u;
 };
 
 struct OrStats : public SpecificStats {
@@ -651,6 +686,11 @@ struct SortStats : public SpecificStats {
 
     // The number of times that we spilled data to disk during the execution of this query.
     uint64_t spills = 0u;
+
+    // The number of bytes of data spilled to disk, and the number of bytes written to disk to store
+    // them after compression.
+    uint64_t spilledDataSizeBytes = 0u;
+    uint64_t spilledDataStorageSizeBytes = 0u;
 };
 
 struct MergeSortStats : public SpecificStats {
@@ -814,6 +854,9 @@ struct TextOrStats : public SpecificStats {
     }
 
     size_t fetches;
+
+    // The number of highest-scoring documents the stage returns, or 0 if it returns all of them.
+    size_t topK = 0;
 };
 
 struct TrialStats : public SpecificStats {
@@ -199,7 +199,7 @@ void ProjectionNode::applyExpressions(const Document& root, MutableDocument* out
             invariant(expressionIt != _expressions.end());
             outputDoc->setField(
                 field,
-                expressionIt->second->evaluate(
+                expressionIt->second->evaluateMaybeCompiled(
                     root, &expressionIt->second->getExpressionContext()->variables));
         }
     }
@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bloom_filter.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Mixes the bits of 'repr', so that the consecutive RecordIds of a collection are spread over the
+ * whole filter. This is the finalizer of splitmix64.
+ */
+uint64_t mix(uint64_t repr) {
+    repr ^= repr >> 30;
+    repr *= 0xbf58476d1ce4e5b9ULL;
+    repr ^= repr >> 27;
+    repr *= 0x94d049bb133111ebULL;
+    repr ^= repr >> 31;
+    return repr;
+}
+
+}  // namespace
+
+RecordIdBloomFilter::RecordIdBloomFilter(size_t expectedNumRecordIds) {
+    uint64_t numBits = 64;
+    while (numBits < expectedNumRecordIds * kBitsPerRecordId) {
+        numBits *= 2;
+    }
+    _bitMask = numBits - 1;
+    _words.resize(numBits / 64);
+}
+
+void RecordIdBloomFilter::insert(const RecordId& rid) {
+    // Derives the positions of the probes from two halves of the hash, as in double hashing.
+    const uint64_t hash = mix(rid.repr());
+    const uint64_t step = (hash >> 32) | 1;
+    uint64_t position = hash;
+    for (size_t i = 0; i < kNumProbes; ++i, position += step) {
+        const uint64_t bit = position & _bitMask;
+        _words[bit / 64] |= uint64_t{1} << (bit % 64);
+    }
+}
+
+bool RecordIdBloomFilter::mayContain(const RecordId& rid) const {
+    const uint64_t hash = mix(rid.repr());
+    const uint64_t step = (hash >> 32) | 1;
+    uint64_t position = hash;
+    for (size_t i = 0; i < kNumProbes; ++i, position += step) {
+        const uint64_t bit = position & _bitMask;
+        if (!(_words[bit / 64] & (uint64_t{1} << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace mongo
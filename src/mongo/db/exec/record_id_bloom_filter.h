@@ -0,0 +1,73 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+/**
+ * A Bloom filter over a set of RecordIds, used to reject most of the RecordIds which are not in the
+ * set without probing the hash table holding it.
+ *
+ * The filter never rejects a RecordId which was inserted. It accepts each RecordId which was not
+ * inserted with a probability of about 1% when it is sized for the number of RecordIds inserted.
+ */
+class RecordIdBloomFilter {
+public:
+    /**
+     * Creates a filter sized for 'expectedNumRecordIds' RecordIds.
+     */
+    explicit RecordIdBloomFilter(size_t expectedNumRecordIds);
+
+    void insert(const RecordId& rid);
+
+    /**
+     * Returns false if 'rid' was definitely not inserted, or true if it may have been.
+     */
+    bool mayContain(const RecordId& rid) const;
+
+    size_t getMemUsage() const {
+        return sizeof(*this) + _words.capacity() * sizeof(uint64_t);
+    }
+
+private:
+    static constexpr size_t kBitsPerRecordId = 10;
+    static constexpr size_t kNumProbes = 7;
+
+    // The number of bits in the filter, which is a power of two, minus one.
+    uint64_t _bitMask;
+    std::vector<uint64_t> _words;
+};
+
+}  // namespace mongo
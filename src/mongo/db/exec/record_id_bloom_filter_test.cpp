@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bloom_filter.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdBloomFilterTest, ContainsInsertedRecordIds) {
+    RecordIdBloomFilter filter(1000);
+    for (int64_t i = 1; i <= 1000; ++i) {
+        filter.insert(RecordId(i * 3));
+    }
+    for (int64_t i = 1; i <= 1000; ++i) {
+        ASSERT(filter.mayContain(RecordId(i * 3)));
+    }
+}
+
+TEST(RecordIdBloomFilterTest, RejectsMostRecordIdsNotInserted) {
+    RecordIdBloomFilter filter(10000);
+    for (int64_t i = 0; i < 10000; ++i) {
+        filter.insert(RecordId(i));
+    }
+
+    size_t falsePositives = 0;
+    for (int64_t i = 10000; i < 110000; ++i) {
+        if (filter.mayContain(RecordId(i))) {
+            ++falsePositives;
+        }
+    }
+
+    // The filter is sized for a false positive rate of about 1%.
+    ASSERT_LT(falsePositives, 2000U);
+}
+
+TEST(RecordIdBloomFilterTest, EmptyFilterRejectsEverything) {
+    RecordIdBloomFilter filter(0);
+    ASSERT_FALSE(filter.mayContain(RecordId(1)));
+    ASSERT_FALSE(filter.mayContain(RecordId(RecordId::kMaxRepr)));
+}
+
+}  // namespace
+}  // namespace mongo
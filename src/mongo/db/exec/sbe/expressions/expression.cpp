@@ -467,6 +467,21 @@ static stdx::unordered_map<std::string, InstrFn> kInstrFunctions = {
     {"last", InstrFn{[](size_t n) { return n == 1; }, &vm::CodeFragment::appendLast, true}},
     {"mod", InstrFn{[](size_t n) { return n == 2; }, &vm::CodeFragment::appendMod, false}},
 };
+
+/**
+ * The code generation function for an instruction taking its second argument as an immediate.
+ */
+using ImmCodeFn = void (vm::CodeFragment::*)(value::TypeTags, value::Value);
+
+/**
+ * The map of instruction functions that have a variant encoding a constant second argument in the
+ * instruction itself, saving a push onto the stack and a separate dispatch. A field lookup by a
+ * constant name is by far the most common shape of getField.
+ */
+static stdx::unordered_map<std::string, ImmCodeFn> kImmInstrFunctions = {
+    {"getField", &vm::CodeFragment::appendGetFieldImm},
+    {"fillEmpty", &vm::CodeFragment::appendFillEmptyImm},
+};
 }  // namespace
 
 std::unique_ptr<vm::CodeFragment> EFunction::compile(CompileCtx& ctx) const {
@@ -514,6 +529,16 @@ std::unique_ptr<vm::CodeFragment> EFunction::compile(CompileCtx& ctx) const {
             code->appendAccessVal(ctx.accumulator);
         }
 
+        if (auto immIt = kImmInstrFunctions.find(_name); immIt != kImmInstrFunctions.end()) {
+            if (auto constant = dynamic_cast<const EConstant*>(_nodes[1].get())) {
+                auto [tag, val] = constant->getConstant();
+                code->append(_nodes[0]->compile(ctx));
+                (*code.*(immIt->second))(tag, val);
+
+                return code;
+            }
+        }
+
         // The order of evaluation is flipped for instruction functions. We may want to change the
         // evaluation code for those functions so we have the same behavior for all functions.
         for (size_t idx = 0; idx < _nodes.size(); ++idx) {
@@ -801,6 +826,14 @@ value::SlotId RuntimeEnvironment::getSlot(StringData type) {
     uasserted(4946305, str::stream() << "environment slot is not registered for type: " << type);
 }
 
+boost::optional<value::SlotId> RuntimeEnvironment::getSlotIfExists(StringData type) {
+    if (auto it = _state->slots.find(type); it != _state->slots.end()) {
+        return it->second.first;
+    }
+
+    return boost::none;
+}
+
 void RuntimeEnvironment::resetSlot(value::SlotId slot,
                                    value::TypeTags tag,
                                    value::Value val,
@@ -834,6 +867,24 @@ std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeCopy(bool isSmp) {
     return std::unique_ptr<RuntimeEnvironment>(new RuntimeEnvironment(*this));
 }
 
+std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeDeepCopy() const {
+    auto env = std::make_unique<RuntimeEnvironment>();
+    env->_state->slots = _state->slots;
+    env->_state->owned = _state->owned;
+    for (size_t idx = 0; idx < _state->vals.size(); ++idx) {
+        auto [tag, val] = _state->owned[idx]
+            ? value::copyValue(_state->typeTags[idx], _state->vals[idx])
+            : std::make_pair(_state->typeTags[idx], _state->vals[idx]);
+        env->_state->typeTags.push_back(tag);
+        env->_state->vals.push_back(val);
+    }
+
+    for (auto&& [type, slot] : env->_state->slots) {
+        env->emplaceAccessor(slot.first, slot.second);
+    }
+    return env;
+}
+
 void RuntimeEnvironment::debugString(StringBuilder* builder) {
     *builder << "env: { ";
     for (auto&& [type, slot] : _state->slots) {
@@ -92,6 +92,12 @@ public:
      */
     value::SlotId getSlot(StringData type);
 
+    /**
+     * Returns a SlotId registered for the given slot 'type', or boost::none if the slot hasn't been
+     * registered.
+     */
+    boost::optional<value::SlotId> getSlotIfExists(StringData type);
+
     /**
      * Store the given value in the specified slot within this runtime environment instance.
      *
@@ -118,6 +124,12 @@ public:
      */
     std::unique_ptr<RuntimeEnvironment> makeCopy(bool isSmp);
 
+    /**
+     * Make a copy of this environment which holds its own copies of the slot values, so the slots
+     * of either environment can be reset without affecting the other one.
+     */
+    std::unique_ptr<RuntimeEnvironment> makeDeepCopy() const;
+
     /**
      * Dumps all the slots currently defined in this environment into the given string builder.
      */
@@ -329,6 +341,13 @@ public:
 
     std::vector<DebugPrinter::Block> debugPrint() const override;
 
+    /**
+     * Returns a view of the constant value; it remains owned by this expression.
+     */
+    std::pair<value::TypeTags, value::Value> getConstant() const {
+        return {_tag, _val};
+    }
+
 private:
     value::TypeTags _tag;
     value::Value _val;
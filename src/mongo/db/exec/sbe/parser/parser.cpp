@@ -915,6 +915,9 @@ void Parser::walkGroup(AstQuery& ast) {
     ast.stage = makeS<HashAggStage>(std::move(ast.nodes[2]->stage),
                                     lookupSlots(std::move(ast.nodes[0]->identifiers)),
                                     lookupSlots(std::move(ast.nodes[1]->projects)),
+                                    false,
+                                    makeEM(),
+                                    std::numeric_limits<size_t>::max(),
                                     getCurrentPlanNodeId());
 }
 
@@ -927,6 +930,8 @@ void Parser::walkHashJoin(AstQuery& ast) {
                              lookupSlots(ast.nodes[0]->nodes[1]->identifiers),  // outer projections
                              lookupSlots(ast.nodes[1]->nodes[0]->identifiers),  // inner conditions
                              lookupSlots(ast.nodes[1]->nodes[1]->identifiers),  // inner projections
+                             false,
+                             std::numeric_limits<size_t>::max(),
                              getCurrentPlanNodeId());
 }
 
@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for sbe::BSONScanStage.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/bson_scan.h"
+
+namespace mongo::sbe {
+
+using BSONScanStageTest = PlanStageTestFixture;
+
+TEST_F(BSONScanStageTest, FieldsResolveToTheirFirstOccurrence) {
+    // Build a record in which field 'a' occurs twice before field 'b', followed by a record
+    // without field 'a'.
+    BSONObjBuilder withDuplicates;
+    withDuplicates.append("a", 1);
+    withDuplicates.append("a", 2);
+    withDuplicates.append("b", 3);
+    BSONObj first = withDuplicates.obj();
+    BSONObj second = BSON("b" << 4);
+
+    BufBuilder records;
+    records.appendBuf(first.objdata(), first.objsize());
+    records.appendBuf(second.objdata(), second.objsize());
+
+    auto ctx = makeCompileCtx();
+    auto slotA = generateSlotId();
+    auto slotB = generateSlotId();
+    auto scan = makeS<BSONScanStage>(records.buf(),
+                                     records.buf() + records.len(),
+                                     boost::none,
+                                     std::vector<std::string>{"a", "b"},
+                                     makeSV(slotA, slotB),
+                                     kEmptyPlanNodeId);
+    auto accessors = prepareTree(ctx.get(), scan.get(), makeSV(slotA, slotB));
+
+    // Like BSONObj::getField(), the scan takes the first occurrence of a duplicated field, and
+    // still finds the fields which come after the duplicate.
+    ASSERT_TRUE(scan->getNext() == PlanState::ADVANCED);
+    auto [aTag, aVal] = accessors[0]->getViewOfValue();
+    ASSERT_TRUE(aTag == value::TypeTags::NumberInt32);
+    ASSERT_EQ(value::bitcastTo<int32_t>(aVal), 1);
+    auto [bTag, bVal] = accessors[1]->getViewOfValue();
+    ASSERT_TRUE(bTag == value::TypeTags::NumberInt32);
+    ASSERT_EQ(value::bitcastTo<int32_t>(bVal), 3);
+
+    // A field missing from the next record is reset rather than keeping its previous value.
+    ASSERT_TRUE(scan->getNext() == PlanState::ADVANCED);
+    ASSERT_TRUE(accessors[0]->getViewOfValue().first == value::TypeTags::Nothing);
+    auto [nextBTag, nextBVal] = accessors[1]->getViewOfValue();
+    ASSERT_TRUE(nextBTag == value::TypeTags::NumberInt32);
+    ASSERT_EQ(value::bitcastTo<int32_t>(nextBVal), 4);
+
+    ASSERT_TRUE(scan->getNext() == PlanState::IS_EOF);
+}
+}  // namespace mongo::sbe
@@ -40,7 +40,34 @@
 
 namespace mongo::sbe {
 
-using FilterStageTest = PlanStageTestFixture;
+class FilterStageTest : public PlanStageTestFixture {
+public:
+    /**
+     * Drains 'stage' through getNextBatch() in batches of up to 'maxRows' rows, and returns the
+     * values of 'accessor' as an SBE array.
+     */
+    std::pair<value::TypeTags, value::Value> getAllBatchResults(PlanStage* stage,
+                                                                value::SlotAccessor* accessor,
+                                                                size_t maxRows) {
+        auto [resultsTag, resultsVal] = value::makeNewArray();
+        value::ValueGuard resultsGuard{resultsTag, resultsVal};
+        auto resultsView = value::getArrayView(resultsVal);
+
+        std::vector<value::MaterializedRow> rows;
+        while (auto count = stage->getNextBatch({accessor}, maxRows, rows)) {
+            ASSERT_LTE(count, maxRows);
+            ASSERT_EQ(count, rows.size());
+            for (auto& row : rows) {
+                auto [tag, val] = row.copyOrMoveValue(0);
+                resultsView->push_back(tag, val);
+            }
+            rows.clear();
+        }
+
+        resultsGuard.reset();
+        return {resultsTag, resultsVal};
+    }
+};
 
 TEST_F(FilterStageTest, ConstantFilterAlwaysTrueTest) {
     auto [inputTag, inputVal] = stage_builder::makeValue(
@@ -185,4 +212,30 @@ TEST_F(FilterStageTest, FilterLessThanTest) {
     runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
 }
 
+TEST_F(FilterStageTest, FilterGetNextBatchTest) {
+    auto [inputTag, inputVal] = stage_builder::makeValue(
+        BSON_ARRAY(BSON_ARRAY(2.8 << 3) << BSON_ARRAY(7LL << 5.0) << BSON_ARRAY(4LL << 4.3)
+                                        << BSON_ARRAY(8 << 8) << BSON_ARRAY("1" << 2)
+                                        << BSON_ARRAY(4.9 << 5)));
+    auto [scanSlots, scanStage] = generateVirtualScanMulti(2, inputTag, inputVal);
+
+    // Build a FilterStage whose filter expression is "slot0 < slot1", and only ask for slot1 in
+    // batches which don't divide the number of results.
+    auto filter = makeS<FilterStage<false>>(std::move(scanStage),
+                                            makeE<EPrimBinary>(EPrimBinary::less,
+                                                               makeE<EVariable>(scanSlots[0]),
+                                                               makeE<EVariable>(scanSlots[1])),
+                                            kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    auto resultAccessor = prepareTree(ctx.get(), filter.get(), scanSlots[1]);
+
+    auto [resultsTag, resultsVal] = getAllBatchResults(filter.get(), resultAccessor, 2);
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(BSON_ARRAY(3 << 4.3 << 5));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    ASSERT_TRUE(valueEquals(resultsTag, resultsVal, expectedTag, expectedVal));
+}
 }  // namespace mongo::sbe
@@ -0,0 +1,146 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/query/sbe_stage_builder_helpers.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo::sbe {
+/**
+ * This file contains tests for sbe::HashAggStage.
+ */
+
+class HashAggStageTest : public PlanStageTestFixture {
+public:
+    void setUp() override {
+        PlanStageTestFixture::setUp();
+        _tempDir = std::make_unique<unittest::TempDir>("sbeHashAggTests");
+        _oldDbPath = storageGlobalParams.dbpath;
+        storageGlobalParams.dbpath = _tempDir->path();
+    }
+
+    void tearDown() override {
+        storageGlobalParams.dbpath = _oldDbPath;
+        _tempDir.reset();
+        PlanStageTestFixture::tearDown();
+    }
+
+    /**
+     * Builds a HashAggStage grouping by 'scanSlots[0]' and computing the sum of 'scanSlots[1]'.
+     */
+    std::unique_ptr<PlanStage> makeSumStage(const value::SlotVector& scanSlots,
+                                            std::unique_ptr<PlanStage> scanStage,
+                                            value::SlotId sumSlot,
+                                            bool allowDiskUse,
+                                            size_t memoryLimit) {
+        return makeS<HashAggStage>(
+            std::move(scanStage),
+            makeSV(scanSlots[0]),
+            makeEM(sumSlot, makeE<EFunction>("sum", makeEs(makeE<EVariable>(scanSlots[1])))),
+            allowDiskUse,
+            makeEM(sumSlot, makeE<EFunction>("sum", makeEs(makeE<EVariable>(sumSlot)))),
+            memoryLimit,
+            kEmptyPlanNodeId);
+    }
+
+private:
+    std::unique_ptr<unittest::TempDir> _tempDir;
+    std::string _oldDbPath;
+};
+
+TEST_F(HashAggStageTest, SpillsAndMergesPartialAggregates) {
+    auto [inputTag, inputVal] = stage_builder::makeValue(
+        BSON_ARRAY(BSON_ARRAY(1 << 1) << BSON_ARRAY(2 << 2) << BSON_ARRAY(1 << 3)
+                                      << BSON_ARRAY(3 << 4) << BSON_ARRAY(2 << 5)
+                                      << BSON_ARRAY(1 << 6)));
+    auto [scanSlots, scan] = generateVirtualScanMulti(2, inputTag, inputVal);
+
+    // A memory limit of zero forces a spill after every input row, and the spilled groups are
+    // returned in key order.
+    auto sumSlot = generateSlotId();
+    auto agg = makeSumStage(scanSlots, std::move(scan), sumSlot, true, 0);
+
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(
+        BSON_ARRAY(BSON_ARRAY(1 << 10) << BSON_ARRAY(2 << 7) << BSON_ARRAY(3 << 4)));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    auto ctx = makeCompileCtx();
+    auto resultAccessors = prepareTree(ctx.get(), agg.get(), makeSV(scanSlots[0], sumSlot));
+
+    auto [resultsTag, resultsVal] = getAllResultsMulti(agg.get(), resultAccessors);
+    value::ValueGuard resultGuard{resultsTag, resultsVal};
+
+    ASSERT_TRUE(valueEquals(resultsTag, resultsVal, expectedTag, expectedVal));
+
+    auto stats = static_cast<const HashAggStats*>(agg->getSpecificStats());
+    ASSERT_EQ(stats->spills, 6u);
+    ASSERT_EQ(stats->spilledRecords, 6u);
+}
+
+TEST_F(HashAggStageTest, DoesNotSpillWithinMemoryLimit) {
+    auto [inputTag, inputVal] = stage_builder::makeValue(
+        BSON_ARRAY(BSON_ARRAY(1 << 1) << BSON_ARRAY(1 << 2) << BSON_ARRAY(1 << 3)));
+    auto [scanSlots, scan] = generateVirtualScanMulti(2, inputTag, inputVal);
+
+    auto sumSlot = generateSlotId();
+    auto agg = makeSumStage(scanSlots, std::move(scan), sumSlot, true, 100 * 1024 * 1024);
+
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(BSON_ARRAY(BSON_ARRAY(1 << 6)));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    auto ctx = makeCompileCtx();
+    auto resultAccessors = prepareTree(ctx.get(), agg.get(), makeSV(scanSlots[0], sumSlot));
+
+    auto [resultsTag, resultsVal] = getAllResultsMulti(agg.get(), resultAccessors);
+    value::ValueGuard resultGuard{resultsTag, resultsVal};
+
+    ASSERT_TRUE(valueEquals(resultsTag, resultsVal, expectedTag, expectedVal));
+
+    auto stats = static_cast<const HashAggStats*>(agg->getSpecificStats());
+    ASSERT_EQ(stats->spills, 0u);
+}
+
+TEST_F(HashAggStageTest, FailsWhenMemoryLimitExceededWithoutDiskUse) {
+    auto [inputTag, inputVal] =
+        stage_builder::makeValue(BSON_ARRAY(BSON_ARRAY(1 << 1) << BSON_ARRAY(2 << 2)));
+    auto [scanSlots, scan] = generateVirtualScanMulti(2, inputTag, inputVal);
+
+    auto sumSlot = generateSlotId();
+    auto agg = makeSumStage(scanSlots, std::move(scan), sumSlot, false, 0);
+
+    auto ctx = makeCompileCtx();
+    ASSERT_THROWS_CODE(prepareTree(ctx.get(), agg.get(), makeSV(scanSlots[0], sumSlot)),
+                       AssertionException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <set>
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/hash_join.h"
+#include "mongo/db/query/sbe_stage_builder_helpers.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo::sbe {
+/**
+ * This file contains tests for sbe::HashJoinStage.
+ */
+
+class HashJoinStageTest : public PlanStageTestFixture {
+public:
+    using JoinedRows = std::multiset<std::pair<int32_t, int32_t>>;
+
+    void setUp() override {
+        PlanStageTestFixture::setUp();
+        _tempDir = std::make_unique<unittest::TempDir>("sbeHashJoinTests");
+        _oldDbPath = storageGlobalParams.dbpath;
+        storageGlobalParams.dbpath = _tempDir->path();
+    }
+
+    void tearDown() override {
+        storageGlobalParams.dbpath = _oldDbPath;
+        _tempDir.reset();
+        PlanStageTestFixture::tearDown();
+    }
+
+    /**
+     * Joins the [key, value] pairs of the 'outer' and 'inner' arrays on their keys, and returns the
+     * [outer value, inner value] pairs produced by the join. The order in which a spilling join
+     * returns its rows depends on the partitioning, so the rows are collected into a multiset.
+     */
+    JoinedRows runJoin(BSONArray outer,
+                       BSONArray inner,
+                       bool allowDiskUse,
+                       size_t memoryLimit,
+                       const HashJoinStats** stats = nullptr) {
+        auto [outerTag, outerVal] = stage_builder::makeValue(outer);
+        auto [outerSlots, outerScan] = generateVirtualScanMulti(2, outerTag, outerVal);
+        auto [innerTag, innerVal] = stage_builder::makeValue(inner);
+        auto [innerSlots, innerScan] = generateVirtualScanMulti(2, innerTag, innerVal);
+
+        _stage = makeS<HashJoinStage>(std::move(outerScan),
+                                      std::move(innerScan),
+                                      makeSV(outerSlots[0]),
+                                      makeSV(outerSlots[1]),
+                                      makeSV(innerSlots[0]),
+                                      makeSV(innerSlots[1]),
+                                      allowDiskUse,
+                                      memoryLimit,
+                                      kEmptyPlanNodeId);
+
+        _ctx = makeCompileCtx();
+        auto accessors =
+            prepareTree(_ctx.get(), _stage.get(), makeSV(outerSlots[1], innerSlots[1]));
+
+        JoinedRows rows;
+        while (_stage->getNext() == PlanState::ADVANCED) {
+            auto [outerProjTag, outerProjVal] = accessors[0]->getViewOfValue();
+            auto [innerProjTag, innerProjVal] = accessors[1]->getViewOfValue();
+            ASSERT_EQ(outerProjTag, value::TypeTags::NumberInt32);
+            ASSERT_EQ(innerProjTag, value::TypeTags::NumberInt32);
+            rows.emplace(value::bitcastTo<int32_t>(outerProjVal),
+                         value::bitcastTo<int32_t>(innerProjVal));
+        }
+
+        if (stats) {
+            *stats = static_cast<const HashJoinStats*>(_stage->getSpecificStats());
+        }
+        return rows;
+    }
+
+private:
+    std::unique_ptr<unittest::TempDir> _tempDir;
+    std::string _oldDbPath;
+    std::unique_ptr<CompileCtx> _ctx;
+    std::unique_ptr<PlanStage> _stage;
+};
+
+TEST_F(HashJoinStageTest, SpillsAndJoinsPartitions) {
+    auto outer = BSON_ARRAY(BSON_ARRAY(1 << 10) << BSON_ARRAY(2 << 20) << BSON_ARRAY(1 << 11)
+                                                << BSON_ARRAY(3 << 30) << BSON_ARRAY(4 << 40));
+    auto inner = BSON_ARRAY(BSON_ARRAY(1 << 100) << BSON_ARRAY(3 << 300) << BSON_ARRAY(5 << 500)
+                                                 << BSON_ARRAY(1 << 101) << BSON_ARRAY(4 << 400));
+
+    JoinedRows expected{{10, 100}, {11, 100}, {10, 101}, {11, 101}, {30, 300}, {40, 400}};
+
+    // A memory limit of zero forces every partition that receives a build row to be spilled.
+    const HashJoinStats* stats = nullptr;
+    ASSERT(runJoin(outer, inner, true, 0, &stats) == expected);
+    ASSERT_GT(stats->spilledPartitions, 0u);
+    ASSERT_EQ(stats->spilledBuildRecords, 5u);
+    ASSERT_GTE(stats->spilledProbeRecords, 4u);
+}
+
+TEST_F(HashJoinStageTest, DoesNotSpillWithinMemoryLimit) {
+    auto outer = BSON_ARRAY(BSON_ARRAY(1 << 10) << BSON_ARRAY(2 << 20));
+    auto inner = BSON_ARRAY(BSON_ARRAY(2 << 200) << BSON_ARRAY(1 << 100) << BSON_ARRAY(2 << 201));
+
+    JoinedRows expected{{10, 100}, {20, 200}, {20, 201}};
+
+    const HashJoinStats* stats = nullptr;
+    ASSERT(runJoin(outer, inner, true, 100 * 1024 * 1024, &stats) == expected);
+    ASSERT_EQ(stats->spilledPartitions, 0u);
+    ASSERT_EQ(stats->spilledProbeRecords, 0u);
+}
+
+TEST_F(HashJoinStageTest, FailsWhenMemoryLimitExceededWithoutDiskUse) {
+    auto outer = BSON_ARRAY(BSON_ARRAY(1 << 10) << BSON_ARRAY(2 << 20));
+    auto inner = BSON_ARRAY(BSON_ARRAY(1 << 100));
+
+    ASSERT_THROWS_CODE(runJoin(outer, inner, false, 0),
+                       AssertionException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+}  // namespace mongo::sbe
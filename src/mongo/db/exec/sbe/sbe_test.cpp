@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 #include "mongo/unittest/unittest.h"
@@ -188,6 +189,34 @@ TEST(SBEValues, HashCompound) {
     }
 }
 
+TEST(SBEValues, InlineCompareAndHashMatchGeneric) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<std::pair<value::TypeTags, value::Value>> values = {
+        {value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(-5)},
+        {value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(7)},
+        {value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(-5)},
+        {value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(1LL << 40)},
+        {value::TypeTags::NumberDouble, value::bitcastFrom<double>(-5.0)},
+        {value::TypeTags::NumberDouble, value::bitcastFrom<double>(0.5)},
+        {value::TypeTags::NumberDouble, value::bitcastFrom<double>(nan)},
+        {value::TypeTags::Date, value::bitcastFrom<int64_t>(-1)},
+        {value::TypeTags::Date, value::bitcastFrom<int64_t>(1000)},
+        {value::TypeTags::RecordId, value::bitcastFrom<int64_t>(3)},
+        {value::TypeTags::Boolean, value::bitcastFrom<bool>(true)},
+    };
+
+    for (auto [lhsTag, lhsVal] : values) {
+        ASSERT_EQUALS(value::hashValueGeneric(lhsTag, lhsVal), value::hashValue(lhsTag, lhsVal));
+        for (auto [rhsTag, rhsVal] : values) {
+            auto [expectedTag, expectedVal] =
+                value::compareValueGeneric(lhsTag, lhsVal, rhsTag, rhsVal);
+            auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+            ASSERT_EQUALS(expectedTag, tag);
+            ASSERT_EQUALS(expectedVal, val);
+        }
+    }
+}
+
 TEST(SBEVM, Add) {
     {
         auto tagInt32 = value::TypeTags::NumberInt32;
@@ -248,4 +277,53 @@ TEST(SBEVM, Add) {
     }
 }
 
+TEST(SBEVM, GetFieldImm) {
+    auto obj = BSON("a" << 3 << "b" << 4);
+    auto [fieldTag, fieldVal] = value::makeSmallString("b");
+
+    vm::CodeFragment code;
+    code.appendConstVal(value::TypeTags::bsonObject,
+                        value::bitcastFrom<const char*>(obj.objdata()));
+    code.appendGetFieldImm(fieldTag, fieldVal);
+    ASSERT_EQUALS(code.stackSize(), 1);
+
+    vm::ByteCode interpreter;
+    auto [owned, tag, val] = interpreter.run(&code);
+
+    ASSERT_FALSE(owned);
+    ASSERT_EQUALS(tag, value::TypeTags::NumberInt32);
+    ASSERT_EQUALS(value::bitcastTo<int32_t>(val), 4);
+}
+
+TEST(SBEVM, FillEmptyImm) {
+    auto obj = BSON("a" << 3);
+    auto [fieldTag, fieldVal] = value::makeSmallString("b");
+
+    {
+        vm::CodeFragment code;
+        code.appendConstVal(value::TypeTags::bsonObject,
+                            value::bitcastFrom<const char*>(obj.objdata()));
+        code.appendGetFieldImm(fieldTag, fieldVal);
+        code.appendFillEmptyImm(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(-1));
+        ASSERT_EQUALS(code.stackSize(), 1);
+
+        vm::ByteCode interpreter;
+        auto [owned, tag, val] = interpreter.run(&code);
+
+        ASSERT_EQUALS(tag, value::TypeTags::NumberInt64);
+        ASSERT_EQUALS(value::bitcastTo<int64_t>(val), -1);
+    }
+    {
+        vm::CodeFragment code;
+        code.appendConstVal(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(5));
+        code.appendFillEmptyImm(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(-1));
+
+        vm::ByteCode interpreter;
+        auto [owned, tag, val] = interpreter.run(&code);
+
+        ASSERT_EQUALS(tag, value::TypeTags::NumberInt32);
+        ASSERT_EQUALS(value::bitcastTo<int32_t>(val), 5);
+    }
+}
+
 }  // namespace mongo::sbe
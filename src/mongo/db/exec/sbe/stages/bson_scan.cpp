@@ -48,6 +48,7 @@ BSONScanStage::BSONScanStage(const char* bsonBegin,
       _recordSlot(recordSlot),
       _fields(std::move(fields)),
       _vars(std::move(vars)),
+      _fieldScanner(_fields),
       _bsonCurrent(bsonBegin) {}
 
 std::unique_ptr<PlanStage> BSONScanStage::clone() const {
@@ -66,7 +67,9 @@ void BSONScanStage::prepare(CompileCtx& ctx) {
         uassert(4822841, str::stream() << "duplicate field: " << _fields[idx], inserted);
         auto [itRename, insertedRename] = _varAccessors.emplace(_vars[idx], it->second.get());
         uassert(4822842, str::stream() << "duplicate field: " << _vars[idx], insertedRename);
+        _fieldAccessorsByIndex.push_back(it->second.get());
     }
+    _fieldElements.resize(_fields.size());
 }
 
 value::SlotAccessor* BSONScanStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
@@ -93,27 +96,17 @@ PlanState BSONScanStage::getNext() {
                                    value::bitcastFrom<const char*>(_bsonCurrent));
         }
 
-        if (auto fieldsToMatch = _fieldAccessors.size(); fieldsToMatch != 0) {
-            auto be = _bsonCurrent + 4;
+        if (!_fieldAccessors.empty()) {
             auto end = _bsonCurrent + value::readFromMemory<uint32_t>(_bsonCurrent);
-            for (auto& [name, accessor] : _fieldAccessors) {
-                accessor->reset();
-            }
-            while (*be != 0) {
-                auto sv = bson::fieldNameView(be);
-                if (auto it = _fieldAccessors.find(sv); it != _fieldAccessors.end()) {
+            _fieldScanner.scan(_bsonCurrent, _fieldElements.data());
+            for (size_t idx = 0; idx < _fieldElements.size(); ++idx) {
+                if (auto elem = _fieldElements[idx]) {
                     // Found the field so convert it to Value.
-                    auto [tag, val] = bson::convertFrom(true, be, end, sv.size());
-
-                    it->second->reset(tag, val);
-
-                    if ((--fieldsToMatch) == 0) {
-                        // No need to scan any further so bail out early.
-                        break;
-                    }
+                    auto [tag, val] = bson::convertFrom(true, elem, end, _fields[idx].size());
+                    _fieldAccessorsByIndex[idx]->reset(tag, val);
+                } else {
+                    _fieldAccessorsByIndex[idx]->reset();
                 }
-
-                be = bson::advance(be, sv.size());
             }
         }
 
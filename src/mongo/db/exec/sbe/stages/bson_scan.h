@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/bson/bson_field_scan.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/values/bson.h"
 
@@ -64,11 +65,20 @@ private:
     const std::vector<std::string> _fields;
     const value::SlotVector _vars;
 
+    // Locates '_fields' within each record in a single pass. A field which occurs more than once
+    // in a record resolves to its first occurrence, as with BSONObj::getField().
+    const BSONFieldScanner _fieldScanner;
+
     std::unique_ptr<value::ViewOfValueAccessor> _recordAccessor;
 
     value::FieldAccessorMap _fieldAccessors;
     value::SlotAccessorMap _varAccessors;
 
+    // The accessors of '_fields' and the elements found for them in the current record, both in
+    // the same order as '_fields'.
+    std::vector<value::ViewOfValueAccessor*> _fieldAccessorsByIndex;
+    std::vector<const char*> _fieldElements;
+
     const char* _bsonCurrent;
 
     ScanStats _specificStats;
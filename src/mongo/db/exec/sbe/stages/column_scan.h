@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/db_raii.h"
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/trial_run_progress_tracker.h"
+#include "mongo/db/index/column_store_access_method.h"
+
+namespace mongo::sbe {
+
+/**
+ * A stage that reads every document of a collection back from the columnstore index 'indexName',
+ * in RecordId order, as an alternative to a full collection scan.
+ *
+ * The "output" slots are
+ *   - 'resultSlot': a BSON object holding the subset of 'fields' present in the document, in the
+ *     order in which they appear in the document, and
+ *   - 'recordIdSlot': the RecordId of the document.
+ */
+class ColumnScanStage final : public PlanStage {
+public:
+    ColumnScanStage(const NamespaceStringOrUUID& name,
+                    std::string_view indexName,
+                    std::vector<std::string> fields,
+                    value::SlotId resultSlot,
+                    value::SlotId recordIdSlot,
+                    PlanYieldPolicy* yieldPolicy,
+                    TrialRunProgressTracker* tracker,
+                    PlanNodeId nodeId);
+
+    std::unique_ptr<PlanStage> clone() const final;
+
+    void prepare(CompileCtx& ctx) final;
+    value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
+    void open(bool reOpen) final;
+    PlanState getNext() final;
+    void close() final;
+
+    std::unique_ptr<PlanStageStats> getStats() const final;
+    const SpecificStats* getSpecificStats() const final;
+    std::vector<DebugPrinter::Block> debugPrint() const final;
+
+protected:
+    void doSaveState() override;
+    void doRestoreState() override;
+    void doDetachFromOperationContext() override;
+    void doAttachFromOperationContext(OperationContext* opCtx) override;
+    void doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) override;
+
+private:
+    const NamespaceStringOrUUID _name;
+    const std::string _indexName;
+    const std::vector<std::string> _fields;
+    const value::SlotId _resultSlot;
+    const value::SlotId _recordIdSlot;
+
+    std::unique_ptr<value::ViewOfValueAccessor> _resultAccessor;
+    std::unique_ptr<value::ViewOfValueAccessor> _recordIdAccessor;
+
+    std::unique_ptr<ColumnStoreAccessMethod::RowCursor> _cursor;
+    std::weak_ptr<const IndexCatalogEntry> _weakIndexCatalogEntry;
+    boost::optional<AutoGetCollectionForRead> _coll;
+
+    // The row last returned, which the '_resultAccessor' views.
+    BSONObj _row;
+
+    bool _open{false};
+    ColumnScanStats _specificStats;
+
+    // If provided, used during a trial run to accumulate certain execution stats. Once the trial
+    // run is complete, this pointer is reset to nullptr.
+    TrialRunProgressTracker* _tracker{nullptr};
+};
+}  // namespace mongo::sbe
@@ -249,15 +249,20 @@ void ExchangeConsumer::open(bool reOpen) {
                 }
             }
 
-            // Start n producers.
+            // Start n producers. They inherit the time limit of this operation.
             invariant(_state->producerCompileCtxs().size() == _state->numOfProducers());
+            _state->setParentOpCtx(_opCtx);
+            const auto deadline = _opCtx->getDeadline();
+            const auto timeoutError = _opCtx->getTimeoutError();
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
                 auto pf = makePromiseFuture<void>();
                 s_globalThreadPool->schedule(
-                    [this, idx, promise = std::move(pf.promise)](auto status) mutable {
+                    [this, idx, deadline, timeoutError, promise = std::move(pf.promise)](
+                        auto status) mutable {
                         invariant(status);
 
                         auto opCtx = cc().makeOperationContext();
+                        opCtx->setDeadlineByDate(deadline, timeoutError);
 
                         promise.setWith([&] {
                             ExchangeProducer::start(opCtx.get(),
@@ -363,7 +368,10 @@ void ExchangeConsumer::close() {
 
 std::unique_ptr<PlanStageStats> ExchangeConsumer::getStats() const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
-    ret->children.emplace_back(_children[0]->getStats());
+    // Once opened, the subtree has been handed over to the producers.
+    if (!_children.empty()) {
+        ret->children.emplace_back(_children[0]->getStats());
+    }
     return ret;
 }
 
@@ -396,8 +404,10 @@ std::vector<DebugPrinter::Block> ExchangeConsumer::debugPrint() const {
             uasserted(4822835, "policy not yet implemented");
     }
 
-    DebugPrinter::addNewLine(ret);
-    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    if (!_children.empty()) {
+        DebugPrinter::addNewLine(ret);
+        DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    }
 
     return ret;
 }
@@ -516,6 +526,8 @@ bool ExchangeProducer::appendData(size_t consumerId) {
 
 PlanState ExchangeProducer::getNext() {
     while (_children[0]->getNext() == PlanState::ADVANCED) {
+        _state->checkParentForInterrupt();
+
         // Push to the correct pipe.
         switch (_state->policy()) {
             case ExchangePolicy::broadcast: {
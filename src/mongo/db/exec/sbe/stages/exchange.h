@@ -217,6 +217,21 @@ public:
     }
     ExchangePipe* pipe(size_t consumerTid, size_t producerTid);
 
+    void setParentOpCtx(OperationContext* opCtx) {
+        _parentOpCtx = opCtx;
+    }
+
+    /**
+     * The producers run on operation contexts of their own, so a killOp on the operation that
+     * opened the exchange is forwarded to them through this check.
+     */
+    void checkParentForInterrupt() const {
+        invariant(_parentOpCtx);
+        if (auto code = _parentOpCtx->getKillStatus(); code != ErrorCodes::OK) {
+            uasserted(code, "operation running the exchange was interrupted");
+        }
+    }
+
 private:
     const ExchangePolicy _policy;
     const size_t _numOfProducers;
@@ -226,6 +241,9 @@ private:
     std::vector<CompileCtx> _producerCompileCtxs;
     std::vector<Future<void>> _producerResults;
 
+    // The operation of consumer 0, which starts the producers and waits for them in close().
+    OperationContext* _parentOpCtx{nullptr};
+
     // Variables (fields) that pass through the exchange.
     const value::SlotVector _fields;
 
@@ -33,14 +33,58 @@
 
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashAggFileCounter;
+    return "extsort-hash-agg-sbe." + std::to_string(hashAggFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
+namespace {
+/**
+ * Compares two group-by keys value by value, yielding the order in which the groups are written to
+ * and read back from the spilled runs.
+ */
+int compareKeys(const value::MaterializedRow& lhs, const value::MaterializedRow& rhs) {
+    for (size_t idx = 0; idx < lhs.size(); ++idx) {
+        auto [lhsTag, lhsVal] = lhs.getViewOfValue(idx);
+        auto [rhsTag, rhsVal] = rhs.getViewOfValue(idx);
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+
+        auto result = value::bitcastTo<int32_t>(val);
+        if (result) {
+            return result;
+        }
+    }
+
+    return 0;
+}
+}  // namespace
+
 HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector gbs,
                            value::SlotMap<std::unique_ptr<EExpression>> aggs,
+                           bool allowDiskUse,
+                           value::SlotMap<std::unique_ptr<EExpression>> mergingExprs,
+                           size_t memoryLimit,
                            PlanNodeId planNodeId)
-    : PlanStage("group"_sd, planNodeId), _gbs(std::move(gbs)), _aggs(std::move(aggs)) {
+    : PlanStage("group"_sd, planNodeId),
+      _gbs(std::move(gbs)),
+      _aggs(std::move(aggs)),
+      _allowDiskUse(allowDiskUse),
+      _mergingExprs(std::move(mergingExprs)),
+      _mergeData({0, 0}) {
     _children.emplace_back(std::move(input));
+
+    _specificStats.maxMemoryUsageBytes = memoryLimit;
+}
+
+HashAggStage::~HashAggStage() {
+    resetSpilledState();
 }
 
 std::unique_ptr<PlanStage> HashAggStage::clone() const {
@@ -48,8 +92,17 @@ std::unique_ptr<PlanStage> HashAggStage::clone() const {
     for (auto& [k, v] : _aggs) {
         aggs.emplace(k, v->clone());
     }
-    return std::make_unique<HashAggStage>(
-        _children[0]->clone(), _gbs, std::move(aggs), _commonStats.nodeId);
+    value::SlotMap<std::unique_ptr<EExpression>> mergingExprs;
+    for (auto& [k, v] : _mergingExprs) {
+        mergingExprs.emplace(k, v->clone());
+    }
+    return std::make_unique<HashAggStage>(_children[0]->clone(),
+                                          _gbs,
+                                          std::move(aggs),
+                                          _allowDiskUse,
+                                          std::move(mergingExprs),
+                                          _specificStats.maxMemoryUsageBytes,
+                                          _commonStats.nodeId);
 }
 
 void HashAggStage::prepare(CompileCtx& ctx) {
@@ -63,8 +116,12 @@ void HashAggStage::prepare(CompileCtx& ctx) {
         uassert(4822827, str::stream() << "duplicate field: " << slot, inserted);
 
         _inKeyAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
-        _outKeyAccessors.emplace_back(std::make_unique<HashKeyAccessor>(_htIt, counter++));
+        _outKeyAccessors.emplace_back(std::make_unique<HashKeyAccessor>(_htIt, counter));
         _outAccessors[slot] = _outKeyAccessors.back().get();
+
+        _spilledKeyAccessors.emplace_back(
+            std::make_unique<SpilledKeyAccessor>(_mergeDataIt, counter++));
+        _spilledAccessors[slot] = _spilledKeyAccessors.back().get();
     }
 
     counter = 0;
@@ -76,9 +133,13 @@ void HashAggStage::prepare(CompileCtx& ctx) {
         const auto slotId = slot;
         uassert(4822828, str::stream() << "duplicate field: " << slotId, inserted);
 
-        _outAggAccessors.emplace_back(std::make_unique<HashAggAccessor>(_htIt, counter++));
+        _outAggAccessors.emplace_back(std::make_unique<HashAggAccessor>(_htIt, counter));
         _outAccessors[slot] = _outAggAccessors.back().get();
 
+        _spilledAggAccessors.emplace_back(
+            std::make_unique<SpilledAggAccessor>(_mergeDataIt, counter++));
+        _spilledAccessors[slot] = _spilledAggAccessors.back().get();
+
         ctx.root = this;
         ctx.aggExpression = true;
         ctx.accumulator = _outAggAccessors.back().get();
@@ -86,11 +147,37 @@ void HashAggStage::prepare(CompileCtx& ctx) {
         _aggCodes.emplace_back(expr->compile(ctx));
         ctx.aggExpression = false;
     }
+
+    if (_allowDiskUse) {
+        // The merging expressions fold the spilled partial aggregates into the same accumulators,
+        // so they are compiled only after all the output accessors have been set up.
+        _compilingMergingExprs = true;
+        counter = 0;
+        for (auto& [slot, expr] : _aggs) {
+            const auto slotId = slot;
+            auto it = _mergingExprs.find(slotId);
+            uassert(5843100,
+                    str::stream() << "missing merging expression for aggregate slot: " << slotId,
+                    it != _mergingExprs.end());
+
+            ctx.root = this;
+            ctx.aggExpression = true;
+            ctx.accumulator = _outAggAccessors[counter++].get();
+
+            _mergingCodes.emplace_back(it->second->compile(ctx));
+            ctx.aggExpression = false;
+        }
+        _compilingMergingExprs = false;
+    }
     _compiled = true;
 }
 
 value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
-    if (_compiled) {
+    if (_compilingMergingExprs) {
+        if (auto it = _spilledAccessors.find(slot); it != _spilledAccessors.end()) {
+            return it->second;
+        }
+    } else if (_compiled) {
         if (auto it = _outAccessors.find(slot); it != _outAccessors.end()) {
             return it->second;
         }
@@ -107,7 +194,9 @@ void HashAggStage::open(bool reOpen) {
 
     if (reOpen) {
         _ht.clear();
+        resetSpilledState();
     }
+    _memoryUsageBytes = 0;
 
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         value::MaterializedRow key{_inKeyAccessors.size()};
@@ -121,9 +210,16 @@ void HashAggStage::open(bool reOpen) {
         auto [it, inserted] = _ht.try_emplace(std::move(key), value::MaterializedRow{0});
         if (inserted) {
             // Copy keys.
-            const_cast<value::MaterializedRow&>(it->first).makeOwned();
+            it->first.makeOwned();
             // Initialize accumulators.
             it->second.resize(_outAggAccessors.size());
+
+            if (isMemoryTracked()) {
+                _memoryUsageBytes += it->first.memUsageForSorter();
+            }
+        } else if (isMemoryTracked()) {
+            // Subtract the old size of the accumulators, the new size is added back below.
+            _memoryUsageBytes -= it->second.memUsageForSorter();
         }
 
         // Accumulate.
@@ -132,14 +228,114 @@ void HashAggStage::open(bool reOpen) {
             auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
             _outAggAccessors[idx]->reset(owned, tag, val);
         }
+
+        if (isMemoryTracked()) {
+            _memoryUsageBytes += it->second.memUsageForSorter();
+
+            if (_memoryUsageBytes > _specificStats.maxMemoryUsageBytes) {
+                uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                        "Exceeded memory limit for $group, but didn't allow external sort."
+                        " Pass allowDiskUse:true to opt in.",
+                        _allowDiskUse);
+                spill();
+            } else if (_allowDiskUse && _memoryReservation.update(_memoryUsageBytes)) {
+                QueryMemoryReservation::recordForcedSpill();
+                spill();
+            }
+        }
     }
 
     _children[0]->close();
 
+    if (!_spilledRuns.empty()) {
+        if (!_ht.empty()) {
+            spill();
+        }
+
+        auto comp = [](const SpilledRow& lhs, const SpilledRow& rhs) {
+            return compareKeys(lhs.first, rhs.first);
+        };
+        _mergeIt.reset(SpillIterator::merge(_spilledRuns, SortOptions(), comp));
+        _hasSpilledRow = _mergeIt->more();
+        if (_hasSpilledRow) {
+            _mergeData = _mergeIt->next();
+        }
+    }
+
     _htIt = _ht.end();
 }
 
+void HashAggStage::spill() {
+    std::vector<const TableType::value_type*> groups;
+    groups.reserve(_ht.size());
+    for (auto& group : _ht) {
+        groups.push_back(&group);
+    }
+    std::sort(groups.begin(), groups.end(), [](auto lhs, auto rhs) {
+        return compareKeys(lhs->first, rhs->first) < 0;
+    });
+
+    SortOptions opts;
+    opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
+    if (_spillFileName.empty()) {
+        _spillFileName = opts.tempDir + "/" + nextFileName();
+    }
+
+    SortedFileWriter<value::MaterializedRow, value::MaterializedRow> writer(
+        opts, _spillFileName, _nextSpillFileOffset);
+    for (auto group : groups) {
+        writer.addAlreadySorted(group->first, group->second);
+    }
+    _spilledRuns.emplace_back(writer.done());
+    _nextSpillFileOffset = writer.getFileEndOffset();
+
+    _specificStats.spills++;
+    _specificStats.spilledRecords += groups.size();
+
+    _ht.clear();
+    _memoryUsageBytes = 0;
+    _memoryReservation.update(0);
+}
+
+PlanState HashAggStage::getNextSpilled() {
+    if (!_hasSpilledRow) {
+        _ht.clear();
+        _htIt = _ht.end();
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
+    // The output accessors read from the hash table, so every merged group is materialized as the
+    // only entry of the otherwise empty table.
+    _ht.clear();
+    auto [it, inserted] =
+        _ht.try_emplace(_mergeData.first, value::MaterializedRow{_outAggAccessors.size()});
+    _htIt = it;
+
+    while (true) {
+        for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
+            auto [owned, tag, val] = _bytecode.run(_mergingCodes[idx].get());
+            _outAggAccessors[idx]->reset(owned, tag, val);
+        }
+
+        if (!_mergeIt->more()) {
+            _hasSpilledRow = false;
+            break;
+        }
+
+        _mergeData = _mergeIt->next();
+        if (compareKeys(_mergeData.first, _htIt->first) != 0) {
+            break;
+        }
+    }
+
+    return trackPlanState(PlanState::ADVANCED);
+}
+
 PlanState HashAggStage::getNext() {
+    if (_mergeIt) {
+        return getNextSpilled();
+    }
+
     if (_htIt == _ht.end()) {
         _htIt = _ht.begin();
     } else {
@@ -155,17 +351,33 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats() const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
     ret->children.emplace_back(_children[0]->getStats());
     return ret;
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
     _commonStats.closes++;
     _ht.clear();
+    resetSpilledState();
+}
+
+void HashAggStage::resetSpilledState() {
+    // The merge iterator and the runs must be destroyed before the file they read from is removed.
+    _mergeIt.reset();
+    _spilledRuns.clear();
+    _hasSpilledRow = false;
+    _mergeData = {0, 0};
+
+    if (!_spillFileName.empty()) {
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_spillFileName));
+        _spillFileName.clear();
+    }
+    _nextSpillFileOffset = 0;
 }
 
 std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
@@ -195,6 +407,24 @@ std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
     }
     ret.emplace_back("`]");
 
+    if (_allowDiskUse) {
+        ret.emplace_back("spill");
+
+        ret.emplace_back(DebugPrinter::Block("[`"));
+        first = true;
+        for (auto& p : _mergingExprs) {
+            if (!first) {
+                ret.emplace_back(DebugPrinter::Block("`,"));
+            }
+
+            DebugPrinter::addIdentifier(ret, p.first);
+            ret.emplace_back("=");
+            DebugPrinter::addBlocks(ret, p.second->debugPrint());
+            first = false;
+        }
+        ret.emplace_back("`]");
+    }
+
     DebugPrinter::addNewLine(ret);
     DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
 
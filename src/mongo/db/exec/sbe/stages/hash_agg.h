@@ -29,22 +29,45 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <ios>
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/sbe/values/row_hash_table.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
-#include "mongo/stdx/unordered_map.h"
+#include "mongo/db/sorter/query_memory_reservation.h"
 
 namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+
 namespace sbe {
+/**
+ * Groups the input rows by the values in the 'gbs' slots and computes the aggregate expressions
+ * in 'aggs' for every group.
+ *
+ * When 'memoryLimit' is finite, the size of the hash table is tracked and once it exceeds the limit
+ * the table is either spilled to disk as a sorted run of (key, partial aggregate) pairs, or, when
+ * 'allowDiskUse' is false, the query fails. Spilled runs are merged back in key order once the
+ * input is exhausted, and the partial aggregates of every group are combined using
+ * 'mergingExprs'. There must be a merging expression for every aggregate slot when disk use is
+ * allowed. A merging expression is an aggregate expression keyed by the aggregate slot it
+ * produces; inside of it, a reference to any output slot (either a group-by or an aggregate slot)
+ * denotes the value read back from the spilled row. E.g. a "count" computed as 'sum(1)' would be
+ * merged as 'sum(s1)', where 's1' is the slot holding the count.
+ */
 class HashAggStage final : public PlanStage {
 public:
     HashAggStage(std::unique_ptr<PlanStage> input,
                  value::SlotVector gbs,
                  value::SlotMap<std::unique_ptr<EExpression>> aggs,
+                 bool allowDiskUse,
+                 value::SlotMap<std::unique_ptr<EExpression>> mergingExprs,
+                 size_t memoryLimit,
                  PlanNodeId planNodeId);
 
+    ~HashAggStage();
+
     std::unique_ptr<PlanStage> clone() const final;
 
     void prepare(CompileCtx& ctx) final;
@@ -58,14 +81,43 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
 private:
-    using TableType = stdx::
-        unordered_map<value::MaterializedRow, value::MaterializedRow, value::MaterializedRowHasher>;
+    using TableType = value::RowHashTable;
 
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    using SpilledRow = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpillIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+
+    using SpilledKeyAccessor = value::MaterializedRowKeyAccessor<SpilledRow*>;
+    using SpilledAggAccessor = value::MaterializedRowValueAccessor<SpilledRow*>;
+
+    bool isMemoryTracked() const {
+        return _specificStats.maxMemoryUsageBytes != std::numeric_limits<size_t>::max();
+    }
+
+    /**
+     * Writes the content of the hash table to disk as a run sorted by the group-by key, and then
+     * empties the hash table.
+     */
+    void spill();
+
+    /**
+     * Produces the next group by merging the partial aggregates of all spilled rows sharing the
+     * smallest group-by key remaining in the sorted runs.
+     */
+    PlanState getNextSpilled();
+
+    /**
+     * Releases the resources acquired while spilling, including the temporary file.
+     */
+    void resetSpilledState();
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
+    const bool _allowDiskUse;
+    const value::SlotMap<std::unique_ptr<EExpression>> _mergingExprs;
+    HashAggStats _specificStats;
 
     value::SlotAccessorMap _outAccessors;
     std::vector<value::SlotAccessor*> _inKeyAccessors;
@@ -74,12 +126,39 @@ private:
     std::vector<std::unique_ptr<HashAggAccessor>> _outAggAccessors;
     std::vector<std::unique_ptr<vm::CodeFragment>> _aggCodes;
 
+    // Accessors used by the merging expressions to read the spilled (key, partial aggregate) row
+    // currently being merged. The merging code is stored in the same order as '_aggCodes'.
+    value::SlotAccessorMap _spilledAccessors;
+    std::vector<std::unique_ptr<SpilledKeyAccessor>> _spilledKeyAccessors;
+    std::vector<std::unique_ptr<SpilledAggAccessor>> _spilledAggAccessors;
+    std::vector<std::unique_ptr<vm::CodeFragment>> _mergingCodes;
+
     TableType _ht;
     TableType::iterator _htIt;
 
+    // Approximate number of bytes held by the hash table. Only maintained when 'memoryLimit' is
+    // finite.
+    size_t _memoryUsageBytes{0};
+
+    // Accounts for '_memoryUsageBytes' in the memory used by the blocking stages of all queries.
+    QueryMemoryReservation _memoryReservation;
+
+    // The sorted runs written by spill(). All of them share a single temporary file.
+    std::vector<std::shared_ptr<SpillIterator>> _spilledRuns;
+    std::string _spillFileName;
+    std::streampos _nextSpillFileOffset{0};
+
+    // Iterates over the spilled runs in key order. '_mergeData' holds the first spilled row of the
+    // next group to be returned, if '_hasSpilledRow' is true.
+    std::unique_ptr<SpillIterator> _mergeIt;
+    SpilledRow _mergeData;
+    SpilledRow* _mergeDataIt{&_mergeData};
+    bool _hasSpilledRow{false};
+
     vm::ByteCode _bytecode;
 
     bool _compiled{false};
+    bool _compilingMergingExprs{false};
 };
 }  // namespace sbe
 }  // namespace mongo
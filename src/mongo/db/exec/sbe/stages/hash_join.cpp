@@ -34,6 +34,15 @@
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashJoinFileCounter;
+    return "extsort-hash-join-sbe." + std::to_string(hashJoinFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
 HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
@@ -42,21 +51,32 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
                              value::SlotVector outerProjects,
                              value::SlotVector innerCond,
                              value::SlotVector innerProjects,
+                             bool allowDiskUse,
+                             size_t memoryLimit,
                              PlanNodeId planNodeId)
     : PlanStage("hj"_sd, planNodeId),
       _outerCond(std::move(outerCond)),
       _outerProjects(std::move(outerProjects)),
       _innerCond(std::move(innerCond)),
       _innerProjects(std::move(innerProjects)),
-      _probeKey(0) {
+      _allowDiskUse(allowDiskUse),
+      _probeKey(0),
+      _probeProjects(0),
+      _spilledProbeRow{0, 0} {
     if (_outerCond.size() != _innerCond.size()) {
         uasserted(4822823, "left and right size do not match");
     }
 
+    _specificStats.maxMemoryUsageBytes = memoryLimit;
+
     _children.emplace_back(std::move(outer));
     _children.emplace_back(std::move(inner));
 }
 
+HashJoinStage::~HashJoinStage() {
+    resetSpilledState();
+}
+
 std::unique_ptr<PlanStage> HashJoinStage::clone() const {
     return std::make_unique<HashJoinStage>(_children[0]->clone(),
                                            _children[1]->clone(),
@@ -64,6 +84,8 @@ std::unique_ptr<PlanStage> HashJoinStage::clone() const {
                                            _outerProjects,
                                            _innerCond,
                                            _innerProjects,
+                                           _allowDiskUse,
+                                           _specificStats.maxMemoryUsageBytes,
                                            _commonStats.nodeId);
 }
 
@@ -88,6 +110,11 @@ void HashJoinStage::prepare(CompileCtx& ctx) {
         uassert(4822825, str::stream() << "duplicate field: " << slot, inserted);
 
         _inInnerKeyAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+        if (_allowDiskUse) {
+            auto [accIt, accInserted] =
+                _outInnerAccessors.emplace(slot, std::make_unique<value::ViewOfValueAccessor>());
+            _outInnerKeyAccessors.push_back(accIt->second.get());
+        }
     }
 
     counter = 0;
@@ -101,7 +128,20 @@ void HashJoinStage::prepare(CompileCtx& ctx) {
         _outOuterAccessors[slot] = _outOuterProjectAccessors.back().get();
     }
 
+    if (_allowDiskUse) {
+        for (auto& slot : _innerProjects) {
+            auto [it, inserted] = dupCheck.emplace(slot);
+            uassert(5843101, str::stream() << "duplicate field: " << slot, inserted);
+
+            _inInnerProjectAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+            auto [accIt, accInserted] =
+                _outInnerAccessors.emplace(slot, std::make_unique<value::ViewOfValueAccessor>());
+            _outInnerProjectAccessors.push_back(accIt->second.get());
+        }
+    }
+
     _probeKey.resize(_inInnerKeyAccessors.size());
+    _probeProjects.resize(_inInnerProjectAccessors.size());
 
     _compiled = true;
 }
@@ -112,15 +152,32 @@ value::SlotAccessor* HashJoinStage::getAccessor(CompileCtx& ctx, value::SlotId s
             return it->second;
         }
 
+        if (_allowDiskUse) {
+            if (auto it = _outInnerAccessors.find(slot); it != _outInnerAccessors.end()) {
+                return it->second.get();
+            }
+
+            return ctx.getAccessor(slot);
+        }
+
         return _children[1]->getAccessor(ctx, slot);
     }
 
     return ctx.getAccessor(slot);
 }
 
+size_t HashJoinStage::partitionOf(const value::MaterializedRow& key) {
+    return value::MaterializedRowHasher{}(key) % kNumPartitions;
+}
+
 void HashJoinStage::open(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
+
+    // The rows of a previous execution, if any, are no longer needed.
+    _ht.clear();
+    resetSpilledState();
+
     // Insert the outer side into the hash table.
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         value::MaterializedRow key{_inOuterKeyAccessors.size()};
@@ -140,62 +197,295 @@ void HashJoinStage::open(bool reOpen) {
             project.reset(idx++, true, tag, val);
         }
 
+        if (!isMemoryTracked()) {
+            _ht.emplace(std::move(key), std::move(project));
+            continue;
+        }
+
+        auto& partition = _partitions[partitionOf(key)];
+        if (partition.spilled) {
+            // The rest of this partition is already on disk, so the row goes there as well.
+            writeSpilledRow(partition.buildWriter, partition.buildFileName, key, project);
+            _specificStats.spilledBuildRecords++;
+            continue;
+        }
+
+        auto rowSize = key.memUsageForSorter() + project.memUsageForSorter();
+        partition.memoryUsageBytes += rowSize;
+        _memoryUsageBytes += rowSize;
         _ht.emplace(std::move(key), std::move(project));
+
+        if (_memoryUsageBytes > _specificStats.maxMemoryUsageBytes) {
+            uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                    "Exceeded memory limit for hash join, but didn't allow external sort. Pass "
+                    "allowDiskUse:true to opt in.",
+                    _allowDiskUse);
+            spillPartitions();
+        }
     }
 
     _children[0]->close();
 
+    for (auto& partition : _partitions) {
+        if (partition.buildWriter) {
+            partition.buildRows.reset(partition.buildWriter->done());
+            partition.buildWriter.reset();
+        }
+    }
+
     _children[1]->open(reOpen);
 
     _htIt = _ht.end();
-    _htItEnd = _ht.end();
+}
+
+void HashJoinStage::spillPartitions() {
+    while (_memoryUsageBytes > _specificStats.maxMemoryUsageBytes) {
+        size_t largest = kNumPartitions;
+        for (size_t idx = 0; idx < kNumPartitions; ++idx) {
+            if (!_partitions[idx].spilled &&
+                (largest == kNumPartitions ||
+                 _partitions[idx].memoryUsageBytes > _partitions[largest].memoryUsageBytes)) {
+                largest = idx;
+            }
+        }
+
+        if (largest == kNumPartitions) {
+            break;
+        }
+        spillPartition(largest);
+    }
+}
+
+void HashJoinStage::spillPartition(size_t partitionIdx) {
+    auto& partition = _partitions[partitionIdx];
+
+    // Rebuild the hash table from the rows that stay in memory. The entries are visited in their
+    // insertion order, so the order of the duplicates of every key is preserved.
+    TableType ht;
+    ht.reserve(_ht.size());
+    size_t spilledRows = 0;
+    for (auto& [key, project] : _ht) {
+        if (partitionOf(key) == partitionIdx) {
+            writeSpilledRow(partition.buildWriter, partition.buildFileName, key, project);
+            ++spilledRows;
+        } else {
+            ht.emplace(std::move(key), std::move(project));
+        }
+    }
+    _ht = std::move(ht);
+
+    partition.spilled = true;
+    _memoryUsageBytes -= partition.memoryUsageBytes;
+    partition.memoryUsageBytes = 0;
+    _hasSpilledPartitions = true;
+
+    _specificStats.spilledPartitions++;
+    _specificStats.spilledBuildRecords += spilledRows;
+}
+
+void HashJoinStage::writeSpilledRow(std::unique_ptr<SpillWriter>& writer,
+                                    std::string& fileName,
+                                    const value::MaterializedRow& key,
+                                    const value::MaterializedRow& row) {
+    if (!writer) {
+        // The writer, and with it the file, is only created for the first row, because the file
+        // of every spilled run must not be empty.
+        SortOptions opts;
+        opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
+        fileName = opts.tempDir + "/" + nextFileName();
+        writer = std::make_unique<SpillWriter>(opts, fileName, 0);
+    }
+    writer->addAlreadySorted(key, row);
 }
 
 PlanState HashJoinStage::getNext() {
-    if (_htIt != _htItEnd) {
-        ++_htIt;
+    if (_htIt != _ht.end()) {
+        _htIt = _ht.nextDuplicate(_htIt);
     }
 
-    if (_htIt == _htItEnd) {
-        while (_htIt == _htItEnd) {
-            auto state = _children[1]->getNext();
-            if (state == PlanState::IS_EOF) {
-                // LEFT and OUTER joins should enumerate "non-returned" rows here.
-                return trackPlanState(state);
+    while (_htIt == _ht.end()) {
+        if (!fetchNextProbeRow()) {
+            // LEFT and OUTER joins should enumerate "non-returned" rows here.
+            return trackPlanState(PlanState::IS_EOF);
+        }
+
+        _htIt = _ht.find(_probeKey);
+        // If _htIt == _ht.end() (i.e. no match) then RIGHT and OUTER joins
+        // should enumerate "non-returned" rows here.
+    }
+
+    if (_allowDiskUse) {
+        resetInnerAccessors();
+    }
+
+    return trackPlanState(PlanState::ADVANCED);
+}
+
+bool HashJoinStage::fetchNextProbeRow() {
+    while (!_probingSpilledPartitions) {
+        auto state = _children[1]->getNext();
+        if (state == PlanState::IS_EOF) {
+            if (!_hasSpilledPartitions) {
+                return false;
             }
 
-            // Copy keys in order to do the lookup.
-            size_t idx = 0;
-            for (auto& p : _inInnerKeyAccessors) {
-                auto [tag, val] = p->getViewOfValue();
-                _probeKey.reset(idx++, false, tag, val);
+            for (auto& partition : _partitions) {
+                if (partition.probeWriter) {
+                    partition.probeRows.reset(partition.probeWriter->done());
+                    partition.probeWriter.reset();
+                }
+            }
+            _probingSpilledPartitions = true;
+            _currentPartition = kNumPartitions;
+            if (!loadNextSpilledPartition()) {
+                return false;
             }
+            break;
+        }
+
+        // Copy keys in order to do the lookup.
+        size_t idx = 0;
+        for (auto& p : _inInnerKeyAccessors) {
+            auto [tag, val] = p->getViewOfValue();
+            _probeKey.reset(idx++, false, tag, val);
+        }
+
+        idx = 0;
+        for (auto& p : _inInnerProjectAccessors) {
+            auto [tag, val] = p->getViewOfValue();
+            _probeProjects.reset(idx++, false, tag, val);
+        }
+
+        if (!_hasSpilledPartitions) {
+            return true;
+        }
+
+        auto& partition = _partitions[partitionOf(_probeKey)];
+        if (!partition.spilled) {
+            return true;
+        }
 
-            auto [low, hi] = _ht.equal_range(_probeKey);
-            _htIt = low;
-            _htItEnd = hi;
-            // If _htIt == _htItEnd (i.e. no match) then RIGHT and OUTER joins
-            // should enumerate "non-returned" rows here.
+        // Probe rows with no build rows to match are dropped rather than written to disk.
+        if (partition.buildRows) {
+            writeSpilledRow(
+                partition.probeWriter, partition.probeFileName, _probeKey, _probeProjects);
+            _specificStats.spilledProbeRecords++;
         }
     }
 
-    return trackPlanState(PlanState::ADVANCED);
+    if (_currentPartition == kNumPartitions) {
+        return false;
+    }
+
+    while (!_partitions[_currentPartition].probeRows->more()) {
+        if (!loadNextSpilledPartition()) {
+            return false;
+        }
+    }
+
+    _spilledProbeRow = _partitions[_currentPartition].probeRows->next();
+
+    for (size_t idx = 0; idx < _probeKey.size(); ++idx) {
+        auto [tag, val] = _spilledProbeRow.first.getViewOfValue(idx);
+        _probeKey.reset(idx, false, tag, val);
+    }
+
+    for (size_t idx = 0; idx < _probeProjects.size(); ++idx) {
+        auto [tag, val] = _spilledProbeRow.second.getViewOfValue(idx);
+        _probeProjects.reset(idx, false, tag, val);
+    }
+
+    return true;
+}
+
+bool HashJoinStage::loadNextSpilledPartition() {
+    if (_currentPartition != kNumPartitions) {
+        _partitions[_currentPartition].probeRows->closeSource();
+    }
+
+    _ht.clear();
+    _htIt = _ht.end();
+
+    for (++_currentPartition; _currentPartition < kNumPartitions; ++_currentPartition) {
+        auto& partition = _partitions[_currentPartition];
+        if (!partition.buildRows || !partition.probeRows) {
+            continue;
+        }
+
+        partition.buildRows->openSource();
+        while (partition.buildRows->more()) {
+            auto [key, project] = partition.buildRows->next();
+            _ht.emplace(std::move(key), std::move(project));
+        }
+        partition.buildRows->closeSource();
+
+        partition.probeRows->openSource();
+        return true;
+    }
+
+    return false;
+}
+
+void HashJoinStage::resetInnerAccessors() {
+    for (size_t idx = 0; idx < _outInnerKeyAccessors.size(); ++idx) {
+        auto [tag, val] = _probeKey.getViewOfValue(idx);
+        _outInnerKeyAccessors[idx]->reset(tag, val);
+    }
+
+    for (size_t idx = 0; idx < _outInnerProjectAccessors.size(); ++idx) {
+        auto [tag, val] = _probeProjects.getViewOfValue(idx);
+        _outInnerProjectAccessors[idx]->reset(tag, val);
+    }
 }
 
 void HashJoinStage::close() {
     _commonStats.closes++;
     _children[1]->close();
+    _ht.clear();
+    _htIt = _ht.end();
+    resetSpilledState();
+}
+
+void HashJoinStage::resetSpilledState() {
+    if (_probingSpilledPartitions && _currentPartition != kNumPartitions) {
+        DESTRUCTOR_GUARD(_partitions[_currentPartition].probeRows->closeSource());
+    }
+
+    for (auto& partition : _partitions) {
+        // The writers and iterators must be destroyed before the files they use are removed.
+        partition.buildWriter.reset();
+        partition.probeWriter.reset();
+        partition.buildRows.reset();
+        partition.probeRows.reset();
+
+        for (auto fileName : {&partition.buildFileName, &partition.probeFileName}) {
+            if (!fileName->empty()) {
+                DESTRUCTOR_GUARD(boost::filesystem::remove(*fileName));
+                fileName->clear();
+            }
+        }
+
+        partition.memoryUsageBytes = 0;
+        partition.spilled = false;
+    }
+
+    _memoryUsageBytes = 0;
+    _hasSpilledPartitions = false;
+    _probingSpilledPartitions = false;
+    _currentPartition = kNumPartitions;
+    _spilledProbeRow = {0, 0};
 }
 
 std::unique_ptr<PlanStageStats> HashJoinStage::getStats() const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashJoinStats>(_specificStats);
     ret->children.emplace_back(_children[0]->getStats());
     ret->children.emplace_back(_children[1]->getStats());
     return ret;
 }
 
 const SpecificStats* HashJoinStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 std::vector<DebugPrinter::Block> HashJoinStage::debugPrint() const {
@@ -29,12 +29,38 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/sbe/values/row_hash_table.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 
+namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+template <typename Key, typename Value>
+class SortedFileWriter;
+}  // namespace mongo
+
 namespace mongo::sbe {
+/**
+ * Joins the rows of the 'inner' side with the rows of the 'outer' side whose 'outerCond' values are
+ * equal to the 'innerCond' values, by building a hash table from the outer side and probing it with
+ * the inner side.
+ *
+ * When 'memoryLimit' is finite and the hash table grows over the limit, the join either fails, or,
+ * if 'allowDiskUse' is true, switches to a hybrid hash join: the build rows are split into a fixed
+ * number of partitions by the hash of their key, and the largest in-memory partitions are written
+ * to temporary files until the table fits in memory again. Inner rows whose key falls in a spilled
+ * partition are written to the matching probe file instead of being probed right away. Once the
+ * inner side is exhausted, every spilled partition is loaded back into memory in turn and probed by
+ * its matching spilled inner rows. Spilled partitions are not re-partitioned, so each one on its
+ * own is expected to fit in memory.
+ *
+ * When disk use is allowed, only the 'innerCond' and 'innerProjects' slots are available from the
+ * inner side, since these are the only values preserved for the inner rows written to disk.
+ */
 class HashJoinStage final : public PlanStage {
 public:
     HashJoinStage(std::unique_ptr<PlanStage> outer,
@@ -43,8 +69,12 @@ public:
                   value::SlotVector outerProjects,
                   value::SlotVector innerCond,
                   value::SlotVector innerProjects,
+                  bool allowDiskUse,
+                  size_t memoryLimit,
                   PlanNodeId planNodeId);
 
+    ~HashJoinStage();
+
     std::unique_ptr<PlanStage> clone() const final;
 
     void prepare(CompileCtx& ctx) final;
@@ -58,17 +88,80 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
 private:
-    using TableType = std::unordered_multimap<value::MaterializedRow,  // NOLINT
-                                              value::MaterializedRow,
-                                              value::MaterializedRowHasher>;
+    using TableType = value::RowHashTable;
 
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashProjectAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    using SpilledRow = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpillWriter = SortedFileWriter<value::MaterializedRow, value::MaterializedRow>;
+    using SpillIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+
+    static constexpr size_t kNumPartitions = 8;
+
+    /**
+     * A subset of the build rows, and of the probe rows whose keys hash to the same partition.
+     * Once spilled, the partition's build rows are written through 'buildWriter', and read back
+     * through 'buildRows' after the build side is done. The probe rows are handled likewise.
+     */
+    struct Partition {
+        size_t memoryUsageBytes{0};
+        bool spilled{false};
+        std::string buildFileName;
+        std::string probeFileName;
+        std::unique_ptr<SpillWriter> buildWriter;
+        std::unique_ptr<SpillWriter> probeWriter;
+        std::unique_ptr<SpillIterator> buildRows;
+        std::unique_ptr<SpillIterator> probeRows;
+    };
+
+    bool isMemoryTracked() const {
+        return _specificStats.maxMemoryUsageBytes != std::numeric_limits<size_t>::max();
+    }
+
+    static size_t partitionOf(const value::MaterializedRow& key);
+
+    /**
+     * Spills in-memory partitions, largest first, until the hash table fits in the memory limit.
+     */
+    void spillPartitions();
+
+    /**
+     * Moves all rows of the given partition from the hash table to its build file.
+     */
+    void spillPartition(size_t partition);
+
+    void writeSpilledRow(std::unique_ptr<SpillWriter>& writer,
+                         std::string& fileName,
+                         const value::MaterializedRow& key,
+                         const value::MaterializedRow& row);
+
+    /**
+     * Advances to the next row of the probe side, which is either a row of the inner child or a
+     * row read back from a probe file, and sets '_probeKey' accordingly. Returns false once all the
+     * probe rows are exhausted.
+     */
+    bool fetchNextProbeRow();
+
+    /**
+     * Loads the build rows of the next spilled partition into the hash table and positions
+     * '_currentPartition' on it. Returns false when there is no spilled partition left.
+     */
+    bool loadNextSpilledPartition();
+
+    /**
+     * Points the accessors for the inner side slots at the current probe row.
+     */
+    void resetInnerAccessors();
+
+    void resetSpilledState();
+
     const value::SlotVector _outerCond;
     const value::SlotVector _outerProjects;
     const value::SlotVector _innerCond;
     const value::SlotVector _innerProjects;
+    const bool _allowDiskUse;
+    HashJoinStats _specificStats;
 
     // All defined values from the outer side (i.e. they come from the hash table).
     value::SlotAccessorMap _outOuterAccessors;
@@ -88,12 +181,37 @@ private:
     // Accessors of input codition values (keys) that are being inserted into the hash table.
     std::vector<value::SlotAccessor*> _inInnerKeyAccessors;
 
+    // Accessors of the inner projection values, which are preserved for spilled probe rows.
+    std::vector<value::SlotAccessor*> _inInnerProjectAccessors;
+
+    // When disk use is allowed, the inner side slots are read through these accessors so that they
+    // can be pointed at either the current row of the inner child or a row read back from disk.
+    value::SlotMap<std::unique_ptr<value::ViewOfValueAccessor>> _outInnerAccessors;
+    std::vector<value::ViewOfValueAccessor*> _outInnerKeyAccessors;
+    std::vector<value::ViewOfValueAccessor*> _outInnerProjectAccessors;
+
     // Key used to probe inside the hash table.
     value::MaterializedRow _probeKey;
 
+    // The inner projection values of the current probe row.
+    value::MaterializedRow _probeProjects;
+
     TableType _ht;
     TableType::iterator _htIt;
-    TableType::iterator _htItEnd;
+
+    // Approximate number of bytes held by the hash table. Only maintained when 'memoryLimit' is
+    // finite.
+    size_t _memoryUsageBytes{0};
+
+    std::array<Partition, kNumPartitions> _partitions;
+    bool _hasSpilledPartitions{false};
+
+    // Whether the inner child is exhausted and the probe rows now come from the probe files.
+    bool _probingSpilledPartitions{false};
+    size_t _currentPartition{kNumPartitions};
+
+    // The spilled probe row currently being joined.
+    SpilledRow _spilledProbeRow;
 
     vm::ByteCode _bytecode;
 
@@ -159,6 +159,12 @@ void IndexScanStage::doAttachFromOperationContext(OperationContext* opCtx) {
     }
 }
 
+void IndexScanStage::doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) {
+    if (_tracker) {
+        _tracker = tracker;
+    }
+}
+
 void IndexScanStage::open(bool reOpen) {
     _commonStats.opens++;
 
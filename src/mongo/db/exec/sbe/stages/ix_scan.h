@@ -90,6 +90,7 @@ protected:
     void doRestoreState() override;
     void doDetachFromOperationContext() override;
     void doAttachFromOperationContext(OperationContext* opCtx) override;
+    void doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) override;
 
 private:
     const NamespaceStringOrUUID _name;
@@ -52,6 +52,9 @@ size_t calculateNumberOfReads(const PlanStageStats* root) {
         } else if (auto indexScanStats =
                        dynamic_cast<sbe::IndexScanStats*>(stats->specific.get())) {
             numReads += indexScanStats->numReads;
+        } else if (auto columnScanStats =
+                       dynamic_cast<sbe::ColumnScanStats*>(stats->specific.get())) {
+            numReads += columnScanStats->keysExamined;
         }
 
         for (auto&& child : stats->children) {
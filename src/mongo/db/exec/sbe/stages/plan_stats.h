@@ -94,6 +94,23 @@ struct IndexScanStats final : public SpecificStats {
     size_t numReads{0};
 };
 
+struct ColumnScanStats final : public SpecificStats {
+    SpecificStats* clone() const final {
+        return new ColumnScanStats(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& stats) const final {
+        stats.totalKeysExamined += keysExamined;
+    }
+
+    size_t keysExamined{0};
+    size_t docsReturned{0};
+};
+
 struct FilterStats final : public SpecificStats {
     SpecificStats* clone() const final {
         return new FilterStats(*this);
@@ -132,6 +149,56 @@ struct UniqueStats : public SpecificStats {
     unsigned int dupsDropped = 0;
 };
 
+struct HashAggStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        return new HashAggStats(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& summary) const final {
+        if (spills > 0) {
+            summary.usedDisk = true;
+        }
+    }
+
+    // The maximum number of bytes of memory the hash table may use before it is spilled to disk.
+    uint64_t maxMemoryUsageBytes = 0u;
+
+    // The number of times the hash table was spilled to disk, and the total number of groups
+    // written out by those spills.
+    uint64_t spills = 0u;
+    uint64_t spilledRecords = 0u;
+};
+
+struct HashJoinStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        return new HashJoinStats(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& summary) const final {
+        if (spilledPartitions > 0) {
+            summary.usedDisk = true;
+        }
+    }
+
+    // The maximum number of bytes of memory the hash table may use before its partitions are
+    // spilled to disk.
+    uint64_t maxMemoryUsageBytes = 0u;
+
+    // The number of partitions written to disk, and the total number of build (outer) and probe
+    // (inner) rows written to them.
+    uint64_t spilledPartitions = 0u;
+    uint64_t spilledBuildRecords = 0u;
+    uint64_t spilledProbeRecords = 0u;
+};
+
 /**
  * Calculates the total number of physical reads in the given plan stats tree. If a stage can do
  * a physical read (e.g. COLLSCAN or IXSCAN), then its 'numReads' stats is added to the total.
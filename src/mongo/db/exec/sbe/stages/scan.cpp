@@ -54,6 +54,7 @@ ScanStage::ScanStage(const NamespaceStringOrUUID& name,
       _recordIdSlot(recordIdSlot),
       _fields(std::move(fields)),
       _vars(std::move(vars)),
+      _fieldScanner(_fields),
       _seekKeySlot(seekKeySlot),
       _forward(forward),
       _tracker(tracker),
@@ -91,7 +92,9 @@ void ScanStage::prepare(CompileCtx& ctx) {
         uassert(4822814, str::stream() << "duplicate field: " << _fields[idx], inserted);
         auto [itRename, insertedRename] = _varAccessors.emplace(_vars[idx], it->second.get());
         uassert(4822815, str::stream() << "duplicate field: " << _vars[idx], insertedRename);
+        _fieldAccessorsByIndex.push_back(it->second.get());
     }
+    _fieldElements.resize(_fields.size());
 
     if (_seekKeySlot) {
         _seekKeyAccessor = ctx.getAccessor(*_seekKeySlot);
@@ -157,6 +160,12 @@ void ScanStage::doAttachFromOperationContext(OperationContext* opCtx) {
     }
 }
 
+void ScanStage::doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) {
+    if (_tracker) {
+        _tracker = tracker;
+    }
+}
+
 void ScanStage::open(bool reOpen) {
     _commonStats.opens++;
     invariant(_opCtx);
@@ -226,28 +235,17 @@ PlanState ScanStage::getNext() {
     }
 
     if (!_fieldAccessors.empty()) {
-        auto fieldsToMatch = _fieldAccessors.size();
         auto rawBson = nextRecord->data.data();
-        auto be = rawBson + 4;
         auto end = rawBson + ConstDataView(rawBson).read<LittleEndian<uint32_t>>();
-        for (auto& [name, accessor] : _fieldAccessors) {
-            accessor->reset();
-        }
-        while (*be != 0) {
-            auto sv = bson::fieldNameView(be);
-            if (auto it = _fieldAccessors.find(sv); it != _fieldAccessors.end()) {
+        _fieldScanner.scan(rawBson, _fieldElements.data());
+        for (size_t idx = 0; idx < _fieldElements.size(); ++idx) {
+            if (auto elem = _fieldElements[idx]) {
                 // Found the field so convert it to Value.
-                auto [tag, val] = bson::convertFrom(true, be, end, sv.size());
-
-                it->second->reset(tag, val);
-
-                if ((--fieldsToMatch) == 0) {
-                    // No need to scan any further so bail out early.
-                    break;
-                }
+                auto [tag, val] = bson::convertFrom(true, elem, end, _fields[idx].size());
+                _fieldAccessorsByIndex[idx]->reset(tag, val);
+            } else {
+                _fieldAccessorsByIndex[idx]->reset();
             }
-
-            be = bson::advance(be, sv.size());
         }
     }
 
@@ -325,7 +323,8 @@ ParallelScanStage::ParallelScanStage(const NamespaceStringOrUUID& name,
       _recordSlot(recordSlot),
       _recordIdSlot(recordIdSlot),
       _fields(std::move(fields)),
-      _vars(std::move(vars)) {
+      _vars(std::move(vars)),
+      _fieldScanner(_fields) {
     invariant(_fields.size() == _vars.size());
 
     _state = std::make_shared<ParallelState>();
@@ -345,6 +344,7 @@ ParallelScanStage::ParallelScanStage(const std::shared_ptr<ParallelState>& state
       _recordIdSlot(recordIdSlot),
       _fields(std::move(fields)),
       _vars(std::move(vars)),
+      _fieldScanner(_fields),
       _state(state) {
     invariant(_fields.size() == _vars.size());
 }
@@ -375,7 +375,9 @@ void ParallelScanStage::prepare(CompileCtx& ctx) {
         uassert(4822816, str::stream() << "duplicate field: " << _fields[idx], inserted);
         auto [itRename, insertedRename] = _varAccessors.emplace(_vars[idx], it->second.get());
         uassert(4822817, str::stream() << "duplicate field: " << _vars[idx], insertedRename);
+        _fieldAccessorsByIndex.push_back(it->second.get());
     }
+    _fieldElements.resize(_fields.size());
 }
 
 value::SlotAccessor* ParallelScanStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
@@ -533,28 +535,17 @@ PlanState ParallelScanStage::getNext() {
 
 
     if (!_fieldAccessors.empty()) {
-        auto fieldsToMatch = _fieldAccessors.size();
         auto rawBson = nextRecord->data.data();
-        auto be = rawBson + 4;
         auto end = rawBson + ConstDataView(rawBson).read<LittleEndian<uint32_t>>();
-        for (auto& [name, accessor] : _fieldAccessors) {
-            accessor->reset();
-        }
-        while (*be != 0) {
-            auto sv = bson::fieldNameView(be);
-            if (auto it = _fieldAccessors.find(sv); it != _fieldAccessors.end()) {
+        _fieldScanner.scan(rawBson, _fieldElements.data());
+        for (size_t idx = 0; idx < _fieldElements.size(); ++idx) {
+            if (auto elem = _fieldElements[idx]) {
                 // Found the field so convert it to Value.
-                auto [tag, val] = bson::convertFrom(true, be, end, sv.size());
-
-                it->second->reset(tag, val);
-
-                if ((--fieldsToMatch) == 0) {
-                    // No need to scan any further so bail out early.
-                    break;
-                }
+                auto [tag, val] = bson::convertFrom(true, elem, end, _fields[idx].size());
+                _fieldAccessorsByIndex[idx]->reset(tag, val);
+            } else {
+                _fieldAccessorsByIndex[idx]->reset();
             }
-
-            be = bson::advance(be, sv.size());
         }
     }
 
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/bson/bson_field_scan.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/values/bson.h"
@@ -70,6 +71,7 @@ protected:
     void doRestoreState() override;
     void doDetachFromOperationContext() override;
     void doAttachFromOperationContext(OperationContext* opCtx) override;
+    void doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) override;
 
 private:
     const NamespaceStringOrUUID _name;
@@ -77,6 +79,11 @@ private:
     const boost::optional<value::SlotId> _recordIdSlot;
     const std::vector<std::string> _fields;
     const value::SlotVector _vars;
+
+    // Locates '_fields' within each record in a single pass. A field which occurs more than once
+    // in a record resolves to its first occurrence, as with BSONObj::getField().
+    const BSONFieldScanner _fieldScanner;
+
     const boost::optional<value::SlotId> _seekKeySlot;
     const bool _forward;
 
@@ -91,6 +98,11 @@ private:
 
     value::FieldAccessorMap _fieldAccessors;
     value::SlotAccessorMap _varAccessors;
+
+    // The accessors of '_fields' and the elements found for them in the current record, both in
+    // the same order as '_fields'.
+    std::vector<value::ViewOfValueAccessor*> _fieldAccessorsByIndex;
+    std::vector<const char*> _fieldElements;
     value::SlotAccessor* _seekKeyAccessor{nullptr};
 
     bool _open{false};
@@ -165,6 +177,10 @@ private:
     const std::vector<std::string> _fields;
     const value::SlotVector _vars;
 
+    // Locates '_fields' within each record in a single pass. A field which occurs more than once
+    // in a record resolves to its first occurrence, as with BSONObj::getField().
+    const BSONFieldScanner _fieldScanner;
+
     std::shared_ptr<ParallelState> _state;
 
     std::unique_ptr<value::ViewOfValueAccessor> _recordAccessor;
@@ -173,6 +189,11 @@ private:
     value::FieldAccessorMap _fieldAccessors;
     value::SlotAccessorMap _varAccessors;
 
+    // The accessors of '_fields' and the elements found for them in the current record, both in
+    // the same order as '_fields'.
+    std::vector<value::ViewOfValueAccessor*> _fieldAccessorsByIndex;
+    std::vector<const char*> _fieldElements;
+
     size_t _currentRange{std::numeric_limits<std::size_t>::max()};
     Range _range;
 
@@ -124,6 +124,7 @@ void SortStage::makeSorter() {
     opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
     opts.maxMemoryUsageBytes = _specificStats.maxMemoryUsageBytes;
     opts.extSortAllowed = _allowDiskUse;
+    opts.useQueryMemoryReservation = true;
     opts.limit =
         _specificStats.limit != std::numeric_limits<size_t>::max() ? _specificStats.limit : 0;
 
@@ -155,42 +156,53 @@ void SortStage::open(bool reOpen) {
 
     makeSorter();
 
-    while (_children[0]->getNext() == PlanState::ADVANCED) {
-        value::MaterializedRow keys{_inKeyAccessors.size()};
-        value::MaterializedRow vals{_inValueAccessors.size()};
-
-        size_t idx = 0;
-        for (auto accesor : _inKeyAccessors) {
-            auto [tag, val] = accesor->copyOrMoveValue();
-            keys.reset(idx++, true, tag, val);
-        }
+    // The input is read in batches, unless a trial run is tracked, which has to be checked after
+    // every row so that no more rows than needed are read from the input.
+    std::vector<value::SlotAccessor*> inputAccessors{_inKeyAccessors};
+    inputAccessors.insert(inputAccessors.end(), _inValueAccessors.begin(), _inValueAccessors.end());
+    const size_t batchSize = _tracker ? 1 : kInputBatchSize;
+    std::vector<value::MaterializedRow> batch;
+
+    while (_children[0]->getNextBatch(inputAccessors, batchSize, batch)) {
+        for (auto& row : batch) {
+            value::MaterializedRow keys{_inKeyAccessors.size()};
+            value::MaterializedRow vals{_inValueAccessors.size()};
+
+            size_t idx = 0;
+            for (; idx < keys.size(); ++idx) {
+                auto [tag, val] = row.copyOrMoveValue(idx);
+                keys.reset(idx, true, tag, val);
+            }
 
-        idx = 0;
-        for (auto accesor : _inValueAccessors) {
-            auto [tag, val] = accesor->copyOrMoveValue();
-            vals.reset(idx++, true, tag, val);
-        }
+            for (; idx < row.size(); ++idx) {
+                auto [tag, val] = row.copyOrMoveValue(idx);
+                vals.reset(idx - keys.size(), true, tag, val);
+            }
 
-        // TODO SERVER-51815: count total mem usage for specificStats.
-        _sorter->emplace(std::move(keys), std::move(vals));
-
-        if (_tracker && _tracker->trackProgress<TrialRunProgressTracker::kNumResults>(1)) {
-            // If we either hit the maximum number of document to return during the trial run, or
-            // if we've performed enough physical reads, stop populating the sort heap and bail out
-            // from the trial run by raising a special exception to signal a runtime planner that
-            // this candidate plan has completed its trial run early. Note that the sort stage is a
-            // blocking operation and until all documents are loaded from the child stage and
-            // sorted, the control is not returned to the runtime planner, so an raising this
-            // special is mechanism to stop the trial run without affecting the plan stats of the
-            // higher level stages.
-            _tracker = nullptr;
-            _children[0]->close();
-            uasserted(ErrorCodes::QueryTrialRunCompleted, "Trial run early exit");
+            // TODO SERVER-51815: count total mem usage for specificStats.
+            _sorter->emplace(std::move(keys), std::move(vals));
+
+            if (_tracker && _tracker->trackProgress<TrialRunProgressTracker::kNumResults>(1)) {
+                // If we either hit the maximum number of document to return during the trial run,
+                // or if we've performed enough physical reads, stop populating the sort heap and
+                // bail out from the trial run by raising a special exception to signal a runtime
+                // planner that this candidate plan has completed its trial run early. Note that
+                // the sort stage is a blocking operation and until all documents are loaded from
+                // the child stage and sorted, the control is not returned to the runtime planner,
+                // so an raising this special is mechanism to stop the trial run without affecting
+                // the plan stats of the higher level stages.
+                _tracker = nullptr;
+                _children[0]->close();
+                uasserted(ErrorCodes::QueryTrialRunCompleted, "Trial run early exit");
+            }
         }
+        batch.clear();
     }
 
     _mergeIt.reset(_sorter->done());
     _specificStats.spills += _sorter->numSpills();
+    _specificStats.spilledDataSizeBytes += _sorter->spilledDataSize();
+    _specificStats.spilledDataStorageSizeBytes += _sorter->spilledDataStorageSize();
 
     _children[0]->close();
 }
@@ -212,6 +224,12 @@ void SortStage::close() {
     _sorter.reset();
 }
 
+void SortStage::doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) {
+    if (_tracker) {
+        _tracker = tracker;
+    }
+}
+
 std::unique_ptr<PlanStageStats> SortStage::getStats() const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
     ret->specific = std::make_unique<SortStats>(_specificStats);
@@ -66,7 +66,13 @@ public:
     const SpecificStats* getSpecificStats() const final;
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
+protected:
+    void doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) final;
+
 private:
+    // The number of rows read from the input at once while the sorter is populated.
+    static constexpr size_t kInputBatchSize = 128;
+
     void makeSorter();
 
     using SorterIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
@@ -34,6 +34,7 @@
 #include "mongo/db/exec/sbe/values/slot.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/exec/scoped_timer.h"
+#include "mongo/db/exec/trial_run_progress_tracker.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/plan_yield_policy.h"
 #include "mongo/util/str.h"
@@ -257,7 +258,7 @@ public:
     }
 
 protected:
-    PlanYieldPolicy* const _yieldPolicy{nullptr};
+    PlanYieldPolicy* _yieldPolicy{nullptr};
 
 private:
     static const int kInterruptCheckPeriod = 128;
@@ -314,11 +315,67 @@ public:
      */
     virtual PlanState getNext() = 0;
 
+    /**
+     * Moves forward by up to 'maxRows' positions at once. For every position, a row holding owned
+     * copies of the values of 'accessors' is appended to 'rows', where the accessors must have been
+     * obtained from this stage by getAccessor(). Returns the number of rows appended, which is zero
+     * only once EOF is reached. The accessors of this stage are not positioned on any of the rows
+     * in the batch.
+     *
+     * The default implementation calls getNext() for every row. Stages which can produce a batch
+     * of rows more cheaply than row by row may override it.
+     */
+    virtual size_t getNextBatch(const std::vector<value::SlotAccessor*>& accessors,
+                                size_t maxRows,
+                                std::vector<value::MaterializedRow>& rows) {
+        size_t count = 0;
+        while (count < maxRows && getNext() == PlanState::ADVANCED) {
+            value::MaterializedRow row{accessors.size()};
+            for (size_t idx = 0; idx < accessors.size(); ++idx) {
+                auto [tag, val] = accessors[idx]->copyOrMoveValue();
+                row.reset(idx, true, tag, val);
+            }
+            rows.emplace_back(std::move(row));
+            ++count;
+        }
+        return count;
+    }
+
     /**
      * The mirror method to open(). It releases any acquired resources.
      */
     virtual void close() = 0;
 
+    /**
+     * Replaces the yield policy of every stage in this tree which was built with yielding enabled.
+     * Must be called before prepare() on a tree cloned from a plan built for a different
+     * operation, as clone() preserves the yield policy of the original stages.
+     */
+    void attachNewYieldPolicy(PlanYieldPolicy* yieldPolicy) {
+        for (auto&& child : _children) {
+            child->attachNewYieldPolicy(yieldPolicy);
+        }
+
+        if (_yieldPolicy) {
+            _yieldPolicy = yieldPolicy;
+        }
+    }
+
+    /**
+     * Replaces the TrialRunProgressTracker of every stage in this tree which was built to report
+     * the progress of a trial run. Like attachNewYieldPolicy(), this is used to reuse a tree cloned
+     * from a plan which was built for a different operation.
+     *
+     * Propagates to all children, then calls doAttachToTrialRunTracker().
+     */
+    void attachToTrialRunTracker(TrialRunProgressTracker* tracker) {
+        for (auto&& child : _children) {
+            child->attachToTrialRunTracker(tracker);
+        }
+
+        doAttachToTrialRunTracker(tracker);
+    }
+
     virtual std::vector<DebugPrinter::Block> debugPrint() const {
         auto stats = getCommonStats();
         std::string str = str::stream() << '[' << stats->nodeId << "] " << stats->stageType;
@@ -335,6 +392,7 @@ protected:
     virtual void doRestoreState() {}
     virtual void doDetachFromOperationContext() {}
     virtual void doAttachFromOperationContext(OperationContext* opCtx) {}
+    virtual void doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) {}
 
     std::vector<std::unique_ptr<PlanStage>> _children;
 };
@@ -0,0 +1,274 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/exec/sbe/values/slot.h"
+
+namespace mongo::sbe::value {
+/**
+ * An open-addressing hash table keyed by MaterializedRow, purpose-built for the SBE hash stages.
+ *
+ * The (key, value) entries are stored contiguously in insertion order, so building the table costs
+ * no per-entry node allocation and iterating over it is a sequential scan. The bucket array is
+ * probed linearly and holds, next to the index of the entry, the full hash of its key. This means
+ * that most mismatching buckets are skipped without touching the entry, and growing the table
+ * only has to redistribute the buckets without re-hashing any key or moving any entry.
+ *
+ * Keys may be inserted either uniquely via 'try_emplace()', or repeatedly via 'emplace()'. Every
+ * entry added by 'emplace()' under an already present key is chained after the previous one, in
+ * insertion order, and can be reached from the first one through 'nextDuplicate()'.
+ *
+ * Iterators are invalidated by any insertion.
+ */
+class RowHashTable {
+public:
+    using value_type = std::pair<MaterializedRow, MaterializedRow>;
+    using iterator = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    iterator begin() {
+        return _entries.begin();
+    }
+
+    iterator end() {
+        return _entries.end();
+    }
+
+    const_iterator begin() const {
+        return _entries.begin();
+    }
+
+    const_iterator end() const {
+        return _entries.end();
+    }
+
+    size_t size() const {
+        return _entries.size();
+    }
+
+    bool empty() const {
+        return _entries.empty();
+    }
+
+    /**
+     * Removes all entries, but keeps hold of the already allocated memory.
+     */
+    void clear() {
+        _entries.clear();
+        _chains.clear();
+        std::fill(_buckets.begin(), _buckets.end(), Bucket{});
+    }
+
+    /**
+     * Prepares the table to hold at least 'count' entries without growing.
+     */
+    void reserve(size_t count) {
+        _entries.reserve(count);
+        _chains.reserve(count);
+        if (count > maxEntries()) {
+            rehash(bucketCountFor(count));
+        }
+    }
+
+    /**
+     * Inserts ('key', 'value') unless an entry with an equal key is already present. Returns the
+     * position of the entry with the given key, and whether the insertion took place. Nothing is
+     * moved out of 'key' or 'value' when an entry with an equal key already exists.
+     */
+    template <typename KeyType, typename ValueType>
+    std::pair<iterator, bool> try_emplace(KeyType&& key, ValueType&& value) {
+        const auto hash = hashOf(key);
+        auto bucket = findBucket(key, hash);
+        if (_buckets[bucket].isOccupied()) {
+            return {_entries.begin() + _buckets[bucket].entry, false};
+        }
+
+        return {insertAt(bucket,
+                         hash,
+                         std::forward<KeyType>(key),
+                         std::forward<ValueType>(value)),
+                true};
+    }
+
+    /**
+     * Unconditionally inserts ('key', 'value'). If an entry with an equal key is already present,
+     * the new entry is appended to its chain of duplicates.
+     */
+    iterator emplace(MaterializedRow key, MaterializedRow value) {
+        const auto hash = hashOf(key);
+        auto bucket = findBucket(key, hash);
+        if (!_buckets[bucket].isOccupied()) {
+            return insertAt(bucket, hash, std::move(key), std::move(value));
+        }
+
+        const auto head = _buckets[bucket].entry;
+        const auto entry = _entries.size();
+        _entries.emplace_back(std::move(key), std::move(value));
+        _chains.push_back(Chain{});
+        _chains[_chains[head].last].next = entry;
+        _chains[head].last = entry;
+
+        return _entries.begin() + entry;
+    }
+
+    /**
+     * Returns the first entry inserted with a key equal to 'key', or end() if there is none.
+     */
+    iterator find(const MaterializedRow& key) {
+        if (_entries.empty()) {
+            return end();
+        }
+
+        auto bucket = findBucket(key, hashOf(key));
+        return _buckets[bucket].isOccupied() ? _entries.begin() + _buckets[bucket].entry : end();
+    }
+
+    /**
+     * Returns the entry inserted after 'it' with an equal key, or end() if 'it' is the last one.
+     */
+    iterator nextDuplicate(iterator it) {
+        const auto next = _chains[it - _entries.begin()].next;
+        return next != kNoEntry ? _entries.begin() + next : end();
+    }
+
+private:
+    static constexpr size_t kNoEntry = std::numeric_limits<size_t>::max();
+    static constexpr size_t kMinBuckets = 16;
+
+    struct Bucket {
+        bool isOccupied() const {
+            return entry != kNoEntry;
+        }
+
+        size_t hash{0};
+        size_t entry{kNoEntry};
+    };
+
+    /**
+     * Links between the entries sharing a key. 'last' is only maintained for the first entry of
+     * every chain.
+     */
+    struct Chain {
+        size_t next{kNoEntry};
+        size_t last{kNoEntry};
+    };
+
+    /**
+     * The row hashes are combined with a simple polynomial, so they are further scrambled before
+     * their high bits are used as the bucket position.
+     */
+    static size_t hashOf(const MaterializedRow& key) {
+        return MaterializedRowHasher{}(key) * 0x9E3779B97F4A7C15ULL;
+    }
+
+    static size_t bucketCountFor(size_t count) {
+        size_t buckets = kMinBuckets;
+        while (buckets / 2 < count) {
+            buckets *= 2;
+        }
+        return buckets;
+    }
+
+    // The table grows once it is more than half full.
+    size_t maxEntries() const {
+        return _buckets.size() / 2;
+    }
+
+    size_t position(size_t hash) const {
+        return hash >> _shift;
+    }
+
+    /**
+     * Returns either the bucket pointing at the first entry with the given key, or the empty bucket
+     * where such an entry would be inserted.
+     */
+    size_t findBucket(const MaterializedRow& key, size_t hash) {
+        if (_buckets.empty()) {
+            rehash(kMinBuckets);
+        }
+
+        const auto mask = _buckets.size() - 1;
+        for (auto idx = position(hash);; idx = (idx + 1) & mask) {
+            auto& bucket = _buckets[idx];
+            if (!bucket.isOccupied() ||
+                (bucket.hash == hash && _entries[bucket.entry].first == key)) {
+                return idx;
+            }
+        }
+    }
+
+    template <typename KeyType, typename ValueType>
+    iterator insertAt(size_t bucket, size_t hash, KeyType&& key, ValueType&& value) {
+        const auto entry = _entries.size();
+        _entries.emplace_back(std::forward<KeyType>(key), std::forward<ValueType>(value));
+        _chains.push_back(Chain{kNoEntry, entry});
+        _buckets[bucket] = Bucket{hash, entry};
+
+        if (_entries.size() > maxEntries()) {
+            rehash(_buckets.size() * 2);
+        }
+
+        return _entries.begin() + entry;
+    }
+
+    void rehash(size_t bucketCount) {
+        std::vector<Bucket> buckets(bucketCount);
+        _buckets.swap(buckets);
+
+        _shift = 64;
+        for (auto count = bucketCount; count > 1; count /= 2) {
+            --_shift;
+        }
+
+        const auto mask = _buckets.size() - 1;
+        for (auto& bucket : buckets) {
+            if (bucket.isOccupied()) {
+                auto idx = position(bucket.hash);
+                while (_buckets[idx].isOccupied()) {
+                    idx = (idx + 1) & mask;
+                }
+                _buckets[idx] = bucket;
+            }
+        }
+    }
+
+    std::vector<value_type> _entries;
+    std::vector<Chain> _chains;
+    std::vector<Bucket> _buckets;
+
+    // The number of low bits to drop from a hash to obtain the position of its bucket.
+    size_t _shift{64};
+};
+}  // namespace mongo::sbe::value
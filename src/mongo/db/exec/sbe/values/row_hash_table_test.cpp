@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for sbe::value::RowHashTable.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/values/row_hash_table.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::sbe::value {
+namespace {
+MaterializedRow makeRow(int64_t first, int64_t second = 0) {
+    MaterializedRow row{2};
+    row.reset(0, false, TypeTags::NumberInt64, bitcastFrom<int64_t>(first));
+    row.reset(1, false, TypeTags::NumberInt64, bitcastFrom<int64_t>(second));
+    return row;
+}
+
+int64_t firstOf(const MaterializedRow& row) {
+    return bitcastTo<int64_t>(row.getViewOfValue(0).second);
+}
+
+TEST(RowHashTableTest, TryEmplaceInsertsEachKeyOnce) {
+    RowHashTable table;
+    for (int64_t i = 0; i < 1000; ++i) {
+        auto [it, inserted] = table.try_emplace(makeRow(i % 100, 1), makeRow(i));
+        ASSERT_EQ(inserted, i < 100);
+        ASSERT_EQ(firstOf(it->first), i % 100);
+        // The value of an existing entry is left untouched.
+        ASSERT_EQ(firstOf(it->second), i % 100);
+    }
+    ASSERT_EQ(table.size(), 100u);
+
+    // Entries are iterated over in insertion order.
+    int64_t expected = 0;
+    for (auto& [key, value] : table) {
+        ASSERT_EQ(firstOf(key), expected++);
+    }
+
+    ASSERT(table.find(makeRow(42, 1)) != table.end());
+    ASSERT(table.find(makeRow(42, 2)) == table.end());
+    ASSERT(table.find(makeRow(100, 1)) == table.end());
+}
+
+TEST(RowHashTableTest, EmplaceChainsDuplicatesInInsertionOrder) {
+    RowHashTable table;
+    for (int64_t i = 0; i < 3000; ++i) {
+        table.emplace(makeRow(i % 3), makeRow(i));
+    }
+    ASSERT_EQ(table.size(), 3000u);
+
+    for (int64_t key = 0; key < 3; ++key) {
+        int64_t expected = key;
+        for (auto it = table.find(makeRow(key)); it != table.end(); it = table.nextDuplicate(it)) {
+            ASSERT_EQ(firstOf(it->second), expected);
+            expected += 3;
+        }
+        ASSERT_EQ(expected, 3000 + key);
+    }
+}
+
+TEST(RowHashTableTest, ClearAllowsReuse) {
+    RowHashTable table;
+    table.reserve(10);
+    for (int64_t i = 0; i < 10; ++i) {
+        table.emplace(makeRow(i), makeRow(i));
+    }
+    table.clear();
+    ASSERT(table.empty());
+    ASSERT(table.find(makeRow(1)) == table.end());
+
+    auto [it, inserted] = table.try_emplace(makeRow(1), makeRow(2));
+    ASSERT(inserted);
+    ASSERT_EQ(firstOf(it->second), 2);
+    ASSERT(table.nextDuplicate(it) == table.end());
+}
+}  // namespace
+}  // namespace mongo::sbe::value
@@ -362,7 +362,7 @@ public:
         copy(other);
     }
 
-    MaterializedRow(MaterializedRow&& other) {
+    MaterializedRow(MaterializedRow&& other) noexcept {
         swap(*this, other);
     }
 
@@ -505,7 +505,7 @@ BSONType tagToType(TypeTags tag) noexcept {
     }
 }
 
-std::size_t hashValue(TypeTags tag, Value val) noexcept {
+std::size_t hashValueGeneric(TypeTags tag, Value val) noexcept {
     switch (tag) {
         case TypeTags::NumberInt32:
             return absl::Hash<int32_t>{}(bitcastTo<int32_t>(val));
@@ -607,28 +607,10 @@ std::size_t hashValue(TypeTags tag, Value val) noexcept {
     return 0;
 }
 
-
-/**
- * Performs a three-way comparison for any type that has < and == operators. Additionally,
- * guarantees that the result will be exactlty -1, 0, or 1, which is important, because not all
- * comparison functions make that guarantee.
- *
- * The std::string_view::compare(basic_string_view s) function, for example, only promises that it
- * will return a value less than 0 in the case that 'this' is less than 's,' whereas we want to
- * return exactly -1.
- */
-template <typename T>
-int32_t compareHelper(const T lhs, const T rhs) noexcept {
-    return lhs < rhs ? -1 : (lhs == rhs ? 0 : 1);
-}
-
-/*
- * Three ways value comparison (aka spacehip operator).
- */
-std::pair<TypeTags, Value> compareValue(TypeTags lhsTag,
-                                        Value lhsValue,
-                                        TypeTags rhsTag,
-                                        Value rhsValue) {
+std::pair<TypeTags, Value> compareValueGeneric(TypeTags lhsTag,
+                                               Value lhsValue,
+                                               TypeTags rhsTag,
+                                               Value rhsValue) {
     if (isNumber(lhsTag) && isNumber(rhsTag)) {
         switch (getWidestNumericalType(lhsTag, rhsTag)) {
             case TypeTags::NumberInt32: {
@@ -184,7 +184,7 @@ enum class SortDirection : uint8_t { Descending, Ascending };
  */
 void releaseValue(TypeTags tag, Value val) noexcept;
 std::pair<TypeTags, Value> copyValue(TypeTags tag, Value val);
-std::size_t hashValue(TypeTags tag, Value val) noexcept;
+inline std::size_t hashValue(TypeTags tag, Value val) noexcept;
 
 /**
  * Overloads for writing values and tags to stream.
@@ -197,10 +197,22 @@ str::stream& operator<<(str::stream& str, const std::pair<TypeTags, Value>& valu
 /**
  * Three ways value comparison (aka spaceship operator).
  */
-std::pair<TypeTags, Value> compareValue(TypeTags lhsTag,
-                                        Value lhsValue,
-                                        TypeTags rhsTag,
-                                        Value rhsValue);
+inline std::pair<TypeTags, Value> compareValue(TypeTags lhsTag,
+                                               Value lhsValue,
+                                               TypeTags rhsTag,
+                                               Value rhsValue);
+
+/**
+ * The implementations of hashValue() and compareValue() for values of any type. Those functions
+ * are inlined, and handle values of the fixed-size types which make up most sort, group and join
+ * keys themselves, so that loops over such keys avoid a call and the dispatch on each operand's
+ * type.
+ */
+std::size_t hashValueGeneric(TypeTags tag, Value val) noexcept;
+std::pair<TypeTags, Value> compareValueGeneric(TypeTags lhsTag,
+                                               Value lhsValue,
+                                               TypeTags rhsTag,
+                                               Value rhsValue);
 
 bool isNaN(TypeTags tag, Value val);
 
@@ -946,6 +958,59 @@ inline TypeTags getWidestNumericalType(TypeTags lhsTag, TypeTags rhsTag) noexcep
     }
 }
 
+inline std::size_t hashValue(TypeTags tag, Value val) noexcept {
+    switch (tag) {
+        case TypeTags::NumberInt32:
+            return absl::Hash<int32_t>{}(bitcastTo<int32_t>(val));
+        case TypeTags::RecordId:
+        case TypeTags::NumberInt64:
+        case TypeTags::Date:
+            return absl::Hash<int64_t>{}(bitcastTo<int64_t>(val));
+        default:
+            return hashValueGeneric(tag, val);
+    }
+}
+
+/**
+ * Performs a three-way comparison for any type that has < and == operators. Additionally,
+ * guarantees that the result will be exactlty -1, 0, or 1, which is important, because not all
+ * comparison functions make that guarantee.
+ *
+ * The std::string_view::compare(basic_string_view s) function, for example, only promises that it
+ * will return a value less than 0 in the case that 'this' is less than 's,' whereas we want to
+ * return exactly -1.
+ */
+template <typename T>
+int32_t compareHelper(const T lhs, const T rhs) noexcept {
+    return lhs < rhs ? -1 : (lhs == rhs ? 0 : 1);
+}
+
+inline std::pair<TypeTags, Value> compareValue(TypeTags lhsTag,
+                                               Value lhsValue,
+                                               TypeTags rhsTag,
+                                               Value rhsValue) {
+    if (lhsTag == rhsTag) {
+        switch (lhsTag) {
+            case TypeTags::NumberInt32:
+                return {TypeTags::NumberInt32,
+                        bitcastFrom<int32_t>(compareHelper(bitcastTo<int32_t>(lhsValue),
+                                                           bitcastTo<int32_t>(rhsValue)))};
+            case TypeTags::NumberInt64:
+            case TypeTags::Date:
+                return {TypeTags::NumberInt32,
+                        bitcastFrom<int32_t>(compareHelper(bitcastTo<int64_t>(lhsValue),
+                                                           bitcastTo<int64_t>(rhsValue)))};
+            case TypeTags::NumberDouble:
+                return {TypeTags::NumberInt32,
+                        bitcastFrom<int32_t>(compareHelper(bitcastTo<double>(lhsValue),
+                                                           bitcastTo<double>(rhsValue)))};
+            default:
+                break;
+        }
+    }
+    return compareValueGeneric(lhsTag, lhsValue, rhsTag, rhsValue);
+}
+
 
 class ObjectEnumerator {
 public:
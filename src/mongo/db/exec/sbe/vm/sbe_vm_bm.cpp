@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/sbe/values/slot.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+
+namespace mongo::sbe {
+namespace {
+
+constexpr int kNumDocs = 1024;
+
+std::vector<BSONObj> makeDocs() {
+    std::vector<BSONObj> docs;
+    docs.reserve(kNumDocs);
+    for (int i = 0; i < kNumDocs; ++i) {
+        docs.push_back(BSON("x" << "padding"
+                                << "a" << i << "b" << BSON("c" << i)));
+    }
+    return docs;
+}
+
+/**
+ * Runs 'code' as a predicate once per document, with the document bound to 'accessor'.
+ */
+void runPredicateOverDocs(benchmark::State& state,
+                          const vm::CodeFragment& code,
+                          value::ViewOfValueAccessor& accessor) {
+    auto docs = makeDocs();
+    vm::ByteCode vm;
+
+    size_t matched = 0;
+    for (auto _ : state) {
+        for (auto&& doc : docs) {
+            accessor.reset(value::TypeTags::bsonObject,
+                           value::bitcastFrom<const char*>(doc.objdata()));
+            matched += vm.runPredicate(&code);
+        }
+    }
+    benchmark::DoNotOptimize(matched);
+    state.SetItemsProcessed(state.iterations() * kNumDocs);
+}
+
+// getField(doc, "a") > 512, with the field name pushed onto the stack.
+void BM_GetFieldCompare(benchmark::State& state) {
+    value::ViewOfValueAccessor accessor;
+    auto [fieldTag, fieldVal] = value::makeSmallString("a");
+
+    vm::CodeFragment code;
+    code.appendAccessVal(&accessor);
+    code.appendConstVal(fieldTag, fieldVal);
+    code.appendGetField();
+    code.appendConstVal(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(512));
+    code.appendGreater();
+
+    runPredicateOverDocs(state, code, accessor);
+}
+
+// getField(doc, "a") > 512, with the field name encoded in the getField instruction.
+void BM_GetFieldImmCompare(benchmark::State& state) {
+    value::ViewOfValueAccessor accessor;
+    auto [fieldTag, fieldVal] = value::makeSmallString("a");
+
+    vm::CodeFragment code;
+    code.appendAccessVal(&accessor);
+    code.appendGetFieldImm(fieldTag, fieldVal);
+    code.appendConstVal(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(512));
+    code.appendGreater();
+
+    runPredicateOverDocs(state, code, accessor);
+}
+
+// fillEmpty(getField(getField(doc, "b"), "c") == 7, false), the shape of a dotted path equality.
+void BM_DottedPathEqFillEmpty(benchmark::State& state) {
+    value::ViewOfValueAccessor accessor;
+    auto [bTag, bVal] = value::makeSmallString("b");
+    auto [cTag, cVal] = value::makeSmallString("c");
+
+    vm::CodeFragment code;
+    code.appendAccessVal(&accessor);
+    code.appendGetFieldImm(bTag, bVal);
+    code.appendGetFieldImm(cTag, cVal);
+    code.appendConstVal(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(7));
+    code.appendEq();
+    code.appendFillEmptyImm(value::TypeTags::Boolean, value::bitcastFrom<bool>(false));
+
+    runPredicateOverDocs(state, code, accessor);
+}
+
+// A long chain of cheap arithmetic instructions, which is dominated by the dispatch overhead.
+void BM_ArithmeticChain(benchmark::State& state) {
+    value::ViewOfValueAccessor accessor;
+    vm::CodeFragment code;
+    code.appendConstVal(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(0));
+    for (int i = 0; i < 64; ++i) {
+        code.appendConstVal(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(i));
+        code.appendAdd();
+    }
+    code.appendConstVal(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(0));
+    code.appendGreater();
+
+    runPredicateOverDocs(state, code, accessor);
+}
+
+BENCHMARK(BM_GetFieldCompare);
+BENCHMARK(BM_GetFieldImmCompare);
+BENCHMARK(BM_DottedPathEqFillEmpty);
+BENCHMARK(BM_ArithmeticChain);
+
+}  // namespace
+}  // namespace mongo::sbe
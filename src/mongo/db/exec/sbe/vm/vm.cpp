@@ -37,6 +37,7 @@
 #include <boost/algorithm/string.hpp>
 #include <pcre.h>
 
+#include "mongo/bson/bson_field_scan.h"
 #include "mongo/bson/oid.h"
 #include "mongo/db/client.h"
 #include "mongo/db/exec/js_function.h"
@@ -88,8 +89,10 @@ int Instruction::stackOffset[Instruction::Tags::lastInstruction] = {
     -1,  // cmp3w
 
     -1,  // fillEmpty
+    0,   // fillEmptyImm
 
     -1,  // getField
+    0,   // getFieldImm
     -1,  // getElement
 
     -1,  // sum
@@ -271,10 +274,32 @@ void CodeFragment::appendSimpleInstruction(Instruction::Tags tag) {
     offset += value::writeToMemory(offset, i);
 }
 
+void CodeFragment::appendImmInstruction(Instruction::Tags tag,
+                                        value::TypeTags immTag,
+                                        value::Value immVal) {
+    Instruction i;
+    i.tag = tag;
+    adjustStackSimple(i);
+
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(immTag) + sizeof(immVal));
+
+    offset += value::writeToMemory(offset, i);
+    offset += value::writeToMemory(offset, immTag);
+    offset += value::writeToMemory(offset, immVal);
+}
+
+void CodeFragment::appendFillEmptyImm(value::TypeTags tag, value::Value val) {
+    appendImmInstruction(Instruction::fillEmptyImm, tag, val);
+}
+
 void CodeFragment::appendGetField() {
     appendSimpleInstruction(Instruction::getField);
 }
 
+void CodeFragment::appendGetFieldImm(value::TypeTags tag, value::Value val) {
+    appendImmInstruction(Instruction::getFieldImm, tag, val);
+}
+
 void CodeFragment::appendGetElement() {
     appendSimpleInstruction(Instruction::getElement);
 }
@@ -432,18 +457,10 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTa
         return {false, tag, val};
     } else if (objTag == value::TypeTags::bsonObject) {
         auto be = value::bitcastTo<const char*>(objValue);
-        auto end = be + ConstDataView(be).read<LittleEndian<uint32_t>>();
-        // Skip document length.
-        be += 4;
-        while (*be != 0) {
-            auto sv = bson::fieldNameView(be);
-
-            if (sv == fieldStr) {
-                auto [tag, val] = bson::convertFrom(true, be, end, sv.size());
-                return {false, tag, val};
-            }
-
-            be = bson::advance(be, sv.size());
+        if (auto elem = BSONFieldScanner::findField(be, {fieldStr.data(), fieldStr.size()})) {
+            auto end = be + ConstDataView(be).read<LittleEndian<uint32_t>>();
+            auto [tag, val] = bson::convertFrom(true, elem, end, fieldStr.size());
+            return {false, tag, val};
         }
     }
     return {false, value::TypeTags::Nothing, 0};
@@ -2326,7 +2343,91 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::dispatchBuiltin(Builti
     MONGO_UNREACHABLE;
 }
 
+// With threaded dispatch each instruction jumps directly to the code of the next one through a
+// table of label addresses (a GNU extension supported by both gcc and clang), instead of going
+// back through the single indirect branch at the top of the switch statement. This gives the
+// branch predictor a separate history for every instruction, which matters for the short, tight
+// instruction sequences produced for filters and projections. Defining
+// MONGO_SBE_VM_SWITCH_DISPATCH selects the portable switch-based dispatch instead.
+#if defined(__GNUC__) && !defined(MONGO_SBE_VM_SWITCH_DISPATCH)
+#define MONGO_SBE_VM_THREADED_DISPATCH
+#endif
+
+#ifdef MONGO_SBE_VM_THREADED_DISPATCH
+#define INSTRUCTION(name)   \
+    case Instruction::name: \
+    label_##name:
+#define DISPATCH_NEXT()                                    \
+    if (pcPointer == pcEnd) {                              \
+        goto done;                                         \
+    }                                                      \
+    i = value::readFromMemory<Instruction>(pcPointer);     \
+    pcPointer += sizeof(i);                                \
+    goto* kDispatchTable[i.tag]
+#else
+#define INSTRUCTION(name) case Instruction::name:
+#define DISPATCH_NEXT() break
+#endif
+
 std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragment* code) {
+#ifdef MONGO_SBE_VM_THREADED_DISPATCH
+    // Must be kept in the same order as Instruction::Tags.
+    static const void* const kDispatchTable[] = {
+        &&label_pushConstVal,
+        &&label_pushAccessVal,
+        &&label_pushMoveVal,
+        &&label_pushLocalVal,
+        &&label_pop,
+        &&label_swap,
+        &&label_add,
+        &&label_sub,
+        &&label_mul,
+        &&label_div,
+        &&label_idiv,
+        &&label_mod,
+        &&label_negate,
+        &&label_numConvert,
+        &&label_logicNot,
+        &&label_less,
+        &&label_lessEq,
+        &&label_greater,
+        &&label_greaterEq,
+        &&label_eq,
+        &&label_neq,
+        &&label_cmp3w,
+        &&label_fillEmpty,
+        &&label_fillEmptyImm,
+        &&label_getField,
+        &&label_getFieldImm,
+        &&label_getElement,
+        &&label_aggSum,
+        &&label_aggMin,
+        &&label_aggMax,
+        &&label_aggFirst,
+        &&label_aggLast,
+        &&label_exists,
+        &&label_isNull,
+        &&label_isObject,
+        &&label_isArray,
+        &&label_isString,
+        &&label_isNumber,
+        &&label_isBinData,
+        &&label_isDate,
+        &&label_isNaN,
+        &&label_isRecordId,
+        &&label_typeMatch,
+        &&label_function,
+        &&label_functionSmall,
+        &&label_jmp,
+        &&label_jmpTrue,
+        &&label_jmpNothing,
+        &&label_fail,
+    };
+    static_assert(sizeof(kDispatchTable) / sizeof(kDispatchTable[0]) ==
+                      Instruction::Tags::lastInstruction,
+                  "The dispatch table must have an entry for every instruction");
+#endif
+
     auto pcPointer = code->instrs().data();
     auto pcEnd = pcPointer + code->instrs().size();
 
@@ -2337,7 +2438,7 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
             Instruction i = value::readFromMemory<Instruction>(pcPointer);
             pcPointer += sizeof(i);
             switch (i.tag) {
-                case Instruction::pushConstVal: {
+                INSTRUCTION(pushConstVal) {
                     auto tag = value::readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
                     auto val = value::readFromMemory<value::Value>(pcPointer);
@@ -2345,27 +2446,27 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(false, tag, val);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::pushAccessVal: {
+                INSTRUCTION(pushAccessVal) {
                     auto accessor = value::readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->getViewOfValue();
                     pushStack(false, tag, val);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::pushMoveVal: {
+                INSTRUCTION(pushMoveVal) {
                     auto accessor = value::readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->copyOrMoveValue();
                     pushStack(true, tag, val);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::pushLocalVal: {
+                INSTRUCTION(pushLocalVal) {
                     auto stackOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(stackOffset);
 
@@ -2373,9 +2474,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(false, tag, val);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::pop: {
+                INSTRUCTION(pop) {
                     auto [owned, tag, val] = getFromStack(0);
                     popStack();
 
@@ -2383,9 +2484,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(tag, val);
                     }
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::swap: {
+                INSTRUCTION(swap) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(1);
 
@@ -2401,9 +2502,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         invariant(!rhsOwned);
                     }
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::add: {
+                INSTRUCTION(add) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2418,9 +2519,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::sub: {
+                INSTRUCTION(sub) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2435,9 +2536,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::mul: {
+                INSTRUCTION(mul) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2452,9 +2553,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::div: {
+                INSTRUCTION(div) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2469,9 +2570,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::idiv: {
+                INSTRUCTION(idiv) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2486,9 +2587,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::mod: {
+                INSTRUCTION(mod) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2503,9 +2604,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::negate: {
+                INSTRUCTION(negate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultOwned, resultTag, resultVal] = genericSub(
@@ -2517,9 +2618,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(resultTag, resultVal);
                     }
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::numConvert: {
+                INSTRUCTION(numConvert) {
                     auto tag = value::readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
 
@@ -2533,9 +2634,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(lhsTag, lhsVal);
                     }
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::logicNot: {
+                INSTRUCTION(logicNot) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultOwned, resultTag, resultVal] = genericNot(tag, val);
@@ -2545,9 +2646,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::less: {
+                INSTRUCTION(less) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2562,9 +2663,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::lessEq: {
+                INSTRUCTION(lessEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2580,9 +2681,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::greater: {
+                INSTRUCTION(greater) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2598,9 +2699,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::greaterEq: {
+                INSTRUCTION(greaterEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2616,9 +2717,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::eq: {
+                INSTRUCTION(eq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2633,9 +2734,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::neq: {
+                INSTRUCTION(neq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2650,9 +2751,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::cmp3w: {
+                INSTRUCTION(cmp3w) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2667,9 +2768,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::fillEmpty: {
+                INSTRUCTION(fillEmpty) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2685,9 +2786,26 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                             value::releaseValue(rhsTag, rhsVal);
                         }
                     }
-                    break;
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION(fillEmptyImm) {
+                    auto immTag = value::readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(immTag);
+                    auto immVal = value::readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(immVal);
+
+                    auto [owned, tag, val] = getFromStack(0);
+
+                    if (tag == value::TypeTags::Nothing) {
+                        topStack(false, immTag, immVal);
+
+                        if (owned) {
+                            value::releaseValue(tag, val);
+                        }
+                    }
+                    DISPATCH_NEXT();
                 }
-                case Instruction::getField: {
+                INSTRUCTION(getField) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2702,9 +2820,26 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::getElement: {
+                INSTRUCTION(getFieldImm) {
+                    auto immTag = value::readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(immTag);
+                    auto immVal = value::readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(immVal);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [owned, tag, val] = getField(lhsTag, lhsVal, immTag, immVal);
+
+                    topStack(owned, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION(getElement) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2719,9 +2854,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggSum: {
+                INSTRUCTION(aggSum) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2736,9 +2871,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggMin: {
+                INSTRUCTION(aggMin) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2753,9 +2888,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggMax: {
+                INSTRUCTION(aggMax) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2770,9 +2905,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggFirst: {
+                INSTRUCTION(aggFirst) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2787,9 +2922,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggLast: {
+                INSTRUCTION(aggLast) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2804,9 +2939,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::exists: {
+                INSTRUCTION(exists) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     topStack(false,
@@ -2816,9 +2951,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isNull: {
+                INSTRUCTION(isNull) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -2830,9 +2965,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isObject: {
+                INSTRUCTION(isObject) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -2844,9 +2979,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isArray: {
+                INSTRUCTION(isArray) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -2858,9 +2993,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isString: {
+                INSTRUCTION(isString) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -2872,9 +3007,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isNumber: {
+                INSTRUCTION(isNumber) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -2886,9 +3021,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isBinData: {
+                INSTRUCTION(isBinData) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -2900,9 +3035,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isDate: {
+                INSTRUCTION(isDate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -2914,9 +3049,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isNaN: {
+                INSTRUCTION(isNaN) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -2928,9 +3063,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isRecordId: {
+                INSTRUCTION(isRecordId) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -2942,9 +3077,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::typeMatch: {
+                INSTRUCTION(typeMatch) {
                     auto typeMask = value::readFromMemory<uint32_t>(pcPointer);
                     pcPointer += sizeof(typeMask);
 
@@ -2959,10 +3094,10 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::function:
-                case Instruction::functionSmall: {
+                INSTRUCTION(function)
+                INSTRUCTION(functionSmall) {
                     auto f = value::readFromMemory<Builtin>(pcPointer);
                     pcPointer += sizeof(f);
                     ArityType arity{0};
@@ -2986,16 +3121,16 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(owned, tag, val);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::jmp: {
+                INSTRUCTION(jmp) {
                     auto jumpOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
                     pcPointer += jumpOffset;
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::jmpTrue: {
+                INSTRUCTION(jmpTrue) {
                     auto jumpOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -3009,9 +3144,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::jmpNothing: {
+                INSTRUCTION(jmpNothing) {
                     auto jumpOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -3019,9 +3154,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (tag == value::TypeTags::Nothing) {
                         pcPointer += jumpOffset;
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::fail: {
+                INSTRUCTION(fail) {
                     auto [ownedCode, tagCode, valCode] = getFromStack(1);
                     invariant(tagCode == value::TypeTags::NumberInt64);
 
@@ -3034,13 +3169,16 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     uasserted(code, message);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
                 default:
                     MONGO_UNREACHABLE;
             }
         }
     }
+#ifdef MONGO_SBE_VM_THREADED_DISPATCH
+done:
+#endif
     uassert(
         4822801, "The evaluation stack must hold only a single value", _argStackOwned.size() == 1);
 
@@ -3055,6 +3193,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
     return {owned, tag, val};
 }
 
+#undef DISPATCH_NEXT
+#undef INSTRUCTION
+
 bool ByteCode::runPredicate(const CodeFragment* code) {
     auto [owned, tag, val] = run(code);
 
@@ -134,8 +134,12 @@ struct Instruction {
         cmp3w,
 
         fillEmpty,
+        // fillEmpty with the replacement value encoded in the instruction itself.
+        fillEmptyImm,
 
         getField,
+        // getField with the field name encoded in the instruction itself.
+        getFieldImm,
         getElement,
 
         aggSum,
@@ -296,7 +300,9 @@ public:
     void appendFillEmpty() {
         appendSimpleInstruction(Instruction::fillEmpty);
     }
+    void appendFillEmptyImm(value::TypeTags tag, value::Value val);
     void appendGetField();
+    void appendGetFieldImm(value::TypeTags tag, value::Value val);
     void appendGetElement();
     void appendSum();
     void appendMin();
@@ -325,6 +331,9 @@ public:
 
 private:
     void appendSimpleInstruction(Instruction::Tags tag);
+    // Appends an instruction followed by an immediate constant operand, which is read by the
+    // instruction in place of the value it would otherwise pop off the stack.
+    void appendImmInstruction(Instruction::Tags tag, value::TypeTags immTag, value::Value immVal);
     auto allocateSpace(size_t size) {
         auto oldSize = _instrs.size();
         _instrs.resize(oldSize + size);
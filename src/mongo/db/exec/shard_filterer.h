@@ -47,6 +47,21 @@ public:
 
     virtual DocumentBelongsResult documentBelongsToMe(const WorkingSetMember& wsm) const = 0;
     virtual DocumentBelongsResult documentBelongsToMe(const Document& doc) const = 0;
+
+    /**
+     * Same as documentBelongsToMe, for each of 'docs'. Implementations may check the documents
+     * against the owned ranges more cheaply than one at a time.
+     */
+    virtual std::vector<DocumentBelongsResult> documentsBelongToMe(
+        const std::vector<Document>& docs) const {
+        std::vector<DocumentBelongsResult> results;
+        results.reserve(docs.size());
+        for (const auto& doc : docs) {
+            results.push_back(documentBelongsToMe(doc));
+        }
+        return results;
+    }
+
     virtual bool isCollectionSharded() const = 0;
     virtual const KeyPattern& getKeyPattern() const = 0;
 };
@@ -80,4 +80,30 @@ ShardFilterer::DocumentBelongsResult ShardFiltererImpl::documentBelongsToMe(
     }
     return _shardKeyBelongsToMe(_keyPattern->extractShardKeyFromDoc(doc.toBson()));
 }
+
+std::vector<ShardFilterer::DocumentBelongsResult> ShardFiltererImpl::documentsBelongToMe(
+    const std::vector<Document>& docs) const {
+    if (!_collectionFilter.isSharded()) {
+        return std::vector<DocumentBelongsResult>(docs.size(), DocumentBelongsResult::kBelongs);
+    }
+
+    std::vector<BSONObj> shardKeys;
+    shardKeys.reserve(docs.size());
+    for (const auto& doc : docs) {
+        shardKeys.push_back(_keyPattern->extractShardKeyFromDoc(doc.toBson()));
+    }
+
+    const auto belongs = _collectionFilter.keysBelongToMe(shardKeys);
+    std::vector<DocumentBelongsResult> results;
+    results.reserve(docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (shardKeys[i].isEmpty()) {
+            results.push_back(DocumentBelongsResult::kNoShardKey);
+        } else {
+            results.push_back(belongs[i] ? DocumentBelongsResult::kBelongs
+                                         : DocumentBelongsResult::kDoesNotBelong);
+        }
+    }
+    return results;
+}
 }  // namespace mongo
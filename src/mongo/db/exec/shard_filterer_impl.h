@@ -41,6 +41,8 @@ public:
 
     DocumentBelongsResult documentBelongsToMe(const WorkingSetMember& wsm) const override;
     DocumentBelongsResult documentBelongsToMe(const Document& doc) const override;
+    std::vector<DocumentBelongsResult> documentsBelongToMe(
+        const std::vector<Document>& docs) const override;
 
     bool isCollectionSharded() const override {
         return _collectionFilter.isSharded();
@@ -54,10 +54,12 @@ std::string nextFileName() {
 
 #include "mongo/db/sorter/sorter.cpp"
 
-MONGO_CREATE_SORTER(mongo::Value,
+MONGO_CREATE_SORTER(mongo::NormalizedSortKey,
                     mongo::Document,
                     mongo::SortExecutor<mongo::Document>::Comparator);
-MONGO_CREATE_SORTER(mongo::Value,
+MONGO_CREATE_SORTER(mongo::NormalizedSortKey,
                     mongo::SortableWorkingSetMember,
                     mongo::SortExecutor<mongo::SortableWorkingSetMember>::Comparator);
-MONGO_CREATE_SORTER(mongo::Value, mongo::BSONObj, mongo::SortExecutor<mongo::BSONObj>::Comparator);
+MONGO_CREATE_SORTER(mongo::NormalizedSortKey,
+                    mongo::BSONObj,
+                    mongo::SortExecutor<mongo::BSONObj>::Comparator);
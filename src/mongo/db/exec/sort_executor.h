@@ -30,10 +30,12 @@
 #pragma once
 
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/normalized_sort_key.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/exec/sort_key_comparator.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
 
@@ -47,21 +49,31 @@ namespace mongo {
  * The template parameter is the type of data being sorted. In DocumentSource execution, we sort
  * Document objects directly, but in the PlanStage layer we may sort WorkingSetMembers. The type of
  * the sort key, on the other hand, is always Value.
+ *
+ * Unless disabled by the 'internalQueryUseNormalizedSortKeys' knob, each sort key is encoded once
+ * into a KeyString on add(), and the sorter, including the merge of its spilled runs, orders the
+ * documents by comparing these encodings with memcmp() rather than comparing the components of the
+ * sort keys one by one.
  */
 template <typename T>
 class SortExecutor {
 public:
-    using DocumentSorter = Sorter<Value, T>;
+    using DocumentSorter = Sorter<NormalizedSortKey, T>;
     class Comparator {
     public:
-        Comparator(const SortPattern& sortPattern) : _sortKeyComparator(sortPattern) {}
+        Comparator(const SortPattern& sortPattern, bool normalizedKeys)
+            : _sortKeyComparator(sortPattern), _normalizedKeys(normalizedKeys) {}
         int operator()(const typename DocumentSorter::Data& lhs,
                        const typename DocumentSorter::Data& rhs) const {
-            return _sortKeyComparator(lhs.first, rhs.first);
+            if (_normalizedKeys) {
+                return lhs.first.compare(rhs.first);
+            }
+            return _sortKeyComparator(lhs.first.sortKey(), rhs.first.sortKey());
         }
 
     private:
         SortKeyComparator _sortKeyComparator;
+        bool _normalizedKeys;
     };
 
     /**
@@ -75,6 +87,10 @@ public:
         : _sortPattern(std::move(sortPattern)),
           _tempDir(std::move(tempDir)),
           _diskUseAllowed(allowDiskUse) {
+        if (internalQueryUseNormalizedSortKeys.load() &&
+            SortKeyNormalizer::canNormalize(_sortPattern)) {
+            _normalizer.emplace(_sortPattern);
+        }
         _stats.sortPattern =
             _sortPattern.serialize(SortPattern::SortKeySerialization::kForExplain).toBson();
         _stats.limit = limit;
@@ -124,9 +140,9 @@ public:
      */
     void add(const Value& sortKey, const T& data) {
         if (!_sorter) {
-            _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
+            _sorter.reset(DocumentSorter::make(makeSortOptions(), makeComparator()));
         }
-        _sorter->add(sortKey, data);
+        _sorter->add(_normalizer ? (*_normalizer)(sortKey) : NormalizedSortKey{sortKey}, data);
 
         _stats.totalDataSizeBytes += data.memUsageForSorter();
     }
@@ -137,11 +153,13 @@ public:
     void loadingDone() {
         // This conditional should only pass if no documents were added to the sorter.
         if (!_sorter) {
-            _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
+            _sorter.reset(DocumentSorter::make(makeSortOptions(), makeComparator()));
         }
         _output.reset(_sorter->done());
         _stats.keysSorted += _sorter->numSorted();
         _stats.spills += _sorter->numSpills();
+        _stats.spilledDataSizeBytes += _sorter->spilledDataSize();
+        _stats.spilledDataStorageSizeBytes += _sorter->spilledDataStorageSize();
         _sorter.reset();
     }
 
@@ -169,10 +187,15 @@ public:
      * end-of-stream must be detected with 'hasNext()'.
      */
     std::pair<Value, T> getNext() {
-        return _output->next();
+        auto next = _output->next();
+        return {next.first.releaseSortKey(), std::move(next.second)};
     }
 
 private:
+    Comparator makeComparator() const {
+        return Comparator(_sortPattern, _normalizer.has_value());
+    }
+
     SortOptions makeSortOptions() const {
         SortOptions opts;
         if (_stats.limit) {
@@ -180,6 +203,7 @@ private:
         }
 
         opts.maxMemoryUsageBytes = _stats.maxMemoryUsageBytes;
+        opts.useQueryMemoryReservation = true;
         if (_diskUseAllowed) {
             opts.extSortAllowed = true;
             opts.tempDir = _tempDir;
@@ -192,6 +216,9 @@ private:
     const std::string _tempDir;
     const bool _diskUseAllowed;
 
+    // Encodes the sort keys into normalized sort keys, unless they are compared directly.
+    boost::optional<SortKeyNormalizer> _normalizer;
+
     std::unique_ptr<DocumentSorter> _sorter;
     std::unique_ptr<typename DocumentSorter::Iterator> _output;
 
@@ -123,8 +123,8 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
     if (wantTextScore) {
         // We use a TEXT_OR stage to get the union of the results from the index scans and then
         // compute their text scores. This is a blocking operation.
-        auto textScorer =
-            std::make_unique<TextOrStage>(expCtx(), _params.spec, ws, filter, collection);
+        auto textScorer = std::make_unique<TextOrStage>(
+            expCtx(), _params.spec, ws, filter, collection, _params.topK, &_params.query);
 
         textScorer->addChildren(std::move(indexScanList));
 
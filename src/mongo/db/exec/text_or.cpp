@@ -31,6 +31,7 @@
 
 #include <map>
 #include <memory>
+#include <numeric>
 #include <vector>
 
 #include "mongo/db/concurrency/write_conflict_exception.h"
@@ -56,13 +57,22 @@ TextOrStage::TextOrStage(ExpressionContext* expCtx,
                          const FTSSpec& ftsSpec,
                          WorkingSet* ws,
                          const MatchExpression* filter,
-                         const CollectionPtr& collection)
+                         const CollectionPtr& collection,
+                         size_t topK,
+                         const fts::FTSQueryImpl* query)
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ftsSpec(ftsSpec),
       _ws(ws),
       _scoreIterator(_scores.end()),
+      _topK(topK),
       _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {}
+      _idRetrying(WorkingSet::INVALID_ID) {
+    if (_topK) {
+        invariant(query);
+        _matcher = std::make_unique<fts::FTSMatcher>(*query, _ftsSpec);
+        _specificStats.topK = _topK;
+    }
+}
 
 void TextOrStage::addChild(unique_ptr<PlanStage> child) {
     _children.push_back(std::move(child));
@@ -154,6 +164,10 @@ PlanStage::StageState TextOrStage::initStage(WorkingSetID* out) {
     try {
         _recordCursor = collection()->getCursor(opCtx());
         _internalState = State::kReadingTerms;
+        if (_topK) {
+            _maxRemainingScores.assign(_children.size(), fts::MAX_WEIGHT);
+            _childIsEOF.assign(_children.size(), false);
+        }
         return PlanStage::NEED_TIME;
     } catch (const WriteConflictException&) {
         invariant(_internalState == State::kInit);
@@ -182,8 +196,18 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        auto stageState = addTerm(id, out);
+        if (_topK && PlanStage::NEED_TIME == stageState) {
+            return nextChildForTopK();
+        }
+        return stageState;
     } else if (PlanStage::IS_EOF == childState) {
+        if (_topK) {
+            _childIsEOF[_currentChild] = true;
+            _maxRemainingScores[_currentChild] = 0;
+            return nextChildForTopK();
+        }
+
         // Done with this child.
         ++_currentChild;
 
@@ -204,6 +228,56 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 }
 
+PlanStage::StageState TextOrStage::nextChildForTopK() {
+    if (!canStopReadingForTopK()) {
+        for (size_t i = 1; i <= _children.size(); ++i) {
+            const size_t child = (_currentChild + i) % _children.size();
+            if (!_childIsEOF[child]) {
+                _currentChild = child;
+                return PlanStage::NEED_TIME;
+            }
+        }
+    }
+
+    // Either every child is EOF, or no document which hasn't been seen can score higher than the
+    // best '_topK' found.
+    _scoreIterator = _scores.begin();
+    _internalState = State::kReturningResults;
+    return PlanStage::NEED_TIME;
+}
+
+bool TextOrStage::canStopReadingForTopK() const {
+    if (_topDocuments.size() < _topK) {
+        return false;
+    }
+    const double maxUnseenScore =
+        std::accumulate(_maxRemainingScores.begin(), _maxRemainingScores.end(), 0.0);
+    return _topDocuments.top().first >= maxUnseenScore;
+}
+
+void TextOrStage::rejectDocument(TextRecordData* textRecordData) {
+    if (WorkingSet::INVALID_ID != textRecordData->wsid) {
+        _ws->free(textRecordData->wsid);
+        textRecordData->wsid = WorkingSet::INVALID_ID;
+    }
+    textRecordData->score = -1;
+}
+
+double TextOrStage::scoreDocument(const BSONObj& obj) const {
+    fts::TermFrequencyMap termFreqs;
+    _ftsSpec.scoreDocument(obj, &termFreqs);
+
+    // Add up the scores in the order in which the children would have returned them.
+    double score = 0;
+    for (const auto& term : _matcher->query().getTermsForBounds()) {
+        auto it = termFreqs.find(term);
+        if (it != termFreqs.end()) {
+            score += it->second;
+        }
+    }
+    return score;
+}
+
 PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     if (_scoreIterator == _scores.end()) {
         _internalState = State::kDone;
@@ -235,6 +309,22 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
     const IndexKeyDatum newKeyData = wsm->keyData.back();  // copy to keep it around.
     TextRecordData* textRecordData = &_scores[wsm->recordId];
 
+    // Locate score within possibly compound key: {prefix,term,score,suffix}.
+    BSONObjIterator keyIt(newKeyData.keyData);
+    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
+        keyIt.next();
+    }
+
+    keyIt.next();  // Skip past 'term'.
+
+    BSONElement scoreElement = keyIt.next();
+    double documentTermScore = scoreElement.number();
+
+    if (_topK) {
+        // The children return their documents in descending order of score.
+        _maxRemainingScores[_currentChild] = documentTermScore;
+    }
+
     if (textRecordData->score < 0) {
         // We have already rejected this document for not matching the filter.
         invariant(WorkingSet::INVALID_ID == textRecordData->wsid);
@@ -246,6 +336,22 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         // We haven't seen this RecordId before.
         invariant(textRecordData->score == 0);
 
+        // A new document can only be among the best '_topK' if its score for this term, plus the
+        // most it can score for each of the other terms, exceeds the lowest of their scores.
+        if (_topK && _topDocuments.size() == _topK) {
+            double maxScore = documentTermScore;
+            for (size_t i = 0; i < _maxRemainingScores.size(); ++i) {
+                if (i != _currentChild) {
+                    maxScore += _maxRemainingScores[i];
+                }
+            }
+            if (maxScore <= _topDocuments.top().first) {
+                _ws->free(wsid);
+                textRecordData->score = -1;
+                return NEED_TIME;
+            }
+        }
+
         if (!Filter::passes(newKeyData.keyData, newKeyData.indexKeyPattern, _filter)) {
             _ws->free(wsid);
             textRecordData->score = -1;
@@ -272,6 +378,34 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
 
         // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
         wsm->makeObjOwnedIfNeeded();
+
+        if (_topK) {
+            // Score the document for all of the terms at once, now that it has been fetched, and
+            // keep it if it is among the best '_topK' so far.
+            const BSONObj obj = wsm->doc.value().toBson();
+            if (!_matcher->matches(obj)) {
+                rejectDocument(textRecordData);
+                return NEED_TIME;
+            }
+
+            textRecordData->score = scoreDocument(obj);
+            if (_topDocuments.size() == _topK &&
+                textRecordData->score <= _topDocuments.top().first) {
+                rejectDocument(textRecordData);
+                return NEED_TIME;
+            }
+
+            _topDocuments.emplace(textRecordData->score, wsm->recordId);
+            if (_topDocuments.size() > _topK) {
+                rejectDocument(&_scores[_topDocuments.top().second]);
+                _topDocuments.pop();
+            }
+            return NEED_TIME;
+        }
+    } else if (_topK) {
+        // The document has already been scored for all of the terms.
+        _ws->free(wsid);
+        return NEED_TIME;
     } else {
         // We already have a working set member for this RecordId. Free the new WSM and retrieve the
         // old one. Note that since we don't keep all index keys, we could get a score that doesn't
@@ -282,17 +416,6 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         wsm = _ws->get(textRecordData->wsid);
     }
 
-    // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
-    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
-        keyIt.next();
-    }
-
-    keyIt.next();  // Skip past 'term'.
-
-    BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
-
     // Aggregate relevance score, term keys.
     textRecordData->score += documentTermScore;
     return NEED_TIME;
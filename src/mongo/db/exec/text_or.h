@@ -30,8 +30,12 @@
 #pragma once
 
 #include <memory>
+#include <queue>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/fts/fts_matcher.h"
+#include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
@@ -46,6 +50,13 @@ class OperationContext;
  * A blocking stage that returns the set of WSMs with RecordIDs of all of the documents that contain
  * the positive terms in the search query, as well as their scores.
  *
+ * When only the 'topK' highest-scoring documents are wanted, the stage reads its children, which
+ * return the documents containing each term in descending order of the term's score, in turn. The
+ * score of the last document read from each child bounds the scores of the documents it has yet to
+ * return. Any new document whose score can't exceed the lowest of the best 'topK' found so far is
+ * discarded without being fetched, and the stage stops reading once no unseen document can. The
+ * documents kept are scored in full, and checked against the whole text query, as they are found.
+ *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
  */
 class TextOrStage final : public RequiresCollectionStage {
@@ -67,11 +78,17 @@ public:
         kDone,
     };
 
+    /**
+     * If 'topK' is non-zero, only the 'topK' highest-scoring documents which match 'query' are
+     * returned, and 'query' must be non-null.
+     */
     TextOrStage(ExpressionContext* expCtx,
                 const FTSSpec& ftsSpec,
                 WorkingSet* ws,
                 const MatchExpression* filter,
-                const CollectionPtr& collection);
+                const CollectionPtr& collection,
+                size_t topK = 0,
+                const fts::FTSQueryImpl* query = nullptr);
 
     void addChild(std::unique_ptr<PlanStage> child);
 
@@ -123,6 +140,19 @@ private:
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * Helpers for reading only the 'topK' best documents. Once the current child has been read
+     * from, moves on to the next child which isn't EOF, and stops reading if the best documents
+     * found so far are final.
+     */
+    StageState nextChildForTopK();
+    bool canStopReadingForTopK() const;
+
+    /**
+     * Returns the score of 'obj' for the terms of the query, as the index keys would give it.
+     */
+    double scoreDocument(const BSONObj& obj) const;
+
     // The index spec used to determine where to find the score.
     FTSSpec _ftsSpec;
 
@@ -150,6 +180,27 @@ private:
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
+    /**
+     * Rejects the document of 'textRecordData', freeing its working set member if it has one.
+     */
+    void rejectDocument(TextRecordData* textRecordData);
+
+    // The number of highest-scoring documents to return, or 0 to return all of them.
+    const size_t _topK;
+
+    // Checks that a document matches the whole text query before it is kept among the best
+    // '_topK'. Only set when '_topK' is non-zero.
+    std::unique_ptr<fts::FTSMatcher> _matcher;
+
+    // The best '_topK' documents found so far, with the lowest score on top, and for each child
+    // the score of the last document it returned, or 0 once it is EOF.
+    std::priority_queue<std::pair<double, RecordId>,
+                        std::vector<std::pair<double, RecordId>>,
+                        std::greater<std::pair<double, RecordId>>>
+        _topDocuments;
+    std::vector<double> _maxRemainingScores;
+    std::vector<bool> _childIsEOF;
+
     TextOrStats _specificStats;
 
     // Members needed only for using the TextMatchableDocument.
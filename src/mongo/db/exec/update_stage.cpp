@@ -46,6 +46,7 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/resharding_util.h"
@@ -105,6 +106,17 @@ CollectionUpdateArgs::StoreDocOption getStoreDocMode(const UpdateRequest& update
     invariant(!updateRequest.shouldReturnAnyDocs());
     return CollectionUpdateArgs::StoreDocOption::None;
 }
+
+size_t getBatchSize(OperationContext* opCtx, const UpdateStageParams& params) {
+    // Batches can be retried, so an update which hands each updated document to its caller has to
+    // update them one at a time. The writes of a transaction all share its WriteUnitOfWork anyway.
+    if (!params.request->isMulti() || params.request->explain() ||
+        params.request->shouldReturnAnyDocs() || opCtx->inMultiDocumentTransaction()) {
+        return 1;
+    }
+    return static_cast<size_t>(internalQueryMultiUpdateBatchSize.load());
+}
+
 }  // namespace
 
 // Public constructor.
@@ -130,7 +142,8 @@ UpdateStage::UpdateStage(ExpressionContext* expCtx,
       _doc(params.driver->getDocument()),
       _idRetrying(WorkingSet::INVALID_ID),
       _idReturning(WorkingSet::INVALID_ID),
-      _updatedRecordIds(params.request->isMulti() ? new RecordIdSet() : nullptr) {
+      _updatedRecordIds(params.request->isMulti() ? new RecordIdSet() : nullptr),
+      _batchSize(getBatchSize(opCtx(), params)) {
 
     // Should the modifiers validate their embedded docs via storage_validation::storageValid()?
     // Only user updates should be checked. Any system or replication stuff should pass through.
@@ -180,6 +193,13 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         }
         immutablePaths.keepShortest(&idFieldRef);
     }
+
+    // Only operator updates track which paths they modify. These let the index catalog leave the
+    // indexes which the update did not touch alone.
+    _modifiedPaths.clear();
+    FieldRefSetWithStorage* const modifiedPaths =
+        driver->type() == UpdateDriver::UpdateType::kOperator ? &_modifiedPaths : nullptr;
+
     if (!driver->needMatchDetails()) {
         // If we don't need match details, avoid doing the rematch
         status = driver->update(opCtx(),
@@ -189,7 +209,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                 immutablePaths,
                                 isInsert,
                                 &logObj,
-                                &docWasModified);
+                                &docWasModified,
+                                modifiedPaths);
     } else {
         // If there was a matched field, obtain it.
         MatchDetails matchDetails;
@@ -209,7 +230,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                 immutablePaths,
                                 isInsert,
                                 &logObj,
-                                &docWasModified);
+                                &docWasModified,
+                                modifiedPaths);
     }
 
     if (!status.isOK()) {
@@ -260,6 +282,11 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                     !request->isMulti() || args.criteria.hasField("_id"_sd));
             args.fromMigrate = request->isFromMigration();
             args.storeDocOption = getStoreDocMode(*request);
+            // A document without an _id may have had one generated, which the modified paths
+            // don't mention.
+            if (modifiedPaths && !modifiedPaths->empty() && oldObj.value().hasField(idFieldName)) {
+                args.modifiedPaths = modifiedPaths;
+            }
             if (args.storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage) {
                 args.preImageDoc = oldObj.value().getOwned();
             }
@@ -322,9 +349,14 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // it again.  For an example, see the comment above near declaration of
         // updatedRecordIds.
         //
-        // This must be done after the wunit commits so we are sure we won't be rolling back.
+        // This must be done after the wunit commits so we are sure we won't be rolling back. The
+        // WriteUnitOfWork of a batch is only committed once all of its documents are updated.
         if (_updatedRecordIds && (newRecordId != recordId || driver->modsAffectIndices())) {
-            _updatedRecordIds->insert(newRecordId);
+            if (_batchSize > 1) {
+                _batchUpdatedRecordIds.push_back(newRecordId);
+            } else {
+                _updatedRecordIds->insert(newRecordId);
+            }
         }
     }
 
@@ -356,6 +388,7 @@ bool UpdateStage::isEOF() {
     // We're done updating if either the child has no more results to give us, or we've
     // already gotten a result back and we're not a multi-update.
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
+        _batch.empty() &&
         (child()->isEOF() || (_specificStats.nMatched > 0 && !_params.request->isMulti()));
 }
 
@@ -364,6 +397,10 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_batchSize > 1) {
+        return doBatchedWork(out);
+    }
+
     // It is possible that after an update was applied, a WriteConflictException
     // occurred and prevented us from returning ADVANCED with the requested version
     // of the document.
@@ -518,6 +555,129 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState UpdateStage::doBatchedWork(WorkingSetID* out) {
+    // A full batch, or the last one, is only left in place when its update has to be retried.
+    if (!_batch.empty() && (_batch.size() >= _batchSize || child()->isEOF())) {
+        return updateBatch(out);
+    }
+
+    WorkingSetID id;
+    auto status = child()->work(&id);
+    switch (status) {
+        case PlanStage::ADVANCED:
+            break;
+
+        case PlanStage::NEED_TIME:
+            return status;
+
+        case PlanStage::NEED_YIELD:
+            *out = id;
+            return status;
+
+        case PlanStage::IS_EOF:
+            return _batch.empty() ? status : updateBatch(out);
+
+        default:
+            MONGO_UNREACHABLE;
+    }
+
+    WorkingSetMember* member = _ws->get(id);
+    invariant(member->hasRecordId());
+    invariant(member->hasObj());
+
+    if (_updatedRecordIds->count(member->recordId) > 0) {
+        // A document we have already updated, see the comment on '_updatedRecordIds'.
+        _ws->free(id);
+        return PlanStage::NEED_TIME;
+    }
+
+    // Whether the document still exists and matches the predicate is checked when the batch is
+    // updated, as the snapshot can change while the rest of the batch is gathered. The BSONObj
+    // must be owned to survive the yields in between.
+    member->makeObjOwnedIfNeeded();
+    _batch.push_back(id);
+
+    if (_batch.size() < _batchSize) {
+        return PlanStage::NEED_TIME;
+    }
+    return updateBatch(out);
+}
+
+PlanStage::StageState UpdateStage::updateBatch(WorkingSetID* out) {
+    try {
+        child()->saveState();
+    } catch (const WriteConflictException&) {
+        std::terminate();
+    }
+
+    // Updating the documents in RecordId order lets the record store write them with mostly
+    // sequential accesses.
+    std::sort(_batch.begin(), _batch.end(), [&](WorkingSetID lhs, WorkingSetID rhs) {
+        return _ws->get(lhs)->recordId < _ws->get(rhs)->recordId;
+    });
+
+    while (!_batch.empty()) {
+        const size_t numToUpdate = _updateBatchOneByOne ? 1 : _batch.size();
+        const auto nModified = _specificStats.nModified;
+        size_t nMatched = 0;
+        try {
+            WriteUnitOfWork wunit(opCtx());
+            for (size_t i = 0; i < numToUpdate; ++i) {
+                if (!write_stage_common::ensureStillMatches(
+                        collection(), opCtx(), _ws, _batch[i], _params.canonicalQuery)) {
+                    // Either the document has been deleted, or it has been updated such that it
+                    // no longer matches the predicate.
+                    continue;
+                }
+
+                WorkingSetMember* member = _ws->get(_batch[i]);
+                RecordId recordId = member->recordId;
+                transformAndUpdate({member->doc.snapshotId(), member->doc.value().toBson()},
+                                   recordId);
+                ++nMatched;
+            }
+            wunit.commit();
+        } catch (const WriteConflictException&) {
+            // Keep the rest of the batch around so we can retry updating it.
+            _specificStats.nModified = nModified;
+            _batchUpdatedRecordIds.clear();
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        } catch (const DBException& ex) {
+            _specificStats.nModified = nModified;
+            _batchUpdatedRecordIds.clear();
+            // A failed WriteUnitOfWork nested in another one can't be followed by a new one.
+            if (numToUpdate == 1 || ErrorCodes::isInterruption(ex.code()) ||
+                opCtx()->lockState()->inAWriteUnitOfWork()) {
+                throw;
+            }
+            // Update the documents one at a time instead, so that those in front of the one which
+            // failed are updated before the error is raised, as for unbatched updates.
+            _updateBatchOneByOne = true;
+            continue;
+        }
+
+        _specificStats.nMatched += nMatched;
+        _updatedRecordIds->insert(_batchUpdatedRecordIds.begin(), _batchUpdatedRecordIds.end());
+        _batchUpdatedRecordIds.clear();
+        for (size_t i = 0; i < numToUpdate; ++i) {
+            _ws->free(_batch[i]);
+        }
+        _batch.erase(_batch.begin(), _batch.begin() + numToUpdate);
+    }
+    _updateBatchOneByOne = false;
+
+    // As in the unbatched case, make sure to restore the state outside of the WriteUnitOfWork.
+    try {
+        child()->restoreState(&collection());
+    } catch (const WriteConflictException&) {
+        // The batch was committed, there is nothing to retry.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+    return PlanStage::NEED_TIME;
+}
+
 void UpdateStage::_ensureIdFieldIsFirst(mb::Document* doc, bool generateOIDIfMissing) {
     mb::Element idElem = mb::findFirstChildNamed(doc->root(), idFieldName);
 
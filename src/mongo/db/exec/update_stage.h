@@ -129,6 +129,7 @@ protected:
     // These get reused for each update.
     mutablebson::Document& _doc;
     mutablebson::DamageVector _damages;
+    FieldRefSetWithStorage _modifiedPaths;
 
 private:
     /**
@@ -138,6 +139,19 @@ private:
      */
     BSONObj transformAndUpdate(const Snapshotted<BSONObj>& oldObj, RecordId& recordId);
 
+    /**
+     * Gathers the members returned by the child into '_batch', and updates them once the batch is
+     * full or the child is exhausted. Used by multi-updates which don't return any documents.
+     */
+    StageState doBatchedWork(WorkingSetID* out);
+
+    /**
+     * Updates the documents of '_batch' in a single WriteUnitOfWork, skipping those which were
+     * deleted or no longer match since they were gathered. Returns NEED_YIELD, keeping the batch,
+     * if the update has to be retried.
+     */
+    StageState updateBatch(WorkingSetID* out);
+
     /**
      * Stores 'idToRetry' in '_idRetrying' so the update can be retried during the next call to
      * doWork(). Always returns NEED_YIELD and sets 'out' to WorkingSet::INVALID_ID.
@@ -195,6 +209,20 @@ private:
     // So, no matter what, we keep track of where the doc wound up.
     typedef stdx::unordered_set<RecordId, RecordId::Hasher> RecordIdSet;
     const std::unique_ptr<RecordIdSet> _updatedRecordIds;
+
+    // The maximum number of documents updated in a single WriteUnitOfWork. Only multi-updates
+    // which don't return any documents update more than one document at a time.
+    const size_t _batchSize;
+
+    // Members gathered from the child which are yet to be updated.
+    std::vector<WorkingSetID> _batch;
+
+    // The RecordIds to add to '_updatedRecordIds' once the WriteUnitOfWork of the batch commits.
+    std::vector<RecordId> _batchUpdatedRecordIds;
+
+    // Set once a batch failed with an error other than a write conflict, after which the rest of
+    // the batch is updated one document per WriteUnitOfWork.
+    bool _updateBatchOneByOne = false;
 };
 
 }  // namespace mongo
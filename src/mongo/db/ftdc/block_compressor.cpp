@@ -32,12 +32,41 @@
 #include "mongo/db/ftdc/block_compressor.h"
 
 #include <zlib.h>
+#include <zstd.h>
 
+#include "mongo/base/data_view.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
+namespace {
+
+// Favors speed, since FTDC compresses on its collection thread. Metric chunks are highly
+// repetitive after delta and run-length encoding, so higher levels gain little.
+constexpr int kZstdCompressionLevel = 3;
+
+bool isZstdFrame(ConstDataRange source) {
+    return source.length() >= sizeof(std::uint32_t) &&
+        ConstDataView(source.data()).read<LittleEndian<std::uint32_t>>() == ZSTD_MAGICNUMBER;
+}
+
+}  // namespace
+
+StatusWith<BlockCompressor::Algorithm> BlockCompressor::parseAlgorithm(StringData name) {
+    if (name == "zlib"_sd) {
+        return Algorithm::kZlib;
+    } else if (name == "zstd"_sd) {
+        return Algorithm::kZstd;
+    }
+    return {ErrorCodes::BadValue,
+            str::stream() << "Unknown FTDC compressor '" << name
+                          << "', expected one of 'zlib' or 'zstd'"};
+}
+
+StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source, Algorithm algorithm) {
+    if (algorithm == Algorithm::kZstd) {
+        return _compressZstd(source);
+    }
 
-StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source) {
     z_stream stream;
     int level = Z_DEFAULT_COMPRESSION;
 
@@ -79,6 +108,10 @@ StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source) {
 
 StatusWith<ConstDataRange> BlockCompressor::uncompress(ConstDataRange source,
                                                        size_t uncompressedLength) {
+    if (isZstdFrame(source)) {
+        return _uncompressZstd(source, uncompressedLength);
+    }
+
     z_stream stream;
 
     stream.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(source.data()));
@@ -115,4 +148,30 @@ StatusWith<ConstDataRange> BlockCompressor::uncompress(ConstDataRange source,
     return ConstDataRange(_buffer.data(), stream.total_out);
 }
 
+StatusWith<ConstDataRange> BlockCompressor::_compressZstd(ConstDataRange source) {
+    _buffer.resize(ZSTD_compressBound(source.length()));
+
+    auto size = ZSTD_compress(
+        _buffer.data(), _buffer.size(), source.data(), source.length(), kZstdCompressionLevel);
+    if (ZSTD_isError(size)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "zstd compression failed: " << ZSTD_getErrorName(size)};
+    }
+
+    return ConstDataRange(_buffer.data(), size);
+}
+
+StatusWith<ConstDataRange> BlockCompressor::_uncompressZstd(ConstDataRange source,
+                                                            size_t uncompressedLength) {
+    _buffer.resize(uncompressedLength);
+
+    auto size = ZSTD_decompress(_buffer.data(), _buffer.size(), source.data(), source.length());
+    if (ZSTD_isError(size)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "zstd decompression failed: " << ZSTD_getErrorName(size)};
+    }
+
+    return ConstDataRange(_buffer.data(), size);
+}
+
 }  // namespace mongo
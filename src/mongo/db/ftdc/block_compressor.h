@@ -34,26 +34,37 @@
 
 #include "mongo/base/data_range.h"
 #include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
 
 namespace mongo {
 
 /**
- * Compesses and uncompresses a block of buffer using zlib.
+ * Compesses and uncompresses a block of buffer using zlib or zstd. Either kind of block can be
+ * uncompressed regardless of the algorithm used to compress, since a zstd frame never starts like
+ * a zlib stream.
  */
 class BlockCompressor {
     BlockCompressor(const BlockCompressor&) = delete;
     BlockCompressor& operator=(const BlockCompressor&) = delete;
 
 public:
+    enum class Algorithm { kZlib, kZstd };
+
     BlockCompressor() = default;
 
+    /**
+     * Parses the name of an algorithm: 'zlib' or 'zstd'.
+     */
+    static StatusWith<Algorithm> parseAlgorithm(StringData name);
+
     /**
      * Compress a buffer of data.
      *
      * Returns a pointer to a buffer that BlockCompressor owns.
      * The returned buffer is valid until the next call to compress or uncompress.
      */
-    StatusWith<ConstDataRange> compress(ConstDataRange source);
+    StatusWith<ConstDataRange> compress(ConstDataRange source,
+                                        Algorithm algorithm = Algorithm::kZlib);
 
     /**
      * Uncompress a buffer of data.
@@ -67,6 +78,9 @@ public:
     StatusWith<ConstDataRange> uncompress(ConstDataRange source, size_t maxUncompressedLength);
 
 private:
+    StatusWith<ConstDataRange> _compressZstd(ConstDataRange source);
+    StatusWith<ConstDataRange> _uncompressZstd(ConstDataRange source, size_t maxUncompressedLength);
+
     std::vector<std::uint8_t> _buffer;
 };
 
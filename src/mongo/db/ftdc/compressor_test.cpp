@@ -116,6 +116,33 @@ TEST_F(FTDCCompressorTest, TestStrings) {
     ASSERT_TRUE(std::get<0>(swBuf.getValue()).data() != nullptr);
 }
 
+// Chunks compressed with either algorithm are read back by the same decompressor.
+TEST_F(FTDCCompressorTest, TestBlockCompressors) {
+    for (auto algorithm : {BlockCompressor::Algorithm::kZlib, BlockCompressor::Algorithm::kZstd}) {
+        FTDCConfig config;
+        config.blockCompressor = algorithm;
+        FTDCCompressor c(&config);
+
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < 100; ++i) {
+            docs.push_back(BSON("name"
+                                << "joe"
+                                << "key1" << i << "key2" << i * i));
+            ASSERT_HAS_SPACE(c.addSample(docs.back(), Date_t()));
+        }
+
+        auto swBuf = c.getCompressedSamples();
+        ASSERT_OK(swBuf.getStatus());
+
+        FTDCDecompressor decompressor;
+        auto swDocs = decompressor.uncompress(std::get<0>(swBuf.getValue()));
+        ASSERT_OK(swDocs.getStatus());
+        ValidateDocumentList(swDocs.getValue(), docs, FTDCValidationMode::kStrict);
+    }
+
+    ASSERT_NOT_OK(BlockCompressor::parseAlgorithm("snappy").getStatus());
+}
+
 /**
  * Test class that records a series of samples and ensures that compress + decompress round trips
  * them correctly.
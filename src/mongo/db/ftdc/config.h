@@ -31,6 +31,7 @@
 
 #include <cstdint>
 
+#include "mongo/db/ftdc/block_compressor.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -47,7 +48,8 @@ struct FTDCConfig {
           maxFileSizeBytes(kMaxFileSizeBytesDefault),
           period(kPeriodMillisDefault),
           maxSamplesPerArchiveMetricChunk(kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault),
+          blockCompressor(BlockCompressor::Algorithm::kZlib) {}
 
     /**
      * True if FTDC is collecting data. False otherwise
@@ -84,6 +86,12 @@ struct FTDCConfig {
      */
     std::uint32_t maxSamplesPerInterimMetricChunk;
 
+    /**
+     * Algorithm with which metric chunks are compressed. Readers accept chunks compressed with
+     * either, but tools outside the server may only understand zlib.
+     */
+    BlockCompressor::Algorithm blockCompressor;
+
     static const bool kEnabledDefault = true;
 
     static const std::int64_t kPeriodMillisDefault;
@@ -94,6 +94,12 @@ void FTDCController::setMaxSamplesPerInterimMetricChunk(size_t size) {
     _condvar.notify_one();
 }
 
+void FTDCController::setBlockCompressor(BlockCompressor::Algorithm algorithm) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.blockCompressor = algorithm;
+    _condvar.notify_one();
+}
+
 Status FTDCController::setDirectory(const boost::filesystem::path& path) {
     stdx::lock_guard<Latch> lock(_mutex);
 
@@ -111,6 +117,13 @@ Status FTDCController::setDirectory(const boost::filesystem::path& path) {
 }
 
 
+void FTDCController::setExporter(std::unique_ptr<FTDCExporterInterface> exporter) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    invariant(_state == State::kNotStarted);
+
+    _exporter = std::move(exporter);
+}
+
 void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
     {
         stdx::lock_guard<Latch> lock(_mutex);
@@ -253,6 +266,10 @@ void FTDCController::doLoop() noexcept {
 
             uassertStatusOK(s);
 
+            if (_exporter) {
+                _exporter->exportSample(std::get<0>(collectSample));
+            }
+
             // Store a reference to the most recent document from the periodic collectors
             {
                 stdx::lock_guard<Latch> lock(_mutex);
@@ -35,6 +35,7 @@
 
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
+#include "mongo/db/ftdc/exporter.h"
 #include "mongo/db/ftdc/file_manager.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/mutex.h"
@@ -99,6 +100,11 @@ public:
      */
     void setMaxSamplesPerInterimMetricChunk(size_t size);
 
+    /**
+     * Set the algorithm with which metric chunks are compressed.
+     */
+    void setBlockCompressor(BlockCompressor::Algorithm algorithm);
+
     /*
      * Set the path to store FTDC files if not already set.
      *
@@ -118,6 +124,11 @@ public:
      */
     void addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Set an exporter to receive each sample from the periodic collectors after it is written.
+     */
+    void setExporter(std::unique_ptr<FTDCExporterInterface> exporter);
+
     /**
      * Start the controller.
      *
@@ -210,6 +221,9 @@ private:
     // File manager that manages file rotation, and logging
     std::unique_ptr<FTDCFileManager> _mgr;
 
+    // Optional, only used by the background thread once started.
+    std::unique_ptr<FTDCExporterInterface> _exporter;
+
     // Background collection and writing thread
     stdx::thread _thread;
 };
@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kFTDC
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ftdc/exporter.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "mongo/logv2/log.h"
+#include "mongo/util/errno_util.h"
+
+namespace mongo {
+
+FTDCUnixSocketExporter::~FTDCUnixSocketExporter() {
+    _close();
+}
+
+#ifndef _WIN32
+
+bool FTDCUnixSocketExporter::_connect() {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (_path.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+    _path.copy(addr.sun_path, _path.size());
+
+    _fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_fd < 0) {
+        return false;
+    }
+    ::fcntl(_fd, F_SETFL, ::fcntl(_fd, F_GETFL) | O_NONBLOCK);
+
+    if (::connect(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        auto err = errno;
+        LOGV2_DEBUG(5843218,
+                    2,
+                    "Could not connect to the FTDC export socket",
+                    "path"_attr = _path,
+                    "error"_attr = errnoWithDescription(err));
+        _close();
+        return false;
+    }
+
+    LOGV2(5843219, "Connected to the FTDC export socket", "path"_attr = _path);
+    return true;
+}
+
+void FTDCUnixSocketExporter::_close() {
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    _pending.clear();
+}
+
+void FTDCUnixSocketExporter::exportSample(const BSONObj& sample) {
+    if (_fd < 0 && !_connect()) {
+        ++_droppedSamples;
+        return;
+    }
+
+    // Finish the line left over from the previous sample before starting a new one.
+    if (_pending.empty()) {
+        _pending = sample.jsonString(ExtendedRelaxedV2_0_0);
+        _pending.push_back('\n');
+    } else {
+        ++_droppedSamples;
+    }
+
+    while (!_pending.empty()) {
+        auto sent = ::send(_fd, _pending.data(), _pending.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent < 0) {
+            auto err = errno;
+            if (err == EINTR) {
+                continue;
+            }
+            if (err == EAGAIN || err == EWOULDBLOCK) {
+                return;
+            }
+
+            LOGV2(5843220,
+                  "Lost the connection to the FTDC export socket",
+                  "path"_attr = _path,
+                  "error"_attr = errnoWithDescription(err));
+            _close();
+            return;
+        }
+        _pending.erase(0, sent);
+    }
+}
+
+#else
+
+bool FTDCUnixSocketExporter::_connect() {
+    return false;
+}
+
+void FTDCUnixSocketExporter::_close() {}
+
+void FTDCUnixSocketExporter::exportSample(const BSONObj& sample) {
+    ++_droppedSamples;
+}
+
+#endif
+
+}  // namespace mongo
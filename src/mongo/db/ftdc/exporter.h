@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * Receives every sample collected by the periodic FTDC collectors, on the FTDC thread, so that it
+ * can be forwarded to an external metrics pipeline without a second collection pass.
+ *
+ * Implementations must not block: the FTDC thread collects on a fixed period.
+ */
+class FTDCExporterInterface {
+    FTDCExporterInterface(const FTDCExporterInterface&) = delete;
+    FTDCExporterInterface& operator=(const FTDCExporterInterface&) = delete;
+
+public:
+    virtual ~FTDCExporterInterface() = default;
+
+    virtual void exportSample(const BSONObj& sample) = 0;
+
+protected:
+    FTDCExporterInterface() = default;
+};
+
+/**
+ * Streams each sample as one line of relaxed extended JSON to a reader listening on a UNIX domain
+ * socket. The exporter (re)connects at the next sample whenever there is no connection, and drops
+ * samples rather than wait when the reader keeps up too slowly.
+ */
+class FTDCUnixSocketExporter final : public FTDCExporterInterface {
+public:
+    explicit FTDCUnixSocketExporter(std::string path) : _path(std::move(path)) {}
+    ~FTDCUnixSocketExporter() final;
+
+    void exportSample(const BSONObj& sample) final;
+
+    /**
+     * Number of samples that were not sent, for lack of a reader or of room in its socket buffer.
+     */
+    long long getDroppedSamples() const {
+        return _droppedSamples;
+    }
+
+private:
+    bool _connect();
+    void _close();
+
+    const std::string _path;
+    int _fd = -1;
+
+    // Bytes of the current line not yet sent, which must be sent before the next sample so that
+    // the reader never sees a torn line.
+    std::string _pending;
+
+    long long _droppedSamples = 0;
+};
+
+}  // namespace mongo
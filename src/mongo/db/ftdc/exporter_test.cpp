@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ftdc/exporter.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "mongo/db/json.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+#ifndef _WIN32
+
+class FTDCUnixSocketExporterTest : public unittest::Test {
+protected:
+    void setUp() override {
+        _path = _dir.path() + "/export.sock";
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        ASSERT_LT(_path.size(), sizeof(addr.sun_path));
+        _path.copy(addr.sun_path, _path.size());
+
+        _listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        ASSERT_GTE(_listenFd, 0);
+        ASSERT_EQ(0, ::bind(_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)));
+        ASSERT_EQ(0, ::listen(_listenFd, 1));
+    }
+
+    void tearDown() override {
+        if (_readFd >= 0) {
+            ::close(_readFd);
+        }
+        ::close(_listenFd);
+    }
+
+    // Reads the next line sent by the exporter.
+    std::string readLine() {
+        if (_readFd < 0) {
+            _readFd = ::accept(_listenFd, nullptr, nullptr);
+            ASSERT_GTE(_readFd, 0);
+        }
+
+        std::string line;
+        char c;
+        while (::read(_readFd, &c, 1) == 1 && c != '\n') {
+            line.push_back(c);
+        }
+        return line;
+    }
+
+    unittest::TempDir _dir{"ftdc_exporter_test"};
+    std::string _path;
+    int _listenFd = -1;
+    int _readFd = -1;
+};
+
+TEST_F(FTDCUnixSocketExporterTest, StreamsOneLinePerSample) {
+    FTDCUnixSocketExporter exporter(_path);
+
+    auto first = BSON("start" << Date_t::fromMillisSinceEpoch(1000) << "value" << 1);
+    auto second = BSON("start" << Date_t::fromMillisSinceEpoch(2000) << "value" << 2.5);
+    exporter.exportSample(first);
+    exporter.exportSample(second);
+
+    ASSERT_BSONOBJ_EQ(first, fromjson(readLine()));
+    ASSERT_BSONOBJ_EQ(second, fromjson(readLine()));
+    ASSERT_EQ(0, exporter.getDroppedSamples());
+}
+
+TEST_F(FTDCUnixSocketExporterTest, DropsSamplesWithoutReader) {
+    FTDCUnixSocketExporter exporter(_path + ".missing");
+    exporter.exportSample(BSON("value" << 1));
+    exporter.exportSample(BSON("value" << 2));
+    ASSERT_EQ(2, exporter.getDroppedSamples());
+}
+
+#endif
+
+}  // namespace
+}  // namespace mongo
@@ -41,6 +41,7 @@
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/controller.h"
+#include "mongo/db/ftdc/exporter.h"
 #include "mongo/db/ftdc/ftdc_server_gen.h"
 #include "mongo/db/ftdc/ftdc_system_stats.h"
 #include "mongo/db/jsobj.h"
@@ -170,6 +171,19 @@ Status onUpdateFTDCPerInterimUpdate(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status validateFTDCCompressor(const std::string& value) {
+    return BlockCompressor::parseAlgorithm(value).getStatus();
+}
+
+Status onUpdateFTDCCompressor(const std::string& value) {
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setBlockCompressor(uassertStatusOK(BlockCompressor::parseAlgorithm(value)));
+    }
+
+    return Status::OK();
+}
+
 FTDCSimpleInternalCommandCollector::FTDCSimpleInternalCommandCollector(StringData command,
                                                                        StringData name,
                                                                        StringData ns,
@@ -260,6 +274,8 @@ void startFTDC(boost::filesystem::path& path,
         ftdcStartupParams.maxSamplesPerArchiveMetricChunk.load();
     config.maxSamplesPerInterimMetricChunk =
         ftdcStartupParams.maxSamplesPerInterimMetricChunk.load();
+    config.blockCompressor =
+        uassertStatusOK(BlockCompressor::parseAlgorithm(ftdcStartupParams.blockCompressor.get()));
 
     ftdcDirectoryPathParameter = path;
 
@@ -276,6 +292,11 @@ void startFTDC(boost::filesystem::path& path,
     // Install System Metric Collector as a periodic collector
     installSystemMetricsCollector(controller.get());
 
+    if (!gDiagnosticDataCollectionExportSocketPath.empty()) {
+        controller->setExporter(
+            std::make_unique<FTDCUnixSocketExporter>(gDiagnosticDataCollectionExportSocketPath));
+    }
+
     // Install file rotation collectors
     // These are collected on each file rotation.
 
@@ -61,6 +61,30 @@ inline void appendUtf8Codepoint(char32_t codepoint, OutputIterator* outputIt) {
         *(*outputIt)++ = (((codepoint >> (6 * 0)) & 0x3f) | 0x80);
     }
 }
+
+/**
+ * Returns the number of leading bytes of 'utf8' which are ASCII other than NUL, each of which is a
+ * code point of its own.
+ */
+size_t countLeadingAsciiBytes(StringData utf8) {
+    size_t count = 0;
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    while (utf8.size() - count >= ByteVector::size) {
+        auto word = ByteVector::load(utf8.rawData() + count);
+        if (word.maskHigh() || word.compareEQ(0).maskAny()) {
+            break;
+        }
+        count += ByteVector::size;
+    }
+#endif
+    for (; count < utf8.size(); ++count) {
+        const uint8_t byte = utf8[count];
+        if (byte == 0 || byte > 0x7f) {
+            break;
+        }
+    }
+    return count;
+}
 }  // namespace
 
 using linenoise_utf8::copyString32to8;
@@ -83,22 +107,27 @@ void String::setData(const StringData utf8_src) {
     // plus a null character if there isn't one.
     _data.resize(utf8_src.size() + 1);
 
+    // Text is mostly ASCII, whose bytes are widened as they are. Only the rest of the input, from
+    // the first byte which isn't ASCII (or is a NUL, which ends the text), needs decoding.
+    const size_t asciiSize = countLeadingAsciiBytes(utf8_src);
+    std::copy(utf8_src.begin(), utf8_src.begin() + asciiSize, _data.begin());
+
     int result = 0;
     size_t resultSize = 0;
 
     // Although utf8_src.rawData() is not guaranteed to be null-terminated, copyString8to32 won't
     // access bad memory because it is limited by the size of its output buffer, which is set to the
     // size of utf8_src.
-    copyString8to32(&_data[0],
-                    reinterpret_cast<const unsigned char*>(&utf8_src.rawData()[0]),
-                    _data.size(),
+    copyString8to32(&_data[asciiSize],
+                    reinterpret_cast<const unsigned char*>(&utf8_src.rawData()[asciiSize]),
+                    _data.size() - asciiSize,
                     resultSize,
                     result);
 
     uassert(28755, "text contains invalid UTF-8", result == 0);
 
     // Resize _data so it is only as big as what it contains.
-    _data.resize(resultSize);
+    _data.resize(asciiSize + resultSize);
     _needsOutputConversion = true;
 }
 
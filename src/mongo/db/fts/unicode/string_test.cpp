@@ -198,6 +198,25 @@ TEST(UnicodeString, SubstringMatchTurkish) {
         str, UTF8("yaşindasiniz"), String::kDiacriticSensitive, CaseFoldMode::kTurkish));
 }
 
+TEST(UnicodeString, DecodeAsciiAndNonAsciiRuns) {
+    // Long enough runs of ASCII to take the vectored path, around code points of 2, 3 and 4 bytes.
+    const std::string ascii = filler + "abc";
+    String str(ascii + UTF8("é") + ascii + UTF8("二") + UTF8("𐌂") + ascii);
+    ASSERT_EQ(str.size(), 3 * ascii.size() + 3);
+    ASSERT_EQ(str[0], U'x');
+    ASSERT_EQ(str[ascii.size()], U'é');
+    ASSERT_EQ(str[2 * ascii.size() + 1], U'二');
+    ASSERT_EQ(str[2 * ascii.size() + 2], U'𐌂');
+    ASSERT_EQ(str[str.size() - 1], U'c');
+
+    StackBufBuilder buf;
+    ASSERT_EQ(ascii + UTF8("é"), str.substrToBuf(&buf, 0, ascii.size() + 1));
+
+    // A NUL ends the text, whether within a run of ASCII or not.
+    ASSERT_EQ(String(StringData(filler + '\0' + filler)).size(), filler.size());
+    ASSERT_EQ(String(StringData(UTF8("é") + std::string(1, '\0') + filler)).size(), 1U);
+}
+
 TEST(UnicodeString, BadUTF8) {
     // Overlong.
     const char invalid1[] = {C(0xC0), C(0xAF), 0};
@@ -224,6 +243,7 @@ TEST(UnicodeString, BadUTF8) {
     ASSERT_THROWS(String(invalid2), AssertionException);
     ASSERT_THROWS(String(invalid3), AssertionException);
     ASSERT_THROWS(String(invalid4), AssertionException);
+    ASSERT_THROWS(String(filler + invalid1), AssertionException);
 
     StackBufBuilder buf;
 
@@ -33,6 +33,11 @@
 
 #include "mongo/db/hasher.h"
 
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "mongo/db/jsobj.h"
 #include "mongo/util/md5.hpp"
@@ -99,7 +104,181 @@ void Hasher::finish(HashDigest out) {
     md5_finish(&_md5State, out);
 }
 
-void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
+/**
+ * Collects the input of the hash of an element, as long as it fits in a single MD5 block along
+ * with the padding, which is the case for most scalar values.
+ */
+class SingleBlockHashInput {
+public:
+    // MD5 pads each message with at least one byte, followed by the 8 byte message length.
+    static constexpr size_t kMaxSize = 64 - 1 - 8;
+
+    explicit SingleBlockHashInput(HashSeed seed) {
+        addSeed(seed);
+    }
+
+    void addData(const void* keyData, size_t numBytes) {
+        if (_size + numBytes > kMaxSize) {
+            _fits = false;
+            return;
+        }
+        std::memcpy(_bytes + _size, keyData, numBytes);
+        _size += numBytes;
+    }
+
+    void addSeed(int32_t number) {
+        addIntegerData(number);
+    }
+
+    void addNumber(int64_t number) {
+        addIntegerData(number);
+    }
+
+    bool fits() const {
+        return _fits;
+    }
+
+    /**
+     * Writes the input padded as MD5 does as sixteen little-endian words. Requires fits().
+     */
+    void pad(uint32_t block[16]) const {
+        unsigned char padded[64] = {};
+        std::memcpy(padded, _bytes, _size);
+        padded[_size] = 0x80;
+        DataView(reinterpret_cast<char*>(padded) + 56)
+            .write<LittleEndian<uint64_t>>(static_cast<uint64_t>(_size) * 8);
+        for (int i = 0; i < 16; ++i) {
+            block[i] = ConstDataView(reinterpret_cast<const char*>(padded) + 4 * i)
+                           .read<LittleEndian<uint32_t>>();
+        }
+    }
+
+private:
+    template <typename T>
+    void addIntegerData(T number) {
+        const auto data = endian::nativeToLittle(number);
+        addData(&data, sizeof(data));
+    }
+
+    unsigned char _bytes[kMaxSize];
+    size_t _size = 0;
+    bool _fits = true;
+};
+
+#if defined(__SSE2__)
+/**
+ * Runs the MD5 compression function over four independent single-block messages at once, one in
+ * each 32-bit lane, starting from the MD5 initial state. Each of 'blocks' holds a padded message as
+ * sixteen little-endian words. Returns the first two words of each digest, which hash64() reads.
+ */
+void md5FourBlocks(const uint32_t blocks[4][16], uint64_t out[4]) {
+    __m128i x[16];
+    for (int k = 0; k < 16; ++k) {
+        x[k] = _mm_set_epi32(blocks[3][k], blocks[2][k], blocks[1][k], blocks[0][k]);
+    }
+
+    const __m128i initA = _mm_set1_epi32(0x67452301);
+    const __m128i initB = _mm_set1_epi32(0xefcdab89);
+    const __m128i initC = _mm_set1_epi32(0x98badcfe);
+    const __m128i initD = _mm_set1_epi32(0x10325476);
+    const __m128i ones = _mm_set1_epi32(-1);
+    __m128i a = initA, b = initB, c = initC, d = initD;
+
+#define MD5X4_F(x, y, z) _mm_xor_si128(z, _mm_and_si128(x, _mm_xor_si128(y, z)))
+#define MD5X4_G(x, y, z) _mm_xor_si128(y, _mm_and_si128(z, _mm_xor_si128(x, y)))
+#define MD5X4_H(x, y, z) _mm_xor_si128(_mm_xor_si128(x, y), z)
+#define MD5X4_I(x, y, z) _mm_xor_si128(y, _mm_or_si128(x, _mm_xor_si128(z, ones)))
+#define MD5X4_STEP(f, a, b, c, d, k, s, t)                                                  \
+    a = _mm_add_epi32(_mm_add_epi32(a, x[k]),                                              \
+                      _mm_add_epi32(_mm_set1_epi32(static_cast<int32_t>(t)), f(b, c, d))); \
+    a = _mm_add_epi32(_mm_or_si128(_mm_slli_epi32(a, s), _mm_srli_epi32(a, 32 - s)), b)
+
+    MD5X4_STEP(MD5X4_F, a, b, c, d, 0, 7, 0xd76aa478);
+    MD5X4_STEP(MD5X4_F, d, a, b, c, 1, 12, 0xe8c7b756);
+    MD5X4_STEP(MD5X4_F, c, d, a, b, 2, 17, 0x242070db);
+    MD5X4_STEP(MD5X4_F, b, c, d, a, 3, 22, 0xc1bdceee);
+    MD5X4_STEP(MD5X4_F, a, b, c, d, 4, 7, 0xf57c0faf);
+    MD5X4_STEP(MD5X4_F, d, a, b, c, 5, 12, 0x4787c62a);
+    MD5X4_STEP(MD5X4_F, c, d, a, b, 6, 17, 0xa8304613);
+    MD5X4_STEP(MD5X4_F, b, c, d, a, 7, 22, 0xfd469501);
+    MD5X4_STEP(MD5X4_F, a, b, c, d, 8, 7, 0x698098d8);
+    MD5X4_STEP(MD5X4_F, d, a, b, c, 9, 12, 0x8b44f7af);
+    MD5X4_STEP(MD5X4_F, c, d, a, b, 10, 17, 0xffff5bb1);
+    MD5X4_STEP(MD5X4_F, b, c, d, a, 11, 22, 0x895cd7be);
+    MD5X4_STEP(MD5X4_F, a, b, c, d, 12, 7, 0x6b901122);
+    MD5X4_STEP(MD5X4_F, d, a, b, c, 13, 12, 0xfd987193);
+    MD5X4_STEP(MD5X4_F, c, d, a, b, 14, 17, 0xa679438e);
+    MD5X4_STEP(MD5X4_F, b, c, d, a, 15, 22, 0x49b40821);
+
+    MD5X4_STEP(MD5X4_G, a, b, c, d, 1, 5, 0xf61e2562);
+    MD5X4_STEP(MD5X4_G, d, a, b, c, 6, 9, 0xc040b340);
+    MD5X4_STEP(MD5X4_G, c, d, a, b, 11, 14, 0x265e5a51);
+    MD5X4_STEP(MD5X4_G, b, c, d, a, 0, 20, 0xe9b6c7aa);
+    MD5X4_STEP(MD5X4_G, a, b, c, d, 5, 5, 0xd62f105d);
+    MD5X4_STEP(MD5X4_G, d, a, b, c, 10, 9, 0x02441453);
+    MD5X4_STEP(MD5X4_G, c, d, a, b, 15, 14, 0xd8a1e681);
+    MD5X4_STEP(MD5X4_G, b, c, d, a, 4, 20, 0xe7d3fbc8);
+    MD5X4_STEP(MD5X4_G, a, b, c, d, 9, 5, 0x21e1cde6);
+    MD5X4_STEP(MD5X4_G, d, a, b, c, 14, 9, 0xc33707d6);
+    MD5X4_STEP(MD5X4_G, c, d, a, b, 3, 14, 0xf4d50d87);
+    MD5X4_STEP(MD5X4_G, b, c, d, a, 8, 20, 0x455a14ed);
+    MD5X4_STEP(MD5X4_G, a, b, c, d, 13, 5, 0xa9e3e905);
+    MD5X4_STEP(MD5X4_G, d, a, b, c, 2, 9, 0xfcefa3f8);
+    MD5X4_STEP(MD5X4_G, c, d, a, b, 7, 14, 0x676f02d9);
+    MD5X4_STEP(MD5X4_G, b, c, d, a, 12, 20, 0x8d2a4c8a);
+
+    MD5X4_STEP(MD5X4_H, a, b, c, d, 5, 4, 0xfffa3942);
+    MD5X4_STEP(MD5X4_H, d, a, b, c, 8, 11, 0x8771f681);
+    MD5X4_STEP(MD5X4_H, c, d, a, b, 11, 16, 0x6d9d6122);
+    MD5X4_STEP(MD5X4_H, b, c, d, a, 14, 23, 0xfde5380c);
+    MD5X4_STEP(MD5X4_H, a, b, c, d, 1, 4, 0xa4beea44);
+    MD5X4_STEP(MD5X4_H, d, a, b, c, 4, 11, 0x4bdecfa9);
+    MD5X4_STEP(MD5X4_H, c, d, a, b, 7, 16, 0xf6bb4b60);
+    MD5X4_STEP(MD5X4_H, b, c, d, a, 10, 23, 0xbebfbc70);
+    MD5X4_STEP(MD5X4_H, a, b, c, d, 13, 4, 0x289b7ec6);
+    MD5X4_STEP(MD5X4_H, d, a, b, c, 0, 11, 0xeaa127fa);
+    MD5X4_STEP(MD5X4_H, c, d, a, b, 3, 16, 0xd4ef3085);
+    MD5X4_STEP(MD5X4_H, b, c, d, a, 6, 23, 0x04881d05);
+    MD5X4_STEP(MD5X4_H, a, b, c, d, 9, 4, 0xd9d4d039);
+    MD5X4_STEP(MD5X4_H, d, a, b, c, 12, 11, 0xe6db99e5);
+    MD5X4_STEP(MD5X4_H, c, d, a, b, 15, 16, 0x1fa27cf8);
+    MD5X4_STEP(MD5X4_H, b, c, d, a, 2, 23, 0xc4ac5665);
+
+    MD5X4_STEP(MD5X4_I, a, b, c, d, 0, 6, 0xf4292244);
+    MD5X4_STEP(MD5X4_I, d, a, b, c, 7, 10, 0x432aff97);
+    MD5X4_STEP(MD5X4_I, c, d, a, b, 14, 15, 0xab9423a7);
+    MD5X4_STEP(MD5X4_I, b, c, d, a, 5, 21, 0xfc93a039);
+    MD5X4_STEP(MD5X4_I, a, b, c, d, 12, 6, 0x655b59c3);
+    MD5X4_STEP(MD5X4_I, d, a, b, c, 3, 10, 0x8f0ccc92);
+    MD5X4_STEP(MD5X4_I, c, d, a, b, 10, 15, 0xffeff47d);
+    MD5X4_STEP(MD5X4_I, b, c, d, a, 1, 21, 0x85845dd1);
+    MD5X4_STEP(MD5X4_I, a, b, c, d, 8, 6, 0x6fa87e4f);
+    MD5X4_STEP(MD5X4_I, d, a, b, c, 15, 10, 0xfe2ce6e0);
+    MD5X4_STEP(MD5X4_I, c, d, a, b, 6, 15, 0xa3014314);
+    MD5X4_STEP(MD5X4_I, b, c, d, a, 13, 21, 0x4e0811a1);
+    MD5X4_STEP(MD5X4_I, a, b, c, d, 4, 6, 0xf7537e82);
+    MD5X4_STEP(MD5X4_I, d, a, b, c, 11, 10, 0xbd3af235);
+    MD5X4_STEP(MD5X4_I, c, d, a, b, 2, 15, 0x2ad7d2bb);
+    MD5X4_STEP(MD5X4_I, b, c, d, a, 9, 21, 0xeb86d391);
+
+#undef MD5X4_STEP
+#undef MD5X4_I
+#undef MD5X4_H
+#undef MD5X4_G
+#undef MD5X4_F
+
+    alignas(16) uint32_t lowWords[4];
+    alignas(16) uint32_t highWords[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lowWords), _mm_add_epi32(a, initA));
+    _mm_store_si128(reinterpret_cast<__m128i*>(highWords), _mm_add_epi32(b, initB));
+    for (int lane = 0; lane < 4; ++lane) {
+        out[lane] = (static_cast<uint64_t>(highWords[lane]) << 32) | lowWords[lane];
+    }
+}
+#endif
+
+template <typename HashInput>
+void recursiveHash(HashInput* h, const BSONElement& e, bool includeFieldName) {
     int canonicalType = endian::nativeToLittle(e.canonicalType());
     h->addData(&canonicalType, sizeof(canonicalType));
 
@@ -148,4 +327,48 @@ long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
     return digestView.read<LittleEndian<long long int>>();
 }
 
+std::vector<long long int> BSONElementHasher::hash64(const std::vector<BSONElement>& elements,
+                                                     HashSeed seed) {
+    std::vector<long long int> hashes(elements.size());
+#if defined(__SSE2__)
+    // The elements whose hash input fits in one MD5 block are hashed four at a time.
+    uint32_t blocks[4][16];
+    size_t lanes[4];
+    size_t numLanes = 0;
+    for (size_t i = 0; i < elements.size(); ++i) {
+        // Don't walk large values just to find out that they need more than one block.
+        if (elements[i].valuesize() > static_cast<int>(SingleBlockHashInput::kMaxSize)) {
+            hashes[i] = hash64(elements[i], seed);
+            continue;
+        }
+
+        SingleBlockHashInput input(seed);
+        recursiveHash(&input, elements[i], false);
+        if (!input.fits()) {
+            hashes[i] = hash64(elements[i], seed);
+            continue;
+        }
+
+        input.pad(blocks[numLanes]);
+        lanes[numLanes++] = i;
+        if (numLanes == 4) {
+            uint64_t digests[4];
+            md5FourBlocks(blocks, digests);
+            for (size_t lane = 0; lane < 4; ++lane) {
+                hashes[lanes[lane]] = static_cast<long long int>(digests[lane]);
+            }
+            numLanes = 0;
+        }
+    }
+    for (size_t lane = 0; lane < numLanes; ++lane) {
+        hashes[lanes[lane]] = hash64(elements[lanes[lane]], seed);
+    }
+#else
+    for (size_t i = 0; i < elements.size(); ++i) {
+        hashes[i] = hash64(elements[i], seed);
+    }
+#endif
+    return hashes;
+}
+
 }  // namespace mongo
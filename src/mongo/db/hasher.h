@@ -34,6 +34,8 @@
  */
 
 
+#include <vector>
+
 #include "mongo/bson/bsonelement.h"
 
 namespace mongo {
@@ -68,6 +70,12 @@ public:
      */
     static long long int hash64(const BSONElement& e, HashSeed seed);
 
+    /* Computes hash64() of each of 'elements'. Hashing many small values together is faster, as
+     * their MD5 digests are computed several at a time where the CPU allows it.
+     */
+    static std::vector<long long int> hash64(const std::vector<BSONElement>& elements,
+                                             HashSeed seed);
+
 private:
     BSONElementHasher();
 };
@@ -371,5 +371,33 @@ TEST(BSONElementHasher, HashWithNonZeroSeed) {
     ASSERT_EQUALS(hashIt(o, seed), -9222615859251096151LL);
 }
 
+TEST(BSONElementHasher, HashManyMatchesHashOne) {
+    BSONArrayBuilder builder;
+    for (int i = 0; i < 9; ++i) {
+        builder.append(i);
+        builder.append(i * 0.5);
+        builder.append(std::string(i * 7, 'a'));
+        builder.append(BSON("x" << i << "y" << BSON_ARRAY("z" << BSONNULL)));
+    }
+    builder.append(std::string(200, 'b'));
+    builder.append(BSON("big" << std::string(100, 'c')));
+    builder.appendNull();
+    builder.append(OID::gen());
+    BSONObj values = builder.arr();
+
+    std::vector<BSONElement> elements;
+    for (auto&& element : values) {
+        elements.push_back(element);
+    }
+
+    for (HashSeed seed : {0, 40513}) {
+        auto hashes = BSONElementHasher::hash64(elements, seed);
+        ASSERT_EQ(hashes.size(), elements.size());
+        for (size_t i = 0; i < elements.size(); ++i) {
+            ASSERT_EQ(hashes[i], BSONElementHasher::hash64(elements[i], seed)) << elements[i];
+        }
+    }
+}
+
 }  // namespace
 }  // namespace mongo
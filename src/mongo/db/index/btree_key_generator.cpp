@@ -85,6 +85,19 @@ BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path) {
     // "a.b".
     return kEmptyElt;
 }
+
+template <class BuilderT>
+void appendToKeyString(const BSONElement& elem,
+                       const CollatorInterface* collator,
+                       BuilderT* keyString) {
+    if (collator) {
+        keyString->appendBSONElement(elem, [&](StringData stringData) {
+            return collator->getComparisonString(stringData);
+        });
+    } else {
+        keyString->appendBSONElement(elem);
+    }
+}
 }  // namespace
 
 BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
@@ -175,7 +188,9 @@ void BtreeKeyGenerator::_getKeysArrEltFixed(const std::vector<const char*>& fiel
                                             bool mayExpandArrayUnembedded,
                                             const std::vector<PositionalPathInfo>& positionalInfo,
                                             MultikeyPaths* multikeyPaths,
-                                            boost::optional<RecordId> id) const {
+                                            boost::optional<RecordId> id,
+                                            const KeyString::Builder& prefix,
+                                            size_t prefixLen) const {
     // fieldNamesTemp and fixedTemp are passed in by the caller to be used as temporary data
     // structures as we need them to be mutable in the recursion. When they are stored outside we
     // can reuse their memory.
@@ -202,7 +217,25 @@ void BtreeKeyGenerator::_getKeysArrEltFixed(const std::vector<const char*>& fiel
                       numNotFound,
                       positionalInfo,
                       multikeyPaths,
-                      id);
+                      id,
+                      prefix,
+                      prefixLen);
+}
+
+size_t BtreeKeyGenerator::_extendKeyPrefix(const std::vector<const char*>& fieldNames,
+                                           const std::vector<BSONElement>& fixed,
+                                           const std::set<size_t>& arrIdxs,
+                                           const KeyString::Builder& prefix,
+                                           size_t prefixLen,
+                                           KeyString::Builder* extendedPrefix) const {
+    extendedPrefix->resetFromPrefix(prefix);
+    for (; prefixLen < fixed.size(); ++prefixLen) {
+        if (*fieldNames[prefixLen] != '\0' || arrIdxs.count(prefixLen)) {
+            break;
+        }
+        appendToKeyString(fixed[prefixLen], _collator, extendedPrefix);
+    }
+    return prefixLen;
 }
 
 void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
@@ -258,6 +291,7 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
         // '_fieldNames' and '_fixed' are mutated by _getKeysWithArray so pass in copies
         auto fieldNamesCopy = _fieldNames;
         auto fixedCopy = _fixed;
+        KeyString::Builder emptyPrefix(_keyStringVersion, _ordering);
         _getKeysWithArray(&fieldNamesCopy,
                           &fixedCopy,
                           pooledBufferBuilder,
@@ -266,7 +300,9 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
                           0,
                           _emptyPositionalInfo,
                           multikeyPaths,
-                          id);
+                          id,
+                          emptyPrefix,
+                          0);
         // Put the sequence back into the set, it will sort and guarantee uniqueness, this is
         // O(NlogN)
         keys->adopt_sequence(std::move(seq));
@@ -318,7 +354,9 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                                           unsigned numNotFound,
                                           const std::vector<PositionalPathInfo>& positionalInfo,
                                           MultikeyPaths* multikeyPaths,
-                                          boost::optional<RecordId> id) const {
+                                          boost::optional<RecordId> id,
+                                          const KeyString::Builder& prefix,
+                                          size_t prefixLen) const {
     BSONElement arrElt;
 
     // A set containing the position of any indexed fields in the key pattern that traverse through
@@ -388,14 +426,9 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
             return;
         }
         KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
-        for (const auto& elem : *fixed) {
-            if (_collator) {
-                keyString.appendBSONElement(elem, [&](StringData stringData) {
-                    return _collator->getComparisonString(stringData);
-                });
-            } else {
-                keyString.appendBSONElement(elem);
-            }
+        keyString.resetFromPrefix(prefix);
+        for (size_t i = prefixLen; i < fixed->size(); ++i) {
+            appendToKeyString((*fixed)[i], _collator, &keyString);
         }
         if (id) {
             keyString.appendRecordId(*id);
@@ -421,6 +454,9 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
         // For an empty array, set matching fields to undefined.
         std::vector<const char*> fieldNamesTemp;
         std::vector<BSONElement> fixedTemp;
+        KeyString::Builder arrPrefix(_keyStringVersion);
+        const size_t arrPrefixLen =
+            _extendKeyPrefix(*fieldNames, *fixed, arrIdxs, prefix, prefixLen, &arrPrefix);
         _getKeysArrEltFixed(*fieldNames,
                             *fixed,
                             &fieldNamesTemp,
@@ -434,7 +470,9 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                             true,
                             _emptyPositionalInfo,
                             multikeyPaths,
-                            id);
+                            id,
+                            arrPrefix,
+                            arrPrefixLen);
     } else {
         BSONObj arrObj = arrElt.embeddedObject();
 
@@ -505,9 +543,13 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                 arrObj, subPositionalInfo[i].remainingPath);
         }
 
-        // Generate a key for each element of the indexed array.
+        // Generate a key for each element of the indexed array. The components which don't depend
+        // on the array element are encoded once up front and shared by all of them.
         std::vector<const char*> fieldNamesTemp;
         std::vector<BSONElement> fixedTemp;
+        KeyString::Builder arrPrefix(_keyStringVersion);
+        const size_t arrPrefixLen =
+            _extendKeyPrefix(*fieldNames, *fixed, arrIdxs, prefix, prefixLen, &arrPrefix);
         for (const auto& arrObjElem : arrObj) {
             _getKeysArrEltFixed(*fieldNames,
                                 *fixed,
@@ -522,7 +564,9 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                                 mayExpandArrayUnembedded,
                                 subPositionalInfo,
                                 multikeyPaths,
-                                id);
+                                id,
+                                arrPrefix,
+                                arrPrefixLen);
         }
     }
 
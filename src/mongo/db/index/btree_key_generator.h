@@ -151,6 +151,9 @@ private:
     /**
      * This recursive method does the heavy-lifting for getKeys().
      * It will modify 'fieldNames' and 'fixed'.
+     *
+     * 'prefix' holds the encoding of the first 'prefixLen' elements of 'fixed', which are the same
+     * for every key generated by this call.
      */
     void _getKeysWithArray(std::vector<const char*>* fieldNames,
                            std::vector<BSONElement>* fixed,
@@ -160,7 +163,22 @@ private:
                            unsigned numNotFound,
                            const std::vector<PositionalPathInfo>& positionalInfo,
                            MultikeyPaths* multikeyPaths,
-                           boost::optional<RecordId> id) const;
+                           boost::optional<RecordId> id,
+                           const KeyString::Builder& prefix,
+                           size_t prefixLen) const;
+
+    /**
+     * Sets 'extendedPrefix' to 'prefix' followed by the encoding of each element of 'fixed' from
+     * 'prefixLen' up to the first field which has yet to be traversed to its end or which goes
+     * through an array in 'arrIdxs', and returns the number of elements it encodes. Those elements
+     * are the same for every key generated from the array being expanded.
+     */
+    size_t _extendKeyPrefix(const std::vector<const char*>& fieldNames,
+                            const std::vector<BSONElement>& fixed,
+                            const std::set<size_t>& arrIdxs,
+                            const KeyString::Builder& prefix,
+                            size_t prefixLen,
+                            KeyString::Builder* extendedPrefix) const;
 
     /**
      * An optimized version of the key generation algorithm to be used when it is known that 'obj'
@@ -229,7 +247,9 @@ private:
                              bool mayExpandArrayUnembedded,
                              const std::vector<PositionalPathInfo>& positionalInfo,
                              MultikeyPaths* multikeyPaths,
-                             boost::optional<RecordId> id) const;
+                             boost::optional<RecordId> id,
+                             const KeyString::Builder& prefix,
+                             size_t prefixLen) const;
 
     KeyString::Value _buildNullKeyString() const;
 
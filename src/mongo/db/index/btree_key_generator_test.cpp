@@ -1421,4 +1421,20 @@ TEST(BtreeKeyGeneratorTest, GetCollationAwareKeysFromNestedArray) {
         testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
 }
 
+TEST(BtreeKeyGeneratorTest, GetCollationAwareCompoundKeysSharingLeadingComponents) {
+    BSONObj keyPattern = fromjson("{a: 1, 'b.c': 1, d: 1}");
+    BSONObj genKeysFrom = fromjson("{a: 'foo', b: [{c: 'x'}, {c: 'y'}], d: 'bar'}");
+    KeyString::HeapBuilder keyString1(KeyString::Version::kLatestVersion,
+                                      fromjson("{'': 'oof', '': 'x', '': 'rab'}"),
+                                      Ordering::make(BSONObj()));
+    KeyString::HeapBuilder keyString2(KeyString::Version::kLatestVersion,
+                                      fromjson("{'': 'oof', '': 'y', '': 'rab'}"),
+                                      Ordering::make(BSONObj()));
+    KeyStringSet expectedKeys{keyString1.release(), keyString2.release()};
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    MultikeyPaths expectedMultikeyPaths{MultikeyComponents{}, {0U}, MultikeyComponents{}};
+    ASSERT(
+        testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
+}
+
 }  // namespace
@@ -0,0 +1,211 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_store_access_method.h"
+
+#include <algorithm>
+
+#include "mongo/db/catalog/index_catalog_entry.h"
+#include "mongo/db/storage/index_entry_comparison.h"
+
+namespace mongo {
+namespace {
+/**
+ * Returns the rank and the value held by an entry of an indexed field, as laid out by
+ * ColumnStoreKeyGenerator.
+ */
+std::pair<long long, BSONElement> parseFieldEntry(const BSONObj& key) {
+    BSONObjIterator it(key);
+    it.next();  // The field name.
+    it.next();  // The RecordId.
+    auto rank = it.next().numberLong();
+    return {rank, it.next()};
+}
+}  // namespace
+
+ColumnStoreAccessMethod::RowCursor::RowCursor(OperationContext* opCtx,
+                                              const SortedDataInterface* sdi,
+                                              const std::vector<std::string>& fields)
+    : _sdi(sdi) {
+    auto makeColumn = [&](StringData field) {
+        Column column;
+        column.field = field.toString();
+        column.cursor = _sdi->newCursor(opCtx);
+        column.cursor->setEndPosition(BSON("" << field), true);
+        return column;
+    };
+
+    _rows = makeColumn(ColumnStoreKeyGenerator::kRowColumn);
+    _columns.reserve(fields.size());
+    for (auto&& field : fields) {
+        _columns.push_back(makeColumn(field));
+    }
+}
+
+void ColumnStoreAccessMethod::RowCursor::seek(Column* column, const BSONObj& key, bool inclusive) {
+    column->entry = column->cursor->seek(IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+        key, _sdi->getKeyStringVersion(), _sdi->getOrdering(), true /* forward */, inclusive));
+    if (column->entry) {
+        ++_keysExamined;
+    }
+}
+
+void ColumnStoreAccessMethod::RowCursor::seekPastLastReturned(Column* column) {
+    if (_lastReturned) {
+        seek(column, ColumnStoreKeyGenerator::makeSeekKey(column->field, *_lastReturned), false);
+    } else {
+        seek(column, BSON("" << column->field), true);
+    }
+}
+
+void ColumnStoreAccessMethod::RowCursor::advanceTo(Column* column, const RecordId& id) {
+    // The column is usually dense, in which case its next entry is the one we want and stepping is
+    // cheaper than seeking. A column which is still behind after one step is sparse around 'id', so
+    // seek instead of walking the gap.
+    if (column->entry && column->entry->loc < id) {
+        column->entry = column->cursor->next();
+        if (column->entry) {
+            ++_keysExamined;
+        }
+    }
+    if (column->entry && column->entry->loc < id) {
+        seek(column, ColumnStoreKeyGenerator::makeSeekKey(column->field, id), true);
+    }
+}
+
+boost::optional<RecordId> ColumnStoreAccessMethod::RowCursor::next(BSONObjBuilder* row) {
+    if (_eof) {
+        return boost::none;
+    }
+
+    // Until this call completes, an exception may leave the cursors anywhere.
+    if (std::exchange(_needsReposition, true)) {
+        seekPastLastReturned(&_rows);
+        for (auto&& column : _columns) {
+            seekPastLastReturned(&column);
+        }
+    } else {
+        _rows.entry = _rows.cursor->next();
+        if (_rows.entry) {
+            ++_keysExamined;
+        }
+    }
+
+    if (!_rows.entry) {
+        _eof = true;
+        _needsReposition = false;
+        return boost::none;
+    }
+
+    const RecordId id = _rows.entry->loc;
+    std::vector<std::pair<long long, const Column*>> present;
+    for (auto&& column : _columns) {
+        advanceTo(&column, id);
+        if (column.entry && column.entry->loc == id) {
+            present.emplace_back(parseFieldEntry(column.entry->key).first, &column);
+        }
+    }
+
+    std::sort(present.begin(), present.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+    for (auto&& [rank, column] : present) {
+        row->appendAs(parseFieldEntry(column->entry->key).second, column->field);
+    }
+
+    _lastReturned = id;
+    _needsReposition = false;
+    return id;
+}
+
+void ColumnStoreAccessMethod::RowCursor::save() {
+    _rows.cursor->save();
+    for (auto&& column : _columns) {
+        column.cursor->save();
+    }
+
+    // Documents may change while we are yielded, so the cursors are repositioned past the last row
+    // returned rather than trusting the entries read before the yield.
+    _needsReposition = true;
+}
+
+void ColumnStoreAccessMethod::RowCursor::restore() {
+    _rows.cursor->restore();
+    for (auto&& column : _columns) {
+        column.cursor->restore();
+    }
+}
+
+void ColumnStoreAccessMethod::RowCursor::detachFromOperationContext() {
+    _rows.cursor->detachFromOperationContext();
+    for (auto&& column : _columns) {
+        column.cursor->detachFromOperationContext();
+    }
+}
+
+void ColumnStoreAccessMethod::RowCursor::reattachToOperationContext(OperationContext* opCtx) {
+    _rows.cursor->reattachToOperationContext(opCtx);
+    for (auto&& column : _columns) {
+        column.cursor->reattachToOperationContext(opCtx);
+    }
+}
+
+ColumnStoreAccessMethod::ColumnStoreAccessMethod(IndexCatalogEntry* columnState,
+                                                 std::unique_ptr<SortedDataInterface> sdi)
+    : AbstractIndexAccessMethod(columnState, std::move(sdi)),
+      _keyGen(_descriptor->keyPattern(),
+              getSortedDataInterface()->getKeyStringVersion(),
+              getSortedDataInterface()->getOrdering()) {}
+
+bool ColumnStoreAccessMethod::shouldMarkIndexAsMultikey(size_t numberOfKeys,
+                                                        const KeyStringSet& multikeyMetadataKeys,
+                                                        const MultikeyPaths& multikeyPaths) const {
+    return false;
+}
+
+std::unique_ptr<ColumnStoreAccessMethod::RowCursor> ColumnStoreAccessMethod::newRowCursor(
+    OperationContext* opCtx, const std::vector<std::string>& fields) const {
+    return std::make_unique<RowCursor>(opCtx, getSortedDataInterface(), fields);
+}
+
+void ColumnStoreAccessMethod::doGetKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                        const BSONObj& obj,
+                                        GetKeysContext context,
+                                        KeyStringSet* keys,
+                                        KeyStringSet* multikeyMetadataKeys,
+                                        MultikeyPaths* multikeyPaths,
+                                        boost::optional<RecordId> id) const {
+    // Every entry of a columnstore index is keyed by the RecordId of its document.
+    invariant(id);
+    _keyGen.getKeys(pooledBufferBuilder, obj, *id, keys);
+}
+
+}  // namespace mongo
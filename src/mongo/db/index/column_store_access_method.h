@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/index/column_store_key_generator.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+/**
+ * This is the access method for "columnstore" indexes, whose keys are described by
+ * ColumnStoreKeyGenerator. A columnstore index cannot answer predicates or provide a sort. Instead,
+ * a query which only reads indexed fields can scan the columns it needs through a RowCursor rather
+ * than reading and decoding whole documents from the collection.
+ */
+class ColumnStoreAccessMethod final : public AbstractIndexAccessMethod {
+public:
+    /**
+     * Reads the rows of the collection, restricted to a set of indexed fields, out of a columnstore
+     * index in RecordId order.
+     *
+     * The cursor walks the row column, which has an entry for every document, and advances one
+     * cursor per requested field in step with it. After a yield it repositions every cursor past
+     * the last row it returned, so that the fields of a row are always read from the same snapshot.
+     */
+    class RowCursor {
+    public:
+        RowCursor(OperationContext* opCtx,
+                  const SortedDataInterface* sdi,
+                  const std::vector<std::string>& fields);
+
+        /**
+         * Advances to the next document of the collection, appends the requested fields which it
+         * holds to 'row' in the order in which they appear in the document, and returns its
+         * RecordId. Returns boost::none once every document has been read.
+         *
+         * May throw WriteConflictException, in which case the call can be retried after a yield.
+         */
+        boost::optional<RecordId> next(BSONObjBuilder* row);
+
+        void save();
+        void restore();
+        void detachFromOperationContext();
+        void reattachToOperationContext(OperationContext* opCtx);
+
+        /**
+         * Returns the number of index entries read so far.
+         */
+        size_t keysExamined() const {
+            return _keysExamined;
+        }
+
+    private:
+        struct Column {
+            std::string field;
+            std::unique_ptr<SortedDataInterface::Cursor> cursor;
+            boost::optional<IndexKeyEntry> entry;
+        };
+
+        void seek(Column* column, const BSONObj& key, bool inclusive);
+        void seekPastLastReturned(Column* column);
+        void advanceTo(Column* column, const RecordId& id);
+
+        const SortedDataInterface* const _sdi;
+
+        Column _rows;
+        std::vector<Column> _columns;
+
+        // The RecordId of the last row returned, if any.
+        boost::optional<RecordId> _lastReturned;
+
+        // Set when the cursors may no longer be positioned in step with '_lastReturned', such as
+        // after a yield or an exception, so that the next call repositions all of them.
+        bool _needsReposition = true;
+
+        bool _eof = false;
+
+        size_t _keysExamined = 0;
+    };
+
+    ColumnStoreAccessMethod(IndexCatalogEntry* columnState,
+                            std::unique_ptr<SortedDataInterface> sdi);
+
+    /**
+     * Columnstore indexes never become multikey: an array is stored whole, as the value of the
+     * field which holds it.
+     */
+    bool shouldMarkIndexAsMultikey(size_t numberOfKeys,
+                                   const KeyStringSet& multikeyMetadataKeys,
+                                   const MultikeyPaths& multikeyPaths) const final;
+
+    /**
+     * Returns the top-level fields stored by this index.
+     */
+    const std::vector<std::string>& getFields() const {
+        return _keyGen.getFields();
+    }
+
+    /**
+     * Returns a cursor over the rows of the collection restricted to 'fields', each of which must
+     * be stored by this index.
+     */
+    std::unique_ptr<RowCursor> newRowCursor(OperationContext* opCtx,
+                                            const std::vector<std::string>& fields) const;
+
+private:
+    void doGetKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                   const BSONObj& obj,
+                   GetKeysContext context,
+                   KeyStringSet* keys,
+                   KeyStringSet* multikeyMetadataKeys,
+                   MultikeyPaths* multikeyPaths,
+                   boost::optional<RecordId> id) const final;
+
+    const ColumnStoreKeyGenerator _keyGen;
+};
+
+}  // namespace mongo
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_store_key_generator.h"
+
+namespace mongo {
+
+constexpr StringData ColumnStoreKeyGenerator::kRowColumn;
+
+ColumnStoreKeyGenerator::ColumnStoreKeyGenerator(const BSONObj& keyPattern,
+                                                 KeyString::Version keyStringVersion,
+                                                 Ordering ordering)
+    : _keyStringVersion(keyStringVersion), _ordering(ordering) {
+    for (auto&& elem : keyPattern) {
+        if (_fieldSet.insert(elem.fieldName()).second) {
+            _fields.push_back(elem.fieldName());
+        }
+    }
+}
+
+void ColumnStoreKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                      const BSONObj& obj,
+                                      const RecordId& id,
+                                      KeyStringSet* keys) const {
+    {
+        KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
+        keyString.appendString(kRowColumn);
+        keyString.appendNumberLong(id.repr());
+        keyString.appendRecordId(id);
+        keys->insert(keyString.release());
+    }
+
+    // Only the first occurrence of a field is indexed if the document holds duplicate field names,
+    // since that is the one a query on the field reads.
+    StringSet seen;
+    long long rank = 0;
+    for (auto&& elem : obj) {
+        auto fieldName = elem.fieldNameStringData();
+        if (!_fieldSet.count(fieldName) || !seen.insert(fieldName.toString()).second) {
+            continue;
+        }
+
+        KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
+        keyString.appendString(fieldName);
+        keyString.appendNumberLong(id.repr());
+        keyString.appendNumberLong(rank++);
+        keyString.appendBSONElement(elem);
+        keyString.appendRecordId(id);
+        keys->insert(keyString.release());
+
+        if (seen.size() == _fields.size()) {
+            break;
+        }
+    }
+}
+
+BSONObj ColumnStoreKeyGenerator::makeSeekKey(StringData column, const RecordId& id) {
+    return BSON("" << column << "" << id.repr());
+}
+
+}  // namespace mongo
@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * Generates the keys of a "columnstore" index, created with a key pattern such as
+ * { a: "columnstore", b: "columnstore" } which names the top-level fields to store.
+ *
+ * Rather than one key per document, the index holds one entry per indexed field present in a
+ * document, keyed so that the entries of a field are contiguous and in RecordId order:
+ *      { '': <field name>, '': NumberLong(<RecordId>), '': NumberLong(<rank>), '': <value> }
+ * The 'rank' of an entry is the number of indexed fields which precede the field in the document,
+ * and lets a reader put the fields of a row back in document order. Every document also gets one
+ * row entry, whether or not it holds any of the indexed fields:
+ *      { '': "", '': NumberLong(<RecordId>) }
+ *
+ * Values are stored exactly as they appear in the document. No collation is applied, and arrays
+ * and subdocuments are stored whole, so that a row read back from the index is equal to the same
+ * fields taken from the document.
+ */
+class ColumnStoreKeyGenerator {
+public:
+    // The name of the column which holds the row entries. Index key patterns cannot name an empty
+    // field, so it never collides with an indexed field.
+    static constexpr StringData kRowColumn = ""_sd;
+
+    ColumnStoreKeyGenerator(const BSONObj& keyPattern,
+                            KeyString::Version keyStringVersion,
+                            Ordering ordering);
+
+    /**
+     * Returns the indexed top-level fields, in key pattern order.
+     */
+    const std::vector<std::string>& getFields() const {
+        return _fields;
+    }
+
+    /**
+     * Adds the row entry and one entry for each indexed field of 'obj' to 'keys'.
+     */
+    void getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                 const BSONObj& obj,
+                 const RecordId& id,
+                 KeyStringSet* keys) const;
+
+    /**
+     * Returns the key prefix of the entry of 'column' which belongs to the document with RecordId
+     * 'id'.
+     */
+    static BSONObj makeSeekKey(StringData column, const RecordId& id);
+
+private:
+    std::vector<std::string> _fields;
+    StringSet _fieldSet;
+    const KeyString::Version _keyStringVersion;
+    const Ordering _ordering;
+};
+
+}  // namespace mongo
@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/index/column_store_key_generator.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const RecordId kRecordId(17);
+
+KeyStringSet makeKeySet(std::initializer_list<BSONObj> init) {
+    KeyStringSet keys;
+    Ordering ordering = Ordering::make(BSONObj());
+    for (const auto& key : init) {
+        KeyString::HeapBuilder keyString(KeyString::Version::kLatestVersion, key, ordering);
+        keyString.appendRecordId(kRecordId);
+        keys.insert(keyString.release());
+    }
+    return keys;
+}
+
+std::string dumpKeyset(const KeyStringSet& keyStrings) {
+    std::stringstream ss;
+    ss << "[ ";
+    for (auto& keyString : keyStrings) {
+        ss << KeyString::toBson(keyString, Ordering::make(BSONObj())).toString() << " ";
+    }
+    ss << "]";
+    return ss.str();
+}
+
+BSONObj rowKey() {
+    return BSON("" << ColumnStoreKeyGenerator::kRowColumn << "" << kRecordId.repr());
+}
+
+BSONObj fieldKey(StringData field, long long rank, const BSONObj& value) {
+    BSONObjBuilder bob;
+    bob.append("", field);
+    bob.append("", kRecordId.repr());
+    bob.append("", rank);
+    bob.appendAs(value.firstElement(), "");
+    return bob.obj();
+}
+
+struct ColumnStoreKeyGeneratorTest : public unittest::Test {
+    KeyStringSet getKeys(const BSONObj& keyPattern, const BSONObj& doc) {
+        ColumnStoreKeyGenerator keyGen{
+            keyPattern, KeyString::Version::kLatestVersion, Ordering::make(BSONObj())};
+        KeyStringSet keys;
+        keyGen.getKeys(allocator, doc, kRecordId, &keys);
+        return keys;
+    }
+
+    SharedBufferFragmentBuilder allocator{KeyString::HeapBuilder::kHeapAllocatorDefaultBytes};
+};
+
+TEST_F(ColumnStoreKeyGeneratorTest, IndexesEveryStoredField) {
+    auto keys = getKeys(fromjson("{a: 'columnstore', b: 'columnstore'}"),
+                        fromjson("{b: 'x', c: 3, a: [1, {d: 2}]}"));
+    auto expected = makeKeySet({rowKey(),
+                                fieldKey("b", 0, fromjson("{'': 'x'}")),
+                                fieldKey("a", 1, fromjson("{'': [1, {d: 2}]}"))});
+    ASSERT_EQ(dumpKeyset(expected), dumpKeyset(keys));
+    ASSERT(expected == keys);
+}
+
+TEST_F(ColumnStoreKeyGeneratorTest, AlwaysIndexesTheRow) {
+    auto keys = getKeys(fromjson("{a: 'columnstore'}"), fromjson("{b: 1}"));
+    auto expected = makeKeySet({rowKey()});
+    ASSERT_EQ(dumpKeyset(expected), dumpKeyset(keys));
+    ASSERT(expected == keys);
+}
+
+TEST_F(ColumnStoreKeyGeneratorTest, RankCountsOnlyStoredFields) {
+    auto keys = getKeys(fromjson("{a: 'columnstore', c: 'columnstore'}"),
+                        fromjson("{x: 1, c: null, y: 2, a: {}}"));
+    auto expected = makeKeySet({rowKey(),
+                                fieldKey("c", 0, BSON("" << BSONNULL)),
+                                fieldKey("a", 1, BSON("" << BSONObj()))});
+    ASSERT_EQ(dumpKeyset(expected), dumpKeyset(keys));
+    ASSERT(expected == keys);
+}
+
+TEST_F(ColumnStoreKeyGeneratorTest, IndexesOnlyTheFirstOfDuplicateFields) {
+    auto keys = getKeys(fromjson("{a: 'columnstore'}"), BSON("a" << 1 << "a" << 2));
+    auto expected = makeKeySet({rowKey(), fieldKey("a", 0, BSON("" << 1))});
+    ASSERT_EQ(dumpKeyset(expected), dumpKeyset(keys));
+    ASSERT(expected == keys);
+}
+
+TEST_F(ColumnStoreKeyGeneratorTest, IgnoresDuplicateFieldsInTheKeyPattern) {
+    ColumnStoreKeyGenerator keyGen{BSON("a"
+                                        << "columnstore"
+                                        << "b"
+                                        << "columnstore"
+                                        << "a"
+                                        << "columnstore"),
+                                   KeyString::Version::kLatestVersion,
+                                   Ordering::make(BSONObj())};
+    ASSERT_EQ(2U, keyGen.getFields().size());
+    ASSERT_EQ("a", keyGen.getFields()[0]);
+    ASSERT_EQ("b", keyGen.getFields()[1]);
+}
+
+}  // namespace
+}  // namespace mongo
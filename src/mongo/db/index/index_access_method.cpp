@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/btree_access_method.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -88,7 +89,9 @@ SortOptions makeSortOptions(size_t maxMemoryUsageBytes) {
     return SortOptions()
         .TempDir(storageGlobalParams.dbpath + "/_tmp")
         .ExtSortAllowed()
-        .MaxMemoryUsageBytes(maxMemoryUsageBytes);
+        .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+        // Index builds insert keys faster than a run can be sorted and written, so overlap both.
+        .AsyncSpill();
 }
 
 MultikeyPaths createMultikeyPaths(const std::vector<MultikeyPath>& multikeyPathsVec) {
@@ -218,6 +221,61 @@ Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status AbstractIndexAccessMethod::insertBatch(OperationContext* opCtx,
+                                              const CollectionPtr& coll,
+                                              const std::vector<BsonRecord>& bsonRecords,
+                                              const InsertDeleteOptions& options,
+                                              int64_t* numInserted) {
+    invariant(!_descriptor->unique());
+    invariant(!_indexCatalogEntry->isHybridBuilding());
+
+    auto& executionCtx = StorageExecutionContext::get(opCtx);
+
+    // Gather the keys of every document, so that they can be inserted in a single pass over the
+    // index in key order.
+    std::vector<KeyString::Value> batchKeys;
+    size_t numMultikeyMetadataKeys = 0;
+    for (const auto& bsonRecord : bsonRecords) {
+        auto keys = executionCtx.keys();
+        auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
+        auto multikeyPaths = executionCtx.multikeyPaths();
+
+        getKeys(executionCtx.pooledBufferBuilder(),
+                *bsonRecord.docPtr,
+                options.getKeysMode,
+                GetKeysContext::kAddingKeys,
+                keys.get(),
+                multikeyMetadataKeys.get(),
+                multikeyPaths.get(),
+                bsonRecord.id,
+                kNoopOnSuppressedErrorFn);
+
+        batchKeys.insert(batchKeys.end(), keys->begin(), keys->end());
+
+        // Both the keys and the multikey state are written in the same storage transaction, so it
+        // doesn't matter that the index is marked multikey before its keys are inserted.
+        if (shouldMarkIndexAsMultikey(keys->size(), *multikeyMetadataKeys, *multikeyPaths)) {
+            _indexCatalogEntry->setMultikey(opCtx, coll, *multikeyMetadataKeys, *multikeyPaths);
+        }
+        numMultikeyMetadataKeys += multikeyMetadataKeys->size();
+    }
+
+    // The RecordId is part of every key, so keys generated from different documents never compare
+    // equal.
+    std::sort(batchKeys.begin(), batchKeys.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.compare(rhs) < 0;
+    });
+
+    Status status = _newInterface->insertBatch(opCtx, batchKeys, true /* dupsAllowed */);
+    if (!status.isOK()) {
+        return status;
+    }
+    if (numInserted) {
+        *numInserted += batchKeys.size() + numMultikeyMetadataKeys;
+    }
+    return Status::OK();
+}
+
 void AbstractIndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                              const KeyString::Value& keyString,
                                              const RecordId& loc,
@@ -290,11 +348,21 @@ RecordId AbstractIndexAccessMethod::findSingle(OperationContext* opCtx,
                     kNoopOnSuppressedErrorFn);
             invariant(keys->size() == 1);
             return *keys->begin();
+        } else if (requestedKey.isEmpty()) {
+            KeyString::HeapBuilder requestedKeyString(
+                getSortedDataInterface()->getKeyStringVersion(),
+                requestedKey,
+                getSortedDataInterface()->getOrdering());
+            return requestedKeyString.release();
         } else {
+            // Field names are not part of a KeyString, so append the elements directly rather
+            // than allocating a copy of the key with its field names stripped.
             KeyString::HeapBuilder requestedKeyString(
                 getSortedDataInterface()->getKeyStringVersion(),
-                BSONObj::stripFieldNames(requestedKey),
                 getSortedDataInterface()->getOrdering());
+            for (auto&& elem : requestedKey) {
+                requestedKeyString.appendBSONElement(elem);
+            }
             return requestedKeyString.release();
         }
     }();
@@ -384,6 +452,7 @@ void AbstractIndexAccessMethod::prepareUpdate(OperationContext* opCtx,
                                               const BSONObj& from,
                                               const BSONObj& to,
                                               const RecordId& record,
+                                              const FieldRefSetWithStorage* modifiedPaths,
                                               const InsertDeleteOptions& options,
                                               UpdateTicket* ticket) const {
     auto& executionCtx = StorageExecutionContext::get(opCtx);
@@ -398,27 +467,29 @@ void AbstractIndexAccessMethod::prepareUpdate(OperationContext* opCtx,
         // There's no need to compute the prefixes of the indexed fields that possibly caused the
         // index to be multikey when the old version of the document was written since the index
         // metadata isn't updated when keys are deleted.
-        getKeys(executionCtx.pooledBufferBuilder(),
-                from,
-                getKeysMode,
-                GetKeysContext::kRemovingKeys,
-                &ticket->oldKeys,
-                nullptr,
-                nullptr,
-                record,
-                kNoopOnSuppressedErrorFn);
+        _getKeys(executionCtx.pooledBufferBuilder(),
+                 from,
+                 getKeysMode,
+                 GetKeysContext::kRemovingKeys,
+                 &ticket->oldKeys,
+                 nullptr,
+                 nullptr,
+                 record,
+                 kNoopOnSuppressedErrorFn,
+                 modifiedPaths);
     }
 
     if (!indexFilter || indexFilter->matchesBSON(to)) {
-        getKeys(executionCtx.pooledBufferBuilder(),
-                to,
-                options.getKeysMode,
-                GetKeysContext::kAddingKeys,
-                &ticket->newKeys,
-                &ticket->newMultikeyMetadataKeys,
-                &ticket->newMultikeyPaths,
-                record,
-                kNoopOnSuppressedErrorFn);
+        _getKeys(executionCtx.pooledBufferBuilder(),
+                 to,
+                 options.getKeysMode,
+                 GetKeysContext::kAddingKeys,
+                 &ticket->newKeys,
+                 &ticket->newMultikeyMetadataKeys,
+                 &ticket->newMultikeyPaths,
+                 record,
+                 kNoopOnSuppressedErrorFn,
+                 modifiedPaths);
     }
 
     ticket->loc = record;
@@ -490,6 +561,17 @@ public:
                   const RecordId& loc,
                   const InsertDeleteOptions& options) final;
 
+    Status generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                        const BSONObj& obj,
+                        const RecordId& loc,
+                        const InsertDeleteOptions& options,
+                        GeneratedKeys* generated) const final;
+
+    Status insertKeys(OperationContext* opCtx,
+                      const BSONObj& obj,
+                      const RecordId& loc,
+                      GeneratedKeys* generated) final;
+
     void addToSorter(const KeyString::Value& keyString) final {
         _sorter->add(keyString, mongo::NullValue());
     }
@@ -509,6 +591,21 @@ public:
     Sorter::PersistedState persistDataForShutdown() final;
 
 private:
+    /**
+     * Adds the data keys of one document to the sorter and accumulates its multikey information.
+     * The document's multikey metadata keys must already be in '_multikeyMetadataKeys'.
+     */
+    void _addKeys(const KeyStringSet& keys, const MultikeyPaths& multikeyPaths);
+
+    /**
+     * Records the document at 'loc' as skipped after a suppressed key generation error, so the
+     * index builder can retry it at a point when data is consistent.
+     */
+    void _recordSuppressedError(OperationContext* opCtx,
+                                const Status& status,
+                                const BSONObj& obj,
+                                const RecordId& loc);
+
     void _insertMultikeyMetadataKeysIntoSorter();
 
     Sorter* _makeSorter(
@@ -575,47 +672,91 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
             multikeyPaths.get(),
             loc,
             [&](Status status, const BSONObj&, boost::optional<RecordId>) {
-                // If a key generation error was suppressed, record the document as "skipped" so the
-                // index builder can retry at a point when data is consistent.
-                auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
-                if (interceptor && interceptor->getSkippedRecordTracker()) {
-                    LOGV2_DEBUG(20684,
-                                1,
-                                "Recording suppressed key generation error to retry later: "
-                                "{error} on {loc}: {obj}",
-                                "error"_attr = status,
-                                "loc"_attr = loc,
-                                "obj"_attr = redact(obj));
-                    interceptor->getSkippedRecordTracker()->record(opCtx, loc);
-                }
+                _recordSuppressedError(opCtx, status, obj, loc);
+            });
+    } catch (...) {
+        return exceptionToStatus();
+    }
+
+    _addKeys(*keys, *multikeyPaths);
+    return Status::OK();
+}
+
+Status AbstractIndexAccessMethod::BulkBuilderImpl::generateKeys(
+    SharedBufferFragmentBuilder& pooledBufferBuilder,
+    const BSONObj& obj,
+    const RecordId& loc,
+    const InsertDeleteOptions& options,
+    GeneratedKeys* generated) const {
+    try {
+        _indexCatalogEntry->accessMethod()->getKeys(
+            pooledBufferBuilder,
+            obj,
+            options.getKeysMode,
+            GetKeysContext::kAddingKeys,
+            &generated->keys,
+            &generated->multikeyMetadataKeys,
+            &generated->multikeyPaths,
+            loc,
+            [&](Status status, const BSONObj&, boost::optional<RecordId>) {
+                generated->suppressedError = std::move(status);
             });
     } catch (...) {
         return exceptionToStatus();
     }
+    return Status::OK();
+}
+
+Status AbstractIndexAccessMethod::BulkBuilderImpl::insertKeys(OperationContext* opCtx,
+                                                              const BSONObj& obj,
+                                                              const RecordId& loc,
+                                                              GeneratedKeys* generated) {
+    if (!generated->suppressedError.isOK()) {
+        _recordSuppressedError(opCtx, generated->suppressedError, obj, loc);
+    }
+    _multikeyMetadataKeys.merge(generated->multikeyMetadataKeys);
+    _addKeys(generated->keys, generated->multikeyPaths);
+    return Status::OK();
+}
 
-    if (!multikeyPaths->empty()) {
+void AbstractIndexAccessMethod::BulkBuilderImpl::_recordSuppressedError(
+    OperationContext* opCtx, const Status& status, const BSONObj& obj, const RecordId& loc) {
+    auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
+    if (interceptor && interceptor->getSkippedRecordTracker()) {
+        LOGV2_DEBUG(20684,
+                    1,
+                    "Recording suppressed key generation error to retry later: "
+                    "{error} on {loc}: {obj}",
+                    "error"_attr = status,
+                    "loc"_attr = loc,
+                    "obj"_attr = redact(obj));
+        interceptor->getSkippedRecordTracker()->record(opCtx, loc);
+    }
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::_addKeys(const KeyStringSet& keys,
+                                                        const MultikeyPaths& multikeyPaths) {
+    if (!multikeyPaths.empty()) {
         if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = *multikeyPaths;
+            _indexMultikeyPaths = multikeyPaths;
         } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths->size());
-            for (size_t i = 0; i < multikeyPaths->size(); ++i) {
+            invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
+            for (size_t i = 0; i < multikeyPaths.size(); ++i) {
                 _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
-                                              (*multikeyPaths)[i].begin(),
-                                              (*multikeyPaths)[i].end());
+                                              multikeyPaths[i].begin(),
+                                              multikeyPaths[i].end());
             }
         }
     }
 
-    for (const auto& keyString : *keys) {
+    for (const auto& keyString : keys) {
         _sorter->add(keyString, mongo::NullValue());
         ++_keysInserted;
     }
 
     _isMultiKey = _isMultiKey ||
         _indexCatalogEntry->accessMethod()->shouldMarkIndexAsMultikey(
-            keys->size(), _multikeyMetadataKeys, *multikeyPaths);
-
-    return Status::OK();
+            keys.size(), _multikeyMetadataKeys, multikeyPaths);
 }
 
 const MultikeyPaths& AbstractIndexAccessMethod::BulkBuilderImpl::getMultikeyPaths() const {
@@ -813,8 +954,35 @@ void AbstractIndexAccessMethod::getKeys(SharedBufferFragmentBuilder& pooledBuffe
                                         MultikeyPaths* multikeyPaths,
                                         boost::optional<RecordId> id,
                                         OnSuppressedErrorFn onSuppressedError) const {
+    _getKeys(pooledBufferBuilder,
+             obj,
+             mode,
+             context,
+             keys,
+             multikeyMetadataKeys,
+             multikeyPaths,
+             id,
+             std::move(onSuppressedError),
+             nullptr);
+}
+
+void AbstractIndexAccessMethod::_getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                         const BSONObj& obj,
+                                         GetKeysMode mode,
+                                         GetKeysContext context,
+                                         KeyStringSet* keys,
+                                         KeyStringSet* multikeyMetadataKeys,
+                                         MultikeyPaths* multikeyPaths,
+                                         boost::optional<RecordId> id,
+                                         OnSuppressedErrorFn onSuppressedError,
+                                         const FieldRefSetWithStorage* paths) const {
     try {
-        doGetKeys(pooledBufferBuilder, obj, context, keys, multikeyMetadataKeys, multikeyPaths, id);
+        if (!paths ||
+            !doGetKeysUnderPaths(
+                pooledBufferBuilder, obj, *paths, keys, multikeyMetadataKeys, id)) {
+            doGetKeys(
+                pooledBufferBuilder, obj, context, keys, multikeyMetadataKeys, multikeyPaths, id);
+        }
     } catch (const AssertionException& ex) {
         // Suppress all indexing errors when mode is kRelaxConstraints.
         if (mode == GetKeysMode::kEnforceConstraints) {
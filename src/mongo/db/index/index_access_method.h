@@ -46,7 +46,9 @@
 namespace mongo {
 
 class BSONObjBuilder;
+class FieldRefSetWithStorage;
 class MatchExpression;
+struct BsonRecord;
 struct UpdateTicket;
 struct InsertDeleteOptions;
 
@@ -123,6 +125,20 @@ public:
                               KeyHandlerFn&& onDuplicateKey,
                               int64_t* numInserted) = 0;
 
+    /**
+     * Generates the keys for every document in 'bsonRecords' and inserts all of them into the index
+     * in key order, rather than document by document, so that consecutive insertions tend to land
+     * on the same pages of the index. Marks the index as multikey as insert() would for each
+     * document. The index must not be unique or in the middle of a hybrid build.
+     *
+     * If 'numInserted' is not nullptr, it is incremented by the number of keys inserted.
+     */
+    virtual Status insertBatch(OperationContext* opCtx,
+                               const CollectionPtr& coll,
+                               const std::vector<BsonRecord>& bsonRecords,
+                               const InsertDeleteOptions& options,
+                               int64_t* numInserted) = 0;
+
     /**
      * Analogous to insertKeys above, but remove the keys instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the provided keys.
@@ -136,12 +152,16 @@ public:
     /**
      * Gets the keys of the documents 'from' and 'to' and prepares them for the update.
      * Provides a ticket for actually performing the update.
+     *
+     * If 'modifiedPaths' is non-null, 'from' and 'to' differ at most at those paths, and the index
+     * may leave the keys it generates for the rest of the documents out of the ticket.
      */
     virtual void prepareUpdate(OperationContext* opCtx,
                                IndexCatalogEntry* index,
                                const BSONObj& from,
                                const BSONObj& to,
                                const RecordId& loc,
+                               const FieldRefSetWithStorage* modifiedPaths,
                                const InsertDeleteOptions& options,
                                UpdateTicket* ticket) const = 0;
 
@@ -248,6 +268,38 @@ public:
                               const RecordId& loc,
                               const InsertDeleteOptions& options) = 0;
 
+        /**
+         * The keys which insert() would add for one document, as generated by generateKeys().
+         */
+        struct GeneratedKeys {
+            KeyStringSet keys;
+            KeyStringSet multikeyMetadataKeys;
+            MultikeyPaths multikeyPaths;
+
+            // Set if a key generation error was suppressed, in which case 'keys' is empty.
+            Status suppressedError = Status::OK();
+        };
+
+        /**
+         * Generates the keys which insert() would add for 'obj' into 'generated', which must be
+         * empty, without modifying the BulkBuilder. This is safe to call concurrently from
+         * several threads, as long as each uses its own 'pooledBufferBuilder'.
+         */
+        virtual Status generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                    const BSONObj& obj,
+                                    const RecordId& loc,
+                                    const InsertDeleteOptions& options,
+                                    GeneratedKeys* generated) const = 0;
+
+        /**
+         * Adds the keys which generateKeys() produced for the document 'obj' at 'loc', completing
+         * the work of insert() for the document.
+         */
+        virtual Status insertKeys(OperationContext* opCtx,
+                                  const BSONObj& obj,
+                                  const RecordId& loc,
+                                  GeneratedKeys* generated) = 0;
+
         /**
          * Inserts the keyString directly into the sorter. No additional logic (related to multikey
          * paths, etc.) is performed.
@@ -491,6 +543,12 @@ public:
                                             KeyHandlerFn&& onDuplicateKey,
                                             int64_t* numInserted) final;
 
+    Status insertBatch(OperationContext* opCtx,
+                       const CollectionPtr& coll,
+                       const std::vector<BsonRecord>& bsonRecords,
+                       const InsertDeleteOptions& options,
+                       int64_t* numInserted) final;
+
     Status removeKeys(OperationContext* opCtx,
                       const KeyStringSet& keys,
                       const RecordId& loc,
@@ -502,6 +560,7 @@ public:
                        const BSONObj& from,
                        const BSONObj& to,
                        const RecordId& loc,
+                       const FieldRefSetWithStorage* modifiedPaths,
                        const InsertDeleteOptions& options,
                        UpdateTicket* ticket) const final;
 
@@ -589,12 +648,43 @@ protected:
                            MultikeyPaths* multikeyPaths,
                            boost::optional<RecordId> id) const = 0;
 
+    /**
+     * Like doGetKeys(), but only generates the keys and multikey metadata keys for the parts of
+     * 'obj' which lie along or under one of 'paths'. An update which modified nothing else leaves
+     * the keys of the rest of the document unchanged, so those would cancel out of the difference
+     * between its old and new keys anyway. Returns false, having generated nothing, if this index
+     * can't tell which of its keys come from which paths; the caller then uses doGetKeys().
+     */
+    virtual bool doGetKeysUnderPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                     const BSONObj& obj,
+                                     const FieldRefSetWithStorage& paths,
+                                     KeyStringSet* keys,
+                                     KeyStringSet* multikeyMetadataKeys,
+                                     boost::optional<RecordId> id) const {
+        return false;
+    }
+
     IndexCatalogEntry* const _indexCatalogEntry;  // owned by IndexCatalog
     const IndexDescriptor* const _descriptor;
 
 private:
     class BulkBuilderImpl;
 
+    /**
+     * Implements getKeys(), generating only the keys under 'paths' when it is non-null and the
+     * index supports doing so.
+     */
+    void _getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                  const BSONObj& obj,
+                  GetKeysMode mode,
+                  GetKeysContext context,
+                  KeyStringSet* keys,
+                  KeyStringSet* multikeyMetadataKeys,
+                  MultikeyPaths* multikeyPaths,
+                  boost::optional<RecordId> id,
+                  OnSuppressedErrorFn onSuppressedError,
+                  const FieldRefSetWithStorage* paths) const;
+
     /**
      * Removes a single key from the index.
      *
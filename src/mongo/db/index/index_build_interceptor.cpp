@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/index_build_interceptor.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/bson/bsonobj.h"
@@ -62,7 +63,7 @@ bool IndexBuildInterceptor::typeCanFastpathMultikeyUpdates(IndexType indexType)
     // vector.
     invariant(indexType == INDEX_BTREE || indexType == INDEX_2D || indexType == INDEX_HAYSTACK ||
               indexType == INDEX_2DSPHERE || indexType == INDEX_TEXT || indexType == INDEX_HASHED ||
-              indexType == INDEX_WILDCARD);
+              indexType == INDEX_WILDCARD || indexType == INDEX_COLUMN);
     // Only BTREE indexes are guaranteed to use the multikeyPaths vector. Other index types either
     // do not track path-level multikey information or have "special" handling of multikey
     // information.
@@ -206,6 +207,9 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
         // table matters.
         std::vector<RecordId> recordsAddedToIndex;
 
+        // The writes in this batch, in the order they were read from the side table.
+        std::vector<SideWrite> writes;
+
         auto record = cursor->next();
         while (record) {
             opCtx->checkForInterrupt();
@@ -227,16 +231,7 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             batchSize += 1;
             batchSizeBytes += objSize;
 
-            if (auto status = _applyWrite(opCtx,
-                                          coll,
-                                          unownedDoc,
-                                          options,
-                                          trackDuplicates,
-                                          &totalInserted,
-                                          &totalDeleted);
-                !status.isOK()) {
-                return status;
-            }
+            writes.push_back(_decodeSideWrite(unownedDoc));
 
             // Save the record ids of the documents inserted into the index for deletion later.
             // We can't delete records while holding a positioned cursor.
@@ -250,6 +245,23 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             record = cursor->next();
         }
 
+        // Apply the batch in key order rather than in the order the writes were observed, so that
+        // consecutive writes land on neighbouring index pages instead of at random points in the
+        // index. Writes to different key values are independent of each other. Writes to the same
+        // key value, even for different RecordIds, must keep their relative order because a
+        // unique index may otherwise see a transient duplicate, hence the stable sort which
+        // ignores the RecordId at the end of each key.
+        std::stable_sort(writes.begin(), writes.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.key.compareWithoutRecordId(rhs.key) < 0;
+        });
+        for (const auto& write : writes) {
+            if (auto status = _applyWrite(
+                    opCtx, coll, write, options, trackDuplicates, &totalInserted, &totalDeleted);
+                !status.isOK()) {
+                return status;
+            }
+        }
+
         // Delete documents from the side table as soon as they have been inserted into the index.
         // This ensures that no key is ever inserted twice and no keys are skipped.
         for (const auto& recordId : recordsAddedToIndex) {
@@ -305,23 +317,33 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
     return Status::OK();
 }
 
-Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
-                                          const CollectionPtr& coll,
-                                          const BSONObj& operation,
-                                          const InsertDeleteOptions& options,
-                                          TrackDuplicates trackDups,
-                                          int64_t* const keysInserted,
-                                          int64_t* const keysDeleted) {
+IndexBuildInterceptor::SideWrite IndexBuildInterceptor::_decodeSideWrite(
+    const BSONObj& operation) const {
     // Deserialize the encoded KeyString::Value.
     int keyLen;
     const char* binKey = operation["key"].binData(keyLen);
     BufReader reader(binKey, keyLen);
-    const KeyString::Value keyString = KeyString::Value::deserialize(
+    auto keyString = KeyString::Value::deserialize(
         reader,
         _indexCatalogEntry->accessMethod()->getSortedDataInterface()->getKeyStringVersion());
 
-    const Op opType =
-        (strcmp(operation.getStringField("op"), "i") == 0) ? Op::kInsert : Op::kDelete;
+    const auto opStr = operation.getStringField("op");
+    const Op opType = (strcmp(opStr, "i") == 0) ? Op::kInsert : Op::kDelete;
+    if (kDebugBuild && opType == Op::kDelete)
+        invariant(strcmp(opStr, "d") == 0);
+
+    return {opType, std::move(keyString)};
+}
+
+Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
+                                          const CollectionPtr& coll,
+                                          const SideWrite& write,
+                                          const InsertDeleteOptions& options,
+                                          TrackDuplicates trackDups,
+                                          int64_t* const keysInserted,
+                                          int64_t* const keysDeleted) {
+    const KeyString::Value& keyString = write.key;
+    const Op opType = write.op;
 
     const KeyStringSet keySet{keyString};
     const RecordId opRecordId =
@@ -353,8 +375,6 @@ Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
             [keysInserted, numInserted] { *keysInserted -= numInserted; });
     } else {
         invariant(opType == Op::kDelete);
-        if (kDebugBuild)
-            invariant(strcmp(operation.getStringField("op"), "d") == 0);
 
         int64_t numDeleted;
         Status s = accessMethod->removeKeys(
@@ -177,11 +177,25 @@ public:
 private:
     using SideWriteRecord = std::pair<RecordId, BSONObj>;
 
+    /**
+     * A side write decoded from its document in the side writes table.
+     */
+    struct SideWrite {
+        Op op;
+        KeyString::Value key;
+    };
 
     void _initializeMultiKeyPaths(IndexCatalogEntry* entry);
+
+    /**
+     * Decodes a document from the side writes table. The returned key owns its buffer, so it
+     * remains valid after the cursor that produced the document moves.
+     */
+    SideWrite _decodeSideWrite(const BSONObj& doc) const;
+
     Status _applyWrite(OperationContext* opCtx,
                        const CollectionPtr& coll,
-                       const BSONObj& doc,
+                       const SideWrite& write,
                        const InsertDeleteOptions& options,
                        TrackDuplicates trackDups,
                        int64_t* const keysInserted,
@@ -60,4 +60,17 @@ void WildcardAccessMethod::doGetKeys(SharedBufferFragmentBuilder& pooledBufferBu
                                      boost::optional<RecordId> id) const {
     _keyGen.generateKeys(pooledBufferBuilder, obj, keys, multikeyMetadataKeys, id);
 }
+
+bool WildcardAccessMethod::doGetKeysUnderPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                               const BSONObj& obj,
+                                               const FieldRefSetWithStorage& paths,
+                                               KeyStringSet* keys,
+                                               KeyStringSet* multikeyMetadataKeys,
+                                               boost::optional<RecordId> id) const {
+    if (!_keyGen.canGenerateKeysUnderPaths()) {
+        return false;
+    }
+    _keyGen.generateKeysUnderPaths(pooledBufferBuilder, obj, paths, keys, multikeyMetadataKeys, id);
+    return true;
+}
 }  // namespace mongo
@@ -75,6 +75,13 @@ private:
                    MultikeyPaths* multikeyPaths,
                    boost::optional<RecordId> id) const final;
 
+    bool doGetKeysUnderPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                             const BSONObj& obj,
+                             const FieldRefSetWithStorage& paths,
+                             KeyStringSet* keys,
+                             KeyStringSet* multikeyMetadataKeys,
+                             boost::optional<RecordId> id) const final;
+
     const WildcardKeyGenerator _keyGen;
 };
 }  // namespace mongo
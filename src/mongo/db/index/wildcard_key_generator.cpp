@@ -61,6 +61,23 @@ void popPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* path
         pathToElem->removeLastPart();
     }
 }
+
+// How the path of an element within a document relates to a set of paths: it either lies at or
+// under one of them, along one of them, or neither.
+enum class PathOverlap { kNone, kAlong, kUnder };
+
+PathOverlap getPathOverlap(const FieldRef& docPath, const FieldRefSetWithStorage& paths) {
+    auto overlap = PathOverlap::kNone;
+    for (const auto* path : paths) {
+        if (path->isPrefixOfOrEqualTo(docPath)) {
+            return PathOverlap::kUnder;
+        }
+        if (docPath.isPrefixOf(*path)) {
+            overlap = PathOverlap::kAlong;
+        }
+    }
+    return overlap;
+}
 }  // namespace
 
 constexpr StringData WildcardKeyGenerator::kSubtreeSuffix;
@@ -112,7 +129,31 @@ void WildcardKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBuffe
                                         KeyStringSet* keys,
                                         KeyStringSet* multikeyPaths,
                                         boost::optional<RecordId> id) const {
+    _generateKeys(pooledBufferBuilder, inputDoc, nullptr, keys, multikeyPaths, id);
+}
+
+bool WildcardKeyGenerator::canGenerateKeysUnderPaths() const {
+    return _proj.exec()->getType() == TransformerInterface::TransformerType::kExclusionProjection;
+}
+
+void WildcardKeyGenerator::generateKeysUnderPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                                  BSONObj inputDoc,
+                                                  const FieldRefSetWithStorage& paths,
+                                                  KeyStringSet* keys,
+                                                  KeyStringSet* multikeyPaths,
+                                                  boost::optional<RecordId> id) const {
+    invariant(canGenerateKeysUnderPaths());
+    _generateKeys(pooledBufferBuilder, inputDoc, &paths, keys, multikeyPaths, id);
+}
+
+void WildcardKeyGenerator::_generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                         BSONObj inputDoc,
+                                         const FieldRefSetWithStorage* paths,
+                                         KeyStringSet* keys,
+                                         KeyStringSet* multikeyPaths,
+                                         boost::optional<RecordId> id) const {
     FieldRef rootPath;
+    FieldRef docPath;
     auto keysSequence = keys->extract_sequence();
     // multikeyPaths is allowed to be nullptr
     KeyStringSet::sequence_type multikeyPathsSequence;
@@ -122,6 +163,8 @@ void WildcardKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBuffe
                       _proj.exec()->applyTransformation(Document{inputDoc}).toBson(),
                       false,
                       &rootPath,
+                      paths,
+                      &docPath,
                       &keysSequence,
                       multikeyPaths ? &multikeyPathsSequence : nullptr,
                       id);
@@ -134,6 +177,8 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
                                              BSONObj obj,
                                              bool objIsArray,
                                              FieldRef* path,
+                                             const FieldRefSetWithStorage* paths,
+                                             FieldRef* docPath,
                                              KeyStringSet::sequence_type* keys,
                                              KeyStringSet::sequence_type* multikeyPaths,
                                              boost::optional<RecordId> id) const {
@@ -142,6 +187,21 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
         if (elem.fieldNameStringData().find('.', 0) != std::string::npos)
             continue;
 
+        // Skip the element if it lies neither along nor under any of 'paths'. Once it lies under
+        // one of them, all of its subtree is traversed.
+        const FieldRefSetWithStorage* elemPaths = paths;
+        if (paths) {
+            docPath->appendPart(elem.fieldNameStringData());
+            auto overlap = getPathOverlap(*docPath, *paths);
+            if (overlap == PathOverlap::kNone) {
+                docPath->removeLastPart();
+                continue;
+            }
+            if (overlap == PathOverlap::kUnder) {
+                elemPaths = nullptr;
+            }
+        }
+
         // Append the element's fieldname to the path, if the enclosing object is not an array.
         pushPathComponent(elem, objIsArray, path);
 
@@ -162,6 +222,8 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
                                   elem.Obj(),
                                   elem.type() == BSONType::Array,
                                   path,
+                                  elemPaths,
+                                  docPath,
                                   keys,
                                   multikeyPaths,
                                   id);
@@ -173,6 +235,9 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
 
         // Remove the element's fieldname from the path, if it was pushed onto it earlier.
         popPathComponent(elem, objIsArray, path);
+        if (paths) {
+            docPath->removeLastPart();
+        }
     }
 }
 
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/wildcard_projection.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/field_ref_set.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/sorted_data_interface.h"
@@ -80,12 +81,43 @@ public:
                       KeyStringSet* multikeyPaths,
                       boost::optional<RecordId> id = boost::none) const;
 
+    /**
+     * Returns whether generateKeysUnderPaths() may be used. This is only the case for exclusion
+     * projections, which leave every array element at its position, so that a path of the input
+     * document leads to the same element of the post-projection document.
+     */
+    bool canGenerateKeysUnderPaths() const;
+
+    /**
+     * Like generateKeys(), but only adds the keys and multikey paths for the elements of the
+     * post-projection document which lie along or under one of 'paths'. Unlike the paths stored in
+     * the keys, 'paths' include the positions of the array elements they lead through, as do the
+     * paths modified by an update.
+     */
+    void generateKeysUnderPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                BSONObj inputDoc,
+                                const FieldRefSetWithStorage& paths,
+                                KeyStringSet* keys,
+                                KeyStringSet* multikeyPaths,
+                                boost::optional<RecordId> id = boost::none) const;
+
 private:
-    // Traverses every path of the post-projection document, adding keys to the set as it goes.
+    void _generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                       BSONObj inputDoc,
+                       const FieldRefSetWithStorage* paths,
+                       KeyStringSet* keys,
+                       KeyStringSet* multikeyPaths,
+                       boost::optional<RecordId> id) const;
+
+    // Traverses every path of the post-projection document, adding keys to the set as it goes. If
+    // 'paths' is non-null, the elements which lie neither along nor under one of them are skipped;
+    // 'docPath' then tracks the path of 'obj' within the document, including array positions.
     void _traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
                            BSONObj obj,
                            bool objIsArray,
                            FieldRef* path,
+                           const FieldRefSetWithStorage* paths,
+                           FieldRef* docPath,
                            KeyStringSet::sequence_type* keys,
                            KeyStringSet::sequence_type* multikeyPaths,
                            boost::optional<RecordId> id) const;
@@ -1173,5 +1173,110 @@ TEST_F(WildcardKeyGeneratorDottedFieldsTest, DoNotIndexDottedFieldsWithSimilarSu
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+// Tests of the generation of the keys under a set of paths only.
+struct WildcardKeyGeneratorUnderPathsTest : public WildcardKeyGeneratorTest {
+    const FieldRefSetWithStorage& makePaths(std::initializer_list<StringData> paths) {
+        _paths.clear();
+        for (auto path : paths) {
+            _paths.keepShortest(FieldRef(path));
+        }
+        return _paths;
+    }
+
+private:
+    FieldRefSetWithStorage _paths;
+};
+
+TEST_F(WildcardKeyGeneratorUnderPathsTest, OnlyGenerateKeysAlongOrUnderPaths) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                {},
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+    ASSERT_TRUE(keyGen.canGenerateKeysUnderPaths());
+    auto inputDoc = fromjson("{a: {b: {c: 1, d: 2}, e: 3}, f: [{g: 4}, {g: 5, h: [6]}], i: 7}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 'a.b.c', '': 1}"),
+                                    fromjson("{'': 'a.b.d', '': 2}"),
+                                    fromjson("{'': 'f.h', '': 6}")});
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'f'}"), fromjson("{'': 1, '': 'f.h'}")},
+                   RecordId{RecordId::ReservedId::kWildcardMultikeyMetadataId});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeysUnderPaths(
+        allocator, inputDoc, makePaths({"a.b", "f.1.h", "x"}), &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST_F(WildcardKeyGeneratorUnderPathsTest, GenerateKeysForLeavesAlongPaths) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                {},
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+    auto inputDoc = fromjson("{a: {}, b: 1, c: [], d: 2}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 'a', '': {}}"),
+                                    fromjson("{'': 'b', '': 1}"),
+                                    fromjson("{'': 'c', '': undefined}")});
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'c'}")},
+                   RecordId{RecordId::ReservedId::kWildcardMultikeyMetadataId});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeysUnderPaths(allocator,
+                                  inputDoc,
+                                  makePaths({"a.x", "b.y", "c.0"}),
+                                  &outputKeys,
+                                  &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST_F(WildcardKeyGeneratorUnderPathsTest, GenerateKeysUnderPathsWithExclusionProjection) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                fromjson("{'a.b': 0}"),
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+    ASSERT_TRUE(keyGen.canGenerateKeysUnderPaths());
+    auto inputDoc = fromjson("{a: [1, {b: 2, c: 3}, {c: 4}], d: 5}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 'a.c', '': 3}")});
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'a'}")},
+                   RecordId{RecordId::ReservedId::kWildcardMultikeyMetadataId});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeysUnderPaths(
+        allocator, inputDoc, makePaths({"a.1"}), &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST_F(WildcardKeyGeneratorUnderPathsTest, CannotGenerateKeysUnderPathsWithInclusionProjection) {
+    WildcardKeyGenerator subtreeKeyGen{fromjson("{'a.$**': 1}"),
+                                       {},
+                                       nullptr,
+                                       KeyString::Version::kLatestVersion,
+                                       Ordering::make(BSONObj())};
+    ASSERT_FALSE(subtreeKeyGen.canGenerateKeysUnderPaths());
+
+    WildcardKeyGenerator inclusionKeyGen{fromjson("{'$**': 1}"),
+                                         fromjson("{'a.b': 1}"),
+                                         nullptr,
+                                         KeyString::Version::kLatestVersion,
+                                         Ordering::make(BSONObj())};
+    ASSERT_FALSE(inclusionKeyGen.canGenerateKeysUnderPaths());
+}
+
 }  // namespace
 }  // namespace mongo
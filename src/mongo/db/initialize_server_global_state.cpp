@@ -355,6 +355,7 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
         lv2Config.fileRotationMode = serverGlobalParams.logRenameOnRotate
             ? logv2::LogDomainGlobal::ConfigurationOptions::RotationMode::kRename
             : logv2::LogDomainGlobal::ConfigurationOptions::RotationMode::kReopen;
+        lv2Config.fileAsyncBufferSizeBytes = static_cast<size_t>(gLogAsyncBufferSizeKB) * 1024;
         lv2Config.fileOpenMode = serverGlobalParams.logAppend
             ? logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kAppend
             : logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kTruncate;
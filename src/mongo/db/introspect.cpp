@@ -33,19 +33,28 @@
 
 #include "mongo/db/introspect.h"
 
+#include <deque>
+#include <map>
+
+#include "mongo/base/counter.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/auth/authorization_manager.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_set.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/introspect_gen.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/service_context.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/rpc/metadata/client_metadata.h"
+#include "mongo/util/periodic_runner.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -54,6 +63,189 @@ using std::endl;
 using std::string;
 using std::unique_ptr;
 
+namespace {
+
+// The maximum number of buffered profile entries inserted into a system.profile collection in a
+// single WriteUnitOfWork.
+constexpr size_t kMaxProfileEntriesPerBatch = 256;
+
+Counter64 profilerBufferedEntries;
+Counter64 profilerDroppedEntries;
+ServerStatusMetricField<Counter64> displayProfilerBufferedEntries("profiler.bufferedEntries",
+                                                                  &profilerBufferedEntries);
+ServerStatusMetricField<Counter64> displayProfilerDroppedEntries("profiler.droppedEntries",
+                                                                 &profilerDroppedEntries);
+
+/**
+ * Inserts 'entries' into the profile collection of 'dbName', creating the collection if it does
+ * not exist yet. Returns false if the database does not exist. Throws on failure.
+ */
+bool insertProfileEntries(OperationContext* opCtx,
+                          const std::string& dbName,
+                          const std::vector<InsertStatement>& entries) {
+    auto origFlowControl = opCtx->shouldParticipateInFlowControl();
+
+    // The system.profile collection is non-replicated, so writes to it do not cause
+    // replication lag. As such, they should be excluded from Flow Control.
+    opCtx->setShouldParticipateInFlowControl(false);
+
+    // IX lock acquisitions beyond this block will not be related to writes to system.profile.
+    ON_BLOCK_EXIT(
+        [opCtx, origFlowControl] { opCtx->setShouldParticipateInFlowControl(origFlowControl); });
+
+    // Even if the operation we are profiling was interrupted, we still want to output the
+    // profiler entry.  This lock guard will prevent lock acquisitions from throwing exceptions
+    // before we finish writing the entry. However, our maximum lock timeout overrides
+    // uninterruptibility.
+    boost::optional<UninterruptibleLockGuard> noInterrupt;
+    if (!opCtx->lockState()->hasMaxLockTimeout()) {
+        noInterrupt.emplace(opCtx->lockState());
+    }
+
+    const auto dbProfilingNS = NamespaceString(dbName, "system.profile");
+    AutoGetCollection autoColl(opCtx, dbProfilingNS, MODE_IX);
+    Database* const db = autoColl.getDb();
+    if (!db) {
+        return false;
+    }
+
+    // We are about to enforce prepare conflicts for the OperationContext. But it is illegal
+    // to change the behavior of ignoring prepare conflicts while any storage transaction is
+    // still active. So we need to call abandonSnapshot() to close any open transactions.
+    // This call is also harmless because any previous reads or writes should have already
+    // completed, as profile() is called at the end of an operation.
+    opCtx->recoveryUnit()->abandonSnapshot();
+    // The profiler performs writes even after read commands. Ignoring prepare conflicts is
+    // not allowed while performing writes, so temporarily enforce prepare conflicts.
+    EnforcePrepareConflictsBlock enforcePrepare(opCtx);
+
+    uassertStatusOK(createProfileCollection(opCtx, db));
+    auto coll = CollectionCatalog::get(opCtx)->lookupCollectionByNamespace(opCtx, dbProfilingNS);
+
+    invariant(!opCtx->shouldParticipateInFlowControl());
+    WriteUnitOfWork wuow(opCtx);
+    OpDebug* const nullOpDebug = nullptr;
+    uassertStatusOK(
+        coll->insertDocuments(opCtx, entries.begin(), entries.end(), nullOpDebug, false));
+    wuow.commit();
+    return true;
+}
+
+/**
+ * Buffers profile entries in memory when 'profilerWriteBufferSize' is non-zero, and writes them to
+ * the system.profile collections in batches from a periodic background job. This takes the lock
+ * acquisitions and the storage transaction of the profile write off the path of the profiled
+ * operations. Entries which don't fit into the buffer, or whose write fails, are dropped and
+ * counted in serverStatus. Buffered entries are lost on shutdown.
+ */
+class ProfileWriteBuffer {
+public:
+    static ProfileWriteBuffer& get(ServiceContext* serviceContext);
+
+    /**
+     * Buffers 'entry', to be written to the profile collection of 'dbName'. Returns false if
+     * buffering is disabled, in which case the caller must write the entry itself.
+     */
+    bool append(ServiceContext* serviceContext, std::string dbName, BSONObj entry);
+
+private:
+    void _startJob(WithLock, ServiceContext* serviceContext);
+
+    void _flush(Client* client);
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ProfileWriteBuffer::_mutex");
+
+    // Buffered entries and the name of the database they are written to, in the order in which
+    // they were generated.
+    std::deque<std::pair<std::string, BSONObj>> _entries;
+
+    boost::optional<PeriodicJobAnchor> _job;
+};
+
+const auto getProfileWriteBuffer = ServiceContext::declareDecoration<ProfileWriteBuffer>();
+
+ProfileWriteBuffer& ProfileWriteBuffer::get(ServiceContext* serviceContext) {
+    return getProfileWriteBuffer(serviceContext);
+}
+
+bool ProfileWriteBuffer::append(ServiceContext* serviceContext,
+                                std::string dbName,
+                                BSONObj entry) {
+    const auto bufferSize = gProfilerWriteBufferSize.load();
+    if (bufferSize <= 0 || !serviceContext->getPeriodicRunner()) {
+        return false;
+    }
+
+    stdx::lock_guard lk(_mutex);
+    if (!_job) {
+        _startJob(lk, serviceContext);
+    }
+
+    if (_entries.size() >= static_cast<size_t>(bufferSize)) {
+        profilerDroppedEntries.increment();
+        return true;
+    }
+
+    _entries.emplace_back(std::move(dbName), entry.getOwned());
+    profilerBufferedEntries.increment();
+    return true;
+}
+
+void ProfileWriteBuffer::_startJob(WithLock, ServiceContext* serviceContext) {
+    PeriodicRunner::PeriodicJob job("profileWriter",
+                                    [this](Client* client) { _flush(client); },
+                                    Milliseconds(gProfilerWriteBufferFlushIntervalMillis));
+    _job.emplace(serviceContext->getPeriodicRunner()->makeJob(std::move(job)));
+    _job->start();
+}
+
+void ProfileWriteBuffer::_flush(Client* client) {
+    std::deque<std::pair<std::string, BSONObj>> entries;
+    {
+        stdx::lock_guard lk(_mutex);
+        entries.swap(_entries);
+    }
+    if (entries.empty()) {
+        return;
+    }
+
+    // Group the entries by database, keeping them in the order in which they were generated.
+    std::map<std::string, std::vector<InsertStatement>> entriesByDb;
+    for (auto& [dbName, entry] : entries) {
+        entriesByDb[dbName].emplace_back(std::move(entry));
+    }
+
+    auto opCtx = client->makeOperationContext();
+    for (const auto& [dbName, dbEntries] : entriesByDb) {
+        for (auto it = dbEntries.begin(); it != dbEntries.end();) {
+            const auto batchSize =
+                std::min(kMaxProfileEntriesPerBatch, static_cast<size_t>(dbEntries.end() - it));
+            const auto batchEnd = it + batchSize;
+            const std::vector<InsertStatement> batch(it, batchEnd);
+            it = batchEnd;
+
+            try {
+                const auto written = writeConflictRetry(
+                    opCtx.get(), "profileWriter", dbName + ".system.profile", [&] {
+                        return insertProfileEntries(opCtx.get(), dbName, batch);
+                    });
+                if (!written) {
+                    profilerDroppedEntries.increment(batch.size());
+                }
+            } catch (const DBException& ex) {
+                profilerDroppedEntries.increment(batch.size());
+                LOGV2_WARNING(5843226,
+                              "Failed to write buffered profile entries",
+                              "db"_attr = dbName,
+                              "numEntries"_attr = batch.size(),
+                              "error"_attr = redact(ex));
+            }
+        }
+    }
+}
+
+}  // namespace
+
 void profile(OperationContext* opCtx, NetworkOp op) {
     // Initialize with 1kb at start in order to avoid realloc later
     BufBuilder profileBufBuilder(1024);
@@ -92,58 +284,19 @@ void profile(OperationContext* opCtx, NetworkOp op) {
 
     const string dbName(nsToDatabase(CurOp::get(opCtx)->getNS()));
 
-    auto origFlowControl = opCtx->shouldParticipateInFlowControl();
-
-    // The system.profile collection is non-replicated, so writes to it do not cause
-    // replication lag. As such, they should be excluded from Flow Control.
-    opCtx->setShouldParticipateInFlowControl(false);
-
-    // IX lock acquisitions beyond this block will not be related to writes to system.profile.
-    ON_BLOCK_EXIT(
-        [opCtx, origFlowControl] { opCtx->setShouldParticipateInFlowControl(origFlowControl); });
+    if (ProfileWriteBuffer::get(opCtx->getServiceContext())
+            .append(opCtx->getServiceContext(), dbName, p)) {
+        return;
+    }
 
     try {
-
-        // Even if the operation we are profiling was interrupted, we still want to output the
-        // profiler entry.  This lock guard will prevent lock acquisitions from throwing exceptions
-        // before we finish writing the entry. However, our maximum lock timeout overrides
-        // uninterruptibility.
-        boost::optional<UninterruptibleLockGuard> noInterrupt;
-        if (!opCtx->lockState()->hasMaxLockTimeout()) {
-            noInterrupt.emplace(opCtx->lockState());
-        }
-
-        const auto dbProfilingNS = NamespaceString(dbName, "system.profile");
-        AutoGetCollection autoColl(opCtx, dbProfilingNS, MODE_IX);
-        Database* const db = autoColl.getDb();
-        if (!db) {
+        if (!insertProfileEntries(opCtx, dbName, {InsertStatement(p)})) {
             // Database disappeared.
             LOGV2(20700,
                   "note: not profiling because db went away for {namespace}",
                   "note: not profiling because db went away for namespace",
                   "namespace"_attr = CurOp::get(opCtx)->getNS());
-            return;
         }
-
-        // We are about to enforce prepare conflicts for the OperationContext. But it is illegal
-        // to change the behavior of ignoring prepare conflicts while any storage transaction is
-        // still active. So we need to call abandonSnapshot() to close any open transactions.
-        // This call is also harmless because any previous reads or writes should have already
-        // completed, as profile() is called at the end of an operation.
-        opCtx->recoveryUnit()->abandonSnapshot();
-        // The profiler performs writes even after read commands. Ignoring prepare conflicts is
-        // not allowed while performing writes, so temporarily enforce prepare conflicts.
-        EnforcePrepareConflictsBlock enforcePrepare(opCtx);
-
-        uassertStatusOK(createProfileCollection(opCtx, db));
-        auto coll =
-            CollectionCatalog::get(opCtx)->lookupCollectionByNamespace(opCtx, dbProfilingNS);
-
-        invariant(!opCtx->shouldParticipateInFlowControl());
-        WriteUnitOfWork wuow(opCtx);
-        OpDebug* const nullOpDebug = nullptr;
-        uassertStatusOK(coll->insertDocument(opCtx, InsertStatement(p), nullOpDebug, false));
-        wuow.commit();
     } catch (const AssertionException& assertionEx) {
         LOGV2_WARNING(20703,
                       "Caught Assertion while trying to profile {operation} against "
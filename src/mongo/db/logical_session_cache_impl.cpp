@@ -245,6 +245,9 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
         // Clear the refresh-related stats with the beginning of our run.
         _stats.setLastSessionsCollectionJobDurationMillis(0);
         _stats.setLastSessionsCollectionJobEntriesRefreshed(0);
+        _stats.setLastSessionsCollectionJobEntriesSkipped(0);
+        _stats.setLastSessionsCollectionJobRefreshBatches(0);
+        _stats.setLastSessionsCollectionJobRefreshDurationMillis(0);
         _stats.setLastSessionsCollectionJobEntriesEnded(0);
         _stats.setLastSessionsCollectionJobCursorsClosed(0);
 
@@ -320,12 +323,77 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
         activeSessionRecords.insert(it.second);
     }
 
-    // Refresh the active sessions in the sessions collection.
-    _sessionsColl->refreshSessions(opCtx, activeSessionRecords);
+    // Skip the sessions whose records were upserted recently enough that their lastUse in the
+    // sessions collection is not stale yet.
+    const auto refreshStart = _service->now();
+    const Milliseconds stalenessThreshold{logicalSessionRefreshStalenessMillis.load()};
+    size_t numSkipped = 0;
+    {
+        stdx::lock_guard<Latch> lk(_lastUpsertedMutex);
+        if (stalenessThreshold <= Milliseconds(0)) {
+            _lastUpserted.clear();
+        }
+        for (auto it = _lastUpserted.begin(); it != _lastUpserted.end();) {
+            if (it->second + stalenessThreshold <= refreshStart ||
+                explicitlyEndingSessions.count(it->first)) {
+                _lastUpserted.erase(it++);
+                continue;
+            }
+            ++it;
+        }
+        for (auto it = activeSessionRecords.begin(); it != activeSessionRecords.end();) {
+            if (_lastUpserted.count(it->getId())) {
+                activeSessionRecords.erase(it++);
+                ++numSkipped;
+                continue;
+            }
+            ++it;
+        }
+    }
+
+    // Refresh the active sessions in the sessions collection, pacing the batches if requested.
+    const Milliseconds batchPause{logicalSessionRefreshBatchPauseMillis.load()};
+    long long numBatches = 0;
+    if (batchPause <= Milliseconds(0)) {
+        _sessionsColl->refreshSessions(opCtx, activeSessionRecords);
+        numBatches = activeSessionRecords.empty() ? 0 : 1;
+    } else {
+        const size_t batchSize = logicalSessionRefreshBatchSize.load();
+        LogicalSessionRecordSet batch;
+        auto refreshBatch = [&] {
+            if (numBatches++ > 0) {
+                opCtx->sleepFor(batchPause);
+            }
+            _sessionsColl->refreshSessions(opCtx, batch);
+            batch.clear();
+        };
+
+        for (const auto& record : activeSessionRecords) {
+            batch.insert(record);
+            if (batch.size() >= batchSize) {
+                refreshBatch();
+            }
+        }
+        if (!batch.empty()) {
+            refreshBatch();
+        }
+    }
     activeSessionsBackSwapper.dismiss();
+
+    const auto refreshEnd = _service->now();
+    if (stalenessThreshold > Milliseconds(0)) {
+        stdx::lock_guard<Latch> lk(_lastUpsertedMutex);
+        for (const auto& record : activeSessionRecords) {
+            _lastUpserted[record.getId()] = refreshStart;
+        }
+    }
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _stats.setLastSessionsCollectionJobEntriesRefreshed(activeSessionRecords.size());
+        _stats.setLastSessionsCollectionJobEntriesSkipped(numSkipped);
+        _stats.setLastSessionsCollectionJobRefreshBatches(numBatches);
+        _stats.setLastSessionsCollectionJobRefreshDurationMillis(
+            durationCount<Milliseconds>(refreshEnd - refreshStart));
     }
 
     // Remove the ending sessions from the sessions collection.
@@ -116,6 +116,15 @@ private:
 
     Date_t _lastRefreshTime;
 
+    // Protects _lastUpserted. Only taken by the refresh, and never together with _mutex.
+    Mutex _lastUpsertedMutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0),
+                                                "LogicalSessionCacheImpl::_lastUpsertedMutex");
+
+    // When logicalSessionRefreshStalenessMillis is set, the time at which the record of each
+    // session was last upserted into the sessions collection, for the sessions upserted within
+    // that many milliseconds.
+    LogicalSessionIdMap<Date_t> _lastUpserted;
+
     LogicalSessionCacheStats _stats;
 };
 
@@ -50,6 +50,7 @@
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/ensure_fcv.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -216,6 +217,68 @@ TEST_F(LogicalSessionCacheTest, ManySignedLsidsInCacheRefresh) {
     ASSERT_OK(cache()->refreshNow(opCtx()));
 }
 
+// Test that a refresh skips the sessions it upserted within the staleness threshold
+TEST_F(LogicalSessionCacheTest, RefreshSkipsRecentlyUpsertedSessions) {
+    logicalSessionRefreshStalenessMillis.store(2 * kForceRefresh.count());
+    ON_BLOCK_EXIT([] { logicalSessionRefreshStalenessMillis.store(0); });
+
+    auto lsid = makeLogicalSessionIdForTest();
+    ASSERT_OK(cache()->startSession(opCtx(), makeLogicalSessionRecord(lsid, service()->now())));
+
+    size_t numRefreshed = 0;
+    sessions()->setRefreshHook([&numRefreshed](const LogicalSessionRecordSet& sessions) {
+        numRefreshed += sessions.size();
+    });
+
+    service()->fastForward(kForceRefresh);
+    ASSERT_OK(cache()->refreshNow(opCtx()));
+    ASSERT_EQ(1U, numRefreshed);
+    ASSERT_EQ(1, cache()->getStats().getLastSessionsCollectionJobEntriesRefreshed());
+
+    // The session is used again, but its record is still fresh.
+    ASSERT_OK(cache()->vivify(opCtx(), lsid));
+    service()->fastForward(kForceRefresh);
+    ASSERT_OK(cache()->refreshNow(opCtx()));
+    ASSERT_EQ(1U, numRefreshed);
+    ASSERT_EQ(0, cache()->getStats().getLastSessionsCollectionJobEntriesRefreshed());
+    ASSERT_EQ(1, cache()->getStats().getLastSessionsCollectionJobEntriesSkipped());
+
+    // Once the record is stale, the session is upserted again.
+    ASSERT_OK(cache()->vivify(opCtx(), lsid));
+    service()->fastForward(kForceRefresh);
+    ASSERT_OK(cache()->refreshNow(opCtx()));
+    ASSERT_EQ(2U, numRefreshed);
+    ASSERT_EQ(0, cache()->getStats().getLastSessionsCollectionJobEntriesSkipped());
+}
+
+// Test that a paced refresh upserts the sessions in batches
+TEST_F(LogicalSessionCacheTest, PacedRefreshUpsertsInBatches) {
+    logicalSessionRefreshBatchPauseMillis.store(1);
+    logicalSessionRefreshBatchSize.store(100);
+    ON_BLOCK_EXIT([] {
+        logicalSessionRefreshBatchPauseMillis.store(0);
+        logicalSessionRefreshBatchSize.store(10000);
+    });
+
+    const int count = 250;
+    for (int i = 0; i < count; i++) {
+        ASSERT_OK(cache()->startSession(opCtx(), makeLogicalSessionRecordForTest()));
+    }
+
+    std::vector<size_t> batchSizes;
+    sessions()->setRefreshHook([&batchSizes](const LogicalSessionRecordSet& sessions) {
+        batchSizes.push_back(sessions.size());
+    });
+
+    service()->fastForward(kForceRefresh);
+    ASSERT_OK(cache()->refreshNow(opCtx()));
+    ASSERT(batchSizes == std::vector<size_t>({100, 100, 50}));
+
+    auto stats = cache()->getStats();
+    ASSERT_EQ(count, stats.getLastSessionsCollectionJobEntriesRefreshed());
+    ASSERT_EQ(3, stats.getLastSessionsCollectionJobRefreshBatches());
+}
+
 //
 TEST_F(LogicalSessionCacheTest, RefreshMatrixSessionState) {
     const std::vector<std::vector<std::string>> stateNames = {
@@ -31,7 +31,9 @@
 
 #include "mongo/db/matcher/expression_leaf.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <pcrecpp.h>
 
@@ -44,6 +46,8 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/path.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/regex_util.h"
 #include "mongo/util/str.h"
 
@@ -214,14 +218,100 @@ std::unique_ptr<pcrecpp::RE> RegexMatchExpression::makeRegex(const std::string&
                                          regex_util::flagsToPcreOptions(flags, true));
 }
 
+namespace {
+
+/**
+ * A process-wide cache of the regexes compiled for RegexMatchExpression, keyed by pattern and
+ * flags, so that the same regex isn't recompiled for every query, or every clone of an expression,
+ * which uses it. A pcrecpp::RE can be used to match from several threads at once.
+ */
+class CompiledRegexCache {
+public:
+    static constexpr size_t kMaxSize = 1024;
+
+    std::shared_ptr<const pcrecpp::RE> get(const std::string& regex, const std::string& flags) {
+        // Neither the pattern nor the flags contain a null byte, so the key is unambiguous.
+        auto key = regex + '\0' + flags;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (auto it = _regexes.find(key); it != _regexes.end()) {
+                return it->second;
+            }
+        }
+
+        auto re = std::make_shared<const pcrecpp::RE>(regex.c_str(),
+                                                      regex_util::flagsToPcreOptions(flags, true));
+        if (!re->error().empty()) {
+            return re;
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_regexes.size() >= kMaxSize) {
+            // Expressions keep their own reference to the regexes which they use.
+            _regexes.clear();
+        }
+        return _regexes.emplace(std::move(key), std::move(re)).first->second;
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("CompiledRegexCache::_mutex");
+    stdx::unordered_map<std::string, std::shared_ptr<const pcrecpp::RE>> _regexes;
+};
+
+CompiledRegexCache compiledRegexCache;
+
+/**
+ * Returns the literal text which any string matched by 'regex' must begin with, or an empty string
+ * if there is none we can tell. Sets 'isWholeRegex' to whether matching 'regex' is the same as
+ * checking for this prefix.
+ */
+std::string getLiteralPrefix(const std::string& regex,
+                             const std::string& flags,
+                             bool* isWholeRegex) {
+    *isWholeRegex = false;
+
+    // Only a regex anchored at the start of the string has a prefix. With the 'm' flag '^' also
+    // matches after any newline, and the 'i' and 'x' flags change the meaning of the literal text.
+    if (regex.empty() || regex[0] != '^' || regex.find('|') != std::string::npos ||
+        flags.find_first_of("imx") != std::string::npos) {
+        return "";
+    }
+
+    size_t end = 1;
+    while (end < regex.size() && !std::strchr("\\^$.|?*+()[]{}", regex[end])) {
+        ++end;
+    }
+
+    if (end == regex.size()) {
+        *isWholeRegex = true;
+        return regex.substr(1);
+    }
+
+    // A quantifier applies to the character before it, which therefore may not be present. That
+    // character may be a multi-byte UTF-8 sequence, so back up over its continuation bytes too.
+    if (std::strchr("?*+{", regex[end])) {
+        --end;
+        while (end > 1 && (static_cast<unsigned char>(regex[end]) & 0xC0) == 0x80) {
+            --end;
+        }
+    }
+    return regex.substr(1, end - 1);
+}
+
+bool isAscii(StringData str) {
+    return std::all_of(
+        str.begin(), str.end(), [](char c) { return static_cast<unsigned char>(c) < 0x80; });
+}
+
+}  // namespace
+
 RegexMatchExpression::RegexMatchExpression(StringData path,
                                            StringData regex,
                                            StringData options,
                                            clonable_ptr<ErrorAnnotation> annotation)
     : LeafMatchExpression(REGEX, path, std::move(annotation)),
       _regex(regex.toString()),
-      _flags(options.toString()),
-      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags, true))) {
+      _flags(options.toString()) {
 
     uassert(ErrorCodes::BadValue,
             "Regular expression cannot contain an embedded null byte",
@@ -231,9 +321,12 @@ RegexMatchExpression::RegexMatchExpression(StringData path,
             "Regular expression options string cannot contain an embedded null byte",
             _flags.find('\0') == std::string::npos);
 
+    _re = compiledRegexCache.get(_regex, _flags);
     uassert(51091,
             str::stream() << "Regular expression is invalid: " << _re->error(),
             _re->error().empty());
+
+    _literalPrefix = getLiteralPrefix(_regex, _flags, &_regexIsLiteralPrefix);
 }
 
 RegexMatchExpression::~RegexMatchExpression() {}
@@ -254,7 +347,17 @@ bool RegexMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetai
             // String values stored in documents can contain embedded NUL bytes. We construct a
             // pcrecpp::StringPiece instance using the full length of the string to avoid truncating
             // 'data' early.
-            pcrecpp::StringPiece data(e.valuestr(), e.valuestrsize() - 1);
+            StringData str(e.valuestr(), e.valuestrsize() - 1);
+            if (!_literalPrefix.empty()) {
+                if (!str.startsWith(_literalPrefix)) {
+                    return false;
+                }
+                // PCRE doesn't match strings which aren't valid UTF-8, so leave those to the regex.
+                if (_regexIsLiteralPrefix && isAscii(str)) {
+                    return true;
+                }
+            }
+            pcrecpp::StringPiece data(str.rawData(), str.size());
             return _re->PartialMatch(data);
         }
         case RegEx:
@@ -389,6 +492,11 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
     next->_originalEqualityVector = _originalEqualityVector;
+    next->_backingBSON = _backingBSON;
+    if (_hashedEqualitySet) {
+        next->_hashedEqualitySet.emplace(next->_eltCmp.makeBSONEltUnorderedSet());
+        next->_hashedEqualitySet->insert(next->_equalitySet.begin(), next->_equalitySet.end());
+    }
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
             static_cast<RegexMatchExpression*>(regex->shallowClone().release()));
@@ -398,6 +506,9 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
 }
 
 bool InMatchExpression::contains(const BSONElement& e) const {
+    if (_hashedEqualitySet) {
+        return _hashedEqualitySet->find(e) != _hashedEqualitySet->end();
+    }
     return std::binary_search(_equalitySet.begin(), _equalitySet.end(), e, _eltCmp.makeLessThan());
 }
 
@@ -495,20 +606,8 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
     _collator = collator;
     _eltCmp = BSONElementComparator(BSONElementComparator::FieldNamesMode::kIgnore, _collator);
 
-    if (!std::is_sorted(_originalEqualityVector.begin(),
-                        _originalEqualityVector.end(),
-                        _eltCmp.makeLessThan())) {
-        std::sort(
-            _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeLessThan());
-    }
-
     // We need to re-compute '_equalitySet', since our set comparator has changed.
-    _equalitySet.clear();
-    _equalitySet.reserve(_originalEqualityVector.size());
-    std::unique_copy(_originalEqualityVector.begin(),
-                     _originalEqualityVector.end(),
-                     std::back_inserter(_equalitySet),
-                     _eltCmp.makeEqualTo());
+    _buildEqualitySet();
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -528,7 +627,12 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
     }
 
     _originalEqualityVector = std::move(equalities);
+    _buildEqualitySet();
+
+    return Status::OK();
+}
 
+void InMatchExpression::_buildEqualitySet() {
     if (!std::is_sorted(_originalEqualityVector.begin(),
                         _originalEqualityVector.end(),
                         _eltCmp.makeLessThan())) {
@@ -543,7 +647,12 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
 
-    return Status::OK();
+    _hashedEqualitySet = boost::none;
+    if (_equalitySet.size() >= kMinEqualitiesForHashedLookup) {
+        _hashedEqualitySet.emplace(_eltCmp.makeBSONEltUnorderedSet());
+        _hashedEqualitySet->reserve(_equalitySet.size());
+        _hashedEqualitySet->insert(_equalitySet.begin(), _equalitySet.end());
+    }
 }
 
 Status InMatchExpression::addRegex(std::unique_ptr<RegexMatchExpression> expr) {
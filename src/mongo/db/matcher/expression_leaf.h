@@ -94,6 +94,10 @@ public:
  */
 class ComparisonMatchExpressionBase : public LeafMatchExpression {
 public:
+    // Identifies the right hand side of a comparison as a parameter of its query, see
+    // setInputParamId().
+    using InputParamId = int32_t;
+
     static bool isEquality(MatchType matchType) {
         switch (matchType) {
             case MatchExpression::EQ:
@@ -142,6 +146,20 @@ public:
         return _collator;
     }
 
+    /**
+     * Marks the right hand side of this expression as the input parameter 'paramId' of its query.
+     * A plan built for a parameterized query reads the values of its parameters at runtime, so it
+     * can be reused by another query of the same shape by binding the values of that query to the
+     * same parameter ids. The id is preserved by shallowClone().
+     */
+    void setInputParamId(boost::optional<InputParamId> paramId) {
+        _inputParamId = paramId;
+    }
+
+    boost::optional<InputParamId> getInputParamId() const {
+        return _inputParamId;
+    }
+
 protected:
     /**
      * 'collator' must outlive the ComparisonMatchExpression and any clones made of it.
@@ -157,6 +175,8 @@ protected:
     // Collator used to compare elements. By default, simple binary comparison will be used.
     const CollatorInterface* _collator = nullptr;
 
+    boost::optional<InputParamId> _inputParamId;
+
 private:
     ExpressionOptimizerFunc getOptimizer() const final {
         return [](std::unique_ptr<MatchExpression> expression) { return expression; };
@@ -221,6 +241,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return e;
     }
 
@@ -257,6 +278,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return e;
     }
 
@@ -293,6 +315,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return e;
     }
 
@@ -334,6 +357,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return e;
     }
 
@@ -374,6 +398,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return e;
     }
 
@@ -453,7 +478,16 @@ private:
 
     std::string _regex;
     std::string _flags;
-    std::unique_ptr<pcrecpp::RE> _re;
+
+    // Compiled regexes are shared by all of the expressions with the same pattern and flags,
+    // including the clones made during planning.
+    std::shared_ptr<const pcrecpp::RE> _re;
+
+    // The literal text which every string matched by an anchored regex must start with, which is
+    // checked before running the regex. If the regex is nothing but this prefix, then the regex
+    // only needs to run on strings which the prefix check alone can't decide.
+    std::string _literalPrefix;
+    bool _regexIsLiteralPrefix = false;
 };
 
 class ModMatchExpression : public LeafMatchExpression {
@@ -552,6 +586,10 @@ private:
  */
 class InMatchExpression : public LeafMatchExpression {
 public:
+    // The number of distinct equalities from which membership is tested with a hash lookup rather
+    // than a binary search.
+    static constexpr size_t kMinEqualitiesForHashedLookup = 64;
+
     explicit InMatchExpression(StringData path, clonable_ptr<ErrorAnnotation> annotation = nullptr);
 
     virtual std::unique_ptr<MatchExpression> shallowClone() const;
@@ -571,6 +609,14 @@ public:
 
     Status setEqualities(std::vector<BSONElement> equalities);
 
+    /**
+     * Makes this expression, and any clones made of it, keep 'backingBSON' alive. Used when the
+     * elements given to setEqualities() are not owned by the query the expression was parsed from.
+     */
+    void setBackingBSON(BSONObj backingBSON) {
+        _backingBSON = std::move(backingBSON);
+    }
+
     Status addRegex(std::unique_ptr<RegexMatchExpression> expr);
 
     const std::vector<BSONElement>& getEqualities() const {
@@ -606,6 +652,12 @@ public:
 private:
     ExpressionOptimizerFunc getOptimizer() const final;
 
+    /**
+     * Sets '_equalitySet' to the sorted and deduped '_originalEqualityVector', and rebuilds
+     * '_hashedEqualitySet' from it.
+     */
+    void _buildEqualitySet();
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -629,12 +681,19 @@ private:
     // support std::binary_search. Because we need to sort the elements anyway for things like index
     // bounds building, using binary search avoids the overhead of inserting into a hash table which
     // doesn't pay for itself in the common case where lookups are done a few times if ever.
-    // TODO It may be worth dynamically creating a hashset after matchesSingleElement() has been
-    // called "many" times.
     std::vector<BSONElement> _equalitySet;
 
+    // The elements of '_equalitySet', hashed according to '_eltCmp', when there are at least
+    // 'kMinEqualitiesForHashedLookup' of them. The binary search of a list that long takes enough
+    // comparisons for the hash table to pay for itself quickly. As the set refers to '_eltCmp', it
+    // is rebuilt rather than copied by shallowClone().
+    boost::optional<BSONEltUnorderedSet> _hashedEqualitySet;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
+
+    // Owns the equality elements, if they don't belong to the query this expression came from.
+    BSONObj _backingBSON;
 };
 
 /**
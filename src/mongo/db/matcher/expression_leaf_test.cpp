@@ -729,6 +729,60 @@ TEST(RegexMatchExpression, MatchesElementSimplePrefix) {
     ASSERT(!regex.matchesSingleElement(notMatch.firstElement()));
 }
 
+TEST(RegexMatchExpression, MatchesElementLiteralPrefixFollowedByPattern) {
+    auto matches = [](StringData pattern, StringData flags, StringData str) {
+        RegexMatchExpression regex("", pattern, flags);
+        return regex.matchesSingleElement(BSON("x" << str).firstElement());
+    };
+
+    // The character before a quantifier is not part of the literal prefix.
+    ASSERT(matches("^abc?", "", "ab"));
+    ASSERT(matches("^abc*d", "", "abd"));
+    ASSERT(matches("^abc{0,1}", "", "abx"));
+    ASSERT(!matches("^abc+", "", "ab"));
+
+    // The whole of a multi-byte UTF-8 character before a quantifier is left out of the prefix.
+    ASSERT(matches("^\xc3\xa9?", "", "x"));
+    ASSERT(matches("^a\xc3\xa9*b", "", "ab"));
+    ASSERT(matches("^a\xc3\xa9?", "", "a\xc3\xa9"));
+    ASSERT(!matches("^a\xc3\xa9+", "", "a"));
+
+    ASSERT(matches("^ab\\d", "", "ab1"));
+    ASSERT(!matches("^ab\\d", "", "abc"));
+    ASSERT(matches("^ab.", "", "abc"));
+    ASSERT(!matches("^ab.", "", "ab"));
+
+    // An alternation or the 'i', 'm' and 'x' flags change what the regex can match, so no prefix
+    // must be assumed for them.
+    ASSERT(matches("^ab|cd", "", "xcd"));
+    ASSERT(matches("^ab", "i", "ABc"));
+    ASSERT(matches("^ab", "m", "x\nabc"));
+    ASSERT(matches("^a b", "x", "ab"));
+}
+
+TEST(RegexMatchExpression, MatchesElementWholeLiteralPrefixWithNonAsciiString) {
+    RegexMatchExpression regex("", "^ab", "");
+    ASSERT(regex.matchesSingleElement(BSON("x"
+                                           << "ab\xc2\xa5")
+                                          .firstElement()));
+
+    // PCRE never matches a string which isn't valid UTF-8.
+    ASSERT(!regex.matchesSingleElement(BSON("x"
+                                            << "ab\xc2")
+                                           .firstElement()));
+}
+
+TEST(RegexMatchExpression, ClonedExpressionMatchesLikeTheOriginal) {
+    RegexMatchExpression regex("a", "^ab.*c", "s");
+    auto clone = regex.shallowClone();
+    ASSERT(clone->matchesSingleElement(BSON("a"
+                                            << "ab\nc")
+                                           .firstElement()));
+    ASSERT(!clone->matchesSingleElement(BSON("a"
+                                             << "abd")
+                                            .firstElement()));
+}
+
 TEST(RegexMatchExpression, MatchesElementCaseSensitive) {
     BSONObj match = BSON("x"
                          << "abc");
@@ -1370,6 +1424,54 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.contains(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, LargeEqualityListMatchesNumbersOfAnyType) {
+    BSONArrayBuilder operand;
+    for (int i = 0; i < 1000; ++i) {
+        operand.append(i * 2);
+        operand.append(i * 2);
+    }
+    BSONArray operandArr = operand.arr();
+    InMatchExpression in("a");
+    std::vector<BSONElement> equalities;
+    operandArr.elems(equalities);
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+    ASSERT_EQ(1000U, in.getEqualities().size());
+
+    ASSERT(in.matchesSingleElement(BSON("a" << 10)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 10LL)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 10.0)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << Decimal128(10))["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 11)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 10.5)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "10")["a"]));
+
+    auto clone = in.shallowClone();
+    ASSERT(clone->matchesSingleElement(BSON("a" << 1998)["a"]));
+    ASSERT(!clone->matchesSingleElement(BSON("a" << 2000)["a"]));
+}
+
+TEST(InMatchExpression, LargeEqualityListRespectsCollation) {
+    BSONArrayBuilder operand;
+    for (int i = 0; i < 100; ++i) {
+        operand.append("string" + std::to_string(i));
+    }
+    BSONArray operandArr = operand.arr();
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    InMatchExpression in("a");
+    std::vector<BSONElement> equalities;
+    operandArr.elems(equalities);
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "STRING42")["a"]));
+
+    in.setCollator(&collator);
+    ASSERT(in.matchesSingleElement(BSON("a"
+                                        << "STRING42")["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "STRING100")["a"]));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
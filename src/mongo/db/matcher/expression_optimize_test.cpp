@@ -449,5 +449,74 @@ TEST(ExpressionOptimizeTest, NestedOrWithAlwaysTrueOptimizesToAlwaysTrue) {
     ASSERT_BSONOBJ_EQ(bob.obj(), fromjson("{$alwaysTrue: 1}"));
 }
 
+BSONObj orOfEqualities(StringData path, int numEqualities, BSONObj otherBranch = BSONObj()) {
+    BSONObjBuilder bob;
+    BSONArrayBuilder orBuilder(bob.subarrayStart("$or"));
+    for (int i = 0; i < numEqualities; ++i) {
+        orBuilder.append(BSON(path << i));
+    }
+    if (!otherBranch.isEmpty()) {
+        orBuilder.append(otherBranch);
+    }
+    orBuilder.doneFast();
+    return bob.obj();
+}
+
+TEST(ExpressionOptimizeTest, OrOfManyEqualitiesOnOnePathOptimizesToIn) {
+    std::unique_ptr<MatchExpression> matchExpression;
+    {
+        // The optimized expression must not depend on the query it was parsed from.
+        BSONObj obj = orOfEqualities("a", 100, BSON("b" << 1));
+        matchExpression.reset(parseMatchExpression(obj));
+        matchExpression = MatchExpression::optimize(std::move(matchExpression));
+    }
+    ASSERT_EQ(matchExpression->matchType(), MatchExpression::OR);
+    ASSERT_EQ(matchExpression->numChildren(), 2U);
+    ASSERT_EQ(matchExpression->getChild(0)->matchType(), MatchExpression::MATCH_IN);
+    ASSERT_EQ(matchExpression->getChild(1)->matchType(), MatchExpression::EQ);
+    auto inExpr = static_cast<const InMatchExpression*>(matchExpression->getChild(0));
+    ASSERT_EQ(inExpr->path(), "a");
+    ASSERT_EQ(inExpr->getEqualities().size(), 100U);
+
+    ASSERT_TRUE(matchExpression->matchesBSON(BSON("a" << 0)));
+    ASSERT_TRUE(matchExpression->matchesBSON(BSON("a" << BSON_ARRAY(200 << 99))));
+    ASSERT_TRUE(matchExpression->matchesBSON(BSON("a" << 200 << "b" << 1)));
+    ASSERT_FALSE(matchExpression->matchesBSON(BSON("a" << 100)));
+
+    auto clone = matchExpression->shallowClone();
+    matchExpression.reset();
+    ASSERT_TRUE(clone->matchesBSON(BSON("a" << 50)));
+}
+
+TEST(ExpressionOptimizeTest, OrOfEqualitiesCollapsesToSingleInWhenNothingElseRemains) {
+    BSONObj obj = orOfEqualities("a.b", 64);
+    std::unique_ptr<MatchExpression> matchExpression(parseMatchExpression(obj));
+    matchExpression = MatchExpression::optimize(std::move(matchExpression));
+    ASSERT_EQ(matchExpression->matchType(), MatchExpression::MATCH_IN);
+    ASSERT_EQ(matchExpression->path(), "a.b");
+    ASSERT_TRUE(matchExpression->matchesBSON(fromjson("{a: [{b: 100}, {b: 63}]}")));
+    ASSERT_FALSE(matchExpression->matchesBSON(fromjson("{a: {b: 64}}")));
+}
+
+TEST(ExpressionOptimizeTest, OrOfFewEqualitiesIsNotCollapsed) {
+    BSONObj obj = orOfEqualities("a", InMatchExpression::kMinEqualitiesForHashedLookup - 1);
+    std::unique_ptr<MatchExpression> matchExpression(parseMatchExpression(obj));
+    matchExpression = MatchExpression::optimize(std::move(matchExpression));
+    ASSERT_EQ(matchExpression->matchType(), MatchExpression::OR);
+    ASSERT_EQ(matchExpression->numChildren(), InMatchExpression::kMinEqualitiesForHashedLookup - 1);
+}
+
+TEST(ExpressionOptimizeTest, OrOfEqualitiesDoesNotCollapseRegexEquality) {
+    BSONObj obj = orOfEqualities("a", 64, fromjson("{a: {$eq: /^x/}}"));
+    std::unique_ptr<MatchExpression> matchExpression(parseMatchExpression(obj));
+    matchExpression = MatchExpression::optimize(std::move(matchExpression));
+    ASSERT_EQ(matchExpression->matchType(), MatchExpression::OR);
+    ASSERT_EQ(matchExpression->numChildren(), 2U);
+    ASSERT_EQ(matchExpression->getChild(0)->matchType(), MatchExpression::MATCH_IN);
+    ASSERT_EQ(matchExpression->getChild(1)->matchType(), MatchExpression::EQ);
+    ASSERT_FALSE(matchExpression->matchesBSON(BSON("a"
+                                                   << "xyz")));
+}
+
 }  // namespace
 }  // namespace mongo
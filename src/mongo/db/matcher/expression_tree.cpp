@@ -33,10 +33,75 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/matcher/expression_always_boolean.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/expression_path.h"
 #include "mongo/db/matcher/expression_text_base.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
+namespace {
+
+/**
+ * Collapses the equality children of an OR which share a path into a single $in on that path, when
+ * there are enough of them for the $in's hashed lookup to beat testing each equality in turn. The
+ * $in takes the place of the first of those equalities. Smaller ORs are left as they are, so that
+ * their equalities stay eligible for parameterization and for indexed OR plans.
+ */
+void collapseEqualitiesIntoIn(std::vector<MatchExpression*>* children) {
+    StringMap<std::vector<size_t>> equalitiesByPath;
+    for (size_t i = 0; i < children->size(); ++i) {
+        auto child = (*children)[i];
+        if (child->matchType() != MatchExpression::EQ || child->getErrorAnnotation() ||
+            child->getTag()) {
+            continue;
+        }
+
+        // An $in treats a regex as a pattern to match rather than a value, and rejects undefined.
+        auto eq = static_cast<EqualityMatchExpression*>(child);
+        auto type = eq->getData().type();
+        if (type == BSONType::RegEx || type == BSONType::Undefined) {
+            continue;
+        }
+        equalitiesByPath[eq->path().toString()].push_back(i);
+    }
+
+    bool collapsedAny = false;
+    for (auto&& [path, indexes] : equalitiesByPath) {
+        if (indexes.size() < InMatchExpression::kMinEqualitiesForHashedLookup) {
+            continue;
+        }
+
+        auto first = static_cast<EqualityMatchExpression*>((*children)[indexes.front()]);
+        BSONArrayBuilder equalitiesBuilder;
+        for (auto index : indexes) {
+            equalitiesBuilder.append(static_cast<EqualityMatchExpression*>((*children)[index])
+                                         ->getData());
+        }
+        auto backingBSON = equalitiesBuilder.arr();
+        std::vector<BSONElement> equalities;
+        for (auto&& elem : backingBSON) {
+            equalities.push_back(elem);
+        }
+
+        auto inExpr = std::make_unique<InMatchExpression>(first->path());
+        inExpr->setCollator(first->getCollator());
+        uassertStatusOK(inExpr->setEqualities(std::move(equalities)));
+        inExpr->setBackingBSON(std::move(backingBSON));
+
+        for (auto index : indexes) {
+            std::unique_ptr<MatchExpression> eqPtr((*children)[index]);
+            (*children)[index] = nullptr;
+        }
+        (*children)[indexes.front()] = inExpr.release();
+        collapsedAny = true;
+    }
+
+    if (collapsedAny) {
+        children->erase(std::remove(children->begin(), children->end(), nullptr), children->end());
+    }
+}
+
+}  // namespace
 
 ListOfMatchExpression::~ListOfMatchExpression() {
     for (unsigned i = 0; i < _expressions.size(); i++) {
@@ -114,6 +179,10 @@ MatchExpression::ExpressionOptimizerFunc ListOfMatchExpression::getOptimizer() c
             children.insert(children.end(), absorbedExpressions.begin(), absorbedExpressions.end());
         }
 
+        if (matchType == OR) {
+            collapseEqualitiesIntoIn(&children);
+        }
+
         // Remove all children of AND that are $alwaysTrue and all children of OR that are
         // $alwaysFalse.
         if (matchType == AND || matchType == OR) {
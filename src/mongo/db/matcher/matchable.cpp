@@ -33,7 +33,7 @@
 
 namespace mongo {
 
-BSONMatchableDocument::BSONMatchableDocument(const BSONObj& obj) : _obj(obj) {
+BSONMatchableDocument::BSONMatchableDocument(const BSONObj& obj) : _index(obj) {
     _iteratorUsed = false;
 }
 
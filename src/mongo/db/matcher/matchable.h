@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/field_ref.h"
@@ -80,14 +81,14 @@ public:
     virtual ~BSONMatchableDocument();
 
     virtual BSONObj toBSON() const {
-        return _obj;
+        return _index.obj();
     }
 
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
         if (_iteratorUsed)
-            return new BSONElementIterator(path, _obj);
+            return new BSONElementIterator(path, _index);
         _iteratorUsed = true;
-        _iterator.reset(path, _obj);
+        _iterator.reset(path, _index);
         return &_iterator;
     }
 
@@ -100,7 +101,8 @@ public:
     }
 
 private:
-    BSONObj _obj;
+    // Matching a large object against many paths finds their top-level fields through the index.
+    BSONFieldIndex _index;
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
 };
@@ -88,6 +88,13 @@ BSONElementIterator::BSONElementIterator(const ElementPath* path, const BSONObj&
         getFieldDottedOrArray(objectToIterate, _path->fieldRef(), &_traversalStartIndex);
 }
 
+BSONElementIterator::BSONElementIterator(const ElementPath* path,
+                                         const BSONFieldIndex& objectToIterate)
+    : _path(path), _state(BEGIN) {
+    _traversalStart =
+        getFieldDottedOrArray(objectToIterate, _path->fieldRef(), &_traversalStartIndex);
+}
+
 BSONElementIterator::~BSONElementIterator() {}
 
 void BSONElementIterator::reset(const ElementPath* path,
@@ -116,6 +123,18 @@ void BSONElementIterator::reset(const ElementPath* path, const BSONObj& objectTo
     _subCursorPath.reset();
 }
 
+void BSONElementIterator::reset(const ElementPath* path, const BSONFieldIndex& objectToIterate) {
+    _path = path;
+    _traversalStartIndex = 0;
+    _traversalStart =
+        getFieldDottedOrArray(objectToIterate, _path->fieldRef(), &_traversalStartIndex);
+    _state = BEGIN;
+    _next.reset();
+
+    _subCursor.reset();
+    _subCursorPath.reset();
+}
+
 void BSONElementIterator::_setTraversalStart(size_t suffixIndex, BSONElement elementToIterate) {
     invariant(_path->fieldRef().numParts() >= suffixIndex);
 
@@ -32,6 +32,7 @@
 
 #include "mongo/base/status.h"
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/field_ref.h"
 
@@ -209,10 +210,17 @@ public:
      */
     BSONElementIterator(const ElementPath* path, const BSONObj& objectToIterate);
 
+    /**
+     * As above, but finds the start of 'path' through an index over the object, which is cheaper
+     * when many paths are iterated over the same large object.
+     */
+    BSONElementIterator(const ElementPath* path, const BSONFieldIndex& objectToIterate);
+
     virtual ~BSONElementIterator();
 
     void reset(const ElementPath* path, size_t suffixIndex, BSONElement elementToIterate);
     void reset(const ElementPath* path, const BSONObj& objectToIterate);
+    void reset(const ElementPath* path, const BSONFieldIndex& objectToIterate);
 
     bool more();
     Context next();
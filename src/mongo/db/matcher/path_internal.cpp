@@ -80,5 +80,28 @@ BSONElement getFieldDottedOrArray(const BSONObj& doc,
     return res;
 }
 
+BSONElement getFieldDottedOrArray(const BSONFieldIndex& doc,
+                                  const FieldRef& path,
+                                  size_t* idxPath) {
+    if (path.numParts() == 0)
+        return doc.getField("");
+
+    // Only the top-level lookup, which is the one repeated for every path, uses the index.
+    BSONElement res = doc.getField(path.getPart(0));
+    if (res.type() == Object) {
+        if (path.numParts() == 1) {
+            *idxPath = 1;
+            return res;
+        }
+        return getFieldDottedOrArray(res.Obj(), path, idxPath, 1);
+    }
+
+    *idxPath = 0;
+    if (res.type() != EOO && res.type() != Array && path.numParts() > 1) {
+        return BSONElement();
+    }
+    return res;
+}
+
 
 }  // namespace mongo
@@ -32,6 +32,7 @@
 #include <cstdint>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/jsobj.h"
 
@@ -49,4 +50,9 @@ BSONElement getFieldDottedOrArray(const BSONObj& doc,
                                   size_t* idxPath,
                                   size_t startIndex = 0);
 
+/**
+ * As above, for the whole of 'path' in the object indexed by 'doc'.
+ */
+BSONElement getFieldDottedOrArray(const BSONFieldIndex& doc, const FieldRef& path, size_t* idxPath);
+
 }  // namespace mongo
@@ -533,6 +533,31 @@ TEST(Path, LeafArrayBehaviorTraverseOmitArrayNestedEmptyArray) {
     ASSERT_FALSE(cursor.more());
 }
 
+TEST(Path, IndexedObjectIteratesLikeObject) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 100; ++i) {
+        builder.append("f" + std::to_string(i), std::string(20, 'x'));
+    }
+    builder.append("a", fromjson("{b: [{c: 1}, {c: 2}], d: 3}"));
+    builder.append("e", BSON_ARRAY(BSON("b" << 4) << 5));
+    BSONObj doc = builder.obj();
+    BSONFieldIndex index(doc);
+
+    for (auto&& pathStr : {"a", "a.b", "a.b.c", "a.d", "a.d.x", "a.z", "e", "e.b", "e.1", "f5",
+                           "f5.x", "f99", "z", "z.b"}) {
+        ElementPath path{pathStr};
+        BSONElementIterator expected(&path, doc);
+        BSONElementIterator cursor(&path, index);
+        while (expected.more()) {
+            ASSERT_TRUE(cursor.more()) << pathStr;
+            ASSERT_EQUALS(expected.next().element().rawdata(), cursor.next().element().rawdata())
+                << pathStr;
+        }
+        ASSERT_FALSE(cursor.more()) << pathStr;
+    }
+    ASSERT_TRUE(index.isIndexed());
+}
+
 TEST(SimpleArrayElementIterator, SimpleNoArrayLast1) {
     BSONObj obj = BSON("a" << BSON_ARRAY(5 << BSON("x" << 6) << BSON_ARRAY(7 << 9) << 11));
     SimpleArrayElementIterator i(obj["a"], false);
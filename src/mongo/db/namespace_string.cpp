@@ -152,6 +152,9 @@ bool NamespaceString::isLegalClientSystemNS() const {
     if (isTimeseriesBucketsCollection()) {
         return true;
     }
+    if (isMaterializedViewCollection()) {
+        return true;
+    }
 
     return false;
 }
@@ -291,6 +294,14 @@ NamespaceString NamespaceString::makeTimeseriesBucketsNamespace() const {
     return {db(), bucketsColl};
 }
 
+bool NamespaceString::isMaterializedViewCollection() const {
+    return coll().startsWith(kMaterializedViewCollectionPrefix);
+}
+
+NamespaceString NamespaceString::makeMaterializedViewNamespace() const {
+    return {db(), kMaterializedViewCollectionPrefix.toString() + coll()};
+}
+
 bool NamespaceString::isReplicated() const {
     if (isLocal()) {
         return false;
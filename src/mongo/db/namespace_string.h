@@ -79,6 +79,9 @@ public:
     // Prefix for time-series buckets collection.
     static constexpr StringData kTimeseriesBucketsCollectionPrefix = "system.buckets."_sd;
 
+    // Prefix for the collection backing a materialized view.
+    static constexpr StringData kMaterializedViewCollectionPrefix = "system.materialized."_sd;
+
     // Namespace for storing configuration data, which needs to be replicated if the server is
     // running as a replica set. Documents in this collection should represent some configuration
     // state of the server, which needs to be recovered/consulted at startup. Each document in this
@@ -323,6 +326,16 @@ public:
      */
     NamespaceString makeTimeseriesBucketsNamespace() const;
 
+    /**
+     * Returns whether the specified namespace is <database>.system.materialized.<>.
+     */
+    bool isMaterializedViewCollection() const;
+
+    /**
+     * Returns the namespace of the collection backing this materialized view.
+     */
+    NamespaceString makeMaterializedViewNamespace() const;
+
     /**
      * Returns whether a namespace is replicated, based only on its string value. One notable
      * omission is that map reduce `tmp.mr` collections may or may not be replicated. Callers must
@@ -94,6 +94,7 @@ StatusWith<BSONObj> fixDocumentForInsert(OperationContext* opCtx, const BSONObj&
     bool firstElementIsId = false;
     bool hasTimestampToFix = false;
     bool hadId = false;
+    BSONElement idElem;
     {
         BSONObjIterator i(doc);
         for (bool isFirstElement = true; i.more(); isFirstElement = false) {
@@ -139,6 +140,7 @@ StatusWith<BSONObj> fixDocumentForInsert(OperationContext* opCtx, const BSONObj&
                 } else {
                     hadId = true;
                     firstElementIsId = isFirstElement;
+                    idElem = e;
                 }
             }
         }
@@ -147,9 +149,26 @@ StatusWith<BSONObj> fixDocumentForInsert(OperationContext* opCtx, const BSONObj&
     if (firstElementIsId && !hasTimestampToFix)
         return StatusWith<BSONObj>(BSONObj());
 
-    BSONObjIterator i(doc);
-
     BSONObjBuilder b(doc.objsize() + 16);
+
+    if (!hasTimestampToFix) {
+        // Only the _id needs to move to the front, so the other elements are copied in at most two
+        // contiguous runs rather than one by one.
+        const char* const begin = doc.objdata() + 4;
+        const char* const end = doc.objdata() + doc.objsize() - 1;
+        if (hadId) {
+            b.append(idElem);
+            b.bb().appendBuf(begin, idElem.rawdata() - begin);
+            const char* const afterId = idElem.rawdata() + idElem.size();
+            b.bb().appendBuf(afterId, end - afterId);
+        } else {
+            b.appendOID("_id", nullptr, true);
+            b.bb().appendBuf(begin, end - begin);
+        }
+        return StatusWith<BSONObj>(b.obj());
+    }
+
+    BSONObjIterator i(doc);
     if (firstElementIsId) {
         b.append(doc.firstElement());
         i.next();
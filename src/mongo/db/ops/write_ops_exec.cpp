@@ -287,6 +287,29 @@ bool handleError(OperationContext* opCtx,
     return !wholeOp.getOrdered();
 }
 
+/**
+ * Returns true if the inserts of a batch should be logged as the operations of a single applyOps
+ * oplog entry, which requires them to share one optime. This is only done for batches that are
+ * neither retryable writes nor migrations, whose oplog entries are looked up individually, and
+ * that fit comfortably in one oplog entry.
+ */
+bool shouldGroupOplogEntries(OperationContext* opCtx,
+                             const CollectionPtr& collection,
+                             std::vector<InsertStatement>::iterator begin,
+                             std::vector<InsertStatement>::iterator end,
+                             bool fromMigrate) {
+    if (!internalInsertGroupOplogEntries.load() || std::distance(begin, end) < 2 || fromMigrate ||
+        opCtx->getTxnNumber() || collection->isCapped() || collection->ns().isOnInternalDb()) {
+        return false;
+    }
+
+    size_t bytesInBatch = 0;
+    for (auto it = begin; it != end; it++) {
+        bytesInBatch += it->doc.objsize();
+    }
+    return bytesInBatch <= write_ops::insertVectorMaxBytes;
+}
+
 void insertDocuments(OperationContext* opCtx,
                      const CollectionPtr& collection,
                      std::vector<InsertStatement>::iterator begin,
@@ -307,12 +330,20 @@ void insertDocuments(OperationContext* opCtx,
     auto inTransaction = opCtx->inMultiDocumentTransaction();
 
     if (!inTransaction && !replCoord->isOplogDisabledFor(opCtx, collection->ns())) {
-        // Populate 'slots' with new optimes for each insert.
-        // This also notifies the storage engine of each new timestamp.
-        auto oplogSlots = repl::getNextOpTimes(opCtx, batchSize);
-        auto slot = oplogSlots.begin();
-        for (auto it = begin; it != end; it++) {
-            it->oplogSlot = *slot++;
+        if (shouldGroupOplogEntries(opCtx, collection, begin, end, fromMigrate)) {
+            // The inserts share the single optime of the applyOps entry they are logged in.
+            auto oplogSlot = repl::getNextOpTimes(opCtx, 1U).front();
+            for (auto it = begin; it != end; it++) {
+                it->oplogSlot = oplogSlot;
+            }
+        } else {
+            // Populate 'slots' with new optimes for each insert.
+            // This also notifies the storage engine of each new timestamp.
+            auto oplogSlots = repl::getNextOpTimes(opCtx, batchSize);
+            auto slot = oplogSlots.begin();
+            for (auto it = begin; it != end; it++) {
+                it->oplogSlot = *slot++;
+            }
         }
     }
 
@@ -582,7 +613,7 @@ WriteResult performInserts(OperationContext* opCtx,
             // current batch to preserve the error results order.
         } else {
             BSONObj toInsert = fixedDoc.getValue().isEmpty() ? doc : std::move(fixedDoc.getValue());
-            batch.emplace_back(stmtId, toInsert);
+            batch.emplace_back(stmtId, std::move(toInsert));
             bytesInBatch += batch.back().doc.objsize();
 
             if (!isLastDoc && batch.size() < maxBatchSize && bytesInBatch < maxBatchBytes)
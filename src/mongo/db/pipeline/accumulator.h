@@ -40,13 +40,18 @@
 #include "mongo/bson/bsontypes.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/exec/sort_key_comparator.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/stdx/unordered_set.h"
+#include "mongo/util/hyper_log_log.h"
 #include "mongo/util/summation.h"
+#include "mongo/util/t_digest.h"
 
 namespace mongo {
 
+struct AccumulationExpression;
+
 /**
  * This enum indicates which documents an accumulator needs to see in order to compute its output.
  */
@@ -81,6 +86,14 @@ public:
         processInternal(input, merging);
     }
 
+    /**
+     * Processes each of 'inputs' in turn, as process() would. Accumulators which can process runs
+     * of values faster than one at a time override processBatchInternal() to do so.
+     */
+    void processBatch(const std::vector<Value>& inputs, bool merging) {
+        processBatchInternal(inputs, merging);
+    }
+
     /**
      * Finish processing all the pending operations, and clean up memory. Some accumulators
      * ($accumulator for example) might do a batch processing in order to improve performace. In
@@ -145,6 +158,12 @@ protected:
     /// Update subclass's internal state based on input
     virtual void processInternal(const Value& input, bool merging) = 0;
 
+    virtual void processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+        for (auto&& input : inputs) {
+            processInternal(input, merging);
+        }
+    }
+
     auto getExpressionContext() const {
         return _expCtx;
     }
@@ -224,11 +243,50 @@ private:
     Value _last;
 };
 
+/**
+ * Computes $first or $last as if the input had been ordered by a sort pattern, without the input
+ * having to arrive in that order. Each input is an array holding the sort key generated for the
+ * document and the value of the $first or $last argument for it; the accumulator keeps the value
+ * whose sort key comes first (or last) under the sort pattern. The partial state passed between
+ * merging accumulators has the same shape as the input.
+ */
+class AccumulatorFirstLastBySortKey final : public AccumulatorState {
+public:
+    enum class Sense { kFirst, kLast };
+
+    AccumulatorFirstLastBySortKey(ExpressionContext* const expCtx,
+                                  const SortPattern& sortPattern,
+                                  Sense sense);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* const expCtx,
+                                                         const SortPattern& sortPattern,
+                                                         Sense sense);
+
+    AccumulatorDocumentsNeeded documentsNeeded() const final {
+        return _sense == Sense::kFirst ? AccumulatorDocumentsNeeded::kFirstDocument
+                                       : AccumulatorDocumentsNeeded::kLastDocument;
+    }
+
+private:
+    const SortKeyComparator _sortKeyComparator;
+    const Sense _sense;
+
+    bool _haveValue = false;
+    Value _sortKey;
+    Value _value;
+};
+
 class AccumulatorSum final : public AccumulatorState {
 public:
     explicit AccumulatorSum(ExpressionContext* const expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatchInternal(const std::vector<Value>& inputs, bool merging) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -314,6 +372,7 @@ public:
     explicit AccumulatorAvg(ExpressionContext* const expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatchInternal(const std::vector<Value>& inputs, bool merging) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -338,6 +397,7 @@ public:
     AccumulatorStdDev(ExpressionContext* const expCtx, bool isSamp);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatchInternal(const std::vector<Value>& inputs, bool merging) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -378,4 +438,77 @@ private:
     MutableDocument _output;
 };
 
+/**
+ * $approxCountDistinct estimates the number of distinct values in a group with a HyperLogLog
+ * sketch, so it uses a few kilobytes per group however many distinct values there are, unlike
+ * $addToSet followed by $size. Values are told apart as $addToSet would, under the collation of the
+ * expression context. The partial state passed between merging accumulators is the registers of
+ * the sketch, as BinData.
+ */
+class AccumulatorApproxCountDistinct final : public AccumulatorState {
+public:
+    explicit AccumulatorApproxCountDistinct(ExpressionContext* const expCtx);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* const expCtx);
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    HyperLogLog _sketch;
+};
+
+/**
+ * $percentile estimates the values at the quantiles 'p' of the numeric values in a group with a
+ * t-digest, instead of sorting and holding all of them. Its syntax is
+ *     {$percentile: {input: <expression>, p: [<quantile>, ...], method: "approximate"}}
+ * and it returns an array holding the estimate for each quantile, or null if the group had no
+ * numeric values. Non-numeric values and NaNs are ignored. The partial state passed between
+ * merging accumulators holds the smallest and largest values and the centroids of the digest.
+ */
+class AccumulatorPercentile final : public AccumulatorState {
+public:
+    AccumulatorPercentile(ExpressionContext* const expCtx, std::vector<double> ps);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    Document serialize(boost::intrusive_ptr<Expression> initializer,
+                       boost::intrusive_ptr<Expression> argument,
+                       bool explain) const final;
+
+    static AccumulationExpression parse(ExpressionContext* const expCtx,
+                                        BSONElement elem,
+                                        VariablesParseState vps);
+
+    static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* const expCtx,
+                                                         std::vector<double> ps);
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    void _updateMemUsage();
+
+    const std::vector<double> _ps;
+    TDigest _digest;
+};
+
 }  // namespace mongo
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_ACCUMULATOR(approxCountDistinct,
+                     genericParseSingleExpressionAccumulator<AccumulatorApproxCountDistinct>);
+
+AccumulatorApproxCountDistinct::AccumulatorApproxCountDistinct(ExpressionContext* const expCtx)
+    : AccumulatorState(expCtx) {
+    _memUsageBytes = sizeof(*this) + _sketch.registers().size();
+}
+
+const char* AccumulatorApproxCountDistinct::getOpName() const {
+    return "$approxCountDistinct";
+}
+
+void AccumulatorApproxCountDistinct::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        // Missing values are ignored, as they are by $addToSet.
+        if (!input.missing()) {
+            _sketch.add(
+                HyperLogLog::mix(getExpressionContext()->getValueComparator().hash(input)));
+        }
+        return;
+    }
+
+    // The registers of another sketch, as produced by getValue(true) below.
+    uassert(5843108,
+            "$approxCountDistinct cannot merge a partial state it did not produce",
+            input.getType() == BinData &&
+                static_cast<size_t>(input.getBinData().length) == _sketch.registers().size());
+    const auto binData = input.getBinData();
+    const auto* data = static_cast<const uint8_t*>(binData.data);
+    _sketch.merge(std::vector<uint8_t>(data, data + binData.length));
+}
+
+Value AccumulatorApproxCountDistinct::getValue(bool toBeMerged) {
+    if (toBeMerged) {
+        const auto& registers = _sketch.registers();
+        return Value(BSONBinData(registers.data(), registers.size(), BinDataGeneral));
+    }
+    return Value(_sketch.estimate());
+}
+
+void AccumulatorApproxCountDistinct::reset() {
+    _sketch.reset();
+}
+
+intrusive_ptr<AccumulatorState> AccumulatorApproxCountDistinct::create(
+    ExpressionContext* const expCtx) {
+    return new AccumulatorApproxCountDistinct(expCtx);
+}
+}  // namespace mongo
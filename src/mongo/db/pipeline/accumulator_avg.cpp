@@ -34,6 +34,7 @@
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/accumulator_batch_helpers.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/platform/decimal128.h"
@@ -93,6 +94,40 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
     _count++;
 }
 
+void AccumulatorAvg::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    if (merging) {
+        AccumulatorState::processBatchInternal(inputs, merging);
+        return;
+    }
+
+    accumulator_batch::forEachTypeRun(inputs, [&](BSONType type, auto begin, auto end) {
+        switch (type) {
+            case NumberInt:
+                accumulator_batch::forEachChunk<int>(begin, end, [&](auto values, size_t count) {
+                    _nonDecimalTotal.addInts(values, count);
+                });
+                break;
+            case NumberLong:
+                accumulator_batch::forEachChunk<long long>(
+                    begin, end, [&](auto values, size_t count) {
+                        _nonDecimalTotal.addLongs(values, count);
+                    });
+                break;
+            case NumberDouble:
+                accumulator_batch::forEachChunk<double>(begin, end, [&](auto values, size_t count) {
+                    _nonDecimalTotal.addDoubles(values, count);
+                });
+                break;
+            default:
+                for (; begin != end; ++begin) {
+                    processInternal(*begin, false);
+                }
+                return;
+        }
+        _count += std::distance(begin, end);
+    });
+}
+
 intrusive_ptr<AccumulatorState> AccumulatorAvg::create(ExpressionContext* const expCtx) {
     return new AccumulatorAvg(expCtx);
 }
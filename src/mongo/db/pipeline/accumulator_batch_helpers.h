@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include "mongo/db/exec/document_value/value.h"
+
+namespace mongo::accumulator_batch {
+
+// The number of raw numbers handed to the summation kernels at a time.
+constexpr size_t kChunkSize = 256;
+
+/**
+ * Calls 'onRun(type, begin, end)' for each maximal run [begin, end) of consecutive values of
+ * 'inputs' of the same BSON type, in order.
+ */
+template <typename OnRun>
+void forEachTypeRun(const std::vector<Value>& inputs, OnRun&& onRun) {
+    auto begin = inputs.begin();
+    while (begin != inputs.end()) {
+        const auto type = begin->getType();
+        auto end = std::next(begin);
+        while (end != inputs.end() && end->getType() == type) {
+            ++end;
+        }
+        onRun(type, begin, end);
+        begin = end;
+    }
+}
+
+/**
+ * Copies the numbers held by the values [begin, end) into contiguous chunks of at most 'kChunkSize'
+ * numbers of type 'T', and calls 'onChunk(numbers, count)' for each chunk. 'T' must be int for
+ * NumberInt values and long long for NumberLong values, while any numeric values convert to
+ * double.
+ */
+template <typename T, typename OnChunk>
+void forEachChunk(std::vector<Value>::const_iterator begin,
+                  std::vector<Value>::const_iterator end,
+                  OnChunk&& onChunk) {
+    std::array<T, kChunkSize> chunk;
+    while (begin != end) {
+        size_t count = 0;
+        for (; begin != end && count < kChunkSize; ++begin) {
+            if constexpr (std::is_same_v<T, int>) {
+                chunk[count++] = begin->getInt();
+            } else if constexpr (std::is_same_v<T, long long>) {
+                chunk[count++] = begin->getLong();
+            } else {
+                static_assert(std::is_same_v<T, double>);
+                chunk[count++] = begin->getDouble();
+            }
+        }
+        onChunk(chunk.data(), count);
+    }
+}
+
+}  // namespace mongo::accumulator_batch
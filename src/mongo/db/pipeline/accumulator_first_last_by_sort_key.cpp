@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include "mongo/db/exec/document_value/value.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+AccumulatorFirstLastBySortKey::AccumulatorFirstLastBySortKey(ExpressionContext* const expCtx,
+                                                             const SortPattern& sortPattern,
+                                                             Sense sense)
+    : AccumulatorState(expCtx), _sortKeyComparator(sortPattern), _sense(sense) {
+    _memUsageBytes = sizeof(*this);
+}
+
+const char* AccumulatorFirstLastBySortKey::getOpName() const {
+    // This accumulator only ever stands in for a $first or $last following a $sort.
+    return _sense == Sense::kFirst ? "$first" : "$last";
+}
+
+void AccumulatorFirstLastBySortKey::processInternal(const Value& input, bool merging) {
+    // Both the inputs and the partial states are [sortKey, value] pairs, where a missing value is
+    // represented by leaving it out of the array.
+    if (merging && input.missing()) {
+        return;
+    }
+    invariant(input.isArray() && (input.getArrayLength() == 1 || input.getArrayLength() == 2));
+    const auto& sortKey = input.getArray()[0];
+
+    if (_haveValue) {
+        const int cmp = _sortKeyComparator(sortKey, _sortKey);
+
+        // Ties go to the input seen first for $first and last for $last, as with a stable sort.
+        if (_sense == Sense::kFirst ? cmp >= 0 : cmp < 0) {
+            return;
+        }
+    }
+
+    _haveValue = true;
+    _sortKey = sortKey;
+    _value = input.getArrayLength() == 2 ? input.getArray()[1] : Value();
+    _memUsageBytes = sizeof(*this) + _sortKey.getApproximateSize() + _value.getApproximateSize() -
+        2 * sizeof(Value);
+}
+
+Value AccumulatorFirstLastBySortKey::getValue(bool toBeMerged) {
+    if (toBeMerged) {
+        if (!_haveValue) {
+            return Value();
+        }
+        return _value.missing() ? Value(std::vector<Value>{_sortKey})
+                                : Value(std::vector<Value>{_sortKey, _value});
+    }
+    return _value;
+}
+
+void AccumulatorFirstLastBySortKey::reset() {
+    _haveValue = false;
+    _sortKey = Value();
+    _value = Value();
+    _memUsageBytes = sizeof(*this);
+}
+
+intrusive_ptr<AccumulatorState> AccumulatorFirstLastBySortKey::create(
+    ExpressionContext* const expCtx, const SortPattern& sortPattern, Sense sense) {
+    return new AccumulatorFirstLastBySortKey(expCtx, sortPattern, sense);
+}
+}  // namespace mongo
@@ -32,6 +32,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/pipeline/accumulator_js_reduce.h"
 #include "mongo/db/pipeline/make_js_function.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -111,6 +112,16 @@ void AccumulatorInternalJsReduce::processInternal(const Value& input, bool mergi
 
     _memUsageBytes += vField.getApproximateSize();
     _values.push_back(std::move(vField));
+
+    // The reduce function must be able to re-reduce its own output, so rather than holding on to
+    // every value of a key until the end of the group, fold the values gathered so far into one.
+    const auto threshold = internalQueryJsReduceIncrementalThreshold.load();
+    if (threshold > 0 && _values.size() >= static_cast<size_t>(threshold)) {
+        Value reduced = _reduceValues();
+        _values.clear();
+        _memUsageBytes = sizeof(*this) + reduced.getApproximateSize();
+        _values.push_back(std::move(reduced));
+    }
 }
 
 Value AccumulatorInternalJsReduce::getValue(bool toBeMerged) {
@@ -118,6 +129,20 @@ Value AccumulatorInternalJsReduce::getValue(bool toBeMerged) {
         return Value{};
     }
 
+    Value result = _reduceValues();
+
+    // If we're merging after this, wrap the value in the same format it was inserted in.
+    if (toBeMerged) {
+        MutableDocument output;
+        output.addField("k", _key);
+        output.addField("v", result);
+        return Value(output.freeze());
+    } else {
+        return result;
+    }
+}
+
+Value AccumulatorInternalJsReduce::_reduceValues() {
     const auto keySize = _key.getApproximateSize();
 
     Value result;
@@ -161,15 +186,7 @@ Value AccumulatorInternalJsReduce::getValue(bool toBeMerged) {
         }
     }
 
-    // If we're merging after this, wrap the value in the same format it was inserted in.
-    if (toBeMerged) {
-        MutableDocument output;
-        output.addField("k", _key);
-        output.addField("v", result);
-        return Value(output.freeze());
-    } else {
-        return result;
-    }
+    return result;
 }
 
 boost::intrusive_ptr<AccumulatorState> AccumulatorInternalJsReduce::create(
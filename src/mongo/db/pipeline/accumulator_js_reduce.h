@@ -71,6 +71,12 @@ public:
 private:
     static std::string parseReduceFunction(BSONElement func);
 
+    /**
+     * Calls the reduce function as many times as needed to reduce '_values' to a single value,
+     * which is returned.
+     */
+    Value _reduceValues();
+
     std::string _funcSource;
     std::vector<Value> _values;
     Value _key;
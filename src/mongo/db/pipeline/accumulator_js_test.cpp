@@ -36,9 +36,11 @@
 #include "mongo/db/pipeline/accumulator_js_reduce.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/process_interface/standalone_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -174,6 +176,26 @@ TEST_F(MapReduceFixture, InternalJsReduceIdempotentOnlyWhenJSFunctionIsIdempoten
     ASSERT_EQUALS(expectedResult.getType(), result.getType());
 }
 
+TEST_F(MapReduceFixture, InternalJsReduceReducesIncrementallyOnceThresholdIsReached) {
+    const auto originalThreshold = internalQueryJsReduceIncrementalThreshold.load();
+    ON_BLOCK_EXIT([&] { internalQueryJsReduceIncrementalThreshold.store(originalThreshold); });
+    internalQueryJsReduceIncrementalThreshold.store(3);
+
+    // The non-idempotent function makes each call of the reduce function visible in the result.
+    std::string eval("function(key, values) { return Array.sum(values) + 1; };");
+    auto accum = AccumulatorInternalJsReduce::create(getExpCtx(), eval);
+    auto input = Value(DOC("k" << std::string("foo") << "v" << Value(1)));
+    for (int i = 0; i < 7; ++i) {
+        accum->process(input, false);
+    }
+
+    // The values are reduced after the 3rd, 5th and 7th inputs, then once more by getValue().
+    auto expectedResult = Value(11.0);
+    Value result = accum->getValue(false);
+    ASSERT_VALUE_EQ(expectedResult, result);
+    ASSERT_EQUALS(expectedResult.getType(), result.getType());
+}
+
 TEST_F(MapReduceFixture, InternalJsReduceFailsWhenEvalContainsInvalidJavascript) {
     std::string eval("INVALID_JAVASCRIPT");
     // Multiple source documents.
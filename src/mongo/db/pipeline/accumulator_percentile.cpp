@@ -0,0 +1,182 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <cmath>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_ACCUMULATOR(percentile, AccumulatorPercentile::parse);
+
+AccumulationExpression AccumulatorPercentile::parse(ExpressionContext* const expCtx,
+                                                    BSONElement elem,
+                                                    VariablesParseState vps) {
+    /*
+     * {$percentile: {
+     *   input: <expr>,  // evaluated once per document
+     *   p: [<number>, ...],  // the quantiles to estimate, each in [0, 1]
+     *   method: 'approximate',
+     * }}
+     */
+    uassert(5843109,
+            str::stream() << "$percentile expects an object as an argument; found: "
+                          << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    boost::intrusive_ptr<Expression> input;
+    boost::optional<std::vector<double>> ps;
+    bool haveMethod = false;
+    for (auto&& element : elem.embeddedObject()) {
+        auto name = element.fieldNameStringData();
+        if (name == "input") {
+            input = Expression::parseOperand(expCtx, element, vps);
+        } else if (name == "p") {
+            uassert(5843110,
+                    str::stream() << "$percentile 'p' must be a non-empty array of numbers; found: "
+                                  << element.toString(false),
+                    element.type() == BSONType::Array && !element.embeddedObject().isEmpty());
+            ps.emplace();
+            for (auto&& p : element.embeddedObject()) {
+                uassert(5843111,
+                        str::stream()
+                            << "$percentile 'p' must hold numbers between 0 and 1; found: "
+                            << p.toString(false),
+                        p.isNumber() && p.numberDouble() >= 0 && p.numberDouble() <= 1);
+                ps->push_back(p.numberDouble());
+            }
+        } else if (name == "method") {
+            uassert(5843112,
+                    "$percentile only supports method: 'approximate'",
+                    element.type() == BSONType::String &&
+                        element.valueStringData() == "approximate");
+            haveMethod = true;
+        } else {
+            uasserted(5843113, str::stream() << "$percentile got an unexpected field: " << name);
+        }
+    }
+    uassert(5843114, "$percentile missing required argument 'input'", input);
+    uassert(5843115, "$percentile missing required argument 'p'", ps);
+    uassert(5843116, "$percentile missing required argument 'method'", haveMethod);
+
+    auto initializer = ExpressionConstant::create(expCtx, Value(BSONNULL));
+    return {initializer, input, [expCtx, ps = std::move(*ps)]() { return create(expCtx, ps); }};
+}
+
+void AccumulatorPercentile::_updateMemUsage() {
+    _memUsageBytes = sizeof(*this) + _ps.capacity() * sizeof(double) + _digest.memUsageBytes() -
+        sizeof(TDigest);
+}
+
+AccumulatorPercentile::AccumulatorPercentile(ExpressionContext* const expCtx,
+                                             std::vector<double> ps)
+    : AccumulatorState(expCtx), _ps(std::move(ps)) {
+    _updateMemUsage();
+}
+
+const char* AccumulatorPercentile::getOpName() const {
+    return "$percentile";
+}
+
+void AccumulatorPercentile::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        if (input.numeric()) {
+            const double value = input.coerceToDouble();
+            if (!std::isnan(value)) {
+                _digest.add(value);
+            }
+        }
+    } else {
+        // This is what getValue(true) produced below.
+        uassert(5843117,
+                "$percentile cannot merge a partial state it did not produce",
+                input.getType() == Object && input["min"].numeric() && input["max"].numeric() &&
+                    input["centroids"].isArray());
+        std::vector<TDigest::Centroid> centroids;
+        for (auto&& centroid : input["centroids"].getArray()) {
+            uassert(5843118,
+                    "$percentile cannot merge a partial state it did not produce",
+                    centroid.isArray() && centroid.getArrayLength() == 2 &&
+                        centroid[0].numeric() && centroid[1].numeric() &&
+                        centroid[1].coerceToDouble() > 0);
+            centroids.push_back({centroid[0].coerceToDouble(), centroid[1].coerceToDouble()});
+        }
+        _digest.merge(centroids, input["min"].coerceToDouble(), input["max"].coerceToDouble());
+    }
+    _updateMemUsage();
+}
+
+Value AccumulatorPercentile::getValue(bool toBeMerged) {
+    if (toBeMerged) {
+        std::vector<Value> centroids;
+        for (auto&& centroid : _digest.centroids()) {
+            centroids.push_back(
+                Value(std::vector<Value>{Value(centroid.mean), Value(centroid.weight)}));
+        }
+        return Value(DOC("min" << _digest.min() << "max" << _digest.max() << "centroids"
+                               << std::move(centroids)));
+    }
+
+    if (_digest.empty()) {
+        return Value(BSONNULL);
+    }
+    std::vector<Value> estimates;
+    for (auto p : _ps) {
+        estimates.push_back(Value(_digest.quantile(p)));
+    }
+    return Value(std::move(estimates));
+}
+
+void AccumulatorPercentile::reset() {
+    _digest.reset();
+    _updateMemUsage();
+}
+
+Document AccumulatorPercentile::serialize(boost::intrusive_ptr<Expression> initializer,
+                                          boost::intrusive_ptr<Expression> argument,
+                                          bool explain) const {
+    std::vector<Value> ps(_ps.begin(), _ps.end());
+    return DOC(getOpName() << DOC("input" << argument->serialize(explain) << "p" << std::move(ps)
+                                          << "method"
+                                          << "approximate"_sd));
+}
+
+intrusive_ptr<AccumulatorState> AccumulatorPercentile::create(ExpressionContext* const expCtx,
+                                                              std::vector<double> ps) {
+    return new AccumulatorPercentile(expCtx, std::move(ps));
+}
+}  // namespace mongo
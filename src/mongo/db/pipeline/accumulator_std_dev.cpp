@@ -34,6 +34,7 @@
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/accumulator_batch_helpers.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 
@@ -91,6 +92,32 @@ void AccumulatorStdDev::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorStdDev::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    if (merging) {
+        AccumulatorState::processBatchInternal(inputs, merging);
+        return;
+    }
+
+    accumulator_batch::forEachTypeRun(inputs, [&](BSONType type, auto begin, auto end) {
+        if (!isNumericBSONType(type)) {
+            // Non numeric types have no impact on standard deviation.
+            return;
+        }
+
+        // The same online algorithm as in processInternal(), run over contiguous doubles.
+        accumulator_batch::forEachChunk<double>(begin, end, [&](auto values, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                _count += 1;
+                const double delta = values[i] - _mean;
+                if (delta != 0.0) {
+                    _mean += delta / _count;
+                    _m2 += delta * (values[i] - _mean);
+                }
+            }
+        });
+    });
+}
+
 Value AccumulatorStdDev::getValue(bool toBeMerged) {
     if (!toBeMerged) {
         const long long adjustedCount = (_isSamp ? _count - 1 : _count);
@@ -36,6 +36,7 @@
 
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/accumulator_batch_helpers.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/util/summation.h"
 
@@ -85,6 +86,41 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorSum::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    if (merging) {
+        AccumulatorState::processBatchInternal(inputs, merging);
+        return;
+    }
+
+    accumulator_batch::forEachTypeRun(inputs, [&](BSONType type, auto begin, auto end) {
+        switch (type) {
+            case NumberInt:
+                totalType = Value::getWidestNumeric(totalType, type);
+                accumulator_batch::forEachChunk<int>(begin, end, [&](auto values, size_t count) {
+                    nonDecimalTotal.addInts(values, count);
+                });
+                break;
+            case NumberLong:
+                totalType = Value::getWidestNumeric(totalType, type);
+                accumulator_batch::forEachChunk<long long>(
+                    begin, end, [&](auto values, size_t count) {
+                        nonDecimalTotal.addLongs(values, count);
+                    });
+                break;
+            case NumberDouble:
+                totalType = Value::getWidestNumeric(totalType, type);
+                accumulator_batch::forEachChunk<double>(begin, end, [&](auto values, size_t count) {
+                    nonDecimalTotal.addDoubles(values, count);
+                });
+                break;
+            default:
+                for (; begin != end; ++begin) {
+                    processInternal(*begin, false);
+                }
+        }
+    });
+}
+
 intrusive_ptr<AccumulatorState> AccumulatorSum::create(ExpressionContext* const expCtx) {
     return new AccumulatorSum(expCtx);
 }
@@ -70,6 +70,15 @@ static void assertExpectedResults(
                 ASSERT_EQUALS(op.second.getType(), result.getType());
             }
 
+            // Asserts that result equals expected result when all input is processed as a batch.
+            {
+                auto accum = AccName::create(expCtx);
+                accum->processBatch(op.first, false);
+                Value result = accum->getValue(false);
+                ASSERT_VALUE_EQ(op.second, result);
+                ASSERT_EQUALS(op.second.getType(), result.getType());
+            }
+
             // Asserts that result equals expected result when all input is on one shard.
             {
                 auto accum = AccName::create(expCtx);
@@ -336,6 +345,65 @@ TEST(Accumulators, Sum) {
          {{Value(9), Value()}, Value(9)}});
 }
 
+/**
+ * Asserts that processing 'inputs' as a batch gives the same result as processing them one at a
+ * time, for the given AccumulatorState.
+ */
+template <typename AccName>
+static void assertBatchMatchesSequential(ExpressionContext* const expCtx,
+                                         const std::vector<Value>& inputs) {
+    auto sequential = AccName::create(expCtx);
+    for (auto&& input : inputs) {
+        sequential->process(input, false);
+    }
+    auto batch = AccName::create(expCtx);
+    batch->processBatch(inputs, false);
+
+    ASSERT_VALUE_EQ(sequential->getValue(false), batch->getValue(false));
+    ASSERT_EQUALS(sequential->getValue(false).getType(), batch->getValue(false).getType());
+}
+
+TEST(Accumulators, BatchOfMixedNumericRunsMatchesSequentialProcessing) {
+    auto expCtx = ExpressionContextForTest{};
+
+    // Runs of each numeric type, longer than a chunk of the batch kernels, interleaved with
+    // non-numeric values and values whose sums overflow the narrower types.
+    std::vector<Value> inputs;
+    for (int i = 0; i < 600; ++i) {
+        inputs.push_back(Value(0.1 * i));
+    }
+    inputs.push_back(Value(BSONNULL));
+    for (int i = 0; i < 1000; ++i) {
+        inputs.push_back(Value(numeric_limits<int>::max() - i));
+    }
+    inputs.push_back(Value("string"_sd));
+    for (long long i = 0; i < 700; ++i) {
+        inputs.push_back(Value(numeric_limits<long long>::max() / 3 - i));
+    }
+    inputs.push_back(Value(Decimal128("1.5")));
+    for (int i = 0; i < 300; ++i) {
+        inputs.push_back(Value(-i));
+    }
+    inputs.push_back(Value());
+
+    assertBatchMatchesSequential<AccumulatorSum>(&expCtx, inputs);
+    assertBatchMatchesSequential<AccumulatorAvg>(&expCtx, inputs);
+    assertBatchMatchesSequential<AccumulatorStdDevPop>(&expCtx, inputs);
+    assertBatchMatchesSequential<AccumulatorStdDevSamp>(&expCtx, inputs);
+}
+
+TEST(Accumulators, BatchOfIntsStaysInt) {
+    auto expCtx = ExpressionContextForTest{};
+    std::vector<Value> inputs;
+    for (int i = 0; i < 1000; ++i) {
+        inputs.push_back(Value(i));
+    }
+    auto accum = AccumulatorSum::create(&expCtx);
+    accum->processBatch(inputs, false);
+    ASSERT_VALUE_EQ(Value(499500), accum->getValue(false));
+    ASSERT_EQUALS(NumberInt, accum->getValue(false).getType());
+}
+
 TEST(Accumulators, AddToSetRespectsCollation) {
     auto expCtx = ExpressionContextForTest{};
     auto collator =
@@ -419,4 +487,160 @@ TEST(AccumulatorMergeObjects, MergingWithEmptyDocumentShouldIgnore) {
     assertExpectedResults<AccumulatorMergeObjects>(&expCtx, {{{first, second}, expected}});
 }
 
+/* ------------------------- AccumulatorApproxCountDistinct -------------------------- */
+
+TEST(AccumulatorApproxCountDistinct, SmallNumbersOfDistinctValuesAreCountedExactly) {
+    auto expCtx = ExpressionContextForTest{};
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        &expCtx,
+        {
+            {{}, Value(0LL)},
+            {{Value(1)}, Value(1LL)},
+            // Numbers which compare equal are not distinct, as with $addToSet.
+            {{Value(1), Value(1.0), Value(1LL), Value(2)}, Value(2LL)},
+            {{Value("a"_sd), Value("b"_sd), Value("a"_sd), Value(BSONNULL)}, Value(3LL)},
+            // Missing values are ignored.
+            {{Value(), Value(3)}, Value(1LL)},
+        });
+}
+
+TEST(AccumulatorApproxCountDistinct, RespectsCollation) {
+    auto expCtx = ExpressionContextForTest{};
+    expCtx.setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kAlwaysEqual));
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        &expCtx, {{{Value("a"_sd), Value("b"_sd), Value("c"_sd)}, Value(1LL)}});
+}
+
+TEST(AccumulatorApproxCountDistinct, EstimatesLargeNumbersOfDistinctValues) {
+    auto expCtx = ExpressionContextForTest{};
+    auto left = AccumulatorApproxCountDistinct::create(&expCtx);
+    auto right = AccumulatorApproxCountDistinct::create(&expCtx);
+    for (int i = 0; i < 100'000; ++i) {
+        (i < 60'000 ? left : right)->process(Value(i), false);
+        (i >= 40'000 ? left : right)->process(Value(i), false);
+    }
+    const int memUsage = left->memUsageForSorter();
+
+    auto merged = AccumulatorApproxCountDistinct::create(&expCtx);
+    merged->process(left->getValue(true), true);
+    merged->process(right->getValue(true), true);
+    ASSERT_APPROX_EQUAL(100'000, merged->getValue(false).getLong(), 5'000);
+
+    // The memory used does not grow with the number of distinct values.
+    ASSERT_EQ(memUsage, merged->memUsageForSorter());
+}
+
+TEST(AccumulatorApproxCountDistinct, RejectsPartialStatesItDidNotProduce) {
+    auto expCtx = ExpressionContextForTest{};
+    auto accum = AccumulatorApproxCountDistinct::create(&expCtx);
+    ASSERT_THROWS_CODE(accum->process(Value(1), true), AssertionException, 5843108);
+}
+
+/* ------------------------- AccumulatorPercentile -------------------------- */
+
+AccumulationExpression parsePercentile(ExpressionContext* const expCtx, BSONObj spec) {
+    return AccumulatorPercentile::parse(expCtx, spec.firstElement(), expCtx->variablesParseState);
+}
+
+TEST(AccumulatorPercentile, EstimatesRequestedQuantiles) {
+    auto expCtx = ExpressionContextForTest{};
+    auto accum = AccumulatorPercentile::create(&expCtx, {0, 0.5, 1});
+    for (int i = 1; i <= 5; ++i) {
+        accum->process(Value(i), false);
+    }
+    // Non-numeric values are ignored.
+    accum->process(Value("string"_sd), false);
+    accum->process(Value(BSONNULL), false);
+    ASSERT_VALUE_EQ(Value(std::vector<Value>{Value(1.0), Value(3.0), Value(5.0)}),
+                    accum->getValue(false));
+}
+
+TEST(AccumulatorPercentile, ReturnsNullWithoutNumericInput) {
+    auto expCtx = ExpressionContextForTest{};
+    auto accum = AccumulatorPercentile::create(&expCtx, {0.5});
+    accum->process(Value("string"_sd), false);
+    ASSERT_VALUE_EQ(Value(BSONNULL), accum->getValue(false));
+}
+
+TEST(AccumulatorPercentile, MergesPartialStates) {
+    auto expCtx = ExpressionContextForTest{};
+    auto merged = AccumulatorPercentile::create(&expCtx, {0, 0.5, 0.99, 1});
+    for (int shard = 0; shard < 4; ++shard) {
+        auto accum = AccumulatorPercentile::create(&expCtx, {0, 0.5, 0.99, 1});
+        for (int i = shard; i < 100'000; i += 4) {
+            accum->process(Value(i), false);
+        }
+        merged->process(accum->getValue(true), true);
+    }
+    // An empty partial state changes nothing.
+    merged->process(AccumulatorPercentile::create(&expCtx, {0.5})->getValue(true), true);
+
+    auto result = merged->getValue(false).getArray();
+    ASSERT_EQ(4U, result.size());
+    ASSERT_EQ(0, result[0].getDouble());
+    ASSERT_APPROX_EQUAL(50'000, result[1].getDouble(), 500);
+    ASSERT_APPROX_EQUAL(99'000, result[2].getDouble(), 500);
+    ASSERT_EQ(99'999, result[3].getDouble());
+}
+
+TEST(AccumulatorPercentile, ParsesAndSerializes) {
+    auto expCtx = ExpressionContextForTest{};
+    auto spec = BSON("$percentile" << BSON("input"
+                                           << "$a"
+                                           << "p" << BSON_ARRAY(0.5 << 1) << "method"
+                                           << "approximate"));
+    auto expr = parsePercentile(&expCtx, spec);
+    auto accum = expr.makeAccumulator();
+    ASSERT_VALUE_EQ(Value(spec),
+                    Value(accum->serialize(expr.initializer, expr.argument, false)));
+}
+
+TEST(AccumulatorPercentile, RejectsInvalidSpecifications) {
+    auto expCtx = ExpressionContextForTest{};
+    ASSERT_THROWS_CODE(
+        parsePercentile(&expCtx, BSON("$percentile"
+                                      << "$a")),
+        AssertionException,
+        5843109);
+    ASSERT_THROWS_CODE(parsePercentile(&expCtx,
+                                       BSON("$percentile" << BSON("input"
+                                                                  << "$a"
+                                                                  << "p" << 0.5 << "method"
+                                                                  << "approximate"))),
+                       AssertionException,
+                       5843110);
+    ASSERT_THROWS_CODE(parsePercentile(&expCtx,
+                                       BSON("$percentile" << BSON("input"
+                                                                  << "$a"
+                                                                  << "p" << BSON_ARRAY(1.5)
+                                                                  << "method"
+                                                                  << "approximate"))),
+                       AssertionException,
+                       5843111);
+    ASSERT_THROWS_CODE(parsePercentile(&expCtx,
+                                       BSON("$percentile" << BSON("input"
+                                                                  << "$a"
+                                                                  << "p" << BSON_ARRAY(0.5)
+                                                                  << "method"
+                                                                  << "exact"))),
+                       AssertionException,
+                       5843112);
+    ASSERT_THROWS_CODE(parsePercentile(&expCtx,
+                                       BSON("$percentile" << BSON("input"
+                                                                  << "$a"
+                                                                  << "p" << BSON_ARRAY(0.5)
+                                                                  << "method"
+                                                                  << "approximate"
+                                                                  << "q" << 1))),
+                       AssertionException,
+                       5843113);
+    ASSERT_THROWS_CODE(
+        parsePercentile(&expCtx,
+                        BSON("$percentile" << BSON("p" << BSON_ARRAY(0.5) << "method"
+                                                       << "approximate"))),
+        AssertionException,
+        5843114);
+}
+
 }  // namespace AccumulatorTests
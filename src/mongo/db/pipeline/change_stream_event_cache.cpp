@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/change_stream_event_cache.h"
+
+#include <algorithm>
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+namespace {
+Counter64 changeStreamEventCacheHits;
+Counter64 changeStreamEventCacheMisses;
+
+ServerStatusMetricField<Counter64> changeStreamEventCacheHitsMetric(
+    "changeStreams.sharedEventCache.hits", &changeStreamEventCacheHits);
+ServerStatusMetricField<Counter64> changeStreamEventCacheMissesMetric(
+    "changeStreams.sharedEventCache.misses", &changeStreamEventCacheMisses);
+
+// The fraction of the size limit of the cache above which a single event is not cached.
+constexpr long long kMaxEventFraction = 16;
+}  // namespace
+
+ChangeStreamEventCache& ChangeStreamEventCache::get() {
+    static ChangeStreamEventCache cache;
+    return cache;
+}
+
+bool ChangeStreamEventCache::enabled() {
+    return internalChangeStreamSharedEventCacheMaxBytes.load() > 0;
+}
+
+std::shared_ptr<const ChangeStreamEventCache::Event> ChangeStreamEventCache::find(
+    const Key& key) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _events.find(key);
+    if (it == _events.end()) {
+        changeStreamEventCacheMisses.increment();
+        return nullptr;
+    }
+
+    changeStreamEventCacheHits.increment();
+    return it->second;
+}
+
+void ChangeStreamEventCache::add(Key key,
+                                 const Document& event,
+                                 std::vector<std::string> fieldNames) {
+    const auto maxBytes = internalChangeStreamSharedEventCacheMaxBytes.load();
+    const auto maxEventBytes =
+        std::min(maxBytes / kMaxEventFraction, static_cast<long long>(BSONObjMaxUserSize / 2));
+    if (static_cast<long long>(event.getApproximateSize()) > maxEventBytes) {
+        return;
+    }
+
+    auto entry = std::make_shared<const Event>(Event{event.toBson(), std::move(fieldNames)});
+    const auto bytes = _cachedBytes(key, *entry);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto [it, inserted] = _events.emplace(std::move(key), std::move(entry));
+    if (!inserted) {
+        // Another stream cached the same event in the meantime.
+        return;
+    }
+    _bytes += bytes;
+
+    while (!_events.empty() && _bytes > static_cast<size_t>(std::max(0LL, maxBytes))) {
+        auto oldest = _events.begin();
+        _bytes -= _cachedBytes(oldest->first, *oldest->second);
+        _events.erase(oldest);
+    }
+}
+
+void ChangeStreamEventCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _events.clear();
+    _bytes = 0;
+}
+
+size_t ChangeStreamEventCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _events.size();
+}
+
+size_t ChangeStreamEventCache::_cachedBytes(const Key& key, const Event& event) {
+    size_t bytes = sizeof(Key) + sizeof(Event) + key.variant.size() + event.event.objsize();
+    for (auto&& fieldName : event.fieldNames) {
+        bytes += sizeof(std::string) + fieldName.size();
+    }
+    return bytes;
+}
+}  // namespace mongo
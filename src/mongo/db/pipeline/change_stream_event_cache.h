@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+/**
+ * A process-wide cache of the change events built from recent oplog entries. Each change stream
+ * reads the oplog through its own cursor, and transforms every entry it reads into a change event,
+ * so that many streams over the same namespaces repeat the same transformation for every entry.
+ * The first stream to transform an entry caches the resulting event, and the other streams build
+ * their copy of the event from the cache instead.
+ *
+ * Apart from the oplog entry it was built from, an event depends on the document key fields of
+ * its collection as seen by the stream and on some options of the stream; these form part of the
+ * key of the event. Events are stored as owned BSON so that they can be shared across operations,
+ * along with the names of their fields in order, including those whose value is missing, so that
+ * the stages which fill in these fields later find them in place.
+ *
+ * Events are evicted in oplog order, oldest first, once the size of the cache exceeds the
+ * 'internalChangeStreamSharedEventCacheMaxBytes' knob; a value of zero disables the cache.
+ */
+class ChangeStreamEventCache {
+    ChangeStreamEventCache(const ChangeStreamEventCache&) = delete;
+    ChangeStreamEventCache& operator=(const ChangeStreamEventCache&) = delete;
+
+public:
+    struct Key {
+        bool operator<(const Key& other) const {
+            return std::tie(clusterTime, term, txnOpIndex, variant) <
+                std::tie(other.clusterTime, other.term, other.txnOpIndex, other.variant);
+        }
+
+        // The position of the event in the oplog: the timestamp and term of the oplog entry, or of
+        // the commit of the transaction the event belongs to, and the index of the event within
+        // that transaction.
+        Timestamp clusterTime;
+        long long term;
+        size_t txnOpIndex;
+
+        // Encodes the document key fields and the options of the stream the event was built by.
+        std::string variant;
+    };
+
+    struct Event {
+        BSONObj event;
+        std::vector<std::string> fieldNames;
+    };
+
+    /**
+     * Returns the cache shared by all the operations of the process.
+     */
+    static ChangeStreamEventCache& get();
+
+    /**
+     * Returns whether the cache is enabled.
+     */
+    static bool enabled();
+
+    ChangeStreamEventCache() = default;
+
+    /**
+     * Returns the event cached under 'key', if any.
+     */
+    std::shared_ptr<const Event> find(const Key& key) const;
+
+    /**
+     * Caches 'event', whose fields are named 'fieldNames', under 'key', then evicts the oldest
+     * events until the cache fits within its size limit. Events which are large relative to the
+     * limit are not cached.
+     */
+    void add(Key key, const Document& event, std::vector<std::string> fieldNames);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    // Returns the amount of memory accounted for 'event' cached under 'key'.
+    static size_t _cachedBytes(const Key& key, const Event& event);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ChangeStreamEventCache::_mutex");
+    std::map<Key, std::shared_ptr<const Event>> _events;
+    size_t _bytes = 0;
+};
+}  // namespace mongo
@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/change_stream_post_image_cache.h"
+
+#include <algorithm>
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+namespace {
+Counter64 changeStreamPostImageCacheHits;
+Counter64 changeStreamPostImageCacheMisses;
+
+ServerStatusMetricField<Counter64> changeStreamPostImageCacheHitsMetric(
+    "changeStreams.postImageCache.hits", &changeStreamPostImageCacheHits);
+ServerStatusMetricField<Counter64> changeStreamPostImageCacheMissesMetric(
+    "changeStreams.postImageCache.misses", &changeStreamPostImageCacheMisses);
+
+// The fraction of the size limit of the cache above which a single post-image is not cached.
+constexpr long long kMaxPostImageFraction = 16;
+}  // namespace
+
+ChangeStreamPostImageCache& ChangeStreamPostImageCache::get() {
+    static ChangeStreamPostImageCache cache;
+    return cache;
+}
+
+bool ChangeStreamPostImageCache::enabled() {
+    return internalChangeStreamPostImageCacheMaxBytes.load() > 0;
+}
+
+boost::optional<Value> ChangeStreamPostImageCache::find(const Key& key, Date_t now) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _index.find(key);
+    if (it == _index.end() || _isExpired(*it->second, now)) {
+        changeStreamPostImageCacheMisses.increment();
+        return boost::none;
+    }
+
+    changeStreamPostImageCacheHits.increment();
+    const auto& postImage = it->second->postImage;
+    return postImage ? Value(Document(*postImage)) : Value(BSONNULL);
+}
+
+void ChangeStreamPostImageCache::add(Key key,
+                                     const boost::optional<Document>& postImage,
+                                     Date_t now) {
+    const auto maxBytes = internalChangeStreamPostImageCacheMaxBytes.load();
+    const auto maxPostImageBytes = std::min(maxBytes / kMaxPostImageFraction,
+                                            static_cast<long long>(BSONObjMaxUserSize / 2));
+    if (postImage && static_cast<long long>(postImage->getApproximateSize()) > maxPostImageBytes) {
+        return;
+    }
+
+    Entry entry{std::move(key),
+                postImage ? boost::make_optional(postImage->toBson()) : boost::none,
+                now};
+    entry.key.documentKey = entry.key.documentKey.getOwned();
+    const auto bytes = _cachedBytes(entry);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (auto it = _index.find(entry.key); it != _index.end()) {
+        if (!_isExpired(*it->second, now)) {
+            // Another stream cached the same post-image in the meantime.
+            return;
+        }
+        _bytes -= _cachedBytes(*it->second);
+        _entries.erase(it->second);
+        _index.erase(it);
+    }
+
+    _entries.push_back(std::move(entry));
+    _index.emplace(_entries.back().key, std::prev(_entries.end()));
+    _bytes += bytes;
+
+    // Entries are added in the order they are looked up, so the expired ones are at the front.
+    while (!_entries.empty() &&
+           (_isExpired(_entries.front(), now) ||
+            _bytes > static_cast<size_t>(std::max(0LL, maxBytes)))) {
+        _evictOldest(lk);
+    }
+}
+
+void ChangeStreamPostImageCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _index.clear();
+    _entries.clear();
+    _bytes = 0;
+}
+
+size_t ChangeStreamPostImageCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+size_t ChangeStreamPostImageCache::_cachedBytes(const Entry& entry) {
+    return sizeof(Entry) + sizeof(Key) + entry.key.nss.size() + entry.key.documentKey.objsize() +
+        (entry.postImage ? entry.postImage->objsize() : 0);
+}
+
+bool ChangeStreamPostImageCache::_isExpired(const Entry& entry, Date_t now) {
+    return now - entry.lookedUpAt >=
+        Milliseconds(internalChangeStreamPostImageCacheExpiryMillis.load());
+}
+
+void ChangeStreamPostImageCache::_evictOldest(WithLock) {
+    auto& oldest = _entries.front();
+    _bytes -= _cachedBytes(oldest);
+    _index.erase(oldest.key);
+    _entries.pop_front();
+}
+}  // namespace mongo
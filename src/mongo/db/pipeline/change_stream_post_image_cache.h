@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <tuple>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+/**
+ * A process-wide cache of the post-images looked up by change streams opened with
+ * 'fullDocument: "updateLookup"'. Every stream looks up the current version of the document for
+ * each update event it returns, so that many streams over the same collection repeat the same
+ * point lookup for every update. The first stream to look up the post-image of an update caches
+ * it, and the other streams use the cached version instead.
+ *
+ * Post-images are keyed by the namespace, collection UUID and document key of the update, and by
+ * its cluster time, so a cached post-image always reflects a version of the document at least as
+ * recent as the update it was looked up for. Since a lookup returns whichever version is current
+ * when it runs, a cached post-image may be older than the one a new lookup would return; entries
+ * therefore expire after 'internalChangeStreamPostImageCacheExpiryMillis', and the oldest entries
+ * are evicted once the size of the cache exceeds 'internalChangeStreamPostImageCacheMaxBytes'. A
+ * size of zero disables the cache.
+ */
+class ChangeStreamPostImageCache {
+    ChangeStreamPostImageCache(const ChangeStreamPostImageCache&) = delete;
+    ChangeStreamPostImageCache& operator=(const ChangeStreamPostImageCache&) = delete;
+
+public:
+    struct Key {
+        bool operator<(const Key& other) const {
+            if (clusterTime != other.clusterTime) {
+                return clusterTime < other.clusterTime;
+            }
+            if (auto cmp = SimpleBSONObjComparator::kInstance.compare(documentKey,
+                                                                      other.documentKey)) {
+                return cmp < 0;
+            }
+            return std::tie(uuid, nss) < std::tie(other.uuid, other.nss);
+        }
+
+        NamespaceString nss;
+        UUID uuid;
+        BSONObj documentKey;
+        Timestamp clusterTime;
+    };
+
+    /**
+     * Returns the cache shared by all the operations of the process.
+     */
+    static ChangeStreamPostImageCache& get();
+
+    /**
+     * Returns whether the cache is enabled.
+     */
+    static bool enabled();
+
+    ChangeStreamPostImageCache() = default;
+
+    /**
+     * Returns the post-image cached under 'key', as either a document or null if the lookup found
+     * no document, provided it has not expired by 'now'.
+     */
+    boost::optional<Value> find(const Key& key, Date_t now) const;
+
+    /**
+     * Caches the post-image 'postImage', or the absence of one, looked up at 'now' under 'key',
+     * then evicts the expired and oldest entries until the cache fits within its size limit.
+     * Post-images which are large relative to the limit are not cached.
+     */
+    void add(Key key, const boost::optional<Document>& postImage, Date_t now);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        Key key;
+        boost::optional<BSONObj> postImage;
+        Date_t lookedUpAt;
+    };
+
+    // Returns the amount of memory accounted for 'entry'.
+    static size_t _cachedBytes(const Entry& entry);
+
+    // Returns whether 'entry' has expired by 'now'.
+    static bool _isExpired(const Entry& entry, Date_t now);
+
+    // Removes the oldest entry of the cache.
+    void _evictOldest(WithLock);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ChangeStreamPostImageCache::_mutex");
+
+    // The entries in the order they were added, oldest first, and an index of them by key.
+    std::list<Entry> _entries;
+    std::map<Key, std::list<Entry>::iterator> _index;
+    size_t _bytes = 0;
+};
+}  // namespace mongo
@@ -0,0 +1,196 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/change_stream_rewrite_helpers.h"
+
+#include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_tree.h"
+#include "mongo/db/pipeline/document_source_change_stream.h"
+#include "mongo/db/repl/oplog_entry.h"
+
+namespace mongo {
+namespace change_stream_rewrite {
+namespace {
+using DSChangeStream = DocumentSourceChangeStream;
+
+/**
+ * Matches the oplog entries of all operations other than inserts, updates and deletes.
+ */
+BSONObj nonCrudEntryFilter() {
+    return BSON("op" << BSON("$nin" << BSON_ARRAY("i"
+                                                  << "u"
+                                                  << "d")));
+}
+
+/**
+ * Matches the oplog entries of updates which modify a document rather than replace it. Unlike the
+ * object of a replacement, which is the new version of the document, the object of such an entry
+ * does not contain the '_id' of the document.
+ */
+BSONObj updateEntryFilter() {
+    return BSON("op"
+                << "u"
+                << "o._id" << BSON("$exists" << false));
+}
+
+BSONObj replaceEntryFilter() {
+    return BSON("op"
+                << "u"
+                << "o._id" << BSON("$exists" << true));
+}
+
+/**
+ * Returns a filter matching the oplog entries of the CRUD operations whose change events satisfy
+ * 'expr', a predicate on the 'operationType' field of the events, or boost::none if 'expr' cannot
+ * be rewritten.
+ */
+boost::optional<BSONObj> rewriteOperationTypePredicate(const MatchExpression& expr) {
+    std::vector<BSONElement> operationTypes;
+    if (expr.matchType() == MatchExpression::EQ) {
+        operationTypes.push_back(checked_cast<const EqualityMatchExpression&>(expr).getData());
+    } else if (expr.matchType() == MatchExpression::MATCH_IN) {
+        const auto& inExpr = checked_cast<const InMatchExpression&>(expr);
+        if (!inExpr.getRegexes().empty()) {
+            return boost::none;
+        }
+        operationTypes = inExpr.getEqualities();
+    } else {
+        return boost::none;
+    }
+
+    BSONArrayBuilder entryFilters;
+    for (auto&& operationType : operationTypes) {
+        // The operation type of an event is always a string, so that values of other types never
+        // match it.
+        if (operationType.type() != BSONType::String) {
+            continue;
+        }
+
+        const auto name = operationType.valueStringData();
+        if (name == DSChangeStream::kInsertOpType) {
+            entryFilters.append(BSON("op"
+                                     << "i"));
+        } else if (name == DSChangeStream::kDeleteOpType) {
+            entryFilters.append(BSON("op"
+                                     << "d"));
+        } else if (name == DSChangeStream::kUpdateOpType) {
+            entryFilters.append(updateEntryFilter());
+        } else if (name == DSChangeStream::kReplaceOpType) {
+            entryFilters.append(replaceEntryFilter());
+        }
+    }
+
+    auto filters = entryFilters.arr();
+    return filters.isEmpty() ? BSON("op" << BSON("$in" << BSONArray())) : BSON("$or" << filters);
+}
+
+/**
+ * Returns whether 'expr' only depends on the 'fullDocument' field of the events, and consists of
+ * predicates which can be evaluated against the object of an oplog entry instead.
+ */
+bool isOnlyDependentOnFullDocument(const MatchExpression& expr) {
+    switch (expr.getCategory()) {
+        case MatchExpression::MatchCategory::kLogical: {
+            if (expr.numChildren() == 0) {
+                return false;
+            }
+            for (size_t i = 0; i < expr.numChildren(); ++i) {
+                if (!isOnlyDependentOnFullDocument(*expr.getChild(i))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case MatchExpression::MatchCategory::kLeaf: {
+            return expr.path() == DSChangeStream::kFullDocumentField ||
+                expression::isPathPrefixOf(DSChangeStream::kFullDocumentField, expr.path());
+        }
+        case MatchExpression::MatchCategory::kArrayMatching:
+        case MatchExpression::MatchCategory::kOther: {
+            return false;
+        }
+    }
+
+    MONGO_UNREACHABLE;
+}
+}  // namespace
+
+BSONObj rewriteFilterForOplog(const MatchExpression& userMatch) {
+    std::vector<const MatchExpression*> conjuncts;
+    if (userMatch.matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < userMatch.numChildren(); ++i) {
+            conjuncts.push_back(userMatch.getChild(i));
+        }
+    } else {
+        conjuncts.push_back(&userMatch);
+    }
+
+    BSONArrayBuilder crudEntryFilters;
+    auto fullDocumentPredicates = std::make_unique<AndMatchExpression>();
+    for (auto&& conjunct : conjuncts) {
+        if (conjunct->getCategory() == MatchExpression::MatchCategory::kLeaf &&
+            conjunct->path() == DSChangeStream::kOperationTypeField) {
+            if (auto filter = rewriteOperationTypePredicate(*conjunct)) {
+                crudEntryFilters.append(*filter);
+            }
+        } else if (isOnlyDependentOnFullDocument(*conjunct)) {
+            fullDocumentPredicates->add(conjunct->shallowClone());
+        }
+    }
+
+    if (fullDocumentPredicates->numChildren() > 0) {
+        // The event of an insert or a replacement reports the object of its oplog entry as its
+        // 'fullDocument', so the predicates on 'fullDocument' apply to that object once renamed.
+        // The events of other updates and of deletes either have no 'fullDocument', or one which
+        // is looked up after the event is built, so their entries are not filtered.
+        auto objectPredicates =
+            expression::splitMatchExpressionBy(std::move(fullDocumentPredicates),
+                                               {},
+                                               {{DSChangeStream::kFullDocumentField.toString(),
+                                                 repl::OplogEntry::kObjectFieldName.toString()}})
+                .first;
+        invariant(objectPredicates);
+        crudEntryFilters.append(BSON("$or" << BSON_ARRAY(BSON("op"
+                                                              << "d")
+                                                         << updateEntryFilter()
+                                                         << objectPredicates->serialize())));
+    }
+
+    auto filters = crudEntryFilters.arr();
+    if (filters.isEmpty()) {
+        return BSONObj();
+    }
+    return BSON("$or" << BSON_ARRAY(nonCrudEntryFilter() << BSON("$and" << filters)));
+}
+
+}  // namespace change_stream_rewrite
+}  // namespace mongo
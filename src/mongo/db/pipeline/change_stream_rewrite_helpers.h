@@ -0,0 +1,52 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+namespace change_stream_rewrite {
+/**
+ * Rewrites the predicates of 'userMatch', a filter over the change events of a change stream, into
+ * a filter over the oplog entries the change stream reads. The rewritten filter matches every
+ * oplog entry whose change event may match 'userMatch', which is still applied to the change
+ * events, but lets the oplog scan discard the entries whose events certainly do not match before
+ * they are transformed.
+ *
+ * Only the predicates on the 'operationType' and 'fullDocument' fields of the events of CRUD
+ * operations are rewritten, and only when they are conjuncts of 'userMatch'. The entries of all
+ * other operations, including those of commands and transactions, always match the rewritten
+ * filter. Returns an empty object if no predicate of 'userMatch' can be rewritten.
+ */
+BSONObj rewriteFilterForOplog(const MatchExpression& userMatch);
+
+}  // namespace change_stream_rewrite
+}  // namespace mongo
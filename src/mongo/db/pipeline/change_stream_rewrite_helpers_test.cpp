@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/change_stream_rewrite_helpers.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const BSONObj kInsertEntry = fromjson("{op: 'i', ns: 'test.coll', o: {_id: 1, tenantId: 5}}");
+const BSONObj kUpdateEntry =
+    fromjson("{op: 'u', ns: 'test.coll', o: {$v: 2, diff: {u: {tenantId: 6}}}, o2: {_id: 1}}");
+const BSONObj kReplaceEntry =
+    fromjson("{op: 'u', ns: 'test.coll', o: {_id: 1, tenantId: 6}, o2: {_id: 1}}");
+const BSONObj kDeleteEntry = fromjson("{op: 'd', ns: 'test.coll', o: {_id: 1}}");
+const BSONObj kDropEntry = fromjson("{op: 'c', ns: 'test.$cmd', o: {drop: 'coll'}}");
+const BSONObj kApplyOpsEntry = fromjson(
+    "{op: 'c', ns: 'admin.$cmd', o: {applyOps: [{op: 'i', ns: 'test.coll', o: {_id: 2}}]}}");
+const BSONObj kNewShardEntry =
+    fromjson("{op: 'n', ns: 'test.coll', o2: {type: 'migrateChunkToNewShard'}}");
+
+class ChangeStreamRewriteTest : public unittest::Test {
+protected:
+    /**
+     * Returns the oplog filter rewritten from 'userFilter'.
+     */
+    BSONObj rewrite(const BSONObj& userFilter) {
+        auto userMatch = uassertStatusOK(MatchExpressionParser::parse(userFilter, _expCtx));
+        return change_stream_rewrite::rewriteFilterForOplog(*userMatch);
+    }
+
+    /**
+     * Returns whether the oplog filter rewritten from 'userFilter' matches 'entry'.
+     */
+    bool matches(const BSONObj& userFilter, const BSONObj& entry) {
+        auto filter = rewrite(userFilter);
+        ASSERT_FALSE(filter.isEmpty());
+        auto oplogMatch = uassertStatusOK(MatchExpressionParser::parse(filter, _expCtx));
+        return oplogMatch->matchesBSON(entry);
+    }
+
+private:
+    boost::intrusive_ptr<ExpressionContextForTest> _expCtx =
+        make_intrusive<ExpressionContextForTest>();
+};
+
+TEST_F(ChangeStreamRewriteTest, ShouldRewriteOperationTypeEquality) {
+    const auto userFilter = fromjson("{operationType: 'insert'}");
+    ASSERT_TRUE(matches(userFilter, kInsertEntry));
+    ASSERT_FALSE(matches(userFilter, kUpdateEntry));
+    ASSERT_FALSE(matches(userFilter, kReplaceEntry));
+    ASSERT_FALSE(matches(userFilter, kDeleteEntry));
+}
+
+TEST_F(ChangeStreamRewriteTest, ShouldRewriteOperationTypeIn) {
+    const auto userFilter = fromjson("{operationType: {$in: ['update', 'replace', 1]}}");
+    ASSERT_FALSE(matches(userFilter, kInsertEntry));
+    ASSERT_TRUE(matches(userFilter, kUpdateEntry));
+    ASSERT_TRUE(matches(userFilter, kReplaceEntry));
+    ASSERT_FALSE(matches(userFilter, kDeleteEntry));
+}
+
+TEST_F(ChangeStreamRewriteTest, ShouldTellUpdatesFromReplacements) {
+    ASSERT_TRUE(matches(fromjson("{operationType: 'update'}"), kUpdateEntry));
+    ASSERT_FALSE(matches(fromjson("{operationType: 'update'}"), kReplaceEntry));
+    ASSERT_FALSE(matches(fromjson("{operationType: 'replace'}"), kUpdateEntry));
+    ASSERT_TRUE(matches(fromjson("{operationType: 'replace'}"), kReplaceEntry));
+}
+
+TEST_F(ChangeStreamRewriteTest, ShouldRejectAllCrudEntriesForNonCrudOperationType) {
+    const auto userFilter = fromjson("{operationType: 'drop'}");
+    ASSERT_FALSE(matches(userFilter, kInsertEntry));
+    ASSERT_FALSE(matches(userFilter, kUpdateEntry));
+    ASSERT_FALSE(matches(userFilter, kReplaceEntry));
+    ASSERT_FALSE(matches(userFilter, kDeleteEntry));
+    ASSERT_TRUE(matches(userFilter, kDropEntry));
+}
+
+TEST_F(ChangeStreamRewriteTest, ShouldAlwaysMatchEntriesOfOtherOperations) {
+    for (auto&& userFilter : {fromjson("{operationType: 'insert'}"),
+                              fromjson("{operationType: {$in: []}}"),
+                              fromjson("{'fullDocument.tenantId': 7}")}) {
+        ASSERT_TRUE(matches(userFilter, kDropEntry));
+        ASSERT_TRUE(matches(userFilter, kApplyOpsEntry));
+        ASSERT_TRUE(matches(userFilter, kNewShardEntry));
+    }
+}
+
+TEST_F(ChangeStreamRewriteTest, ShouldRewriteFullDocumentPredicatesOverObjectOfEntry) {
+    const auto userFilter = fromjson("{'fullDocument.tenantId': 5}");
+    ASSERT_TRUE(matches(userFilter, kInsertEntry));
+    ASSERT_FALSE(matches(fromjson("{'fullDocument.tenantId': 6}"), kInsertEntry));
+    ASSERT_FALSE(matches(userFilter, kReplaceEntry));
+    ASSERT_TRUE(matches(fromjson("{'fullDocument.tenantId': {$gt: 5}}"), kReplaceEntry));
+
+    // The update and delete events have no 'fullDocument' unless it is looked up, so their entries
+    // are never filtered.
+    ASSERT_TRUE(matches(userFilter, kUpdateEntry));
+    ASSERT_TRUE(matches(userFilter, kDeleteEntry));
+}
+
+TEST_F(ChangeStreamRewriteTest, ShouldRewriteLogicalPredicatesOnlyOverFullDocument) {
+    const auto userFilter = fromjson(
+        "{$or: [{'fullDocument.tenantId': 6}, {fullDocument: {$exists: false}}], "
+        "'fullDocument._id': {$ne: 2}}");
+    ASSERT_FALSE(matches(userFilter, kInsertEntry));
+    ASSERT_TRUE(matches(userFilter, kReplaceEntry));
+}
+
+TEST_F(ChangeStreamRewriteTest, ShouldCombineRewrittenConjuncts) {
+    const auto userFilter = fromjson(
+        "{operationType: {$in: ['insert', 'delete']}, 'fullDocument.tenantId': 5, "
+        "'documentKey._id': 1}");
+    ASSERT_TRUE(matches(userFilter, kInsertEntry));
+    ASSERT_FALSE(matches(fromjson("{operationType: 'insert', 'fullDocument.tenantId': 6}"),
+                         kInsertEntry));
+    ASSERT_FALSE(matches(userFilter, kUpdateEntry));
+    ASSERT_FALSE(matches(userFilter, kReplaceEntry));
+    ASSERT_TRUE(matches(userFilter, kDeleteEntry));
+}
+
+TEST_F(ChangeStreamRewriteTest, ShouldNotRewriteUnsupportedPredicates) {
+    ASSERT_BSONOBJ_EQ(rewrite(fromjson("{'documentKey._id': 1}")), BSONObj());
+    ASSERT_BSONOBJ_EQ(rewrite(fromjson("{operationType: {$regex: '^ins'}}")), BSONObj());
+    ASSERT_BSONOBJ_EQ(rewrite(fromjson("{operationType: {$ne: 'insert'}}")), BSONObj());
+    ASSERT_BSONOBJ_EQ(rewrite(fromjson("{'fullDocument.a': {$elemMatch: {b: 1}}}")), BSONObj());
+    ASSERT_BSONOBJ_EQ(
+        rewrite(fromjson("{$or: [{operationType: 'insert'}, {'fullDocument.tenantId': 5}]}")),
+        BSONObj());
+    ASSERT_BSONOBJ_EQ(rewrite(fromjson("{$expr: {$eq: ['$fullDocument.tenantId', 5]}}")),
+                      BSONObj());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -90,7 +90,7 @@ const char* DocumentSourceBucketAuto::getSourceName() const {
 
 DocumentSource::GetNextResult DocumentSourceBucketAuto::doGetNext() {
     if (!_populated) {
-        const auto populationResult = populateSorter();
+        const auto populationResult = _approximate ? populateRanges() : populateSorter();
         if (populationResult.isPaused()) {
             return populationResult;
         }
@@ -101,7 +101,7 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::doGetNext() {
     }
 
     if (_currentBucketDetails.currentBucketNum++ < _nBuckets) {
-        if (auto bucket = populateNextBucket()) {
+        if (auto bucket = _approximate ? populateNextBucketFromRanges() : populateNextBucket()) {
             return makeDocument(*bucket);
         }
     }
@@ -162,6 +162,109 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
     return next;
 }
 
+DocumentSource::GetNextResult DocumentSourceBucketAuto::populateRanges() {
+    const auto& valueCmp = pExpCtx->getValueComparator();
+    const size_t maxRanges = kRangesPerBucket * _nBuckets;
+
+    auto next = pSource->getNext();
+    for (; next.isAdvanced(); next = pSource->getNext()) {
+        auto nextDoc = next.releaseDocument();
+        auto key = extractKey(nextDoc);
+
+        // Find the range holding 'key', or start a new one if it falls between two ranges.
+        auto range = _ranges.upper_bound(key);
+        if (range != _ranges.begin() && valueCmp.evaluate(key <= std::prev(range)->second.max)) {
+            --range;
+        } else {
+            ValueRange newRange{key};
+            for (auto&& accumulatedField : _accumulatedFields) {
+                newRange.accums.push_back(accumulatedField.makeAccumulator());
+            }
+            startAccumulators(newRange.accums);
+            range = _ranges.emplace_hint(range, key, std::move(newRange));
+        }
+
+        ++range->second.count;
+        for (size_t k = 0; k < _accumulatedFields.size(); ++k) {
+            range->second.accums[k]->process(
+                _accumulatedFields[k].expr.argument->evaluate(nextDoc, &pExpCtx->variables),
+                false);
+        }
+        ++_nDocuments;
+
+        if (_ranges.size() > maxRanges) {
+            compactRanges();
+        }
+    }
+    return next;
+}
+
+void DocumentSourceBucketAuto::compactRanges() {
+    // Ranges are merged into the range before them while the merged range would hold at most four
+    // times the average number of documents for 'kRangesPerBucket' ranges per bucket. Any two
+    // adjacent ranges left then hold more than that between them, which bounds their number by
+    // about half the maximum.
+    const long long maxCount =
+        std::max(1LL, 4 * _nDocuments / static_cast<long long>(kRangesPerBucket * _nBuckets));
+    auto current = _ranges.begin();
+    for (auto next = std::next(current); next != _ranges.end();) {
+        if (current->second.count + next->second.count > maxCount) {
+            current = next++;
+            continue;
+        }
+        current->second.max = next->second.max;
+        current->second.count += next->second.count;
+        for (size_t k = 0; k < _accumulatedFields.size(); ++k) {
+            current->second.accums[k]->process(next->second.accums[k]->getValue(true), true);
+        }
+        next = _ranges.erase(next);
+    }
+}
+
+boost::optional<DocumentSourceBucketAuto::Bucket>
+DocumentSourceBucketAuto::populateNextBucketFromRanges() {
+    if (_nextRange == _ranges.end()) {
+        return {};
+    }
+
+    // The bucket takes over the accumulators of its first range, and merges those of the ranges
+    // after it into them until the buckets so far hold their share of the documents. The last
+    // bucket takes all of the remaining ranges.
+    Bucket bucket(pExpCtx, _nextRange->first, _nextRange->second.max, {});
+    bucket._accums = std::move(_nextRange->second.accums);
+    _nBucketedDocuments += _nextRange->second.count;
+    const auto isLastBucket = (_currentBucketDetails.currentBucketNum == _nBuckets);
+    const long long target =
+        std::llround(double(_nDocuments) * _currentBucketDetails.currentBucketNum / _nBuckets);
+    for (++_nextRange;
+         _nextRange != _ranges.end() && (_nBucketedDocuments < target || isLastBucket);
+         ++_nextRange) {
+        bucket._max = _nextRange->second.max;
+        _nBucketedDocuments += _nextRange->second.count;
+        for (size_t k = 0; k < _accumulatedFields.size(); ++k) {
+            bucket._accums[k]->process(_nextRange->second.accums[k]->getValue(true), true);
+        }
+    }
+
+    // As for exact buckets, the max boundary is exclusive unless this is the last bucket.
+    if (_nextRange != _ranges.end()) {
+        bucket._max = _nextRange->first;
+    }
+    return bucket;
+}
+
+void DocumentSourceBucketAuto::startAccumulators(
+    const std::vector<boost::intrusive_ptr<AccumulatorState>>& accums) {
+    // Evaluate each initializer against an empty document. Normally the initializer can refer to
+    // the group key, but in $bucketAuto there is no single group key per bucket.
+    Document emptyDoc;
+    for (size_t k = 0; k < _accumulatedFields.size(); ++k) {
+        Value initializerValue =
+            _accumulatedFields[k].expr.initializer->evaluate(emptyDoc, &pExpCtx->variables);
+        accums[k]->startNewGroup(initializerValue);
+    }
+}
+
 Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     if (!_groupByExpression) {
         return Value(BSONNULL);
@@ -207,15 +310,19 @@ void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>&
 }
 
 void DocumentSourceBucketAuto::initalizeBucketIteration() {
-    // Initialize the iterator on '_sorter'.
-    invariant(_sorter);
-    _sortedInput.reset(_sorter->done());
+    if (_approximate) {
+        _nextRange = _ranges.begin();
+    } else {
+        // Initialize the iterator on '_sorter'.
+        invariant(_sorter);
+        _sortedInput.reset(_sorter->done());
 
-    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(pExpCtx->opCtx);
-    metricsCollector.incrementKeysSorted(_sorter->numSorted());
-    metricsCollector.incrementSorterSpills(_sorter->numSpills());
+        auto& metricsCollector = ResourceConsumption::MetricsCollector::get(pExpCtx->opCtx);
+        metricsCollector.incrementKeysSorted(_sorter->numSorted());
+        metricsCollector.incrementSorterSpills(_sorter->numSpills());
 
-    _sorter.reset();
+        _sorter.reset();
+    }
 
     // If there are no buckets, then we don't need to populate anything.
     if (_nBuckets == 0) {
@@ -304,15 +411,7 @@ boost::optional<DocumentSourceBucketAuto::Bucket> DocumentSourceBucketAuto::popu
             _granularityRounder->roundDown(currentValue.first));
     }
 
-    // Evaluate each initializer against an empty document. Normally the initializer can refer to
-    // the group key, but in $bucketAuto there is no single group key per bucket.
-    Document emptyDoc;
-    for (size_t k = 0; k < _accumulatedFields.size(); ++k) {
-        Value initializerValue =
-            _accumulatedFields[k].expr.initializer->evaluate(emptyDoc, &pExpCtx->variables);
-        currentBucket._accums[k]->startNewGroup(initializerValue);
-    }
-
+    startAccumulators(currentBucket._accums);
 
     // Add 'approxBucketSize' number of documents to the current bucket. If this is the last bucket,
     // add all the remaining documents.
@@ -362,6 +461,8 @@ Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
 
 void DocumentSourceBucketAuto::doDispose() {
     _sortedInput.reset();
+    _ranges.clear();
+    _nextRange = _ranges.end();
 }
 
 Value DocumentSourceBucketAuto::serialize(
@@ -375,6 +476,10 @@ Value DocumentSourceBucketAuto::serialize(
         insides["granularity"] = Value(_granularityRounder->getName());
     }
 
+    if (_approximate) {
+        insides["approximate"] = Value(true);
+    }
+
     MutableDocument outputSpec(_accumulatedFields.size());
     for (auto&& accumulatedField : _accumulatedFields) {
         intrusive_ptr<AccumulatorState> accum = accumulatedField.makeAccumulator();
@@ -394,11 +499,15 @@ intrusive_ptr<DocumentSourceBucketAuto> DocumentSourceBucketAuto::create(
     int numBuckets,
     std::vector<AccumulationStatement> accumulationStatements,
     const boost::intrusive_ptr<GranularityRounder>& granularityRounder,
-    uint64_t maxMemoryUsageBytes) {
+    uint64_t maxMemoryUsageBytes,
+    bool approximate) {
     uassert(40243,
             str::stream() << "The $bucketAuto 'buckets' field must be greater than 0, but found: "
                           << numBuckets,
             numBuckets > 0);
+    uassert(5843119,
+            "The $bucketAuto 'granularity' field cannot be combined with 'approximate'",
+            !(approximate && granularityRounder));
     // If there is no output field specified, then add the default one.
     if (accumulationStatements.empty()) {
         accumulationStatements.emplace_back(
@@ -412,7 +521,8 @@ intrusive_ptr<DocumentSourceBucketAuto> DocumentSourceBucketAuto::create(
                                         numBuckets,
                                         accumulationStatements,
                                         granularityRounder,
-                                        maxMemoryUsageBytes);
+                                        maxMemoryUsageBytes,
+                                        approximate);
 }
 
 DocumentSourceBucketAuto::DocumentSourceBucketAuto(
@@ -421,13 +531,17 @@ DocumentSourceBucketAuto::DocumentSourceBucketAuto(
     int numBuckets,
     std::vector<AccumulationStatement> accumulationStatements,
     const boost::intrusive_ptr<GranularityRounder>& granularityRounder,
-    uint64_t maxMemoryUsageBytes)
+    uint64_t maxMemoryUsageBytes,
+    bool approximate)
     : DocumentSource(kStageName, pExpCtx),
       _maxMemoryUsageBytes(maxMemoryUsageBytes),
       _groupByExpression(groupByExpression),
       _granularityRounder(granularityRounder),
       _nBuckets(numBuckets),
-      _currentBucketDetails{0} {
+      _currentBucketDetails{0},
+      _approximate(approximate),
+      _ranges(pExpCtx->getValueComparator().makeOrderedValueMap<ValueRange>()),
+      _nextRange(_ranges.end()) {
     invariant(!accumulationStatements.empty());
     for (auto&& accumulationStatement : accumulationStatements) {
         _accumulatedFields.push_back(accumulationStatement);
@@ -454,6 +568,7 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
     boost::intrusive_ptr<Expression> groupByExpression;
     boost::optional<int> numBuckets;
     boost::intrusive_ptr<GranularityRounder> granularityRounder;
+    bool approximate = false;
 
     for (auto&& argument : elem.Obj()) {
         const auto argName = argument.fieldNameStringData();
@@ -499,6 +614,13 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
                         << typeName(argument.type()),
                     argument.type() == BSONType::String);
             granularityRounder = GranularityRounder::getGranularityRounder(pExpCtx, argument.str());
+        } else if ("approximate" == argName) {
+            uassert(5843120,
+                    str::stream()
+                        << "The $bucketAuto 'approximate' field must be a boolean, but found type: "
+                        << typeName(argument.type()),
+                    argument.type() == BSONType::Bool);
+            approximate = argument.boolean();
         } else {
             uasserted(40245, str::stream() << "Unrecognized option to $bucketAuto: " << argName);
         }
@@ -508,8 +630,13 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
             "$bucketAuto requires 'groupBy' and 'buckets' to be specified",
             groupByExpression && numBuckets);
 
-    return DocumentSourceBucketAuto::create(
-        pExpCtx, groupByExpression, numBuckets.get(), accumulationStatements, granularityRounder);
+    return DocumentSourceBucketAuto::create(pExpCtx,
+                                            groupByExpression,
+                                            numBuckets.get(),
+                                            accumulationStatements,
+                                            granularityRounder,
+                                            kDefaultMaxMemoryUsageBytes,
+                                            approximate);
 }
 
 }  // namespace mongo
@@ -41,6 +41,11 @@ namespace mongo {
 /**
  * The $bucketAuto stage takes a user-specified number of buckets and automatically determines
  * boundaries such that the values are approximately equally distributed between those buckets.
+ *
+ * With 'approximate: true', the input is not sorted. Instead it is summarized in a single pass by
+ * a bounded number of contiguous ranges of 'groupBy' values, each holding the accumulated state of
+ * its documents. Adjacent ranges are merged whenever there are too many, and the buckets are formed
+ * from consecutive ranges at the end. The bucket boundaries are then only as precise as the ranges.
  */
 class DocumentSourceBucketAuto final : public DocumentSource {
 public:
@@ -84,7 +89,11 @@ public:
         int numBuckets,
         std::vector<AccumulationStatement> accumulationStatements = {},
         const boost::intrusive_ptr<GranularityRounder>& granularityRounder = nullptr,
-        uint64_t maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes);
+        uint64_t maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes,
+        bool approximate = false);
+
+    // In approximate mode, the number of value ranges kept per requested bucket.
+    static constexpr size_t kRangesPerBucket = 128;
 
     /**
      * Parses a $bucketAuto stage from the user-supplied BSON.
@@ -105,7 +114,8 @@ private:
                              int numBuckets,
                              std::vector<AccumulationStatement> accumulationStatements,
                              const boost::intrusive_ptr<GranularityRounder>& granularityRounder,
-                             uint64_t maxMemoryUsageBytes);
+                             uint64_t maxMemoryUsageBytes,
+                             bool approximate);
 
     // struct for holding information about a bucket.
     struct Bucket {
@@ -118,6 +128,14 @@ private:
         std::vector<boost::intrusive_ptr<AccumulatorState>> _accums;
     };
 
+    // A contiguous range of 'groupBy' values in approximate mode, from the key it is stored under
+    // to 'max' inclusive, with the number and the accumulated state of the documents in it.
+    struct ValueRange {
+        Value max;
+        long long count = 0;
+        std::vector<boost::intrusive_ptr<AccumulatorState>> accums;
+    };
+
     struct BucketDetails {
         int currentBucketNum;
         long long approxBucketSize = 0;
@@ -133,6 +151,26 @@ private:
      */
     GetNextResult populateSorter();
 
+    /**
+     * The approximate mode counterpart of populateSorter(), which adds the documents from the
+     * source to '_ranges'.
+     */
+    GetNextResult populateRanges();
+
+    /**
+     * Merges adjacent ranges of '_ranges' holding few documents, so that about half as many are
+     * left.
+     */
+    void compactRanges();
+
+    /**
+     * The approximate mode counterpart of populateNextBucket(), which forms the next bucket from
+     * ranges of '_ranges'. Since a range may hold many documents, the buckets are filled up to an
+     * even share of all the documents so far, rather than to 'approxBucketSize' each, so that the
+     * last bucket does not make up for the excess of all the others.
+     */
+    boost::optional<Bucket> populateNextBucketFromRanges();
+
     void initalizeBucketIteration();
 
     /**
@@ -158,6 +196,9 @@ private:
      */
     Document makeDocument(const Bucket& bucket);
 
+    // Starts the accumulators of 'accums' for a new bucket of $bucketAuto.
+    void startAccumulators(const std::vector<boost::intrusive_ptr<AccumulatorState>>& accums);
+
     std::unique_ptr<Sorter<Value, Document>> _sorter;
     std::unique_ptr<Sorter<Value, Document>::Iterator> _sortedInput;
 
@@ -170,6 +211,14 @@ private:
     int _nBuckets;
     long long _nDocuments = 0;
     BucketDetails _currentBucketDetails;
+
+    const bool _approximate;
+
+    // Only used in approximate mode. The value ranges summarizing the input, keyed by their
+    // smallest value, and the next one to add to a bucket once they are all populated.
+    ValueMap<ValueRange> _ranges;
+    ValueMap<ValueRange>::iterator _nextRange;
+    long long _nBucketedDocuments = 0;
 };
 
 }  // namespace mongo
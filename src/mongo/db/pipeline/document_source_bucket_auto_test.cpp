@@ -518,6 +518,15 @@ TEST_F(BucketAutoTests, SerializesOutputFieldIfSpecified) {
     testSerialize(spec, expected);
 }
 
+TEST_F(BucketAutoTests, SerializesApproximateFieldIfSpecified) {
+    BSONObj spec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, approximate : true}}");
+    BSONObj expected = fromjson(
+        "{groupBy : '$x', buckets : 2, approximate : true, output : {count : {$sum : {$const : "
+        "1}}}}");
+
+    testSerialize(spec, expected);
+}
+
 TEST_F(BucketAutoTests, SerializesGranularityFieldIfSpecified) {
     BSONObj spec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, granularity : 'R5'}}");
     BSONObj expected = fromjson(
@@ -616,6 +625,17 @@ TEST_F(BucketAutoTests, FailsWithUnknownField) {
     ASSERT_THROWS_CODE(createBucketAuto(spec), AssertionException, 40245);
 }
 
+TEST_F(BucketAutoTests, FailsWithNonBooleanApproximate) {
+    auto spec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 1, approximate : 1}}");
+    ASSERT_THROWS_CODE(createBucketAuto(spec), AssertionException, 5843120);
+}
+
+TEST_F(BucketAutoTests, FailsWithApproximateAndGranularity) {
+    auto spec = fromjson(
+        "{$bucketAuto : {groupBy : '$x', buckets : 1, approximate : true, granularity : 'R5'}}");
+    ASSERT_THROWS_CODE(createBucketAuto(spec), AssertionException, 5843119);
+}
+
 TEST_F(BucketAutoTests, FailsWithInvalidExpressionToAccumulator) {
     auto spec = fromjson(
         "{$bucketAuto : {groupBy : '$x', buckets : 1, output : {avg : {$avg : ['$x', 1]}}}}");
@@ -852,5 +872,53 @@ TEST_F(BucketAutoTests, ShouldFailOnNegativeNumbersWhenGranularitySpecified) {
         AssertionException,
         40260);
 }
+TEST_F(BucketAutoTests, ApproximateModeIsExactWithFewDistinctValues) {
+    deque<Document> inputs;
+    for (int i = 0; i < 1000; ++i) {
+        inputs.push_back(Document{{"x", (i * 17) % 40}, {"y", i}});
+    }
+
+    auto exact = getResults(
+        fromjson("{$bucketAuto : {groupBy : '$x', buckets : 5, output : {count : {$sum : 1}, "
+                 "avg : {$avg : '$y'}}}}"),
+        inputs);
+    auto approximate = getResults(
+        fromjson("{$bucketAuto : {groupBy : '$x', buckets : 5, approximate : true, output : "
+                 "{count : {$sum : 1}, avg : {$avg : '$y'}}}}"),
+        inputs);
+
+    ASSERT_EQUALS(exact.size(), 5UL);
+    ASSERT_EQUALS(approximate.size(), exact.size());
+    for (size_t i = 0; i < exact.size(); ++i) {
+        ASSERT_DOCUMENT_EQ(exact[i], approximate[i]);
+    }
+}
+
+TEST_F(BucketAutoTests, ApproximateModeSummarizesManyDistinctValues) {
+    deque<Document> inputs;
+    const int kNumDocs = 10000;
+    for (int i = 0; i < kNumDocs; ++i) {
+        inputs.push_back(Document{{"x", (i * 7919) % kNumDocs}});
+    }
+
+    auto results = getResults(
+        fromjson("{$bucketAuto : {groupBy : '$x', buckets : 4, approximate : true}}"), inputs);
+    ASSERT_EQUALS(results.size(), 4UL);
+
+    // The buckets cover all of the values, are contiguous, and are roughly equally sized.
+    ASSERT_VALUE_EQ(results.front()["_id"]["min"], Value(0));
+    ASSERT_VALUE_EQ(results.back()["_id"]["max"], Value(kNumDocs - 1));
+    long long total = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (i > 0) {
+            ASSERT_VALUE_EQ(results[i - 1]["_id"]["max"], results[i]["_id"]["min"]);
+        }
+        const auto count = results[i]["count"].coerceToLong();
+        ASSERT_APPROX_EQUAL(kNumDocs / 4, count, kNumDocs / 20);
+        total += count;
+    }
+    ASSERT_EQUALS(total, kNumDocs);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -195,6 +195,25 @@ BSONObj getTxnApplyOpsFilter(BSONElement nsMatch, const NamespaceString& nss) {
     }
     return applyOpsBuilder.obj();
 }
+
+/**
+ * Constructs a filter matching any 'applyOps' commands written outside of a transaction which only
+ * contain inserts, at least one of which is into a namespace that the change stream is watching.
+ * These include the entries the inserts of a batch are grouped in when
+ * 'internalInsertGroupOplogEntries' is enabled.
+ */
+BSONObj getInsertsApplyOpsFilter(BSONElement nsMatch) {
+    BSONObjBuilder applyOpsBuilder;
+    applyOpsBuilder.append("op", "c");
+    applyOpsBuilder.append("o.applyOps.0", BSON("$exists" << true));
+    applyOpsBuilder.append("lsid", BSON("$exists" << false));
+    applyOpsBuilder.append(
+        "o.applyOps",
+        BSON("$not" << BSON("$elemMatch" << BSON("op" << BSON("$ne"
+                                                              << "i")))));
+    applyOpsBuilder.appendAs(nsMatch, "o.applyOps.ns"_sd);
+    return applyOpsBuilder.obj();
+}
 }  // namespace
 
 DocumentSourceChangeStream::ChangeStreamType DocumentSourceChangeStream::getChangeStreamType(
@@ -318,9 +337,13 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
     // 3) Look for 'applyOps' which were created as part of a transaction.
     BSONObj applyOps = getTxnApplyOpsFilter(opNsMatch["ns"], nss);
 
-    // Either (1) or (3), excluding those resulting from chunk migration.
-    BSONObj commandAndApplyOpsMatch =
-        BSON("$and" << BSON_ARRAY(BSON(OR(commandMatch, applyOps)) << notFromMigrateFilter));
+    // 4) Look for 'applyOps' of inserts which were created outside of a transaction.
+    BSONObj insertsApplyOps = getInsertsApplyOpsFilter(opNsMatch["ns"]);
+
+    // Either (1), (3) or (4), excluding those resulting from chunk migration.
+    BSONObj commandAndApplyOpsMatch = BSON(
+        "$and" << BSON_ARRAY(BSON(OR(commandMatch, applyOps, insertsApplyOps))
+                             << notFromMigrateFilter));
 
     // Match oplog entries after "start" that are either supported (1) commands or (2) operations.
     // Only include CRUD operations tagged "fromMigrate" when the "showMigrationEvents" option is
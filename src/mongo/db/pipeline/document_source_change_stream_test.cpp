@@ -42,6 +42,7 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/change_stream_event_cache.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 #include "mongo/db/pipeline/document_source_change_stream_transform.h"
@@ -51,6 +52,8 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/transaction_history_iterator.h"
@@ -308,11 +311,12 @@ public:
     /**
      * Helper for running an applyOps through the pipeline, and getting all of the results.
      */
-    std::vector<Document> getApplyOpsResults(const Document& applyOpsDoc,
-                                             const LogicalSessionFromClient& lsid) {
+    std::vector<Document> getApplyOpsResults(
+        const Document& applyOpsDoc, const boost::optional<LogicalSessionFromClient>& lsid) {
         BSONObj applyOpsObj = applyOpsDoc.toBson();
 
-        // Create an oplog entry and then glue on an lsid and txnNumber
+        // Create an oplog entry and then glue on an lsid and txnNumber, unless the entry is meant
+        // to have been written outside of a transaction.
         auto baseOplogEntry = makeOplogEntry(OpTypeEnum::kCommand,
                                              nss.getCommandNS(),
                                              applyOpsObj,
@@ -320,8 +324,10 @@ public:
                                              boost::none,  // fromMigrate
                                              BSONObj());
         BSONObjBuilder builder(baseOplogEntry.toBSON());
-        builder.append("lsid", lsid.toBSON());
-        builder.append("txnNumber", 0LL);
+        if (lsid) {
+            builder.append("lsid", lsid->toBSON());
+            builder.append("txnNumber", 0LL);
+        }
         BSONObj oplogEntry = builder.done();
 
         // Create the stages and check that the documents produced matched those in the applyOps.
@@ -1550,6 +1556,225 @@ TEST_F(ChangeStreamStageTest, TransformApplyOps) {
     // The third document is skipped.
 }
 
+TEST_F(ChangeStreamStageTest, TransformApplyOpsOfInsertsWithoutSession) {
+    Document applyOpsDoc{
+        {"applyOps",
+         Value{std::vector<Document>{
+             Document{{"op", "i"_sd},
+                      {"ns", nss.ns()},
+                      {"ui", testUuid()},
+                      {"o", Value{Document{{"_id", 1}, {"x", 1}}}}},
+             // Operation on another namespace which should be skipped.
+             Document{{"op", "i"_sd},
+                      {"ns", "someotherdb.collname"_sd},
+                      {"ui", UUID::gen()},
+                      {"o", Value{Document{{"_id", 0}}}}},
+             Document{{"op", "i"_sd},
+                      {"ns", nss.ns()},
+                      {"ui", testUuid()},
+                      {"o", Value{Document{{"_id", 2}, {"x", 2}}}}},
+         }}},
+    };
+    vector<Document> results = getApplyOpsResults(applyOpsDoc, boost::none);
+    ASSERT_EQ(results.size(), 2u);
+
+    // The events are those of plain inserts, which share the entry's clusterTime but not their
+    // resume tokens.
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& nextDoc = results[i];
+        ASSERT_EQ(nextDoc[DSChangeStream::kOperationTypeField].getString(),
+                  DSChangeStream::kInsertOpType);
+        ASSERT_EQ(nextDoc[DSChangeStream::kFullDocumentField]["_id"].getInt(), int(i) + 1);
+        ASSERT_EQ(nextDoc[DSChangeStream::kClusterTimeField].getTimestamp(), kDefaultTs);
+        ASSERT(nextDoc["lsid"].missing());
+        ASSERT(nextDoc["txnNumber"].missing());
+    }
+    ASSERT_VALUE_NE(results[0][DSChangeStream::kIdField], results[1][DSChangeStream::kIdField]);
+}
+
+TEST_F(ChangeStreamStageTest, ApplyOpsWithoutSessionIsIgnoredUnlessItOnlyInserts) {
+    Document applyOpsDoc{
+        {"applyOps",
+         Value{std::vector<Document>{
+             Document{{"op", "i"_sd},
+                      {"ns", nss.ns()},
+                      {"ui", testUuid()},
+                      {"o", Value{Document{{"_id", 1}}}}},
+             Document{{"op", "u"_sd},
+                      {"ns", nss.ns()},
+                      {"ui", testUuid()},
+                      {"o", Value{Document{{"$set", Value{Document{{"x", 1}}}}}}},
+                      {"o2", Value{Document{{"_id", 1}}}}},
+         }}},
+    };
+    ASSERT_EQ(getApplyOpsResults(applyOpsDoc, boost::none).size(), 0u);
+}
+
+/**
+ * Enables the cache through which change streams share the events they build for the duration of
+ * a test.
+ */
+class ChangeStreamSharedEventCacheTest : public ChangeStreamStageTest {
+public:
+    ChangeStreamSharedEventCacheTest() {
+        ChangeStreamEventCache::get().clear();
+        internalChangeStreamSharedEventCacheMaxBytes.store(1024 * 1024);
+    }
+
+    ~ChangeStreamSharedEventCacheTest() {
+        internalChangeStreamSharedEventCacheMaxBytes.store(0);
+        ChangeStreamEventCache::get().clear();
+    }
+};
+
+TEST_F(ChangeStreamSharedEventCacheTest, ShouldShareEventsBuiltFromTheSameEntry) {
+    BSONObj o2 = BSON("_id" << 1 << "x" << 2);
+    auto updateField = makeOplogEntry(OpTypeEnum::kUpdate,             // op type
+                                      nss,                             // namespace
+                                      BSON("$set" << BSON("y" << 1)),  // o
+                                      testUuid(),                      // uuid
+                                      boost::none,                     // fromMigrate
+                                      o2);                             // o2
+
+    Document expectedUpdateField{
+        {DSChangeStream::kIdField, makeResumeToken(kDefaultTs, testUuid(), o2)},
+        {DSChangeStream::kOperationTypeField, DSChangeStream::kUpdateOpType},
+        {DSChangeStream::kClusterTimeField, kDefaultTs},
+        {DSChangeStream::kNamespaceField, D{{"db", nss.db()}, {"coll", nss.coll()}}},
+        {DSChangeStream::kDocumentKeyField, D{{"_id", 1}, {"x", 2}}},
+        {
+            "updateDescription",
+            D{{"updatedFields", D{{"y", 1}}}, {"removedFields", vector<V>()}},
+        },
+    };
+    checkTransformation(updateField, expectedUpdateField);
+    ASSERT_EQ(ChangeStreamEventCache::get().size(), 1u);
+
+    // A second change stream builds the same event from the cache.
+    checkTransformation(updateField, expectedUpdateField);
+    ASSERT_EQ(ChangeStreamEventCache::get().size(), 1u);
+}
+
+TEST_F(ChangeStreamSharedEventCacheTest, ShouldKeepMissingFieldsOfCachedEventsInPlace) {
+    BSONObj o2 = BSON("_id" << 1);
+    auto updateField = makeOplogEntry(OpTypeEnum::kUpdate,             // op type
+                                      nss,                             // namespace
+                                      BSON("$set" << BSON("y" << 1)),  // o
+                                      testUuid(),                      // uuid
+                                      boost::none,                     // fromMigrate
+                                      o2);                             // o2
+
+    // The post-image lookup fills in the 'fullDocument' field, which must keep its position in the
+    // events built from the cache.
+    const auto spec = fromjson("{$changeStream: {fullDocument: 'updateLookup'}}");
+    Document expectedUpdateLookup{
+        {DSChangeStream::kIdField, makeResumeToken(kDefaultTs, testUuid(), o2)},
+        {DSChangeStream::kOperationTypeField, DSChangeStream::kUpdateOpType},
+        {DSChangeStream::kClusterTimeField, kDefaultTs},
+        {DSChangeStream::kFullDocumentField, D{{"_id", 1}, {"y", 1}}},
+        {DSChangeStream::kNamespaceField, D{{"db", nss.db()}, {"coll", nss.coll()}}},
+        {DSChangeStream::kDocumentKeyField, D{{"_id", 1}}},
+        {
+            "updateDescription",
+            D{{"updatedFields", D{{"y", 1}}}, {"removedFields", vector<V>()}},
+        },
+    };
+    std::vector<Document> documentsForLookup = {D{{"_id", 1}, {"y", 1}}};
+    for (int i = 0; i < 2; ++i) {
+        checkTransformation(
+            updateField, expectedUpdateLookup, {}, spec, boost::none, {}, documentsForLookup);
+    }
+    ASSERT_EQ(ChangeStreamEventCache::get().size(), 1u);
+}
+
+TEST_F(ChangeStreamSharedEventCacheTest, ShouldNotShareEventsBuiltWithOtherDocumentKeyFields) {
+    auto insert = makeOplogEntry(OpTypeEnum::kInsert,           // op type
+                                 nss,                           // namespace
+                                 BSON("_id" << 1 << "x" << 2),  // o
+                                 testUuid(),                    // uuid
+                                 boost::none,                   // fromMigrate
+                                 boost::none);                  // o2
+
+    Document expectedShardedInsert{
+        {DSChangeStream::kIdField,
+         makeResumeToken(kDefaultTs, testUuid(), BSON("x" << 2 << "_id" << 1))},
+        {DSChangeStream::kOperationTypeField, DSChangeStream::kInsertOpType},
+        {DSChangeStream::kClusterTimeField, kDefaultTs},
+        {DSChangeStream::kFullDocumentField, D{{"_id", 1}, {"x", 2}}},
+        {DSChangeStream::kNamespaceField, D{{"db", nss.db()}, {"coll", nss.coll()}}},
+        {DSChangeStream::kDocumentKeyField, D{{"x", 2}, {"_id", 1}}},
+    };
+    checkTransformation(insert, expectedShardedInsert, {{"x"}, {"_id"}});
+
+    Document expectedInsert{
+        {DSChangeStream::kIdField, makeResumeToken(kDefaultTs, testUuid(), BSON("_id" << 1))},
+        {DSChangeStream::kOperationTypeField, DSChangeStream::kInsertOpType},
+        {DSChangeStream::kClusterTimeField, kDefaultTs},
+        {DSChangeStream::kFullDocumentField, D{{"_id", 1}, {"x", 2}}},
+        {DSChangeStream::kNamespaceField, D{{"db", nss.db()}, {"coll", nss.coll()}}},
+        {DSChangeStream::kDocumentKeyField, D{{"_id", 1}}},
+    };
+    checkTransformation(insert, expectedInsert, {{"_id"}});
+    ASSERT_EQ(ChangeStreamEventCache::get().size(), 2u);
+}
+
+TEST_F(ChangeStreamSharedEventCacheTest, ShouldShareEventsOfTransactionsByOperationIndex) {
+    Document applyOpsDoc{
+        {"applyOps",
+         Value{std::vector<Document>{
+             Document{{"op", "i"_sd},
+                      {"ns", nss.ns()},
+                      {"ui", testUuid()},
+                      {"o", Value{Document{{"_id", 123}, {"x", "hallo"_sd}}}}},
+             Document{{"op", "i"_sd},
+                      {"ns", nss.ns()},
+                      {"ui", testUuid()},
+                      {"o", Value{Document{{"_id", 456}, {"x", "hallo 2"_sd}}}}},
+         }}},
+    };
+    LogicalSessionFromClient lsid = testLsid();
+    vector<Document> results = getApplyOpsResults(applyOpsDoc, lsid);
+    ASSERT_EQ(results.size(), 2u);
+    ASSERT_EQ(ChangeStreamEventCache::get().size(), 2u);
+
+    vector<Document> cachedResults = getApplyOpsResults(applyOpsDoc, lsid);
+    ASSERT_EQ(cachedResults.size(), 2u);
+    ASSERT_EQ(ChangeStreamEventCache::get().size(), 2u);
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_DOCUMENT_EQ(cachedResults[i], results[i]);
+        ASSERT_VALUE_EQ(cachedResults[i].metadata().getSortKey(),
+                        results[i].metadata().getSortKey());
+    }
+    ASSERT_EQ(cachedResults[1][DSChangeStream::kFullDocumentField]["_id"].getInt(), 456);
+}
+
+TEST_F(ChangeStreamSharedEventCacheTest, ShouldEvictOldestEventsOnceFull) {
+    internalChangeStreamSharedEventCacheMaxBytes.store(16 * 1024);
+    for (int i = 1; i <= 100; ++i) {
+        const Timestamp ts(100, i);
+        auto deleteEntry = makeOplogEntry(OpTypeEnum::kDelete,   // op type
+                                          nss,                   // namespace
+                                          BSON("_id" << i),      // o
+                                          testUuid(),            // uuid
+                                          boost::none,           // fromMigrate
+                                          boost::none,           // o2
+                                          repl::OpTime(ts, 1));  // opTime
+
+        Document expectedDelete{
+            {DSChangeStream::kIdField, makeResumeToken(ts, testUuid(), BSON("_id" << i))},
+            {DSChangeStream::kOperationTypeField, DSChangeStream::kDeleteOpType},
+            {DSChangeStream::kClusterTimeField, ts},
+            {DSChangeStream::kNamespaceField, D{{"db", nss.db()}, {"coll", nss.coll()}}},
+            {DSChangeStream::kDocumentKeyField, D{{"_id", i}}},
+        };
+        checkTransformation(deleteEntry, expectedDelete);
+    }
+
+    const auto cachedEvents = ChangeStreamEventCache::get().size();
+    ASSERT_GT(cachedEvents, 0u);
+    ASSERT_LT(cachedEvents, 100u);
+}
+
 TEST_F(ChangeStreamStageTest, ClusterTimeMatchesOplogEntry) {
     const Timestamp ts(3, 45);
     const long long term = 4;
@@ -1661,6 +1886,69 @@ TEST_F(ChangeStreamStageTest, TransformationShouldBeAbleToReParseSerializedStage
     ASSERT_VALUE_EQ(newSerialization[0], serialization[0]);
 }
 
+TEST_F(ChangeStreamStageTest, ShouldPushUserMatchDownIntoOplogFilter) {
+    auto stages = DSChangeStream::createFromBson(kDefaultSpec.firstElement(), getExpCtx());
+    const auto numChangeStreamStages = stages.size();
+    stages.push_back(DocumentSourceMatch::create(
+        fromjson("{operationType: 'insert', 'fullDocument.x': 2}"), getExpCtx()));
+    auto pipeline = Pipeline::create(std::move(stages), getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(pipeline->getSources().front().get());
+    ASSERT(oplogMatch);
+    auto matches = [&](const OplogEntry& entry) {
+        return oplogMatch->getMatchExpression()->matchesBSON(entry.toBSON());
+    };
+    ASSERT_TRUE(matches(makeOplogEntry(OpTypeEnum::kInsert, nss, BSON("_id" << 1 << "x" << 2))));
+    ASSERT_FALSE(matches(makeOplogEntry(OpTypeEnum::kInsert, nss, BSON("_id" << 1 << "x" << 3))));
+    ASSERT_FALSE(matches(makeOplogEntry(OpTypeEnum::kDelete, nss, BSON("_id" << 1))));
+    ASSERT_TRUE(matches(createCommand(BSON("drop" << nss.coll()), testUuid())));
+
+    // The user $match is still applied to the change events.
+    ASSERT_EQ(pipeline->getSources().size(), numChangeStreamStages + 1);
+    ASSERT(dynamic_cast<DocumentSourceMatch*>(pipeline->getSources().back().get()));
+}
+
+TEST_F(ChangeStreamStageTest, ShouldKeepEntryOfResumeTokenWhenPushingUserMatchDown) {
+    auto resumeToken = makeResumeToken(kDefaultTs, testUuid(), BSON("_id" << 1));
+    auto spec = BSON(DSChangeStream::kStageName << BSON("resumeAfter" << resumeToken));
+    auto stages = DSChangeStream::createFromBson(spec.firstElement(), getExpCtx());
+    stages.push_back(
+        DocumentSourceMatch::create(fromjson("{operationType: 'insert'}"), getExpCtx()));
+    auto pipeline = Pipeline::create(std::move(stages), getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(pipeline->getSources().front().get());
+    ASSERT(oplogMatch);
+    const auto laterOpTime = repl::OpTime(Timestamp(kDefaultTs.getSecs() + 1, 0), 1);
+    auto deleteAtResumeToken = makeOplogEntry(OpTypeEnum::kDelete, nss, BSON("_id" << 1));
+    auto deleteAfterResumeToken = makeOplogEntry(OpTypeEnum::kDelete,
+                                                 nss,
+                                                 BSON("_id" << 1),
+                                                 testUuid(),
+                                                 boost::none,
+                                                 boost::none,
+                                                 laterOpTime);
+    ASSERT_TRUE(oplogMatch->getMatchExpression()->matchesBSON(deleteAtResumeToken.toBSON()));
+    ASSERT_FALSE(oplogMatch->getMatchExpression()->matchesBSON(deleteAfterResumeToken.toBSON()));
+}
+
+TEST_F(ChangeStreamStageTest, ShouldNotPushUserMatchDownWithNonSimpleCollation) {
+    getExpCtx()->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kAlwaysEqual));
+    auto stages = DSChangeStream::createFromBson(kDefaultSpec.firstElement(), getExpCtx());
+    stages.push_back(
+        DocumentSourceMatch::create(fromjson("{'fullDocument.x': 'abc'}"), getExpCtx()));
+    auto pipeline = Pipeline::create(std::move(stages), getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(pipeline->getSources().front().get());
+    ASSERT(oplogMatch);
+    auto insert = makeOplogEntry(OpTypeEnum::kInsert, nss, BSON("_id" << 1 << "x"
+                                                                      << "xyz"));
+    ASSERT_TRUE(oplogMatch->getMatchExpression()->matchesBSON(insert.toBSON()));
+}
+
 TEST_F(ChangeStreamStageTest, CloseCursorOnInvalidateEntries) {
     OplogEntry dropColl = createCommand(BSON("drop" << nss.coll()), testUuid());
     auto stages = makeStages(dropColl);
@@ -39,6 +39,7 @@
 #include "mongo/db/commands/feature_compatibility_version_documentation.h"
 #include "mongo/db/pipeline/change_stream_constants.h"
 #include "mongo/db/pipeline/change_stream_document_diff_parser.h"
+#include "mongo/db/pipeline/change_stream_rewrite_helpers.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
@@ -102,6 +103,7 @@ DocumentSourceChangeStreamTransform::DocumentSourceChangeStreamTransform(
     if (resumeAfter || startAfter) {
         ResumeToken token = resumeAfter ? resumeAfter.get() : startAfter.get();
         ResumeTokenData tokenData = token.getData();
+        _resumeTokenClusterTime = tokenData.clusterTime;
 
         if (!tokenData.documentKey.missing() && tokenData.uuid) {
             std::vector<FieldPath> docKeyFields;
@@ -141,6 +143,42 @@ StageConstraints DocumentSourceChangeStreamTransform::constraints(
     return constraints;
 }
 
+Pipeline::SourceContainer::iterator DocumentSourceChangeStreamTransform::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    // The oplog filter compares strings using the simple collation, so the predicates of the user
+    // filter can only be pushed down into it if they use the simple collation as well.
+    if (_pushedDownUserFilter || itr == container->begin() || pExpCtx->getCollator()) {
+        return std::next(itr);
+    }
+
+    auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(std::prev(itr)->get());
+    auto userStage = std::find_if(std::next(itr), container->end(), [](const auto& stage) {
+        return !stage->constraints(Pipeline::SplitState::kUnsplit).isChangeStreamStage();
+    });
+    auto userMatch = userStage != container->end()
+        ? dynamic_cast<DocumentSourceMatch*>(userStage->get())
+        : nullptr;
+    if (!oplogMatch || !userMatch) {
+        return std::next(itr);
+    }
+
+    auto filter = change_stream_rewrite::rewriteFilterForOplog(*userMatch->getMatchExpression());
+    if (filter.isEmpty()) {
+        return std::next(itr);
+    }
+
+    if (_resumeTokenClusterTime) {
+        filter = BSON("$or" << BSON_ARRAY(BSON(repl::OplogEntry::kTimestampFieldName
+                                               << *_resumeTokenClusterTime)
+                                          << filter));
+    }
+    oplogMatch->rebuild(BSON("$and" << BSON_ARRAY(oplogMatch->getQuery() << filter)));
+    _pushedDownUserFilter = true;
+    return std::next(itr);
+}
+
 ResumeTokenData DocumentSourceChangeStreamTransform::getResumeToken(Value ts,
                                                                     Value uuid,
                                                                     Value documentKey) {
@@ -163,6 +201,38 @@ ResumeTokenData DocumentSourceChangeStreamTransform::getResumeToken(Value ts,
     return resumeTokenData;
 }
 
+boost::optional<ChangeStreamEventCache::Key>
+DocumentSourceChangeStreamTransform::makeEventCacheKey(
+    const Document& input, const std::vector<FieldPath>& documentKeyFields) const {
+    if (!ChangeStreamEventCache::enabled()) {
+        return boost::none;
+    }
+
+    StringBuilder variant;
+    variant << (_txnIterator ? 't' : 'o') << (_includePreImageOptime ? 'p' : 'n');
+    for (auto&& field : documentKeyFields) {
+        variant << ',' << field.fullPath();
+    }
+
+    if (_txnIterator) {
+        return ChangeStreamEventCache::Key{_txnIterator->clusterTime(),
+                                           _txnIterator->term(),
+                                           _txnIterator->txnOpIndex(),
+                                           variant.str()};
+    }
+
+    Value ts = input[repl::OplogEntry::kTimestampFieldName];
+    if (ts.getType() != BSONType::bsonTimestamp) {
+        return boost::none;
+    }
+    Value term = input[repl::OplogEntry::kTermFieldName];
+    return ChangeStreamEventCache::Key{
+        ts.getTimestamp(),
+        term.numeric() ? term.coerceToLong() : repl::OpTime::kUninitializedTerm,
+        0,
+        variant.str()};
+}
+
 Document DocumentSourceChangeStreamTransform::applyTransformation(const Document& input) {
     // If we're executing a change stream pipeline that was forwarded from mongos, then we expect it
     // to "need merge"---we expect to be executing the shards part of a split pipeline. It is never
@@ -217,6 +287,38 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
 
         documentKeyFields = _documentKeyCache.find(uuid.getUuid())->second.documentKeyFields;
     }
+
+    // If another change stream has already built the event for this entry, build ours from it.
+    auto eventCacheKey = makeEventCacheKey(input, documentKeyFields);
+    if (eventCacheKey) {
+        if (auto cached = ChangeStreamEventCache::get().find(*eventCacheKey)) {
+            Document event(cached->event);
+            for (auto&& fieldName : cached->fieldNames) {
+                doc.addField(fieldName, event[fieldName]);
+            }
+            doc.metadata().setSortKey(doc.peek()[DocumentSourceChangeStream::kIdField], true);
+            return doc.freeze();
+        }
+    }
+
+    // The names of the fields of the event in order, including those whose value is missing, which
+    // later stages such as the post-image lookup may fill in.
+    std::vector<std::string> fieldNames;
+    auto addField = [&](StringData fieldName, Value value) {
+        if (eventCacheKey) {
+            fieldNames.push_back(fieldName.toString());
+        }
+        doc.addField(fieldName, std::move(value));
+    };
+    auto freezeEvent = [&] {
+        Document event = doc.freeze();
+        if (eventCacheKey) {
+            ChangeStreamEventCache::get().add(
+                std::move(*eventCacheKey), event, std::move(fieldNames));
+        }
+        return event;
+    };
+
     Value id = input.getNestedField("o._id");
     // Non-replace updates have the _id in field "o2".
     StringData operationType;
@@ -300,9 +402,9 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
                 // The "o.to" field contains the target namespace for the rename.
                 const auto renameTargetNss =
                     NamespaceString(input.getNestedField("o.to").getString());
-                doc.addField(DocumentSourceChangeStream::kRenameTargetNssField,
-                             Value(Document{{"db", renameTargetNss.db()},
-                                            {"coll", renameTargetNss.coll()}}));
+                addField(DocumentSourceChangeStream::kRenameTargetNssField,
+                         Value(Document{{"db", renameTargetNss.db()},
+                                        {"coll", renameTargetNss.coll()}}));
             } else if (!input.getNestedField("o.dropDatabase").missing()) {
                 operationType = DocumentSourceChangeStream::kDropDatabaseOpType;
 
@@ -341,15 +443,15 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
     auto resumeToken = ResumeToken(resumeTokenData).toDocument();
 
     // Add some additional fields only relevant to transactions.
-    if (_txnIterator) {
-        doc.addField(DocumentSourceChangeStream::kTxnNumberField,
-                     Value(static_cast<long long>(_txnIterator->txnNumber())));
-        doc.addField(DocumentSourceChangeStream::kLsidField, Value(_txnIterator->lsid()));
+    if (_txnIterator && _txnIterator->lsid()) {
+        addField(DocumentSourceChangeStream::kTxnNumberField,
+                 Value(static_cast<long long>(*_txnIterator->txnNumber())));
+        addField(DocumentSourceChangeStream::kLsidField, Value(*_txnIterator->lsid()));
     }
 
-    doc.addField(DocumentSourceChangeStream::kIdField, Value(resumeToken));
-    doc.addField(DocumentSourceChangeStream::kOperationTypeField, Value(operationType));
-    doc.addField(DocumentSourceChangeStream::kClusterTimeField, Value(resumeTokenData.clusterTime));
+    addField(DocumentSourceChangeStream::kIdField, Value(resumeToken));
+    addField(DocumentSourceChangeStream::kOperationTypeField, Value(operationType));
+    addField(DocumentSourceChangeStream::kClusterTimeField, Value(resumeTokenData.clusterTime));
 
     // We set the resume token as the document's sort key in both the sharded and non-sharded cases,
     // since we will subsequently rely upon it to generate a correct postBatchResumeToken.
@@ -359,26 +461,26 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
     // "invalidate" and "newShardDetected" entries have fewer fields.
     if (operationType == DocumentSourceChangeStream::kInvalidateOpType ||
         operationType == DocumentSourceChangeStream::kNewShardDetectedOpType) {
-        return doc.freeze();
+        return freezeEvent();
     }
 
     // Add the post-image, pre-image, namespace, documentKey and other fields as appropriate.
-    doc.addField(DocumentSourceChangeStream::kFullDocumentField, fullDocument);
+    addField(DocumentSourceChangeStream::kFullDocumentField, fullDocument);
     if (_includePreImageOptime) {
         // Set 'kFullDocumentBeforeChangeField' to the pre-image optime. The DSCSLookupPreImage
         // stage will replace this optime with the actual pre-image taken from the oplog.
-        doc.addField(DocumentSourceChangeStream::kFullDocumentBeforeChangeField, preImageOpTime);
+        addField(DocumentSourceChangeStream::kFullDocumentBeforeChangeField, preImageOpTime);
     }
-    doc.addField(DocumentSourceChangeStream::kNamespaceField,
-                 operationType == DocumentSourceChangeStream::kDropDatabaseOpType
-                     ? Value(Document{{"db", nss.db()}})
-                     : Value(Document{{"db", nss.db()}, {"coll", nss.coll()}}));
-    doc.addField(DocumentSourceChangeStream::kDocumentKeyField, documentKey);
+    addField(DocumentSourceChangeStream::kNamespaceField,
+             operationType == DocumentSourceChangeStream::kDropDatabaseOpType
+                 ? Value(Document{{"db", nss.db()}})
+                 : Value(Document{{"db", nss.db()}, {"coll", nss.coll()}}));
+    addField(DocumentSourceChangeStream::kDocumentKeyField, documentKey);
 
     // Note that 'updateDescription' might be the 'missing' value, in which case it will not be
     // serialized.
-    doc.addField("updateDescription", updateDescription);
-    return doc.freeze();
+    addField("updateDescription", updateDescription);
+    return freezeEvent();
 }
 
 Value DocumentSourceChangeStreamTransform::serialize(
@@ -485,13 +587,17 @@ DocumentSourceChangeStreamTransform::TransactionOpIterator::TransactionOpIterato
     const Document& input,
     const pcrecpp::RE& nsRegex)
     : _mongoProcessInterface(mongoProcessInterface), _nsRegex(nsRegex) {
+    // An applyOps entry written outside of a transaction, such as one grouping the inserts of a
+    // batch, has neither a session nor a transaction number.
     Value lsidValue = input["lsid"];
-    checkValueType(lsidValue, "lsid", BSONType::Object);
-    _lsid = lsidValue.getDocument();
-
     Value txnNumberValue = input["txnNumber"];
-    checkValueType(txnNumberValue, "txnNumber", BSONType::NumberLong);
-    _txnNumber = txnNumberValue.getLong();
+    if (!lsidValue.missing() || !txnNumberValue.missing()) {
+        checkValueType(lsidValue, "lsid", BSONType::Object);
+        _lsid = lsidValue.getDocument();
+
+        checkValueType(txnNumberValue, "txnNumber", BSONType::NumberLong);
+        _txnNumber = txnNumberValue.getLong();
+    }
 
     // We want to parse the OpTime out of this document using the BSON OpTime parser. Instead of
     // converting the entire Document back to BSON, we convert only the fields we need.
@@ -500,6 +606,7 @@ DocumentSourceChangeStreamTransform::TransactionOpIterator::TransactionOpIterato
                                                       << repl::OpTime::kTermFieldName
                                                       << input[repl::OpTime::kTermFieldName]));
     _clusterTime = txnOpTime.getTimestamp();
+    _term = txnOpTime.getTerm();
 
     auto commandObj = input["o"].getDocument();
     Value applyOps = commandObj["applyOps"];
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/pipeline/change_stream_event_cache.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 #include "mongo/db/pipeline/document_source_change_stream_gen.h"
@@ -55,6 +56,14 @@ public:
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const;
     StageConstraints constraints(Pipeline::SplitState pipeState) const final;
 
+    /**
+     * Rewrites the predicates of a user $match which follows the change stream stages over the
+     * fields of the oplog entries, and adds them to the oplog filter preceding this stage, so that
+     * the oplog scan discards the entries whose events cannot match before they are transformed.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
     boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
         return boost::none;
     }
@@ -129,11 +138,17 @@ private:
             return _clusterTime;
         }
 
-        Document lsid() const {
+        long long term() const {
+            return _term;
+        }
+
+        // The session and transaction number are missing for an applyOps entry which was not
+        // written by a transaction.
+        const boost::optional<Document>& lsid() const {
             return _lsid;
         }
 
-        TxnNumber txnNumber() const {
+        boost::optional<TxnNumber> txnNumber() const {
             return _txnNumber;
         }
 
@@ -181,12 +196,13 @@ private:
         // arrays.
         size_t _txnOpIndex;
 
-        // The clusterTime of the _applyOps.
+        // The clusterTime and term of the _applyOps.
         Timestamp _clusterTime;
+        long long _term;
 
         // Fields that were taken from the '_applyOps' oplog entry.
-        Document _lsid;
-        TxnNumber _txnNumber;
+        boost::optional<Document> _lsid;
+        boost::optional<TxnNumber> _txnNumber;
 
         // Used for traversing the oplog with TransactionHistoryInterface.
         std::shared_ptr<MongoProcessInterface> _mongoProcessInterface;
@@ -195,6 +211,14 @@ private:
         const pcrecpp::RE& _nsRegex;
     };
 
+    /**
+     * Returns the key under which the event built from 'input' with the document key fields
+     * 'documentKeyFields' is shared with other change streams, or boost::none if the shared event
+     * cache is disabled.
+     */
+    boost::optional<ChangeStreamEventCache::Key> makeEventCacheKey(
+        const Document& input, const std::vector<FieldPath>& documentKeyFields) const;
+
     /**
      * Helper used for determining what resume token to return.
      */
@@ -202,6 +226,13 @@ private:
 
     BSONObj _changeStreamSpec;
 
+    // The clusterTime of the resume token of the stream, if it is resumed from a token. The entry
+    // of the resumed event must reach the resume token check even if the user filter rejects it.
+    boost::optional<Timestamp> _resumeTokenClusterTime;
+
+    // Set once the user filter has been pushed down into the oplog filter.
+    bool _pushedDownUserFilter = false;
+
     // Map of collection UUID to document key fields.
     std::map<UUID, DocumentKeyCacheEntry> _documentKeyCache;
 
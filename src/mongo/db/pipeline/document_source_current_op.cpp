@@ -110,13 +110,15 @@ const char* DocumentSourceCurrentOp::getSourceName() const {
 
 DocumentSource::GetNextResult DocumentSourceCurrentOp::doGetNext() {
     if (_ops.empty()) {
+        const auto filter = _absorbedMatch ? _absorbedMatch->getMatchExpression() : nullptr;
         _ops = pExpCtx->mongoProcessInterface->getCurrentOps(pExpCtx,
                                                              _includeIdleConnections,
                                                              _includeIdleSessions,
                                                              _includeOpsFromAllUsers,
                                                              _truncateOps,
                                                              _idleCursors,
-                                                             _backtrace);
+                                                             _backtrace,
+                                                             filter);
 
         _opsIter = _ops.begin();
 
@@ -306,4 +308,30 @@ Value DocumentSourceCurrentOp::serialize(boost::optional<ExplainOptions::Verbosi
                   {kBacktraceFieldName,
                    _backtrace == BacktraceMode::kIncludeBacktrace ? Value(true) : Value()}}}});
 }
+
+void DocumentSourceCurrentOp::serializeToArray(
+    std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
+    array.push_back(serialize(explain));
+    if (_absorbedMatch) {
+        _absorbedMatch->serializeToArray(array, explain);
+    }
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceCurrentOp::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    auto itrToNext = std::next(itr);
+    if (itrToNext == container->end()) {
+        return itrToNext;
+    }
+
+    // When running on a shard, the operations are rewritten for mongos after they are collected,
+    // so a $match must see the rewritten documents.
+    auto subsequentMatch = dynamic_cast<DocumentSourceMatch*>(itrToNext->get());
+    if (!subsequentMatch || _absorbedMatch || pExpCtx->fromMongos) {
+        return itrToNext;
+    }
+
+    _absorbedMatch = subsequentMatch;
+    return container->erase(itrToNext);
+}
 }  // namespace mongo
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_match.h"
 
 namespace mongo {
 
@@ -135,6 +136,18 @@ public:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
+    void serializeToArray(
+        std::vector<Value>& array,
+        boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+protected:
+    /**
+     * Absorbs an immediately following $match, so that operations which don't match it are
+     * discarded while they are collected, instead of being returned to the pipeline first.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
 private:
     DocumentSourceCurrentOp(const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
                             ConnMode includeIdleConnections,
@@ -163,6 +176,9 @@ private:
     CursorMode _idleCursors = CursorMode::kExcludeCursors;
     BacktraceMode _backtrace = BacktraceMode::kExcludeBacktrace;
 
+    // A $match stage which was absorbed into this stage, or null.
+    boost::intrusive_ptr<DocumentSourceMatch> _absorbedMatch;
+
     std::string _shardName;
 
     std::vector<BSONObj> _ops;
@@ -33,6 +33,8 @@
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_current_op.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
@@ -72,8 +74,13 @@ public:
                                        CurrentOpUserMode userMode,
                                        CurrentOpTruncateMode truncateMode,
                                        CurrentOpCursorMode cursorMode,
-                                       CurrentOpBacktraceMode backtraceMode) const {
-        return _ops;
+                                       CurrentOpBacktraceMode backtraceMode,
+                                       const MatchExpression* filter) const {
+        std::vector<BSONObj> ops;
+        std::copy_if(_ops.begin(), _ops.end(), std::back_inserter(ops), [&](const BSONObj& op) {
+            return !filter || filter->matchesBSON(op);
+        });
+        return ops;
     }
 
     std::string getShardName(OperationContext* opCtx) const {
@@ -263,5 +270,48 @@ TEST_F(DocumentSourceCurrentOpTest, ShouldFailIfOpIDIsNonNumericWhenModifyingInS
     ASSERT_THROWS_CODE(currentOp->getNext(), AssertionException, ErrorCodes::TypeMismatch);
 }
 
+TEST_F(DocumentSourceCurrentOpTest, ShouldAbsorbSubsequentMatchAndSerializeIt) {
+    const auto specObj = fromjson("{$currentOp: {}}");
+    auto currentOp = DocumentSourceCurrentOp::createFromBson(specObj.firstElement(), getExpCtx());
+    auto match = DocumentSourceMatch::create(fromjson("{active: true}"), getExpCtx());
+    auto pipeline = Pipeline::create({currentOp, match}, getExpCtx());
+
+    pipeline->optimizePipeline();
+    ASSERT_EQ(1u, pipeline->getSources().size());
+
+    auto serialized = pipeline->serialize();
+    ASSERT_EQ(2u, serialized.size());
+    ASSERT_BSONOBJ_EQ(specObj, serialized[0].getDocument().toBson());
+    ASSERT_BSONOBJ_EQ(fromjson("{$match: {active: true}}"), serialized[1].getDocument().toBson());
+}
+
+TEST_F(DocumentSourceCurrentOpTest, ShouldOnlyReturnOpsMatchingAbsorbedMatch) {
+    std::vector<BSONObj> ops{fromjson("{opid: 1, active: true}"),
+                             fromjson("{opid: 2, active: false}"),
+                             fromjson("{opid: 3, active: true}")};
+    getExpCtx()->mongoProcessInterface = std::make_shared<MockMongoInterface>(ops);
+
+    auto currentOp = DocumentSourceCurrentOp::create(getExpCtx());
+    auto match = DocumentSourceMatch::create(fromjson("{active: true}"), getExpCtx());
+    auto pipeline = Pipeline::create({currentOp, match}, getExpCtx());
+    pipeline->optimizePipeline();
+    ASSERT_EQ(1u, pipeline->getSources().size());
+
+    ASSERT_DOCUMENT_EQ(*pipeline->getNext(), (Document{{"opid", 1}, {"active", true}}));
+    ASSERT_DOCUMENT_EQ(*pipeline->getNext(), (Document{{"opid", 3}, {"active", true}}));
+    ASSERT_FALSE(pipeline->getNext());
+}
+
+TEST_F(DocumentSourceCurrentOpTest, ShouldNotAbsorbSubsequentMatchInShardedContext) {
+    getExpCtx()->fromMongos = true;
+
+    auto currentOp = DocumentSourceCurrentOp::create(getExpCtx());
+    auto match = DocumentSourceMatch::create(fromjson("{shard: 'testshard'}"), getExpCtx());
+    auto pipeline = Pipeline::create({currentOp, match}, getExpCtx());
+
+    pipeline->optimizePipeline();
+    ASSERT_EQ(2u, pipeline->getSources().size());
+}
+
 }  // namespace
 }  // namespace mongo
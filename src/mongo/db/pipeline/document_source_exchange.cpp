@@ -356,18 +356,25 @@ size_t Exchange::loadNextBatch() {
         // We have a document and we will deliver it to a consumer(s) based on the policy.
         switch (_policy) {
             case ExchangePolicyEnum::kBroadcast: {
-                bool full = false;
+                boost::optional<size_t> fullConsumerId;
                 // The document is sent to all consumers.
-                for (auto& c : _consumers) {
+                for (size_t idx = 0; idx < _consumers.size(); ++idx) {
                     // By default the Document is shallow copied. However, the broadcasted document
                     // can be used by multiple threads (consumers) and the Document is not thread
-                    // safe. Hence we have to clone the Document.
-                    auto copy = DocumentSource::GetNextResult(input.getDocument().clone());
-                    full = c->appendDocument(copy, _maxBufferSize);
+                    // safe. Hence we have to clone the Document for all consumers but the last one,
+                    // which takes the original.
+                    auto copy = idx + 1 < _consumers.size()
+                        ? DocumentSource::GetNextResult(input.getDocument().clone())
+                        : std::move(input);
+                    if (_consumers[idx]->appendDocument(std::move(copy), _maxBufferSize) &&
+                        !fullConsumerId) {
+                        fullConsumerId = idx;
+                    }
                 }
 
-                if (full)
-                    return 0;
+                // Stop as soon as any consumer's buffer is full, and block the loading on it.
+                if (fullConsumerId)
+                    return *fullConsumerId;
             } break;
             case ExchangePolicyEnum::kRoundRobin: {
                 size_t target = _roundRobinCounter;
@@ -315,6 +315,40 @@ TEST_F(DocumentSourceExchangeTest, BroadcastExchangeNConsumer) {
         _executor->wait(h);
 }
 
+TEST_F(DocumentSourceExchangeTest, BroadcastExchangeStopsLoadingWhenAnyBufferIsFull) {
+    const size_t nDocs = 500;
+    auto source = getMockSource(nDocs);
+
+    const size_t nConsumers = 3;
+
+    ExchangeSpec spec;
+    spec.setPolicy(ExchangePolicyEnum::kBroadcast);
+    spec.setConsumers(nConsumers);
+    spec.setBufferSize(1024);
+
+    auto opCtx = getOpCtx();
+    boost::intrusive_ptr<Exchange> ex = new Exchange(spec, Pipeline::create({source}, getExpCtx()));
+
+    // The first load fills every buffer with the same documents.
+    ASSERT_TRUE(ex->getNext(opCtx, 1, nullptr).isAdvanced());
+    const size_t nDocsPerBuffer = nDocs - source->size();
+    ASSERT_GT(nDocsPerBuffer, 1u);
+
+    // Drain the buffers of the first and last consumers, leaving the middle one nearly full.
+    for (size_t i = 0; i < nDocsPerBuffer; ++i) {
+        ASSERT_TRUE(ex->getNext(opCtx, 0, nullptr).isAdvanced());
+        ASSERT_TRUE(ex->getNext(opCtx, 2, nullptr).isAdvanced());
+    }
+
+    // Loading again fills up the middle consumer's buffer after a single document.
+    ASSERT_TRUE(ex->getNext(opCtx, 0, nullptr).isAdvanced());
+    ASSERT_EQ(nDocs - nDocsPerBuffer - 1, source->size());
+
+    for (size_t id = 0; id < nConsumers; ++id) {
+        ex->dispose(opCtx, id);
+    }
+}
+
 TEST_F(DocumentSourceExchangeTest, RangeExchangeNConsumer) {
     const size_t nDocs = 500;
     auto source = getMockSource(nDocs);
@@ -160,17 +160,25 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     };
 
     vector<vector<Value>> results(_facets.size());
-    bool allPipelinesEOF = false;
-    while (!allPipelinesEOF) {
-        allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
+    // Each pipeline which has reached EOF, e.g. because of a $limit, is not pulled from again while
+    // the other pipelines consume the rest of the input.
+    vector<bool> pipelineEOF(_facets.size(), false);
+    size_t nPipelinesEOF = 0;
+    while (nPipelinesEOF < _facets.size()) {
         for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+            if (pipelineEOF[facetId]) {
+                continue;
+            }
             const auto& pipeline = _facets[facetId].pipeline;
             auto next = pipeline->getSources().back()->getNext();
             for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
                 ensureUnderMemoryLimit(next.getDocument().getApproximateSize());
                 results[facetId].emplace_back(next.releaseDocument());
             }
-            allPipelinesEOF = allPipelinesEOF && next.isEOF();
+            if (next.isEOF()) {
+                pipelineEOF[facetId] = true;
+                ++nPipelinesEOF;
+            }
         }
     }
 
@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <memory>
 
 #include "mongo/base/init.h"
@@ -45,10 +46,22 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/util/destructor_guard.h"
 
 namespace mongo {
 
 namespace {
+
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number. See the comment on nextFileName() in document_source_group.cpp.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> documentSourceGraphLookUpFileCounter;
+    return "extsort-doc-graph-lookup." +
+        std::to_string(documentSourceGraphLookUpFileCounter.fetchAndAdd(1));
+}
+
 bool foreignShardedLookupAllowed() {
     return getTestCommandsEnabled() && internalQueryAllowShardedLookup.load();
 }
@@ -131,11 +144,9 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (hasVisited()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popVisited()));
     }
 
     MutableDocument output(*_input);
@@ -143,7 +154,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
 
     _visitedUsageBytes = 0;
 
-    invariant(_visited.empty());
+    invariant(!hasVisited());
 
     return output.freeze();
 }
@@ -154,7 +165,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -170,7 +181,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -184,23 +195,50 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popVisited()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
     }
 }
 
+Document DocumentSourceGraphLookUp::popVisited() {
+    invariant(hasVisited());
+    if (_spilledVisited.empty()) {
+        auto it = _visited.begin();
+        auto result = std::move(it->second);
+        _visited.erase(it);
+        return result;
+    }
+
+    auto& spilled = _spilledVisited.front();
+    if (!_spilledVisitedOpen) {
+        spilled->openSource();
+        _spilledVisitedOpen = true;
+    }
+    auto result = spilled->next().second;
+    if (!spilled->more()) {
+        spilled->closeSource();
+        _spilledVisitedOpen = false;
+        _spilledVisited.erase(_spilledVisited.begin());
+    }
+    return result;
+}
+
 void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    _spilledIds.clear();
+    if (_spilledVisitedOpen) {
+        _spilledVisited.front()->closeSource();
+        _spilledVisitedOpen = false;
+    }
+    _spilledVisited.clear();
 }
 
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
@@ -266,13 +304,16 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
     _frontier.clear();
     _frontierUsageBytes = 0;
+
+    // The spilled ids are only needed to de-duplicate the documents found by this search.
+    _spilledIds.clear();
 }
 
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
     // The oplog does not have _id so visited oplog docs are cached by 'ts' instead.
     auto id = _from == NamespaceString::kRsOplogNamespace ? result.getField("ts")
                                                           : result.getField("_id");
-    if (_visited.find(id) != _visited.end()) {
+    if (_visited.find(id) != _visited.end() || _spilledIds.find(id) != _spilledIds.end()) {
         // We've already seen this object, don't repeat any work.
         return false;
     }
@@ -431,13 +472,42 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    if (_allowDiskUse && !_visited.empty() &&
+        (_visitedUsageBytes + _frontierUsageBytes) >= _maxMemoryUsageBytes) {
+        spillVisited();
+    }
+
     uassert(40099,
-            "$graphLookup reached maximum memory consumption",
+            str::stream() << "$graphLookup reached maximum memory consumption"
+                          << (_allowDiskUse ? "" : ". Pass allowDiskUse:true to opt in"),
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
     _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
 }
 
+void DocumentSourceGraphLookUp::spillVisited() {
+    if (_fileName.empty()) {
+        _fileName = pExpCtx->tempDir + "/" + nextFileName();
+    }
+    _usedDisk = true;
+
+    SortedFileWriter<Value, Document> writer(
+        SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSpillFileOffset);
+    // Only the ids of the spilled documents stay in memory.
+    _visitedUsageBytes = 0;
+    for (auto&& id : _spilledIds) {
+        _visitedUsageBytes += id.getApproximateSize();
+    }
+    while (!_visited.empty()) {
+        auto it = _visited.begin();
+        writer.addAlreadySorted(it->first, it->second);
+        _visitedUsageBytes += it->first.getApproximateSize();
+        _spilledIds.insert(it->first);
+        _visited.erase(it);
+    }
+    _spilledVisited.emplace_back(writer.done());
+    _nextSpillFileOffset = writer.getFileEndOffset();
+}
+
 void DocumentSourceGraphLookUp::serializeToArray(
     std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
     auto fromValue = (pExpCtx->ns.db() == _from.db())
@@ -509,8 +579,11 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _additionalFilter(additionalFilter),
       _depthField(depthField),
       _maxDepth(maxDepth),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos),
+      _spilledIds(ValueComparator::kInstance.makeUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc),
       _variables(expCtx->variables),
@@ -525,6 +598,12 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
     _fromPipeline.push_back(BSON("$match" << BSONObj()));
 }
 
+DocumentSourceGraphLookUp::~DocumentSourceGraphLookUp() {
+    if (!_fileName.empty()) {
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_fileName));
+    }
+}
+
 intrusive_ptr<DocumentSourceGraphLookUp> DocumentSourceGraphLookUp::create(
     const intrusive_ptr<ExpressionContext>& expCtx,
     NamespaceString fromNs,
@@ -660,3 +739,6 @@ void DocumentSourceGraphLookUp::addInvolvedCollections(
     }
 }
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -60,8 +61,14 @@ public:
         }
     };
 
+    ~DocumentSourceGraphLookUp();
+
     const char* getSourceName() const final;
 
+    bool usedDisk() final {
+        return _usedDisk;
+    }
+
     const FieldPath& getConnectFromField() const {
         return _connectFromField;
     }
@@ -95,7 +102,7 @@ public:
         StageConstraints constraints(StreamType::kStreaming,
                                      PositionRequirement::kNone,
                                      HostTypeRequirement::kPrimaryShard,
-                                     DiskUseRequirement::kNoDiskUse,
+                                     DiskUseRequirement::kWritesTmpData,
                                      FacetRequirement::kAllowed,
                                      TransactionRequirement::kAllowed,
                                      LookupRequirement::kAllowed,
@@ -200,11 +207,32 @@ private:
     void addToCache(const Document& result, const ValueUnorderedSet& queried);
 
     /**
-     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, spilling
+     * the documents in '_visited' to disk first if allowed, and then evict from '_cache' until this
+     * source is using less than '_maxMemoryUsageBytes'.
      */
     void checkMemoryUsage();
 
+    /**
+     * Writes the documents in '_visited' to disk and empties it, keeping only their ids in memory
+     * in '_spilledIds'.
+     */
+    void spillVisited();
+
+    /**
+     * Returns whether any documents found by the last search are yet to be returned, either from
+     * disk or from '_visited'.
+     */
+    bool hasVisited() const {
+        return !_spilledVisited.empty() || !_visited.empty();
+    }
+
+    /**
+     * Removes and returns the next document found by the last search, reading the documents
+     * spilled to disk before those in '_visited'. Must only be called if hasVisited() is true.
+     */
+    Document popVisited();
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -230,7 +258,7 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
@@ -244,6 +272,18 @@ private:
     // using the simple collation.
     ValueUnorderedMap<Document> _visited;
 
+    // When allowDiskUse is set, the documents in '_visited' are written to '_fileName' once they
+    // exceed the memory limit. Only their ids are kept in '_spilledIds', for de-duplication, and
+    // the documents are read back through '_spilledVisited' once the search is done. Iterators are
+    // removed from '_spilledVisited' as soon as they are exhausted.
+    const bool _allowDiskUse;
+    bool _usedDisk = false;
+    std::string _fileName;
+    std::streampos _nextSpillFileOffset = 0;
+    ValueUnorderedSet _spilledIds;
+    std::vector<std::shared_ptr<Sorter<Value, Document>::Iterator>> _spilledVisited;
+    bool _spilledVisitedOpen = false;
+
     // Caches query results to avoid repeating any work. This structure is maintained across calls
     // to getNext().
     LookupSetCache _cache;
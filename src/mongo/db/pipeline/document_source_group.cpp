@@ -29,8 +29,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
 #include <memory>
+#include <set>
 
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
@@ -62,6 +64,10 @@ std::string nextFileName() {
     return "extsort-doc-group." + std::to_string(documentSourceGroupFileCounter.fetchAndAdd(1));
 }
 
+// The number of arguments a streaming $group buffers per accumulator before handing them to the
+// accumulator as a batch.
+constexpr size_t kStreamingBatchSize = 1024;
+
 }  // namespace
 
 using boost::intrusive_ptr;
@@ -144,6 +150,14 @@ bool DocumentSourceGroup::MemoryUsageTracker::shouldSpillWithAttemptToSaveMemory
                 " Pass allowDiskUse:true to opt in.",
                 allowDiskUse);
         memoryUsageBytes = 0;
+        memoryReservation.update(0);
+        return true;
+    }
+
+    if (allowDiskUse && memoryReservation.update(memoryUsageBytes)) {
+        QueryMemoryReservation::recordForcedSpill();
+        memoryUsageBytes = 0;
+        memoryReservation.update(0);
         return true;
     }
     return false;
@@ -165,6 +179,14 @@ int DocumentSourceGroup::freeMemory() {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
+    if (_streaming && !_initialized) {
+        auto next = getNextStreaming();
+        if (!next.isEOF()) {
+            return next;
+        }
+        invariant(_initialized);
+    }
+
     if (!_initialized) {
         const auto initializationResult = initialize();
         if (initializationResult.isPaused()) {
@@ -226,7 +248,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
         _firstPartOfNextGroup = _sorterIterator->next();
     }
 
-    return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+    return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge || _emitPartials);
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
@@ -234,7 +256,8 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     if (_groups->empty())
         return GetNextResult::makeEOF();
 
-    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
+    Document out = makeDocument(
+        groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge || _emitPartials);
 
     if (++groupsIterator == _groups->end())
         dispose();
@@ -242,10 +265,185 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     return out;
 }
 
+DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
+    const bool mergeableOutput = pExpCtx->needsMerge || _emitPartials;
+
+    if (_streamingAccumulators.size() != _accumulatedFields.size()) {
+        _streamingAccumulators.clear();
+        for (auto&& accumulatedField : _accumulatedFields) {
+            _streamingAccumulators.push_back(accumulatedField.makeAccumulator());
+        }
+        _streamingArguments.assign(_accumulatedFields.size(), {});
+    }
+
+    GetNextResult input = pSource->getNext();
+    for (; input.isAdvanced(); input = pSource->getNext()) {
+        auto rootDocument = input.releaseDocument();
+        Value id = computeId(rootDocument);
+
+        if (!canStreamId(id)) {
+            addToGroupsMap(id, rootDocument);
+            continue;
+        }
+
+        boost::optional<Document> out;
+        if (_streamingGroupStarted &&
+            pExpCtx->getValueComparator().evaluate(_streamingId != id)) {
+            flushStreamingArguments();
+            out = makeDocument(_streamingId, _streamingAccumulators, mergeableOutput);
+            _streamingGroupStarted = false;
+        }
+
+        if (!_streamingGroupStarted) {
+            _streamingId = std::move(id);
+            Value expandedId = expandId(_streamingId);
+            Document idDoc =
+                expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+            for (size_t i = 0; i < _accumulatedFields.size(); ++i) {
+                _streamingAccumulators[i]->reset();
+                _streamingAccumulators[i]->startNewGroup(
+                    _accumulatedFields[i].expr.initializer->evaluate(idDoc, &pExpCtx->variables));
+            }
+            _streamingGroupStarted = true;
+        }
+
+        auto arguments = evaluateAccumulatorArguments(rootDocument);
+        for (size_t i = 0; i < _accumulatedFields.size(); ++i) {
+            _streamingArguments[i].push_back(std::move(arguments[i]));
+        }
+        if (!_streamingArguments.empty() &&
+            _streamingArguments.front().size() >= kStreamingBatchSize) {
+            flushStreamingArguments();
+        }
+
+        if (out) {
+            return std::move(*out);
+        }
+    }
+
+    // Don't hold on to buffered arguments while execution is paused or the input is exhausted.
+    flushStreamingArguments();
+
+    if (input.isPaused()) {
+        return input;
+    }
+
+    // The sorted input is exhausted. Any groups which could not be streamed are returned next.
+    readyGroupsForOutput();
+    _initialized = true;
+
+    if (_streamingGroupStarted) {
+        _streamingGroupStarted = false;
+        return makeDocument(_streamingId, _streamingAccumulators, mergeableOutput);
+    }
+    return input;
+}
+
+void DocumentSourceGroup::flushStreamingArguments() {
+    for (size_t i = 0; i < _streamingArguments.size(); ++i) {
+        if (!_streamingArguments[i].empty()) {
+            _streamingAccumulators[i]->processBatch(_streamingArguments[i], _doingMerge);
+            _streamingArguments[i].clear();
+        }
+    }
+}
+
+bool DocumentSourceGroup::canStreamId(const Value& id) const {
+    auto isStreamable = [](const Value& component) {
+        return !component.nullish() && !component.isArray();
+    };
+
+    if (_idExpressions.size() == 1) {
+        return isStreamable(id);
+    }
+    const auto& components = id.getArray();
+    return std::all_of(components.begin(), components.end(), isStreamable);
+}
+
+void DocumentSourceGroup::setInputSortedBy(const SortPattern& sortPattern) {
+    _streaming = false;
+
+    // Find the sort component that each group key is a path to. The group keys can be streamed if
+    // the set of those components is a prefix of the sort pattern.
+    std::set<size_t> sortPositions;
+    for (auto&& idExpression : _idExpressions) {
+        auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(idExpression.get());
+        if (!fieldPathExpr) {
+            return;
+        }
+
+        auto position = std::find_if(sortPattern.begin(), sortPattern.end(), [&](auto&& part) {
+            return part.fieldPath && fieldPathExpr->representsPath(part.fieldPath->fullPath());
+        });
+        if (position == sortPattern.end()) {
+            return;
+        }
+        sortPositions.insert(std::distance(sortPattern.begin(), position));
+    }
+
+    if (sortPositions.empty() || *sortPositions.rbegin() + 1 != sortPositions.size()) {
+        return;
+    }
+
+    _streaming = true;
+}
+
+bool DocumentSourceGroup::absorbSort(const SortPattern& sortPattern) {
+    if (_absorbedSortPattern || _doingMerge || _emitPartials || pExpCtx->needsMerge) {
+        return false;
+    }
+
+    // A $meta sort key is read from the document metadata, which is not tracked here.
+    if (std::any_of(sortPattern.begin(), sortPattern.end(), [](auto&& part) {
+            return !part.fieldPath;
+        })) {
+        return false;
+    }
+
+    std::vector<AccumulationStatement> accumulatedFields;
+    accumulatedFields.reserve(_accumulatedFields.size());
+    for (auto&& accumulatedField : _accumulatedFields) {
+        using Sense = AccumulatorFirstLastBySortKey::Sense;
+
+        Sense sense = Sense::kFirst;
+        switch (accumulatedField.makeAccumulator()->documentsNeeded()) {
+            case AccumulatorDocumentsNeeded::kFirstDocument:
+                sense = Sense::kFirst;
+                break;
+            case AccumulatorDocumentsNeeded::kLastDocument:
+                sense = Sense::kLast;
+                break;
+            case AccumulatorDocumentsNeeded::kAllDocuments:
+                return false;
+        }
+
+        auto expCtx = pExpCtx.get();
+        accumulatedFields.emplace_back(
+            accumulatedField.fieldName,
+            AccumulationExpression(
+                accumulatedField.expr.initializer,
+                accumulatedField.expr.argument,
+                [expCtx, sortPattern, sense]() {
+                    return AccumulatorFirstLastBySortKey::create(expCtx, sortPattern, sense);
+                }));
+    }
+
+    _accumulatedFields = std::move(accumulatedFields);
+    _absorbedSortPattern.emplace(sortPattern);
+    _absorbedSortKeyGen.emplace(sortPattern, pExpCtx->getCollator());
+
+    // The input no longer arrives in sorted order.
+    _streaming = false;
+    return true;
+}
+
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
+    _streamingAccumulators.clear();
+    _streamingArguments.clear();
+    _streamingGroupStarted = false;
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -299,6 +497,15 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
         insides["$doingMerge"] = Value(true);
     }
 
+    if (_emitPartials) {
+        insides["$emitPartials"] = Value(true);
+    }
+
+    if (_absorbedSortPattern) {
+        insides["$_internalSortBy"] = Value(_absorbedSortPattern->serialize(
+            SortPattern::SortKeySerialization::kForPipelineSerialization));
+    }
+
     return Value(DOC(getSourceName() << insides.freeze()));
 }
 
@@ -314,6 +521,13 @@ DepsTracker::State DocumentSourceGroup::getDependencies(DepsTracker* deps) const
         // Don't add initializer, because it doesn't refer to docs from the input stream.
     }
 
+    // An absorbed $sort still needs its sort key fields.
+    if (_absorbedSortPattern) {
+        for (auto&& part : *_absorbedSortPattern) {
+            deps->fields.insert(part.fieldPath->fullPath());
+        }
+    }
+
     return DepsTracker::State::EXHAUSTIVE_ALL;
 }
 
@@ -455,6 +669,7 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
     BSONObj groupObj(elem.Obj());
     BSONObjIterator groupIterator(groupObj);
     VariablesParseState vps = pExpCtx->variablesParseState;
+    boost::optional<BSONObj> absorbedSortSpec;
     while (groupIterator.more()) {
         BSONElement groupField(groupIterator.next());
         StringData pFieldName = groupField.fieldNameStringData();
@@ -467,6 +682,18 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
             massert(17030, "$doingMerge should be true if present", groupField.Bool());
 
             pGroup->setDoingMerge(true);
+        } else if (pFieldName == "$emitPartials") {
+            uassert(5843105,
+                    "$emitPartials should be true if present",
+                    groupField.isBoolean() && groupField.Bool());
+
+            pGroup->setEmitPartials(true);
+        } else if (pFieldName == "$_internalSortBy") {
+            uassert(5843106,
+                    "$_internalSortBy must be a sort specification object",
+                    groupField.type() == BSONType::Object);
+
+            absorbedSortSpec = groupField.Obj();
         } else {
             // Any other field will be treated as an accumulator specification.
             pGroup->addAccumulator(
@@ -475,6 +702,12 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
     }
 
     uassert(15955, "a group specification must include an _id", !pGroup->_idExpressions.empty());
+
+    if (absorbedSortSpec) {
+        uassert(5843107,
+                "$_internalSortBy is only allowed with $first and $last accumulators",
+                pGroup->absorbSort(SortPattern(*absorbedSortSpec, pExpCtx)));
+    }
     return pGroup;
 }
 
@@ -510,115 +743,139 @@ private:
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
-    const size_t numAccumulators = _accumulatedFields.size();
-
     // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
     GetNextResult input = pSource->getNext();
 
     for (; input.isAdvanced(); input = pSource->getNext()) {
-        if (_memoryTracker.shouldSpillWithAttemptToSaveMemory([this]() { return freeMemory(); })) {
-            _sortedFiles.push_back(spill());
-        }
-
         // We release the result document here so that it does not outlive the end of this loop
         // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
-        Value id = computeId(rootDocument);
-
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
+        addToGroupsMap(computeId(rootDocument), rootDocument);
+    }
 
-        if (inserted) {
-            _memoryTracker.memoryUsageBytes += id.getApproximateSize();
+    switch (input.getStatus()) {
+        case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
+            MONGO_UNREACHABLE;  // We consumed all advances above.
+        }
+        case DocumentSource::GetNextResult::ReturnStatus::kPauseExecution: {
+            return input;  // Propagate pause.
+        }
+        case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
+            readyGroupsForOutput();
 
-            // Initialize and add the accumulators
-            Value expandedId = expandId(id);
-            Document idDoc =
-                expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                auto accum = accumulatedField.makeAccumulator();
-                Value initializerValue =
-                    accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
-                accum->startNewGroup(initializerValue);
-                group.push_back(accum);
-            }
-        } else {
-            for (auto&& groupObj : group) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryTracker.memoryUsageBytes -= groupObj->memUsageForSorter();
-            }
+            // This must happen last so that, unless control gets here, we will re-enter
+            // initialization after getting a GetNextResult::ResultState::kPauseExecution.
+            _initialized = true;
+            return input;
         }
+    }
+    MONGO_UNREACHABLE;
+}
 
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
+void DocumentSourceGroup::addToGroupsMap(const Value& id, const Document& root) {
+    const size_t numAccumulators = _accumulatedFields.size();
 
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(
-                _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
-                _doingMerge);
+    if (_memoryTracker.shouldSpillWithAttemptToSaveMemory([this]() { return freeMemory(); })) {
+        _sortedFiles.push_back(spill());
+    }
 
-            _memoryTracker.memoryUsageBytes += group[i]->memUsageForSorter();
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+    // looking it up in '_groups' multiple times.
+    const size_t oldSize = _groups->size();
+    vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
+    const bool inserted = _groups->size() != oldSize;
+
+    if (inserted) {
+        _memoryTracker.memoryUsageBytes += id.getApproximateSize();
+
+        // Initialize and add the accumulators
+        Value expandedId = expandId(id);
+        Document idDoc =
+            expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+        group.reserve(numAccumulators);
+        for (auto&& accumulatedField : _accumulatedFields) {
+            auto accum = accumulatedField.makeAccumulator();
+            Value initializerValue =
+                accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
+            accum->startNewGroup(initializerValue);
+            group.push_back(accum);
+        }
+    } else {
+        for (auto&& groupObj : group) {
+            // subtract old mem usage. New usage added back after processing.
+            _memoryTracker.memoryUsageBytes -= groupObj->memUsageForSorter();
         }
+    }
 
-        if (kDebugBuild && !storageGlobalParams.readOnly) {
-            // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&                     // is a dup
-                !pExpCtx->inMongos &&            // can't spill to disk in mongos
-                !_memoryTracker.allowDiskUse &&  // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {      // don't open too many FDs
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
 
-                _sortedFiles.push_back(spill());
-            }
-        }
+    auto arguments = evaluateAccumulatorArguments(root);
+    for (size_t i = 0; i < numAccumulators; i++) {
+        group[i]->process(arguments[i], _doingMerge);
+
+        _memoryTracker.memoryUsageBytes += group[i]->memUsageForSorter();
     }
 
-    switch (input.getStatus()) {
-        case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
-            MONGO_UNREACHABLE;  // We consumed all advances above.
-        }
-        case DocumentSource::GetNextResult::ReturnStatus::kPauseExecution: {
-            return input;  // Propagate pause.
+    if (kDebugBuild && !storageGlobalParams.readOnly) {
+        // In debug mode, spill every time we have a duplicate id to stress merge logic.
+        if (!inserted &&                     // is a dup
+            !pExpCtx->inMongos &&            // can't spill to disk in mongos
+            !_memoryTracker.allowDiskUse &&  // don't change behavior when testing external sort
+            _sortedFiles.size() < 20) {      // don't open too many FDs
+
+            _sortedFiles.push_back(spill());
         }
-        case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
-            // Do any final steps necessary to prepare to output results.
-            if (!_sortedFiles.empty()) {
-                _spilled = true;
-                if (!_groups->empty()) {
-                    _sortedFiles.push_back(spill());
-                }
+    }
+}
+
+std::vector<Value> DocumentSourceGroup::evaluateAccumulatorArguments(const Document& root) const {
+    std::vector<Value> arguments;
+    arguments.reserve(_accumulatedFields.size());
+    for (auto&& accumulatedField : _accumulatedFields) {
+        arguments.push_back(
+            accumulatedField.expr.argument->evaluateMaybeCompiled(root, &pExpCtx->variables));
+    }
 
-                // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    if (_absorbedSortKeyGen && !arguments.empty()) {
+        // The sort key is shared by all the accumulators, so it is only generated once.
+        Value sortKey = _absorbedSortKeyGen->computeSortKeyFromDocument(root);
+        for (auto&& argument : arguments) {
+            argument = argument.missing() ? Value(std::vector<Value>{sortKey})
+                                          : Value(std::vector<Value>{sortKey, std::move(argument)});
+        }
+    }
+    return arguments;
+}
 
-                _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
-                    _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
-                _ownsFileDeletion = false;
+void DocumentSourceGroup::readyGroupsForOutput() {
+    // Do any final steps necessary to prepare to output results.
+    if (!_sortedFiles.empty()) {
+        _spilled = true;
+        if (!_groups->empty()) {
+            _sortedFiles.push_back(spill());
+        }
 
-                // prepare current to accumulate data
-                _currentAccumulators.reserve(numAccumulators);
-                for (auto&& accumulatedField : _accumulatedFields) {
-                    _currentAccumulators.push_back(accumulatedField.makeAccumulator());
-                }
+        // We won't be using groups again so free its memory.
+        _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
 
-                verify(_sorterIterator->more());  // we put data in, we should get something out.
-                _firstPartOfNextGroup = _sorterIterator->next();
-            } else {
-                // start the group iterator
-                groupsIterator = _groups->begin();
-            }
+        _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
+            _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
+        _ownsFileDeletion = false;
 
-            // This must happen last so that, unless control gets here, we will re-enter
-            // initialization after getting a GetNextResult::ResultState::kPauseExecution.
-            _initialized = true;
-            return input;
+        // prepare current to accumulate data
+        _currentAccumulators.reserve(_accumulatedFields.size());
+        for (auto&& accumulatedField : _accumulatedFields) {
+            _currentAccumulators.push_back(accumulatedField.makeAccumulator());
         }
+
+        verify(_sorterIterator->more());  // we put data in, we should get something out.
+        _firstPartOfNextGroup = _sorterIterator->next();
+    } else {
+        // start the group iterator
+        groupsIterator = _groups->begin();
     }
-    MONGO_UNREACHABLE;
 }
 
 bool DocumentSourceGroup::usedDisk() {
@@ -676,7 +933,7 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
 Value DocumentSourceGroup::computeId(const Document& root) {
     // If only one expression, return result directly
     if (_idExpressions.size() == 1) {
-        Value retValue = _idExpressions[0]->evaluate(root, &pExpCtx->variables);
+        Value retValue = _idExpressions[0]->evaluateMaybeCompiled(root, &pExpCtx->variables);
         return retValue.missing() ? Value(BSONNULL) : std::move(retValue);
     }
 
@@ -684,7 +941,7 @@ Value DocumentSourceGroup::computeId(const Document& root) {
     vector<Value> vals;
     vals.reserve(_idExpressions.size());
     for (size_t i = 0; i < _idExpressions.size(); i++) {
-        vals.push_back(_idExpressions[i]->evaluate(root, &pExpCtx->variables));
+        vals.push_back(_idExpressions[i]->evaluateMaybeCompiled(root, &pExpCtx->variables));
     }
     return Value(std::move(vals));
 }
@@ -734,6 +991,7 @@ Document DocumentSourceGroup::makeDocument(const Value& id,
 boost::optional<DocumentSource::DistributedPlanLogic> DocumentSourceGroup::distributedPlanLogic() {
     intrusive_ptr<DocumentSourceGroup> mergingGroup(new DocumentSourceGroup(pExpCtx));
     mergingGroup->setDoingMerge(true);
+    mergingGroup->setEmitPartials(_emitPartials);
 
     VariablesParseState vps = pExpCtx->variablesParseState;
     /* the merger will use the same grouping key */
@@ -797,6 +1055,12 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
         return nullptr;
     }
 
+    if (_absorbedSortPattern) {
+        // The $first accumulators depend on a sort order which the first document of each group in
+        // the input does not follow.
+        return nullptr;
+    }
+
     auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(_idExpressions.front().get());
     if (!fieldPathExpr || !fieldPathExpr->isRootFieldPath()) {
         return nullptr;
@@ -32,10 +32,12 @@
 #include <memory>
 #include <utility>
 
+#include "mongo/db/index/sort_key_generator.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/transformer_interface.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
@@ -156,6 +158,49 @@ public:
         _doingMerge = doingMerge;
     }
 
+    /**
+     * Returns true if this $group stage outputs the mergeable partial states of its accumulators,
+     * as if its results were to be merged by a later $group, even when not running on a shard.
+     */
+    bool emitPartials() const {
+        return _emitPartials;
+    }
+
+    void setEmitPartials(bool emitPartials) {
+        _emitPartials = emitPartials;
+    }
+
+    /**
+     * Informs this stage that its input will arrive ordered by 'sortPattern'. If every group key is
+     * a plain field path and together they form a prefix of 'sortPattern', the stage switches to
+     * streaming mode: each group is returned as soon as a document with a different key arrives,
+     * rather than after the whole input has been collected into the hash table.
+     *
+     * Documents whose key contains an array, null or missing value do not necessarily sort next to
+     * the other members of their group, so they are still collected in the hash table and their
+     * groups are returned once the streamed groups are exhausted.
+     */
+    void setInputSortedBy(const SortPattern& sortPattern);
+
+    /**
+     * Returns true if this $group stage returns its groups as it reads its sorted input.
+     */
+    bool streaming() const {
+        return _streaming;
+    }
+
+    /**
+     * Makes this stage compute its $first and $last accumulators as if its input were ordered by
+     * 'sortPattern', so that a $sort directly before it can be dropped. Rather than sorting the
+     * whole input, each group keeps the value of the document whose sort key comes first (or last)
+     * under 'sortPattern'.
+     *
+     * Returns false and leaves the stage unchanged if that is not possible: if any accumulator
+     * other than $first or $last is present, if the sort pattern has a $meta component, or if this
+     * stage produces or consumes partial results.
+     */
+    bool absorbSort(const SortPattern& sortPattern);
+
     /**
      * Returns true if this $group stage used disk during execution and false otherwise.
      */
@@ -195,6 +240,10 @@ private:
         const bool allowDiskUse;
         const size_t maxMemoryUsageBytes;
         size_t memoryUsageBytes = 0;
+
+        // Accounts for 'memoryUsageBytes' in the memory used by the blocking stages of all
+        // queries.
+        QueryMemoryReservation memoryReservation;
     };
 
     explicit DocumentSourceGroup(const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
@@ -211,10 +260,24 @@ private:
     GetNextResult getNextStandard();
 
     /**
-     * Before returning anything, this source must prepare itself. In a streaming $group,
-     * initialize() requests the first document from the previous source, and uses it to prepare the
-     * accumulators. In an unsorted $group, initialize() exhausts the previous source before
-     * returning. The '_initialized' boolean indicates that initialize() has finished.
+     * Reads from 'pSource' until the key of the group in '_streamingAccumulators' changes, then
+     * returns that group. Documents which cannot be streamed are added to '_groups' instead. Once
+     * 'pSource' is exhausted this returns the last streamed group, prepares '_groups' for output
+     * and marks the stage initialized, after which getNext() carries on as an unsorted $group.
+     */
+    GetNextResult getNextStreaming();
+
+    /**
+     * Hands the arguments buffered in '_streamingArguments' to the matching accumulators of the
+     * current streamed group as one batch each.
+     */
+    void flushStreamingArguments();
+
+    /**
+     * Before returning anything, this source must prepare itself. In an unsorted $group,
+     * initialize() exhausts the previous source before returning. The '_initialized' boolean
+     * indicates that initialize() has finished. A streaming $group is initialized by
+     * getNextStreaming() when its input runs out.
      *
      * This method may not be able to finish initialization in a single call if 'pSource' returns a
      * DocumentSource::GetNextResult::kPauseExecution, so it returns the last GetNextResult
@@ -222,6 +285,30 @@ private:
      */
     GetNextResult initialize();
 
+    /**
+     * Adds 'root' to the group with key 'id' in '_groups', creating the group if needed and
+     * spilling '_groups' to disk if it has grown too large.
+     */
+    void addToGroupsMap(const Value& id, const Document& root);
+
+    /**
+     * Called once the input is exhausted to set up either the merge of the spilled groups or the
+     * iteration over '_groups'.
+     */
+    void readyGroupsForOutput();
+
+    /**
+     * Evaluates the argument of every accumulator for 'root'. If a $sort has been absorbed, the
+     * values are paired with the sort key of 'root'.
+     */
+    std::vector<Value> evaluateAccumulatorArguments(const Document& root) const;
+
+    /**
+     * Returns true if a document with group key 'id' is guaranteed to sort next to the other
+     * members of its group, that is if no component of the key is an array, null or missing.
+     */
+    bool canStreamId(const Value& id) const;
+
     /**
      * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
      * does not exhaust the previous stage before returning, and thus does not maintain as large a
@@ -257,6 +344,12 @@ private:
 
     bool _usedDisk;  // Keeps track of whether this $group spilled to disk.
     bool _doingMerge;
+    bool _emitPartials = false;
+    bool _streaming = false;
+
+    // Set when a preceding $sort has been folded into this stage by absorbSort().
+    boost::optional<SortPattern> _absorbedSortPattern;
+    boost::optional<SortKeyGenerator> _absorbedSortKeyGen;
 
     MemoryUsageTracker _memoryTracker;
 
@@ -287,6 +380,16 @@ private:
     std::unique_ptr<Sorter<Value, Value>::Iterator> _sorterIterator;
 
     std::pair<Value, Value> _firstPartOfNextGroup;
+
+    // Only used when '_streaming' is true. Holds the key and the accumulators of the group which is
+    // currently being read from the sorted input, if any.
+    Value _streamingId;
+    Accumulators _streamingAccumulators;
+    bool _streamingGroupStarted = false;
+
+    // The evaluated arguments of each of '_streamingAccumulators' which have not been processed
+    // yet, so that runs of them can be processed as one batch.
+    std::vector<std::vector<Value>> _streamingArguments;
 };
 
 }  // namespace mongo
@@ -47,6 +47,7 @@
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/query_test_service_context.h"
@@ -244,6 +245,64 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldEmitPartialsWhichAMergingGroupCanCombine) {
+    auto expCtx = getExpCtx();
+    auto partialGroup = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$k', avg: {$avg: '$x'}, $emitPartials: true}}").firstElement(),
+        expCtx);
+    auto partialMock = DocumentSourceMock::createForTest(
+        {Document{{"k", 1}, {"x", 2}}, Document{{"k", 1}, {"x", 4}}}, expCtx);
+    partialGroup->setSource(partialMock.get());
+
+    auto next = partialGroup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto partial = next.releaseDocument();
+    ASSERT_VALUE_EQ(partial["avg"]["count"], Value(2LL));
+    ASSERT_VALUE_EQ(partial["avg"]["subTotal"], Value(6.0));
+    ASSERT_TRUE(partialGroup->getNext().isEOF());
+
+    // Merge the partial state with one which was previously emitted for the same group.
+    auto mergingGroup = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$_id', avg: {$avg: '$avg'}, $doingMerge: true}}").firstElement(),
+        expCtx);
+    auto previousPartial =
+        Document{{"_id", 1}, {"avg", Value(Document{{"subTotal", 9.0}, {"count", 2LL}})}};
+    auto mergingMock = DocumentSourceMock::createForTest(
+        {std::move(partial), std::move(previousPartial)}, expCtx);
+    mergingGroup->setSource(mergingMock.get());
+
+    auto merged = mergingGroup->getNext();
+    ASSERT_TRUE(merged.isAdvanced());
+    ASSERT_DOCUMENT_EQ(merged.getDocument(), (Document{{"_id", 1}, {"avg", 3.75}}));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldKeepEmittingPartialsWhenSplitForShards) {
+    auto expCtx = getExpCtx();
+    auto group = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$k', total: {$sum: '$x'}, $emitPartials: true}}").firstElement(),
+        expCtx);
+
+    vector<Value> serialized;
+    group->serializeToArray(serialized);
+    ASSERT_VALUE_EQ(serialized[0]["$group"]["$emitPartials"], Value(true));
+
+    auto distributedPlanLogic = group->distributedPlanLogic();
+    ASSERT(distributedPlanLogic);
+    auto mergingGroup =
+        dynamic_cast<DocumentSourceGroup*>(distributedPlanLogic->mergingStage.get());
+    ASSERT(mergingGroup);
+    ASSERT_TRUE(mergingGroup->doingMerge());
+    ASSERT_TRUE(mergingGroup->emitPartials());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldRejectFalseEmitPartials) {
+    ASSERT_THROWS_CODE(
+        DocumentSourceGroup::createFromBson(
+            fromjson("{$group: {_id: '$k', $emitPartials: false}}").firstElement(), getExpCtx()),
+        AssertionException,
+        5843105);
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -251,6 +310,236 @@ BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     return arr[0].getDocument().toBson();
 }
 
+intrusive_ptr<DocumentSourceGroup> parseGroup(const char* spec,
+                                              const intrusive_ptr<ExpressionContext>& expCtx) {
+    auto group = dynamic_cast<DocumentSourceGroup*>(
+        DocumentSourceGroup::createFromBson(fromjson(spec).firstElement(), expCtx).get());
+    ASSERT(group);
+    return group;
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldStreamGroupsWhenInputIsSortedByGroupKey) {
+    auto expCtx = getExpCtx();
+    auto group = parseGroup("{$group: {_id: '$a', total: {$sum: '$x'}}}", expCtx);
+    group->setInputSortedBy(SortPattern(fromjson("{a: 1, b: -1}"), expCtx));
+    ASSERT_TRUE(group->streaming());
+
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 1}, {"x", 1}},
+                                           Document{{"a", 1}, {"x", 2}},
+                                           Document{{"a", 2}, {"x", 3}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 3}, {"x", 4}}},
+                                          expCtx);
+    group->setSource(mock.get());
+
+    // Each group is returned as soon as the first document of the next group has been read, so
+    // the first group is returned before the input pauses.
+    auto next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 1}, {"total", 3}}));
+
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 2}, {"total", 3}}));
+
+    next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 3}, {"total", 4}}));
+
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReturnUnstreamableGroupsAfterStreamedGroups) {
+    auto expCtx = getExpCtx();
+    auto group = parseGroup("{$group: {_id: '$a', total: {$sum: '$x'}}}", expCtx);
+    group->setInputSortedBy(SortPattern(fromjson("{a: 1}"), expCtx));
+    ASSERT_TRUE(group->streaming());
+
+    // Null and missing keys share a group, and an array key sorts by its smallest element, so
+    // neither is guaranteed to arrive next to the other members of its group.
+    auto mock = DocumentSourceMock::createForTest(
+        {Document{{"a", BSONNULL}, {"x", 1}},
+         Document{{"x", 2}},
+         Document{{"a", BSON_ARRAY(1 << 2)}, {"x", 4}},
+         Document{{"a", 1}, {"x", 8}},
+         Document{{"a", BSON_ARRAY(1 << 2)}, {"x", 16}},
+         Document{{"a", 2}, {"x", 32}}},
+        expCtx);
+    group->setSource(mock.get());
+
+    auto next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 1}, {"total", 8}}));
+
+    next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 2}, {"total", 32}}));
+
+    vector<Document> unstreamed;
+    for (next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+        unstreamed.push_back(next.releaseDocument());
+    }
+    ASSERT_TRUE(next.isEOF());
+    ASSERT_EQ(unstreamed.size(), 2UL);
+    std::sort(unstreamed.begin(), unstreamed.end(), [](auto&& lhs, auto&& rhs) {
+        return lhs["total"].coerceToInt() < rhs["total"].coerceToInt();
+    });
+    ASSERT_DOCUMENT_EQ(unstreamed[0], (Document{{"_id", BSONNULL}, {"total", 3}}));
+    ASSERT_DOCUMENT_EQ(unstreamed[1], (Document{{"_id", BSON_ARRAY(1 << 2)}, {"total", 20}}));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldOnlyStreamWhenGroupKeysArePrefixOfSortPattern) {
+    auto expCtx = getExpCtx();
+    SortPattern sortPattern(fromjson("{a: 1, b: 1, c: 1}"), expCtx);
+
+    auto group = parseGroup("{$group: {_id: {y: '$b', x: '$a'}}}", expCtx);
+    group->setInputSortedBy(sortPattern);
+    ASSERT_TRUE(group->streaming());
+
+    group = parseGroup("{$group: {_id: {x: '$a', z: '$c'}}}", expCtx);
+    group->setInputSortedBy(sortPattern);
+    ASSERT_FALSE(group->streaming());
+
+    group = parseGroup("{$group: {_id: '$b'}}", expCtx);
+    group->setInputSortedBy(sortPattern);
+    ASSERT_FALSE(group->streaming());
+
+    group = parseGroup("{$group: {_id: {$toLower: '$a'}}}", expCtx);
+    group->setInputSortedBy(sortPattern);
+    ASSERT_FALSE(group->streaming());
+
+    group = parseGroup("{$group: {_id: null}}", expCtx);
+    group->setInputSortedBy(sortPattern);
+    ASSERT_FALSE(group->streaming());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldStreamWhenDirectlyAfterSortOnGroupKey) {
+    auto expCtx = getExpCtx();
+    auto sort = DocumentSourceSort::create(expCtx, BSON("a" << 1));
+    auto group = parseGroup("{$group: {_id: '$a', total: {$sum: '$x'}}}", expCtx);
+
+    Pipeline::SourceContainer container{sort, group};
+    sort->optimizeAt(container.begin(), &container);
+    ASSERT_TRUE(group->streaming());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldComputeFirstAndLastInAbsorbedSortOrder) {
+    auto expCtx = getExpCtx();
+    auto group = parseGroup(
+        "{$group: {_id: '$k', first: {$first: '$v'}, last: {$last: '$v'}, missing: {$last: '$x'}}}",
+        expCtx);
+    ASSERT_TRUE(group->absorbSort(SortPattern(fromjson("{t: -1}"), expCtx)));
+
+    auto mock = DocumentSourceMock::createForTest({Document{{"k", 1}, {"t", 2}, {"v", "b"_sd}},
+                                                   Document{{"k", 1}, {"t", 3}, {"v", "a"_sd}},
+                                                   Document{{"k", 1}, {"t", 1}, {"v", "c"_sd}},
+                                                   Document{{"k", 1}, {"t", 1}, {"v", "d"_sd}},
+                                                   Document{{"k", 1}, {"t", 3}, {"v", "e"_sd}}},
+                                                  expCtx);
+    group->setSource(mock.get());
+
+    // Ties are broken by input order, as if a stable sort had been applied first.
+    auto next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"_id", 1}, {"first", "a"_sd}, {"last", "d"_sd}, {"missing", BSONNULL}}));
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldKeepAbsorbedSortOrderWhenSpilling) {
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    auto parseAccumulator = [&](StringData name, StringData fieldName, StringData argument) {
+        auto arg = BSON("" << argument);
+        auto accExpr = AccumulationStatement::getParser(name, boost::none)(
+            expCtx.get(), arg.firstElement(), expCtx->variablesParseState);
+        return AccumulationStatement{fieldName.toString(), accExpr};
+    };
+    auto group = DocumentSourceGroup::create(
+        expCtx,
+        ExpressionFieldPath::parse(expCtx.get(), "$k", expCtx->variablesParseState),
+        {parseAccumulator("$first", "first", "$v"), parseAccumulator("$last", "last", "$t")},
+        maxMemoryUsageBytes);
+    ASSERT_TRUE(group->absorbSort(SortPattern(fromjson("{t: 1}"), expCtx)));
+
+    // Every group holds a value larger than the memory limit, so the groups are spilled as they
+    // are updated and have to be merged back together.
+    string largeStr(maxMemoryUsageBytes, 'x');
+    std::deque<DocumentSource::GetNextResult> input;
+    for (int t : {5, 3, 8, 1, 9, 2}) {
+        input.push_back(Document{{"k", t % 2}, {"t", t}, {"v", largeStr + std::to_string(t)}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(input), expCtx);
+    group->setSource(mock.get());
+
+    map<int, Document> results;
+    for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+        auto doc = next.releaseDocument();
+        results.emplace(doc["_id"].coerceToInt(), doc);
+    }
+    ASSERT_TRUE(group->usedDisk());
+    ASSERT_EQ(results.size(), 2UL);
+    ASSERT_DOCUMENT_EQ(results[0],
+                       (Document{{"_id", 0}, {"first", largeStr + "2"}, {"last", 8}}));
+    ASSERT_DOCUMENT_EQ(results[1],
+                       (Document{{"_id", 1}, {"first", largeStr + "1"}, {"last", 9}}));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldOnlyAbsorbSortForFirstAndLastAccumulators) {
+    auto expCtx = getExpCtx();
+    SortPattern sortPattern(fromjson("{t: 1}"), expCtx);
+
+    ASSERT_FALSE(parseGroup("{$group: {_id: '$k', first: {$first: '$v'}, n: {$sum: 1}}}", expCtx)
+                     ->absorbSort(sortPattern));
+    ASSERT_FALSE(parseGroup("{$group: {_id: '$k', first: {$first: '$v'}, $emitPartials: true}}",
+                            expCtx)
+                     ->absorbSort(sortPattern));
+    ASSERT_FALSE(parseGroup("{$group: {_id: '$k', first: {$first: '$v'}}}", expCtx)
+                     ->absorbSort(SortPattern(fromjson("{s: {$meta: 'textScore'}}"), expCtx)));
+
+    auto group = parseGroup("{$group: {_id: '$k', first: {$first: '$v'}}}", expCtx);
+    ASSERT_TRUE(group->absorbSort(sortPattern));
+    ASSERT_FALSE(group->absorbSort(sortPattern));
+    ASSERT_FALSE(group->rewriteGroupAsTransformOnFirstDocument());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldSerializeAndDependOnAbsorbedSort) {
+    auto expCtx = getExpCtx();
+    auto group = parseGroup("{$group: {_id: '$k', first: {$first: '$v'}}}", expCtx);
+    ASSERT_TRUE(group->absorbSort(SortPattern(fromjson("{t: 1, 'u.w': -1}"), expCtx)));
+
+    DepsTracker deps;
+    group->getDependencies(&deps);
+    ASSERT_EQ(deps.fields.size(), 4UL);
+    for (auto&& field : {"k", "t", "u.w", "v"}) {
+        ASSERT_EQ(deps.fields.count(field), 1UL);
+    }
+
+    auto serialized = toBson(group);
+    ASSERT_BSONOBJ_EQ(serialized,
+                      fromjson("{$group: {_id: '$k', first: {$first: '$v'}, "
+                               "$_internalSortBy: {t: 1, 'u.w': -1}}}"));
+    auto reparsed = DocumentSourceGroup::createFromBson(serialized.firstElement(), expCtx);
+    ASSERT_BSONOBJ_EQ(toBson(reparsed), serialized);
+
+    ASSERT_THROWS_CODE(
+        DocumentSourceGroup::createFromBson(
+            fromjson("{$group: {_id: '$k', n: {$sum: 1}, $_internalSortBy: {t: 1}}}")
+                .firstElement(),
+            expCtx),
+        AssertionException,
+        5843107);
+}
+
 class Base : public ServiceContextTest {
 public:
     Base()
@@ -0,0 +1,379 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+
+#include <algorithm>
+#include <string>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_path.h"
+#include "mongo/db/pipeline/dependencies.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(_internalUnpackBucket,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalUnpackBucket::createFromBson);
+
+constexpr StringData DocumentSourceInternalUnpackBucket::kStageName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kTimeFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kMetaFieldName;
+
+namespace {
+
+/**
+ * Returns true if every node of 'expr' is a logical node or applies to a full path, so that the
+ * paths of 'expr' can be renamed by renaming each path node.
+ */
+bool hasOnlyRenameablePaths(const MatchExpression& expr) {
+    switch (expr.getCategory()) {
+        case MatchExpression::MatchCategory::kLeaf:
+        case MatchExpression::MatchCategory::kArrayMatching:
+            // The children of an array matching node, like those of $elemMatch, have paths that
+            // are relative to the array, so only the node itself needs to be renamed.
+            return dynamic_cast<const PathMatchExpression*>(&expr) != nullptr;
+        case MatchExpression::MatchCategory::kLogical:
+            for (size_t i = 0; i < expr.numChildren(); ++i) {
+                if (!hasOnlyRenameablePaths(*expr.getChild(i))) {
+                    return false;
+                }
+            }
+            return true;
+        case MatchExpression::MatchCategory::kOther:
+            return false;
+    }
+    MONGO_UNREACHABLE;
+}
+
+void applyRenames(MatchExpression* expr, const StringMap<std::string>& renames) {
+    if (expr->getCategory() == MatchExpression::MatchCategory::kLogical) {
+        for (size_t i = 0; i < expr->numChildren(); ++i) {
+            applyRenames(expr->getChild(i), renames);
+        }
+        return;
+    }
+    checked_cast<PathMatchExpression*>(expr)->applyRename(renames);
+}
+
+/**
+ * Returns the top-level conjuncts of 'expr'.
+ */
+std::vector<const MatchExpression*> getConjuncts(const MatchExpression* expr) {
+    if (expr->matchType() != MatchExpression::AND) {
+        return {expr};
+    }
+    std::vector<const MatchExpression*> conjuncts;
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        conjuncts.push_back(expr->getChild(i));
+    }
+    return conjuncts;
+}
+
+boost::intrusive_ptr<DocumentSourceMatch> makeMatch(
+    const std::vector<std::unique_ptr<MatchExpression>>& conjuncts,
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    BSONArrayBuilder andBuilder;
+    for (const auto& expr : conjuncts) {
+        BSONObjBuilder exprBuilder(andBuilder.subobjStart());
+        expr->serialize(&exprBuilder);
+    }
+    return DocumentSourceMatch::create(BSON("$and" << andBuilder.arr()), expCtx);
+}
+
+/**
+ * Inserts 'match' ahead of 'itr' and returns where optimization should resume: at the stage before
+ * 'match', if any, so that 'match' can be combined with a preceding $match.
+ */
+Pipeline::SourceContainer::iterator insertMatchBefore(
+    Pipeline::SourceContainer::iterator itr,
+    Pipeline::SourceContainer* container,
+    boost::intrusive_ptr<DocumentSourceMatch> match) {
+    auto matchItr = container->insert(itr, std::move(match));
+    return matchItr == container->begin() ? matchItr : std::prev(matchItr);
+}
+
+}  // namespace
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBson(
+    BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    uassert(5843123,
+            str::stream() << kStageName << " must take a nested object but found: " << elem,
+            elem.type() == BSONType::Object);
+
+    boost::optional<std::string> timeField;
+    boost::optional<std::string> metaField;
+    for (auto&& option : elem.embeddedObject()) {
+        auto fieldName = option.fieldNameStringData();
+        if (fieldName == kTimeFieldName || fieldName == kMetaFieldName) {
+            uassert(5843124,
+                    str::stream() << kStageName << " '" << fieldName
+                                  << "' option must be a string but found: " << option,
+                    option.type() == BSONType::String);
+            (fieldName == kTimeFieldName ? timeField : metaField) = option.str();
+        } else {
+            uasserted(5843125,
+                      str::stream() << kStageName << " found an unrecognized option: " << option);
+        }
+    }
+    uassert(5843126,
+            str::stream() << kStageName << " requires a '" << kTimeFieldName << "' option",
+            timeField);
+    uassert(5843127,
+            str::stream() << kStageName << " '" << kTimeFieldName << "' and '" << kMetaFieldName
+                          << "' options must differ",
+            *timeField != metaField);
+
+    return new DocumentSourceInternalUnpackBucket(
+        expCtx, std::move(*timeField), std::move(metaField));
+}
+
+DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::string timeField,
+    boost::optional<std::string> metaField)
+    : DocumentSource(kStageName, expCtx),
+      _timeField(std::move(timeField)),
+      _metaField(std::move(metaField)) {}
+
+BSONElement DocumentSourceInternalUnpackBucket::Column::at(StringData position) {
+    if (it.more()) {
+        auto elem = *it;
+        if (elem.fieldNameStringData() == position) {
+            it.next();
+            return elem;
+        }
+    }
+    return values[position];
+}
+
+bool DocumentSourceInternalUnpackBucket::_resetBucket(BSONObj bucket) {
+    _bucket = bucket.getOwned();
+    _metaValue = _metaField ? _bucket[timeseries::kBucketMetaFieldName] : BSONElement();
+    _columns.clear();
+    _nextMeasurement = 0;
+
+    auto data = _bucket[timeseries::kBucketDataFieldName];
+    if (data.type() != BSONType::Object) {
+        return false;
+    }
+
+    // The columns are kept in the order in which they are stored, so that the measurements are
+    // rebuilt with their fields in insertion order.
+    bool hasTimeColumn = false;
+    for (auto&& column : data.embeddedObject()) {
+        if (column.type() != BSONType::Object) {
+            continue;
+        }
+        if (column.fieldNameStringData() == _timeField) {
+            _timeColumn = _columns.size();
+            hasTimeColumn = true;
+        }
+        _columns.emplace_back(column);
+    }
+    return hasTimeColumn;
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
+    while (true) {
+        if (!_bucketExhausted) {
+            // Every measurement has a time, so the time column decides when the bucket ends.
+            auto position = std::to_string(_nextMeasurement++);
+            if (auto time = _columns[_timeColumn].at(position)) {
+                MutableDocument measurement;
+                for (size_t i = 0; i < _columns.size(); ++i) {
+                    if (auto elem = i == _timeColumn ? time : _columns[i].at(position)) {
+                        measurement.addField(_columns[i].name, Value(elem));
+                    }
+                }
+                if (_metaValue) {
+                    measurement.addField(*_metaField, Value(_metaValue));
+                }
+                return measurement.freeze();
+            }
+            _bucketExhausted = true;
+        }
+
+        auto nextResult = pSource->getNext();
+        if (!nextResult.isAdvanced()) {
+            return nextResult;
+        }
+        _bucketExhausted = !_resetBucket(nextResult.getDocument().toBson());
+    }
+}
+
+std::pair<boost::intrusive_ptr<DocumentSourceMatch>, boost::intrusive_ptr<DocumentSourceMatch>>
+DocumentSourceInternalUnpackBucket::splitMatchOnMetaField(DocumentSourceMatch* match) const {
+    if (!_metaField) {
+        return {nullptr, nullptr};
+    }
+
+    auto dependsOnlyOnMetaField = [&](const MatchExpression& expr) {
+        if (!hasOnlyRenameablePaths(expr)) {
+            return false;
+        }
+        DepsTracker deps;
+        expr.addDependencies(&deps);
+        return !deps.needWholeDocument && !deps.fields.empty() &&
+            std::all_of(deps.fields.begin(), deps.fields.end(), [&](const auto& field) {
+                   return field == *_metaField || expression::isPathPrefixOf(*_metaField, field);
+               });
+    };
+
+    std::vector<std::unique_ptr<MatchExpression>> metaOnly;
+    std::vector<std::unique_ptr<MatchExpression>> remaining;
+    for (auto conjunct : getConjuncts(match->getMatchExpression())) {
+        if (dependsOnlyOnMetaField(*conjunct)) {
+            metaOnly.push_back(conjunct->shallowClone());
+            applyRenames(metaOnly.back().get(),
+                         {{*_metaField, timeseries::kBucketMetaFieldName.toString()}});
+        } else {
+            remaining.push_back(conjunct->shallowClone());
+        }
+    }
+
+    if (metaOnly.empty()) {
+        return {nullptr, nullptr};
+    }
+    return {makeMatch(metaOnly, pExpCtx),
+            remaining.empty() ? nullptr : makeMatch(remaining, pExpCtx)};
+}
+
+boost::intrusive_ptr<DocumentSourceMatch>
+DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelFields(
+    const MatchExpression* matchExpr) const {
+    const std::string minTime = str::stream() << timeseries::kBucketControlFieldName << "."
+                                              << timeseries::kControlMinFieldName << "."
+                                              << _timeField;
+    const std::string maxTime = str::stream() << timeseries::kBucketControlFieldName << "."
+                                              << timeseries::kControlMaxFieldName << "."
+                                              << _timeField;
+
+    BSONArrayBuilder andBuilder;
+    for (auto conjunct : getConjuncts(matchExpr)) {
+        auto comparison = dynamic_cast<const ComparisonMatchExpressionBase*>(conjunct);
+        if (!comparison || comparison->path() != _timeField ||
+            comparison->getData().type() != BSONType::Date) {
+            continue;
+        }
+
+        // Every measurement of a bucket has a time in [control.min, control.max], and the width of
+        // that range is bounded, so a lower bound on the time also bounds control.min from below.
+        // That lets an index on control.min answer both sides of a range on the time.
+        auto time = comparison->getData().date();
+        auto canBoundMinTime = time >= Date_t::min() + timeseries::kBucketMaxTimeRange;
+        auto earliestMinTime = canBoundMinTime ? time - timeseries::kBucketMaxTimeRange : time;
+        switch (conjunct->matchType()) {
+            case MatchExpression::EQ:
+                andBuilder.append(BSON(minTime << BSON("$lte" << time)));
+                andBuilder.append(BSON(maxTime << BSON("$gte" << time)));
+                if (canBoundMinTime) {
+                    andBuilder.append(BSON(minTime << BSON("$gte" << earliestMinTime)));
+                }
+                break;
+            case MatchExpression::GT:
+            case MatchExpression::GTE: {
+                auto op = conjunct->matchType() == MatchExpression::GT ? "$gt"_sd : "$gte"_sd;
+                andBuilder.append(BSON(maxTime << BSON(op << time)));
+                if (canBoundMinTime) {
+                    andBuilder.append(BSON(minTime << BSON(op << earliestMinTime)));
+                }
+                break;
+            }
+            case MatchExpression::LT:
+                andBuilder.append(BSON(minTime << BSON("$lt" << time)));
+                break;
+            case MatchExpression::LTE:
+                andBuilder.append(BSON(minTime << BSON("$lte" << time)));
+                break;
+            default:
+                break;
+        }
+    }
+
+    auto predicates = andBuilder.arr();
+    if (predicates.isEmpty()) {
+        return nullptr;
+    }
+    return DocumentSourceMatch::create(BSON("$and" << predicates), pExpCtx);
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    auto nextStage = std::next(itr);
+    if (nextStage == container->end()) {
+        return nextStage;
+    }
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>(nextStage->get());
+    if (!nextMatch) {
+        return nextStage;
+    }
+
+    // Predicates on the metaField alone select whole buckets, so they move ahead of the unpacking.
+    // Optimization restarts ahead of the moved $match so that it can be pushed down further.
+    auto [metaMatch, remainingMatch] = splitMatchOnMetaField(nextMatch);
+    if (metaMatch) {
+        if (remainingMatch) {
+            *nextStage = std::move(remainingMatch);
+        } else {
+            container->erase(nextStage);
+        }
+        return insertMatchBefore(itr, container, std::move(metaMatch));
+    }
+
+    // Predicates on the time are kept after the unpacking, but a looser version of them on the
+    // bucket's bounds is added ahead of it to skip the buckets which can't hold a match.
+    if (!_triedBucketLevelPredicatePushdown) {
+        _triedBucketLevelPredicatePushdown = true;
+        auto bucketMatch = createPredicatesOnBucketLevelFields(nextMatch->getMatchExpression());
+        if (bucketMatch) {
+            return insertMatchBefore(itr, container, std::move(bucketMatch));
+        }
+    }
+    return nextStage;
+}
+
+Value DocumentSourceInternalUnpackBucket::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    MutableDocument spec;
+    spec.addField(kTimeFieldName, Value(_timeField));
+    if (_metaField) {
+        spec.addField(kMetaFieldName, Value(*_metaField));
+    }
+    return Value(Document{{getSourceName(), spec.freezeToValue()}});
+}
+
+}  // namespace mongo
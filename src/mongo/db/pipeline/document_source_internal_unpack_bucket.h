@@ -0,0 +1,154 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_match.h"
+
+namespace mongo {
+
+/**
+ * Unpacks the buckets of a time-series collection back into the measurements they hold. Each input
+ * document is a bucket from a 'system.buckets' namespace; each output document is one measurement
+ * rebuilt from the bucket's 'data' columns, with the bucket's 'meta' value restored under the
+ * metaField. This stage backs the view which presents a time-series collection to users:
+ *
+ *   {$_internalUnpackBucket: {timeField: <string>, metaField: <string, optional>}}
+ *
+ * When followed by a $match, the stage rewrites the pipeline so that buckets are filtered before
+ * they are unpacked: predicates on the metaField alone are moved ahead of this stage and renamed to
+ * the bucket's 'meta' field, and predicates on the timeField are translated into predicates on the
+ * bucket's 'control.min' and 'control.max' bounds. The original $match is kept after this stage so
+ * the result is unchanged.
+ */
+class DocumentSourceInternalUnpackBucket final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalUnpackBucket"_sd;
+    static constexpr StringData kTimeFieldName = "timeField"_sd;
+    static constexpr StringData kMetaFieldName = "metaField"_sd;
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    DocumentSourceInternalUnpackBucket(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                       std::string timeField,
+                                       boost::optional<std::string> metaField);
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed,
+                LookupRequirement::kAllowed,
+                UnionRequirement::kAllowed};
+    }
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+    const std::string& getTimeField() const {
+        return _timeField;
+    }
+
+    const boost::optional<std::string>& getMetaField() const {
+        return _metaField;
+    }
+
+    /**
+     * Splits the predicates of 'match' which depend on only the metaField off of it, renaming them
+     * so that they apply to the 'meta' field of a bucket. Returns {nullptr, nullptr} when no such
+     * predicates exist; otherwise returns the renamed predicates and whatever remains of 'match',
+     * which is nullptr if nothing remains.
+     */
+    std::pair<boost::intrusive_ptr<DocumentSourceMatch>, boost::intrusive_ptr<DocumentSourceMatch>>
+    splitMatchOnMetaField(DocumentSourceMatch* match) const;
+
+    /**
+     * Returns a $match on the 'control' bounds of a bucket which passes every bucket that may hold
+     * a measurement matching the top-level time predicates of 'matchExpr', or nullptr if
+     * 'matchExpr' has no such predicates. The result never filters out a matching measurement, so
+     * 'matchExpr' must still be applied to the unpacked measurements.
+     */
+    boost::intrusive_ptr<DocumentSourceMatch> createPredicatesOnBucketLevelFields(
+        const MatchExpression* matchExpr) const;
+
+private:
+    /**
+     * Iterates over one column of a bucket's 'data'. Columns are usually stored in measurement
+     * order, so the next element is checked first, and a lookup by position is the fallback.
+     */
+    struct Column {
+        Column(BSONElement column) : name(column.fieldNameStringData()), values(column.Obj()) {}
+
+        BSONElement at(StringData position);
+
+        StringData name;
+        BSONObj values;
+        BSONObjIterator it{values};
+    };
+
+    GetNextResult doGetNext() final;
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
+    /**
+     * Starts unpacking 'bucket'. Returns false if the bucket doesn't hold any measurements.
+     */
+    bool _resetBucket(BSONObj bucket);
+
+    const std::string _timeField;
+    const boost::optional<std::string> _metaField;
+
+    // The bucket that is currently being unpacked and the iteration state in its columns. Every
+    // measurement has a value in the time column, at '_timeColumn' in '_columns'.
+    BSONObj _bucket;
+    BSONElement _metaValue;
+    std::vector<Column> _columns;
+    size_t _timeColumn = 0;
+    size_t _nextMeasurement = 0;
+    bool _bucketExhausted = true;
+
+    // Whether the bucket-level predicates for a following $match were already added, so that a
+    // second optimization pass doesn't add them again.
+    bool _triedBucketLevelPredicatePushdown = false;
+};
+
+}  // namespace mongo
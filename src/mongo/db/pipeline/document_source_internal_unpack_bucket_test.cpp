@@ -0,0 +1,216 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using DocumentSourceInternalUnpackBucketTest = AggregationContextFixture;
+
+boost::intrusive_ptr<DocumentSource> makeUnpack(
+    BSONObj spec, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    return DocumentSourceInternalUnpackBucket::createFromBson(
+        BSON(DocumentSourceInternalUnpackBucket::kStageName << spec).firstElement(), expCtx);
+}
+
+std::unique_ptr<Pipeline, PipelineDeleter> makeOptimizedPipeline(
+    const std::vector<BSONObj>& stages, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    auto pipeline = Pipeline::parse(stages, expCtx);
+    pipeline->optimizePipeline();
+    return pipeline;
+}
+
+bool matches(const boost::intrusive_ptr<DocumentSource>& stage, const BSONObj& doc) {
+    auto match = dynamic_cast<DocumentSourceMatch*>(stage.get());
+    ASSERT(match);
+    return match->getMatchExpression()->matchesBSON(doc);
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, UnpacksMeasurementsWithMeta) {
+    auto unpack = makeUnpack(fromjson("{timeField: 't', metaField: 'm'}"), getExpCtx());
+    auto mock = DocumentSourceMock::createForTest(
+        {"{meta: {host: 'a'}, data: {_id: {'0': 1, '1': 2}, t: {'0': 10, '1': 20}, x: {'1': 5}}}",
+         "{data: {t: {'0': 30}, _id: {'0': 3}}}"},
+        getExpCtx());
+    unpack->setSource(mock.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{_id: 1, t: 10, m: {host: 'a'}}")));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{_id: 2, t: 20, x: 5, m: {host: 'a'}}")));
+
+    // A bucket without a meta value yields measurements without the metaField.
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{t: 30, _id: 3}")));
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, UnpacksColumnsStoredOutOfOrder) {
+    auto unpack = makeUnpack(fromjson("{timeField: 't'}"), getExpCtx());
+    auto mock = DocumentSourceMock::createForTest(
+        {"{meta: 'ignored', data: {t: {'1': 20, '0': 10}, a: {'1': 'y', '0': 'x'}}}",
+         "{data: {}}",
+         "{data: {t: {'0': 30}}}"},
+        getExpCtx());
+    unpack->setSource(mock.get());
+
+    for (auto&& expected : {"{t: 10, a: 'x'}", "{t: 20, a: 'y'}", "{t: 30}"}) {
+        auto next = unpack->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson(expected)));
+    }
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, RejectsInvalidSpecs) {
+    ASSERT_THROWS_CODE(DocumentSourceInternalUnpackBucket::createFromBson(
+                           BSON(DocumentSourceInternalUnpackBucket::kStageName << 1).firstElement(),
+                           getExpCtx()),
+                       AssertionException,
+                       5843123);
+    ASSERT_THROWS_CODE(makeUnpack(fromjson("{timeField: 1}"), getExpCtx()),
+                       AssertionException,
+                       5843124);
+    ASSERT_THROWS_CODE(makeUnpack(fromjson("{timeField: 't', other: 'x'}"), getExpCtx()),
+                       AssertionException,
+                       5843125);
+    ASSERT_THROWS_CODE(
+        makeUnpack(fromjson("{metaField: 'm'}"), getExpCtx()), AssertionException, 5843126);
+    ASSERT_THROWS_CODE(makeUnpack(fromjson("{timeField: 't', metaField: 't'}"), getExpCtx()),
+                       AssertionException,
+                       5843127);
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, SerializesSpec) {
+    auto spec = BSON(DocumentSourceInternalUnpackBucket::kStageName
+                     << fromjson("{timeField: 't', metaField: 'm'}"));
+    auto pipeline = makeOptimizedPipeline({spec}, getExpCtx());
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(1U, serialized.size());
+    ASSERT_BSONOBJ_EQ(spec, serialized[0]);
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, MovesMetaPredicatesAheadOfUnpacking) {
+    auto pipeline = makeOptimizedPipeline(
+        {fromjson("{$_internalUnpackBucket: {timeField: 't', metaField: 'm'}}"),
+         fromjson("{$match: {'m.host': 'a', x: 1}}")},
+        getExpCtx());
+    const auto& sources = pipeline->getSources();
+    ASSERT_EQ(3U, sources.size());
+
+    // The predicate on the metaField applies to whole buckets, renamed to their 'meta' field.
+    auto bucketMatch = sources.front();
+    ASSERT_TRUE(matches(bucketMatch, fromjson("{meta: {host: 'a'}}")));
+    ASSERT_FALSE(matches(bucketMatch, fromjson("{meta: {host: 'b'}}")));
+    ASSERT_FALSE(matches(bucketMatch, fromjson("{m: {host: 'a'}}")));
+
+    ASSERT(dynamic_cast<DocumentSourceInternalUnpackBucket*>(std::next(sources.begin())->get()));
+
+    auto measurementMatch = sources.back();
+    ASSERT_TRUE(matches(measurementMatch, fromjson("{x: 1}")));
+    ASSERT_FALSE(matches(measurementMatch, fromjson("{x: 2}")));
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, MovesWholeMatchOnMetaField) {
+    auto pipeline = makeOptimizedPipeline(
+        {fromjson("{$_internalUnpackBucket: {timeField: 't', metaField: 'm'}}"),
+         fromjson("{$match: {$or: [{m: 1}, {'m.a': {$gt: 2}}]}}")},
+        getExpCtx());
+    const auto& sources = pipeline->getSources();
+    ASSERT_EQ(2U, sources.size());
+    ASSERT_TRUE(matches(sources.front(), fromjson("{meta: 1}")));
+    ASSERT_TRUE(matches(sources.front(), fromjson("{meta: {a: 3}}")));
+    ASSERT_FALSE(matches(sources.front(), fromjson("{meta: {a: 2}}")));
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, KeepsPredicatesMixingMetaAndOtherFields) {
+    auto pipeline = makeOptimizedPipeline(
+        {fromjson("{$_internalUnpackBucket: {timeField: 't', metaField: 'm'}}"),
+         fromjson("{$match: {$or: [{m: 1}, {x: 1}]}}")},
+        getExpCtx());
+    const auto& sources = pipeline->getSources();
+    ASSERT_EQ(2U, sources.size());
+    ASSERT(dynamic_cast<DocumentSourceInternalUnpackBucket*>(sources.front().get()));
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, AddsBucketBoundsForTimePredicates) {
+    auto pipeline = makeOptimizedPipeline(
+        {fromjson("{$_internalUnpackBucket: {timeField: 't'}}"),
+         fromjson("{$match: {t: {$gte: {$date: 10000000}, $lt: {$date: 20000000}}, x: 1}}")},
+        getExpCtx());
+    const auto& sources = pipeline->getSources();
+    ASSERT_EQ(3U, sources.size());
+
+    // Buckets need a maximum time no earlier than the lower bound, a minimum time earlier than
+    // the upper bound, and a minimum time within the bucket time range of the lower bound.
+    auto bucketMatch = sources.front();
+    ASSERT_TRUE(matches(bucketMatch,
+                        fromjson("{control: {min: {t: {$date: 9000000}}, "
+                                 "max: {t: {$date: 10000000}}}}")));
+    ASSERT_FALSE(matches(bucketMatch,
+                         fromjson("{control: {min: {t: {$date: 9000000}}, "
+                                  "max: {t: {$date: 9999999}}}}")));
+    ASSERT_FALSE(matches(bucketMatch,
+                         fromjson("{control: {min: {t: {$date: 20000000}}, "
+                                  "max: {t: {$date: 20000001}}}}")));
+    ASSERT_FALSE(matches(bucketMatch,
+                         fromjson("{control: {min: {t: {$date: 1000000}}, "
+                                  "max: {t: {$date: 10000000}}}}")));
+
+    // The original predicates still apply to the measurements.
+    auto measurementMatch = sources.back();
+    ASSERT_TRUE(matches(measurementMatch, fromjson("{t: {$date: 15000000}, x: 1}")));
+    ASSERT_FALSE(matches(measurementMatch, fromjson("{t: {$date: 25000000}, x: 1}")));
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, IgnoresTimePredicatesOnNonDates) {
+    auto pipeline =
+        makeOptimizedPipeline({fromjson("{$_internalUnpackBucket: {timeField: 't'}}"),
+                               fromjson("{$match: {t: {$gte: 5}}}")},
+                              getExpCtx());
+    ASSERT_EQ(2U, pipeline->getSources().size());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -31,13 +31,18 @@
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 
 #include "mongo/base/init.h"
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source_merge_gen.h"
 #include "mongo/db/pipeline/expression.h"
@@ -54,6 +59,19 @@ using std::vector;
 
 namespace {
 
+/**
+ * Returns true if 'path' has a numeric component, which a query may treat as an array position.
+ */
+bool hasPositionalComponent(const FieldPath& path) {
+    const FieldRef fieldRef{path.fullPath()};
+    for (FieldIndex i = 0; i < fieldRef.numParts(); ++i) {
+        if (fieldRef.isNumericPathComponentStrict(i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * Constructs a query of the following shape:
  *  {$or: [
@@ -274,22 +292,79 @@ StageConstraints DocumentSourceLookUp::constraints(Pipeline::SplitState) const {
     return constraints;
 }
 
+template <typename BuildFn>
+auto DocumentSourceLookUp::buildForeignPipeline(BuildFn&& buildFn) {
+    try {
+        return buildFn();
+    } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
+        // If lookup on a sharded collection is disallowed and the foreign collection is sharded,
+        // throw a custom exception.
+        if (auto staleInfo = ex.extraInfo<StaleConfigInfo>()) {
+            uassert(51069,
+                    "Cannot run $lookup with sharded foreign collection",
+                    foreignShardedLookupAllowed() || !staleInfo->getVersionWanted() ||
+                        staleInfo->getVersionWanted() == ChunkVersion::UNSHARDED());
+        }
+        throw;
+    }
+}
+
 DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     if (_unwindSrc) {
         return unwindResult();
     }
 
-    auto nextInput = pSource->getNext();
-    if (!nextInput.isAdvanced()) {
-        return nextInput;
-    }
-
-    auto inputDoc = nextInput.releaseDocument();
-
     // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
 
+    if (!_batchOutput.empty()) {
+        auto output = std::move(_batchOutput.front());
+        _batchOutput.pop_front();
+        return output;
+    }
+
+    while (!_sourceExhausted && _batchInput.size() < _batchSize) {
+        auto nextInput = pSource->getNext();
+        if (nextInput.isPaused()) {
+            return nextInput;
+        } else if (nextInput.isEOF()) {
+            _sourceExhausted = true;
+            break;
+        }
+        _batchInput.push_back(nextInput.releaseDocument());
+
+        if (!_hashJoinDecided) {
+            _hashJoinDecided = true;
+            buildForeignPipeline([&] { buildHashJoinTableIfEligible(); });
+            if (!_hashJoinTable && !wasConstructedWithPipelineSyntax() &&
+                !hasPositionalComponent(*_foreignField)) {
+                _batchSize = std::max(1, internalDocumentSourceLookupBatchSize.load());
+            }
+        }
+    }
+
+    if (_batchInput.empty()) {
+        return GetNextResult::makeEOF();
+    }
+
+    if (_batchInput.size() > 1) {
+        lookUpBatch();
+        auto output = std::move(_batchOutput.front());
+        _batchOutput.pop_front();
+        return output;
+    }
+
+    auto inputDoc = std::move(_batchInput.front());
+    _batchInput.clear();
+    return lookUpDocument(std::move(inputDoc));
+}
+
+Document DocumentSourceLookUp::lookUpDocument(Document inputDoc) {
+    if (_hashJoinTable) {
+        return joinWithHashJoinTable(std::move(inputDoc), *_hashJoinTable);
+    }
+
     if (!wasConstructedWithPipelineSyntax()) {
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
@@ -297,38 +372,83 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         _resolvedPipeline.back() = matchStage;
     }
 
-    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
-    try {
-        pipeline = buildPipeline(inputDoc);
-    } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
-        // If lookup on a sharded collection is disallowed and the foreign collection is sharded,
-        // throw a custom exception.
-        if (auto staleInfo = ex.extraInfo<StaleConfigInfo>()) {
-            uassert(51069,
-                    "Cannot run $lookup with sharded foreign collection",
-                    foreignShardedLookupAllowed() || !staleInfo->getVersionWanted() ||
-                        staleInfo->getVersionWanted() == ChunkVersion::UNSHARDED());
-        }
-        throw;
-    }
+    auto pipeline = buildForeignPipeline([&] { return buildPipeline(inputDoc); });
 
     std::vector<Value> results;
-    long long objsize = 0;
+    long long resultsSize = 0;
+    while (auto result = pipeline->getNext()) {
+        appendJoinedDocument(std::move(*result), &results, &resultsSize);
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+
+    MutableDocument output(std::move(inputDoc));
+    output.setNestedField(_as, Value(std::move(results)));
+    return output.freeze();
+}
+
+void DocumentSourceLookUp::appendJoinedDocument(Document&& result,
+                                                std::vector<Value>* results,
+                                                long long* resultsSize) const {
     const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    long long safeSum = 0;
+    bool hasOverflowed = overflow::add(*resultsSize, result.getApproximateSize(), &safeSum);
+    uassert(4568,
+            str::stream() << "Total size of documents in " << _fromNs.coll()
+                          << " matching pipeline's $lookup stage exceeds " << maxBytes << " bytes",
+
+            !hasOverflowed && *resultsSize <= maxBytes);
+    *resultsSize = safeSum;
+    results->emplace_back(std::move(result));
+}
 
-    while (auto result = pipeline->getNext()) {
-        long long safeSum = 0;
-        bool hasOverflowed = overflow::add(objsize, result->getApproximateSize(), &safeSum);
-        uassert(4568,
-                str::stream() << "Total size of documents in " << _fromNs.coll()
-                              << " matching pipeline's $lookup stage exceeds " << maxBytes
-                              << " bytes",
+void DocumentSourceLookUp::lookUpBatch() {
+    // Gather the distinct local values of the whole batch, so that one query against the foreign
+    // collection returns every document joining with any document of the batch.
+    std::vector<Value> localValues;
+    auto seen = _fromExpCtx->getValueComparator().makeUnorderedValueSet();
+    for (auto&& inputDoc : _batchInput) {
+        bool hasValue = false;
+        document_path_support::visitAllValuesAtPath(
+            inputDoc, *_localField, [&](const Value& nextValue) {
+                hasValue = true;
+                if (seen.insert(nextValue).second) {
+                    localValues.push_back(nextValue);
+                }
+            });
+        if (!hasValue && seen.insert(Value(BSONNULL)).second) {
+            // Missing values are treated as null.
+            localValues.emplace_back(BSONNULL);
+        }
+    }
 
-                !hasOverflowed && objsize <= maxBytes);
-        objsize = safeSum;
-        results.emplace_back(std::move(*result));
+    const FieldPath valuesPath("values");
+    _resolvedPipeline.back() =
+        makeMatchStageFromInput(Document{{valuesPath.fullPath(), Value(std::move(localValues))}},
+                                valuesPath,
+                                _foreignField->fullPath(),
+                                BSONObj());
+    auto pipeline = buildForeignPipeline([&] { return buildPipeline(Document()); });
+
+    // Hand the foreign documents back to each document of the batch through a hash table. If they
+    // do not fit in its memory budget, query the foreign collection for each document instead.
+    HashJoinTable table(_fromExpCtx->getValueComparator());
+    const bool filled = fillHashJoinTable(pipeline.get(), &table);
+
+    auto batch = std::move(_batchInput);
+    _batchInput.clear();
+    for (auto&& inputDoc : batch) {
+        _batchOutput.push_back(filled ? joinWithHashJoinTable(std::move(inputDoc), table)
+                                      : lookUpDocument(std::move(inputDoc)));
+    }
+}
+
+Document DocumentSourceLookUp::joinWithHashJoinTable(Document inputDoc,
+                                                     const HashJoinTable& table) const {
+    std::vector<Value> results;
+    long long resultsSize = 0;
+    for (auto pos : probeHashJoinTable(table, inputDoc)) {
+        appendJoinedDocument(Document(table.docs[pos]), &results, &resultsSize);
     }
-    _usedDisk = _usedDisk || pipeline->usedDisk();
 
     MutableDocument output(std::move(inputDoc));
     output.setNestedField(_as, Value(std::move(results)));
@@ -398,6 +518,124 @@ std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     return pipeline;
 }
 
+void DocumentSourceLookUp::buildHashJoinTableIfEligible() {
+    const auto maxForeignDocs = internalDocumentSourceLookupHashJoinMaxForeignDocs.load();
+    if (maxForeignDocs == 0 || wasConstructedWithPipelineSyntax() || _unwindSrc ||
+        pExpCtx->inMongos) {
+        return;
+    }
+
+    // The probe does not reproduce the query semantics of positional path components.
+    if (hasPositionalComponent(*_foreignField)) {
+        return;
+    }
+
+    // Only read the foreign collection up front if it is small. The record count is that of the
+    // underlying collection when '_fromNs' is a view.
+    BSONObjBuilder countBuilder;
+    if (!pExpCtx->mongoProcessInterface
+             ->appendRecordCount(pExpCtx->opCtx, _resolvedNs, &countBuilder)
+             .isOK()) {
+        return;
+    }
+    const auto count = countBuilder.obj()["count"];
+    if (!count.isNumber() || count.safeNumberLong() > maxForeignDocs) {
+        return;
+    }
+
+    // Read every foreign document, through the view pipeline if there is one.
+    _resolvedPipeline.back() = BSON("$match" << BSONObj());
+    auto pipeline = buildPipeline(Document());
+
+    HashJoinTable table(_fromExpCtx->getValueComparator());
+    if (fillHashJoinTable(pipeline.get(), &table)) {
+        _hashJoinTable.emplace(std::move(table));
+    }
+}
+
+bool DocumentSourceLookUp::fillHashJoinTable(Pipeline* pipeline, HashJoinTable* table) {
+    const auto maxBytes = internalDocumentSourceLookupHashJoinMaxMemoryBytes.load();
+    long long bytes = 0;
+    while (auto result = pipeline->getNext()) {
+        auto obj = result->toBson();
+        bytes += obj.objsize();
+        if (bytes > maxBytes) {
+            _usedDisk = _usedDisk || pipeline->usedDisk();
+            return false;
+        }
+
+        const size_t pos = table->docs.size();
+        BSONElementSet elems;
+        dotted_path_support::extractAllElementsAlongPath(obj, _foreignField->fullPath(), elems);
+        bool mayMatchNull = elems.empty();
+        for (auto&& elem : elems) {
+            Value value(elem);
+            if (value.nullish()) {
+                mayMatchNull = true;
+            } else {
+                table->buckets[value].push_back(pos);
+            }
+        }
+        if (mayMatchNull) {
+            table->nullCandidates.push_back(pos);
+        }
+        table->docs.push_back(std::move(obj));
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+    return true;
+}
+
+std::vector<size_t> DocumentSourceLookUp::probeHashJoinTable(const HashJoinTable& table,
+                                                             const Document& inputDoc) const {
+    std::vector<Value> localValues;
+    document_path_support::visitAllValuesAtPath(
+        inputDoc, *_localField, [&](const Value& nextValue) { localValues.push_back(nextValue); });
+    if (localValues.empty()) {
+        // Missing values are treated as null.
+        localValues.emplace_back(BSONNULL);
+    }
+
+    // Gather the documents which may join with 'inputDoc'. A local value that is itself an array
+    // may equal a whole foreign array rather than one of its elements, and a null may match a
+    // document missing a component of a dotted 'foreignField' inside an array, so both of these
+    // consider every foreign document.
+    std::vector<size_t> candidates;
+    bool considerAll = false;
+    for (auto&& value : localValues) {
+        if (value.getType() == BSONType::Array) {
+            considerAll = true;
+        } else if (value.nullish()) {
+            considerAll = considerAll || _foreignField->getPathLength() > 1;
+            candidates.insert(
+                candidates.end(), table.nullCandidates.begin(), table.nullCandidates.end());
+        } else if (auto it = table.buckets.find(value); it != table.buckets.end()) {
+            candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    if (considerAll) {
+        candidates.resize(table.docs.size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+    } else {
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+    // Check each candidate against the same filter the foreign query would have used.
+    const auto matchStage =
+        makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
+    const auto filter = uassertStatusOK(
+        MatchExpressionParser::parse(matchStage.firstElement().embeddedObject(), _fromExpCtx));
+
+    std::vector<size_t> matches;
+    for (auto pos : candidates) {
+        if (filter->matchesBSON(table.docs[pos])) {
+            matches.push_back(pos);
+        }
+    }
+    return matches;
+}
+
 DocumentSource::GetModPathsReturn DocumentSourceLookUp::getModifiedPaths() const {
     std::set<std::string> modifiedPaths{_as.fullPath()};
     if (_unwindSrc) {
@@ -680,16 +918,20 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
     auto currentValue = *_nextValue;
     _nextValue = _pipeline->getNext();
 
-    // Move input document into output if this is the last or only result, otherwise perform a copy.
-    MutableDocument output(_nextValue ? *_input : std::move(*_input));
-    output.setNestedField(_as, Value(currentValue));
+    // WARNING: Like the $unwind stage, this returns a view of '_unwindOutput' rather than a copy of
+    // the input document for every result. Any functional changes to this must also be implemented
+    // in DocumentSourceUnwind::Unwinder.
+    if (_cursorIndex == 0) {
+        _unwindOutput.reset(std::move(*_input));
+    }
+    _unwindOutput.setNestedField(_as, Value(currentValue));
 
     if (indexPath) {
-        output.setNestedField(*indexPath, Value(_cursorIndex));
+        _unwindOutput.setNestedField(*indexPath, Value(_cursorIndex));
     }
 
     ++_cursorIndex;
-    return output.freeze();
+    return _nextValue ? _unwindOutput.peek() : _unwindOutput.freeze();
 }
 
 void DocumentSourceLookUp::resolveLetVariables(const Document& localDoc, Variables* variables) {
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
@@ -256,6 +257,72 @@ private:
      */
     std::unique_ptr<Pipeline, PipelineDeleter> buildPipeline(const Document& inputDoc);
 
+    // Holds a set of foreign documents, together with their positions grouped by each value found
+    // at 'foreignField'.
+    struct HashJoinTable {
+        explicit HashJoinTable(const ValueComparator& comparator)
+            : buckets(comparator.makeUnorderedValueMap<std::vector<size_t>>()) {}
+
+        std::vector<BSONObj> docs;
+        ValueUnorderedMap<std::vector<size_t>> buckets;
+
+        // The documents which may match a null (or missing) local value.
+        std::vector<size_t> nullCandidates;
+    };
+
+    /**
+     * Reads the whole foreign collection into '_hashJoinTable' if this stage joins on
+     * localField/foreignField and the record count of the foreign collection is small enough for
+     * one scan of it to replace a query per input document. Leaves '_hashJoinTable' unset if the
+     * stage is not eligible, or if the foreign documents exceed the hash join memory budget.
+     */
+    void buildHashJoinTableIfEligible();
+
+    /**
+     * Adds every document returned by 'pipeline' to 'table'. Returns false, leaving 'table'
+     * partially filled, if the documents exceed the hash join memory budget.
+     */
+    bool fillHashJoinTable(Pipeline* pipeline, HashJoinTable* table);
+
+    /**
+     * Returns the positions in 'table' of the foreign documents joining with 'inputDoc', in the
+     * order they were added to it.
+     */
+    std::vector<size_t> probeHashJoinTable(const HashJoinTable& table,
+                                           const Document& inputDoc) const;
+
+    /**
+     * Returns 'inputDoc' with the documents of 'table' joining with it set at the 'as' field.
+     */
+    Document joinWithHashJoinTable(Document inputDoc, const HashJoinTable& table) const;
+
+    /**
+     * Returns 'inputDoc' with the foreign documents joining with it set at the 'as' field, probing
+     * '_hashJoinTable' if there is one and querying the foreign collection otherwise.
+     */
+    Document lookUpDocument(Document inputDoc);
+
+    /**
+     * Queries the foreign collection once for the local values of every document in
+     * '_batchInput', and queues the joined documents in '_batchOutput' in input order.
+     */
+    void lookUpBatch();
+
+    /**
+     * Appends 'result' to 'results', asserting that the total size of the joined documents stays
+     * within the limit on intermediate $lookup documents.
+     */
+    void appendJoinedDocument(Document&& result,
+                              std::vector<Value>* results,
+                              long long* resultsSize) const;
+
+    /**
+     * Returns the result of 'buildFn', which builds a pipeline against the foreign collection,
+     * throwing a custom error if that collection is sharded and $lookup may not target it.
+     */
+    template <typename BuildFn>
+    auto buildForeignPipeline(BuildFn&& buildFn);
+
     /**
      * Reinitialize the cache with a new max size. May only be called if this DSLookup was created
      * with pipeline syntax, the cache has not been frozen or abandoned, and no data has been added
@@ -289,6 +356,18 @@ private:
     // from a cursor source.
     boost::optional<SequentialDocumentCache> _cache;
 
+    // Holds every document of the foreign collection when the stage executes as a hash join.
+    boost::optional<HashJoinTable> _hashJoinTable;
+    bool _hashJoinDecided = false;
+
+    // The number of input documents whose local values are sent to the foreign collection in a
+    // single query, the input documents gathered for the next such query, and the output documents
+    // of the last one which are yet to be returned.
+    size_t _batchSize = 1;
+    std::vector<Document> _batchInput;
+    std::deque<Document> _batchOutput;
+    bool _sourceExhausted = false;
+
     // The ExpressionContext used when performing aggregation pipelines against the '_resolvedNs'
     // namespace.
     boost::intrusive_ptr<ExpressionContext> _fromExpCtx;
@@ -314,6 +393,11 @@ private:
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     boost::optional<Document> _input;
     boost::optional<Document> _nextValue;
+
+    // The document returned for each result of unwinding '_input'. It is reused across results so
+    // that the unwound field is overwritten in place rather than '_input' being copied for each
+    // result, provided the consumer releases each result before asking for the next.
+    MutableDocument _unwindOutput;
 };
 
 }  // namespace mongo
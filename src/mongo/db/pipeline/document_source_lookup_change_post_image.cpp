@@ -32,6 +32,8 @@
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/pipeline/change_stream_post_image_cache.h"
+#include "mongo/util/clock_source.h"
 
 namespace mongo {
 
@@ -112,6 +114,21 @@ Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updat
     // reads.
     const auto allowSpeculativeMajorityRead = pExpCtx->inMongos;
     invariant(resumeToken.getData().uuid);
+
+    // Other change streams may have looked up the post-image of the same update already. The
+    // cache is only used under the simple collation, which the lookup by document key of every
+    // stream then shares.
+    boost::optional<ChangeStreamPostImageCache::Key> cacheKey;
+    const auto now = pExpCtx->opCtx->getServiceContext()->getFastClockSource()->now();
+    if (ChangeStreamPostImageCache::enabled() && !pExpCtx->getCollator()) {
+        cacheKey = ChangeStreamPostImageCache::Key{nss,
+                                                   *resumeToken.getData().uuid,
+                                                   documentKey.toBson(),
+                                                   resumeToken.getData().clusterTime};
+        if (auto cached = ChangeStreamPostImageCache::get().find(*cacheKey, now)) {
+            return std::move(*cached);
+        }
+    }
     auto lookedUpDoc =
         pExpCtx->mongoProcessInterface->lookupSingleDocument(pExpCtx,
                                                              nss,
@@ -119,6 +136,9 @@ Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updat
                                                              documentKey,
                                                              readConcern,
                                                              allowSpeculativeMajorityRead);
+    if (cacheKey) {
+        ChangeStreamPostImageCache::get().add(std::move(*cacheKey), lookedUpDoc, now);
+    }
 
     // Check whether the lookup returned any documents. Even if the lookup itself succeeded, it may
     // not have returned any results if the document was deleted in the time since the update op.
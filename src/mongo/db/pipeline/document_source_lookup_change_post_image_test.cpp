@@ -40,11 +40,13 @@
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/change_stream_post_image_cache.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 namespace {
@@ -66,8 +68,7 @@ public:
         return *uuid_gen;
     }
 
-    Document makeResumeToken(ImplicitValue id = Value()) {
-        const Timestamp ts(100, 1);
+    Document makeResumeToken(ImplicitValue id = Value(), Timestamp ts = Timestamp(100, 1)) {
         if (id.missing()) {
             ResumeTokenData tokenData;
             tokenData.clusterTime = ts;
@@ -334,5 +335,111 @@ TEST_F(DocumentSourceLookupChangePostImageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
 }
 
+class ChangeStreamPostImageCacheTest : public DocumentSourceLookupChangePostImageTest {
+public:
+    ChangeStreamPostImageCacheTest() {
+        ChangeStreamPostImageCache::get().clear();
+        internalChangeStreamPostImageCacheMaxBytes.store(1024 * 1024);
+    }
+
+    ~ChangeStreamPostImageCacheTest() {
+        internalChangeStreamPostImageCacheMaxBytes.store(0);
+        ChangeStreamPostImageCache::get().clear();
+    }
+
+    /**
+     * Runs a post-image lookup stage over an update of the document with _id 0 at 'ts', against a
+     * collection made of 'foreignContents', and returns the resulting "fullDocument".
+     */
+    Value lookUpPostImage(deque<DocumentSource::GetNextResult> foreignContents,
+                          Timestamp ts = Timestamp(100, 1)) {
+        auto expCtx = getExpCtx();
+        auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+        auto mockLocalSource = DocumentSourceMock::createForTest(
+            Document{{"_id", makeResumeToken(0, ts)},
+                     {"documentKey", Document{{"_id", 0}}},
+                     {"operationType", "update"_sd},
+                     {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}},
+            expCtx);
+        lookupChangeStage->setSource(mockLocalSource.get());
+        expCtx->mongoProcessInterface =
+            std::make_unique<MockMongoInterface>(std::move(foreignContents));
+
+        auto next = lookupChangeStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        return next.getDocument()["fullDocument"];
+    }
+};
+
+TEST_F(ChangeStreamPostImageCacheTest, ShouldShareLookedUpPostImagesAcrossStreams) {
+    ASSERT_VALUE_EQ(lookUpPostImage({Document{{"_id", 0}, {"x", 1}}}),
+                    Value(Document{{"_id", 0}, {"x", 1}}));
+    ASSERT_EQ(ChangeStreamPostImageCache::get().size(), 1U);
+
+    // Another stream reading the same update gets the post-image looked up by the first one.
+    ASSERT_VALUE_EQ(lookUpPostImage({Document{{"_id", 0}, {"x", 2}}}),
+                    Value(Document{{"_id", 0}, {"x", 1}}));
+}
+
+TEST_F(ChangeStreamPostImageCacheTest, ShouldShareMissingPostImagesAcrossStreams) {
+    ASSERT_VALUE_EQ(lookUpPostImage({}), Value(BSONNULL));
+    ASSERT_VALUE_EQ(lookUpPostImage({Document{{"_id", 0}, {"x", 2}}}), Value(BSONNULL));
+}
+
+TEST_F(ChangeStreamPostImageCacheTest, ShouldNotSharePostImagesOfOtherUpdates) {
+    ASSERT_VALUE_EQ(lookUpPostImage({Document{{"_id", 0}, {"x", 1}}}),
+                    Value(Document{{"_id", 0}, {"x", 1}}));
+    ASSERT_VALUE_EQ(lookUpPostImage({Document{{"_id", 0}, {"x", 2}}}, Timestamp(100, 2)),
+                    Value(Document{{"_id", 0}, {"x", 2}}));
+    ASSERT_EQ(ChangeStreamPostImageCache::get().size(), 2U);
+}
+
+TEST_F(ChangeStreamPostImageCacheTest, ShouldNotCachePostImagesWhenDisabled) {
+    internalChangeStreamPostImageCacheMaxBytes.store(0);
+    ASSERT_VALUE_EQ(lookUpPostImage({Document{{"_id", 0}, {"x", 1}}}),
+                    Value(Document{{"_id", 0}, {"x", 1}}));
+    ASSERT_VALUE_EQ(lookUpPostImage({Document{{"_id", 0}, {"x", 2}}}),
+                    Value(Document{{"_id", 0}, {"x", 2}}));
+    ASSERT_EQ(ChangeStreamPostImageCache::get().size(), 0U);
+}
+
+TEST_F(ChangeStreamPostImageCacheTest, ShouldExpirePostImages) {
+    auto& cache = ChangeStreamPostImageCache::get();
+    const auto expiry = Milliseconds(internalChangeStreamPostImageCacheExpiryMillis.load());
+    const auto start = Date_t::fromMillisSinceEpoch(1000000);
+    auto makeKey = [&](int id) {
+        return ChangeStreamPostImageCache::Key{
+            getExpCtx()->ns, testUuid(), BSON("_id" << id), Timestamp(100, 1)};
+    };
+
+    cache.add(makeKey(0), Document{{"_id", 0}}, start);
+    ASSERT_VALUE_EQ(*cache.find(makeKey(0), start + expiry - Milliseconds(1)),
+                    Value(Document{{"_id", 0}}));
+    ASSERT_FALSE(cache.find(makeKey(0), start + expiry));
+
+    // Expired post-images are evicted as new ones are added.
+    cache.add(makeKey(1), Document{{"_id", 1}}, start + expiry);
+    ASSERT_EQ(cache.size(), 1U);
+    ASSERT_TRUE(cache.find(makeKey(1), start + expiry));
+}
+
+TEST_F(ChangeStreamPostImageCacheTest, ShouldEvictOldestPostImagesOnceFull) {
+    auto& cache = ChangeStreamPostImageCache::get();
+    const auto now = Date_t::fromMillisSinceEpoch(1000000);
+    auto makeKey = [&](int id) {
+        return ChangeStreamPostImageCache::Key{
+            getExpCtx()->ns, testUuid(), BSON("_id" << id), Timestamp(100, 1)};
+    };
+
+    internalChangeStreamPostImageCacheMaxBytes.store(16 * 1024);
+    const auto padding = std::string(512, 'a');
+    for (int id = 0; id < 100; ++id) {
+        cache.add(makeKey(id), Document{{"_id", id}, {"padding", padding}}, now);
+    }
+    ASSERT_LT(cache.size(), 100U);
+    ASSERT_FALSE(cache.find(makeKey(0), now));
+    ASSERT_TRUE(cache.find(makeKey(99), now));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -798,6 +798,54 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     lookup->dispose();
 }
 
+TEST_F(DocumentSourceLookUpTest, ShouldReuseOutputDocumentWhileUnwinding) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    // Mock out the foreign collection.
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"_id", 0}, {"key", 1}},
+                                                             Document{{"_id", 1}, {"key", 1}},
+                                                             Document{{"_id", 2}, {"key", 1}}};
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+
+    // Set up the $lookup stage.
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "key"_sd},
+                                         {"foreignField", "key"_sd},
+                                         {"as", "foreignDoc"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+    lookup->setUnwindStage(DocumentSourceUnwind::create(expCtx, "foreignDoc", false, boost::none));
+
+    auto mockLocalSource =
+        DocumentSourceMock::createForTest({Document{{"_id", 0}, {"key", 1}}}, expCtx);
+    lookup->setSource(mockLocalSource.get());
+
+    // A result which is released before the next is requested is overwritten in place.
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    const void* storage = next.getDocument().getPtr();
+    ASSERT_VALUE_EQ(next.releaseDocument()["foreignDoc"]["_id"], Value(0));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_EQ(storage, next.getDocument().getPtr());
+
+    // A result which is held onto is left untouched by the following one.
+    auto last = lookup->getNext();
+    ASSERT_TRUE(last.isAdvanced());
+    ASSERT_VALUE_EQ(next.getDocument()["foreignDoc"]["_id"], Value(1));
+    ASSERT_VALUE_EQ(last.getDocument()["foreignDoc"]["_id"], Value(2));
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
 TEST_F(DocumentSourceLookUpTest, LookupReportsAsFieldIsModified) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
@@ -31,12 +31,17 @@
 
 #include "mongo/db/pipeline/document_source_sample.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "mongo/db/client.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 using boost::intrusive_ptr;
@@ -50,34 +55,119 @@ REGISTER_DOCUMENT_SOURCE(sample,
                          LiteParsedDocumentSourceDefault::parse,
                          DocumentSourceSample::createFromBson);
 
+namespace {
+
+// Orders documents by descending random value, so that heap operations keep the document with the
+// smallest random value at the front.
+bool hasLargerRandVal(const Document& lhs, const Document& rhs) {
+    return lhs.metadata().getRandVal() > rhs.metadata().getRandVal();
+}
+
+}  // namespace
+
 DocumentSource::GetNextResult DocumentSourceSample::doGetNext() {
     if (_size == 0)
         return GetNextResult::makeEOF();
 
-    if (!_sortStage->isPopulated()) {
-        // Exhaust source stage, add random metadata, and push all into sorter.
-        PseudoRandom& prng = pExpCtx->opCtx->getClient()->getPrng();
-        auto nextInput = pSource->getNext();
-        for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
+    if (!_populated) {
+        auto nextInput = populate();
+        if (nextInput.isPaused()) {
+            return nextInput;  // Propagate the pause.
+        }
+        invariant(_populated);
+    }
+
+    if (_usingSortStage) {
+        invariant(_sortStage->isPopulated());
+        return _sortStage->getNext();
+    }
+
+    if (_nextOutput == _reservoir.size()) {
+        return GetNextResult::makeEOF();
+    }
+    return std::move(_reservoir[_nextOutput++]);
+}
+
+DocumentSource::GetNextResult DocumentSourceSample::populate() {
+    PseudoRandom& prng = pExpCtx->opCtx->getClient()->getPrng();
+    auto nextInput = pSource->getNext();
+    for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
+        if (_usingSortStage) {
             MutableDocument doc(nextInput.releaseDocument());
             doc.metadata().setRandVal(prng.nextCanonicalDouble());
             _sortStage->loadDocument(doc.freeze());
+        } else if (static_cast<long long>(_reservoir.size()) < _size) {
+            addToReservoir(nextInput.releaseDocument(), prng.nextCanonicalDouble());
+        } else if (_numToSkip > 0) {
+            --_numToSkip;
+        } else {
+            // This is the first document whose random value is larger than the smallest one in the
+            // reservoir, so its random value is uniformly distributed above the smallest one.
+            const double smallest = _reservoir.front().metadata().getRandVal();
+            std::pop_heap(_reservoir.begin(), _reservoir.end(), hasLargerRandVal);
+            _reservoirBytes -= _reservoir.back().getApproximateSize();
+            _reservoir.pop_back();
+            addToReservoir(nextInput.releaseDocument(),
+                           smallest + (1 - smallest) * prng.nextCanonicalDouble());
         }
-        switch (nextInput.getStatus()) {
-            case GetNextResult::ReturnStatus::kAdvanced: {
-                MONGO_UNREACHABLE;  // We consumed all advances above.
-            }
-            case GetNextResult::ReturnStatus::kPauseExecution: {
-                return nextInput;  // Propagate the pause.
-            }
-            case GetNextResult::ReturnStatus::kEOF: {
+    }
+
+    switch (nextInput.getStatus()) {
+        case GetNextResult::ReturnStatus::kAdvanced: {
+            MONGO_UNREACHABLE;  // We consumed all advances above.
+        }
+        case GetNextResult::ReturnStatus::kPauseExecution: {
+            return nextInput;
+        }
+        case GetNextResult::ReturnStatus::kEOF: {
+            if (_usingSortStage) {
                 _sortStage->loadingDone();
+            } else {
+                std::sort_heap(_reservoir.begin(), _reservoir.end(), hasLargerRandVal);
             }
+            _populated = true;
         }
     }
+    return nextInput;
+}
+
+void DocumentSourceSample::addToReservoir(Document&& doc, double randVal) {
+    MutableDocument sampled(std::move(doc));
+    sampled.metadata().setRandVal(randVal);
+    if (pExpCtx->needsMerge) {
+        // The merger sorts the results of the shards by their random values, like a $sort would.
+        sampled.metadata().setSortKey(Value(randVal), true);
+    }
+    _reservoir.push_back(sampled.freeze());
+    _reservoirBytes += _reservoir.back().getApproximateSize();
+    std::push_heap(_reservoir.begin(), _reservoir.end(), hasLargerRandVal);
+
+    if (_reservoirBytes > internalQueryMaxBlockingSortMemoryUsageBytes.load()) {
+        switchToSortStage();
+        return;
+    }
 
-    invariant(_sortStage->isPopulated());
-    return _sortStage->getNext();
+    if (static_cast<long long>(_reservoir.size()) == _size) {
+        // Each following document has a random value below the smallest one in the reservoir with
+        // probability 'smallest', so the number of them to skip is geometrically distributed.
+        const double smallest = _reservoir.front().metadata().getRandVal();
+        const double uniform = 1 - pExpCtx->opCtx->getClient()->getPrng().nextCanonicalDouble();
+        const double numToSkip = std::floor(std::log(uniform) / std::log(smallest));
+        _numToSkip = numToSkip < static_cast<double>(std::numeric_limits<long long>::max())
+            ? static_cast<long long>(numToSkip)
+            : std::numeric_limits<long long>::max();
+    }
+}
+
+void DocumentSourceSample::switchToSortStage() {
+    // The random values already drawn for the documents in the reservoir stay valid, and the rest
+    // of the input is given random values as it is read.
+    for (auto&& doc : _reservoir) {
+        _sortStage->loadDocument(std::move(doc));
+    }
+    _reservoir.clear();
+    _reservoirBytes = 0;
+    _usingSortStage = true;
 }
 
 Value DocumentSourceSample::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
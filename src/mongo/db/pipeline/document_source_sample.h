@@ -76,10 +76,44 @@ private:
 
     GetNextResult doGetNext() final;
 
+    /**
+     * Reads the input into '_reservoir', or into '_sortStage' once the reservoir outgrows the
+     * memory limit of a blocking sort. Returns the pause or EOF which ended the input.
+     */
+    GetNextResult populate();
+
+    /**
+     * Adds 'doc' to '_reservoir' with the given random value, and draws the number of documents to
+     * skip before the next one enters it if it is full.
+     */
+    void addToReservoir(Document&& doc, double randVal);
+
+    /**
+     * Moves the documents of '_reservoir' into '_sortStage', which takes all further input.
+     */
+    void switchToSortStage();
+
     long long _size;
 
-    // Uses a $sort stage to randomly sort the documents.
+    // Uses a $sort stage to randomly sort the documents, if the sampled documents are too large to
+    // hold in memory.
     boost::intrusive_ptr<DocumentSourceSort> _sortStage;
+
+    // A single pass reservoir sample of the input: the documents with the '_size' largest random
+    // values, as a min-heap on the random value. Rather than drawing a random value for every
+    // input document, the number of documents whose random values would fall below the smallest
+    // one in the reservoir is drawn from a geometric distribution and those are skipped. This
+    // gives the same sample as sorting the whole input on random values would.
+    std::vector<Document> _reservoir;
+    size_t _reservoirBytes = 0;
+    long long _numToSkip = 0;
+
+    bool _populated = false;
+    bool _usingSortStage = false;
+
+    // The position in '_reservoir', sorted by descending random value, of the next document to
+    // return.
+    size_t _nextOutput = 0;
 };
 
 }  // namespace mongo
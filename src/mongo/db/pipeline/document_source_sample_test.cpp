@@ -41,9 +41,12 @@
 #include "mongo/db/pipeline/document_source_sample.h"
 #include "mongo/db/pipeline/document_source_sample_from_random_cursor.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/death_test.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/tick_source_mock.h"
 
 namespace mongo {
@@ -188,6 +191,59 @@ TEST_F(SampleBasics, ShouldPropagatePauses) {
     assertEOF();
 }
 
+/**
+ * A sample of a large input should return documents sorted by their random values, like a sample of
+ * a small one.
+ */
+TEST_F(SampleBasics, SampleFromLargeInput) {
+    loadDocuments(10000);
+    checkResults(10, 10);
+}
+
+/**
+ * Every document should be equally likely to be sampled, even though most are skipped without
+ * drawing a random value for them.
+ */
+TEST_F(SampleBasics, SampleIsUniform) {
+    const int kNumDocs = 20;
+    const int kSampleSize = 5;
+    const int kNumSamples = 2000;
+    std::vector<int> timesSampled(kNumDocs, 0);
+    for (int i = 0; i < kNumSamples; ++i) {
+        _mock = DocumentSourceMock::createForTest(getExpCtx());
+        loadDocuments(kNumDocs);
+        createSample(kSampleSize);
+        for (auto next = sample()->getNext(); next.isAdvanced(); next = sample()->getNext()) {
+            ++timesSampled[next.getDocument()["_id"].getInt()];
+        }
+    }
+
+    // Each document is expected to be sampled 500 times, with a standard deviation of about 19.
+    const int expected = kNumSamples * kSampleSize / kNumDocs;
+    for (int count : timesSampled) {
+        ASSERT_APPROX_EQUAL(expected, count, 100);
+    }
+}
+
+/**
+ * A $sample whose documents don't fit in the memory limit of a blocking sort should fall back to a
+ * sort which can spill, and still return a sample.
+ */
+TEST_F(SampleBasics, FallsBackToSortWhenReservoirIsTooLarge) {
+    const auto originalMaxBytes = internalQueryMaxBlockingSortMemoryUsageBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryMaxBlockingSortMemoryUsageBytes.store(originalMaxBytes); });
+    internalQueryMaxBlockingSortMemoryUsageBytes.store(1024);
+    unittest::TempDir tempDir("DocumentSourceSampleTest");
+    getExpCtx()->allowDiskUse = true;
+    getExpCtx()->tempDir = tempDir.path();
+
+    const std::string largeString(100, 'x');
+    for (int i = 0; i < 100; i++) {
+        _mock->push_back(DOC("_id" << i << "payload" << largeString));
+    }
+    checkResults(50, 50);
+}
+
 /**
  * Fixture to test error cases of the $sample stage.
  */
@@ -37,6 +37,7 @@
 #include "mongo/db/exec/document_value/document_comparator.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
@@ -136,6 +137,12 @@ Pipeline::SourceContainer::iterator DocumentSourceSort::doOptimizeAt(
         return container->end();
     }
 
+    // A $group directly after this stage can return each group as soon as it has been read, if it
+    // groups by a prefix of this sort pattern.
+    if (auto nextGroup = dynamic_cast<DocumentSourceGroup*>((*nextStage).get())) {
+        nextGroup->setInputSortedBy(getSortKeyPattern());
+    }
+
     limit = getLimit();
 
     // Since $sort is not guaranteed to be stable, we can blindly remove the first $sort only when
@@ -43,6 +43,7 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_source_sort_by_count.h"
+#include "mongo/db/pipeline/pipeline.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -108,6 +109,24 @@ TEST_F(SortByCountReturnsGroupAndSort, ExpressionInObjectSpec) {
     testCreateFromBsonResult(spec, expectedGroupExplain);
 }
 
+TEST_F(SortByCountReturnsGroupAndSort, FollowingLimitMakesTheSortKeepOnlyTheTopGroups) {
+    auto pipeline = Pipeline::parse({BSON("$sortByCount"
+                                          << "$x"),
+                                     BSON("$limit" << 5)},
+                                    getExpCtx());
+    pipeline->optimizePipeline();
+
+    // The $limit is absorbed into the $sort, which then keeps only the five largest groups in a
+    // bounded heap rather than sorting all of them.
+    const auto& sources = pipeline->getSources();
+    ASSERT_EQUALS(sources.size(), 2UL);
+    ASSERT(dynamic_cast<DocumentSourceGroup*>(sources.front().get()));
+    const auto* sortStage = dynamic_cast<DocumentSourceSort*>(sources.back().get());
+    ASSERT(sortStage);
+    ASSERT(sortStage->getLimit());
+    ASSERT_EQUALS(*sortStage->getLimit(), 5LL);
+}
+
 /**
  * Fixture to test error cases of the $sortByCount stage.
  */
@@ -37,6 +37,7 @@
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/document_source_union_with_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/logv2/log.h"
 
@@ -171,6 +172,13 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kIteratingSource) {
+        if (!_subPipelineAttached && !pExpCtx->explain &&
+            internalQueryUnionWithEagerSubPipelineDispatch.load()) {
+            // Dispatch the sub-pipeline before reading any input, so that any remote cursors it
+            // opens produce their first batch while the base collection is being read.
+            attachCursorSourceToSubPipeline();
+        }
+
         auto nextInput = pSource->getNext();
         if (!nextInput.isEOF()) {
             return nextInput;
@@ -181,6 +189,23 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kStartingSubPipeline) {
+        if (!_subPipelineAttached) {
+            attachCursorSourceToSubPipeline();
+        }
+        _executionState = ExecutionProgress::kIteratingSubPipeline;
+    }
+
+    auto res = _pipeline->getNext();
+    if (res)
+        return std::move(*res);
+
+    _executionState = ExecutionProgress::kFinished;
+    return GetNextResult::makeEOF();
+}
+
+void DocumentSourceUnionWith::attachCursorSourceToSubPipeline() {
+    invariant(!_subPipelineAttached);
+    while (true) {
         auto serializedPipe = _pipeline->serializeToBson();
         LOGV2_DEBUG(23869,
                     1,
@@ -189,7 +214,8 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
         try {
             _pipeline =
                 pExpCtx->mongoProcessInterface->attachCursorSourceToPipeline(_pipeline.release());
-            _executionState = ExecutionProgress::kIteratingSubPipeline;
+            _subPipelineAttached = true;
+            return;
         } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
             _pipeline = buildPipelineFromViewDefinition(
                 pExpCtx,
@@ -202,16 +228,8 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
                         "ns"_attr = e->getNamespace(),
                         "pipeline"_attr = Value(e->getPipeline()),
                         "new_pipe"_attr = _pipeline->serializeToBson());
-            return doGetNext();
         }
     }
-
-    auto res = _pipeline->getNext();
-    if (res)
-        return std::move(*res);
-
-    _executionState = ExecutionProgress::kFinished;
-    return GetNextResult::makeEOF();
 }
 
 Pipeline::SourceContainer::iterator DocumentSourceUnionWith::doOptimizeAt(
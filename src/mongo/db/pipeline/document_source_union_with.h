@@ -160,10 +160,20 @@ private:
 
     void addViewDefinition(NamespaceString nss, std::vector<BSONObj> viewPipeline);
 
+    /**
+     * Attaches a cursor source to '_pipeline', resolving the sub-pipeline against the view
+     * definition if the foreign namespace turns out to be a view.
+     */
+    void attachCursorSourceToSubPipeline();
+
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     Pipeline::SourceContainer _cachedPipeline;
     bool _usedDisk = false;
     ExecutionProgress _executionState = ExecutionProgress::kIteratingSource;
+
+    // Whether a cursor source has been attached to '_pipeline'. This may be the case while still
+    // iterating 'pSource' if internalQueryUnionWithEagerSubPipelineDispatch is set.
+    bool _subPipelineAttached = false;
 };
 
 }  // namespace mongo
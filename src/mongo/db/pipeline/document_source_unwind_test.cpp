@@ -708,6 +708,33 @@ TEST_F(UnwindStageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(unwind->getNext().isEOF());
 }
 
+TEST_F(UnwindStageTest, ShouldReuseOutputDocumentWhenResultsAreReleased) {
+    auto unwind = DocumentSourceUnwind::create(getExpCtx(), "array", false, std::string("index"));
+    auto source = DocumentSourceMock::createForTest(
+        {Document{{"_id", 0}, {"array", vector<Value>{Value(1), Value(2), Value(3)}}}},
+        getExpCtx());
+    unwind->setSource(source.get());
+
+    // A result which is released before the next is requested is overwritten in place.
+    auto next = unwind->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    const void* storage = next.getDocument().getPtr();
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", 0}, {"array", 1}, {"index", 0LL}}));
+
+    next = unwind->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_EQ(storage, next.getDocument().getPtr());
+
+    // A result which is held onto is left untouched by the following one.
+    auto last = unwind->getNext();
+    ASSERT_TRUE(last.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(), (Document{{"_id", 0}, {"array", 2}, {"index", 1LL}}));
+    ASSERT_DOCUMENT_EQ(last.getDocument(), (Document{{"_id", 0}, {"array", 3}, {"index", 2LL}}));
+
+    ASSERT_TRUE(unwind->getNext().isEOF());
+}
+
 TEST_F(UnwindStageTest, UnwindOnlyModifiesUnwoundPathWhenNotIncludingIndex) {
     const bool includeNullIfEmptyOrMissing = false;
     const boost::optional<std::string> includeArrayIndex = boost::none;
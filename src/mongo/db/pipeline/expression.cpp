@@ -193,6 +193,22 @@ bool Expression::isExpressionName(StringData name) {
     return parserMap.find(name) != parserMap.end();
 }
 
+Value Expression::evaluateMaybeCompiled(const Document& root, Variables* variables) const {
+    if (!_compilationAttempted) {
+        _compilationAttempted = true;
+        if (auto&& compiler = getExpressionContext()->expressionCompiler) {
+            _compiled = compiler->compile(*this);
+        }
+    }
+
+    if (_compiled) {
+        if (auto result = _compiled->evaluate(root)) {
+            return std::move(*result);
+        }
+    }
+    return evaluate(root, variables);
+}
+
 /* ------------------------- Register Date Expressions ----------------------------- */
 
 REGISTER_EXPRESSION(dayOfMonth, ExpressionDayOfMonth::parse);
@@ -164,6 +164,14 @@ public:
      */
     virtual Value evaluate(const Document& root, Variables* variables) const = 0;
 
+    /**
+     * Same as evaluate(), but evaluates the compiled form of the expression if the
+     * ExpressionContext provides an ExpressionCompiler which supports it. The expression is
+     * compiled on the first call, so it must not be modified afterwards. Unlike evaluate(), this
+     * method is not thread-safe.
+     */
+    Value evaluateMaybeCompiled(const Document& root, Variables* variables) const;
+
     /**
      * Returns information about the paths computed by this expression. This only needs to be
      * overridden by expressions that have renaming semantics, where optimization code could take
@@ -297,6 +305,10 @@ protected:
 private:
     boost::optional<Variables::Id> _boundaryVariableId;
     ExpressionContext* const _expCtx;
+
+    // The compiled form of the expression, if evaluateMaybeCompiled() could compile it.
+    mutable std::unique_ptr<CompiledExpression> _compiled;
+    mutable bool _compilationAttempted = false;
 };
 
 /**
@@ -429,9 +441,7 @@ public:
         if (n == 1) {
             Value singleVal = this->_children[0]->evaluate(root, variables);
             if (singleVal.getType() == Array) {
-                for (const Value& val : singleVal.getArray()) {
-                    accum.process(val, false);
-                }
+                accum.processBatch(singleVal.getArray(), false);
             } else {
                 accum.process(singleVal, false);
             }
@@ -0,0 +1,76 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+
+namespace mongo {
+
+class Expression;
+
+/**
+ * An Expression lowered to a form which evaluates it without the recursive walk over the
+ * expression tree done by Expression::evaluate().
+ */
+class CompiledExpression {
+public:
+    virtual ~CompiledExpression() = default;
+
+    /**
+     * Evaluates the expression with respect to the Document given by 'root'. Returns boost::none
+     * if the compiled form of the expression cannot be evaluated against 'root', in which case
+     * the caller falls back to Expression::evaluate().
+     */
+    virtual boost::optional<Value> evaluate(const Document& root) = 0;
+};
+
+/**
+ * Lowers Expressions to CompiledExpressions. An ExpressionCompiler is attached to the
+ * ExpressionContext of a pipeline by the components which provide one, such as the mongod
+ * executor of pipelines, and is used by the stages which evaluate expressions for each document
+ * through Expression::evaluateMaybeCompiled().
+ */
+class ExpressionCompiler {
+public:
+    virtual ~ExpressionCompiler() = default;
+
+    /**
+     * Returns the compiled form of 'expr', or nullptr if 'expr' cannot be compiled or is not worth
+     * compiling. A compiled expression can only refer to $$ROOT, $$REMOVE and the variables
+     * defined within the expression itself.
+     */
+    virtual std::unique_ptr<CompiledExpression> compile(const Expression& expr) = 0;
+};
+
+}  // namespace mongo
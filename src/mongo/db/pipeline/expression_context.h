@@ -42,6 +42,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/db/pipeline/expression_compiler.h"
 #include "mongo/db/pipeline/javascript_execution.h"
 #include "mongo/db/pipeline/process_interface/mongo_process_interface.h"
 #include "mongo/db/pipeline/runtime_constants_gen.h"
@@ -334,6 +335,10 @@ public:
     // libraries from having large numbers of dependencies. This pointer is always non-null.
     std::shared_ptr<MongoProcessInterface> mongoProcessInterface;
 
+    // Lowers the expressions evaluated by the stages of the pipeline for each document to a faster
+    // form. Only set by the components which provide one, and null otherwise.
+    std::shared_ptr<ExpressionCompiler> expressionCompiler;
+
     const TimeZoneDatabase* timeZoneDatabase;
 
     Variables variables;
@@ -111,9 +111,8 @@ Value ExpressionFunction::evaluate(const Document& root, Variables* variables) c
     auto jsExec = getExpressionContext()->getJsExecWithScope(_assignFirstArgToThis);
     auto scope = jsExec->getScope();
 
-    // createFunction is memoized in MozJSImplScope, so it's ok to call this for each
-    // eval call.
-    ScriptingFunction func = jsExec->getScope()->createFunction(_funcSource.c_str());
+    // createFunction is memoized in JsExecution, so it's ok to call this for each eval call.
+    ScriptingFunction func = jsExec->createFunction(_funcSource);
     uassert(31265, "The body function did not evaluate", func);
 
     auto argValue = _passedArgs->evaluate(root, variables);
@@ -63,6 +63,19 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
     return exec.get();
 }
 
+ScriptingFunction JsExecution::createFunction(StringData funcCode) {
+    if (auto it = _compiledFunctions.find(funcCode); it != _compiledFunctions.end()) {
+        return it->second;
+    }
+
+    auto funcCodeStr = funcCode.toString();
+    ScriptingFunction func = _scope->createFunction(funcCodeStr.c_str());
+    if (func) {
+        _compiledFunctions.emplace(std::move(funcCodeStr), func);
+    }
+    return func;
+}
+
 Value JsExecution::callFunction(ScriptingFunction func,
                                 const BSONObj& params,
                                 const BSONObj& thisObj) {
@@ -35,6 +35,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -94,11 +95,11 @@ public:
     Value callFunction(ScriptingFunction func, const BSONObj& params, const BSONObj& thisObj);
 
     /**
-     * Creates a function in the owned Scope* if it hasn't been created yet.
+     * Creates a function in the owned Scope* if it hasn't been created yet. The compiled functions
+     * are remembered by their source, so that callers which evaluate the same function for every
+     * document don't pay for copying the source into the Scope's own function cache each time.
      */
-    ScriptingFunction createFunction(std::string funcCode) {
-        return _scope->createFunction(funcCode.c_str());
-    };
+    ScriptingFunction createFunction(StringData funcCode);
 
     /**
      * Injects the given function 'emitFn' as a native JS function named 'emit', callable from
@@ -122,6 +123,9 @@ private:
     bool _storedProceduresLoaded = false;
     int _fnCallTimeoutMillis;
 
+    // Maps the source of each function created through this JsExecution to its compiled form.
+    StringMap<ScriptingFunction> _compiledFunctions;
+
     Value doCallFunction(ScriptingFunction func,
                          const BSONObj& params,
                          const BSONObj& thisObj,
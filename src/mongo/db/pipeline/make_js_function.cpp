@@ -38,7 +38,7 @@ namespace mongo {
 ScriptingFunction makeJsFunc(ExpressionContext* const expCtx, const std::string& func) {
     auto jsExec =
         expCtx->getJsExecWithScope();  // default arg forceLoadOfStoredProcedures is false here.
-    ScriptingFunction parsedFunc = jsExec->getScope()->createFunction(func.c_str());
+    ScriptingFunction parsedFunc = jsExec->createFunction(func);
     uassert(
         31247, "The user-defined function failed to parse in the javascript engine", parsedFunc);
     return parsedFunc;
@@ -70,7 +70,9 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/sbe_expression_compiler.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/service_context.h"
@@ -322,6 +324,12 @@ PipelineD::buildInnerQueryExecutor(const CollectionPtr& collection,
                                    Pipeline* pipeline) {
     auto expCtx = pipeline->getContext();
 
+    // The stages of the pipeline run in the classic engine, but may evaluate their expressions
+    // through SBE.
+    if (internalQueryCompileAggExpressionsToSBE.load() && !expCtx->expressionCompiler) {
+        expCtx->expressionCompiler = std::make_shared<stage_builder::SBEExpressionCompiler>();
+    }
+
     // We will be modifying the source vector as we go.
     Pipeline::SourceContainer& sources = pipeline->_sources;
 
@@ -434,6 +442,29 @@ getSortAndGroupStagesFromPipeline(const Pipeline::SourceContainer& sources) {
     return std::make_pair(sortStage, groupStage);
 }
 
+/**
+ * Returns true if 'collection' has an index whose first field is the first field of 'sortPattern',
+ * in which case the query layer may be able to provide the sort without a blocking SORT stage.
+ */
+bool indexMayProvideSort(OperationContext* opCtx,
+                         const CollectionPtr& collection,
+                         const SortPattern& sortPattern) {
+    if (!collection || sortPattern.empty() || !sortPattern[0].fieldPath) {
+        return false;
+    }
+
+    const auto firstSortField = sortPattern[0].fieldPath->fullPath();
+    auto ii = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+    while (ii->more()) {
+        const IndexDescriptor* desc = ii->next()->descriptor();
+        if (!desc->hidden() &&
+            desc->keyPattern().firstElementFieldNameStringData() == firstSortField) {
+            return true;
+        }
+    }
+    return false;
+}
+
 boost::optional<long long> extractSkipForPushdown(Pipeline* pipeline) {
     // If the disablePipelineOptimization failpoint is enabled, then do not attempt the skip
     // pushdown optimization.
@@ -536,6 +567,18 @@ PipelineD::buildInnerQueryExecutorGeneric(const CollectionPtr& collection,
     }
 
     auto&& [sortStage, groupStage] = getSortAndGroupStagesFromPipeline(pipeline->_sources);
+
+    // A $sort followed by a $group which only computes $first and $last does not need to order the
+    // whole input: the $group can instead keep, for each group, the values from the document which
+    // sorts first or last. This is only done when no index could provide the sort, since an index
+    // scan may avoid the blocking sort altogether, or allow a DISTINCT_SCAN.
+    if (sortStage && groupStage && !MONGO_unlikely(disablePipelineOptimization.shouldFail()) &&
+        !indexMayProvideSort(expCtx->opCtx, collection, sortStage->getSortKeyPattern()) &&
+        groupStage->absorbSort(sortStage->getSortKeyPattern())) {
+        pipeline->popFrontWithName(DocumentSourceSort::kStageName);
+        sortStage = nullptr;
+    }
+
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage;
     if (groupStage) {
         rewrittenGroupStage = groupStage->rewriteGroupAsTransformOnFirstDocument();
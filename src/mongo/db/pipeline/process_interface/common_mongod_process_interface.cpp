@@ -177,7 +177,7 @@ std::vector<Document> CommonMongodProcessInterface::getIndexStats(OperationConte
         doc["name"] = Value(indexName);
         doc["key"] = Value(stats->indexKey);
         doc["host"] = Value(host);
-        doc["accesses"]["ops"] = Value(stats->accesses.loadRelaxed());
+        doc["accesses"]["ops"] = Value(stats->accesses.get());
         doc["accesses"]["since"] = Value(stats->trackerStartTime);
 
         if (addShardName)
@@ -63,7 +63,8 @@ std::vector<BSONObj> CommonProcessInterface::getCurrentOps(
     CurrentOpUserMode userMode,
     CurrentOpTruncateMode truncateMode,
     CurrentOpCursorMode cursorMode,
-    CurrentOpBacktraceMode backtraceMode) const {
+    CurrentOpBacktraceMode backtraceMode,
+    const MatchExpression* filter) const {
     OperationContext* opCtx = expCtx->opCtx;
     AuthorizationSession* ctxAuth = AuthorizationSession::get(opCtx->getClient());
 
@@ -93,9 +94,16 @@ std::vector<BSONObj> CommonProcessInterface::getCurrentOps(
         }
 
         // Delegate to the mongoD- or mongoS-specific implementation of _reportCurrentOpForClient.
-        ops.emplace_back(_reportCurrentOpForClient(opCtx, client, truncateMode, backtraceMode));
+        // Operations which don't match the filter are discarded right away, rather than held on
+        // to for a later $match to drop.
+        auto op = _reportCurrentOpForClient(opCtx, client, truncateMode, backtraceMode);
+        if (!filter || filter->matchesBSON(op)) {
+            ops.emplace_back(std::move(op));
+        }
     }
 
+    const auto numClientOps = ops.size();
+
     // If 'cursorMode' is set to include idle cursors, retrieve them and add them to ops.
     if (cursorMode == CurrentOpCursorMode::kIncludeCursors) {
 
@@ -135,6 +143,13 @@ std::vector<BSONObj> CommonProcessInterface::getCurrentOps(
         _reportCurrentOpsForPrimaryOnlyServices(opCtx, connMode, sessionMode, &ops);
     }
 
+    if (filter) {
+        ops.erase(std::remove_if(ops.begin() + numClientOps,
+                                 ops.end(),
+                                 [&](const BSONObj& op) { return !filter->matchesBSON(op); }),
+                  ops.end());
+    }
+
     return ops;
 }
 
@@ -59,7 +59,8 @@ public:
                                        CurrentOpUserMode userMode,
                                        CurrentOpTruncateMode truncateMode,
                                        CurrentOpCursorMode cursorMode,
-                                       CurrentOpBacktraceMode backtraceMode) const final;
+                                       CurrentOpBacktraceMode backtraceMode,
+                                       const MatchExpression* filter) const final;
 
     virtual std::vector<FieldPath> collectDocumentKeyFieldsActingAsRouter(
         OperationContext*, const NamespaceString&) const override;
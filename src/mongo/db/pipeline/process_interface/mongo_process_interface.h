@@ -304,6 +304,7 @@ public:
      * Returns a vector of owned BSONObjs, each of which contains details of an in-progress
      * operation or, optionally, an idle connection. If userMode is kIncludeAllUsers, report
      * operations for all authenticated users; otherwise, report only the current user's operations.
+     * If 'filter' is not null, only the operations which match it are returned.
      */
     virtual std::vector<BSONObj> getCurrentOps(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
@@ -312,7 +313,8 @@ public:
         CurrentOpUserMode userMode,
         CurrentOpTruncateMode,
         CurrentOpCursorMode,
-        CurrentOpBacktraceMode) const = 0;
+        CurrentOpBacktraceMode,
+        const MatchExpression* filter) const = 0;
 
     /**
      * Returns the name of the local shard if sharding is enabled, or an empty string.
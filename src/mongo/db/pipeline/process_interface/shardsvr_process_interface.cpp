@@ -365,7 +365,50 @@ void ShardServerProcessInterface::dropCollection(OperationContext* opCtx,
 std::unique_ptr<Pipeline, PipelineDeleter>
 ShardServerProcessInterface::attachCursorSourceToPipeline(Pipeline* ownedPipeline,
                                                           bool allowTargetingShards) {
-    return sharded_agg_helpers::attachCursorToPipeline(ownedPipeline, allowTargetingShards);
+    auto expCtx = ownedPipeline->getContext();
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline(ownedPipeline,
+                                                        PipelineDeleter(expCtx->opCtx));
+    if (allowTargetingShards && internalQueryReadCoLocatedSubPipelinesLocally.load() &&
+        _canReadLocally(*pipeline)) {
+        return attachCursorSourceToPipelineForLocalRead(pipeline.release());
+    }
+    return sharded_agg_helpers::attachCursorToPipeline(pipeline.release(), allowTargetingShards);
+}
+
+bool ShardServerProcessInterface::_canReadLocally(const Pipeline& pipeline) {
+    const auto& expCtx = pipeline.getContext();
+    const auto& nss = expCtx->ns;
+
+    // Without a shard version the local read wouldn't filter out orphaned documents, so only
+    // operations which are versioned may read locally.
+    if (!_opIsVersioned || nss.isConfigDotCacheDotChunks() || nss.db() == "local" ||
+        pipeline.getSources().empty()) {
+        return false;
+    }
+
+    auto opCtx = expCtx->opCtx;
+    const auto cm =
+        uassertStatusOK(Grid::get(opCtx)->catalogCache()->getCollectionRoutingInfo(opCtx, nss));
+    if (!cm.isSharded()) {
+        return false;
+    }
+
+    const auto thisShardId = ShardingState::get(opCtx)->shardId();
+    const auto shardIds = getTargetedShardsForQuery(
+        expCtx, cm, pipeline.getInitialQuery(), expCtx->getCollatorBSON());
+    if (shardIds.size() != 1 || *shardIds.begin() != thisShardId) {
+        return false;
+    }
+
+    // The routing table used for targeting must be the one the local read is checked against. If
+    // the operation already carries another version for the collection, read through the router.
+    const auto shardVersion = cm.getVersion(thisShardId);
+    auto& oss = OperationShardingState::get(opCtx);
+    if (oss.hasShardVersion(nss)) {
+        return oss.getShardVersion(nss) == shardVersion;
+    }
+    oss.initializeClientRoutingVersions(nss, shardVersion, boost::none);
+    return true;
 }
 
 void ShardServerProcessInterface::setExpectedShardVersion(
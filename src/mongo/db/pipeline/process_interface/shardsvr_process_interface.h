@@ -122,7 +122,8 @@ public:
      * If 'allowTargetingShards' is true, splits the pipeline and dispatch half to the shards,
      * leaving the merging half executing in this process after attaching a $mergeCursors. Will
      * retry on network errors and also on StaleConfig errors to avoid restarting the entire
-     * operation.
+     * operation. If the pipeline targets this shard only, as the foreign pipeline of a $lookup
+     * between collections sharded alike does, it instead reads this shard's data locally.
      */
     std::unique_ptr<Pipeline, PipelineDeleter> attachCursorSourceToPipeline(
         Pipeline* pipeline, bool allowTargetingShards) final;
@@ -132,6 +133,14 @@ public:
                                  boost::optional<ChunkVersion> chunkVersion) final;
 
 private:
+    /**
+     * Returns true if 'pipeline', which reads from a sharded collection, targets no shard other
+     * than this one and can therefore read the local data of the collection. In that case the
+     * shard version of this shard is attached to the operation for the collection, so that the
+     * local read filters out orphaned documents and fails if this shard's metadata is stale.
+     */
+    bool _canReadLocally(const Pipeline& pipeline);
+
     // If the current operation is versioned, then we attach the DB version to the command object;
     // otherwise, it is returned unmodified. Used when running internal commands, as the parent
     // operation may be unversioned if run by a client connecting directly to the shard. If a shard
@@ -170,7 +170,8 @@ public:
                                        CurrentOpUserMode userMode,
                                        CurrentOpTruncateMode truncateMode,
                                        CurrentOpCursorMode cursorMode,
-                                       CurrentOpBacktraceMode backtraceMode) const override {
+                                       CurrentOpBacktraceMode backtraceMode,
+                                       const MatchExpression* filter) const override {
         MONGO_UNREACHABLE;
     }
 
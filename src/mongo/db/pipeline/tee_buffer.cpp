@@ -38,7 +38,9 @@
 namespace mongo {
 
 TeeBuffer::TeeBuffer(size_t nConsumers, size_t bufferSizeBytes)
-    : _bufferSizeBytes(bufferSizeBytes), _consumers(nConsumers) {}
+    : _bufferSizeBytes(bufferSizeBytes),
+      _consumers(nConsumers),
+      _nConsumersStillInUse(nConsumers) {}
 
 boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferSizeBytes) {
     uassert(40309, "need at least one consumer for a TeeBuffer", nConsumers > 0);
@@ -50,12 +52,7 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
-    size_t nConsumersStillProcessingThisBatch =
-        std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
-            return info.nLeftToReturn > 0;
-        });
-
-    if (_buffer.empty() || nConsumersStillProcessingThisBatch == 0) {
+    if (_buffer.empty() || _nConsumersStillProcessingThisBatch == 0) {
         loadNextBatch();
     }
 
@@ -71,7 +68,9 @@ DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
     }
 
     const size_t bufferIndex = _buffer.size() - _consumers[consumerId].nLeftToReturn;
-    --_consumers[consumerId].nLeftToReturn;
+    if (--_consumers[consumerId].nLeftToReturn == 0) {
+        --_nConsumersStillProcessingThisBatch;
+    }
 
     return _buffer[bufferIndex];
 }
@@ -97,6 +96,7 @@ void TeeBuffer::loadNextBatch() {
     invariant(!input.isPaused());  // NOLINT(bugprone-use-after-move)
 
     // Populate the pending returns.
+    _nConsumersStillProcessingThisBatch = _buffer.empty() ? 0 : _nConsumersStillInUse;
     for (size_t consumerId = 0; consumerId < _consumers.size(); ++consumerId) {
         if (_consumers[consumerId].stillInUse) {
             _consumers[consumerId].nLeftToReturn = _buffer.size();
@@ -64,11 +64,17 @@ public:
      * consumer will not consume all input.
      */
     void dispose(size_t consumerId) {
-        _consumers[consumerId].stillInUse = false;
-        _consumers[consumerId].nLeftToReturn = 0;
-        if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
-                return info.stillInUse;
-            })) {
+        auto& consumer = _consumers[consumerId];
+        if (!consumer.stillInUse) {
+            return;
+        }
+        consumer.stillInUse = false;
+        --_nConsumersStillInUse;
+        if (consumer.nLeftToReturn > 0) {
+            consumer.nLeftToReturn = 0;
+            --_nConsumersStillProcessingThisBatch;
+        }
+        if (_nConsumersStillInUse == 0) {
             _buffer.clear();
             if (_source) {
                 _source->dispose();
@@ -103,5 +109,9 @@ private:
         int nLeftToReturn = 0;
     };
     std::vector<ConsumerInfo> _consumers;
+
+    // Kept up to date with '_consumers' so that neither getNext() nor dispose() need to scan it.
+    size_t _nConsumersStillInUse;
+    size_t _nConsumersStillProcessingThisBatch = 0;
 };
 }  // namespace mongo
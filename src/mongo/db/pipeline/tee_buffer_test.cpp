@@ -170,5 +170,32 @@ TEST_F(TeeBufferTest, ShouldAllowOtherConsumersToAdvanceOnceTrailingConsumerIsDi
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
 }
+
+TEST_F(TeeBufferTest, ShouldKeepTrailingConsumersInBatchOnceLeadingConsumerIsDisposed) {
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"a", 1}}, Document{{"a", 2}}};
+    auto mock = DocumentSourceMock::createForTest(inputs, getExpCtx());
+
+    const size_t nConsumers = 3;
+    const size_t bufferBytes = 1;  // Both docs won't fit in a single batch.
+    auto teeBuffer = TeeBuffer::create(nConsumers, bufferBytes);
+    teeBuffer->setSource(mock.get());
+
+    // Consumer #0 finishes the first batch, then is disposed, twice.
+    ASSERT_DOCUMENT_EQ(teeBuffer->getNext(0).getDocument(), inputs.front().getDocument());
+    teeBuffer->dispose(0);
+    teeBuffer->dispose(0);
+
+    // Consumer #1 finishes the first batch, and must wait for consumer #2.
+    ASSERT_DOCUMENT_EQ(teeBuffer->getNext(1).getDocument(), inputs.front().getDocument());
+    ASSERT_TRUE(teeBuffer->getNext(1).isPaused());
+
+    ASSERT_DOCUMENT_EQ(teeBuffer->getNext(2).getDocument(), inputs.front().getDocument());
+    ASSERT_DOCUMENT_EQ(teeBuffer->getNext(2).getDocument(), inputs.back().getDocument());
+    ASSERT_TRUE(teeBuffer->getNext(2).isPaused());
+
+    ASSERT_DOCUMENT_EQ(teeBuffer->getNext(1).getDocument(), inputs.back().getDocument());
+    ASSERT_TRUE(teeBuffer->getNext(1).isEOF());
+    ASSERT_TRUE(teeBuffer->getNext(2).isEOF());
+}
 }  // namespace
 }  // namespace mongo
@@ -30,6 +30,8 @@
 #include "mongo/db/prepare_conflict_tracker.h"
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/stats/wait_events.h"
+
 namespace mongo {
 
 const OperationContext::Decoration<PrepareConflictTracker> PrepareConflictTracker::get =
@@ -60,6 +62,7 @@ void PrepareConflictTracker::endPrepareConflict(OperationContext* opCtx) {
         auto curConflictDuration =
             tickSource->ticksTo<Microseconds>(curTick - _prepareConflictStartTime);
         _prepareConflictDuration.store(_prepareConflictDuration.load() + curConflictDuration);
+        recordWaitTime(opCtx, WaitClass::kPrepareConflict, curConflictDuration);
         _prepareConflictStartTime = 0;
 
         // Implies that the current read operation is not blocked on a prepared transaction.
@@ -0,0 +1,275 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/aggregation_result_cache.h"
+
+#include <algorithm>
+#include <array>
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+namespace {
+Counter64 aggregationResultCacheHits;
+Counter64 aggregationResultCacheMisses;
+Counter64 aggregationResultCacheInvalidations;
+
+ServerStatusMetricField<Counter64> aggregationResultCacheHitsMetric(
+    "query.aggregationResultCache.hits", &aggregationResultCacheHits);
+ServerStatusMetricField<Counter64> aggregationResultCacheMissesMetric(
+    "query.aggregationResultCache.misses", &aggregationResultCacheMisses);
+ServerStatusMetricField<Counter64> aggregationResultCacheInvalidationsMetric(
+    "query.aggregationResultCache.invalidations", &aggregationResultCacheInvalidations);
+
+// The fraction of the size limit of the cache above which the results of an aggregation are not
+// cached.
+constexpr long long kMaxResultsFraction = 16;
+
+// The stages and expressions whose results do not only depend on the contents of the collections
+// read by the pipeline. Internal stages, whose names start with '$_internal', are excluded as well.
+constexpr std::array<StringData, 16> kUncacheableOperators = {"$accumulator"_sd,
+                                                              "$changeStream"_sd,
+                                                              "$collStats"_sd,
+                                                              "$currentOp"_sd,
+                                                              "$function"_sd,
+                                                              "$indexStats"_sd,
+                                                              "$listCachedAndActiveUsers"_sd,
+                                                              "$listLocalSessions"_sd,
+                                                              "$listSessions"_sd,
+                                                              "$merge"_sd,
+                                                              "$out"_sd,
+                                                              "$planCacheStats"_sd,
+                                                              "$rand"_sd,
+                                                              "$sample"_sd,
+                                                              "$sampleRate"_sd,
+                                                              "$where"_sd};
+
+// The system variables whose values are not the same from one execution to the next.
+constexpr std::array<StringData, 2> kUncacheableVariables = {"$$NOW"_sd, "$$CLUSTER_TIME"_sd};
+
+bool isCacheableElement(const BSONElement& elem) {
+    const auto fieldName = elem.fieldNameStringData();
+    if (fieldName.startsWith("$") &&
+        (fieldName.startsWith("$_internal") ||
+         std::find(kUncacheableOperators.begin(), kUncacheableOperators.end(), fieldName) !=
+             kUncacheableOperators.end())) {
+        return false;
+    }
+
+    switch (elem.type()) {
+        case String: {
+            const auto str = elem.valueStringData();
+            return std::none_of(kUncacheableVariables.begin(),
+                                kUncacheableVariables.end(),
+                                [&](StringData var) { return str.startsWith(var); });
+        }
+        case Object:
+        case Array:
+            for (auto&& child : elem.Obj()) {
+                if (!isCacheableElement(child)) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+}  // namespace
+
+AggregationResultCache& AggregationResultCache::get() {
+    static AggregationResultCache cache;
+    return cache;
+}
+
+bool AggregationResultCache::enabled() {
+    return internalQueryAggregationResultCacheMaxBytes.load() > 0;
+}
+
+bool AggregationResultCache::isCacheablePipeline(const std::vector<BSONObj>& pipeline,
+                                                 const BSONObj& letParameters) {
+    auto isCacheableObj = [](const BSONObj& obj) {
+        return std::all_of(obj.begin(), obj.end(), isCacheableElement);
+    };
+    return std::all_of(pipeline.begin(), pipeline.end(), isCacheableObj) &&
+        isCacheableObj(letParameters);
+}
+
+AggregationResultCache::ReadVersions AggregationResultCache::getReadVersions(
+    const std::vector<NamespaceString>& namespaces) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _catchUpWithMissedWrites(lk);
+
+    ReadVersions versions;
+    versions.epoch = _epoch;
+    for (auto&& nss : namespaces) {
+        auto it = _writeVersions.find(nss.ns());
+        versions.namespaces.emplace_back(nss.ns(), it == _writeVersions.end() ? 0 : it->second);
+    }
+    return versions;
+}
+
+boost::optional<std::vector<BSONObj>> AggregationResultCache::find(const BSONObj& key,
+                                                                   Date_t now) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _catchUpWithMissedWrites(lk);
+
+    auto it = _index.find(key);
+    if (it == _index.end()) {
+        aggregationResultCacheMisses.increment();
+        return boost::none;
+    }
+
+    auto entryIt = it->second;
+    const bool isStale = _isStale(lk, entryIt->versions);
+    if (isStale || _isExpired(*entryIt, now)) {
+        if (isStale) {
+            aggregationResultCacheInvalidations.increment();
+        }
+        aggregationResultCacheMisses.increment();
+        _erase(lk, entryIt);
+        return boost::none;
+    }
+
+    aggregationResultCacheHits.increment();
+    _entries.splice(_entries.end(), _entries, entryIt);
+    return entryIt->results;
+}
+
+void AggregationResultCache::add(const BSONObj& key,
+                                 ReadVersions versions,
+                                 std::vector<BSONObj> results,
+                                 Date_t now) {
+    const auto maxBytes = internalQueryAggregationResultCacheMaxBytes.load();
+    Entry entry{key.getOwned(), std::move(versions), std::move(results), now};
+    const auto bytes = _cachedBytes(entry);
+    if (static_cast<long long>(bytes) > maxBytes / kMaxResultsFraction) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _catchUpWithMissedWrites(lk);
+    if (_isStale(lk, entry.versions)) {
+        // A collection was written to while the aggregation was running.
+        return;
+    }
+
+    if (auto it = _index.find(entry.key); it != _index.end()) {
+        _erase(lk, it->second);
+    }
+
+    _entries.push_back(std::move(entry));
+    _index.emplace(_entries.back().key, std::prev(_entries.end()));
+    _bytes += bytes;
+
+    while (!_entries.empty() && _bytes > static_cast<size_t>(std::max(0LL, maxBytes))) {
+        _erase(lk, _entries.begin());
+    }
+}
+
+void AggregationResultCache::onWrite(const NamespaceString& nss) {
+    if (!enabled()) {
+        if (!_missedWrites.loadRelaxed()) {
+            _missedWrites.store(true);
+        }
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _writeVersions[nss.ns()] = ++_clock;
+}
+
+void AggregationResultCache::invalidateAll() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _invalidateAll(lk);
+}
+
+void AggregationResultCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _index.clear();
+    _entries.clear();
+    _bytes = 0;
+}
+
+size_t AggregationResultCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+size_t AggregationResultCache::_cachedBytes(const Entry& entry) {
+    size_t bytes = sizeof(Entry) + entry.key.objsize();
+    for (auto&& [ns, version] : entry.versions.namespaces) {
+        bytes += sizeof(std::pair<std::string, uint64_t>) + ns.size();
+    }
+    for (auto&& result : entry.results) {
+        bytes += sizeof(BSONObj) + result.objsize();
+    }
+    return bytes;
+}
+
+bool AggregationResultCache::_isExpired(const Entry& entry, Date_t now) {
+    const auto expiryMillis = internalQueryAggregationResultCacheExpiryMillis.load();
+    return expiryMillis > 0 && now - entry.cachedAt >= Milliseconds(expiryMillis);
+}
+
+bool AggregationResultCache::_isStale(WithLock, const ReadVersions& versions) const {
+    if (versions.epoch != _epoch) {
+        return true;
+    }
+    return std::any_of(
+        versions.namespaces.begin(), versions.namespaces.end(), [&](const auto& nsAndVersion) {
+            auto it = _writeVersions.find(nsAndVersion.first);
+            return (it == _writeVersions.end() ? 0 : it->second) != nsAndVersion.second;
+        });
+}
+
+void AggregationResultCache::_catchUpWithMissedWrites(WithLock lk) {
+    if (_missedWrites.load()) {
+        _missedWrites.store(false);
+        _invalidateAll(lk);
+    }
+}
+
+void AggregationResultCache::_invalidateAll(WithLock lk) {
+    ++_epoch;
+    aggregationResultCacheInvalidations.increment(_entries.size());
+    _index.clear();
+    _entries.clear();
+    _bytes = 0;
+}
+
+void AggregationResultCache::_erase(WithLock, std::list<Entry>::iterator it) {
+    _bytes -= _cachedBytes(*it);
+    _index.erase(it->key);
+    _entries.erase(it);
+}
+}  // namespace mongo
@@ -0,0 +1,178 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * A process-wide cache of the results of read-only aggregations which return all their results in
+ * their first batch, so that an aggregation repeated before any of the collections it reads is
+ * written to can be answered with the cached batch instead of being executed again.
+ *
+ * The cache tracks a write version for every namespace which is written to, which is bumped by
+ * the AggregationResultCacheOpObserver once each write commits. An aggregation takes the write
+ * versions of the namespaces it reads before it starts reading them, and its results are cached
+ * along with these versions; a cached result is only returned as long as none of the versions
+ * has changed since, so that it is never older than the data a new execution could observe. Events
+ * which may change any collection, such as a rollback, bump an epoch shared by all the entries.
+ *
+ * Entries also expire after 'internalQueryAggregationResultCacheExpiryMillis', if non-zero, and
+ * the least recently used entries are evicted once the size of the cache exceeds
+ * 'internalQueryAggregationResultCacheMaxBytes'. A size of zero disables the cache.
+ */
+class AggregationResultCache {
+    AggregationResultCache(const AggregationResultCache&) = delete;
+    AggregationResultCache& operator=(const AggregationResultCache&) = delete;
+
+public:
+    /**
+     * The write versions of the namespaces read by an aggregation, as of before it read them.
+     */
+    struct ReadVersions {
+        uint64_t epoch = 0;
+        std::vector<std::pair<std::string, uint64_t>> namespaces;
+    };
+
+    /**
+     * Returns the cache shared by all the operations of the process.
+     */
+    static AggregationResultCache& get();
+
+    /**
+     * Returns whether the cache is enabled.
+     */
+    static bool enabled();
+
+    /**
+     * Returns whether the results of an aggregation running 'pipeline' with the variables
+     * 'letParameters' only depend on the contents of the collections it reads, i.e. whether the
+     * pipeline neither writes, nor reads any state other than collections, nor uses random values
+     * or the current time.
+     */
+    static bool isCacheablePipeline(const std::vector<BSONObj>& pipeline,
+                                    const BSONObj& letParameters);
+
+    AggregationResultCache() = default;
+
+    /**
+     * Returns the current write versions of 'namespaces'. Must be called before the aggregation
+     * whose results are to be cached opens any storage snapshot.
+     */
+    ReadVersions getReadVersions(const std::vector<NamespaceString>& namespaces);
+
+    /**
+     * Returns the results cached under 'key', provided they have not expired by 'now' and none of
+     * the namespaces they were read from has been written to since.
+     */
+    boost::optional<std::vector<BSONObj>> find(const BSONObj& key, Date_t now);
+
+    /**
+     * Caches the complete results 'results' of the aggregation identified by 'key', which read
+     * its namespaces at 'versions', then evicts the least recently used entries until the cache
+     * fits within its size limit. Results which are large relative to the limit, or which were
+     * already stale by the time they were computed, are not cached.
+     */
+    void add(const BSONObj& key,
+             ReadVersions versions,
+             std::vector<BSONObj> results,
+             Date_t now);
+
+    /**
+     * Records that a write to 'nss' has committed, which invalidates the results read from it.
+     */
+    void onWrite(const NamespaceString& nss);
+
+    /**
+     * Invalidates all the cached results, and those of the aggregations currently running.
+     */
+    void invalidateAll();
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        BSONObj key;
+        ReadVersions versions;
+        std::vector<BSONObj> results;
+        Date_t cachedAt;
+    };
+
+    // Returns the amount of memory accounted for 'entry'.
+    static size_t _cachedBytes(const Entry& entry);
+
+    // Returns whether 'entry' has expired by 'now'.
+    static bool _isExpired(const Entry& entry, Date_t now);
+
+    // Returns whether any of the namespaces read for 'versions' has been written to since.
+    bool _isStale(WithLock, const ReadVersions& versions) const;
+
+    // Invalidates everything if writes were committed while the cache was disabled.
+    void _catchUpWithMissedWrites(WithLock);
+
+    void _invalidateAll(WithLock);
+
+    void _erase(WithLock, std::list<Entry>::iterator it);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("AggregationResultCache::_mutex");
+
+    // The entries from least to most recently used, and an index of them by key.
+    std::list<Entry> _entries;
+    BSONObjIndexedMap<std::list<Entry>::iterator> _index =
+        SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<std::list<Entry>::iterator>();
+    size_t _bytes = 0;
+
+    // The write version of every namespace written to since startup. Versions are taken from a
+    // single clock so that they are never reused, even across an epoch change.
+    StringMap<uint64_t> _writeVersions;
+    uint64_t _clock = 0;
+    uint64_t _epoch = 0;
+
+    // Writes are not tracked while the cache is disabled, so this records that some were missed
+    // and the cached results must be invalidated before the cache is used again.
+    AtomicWord<bool> _missedWrites{false};
+};
+}  // namespace mongo
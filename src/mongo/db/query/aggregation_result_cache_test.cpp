@@ -0,0 +1,209 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/query/aggregation_result_cache.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+const NamespaceString kForeignNss("test.foreign");
+const NamespaceString kOtherNss("test.other");
+
+class AggregationResultCacheTest : public unittest::Test {
+public:
+    AggregationResultCacheTest() {
+        internalQueryAggregationResultCacheMaxBytes.store(1024 * 1024);
+    }
+
+    ~AggregationResultCacheTest() {
+        internalQueryAggregationResultCacheMaxBytes.store(0);
+        internalQueryAggregationResultCacheExpiryMillis.store(0);
+    }
+
+    /**
+     * Caches 'results' under 'key' as read from 'kNss' and 'kForeignNss' by an aggregation which
+     * saw no concurrent write.
+     */
+    void addResults(const BSONObj& key, std::vector<BSONObj> results, Date_t now = Date_t()) {
+        auto versions = cache.getReadVersions({kNss, kForeignNss});
+        cache.add(key, std::move(versions), std::move(results), now);
+    }
+
+    AggregationResultCache cache;
+};
+
+std::vector<BSONObj> makeResults(int count) {
+    std::vector<BSONObj> results;
+    for (int i = 0; i < count; ++i) {
+        results.push_back(BSON("_id" << i));
+    }
+    return results;
+}
+
+TEST_F(AggregationResultCacheTest, ReturnsCachedResults) {
+    const auto key = BSON("pipeline" << BSON_ARRAY(BSON("$match" << BSON("a" << 1))));
+    ASSERT_FALSE(cache.find(key, Date_t()));
+
+    addResults(key, makeResults(3));
+    auto results = cache.find(key, Date_t());
+    ASSERT(results);
+    ASSERT_EQ(results->size(), 3U);
+    ASSERT_BSONOBJ_EQ(results->back(), BSON("_id" << 2));
+
+    ASSERT_FALSE(cache.find(BSON("pipeline" << BSONArray()), Date_t()));
+}
+
+TEST_F(AggregationResultCacheTest, WriteToReadNamespaceInvalidatesResults) {
+    const auto key = BSON("k" << 1);
+    addResults(key, makeResults(1));
+
+    cache.onWrite(kOtherNss);
+    ASSERT(cache.find(key, Date_t()));
+
+    cache.onWrite(kForeignNss);
+    ASSERT_FALSE(cache.find(key, Date_t()));
+    ASSERT_EQ(cache.size(), 0U);
+
+    // The results computed after the write are cached again.
+    addResults(key, makeResults(1));
+    ASSERT(cache.find(key, Date_t()));
+}
+
+TEST_F(AggregationResultCacheTest, DoesNotCacheResultsReadConcurrentlyWithAWrite) {
+    const auto key = BSON("k" << 1);
+    auto versions = cache.getReadVersions({kNss});
+    cache.onWrite(kNss);
+    cache.add(key, std::move(versions), makeResults(1), Date_t());
+    ASSERT_FALSE(cache.find(key, Date_t()));
+}
+
+TEST_F(AggregationResultCacheTest, InvalidateAllInvalidatesCachedAndRunningAggregations) {
+    const auto key = BSON("k" << 1);
+    const auto otherKey = BSON("k" << 2);
+    addResults(key, makeResults(1));
+    auto versions = cache.getReadVersions({kNss});
+
+    cache.invalidateAll();
+    ASSERT_FALSE(cache.find(key, Date_t()));
+
+    cache.add(otherKey, std::move(versions), makeResults(1), Date_t());
+    ASSERT_FALSE(cache.find(otherKey, Date_t()));
+}
+
+TEST_F(AggregationResultCacheTest, WritesWhileDisabledInvalidateResultsOnceReenabled) {
+    const auto key = BSON("k" << 1);
+    addResults(key, makeResults(1));
+
+    internalQueryAggregationResultCacheMaxBytes.store(0);
+    cache.onWrite(kOtherNss);
+    internalQueryAggregationResultCacheMaxBytes.store(1024 * 1024);
+
+    ASSERT_FALSE(cache.find(key, Date_t()));
+}
+
+TEST_F(AggregationResultCacheTest, ResultsExpireOnlyIfExpiryIsSet) {
+    const auto key = BSON("k" << 1);
+    const auto start = Date_t() + Hours(1);
+    addResults(key, makeResults(1), start);
+    ASSERT(cache.find(key, start + Hours(24)));
+
+    internalQueryAggregationResultCacheExpiryMillis.store(100);
+    ASSERT(cache.find(key, start + Milliseconds(99)));
+    ASSERT_FALSE(cache.find(key, start + Milliseconds(100)));
+}
+
+TEST_F(AggregationResultCacheTest, EvictsLeastRecentlyUsedResults) {
+    // Fill the cache until it starts evicting, using the first entry after every other one is
+    // added so that the second entry is the least recently used.
+    std::vector<BSONObj> keys{BSON("k" << 0)};
+    addResults(keys[0], makeResults(100));
+    while (cache.size() == keys.size()) {
+        ASSERT_LT(keys.size(), 10000U);
+        keys.push_back(BSON("k" << static_cast<int>(keys.size())));
+        addResults(keys.back(), makeResults(100));
+        ASSERT(cache.find(keys[0], Date_t()));
+    }
+
+    ASSERT_EQ(cache.size(), keys.size() - 1);
+    ASSERT_FALSE(cache.find(keys[1], Date_t()));
+    ASSERT(cache.find(keys[2], Date_t()));
+    ASSERT(cache.find(keys.back(), Date_t()));
+}
+
+TEST_F(AggregationResultCacheTest, DoesNotCacheResultsWhichAreLargeRelativeToTheLimit) {
+    internalQueryAggregationResultCacheMaxBytes.store(16 * 1024);
+    addResults(BSON("k" << 1), makeResults(100));
+    ASSERT_EQ(cache.size(), 0U);
+}
+
+TEST(AggregationResultCacheIsCacheablePipelineTest, AcceptsPipelinesWhichOnlyReadCollections) {
+    ASSERT(AggregationResultCache::isCacheablePipeline(
+        {fromjson("{$match: {a: {$gt: 1}}}"),
+         fromjson("{$lookup: {from: 'foreign', localField: 'a', foreignField: 'b', as: 'c'}}"),
+         fromjson("{$group: {_id: '$a', n: {$sum: 1}}}"),
+         fromjson("{$project: {d: {$concat: ['$$ROOT.a', 'NOW']}}}")},
+        BSON("x" << 1)));
+}
+
+TEST(AggregationResultCacheIsCacheablePipelineTest, RejectsPipelinesWhichWrite) {
+    ASSERT_FALSE(AggregationResultCache::isCacheablePipeline({fromjson("{$out: 'target'}")}, {}));
+    ASSERT_FALSE(
+        AggregationResultCache::isCacheablePipeline({fromjson("{$merge: {into: 'target'}}")}, {}));
+}
+
+TEST(AggregationResultCacheIsCacheablePipelineTest, RejectsNonDeterministicPipelines) {
+    ASSERT_FALSE(AggregationResultCache::isCacheablePipeline(
+        {fromjson("{$sample: {size: 1}}")}, {}));
+    ASSERT_FALSE(AggregationResultCache::isCacheablePipeline(
+        {fromjson("{$project: {r: {$add: [1, {$rand: {}}]}}}")}, {}));
+    ASSERT_FALSE(AggregationResultCache::isCacheablePipeline(
+        {fromjson("{$match: {$expr: {$lt: ['$date', '$$NOW']}}}")}, {}));
+    ASSERT_FALSE(AggregationResultCache::isCacheablePipeline(
+        {fromjson("{$lookup: {from: 'f', pipeline: [{$match: {$sampleRate: 0.5}}], as: 'c'}}")},
+        {}));
+    ASSERT_FALSE(AggregationResultCache::isCacheablePipeline(
+        {fromjson("{$match: {}}")}, BSON("t" << "$$CLUSTER_TIME")));
+}
+
+TEST(AggregationResultCacheIsCacheablePipelineTest, RejectsPipelinesWhichReadOtherState) {
+    ASSERT_FALSE(AggregationResultCache::isCacheablePipeline({fromjson("{$indexStats: {}}")}, {}));
+    ASSERT_FALSE(AggregationResultCache::isCacheablePipeline(
+        {fromjson("{$unionWith: {coll: 'f', pipeline: [{$collStats: {count: {}}}]}}")}, {}));
+    ASSERT_FALSE(AggregationResultCache::isCacheablePipeline(
+        {fromjson("{$_internalInhibitOptimization: {}}")}, {}));
+}
+
+}  // namespace
+}  // namespace mongo
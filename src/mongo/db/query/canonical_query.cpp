@@ -43,6 +43,7 @@
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/input_params.h"
 #include "mongo/db/query/projection_parser.h"
 #include "mongo/db/query/query_planner_common.h"
 
@@ -275,6 +276,10 @@ void CanonicalQuery::setCollator(std::unique_ptr<CollatorInterface> collator) {
     _root->setCollator(collatorRaw);
 }
 
+void CanonicalQuery::parameterize() {
+    _numInputParams = input_params::parameterize(_root.get());
+}
+
 // static
 bool CanonicalQuery::isSimpleIdQuery(const BSONObj& query) {
     bool hasID = false;
@@ -187,6 +187,21 @@ public:
      */
     void setCollator(std::unique_ptr<CollatorInterface> collator);
 
+    /**
+     * Marks the literals of the filter which can be bound to a plan at runtime as input parameters,
+     * see input_params::parameterize(). A plan built for a parameterized query can be reused by
+     * other queries of the same parameterized shape. Must be called before the query is planned.
+     */
+    void parameterize();
+
+    /**
+     * Returns the number of input parameters of this query, which is zero unless parameterize()
+     * has been called.
+     */
+    size_t numInputParams() const {
+        return _numInputParams;
+    }
+
     // Debugging
     std::string toString() const;
     std::string toStringShort() const;
@@ -247,6 +262,8 @@ private:
     QueryMetadataBitSet _metadataDeps;
 
     bool _canHaveNoopMatchNodes = false;
+
+    size_t _numInputParams = 0;
 };
 
 }  // namespace mongo
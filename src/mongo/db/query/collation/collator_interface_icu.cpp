@@ -34,7 +34,6 @@
 #include <memory>
 
 #include <unicode/coll.h>
-#include <unicode/sortkey.h>
 
 #include "mongo/util/assert_util.h"
 
@@ -78,25 +77,32 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
 
-    UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
+    const auto unicodeString = icu::UnicodeString::fromUTF8(stringPiece);
+
+    // Write the sort key straight into the string which becomes the comparison key, rather than
+    // into an icu::CollationKey which would then have to be copied. The bytes are the same. The
+    // initial size fits the sort keys of most strings, so that ICU rarely has to run twice.
+    std::string key(stringData.size() * 3 + 16, '\0');
+    auto writeSortKey = [&] {
+        return _collator->getSortKey(
+            unicodeString, reinterpret_cast<uint8_t*>(&key[0]), static_cast<int32_t>(key.size()));
+    };
+    int32_t keyLength = writeSortKey();
+    if (static_cast<size_t>(keyLength) > key.size()) {
+        key.resize(keyLength);
+        keyLength = writeSortKey();
+    }
 
     // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
-    // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
-    // expected when a memory allocation fails inside ICU, which we consider fatal to the process.
-    fassert(34439, U_SUCCESS(status));
-
-    int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
-    invariant(keyLength > 0);
-    invariant(keyBuffer);
+    // subsequences are weighted as the replacement character, U+FFFD). ICU only fails to produce a
+    // sort key when a memory allocation fails, which we consider fatal to the process.
+    fassert(34439, keyLength > 0 && static_cast<size_t>(keyLength) <= key.size());
 
     // The last byte of the sort key should always be null. When we construct the comparison key, we
     // omit the trailing null byte.
-    invariant(keyBuffer[keyLength - 1u] == '\0');
-    const char* charBuffer = reinterpret_cast<const char*>(keyBuffer);
-    return makeComparisonKey(std::string(charBuffer, keyLength - 1u));
+    invariant(key[keyLength - 1u] == '\0');
+    key.resize(keyLength - 1u);
+    return makeComparisonKey(std::move(key));
 }
 
 }  // namespace mongo
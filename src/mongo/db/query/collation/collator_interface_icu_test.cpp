@@ -34,6 +34,7 @@
 #include <iomanip>
 #include <iostream>
 #include <unicode/coll.h>
+#include <unicode/sortkey.h>
 
 #include "mongo/unittest/unittest.h"
 
@@ -594,4 +595,35 @@ TEST(CollatorInterfaceICUTest, ComparisonKeysForFrCaCollatorCorrect) {
               "\x2D\x45\x4F\x31\x01\x88\x44\x8E\x06\x01\x0A");
 }
 
+TEST(CollatorInterfaceICUTest, ComparisonKeysMatchICUSortKeysOfAnyLength) {
+    CollationSpec collationSpec;
+    collationSpec.localeID = "en_US";
+
+    UErrorCode status = U_ZERO_ERROR;
+    std::unique_ptr<icu::Collator> coll(
+        icu::Collator::createInstance(icu::Locale("en", "US"), status));
+    ASSERT(U_SUCCESS(status));
+
+    // At identical strength the sort key has the most levels, so it is longest.
+    coll->setStrength(icu::Collator::IDENTICAL);
+    std::unique_ptr<icu::Collator> reference(coll->clone());
+    CollatorInterfaceICU icuCollator(collationSpec, std::move(coll));
+
+    std::string longString;
+    for (int i = 0; i < 200; ++i) {
+        longString += "Ab\xC3\xA9\xE4\xB8\xAD";
+    }
+
+    for (auto&& str : std::vector<std::string>{"", "a", "c\xC3\xB4t\xC3\xA9", longString}) {
+        icu::CollationKey expectedKey;
+        reference->getCollationKey(icu::UnicodeString::fromUTF8(str), expectedKey, status);
+        ASSERT(U_SUCCESS(status));
+
+        int32_t expectedLength;
+        const uint8_t* expectedBytes = expectedKey.getByteArray(expectedLength);
+        ASSERT_EQ(icuCollator.getComparisonKey(str).getKeyData(),
+                  StringData(reinterpret_cast<const char*>(expectedBytes), expectedLength - 1));
+    }
+}
+
 }  // namespace
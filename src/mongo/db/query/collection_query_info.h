@@ -30,9 +30,11 @@
 #pragma once
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/query/histogram_cache.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -62,11 +64,22 @@ public:
      */
     PlanCache* getPlanCache() const;
 
+    /**
+     * Get the histograms of the fields of this collection.
+     */
+    HistogramCache* getHistogramCache() const;
+
     /* get set of index keys for this namespace.  handy to quickly check if a given
        field is indexed (Note it might be a secondary component of a compound index.)
     */
     const UpdateIndexData& getIndexKeys(OperationContext* opCtx) const;
 
+    /**
+     * Returns the paths indexed by the index named 'indexName' alone, or nullptr if that index was
+     * not known when the index keys were last computed.
+     */
+    const UpdateIndexData* getIndexKeys(OperationContext* opCtx, StringData indexName) const;
+
     /**
      * Builds internal cache state based on the current state of the Collection's IndexCatalog.
      */
@@ -105,9 +118,13 @@ private:
     // ---  index keys cache
     bool _keysComputed;
     UpdateIndexData _indexedPaths;
+    StringMap<UpdateIndexData> _indexedPathsByIndex;
 
     // A cache for query plans. Shared across cloned Collection instances.
     std::shared_ptr<PlanCache> _planCache;
+
+    // The histograms of the collection's fields. Shared across cloned Collection instances.
+    std::shared_ptr<HistogramCache> _histogramCache;
 };
 
 }  // namespace mongo
@@ -275,6 +275,17 @@ StatusWith<CursorResponse> CursorResponse::parseFromBSON(const BSONObj& cmdRespo
              partialResultsReturned.trueValue()}};
 }
 
+std::size_t CursorResponse::estimateBatchBytes(const std::vector<BSONObj>& batch) {
+    // Each document is preceded by its type byte and its NUL-terminated array index, of at most 7
+    // digits since a batch of documents fits in 16MB.
+    const std::size_t kMaxArrayElementOverheadBytes = 1 + 8;
+    std::size_t bytes = BSONObj().objsize();
+    for (const auto& obj : batch) {
+        bytes += obj.objsize() + kMaxArrayElementOverheadBytes;
+    }
+    return bytes;
+}
+
 void CursorResponse::addToBSON(CursorResponse::ResponseType responseType,
                                BSONObjBuilder* builder) const {
     BSONObjBuilder cursorBuilder(builder->subobjStart(kCursorField));
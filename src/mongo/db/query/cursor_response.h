@@ -184,6 +184,13 @@ public:
         return uassertStatusOK(parseFromBSON(cmdResponse));
     }
 
+    /**
+     * Returns an upper bound on the number of bytes that the array of the documents in 'batch'
+     * takes up in a cursor reply. Reserving this much in the reply buffer up front spares copying
+     * the batch each time the buffer would otherwise grow.
+     */
+    static std::size_t estimateBatchBytes(const std::vector<BSONObj>& batch);
+
     /**
      * Constructs an empty cursor response.
      */
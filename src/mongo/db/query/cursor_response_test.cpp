@@ -344,6 +344,18 @@ TEST(CursorResponseTest, addToBSONSubsequentResponse) {
     ASSERT_BSONOBJ_EQ(responseObj, expectedResponse);
 }
 
+TEST(CursorResponseTest, estimateBatchBytesBoundsBatchArraySize) {
+    std::vector<BSONObj> batch;
+    ASSERT_GTE(CursorResponse::estimateBatchBytes(batch), size_t(BSONArray().objsize()));
+
+    BSONArrayBuilder arrayBuilder;
+    for (int i = 0; i < 1000; ++i) {
+        batch.push_back(BSON("_id" << i << "s" << std::string(i % 10, 'x')));
+        arrayBuilder.append(batch.back());
+    }
+    ASSERT_GTE(CursorResponse::estimateBatchBytes(batch), size_t(arrayBuilder.arr().objsize()));
+}
+
 TEST(CursorResponseTest, serializePostBatchResumeToken) {
     std::vector<BSONObj> batch = {BSON("_id" << 1), BSON("_id" << 2)};
     auto postBatchResumeToken =
@@ -181,6 +181,10 @@ void generateSinglePlanExecutionInfo(const PlanExplainer::PlanStatsDetails& deta
         out->appendBool("failed", true);
     }
 
+    if (summary->planPruned) {
+        out->appendBool("pruned", true);
+    }
+
     // Add the tree of stages, with individual execution stats for each stage.
     out->append("executionStages", stats);
 }
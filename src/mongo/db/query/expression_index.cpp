@@ -37,6 +37,7 @@
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs_gen.h"
+#include "mongo/db/query/s2_covering_cache.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -107,7 +108,8 @@ void ExpressionMapping::cover2d(const R2Region& region,
     GeoHashsToIntervalsWithParents(unorderedCovering, oilOut);
 }
 
-std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region,
+                                                             StringData regionKey) {
     auto minLevel = gInternalQueryS2GeoCoarsestLevel.load();
     auto maxLevel = gInternalQueryS2GeoFinestLevel.load();
 
@@ -120,15 +122,28 @@ std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& reg
     coverer.set_max_level(maxLevel);
     coverer.set_max_cells(gInternalQueryS2GeoMaxCells.load());
 
+    auto cache = regionKey.empty() ? nullptr : S2CoveringCache::get();
+    std::string key;
+    if (cache) {
+        key = S2CoveringCache::makeKey(coverer, regionKey);
+        if (auto cover = cache->find(key)) {
+            return std::move(*cover);
+        }
+    }
+
     std::vector<S2CellId> cover;
     coverer.GetCovering(region, &cover);
+    if (cache) {
+        cache->add(key, cover);
+    }
     return cover;
 }
 
 void ExpressionMapping::cover2dsphere(const S2Region& region,
                                       const S2IndexingParams& indexingParams,
-                                      OrderedIntervalList* oilOut) {
-    std::vector<S2CellId> cover = get2dsphereCovering(region);
+                                      OrderedIntervalList* oilOut,
+                                      StringData regionKey) {
+    std::vector<S2CellId> cover = get2dsphereCovering(region, regionKey);
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
@@ -63,7 +63,12 @@ public:
                         int maxCoveringCells,
                         OrderedIntervalList* oilOut);
 
-    static std::vector<S2CellId> get2dsphereCovering(const S2Region& region);
+    /**
+     * Returns a covering of 'region'. If 'regionKey' is non-empty, it must determine the region,
+     * and the covering is looked up in and added to the S2CoveringCache under that key.
+     */
+    static std::vector<S2CellId> get2dsphereCovering(const S2Region& region,
+                                                     StringData regionKey = StringData());
 
     static void S2CellIdsToIntervals(const std::vector<S2CellId>& intervalSet,
                                      const S2IndexVersion indexVersion,
@@ -77,7 +82,8 @@ public:
 
     static void cover2dsphere(const S2Region& region,
                               const S2IndexingParams& indexParams,
-                              OrderedIntervalList* oilOut);
+                              OrderedIntervalList* oilOut,
+                              StringData regionKey = StringData());
 };
 
 }  // namespace mongo
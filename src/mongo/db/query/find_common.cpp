@@ -37,9 +37,11 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -78,6 +80,11 @@ bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int
     return (bytesBuffered + nextDoc.objsize()) <= kMaxBytesToReturnToClientAtOnce;
 }
 
+bool FindCommon::batchTimeBudgetExhausted(const Timer& batchTimer, long long numDocs) {
+    const auto budgetMillis = internalQueryFindBatchTimeBudgetMillis.load();
+    return budgetMillis > 0 && numDocs > 0 && batchTimer.millis() >= budgetMillis;
+}
+
 void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx, const CanonicalQuery& cq) {
     auto whileWaitingFunc = [&, hasLogged = false]() mutable {
         if (!std::exchange(hasLogged, true)) {
@@ -55,6 +55,7 @@ extern const OperationContext::Decoration<AwaitDataState> awaitDataState;
 class BSONObj;
 class CanonicalQuery;
 class QueryRequest;
+class Timer;
 
 // Failpoint for making find hang.
 extern FailPoint waitInFindBeforeMakingBatch;
@@ -120,6 +121,15 @@ public:
      */
     static bool haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered);
 
+    /**
+     * Returns true if a batch which already holds 'numDocs' documents has been filling for at
+     * least internalQueryFindBatchTimeBudgetMillis since 'batchTimer' started, and so should be
+     * returned to the client rather than filled up to its batchSize or the maximum response size.
+     * Always returns false for an empty batch, so that every batch makes progress, and when the
+     * time budget is disabled.
+     */
+    static bool batchTimeBudgetExhausted(const Timer& batchTimer, long long numDocs);
+
     /**
      * This function wraps waitWhileFailPointEnabled() on waitInFindBeforeMakingBatch.
      *
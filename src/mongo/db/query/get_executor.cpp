@@ -41,6 +41,7 @@
 #include "mongo/base/parse_number.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/exec/cached_plan.h"
+#include "mongo/db/exec/clustered_idhack.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/count.h"
 #include "mongo/db/exec/delete.h"
@@ -61,6 +62,7 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_access_method.h"
 #include "mongo/db/index_names.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/query/canonical_query.h"
@@ -71,6 +73,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_cost_estimator.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
@@ -83,6 +86,7 @@
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/query/query_settings_decoration.h"
 #include "mongo/db/query/sbe_cached_solution_planner.h"
+#include "mongo/db/query/sbe_compiled_plan_cache.h"
 #include "mongo/db/query/sbe_multi_planner.h"
 #include "mongo/db/query/sbe_sub_planner.h"
 #include "mongo/db/query/stage_builder_util.h"
@@ -153,6 +157,32 @@ bool isIdHackEligibleQuery(const CollectionPtr& collection, const CanonicalQuery
         !query.getQueryRequest().isTailable() &&
         CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
 }
+
+/**
+ * Returns 'true' if 'query' on the given 'collection' is an _id $in which can be answered using a
+ * batched IDHACK plan. The values are looked up by their _id index keys, so both the collection and
+ * the query must have the simple collation. Since the batch is returned in RecordId order, the
+ * query cannot have a sort or a limit either.
+ */
+bool isBatchedIdHackEligibleQuery(const CollectionPtr& collection, const CanonicalQuery& query) {
+    const auto& qr = query.getQueryRequest();
+    if (qr.showRecordId() || !qr.getHint().isEmpty() || !qr.getMin().isEmpty() ||
+        !qr.getMax().isEmpty() || qr.getSkip() || qr.getLimit() || qr.getNToReturn() ||
+        !qr.getSort().isEmpty() || qr.isTailable() || query.getCollator() ||
+        collection->getDefaultCollator()) {
+        return false;
+    }
+
+    const auto root = query.root();
+    if (root->matchType() != MatchExpression::MATCH_IN || root->path() != "_id"_sd) {
+        return false;
+    }
+
+    const auto inExpr = static_cast<const InMatchExpression*>(root);
+    return inExpr->getRegexes().empty() && !inExpr->getEqualities().empty() &&
+        inExpr->getEqualities().size() <=
+        static_cast<size_t>(internalQueryMaxBatchedIdHackKeys.load());
+}
 }  // namespace
 
 bool isAnyComponentOfPathMultikey(const BSONObj& indexKeyPattern,
@@ -576,8 +606,11 @@ public:
 
         const IndexDescriptor* idIndexDesc = _collection->getIndexCatalog()->findIdIndex(_opCtx);
 
-        // If we have an _id index we can use an idhack plan.
-        if (idIndexDesc && isIdHackEligibleQuery(_collection, *_cq)) {
+        // If we have an _id index, or the collection is clustered by _id, we can use an idhack
+        // plan.
+        if ((idIndexDesc || _collection->getRecordStore()->isClustered()) &&
+            (isIdHackEligibleQuery(_collection, *_cq) ||
+             isBatchedIdHackEligibleQuery(_collection, *_cq))) {
             LOGV2_DEBUG(
                 20922, 2, "Using idhack", "canonicalQuery"_attr = redact(_cq->toStringShort()));
             // If an IDHACK plan is not supported, we will use the normal plan generation process
@@ -622,8 +655,7 @@ public:
                                     "query"_attr = redact(_cq->toStringShort()));
                     }
 
-                    return buildCachedPlan(
-                        std::move(querySolution), plannerParams, cs->decisionWorks);
+                    return buildCachedPlan(std::move(querySolution), plannerParams, *cs);
                 }
             }
         }
@@ -666,6 +698,29 @@ public:
             }
         }
 
+        // Drop the candidates which the histograms show to be far more expensive than the best one
+        // before they are run in the multi-planner. Without a sort or a limit, each candidate has
+        // to produce the same set of documents, so its cost doesn't depend on when it is stopped.
+        const auto& qr = _cq->getQueryRequest();
+        if (solutions.size() > 1 && internalQueryPlannerPruneWithHistograms.load() &&
+            qr.getSort().isEmpty() && !qr.getLimit() && !qr.getNToReturn()) {
+            auto numPruned = plan_cost_estimator::pruneCandidates(
+                &solutions,
+                _collection->numRecords(_opCtx),
+                [&](StringData path) {
+                    return CollectionQueryInfo::get(_collection)
+                        .getHistogramCache()
+                        ->get(_opCtx, _collection, path);
+                },
+                internalQueryPlannerHistogramPruneRatio.load());
+            LOGV2_DEBUG(5843228,
+                        2,
+                        "Pruned candidate plans using histograms",
+                        "query"_attr = redact(_cq->toStringShort()),
+                        "numPruned"_attr = numPruned,
+                        "numRemaining"_attr = solutions.size());
+        }
+
         if (1 == solutions.size()) {
             auto result = makeResult();
             // Only one possible plan. Run it. Build the stages from the solution.
@@ -716,7 +771,7 @@ protected:
      */
     virtual std::unique_ptr<ResultType> buildCachedPlan(std::unique_ptr<QuerySolution> solution,
                                                         const QueryPlannerParams& plannerParams,
-                                                        size_t decisionWorks) = 0;
+                                                        const CachedSolution& cachedSolution) = 0;
 
     /**
      * Constructs a special PlanStage tree for rooted $or queries. Each clause of the $or is planned
@@ -770,8 +825,14 @@ protected:
     std::unique_ptr<ClassicPrepareExecutionResult> buildIdHackPlan(
         const IndexDescriptor* descriptor, QueryPlannerParams* plannerParams) final {
         auto result = makeResult();
-        std::unique_ptr<PlanStage> stage =
-            std::make_unique<IDHackStage>(_cq->getExpCtxRaw(), _cq, _ws, _collection, descriptor);
+        std::unique_ptr<PlanStage> stage;
+        if (descriptor) {
+            stage = std::make_unique<IDHackStage>(
+                _cq->getExpCtxRaw(), _cq, _ws, _collection, descriptor);
+        } else {
+            stage =
+                std::make_unique<ClusteredIdHackStage>(_cq->getExpCtxRaw(), _cq, _ws, _collection);
+        }
 
         // Might have to filter out orphaned docs.
         if (plannerParams->options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
@@ -832,7 +893,7 @@ protected:
     std::unique_ptr<ClassicPrepareExecutionResult> buildCachedPlan(
         std::unique_ptr<QuerySolution> solution,
         const QueryPlannerParams& plannerParams,
-        size_t decisionWorks) final {
+        const CachedSolution& cachedSolution) final {
         auto result = makeResult();
         auto&& root = buildExecutableTree(*solution);
 
@@ -845,7 +906,7 @@ protected:
                                                           _ws,
                                                           _cq,
                                                           plannerParams,
-                                                          decisionWorks,
+                                                          cachedSolution.decisionWorks,
                                                           std::move(root)),
                         std::move(solution));
         return result;
@@ -906,6 +967,11 @@ protected:
 
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildIdHackPlan(
         const IndexDescriptor* descriptor, QueryPlannerParams* plannerParams) final {
+        // A batched _id lookup is planned as an ordinary index scan.
+        if (!isIdHackEligibleQuery(_collection, *_cq)) {
+            return nullptr;
+        }
+
         uassert(4822862,
                 "IDHack plan is not supported by SBE yet",
                 !(_cq->metadataDeps()[DocumentMetadataFields::kSortKey] ||
@@ -918,11 +984,11 @@ protected:
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildCachedPlan(
         std::unique_ptr<QuerySolution> solution,
         const QueryPlannerParams& plannerParams,
-        size_t decisionWorks) final {
+        const CachedSolution& cachedSolution) final {
         auto result = makeResult();
-        auto execTree = buildExecutableTree(*solution, true);
-        result->emplace(std::move(execTree), std::move(solution));
-        result->setDecisionWorks(decisionWorks);
+        result->emplace(buildCachedExecutableTree(*solution, plannerParams, cachedSolution),
+                        std::move(solution));
+        result->setDecisionWorks(cachedSolution.decisionWorks);
         return result;
     }
 
@@ -955,6 +1021,55 @@ private:
         return stage_builder::buildSlotBasedExecutableTree(
             _opCtx, _collection, *_cq, solution, _yieldPolicy, needsTrialRunProgressTracker);
     }
+
+    /**
+     * Builds the plan for a solution recovered from the plan cache, or reuses a clone of the plan
+     * built the last time the same query was answered from the same plan cache entry.
+     */
+    std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
+    buildCachedExecutableTree(const QuerySolution& solution,
+                              const QueryPlannerParams& plannerParams,
+                              const CachedSolution& cachedSolution) const {
+        auto&& compiledPlanCache = sbe::CompiledPlanCache::get();
+        auto key = sbe::CompiledPlanCache::makeKey(
+            *_cq, cachedSolution, solution, plannerParams.options);
+        if (!key) {
+            return buildExecutableTree(solution, true);
+        }
+
+        auto cachedPlan = compiledPlanCache.find(*key);
+        if (cachedPlan && _cq->numInputParams() > 0 &&
+            !stage_builder::bindInputParams(
+                _opCtx, _collection, *_cq, solution, cachedPlan->second.env)) {
+            // The index bounds of this query can't be bound to the cached plan, so this query gets
+            // a plan of its own.
+            cachedPlan = boost::none;
+        }
+
+        if (cachedPlan) {
+            auto&& [root, data] = *cachedPlan;
+            data.trialRunProgressTracker = std::make_unique<TrialRunProgressTracker>(
+                trial_period::getTrialPeriodNumToReturn(*_cq),
+                trial_period::getTrialPeriodMaxWorks(_opCtx, _collection));
+            root->attachToTrialRunTracker(data.trialRunProgressTracker.get());
+            root->attachNewYieldPolicy(_yieldPolicy);
+
+            auto sbeYieldPolicy = dynamic_cast<PlanYieldPolicySBE*>(_yieldPolicy);
+            invariant(sbeYieldPolicy);
+            sbeYieldPolicy->registerPlan(root.get());
+            return std::move(*cachedPlan);
+        }
+
+        auto execTree = buildExecutableTree(solution, true);
+        // A parameterized plan is found by any query of the same shape, so it is only cached if
+        // such a query can bind its values to it. Otherwise every query of the shape would replace
+        // it with a plan of its own.
+        if (_cq->numInputParams() == 0 ||
+            stage_builder::canBindInputParams(solution, execTree.second.env)) {
+            compiledPlanCache.add(*key, *execTree.first, execTree.second);
+        }
+        return execTree;
+    }
 };
 
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getClassicExecutor(
@@ -1062,6 +1177,13 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExe
     size_t plannerOptions) {
     invariant(cq);
     auto nss = cq->nss();
+
+    // Parameterize the query, so that the plan built for it can be reused by the queries which
+    // only differ from it in their literals.
+    if (internalQuerySBECompiledPlanCacheSize.load() > 0 && !nss.isOplog()) {
+        cq->parameterize();
+    }
+
     auto yieldPolicy = makeSbeYieldPolicy(opCtx, requestedYieldPolicy, nss);
     SlotBasedPrepareExecutionHelper helper{
         opCtx, *collection, cq.get(), yieldPolicy.get(), plannerOptions};
@@ -1290,12 +1412,23 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDele
             const bool hasCollectionDefaultCollation = request->getCollation().isEmpty() ||
                 CollatorInterface::collatorsMatch(collator.get(), collection->getDefaultCollator());
 
-            if (descriptor && CanonicalQuery::isSimpleIdQuery(unparsedQuery) &&
+            const bool isClustered = collection->getRecordStore()->isClustered();
+
+            if ((descriptor || isClustered) && CanonicalQuery::isSimpleIdQuery(unparsedQuery) &&
                 request->getProj().isEmpty() && hasCollectionDefaultCollation) {
                 LOGV2_DEBUG(20928, 2, "Using idhack", "query"_attr = redact(unparsedQuery));
 
-                auto idHackStage = std::make_unique<IDHackStage>(
-                    expCtx.get(), unparsedQuery["_id"].wrap(), ws.get(), collection, descriptor);
+                std::unique_ptr<PlanStage> idHackStage;
+                if (descriptor) {
+                    idHackStage = std::make_unique<IDHackStage>(expCtx.get(),
+                                                                unparsedQuery["_id"].wrap(),
+                                                                ws.get(),
+                                                                collection,
+                                                                descriptor);
+                } else {
+                    idHackStage = std::make_unique<ClusteredIdHackStage>(
+                        expCtx.get(), unparsedQuery["_id"].wrap(), ws.get(), collection);
+                }
                 std::unique_ptr<DeleteStage> root =
                     std::make_unique<DeleteStage>(expCtx.get(),
                                                   std::move(deleteStageParams),
@@ -1459,7 +1592,9 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpda
             const bool hasCollectionDefaultCollation = CollatorInterface::collatorsMatch(
                 expCtx->getCollator(), collection->getDefaultCollator());
 
-            if (descriptor && CanonicalQuery::isSimpleIdQuery(unparsedQuery) &&
+            const bool isClustered = collection->getRecordStore()->isClustered();
+
+            if ((descriptor || isClustered) && CanonicalQuery::isSimpleIdQuery(unparsedQuery) &&
                 request->getProj().isEmpty() && hasCollectionDefaultCollation) {
                 LOGV2_DEBUG(20930, 2, "Using idhack", "query"_attr = redact(unparsedQuery));
 
@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/simple_bsonelement_comparator.h"
+
+namespace mongo {
+
+Histogram Histogram::make(std::vector<BSONElement> values,
+                          size_t numDocuments,
+                          size_t maxBuckets) {
+    invariant(maxBuckets > 0);
+    const auto& comparator = SimpleBSONElementComparator::kInstance;
+    std::sort(values.begin(), values.end(), comparator.makeLessThan());
+
+    Histogram histogram;
+    histogram._numValues = values.size();
+    histogram._numDocuments = numDocuments;
+    if (values.empty()) {
+        return histogram;
+    }
+    histogram._minValue = values.front().wrap("");
+
+    // Each run of equal values either closes a bucket, as its upper bound, or joins the range of
+    // the bucket being filled. A bucket is closed once it would hold at least 'depth' values.
+    const double depth = std::ceil(static_cast<double>(values.size()) / maxBuckets);
+    Bucket bucket;
+    for (size_t runStart = 0; runStart < values.size();) {
+        size_t runEnd = runStart + 1;
+        while (runEnd < values.size() &&
+               comparator.evaluate(values[runEnd] == values[runStart])) {
+            ++runEnd;
+        }
+
+        const double runCount = runEnd - runStart;
+        if (bucket.rangeCount + runCount >= depth || runEnd == values.size()) {
+            bucket.upperBound = values[runStart].wrap("");
+            bucket.equalCount = runCount;
+            histogram._buckets.push_back(std::move(bucket));
+            bucket = Bucket();
+        } else {
+            bucket.rangeCount += runCount;
+            bucket.rangeDistinct += 1;
+        }
+        runStart = runEnd;
+    }
+
+    return histogram;
+}
+
+double Histogram::_rank(const BSONElement& value, bool inclusive) const {
+    const auto& comparator = SimpleBSONElementComparator::kInstance;
+    if (_buckets.empty()) {
+        return 0;
+    }
+    const int cmpMin = comparator.compare(value, _minValue.firstElement());
+    if (cmpMin < 0 || (cmpMin == 0 && !inclusive)) {
+        return 0;
+    }
+
+    double rank = 0;
+    BSONElement lowerBound = _minValue.firstElement();
+    for (auto&& bucket : _buckets) {
+        const auto upperBound = bucket.upperBound.firstElement();
+        const int cmp = comparator.compare(value, upperBound);
+        if (cmp == 0) {
+            return rank + bucket.rangeCount + (inclusive ? bucket.equalCount : 0);
+        }
+        if (cmp < 0) {
+            // The value lies within the bucket's range. Numbers are assumed to be spread evenly
+            // across it, and any other value to be halfway through it. The value is assumed to be
+            // as frequent as the range's average distinct value.
+            double fraction = 0.5;
+            if (value.isNumber() && lowerBound.isNumber() && upperBound.isNumber() &&
+                upperBound.numberDouble() > lowerBound.numberDouble()) {
+                fraction = (value.numberDouble() - lowerBound.numberDouble()) /
+                    (upperBound.numberDouble() - lowerBound.numberDouble());
+                fraction = std::max(0.0, std::min(1.0, fraction));
+            }
+            const double below = bucket.rangeCount * fraction;
+            rank += below;
+            if (inclusive && bucket.rangeDistinct > 0) {
+                rank += std::min(bucket.rangeCount - below,
+                                 bucket.rangeCount / bucket.rangeDistinct);
+            }
+            return rank;
+        }
+        rank += bucket.rangeCount + bucket.equalCount;
+        lowerBound = upperBound;
+    }
+    return rank;
+}
+
+double Histogram::estimateSelectivity(const Interval& interval) const {
+    if (!_numValues) {
+        return 0;
+    }
+
+    const Interval ascending =
+        interval.getDirection() == Interval::Direction::kDirectionDescending
+        ? interval.reverseClone()
+        : interval;
+    const double count = _rank(ascending.end, ascending.endInclusive) -
+        _rank(ascending.start, !ascending.startInclusive);
+    return std::max(0.0, std::min(1.0, count / _numValues));
+}
+
+double Histogram::estimateSelectivity(const OrderedIntervalList& oil) const {
+    double selectivity = 0;
+    for (auto&& interval : oil.intervals) {
+        selectivity += estimateSelectivity(interval);
+    }
+    return std::min(1.0, selectivity);
+}
+
+}  // namespace mongo
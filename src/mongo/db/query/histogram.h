@@ -0,0 +1,114 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/db/query/interval.h"
+
+namespace mongo {
+
+/**
+ * An equi-depth histogram of the values of a field, built from a sample of a collection. Each
+ * bucket records how many of the sampled values equal its upper bound, and how many values, and
+ * how many distinct values, lie between the previous bucket's upper bound and its own.
+ *
+ * Values are ordered with the simple comparator, as they are in an index without a collation.
+ */
+class Histogram {
+public:
+    struct Bucket {
+        // The bucket's upper bound, as the only element of an object.
+        BSONObj upperBound;
+
+        // The number of values above the previous bucket's upper bound and below this one's.
+        double rangeCount = 0;
+
+        // The number of distinct values above the previous bucket's upper bound and below this
+        // one's.
+        double rangeDistinct = 0;
+
+        // The number of values equal to the upper bound.
+        double equalCount = 0;
+    };
+
+    /**
+     * Builds a histogram of at most 'maxBuckets' buckets from the values of the field found in
+     * 'numDocuments' sampled documents. A document may have contributed several values, when the
+     * field is an array, or none.
+     */
+    static Histogram make(std::vector<BSONElement> values, size_t numDocuments, size_t maxBuckets);
+
+    /**
+     * Returns the number of sampled values.
+     */
+    double getNumValues() const {
+        return _numValues;
+    }
+
+    /**
+     * Returns the average number of values per sampled document, which is that of index keys per
+     * document for an index on the field.
+     */
+    double getValuesPerDocument() const {
+        return _numDocuments ? _numValues / _numDocuments : 0;
+    }
+
+    const std::vector<Bucket>& getBuckets() const {
+        return _buckets;
+    }
+
+    /**
+     * Returns the estimated fraction of the values which lie within 'interval'. The interval may
+     * be in either direction.
+     */
+    double estimateSelectivity(const Interval& interval) const;
+
+    /**
+     * Returns the estimated fraction of the values which lie within any interval of 'oil'.
+     */
+    double estimateSelectivity(const OrderedIntervalList& oil) const;
+
+private:
+    /**
+     * Returns the estimated number of values below 'value', or below or equal to it if 'inclusive'
+     * is true.
+     */
+    double _rank(const BSONElement& value, bool inclusive) const;
+
+    std::vector<Bucket> _buckets;
+    BSONObj _minValue;
+    double _numValues = 0;
+    double _numDocuments = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/histogram_cache.h"
+
+#include <cstdlib>
+
+#include "mongo/bson/bsonelement_comparator_interface.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+namespace {
+
+std::shared_ptr<const Histogram> buildHistogram(OperationContext* opCtx,
+                                                const CollectionPtr& collection,
+                                                StringData path) {
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return nullptr;
+    }
+
+    // A document without the field contributes a null, as it does to an index on the field.
+    static const BSONObj kNullObj = BSON("" << BSONNULL);
+
+    const long long sampleSize = std::min<long long>(internalQueryHistogramSampleSize.load(),
+                                                     collection->numRecords(opCtx));
+    std::vector<BSONObj> documents;
+    std::vector<BSONElement> values;
+    for (long long i = 0; i < sampleSize; ++i) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        documents.push_back(record->data.releaseToBson().getOwned());
+
+        BSONElementSet elements;
+        dotted_path_support::extractAllElementsAlongPath(documents.back(), path, elements);
+        if (elements.empty()) {
+            values.push_back(kNullObj.firstElement());
+        }
+        values.insert(values.end(), elements.begin(), elements.end());
+    }
+
+    return std::make_shared<const Histogram>(Histogram::make(
+        std::move(values), documents.size(), internalQueryHistogramNumBuckets.load()));
+}
+
+}  // namespace
+
+std::shared_ptr<const Histogram> HistogramCache::get(OperationContext* opCtx,
+                                                     const CollectionPtr& collection,
+                                                     StringData path) {
+    const auto now = Date_t::now();
+    const auto numRecords = collection->numRecords(opCtx);
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _entries.find(path);
+        if (it != _entries.end() &&
+            now - it->second.buildTime <
+                Seconds(internalQueryHistogramRefreshIntervalSecs.load()) &&
+            std::llabs(numRecords - it->second.numRecords) * 10 <= it->second.numRecords) {
+            return it->second.histogram;
+        }
+    }
+
+    // Sample without holding the mutex. Queries racing to refresh the same field each build a
+    // histogram, and the last one built is kept.
+    auto histogram = buildHistogram(opCtx, collection, path);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries[path] = {histogram, now, numRecords};
+    return histogram;
+}
+
+}  // namespace mongo
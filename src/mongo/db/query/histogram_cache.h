@@ -0,0 +1,71 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/query/histogram.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class CollectionPtr;
+class OperationContext;
+
+/**
+ * The histograms of the fields of a collection. A field's histogram is built from a random sample
+ * of the collection's documents when it's first asked for, and rebuilt once it is older than
+ * 'internalQueryHistogramRefreshIntervalSecs' or the collection's size has changed by more than a
+ * tenth since. Shared across cloned Collection instances, like the PlanCache.
+ */
+class HistogramCache {
+public:
+    /**
+     * Returns the histogram of the field at 'path' in 'collection', or nullptr if the collection's
+     * storage engine can't sample it.
+     */
+    std::shared_ptr<const Histogram> get(OperationContext* opCtx,
+                                         const CollectionPtr& collection,
+                                         StringData path);
+
+private:
+    struct Entry {
+        std::shared_ptr<const Histogram> histogram;
+        Date_t buildTime;
+        long long numRecords = 0;
+    };
+
+    Mutex _mutex = MONGO_MAKE_LATCH("HistogramCache::_mutex");
+    StringMap<Entry> _entries;
+};
+
+}  // namespace mongo
@@ -0,0 +1,165 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/histogram.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Builds a histogram of the values of 'a' in 'docs'.
+ */
+Histogram makeHistogram(const std::vector<BSONObj>& docs, size_t maxBuckets) {
+    std::vector<BSONElement> values;
+    for (auto&& doc : docs) {
+        values.push_back(doc["a"]);
+    }
+    return Histogram::make(std::move(values), docs.size(), maxBuckets);
+}
+
+Interval makeInterval(BSONObj bounds, bool startInclusive, bool endInclusive) {
+    return Interval(bounds, startInclusive, endInclusive);
+}
+
+TEST(HistogramTest, EmptyHistogramSelectsNothing) {
+    auto histogram = Histogram::make({}, 0, 10);
+    ASSERT_EQ(0, histogram.getNumValues());
+    ASSERT_EQ(0, histogram.getValuesPerDocument());
+    ASSERT(histogram.getBuckets().empty());
+    ASSERT_EQ(0,
+              histogram.estimateSelectivity(makeInterval(BSON("" << 0 << "" << 10), true, true)));
+}
+
+TEST(HistogramTest, BucketsHoldEqualNumbersOfValues) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; ++i) {
+        docs.push_back(BSON("a" << i));
+    }
+    auto histogram = makeHistogram(docs, 10);
+    ASSERT_EQ(100, histogram.getNumValues());
+    ASSERT_EQ(1, histogram.getValuesPerDocument());
+
+    const auto& buckets = histogram.getBuckets();
+    ASSERT_EQ(10U, buckets.size());
+    double numValues = 0;
+    for (auto&& bucket : buckets) {
+        ASSERT_EQ(10, bucket.rangeCount + bucket.equalCount);
+        ASSERT_EQ(1, bucket.equalCount);
+        numValues += bucket.rangeCount + bucket.equalCount;
+    }
+    ASSERT_EQ(100, numValues);
+    ASSERT_BSONOBJ_EQ(BSON("" << 99), buckets.back().upperBound);
+}
+
+TEST(HistogramTest, FrequentValueIsABucketBound) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 50; ++i) {
+        docs.push_back(BSON("a" << 7));
+    }
+    for (int i = 0; i < 50; ++i) {
+        docs.push_back(BSON("a" << 100 + i));
+    }
+    auto histogram = makeHistogram(docs, 10);
+    ASSERT_BSONOBJ_EQ(BSON("" << 7), histogram.getBuckets().front().upperBound);
+    ASSERT_EQ(50, histogram.getBuckets().front().equalCount);
+
+    ASSERT_APPROX_EQUAL(0.5,
+                        histogram.estimateSelectivity(
+                            makeInterval(BSON("" << 7 << "" << 7), true, true)),
+                        1e-9);
+    ASSERT_EQ(0,
+              histogram.estimateSelectivity(makeInterval(BSON("" << 7 << "" << 7), false, true)));
+}
+
+TEST(HistogramTest, EstimatesRanges) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 1000; ++i) {
+        docs.push_back(BSON("a" << i));
+    }
+    auto histogram = makeHistogram(docs, 20);
+
+    auto selectivity = [&](int start, int end) {
+        return histogram.estimateSelectivity(
+            makeInterval(BSON("" << start << "" << end), true, false));
+    };
+    ASSERT_APPROX_EQUAL(0.1, selectivity(0, 100), 0.03);
+    ASSERT_APPROX_EQUAL(0.5, selectivity(250, 750), 0.03);
+    ASSERT_APPROX_EQUAL(1, selectivity(-10, 2000), 1e-9);
+    ASSERT_EQ(0, selectivity(2000, 3000));
+    ASSERT_EQ(0, selectivity(-20, -10));
+}
+
+TEST(HistogramTest, DescendingIntervalIsReversed) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; ++i) {
+        docs.push_back(BSON("a" << i));
+    }
+    auto histogram = makeHistogram(docs, 10);
+    ASSERT_EQ(
+        histogram.estimateSelectivity(makeInterval(BSON("" << 20 << "" << 60), true, false)),
+        histogram.estimateSelectivity(makeInterval(BSON("" << 60 << "" << 20), false, true)));
+}
+
+TEST(HistogramTest, OrdersValuesOfDifferentTypes) {
+    std::vector<BSONObj> docs{BSON("a" << BSONNULL),
+                              BSON("a" << 1),
+                              BSON("a" << 2.5),
+                              BSON("a"
+                                   << "str"),
+                              BSON("a" << BSON("b" << 1))};
+    auto histogram = makeHistogram(docs, 5);
+    ASSERT_BSONOBJ_EQ(BSON("" << BSONNULL), histogram.getBuckets().front().upperBound);
+
+    OrderedIntervalList numbers("a");
+    numbers.intervals.push_back(makeInterval(
+        BSON("" << -std::numeric_limits<double>::infinity() << ""
+                << std::numeric_limits<double>::infinity()),
+        true,
+        true));
+    ASSERT_APPROX_EQUAL(0.4, histogram.estimateSelectivity(numbers), 1e-9);
+}
+
+TEST(HistogramTest, CountsArrayValuesPerDocument) {
+    std::vector<BSONElement> values;
+    auto doc = BSON("a" << BSON_ARRAY(1 << 2 << 3));
+    for (auto&& element : doc["a"].Obj()) {
+        values.push_back(element);
+    }
+    auto histogram = Histogram::make(std::move(values), 2, 4);
+    ASSERT_EQ(3, histogram.getNumValues());
+    ASSERT_EQ(1.5, histogram.getValuesPerDocument());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -879,7 +879,12 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
             const S2Region& region = gme->getGeoExpression().getGeometry().getS2Region();
             S2IndexingParams indexParams;
             ExpressionParams::initialize2dsphereParams(index.infoObj, index.collator, &indexParams);
-            ExpressionMapping::cover2dsphere(region, indexParams, oilOut);
+            // The serialized predicate determines the region, so its covering may be cached.
+            const BSONObj regionObj = gme->getSerializedRightHandSide();
+            ExpressionMapping::cover2dsphere(region,
+                                             indexParams,
+                                             oilOut,
+                                             StringData(regionObj.objdata(), regionObj.objsize()));
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
         } else if ("2d" == elt.valueStringDataSafe()) {
             verify(gme->getGeoExpression().getGeometry().hasR2Region());
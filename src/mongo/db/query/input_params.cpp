@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/input_params.h"
+
+#include "mongo/util/str.h"
+
+namespace mongo::input_params {
+namespace {
+bool isParameterizableType(BSONType type) {
+    switch (type) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case NumberDecimal:
+        case String:
+        case Date:
+        case bsonTimestamp:
+        case jstOID:
+        case Bool:
+        case BinData:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Returns true if the predicates below a node of the given type are planned and executed
+ * independently of each other, so the literals they compare against may be parameterized.
+ */
+bool canParameterizeChildren(MatchExpression::MatchType type) {
+    switch (type) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+        case MatchExpression::ELEM_MATCH_OBJECT:
+        case MatchExpression::ELEM_MATCH_VALUE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void parameterize(MatchExpression* expr, InputParamId* nextParamId) {
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        auto comparison = static_cast<ComparisonMatchExpression*>(expr);
+        if (isParameterizableType(comparison->getData().type())) {
+            comparison->setInputParamId((*nextParamId)++);
+        }
+        return;
+    }
+
+    if (canParameterizeChildren(expr->matchType())) {
+        for (size_t idx = 0; idx < expr->numChildren(); ++idx) {
+            parameterize(expr->getChild(idx), nextParamId);
+        }
+    }
+}
+
+void getInputParams(const MatchExpression* expr,
+                    std::vector<const ComparisonMatchExpressionBase*>* params) {
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        auto comparison = static_cast<const ComparisonMatchExpression*>(expr);
+        if (auto paramId = comparison->getInputParamId()) {
+            if (params->size() <= static_cast<size_t>(*paramId)) {
+                params->resize(*paramId + 1, nullptr);
+            }
+            (*params)[*paramId] = comparison;
+        }
+        return;
+    }
+
+    for (size_t idx = 0; idx < expr->numChildren(); ++idx) {
+        getInputParams(expr->getChild(idx), params);
+    }
+}
+
+void encodeParameterizedShape(const MatchExpression* expr, StringBuilder* builder) {
+    const auto path = expr->path();
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        auto comparison = static_cast<const ComparisonMatchExpression*>(expr);
+        if (comparison->getInputParamId()) {
+            *builder << '?' << expr->matchType() << ':' << path.size() << ':' << path << ':'
+                     << static_cast<int>(comparison->getData().type());
+            return;
+        }
+    }
+
+    if (canParameterizeChildren(expr->matchType())) {
+        *builder << '(' << expr->matchType() << ':' << path.size() << ':' << path;
+        for (size_t idx = 0; idx < expr->numChildren(); ++idx) {
+            *builder << ' ';
+            encodeParameterizedShape(expr->getChild(idx), builder);
+        }
+        *builder << ')';
+        return;
+    }
+
+    // Other nodes are encoded along with their literals. The BSON is prefixed with its size, so
+    // that the encoding remains unambiguous.
+    auto obj = expr->serialize();
+    *builder << '#' << obj.objsize() << ':' << StringData{obj.objdata(), size_t(obj.objsize())};
+}
+}  // namespace
+
+size_t parameterize(MatchExpression* root) {
+    InputParamId nextParamId = 0;
+    parameterize(root, &nextParamId);
+    return nextParamId;
+}
+
+std::vector<const ComparisonMatchExpressionBase*> getInputParams(const MatchExpression* root) {
+    std::vector<const ComparisonMatchExpressionBase*> params;
+    getInputParams(root, &params);
+    return params;
+}
+
+std::string encodeParameterizedShape(const MatchExpression* root) {
+    StringBuilder builder;
+    encodeParameterizedShape(root, &builder);
+    return builder.str();
+}
+}  // namespace mongo::input_params
@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_leaf.h"
+
+/**
+ * Auto-parameterization of query filters.
+ *
+ * The literals of a filter which a query plan can read at runtime, rather than baking them into
+ * the plan, are marked as input parameters. A plan built for such a parameterized query can then be
+ * reused by any other query of the same parameterized shape, after binding the values of that
+ * query to the parameters of the plan.
+ */
+namespace mongo::input_params {
+using InputParamId = ComparisonMatchExpressionBase::InputParamId;
+
+/**
+ * Assigns consecutive input parameter ids, starting from zero, to the right hand sides of the
+ * $eq, $lt, $lte, $gt and $gte predicates of the 'root' filter which can be parameterized. Only
+ * predicates reachable from the root through logical operators and $elemMatch are parameterized,
+ * and only if they compare against a scalar whose type doesn't change the way the predicate is
+ * planned, e.g. not against null, MinKey, MaxKey, arrays, objects or regular expressions.
+ *
+ * Returns the number of input parameters.
+ */
+size_t parameterize(MatchExpression* root);
+
+/**
+ * Returns the predicates of the 'root' filter holding the input parameters assigned by
+ * parameterize(), indexed by their input parameter ids.
+ */
+std::vector<const ComparisonMatchExpressionBase*> getInputParams(const MatchExpression* root);
+
+/**
+ * Encodes the 'root' filter into a string which is equal for two filters if and only if they only
+ * differ in the values of their input parameters. The type of each input parameter is encoded
+ * along with its position.
+ */
+std::string encodeParameterizedShape(const MatchExpression* root);
+}  // namespace mongo::input_params
@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/input_params.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::input_params {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                       const char* json) {
+    return unittest::assertGet(MatchExpressionParser::parse(fromjson(json), expCtx));
+}
+
+std::string parameterizedShape(const char* json) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto expr = parse(expCtx, json);
+    parameterize(expr.get());
+    return encodeParameterizedShape(expr.get());
+}
+
+TEST(InputParamsTest, ParameterizesComparisonsUnderLogicalOperators) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto expr =
+        parse(expCtx, "{$or: [{a: 1}, {b: {$gt: 'x', $lte: 'z'}}], c: {$elemMatch: {$lt: 3}}}");
+    ASSERT_EQ(parameterize(expr.get()), 4u);
+
+    auto params = getInputParams(expr.get());
+    ASSERT_EQ(params.size(), 4u);
+    for (size_t paramId = 0; paramId < params.size(); ++paramId) {
+        ASSERT(params[paramId]);
+        ASSERT_EQ(*params[paramId]->getInputParamId(), static_cast<InputParamId>(paramId));
+    }
+}
+
+TEST(InputParamsTest, DoesNotParameterizeTypeDependentLiterals) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto expr =
+        parse(expCtx, "{a: null, b: [1, 2], c: {d: 1}, e: {$gt: {$minKey: 1}}, f: /x/, g: 1}");
+    ASSERT_EQ(parameterize(expr.get()), 1u);
+
+    auto params = getInputParams(expr.get());
+    ASSERT_EQ(params.size(), 1u);
+    ASSERT_EQ(params[0]->path(), "g");
+}
+
+TEST(InputParamsTest, ShallowClonePreservesInputParamIds) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto expr = parse(expCtx, "{a: {$gte: 1, $lt: 5}}");
+    ASSERT_EQ(parameterize(expr.get()), 2u);
+
+    auto clone = expr->shallowClone();
+    auto params = getInputParams(clone.get());
+    ASSERT_EQ(params.size(), 2u);
+    ASSERT(params[0]);
+    ASSERT(params[1]);
+}
+
+TEST(InputParamsTest, ShapeOnlyDependsOnTheTypesOfInputParams) {
+    ASSERT_EQ(parameterizedShape("{a: 1, b: {$lt: 'x'}}"),
+              parameterizedShape("{a: 2, b: {$lt: 'yy'}}"));
+    ASSERT_NE(parameterizedShape("{a: 1}"), parameterizedShape("{a: 'x'}"));
+    ASSERT_NE(parameterizedShape("{a: 1}"), parameterizedShape("{b: 1}"));
+    ASSERT_NE(parameterizedShape("{a: 1}"), parameterizedShape("{a: {$gt: 1}}"));
+    ASSERT_NE(parameterizedShape("{a: null}"), parameterizedShape("{a: {$exists: false}}"));
+    ASSERT_NE(parameterizedShape("{a: /x/}"), parameterizedShape("{a: /y/}"));
+}
+
+}  // namespace
+}  // namespace mongo::input_params
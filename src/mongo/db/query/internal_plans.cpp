@@ -35,6 +35,7 @@
 
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/client.h"
+#include "mongo/db/exec/clustered_idhack.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/eof.h"
@@ -193,8 +194,14 @@ std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> InternalPlanner::updateWith
     auto expCtx = make_intrusive<ExpressionContext>(
         opCtx, std::unique_ptr<CollatorInterface>(nullptr), collection->ns());
 
-    auto idHackStage =
-        std::make_unique<IDHackStage>(expCtx.get(), key, ws.get(), collection, descriptor);
+    std::unique_ptr<PlanStage> idHackStage;
+    if (descriptor) {
+        idHackStage =
+            std::make_unique<IDHackStage>(expCtx.get(), key, ws.get(), collection, descriptor);
+    } else {
+        idHackStage =
+            std::make_unique<ClusteredIdHackStage>(expCtx.get(), key, ws.get(), collection);
+    }
 
     const bool isUpsert = params.request->isUpsert();
     auto root = (isUpsert ? std::make_unique<UpsertStage>(
@@ -117,7 +117,8 @@ public:
         Direction direction = FORWARD);
 
     /**
-     * Returns an IDHACK => UPDATE plan.
+     * Returns an IDHACK => UPDATE plan. The _id index 'descriptor' is null when the collection is
+     * clustered, in which case the IDHACK reads the record store directly.
      */
     static std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> updateWithIdHack(
         OperationContext* opCtx,
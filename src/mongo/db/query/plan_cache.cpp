@@ -36,6 +36,7 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <algorithm>
+#include <array>
 #include <math.h>
 #include <memory>
 #include <vector>
@@ -52,8 +53,11 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/hex.h"
+#include "mongo/util/static_immortal.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
 #include "mongo/util/visit_helper.h"
 
@@ -63,6 +67,36 @@ namespace {
 ServerStatusMetricField<Counter64> totalPlanCacheSizeEstimateBytesMetric(
     "query.planCacheTotalSizeEstimateBytes", &PlanCacheEntry::planCacheTotalSizeEstimateBytes);
 
+// Lookup and eviction counters for each partition index, summed over the plan caches of all
+// collections.
+struct PartitionMetrics {
+    Counter64 hits;
+    Counter64 misses;
+    Counter64 evictions;
+};
+std::array<PartitionMetrics, PlanCache::kMaxPartitions> partitionMetrics;
+
+// Source of the identifiers assigned to newly created plan cache entries.
+AtomicWord<unsigned long long> nextPlanCacheEntryId{0};
+
+/**
+ * Reports 'partitionMetrics' in serverStatus as an array with an element per partition.
+ */
+class PlanCachePartitionsMetric final : public ServerStatusMetric {
+public:
+    PlanCachePartitionsMetric() : ServerStatusMetric("query.planCache.partitions") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const final {
+        BSONArrayBuilder partitions(b.subarrayStart(_leafName));
+        for (int idx = 0; idx < internalQueryCacheNumPartitions; ++idx) {
+            const auto& metrics = partitionMetrics[idx];
+            partitions.append(BSON("hits" << metrics.hits.get() << "misses"
+                                          << metrics.misses.get() << "evictions"
+                                          << metrics.evictions.get()));
+        }
+    }
+} planCachePartitionsMetric;
+
 // Delimiters for cache key encoding.
 const char kEncodeDiscriminatorsBegin = '<';
 const char kEncodeDiscriminatorsEnd = '>';
@@ -165,7 +199,9 @@ bool PlanCache::shouldCacheQuery(const CanonicalQuery& query) {
 }
 
 CachedSolution::CachedSolution(const PlanCacheEntry& entry)
-    : plannerData(entry.plannerData->clone()), decisionWorks(entry.works) {}
+    : plannerData(entry.plannerData->clone()),
+      decisionWorks(entry.works),
+      entryId(entry.entryId) {}
 
 //
 // PlanCacheEntry
@@ -223,6 +259,7 @@ std::unique_ptr<PlanCacheEntry> PlanCacheEntry::create(
 
     return std::unique_ptr<PlanCacheEntry>(new PlanCacheEntry(std::move(plannerDataForCache),
                                                               timeOfCreation,
+                                                              nextPlanCacheEntryId.fetchAndAdd(1),
                                                               queryHash,
                                                               planCacheKey,
                                                               isActive,
@@ -232,6 +269,7 @@ std::unique_ptr<PlanCacheEntry> PlanCacheEntry::create(
 
 PlanCacheEntry::PlanCacheEntry(std::unique_ptr<const SolutionCacheData> plannerData,
                                const Date_t timeOfCreation,
+                               const uint64_t entryId,
                                const uint32_t queryHash,
                                const uint32_t planCacheKey,
                                const bool isActive,
@@ -239,6 +277,7 @@ PlanCacheEntry::PlanCacheEntry(std::unique_ptr<const SolutionCacheData> plannerD
                                boost::optional<DebugInfo> debugInfo)
     : plannerData(std::move(plannerData)),
       timeOfCreation(timeOfCreation),
+      entryId(entryId),
       queryHash(queryHash),
       planCacheKey(planCacheKey),
       isActive(isActive),
@@ -263,6 +302,7 @@ std::unique_ptr<PlanCacheEntry> PlanCacheEntry::clone() const {
 
     return std::unique_ptr<PlanCacheEntry>(new PlanCacheEntry(plannerData->clone(),
                                                               timeOfCreation,
+                                                              entryId,
                                                               queryHash,
                                                               planCacheKey,
                                                               isActive,
@@ -431,11 +471,79 @@ std::string SolutionCacheData::toString() const {
 // PlanCache
 //
 
-PlanCache::PlanCache() : PlanCache(internalQueryCacheMaxEntriesPerCollection.load()) {}
+struct PlanCache::PartitionRegistry {
+    // Protects 'partitions'. Acquired before the mutex of any partition.
+    Mutex mutex = MONGO_MAKE_LATCH("PlanCache::PartitionRegistry::mutex");
+    stdx::unordered_set<Partition*> partitions;
+};
+
+PlanCache::PartitionRegistry& PlanCache::partitionRegistry() {
+    static StaticImmortal<PartitionRegistry> registry;
+    return *registry;
+}
+
+PlanCache::PlanCache()
+    : PlanCache(internalQueryCacheMaxEntriesPerCollection.load(),
+                internalQueryCacheNumPartitions) {}
+
+PlanCache::PlanCache(size_t size, size_t numPartitions) {
+    invariant(numPartitions > 0 && numPartitions <= kMaxPartitions);
+    const auto entriesPerPartition = std::max<size_t>(size / numPartitions, 1);
+    _partitions.reserve(numPartitions);
+    for (size_t idx = 0; idx < numPartitions; ++idx) {
+        _partitions.push_back(std::make_unique<Partition>(idx, entriesPerPartition));
+    }
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+    auto& registry = partitionRegistry();
+    stdx::lock_guard<Latch> registryLock(registry.mutex);
+    for (auto&& partition : _partitions) {
+        registry.partitions.insert(partition.get());
+    }
+}
 
-PlanCache::~PlanCache() {}
+PlanCache::~PlanCache() {
+    auto& registry = partitionRegistry();
+    stdx::lock_guard<Latch> registryLock(registry.mutex);
+    for (auto&& partition : _partitions) {
+        registry.partitions.erase(partition.get());
+    }
+}
+
+std::unique_ptr<PlanCacheEntry> PlanCache::Partition::add(const PlanCacheKey& key,
+                                                          std::unique_ptr<PlanCacheEntry> entry) {
+    PlanCacheEntry* oldEntry = nullptr;
+    if (cache.get(key, &oldEntry).isOK()) {
+        sizeBytes.fetchAndSubtract(oldEntry->estimatedEntrySizeBytes);
+    }
+    sizeBytes.fetchAndAdd(entry->estimatedEntrySizeBytes);
+
+    auto evictedEntry = cache.add(key, entry.release());
+    if (evictedEntry) {
+        sizeBytes.fetchAndSubtract(evictedEntry->estimatedEntrySizeBytes);
+    }
+    return evictedEntry;
+}
+
+Status PlanCache::Partition::remove(const PlanCacheKey& key) {
+    PlanCacheEntry* entry = nullptr;
+    if (cache.get(key, &entry).isOK()) {
+        sizeBytes.fetchAndSubtract(entry->estimatedEntrySizeBytes);
+    }
+    return cache.remove(key);
+}
+
+std::unique_ptr<PlanCacheEntry> PlanCache::Partition::removeLeastRecentlyUsed() {
+    auto evictedEntry = cache.removeLeastRecentlyUsed();
+    if (evictedEntry) {
+        sizeBytes.fetchAndSubtract(evictedEntry->estimatedEntrySizeBytes);
+    }
+    return evictedEntry;
+}
+
+void PlanCache::Partition::clear() {
+    cache.clear();
+    sizeBytes.store(0);
+}
 
 std::unique_ptr<CachedSolution> PlanCache::getCacheEntryIfActive(const PlanCacheKey& key) const {
     PlanCache::GetResult res = get(key);
@@ -584,7 +692,9 @@ Status PlanCache::set(const CanonicalQuery& query,
                                  }},
         why->stats);
     const auto key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    const auto partitionIdx = partitionIndex(key);
+    auto& partition = *_partitions[partitionIdx];
+    stdx::unique_lock<Latch> cacheLock(partition.mutex);
     bool isNewEntryActive = false;
     uint32_t queryHash;
     uint32_t planCacheKey;
@@ -595,7 +705,7 @@ Status PlanCache::set(const CanonicalQuery& query,
         queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
     } else {
         PlanCacheEntry* oldEntry = nullptr;
-        Status cacheStatus = _cache.get(key, &oldEntry);
+        Status cacheStatus = partition.cache.get(key, &oldEntry);
         invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
         if (oldEntry) {
             queryHash = oldEntry->queryHash;
@@ -622,9 +732,10 @@ Status PlanCache::set(const CanonicalQuery& query,
     auto newEntry(PlanCacheEntry::create(
         solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
 
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.add(key, std::move(newEntry));
 
     if (nullptr != evictedEntry.get()) {
+        partitionMetrics[partitionIdx].evictions.increment();
         LOGV2_DEBUG(20942,
                     1,
                     "Plan cache maximum size exceeded - removed least recently used entry",
@@ -632,9 +743,99 @@ Status PlanCache::set(const CanonicalQuery& query,
                     "evictedEntry"_attr = redact(evictedEntry->debugString()));
     }
 
+    cacheLock.unlock();
+    enforceSizeBudget(&partition);
+
+    return Status::OK();
+}
+
+Status PlanCache::restore(const CanonicalQuery& query,
+                          QuerySolution* soln,
+                          std::unique_ptr<plan_ranker::PlanRankingDecision> why,
+                          bool isActive,
+                          size_t works,
+                          Date_t now) {
+    invariant(why);
+
+    if (!soln->cacheData) {
+        return Status(ErrorCodes::BadValue, "solution has no cache data");
+    }
+
+    const auto key = computeKey(query);
+    const auto partitionIdx = partitionIndex(key);
+    auto& partition = *_partitions[partitionIdx];
+    stdx::unique_lock<Latch> cacheLock(partition.mutex);
+
+    PlanCacheEntry* oldEntry = nullptr;
+    Status cacheStatus = partition.cache.get(key, &oldEntry);
+    invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
+    if (oldEntry) {
+        return Status::OK();
+    }
+
+    const auto planCacheKey = canonical_query_encoder::computeHash(key.stringData());
+    const auto queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
+    std::vector<QuerySolution*> solns{soln};
+    const bool isNewEntryActive = isActive || internalQueryCacheDisableInactiveEntries.load();
+    auto newEntry(PlanCacheEntry::create(
+        solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, works));
+
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.add(key, std::move(newEntry));
+    if (nullptr != evictedEntry.get()) {
+        partitionMetrics[partitionIdx].evictions.increment();
+    }
+
+    cacheLock.unlock();
+    enforceSizeBudget(&partition);
+
     return Status::OK();
 }
 
+size_t PlanCache::partitionIndex(const PlanCacheKey& key) const {
+    return _partitions.size() == 1 ? 0 : PlanCacheKeyHasher{}(key) % _partitions.size();
+}
+
+void PlanCache::enforceSizeBudget(const Partition* addedTo) {
+    if (PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() <=
+        internalQueryCacheMaxSizeBytes.load()) {
+        return;
+    }
+
+    auto& registry = partitionRegistry();
+    stdx::lock_guard<Latch> registryLock(registry.mutex);
+    bool canEvictFromAddedTo = true;
+    while (PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() >
+           internalQueryCacheMaxSizeBytes.load()) {
+        Partition* largest = nullptr;
+        for (auto&& partition : registry.partitions) {
+            if ((partition != addedTo || canEvictFromAddedTo) &&
+                (!largest || partition->sizeBytes.load() > largest->sizeBytes.load())) {
+                largest = partition;
+            }
+        }
+        if (!largest) {
+            return;
+        }
+
+        stdx::lock_guard<Latch> cacheLock(largest->mutex);
+        if (largest == addedTo && largest->cache.size() <= 1) {
+            canEvictFromAddedTo = false;
+            continue;
+        }
+
+        auto evictedEntry = largest->removeLeastRecentlyUsed();
+        if (!evictedEntry) {
+            // Even the largest partition is empty, so there is nothing left to evict.
+            return;
+        }
+        partitionMetrics[largest->index].evictions.increment();
+        LOGV2_DEBUG(5843200,
+                    1,
+                    "Plan cache memory budget exceeded - removed least recently used entry",
+                    "evictedEntry"_attr = redact(evictedEntry->debugString()));
+    }
+}
+
 void PlanCache::deactivate(const CanonicalQuery& query) {
     if (internalQueryCacheDisableInactiveEntries.load()) {
         // This is a noop if inactive entries are disabled.
@@ -642,9 +843,10 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
     }
 
     PlanCacheKey key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = *_partitions[partitionIndex(key)];
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return;
@@ -659,14 +861,18 @@ PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
 }
 
 PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    const auto partitionIdx = partitionIndex(key);
+    auto& partition = *_partitions[partitionIdx];
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
+        partitionMetrics[partitionIdx].misses.increment();
         return {CacheEntryState::kNotPresent, nullptr};
     }
     invariant(entry);
+    partitionMetrics[partitionIdx].hits.increment();
 
     auto state =
         entry->isActive ? CacheEntryState::kPresentActive : CacheEntryState::kPresentInactive;
@@ -674,13 +880,17 @@ PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    const auto key = computeKey(canonicalQuery);
+    auto& partition = *_partitions[partitionIndex(key)];
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
+    return partition.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        partition->clear();
+    }
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -694,9 +904,10 @@ PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
 StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQuery& query) const {
     PlanCacheKey key = computeKey(query);
 
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = *_partitions[partitionIndex(key)];
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -706,20 +917,26 @@ StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQ
 }
 
 std::vector<std::unique_ptr<PlanCacheEntry>> PlanCache::getAllEntries() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     std::vector<std::unique_ptr<PlanCacheEntry>> entries;
 
-    for (auto&& cacheEntry : _cache) {
-        auto entry = cacheEntry.second;
-        entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            auto entry = cacheEntry.second;
+            entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+        }
     }
 
     return entries;
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        size += partition->cache.size();
+    }
+    return size;
 }
 
 void PlanCache::notifyOfIndexUpdates(const std::vector<CoreIndexInfo>& indexCores) {
@@ -730,13 +947,15 @@ std::vector<BSONObj> PlanCache::getMatchingStats(
     const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
     const std::function<bool(const BSONObj&)>& filterFunc) const {
     std::vector<BSONObj> results;
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
 
-    for (auto&& cacheEntry : _cache) {
-        const auto entry = cacheEntry.second;
-        auto serializedEntry = serializationFunc(*entry);
-        if (filterFunc(serializedEntry)) {
-            results.push_back(serializedEntry);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            const auto entry = cacheEntry.second;
+            auto serializedEntry = serializationFunc(*entry);
+            if (filterFunc(serializedEntry)) {
+                results.push_back(serializedEntry);
+            }
         }
     }
 
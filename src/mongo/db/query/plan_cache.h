@@ -280,6 +280,9 @@ public:
     // The number of work cycles taken to decide on a winning plan when the plan was first
     // cached.
     const size_t decisionWorks;
+
+    // The identifier of the plan cache entry this solution was taken from.
+    const uint64_t entryId;
 };
 
 /**
@@ -371,6 +374,11 @@ public:
 
     const Date_t timeOfCreation;
 
+    // An identifier of this entry which is unique across the plan caches of all collections and is
+    // preserved by clone(). Since the planner data of an entry never changes, it can be used to key
+    // artifacts derived from that data, such as compiled SBE plans.
+    const uint64_t entryId;
+
     // Hash of the PlanCacheKey. Intended as an identifier for the query shape in logs and other
     // diagnostic output.
     const uint32_t queryHash;
@@ -412,6 +420,7 @@ private:
      */
     PlanCacheEntry(std::unique_ptr<const SolutionCacheData> plannerData,
                    Date_t timeOfCreation,
+                   uint64_t entryId,
                    uint32_t queryHash,
                    uint32_t planCacheKey,
                    bool isActive,
@@ -429,6 +438,12 @@ private:
  * Caches the best solution to a query.  Aside from the (CanonicalQuery -> QuerySolution)
  * mapping, the cache contains information on why that mapping was made and statistics on the
  * cache entry's actual performance on subsequent runs.
+ *
+ * Entries are spread over a number of partitions by the hash of their key, each with its own
+ * mutex and LRU list, so that concurrent lookups of different query shapes rarely contend. Besides
+ * the per-partition entry count limit, the estimated size of all plan caches in the system is
+ * bounded by 'internalQueryCacheMaxSizeBytes', which is enforced by evicting from the largest
+ * partitions of any plan cache.
  */
 class PlanCache {
 private:
@@ -470,12 +485,21 @@ public:
      */
     static bool shouldCacheQuery(const CanonicalQuery& query);
 
+    /**
+     * The largest number of partitions a plan cache may be split into.
+     */
+    static constexpr size_t kMaxPartitions = 64;
+
     /**
      * If omitted, namespace set to empty string.
      */
     PlanCache();
 
-    PlanCache(size_t size);
+    /**
+     * Creates a plan cache holding at most 'size' entries, split evenly over 'numPartitions'
+     * partitions. Each partition holds at least one entry.
+     */
+    PlanCache(size_t size, size_t numPartitions = 1);
 
     ~PlanCache();
 
@@ -499,6 +523,22 @@ public:
                Date_t now,
                boost::optional<double> worksGrowthCoefficient = boost::none);
 
+    /**
+     * Inserts a cache entry for 'query' whose winning plan is 'soln', as recovered from a plan
+     * cache snapshot taken before a restart. Unlike set(), the activeness and the works of the new
+     * entry are taken as given rather than derived from an existing entry. Does nothing if the
+     * cache already holds an entry for the query's shape, since that entry is more recent than the
+     * snapshot.
+     *
+     * 'why' must describe the single solution 'soln'.
+     */
+    Status restore(const CanonicalQuery& query,
+                   QuerySolution* soln,
+                   std::unique_ptr<plan_ranker::PlanRankingDecision> why,
+                   bool isActive,
+                   size_t works,
+                   Date_t now);
+
     /**
      * Set a cache entry back to the 'inactive' state. Rather than completely evicting an entry
      * when the associated plan starts to perform poorly, we deactivate it, so that plans which
@@ -600,10 +640,47 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
+    struct Partition {
+        Partition(size_t index, size_t maxEntries) : index(index), cache(maxEntries) {}
+
+        /**
+         * Add or remove entries of 'cache' and keep 'sizeBytes' up to date. The caller must hold
+         * 'mutex'.
+         */
+        std::unique_ptr<PlanCacheEntry> add(const PlanCacheKey& key,
+                                            std::unique_ptr<PlanCacheEntry> entry);
+        Status remove(const PlanCacheKey& key);
+        std::unique_ptr<PlanCacheEntry> removeLeastRecentlyUsed();
+        void clear();
+
+        // The index of this partition within its plan cache.
+        const size_t index;
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> cache;
+
+        // The estimated size of the entries in 'cache'. Only written while holding 'mutex', but
+        // read without it when choosing the partition to evict from.
+        AtomicWord<long long> sizeBytes{0};
+
+        // Protects 'cache'.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("PlanCache::Partition::mutex");
+    };
+
+    // The partitions of all plan caches in the system, which the size budget is enforced across.
+    struct PartitionRegistry;
+    static PartitionRegistry& partitionRegistry();
+
+    size_t partitionIndex(const PlanCacheKey& key) const;
+
+    /**
+     * While the estimated size of all plan caches exceeds 'internalQueryCacheMaxSizeBytes', evicts
+     * the least recently used entry of whichever partition in the system holds the most bytes. The
+     * partition 'addedTo' keeps at least one entry, so that an entry which was just added to it is
+     * not evicted right away. The caller must not hold any partition's mutex.
+     */
+    static void enforceSizeBudget(const Partition* addedTo);
 
-    // Protects _cache.
-    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
     // Holds computed information about the collection's indexes.  Used for generating plan
     // cache keys.
@@ -0,0 +1,335 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cache_persistence.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/stage_builder_util.h"
+#include "mongo/db/storage/encryption_hooks.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo::plan_cache_persistence {
+namespace {
+constexpr auto kSnapshotFileName = "planCacheSnapshot.bson"_sd;
+
+constexpr auto kNsField = "ns"_sd;
+constexpr auto kUUIDField = "uuid"_sd;
+constexpr auto kFilterField = "filter"_sd;
+constexpr auto kSortField = "sort"_sd;
+constexpr auto kProjectionField = "projection"_sd;
+constexpr auto kCollationField = "collation"_sd;
+constexpr auto kPlanField = "plan"_sd;
+constexpr auto kWorksField = "works"_sd;
+constexpr auto kIsActiveField = "isActive"_sd;
+
+boost::filesystem::path snapshotPath() {
+    return boost::filesystem::path(storageGlobalParams.dbpath) / kSnapshotFileName.toString();
+}
+
+/**
+ * Appends the names of the indexes used by the cached plan 'tree' in pre-order.
+ */
+void appendIndexNames(const PlanCacheIndexTree* tree, BSONArrayBuilder* out) {
+    if (!tree) {
+        return;
+    }
+    if (tree->entry) {
+        out->append(tree->entry->identifier.catalogName);
+    }
+    for (auto&& orPushdown : tree->orPushdowns) {
+        out->append(orPushdown.indexEntryId.catalogName);
+    }
+    for (auto&& child : tree->children) {
+        appendIndexNames(child, out);
+    }
+}
+
+/**
+ * Describes the access path of a cached plan by its type and the indexes it uses. A solution
+ * planned after the restart which has the same description is taken to be the recorded plan.
+ */
+BSONObj describePlan(const SolutionCacheData& cacheData) {
+    BSONObjBuilder bob;
+    bob.append("type", static_cast<int>(cacheData.solnType));
+    bob.append("direction", cacheData.wholeIXSolnDir);
+    BSONArrayBuilder indexes(bob.subarrayStart("indexes"));
+    appendIndexNames(cacheData.tree.get(), &indexes);
+    indexes.doneFast();
+    return bob.obj();
+}
+
+/**
+ * Builds the ranking decision stored alongside a restored entry. The stats are those of a plan
+ * which has not run yet, except for the works carried over from the snapshot.
+ */
+std::unique_ptr<plan_ranker::PlanRankingDecision> makeDecision(OperationContext* opCtx,
+                                                               const CollectionPtr& collection,
+                                                               const CanonicalQuery& cq,
+                                                               const QuerySolution& soln,
+                                                               size_t works) {
+    WorkingSet ws;
+    auto root = stage_builder::buildClassicExecutableTree(opCtx, collection, cq, soln, &ws);
+    auto stats = root->getStats();
+    stats->common.works = works;
+
+    auto decision = std::make_unique<plan_ranker::PlanRankingDecision>();
+    decision->getStats<PlanStageStats>().push_back(std::move(stats));
+    decision->scores.push_back(0);
+    decision->candidateOrder.push_back(0);
+    return decision;
+}
+
+void writeSnapshot(const std::vector<BSONObj>& records) {
+    const auto path = snapshotPath();
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream ofs(tempPath.c_str(), std::ios_base::out | std::ios_base::binary);
+        for (auto&& record : records) {
+            ofs.write(record.objdata(), record.objsize());
+        }
+        uassert(ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to write plan cache snapshot to " << tempPath.string()
+                              << ": " << errnoWithDescription(),
+                ofs.good());
+    }
+    boost::filesystem::rename(tempPath, path);
+}
+
+std::vector<BSONObj> readSnapshot(const boost::filesystem::path& path) {
+    const auto fileSize = boost::filesystem::file_size(path);
+    std::unique_ptr<char[]> buffer(new char[fileSize]);
+    {
+        std::ifstream ifs(path.c_str(), std::ios_base::in | std::ios_base::binary);
+        ifs.read(buffer.get(), fileSize);
+        uassert(ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to read plan cache snapshot from " << path.string()
+                              << ": " << errnoWithDescription(),
+                ifs.good());
+    }
+
+    std::vector<BSONObj> records;
+    for (uint64_t offset = 0; offset < fileSize;) {
+        const char* data = buffer.get() + offset;
+        const auto remaining = fileSize - offset;
+        uassertStatusOKWithContext(
+            validateBSON(data, remaining),
+            str::stream() << "Invalid plan cache snapshot " << path.string());
+        records.push_back(BSONObj(data).getOwned());
+        offset += records.back().objsize();
+    }
+    return records;
+}
+}  // namespace
+
+boost::optional<BSONObj> serializeEntry(const NamespaceString& nss,
+                                        const UUID& uuid,
+                                        const PlanCacheEntry& entry) {
+    if (!entry.debugInfo) {
+        return boost::none;
+    }
+
+    const auto& createdFromQuery = entry.debugInfo->createdFromQuery;
+    BSONObjBuilder bob;
+    bob.append(kNsField, nss.ns());
+    uuid.appendToBuilder(&bob, kUUIDField);
+    bob.append(kFilterField, createdFromQuery.filter);
+    bob.append(kSortField, createdFromQuery.sort);
+    bob.append(kProjectionField, createdFromQuery.projection);
+    bob.append(kCollationField, createdFromQuery.collation);
+    bob.append(kPlanField, describePlan(*entry.plannerData));
+    bob.append(kWorksField, static_cast<long long>(entry.works));
+    bob.append(kIsActiveField, entry.isActive);
+    return bob.obj();
+}
+
+Status restoreEntry(OperationContext* opCtx,
+                    const CollectionPtr& collection,
+                    const BSONObj& record) {
+    const auto& nss = collection->ns();
+    auto qr = std::make_unique<QueryRequest>(nss);
+    qr->setFilter(record[kFilterField].Obj().getOwned());
+    qr->setSort(record[kSortField].Obj().getOwned());
+    qr->setProj(record[kProjectionField].Obj().getOwned());
+    qr->setCollation(record[kCollationField].Obj().getOwned());
+
+    const boost::intrusive_ptr<ExpressionContext> expCtx;
+    auto statusWithCQ =
+        CanonicalQuery::canonicalize(opCtx,
+                                     std::move(qr),
+                                     expCtx,
+                                     ExtensionsCallbackReal(opCtx, &nss),
+                                     MatchExpressionParser::kAllowAllSpecialFeatures);
+    if (!statusWithCQ.isOK()) {
+        return statusWithCQ.getStatus();
+    }
+    auto cq = std::move(statusWithCQ.getValue());
+    if (!PlanCache::shouldCacheQuery(*cq)) {
+        return Status(ErrorCodes::BadValue, "query shape is not cacheable");
+    }
+
+    QueryPlannerParams plannerParams;
+    fillOutPlannerParams(opCtx, collection, cq.get(), &plannerParams);
+    auto statusWithSolutions = QueryPlanner::plan(*cq, plannerParams);
+    if (!statusWithSolutions.isOK()) {
+        return statusWithSolutions.getStatus();
+    }
+
+    const auto plan = record[kPlanField].Obj();
+    for (auto&& soln : statusWithSolutions.getValue()) {
+        if (!soln->cacheData || describePlan(*soln->cacheData).woCompare(plan) != 0) {
+            continue;
+        }
+
+        const auto works = static_cast<size_t>(record[kWorksField].safeNumberLong());
+        return CollectionQueryInfo::get(collection)
+            .getPlanCache()
+            ->restore(*cq,
+                      soln.get(),
+                      makeDecision(opCtx, collection, *cq, *soln, works),
+                      record[kIsActiveField].trueValue(),
+                      works,
+                      opCtx->getServiceContext()->getPreciseClockSource()->now());
+    }
+    return Status(ErrorCodes::NoQueryExecutionPlans,
+                  "the recorded plan is no longer one of the candidate plans");
+}
+
+void saveSnapshot(OperationContext* opCtx) {
+    if (!internalQueryPersistPlanCache.load() || storageGlobalParams.readOnly) {
+        return;
+    }
+
+    // The recorded queries include their literal values, which may be user data. The snapshot
+    // file is not encrypted, so it must not be written next to encrypted data files.
+    if (EncryptionHooks::get(opCtx->getServiceContext())->enabled()) {
+        LOGV2(5843231, "Not saving a plan cache snapshot since encryption at rest is enabled");
+        return;
+    }
+
+    // The plan caches synchronize access to their entries themselves. Collection locks are not
+    // taken since this runs at shutdown, once all other operations have been killed.
+    std::vector<BSONObj> records;
+    auto catalog = CollectionCatalog::get(opCtx);
+    for (auto&& dbName : catalog->getAllDbNames()) {
+        for (auto collIt = catalog->begin(opCtx, dbName); collIt != catalog->end(opCtx);
+             ++collIt) {
+            auto collection = *collIt;
+            if (!collection) {
+                continue;
+            }
+            auto planCache = CollectionQueryInfo::get(collection).getPlanCache();
+            for (auto&& entry : planCache->getAllEntries()) {
+                if (auto record = serializeEntry(collection->ns(), collection->uuid(), *entry)) {
+                    records.push_back(std::move(*record));
+                }
+            }
+        }
+    }
+
+    try {
+        writeSnapshot(records);
+        LOGV2(5843202,
+              "Saved plan cache snapshot",
+              "path"_attr = snapshotPath().string(),
+              "numEntries"_attr = records.size());
+    } catch (const std::exception& ex) {
+        LOGV2_WARNING(5843203, "Failed to save plan cache snapshot", "error"_attr = ex.what());
+    }
+}
+
+void warmFromSnapshot(OperationContext* opCtx) {
+    const auto path = snapshotPath();
+    if (!internalQueryPersistPlanCache.load() || !boost::filesystem::exists(path)) {
+        return;
+    }
+
+    std::vector<BSONObj> records;
+    try {
+        records = readSnapshot(path);
+    } catch (const std::exception& ex) {
+        LOGV2_WARNING(5843204, "Failed to read plan cache snapshot", "error"_attr = ex.what());
+    }
+
+    size_t numRestored = 0;
+    for (auto&& record : records) {
+        auto status = [&] {
+            try {
+                const auto nss = NamespaceString(record[kNsField].String());
+                const auto uuid = uassertStatusOK(UUID::parse(record[kUUIDField]));
+                AutoGetCollection collection(
+                    opCtx, NamespaceStringOrUUID(nss.db().toString(), uuid), MODE_IS);
+                return restoreEntry(opCtx, collection.getCollection(), record);
+            } catch (const DBException& ex) {
+                return ex.toStatus();
+            }
+        }();
+
+        if (status.isOK()) {
+            ++numRestored;
+        } else {
+            LOGV2_DEBUG(5843205,
+                        1,
+                        "Skipping plan cache snapshot entry",
+                        "entry"_attr = redact(record),
+                        "reason"_attr = status);
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::remove(path, ec);
+    LOGV2(5843206,
+          "Warmed plan caches from snapshot",
+          "path"_attr = path.string(),
+          "numEntries"_attr = records.size(),
+          "numRestored"_attr = numRestored);
+}
+
+}  // namespace mongo::plan_cache_persistence
@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class CollectionPtr;
+class OperationContext;
+class PlanCacheEntry;
+
+/**
+ * Persistence of the plan caches across restarts of the node.
+ *
+ * On clean shutdown the entries of all plan caches are written to a snapshot file in the dbpath.
+ * Each entry is recorded by the query it was created from, the names of the indexes its winning
+ * plan uses and its works. On startup every recorded query is planned again and the solution using
+ * the same indexes is re-inserted into the plan cache of its collection, sparing the node from
+ * multi-planning every query shape after the restart. Entries whose collection was dropped or
+ * whose indexes no longer exist are discarded.
+ */
+namespace plan_cache_persistence {
+
+/**
+ * Writes the plan cache entries of every collection to the snapshot file, replacing any previous
+ * snapshot. Does nothing unless 'internalQueryPersistPlanCache' is enabled. Since the file holds
+ * the recorded queries in plaintext, it is never written when encryption at rest is enabled.
+ */
+void saveSnapshot(OperationContext* opCtx);
+
+/**
+ * Re-creates the plan cache entries recorded in the snapshot file, then removes the file so that
+ * it is not used again after an unclean shutdown. Does nothing unless
+ * 'internalQueryPersistPlanCache' is enabled. Entries which cannot be restored are skipped.
+ */
+void warmFromSnapshot(OperationContext* opCtx);
+
+/**
+ * Returns the snapshot record of 'entry' from the plan cache of the collection 'nss' with the given
+ * 'uuid'. Returns boost::none if the entry does not keep the query it was created from, which
+ * happens once the plan caches grow past 'internalQueryCacheMaxSizeBytesBeforeStripDebugInfo'.
+ */
+boost::optional<BSONObj> serializeEntry(const NamespaceString& nss,
+                                        const UUID& uuid,
+                                        const PlanCacheEntry& entry);
+
+/**
+ * Plans the query recorded in 'record' against 'collection' and inserts the solution matching the
+ * recorded winning plan into the collection's plan cache. Returns an error if the query can no
+ * longer be planned the way it was recorded, e.g. because one of its indexes was dropped.
+ */
+Status restoreEntry(OperationContext* opCtx,
+                    const CollectionPtr& collection,
+                    const BSONObj& record);
+
+}  // namespace plan_cache_persistence
+}  // namespace mongo
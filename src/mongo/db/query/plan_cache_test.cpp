@@ -2424,6 +2424,100 @@ TEST(PlanCacheTest, PlanCacheSizeWithEviction) {
     ASSERT_EQ(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(), originalSize);
 }
 
+TEST(PlanCacheTest, PartitionedPlanCacheHoldsEntriesOfAllPartitions) {
+    PlanCache planCache(100, 4);
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+
+    std::string queryString = "{a: 1, z: 1}";
+    for (int i = 0; i < 10; ++i) {
+        queryString[1] = 'a' + i;
+        unique_ptr<CanonicalQuery> query(canonicalize(queryString));
+        ASSERT_OK(planCache.set(*query, solns, createDecision(1U), Date_t{}));
+        ASSERT_EQ(planCache.get(*query).state, PlanCache::CacheEntryState::kPresentInactive);
+    }
+    ASSERT_EQ(planCache.size(), 10U);
+    ASSERT_EQ(planCache.getAllEntries().size(), 10U);
+
+    unique_ptr<CanonicalQuery> removed(canonicalize("{c: 1, z: 1}"));
+    ASSERT_OK(planCache.remove(*removed));
+    ASSERT_EQ(planCache.get(*removed).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(planCache.size(), 9U);
+
+    planCache.clear();
+    ASSERT_EQ(planCache.size(), 0U);
+}
+
+TEST(PlanCacheTest, PlanCacheEvictsEntriesToStayWithinSizeBudget) {
+    PlanCache planCache(100);
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+
+    unique_ptr<CanonicalQuery> first(canonicalize("{a: 1}"));
+    ASSERT_OK(planCache.set(*first, solns, createDecision(1U), Date_t{}));
+
+    // Set the budget so that it is exceeded as soon as a second entry is added.
+    const auto oldMaxSizeBytes = internalQueryCacheMaxSizeBytes.load();
+    ON_BLOCK_EXIT([oldMaxSizeBytes] { internalQueryCacheMaxSizeBytes.store(oldMaxSizeBytes); });
+    internalQueryCacheMaxSizeBytes.store(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() +
+                                         100);
+
+    std::string queryString = "{b: 1}";
+    for (int i = 0; i < 5; ++i) {
+        queryString[1] = 'b' + i;
+        unique_ptr<CanonicalQuery> query(canonicalize(queryString));
+        ASSERT_OK(planCache.set(*query, solns, createDecision(1U), Date_t{}));
+
+        // The most recently added entry is always retained.
+        ASSERT_EQ(planCache.get(*query).state, PlanCache::CacheEntryState::kPresentInactive);
+        ASSERT_EQ(planCache.size(), 1U);
+    }
+    ASSERT_EQ(planCache.get(*first).state, PlanCache::CacheEntryState::kNotPresent);
+}
+
+TEST(PlanCacheTest, PlanCacheSizeBudgetEvictsFromTheLargestPlanCache) {
+    PlanCache largeCache(100);
+    PlanCache smallCache(100);
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+
+    std::string queryString = "{a: 1}";
+    for (int i = 0; i < 5; ++i) {
+        queryString[1] = 'a' + i;
+        unique_ptr<CanonicalQuery> query(canonicalize(queryString));
+        ASSERT_OK(largeCache.set(*query, solns, createDecision(1U), Date_t{}));
+    }
+    unique_ptr<CanonicalQuery> first(canonicalize("{a: 1}"));
+    ASSERT_OK(smallCache.set(*first, solns, createDecision(1U), Date_t{}));
+
+    // Set the budget so that it is exceeded as soon as another entry is added.
+    const auto oldMaxSizeBytes = internalQueryCacheMaxSizeBytes.load();
+    ON_BLOCK_EXIT([oldMaxSizeBytes] { internalQueryCacheMaxSizeBytes.store(oldMaxSizeBytes); });
+    internalQueryCacheMaxSizeBytes.store(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() +
+                                         100);
+
+    // Adding to the small plan cache evicts the least recently used entries of the large one.
+    unique_ptr<CanonicalQuery> second(canonicalize("{b: 1}"));
+    ASSERT_OK(smallCache.set(*second, solns, createDecision(1U), Date_t{}));
+    ASSERT_EQ(smallCache.size(), 2U);
+    ASSERT_EQ(largeCache.size(), 4U);
+    ASSERT_EQ(largeCache.get(*first).state, PlanCache::CacheEntryState::kNotPresent);
+}
+
+TEST(PlanCacheTest, PartitionedPlanCacheEntryLimitDoesNotExceedSize) {
+    PlanCache planCache(10, 4);
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+
+    std::string queryString = "{a: 1}";
+    for (int i = 0; i < 20; ++i) {
+        queryString[1] = 'a' + i;
+        unique_ptr<CanonicalQuery> query(canonicalize(queryString));
+        ASSERT_OK(planCache.set(*query, solns, createDecision(1U), Date_t{}));
+    }
+    ASSERT_LTE(planCache.size(), 10U);
+}
+
 TEST(PlanCacheTest, PlanCacheSizeWithMultiplePlanCaches) {
     PlanCache planCache1;
     PlanCache planCache2;
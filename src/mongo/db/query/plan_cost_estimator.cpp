@@ -0,0 +1,192 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_estimator.h"
+
+#include <algorithm>
+
+namespace mongo {
+namespace plan_cost_estimator {
+namespace {
+
+struct Estimate {
+    // The keys and documents examined by a plan.
+    double cost = 0;
+
+    // The results it returns.
+    double numResults = 0;
+};
+
+boost::optional<double> estimateKeysExamined(const IndexScanNode& node,
+                                             double numRecords,
+                                             const HistogramProvider& histograms) {
+    // Histograms order values with the simple comparator, and don't account for the documents left
+    // out of sparse and partial indexes.
+    const auto& index = node.index;
+    if (index.type != INDEX_BTREE || index.sparse || index.filterExpr || index.collator ||
+        node.bounds.isSimpleRange) {
+        return boost::none;
+    }
+
+    double selectivity = 1;
+    double keysPerDocument = 1;
+    for (size_t i = 0; i < node.bounds.fields.size(); ++i) {
+        const auto& oil = node.bounds.fields[i];
+        auto histogram = histograms(oil.name);
+        if (!histogram) {
+            if (i == 0) {
+                return boost::none;
+            }
+            break;
+        }
+
+        selectivity *= histogram->estimateSelectivity(oil);
+        keysPerDocument *= std::max(1.0, histogram->getValuesPerDocument());
+
+        // The bounds on a field only narrow the scan when those on the fields before it are points.
+        if (!std::all_of(oil.intervals.begin(), oil.intervals.end(), [](auto&& interval) {
+                return interval.isPoint();
+            })) {
+            break;
+        }
+    }
+    return numRecords * keysPerDocument * selectivity;
+}
+
+boost::optional<Estimate> estimate(const QuerySolutionNode* node,
+                                   double numRecords,
+                                   const HistogramProvider& histograms) {
+    std::vector<Estimate> children;
+    for (auto child : node->children) {
+        auto childEstimate = estimate(child, numRecords, histograms);
+        if (!childEstimate) {
+            return boost::none;
+        }
+        children.push_back(*childEstimate);
+    }
+
+    auto sumOfCosts = [&] {
+        double cost = 0;
+        for (auto&& child : children) {
+            cost += child.cost;
+        }
+        return cost;
+    };
+
+    switch (node->getType()) {
+        case STAGE_COLLSCAN:
+            return Estimate{numRecords, numRecords};
+        case STAGE_IXSCAN: {
+            auto keys = estimateKeysExamined(
+                *static_cast<const IndexScanNode*>(node), numRecords, histograms);
+            if (!keys) {
+                return boost::none;
+            }
+            return Estimate{*keys, *keys};
+        }
+        case STAGE_FETCH:
+        case STAGE_SORT_DEFAULT:
+        case STAGE_SORT_SIMPLE:
+            // Each result of the child is fetched, or buffered and sorted.
+            return Estimate{children[0].cost + children[0].numResults, children[0].numResults};
+        case STAGE_PROJECTION_DEFAULT:
+        case STAGE_PROJECTION_COVERED:
+        case STAGE_PROJECTION_SIMPLE:
+        case STAGE_SHARDING_FILTER:
+        case STAGE_SORT_KEY_GENERATOR:
+            return children[0];
+        case STAGE_AND_HASH:
+        case STAGE_AND_SORTED: {
+            double numResults = children[0].numResults;
+            for (auto&& child : children) {
+                numResults = std::min(numResults, child.numResults);
+            }
+            return Estimate{sumOfCosts(), numResults};
+        }
+        case STAGE_OR:
+        case STAGE_SORT_MERGE: {
+            double numResults = 0;
+            for (auto&& child : children) {
+                numResults += child.numResults;
+            }
+            return Estimate{sumOfCosts(), numResults};
+        }
+        default:
+            return boost::none;
+    }
+}
+
+}  // namespace
+
+boost::optional<double> estimateCost(const QuerySolutionNode* root,
+                                     double numRecords,
+                                     const HistogramProvider& histograms) {
+    auto rootEstimate = estimate(root, numRecords, histograms);
+    if (!rootEstimate) {
+        return boost::none;
+    }
+    return rootEstimate->cost;
+}
+
+size_t pruneCandidates(std::vector<std::unique_ptr<QuerySolution>>* solutions,
+                       double numRecords,
+                       const HistogramProvider& histograms,
+                       double pruneRatio) {
+    std::vector<double> costs;
+    for (auto&& solution : *solutions) {
+        auto cost = estimateCost(solution->root(), numRecords, histograms);
+        if (!cost) {
+            return 0;
+        }
+        costs.push_back(*cost);
+    }
+    if (costs.empty()) {
+        return 0;
+    }
+
+    // The cheapest candidate is always kept, even when it's estimated to examine nothing.
+    const double cheapest = *std::min_element(costs.begin(), costs.end());
+    const double threshold = std::max(cheapest, 1.0) * pruneRatio;
+
+    std::vector<std::unique_ptr<QuerySolution>> kept;
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        if (costs[i] <= threshold || costs[i] == cheapest) {
+            kept.push_back(std::move((*solutions)[i]));
+        }
+    }
+
+    const size_t numPruned = solutions->size() - kept.size();
+    *solutions = std::move(kept);
+    return numPruned;
+}
+
+}  // namespace plan_cost_estimator
+}  // namespace mongo
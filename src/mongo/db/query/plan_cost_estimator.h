@@ -0,0 +1,69 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/query/histogram.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo {
+namespace plan_cost_estimator {
+
+/**
+ * Returns the histogram of the field at 'path' in the collection being planned for, or nullptr if
+ * none is available.
+ */
+using HistogramProvider = std::function<std::shared_ptr<const Histogram>(StringData path)>;
+
+/**
+ * Returns the estimated number of index keys and documents examined by the plan rooted at 'root'
+ * over a collection of 'numRecords' documents. Returns boost::none if the plan contains a stage,
+ * or scans an index, whose cost can't be estimated.
+ */
+boost::optional<double> estimateCost(const QuerySolutionNode* root,
+                                     double numRecords,
+                                     const HistogramProvider& histograms);
+
+/**
+ * Removes from 'solutions' those which are estimated to cost more than 'pruneRatio' times the
+ * cheapest, and returns how many were removed. Leaves 'solutions' untouched if the cost of any of
+ * them can't be estimated.
+ */
+size_t pruneCandidates(std::vector<std::unique_ptr<QuerySolution>>* solutions,
+                       double numRecords,
+                       const HistogramProvider& histograms,
+                       double pruneRatio);
+
+}  // namespace plan_cost_estimator
+}  // namespace mongo
@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_estimator.h"
+
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+constexpr double kNumRecords = 1000;
+
+IndexEntry buildSimpleIndexEntry(const BSONObj& kp) {
+    return {kp,
+            IndexNames::nameToType(IndexNames::findPluginName(kp)),
+            IndexDescriptor::kLatestIndexVersion,
+            false,
+            {},
+            {},
+            false,
+            false,
+            CoreIndexInfo::Identifier(kp.toString()),
+            nullptr,
+            {},
+            nullptr,
+            nullptr};
+}
+
+class PlanCostEstimatorTest : public unittest::Test {
+protected:
+    PlanCostEstimatorTest() {
+        // 'a' is uniformly distributed over [0, 1000), and 'b' only takes the values 0 and 1.
+        for (int i = 0; i < kNumRecords; ++i) {
+            _docs.push_back(BSON("a" << i << "b" << i % 2));
+        }
+        for (auto&& field : {"a", "b"}) {
+            std::vector<BSONElement> values;
+            for (auto&& doc : _docs) {
+                values.push_back(doc[field]);
+            }
+            _histograms[field] = std::make_shared<const Histogram>(
+                Histogram::make(std::move(values), _docs.size(), 32));
+        }
+    }
+
+    plan_cost_estimator::HistogramProvider histograms() const {
+        return [this](StringData path) -> std::shared_ptr<const Histogram> {
+            auto it = _histograms.find(path);
+            return it == _histograms.end() ? nullptr : it->second;
+        };
+    }
+
+    /**
+     * Returns a fetch of the index scan of {field: 1} over [start, end).
+     */
+    static std::unique_ptr<QuerySolutionNode> makeFetchIxscan(const std::string& field,
+                                                              int start,
+                                                              int end) {
+        auto ixscan = std::make_unique<IndexScanNode>(buildSimpleIndexEntry(BSON(field << 1)));
+        OrderedIntervalList oil(field);
+        oil.intervals.push_back(Interval(BSON("" << start << "" << end), true, false));
+        ixscan->bounds.fields.push_back(oil);
+
+        auto fetch = std::make_unique<FetchNode>();
+        fetch->children.push_back(ixscan.release());
+        return fetch;
+    }
+
+    static std::unique_ptr<QuerySolution> makeSolution(std::unique_ptr<QuerySolutionNode> root) {
+        auto solution = std::make_unique<QuerySolution>();
+        solution->setRoot(std::move(root));
+        return solution;
+    }
+
+private:
+    std::vector<BSONObj> _docs;
+    StringMap<std::shared_ptr<const Histogram>> _histograms;
+};
+
+TEST_F(PlanCostEstimatorTest, CollectionScanExaminesEveryDocument) {
+    CollectionScanNode collscan;
+    auto cost = plan_cost_estimator::estimateCost(&collscan, kNumRecords, histograms());
+    ASSERT(cost);
+    ASSERT_EQ(kNumRecords, *cost);
+}
+
+TEST_F(PlanCostEstimatorTest, FetchOfIndexScanExaminesKeysAndDocuments) {
+    auto root = makeFetchIxscan("a", 0, 100);
+    auto cost = plan_cost_estimator::estimateCost(root.get(), kNumRecords, histograms());
+    ASSERT(cost);
+    ASSERT_APPROX_EQUAL(200, *cost, 30);
+}
+
+TEST_F(PlanCostEstimatorTest, NoEstimateWithoutHistogram) {
+    auto root = makeFetchIxscan("c", 0, 100);
+    ASSERT_FALSE(plan_cost_estimator::estimateCost(root.get(), kNumRecords, histograms()));
+}
+
+TEST_F(PlanCostEstimatorTest, NoEstimateForSparseIndex) {
+    auto root = makeFetchIxscan("a", 0, 100);
+    static_cast<IndexScanNode*>(root->children[0])->index.sparse = true;
+    ASSERT_FALSE(plan_cost_estimator::estimateCost(root.get(), kNumRecords, histograms()));
+}
+
+TEST_F(PlanCostEstimatorTest, PrunesExpensiveCandidates) {
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeSolution(makeFetchIxscan("b", 0, 2)));
+    solutions.push_back(makeSolution(makeFetchIxscan("a", 0, 10)));
+    solutions.push_back(makeSolution(makeFetchIxscan("a", 0, 20)));
+
+    ASSERT_EQ(1U,
+              plan_cost_estimator::pruneCandidates(&solutions, kNumRecords, histograms(), 10));
+    ASSERT_EQ(2U, solutions.size());
+    for (auto&& solution : solutions) {
+        auto ixscan = static_cast<const IndexScanNode*>(solution->root()->children[0]);
+        ASSERT_BSONOBJ_EQ(BSON("a" << 1), ixscan->index.keyPattern);
+    }
+}
+
+TEST_F(PlanCostEstimatorTest, KeepsEveryCandidateIfOneCannotBeEstimated) {
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeSolution(makeFetchIxscan("b", 0, 2)));
+    solutions.push_back(makeSolution(makeFetchIxscan("a", 0, 10)));
+    solutions.push_back(makeSolution(makeFetchIxscan("c", 0, 10)));
+
+    ASSERT_EQ(0U,
+              plan_cost_estimator::pruneCandidates(&solutions, kNumRecords, histograms(), 10));
+    ASSERT_EQ(3U, solutions.size());
+}
+
+}  // namespace
+}  // namespace mongo
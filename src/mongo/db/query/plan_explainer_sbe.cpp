@@ -96,6 +96,16 @@ void statsToBSON(const QuerySolutionNode* node,
             }
             break;
         }
+        case STAGE_COLUMN_SCAN: {
+            auto csn = static_cast<const ColumnScanNode*>(node);
+            bob->append("keyPattern", csn->index.keyPattern);
+            bob->append("indexName", csn->index.identifier.catalogName);
+            bob->append("fields", csn->fields);
+            if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+                // TODO SERVER-51409.
+            }
+            break;
+        }
 
         case STAGE_ENSURE_SORTED: {
             if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
@@ -289,6 +299,12 @@ std::string PlanExplainerSBE::getPlanSummary() const {
         sb << stageTypeToString(node->getType());
 
         switch (node->getType()) {
+            case STAGE_COLUMN_SCAN: {
+                auto csn = static_cast<const ColumnScanNode*>(node);
+                const KeyPattern keyPattern{csn->index.keyPattern};
+                sb << " " << keyPattern;
+                break;
+            }
             case STAGE_COUNT_SCAN: {
                 auto csn = static_cast<const CountScanNode*>(node);
                 const KeyPattern keyPattern{csn->index.keyPattern};
@@ -369,6 +385,11 @@ void PlanExplainerSBE::getSummaryStats(PlanSummaryStats* statsOut) const {
         invariant(node);
 
         switch (node->getType()) {
+            case STAGE_COLUMN_SCAN: {
+                auto csn = static_cast<const ColumnScanNode*>(node);
+                statsOut->indexesUsed.insert(csn->index.identifier.catalogName);
+                break;
+            }
             case STAGE_COUNT_SCAN: {
                 auto csn = static_cast<const CountScanNode*>(node);
                 statsOut->indexesUsed.insert(csn->index.identifier.catalogName);
@@ -188,6 +188,9 @@ struct BaseCandidatePlan {
     bool exitedEarly{false};
     // Indicates that this candidate plan has failed in a recoverable fashion during the trial run.
     bool failed{false};
+    // Indicates that the trial run stopped working this candidate plan early, because it was far
+    // enough behind the best candidate. It is still ranked with the stats it had at that point.
+    bool pruned{false};
     // Any results produced during the plan's execution prior to scoring are retained here.
     std::queue<ResultType> results;
 };
@@ -67,6 +67,9 @@ struct PlanSummaryStats {
     // Did this plan failed during execution?
     bool planFailed = false;
 
+    // Did the multi-planner stop working this plan before the end of its trial period?
+    bool planPruned = false;
+
     // The names of each index used by the plan.
     std::set<std::string> indexesUsed;
 
@@ -206,6 +206,21 @@ bool isOplogTsLowerBoundPred(const mongo::MatchExpression* me) {
 
     return me->path() == repl::OpTime::kTimestampFieldName;
 }
+
+/**
+ * Returns true if the field at position 'pos' of the key pattern of 'index' is known to have no
+ * multikey components. Every key generated for a document then holds the whole value of that
+ * field, so an INEXACT_COVERED predicate over it may be evaluated against the index key even if
+ * other fields of the index are multikey.
+ */
+bool isNonMultikeyField(const IndexEntry& index, size_t pos) {
+    if (!index.multikey) {
+        return true;
+    }
+
+    // Without path-level metadata, any field of a multikey index may be an array.
+    return pos < index.multikeyPaths.size() && index.multikeyPaths[pos].empty();
+}
 }  // namespace
 
 std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
@@ -1301,7 +1316,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::_buildIndexedDataAccess(
             if (tightness == IndexBoundsBuilder::EXACT) {
                 return soln;
             } else if (tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-                       !indices[tag->index].multikey) {
+                       isNonMultikeyField(indices[tag->index], tag->pos)) {
                 verify(nullptr == soln->filter.get());
                 soln->filter = std::move(ownedRoot);
                 return soln;
@@ -1449,18 +1464,18 @@ void QueryPlannerAccess::handleFilterAnd(ScanBuildingState* scanState) {
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
         delete child;
     } else if (scanState->tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-               (INDEX_TEXT == index.type || !index.multikey)) {
+               (INDEX_TEXT == index.type || isNonMultikeyField(index, scanState->ixtag->pos))) {
         // The bounds are not exact, but the information needed to
         // evaluate the predicate is in the index key. Remove the
         // MatchExpression from its parent and attach it to the filter
         // of the index scan we're building.
         //
-        // We can only use this optimization if the index is NOT multikey.
-        // Suppose that we had the multikey index {x: 1} and a document
+        // We can only use this optimization if the predicate's field is NOT
+        // multikey. Suppose that we had the multikey index {x: 1} and a document
         // {x: ["a", "b"]}. Now if we query for {x: /b/} the filter might
         // ever only be applied to the index key "a". We'd incorrectly
         // conclude that the document does not match the query :( so we
-        // gotta stick to non-multikey indices.
+        // gotta stick to fields with no multikey components.
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
 
         addFilterToSolutionNode(scanState->currentScan.get(), child, root->matchType());
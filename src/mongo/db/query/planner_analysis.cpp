@@ -39,8 +39,11 @@
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/logv2/log.h"
 
@@ -561,8 +564,86 @@ bool canUseSimpleSort(const QuerySolutionNode& solnRoot,
         && !splitLimitedSortEligible;
 }
 
+/**
+ * Sets 'fieldsToReturn' on every COLLSCAN in the tree rooted at 'node' which may return trimmed
+ * documents. Tailable, resumable and oplog scans read other fields of the documents they return,
+ * so they are left alone.
+ */
+void setCollectionScanFieldsToReturn(const std::set<std::string>& fields, QuerySolutionNode* node) {
+    if (STAGE_COLLSCAN == node->getType()) {
+        auto csn = static_cast<CollectionScanNode*>(node);
+        if (!csn->tailable && !csn->minTs && !csn->maxTs && !csn->requestResumeToken &&
+            !csn->resumeAfterRecordId && !csn->shouldTrackLatestOplogTimestamp) {
+            csn->fieldsToReturn = fields;
+        }
+    }
+
+    for (auto&& child : node->children) {
+        setCollectionScanFieldsToReturn(fields, child);
+    }
+}
+
+/**
+ * If 'sortNode' sorts the documents of a TEXT stage by nothing but their text score and keeps only
+ * the first 'sortNode->limit' of them, the TEXT stage need only score and return that many.
+ */
+void pushDownLimitToTextNode(const SortNode& sortNode) {
+    const auto maxTopK = static_cast<size_t>(internalQueryMaxTextScoreTopK.load());
+    if (0 == sortNode.limit || sortNode.limit > maxTopK || 1 != sortNode.pattern.nFields() ||
+        !QueryRequest::isTextScoreMeta(sortNode.pattern.firstElement())) {
+        return;
+    }
+
+    invariant(1 == sortNode.children.size());
+    if (STAGE_TEXT == sortNode.children[0]->getType()) {
+        static_cast<TextNode*>(sortNode.children[0])->topK = sortNode.limit;
+    }
+}
+
 }  // namespace
 
+// static
+boost::optional<std::set<std::string>> QueryPlannerAnalysis::getTopLevelFieldsRead(
+    const CanonicalQuery& query, const QueryPlannerParams& params) {
+    const auto* proj = query.getProj();
+    if (!proj || proj->type() != projection_ast::ProjectType::kInclusion ||
+        proj->requiresDocument() || query.getQueryRequest().returnKey()) {
+        return boost::none;
+    }
+
+    // $where does not report its dependencies, since it is evaluated over the whole document.
+    if (QueryPlannerCommon::hasNode(query.root(), MatchExpression::WHERE)) {
+        return boost::none;
+    }
+
+    DepsTracker deps;
+    query.root()->addDependencies(&deps);
+    if (deps.needWholeDocument) {
+        return boost::none;
+    }
+
+    std::set<std::string> paths{deps.fields.begin(), deps.fields.end()};
+    paths.insert(proj->getRequiredFields().begin(), proj->getRequiredFields().end());
+    for (auto&& elem : query.getQueryRequest().getSort()) {
+        if (elem.type() == BSONType::Object) {
+            // A $meta sort does not read any field of the document.
+            continue;
+        }
+        paths.insert(elem.fieldName());
+    }
+    if (params.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
+        for (auto&& elem : params.shardKey) {
+            paths.insert(elem.fieldName());
+        }
+    }
+
+    std::set<std::string> fields;
+    for (auto&& path : paths) {
+        fields.insert(FieldRef{path}.getPart(0).toString());
+    }
+    return fields;
+}
+
 // static
 void QueryPlannerAnalysis::analyzeGeo(const QueryPlannerParams& params,
                                       QuerySolutionNode* solnRoot) {
@@ -841,6 +922,7 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         // We have a true limit. The limit can be combined with the SORT stage.
         sortNodeRaw->limit =
             static_cast<size_t>(*qr.getLimit()) + static_cast<size_t>(qr.getSkip().value_or(0));
+        pushDownLimitToTextNode(*sortNodeRaw);
     } else if (qr.getNToReturn()) {
         // We have an ntoreturn specified by an OP_QUERY style find. This is used
         // by clients to mean both batchSize and limit.
@@ -1029,6 +1111,12 @@ std::unique_ptr<QuerySolution> QueryPlannerAnalysis::analyzeDataAccess(
 
     solnRoot = tryPushdownProjectBeneathSort(std::move(solnRoot));
 
+    // If the plan only reads some top-level fields of the documents, let its collection scans
+    // return trimmed documents.
+    if (auto fields = getTopLevelFieldsRead(query, params)) {
+        setCollectionScanFieldsToReturn(*fields, solnRoot.get());
+    }
+
     soln->setRoot(std::move(solnRoot));
     return soln;
 }
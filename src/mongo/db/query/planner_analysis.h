@@ -62,6 +62,14 @@ public:
      */
     static BSONObj getSortPattern(const BSONObj& indexKeyPattern);
 
+    /**
+     * Returns the names of the top-level fields which are read by the filter, sort, shard key
+     * and inclusion projection of 'query', or boost::none if answering 'query' may need any other
+     * part of the documents.
+     */
+    static boost::optional<std::set<std::string>> getTopLevelFieldsRead(
+        const CanonicalQuery& query, const QueryPlannerParams& params);
+
     /**
      * In brief: performs sort and covering analysis.
      *
@@ -33,6 +33,7 @@
 
 #include "mongo/db/query/query_planner.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <vector>
 
@@ -334,6 +335,36 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+/**
+ * Returns a plan which reads the documents of the collection back from the columnstore index
+ * 'index', or nullptr if answering 'query' may need a field which 'index' does not store.
+ */
+std::unique_ptr<QuerySolution> buildColumnScanSoln(const IndexEntry& index,
+                                                   const CanonicalQuery& query,
+                                                   const QueryPlannerParams& params) {
+    invariant(index.type == IndexType::INDEX_COLUMN);
+    auto fieldsRead = QueryPlannerAnalysis::getTopLevelFieldsRead(query, params);
+    if (!fieldsRead) {
+        return nullptr;
+    }
+
+    std::set<std::string> fieldsStored;
+    for (auto&& elem : index.keyPattern) {
+        fieldsStored.insert(elem.fieldName());
+    }
+    if (!std::includes(fieldsStored.begin(),
+                       fieldsStored.end(),
+                       fieldsRead->begin(),
+                       fieldsRead->end())) {
+        return nullptr;
+    }
+
+    auto csn = std::make_unique<ColumnScanNode>(
+        index, std::vector<std::string>{fieldsRead->begin(), fieldsRead->end()});
+    csn->filter = query.root()->shallowClone();
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(csn));
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
@@ -679,6 +710,36 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
 
         hintedIndexEntry.emplace(fullIndexList.front());
+
+        // A columnstore index can only stand in for the collection as a whole.
+        if (hintedIndexEntry->type == IndexType::INDEX_COLUMN) {
+            if (!query.getQueryRequest().getMin().isEmpty() ||
+                !query.getQueryRequest().getMax().isEmpty()) {
+                return Status(ErrorCodes::NoQueryExecutionPlans,
+                              "min and max are incompatible with a columnstore index");
+            }
+            auto soln = buildColumnScanSoln(*hintedIndexEntry, query, params);
+            if (!soln) {
+                return Status(ErrorCodes::NoQueryExecutionPlans,
+                              "hinted columnstore index does not store every field the query "
+                              "reads");
+            }
+            std::vector<std::unique_ptr<QuerySolution>> out;
+            out.push_back(std::move(soln));
+            return {std::move(out)};
+        }
+    }
+
+    // Columnstore indexes cannot answer predicates or provide a sort. They are only considered
+    // in place of a collection scan.
+    std::vector<IndexEntry> columnIndexes;
+    for (auto it = fullIndexList.begin(); it != fullIndexList.end();) {
+        if (it->type == IndexType::INDEX_COLUMN) {
+            columnIndexes.push_back(std::move(*it));
+            it = fullIndexList.erase(it);
+        } else {
+            ++it;
+        }
     }
 
     // Figure out what fields we care about.
@@ -1100,6 +1161,22 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         return Status(ErrorCodes::NoQueryExecutionPlans, "No query solutions");
     }
 
+    // Prefer reading the documents back from a columnstore index which stores every field the
+    // query needs. Such plans are never cached, since they are only built when nothing else is
+    // available.
+    if (possibleToCollscan && collScanRequired) {
+        for (auto&& index : columnIndexes) {
+            if (auto soln = buildColumnScanSoln(index, query, params)) {
+                LOGV2_DEBUG(5843208,
+                            5,
+                            "Planner: outputting a column scan",
+                            "columnScan"_attr = redact(soln->toString()));
+                out.push_back(std::move(soln));
+                return {std::move(out)};
+            }
+        }
+    }
+
     if (possibleToCollscan && (collscanRequested || collScanRequired)) {
         auto collscan = buildCollscanSoln(query, isTailable, params);
         if (!collscan && collScanRequired) {
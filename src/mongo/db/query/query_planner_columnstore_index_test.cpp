@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_planner_test_fixture.h"
+
+namespace mongo {
+/**
+ * A specialization of the QueryPlannerTest fixture which presents the planner with a columnstore
+ * index on the fields 'a' and 'b'.
+ */
+class QueryPlannerColumnStoreTest : public QueryPlannerTest {
+protected:
+    void setUp() final {
+        QueryPlannerTest::setUp();
+        addIndex(kKeyPattern);
+    }
+
+    const BSONObj kKeyPattern = BSON("a"
+                                     << "columnstore"
+                                     << "b"
+                                     << "columnstore");
+};
+
+TEST_F(QueryPlannerColumnStoreTest, ReplacesCollscanWhenIndexStoresEveryFieldRead) {
+    runQuerySortProj(fromjson("{a: {$gt: 1}}"), BSONObj(), fromjson("{_id: 0, b: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, b: 1}, node: "
+        "{column_scan: {fields: ['a', 'b'], filter: {a: {$gt: 1}}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, SortsAboveTheColumnScan) {
+    runQuerySortProj(BSONObj(), fromjson("{b: 1}"), fromjson("{_id: 0, a: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {sort: {pattern: {b: 1}, limit: 0, type: 'simple', "
+        "node: {column_scan: {fields: ['a', 'b']}}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, NotUsedWhenQueryReadsAFieldTheIndexDoesNotStore) {
+    // The projection includes '_id'.
+    runQuerySortProj(BSONObj(), BSONObj(), fromjson("{a: 1}"));
+    assertHasOnlyCollscan();
+
+    runQuerySortProj(fromjson("{c: 1}"), BSONObj(), fromjson("{_id: 0, a: 1}"));
+    assertHasOnlyCollscan();
+
+    // Without a projection the whole document is returned.
+    runQuery(fromjson("{a: 1}"));
+    assertHasOnlyCollscan();
+}
+
+TEST_F(QueryPlannerColumnStoreTest, NotUsedToAnswerPredicates) {
+    addIndex(BSON("b" << 1));
+    runQuerySortProj(fromjson("{b: 1}"), BSONObj(), fromjson("{_id: 0, a: 1, b: 1}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1, b: 1}, node: "
+        "{fetch: {node: {ixscan: {pattern: {b: 1}}}}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1, b: 1}, node: {cscan: {dir: 1, filter: {b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, CanBeHinted) {
+    runQuerySortProjSkipNToReturnHint(
+        fromjson("{a: 1}"), BSONObj(), fromjson("{_id: 0, a: 1}"), 0, 0, kKeyPattern);
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {column_scan: {fields: ['a'], filter: {a: 1}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, HintFailsWhenIndexCannotAnswerTheQuery) {
+    runInvalidQuerySortProjSkipNToReturnHint(
+        fromjson("{a: 1}"), BSONObj(), fromjson("{a: 1}"), 0, 0, kKeyPattern);
+    assertNoSolutions();
+
+    runInvalidQueryHintMinMax(BSONObj(), kKeyPattern, fromjson("{a: 1}"), BSONObj());
+    assertNoSolutions();
+}
+
+}  // namespace mongo
@@ -925,6 +925,40 @@ TEST_F(QueryPlannerTest, DollarResumeAfterFieldPropagatedFromQueryRequestToStage
     ASSERT_EQUALS(RecordId(42LL), csn->resumeAfterRecordId.get());
 }
 
+/**
+ * Returns the COLLSCAN reached by following the first child of each node from 'node'.
+ */
+const CollectionScanNode* findCollscan(const QuerySolutionNode* node) {
+    while (STAGE_COLLSCAN != node->getType()) {
+        ASSERT_FALSE(node->children.empty());
+        node = node->children[0];
+    }
+    return static_cast<const CollectionScanNode*>(node);
+}
+
+TEST_F(QueryPlannerTest, InclusionProjectionPushesFieldsToReturnIntoCollscan) {
+    runQueryAsCommand(fromjson(
+        "{find: 'testns', filter: {'b.c': 1}, sort: {d: 1}, projection: {_id: 0, 'a.x': 1}}"));
+    assertHasOnlyCollscan();
+
+    const auto* csn = findCollscan(solns.front()->root());
+    ASSERT(csn->fieldsToReturn);
+    ASSERT(*csn->fieldsToReturn == (std::set<std::string>{"a", "b", "d"}));
+}
+
+TEST_F(QueryPlannerTest, ExclusionProjectionDoesNotPushFieldsToReturnIntoCollscan) {
+    runQueryAsCommand(fromjson("{find: 'testns', filter: {b: 1}, projection: {a: 0}}"));
+    assertHasOnlyCollscan();
+    ASSERT_FALSE(findCollscan(solns.front()->root())->fieldsToReturn);
+}
+
+TEST_F(QueryPlannerTest, WholeDocumentFilterDoesNotPushFieldsToReturnIntoCollscan) {
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {$expr: {$eq: ['$$ROOT', {}]}}, projection: {a: 1}}"));
+    assertHasOnlyCollscan();
+    ASSERT_FALSE(findCollscan(solns.front()->root())->fieldsToReturn);
+}
+
 TEST_F(QueryPlannerTest, PreserveRecordIdOptionPrecludesSimpleSort) {
     params.options |= QueryPlannerParams::PRESERVE_RECORD_ID;
 
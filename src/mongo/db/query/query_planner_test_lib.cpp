@@ -283,6 +283,43 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
         }
 
         return filterMatches(filter.Obj(), collation, trueSoln);
+    } else if (STAGE_COLUMN_SCAN == trueSoln->getType()) {
+        const ColumnScanNode* csn = static_cast<const ColumnScanNode*>(trueSoln);
+        BSONElement el = testSoln["column_scan"];
+        if (el.eoo() || !el.isABSONObj()) {
+            return false;
+        }
+        BSONObj csObj = el.Obj();
+        invariant(bsonObjFieldsAreInSet(csObj, {"name", "fields", "filter"}));
+
+        BSONElement name = csObj["name"];
+        if (!name.eoo() && name.valueStringData() != csn->index.identifier.catalogName) {
+            return false;
+        }
+
+        BSONElement fields = csObj["fields"];
+        if (!fields.eoo()) {
+            if (fields.type() != BSONType::Array) {
+                return false;
+            }
+            std::vector<std::string> expectedFields;
+            for (auto&& field : fields.Obj()) {
+                expectedFields.push_back(field.str());
+            }
+            if (expectedFields != csn->fields) {
+                return false;
+            }
+        }
+
+        BSONElement filter = csObj["filter"];
+        if (filter.eoo()) {
+            return true;
+        } else if (filter.isNull()) {
+            return nullptr == csn->filter;
+        } else if (!filter.isABSONObj()) {
+            return false;
+        }
+        return filterMatches(filter.Obj(), BSONObj(), trueSoln);
     } else if (STAGE_IXSCAN == trueSoln->getType()) {
         const IndexScanNode* ixn = static_cast<const IndexScanNode*>(trueSoln);
         BSONElement el = testSoln["ixscan"];
@@ -403,7 +440,8 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
                                          "diacriticSensitive",
                                          "prefix",
                                          "collation",
-                                         "filter"}));
+                                         "filter",
+                                         "topK"}));
 
         BSONElement searchElt = textObj["search"];
         if (!searchElt.eoo()) {
@@ -444,6 +482,13 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             }
         }
 
+        BSONElement topKElt = textObj["topK"];
+        if (!topKElt.eoo()) {
+            if (!topKElt.isNumber() || topKElt.numberLong() != static_cast<long long>(node->topK)) {
+                return false;
+            }
+        }
+
         BSONObj collation;
         if (BSONElement collationElt = textObj["collation"]) {
             if (!collationElt.isABSONObj()) {
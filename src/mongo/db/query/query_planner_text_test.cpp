@@ -438,6 +438,51 @@ TEST_F(QueryPlannerTest, SortKeyMetaProjectionWithTextScoreMetaSort) {
         "{text: {search: 'foo'}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, LimitedTextScoreSortIsPushedDownToTextNode) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx" << 1));
+
+    runQueryAsCommand(fromjson(
+        "{find: 'testns', filter: {$text: {$search: 'foo bar'}}, sort: {a: {$meta: 'textScore'}}, "
+        "skip: 2, limit: 3}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{skip: {n: 2, node: {sort: {limit: 5, pattern: {a: {$meta: 'textScore'}}, "
+        "type: 'default', node: {text: {search: 'foo bar', topK: 5}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, UnlimitedTextScoreSortIsNotPushedDownToTextNode) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx" << 1));
+
+    runQuerySortProj(fromjson("{$text: {$search: 'foo'}}"),
+                     fromjson("{a: {$meta: 'textScore'}}"),
+                     BSONObj());
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{sort: {limit: 0, pattern: {a: {$meta: 'textScore'}}, type: 'default', node: "
+        "{text: {search: 'foo', topK: 0}}}}");
+}
+
+TEST_F(QueryPlannerTest, LimitedCompoundSortIsNotPushedDownToTextNode) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx" << 1));
+
+    runQueryAsCommand(fromjson(
+        "{find: 'testns', filter: {$text: {$search: 'foo'}}, "
+        "sort: {a: {$meta: 'textScore'}, b: 1}, limit: 3}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{sort: {limit: 3, pattern: {a: {$meta: 'textScore'}, b: 1}, type: 'default', node: "
+        "{text: {search: 'foo', topK: 0}}}}");
+}
+
 TEST_F(QueryPlannerTest, PredicatesOverLeadingFieldsWithSharedPathPrefixHandledCorrectly) {
     const bool multikey = true;
     addIndex(BSON("a.x" << 1 << "a.y" << 1 << "b.x" << 1 << "b.y" << 1 << "_fts"
@@ -184,6 +184,10 @@ void TextNode::appendToString(str::stream* ss, int indent) const {
     *ss << "diacriticSensitive= " << ftsQuery->getDiacriticSensitive() << '\n';
     addIndent(ss, indent + 1);
     *ss << "indexPrefix = " << indexPrefix.toString() << '\n';
+    if (topK) {
+        addIndent(ss, indent + 1);
+        *ss << "topK = " << topK << '\n';
+    }
     if (nullptr != filter) {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString();
@@ -197,6 +201,7 @@ QuerySolutionNode* TextNode::clone() const {
 
     copy->ftsQuery = this->ftsQuery->clone();
     copy->indexPrefix = this->indexPrefix;
+    copy->topK = this->topK;
 
     return copy;
 }
@@ -216,6 +221,14 @@ void CollectionScanNode::appendToString(str::stream* ss, int indent) const {
         addIndent(ss, indent + 1);
         *ss << "filter = " << filter->debugString();
     }
+    if (fieldsToReturn) {
+        addIndent(ss, indent + 1);
+        *ss << "fieldsToReturn = [";
+        for (auto&& field : *fieldsToReturn) {
+            *ss << " " << field;
+        }
+        *ss << " ]\n";
+    }
     addCommon(ss, indent);
 }
 
@@ -229,7 +242,36 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     copy->shouldTrackLatestOplogTimestamp = this->shouldTrackLatestOplogTimestamp;
     copy->assertMinTsHasNotFallenOffOplog = this->assertMinTsHasNotFallenOffOplog;
     copy->shouldWaitForOplogVisibility = this->shouldWaitForOplogVisibility;
+    copy->fieldsToReturn = this->fieldsToReturn;
+
+    return copy;
+}
+
+//
+// ColumnScanNode
+//
+
+void ColumnScanNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "COLUMN_SCAN\n";
+    addIndent(ss, indent + 1);
+    *ss << "name = " << index.identifier.catalogName << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "fields = [";
+    for (auto&& field : fields) {
+        *ss << " " << field;
+    }
+    *ss << " ]\n";
+    if (nullptr != filter) {
+        addIndent(ss, indent + 1);
+        *ss << "filter = " << filter->debugString();
+    }
+    addCommon(ss, indent);
+}
 
+QuerySolutionNode* ColumnScanNode::clone() const {
+    ColumnScanNode* copy = new ColumnScanNode(this->index, this->fields);
+    cloneBaseData(copy);
     return copy;
 }
 
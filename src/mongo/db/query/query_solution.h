@@ -30,6 +30,8 @@
 #pragma once
 
 #include <memory>
+#include <set>
+#include <string>
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj_comparator_interface.h"
@@ -416,6 +418,10 @@ struct TextNode : public QuerySolutionNodeWithSortSet {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // If non-zero, only this many of the highest-scoring documents need to be returned, because
+    // the TEXT node's parent sorts them by text score and keeps only the first 'topK'.
+    size_t topK = 0u;
 };
 
 struct CollectionScanNode : public QuerySolutionNodeWithSortSet {
@@ -480,6 +486,44 @@ struct CollectionScanNode : public QuerySolutionNodeWithSortSet {
 
     // Once the first matching document is found, assume that all documents after it must match.
     bool stopApplyingFilterAfterFirstMatch = false;
+
+    // If present, the only top-level fields of the scanned documents which the rest of the plan
+    // reads. Set by the planner once the whole plan is known.
+    boost::optional<std::set<std::string>> fieldsToReturn;
+};
+
+/**
+ * Scans a columnstore index in place of the collection. Produces one result per document of the
+ * collection, holding only those of the document's top-level fields which the index stores.
+ */
+struct ColumnScanNode : public QuerySolutionNodeWithSortSet {
+    ColumnScanNode(IndexEntry index, std::vector<std::string> fields)
+        : index(std::move(index)), fields(std::move(fields)) {}
+
+    virtual ~ColumnScanNode() {}
+
+    virtual StageType getType() const {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    virtual void appendToString(str::stream* ss, int indent) const;
+
+    bool fetched() const {
+        return true;
+    }
+    FieldAvailability getFieldAvailability(const std::string& field) const {
+        return FieldAvailability::kFullyProvided;
+    }
+    bool sortedByDiskLoc() const {
+        return false;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    IndexEntry index;
+
+    // The top-level fields to read from the index. Every one of them is stored by 'index'.
+    std::vector<std::string> fields;
 };
 
 /**
@@ -0,0 +1,78 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/s2_covering_cache.h"
+
+#include "mongo/db/query/expression_index_knobs_gen.h"
+#include "third_party/s2/s2regioncoverer.h"
+
+namespace mongo {
+
+S2CoveringCache::S2CoveringCache(size_t maxCoverings) : _coverings(maxCoverings) {}
+
+S2CoveringCache* S2CoveringCache::get() {
+    static const auto maxCoverings = gInternalQueryS2CoveringCacheSize.load();
+    if (maxCoverings <= 0) {
+        return nullptr;
+    }
+    static S2CoveringCache cache(maxCoverings);
+    return &cache;
+}
+
+std::string S2CoveringCache::makeKey(const S2RegionCoverer& coverer, StringData regionKey) {
+    // The coverer's parameters are fixed-width, so a key can't be read more than one way.
+    const int params[] = {coverer.min_level(), coverer.max_level(), coverer.max_cells()};
+    std::string key(reinterpret_cast<const char*>(params), sizeof(params));
+    key.append(regionKey.rawData(), regionKey.size());
+    return key;
+}
+
+boost::optional<std::vector<S2CellId>> S2CoveringCache::find(const std::string& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _coverings.find(key);
+    if (it == _coverings.end()) {
+        return boost::none;
+    }
+    _coverings.promote(it);
+    return it->second;
+}
+
+void S2CoveringCache::add(const std::string& key, std::vector<S2CellId> cover) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _coverings.add(key, std::move(cover));
+}
+
+size_t S2CoveringCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _coverings.size();
+}
+
+}  // namespace mongo
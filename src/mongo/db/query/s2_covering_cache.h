@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "third_party/s2/s2cellid.h"
+
+class S2RegionCoverer;
+
+namespace mongo {
+
+/**
+ * A process-wide cache of the S2 cell coverings of query regions, so that queries repeating a
+ * $geoWithin or $geoIntersects shape, or $geoNear annuli around the same point, don't run the
+ * region coverer again. Coverings are keyed by a caller-supplied key which must determine the
+ * region, combined with the levels and number of cells the coverer is configured with.
+ */
+class S2CoveringCache {
+    S2CoveringCache(const S2CoveringCache&) = delete;
+    S2CoveringCache& operator=(const S2CoveringCache&) = delete;
+
+public:
+    explicit S2CoveringCache(size_t maxCoverings);
+
+    /**
+     * Returns the cache used by the query planner and the GEO_NEAR_2DSPHERE stage, or nullptr if
+     * it's disabled by setting internalQueryS2CoveringCacheSize to 0.
+     */
+    static S2CoveringCache* get();
+
+    /**
+     * Returns the key under which the covering of the region identified by 'regionKey' is cached
+     * when it is computed with 'coverer'.
+     */
+    static std::string makeKey(const S2RegionCoverer& coverer, StringData regionKey);
+
+    /**
+     * Returns the covering cached under 'key', if there is one.
+     */
+    boost::optional<std::vector<S2CellId>> find(const std::string& key);
+
+    /**
+     * Caches 'cover' under 'key', evicting the least recently used covering if the cache is full.
+     */
+    void add(const std::string& key, std::vector<S2CellId> cover);
+
+    size_t size() const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("S2CoveringCache::_mutex");
+    LRUCache<std::string, std::vector<S2CellId>> _coverings;
+};
+
+}  // namespace mongo
@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/s2_covering_cache.h"
+
+#include "mongo/db/query/expression_index.h"
+#include "mongo/unittest/unittest.h"
+#include "third_party/s2/s2cap.h"
+#include "third_party/s2/s2latlng.h"
+#include "third_party/s2/s2regioncoverer.h"
+
+namespace mongo {
+namespace {
+
+S2Cap makeCap(double lat, double lng, double degrees) {
+    return S2Cap::FromAxisAngle(S2LatLng::FromDegrees(lat, lng).ToPoint(),
+                                S1Angle::Degrees(degrees));
+}
+
+TEST(S2CoveringCacheTest, KeyDependsOnCovererParameters) {
+    S2RegionCoverer coverer;
+    coverer.set_min_level(0);
+    coverer.set_max_level(23);
+    coverer.set_max_cells(20);
+    const auto key = S2CoveringCache::makeKey(coverer, "region");
+    ASSERT_EQ(key, S2CoveringCache::makeKey(coverer, "region"));
+    ASSERT_NE(key, S2CoveringCache::makeKey(coverer, "other"));
+
+    coverer.set_max_cells(8);
+    ASSERT_NE(key, S2CoveringCache::makeKey(coverer, "region"));
+}
+
+TEST(S2CoveringCacheTest, FindReturnsWhatWasAdded) {
+    S2CoveringCache cache(4);
+    ASSERT_FALSE(cache.find("a"));
+
+    std::vector<S2CellId> cover = {S2CellId::FromFacePosLevel(1, 0, 3),
+                                   S2CellId::FromFacePosLevel(2, 0, 5)};
+    cache.add("a", cover);
+    auto cached = cache.find("a");
+    ASSERT(cached);
+    ASSERT(cover == *cached);
+    ASSERT_EQ(1U, cache.size());
+}
+
+TEST(S2CoveringCacheTest, EvictsLeastRecentlyUsedCovering) {
+    S2CoveringCache cache(2);
+    cache.add("a", {S2CellId::FromFacePosLevel(0, 0, 0)});
+    cache.add("b", {S2CellId::FromFacePosLevel(1, 0, 0)});
+
+    // Looking up "a" makes "b" the least recently used.
+    ASSERT(cache.find("a"));
+    cache.add("c", {S2CellId::FromFacePosLevel(2, 0, 0)});
+    ASSERT_EQ(2U, cache.size());
+    ASSERT(cache.find("a"));
+    ASSERT_FALSE(cache.find("b"));
+    ASSERT(cache.find("c"));
+}
+
+TEST(S2CoveringCacheTest, CachedCoveringMatchesComputedCovering) {
+    auto cache = S2CoveringCache::get();
+    ASSERT(cache);
+
+    const auto cap = makeCap(40.7, -74.0, 0.5);
+    const auto expected = ExpressionMapping::get2dsphereCovering(cap);
+    ASSERT_FALSE(expected.empty());
+
+    const std::string regionKey = "s2_covering_cache_test cap";
+    ASSERT(expected == ExpressionMapping::get2dsphereCovering(cap, regionKey));
+
+    // The second lookup is answered by the cache, even for a region which isn't the one the key
+    // was cached with.
+    ASSERT(expected ==
+           ExpressionMapping::get2dsphereCovering(makeCap(-33.9, 151.2, 2.0), regionKey));
+}
+
+}  // namespace
+}  // namespace mongo
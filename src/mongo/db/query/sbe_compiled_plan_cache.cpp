@@ -0,0 +1,160 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_compiled_plan_cache.h"
+
+#include <boost/functional/hash.hpp>
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/input_params.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo::sbe {
+namespace {
+Counter64 compiledPlanCacheHits;
+Counter64 compiledPlanCacheMisses;
+
+ServerStatusMetricField<Counter64> compiledPlanCacheHitsMetric("query.sbeCompiledPlanCache.hits",
+                                                               &compiledPlanCacheHits);
+ServerStatusMetricField<Counter64> compiledPlanCacheMissesMetric(
+    "query.sbeCompiledPlanCache.misses", &compiledPlanCacheMisses);
+
+/**
+ * Encodes the shape of the solution tree rooted at 'node': the type of each node, the index scanned
+ * by each index scan, and the input parameters each node filters on.
+ */
+void encodeSolutionShape(const QuerySolutionNode* node, StringBuilder* builder) {
+    *builder << '(' << static_cast<int>(node->getType());
+    if (node->getType() == STAGE_IXSCAN) {
+        auto ixn = static_cast<const IndexScanNode*>(node);
+        *builder << ':' << ixn->index.identifier.catalogName << ':' << ixn->direction;
+    }
+    if (node->filter) {
+        for (auto&& param : input_params::getInputParams(node->filter.get())) {
+            if (param) {
+                *builder << " ?" << *param->getInputParamId();
+            }
+        }
+    }
+    for (auto&& child : node->children) {
+        *builder << ' ';
+        encodeSolutionShape(child, builder);
+    }
+    *builder << ')';
+}
+}  // namespace
+
+size_t CompiledPlanCache::Key::Hasher::operator()(const Key& key) const {
+    size_t hash = 0;
+    boost::hash_combine(hash, key.entryId);
+    boost::hash_combine(hash, key.plannerOptions);
+    boost::hash_combine(hash, key.query);
+    return hash;
+}
+
+CompiledPlanCache& CompiledPlanCache::get() {
+    static CompiledPlanCache cache;
+    return cache;
+}
+
+boost::optional<CompiledPlanCache::Key> CompiledPlanCache::makeKey(
+    const CanonicalQuery& cq,
+    const CachedSolution& cachedSolution,
+    const QuerySolution& solution,
+    size_t plannerOptions) {
+    if (internalQuerySBECompiledPlanCacheSize.load() <= 0) {
+        return boost::none;
+    }
+
+    // A shard filter is bound to the ownership metadata of the operation which built the plan.
+    const auto& qr = cq.getQueryRequest();
+    if ((plannerOptions & QueryPlannerParams::INCLUDE_SHARD_FILTER) || qr.isTailable() ||
+        qr.getRequestResumeToken()) {
+        return boost::none;
+    }
+
+    if (cq.numInputParams() == 0) {
+        return Key{cachedSolution.entryId, plannerOptions, qr.asFindCommand().toString()};
+    }
+
+    StringBuilder query;
+    query << qr.asFindCommand().removeField("filter").toString() << '|'
+          << input_params::encodeParameterizedShape(cq.root()) << '|';
+    encodeSolutionShape(solution.root(), &query);
+    return Key{cachedSolution.entryId, plannerOptions, query.str()};
+}
+
+boost::optional<std::pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>>
+CompiledPlanCache::find(const Key& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    Entry* entry;
+    if (!_cache.get(key, &entry).isOK()) {
+        compiledPlanCacheMisses.increment();
+        return boost::none;
+    }
+
+    compiledPlanCacheHits.increment();
+    return std::make_pair(entry->root->clone(), entry->data.makeCopy());
+}
+
+void CompiledPlanCache::add(const Key& key,
+                            const PlanStage& root,
+                            stage_builder::PlanStageData& data) {
+    if (data.shouldTrackLatestOplogTimestamp || data.shouldTrackResumeToken ||
+        data.shouldUseTailableScan) {
+        return;
+    }
+
+    auto entry = std::make_unique<Entry>(Entry{root.clone(), data.makeCopy()});
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _cache.add(key, entry.release());
+
+    const auto maxSize = internalQuerySBECompiledPlanCacheSize.load();
+    while (_cache.size() > static_cast<size_t>(std::max(0, maxSize))) {
+        _cache.removeLeastRecentlyUsed();
+    }
+}
+
+void CompiledPlanCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _cache.clear();
+}
+
+size_t CompiledPlanCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _cache.size();
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/query/lru_key_value.h"
+#include "mongo/db/query/sbe_stage_builder.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+class CachedSolution;
+class CanonicalQuery;
+class QuerySolution;
+
+namespace sbe {
+/**
+ * A process-wide cache of the SBE plans built for queries answered from the plan cache. A plan
+ * cache entry only records the QuerySolution which won the multi-planning of a query shape, so
+ * without this cache every cache hit has to run the SlotBasedStageBuilder again. This cache keeps
+ * an unprepared clone of each plan built this way, and serves further clones of it to subsequent
+ * executions of the same query.
+ *
+ * Unless a query has been parameterized, its constants are baked into the plan built for it, so a
+ * cached plan can only be reused by a query which is identical to the one the plan was built for,
+ * including its literals. The plan built for a parameterized query instead reads its input
+ * parameters and the index bounds derived from them from its RuntimeEnvironment, and is reused by
+ * any query of the same parameterized shape which is answered with a solution of the same shape,
+ * after binding the values of that query to the plan.
+ *
+ * Plans are keyed by the identifier of the plan cache entry they were built from, so a plan is no
+ * longer found once its entry has been replaced or the plan cache of its collection cleared, and
+ * ages out of this cache according to its LRU policy.
+ *
+ * The number of cached plans is bounded by the 'internalQuerySBECompiledPlanCacheSize' knob; a
+ * value of zero disables the cache.
+ */
+class CompiledPlanCache {
+    CompiledPlanCache(const CompiledPlanCache&) = delete;
+    CompiledPlanCache& operator=(const CompiledPlanCache&) = delete;
+
+public:
+    struct Key {
+        bool operator==(const Key& other) const {
+            return entryId == other.entryId && plannerOptions == other.plannerOptions &&
+                query == other.query;
+        }
+
+        struct Hasher {
+            size_t operator()(const Key& key) const;
+        };
+
+        // The identifier of the plan cache entry the plan was built from.
+        uint64_t entryId;
+
+        // The options the QuerySolution of the plan was created with.
+        size_t plannerOptions;
+
+        // The serialized find command of the query the plan was built for. For a parameterized
+        // query, the filter is replaced with its parameterized shape and the shape of the solution
+        // the plan was built from.
+        std::string query;
+    };
+
+    /**
+     * Returns the cache shared by all the operations of the process.
+     */
+    static CompiledPlanCache& get();
+
+    /**
+     * Returns the key under which the plan built for 'cq' from 'solution', recovered from
+     * 'cachedSolution', is cached, or boost::none if such a plan cannot be reused by other
+     * operations.
+     */
+    static boost::optional<Key> makeKey(const CanonicalQuery& cq,
+                                        const CachedSolution& cachedSolution,
+                                        const QuerySolution& solution,
+                                        size_t plannerOptions);
+
+    CompiledPlanCache() = default;
+
+    /**
+     * Returns an unprepared clone of the plan cached under 'key', if any, along with a copy of its
+     * PlanStageData. The caller must attach the clone to its own yield policy and trial run
+     * tracker before preparing it.
+     */
+    boost::optional<std::pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>> find(
+        const Key& key);
+
+    /**
+     * Caches a clone of the unprepared plan 'root' built along with 'data' under 'key'. Plans which
+     * depend on per-operation state, such as tailable or change stream scans, are not cached.
+     */
+    void add(const Key& key, const PlanStage& root, stage_builder::PlanStageData& data);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        std::unique_ptr<PlanStage> root;
+        stage_builder::PlanStageData data;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CompiledPlanCache::_mutex");
+    LRUKeyValue<Key, Entry, Key::Hasher> _cache{std::numeric_limits<size_t>::max()};
+};
+}  // namespace sbe
+}  // namespace mongo
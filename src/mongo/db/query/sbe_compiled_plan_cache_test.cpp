@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_compiled_plan_cache.h"
+
+#include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/stages/limit_skip.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo::sbe {
+namespace {
+
+CompiledPlanCache::Key makeKey(uint64_t entryId, StringData query = "{find: 'coll'}"_sd) {
+    return {entryId, 0, query.toString()};
+}
+
+std::unique_ptr<PlanStage> makePlan(long long limit) {
+    return makeS<LimitSkipStage>(makeS<CoScanStage>(kEmptyPlanNodeId), limit, boost::none, 1);
+}
+
+stage_builder::PlanStageData makePlanStageData(value::SlotIdGenerator* slotIdGenerator) {
+    stage_builder::PlanStageData data{std::make_unique<RuntimeEnvironment>()};
+    data.env->registerSlot("answer"_sd, value::TypeTags::NumberInt32, 42, false, slotIdGenerator);
+    data.outputs.set(stage_builder::PlanStageSlots::kResult, slotIdGenerator->generate());
+    return data;
+}
+
+std::string printPlan(PlanStage& root) {
+    return DebugPrinter{}.print(&root);
+}
+
+TEST(SbeCompiledPlanCacheTest, ReturnsCloneOfCachedPlan) {
+    CompiledPlanCache cache;
+    value::SlotIdGenerator slotIdGenerator;
+    auto root = makePlan(5);
+    auto data = makePlanStageData(&slotIdGenerator);
+
+    ASSERT_FALSE(cache.find(makeKey(1)));
+    cache.add(makeKey(1), *root, data);
+    ASSERT_EQ(cache.size(), 1U);
+
+    auto cachedPlan = cache.find(makeKey(1));
+    ASSERT_TRUE(cachedPlan);
+    auto&& [cachedRoot, cachedData] = *cachedPlan;
+    ASSERT_NE(cachedRoot.get(), root.get());
+    ASSERT_EQ(printPlan(*cachedRoot), printPlan(*root));
+    ASSERT_EQ(cachedData.outputs.get(stage_builder::PlanStageSlots::kResult),
+              data.outputs.get(stage_builder::PlanStageSlots::kResult));
+    ASSERT_EQ(cachedData.env->getSlot("answer"_sd), data.env->getSlot("answer"_sd));
+    ASSERT_FALSE(cachedData.trialRunProgressTracker);
+
+    // A plan is only reused by the same query answered from the same plan cache entry.
+    ASSERT_FALSE(cache.find(makeKey(2)));
+    ASSERT_FALSE(cache.find(makeKey(1, "{find: 'coll', filter: {a: 1}}"_sd)));
+}
+
+TEST(SbeCompiledPlanCacheTest, DoesNotCachePlansForTailableScans) {
+    CompiledPlanCache cache;
+    value::SlotIdGenerator slotIdGenerator;
+    auto root = makePlan(5);
+    auto data = makePlanStageData(&slotIdGenerator);
+    data.shouldUseTailableScan = true;
+
+    cache.add(makeKey(1), *root, data);
+    ASSERT_EQ(cache.size(), 0U);
+    ASSERT_FALSE(cache.find(makeKey(1)));
+}
+
+TEST(SbeCompiledPlanCacheTest, EvictsLeastRecentlyUsedPlansBeyondMaxSize) {
+    const auto oldMaxSize = internalQuerySBECompiledPlanCacheSize.load();
+    ON_BLOCK_EXIT([oldMaxSize] { internalQuerySBECompiledPlanCacheSize.store(oldMaxSize); });
+    internalQuerySBECompiledPlanCacheSize.store(2);
+
+    CompiledPlanCache cache;
+    value::SlotIdGenerator slotIdGenerator;
+    auto data = makePlanStageData(&slotIdGenerator);
+    cache.add(makeKey(1), *makePlan(1), data);
+    cache.add(makeKey(2), *makePlan(2), data);
+
+    // Looking up the first plan makes the second one the least recently used.
+    ASSERT_TRUE(cache.find(makeKey(1)));
+    cache.add(makeKey(3), *makePlan(3), data);
+
+    ASSERT_EQ(cache.size(), 2U);
+    ASSERT_TRUE(cache.find(makeKey(1)));
+    ASSERT_FALSE(cache.find(makeKey(2)));
+    ASSERT_TRUE(cache.find(makeKey(3)));
+}
+
+}  // namespace
+}  // namespace mongo::sbe
@@ -0,0 +1,191 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_expression_compiler.h"
+
+#include "mongo/db/exec/sbe/stages/project.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/query/sbe_stage_builder.h"
+#include "mongo/db/query/sbe_stage_builder_expression.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo::stage_builder {
+namespace {
+// The plan node id of the stages of compiled expressions, whose plans are never explained.
+constexpr PlanNodeId kCompiledExpressionNodeId = 0;
+
+/**
+ * Returns whether the stage builder can resolve all the variables referenced by 'expr': $$ROOT,
+ * $$REMOVE and the variables defined within 'expr' by $let and $filter. The variables defined by
+ * $map and $reduce are not, since the stage builder does not support these expressions.
+ */
+bool referencesOnlyCompilableVariables(const Expression& expr) {
+    if (dynamic_cast<const ExpressionMap*>(&expr) || dynamic_cast<const ExpressionReduce*>(&expr)) {
+        return false;
+    }
+
+    if (auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(&expr)) {
+        const auto variableId = fieldPath->getVariableId();
+        return variableId == Variables::kRootId || variableId == Variables::kRemoveId ||
+            Variables::isUserDefinedVariable(variableId);
+    }
+
+    for (auto&& child : expr.getChildren()) {
+        if (child && !referencesOnlyCompilableVariables(*child)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Converts the SBE value given by 'tag' and 'val' into a Value, where Nothing is the missing
+ * Value.
+ */
+Value convertToValue(sbe::value::TypeTags tag, sbe::value::Value val) {
+    if (tag == sbe::value::TypeTags::Nothing) {
+        return Value();
+    }
+
+    auto [objTag, objVal] = sbe::value::makeNewObject();
+    sbe::value::ValueGuard guard{objTag, objVal};
+    auto [copyTag, copyVal] = sbe::value::copyValue(tag, val);
+    sbe::value::getObjectView(objVal)->push_back("", copyTag, copyVal);
+
+    BSONObjBuilder builder;
+    sbe::bson::convertToBsonObj(builder, sbe::value::getObjectView(objVal));
+    return Value(builder.done().firstElement());
+}
+
+class SBECompiledExpression final : public CompiledExpression {
+public:
+    SBECompiledExpression(ExpressionContext* expCtx,
+                          std::unique_ptr<sbe::PlanStage> root,
+                          std::unique_ptr<sbe::RuntimeEnvironment> env,
+                          sbe::value::SlotId rootSlot,
+                          sbe::value::SlotId resultSlot)
+        : _expCtx(expCtx),
+          _env(env.get()),
+          _ctx(std::move(env)),
+          _root(std::move(root)),
+          _rootSlot(rootSlot) {
+        _root->prepare(_ctx);
+        _resultAccessor = _root->getAccessor(_ctx, resultSlot);
+    }
+
+    boost::optional<Value> evaluate(const Document& root) final {
+        auto bson = root.toBsonIfTriviallyConvertible();
+        if (!bson) {
+            // Documents may grow past the maximum size of BSON objects within a pipeline.
+            if (root.getApproximateSize() > BSONObjMaxUserSize) {
+                return boost::none;
+            }
+            bson = root.toBson();
+        }
+
+        if (_opCtx != _expCtx->opCtx) {
+            if (_opCtx) {
+                _root->detachFromOperationContext();
+            }
+            _root->attachFromOperationContext(_expCtx->opCtx);
+            _opCtx = _expCtx->opCtx;
+        }
+
+        _env->resetSlot(_rootSlot,
+                        sbe::value::TypeTags::bsonObject,
+                        sbe::value::bitcastFrom<const char*>(bson->objdata()),
+                        false);
+        ON_BLOCK_EXIT([&] { _env->resetSlot(_rootSlot, sbe::value::TypeTags::Nothing, 0, false); });
+
+        _root->open(_opened);
+        _opened = true;
+        invariant(_root->getNext() == sbe::PlanState::ADVANCED);
+
+        auto [tag, val] = _resultAccessor->getViewOfValue();
+        return convertToValue(tag, val);
+    }
+
+private:
+    ExpressionContext* const _expCtx;
+    sbe::RuntimeEnvironment* const _env;
+    sbe::CompileCtx _ctx;
+    std::unique_ptr<sbe::PlanStage> _root;
+    const sbe::value::SlotId _rootSlot;
+    sbe::value::SlotAccessor* _resultAccessor = nullptr;
+
+    // The operation the plan is attached to, which changes across the getMores of a cursor.
+    OperationContext* _opCtx = nullptr;
+    bool _opened = false;
+};
+}  // namespace
+
+std::unique_ptr<CompiledExpression> SBEExpressionCompiler::compile(const Expression& expr) {
+    auto expCtx = expr.getExpressionContext();
+    if (dynamic_cast<const ExpressionFieldPath*>(&expr) ||
+        dynamic_cast<const ExpressionConstant*>(&expr)) {
+        return nullptr;
+    }
+    if (expCtx->getCollator() || !expr.getDependencies().vars.empty() ||
+        !referencesOnlyCompilableVariables(expr)) {
+        return nullptr;
+    }
+
+    sbe::value::SlotIdGenerator slotIdGenerator;
+    sbe::value::FrameIdGenerator frameIdGenerator;
+    auto env = makeRuntimeEnvironment(expCtx->opCtx, &slotIdGenerator);
+    auto rootSlot = env->registerSlot(
+        "compiledExpressionRoot"_sd, sbe::value::TypeTags::Nothing, 0, false, &slotIdGenerator);
+
+    std::unique_ptr<sbe::PlanStage> root;
+    sbe::value::SlotId resultSlot;
+    try {
+        // The stage builder does not modify the expressions it lowers.
+        auto [outputSlot, outputExpr, stage] =
+            generateExpression(expCtx->opCtx,
+                               const_cast<Expression*>(&expr),
+                               nullptr,
+                               &slotIdGenerator,
+                               &frameIdGenerator,
+                               rootSlot,
+                               env.get(),
+                               kCompiledExpressionNodeId);
+        resultSlot = outputSlot;
+        root = sbe::makeProjectStage(
+            std::move(stage), kCompiledExpressionNodeId, outputSlot, std::move(outputExpr));
+    } catch (const ExceptionFor<ErrorCodes::InternalErrorNotSupported>&) {
+        return nullptr;
+    }
+
+    return std::make_unique<SBECompiledExpression>(
+        expCtx, std::move(root), std::move(env), rootSlot, resultSlot);
+}
+}  // namespace mongo::stage_builder
@@ -0,0 +1,49 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/pipeline/expression_compiler.h"
+
+namespace mongo::stage_builder {
+/**
+ * Compiles the Expressions evaluated by the stages of a classic pipeline into SBE plans, for the
+ * pipelines which cannot be executed by SBE as a whole. Each compiled expression is a plan of a
+ * single row, which binds the document to evaluate the expression against to a slot of its
+ * runtime environment and computes the value of the expression into another slot.
+ *
+ * Only the expressions which the SBE stage builder supports are compiled, provided they run under
+ * the simple collation and do not refer to variables defined outside of themselves. Single field
+ * paths and constants are not compiled, since their classic evaluation is as cheap as it gets.
+ */
+class SBEExpressionCompiler final : public ExpressionCompiler {
+public:
+    std::unique_ptr<CompiledExpression> compile(const Expression& expr) final;
+};
+}  // namespace mongo::stage_builder
@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_expression_compiler.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::stage_builder {
+namespace {
+
+class SbeExpressionCompilerTest : public unittest::Test {
+public:
+    SbeExpressionCompilerTest()
+        : _opCtx(_serviceContext.makeOperationContext()),
+          _expCtx(make_intrusive<ExpressionContextForTest>(_opCtx.get())) {}
+
+protected:
+    boost::intrusive_ptr<Expression> parse(StringData json) {
+        auto obj = fromjson(str::stream() << "{expr: " << json << "}");
+        return Expression::parseOperand(
+            _expCtx.get(), obj.firstElement(), _expCtx->variablesParseState);
+    }
+
+    std::unique_ptr<CompiledExpression> compile(StringData json) {
+        return SBEExpressionCompiler{}.compile(*parse(json));
+    }
+
+    /**
+     * Asserts that 'json' compiles, and that its compiled form evaluates to the same values as the
+     * expression itself against each of 'docs'.
+     */
+    void assertCompiledMatchesInterpreted(StringData json, const std::vector<Document>& docs) {
+        auto expr = parse(json);
+        auto compiled = SBEExpressionCompiler{}.compile(*expr);
+        ASSERT(compiled) << json;
+        for (auto&& doc : docs) {
+            auto result = compiled->evaluate(doc);
+            ASSERT(result) << json;
+            ASSERT_VALUE_EQ(*result, expr->evaluate(doc, &_expCtx->variables));
+        }
+    }
+
+    QueryTestServiceContext _serviceContext;
+    ServiceContext::UniqueOperationContext _opCtx;
+    boost::intrusive_ptr<ExpressionContextForTest> _expCtx;
+};
+
+const std::vector<Document> kNumericDocs = {
+    Document{{"a", 1}, {"b", 3}}, Document{{"a", 2.5}, {"b", -1}}, Document{}};
+
+const std::vector<Document> kDocs = {Document{{"a", 1}, {"b", 3}},
+                                     Document{{"a", 2.5}, {"b", -1}},
+                                     Document{{"a", "str"_sd}},
+                                     Document{{"b", Document{{"c", 4}}}},
+                                     Document{}};
+
+TEST_F(SbeExpressionCompilerTest, CompiledExpressionsMatchInterpretedExpressions) {
+    assertCompiledMatchesInterpreted("{$add: ['$a', {$multiply: ['$b', 2]}]}", kNumericDocs);
+    assertCompiledMatchesInterpreted("{$cond: [{$gt: ['$a', 1]}, 'big', 'small']}", kDocs);
+    assertCompiledMatchesInterpreted("{$ifNull: ['$missing', '$a']}", kDocs);
+    assertCompiledMatchesInterpreted("{$let: {vars: {x: '$b'}, in: {$add: ['$$x', 1]}}}",
+                                     kNumericDocs);
+    assertCompiledMatchesInterpreted("{$and: ['$a', {$eq: ['$b.c', 4]}]}", kDocs);
+}
+
+TEST_F(SbeExpressionCompilerTest, ReturnsMissingWhenExpressionEvaluatesToNothing) {
+    auto compiled = compile("{$ifNull: ['$missing', '$$REMOVE']}");
+    ASSERT(compiled);
+    auto result = compiled->evaluate(Document{{"a", 1}});
+    ASSERT(result);
+    ASSERT_TRUE(result->missing());
+}
+
+TEST_F(SbeExpressionCompilerTest, DoesNotCompileTrivialExpressions) {
+    ASSERT_FALSE(compile("'$a'"));
+    ASSERT_FALSE(compile("{$literal: 1}"));
+}
+
+TEST_F(SbeExpressionCompilerTest, DoesNotCompileUnsupportedExpressions) {
+    ASSERT_FALSE(compile("{$pow: ['$a', 2]}"));
+    ASSERT_FALSE(compile("{$map: {input: '$a', in: {$add: ['$$this', 1]}}}"));
+    ASSERT_FALSE(compile("{$add: ['$$NOW', 1]}"));
+}
+
+TEST_F(SbeExpressionCompilerTest, DoesNotCompileExpressionsReferringToOuterVariables) {
+    _expCtx->variablesParseState.defineVariable("outer");
+    ASSERT_FALSE(compile("{$add: ['$$outer', 1]}"));
+}
+
+TEST_F(SbeExpressionCompilerTest, DoesNotCompileExpressionsUnderNonSimpleCollation) {
+    _expCtx->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kReverseString));
+    ASSERT_FALSE(compile("{$eq: ['$a', 'str']}"));
+}
+
+TEST_F(SbeExpressionCompilerTest, EvaluateMaybeCompiledUsesCompilerOfExpressionContext) {
+    _expCtx->expressionCompiler = std::make_shared<SBEExpressionCompiler>();
+    auto expr = parse("{$add: ['$a', 1]}");
+    for (auto&& doc : kNumericDocs) {
+        ASSERT_VALUE_EQ(expr->evaluateMaybeCompiled(doc, &_expCtx->variables),
+                        expr->evaluate(doc, &_expCtx->variables));
+    }
+}
+
+}  // namespace
+}  // namespace mongo::stage_builder
@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/stages/column_scan.h"
 #include "mongo/db/exec/sbe/stages/filter.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 #include "mongo/db/exec/sbe/stages/limit_skip.h"
@@ -46,6 +47,7 @@
 #include "mongo/db/exec/sbe/stages/traverse.h"
 #include "mongo/db/exec/sbe/stages/union.h"
 #include "mongo/db/exec/sbe/stages/unique.h"
+#include "mongo/db/exec/sbe/values/bson.h"
 #include "mongo/db/fts/fts_index_format.h"
 #include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
@@ -98,6 +100,82 @@ std::string PlanStageData::debugString() const {
     return builder.str();
 }
 
+PlanStageData PlanStageData::makeCopy() {
+    PlanStageData copy{env->makeDeepCopy()};
+    copy.outputs = outputs;
+    copy.shouldTrackLatestOplogTimestamp = shouldTrackLatestOplogTimestamp;
+    copy.shouldTrackResumeToken = shouldTrackResumeToken;
+    copy.shouldUseTailableScan = shouldUseTailableScan;
+    return copy;
+}
+
+namespace {
+bool bindIndexBounds(OperationContext* opCtx,
+                     const CollectionPtr& collection,
+                     const QuerySolutionNode* node,
+                     sbe::RuntimeEnvironment* env) {
+    if (node->getType() == STAGE_IXSCAN) {
+        auto ixn = static_cast<const IndexScanNode*>(node);
+        auto slot = env->getSlotIfExists(makeIndexBoundsSlotName(ixn->nodeId()));
+        if (!slot) {
+            return false;
+        }
+        auto bounds = makeIndexScanBounds(opCtx, collection, ixn);
+        if (!bounds) {
+            return false;
+        }
+        env->resetSlot(*slot, bounds->first, bounds->second, true);
+    }
+
+    for (auto&& child : node->children) {
+        if (!bindIndexBounds(opCtx, collection, child, env)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool hasIndexBoundsSlots(const QuerySolutionNode* node, sbe::RuntimeEnvironment* env) {
+    if (node->getType() == STAGE_IXSCAN &&
+        !env->getSlotIfExists(makeIndexBoundsSlotName(node->nodeId()))) {
+        return false;
+    }
+
+    for (auto&& child : node->children) {
+        if (!hasIndexBoundsSlots(child, env)) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+bool bindInputParams(OperationContext* opCtx,
+                     const CollectionPtr& collection,
+                     const CanonicalQuery& cq,
+                     const QuerySolution& solution,
+                     sbe::RuntimeEnvironment* env) {
+    // The parameters which only feed index bounds have no slot of their own.
+    for (auto&& param : input_params::getInputParams(cq.root())) {
+        if (!param) {
+            continue;
+        }
+        if (auto slot = env->getSlotIfExists(makeInputParamSlotName(*param->getInputParamId()))) {
+            const auto& rhs = param->getData();
+            auto [tagView, valView] = sbe::bson::convertFrom(
+                true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
+            auto [tag, val] = sbe::value::copyValue(tagView, valView);
+            env->resetSlot(*slot, tag, val, true);
+        }
+    }
+
+    return bindIndexBounds(opCtx, collection, solution.root(), env);
+}
+
+bool canBindInputParams(const QuerySolution& solution, sbe::RuntimeEnvironment* env) {
+    return hasIndexBoundsSlots(solution.root(), env);
+}
+
 namespace {
 const QuerySolutionNode* getNodeByType(const QuerySolutionNode* root, StageType type) {
     if (root->getType() == type) {
@@ -200,6 +278,53 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
     return {std::move(stage), std::move(outputs)};
 }
 
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildColumnScan(
+    const QuerySolutionNode* root, const PlanStageReqs& reqs) {
+    invariant(!reqs.getIndexKeyBitset());
+    invariant(!reqs.has(kOplogTs));
+
+    auto csn = static_cast<const ColumnScanNode*>(root);
+    auto resultSlot = _slotIdGenerator.generate();
+    auto recordIdSlot = _slotIdGenerator.generate();
+
+    std::unique_ptr<sbe::PlanStage> stage = sbe::makeS<sbe::ColumnScanStage>(
+        NamespaceStringOrUUID{_collection->ns().db().toString(), _collection->uuid()},
+        csn->index.identifier.catalogName,
+        csn->fields,
+        resultSlot,
+        recordIdSlot,
+        _yieldPolicy,
+        _data.trialRunProgressTracker.get(),
+        root->nodeId());
+
+    if (csn->filter) {
+        stage = generateFilter(_opCtx,
+                               csn->filter.get(),
+                               std::move(stage),
+                               &_slotIdGenerator,
+                               &_frameIdGenerator,
+                               resultSlot,
+                               _data.env,
+                               sbe::makeSV(resultSlot, recordIdSlot),
+                               root->nodeId());
+    }
+
+    PlanStageSlots outputs;
+    outputs.set(kResult, resultSlot);
+    outputs.set(kRecordId, recordIdSlot);
+
+    if (reqs.has(kReturnKey)) {
+        // Assign the 'returnKeySlot' to be the empty object.
+        outputs.set(kReturnKey, _slotIdGenerator.generate());
+        stage = sbe::makeProjectStage(std::move(stage),
+                                      root->nodeId(),
+                                      outputs.get(kReturnKey),
+                                      sbe::makeE<sbe::EFunction>("newObj", sbe::makeEs()));
+    }
+
+    return {std::move(stage), std::move(outputs)};
+}
+
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildVirtualScan(
     const QuerySolutionNode* root, const PlanStageReqs& reqs) {
     auto vsn = static_cast<const VirtualScanNode*>(root);
@@ -246,7 +371,8 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                              &_slotIdGenerator,
                              &_spoolIdGenerator,
                              _yieldPolicy,
-                             _data.trialRunProgressTracker.get());
+                             _data.trialRunProgressTracker.get(),
+                             _cq.numInputParams() > 0 ? _data.env : nullptr);
 }
 
 std::tuple<sbe::value::SlotId, sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>>
@@ -1009,6 +1135,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             SlotBasedStageBuilder&, const QuerySolutionNode* root, const PlanStageReqs& reqs)>>
         kStageBuilders = {
             {STAGE_COLLSCAN, &SlotBasedStageBuilder::buildCollScan},
+            {STAGE_COLUMN_SCAN, &SlotBasedStageBuilder::buildColumnScan},
             {STAGE_VIRTUAL_SCAN, &SlotBasedStageBuilder::buildVirtualScan},
             {STAGE_IXSCAN, &SlotBasedStageBuilder::buildIndexScan},
             {STAGE_FETCH, &SlotBasedStageBuilder::buildFetch},
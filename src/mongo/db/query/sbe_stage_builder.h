@@ -222,6 +222,13 @@ struct PlanStageData {
 
     std::string debugString() const;
 
+    /**
+     * Makes a copy of this object to be used along with a clone of the PlanStage tree it was built
+     * for. The RuntimeEnvironment of the copy holds its own copies of the slot values, so the
+     * parameters of the copy can be rebound, and the copy has no TrialRunProgressTracker.
+     */
+    PlanStageData makeCopy();
+
     // This holds the output slots produced by SBE plan (resultSlot, recordIdSlot, etc).
     PlanStageSlots outputs;
 
@@ -240,6 +247,25 @@ struct PlanStageData {
     bool shouldUseTailableScan{false};
 };
 
+/**
+ * Binds the values of the input parameters of the parameterized query 'cq', along with the index
+ * bounds 'solution' derives from them, to the slots of 'env', which belongs to a plan built for
+ * another query of the same parameterized shape and solution. Returns false if the plan reads some
+ * of these values from constants rather than from 'env', in which case it cannot be reused.
+ */
+bool bindInputParams(OperationContext* opCtx,
+                     const CollectionPtr& collection,
+                     const CanonicalQuery& cq,
+                     const QuerySolution& solution,
+                     sbe::RuntimeEnvironment* env);
+
+/**
+ * Returns true if the plan built from 'solution' along with 'env' reads the index bounds of all of
+ * its index scans from 'env', so that bindInputParams() can bind the bounds of another query to it.
+ * A plan whose index bounds are baked in cannot be reused by a query with other values.
+ */
+bool canBindInputParams(const QuerySolution& solution, sbe::RuntimeEnvironment* env);
+
 /**
  * A stage builder which builds an executable tree using slot-based PlanStages.
  */
@@ -270,6 +296,9 @@ private:
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildCollScan(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
+    std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildColumnScan(
+        const QuerySolutionNode* root, const PlanStageReqs& reqs);
+
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildVirtualScan(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
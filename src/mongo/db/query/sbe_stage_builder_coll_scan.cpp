@@ -42,10 +42,13 @@
 #include "mongo/db/exec/sbe/stages/project.h"
 #include "mongo/db/exec/sbe/stages/scan.h"
 #include "mongo/db/exec/sbe/stages/union.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/storage/oplog_hack.h"
+#include "mongo/db/storage/recovery_unit.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
 
@@ -301,6 +304,38 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateOptimizedOplo
     return {std::move(stage), std::move(outputs)};
 }
 
+/**
+ * Returns the number of threads a generic collection scan and its filter should be split across,
+ * or 1 if the scan must run serially. A parallel scan cannot be reopened, repositioned, or tracked
+ * by a trial run, so only plain forward scans of a regular collection are run in parallel.
+ *
+ * Each producer reads through a storage snapshot of its own, so the scan also stays serial when
+ * the operation runs in a multi-document transaction or reads at a timestamp.
+ */
+size_t getParallelScanDegree(OperationContext* opCtx,
+                             const CollectionPtr& collection,
+                             const CollectionScanNode* csn,
+                             bool isTailableResumeBranch,
+                             TrialRunProgressTracker* tracker) {
+    const auto dop = internalQueryDefaultDOP.load();
+    if (dop <= 1 || tracker || isTailableResumeBranch || csn->tailable ||
+        csn->direction != CollectionScanParams::FORWARD || csn->resumeAfterRecordId ||
+        csn->requestResumeToken || csn->shouldTrackLatestOplogTimestamp ||
+        csn->shouldWaitForOplogVisibility || collection->ns().isOplog()) {
+        return 1;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (opCtx->inMultiDocumentTransaction() ||
+        readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern ||
+        readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime() ||
+        readConcernArgs.getArgsOpTime() ||
+        opCtx->recoveryUnit()->getTimestampReadSource() != RecoveryUnit::ReadSource::kNoTimestamp) {
+        return 1;
+    }
+    return dop;
+}
+
 /**
  * Generates a generic collecion scan sub-tree. If a resume token has been provided, the scan will
  * start from a RecordId contained within this token, otherwise from the beginning of the
@@ -340,17 +375,29 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
         collection, slotIdGenerator, csn->shouldTrackLatestOplogTimestamp);
 
     NamespaceStringOrUUID nss{collection->ns().db().toString(), collection->uuid()};
-    auto stage = sbe::makeS<sbe::ScanStage>(nss,
-                                            resultSlot,
-                                            recordIdSlot,
-                                            std::move(fields),
-                                            std::move(slots),
-                                            seekRecordIdSlot,
-                                            forward,
-                                            yieldPolicy,
-                                            tracker,
-                                            csn->nodeId(),
-                                            makeOpenCallbackIfNeeded(collection, csn));
+    const auto dop = getParallelScanDegree(opCtx, collection, csn, isTailableResumeBranch, tracker);
+
+    // A parallel scan is run by the producer threads of an exchange, which take the record ranges
+    // of the collection from a shared state. The yield policy of the plan belongs to the thread
+    // executing the plan, so it is not given to the scan.
+    auto stage = dop > 1 ? sbe::makeS<sbe::ParallelScanStage>(nss,
+                                                              resultSlot,
+                                                              recordIdSlot,
+                                                              std::move(fields),
+                                                              std::move(slots),
+                                                              nullptr,
+                                                              csn->nodeId())
+                         : sbe::makeS<sbe::ScanStage>(nss,
+                                                      resultSlot,
+                                                      recordIdSlot,
+                                                      std::move(fields),
+                                                      std::move(slots),
+                                                      seekRecordIdSlot,
+                                                      forward,
+                                                      yieldPolicy,
+                                                      tracker,
+                                                      csn->nodeId(),
+                                                      makeOpenCallbackIfNeeded(collection, csn));
 
     // Check if the scan should be started after the provided resume RecordId and construct a nested
     // loop join sub-tree to project out the resume RecordId as a seekRecordIdSlot and feed it to
@@ -447,6 +494,18 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
                                csn->nodeId());
     }
 
+    if (dop > 1) {
+        // Every producer runs its own copy of the scan and the filter, and the exchange gathers the
+        // matching records on the thread executing the plan.
+        stage = sbe::makeS<sbe::ExchangeConsumer>(std::move(stage),
+                                                  dop,
+                                                  sbe::makeSV(resultSlot, recordIdSlot),
+                                                  sbe::ExchangePolicy::roundrobin,
+                                                  nullptr,
+                                                  nullptr,
+                                                  csn->nodeId());
+    }
+
     PlanStageSlots outputs;
     outputs.set(PlanStageSlots::kResult, resultSlot);
     outputs.set(PlanStageSlots::kRecordId, recordIdSlot);
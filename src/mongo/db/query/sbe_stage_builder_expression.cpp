@@ -1121,6 +1121,9 @@ public:
             sbe::makeS<sbe::HashAggStage>(std::move(limitNumChildren),
                                           sbe::makeSV(),
                                           sbe::makeEM(groupSlot, std::move(addToArrayExpr)),
+                                          false,
+                                          sbe::makeEM(),
+                                          std::numeric_limits<size_t>::max(),
                                           _context->planNodeId);
         EvalStage groupEvalStage = {std::move(groupStage), sbe::makeSV(groupSlot)};
 
@@ -1149,6 +1152,9 @@ public:
             std::move(unwindEvalStage.stage),
             sbe::makeSV(),
             sbe::makeEM(finalGroupSlot, std::move(finalAddToArrayExpr)),
+            false,
+            sbe::makeEM(),
+            std::numeric_limits<size_t>::max(),
             _context->planNodeId);
 
         // Create a branch stage to select between the branch that produces one null if any eleemnts
@@ -410,20 +410,37 @@ void generateArraySize(MatchExpressionVisitorContext* context,
 void generateComparison(MatchExpressionVisitorContext* context,
                         const ComparisonMatchExpression* expr,
                         sbe::EPrimBinary::Op binaryOp) {
-    auto makePredicate = [expr, binaryOp](sbe::value::SlotId inputSlot,
-                                          EvalStage inputStage) -> EvalExprStagePair {
+    auto makePredicate = [context, expr, binaryOp](sbe::value::SlotId inputSlot,
+                                                   EvalStage inputStage) -> EvalExprStagePair {
         const auto& rhs = expr->getData();
         auto [tagView, valView] = sbe::bson::convertFrom(
             true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
 
-        // SBE EConstant assumes ownership of the value so we have to make a copy here.
+        // SBE EConstant and the RuntimeEnvironment assume ownership of the value so we have to
+        // make a copy here.
         auto [tag, val] = sbe::value::copyValue(tagView, valView);
 
-        return {
-            makeFillEmptyFalse(sbe::makeE<sbe::EPrimBinary>(binaryOp,
-                                                            sbe::makeE<sbe::EVariable>(inputSlot),
-                                                            sbe::makeE<sbe::EConstant>(tag, val))),
-            std::move(inputStage)};
+        // The value of an input parameter is read from the environment, so that the plan can be
+        // reused by a query which binds another value to the parameter. A predicate may appear in
+        // several branches of a plan, in which case its parameter is only registered once.
+        std::unique_ptr<sbe::EExpression> rhsExpr;
+        if (auto paramId = expr->getInputParamId(); paramId && context->env) {
+            const auto slotName = makeInputParamSlotName(*paramId);
+            auto slot = context->env->getSlotIfExists(slotName);
+            if (slot) {
+                sbe::value::releaseValue(tag, val);
+            } else {
+                slot =
+                    context->env->registerSlot(slotName, tag, val, true, context->slotIdGenerator);
+            }
+            rhsExpr = sbe::makeE<sbe::EVariable>(*slot);
+        } else {
+            rhsExpr = sbe::makeE<sbe::EConstant>(tag, val);
+        }
+
+        return {makeFillEmptyFalse(sbe::makeE<sbe::EPrimBinary>(
+                    binaryOp, sbe::makeE<sbe::EVariable>(inputSlot), std::move(rhsExpr))),
+                std::move(inputStage)};
     };
 
     generatePredicate(context, expr->path(), std::move(makePredicate));
@@ -992,6 +1009,7 @@ public:
         sbe::value::ValueGuard arrSetGuard{arrSetTag, arrSetVal};
 
         auto arrSet = sbe::value::getArraySetView(arrSetVal);
+        arrSet->reserve(equalities.size());
 
         for (auto&& equality : equalities) {
 
@@ -432,4 +432,12 @@ std::pair<sbe::value::TypeTags, sbe::value::Value> makeValue(const BSONArray& ba
     return {sbe::value::TypeTags::bsonArray, sbe::value::bitcastFrom<uint8_t*>(data)};
 }
 
+std::string makeInputParamSlotName(input_params::InputParamId paramId) {
+    return str::stream() << "inputParam" << paramId;
+}
+
+std::string makeIndexBoundsSlotName(PlanNodeId nodeId) {
+    return str::stream() << "indexBounds" << nodeId;
+}
+
 }  // namespace mongo::stage_builder
@@ -37,6 +37,7 @@
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/filter.h"
 #include "mongo/db/exec/sbe/stages/project.h"
+#include "mongo/db/query/input_params.h"
 #include "mongo/db/query/sbe_stage_builder_eval_frame.h"
 #include "mongo/db/query/stage_types.h"
 
@@ -307,4 +308,16 @@ std::pair<sbe::value::SlotVector, std::unique_ptr<sbe::PlanStage>> generateVirtu
  */
 std::pair<sbe::value::TypeTags, sbe::value::Value> makeValue(const BSONArray& ba);
 
+/**
+ * Returns the name of the RuntimeEnvironment slot which holds the value of the input parameter
+ * 'paramId' of a parameterized query.
+ */
+std::string makeInputParamSlotName(input_params::InputParamId paramId);
+
+/**
+ * Returns the name of the RuntimeEnvironment slot which holds the intervals scanned by the index
+ * scan built for the IXSCAN node 'nodeId' of a parameterized query.
+ */
+std::string makeIndexBoundsSlotName(PlanNodeId nodeId);
+
 }  // namespace mongo::stage_builder
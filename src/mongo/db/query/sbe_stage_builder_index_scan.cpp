@@ -51,6 +51,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder.h"
+#include "mongo/db/query/sbe_stage_builder_helpers.h"
 #include "mongo/db/query/util/make_data_structure.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
@@ -243,6 +244,33 @@ makeIntervalsFromIndexBounds(const IndexBounds& bounds,
     return result;
 }
 
+/**
+ * Constructs an array containing objects with the low and high keys for each of the 'intervals'.
+ * E.g.,
+ *    [ {l: KS(...), h: KS(...)},
+ *      {l: KS(...), h: KS(...)}, ... ]
+ */
+std::pair<sbe::value::TypeTags, sbe::value::Value> makeIntervalsArray(
+    std::vector<std::pair<std::unique_ptr<KeyString::Value>, std::unique_ptr<KeyString::Value>>>
+        intervals) {
+    using namespace std::literals;
+
+    auto [boundsTag, boundsVal] = sbe::value::makeNewArray();
+    auto arr = sbe::value::getArrayView(boundsVal);
+    for (auto&& [lowKey, highKey] : intervals) {
+        auto [tag, val] = sbe::value::makeNewObject();
+        auto obj = sbe::value::getObjectView(val);
+        obj->push_back("l"sv,
+                       sbe::value::TypeTags::ksValue,
+                       sbe::value::bitcastFrom<KeyString::Value*>(lowKey.release()));
+        obj->push_back("h"sv,
+                       sbe::value::TypeTags::ksValue,
+                       sbe::value::bitcastFrom<KeyString::Value*>(highKey.release()));
+        arr->push_back(tag, val);
+    }
+    return {boundsTag, boundsVal};
+}
+
 /**
  * Constructs an optimized version of an index scan for multi-interval index bounds for the case
  * when the bounds can be decomposed in a number of single-interval bounds. In this case, instead
@@ -271,8 +299,7 @@ generateOptimizedMultiIntervalIndexScan(
     const CollectionPtr& collection,
     const std::string& indexName,
     bool forward,
-    std::vector<std::pair<std::unique_ptr<KeyString::Value>, std::unique_ptr<KeyString::Value>>>
-        intervals,
+    std::unique_ptr<sbe::EExpression> boundsExpr,
     sbe::IndexKeysInclusionSet indexKeysToInclude,
     sbe::value::SlotVector indexKeySlots,
     sbe::value::SlotIdGenerator* slotIdGenerator,
@@ -285,39 +312,21 @@ generateOptimizedMultiIntervalIndexScan(
     auto lowKeySlot = slotIdGenerator->generate();
     auto highKeySlot = slotIdGenerator->generate();
 
-    // Construct an array containing objects with the low and high keys for each interval. E.g.,
-    //    [ {l: KS(...), h: KS(...)},
-    //      {l: KS(...), h: KS(...)}, ... ]
-    auto [boundsTag, boundsVal] = sbe::value::makeNewArray();
-    auto arr = sbe::value::getArrayView(boundsVal);
-    for (auto&& [lowKey, highKey] : intervals) {
-        auto [tag, val] = sbe::value::makeNewObject();
-        auto obj = sbe::value::getObjectView(val);
-        obj->push_back("l"sv,
-                       sbe::value::TypeTags::ksValue,
-                       sbe::value::bitcastFrom<KeyString::Value*>(lowKey.release()));
-        obj->push_back("h"sv,
-                       sbe::value::TypeTags::ksValue,
-                       sbe::value::bitcastFrom<KeyString::Value*>(highKey.release()));
-        arr->push_back(tag, val);
-    }
-
     auto boundsSlot = slotIdGenerator->generate();
     auto unwindSlot = slotIdGenerator->generate();
 
-    // Project out the constructed array as a constant value and add an unwind stage on top to
-    // flatten the array.
+    // Project out the array of intervals and add an unwind stage on top to flatten the array.
     auto unwind = sbe::makeS<sbe::UnwindStage>(
         sbe::makeProjectStage(
             sbe::makeS<sbe::LimitSkipStage>(
                 sbe::makeS<sbe::CoScanStage>(planNodeId), 1, boost::none, planNodeId),
             planNodeId,
             boundsSlot,
-            sbe::makeE<sbe::EConstant>(boundsTag, boundsVal)),
+            std::move(boundsExpr)),
         boundsSlot,
         unwindSlot,
         slotIdGenerator->generate(), /* We don't need an index slot but must to provide it. */
-        false /* Preserve null and empty arrays, in our case it cannot be empty anyway. */,
+        false /* Don't preserve null and empty arrays, an empty array has no intervals to scan. */,
         planNodeId);
 
     // Add another project stage to extract low and high keys from each value produced by unwind and
@@ -611,6 +620,14 @@ generateGenericMultiIntervalIndexScan(const CollectionPtr& collection,
                                            sbe::makeEs(sbe::makeE<sbe::EVariable>(resultSlot))),
                 ixn->nodeId())};
 }
+
+const IndexAccessMethod* getIndexAccessMethod(OperationContext* opCtx,
+                                             const CollectionPtr& collection,
+                                             const IndexScanNode* ixn) {
+    auto descriptor =
+        collection->getIndexCatalog()->findIndexByName(opCtx, ixn->index.identifier.catalogName);
+    return collection->getIndexCatalog()->getEntry(descriptor)->accessMethod();
+}
 }  // namespace
 
 std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleIntervalIndexScan(
@@ -670,6 +687,20 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleInt
                                            planNodeId)};
 }
 
+boost::optional<std::pair<sbe::value::TypeTags, sbe::value::Value>> makeIndexScanBounds(
+    OperationContext* opCtx, const CollectionPtr& collection, const IndexScanNode* ixn) {
+    auto accessMethod = getIndexAccessMethod(opCtx, collection, ixn);
+    auto intervals =
+        makeIntervalsFromIndexBounds(ixn->bounds,
+                                     ixn->direction == 1,
+                                     accessMethod->getSortedDataInterface()->getKeyStringVersion(),
+                                     accessMethod->getSortedDataInterface()->getOrdering());
+    if (intervals.empty()) {
+        return boost::none;
+    }
+    return makeIntervalsArray(std::move(intervals));
+}
+
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
     OperationContext* opCtx,
     const CollectionPtr& collection,
@@ -678,12 +709,11 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
     sbe::value::SlotIdGenerator* slotIdGenerator,
     sbe::value::SpoolIdGenerator* spoolIdGenerator,
     PlanYieldPolicy* yieldPolicy,
-    TrialRunProgressTracker* tracker) {
+    TrialRunProgressTracker* tracker,
+    sbe::RuntimeEnvironment* env) {
     uassert(4822864, "Index scans with a filter are not supported in SBE", !ixn->filter);
 
-    auto descriptor =
-        collection->getIndexCatalog()->findIndexByName(opCtx, ixn->index.identifier.catalogName);
-    auto accessMethod = collection->getIndexCatalog()->getEntry(descriptor)->accessMethod();
+    auto accessMethod = getIndexAccessMethod(opCtx, collection, ixn);
     auto intervals =
         makeIntervalsFromIndexBounds(ixn->bounds,
                                      ixn->direction == 1,
@@ -724,7 +754,29 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
         indexKeyBitset = *reqs.getIndexKeyBitset();
     }
 
-    if (intervals.size() == 1) {
+    if (env && !intervals.empty()) {
+        // The index bounds of a parameterized query depend on the values of its input parameters,
+        // so the intervals are read from the environment, where they can be rebound. An array of
+        // intervals is used even for a single interval, as another query may bind several.
+        auto [boundsTag, boundsVal] = makeIntervalsArray(std::move(intervals));
+        auto boundsSlot = env->registerSlot(
+            makeIndexBoundsSlotName(ixn->nodeId()), boundsTag, boundsVal, true, slotIdGenerator);
+
+        sbe::value::SlotId recordIdSlot;
+        std::tie(recordIdSlot, stage) =
+            generateOptimizedMultiIntervalIndexScan(collection,
+                                                    ixn->index.identifier.catalogName,
+                                                    ixn->direction == 1,
+                                                    sbe::makeE<sbe::EVariable>(boundsSlot),
+                                                    indexKeyBitset,
+                                                    indexKeySlots,
+                                                    slotIdGenerator,
+                                                    yieldPolicy,
+                                                    tracker,
+                                                    ixn->nodeId());
+
+        outputs.set(PlanStageSlots::kRecordId, recordIdSlot);
+    } else if (intervals.size() == 1) {
         // If we have just a single interval, we can construct a simplified sub-tree.
         auto&& [lowKey, highKey] = intervals[0];
         sbe::value::SlotId recordIdSlot;
@@ -747,12 +799,14 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
     } else if (intervals.size() > 1) {
         // If we were able to decompose multi-interval index bounds into a number of single-interval
         // bounds, we can also built an optimized sub-tree to perform an index scan.
+        auto [boundsTag, boundsVal] = makeIntervalsArray(std::move(intervals));
+        auto boundsExpr = sbe::makeE<sbe::EConstant>(boundsTag, boundsVal);
         sbe::value::SlotId recordIdSlot;
         std::tie(recordIdSlot, stage) =
             generateOptimizedMultiIntervalIndexScan(collection,
                                                     ixn->index.identifier.catalogName,
                                                     ixn->direction == 1,
-                                                    std::move(intervals),
+                                                    std::move(boundsExpr),
                                                     indexKeyBitset,
                                                     indexKeySlots,
                                                     slotIdGenerator,
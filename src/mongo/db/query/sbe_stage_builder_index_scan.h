@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/exec/trial_run_progress_tracker.h"
@@ -48,6 +49,10 @@ class PlanStageSlots;
  *
  * If the caller provides a slot ID for the 'returnKeySlot' parameter, this method will populate
  * the specified slot with the rehydrated index key for each record.
+ *
+ * If 'env' is provided, the index scan reads its intervals from the slot of 'env' named
+ * makeIndexBoundsSlotName(ixn->nodeId()) whenever the index bounds can be decomposed into single
+ * intervals, so that they can be rebound for another query of the same parameterized shape.
  */
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
     OperationContext* opCtx,
@@ -57,7 +62,16 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
     sbe::value::SlotIdGenerator* slotIdGenerator,
     sbe::value::SpoolIdGenerator* spoolIdGenerator,
     PlanYieldPolicy* yieldPolicy,
-    TrialRunProgressTracker* tracker);
+    TrialRunProgressTracker* tracker,
+    sbe::RuntimeEnvironment* env = nullptr);
+
+/**
+ * Returns the value to store in the index bounds slot of an index scan generated by
+ * generateIndexScan() for 'ixn' with a RuntimeEnvironment, or boost::none if the index bounds of
+ * 'ixn' cannot be decomposed into single intervals. The caller owns the returned value.
+ */
+boost::optional<std::pair<sbe::value::TypeTags, sbe::value::Value>> makeIndexScanBounds(
+    OperationContext* opCtx, const CollectionPtr& collection, const IndexScanNode* ixn);
 
 /**
  * Constructs the most simple version of an index scan from the single interval index bounds. The
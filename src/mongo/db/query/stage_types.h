@@ -52,6 +52,9 @@ enum StageType {
     STAGE_CACHED_PLAN,
     STAGE_COLLSCAN,
 
+    // Rebuilds the indexed fields of every document of the collection from a columnstore index.
+    STAGE_COLUMN_SCAN,
+
     // A virtual scan stage that simulates a collection scan and doesn't depend on underlying
     // storage.
     STAGE_VIRTUAL_SCAN,
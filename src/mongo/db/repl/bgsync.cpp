@@ -102,6 +102,15 @@ Counter64 numTimesCouldNotFindSyncSource;
 ServerStatusMetricField<Counter64> displayNumTimesCouldNotFindSyncSource(
     "repl.syncSource.numTimesCouldNotFind", &numTimesCouldNotFindSyncSource);
 
+// The number of times a node resumed fetching oplog entries after being without a sync source, as
+// after an election, and the total time in milliseconds it was without one.
+Counter64 numSyncSourceResumes;
+ServerStatusMetricField<Counter64> displayNumSyncSourceResumes("repl.syncSource.numResumes",
+                                                               &numSyncSourceResumes);
+Counter64 syncSourceResumeMillis;
+ServerStatusMetricField<Counter64> displaySyncSourceResumeMillis(
+    "repl.syncSource.totalResumeMillis", &syncSourceResumeMillis);
+
 /**
  * Extends DataReplicatorExternalStateImpl to be member state aware.
  */
@@ -309,6 +318,10 @@ void BackgroundSync::_produce() {
         }
         const auto requiredOpTime = (minValidSaved > _lastOpTimeFetched) ? minValidSaved : OpTime();
         lastOpTimeFetched = _lastOpTimeFetched;
+        if (_syncSourceLostDate == Date_t()) {
+            _syncSourceLostDate = Date_t::now();
+        }
+        _syncSourceCandidatesChanged = false;
         if (!_syncSourceHost.empty()) {
             LOGV2(21080,
                   "Clearing sync source {syncSource} to choose a new one.",
@@ -449,7 +462,7 @@ void BackgroundSync::_produce() {
                     "Could not find a sync source. Sleeping before trying again",
                     "sleepDurationMillis"_attr = sleepMS);
         numTimesCouldNotFindSyncSource.increment(1);
-        mongo::sleepmillis(sleepMS);
+        _waitToRetryChoosingSyncSource(sleepMS);
         return;
     }
 
@@ -649,6 +662,16 @@ Status BackgroundSync::_enqueueDocuments(OplogFetcher::Documents::const_iterator
     // If this is the first batch of operations returned from the query, "toApplyDocumentCount" will
     // be one fewer than "networkDocumentCount" because the first document (which was applied
     // previously) is skipped.
+    {
+        stdx::lock_guard<Latch> lock(_mutex);
+        if (_syncSourceLostDate != Date_t()) {
+            numSyncSourceResumes.increment(1);
+            syncSourceResumeMillis.increment(
+                durationCount<Milliseconds>(Date_t::now() - _syncSourceLostDate));
+            _syncSourceLostDate = Date_t();
+        }
+    }
+
     if (info.toApplyDocumentCount == 0) {
         return Status::OK();  // Nothing to do.
     }
@@ -868,11 +891,19 @@ void BackgroundSync::clearSyncTarget() {
     _syncSourceHost = HostAndPort();
 }
 
+void BackgroundSync::notifySyncSourceCandidatesChanged() {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _syncSourceCandidatesChanged = true;
+    _stateCv.notify_all();
+}
+
 void BackgroundSync::stop(bool resetLastFetchedOptime) {
     stdx::lock_guard<Latch> lock(_mutex);
 
     setState(lock, ProducerState::Stopped);
     LOGV2(21107, "Stopping replication producer");
+    // Time spent stopped, as while primary, doesn't count towards resuming replication.
+    _syncSourceLostDate = Date_t();
 
     _syncSourceHost = HostAndPort();
     if (resetLastFetchedOptime) {
@@ -1010,5 +1041,12 @@ long long BackgroundSync::_getRetrySleepMS() {
     return sleepMS;
 }
 
+void BackgroundSync::_waitToRetryChoosingSyncSource(long long sleepMS) {
+    stdx::unique_lock<Latch> lock(_mutex);
+    _stateCv.wait_for(lock, Milliseconds(sleepMS).toSystemDuration(), [&] {
+        return _syncSourceCandidatesChanged || _inShutdown || _state != ProducerState::Running;
+    });
+}
+
 }  // namespace repl
 }  // namespace mongo
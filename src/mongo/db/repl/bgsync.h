@@ -129,6 +129,13 @@ public:
 
     void clearSyncTarget();
 
+    /**
+     * Notifies the producer that the heartbeat data it chooses sync sources from has changed, for
+     * instance because a member became primary or advanced its optime. If the producer is waiting
+     * to retry after failing to find a sync source, it retries right away.
+     */
+    void notifySyncSourceCandidatesChanged();
+
     // For monitoring
     BSONObj getCounters();
 
@@ -213,6 +220,12 @@ private:
 
     long long _getRetrySleepMS();
 
+    /**
+     * Waits for 'sleepMS' after failing to find a sync source, or until the sync source candidates
+     * change or the producer stops, whichever comes first.
+     */
+    void _waitToRetryChoosingSyncSource(long long sleepMS);
+
     // This OplogApplier applies oplog entries fetched from the sync source.
     OplogApplier* const _oplogApplier;
 
@@ -248,9 +261,19 @@ private:
     // Thread running producerThread().
     std::unique_ptr<stdx::thread> _producerThread;  // (M)
 
-    // Condition variable to notify of _state and _inShutdown changes.
+    // Condition variable to notify of _state, _inShutdown and _syncSourceCandidatesChanged
+    // changes.
     stdx::condition_variable _stateCv;  // (S)
 
+    // Set when the sync source candidates change while choosing a sync source, so that the
+    // producer doesn't wait before trying again.
+    bool _syncSourceCandidatesChanged = false;  // (M)
+
+    // When the producer started choosing a sync source after not having one, reset once it
+    // receives the first batch from the new one. Used to measure how long replication takes to
+    // resume, as after an election.
+    Date_t _syncSourceLostDate;  // (M)
+
     // Set to true if shutdown() has been called.
     bool _inShutdown = false;  // (M)
 
@@ -32,11 +32,15 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/database_cloner_common.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_auth.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -51,7 +55,9 @@ DatabaseCloner::DatabaseCloner(const std::string& dbName,
     : InitialSyncBaseCloner(
           "DatabaseCloner"_sd, sharedData, source, client, storageInterface, dbPool),
       _dbName(dbName),
-      _listCollectionsStage("listCollections", this, &DatabaseCloner::listCollectionsStage) {
+      _listCollectionsStage("listCollections", this, &DatabaseCloner::listCollectionsStage),
+      _createClientFn(
+          [] { return std::make_unique<DBClientConnection>(true /* autoReconnect */); }) {
     invariant(!dbName.empty());
     _stats.dbname = dbName;
 }
@@ -117,6 +123,10 @@ bool DatabaseCloner::isMyFailPoint(const BSONObj& data) const {
     return data["database"].str() == _dbName && BaseCloner::isMyFailPoint(data);
 }
 
+void DatabaseCloner::setCreateClientFn_forTest(const CreateClientFn& createClientFn) {
+    _createClientFn = createClientFn;
+}
+
 void DatabaseCloner::postStage() {
     {
         stdx::lock_guard<Latch> lk(_mutex);
@@ -126,58 +136,124 @@ void DatabaseCloner::postStage() {
             _stats.collectionStats.emplace_back();
             _stats.collectionStats.back().ns = coll.first.ns();
         }
+        _collectionCloners.resize(_collections.size());
     }
-    for (const auto& coll : _collections) {
-        auto& sourceNss = coll.first;
-        auto& collectionOptions = coll.second;
-        {
-            stdx::lock_guard<Latch> lk(_mutex);
-            _currentCollectionCloner = std::make_unique<CollectionCloner>(sourceNss,
-                                                                          collectionOptions,
-                                                                          getSharedData(),
-                                                                          getSource(),
-                                                                          getClient(),
-                                                                          getStorageInterface(),
-                                                                          getDBPool());
+
+    const size_t maxConcurrentCloners = std::min(
+        _collections.size(), size_t(initialSyncMaxConcurrentCollectionCloners.load()));
+    if (maxConcurrentCloners <= 1) {
+        for (size_t i = 0; i < _collections.size(); ++i) {
+            if (!cloneCollection(i, getClient()))
+                return;
         }
-        auto collStatus = _currentCollectionCloner->run();
-        if (collStatus.isOK()) {
-            LOGV2_DEBUG(21148,
-                        1,
-                        "collection clone finished: {namespace}",
-                        "Collection clone finished",
-                        "namespace"_attr = sourceNss);
-        } else {
-            LOGV2_ERROR(21149,
-                        "collection clone for '{namespace}' failed due to {error}",
-                        "Collection clone failed",
-                        "namespace"_attr = sourceNss,
-                        "error"_attr = collStatus.toString());
-            setSyncFailedStatus({ErrorCodes::InitialSyncFailure,
-                                 collStatus
-                                     .withContext(str::stream() << "Error cloning collection '"
-                                                                << sourceNss.toString() << "'")
-                                     .toString()});
+    } else {
+        // Each worker uses its own connection, since a DBClientConnection may only be used by one
+        // thread at a time. If an additional connection can't be made, clone with fewer workers.
+        std::vector<std::unique_ptr<DBClientConnection>> additionalClients;
+        for (size_t i = 1; i < maxConcurrentCloners; ++i) {
+            try {
+                additionalClients.push_back(connectAdditionalClient());
+            } catch (const DBException& ex) {
+                LOGV2(5843216,
+                      "Failed to open an additional connection for cloning collections "
+                      "concurrently",
+                      "database"_attr = _dbName,
+                      "source"_attr = getSource(),
+                      "error"_attr = ex.toStatus());
+                break;
+            }
         }
-        {
-            stdx::lock_guard<Latch> lk(_mutex);
-            _stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-            _currentCollectionCloner = nullptr;
-            // Abort the database cloner if the collection clone failed.
-            if (!collStatus.isOK())
-                return;
-            _stats.clonedCollections++;
+
+        AtomicWord<size_t> nextCollection{0};
+        AtomicWord<bool> failed{false};
+        auto cloneCollections = [&](DBClientConnection* client) {
+            while (!failed.load()) {
+                auto index = nextCollection.fetchAndAdd(1);
+                if (index >= _collections.size())
+                    return;
+                if (!cloneCollection(index, client))
+                    failed.store(true);
+            }
+        };
+
+        std::vector<stdx::thread> workers;
+        workers.reserve(additionalClients.size());
+        for (size_t i = 0; i < additionalClients.size(); ++i) {
+            workers.emplace_back([&, client = additionalClients[i].get(), i] {
+                Client::initThread(str::stream() << "DatabaseCloner-" << _dbName << "-" << i + 1);
+                cloneCollections(client);
+            });
         }
+        cloneCollections(getClient());
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        if (failed.load())
+            return;
     }
     stdx::lock_guard<Latch> lk(_mutex);
     _stats.end = getSharedData()->getClock()->now();
 }
 
+bool DatabaseCloner::cloneCollection(size_t index, DBClientConnection* client) {
+    auto& sourceNss = _collections[index].first;
+    auto& collectionOptions = _collections[index].second;
+    CollectionCloner* collectionCloner;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _collectionCloners[index] = std::make_unique<CollectionCloner>(sourceNss,
+                                                                       collectionOptions,
+                                                                       getSharedData(),
+                                                                       getSource(),
+                                                                       client,
+                                                                       getStorageInterface(),
+                                                                       getDBPool());
+        collectionCloner = _collectionCloners[index].get();
+    }
+    auto collStatus = collectionCloner->run();
+    if (collStatus.isOK()) {
+        LOGV2_DEBUG(21148,
+                    1,
+                    "collection clone finished: {namespace}",
+                    "Collection clone finished",
+                    "namespace"_attr = sourceNss);
+    } else {
+        LOGV2_ERROR(21149,
+                    "collection clone for '{namespace}' failed due to {error}",
+                    "Collection clone failed",
+                    "namespace"_attr = sourceNss,
+                    "error"_attr = collStatus.toString());
+        setSyncFailedStatus({ErrorCodes::InitialSyncFailure,
+                             collStatus
+                                 .withContext(str::stream() << "Error cloning collection '"
+                                                            << sourceNss.toString() << "'")
+                                 .toString()});
+    }
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stats.collectionStats[index] = collectionCloner->getStats();
+    _collectionCloners[index] = nullptr;
+    // Abort the database cloner if the collection clone failed.
+    if (!collStatus.isOK())
+        return false;
+    _stats.clonedCollections++;
+    return true;
+}
+
+std::unique_ptr<DBClientConnection> DatabaseCloner::connectAdditionalClient() {
+    auto client = _createClientFn();
+    uassertStatusOK(client->connect(getSource(), StringData()));
+    uassertStatusOK(replAuthenticate(client.get())
+                        .withContext(str::stream() << "Failed to authenticate to " << getSource()));
+    return client;
+}
+
 DatabaseCloner::Stats DatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     DatabaseCloner::Stats stats = _stats;
-    if (_currentCollectionCloner) {
-        stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
+    for (size_t i = 0; i < _collectionCloners.size(); ++i) {
+        if (_collectionCloners[i]) {
+            stats.collectionStats[i] = _collectionCloners[i]->getStats();
+        }
     }
     return stats;
 }
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
@@ -54,6 +55,8 @@ public:
         void append(BSONObjBuilder* builder) const;
     };
 
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
     DatabaseCloner(const std::string& dbName,
                    InitialSyncSharedData* sharedData,
                    const HostAndPort& source,
@@ -69,6 +72,12 @@ public:
 
     static CollectionOptions parseCollectionOptions(const BSONObj& element);
 
+    /**
+     * Overrides how the connections used to clone collections concurrently are created.
+     * For testing only.
+     */
+    void setCreateClientFn_forTest(const CreateClientFn& createClientFn);
+
 protected:
     ClonerStages getStages() final;
 
@@ -93,6 +102,19 @@ private:
      */
     void postStage() final;
 
+    /**
+     * Creates and runs the CollectionCloner for the collection at 'index' in _collections, using
+     * 'client' to read from the sync source. Returns false if the clone failed, in which case the
+     * sync failed status has been set.
+     */
+    bool cloneCollection(size_t index, DBClientConnection* client);
+
+    /**
+     * Opens and authenticates an additional connection to the sync source, for cloning a
+     * collection concurrently with the ones using the main connection.
+     */
+    std::unique_ptr<DBClientConnection> connectAdditionalClient();
+
     std::string describeForFuzzer(BaseClonerStage* stage) const final {
         return _dbName + " db: { " + stage->getName() + ": 1 } ";
     }
@@ -109,8 +131,10 @@ private:
     const std::string _dbName;                                                // (R)
     ClonerStage<DatabaseCloner> _listCollectionsStage;                        // (R)
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
-    std::unique_ptr<CollectionCloner> _currentCollectionCloner;               // (MX)
-    Stats _stats;                                                             // (MX)
+    // The cloners of the collections currently being cloned, indexed like _collections.
+    std::vector<std::unique_ptr<CollectionCloner>> _collectionCloners;  // (M)
+    Stats _stats;                                                       // (M)
+    CreateClientFn _createClientFn;                                     // (X)
 };
 
 }  // namespace repl
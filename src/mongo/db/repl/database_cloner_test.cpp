@@ -32,6 +32,7 @@
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/initial_sync_cloner_test_fixture.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/service_context_test_fixture.h"
@@ -39,6 +40,7 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -396,6 +398,55 @@ TEST_F(DatabaseClonerTest, CreateCollections) {
     ASSERT(stats.commitCalled);
 }
 
+TEST_F(DatabaseClonerTest, CreateCollectionsConcurrently) {
+    initialSyncMaxConcurrentCollectionCloners.store(2);
+    ON_BLOCK_EXIT([] { initialSyncMaxConcurrentCollectionCloners.store(1); });
+
+    const BSONObj idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                         << "_id_");
+    std::vector<BSONObj> sourceInfos;
+    std::vector<StatusWith<BSONObj>> listIndexesResponses;
+    for (auto&& name : {"a", "b", "c"}) {
+        sourceInfos.push_back(BSON("name" << name << "type"
+                                          << "collection"
+                                          << "options" << BSONObj() << "info"
+                                          << BSON("readOnly" << false << "uuid" << UUID::gen())));
+        listIndexesResponses.push_back(
+            createCursorResponse(_dbName + "." + name, BSON_ARRAY(idIndexSpec)));
+        // Insert the entries up front, since the cloners create their loaders concurrently.
+        _collections[NamespaceString{_dbName, name}];
+    }
+    _mockServer->setCommandReply("listCollections", createListCollectionsResponse(sourceInfos));
+    _mockServer->setCommandReply("collStats", BSON("size" << 0));
+    _mockServer->setCommandReply(
+        "count", {createCountResponse(0), createCountResponse(0), createCountResponse(0)});
+    _mockServer->setCommandReply("listIndexes", listIndexesResponses);
+
+    auto cloner = makeDatabaseCloner();
+    AtomicWord<int> clientsCreated{0};
+    cloner->setCreateClientFn_forTest([&] {
+        clientsCreated.fetchAndAdd(1);
+        return std::unique_ptr<DBClientConnection>(
+            new MockDBClientConnection(_mockServer.get(), true /* autoReconnect */));
+    });
+    ASSERT_OK(cloner->run());
+
+    // The main connection is shared with one additional connection.
+    ASSERT_EQUALS(1, clientsCreated.load());
+    ASSERT_EQUALS(3U, _collections.size());
+    for (auto&& name : {"a", "b", "c"}) {
+        auto stats = *_collections[NamespaceString{_dbName, name}].stats;
+        ASSERT_EQUALS(0, stats.insertCount);
+        ASSERT(stats.commitCalled);
+    }
+
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(3U, stats.collections);
+    ASSERT_EQUALS(3U, stats.clonedCollections);
+    ASSERT_EQUALS(_dbName + ".a", stats.collectionStats[0].ns);
+    ASSERT_EQUALS(_dbName + ".c", stats.collectionStats[2].ns);
+}
+
 TEST_F(DatabaseClonerTest, DatabaseAndCollectionStats) {
     auto uuid1 = UUID::gen();
     auto uuid2 = UUID::gen();
@@ -446,6 +446,46 @@ std::vector<OpTime> logInsertOps(OperationContext* opCtx,
 
     WriteUnitOfWork wuow(opCtx);
 
+    // Inserts that were given a shared optime are logged as the operations of a single applyOps
+    // entry, which secondaries expand back into individual inserts when applying it.
+    const auto& groupOplogSlot = begin->oplogSlot;
+    if (count > 1 && !groupOplogSlot.isNull() &&
+        std::all_of(begin, end, [&](const InsertStatement& stmt) {
+            return stmt.oplogSlot == groupOplogSlot;
+        })) {
+        BSONObjBuilder applyOpsBuilder;
+        {
+            BSONArrayBuilder opsArray(applyOpsBuilder.subarrayStart("applyOps"));
+            for (auto it = begin; it != end; it++) {
+                invariant(it->stmtId == kUninitializedStmtId);
+                auto operation = MutableOplogEntry::makeInsertOperation(
+                    nss, *oplogEntryTemplate->getUuid(), it->doc);
+                operation.setDestinedRecipient(getDestinedRecipient(opCtx, nss, it->doc));
+                opsArray.append(operation.toBSON());
+            }
+        }
+
+        MutableOplogEntry oplogEntry = *oplogEntryTemplate;
+        oplogEntry.setOpType(repl::OpTypeEnum::kCommand);
+        oplogEntry.setNss(nss.getCommandNS());
+        oplogEntry.setUuid(boost::none);
+        oplogEntry.setObject(applyOpsBuilder.done());
+        oplogEntry.setOpTime(groupOplogSlot);
+
+        auto bsonOplogEntry = oplogEntry.toBSON();
+        std::vector<Record> records{
+            Record{RecordId(), RecordData(bsonOplogEntry.objdata(), bsonOplogEntry.objsize())}};
+        _logOpsInner(opCtx,
+                     nss,
+                     &records,
+                     {groupOplogSlot.getTimestamp()},
+                     oplogInfo->getCollection(),
+                     groupOplogSlot,
+                     oplogEntryTemplate->getWallClockTime());
+        wuow.commit();
+        return std::vector<OpTime>(count, groupOplogSlot);
+    }
+
     std::vector<OpTime> opTimes(count);
     std::vector<Timestamp> timestamps(count);
     std::vector<BSONObj> bsonOplogEntries(count);
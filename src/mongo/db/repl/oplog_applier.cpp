@@ -37,6 +37,8 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -150,7 +152,12 @@ std::unique_ptr<ThreadPool> makeReplWriterPool(int threadCount,
     options.threadNamePrefix = name + "-";
     options.poolName = name + "ThreadPool";
     options.maxThreads = options.minThreads = static_cast<size_t>(threadCount);
-    options.onCreateThread = [isKillableByStepdown](const std::string&) {
+    auto nextNumaNode = std::make_shared<AtomicWord<size_t>>(0);
+    options.onCreateThread = [isKillableByStepdown, nextNumaNode](const std::string&) {
+        if (replWriterBindThreadsToNumaNodes) {
+            ProcessInfo::bindCurrentThreadToNumaNode(nextNumaNode->fetchAndAdd(1));
+        }
+
         Client::initThread(getThreadName());
         auto client = Client::getCurrent();
         AuthorizationSession::get(*client)->grantInternalAuthorization(client);
@@ -52,6 +52,7 @@
 #include "mongo/platform/basic.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_with_sampling.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace repl {
@@ -73,6 +74,29 @@ ServerStatusMetricField<Counter64> displayOplogApplicationBatchSize("repl.apply.
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
 
+// Time spent in each stage of batch application, to tell which one limits the apply throughput.
+// Writing the batch to the oplog overlaps with preparing the writer vectors, so its counter only
+// includes the time spent waiting for the oplog writes once the writer vectors are ready. Journal
+// flushes overlap with the application of the following batches.
+Counter64 waitForBatchMicros;
+ServerStatusMetricField<Counter64> displayWaitForBatchMicros("repl.apply.stages.waitForBatchMicros",
+                                                             &waitForBatchMicros);
+Counter64 fillWriterVectorsMicros;
+ServerStatusMetricField<Counter64> displayFillWriterVectorsMicros(
+    "repl.apply.stages.fillWriterVectorsMicros", &fillWriterVectorsMicros);
+Counter64 writeOplogWaitMicros;
+ServerStatusMetricField<Counter64> displayWriteOplogWaitMicros(
+    "repl.apply.stages.writeOplogWaitMicros", &writeOplogWaitMicros);
+Counter64 applyOpsMicros;
+ServerStatusMetricField<Counter64> displayApplyOpsMicros("repl.apply.stages.applyMicros",
+                                                         &applyOpsMicros);
+Counter64 finalizeBatchMicros;
+ServerStatusMetricField<Counter64> displayFinalizeBatchMicros("repl.apply.stages.finalizeMicros",
+                                                              &finalizeBatchMicros);
+Counter64 journalFlushMicros;
+ServerStatusMetricField<Counter64> displayJournalFlushMicros("repl.apply.stages.journalFlushMicros",
+                                                             &journalFlushMicros);
+
 /**
  * Used for logging a report of ops that take longer than "slowMS" to apply. This is called
  * right before returning from applyOplogEntryOrGroupedInserts, and it returns the same status.
@@ -227,7 +251,9 @@ void ApplyBatchFinalizerForJournal::_run() {
         }
 
         auto opCtx = cc().makeOperationContext();
+        Timer journalTimer;
         JournalFlusher::get(opCtx.get())->waitForJournalFlush();
+        journalFlushMicros.increment(journalTimer.micros());
         _recordDurable(latestOpTimeAndWallTime);
     }
 }
@@ -289,6 +315,7 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // Blocks up to a second waiting for a batch to be ready to apply. If one doesn't become
         // ready in time, we'll loop again so we can do the above checks periodically.
+        Timer waitForBatchTimer;
         OplogBatch ops = _oplogBatcher->getNextBatch(Seconds(1));
         if (ops.empty()) {
             if (ops.mustShutdown()) {
@@ -308,6 +335,7 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
             }
             continue;  // Try again.
         }
+        waitForBatchMicros.increment(waitForBatchTimer.micros());
 
         // Extract some info from ops that we'll need after releasing the batch below.
         const auto firstOpTimeInBatch = ops.front().getOpTime();
@@ -343,6 +371,9 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
         fassertNoTrace(34437, swLastOpTimeAppliedInBatch);
         invariant(swLastOpTimeAppliedInBatch.getValue() == lastOpTimeInBatch);
 
+        Timer finalizeTimer;
+        ON_BLOCK_EXIT([&] { finalizeBatchMicros.increment(finalizeTimer.micros()); });
+
         // Update various things that care about our last applied optime. Tests rely on 1 happening
         // before 2 even though it isn't strictly necessary.
 
@@ -482,10 +513,14 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
 
         std::vector<std::vector<const OplogEntry*>> writerVectors(
             _writerPool->getStats().numThreads);
+        Timer stageTimer;
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
+        fillWriterVectorsMicros.increment(stageTimer.micros());
 
         // Wait for writes to finish before applying ops.
+        stageTimer.reset();
         _writerPool->waitForIdle();
+        writeOplogWaitMicros.increment(stageTimer.micros());
 
         // Use this fail point to hold the PBWM lock after we have written the oplog entries but
         // before we have applied them.
@@ -503,6 +538,8 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         }
 
         {
+            stageTimer.reset();
+            ON_BLOCK_EXIT([&] { applyOpsMicros.increment(stageTimer.micros()); });
             std::vector<Status> statusVector(_writerPool->getStats().numThreads, Status::OK());
 
             // Doles out all the work to the writer pool threads. writerVectors is not modified,
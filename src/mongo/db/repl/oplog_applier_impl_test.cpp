@@ -56,6 +56,7 @@
 #include "mongo/db/repl/idempotency_test_fixture.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/oplog_applier_utils.h"
 #include "mongo/db/repl/oplog_entry_test_helpers.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -2031,6 +2032,32 @@ TEST_F(IdempotencyTest, UniqueKeyIndex) {
     ASSERT_EQ(status.code(), ErrorCodes::DuplicateKey);
 }
 
+TEST_F(IdempotencyTest, UniqueKeyIndexDoesNotSerializeWriters) {
+    // Secondaries relax unique index constraints while applying the oplog, so CRUD ops on a
+    // collection with a unique secondary index are still distributed among the writers by _id.
+    ASSERT_OK(
+        ReplicationCoordinator::get(_opCtx.get())->setFollowerMode(MemberState::RS_RECOVERING));
+    ASSERT_OK(runOpInitialSync(createCollection(kUuid)));
+    ASSERT_OK(runOpInitialSync(buildIndex(fromjson("{x: 1}"), fromjson("{unique: true}"), kUuid)));
+
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 100; ++i) {
+        ops.push_back(insert(BSON("_id" << i << "x" << i)));
+    }
+
+    std::vector<std::vector<const OplogEntry*>> writerVectors(16);
+    CachedCollectionProperties collPropertiesCache;
+    for (auto& op : ops) {
+        OplogApplierUtils::addToWriterVector(
+            _opCtx.get(), &op, &writerVectors, &collPropertiesCache);
+    }
+
+    auto numWritersUsed = std::count_if(writerVectors.begin(),
+                                        writerVectors.end(),
+                                        [](const auto& writer) { return !writer.empty(); });
+    ASSERT_GT(numWritersUsed, 1);
+}
+
 TEST_F(IdempotencyTest, ParallelArrayError) {
     ASSERT_OK(
         ReplicationCoordinator::get(_opCtx.get())->setFollowerMode(MemberState::RS_RECOVERING));
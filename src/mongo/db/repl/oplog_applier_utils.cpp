@@ -84,6 +84,10 @@ void OplogApplierUtils::processCrudOp(OperationContext* opCtx,
     // Include the _id of the document in the hash so we get parallelism even if all writes are to a
     // single collection.
     //
+    // Unique secondary indexes don't need to be taken into account: constraints are relaxed while
+    // applying the oplog, so two ops which transiently conflict on a unique key can be applied by
+    // different writers in either order, and the batch converges to the primary's state.
+    //
     // For capped collections, this is illegal, since capped collections must preserve
     // insertion order.
     if (!collProperties.isCapped) {
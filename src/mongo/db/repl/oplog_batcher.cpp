@@ -160,7 +160,16 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
     std::vector<OplogEntry> ops;
     BSONObj op;
     while (_oplogBuffer->peek(opCtx, &op)) {
-        auto entry = OplogEntry(op);
+        // The raw BSON of '_peekedEntry' is kept alive by the entry, so if it has the same address
+        // as the entry at the front of the buffer, it is the same entry.
+        auto entry = _peekedEntry && _peekedEntry->getRaw().objdata() == op.objdata()
+            ? std::move(*_peekedEntry)
+            : OplogEntry(op);
+        _peekedEntry.reset();
+        auto leaveForNextBatch = [&] {
+            _peekedEntry = std::move(entry);
+            return std::move(ops);
+        };
 
         // Check for oplog version change.
         if (entry.getVersion() != OplogEntry::kOplogVersion) {
@@ -186,7 +195,7 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
                     // reconfigs and shutdown to occur.
                     sleepsecs(1);
                 }
-                return std::move(ops);
+                return leaveForNextBatch();
             }
         }
 
@@ -197,7 +206,7 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
             }
 
             // Otherwise, apply what we have so far and come back for this entry.
-            return std::move(ops);
+            return leaveForNextBatch();
         }
 
         // Apply replication batch limits. Avoid returning an empty batch.
@@ -205,7 +214,7 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
         auto opBytes = entry.getRawObjSizeBytes();
         if (totalOps > 0) {
             if (totalOps + opCount > batchLimits.ops || totalBytes + opBytes > batchLimits.bytes) {
-                return std::move(ops);
+                return leaveForNextBatch();
             }
         }
 
@@ -213,7 +222,7 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
         if (totalOps > 0 && !batchLimits.forceBatchBoundaryAfter.isNull() &&
             entry.getOpTime().getTimestamp() > batchLimits.forceBatchBoundaryAfter &&
             ops.back().getOpTime().getTimestamp() <= batchLimits.forceBatchBoundaryAfter) {
-            return std::move(ops);
+            return leaveForNextBatch();
         }
 
         // Add op to buffer.
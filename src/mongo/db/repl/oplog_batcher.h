@@ -202,6 +202,11 @@ private:
     OplogApplier* _oplogApplier;
     OplogBuffer* const _oplogBuffer;
 
+    // The entry at the front of the OplogBuffer which getNextApplierBatch() parsed but left for
+    // the next batch. It is only reused if its raw BSON is still the one at the front of the
+    // buffer, so that each oplog entry is parsed once.
+    boost::optional<OplogEntry> _peekedEntry;
+
     Mutex _mutex = MONGO_MAKE_LATCH("OplogBatcher::_mutex");
     stdx::condition_variable _cv;
 
@@ -239,6 +239,17 @@ public:
                                                const OpTime& opTime,
                                                const WriteConcernOptions& writeConcern) = 0;
 
+    /**
+     * Returns a future which becomes ready once 'opTime' has been replicated to a set of nodes
+     * that satisfies 'writeConcern', without blocking the calling thread. The writeConcern's
+     * wTimeout and any operation deadline are not applied; callers which need a timeout must
+     * wait on the future with one. The future is set with an error under the same conditions
+     * as awaitReplication, e.g. ErrorCodes::PrimarySteppedDown if this node steps down, or
+     * ErrorCodes::ShutdownInProgress if we are mid-shutdown.
+     */
+    virtual SharedSemiFuture<void> awaitReplicationAsyncNoWTimeout(
+        const OpTime& opTime, const WriteConcernOptions& writeConcern) = 0;
+
     /**
      * Causes this node to relinquish being primary for at least 'stepdownTime'.  If 'force' is
      * false, before doing so it will wait for 'waitTime' for one other electable node to be caught
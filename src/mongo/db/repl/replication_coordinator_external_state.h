@@ -233,6 +233,12 @@ public:
      */
     virtual void signalApplierToChooseNewSyncSource() = 0;
 
+    /**
+     * Notifies the bgsync thread that the members it may choose a sync source from have changed,
+     * so that it doesn't wait to retry if it couldn't find one.
+     */
+    virtual void notifySyncSourceCandidatesChanged() = 0;
+
     /**
      * Notifies the bgsync to stop fetching data.
      */
@@ -918,6 +918,13 @@ void ReplicationCoordinatorExternalStateImpl::signalApplierToChooseNewSyncSource
     }
 }
 
+void ReplicationCoordinatorExternalStateImpl::notifySyncSourceCandidatesChanged() {
+    stdx::lock_guard<Latch> lk(_threadMutex);
+    if (_bgSync) {
+        _bgSync->notifySyncSourceCandidatesChanged();
+    }
+}
+
 void ReplicationCoordinatorExternalStateImpl::stopProducer() {
     stdx::lock_guard<Latch> lk(_threadMutex);
     if (_bgSync) {
@@ -100,6 +100,7 @@ public:
     virtual void closeConnections();
     virtual void onStepDownHook();
     virtual void signalApplierToChooseNewSyncSource();
+    virtual void notifySyncSourceCandidatesChanged();
     virtual void stopProducer();
     virtual void startProducerIfStopped();
     virtual bool tooStale();
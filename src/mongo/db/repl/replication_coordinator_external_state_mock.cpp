@@ -242,6 +242,8 @@ void ReplicationCoordinatorExternalStateMock::onStepDownHook() {}
 
 void ReplicationCoordinatorExternalStateMock::signalApplierToChooseNewSyncSource() {}
 
+void ReplicationCoordinatorExternalStateMock::notifySyncSourceCandidatesChanged() {}
+
 void ReplicationCoordinatorExternalStateMock::stopProducer() {}
 
 void ReplicationCoordinatorExternalStateMock::startProducerIfStopped() {}
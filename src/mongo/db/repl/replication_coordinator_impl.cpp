@@ -1985,6 +1985,14 @@ ReplicationCoordinator::StatusAndDuration ReplicationCoordinatorImpl::awaitRepli
     return {std::move(status), duration_cast<Milliseconds>(timer.elapsed())};
 }
 
+SharedSemiFuture<void> ReplicationCoordinatorImpl::awaitReplicationAsyncNoWTimeout(
+    const OpTime& opTime, const WriteConcernOptions& writeConcern) {
+    WriteConcernOptions fixedWriteConcern = populateUnsetWriteConcernOptionsSyncMode(writeConcern);
+
+    stdx::lock_guard lock(_mutex);
+    return _startWaitingForReplication(lock, opTime, fixedWriteConcern);
+}
+
 BSONObj ReplicationCoordinatorImpl::_getReplicationProgress(WithLock wl) const {
     BSONObjBuilder progress;
 
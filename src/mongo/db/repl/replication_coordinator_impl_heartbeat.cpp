@@ -276,6 +276,16 @@ void ReplicationCoordinatorImpl::_handleHeartbeatResponse(
     HeartbeatResponseAction action = _topCoord->processHeartbeatResponse(
         now, duration_cast<Milliseconds>(networkTime), target, hbStatusResponse);
 
+    // A member that advanced its optime or became primary may now be eligible as a sync source.
+    // Let bgsync retry right away if it couldn't find one, so that secondaries resume replicating
+    // as soon as they learn about a newly elected primary.
+    if (hbStatusResponse.isOK() && !_getMemberState_inlock().primary() &&
+        (action.getAdvancedOpTimeOrUpdatedConfig() ||
+         (hbStatusResponse.getValue().hasState() &&
+          hbStatusResponse.getValue().getState().primary()))) {
+        _externalState->notifySyncSourceCandidatesChanged();
+    }
+
     if (action.getAction() == HeartbeatResponseAction::NoAction && hbStatusResponse.isOK() &&
         hbStatusResponse.getValue().hasState() &&
         hbStatusResponse.getValue().getState() != MemberState::RS_PRIMARY &&
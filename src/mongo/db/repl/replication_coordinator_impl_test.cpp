@@ -1253,6 +1253,53 @@ TEST_F(ReplCoordTest, NodeReturnsNotPrimaryWhenSteppingDownBeforeSatisfyingAWrit
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, AwaitReplicationAsyncIsSatisfiedByProgressAndFailsOnStepDown) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id" << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 2);
+    OpTimeWithTermOne time2(100, 3);
+    replCoordSetMyLastAppliedOpTime(time2, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time2, Date_t() + Seconds(100));
+
+    WriteConcernOptions writeConcern;
+    writeConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+    writeConcern.wNumNodes = 2;
+
+    // Neither future is ready until a second node has the write, and no thread is blocked on them.
+    auto future1 = getReplCoord()->awaitReplicationAsyncNoWTimeout(time1, writeConcern);
+    auto future2 = getReplCoord()->awaitReplicationAsyncNoWTimeout(time2, writeConcern);
+    ASSERT_FALSE(future1.isReady());
+    ASSERT_FALSE(future2.isReady());
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time1));
+    ASSERT_OK(getReplCoord()->setLastDurableOptime_forTest(2, 1, time1));
+    ASSERT_TRUE(future1.isReady());
+    ASSERT_OK(future1.getNoThrow());
+    ASSERT_FALSE(future2.isReady());
+
+    // Stepping down fails the waiters which are still outstanding.
+    const auto opCtx = makeOperationContext();
+    getReplCoord()->stepDown(opCtx.get(), true, Milliseconds(0), Milliseconds(1000));
+    ASSERT_TRUE(future2.isReady());
+    ASSERT_EQUALS(ErrorCodes::PrimarySteppedDown, future2.getNoThrow());
+}
+
 TEST_F(ReplCoordTest,
        NodeReturnsInterruptedWhenAnOpWaitingForWriteConcernToBeSatisfiedIsInterrupted) {
     // Tests that a thread blocked in awaitReplication can be killed by a killOp operation
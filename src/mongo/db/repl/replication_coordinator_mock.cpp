@@ -165,6 +165,13 @@ ReplicationCoordinator::StatusAndDuration ReplicationCoordinatorMock::awaitRepli
     return _awaitReplicationReturnValueFunction(opCtx, opTime);
 }
 
+SharedSemiFuture<void> ReplicationCoordinatorMock::awaitReplicationAsyncNoWTimeout(
+    const OpTime& opTime, const WriteConcernOptions& writeConcern) {
+    // There is no operation to pass along, since the wait is not tied to one.
+    auto result = _awaitReplicationReturnValueFunction(nullptr, opTime);
+    return Future<void>::makeReady(result.status).share();
+}
+
 void ReplicationCoordinatorMock::setAwaitReplicationReturnValueFunction(
     AwaitReplicationReturnValueFunction returnValueFunction) {
     _awaitReplicationReturnValueFunction = std::move(returnValueFunction);
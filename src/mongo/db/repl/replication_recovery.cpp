@@ -64,11 +64,17 @@ namespace {
 const auto kRecoveryBatchLogLevel = logv2::LogSeverity::Debug(2);
 const auto kRecoveryOperationLogLevel = logv2::LogSeverity::Debug(3);
 
+// How often to log the progress of recovery oplog application.
+const Seconds kRecoveryProgressLogInterval{10};
+
 /**
  * Tracks and logs operations applied during recovery.
  */
 class RecoveryOplogApplierStats : public OplogApplier::Observer {
 public:
+    RecoveryOplogApplierStats(const Timestamp& startPoint, const Timestamp& endPoint)
+        : _startPoint(startPoint), _endPoint(endPoint) {}
+
     void onBatchBegin(const std::vector<OplogEntry>& batch) final {
         _numBatches++;
         LOGV2_FOR_RECOVERY(24098,
@@ -102,7 +108,15 @@ public:
         }
     }
 
-    void onBatchEnd(const StatusWith<OpTime>&, const std::vector<OplogEntry>&) final {}
+    void onBatchEnd(const StatusWith<OpTime>& lastOpTimeApplied,
+                    const std::vector<OplogEntry>&) final {
+        if (!lastOpTimeApplied.isOK() ||
+            Seconds(_sinceLastProgressLog.seconds()) < kRecoveryProgressLogInterval) {
+            return;
+        }
+        _sinceLastProgressLog.reset();
+        _logProgress(lastOpTimeApplied.getValue().getTimestamp());
+    }
 
     void complete(const OpTime& applyThroughOpTime) const {
         LOGV2(21536,
@@ -115,6 +129,40 @@ public:
     }
 
 private:
+    /**
+     * Logs how far through the oplog application range recovery is, estimating the time
+     * remaining from the wall-clock span of the oplog applied so far. Oplog entries are not spread
+     * evenly over time, so this is only a rough estimate.
+     */
+    void _logProgress(const Timestamp& appliedThrough) const {
+        auto totalSecs = _endPoint.getSecs() - _startPoint.getSecs();
+        auto appliedSecs = appliedThrough.getSecs() - _startPoint.getSecs();
+        double fraction = totalSecs > 0 ? static_cast<double>(appliedSecs) / totalSecs : 1.0;
+        auto elapsedSecs = _sinceStart.seconds();
+        auto opsPerSec = elapsedSecs > 0 ? static_cast<long long>(_numOpsApplied / elapsedSecs) : 0;
+        auto remainingSecs = fraction > 0
+            ? static_cast<long long>(elapsedSecs * (1.0 - fraction) / fraction)
+            : 0;
+
+        LOGV2(5843224,
+              "Recovery oplog application progress: applied {numOpsApplied} operations through "
+              "{appliedThrough} ({percentComplete}% of the oplog to {endPoint}) in {elapsedSecs} "
+              "seconds. Estimated seconds remaining: {estimatedSecsRemaining}",
+              "Recovery oplog application progress",
+              "numOpsApplied"_attr = _numOpsApplied,
+              "numBatches"_attr = _numBatches,
+              "appliedThrough"_attr = appliedThrough,
+              "endPoint"_attr = _endPoint,
+              "percentComplete"_attr = static_cast<int>(fraction * 100),
+              "opsPerSecond"_attr = opsPerSec,
+              "elapsedSecs"_attr = elapsedSecs,
+              "estimatedSecsRemaining"_attr = remainingSecs);
+    }
+
+    const Timestamp _startPoint;
+    const Timestamp _endPoint;
+    Timer _sinceStart;
+    Timer _sinceLastProgressLog;
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
 };
@@ -589,7 +637,7 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
     OplogBufferLocalOplog oplogBuffer(startPoint, endPoint);
     oplogBuffer.startup(opCtx);
 
-    RecoveryOplogApplierStats stats;
+    RecoveryOplogApplierStats stats(startPoint, endPoint);
 
     auto writerPool = makeReplWriterPool();
     OplogApplierImpl oplogApplier(nullptr,
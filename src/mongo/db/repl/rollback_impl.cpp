@@ -611,17 +611,15 @@ void RollbackImpl::_correctRecordStoreCounts(OperationContext* opCtx) {
             invariant(coll == collToScan.getCollection(),
                       str::stream() << "Catalog returned invalid collection: " << nss.ns() << " ("
                                     << uuid.toString() << ")");
-            auto exec = collToScan->makePlanExecutor(opCtx,
-                                                     collToScan.getCollection(),
-                                                     PlanYieldPolicy::YieldPolicy::INTERRUPT_ONLY,
-                                                     Collection::ScanDirection::kForward);
+            // Only the number of records is needed, so iterate the record store directly rather
+            // than building a query plan which would materialize every document.
             long long countFromScan = 0;
-            PlanExecutor::ExecState state;
-            while (PlanExecutor::ADVANCED ==
-                   (state = exec->getNext(static_cast<BSONObj*>(nullptr), nullptr))) {
-                ++countFromScan;
-            }
-            if (PlanExecutor::IS_EOF != state) {
+            try {
+                auto cursor = collToScan->getRecordStore()->getCursor(opCtx);
+                while (cursor->next()) {
+                    ++countFromScan;
+                }
+            } catch (const DBException& ex) {
                 // We ignore errors here because crashing or leaving rollback would only leave
                 // collection counts more inaccurate.
                 LOGV2_WARNING(21637,
@@ -631,7 +629,7 @@ void RollbackImpl::_correctRecordStoreCounts(OperationContext* opCtx) {
                               "namespace"_attr = nss.ns(),
                               "uuid"_attr = uuid.toString(),
                               "ident"_attr = ident,
-                              "error"_attr = exec->statestr(state));
+                              "error"_attr = ex.toStatus());
                 continue;
             }
             newCount = countFromScan;
@@ -37,7 +37,6 @@
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/session.h"
-#include "mongo/db/session_txn_record_gen.h"
 #include "mongo/db/transaction_participant_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
@@ -74,43 +73,22 @@ OplogEntry createOplogEntryForTransactionTableUpdate(repl::OpTime opTime,
 }
 
 /**
- * Constructs a new oplog entry if the given entry has transaction state embedded within in. The new
- * oplog entry will contain the operation needed to replicate the transaction table.
- *
- * Returns boost::none if the given oplog doesn't have any transaction state or does not support
- * update to the transaction table.
+ * Constructs a new oplog entry which contains the operation needed to replicate the transaction
+ * table entry 'txnRecord' of a retryable write.
  */
-boost::optional<repl::OplogEntry> createMatchingTransactionTableUpdate(
-    const repl::OplogEntry& entry) {
-    auto sessionInfo = entry.getOperationSessionInfo();
-    if (!sessionInfo.getTxnNumber()) {
-        return boost::none;
-    }
-
-    invariant(sessionInfo.getSessionId());
-
-    const auto updateBSON = [&] {
-        SessionTxnRecord newTxnRecord;
-        newTxnRecord.setSessionId(*sessionInfo.getSessionId());
-        newTxnRecord.setTxnNum(*sessionInfo.getTxnNumber());
-        newTxnRecord.setLastWriteOpTime(entry.getOpTime());
-        newTxnRecord.setLastWriteDate(entry.getWallClockTime());
-
-        return newTxnRecord.toBSON();
-    }();
-
+repl::OplogEntry createMatchingTransactionTableUpdate(const SessionTxnRecord& txnRecord) {
     return createOplogEntryForTransactionTableUpdate(
-        entry.getOpTime(),
-        updateBSON,
-        BSON(SessionTxnRecord::kSessionIdFieldName << sessionInfo.getSessionId()->toBSON()),
-        entry.getWallClockTime());
+        txnRecord.getLastWriteOpTime(),
+        txnRecord.toBSON(),
+        BSON(SessionTxnRecord::kSessionIdFieldName << txnRecord.getSessionId().toBSON()),
+        txnRecord.getLastWriteDate());
 }
 
 /**
  * Returns true if the oplog entry represents an operation in a transaction and false otherwise.
  */
-bool isTransactionEntry(OplogEntry entry) {
-    auto sessionInfo = entry.getOperationSessionInfo();
+bool isTransactionEntry(const OplogEntry& entry) {
+    const auto& sessionInfo = entry.getOperationSessionInfo();
     if (!sessionInfo.getTxnNumber()) {
         return false;
     }
@@ -183,26 +161,25 @@ void SessionUpdateTracker::_updateSessionInfo(const OplogEntry& entry) {
 
     auto iter = _sessionsToUpdate.find(*lsid);
     if (iter == _sessionsToUpdate.end()) {
-        _sessionsToUpdate.emplace(*lsid, entry);
-        return;
-    }
-
-    const auto& existingSessionInfo = iter->second.getOperationSessionInfo();
-    if (*sessionInfo.getTxnNumber() >= *existingSessionInfo.getTxnNumber()) {
-        iter->second = entry;
-        return;
+        iter = _sessionsToUpdate.emplace(*lsid, SessionTxnRecord()).first;
+        iter->second.setSessionId(*lsid);
+    } else if (*sessionInfo.getTxnNumber() < iter->second.getTxnNum()) {
+        LOGV2_FATAL_NOTRACE(
+            50843,
+            "Entry for session {lsid} has txnNumber {sessionInfo_getTxnNumber} < "
+            "{existingSessionInfo_getTxnNumber}. New oplog entry: {newEntry}, Existing "
+            "transaction table entry: {existingEntry}",
+            "lsid"_attr = lsid->toBSON(),
+            "sessionInfo_getTxnNumber"_attr = *sessionInfo.getTxnNumber(),
+            "existingSessionInfo_getTxnNumber"_attr = iter->second.getTxnNum(),
+            "newEntry"_attr = redact(entry.toString()),
+            "existingEntry"_attr = redact(iter->second.toBSON()));
     }
 
-    LOGV2_FATAL_NOTRACE(50843,
-                        "Entry for session {lsid} has txnNumber {sessionInfo_getTxnNumber} < "
-                        "{existingSessionInfo_getTxnNumber}. New oplog entry: {newEntry}, Existing "
-                        "oplog entry: {existingEntry}",
-                        "lsid"_attr = lsid->toBSON(),
-                        "sessionInfo_getTxnNumber"_attr = *sessionInfo.getTxnNumber(),
-                        "existingSessionInfo_getTxnNumber"_attr =
-                            *existingSessionInfo.getTxnNumber(),
-                        "newEntry"_attr = redact(entry.toString()),
-                        "existingEntry"_attr = redact(iter->second.toString()));
+    auto& txnRecord = iter->second;
+    txnRecord.setTxnNum(*sessionInfo.getTxnNumber());
+    txnRecord.setLastWriteOpTime(entry.getOpTime());
+    txnRecord.setLastWriteDate(entry.getWallClockTime());
 }
 
 std::vector<OplogEntry> SessionUpdateTracker::_flush(const OplogEntry& entry) {
@@ -230,10 +207,9 @@ std::vector<OplogEntry> SessionUpdateTracker::_flush(const OplogEntry& entry) {
 std::vector<OplogEntry> SessionUpdateTracker::flushAll() {
     std::vector<OplogEntry> opList;
 
+    opList.reserve(_sessionsToUpdate.size());
     for (auto&& entry : _sessionsToUpdate) {
-        auto newUpdate = createMatchingTransactionTableUpdate(entry.second);
-        invariant(newUpdate);
-        opList.push_back(std::move(*newUpdate));
+        opList.push_back(createMatchingTransactionTableUpdate(entry.second));
     }
     _sessionsToUpdate.clear();
 
@@ -251,9 +227,7 @@ std::vector<OplogEntry> SessionUpdateTracker::_flushForQueryPredicate(
     }
 
     std::vector<OplogEntry> opList;
-    auto updateOplog = createMatchingTransactionTableUpdate(iter->second);
-    invariant(updateOplog);
-    opList.push_back(std::move(*updateOplog));
+    opList.push_back(createMatchingTransactionTableUpdate(iter->second));
     _sessionsToUpdate.erase(iter);
 
     return opList;
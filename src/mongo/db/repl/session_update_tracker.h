@@ -36,6 +36,7 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/repl/oplog_entry.h"
+#include "mongo/db/session_txn_record_gen.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -97,7 +98,10 @@ private:
     boost::optional<OplogEntry> _createTransactionTableUpdateFromTransactionOp(
         const repl::OplogEntry& entry);
 
-    LogicalSessionIdMap<OplogEntry> _sessionsToUpdate;
+    // The latest transaction table entry of each session updated by a retryable write since the
+    // last flush. Only the fields needed to generate the update are kept, rather than a copy of
+    // the whole oplog entry of the last write.
+    LogicalSessionIdMap<SessionTxnRecord> _sessionsToUpdate;
 };
 
 }  // namespace repl
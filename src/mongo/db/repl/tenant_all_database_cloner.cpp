@@ -139,6 +139,9 @@ void TenantAllDatabaseCloner::postStage() {
                                                                             getStorageInterface(),
                                                                             getDBPool(),
                                                                             _tenantId);
+            if (_createClientFn) {
+                _currentDatabaseCloner->setCreateClientFn(_createClientFn);
+            }
         }
         auto dbStatus = _currentDatabaseCloner->run();
         if (dbStatus.isOK()) {
@@ -208,5 +211,10 @@ Timestamp TenantAllDatabaseCloner::getOperationTime_forTest() {
     return _operationTime;
 }
 
+void TenantAllDatabaseCloner::setCreateClientFn(
+    TenantDatabaseCloner::CreateClientFn createClientFn) {
+    _createClientFn = std::move(createClientFn);
+}
+
 }  // namespace repl
 }  // namespace mongo
@@ -65,6 +65,12 @@ public:
 
     Timestamp getOperationTime_forTest();
 
+    /**
+     * Sets how the TenantDatabaseCloners obtain the additional connections used to clone
+     * collections concurrently. See TenantDatabaseCloner::setCreateClientFn().
+     */
+    void setCreateClientFn(TenantDatabaseCloner::CreateClientFn createClientFn);
+
 protected:
     ClonerStages getStages() final;
 
@@ -107,6 +113,7 @@ private:
     //      threads, read access allowed from main flow without mutex.
     std::vector<std::string> _databases;                           // (X)
     std::unique_ptr<TenantDatabaseCloner> _currentDatabaseCloner;  // (MX)
+    TenantDatabaseCloner::CreateClientFn _createClientFn;          // (X)
 
     // The database name prefix of the tenant associated with this migration.
     std::string _tenantId;  // (R)
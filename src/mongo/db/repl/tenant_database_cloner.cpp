@@ -32,13 +32,16 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/repl/cloner_utils.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/tenant_collection_cloner.h"
 #include "mongo/db/repl/tenant_database_cloner.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -172,6 +175,10 @@ bool TenantDatabaseCloner::isMyFailPoint(const BSONObj& data) const {
     return data["database"].str() == _dbName && BaseCloner::isMyFailPoint(data);
 }
 
+void TenantDatabaseCloner::setCreateClientFn(CreateClientFn createClientFn) {
+    _createClientFn = std::move(createClientFn);
+}
+
 void TenantDatabaseCloner::postStage() {
     {
         stdx::lock_guard<Latch> lk(_mutex);
@@ -181,60 +188,121 @@ void TenantDatabaseCloner::postStage() {
             _stats.collectionStats.emplace_back();
             _stats.collectionStats.back().ns = coll.first.ns();
         }
+        _collectionCloners.resize(_collections.size());
     }
-    for (const auto& coll : _collections) {
-        auto& sourceNss = coll.first;
-        auto& collectionOptions = coll.second;
-        {
-            stdx::lock_guard<Latch> lk(_mutex);
-            _currentCollectionCloner =
-                std::make_unique<TenantCollectionCloner>(sourceNss,
-                                                         collectionOptions,
-                                                         getSharedData(),
-                                                         getSource(),
-                                                         getClient(),
-                                                         getStorageInterface(),
-                                                         getDBPool(),
-                                                         _tenantId);
+
+    const size_t maxConcurrentCloners = !_createClientFn
+        ? 1
+        : std::min(_collections.size(),
+                   size_t(tenantMigrationMaxConcurrentCollectionCloners.load()));
+    if (maxConcurrentCloners <= 1) {
+        for (size_t i = 0; i < _collections.size(); ++i) {
+            if (!cloneCollection(i, getClient()))
+                return;
         }
-        auto collStatus = _currentCollectionCloner->run();
-        if (collStatus.isOK()) {
-            LOGV2_DEBUG(4881600,
-                        1,
-                        "Tenant collection clone finished",
-                        "namespace"_attr = sourceNss,
-                        "tenantId"_attr = _tenantId);
-        } else {
-            LOGV2_ERROR(4881601,
-                        "Tenant collection clone failed",
-                        "namespace"_attr = sourceNss,
-                        "error"_attr = collStatus.toString(),
-                        "tenantId"_attr = _tenantId);
-            setSyncFailedStatus({collStatus.code(),
-                                 collStatus
-                                     .withContext(str::stream() << "Error cloning collection '"
-                                                                << sourceNss.toString() << "'")
-                                     .toString()});
+    } else {
+        // Each worker uses its own connection, since the cloners read from the donor with exhaust
+        // cursors. If an additional connection can't be made, clone with fewer workers.
+        std::vector<DBClientConnection*> additionalClients;
+        for (size_t i = 1; i < maxConcurrentCloners; ++i) {
+            try {
+                additionalClients.push_back(_createClientFn());
+            } catch (const DBException& ex) {
+                LOGV2(5843217,
+                      "Failed to open an additional connection for cloning tenant collections "
+                      "concurrently",
+                      "database"_attr = _dbName,
+                      "source"_attr = getSource(),
+                      "tenantId"_attr = _tenantId,
+                      "error"_attr = ex.toStatus());
+                break;
+            }
         }
-        {
-            stdx::lock_guard<Latch> lk(_mutex);
-            _stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-            _currentCollectionCloner = nullptr;
-            // Abort the tenant database cloner if the collection clone failed.
-            if (!collStatus.isOK())
-                return;
-            _stats.clonedCollections++;
+
+        AtomicWord<size_t> nextCollection{0};
+        AtomicWord<bool> failed{false};
+        auto cloneCollections = [&](DBClientConnection* client) {
+            while (!failed.load()) {
+                auto index = nextCollection.fetchAndAdd(1);
+                if (index >= _collections.size())
+                    return;
+                if (!cloneCollection(index, client))
+                    failed.store(true);
+            }
+        };
+
+        std::vector<stdx::thread> workers;
+        workers.reserve(additionalClients.size());
+        for (size_t i = 0; i < additionalClients.size(); ++i) {
+            workers.emplace_back([&, client = additionalClients[i], i] {
+                Client::initThread(str::stream()
+                                   << "TenantDatabaseCloner-" << _dbName << "-" << i + 1);
+                cloneCollections(client);
+            });
         }
+        cloneCollections(getClient());
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        if (failed.load())
+            return;
     }
     stdx::lock_guard<Latch> lk(_mutex);
     _stats.end = getSharedData()->getClock()->now();
 }
 
+bool TenantDatabaseCloner::cloneCollection(size_t index, DBClientConnection* client) {
+    auto& sourceNss = _collections[index].first;
+    auto& collectionOptions = _collections[index].second;
+    TenantCollectionCloner* collectionCloner;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _collectionCloners[index] = std::make_unique<TenantCollectionCloner>(sourceNss,
+                                                                             collectionOptions,
+                                                                             getSharedData(),
+                                                                             getSource(),
+                                                                             client,
+                                                                             getStorageInterface(),
+                                                                             getDBPool(),
+                                                                             _tenantId);
+        collectionCloner = _collectionCloners[index].get();
+    }
+    auto collStatus = collectionCloner->run();
+    if (collStatus.isOK()) {
+        LOGV2_DEBUG(4881600,
+                    1,
+                    "Tenant collection clone finished",
+                    "namespace"_attr = sourceNss,
+                    "tenantId"_attr = _tenantId);
+    } else {
+        LOGV2_ERROR(4881601,
+                    "Tenant collection clone failed",
+                    "namespace"_attr = sourceNss,
+                    "error"_attr = collStatus.toString(),
+                    "tenantId"_attr = _tenantId);
+        setSyncFailedStatus({collStatus.code(),
+                             collStatus
+                                 .withContext(str::stream() << "Error cloning collection '"
+                                                            << sourceNss.toString() << "'")
+                                 .toString()});
+    }
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stats.collectionStats[index] = collectionCloner->getStats();
+    _collectionCloners[index] = nullptr;
+    // Abort the tenant database cloner if the collection clone failed.
+    if (!collStatus.isOK())
+        return false;
+    _stats.clonedCollections++;
+    return true;
+}
+
 TenantDatabaseCloner::Stats TenantDatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     TenantDatabaseCloner::Stats stats = _stats;
-    if (_currentCollectionCloner) {
-        stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
+    for (size_t i = 0; i < _collectionCloners.size(); ++i) {
+        if (_collectionCloners[i]) {
+            stats.collectionStats[i] = _collectionCloners[i]->getStats();
+        }
     }
     return stats;
 }
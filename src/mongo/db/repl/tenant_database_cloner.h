@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
@@ -54,6 +55,12 @@ public:
         void append(BSONObjBuilder* builder) const;
     };
 
+    /**
+     * Returns a new connection to the donor, authenticated for the migration. The connection is
+     * owned by the caller, which must keep it alive until the cloner completes.
+     */
+    using CreateClientFn = std::function<DBClientConnection*()>;
+
     TenantDatabaseCloner(const std::string& dbName,
                          TenantMigrationSharedData* sharedData,
                          const HostAndPort& source,
@@ -70,6 +77,13 @@ public:
 
     Timestamp getOperationTime_forTest();
 
+    /**
+     * Sets how to obtain the additional connections used to clone up to
+     * 'tenantMigrationMaxConcurrentCollectionCloners' collections concurrently. If never set, the
+     * collections are cloned one at a time on the main connection.
+     */
+    void setCreateClientFn(CreateClientFn createClientFn);
+
 protected:
     ClonerStages getStages() final;
 
@@ -107,6 +121,13 @@ private:
      */
     void postStage() final;
 
+    /**
+     * Creates and runs the TenantCollectionCloner for the collection at 'index' in _collections,
+     * using 'client' to read from the donor. Returns false if the clone failed, in which case the
+     * sync failed status has been set.
+     */
+    bool cloneCollection(size_t index, DBClientConnection* client);
+
     // All member variables are labeled with one of the following codes indicating the
     // synchronization rules for accessing them.
     //
@@ -118,7 +139,9 @@ private:
     //      threads, read access allowed from main flow without mutex.
     const std::string _dbName;                                                // (R)
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
-    std::unique_ptr<TenantCollectionCloner> _currentCollectionCloner;         // (MX)
+    // The cloners of the collections currently being cloned, indexed like _collections.
+    std::vector<std::unique_ptr<TenantCollectionCloner>> _collectionCloners;  // (M)
+    CreateClientFn _createClientFn;                                           // (X)
 
     TenantDatabaseClonerStage _listCollectionsStage;  // (R)
 
@@ -128,7 +151,7 @@ private:
     // The operationTime returned with the listCollections result.
     Timestamp _operationTime;  // (X)
 
-    Stats _stats;  // (MX)
+    Stats _stats;  // (M)
 };
 
 
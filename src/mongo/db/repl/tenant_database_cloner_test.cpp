@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/clientcursor.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/repl/tenant_cloner_test_fixture.h"
@@ -39,6 +40,7 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -529,6 +531,56 @@ TEST_F(TenantDatabaseClonerTest, CreateCollections) {
     ASSERT_EQUALS(0, collInfo.numDocsInserted);
 }
 
+TEST_F(TenantDatabaseClonerTest, CreateCollectionsConcurrently) {
+    tenantMigrationMaxConcurrentCollectionCloners.store(2);
+    ON_BLOCK_EXIT([] { tenantMigrationMaxConcurrentCollectionCloners.store(1); });
+
+    const BSONObj idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                         << "_id_");
+    std::vector<BSONObj> sourceInfos;
+    std::vector<StatusWith<BSONObj>> listIndexesResponses;
+    for (auto&& name : {"a", "b", "c"}) {
+        sourceInfos.push_back(BSON("name" << name << "type"
+                                          << "collection"
+                                          << "options" << BSONObj() << "info"
+                                          << BSON("readOnly" << false << "uuid" << UUID::gen())));
+        listIndexesResponses.push_back(
+            createCursorResponse(_dbName + "." + name, BSON_ARRAY(idIndexSpec)));
+        // Insert the entries up front, since the cloners create their collections concurrently.
+        _collections[NamespaceString{_dbName, name}];
+    }
+    _mockServer->setCommandReply("listCollections", createListCollectionsResponse(sourceInfos));
+    _mockServer->setCommandReply("find", createFindResponse());
+    _mockServer->setCommandReply(
+        "count", {createCountResponse(0), createCountResponse(0), createCountResponse(0)});
+    _mockServer->setCommandReply("listIndexes", listIndexesResponses);
+
+    auto cloner = makeDatabaseCloner();
+    std::vector<std::unique_ptr<MockDBClientConnection>> additionalClients;
+    cloner->setCreateClientFn([&] {
+        additionalClients.push_back(
+            std::make_unique<MockDBClientConnection>(_mockServer.get(), true /* autoReconnect */));
+        additionalClients.back()->setOperationTime(_operationTime);
+        return additionalClients.back().get();
+    });
+    ASSERT_OK(cloner->run());
+
+    // The main connection is shared with one additional connection.
+    ASSERT_EQUALS(1U, additionalClients.size());
+    ASSERT_EQUALS(3U, _collections.size());
+    for (auto&& name : {"a", "b", "c"}) {
+        auto collInfo = _collections[NamespaceString{_dbName, name}];
+        ASSERT(collInfo.collCreated);
+        ASSERT_EQUALS(0, collInfo.numDocsInserted);
+    }
+
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(3U, stats.collections);
+    ASSERT_EQUALS(3U, stats.clonedCollections);
+    ASSERT_EQUALS(_dbName + ".a", stats.collectionStats[0].ns);
+    ASSERT_EQUALS(_dbName + ".c", stats.collectionStats[2].ns);
+}
+
 TEST_F(TenantDatabaseClonerTest, DatabaseAndCollectionStats) {
     auto uuid1 = UUID::gen();
     auto uuid2 = UUID::gen();
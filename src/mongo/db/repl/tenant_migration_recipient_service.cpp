@@ -272,6 +272,31 @@ std::unique_ptr<DBClientConnection> TenantMigrationRecipientService::Instance::_
     return client;
 }
 
+DBClientConnection* TenantMigrationRecipientService::Instance::_connectAdditionalClonerClient() {
+    HostAndPort serverAddress;
+    {
+        stdx::lock_guard lk(_mutex);
+        if (_taskState.isInterrupted()) {
+            uassertStatusOK(_taskState.getInterruptStatus());
+        }
+        serverAddress = _client->getServerHostAndPort();
+    }
+
+    // "TenantMigration_" (16 bytes) + <tenantId> (61 bytes) + "_" (1 byte) +
+    // <migrationUuid> (36 bytes) + "_cloner" (7 bytes) = 121 bytes length.
+    auto applicationName =
+        "TenantMigration_" + getTenantId() + "_" + getMigrationUUID().toString() + "_cloner";
+    auto client = _connectAndAuth(serverAddress, applicationName, _authParams);
+
+    stdx::lock_guard lk(_mutex);
+    if (_taskState.isInterrupted()) {
+        client->shutdownAndDisallowReconnect();
+        uassertStatusOK(_taskState.getInterruptStatus());
+    }
+    _additionalClonerClients.push_back(std::move(client));
+    return _additionalClonerClients.back().get();
+}
+
 SemiFuture<TenantMigrationRecipientService::Instance::ConnectionPair>
 TenantMigrationRecipientService::Instance::_createAndConnectClients() {
     LOGV2_DEBUG(4880401,
@@ -615,6 +640,8 @@ Future<void> TenantMigrationRecipientService::Instance::_startTenantAllDatabaseC
                                                   repl::StorageInterface::get(opCtx.get()),
                                                   _writerPool.get(),
                                                   _tenantId);
+    _tenantAllDatabaseCloner->setCreateClientFn(
+        [this] { return _connectAdditionalClonerClient(); });
     LOGV2_DEBUG(4881100,
                 2,
                 "Starting TenantAllDatabaseCloner",
@@ -730,6 +757,11 @@ void TenantMigrationRecipientService::Instance::_cancelRemainingWork(WithLock lk
         _oplogFetcherClient->shutdownAndDisallowReconnect();
     }
 
+    for (auto&& client : _additionalClonerClients) {
+        // interrupts tenant collection cloners running concurrently.
+        client->shutdownAndDisallowReconnect();
+    }
+
     // Interrupts running oplog applier.
     shutdownTarget(lk, _tenantOplogApplier);
     shutdownTarget(lk, _writerPool);
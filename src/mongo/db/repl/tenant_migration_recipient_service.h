@@ -262,6 +262,13 @@ public:
                                                             StringData applicationName,
                                                             BSONObj authParams);
 
+        /**
+         * Opens an additional connection to the donor host of '_client', so the cloners can clone
+         * collections concurrently. The connection is owned by this instance, and is shut down
+         * with the other donor connections when the instance is interrupted.
+         */
+        DBClientConnection* _connectAdditionalClonerClient();
+
         /**
          * Creates and connects both the oplog fetcher client and the client used for other
          * operations.
@@ -370,6 +377,8 @@ public:
         // optimes while the '_oplogFetcherClient' will be reserved for the oplog fetcher only.
         std::unique_ptr<DBClientConnection> _client;              // (M)
         std::unique_ptr<DBClientConnection> _oplogFetcherClient;  // (M)
+        // Additional connections used by the cloners to clone collections concurrently.
+        std::vector<std::unique_ptr<DBClientConnection>> _additionalClonerClients;  // (M)
 
         std::unique_ptr<OplogFetcherFactory> _createOplogFetcherFn =
             std::make_unique<CreateOplogFetcherFn>();                               // (M)
@@ -32,7 +32,8 @@
 namespace mongo {
 namespace repl {
 void TenantMigrationSharedData::setLastVisibleOpTime(WithLock, OpTime opTime) {
-    _lastVisibleOpTime = opTime;
+    // Collections may be cloned concurrently, so replies can arrive out of order.
+    _lastVisibleOpTime = std::max(_lastVisibleOpTime, opTime);
 }
 
 OpTime TenantMigrationSharedData::getLastVisibleOpTime(WithLock) {
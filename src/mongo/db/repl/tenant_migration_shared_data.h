@@ -38,6 +38,9 @@ class TenantMigrationSharedData final : public ReplSyncSharedData {
 public:
     TenantMigrationSharedData(ClockSource* clock) : ReplSyncSharedData(clock) {}
 
+    /**
+     * Advances the last visible opTime to 'opTime', if it is later than the current one.
+     */
     void setLastVisibleOpTime(WithLock, OpTime opTime);
 
     OpTime getLastVisibleOpTime(WithLock);
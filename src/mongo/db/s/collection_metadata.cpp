@@ -33,6 +33,8 @@
 
 #include "mongo/db/s/collection_metadata.h"
 
+#include <numeric>
+
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/bson/dotted_path_support.h"
@@ -42,7 +44,86 @@
 namespace mongo {
 
 CollectionMetadata::CollectionMetadata(ChunkManager cm, const ShardId& thisShardId)
-    : _cm(std::move(cm)), _thisShardId(thisShardId) {}
+    : _cm(std::move(cm)),
+      _thisShardId(thisShardId),
+      _ownedRanges(std::make_shared<OwnedKeyStringRanges>()) {}
+
+const std::vector<std::pair<std::string, std::string>>&
+CollectionMetadata::_getOwnedKeyStringRanges() const {
+    std::call_once(_ownedRanges->built, [&] {
+        auto& ranges = _ownedRanges->ranges;
+        _cm->forEachChunk([&](const auto& chunk) {
+            if (chunk.getShardId() != _thisShardId)
+                return true;
+
+            auto minKeyString = ShardKeyPattern::toKeyString(chunk.getMin());
+            if (!ranges.empty() && ranges.back().second == minKeyString) {
+                ranges.back().second = ShardKeyPattern::toKeyString(chunk.getMax());
+            } else {
+                ranges.emplace_back(std::move(minKeyString),
+                                    ShardKeyPattern::toKeyString(chunk.getMax()));
+            }
+            return true;
+        });
+    });
+
+    return _ownedRanges->ranges;
+}
+
+bool CollectionMetadata::keyBelongsToMe(const BSONObj& key) const {
+    invariant(isSharded());
+    if (key.isEmpty())
+        return false;
+
+    const auto& ranges = _getOwnedKeyStringRanges();
+    const auto keyString = ShardKeyPattern::toKeyString(key);
+
+    // Find the last range starting at or before the key.
+    auto it = std::upper_bound(ranges.begin(),
+                               ranges.end(),
+                               keyString,
+                               [](const std::string& keyString, const auto& range) {
+                                   return keyString < range.first;
+                               });
+    return it != ranges.begin() && keyString < std::prev(it)->second;
+}
+
+std::vector<bool> CollectionMetadata::keysBelongToMe(const std::vector<BSONObj>& keys) const {
+    invariant(isSharded());
+    const auto& ranges = _getOwnedKeyStringRanges();
+
+    std::vector<std::string> keyStrings;
+    keyStrings.reserve(keys.size());
+    for (const auto& key : keys) {
+        keyStrings.push_back(key.isEmpty() ? std::string() : ShardKeyPattern::toKeyString(key));
+    }
+
+    std::vector<size_t> keyOrder(keys.size());
+    std::iota(keyOrder.begin(), keyOrder.end(), 0);
+    std::sort(keyOrder.begin(), keyOrder.end(), [&](size_t a, size_t b) {
+        return keyStrings[a] < keyStrings[b];
+    });
+
+    // Since the keys are visited in ascending order, the search for the range of each key resumes
+    // from the range of the previous one.
+    std::vector<bool> belongs(keys.size(), false);
+    auto rangeIt = ranges.begin();
+    for (auto i : keyOrder) {
+        if (keys[i].isEmpty())
+            continue;
+
+        const auto& keyString = keyStrings[i];
+        while (rangeIt != ranges.end() && rangeIt->second <= keyString) {
+            ++rangeIt;
+        }
+        if (rangeIt == ranges.end())
+            break;
+
+        belongs[i] = rangeIt->first <= keyString;
+    }
+
+    return belongs;
+}
 
 bool CollectionMetadata::allowMigrations() const {
     return _cm ? _cm->allowMigrations() : true;
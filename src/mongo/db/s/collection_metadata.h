@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "mongo/db/range_arithmetic.h"
 #include "mongo/s/chunk_manager.h"
 
@@ -183,10 +185,13 @@ public:
      * Returns true if the document with the given key belongs to this chunkset. If the key is empty
      * returns false. If key is not a valid shard key, the behaviour is undefined.
      */
-    bool keyBelongsToMe(const BSONObj& key) const {
-        invariant(isSharded());
-        return _cm->keyBelongsToShard(key, _thisShardId);
-    }
+    bool keyBelongsToMe(const BSONObj& key) const;
+
+    /**
+     * Same as keyBelongsToMe, for each of 'keys'. The keys are encoded once and matched against
+     * the ranges owned by this shard in key order, so that they are checked in a single pass.
+     */
+    std::vector<bool> keysBelongToMe(const std::vector<BSONObj>& keys) const;
 
     /**
      * Given a key 'lookupKey' in the shard key range, get the next chunk which overlaps or is
@@ -246,9 +251,25 @@ public:
     }
 
 private:
+    // Ranges of the shard key space owned by this shard, as [min, max) KeyString intervals sorted
+    // by min key, with the intervals of adjacent chunks coalesced.
+    struct OwnedKeyStringRanges {
+        std::once_flag built;
+        std::vector<std::pair<std::string, std::string>> ranges;
+    };
+
+    /**
+     * Returns the ranges owned by this shard, building them on the first call.
+     */
+    const std::vector<std::pair<std::string, std::string>>& _getOwnedKeyStringRanges() const;
+
     // The full routing table for the collection or boost::none if the collection is not sharded
     boost::optional<ChunkManager> _cm;
 
+    // Built from '_cm' on the first ownership check and shared between the copies of this object,
+    // so that keys are checked without looking up the chunk and its history.
+    std::shared_ptr<OwnedKeyStringRanges> _ownedRanges;
+
     // The identity of this shard, for the purpose of answering "key belongs to me" queries. If the
     // collection is not sharded (_cm is boost::none), then this value will be empty.
     ShardId _thisShardId;
@@ -384,6 +384,25 @@ TEST_F(ThreeChunkWithRangeGapFixture, KeyBelongsToMe) {
     ASSERT(!makeCollectionMetadata().keyBelongsToMe(BSONObj()));
 }
 
+TEST_F(ThreeChunkWithRangeGapFixture, KeysBelongToMe) {
+    const std::vector<BSONObj> keys{BSON("a" << 40),
+                                    BSON("a" << 20),
+                                    BSONObj(),
+                                    BSON("a" << 5),
+                                    BSON("a" << MAXKEY),
+                                    BSON("a" << 10),
+                                    BSON("a" << 25),
+                                    BSON("a" << 30),
+                                    BSON("a" << 5)};
+
+    auto metadata(makeCollectionMetadata());
+    const auto belongs = metadata.keysBelongToMe(keys);
+    ASSERT_EQ(keys.size(), belongs.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(metadata.keyBelongsToMe(keys[i]), belongs[i]) << keys[i];
+    }
+}
+
 TEST_F(ThreeChunkWithRangeGapFixture, GetNextChunkFromBeginning) {
     ChunkType nextChunk;
     ASSERT(makeCollectionMetadata().getNextChunk(makeCollectionMetadata().getMinKey(), &nextChunk));
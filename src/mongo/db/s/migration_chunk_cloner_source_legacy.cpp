@@ -33,6 +33,8 @@
 
 #include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
 
+#include <algorithm>
+
 #include "mongo/base/status.h"
 #include "mongo/client/read_preference.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -662,16 +664,32 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
     stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
-
-    for (; iter != _cloneLocs.end(); ++iter) {
+    while (true) {
         // We must always make progress in this method by at least one document because empty
         // return indicates there is no more initial clone data.
         if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
             break;
         }
 
-        auto nextRecordId = *iter;
+        // Mark the record id as being read before releasing the mutex, so that concurrent
+        // _migrateClone requests from the recipient never return the same document twice. There
+        // are at most as many of them as there are concurrent requests.
+        auto iter = std::find_if(_cloneLocs.begin(), _cloneLocs.end(), [&](const RecordId& id) {
+            return !_cloneLocsBeingRead.count(id);
+        });
+        if (iter == _cloneLocs.end()) {
+            break;
+        }
+        const auto nextRecordId = *iter;
+        _cloneLocsBeingRead.insert(nextRecordId);
+
+        // If the read fails, the record id is left in '_cloneLocs' for a later request.
+        auto beingReadGuard = makeGuard([&] {
+            if (!lk.owns_lock()) {
+                lk.lock();
+            }
+            _cloneLocsBeingRead.erase(nextRecordId);
+        });
 
         lk.unlock();
 
@@ -681,7 +699,7 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
             // that we take into consideration the overhead of BSONArray indices.
             if (arrBuilder->arrSize() &&
                 (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
-
+                // Leave the document for the next batch.
                 break;
             }
 
@@ -690,9 +708,8 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
         }
 
         lk.lock();
+        _cloneLocs.erase(nextRecordId);
     }
-
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
 }
 
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
@@ -713,6 +730,8 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
     // attempt to move it, scan the collection directly.
     if (_jumboChunkCloneState && _forceJumbo) {
         try {
+            // The index scan is shared by all _migrateClone requests, so they take turns.
+            stdx::lock_guard<Latch> lk(_indexScanCloneMutex);
             _nextCloneBatchFromIndexScan(opCtx, collection, arrBuilder);
             return Status::OK();
         } catch (const DBException& ex) {
@@ -45,6 +45,7 @@
 #include "mongo/s/request_types/move_chunk_request.h"
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/net/hostandport.h"
 
 namespace mongo {
@@ -342,6 +343,11 @@ private:
 
     std::unique_ptr<SessionCatalogMigrationSource> _sessionCatalogSource;
 
+    // Serializes the batches cloned through the index scan of a jumbo chunk. Must be acquired
+    // before '_mutex'.
+    Mutex _indexScanCloneMutex =
+        MONGO_MAKE_LATCH("MigrationChunkClonerSourceLegacy::_indexScanCloneMutex");
+
     // Protects the entries below
     Mutex _mutex = MONGO_MAKE_LATCH("MigrationChunkClonerSourceLegacy::_mutex");
 
@@ -351,6 +357,10 @@ private:
     // List of record ids that needs to be transferred (initial clone)
     std::set<RecordId> _cloneLocs;
 
+    // The record ids of '_cloneLocs' being read by a _migrateClone request. Other concurrent
+    // requests skip them, and they are only erased from '_cloneLocs' once they have been read.
+    stdx::unordered_set<RecordId, RecordId::Hasher> _cloneLocsBeingRead;
+
     // The estimated average object size during the clone phase. Used for buffer size
     // pre-allocation (initial clone).
     uint64_t _averageObjectSizeForCloneLocs{0};
@@ -269,6 +269,156 @@ MONGO_FAIL_POINT_DEFINE(migrateThreadHangAtStep6);
 MONGO_FAIL_POINT_DEFINE(failMigrationOnRecipient);
 MONGO_FAIL_POINT_DEFINE(failMigrationReceivedOutOfRangeOperation);
 
+/**
+ * Runs one stream of the initial clone: a fetcher on the calling thread hands the batches it gets
+ * from the donor to an inserter thread. Returns the last optime written by the inserter.
+ */
+repl::OpTime cloneDocumentsStream(
+    OperationContext* opCtx,
+    const std::function<void(OperationContext*, BSONObj)>& insertBatchFn,
+    const std::function<BSONObj(OperationContext*)>& fetchBatchFn) {
+    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = 1;
+
+    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    repl::OpTime lastOpApplied;
+
+    stdx::thread inserterThread{[&] {
+        Client::initThread("chunkInserter", opCtx->getServiceContext(), nullptr);
+        auto client = Client::getCurrent();
+        {
+            stdx::lock_guard lk(*client);
+            client->setSystemOperationKillableByStepdown(lk);
+        }
+
+        auto inserterOpCtx = client->makeOperationContext();
+        auto consumerGuard = makeGuard([&] {
+            batches.closeConsumerEnd();
+            lastOpApplied = repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
+        });
+
+        try {
+            while (true) {
+                auto nextBatch = batches.pop(inserterOpCtx.get());
+                auto arr = nextBatch["objects"].Obj();
+                if (arr.isEmpty()) {
+                    return;
+                }
+                insertBatchFn(inserterOpCtx.get(), arr);
+            }
+        } catch (...) {
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
+            LOGV2(21999,
+                  "Batch insertion failed: {error}",
+                  "Batch insertion failed",
+                  "error"_attr = redact(exceptionToStatus()));
+        }
+    }};
+
+
+    {
+        auto inserterThreadJoinGuard = makeGuard([&] {
+            batches.closeProducerEnd();
+            inserterThread.join();
+        });
+
+        while (true) {
+            auto res = fetchBatchFn(opCtx);
+            try {
+                batches.push(res.getOwned(), opCtx);
+                auto arr = res["objects"].Obj();
+                if (arr.isEmpty()) {
+                    break;
+                }
+            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+                break;
+            }
+        }
+    }  // This scope ensures that the guard is destroyed
+
+    // This check is necessary because the consumer thread uses killOp to propagate errors to the
+    // producer thread (this thread)
+    opCtx->checkForInterrupt();
+    return lastOpApplied;
+}
+
+/**
+ * The state shared by the streams of a concurrent clone, all of it guarded by one mutex.
+ */
+class ConcurrentCloneState {
+public:
+    explicit ConcurrentCloneState(OperationContext* opCtx) : _opCtx(opCtx) {}
+
+    /**
+     * Registers the OperationContext of a stream, so that it's interrupted if another stream
+     * fails. Returns false if the clone has already failed, in which case the stream shouldn't
+     * start.
+     */
+    bool addStream(OperationContext* streamOpCtx) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_status.isOK()) {
+            return false;
+        }
+        _streamOpCtxs.push_back(streamOpCtx);
+        return true;
+    }
+
+    void removeStream(OperationContext* streamOpCtx) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _streamOpCtxs.erase(std::find(_streamOpCtxs.begin(), _streamOpCtxs.end(), streamOpCtx));
+    }
+
+    void addLastOpApplied(const repl::OpTime& lastOpApplied) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _lastOpApplied = std::max(_lastOpApplied, lastOpApplied);
+    }
+
+    /**
+     * Records the error of a stream, unless another stream failed first, and interrupts all the
+     * streams rather than letting them clone to completion.
+     */
+    void setFailed(Status status) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_status.isOK()) {
+            return;
+        }
+        _status = std::move(status);
+
+        auto interrupt = [](OperationContext* opCtx) {
+            stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+            opCtx->getServiceContext()->killOperation(
+                clientLock, opCtx, ErrorCodes::Error(5843229));
+        };
+        interrupt(_opCtx);
+        for (auto streamOpCtx : _streamOpCtxs) {
+            interrupt(streamOpCtx);
+        }
+    }
+
+    /**
+     * Returns the last optime written by the streams, or throws the error of the first stream
+     * which failed, rather than the interruptions it caused in the others.
+     */
+    repl::OpTime getLastOpApplied() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        uassertStatusOK(_status);
+        return _lastOpApplied;
+    }
+
+private:
+    // The OperationContext of the thread which started the clone, which runs one of the streams.
+    OperationContext* const _opCtx;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ConcurrentCloneState::_mutex");
+
+    // The OperationContexts of the other streams which are running.
+    std::vector<OperationContext*> _streamOpCtxs;
+
+    Status _status = Status::OK();
+    repl::OpTime _lastOpApplied;
+};
+
 }  // namespace
 
 MigrationDestinationManager::MigrationDestinationManager() = default;
@@ -445,72 +595,53 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    std::function<BSONObj(OperationContext*)> fetchBatchFn) {
-
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
-
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
-    repl::OpTime lastOpApplied;
-
-    stdx::thread inserterThread{[&] {
-        Client::initThread("chunkInserter", opCtx->getServiceContext(), nullptr);
-        auto client = Client::getCurrent();
-        {
-            stdx::lock_guard lk(*client);
-            client->setSystemOperationKillableByStepdown(lk);
-        }
-
-        auto inserterOpCtx = client->makeOperationContext();
-        auto consumerGuard = makeGuard([&] {
-            batches.closeConsumerEnd();
-            lastOpApplied = repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
-        });
+    std::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int numStreams) {
+    if (numStreams <= 1) {
+        return cloneDocumentsStream(opCtx, insertBatchFn, fetchBatchFn);
+    }
 
-        try {
-            while (true) {
-                auto nextBatch = batches.pop(inserterOpCtx.get());
-                auto arr = nextBatch["objects"].Obj();
-                if (arr.isEmpty()) {
-                    return;
-                }
-                insertBatchFn(inserterOpCtx.get(), arr);
+    // Every stream asks the donor for batches independently; the donor hands each request record
+    // ids which no other request has taken, and every stream stops once it gets an empty batch.
+    ConcurrentCloneState state(opCtx);
+
+    std::vector<stdx::thread> streams;
+    for (int i = 1; i < numStreams; ++i) {
+        streams.emplace_back([&, i] {
+            Client::initThread(
+                "chunkCloner-" + std::to_string(i), opCtx->getServiceContext(), nullptr);
+            auto client = Client::getCurrent();
+            {
+                stdx::lock_guard lk(*client);
+                client->setSystemOperationKillableByStepdown(lk);
             }
-        } catch (...) {
-            stdx::lock_guard<Client> lk(*opCtx->getClient());
-            opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
-            LOGV2(21999,
-                  "Batch insertion failed: {error}",
-                  "Batch insertion failed",
-                  "error"_attr = redact(exceptionToStatus()));
-        }
-    }};
-
 
-    {
-        auto inserterThreadJoinGuard = makeGuard([&] {
-            batches.closeProducerEnd();
-            inserterThread.join();
-        });
+            auto streamOpCtx = client->makeOperationContext();
+            if (!state.addStream(streamOpCtx.get())) {
+                return;
+            }
+            ON_BLOCK_EXIT([&] { state.removeStream(streamOpCtx.get()); });
 
-        while (true) {
-            auto res = fetchBatchFn(opCtx);
             try {
-                batches.push(res.getOwned(), opCtx);
-                auto arr = res["objects"].Obj();
-                if (arr.isEmpty()) {
-                    break;
-                }
-            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
-                break;
+                state.addLastOpApplied(
+                    cloneDocumentsStream(streamOpCtx.get(), insertBatchFn, fetchBatchFn));
+            } catch (const DBException& ex) {
+                state.setFailed(ex.toStatus());
             }
-        }
-    }  // This scope ensures that the guard is destroyed
+        });
+    }
 
-    // This check is necessary because the consumer thread uses killOp to propagate errors to the
-    // producer thread (this thread)
-    opCtx->checkForInterrupt();
-    return lastOpApplied;
+    try {
+        state.addLastOpApplied(cloneDocumentsStream(opCtx, insertBatchFn, fetchBatchFn));
+    } catch (const DBException& ex) {
+        state.setFailed(ex.toStatus());
+    }
+
+    for (auto& stream : streams) {
+        stream.join();
+    }
+
+    return state.getLastOpApplied();
 }
 
 Status MigrationDestinationManager::abort(const MigrationSessionId& sessionId) {
@@ -1041,6 +1172,9 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
             uassert(50748, "Migration aborted while copying documents", getState() != ABORT);
         };
 
+        auto outerSessionMutex =
+            MONGO_MAKE_LATCH("MigrationDestinationManager::_migrateDriver::outerSession");
+
         auto insertBatchFn = [&](OperationContext* opCtx, BSONObj arr) {
             auto it = arr.begin();
             while (it != arr.end()) {
@@ -1082,6 +1216,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
                     _clonedBytes += batchClonedBytes;
                 }
                 if (_writeConcern.needToWaitForOtherNodes()) {
+                    // The session of 'outerOpCtx' may only be checked in by one stream at a time.
+                    stdx::lock_guard<Latch> sessionLock(outerSessionMutex);
                     runWithoutSession(outerOpCtx, [&] {
                         repl::ReplicationCoordinator::StatusAndDuration replStatus =
                             repl::ReplicationCoordinator::get(opCtx)->awaitReplication(
@@ -1120,7 +1256,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        lastOpApplied = cloneDocumentsFromDonor(
+            opCtx, insertBatchFn, fetchBatchFn, migrateCloneConcurrency.load());
 
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
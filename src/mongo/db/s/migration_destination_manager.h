@@ -114,12 +114,15 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard, using 'numStreams' concurrent pairs of fetcher and
+     * inserter threads. Each stream calls 'fetchBatchFn' and 'insertBatchFn' until it fetches an
+     * empty batch, so both must be safe to call concurrently when 'numStreams' is greater than 1.
      */
     static repl::OpTime cloneDocumentsFromDonor(
         OperationContext* opCtx,
         std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        std::function<BSONObj(OperationContext*)> fetchBatchFn);
+        std::function<BSONObj(OperationContext*)> fetchBatchFn,
+        int numStreams = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
@@ -157,6 +157,72 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsCatchesInsertErrors) {
     ASSERT_EQ(operationContext()->getKillStatus(), 51008);
 }
 
+// Tests that concurrent clone streams insert each fetched batch exactly once.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithConcurrentStreams) {
+    const int kNumBatches = 20;
+    auto mutex = MONGO_MAKE_LATCH();
+    int batchesFetched = 0;
+    std::vector<int> insertedValues;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+        stdx::lock_guard<Latch> lk(mutex);
+        if (batchesFetched == kNumBatches) {
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        } else {
+            fetchBatchResultBuilder.append("objects", BSON_ARRAY(createDocument(batchesFetched)));
+            ++batchesFetched;
+        }
+        return fetchBatchResultBuilder.obj();
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        stdx::lock_guard<Latch> lk(mutex);
+        for (auto&& docToClone : docs) {
+            insertedValues.push_back(docToClone.Obj()["X"].numberInt());
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 4);
+
+    std::sort(insertedValues.begin(), insertedValues.end());
+    ASSERT_EQ(kNumBatches, insertedValues.size());
+    for (int i = 0; i < kNumBatches; ++i) {
+        ASSERT_EQ(i, insertedValues[i]);
+    }
+}
+
+// Tests that an exception in the fetch logic of any clone stream is thrown on the main thread.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsWithConcurrentStreamsThrowsFetchErrors) {
+    auto mutex = MONGO_MAKE_LATCH();
+    int batchesFetched = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            if (++batchesFetched > 2) {
+                uasserted(ErrorCodes::NetworkTimeout, "network error");
+            }
+        }
+
+        BSONObjBuilder fetchBatchResultBuilder;
+        fetchBatchResultBuilder.append("objects", createDocumentsToCloneArray());
+        return fetchBatchResultBuilder.obj();
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {};
+
+    ASSERT_THROWS_CODE_AND_WHAT(MigrationDestinationManager::cloneDocumentsFromDonor(
+                                    operationContext(), insertBatchFn, fetchBatchFn, 3),
+                                DBException,
+                                ErrorCodes::NetworkTimeout,
+                                "network error");
+
+    // The failure of a stream interrupts the others.
+    ASSERT_EQ(operationContext()->getKillStatus(), 5843229);
+}
+
 using MigrationDestinationManagerNetworkTest = CatalogCacheTestFixture;
 
 // Verifies MigrationDestinationManager::getCollectionOptions() and
@@ -43,7 +43,6 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/dbhelpers.h"
-#include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keypattern.h"
@@ -54,9 +53,11 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/wait_for_majority_service.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/remove_saver.h"
@@ -171,70 +172,94 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                             "namespace"_attr = nss.ns());
     }
 
-    auto deleteStageParams = std::make_unique<DeleteStageParams>();
-    deleteStageParams->fromMigrate = true;
-    deleteStageParams->isMulti = true;
-    deleteStageParams->returnDeleted = true;
-
+    std::unique_ptr<RemoveSaver> removeSaver;
     if (serverGlobalParams.moveParanoia) {
-        deleteStageParams->removeSaver =
-            std::make_unique<RemoveSaver>("moveChunk", nss.ns(), "cleaning");
+        removeSaver = std::make_unique<RemoveSaver>("moveChunk", nss.ns(), "cleaning");
     }
 
-    auto exec = InternalPlanner::deleteWithIndexScan(opCtx,
-                                                     &collection,
-                                                     std::move(deleteStageParams),
-                                                     descriptor,
-                                                     min,
-                                                     max,
-                                                     BoundInclusion::kIncludeStartKeyOnly,
-                                                     PlanYieldPolicy::YieldPolicy::YIELD_MANUAL,
-                                                     InternalPlanner::FORWARD);
+    auto exec = InternalPlanner::indexScan(opCtx,
+                                           &collection,
+                                           descriptor,
+                                           min,
+                                           max,
+                                           BoundInclusion::kIncludeStartKeyOnly,
+                                           PlanYieldPolicy::YieldPolicy::YIELD_MANUAL,
+                                           InternalPlanner::FORWARD);
 
     if (MONGO_unlikely(hangBeforeDoingDeletion.shouldFail())) {
         LOGV2(23768, "Hit hangBeforeDoingDeletion failpoint");
         hangBeforeDoingDeletion.pauseWhileSet(opCtx);
     }
 
+    // Delete the documents in shard key order, grouping the deletes of several documents and of
+    // their index keys into each WriteUnitOfWork.
+    const int docsPerWriteUnitOfWork = rangeDeleterDocsPerWriteUnitOfWork.load();
     int numDeleted = 0;
-    do {
-        BSONObj deletedObj;
+    bool isEOF = false;
+    std::vector<RecordId> recordIds;
+    while (!isEOF && numDeleted < numDocsToRemovePerBatch) {
+        recordIds.clear();
+        while (recordIds.size() < static_cast<size_t>(docsPerWriteUnitOfWork) &&
+               numDeleted + static_cast<int>(recordIds.size()) < numDocsToRemovePerBatch) {
+            if (throwWriteConflictExceptionInDeleteRange.shouldFail()) {
+                throw WriteConflictException();
+            }
 
-        if (throwWriteConflictExceptionInDeleteRange.shouldFail()) {
-            throw WriteConflictException();
-        }
+            if (throwInternalErrorInDeleteRange.shouldFail()) {
+                uasserted(ErrorCodes::InternalError, "Failing for test");
+            }
 
-        if (throwInternalErrorInDeleteRange.shouldFail()) {
-            uasserted(ErrorCodes::InternalError, "Failing for test");
-        }
+            RecordId recordId;
+            PlanExecutor::ExecState state;
+            try {
+                state = exec->getNext(nullptr, &recordId);
+            } catch (const DBException& ex) {
+                auto&& explainer = exec->getPlanExplainer();
+                auto&& [stats, _] =
+                    explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
+                LOGV2_WARNING(23776,
+                              "Cursor error while trying to delete {min} to {max} in {namespace}, "
+                              "stats: {stats}, error: {error}",
+                              "Cursor error while trying to delete range",
+                              "min"_attr = redact(min),
+                              "max"_attr = redact(max),
+                              "namespace"_attr = nss,
+                              "stats"_attr = redact(stats),
+                              "error"_attr = redact(ex.toStatus()));
+                throw;
+            }
+
+            if (state == PlanExecutor::IS_EOF) {
+                isEOF = true;
+                break;
+            }
 
-        PlanExecutor::ExecState state;
-        try {
-            state = exec->getNext(&deletedObj, nullptr);
-        } catch (const DBException& ex) {
-            auto&& explainer = exec->getPlanExplainer();
-            auto&& [stats, _] =
-                explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
-            LOGV2_WARNING(23776,
-                          "Cursor error while trying to delete {min} to {max} in {namespace}, "
-                          "stats: {stats}, error: {error}",
-                          "Cursor error while trying to delete range",
-                          "min"_attr = redact(min),
-                          "max"_attr = redact(max),
-                          "namespace"_attr = nss,
-                          "stats"_attr = redact(stats),
-                          "error"_attr = redact(ex.toStatus()));
-            throw;
+            invariant(PlanExecutor::ADVANCED == state);
+            recordIds.push_back(std::move(recordId));
         }
 
-        if (state == PlanExecutor::IS_EOF) {
+        if (recordIds.empty()) {
             break;
         }
 
-        invariant(PlanExecutor::ADVANCED == state);
-        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
+        exec->saveState();
+        {
+            WriteUnitOfWork wuow(opCtx);
+            for (const auto& recordId : recordIds) {
+                if (removeSaver) {
+                    uassertStatusOK(
+                        removeSaver->goingToDelete(collection->docFor(opCtx, recordId).value()));
+                }
+                collection->deleteDocument(
+                    opCtx, kUninitializedStmtId, recordId, nullptr, true /* fromMigrate */);
+            }
+            wuow.commit();
+        }
+        exec->restoreState(&collection);
 
-    } while (++numDeleted < numDocsToRemovePerBatch);
+        numDeleted += recordIds.size();
+        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(recordIds.size());
+    }
 
     return numDeleted;
 }
@@ -288,6 +313,45 @@ void ensureRangeDeletionTaskStillExists(OperationContext* opCtx, const UUID& mig
     // holding any locks.
 }
 
+/**
+ * Computes the delay before each batch of a range deletion. On top of the configured delay between
+ * batches, while the majority commit point trails this node's last applied write by more than
+ * 'rangeDeleterMaxReplicationLagMS', waits for up to the excess lag so that the secondaries can
+ * catch up with the deletes.
+ */
+class RangeDeletionPacing {
+public:
+    explicit RangeDeletionPacing(Milliseconds delayBetweenBatches)
+        : _delayBetweenBatches(delayBetweenBatches) {}
+
+    Milliseconds nextSleep() {
+        const Milliseconds maxReplicationLag{rangeDeleterMaxReplicationLagMS.load()};
+        if (maxReplicationLag <= Milliseconds(0)) {
+            return _delayBetweenBatches;
+        }
+
+        auto replCoord = repl::ReplicationCoordinator::get(getGlobalServiceContext());
+        const auto lastCommittedWallTime = replCoord->getLastCommittedOpTimeAndWallTime().wallTime;
+        if (!replCoord->isReplEnabled() || lastCommittedWallTime == Date_t()) {
+            return _delayBetweenBatches;
+        }
+
+        const auto replicationLag =
+            replCoord->getMyLastAppliedOpTimeAndWallTime().wallTime - lastCommittedWallTime;
+        if (replicationLag <= maxReplicationLag) {
+            return _delayBetweenBatches;
+        }
+        return _delayBetweenBatches +
+            std::min(replicationLag - maxReplicationLag, kMaxReplicationLagDelay);
+    }
+
+private:
+    // The longest that a single batch is held back because of replication lag.
+    static constexpr Milliseconds kMaxReplicationLagDelay{1000};
+
+    Milliseconds _delayBetweenBatches;
+};
+
 /**
  * Delete the range in a sequence of batches until there are no more documents to
  * delete or deletion returns an error.
@@ -347,7 +411,7 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                 ErrorCodes::isShutdownError(swNumDeleted.getStatus()) ||
                 ErrorCodes::isNotPrimaryError(swNumDeleted.getStatus());
         })
-        .withDelayBetweenIterations(delayBetweenBatches)
+        .withBackoffBetweenIterations(RangeDeletionPacing(delayBetweenBatches))
         .on(executor)
         .ignoreValue();
 }
@@ -42,6 +42,7 @@
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -191,6 +192,39 @@ TEST_F(RangeDeleterTest,
     ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
 }
 
+TEST_F(RangeDeleterTest,
+       RemoveDocumentsInRangeRemovesAllDocumentsInRangeAcrossSeveralWriteUnitsOfWork) {
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    const int numDocsToRemovePerBatch = 3;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    rangeDeleterDocsPerWriteUnitOfWork.store(2);
+    ON_BLOCK_EXIT([] { rangeDeleterDocsPerWriteUnitOfWork.store(16); });
+
+    // Insert documents in range, and one after the end of the range.
+    setFilteringMetadataWithUUID(uuid());
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i <= 10; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               boost::none,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete*/,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 1);
+    ASSERT_EQUALS(dbclient.count(kNss, BSON(kShardKey << 10)), 1);
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeInsertsDocumentToNotifySecondariesOfRangeDeletion) {
     const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
     const int numDocsToRemovePerBatch = 10;
@@ -269,16 +269,21 @@ ExecutorFuture<void> ReshardingCollectionCloner::_insertBatchesUntilPipelineExha
     ServiceContext* serviceContext,
     std::shared_ptr<executor::TaskExecutor> executor,
     std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
+    // Fetching and inserting several batches with the same OperationContext avoids paying for a
+    // fresh OperationContext and a trip through the task executor on every batch, which dominates
+    // the cost of cloning a large collection in small batches.
     bool moreToCome = _withTemporaryOperationContext(serviceContext, [&](auto* opCtx) {
-        pipeline->reattachToOperationContext(opCtx);
-        auto batch = _fillBatch(*pipeline);
-        pipeline->detachFromOperationContext();
+        for (int i = 0; i < resharding::gReshardingCollectionClonerBatchesPerOperation; ++i) {
+            pipeline->reattachToOperationContext(opCtx);
+            auto batch = _fillBatch(*pipeline);
+            pipeline->detachFromOperationContext();
 
-        if (batch.empty()) {
-            return false;
-        }
+            if (batch.empty()) {
+                return false;
+            }
 
-        _insertBatch(opCtx, batch);
+            _insertBatch(opCtx, batch);
+        }
         return true;
     });
 
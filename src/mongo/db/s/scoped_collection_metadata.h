@@ -117,6 +117,10 @@ public:
     bool keyBelongsToMe(const BSONObj& key) const {
         return _impl->get().keyBelongsToMe(key);
     }
+
+    std::vector<bool> keysBelongToMe(const std::vector<BSONObj>& keys) const {
+        return _impl->get().keysBelongToMe(keys);
+    }
 };
 
 }  // namespace mongo
@@ -45,6 +45,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/logv2/log.h"
+#include "mongo/s/shard_key_pattern.h"
 
 namespace mongo {
 namespace {
@@ -52,6 +53,11 @@ namespace {
 const int kMaxObjectPerChunk{250000};
 const int estimatedAdditionalBytesPerItemInBSONArray{2};
 
+// The fewest sampled keys which must fall in a chunk for sampleSplitPoints() to estimate its size,
+// and the fewest that each of the resulting chunks must be estimated from.
+const long long kMinSampledKeysInChunk{100};
+const long long kMinSampledKeysPerSplitChunk{10};
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
@@ -349,4 +355,106 @@ std::vector<BSONObj> splitVector(OperationContext* opCtx,
     return splitKeys;
 }
 
+boost::optional<std::vector<BSONObj>> sampleSplitPoints(OperationContext* opCtx,
+                                                        const NamespaceString& nss,
+                                                        const BSONObj& keyPattern,
+                                                        const BSONObj& min,
+                                                        const BSONObj& max,
+                                                        long long maxChunkSizeBytes,
+                                                        long long numSamples) {
+    invariant(maxChunkSizeBytes > 0);
+    invariant(numSamples > 0);
+
+    AutoGetCollection collection(opCtx, nss, MODE_IS);
+    uassert(ErrorCodes::NamespaceNotFound, "ns not found", collection);
+
+    // If there's not enough data for more than one chunk, no point continuing.
+    const long long recCount = collection->numRecords(opCtx);
+    const long long dataSize = collection->dataSize(opCtx);
+    if (dataSize < maxChunkSizeBytes || recCount == 0) {
+        return std::vector<BSONObj>{};
+    }
+
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return boost::none;
+    }
+
+    const ShardKeyPattern shardKeyPattern(keyPattern);
+    auto isInChunk = [&](const BSONObj& key) {
+        return key.woCompare(min) >= 0 && (max.isEmpty() || key.woCompare(max) < 0);
+    };
+
+    std::vector<BSONObj> sampledKeys;
+    long long numSampled = 0;
+    for (; numSampled < numSamples; ++numSampled) {
+        if (numSampled % 128 == 0) {
+            opCtx->checkForInterrupt();
+        }
+
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+
+        auto key = shardKeyPattern.extractShardKeyFromDoc(record->data.toBson());
+        if (!key.isEmpty() && isInChunk(key)) {
+            sampledKeys.push_back(std::move(key));
+        }
+    }
+
+    const long long numSampledInChunk = sampledKeys.size();
+    if (numSampledInChunk < kMinSampledKeysInChunk) {
+        return boost::none;
+    }
+
+    // The fraction of the sampled documents which fall in the chunk estimates the fraction of the
+    // collection's data which the chunk holds.
+    const long long estimatedChunkSizeBytes =
+        static_cast<long long>(static_cast<double>(dataSize) * numSampledInChunk / numSampled);
+    if (estimatedChunkSizeBytes < maxChunkSizeBytes) {
+        return std::vector<BSONObj>{};
+    }
+
+    const long long numChunks =
+        std::min(estimatedChunkSizeBytes / std::max(maxChunkSizeBytes / 2, 1LL),
+                 numSampledInChunk / kMinSampledKeysPerSplitChunk);
+
+    // Use evenly spaced quantiles of the sampled keys as split points. The invariant here is that
+    // all the instances of a given key value live in the same chunk, so a key which repeats the
+    // previous split point, or the chunk's lower bound, is omitted.
+    std::sort(sampledKeys.begin(),
+              sampledKeys.end(),
+              SimpleBSONObjComparator::kInstance.makeLessThan());
+
+    std::vector<BSONObj> splitKeys;
+    for (long long i = 1; i < numChunks; ++i) {
+        const auto& key = sampledKeys[i * numSampledInChunk / numChunks];
+        if (key.woCompare(min) == 0 ||
+            (!splitKeys.empty() && key.woCompare(splitKeys.back()) == 0)) {
+            continue;
+        }
+        splitKeys.push_back(key);
+    }
+
+    if (splitKeys.empty()) {
+        // The sampled keys are dominated by a single value. Leave it to splitVector to look for a
+        // split point around it, and to warn about the low cardinality key.
+        return boost::none;
+    }
+
+    LOGV2_DEBUG(5843225,
+                1,
+                "Estimated split points for chunk from a sample of the collection",
+                "namespace"_attr = nss.toString(),
+                "minKey"_attr = redact(min),
+                "maxKey"_attr = redact(max),
+                "numSampled"_attr = numSampled,
+                "numSampledInChunk"_attr = numSampledInChunk,
+                "estimatedChunkSizeBytes"_attr = estimatedChunkSizeBytes,
+                "numSplits"_attr = splitKeys.size());
+
+    return splitKeys;
+}
+
 }  // namespace mongo
@@ -66,4 +66,23 @@ std::vector<BSONObj> splitVector(OperationContext* opCtx,
                                  boost::optional<long long> maxChunkObjects,
                                  boost::optional<long long> maxChunkSizeBytes);
 
+/**
+ * Estimates the split points of the chunk [min, max) from the shard key values of up to
+ * 'numSamples' documents read at random from the collection, which bounds the I/O regardless of
+ * the size of the chunk. Like splitVector, aims for chunks of about half of 'maxChunkSizeBytes',
+ * and returns no split points if the collection is too small to need splitting or the chunk is
+ * estimated to be smaller than 'maxChunkSizeBytes'.
+ *
+ * Returns boost::none if the estimate can't be trusted, because the storage engine doesn't
+ * support random cursors, too few of the samples fall in the chunk, or the samples are dominated
+ * by a single shard key value. Callers should fall back to splitVector in that case.
+ */
+boost::optional<std::vector<BSONObj>> sampleSplitPoints(OperationContext* opCtx,
+                                                        const NamespaceString& nss,
+                                                        const BSONObj& keyPattern,
+                                                        const BSONObj& min,
+                                                        const BSONObj& max,
+                                                        long long maxChunkSizeBytes,
+                                                        long long numSamples);
+
 }  // namespace mongo
@@ -286,6 +286,29 @@ TEST_F(SplitVectorTest, NoMaxChunkSize) {
                        ErrorCodes::InvalidOptions);
 }
 
+TEST_F(SplitVectorTest, SampleSplitPointsNotNeededForSmallCollection) {
+    auto splitKeys = sampleSplitPoints(operationContext(),
+                                       kNss,
+                                       BSON(kPattern << 1),
+                                       BSON(kPattern << 0),
+                                       BSON(kPattern << 100),
+                                       getDocSizeBytes() * 200LL,
+                                       1000);
+    ASSERT(splitKeys);
+    ASSERT(splitKeys->empty());
+}
+
+TEST_F(SplitVectorTest, SampleSplitPointsFallsBackWithoutRandomCursor) {
+    // The storage engine used by the fixture doesn't support random cursors.
+    ASSERT_FALSE(sampleSplitPoints(operationContext(),
+                                   kNss,
+                                   BSON(kPattern << 1),
+                                   BSON(kPattern << 0),
+                                   BSON(kPattern << 100),
+                                   getDocSizeBytes() * 10LL,
+                                   1000));
+}
+
 const NamespaceString kJumboNss = NamespaceString("foo", "bar2");
 const std::string kJumboPattern = "a";
 
@@ -78,6 +78,7 @@
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/transaction_coordinator_factory.h"
 #include "mongo/db/service_entry_point_common.h"
+#include "mongo/db/service_entry_point_common_gen.h"
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/stats/api_version_metrics.h"
 #include "mongo/db/stats/counters.h"
@@ -103,6 +104,8 @@
 #include "mongo/util/duration.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -130,6 +133,19 @@ namespace {
 
 using namespace fmt::literals;
 
+// The application names parsed from the 'lowPriorityAppNames' server parameter.
+Mutex lowPriorityAppNamesMutex = MONGO_MAKE_LATCH("lowPriorityAppNamesMutex");
+StringSet lowPriorityAppNames;
+AtomicWord<bool> hasLowPriorityAppNames{false};
+
+bool isLowPriorityAppName(StringData appName) {
+    if (!hasLowPriorityAppNames.load() || appName.empty()) {
+        return false;
+    }
+    stdx::lock_guard lk(lowPriorityAppNamesMutex);
+    return lowPriorityAppNames.find(appName) != lowPriorityAppNames.end();
+}
+
 /*
  * Allows for the very complex handleRequest function to be decomposed into parts.
  * It also provides the infrastructure to futurize the process of executing commands.
@@ -1319,6 +1335,12 @@ Future<void> ExecCommandDatabase::_initiateCommand() try {
     if (auto clientMetadata = ClientMetadata::get(client)) {
         auto appName = clientMetadata->getApplicationName().toString();
         apiVersionMetrics.update(appName, apiParams);
+
+        // Operations of the applications configured as a low priority workload wait for tickets
+        // with low priority, which bounds the share of the tickets they can hold together.
+        if (client->isFromUserConnection() && isLowPriorityAppName(appName)) {
+            opCtx->lockState()->setAdmissionPriority(AdmissionPriority::kLow);
+        }
     }
 
     sleepMillisAfterCommandExecutionBegins.execute([&](const BSONObj& data) {
@@ -2359,4 +2381,21 @@ Future<DbResponse> ServiceEntryPointCommon::handleRequest(
 
 ServiceEntryPointCommon::Hooks::~Hooks() = default;
 
+Status onUpdateLowPriorityAppNames(const std::string& appNames) {
+    std::vector<std::string> names;
+    str::splitStringDelim(appNames, &names, ',');
+
+    StringSet parsedNames;
+    for (auto&& name : names) {
+        if (!name.empty()) {
+            parsedNames.insert(std::move(name));
+        }
+    }
+
+    stdx::lock_guard lk(lowPriorityAppNamesMutex);
+    hasLowPriorityAppNames.store(!parsedNames.empty());
+    lowPriorityAppNames = std::move(parsedNames);
+    return Status::OK();
+}
+
 }  // namespace mongo
@@ -47,6 +47,11 @@ extern FailPoint respondWithNotPrimaryInCommandDispatch;
 // test failing during command execution.
 extern FailPoint skipCheckingForNotPrimaryInCommandDispatch;
 
+/**
+ * Parses a new value of the 'lowPriorityAppNames' server parameter.
+ */
+Status onUpdateLowPriorityAppNames(const std::string& appNames);
+
 /**
  * Helpers for writing ServiceEntryPointImpl implementations from a reusable core.
  * Implementations are ServiceEntryPointMongod and ServiceEntryPointEmbedded, which share
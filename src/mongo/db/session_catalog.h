@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <vector>
 
@@ -49,6 +50,10 @@ class ObservableSession;
 
 /**
  * Keeps track of the transaction runtime state for every active session on this instance.
+ *
+ * The sessions are partitioned into buckets by the hash of their ids, each with its own mutex, so
+ * that operations checking out different sessions rarely contend on the same mutex. No thread ever
+ * holds the mutexes of two buckets at once.
  */
 class SessionCatalog {
     SessionCatalog(const SessionCatalog&) = delete;
@@ -96,8 +101,9 @@ public:
      *
      * NOTE: Since this method runs with the session catalog mutex, the work done by 'workerFn' is
      * not allowed to block, perform I/O or acquire any lock manager locks.
-     * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks the
-     * SessionCatalog.
+     * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks each
+     * bucket of the SessionCatalog in turn, so sessions may be added to or removed from the other
+     * buckets while it runs.
      */
     using ScanSessionsCallbackFn = std::function<void(ObservableSession&)>;
     void scanSession(const LogicalSessionId& lsid, const ScanSessionsCallbackFn& workerFn);
@@ -129,22 +135,41 @@ private:
         // sessions entries from the map.
         int numWaitingToCheckOut{0};
 
-        // Signaled when the state becomes available. Uses the transaction table's mutex to protect
-        // the state transitions.
+        // Signaled when the state becomes available. Uses the mutex of the session's bucket to
+        // protect the state transitions.
         stdx::condition_variable availableCondVar;
     };
     using SessionRuntimeInfoMap = LogicalSessionIdMap<std::unique_ptr<SessionRuntimeInfo>>;
 
+    // The number of buckets the sessions are partitioned into.
+    static constexpr size_t kNumBuckets = 32;
+
+    struct Bucket {
+        // Protects the state below, and the state of the sessions in this bucket
+        mutable Mutex mutex =
+            MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "SessionCatalog::Bucket::mutex");
+
+        // Owns the Session objects for the current Sessions in this bucket.
+        SessionRuntimeInfoMap sessions;
+    };
+
+    /**
+     * Returns the bucket which the session 'lsid' belongs to.
+     */
+    Bucket& _getBucket(const LogicalSessionId& lsid);
+
     /**
      * Blocking method, which checks-out the session set on 'opCtx'.
      */
     ScopedCheckedOutSession _checkOutSession(OperationContext* opCtx);
 
     /**
-     * Creates or returns the session runtime info for 'lsid' from the '_sessions' map. The returned
-     * pointer is guaranteed to be linked on the map for as long as the mutex is held.
+     * Creates or returns the session runtime info for 'lsid' from the sessions map of its bucket
+     * 'bucket'. The returned pointer is guaranteed to be linked on the map for as long as the
+     * bucket's mutex is held.
      */
     SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock,
+                                                       Bucket& bucket,
                                                        OperationContext* opCtx,
                                                        const LogicalSessionId& lsid);
 
@@ -153,12 +178,7 @@ private:
      */
     void _releaseSession(SessionRuntimeInfo* sri, boost::optional<KillToken> killToken);
 
-    // Protects the state below
-    mutable Mutex _mutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "SessionCatalog::_mutex");
-
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
+    std::array<Bucket, kNumBuckets> _buckets;
 };
 
 /**
@@ -266,6 +266,38 @@ TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsMarkForReap) {
     });
 }
 
+TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsAcrossAllBuckets) {
+    // Create enough sessions for every bucket of the catalog to very likely hold some of them.
+    std::vector<LogicalSessionId> lsids;
+    for (int i = 0; i < 200; ++i) {
+        lsids.push_back(makeLogicalSessionIdForTest());
+        stdx::async(stdx::launch::async,
+                    [this, lsid = lsids.back()] {
+                        ThreadClient tc(getServiceContext());
+                        auto opCtx = makeOperationContext();
+                        opCtx->setLogicalSessionId(lsid);
+                        OperationContextSession ocs(opCtx.get());
+                    })
+            .get();
+    }
+    ASSERT_EQ(lsids.size(), catalog()->size());
+
+    // Every session is visited exactly once, and reaping them empties every bucket.
+    SessionKiller::Matcher matcherAllSessions(
+        KillAllSessionsByPatternSet{makeKillAllSessionsByPattern(_opCtx)});
+    LogicalSessionIdSet lsidsFound;
+    catalog()->scanSessions(matcherAllSessions, [&](ObservableSession& session) {
+        ASSERT(lsidsFound.insert(session.getSessionId()).second);
+        session.markForReap();
+    });
+    ASSERT_EQ(lsids.size(), lsidsFound.size());
+    for (const auto& lsid : lsids) {
+        ASSERT(lsidsFound.count(lsid));
+    }
+
+    ASSERT_EQ(0U, catalog()->size());
+}
+
 TEST_F(SessionCatalogTest, KillSessionWhenSessionIsNotCheckedOut) {
     const auto lsid = makeLogicalSessionIdForTest();
 
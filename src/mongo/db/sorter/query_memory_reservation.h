@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace mongo {
+
+/**
+ * Accounts for the memory held by one blocking query stage, such as a sort or a $group, in the
+ * memory held by the blocking stages of all queries in the process. Once that total exceeds
+ * 'internalQueryGlobalBlockingMemoryLimitBytes', the stages which are allowed to spill to disk do
+ * so, even if they are still within their own memory limits, so that many concurrent queries can't
+ * together exhaust the memory of the process.
+ *
+ * The memory is accounted for in coarse increments, so that the shared total is only updated once
+ * a stage's memory usage has changed by at least that much. Stages using less than one increment
+ * are not accounted for, and are never asked to spill early.
+ */
+class QueryMemoryReservation {
+    QueryMemoryReservation(const QueryMemoryReservation&) = delete;
+    QueryMemoryReservation& operator=(const QueryMemoryReservation&) = delete;
+
+public:
+    static constexpr size_t kIncrementBytes = 1024 * 1024;
+
+    QueryMemoryReservation() = default;
+
+    ~QueryMemoryReservation();
+
+    /**
+     * Records that the stage now holds 'bytes' of memory. Returns true if the stage holds memory
+     * and the blocking stages of all queries together hold more than the process-wide limit, in
+     * which case the stage should spill if it is able to.
+     */
+    bool update(size_t bytes);
+
+    /**
+     * Counts a spill done because the process-wide limit was exceeded, for serverStatus.
+     */
+    static void recordForcedSpill();
+
+private:
+    size_t _reservedBytes = 0;
+};
+
+}  // namespace mongo
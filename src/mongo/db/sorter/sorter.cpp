@@ -49,20 +49,24 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
-#include <snappy.h>
 #include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/sorter/sorter_spill_compression.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
+#include "mongo/util/functional.h"
 #include "mongo/util/str.h"
 #include "mongo/util/unowned_ptr.h"
 
@@ -111,6 +115,12 @@ namespace sorter {
 
 using std::shared_ptr;
 
+// Each block of a spill file is preceded by its size, which is negative if the block is compressed.
+// The size of a block compressed with zstd also has this bit set; blocks compressed with snappy, as
+// written by older versions, do not. No block is large enough to set it by itself.
+const int32_t kZstdBlockBit = 1 << 30;
+MONGO_STATIC_ASSERT(BufferMaxSize < kZstdBlockBit);
+
 // We need to use the "real" errno everywhere, not GetLastError() on Windows
 inline std::string myErrnoWithDescription() {
     int errnoCopy = errno;
@@ -176,6 +186,66 @@ private:
     std::deque<Data> _data;
 };
 
+/**
+ * A background thread on which the FileIterators read by a MergeIterator read their next block from
+ * disk while the merge consumes their current block.
+ */
+class ReadAheadThread {
+    ReadAheadThread(const ReadAheadThread&) = delete;
+    ReadAheadThread& operator=(const ReadAheadThread&) = delete;
+
+public:
+    ReadAheadThread() : _thread([this] { _run(); }) {}
+
+    /**
+     * Runs the tasks which are still scheduled before joining the thread.
+     */
+    ~ReadAheadThread() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _shutdown = true;
+        }
+        _cv.notify_one();
+        _thread.join();
+    }
+
+    /**
+     * Schedules 'task', which must not throw, to run on the background thread.
+     */
+    void schedule(unique_function<void()> task) {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _tasks.push_back(std::move(task));
+        }
+        _cv.notify_one();
+    }
+
+private:
+    void _run() {
+        while (true) {
+            unique_function<void()> task;
+            {
+                stdx::unique_lock<Latch> lk(_mutex);
+                _cv.wait(lk, [&] { return _shutdown || !_tasks.empty(); });
+                if (_tasks.empty()) {
+                    return;
+                }
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ReadAheadThread::_mutex");
+    stdx::condition_variable _cv;
+    std::deque<unique_function<void()>> _tasks;
+    bool _shutdown = false;
+
+    // Declared last, so that the thread starts once the other members are initialized.
+    stdx::thread _thread;
+};
+
 /**
  * Returns results from a sorted range within a file. Each instance is given a file name and start
  * and end offsets.
@@ -209,6 +279,10 @@ public:
                 boost::filesystem::file_size(_fileFullPath) != 0);
     }
 
+    ~FileIterator() {
+        _stopReadAhead();
+    }
+
     void openSource() {
         _file.open(_fileFullPath.c_str(), std::ios::in | std::ios::binary);
         uassert(16814,
@@ -224,6 +298,7 @@ public:
     }
 
     void closeSource() {
+        _stopReadAhead();
         _file.close();
         uassert(50969,
                 str::stream() << "error closing file \"" << _fileFullPath
@@ -276,7 +351,37 @@ public:
         return {_fileStartOffset, _fileEndOffset, _originalChecksum};
     }
 
+    /**
+     * Makes this iterator read each of its blocks on 'readAheadThread' while it consumes the block
+     * before, until closeSource() is called. Must be called after openSource() and before this
+     * iterator reads its first block.
+     */
+    void startReadAhead(ReadAheadThread* readAheadThread) {
+        invariant(!_bufferReader);
+        _readAheadThread = readAheadThread;
+        _scheduleReadAhead();
+    }
+
 private:
+    /**
+     * A block of data read from the file, after its decryption and decompression.
+     */
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    /**
+     * The state of a block being read in the background, shared with the task reading it.
+     */
+    struct ReadAhead {
+        Mutex mutex = MONGO_MAKE_LATCH("FileIterator::ReadAhead::mutex");
+        stdx::condition_variable cv;
+        bool ready = false;
+        Status status = Status::OK();
+        boost::optional<Block> block;
+    };
+
     /**
      * Attempts to refill the _bufferReader if it is empty. Expects _done to be false.
      */
@@ -292,24 +397,48 @@ private:
      * read, then _done is set to true and the function returns immediately.
      */
     void fillBufferFromDisk() {
-        int32_t rawSize;
-        read(&rawSize, sizeof(rawSize));
-        if (_done)
+        auto block = _readAheadThread ? _waitForReadAhead() : readBlock();
+        if (!block) {
+            _done = true;
             return;
+        }
+
+        _buffer = std::move(block->data);
+        _bufferReader.reset(new BufReader(_buffer.get(), block->size));
+
+        if (_readAheadThread) {
+            _scheduleReadAhead();
+        }
+    }
+
+    /**
+     * Reads the next block from disk, or returns boost::none if there is no more data to read.
+     * Only reads from '_file' and the immutable members of this iterator, so that it can run in
+     * the background.
+     */
+    boost::optional<Block> readBlock() {
+        int32_t rawSize;
+        if (!read(&rawSize, sizeof(rawSize)))
+            return boost::none;
 
         // negative size means compressed
         const bool compressed = rawSize < 0;
         int32_t blockSize = std::abs(rawSize);
+        auto compressor = SorterSpillCompressor::kNone;
+        if (compressed) {
+            compressor = (blockSize & kZstdBlockBit) ? SorterSpillCompressor::kZstd
+                                                     : SorterSpillCompressor::kSnappy;
+            blockSize &= ~kZstdBlockBit;
+        }
 
-        _buffer.reset(new char[blockSize]);
-        read(_buffer.get(), blockSize);
-        uassert(16816, "file too short?", !_done);
+        std::unique_ptr<char[]> buffer(new char[blockSize]);
+        uassert(16816, "file too short?", read(buffer.get(), blockSize));
 
         if (auto encryptionHooks = getEncryptionHooksIfEnabled()) {
             std::unique_ptr<char[]> out(new char[blockSize]);
             size_t outLen;
             Status status =
-                encryptionHooks->unprotectTmpData(reinterpret_cast<uint8_t*>(_buffer.get()),
+                encryptionHooks->unprotectTmpData(reinterpret_cast<uint8_t*>(buffer.get()),
                                                   blockSize,
                                                   reinterpret_cast<uint8_t*>(out.get()),
                                                   blockSize,
@@ -318,37 +447,77 @@ private:
                     str::stream() << "Failed to unprotect data: " << status.toString(),
                     status.isOK());
             blockSize = outLen;
-            _buffer.swap(out);
+            buffer.swap(out);
         }
 
         if (!compressed) {
-            _bufferReader.reset(new BufReader(_buffer.get(), blockSize));
-            return;
+            return Block{std::move(buffer), static_cast<size_t>(blockSize)};
         }
 
-        dassert(snappy::IsValidCompressedBuffer(_buffer.get(), blockSize));
-
         size_t uncompressedSize;
-        uassert(17061,
-                "couldn't get uncompressed length",
-                snappy::GetUncompressedLength(_buffer.get(), blockSize, &uncompressedSize));
-
-        std::unique_ptr<char[]> decompressionBuffer(new char[uncompressedSize]);
-        uassert(17062,
-                "decompression failed",
-                snappy::RawUncompress(_buffer.get(), blockSize, decompressionBuffer.get()));
+        auto decompressionBuffer =
+            decompressSpillBlock(compressor, buffer.get(), blockSize, &uncompressedSize);
 
         // hold on to decompressed data and throw out compressed data at block exit
-        _buffer.swap(decompressionBuffer);
-        _bufferReader.reset(new BufReader(_buffer.get(), uncompressedSize));
+        return Block{std::move(decompressionBuffer), uncompressedSize};
+    }
+
+    /**
+     * Schedules the read of the next block on the read ahead thread.
+     */
+    void _scheduleReadAhead() {
+        invariant(!_pendingReadAhead);
+        auto readAhead = std::make_shared<ReadAhead>();
+        _pendingReadAhead = readAhead;
+        _readAheadThread->schedule([this, readAhead] {
+            boost::optional<Block> block;
+            Status status = Status::OK();
+            try {
+                block = readBlock();
+            } catch (...) {
+                status = exceptionToStatus();
+            }
+
+            stdx::lock_guard<Latch> lk(readAhead->mutex);
+            readAhead->status = std::move(status);
+            readAhead->block = std::move(block);
+            readAhead->ready = true;
+            readAhead->cv.notify_one();
+        });
     }
 
     /**
-     * Attempts to read data from disk. Sets _done to true when file offset reaches _fileEndOffset.
+     * Waits for the block being read in the background and returns it, or throws the error which
+     * occurred while reading it.
+     */
+    boost::optional<Block> _waitForReadAhead() {
+        auto readAhead = std::exchange(_pendingReadAhead, nullptr);
+        invariant(readAhead);
+
+        stdx::unique_lock<Latch> lk(readAhead->mutex);
+        readAhead->cv.wait(lk, [&] { return readAhead->ready; });
+        uassertStatusOK(readAhead->status);
+        return std::move(readAhead->block);
+    }
+
+    /**
+     * Waits for the block being read in the background, if any, to be read, and discards it.
+     */
+    void _stopReadAhead() {
+        if (auto readAhead = std::exchange(_pendingReadAhead, nullptr)) {
+            stdx::unique_lock<Latch> lk(readAhead->mutex);
+            readAhead->cv.wait(lk, [&] { return readAhead->ready; });
+        }
+        _readAheadThread = nullptr;
+    }
+
+    /**
+     * Attempts to read data from disk. Returns false, without reading anything, when the file
+     * offset reaches _fileEndOffset.
      *
      * Masserts on any file errors
      */
-    void read(void* out, size_t size) {
+    bool read(void* out, size_t size) {
         invariant(_file.is_open());
 
         const std::streampos offset = _file.tellg();
@@ -359,8 +528,7 @@ private:
 
         if (offset >= _fileEndOffset) {
             invariant(offset == _fileEndOffset);
-            _done = true;
-            return;
+            return false;
         }
 
         _file.read(reinterpret_cast<char*>(out), size);
@@ -369,6 +537,7 @@ private:
                               << "\": " << myErrnoWithDescription(),
                 _file.good());
         verify(_file.gcount() == static_cast<std::streamsize>(size));
+        return true;
     }
 
     const Settings _settings;
@@ -390,6 +559,11 @@ private:
     // to disk. This is not modified, and is only used for comparison against _afterReadChecksum
     // when the FileIterator is exhausted to ensure no data corruption.
     const uint32_t _originalChecksum;
+
+    // The thread reading the blocks of this iterator in the background, if any, and the state of
+    // the block it is reading. Only the read ahead task accesses '_file' while a block is pending.
+    ReadAheadThread* _readAheadThread = nullptr;
+    std::shared_ptr<ReadAhead> _pendingReadAhead;
 };
 
 /**
@@ -412,6 +586,16 @@ public:
           _greater(comp) {
         for (size_t i = 0; i < iters.size(); i++) {
             iters[i]->openSource();
+
+            // Only the inputs spilled to disk can read ahead.
+            auto fileIter = dynamic_cast<FileIterator<Key, Value>*>(iters[i].get());
+            if (opts.readAhead && fileIter) {
+                if (!_readAheadThread) {
+                    _readAheadThread = std::make_unique<ReadAheadThread>();
+                }
+                fileIter->startReadAhead(_readAheadThread.get());
+            }
+
             if (iters[i]->more()) {
                 _heap.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
             } else {
@@ -432,9 +616,11 @@ public:
 
     ~MergeIterator() {
         // Clear the remaining Stream objects to close the file handles. Some systems will error
-        // closing the file if any file handles are still open.
+        // closing the file if any file handles are still open. Closing the inputs also stops their
+        // read ahead, so the read ahead thread can be joined afterwards.
         _current.reset();
         _heap.clear();
+        _readAheadThread.reset();
     }
 
     void openSource() {}
@@ -532,6 +718,7 @@ private:
     SortOptions _opts;
     unsigned long long _remaining;
     bool _first;
+    std::unique_ptr<ReadAheadThread> _readAheadThread;  // Declared before the Streams using it.
     std::shared_ptr<Stream> _current;
     std::vector<std::shared_ptr<Stream>> _heap;  // MinHeap
     STLComparator _greater;                      // named so calls make sense
@@ -579,6 +766,11 @@ public:
     }
 
     ~NoLimitSorter() {
+        // The background spill must finish writing before the file can be removed.
+        if (_backgroundSpill) {
+            _backgroundSpill->thread.join();
+        }
+
         // This Sorter is responsible for file deletion, even if done() was called.
         if (!this->_shouldKeepFilesOnDestruction) {
             DESTRUCTOR_GUARD(boost::filesystem::remove(this->_fileFullPath));
@@ -593,8 +785,8 @@ public:
         _memUsed += key.memUsageForSorter();
         _memUsed += val.memUsageForSorter();
 
-        if (_memUsed > this->_opts.maxMemoryUsageBytes)
-            spill();
+        if (_memUsed > _spillThreshold() || this->_exceedsQueryMemoryLimit(_memUsed))
+            _spillInBackgroundOrNow();
     }
 
     void emplace(Key&& key, Value&& val) override {
@@ -605,19 +797,20 @@ public:
 
         _data.emplace_back(std::move(key), std::move(val));
 
-        if (_memUsed > this->_opts.maxMemoryUsageBytes)
-            spill();
+        if (_memUsed > _spillThreshold() || this->_exceedsQueryMemoryLimit(_memUsed))
+            _spillInBackgroundOrNow();
     }
 
     Iterator* done() {
         invariant(!std::exchange(_done, true));
 
-        if (this->_iters.empty()) {
+        if (this->_iters.empty() && !_backgroundSpill) {
             sort();
             return new InMemIterator<Key, Value>(_data);
         }
 
         spill();
+        _mergeSpills();
         return Iterator::merge(this->_iters, this->_opts, _comp);
     }
 
@@ -634,17 +827,85 @@ private:
         const Comparator& _comp;
     };
 
+    /**
+     * A run written to the file, which ends at 'endOffset'.
+     */
+    struct SpilledRun {
+        std::shared_ptr<Iterator> iterator;
+        std::streampos endOffset = 0;
+        uint64_t dataSize = 0;
+        uint64_t dataStorageSize = 0;
+    };
+
+    /**
+     * The state of a run being sorted and written to disk on a background thread, while the next
+     * run is being added.
+     */
+    struct BackgroundSpill {
+        stdx::thread thread;
+        std::deque<Data> data;
+        Status status = Status::OK();
+        SpilledRun run;
+    };
+
     void sort() {
-        STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        _sortData(_comp, &_data);
         this->_numSorted += _data.size();
     }
 
-    void spill() {
-        this->_numSpills++;
-        if (_data.empty())
-            return;
+    /**
+     * Sorts 'data'. Like _writeRun(), does not access the mutable members of this sorter, so that
+     * it can run in the background.
+     */
+    static void _sortData(const Comparator& comp, std::deque<Data>* data) {
+        STLComparator less(comp);
+        std::stable_sort(data->begin(), data->end(), less);
+    }
+
+    /**
+     * Writes the sorted 'data' to a new run starting at 'startOffset' in the file.
+     */
+    static SpilledRun _writeRun(const SortOptions& opts,
+                                const std::string& fileFullPath,
+                                std::streampos startOffset,
+                                const Settings& settings,
+                                std::deque<Data>* data) {
+        SortedFileWriter<Key, Value> writer(opts, fileFullPath, startOffset, settings);
+        for (; !data->empty(); data->pop_front()) {
+            writer.addAlreadySorted(data->front().first, data->front().second);
+        }
+        return _finishRun(&writer);
+    }
+
+    static SpilledRun _finishRun(SortedFileWriter<Key, Value>* writer) {
+        SpilledRun run;
+        run.iterator.reset(writer->done());
+        run.endOffset = writer->getFileEndOffset();
+        run.dataSize = writer->getDataSize();
+        run.dataStorageSize = writer->getDataStorageSize();
+        return run;
+    }
+
+    /**
+     * Accounts for a run written at the end of the file, and returns its iterator.
+     */
+    std::shared_ptr<Iterator> _recordSpilledRun(SpilledRun run) {
+        _nextSortedFileWriterOffset = run.endOffset;
+        this->_spilledDataSize += run.dataSize;
+        this->_spilledDataStorageSize += run.dataStorageSize;
+        return std::move(run.iterator);
+    }
+
+    /**
+     * The memory usage past which the data is spilled. Spilling in the background keeps the data
+     * of two runs in memory at once, so each of them only gets half of the memory.
+     */
+    size_t _spillThreshold() const {
+        return this->_opts.asyncSpill ? this->_opts.maxMemoryUsageBytes / 2
+                                      : this->_opts.maxMemoryUsageBytes;
+    }
 
+    void _checkExtSortAllowed() const {
         if (!this->_opts.extSortAllowed) {
             // This error message only applies to sorts from user queries made through the find or
             // aggregation commands. Other clients, such as bulk index builds, should suppress this
@@ -655,18 +916,107 @@ private:
                           << "Sort exceeded memory limit of " << this->_opts.maxMemoryUsageBytes
                           << " bytes, but did not opt in to external sorting.");
         }
+    }
 
-        sort();
+    /**
+     * Spills the data on a background thread if the options allow it, once the previous
+     * background spill is done, or spills it on this thread otherwise.
+     */
+    void _spillInBackgroundOrNow() {
+        if (!this->_opts.asyncSpill) {
+            spill();
+            return;
+        }
 
-        SortedFileWriter<Key, Value> writer(
-            this->_opts, this->_fileFullPath, _nextSortedFileWriterOffset, _settings);
-        for (; !_data.empty(); _data.pop_front()) {
-            writer.addAlreadySorted(_data.front().first, _data.front().second);
+        _waitForBackgroundSpill();
+        _checkExtSortAllowed();
+
+        this->_numSpills++;
+        this->_numSorted += _data.size();
+
+        _backgroundSpill = std::make_unique<BackgroundSpill>();
+        _backgroundSpill->data = std::move(_data);
+        _data.clear();
+        _memUsed = 0;
+
+        auto spillState = _backgroundSpill.get();
+        spillState->thread = stdx::thread([this, spillState, offset = _nextSortedFileWriterOffset] {
+            try {
+                _sortData(_comp, &spillState->data);
+                spillState->run = _writeRun(
+                    this->_opts, this->_fileFullPath, offset, _settings, &spillState->data);
+            } catch (...) {
+                spillState->status = exceptionToStatus();
+            }
+        });
+    }
+
+    /**
+     * Waits for the background spill, if any, and adds the run it wrote to the spilled runs.
+     */
+    void _waitForBackgroundSpill() {
+        if (!_backgroundSpill) {
+            return;
         }
-        Iterator* iteratorPtr = writer.done();
-        _nextSortedFileWriterOffset = writer.getFileEndOffset();
 
-        this->_iters.push_back(std::shared_ptr<Iterator>(iteratorPtr));
+        auto spillState = std::move(_backgroundSpill);
+        spillState->thread.join();
+        uassertStatusOK(spillState->status);
+
+        this->_iters.push_back(_recordSpilledRun(std::move(spillState->run)));
+    }
+
+    /**
+     * Merges the spilled runs into fewer, larger runs written at the end of the file, until the
+     * final merge reads at most 'maxMergeFanIn' runs at once. Only adjacent runs are merged
+     * together, so that equal keys keep the order in which they were added.
+     */
+    void _mergeSpills() {
+        if (this->_opts.maxMergeFanIn == 0) {
+            return;
+        }
+
+        const size_t fanIn = std::max(this->_opts.maxMergeFanIn, size_t(2));
+        while (this->_iters.size() > fanIn) {
+            std::vector<std::shared_ptr<Iterator>> mergedIters;
+            for (auto it = this->_iters.begin(); it != this->_iters.end();) {
+                const size_t groupSize =
+                    std::min(fanIn, static_cast<size_t>(std::distance(it, this->_iters.end())));
+                if (groupSize == 1) {
+                    mergedIters.push_back(std::move(*it++));
+                    continue;
+                }
+
+                std::vector<std::shared_ptr<Iterator>> group(it, it + groupSize);
+                it += groupSize;
+
+                std::unique_ptr<Iterator> merged(Iterator::merge(group, this->_opts, _comp));
+                SortedFileWriter<Key, Value> writer(
+                    this->_opts, this->_fileFullPath, _nextSortedFileWriterOffset, _settings);
+                while (merged->more()) {
+                    auto next = merged->next();
+                    writer.addAlreadySorted(next.first, next.second);
+                }
+                merged.reset();
+
+                mergedIters.push_back(_recordSpilledRun(_finishRun(&writer)));
+            }
+            this->_iters = std::move(mergedIters);
+        }
+    }
+
+    void spill() {
+        _waitForBackgroundSpill();
+
+        this->_numSpills++;
+        if (_data.empty())
+            return;
+
+        _checkExtSortAllowed();
+        sort();
+
+        this->_iters.push_back(_recordSpilledRun(_writeRun(
+            this->_opts, this->_fileFullPath, _nextSortedFileWriterOffset, _settings, &_data)));
 
         _memUsed = 0;
     }
@@ -677,6 +1027,10 @@ private:
     bool _done = false;
     size_t _memUsed = 0;
     std::deque<Data> _data;  // Data that has not been spilled.
+
+    // The run being spilled in the background, if any. Its run is added to '_iters' once it is
+    // written out.
+    std::unique_ptr<BackgroundSpill> _backgroundSpill;
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -783,7 +1137,8 @@ public:
             if (_data.size() == this->_opts.limit)
                 std::make_heap(_data.begin(), _data.end(), less);
 
-            if (_memUsed > this->_opts.maxMemoryUsageBytes)
+            if (_memUsed > this->_opts.maxMemoryUsageBytes ||
+                this->_exceedsQueryMemoryLimit(_memUsed))
                 spill();
 
             return;
@@ -806,7 +1161,7 @@ public:
         _data.back() = {contender.first.getOwned(), contender.second.getOwned()};
         std::push_heap(_data.begin(), _data.end(), less);
 
-        if (_memUsed > this->_opts.maxMemoryUsageBytes)
+        if (_memUsed > this->_opts.maxMemoryUsageBytes || this->_exceedsQueryMemoryLimit(_memUsed))
             spill();
     }
 
@@ -959,6 +1314,8 @@ private:
         Iterator* iteratorPtr = writer.done();
         _nextSortedFileWriterOffset = writer.getFileEndOffset();
         this->_iters.push_back(std::shared_ptr<Iterator>(iteratorPtr));
+        this->_spilledDataSize += writer.getDataSize();
+        this->_spilledDataStorageSize += writer.getDataStorageSize();
 
         _memUsed = 0;
     }
@@ -1021,6 +1378,7 @@ SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts,
                                                const std::streampos fileStartOffset,
                                                const Settings& settings)
     : _settings(settings),
+      _compressor(opts.spillCompressor),
       _fileFullPath(fileFullPath),
       // The file descriptor is positioned at the end of a file when opened in append mode, but
       // _file.tellp() is not initialized on all systems to reflect this. Therefore, we must also
@@ -1078,10 +1436,9 @@ void SortedFileWriter<Key, Value>::spill() {
         return;
 
     std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
-    verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
+    const auto compressor = sorter::compressSpillBlock(_compressor, outBuffer, size, &compressed);
 
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    const bool shouldCompress = compressor != SorterSpillCompressor::kNone;
     if (shouldCompress) {
         size = compressed.size();
         outBuffer = const_cast<char*>(compressed.data());
@@ -1104,17 +1461,25 @@ void SortedFileWriter<Key, Value>::spill() {
         size = resultLen;
     }
 
+    const int32_t storageSize = size;
+    if (compressor == SorterSpillCompressor::kZstd) {
+        size |= sorter::kZstdBlockBit;
+    }
+
     // negative size means compressed
     size = shouldCompress ? -size : size;
     try {
         _file.write(reinterpret_cast<const char*>(&size), sizeof(size));
-        _file.write(outBuffer, std::abs(size));
+        _file.write(outBuffer, storageSize);
     } catch (const std::exception&) {
         msgasserted(16821,
                     str::stream() << "error writing to file \"" << _fileFullPath
                                   << "\": " << sorter::myErrnoWithDescription());
     }
 
+    _dataSize += _buffer.len();
+    _dataStorageSize += sizeof(size) + storageSize;
+
     _buffer.reset();
 }
 
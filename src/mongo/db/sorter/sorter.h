@@ -39,7 +39,10 @@
 #include <vector>
 
 #include "mongo/bson/util/builder.h"
+#include "mongo/db/sorter/query_memory_reservation.h"
 #include "mongo/db/sorter/sorter_gen.h"
+#include "mongo/db/sorter/sorter_spill_compression.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
 
 /**
@@ -108,7 +111,35 @@ struct SortOptions {
     // extSortAllowed is true.
     std::string tempDir;
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    // The maximum number of spilled runs read at once by the final merge. If more runs have been
+    // spilled, they are first merged into fewer, larger runs. 0 indicates no limit.
+    size_t maxMergeFanIn;
+
+    // Whether merging spilled runs reads the next block of each run from disk on a background
+    // thread while the current block is consumed.
+    bool readAhead;
+
+    // Whether spills sort and write the data on a background thread while more data is added. The
+    // data being added and the data being spilled then each get half of maxMemoryUsageBytes.
+    bool asyncSpill;
+
+    // The algorithm with which the blocks spilled to disk are compressed.
+    SorterSpillCompressor spillCompressor;
+
+    // Whether the memory used by the sorter counts against the memory which the blocking stages of
+    // all queries may use together. See QueryMemoryReservation.
+    bool useQueryMemoryReservation;
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          maxMergeFanIn(internalSorterMaxMergeFanIn.load()),
+          readAhead(internalSorterReadAhead.load()),
+          asyncSpill(false),
+          spillCompressor(uassertStatusOK(
+              parseSorterSpillCompressor(internalSorterSpillCompressor.get()))),
+          useQueryMemoryReservation(false) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -131,6 +162,31 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& MaxMergeFanIn(size_t newMaxMergeFanIn) {
+        maxMergeFanIn = newMaxMergeFanIn;
+        return *this;
+    }
+
+    SortOptions& ReadAhead(bool newReadAhead = true) {
+        readAhead = newReadAhead;
+        return *this;
+    }
+
+    SortOptions& AsyncSpill(bool newAsyncSpill = true) {
+        asyncSpill = newAsyncSpill;
+        return *this;
+    }
+
+    SortOptions& SpillCompressor(SorterSpillCompressor newSpillCompressor) {
+        spillCompressor = newSpillCompressor;
+        return *this;
+    }
+
+    SortOptions& UseQueryMemoryReservation(bool newUseQueryMemoryReservation = true) {
+        useQueryMemoryReservation = newUseQueryMemoryReservation;
+        return *this;
+    }
 };
 
 /**
@@ -266,6 +322,18 @@ public:
         return _numSorted;
     }
 
+    /**
+     * The number of bytes of serialized data spilled to disk, and the number of bytes written to
+     * disk to store them after compression.
+     */
+    uint64_t spilledDataSize() const {
+        return _spilledDataSize;
+    }
+
+    uint64_t spilledDataStorageSize() const {
+        return _spilledDataStorageSize;
+    }
+
     PersistedState persistDataForShutdown();
 
 protected:
@@ -273,14 +341,32 @@ protected:
 
     virtual void spill() = 0;
 
+    /**
+     * Records that the data not yet spilled holds 'memUsed' bytes, and returns true if it should
+     * be spilled early because the blocking stages of all queries use too much memory.
+     */
+    bool _exceedsQueryMemoryLimit(size_t memUsed) {
+        if (!_opts.useQueryMemoryReservation || !_memoryReservation.update(memUsed) ||
+            !_opts.extSortAllowed) {
+            return false;
+        }
+        QueryMemoryReservation::recordForcedSpill();
+        return true;
+    }
+
     size_t _numSpills = 0;  // Keeps track of the number of times data was spilled to disk.
     size_t _numSorted = 0;  // Keeps track of the number of keys sorted.
 
+    uint64_t _spilledDataSize = 0;         // Bytes of data spilled, before compression.
+    uint64_t _spilledDataStorageSize = 0;  // Bytes written to disk by the spills.
+
     // Whether the files written by this Sorter should be kept on destruction.
     bool _shouldKeepFilesOnDestruction = false;
 
     SortOptions _opts;
 
+    QueryMemoryReservation _memoryReservation;
+
     // Used by Sorter::persistDataForShutdown() to return the base file name of the data persisted
     // by this Sorter.
     std::string _fileName;
@@ -328,10 +414,23 @@ public:
         return _fileEndOffset;
     }
 
+    /**
+     * The number of bytes of serialized data written so far, and the number of bytes they take in
+     * the file after compression.
+     */
+    uint64_t getDataSize() const {
+        return _dataSize;
+    }
+
+    uint64_t getDataStorageSize() const {
+        return _dataStorageSize;
+    }
+
 private:
     void spill();
 
     const Settings _settings;
+    const SorterSpillCompressor _compressor;
     std::string _fileFullPath;
     std::ofstream _file;
     BufBuilder _buffer;
@@ -340,6 +439,9 @@ private:
     // to ensure data has not been corrupted after reading from disk.
     uint32_t _checksum = 0;
 
+    uint64_t _dataSize = 0;
+    uint64_t _dataStorageSize = 0;
+
     // Tracks where in the file we started and finished writing the sorted data range so that the
     // information can be given to the Iterator in done(), and to the user via getFileEndOffset()
     // for the next SortedFileWriter instance using the same file.
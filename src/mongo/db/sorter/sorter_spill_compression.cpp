@@ -0,0 +1,125 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/sorter/sorter_spill_compression.h"
+
+#include <snappy.h>
+#include <zstd.h>
+
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+StatusWith<SorterSpillCompressor> parseSorterSpillCompressor(StringData compressorName) {
+    if (compressorName == "none"_sd) {
+        return SorterSpillCompressor::kNone;
+    } else if (compressorName == "snappy"_sd) {
+        return SorterSpillCompressor::kSnappy;
+    } else if (compressorName == "zstd"_sd) {
+        return SorterSpillCompressor::kZstd;
+    }
+    return {ErrorCodes::BadValue,
+            str::stream() << "Unknown sorter spill compressor '" << compressorName
+                          << "', expected one of 'none', 'snappy' or 'zstd'"};
+}
+
+Status validateSorterSpillCompressor(const std::string& compressorName) {
+    return parseSorterSpillCompressor(compressorName).getStatus();
+}
+
+namespace sorter {
+
+SorterSpillCompressor compressSpillBlock(SorterSpillCompressor compressor,
+                                         const char* data,
+                                         size_t size,
+                                         std::string* out) {
+    switch (compressor) {
+        case SorterSpillCompressor::kNone:
+            return SorterSpillCompressor::kNone;
+        case SorterSpillCompressor::kSnappy:
+            snappy::Compress(data, size, out);
+            break;
+        case SorterSpillCompressor::kZstd: {
+            out->resize(ZSTD_compressBound(size));
+            size_t compressedSize =
+                ZSTD_compress(&(*out)[0], out->size(), data, size, ZSTD_CLEVEL_DEFAULT);
+            uassert(5843102,
+                    str::stream() << "zstd compression failed: "
+                                  << ZSTD_getErrorName(compressedSize),
+                    !ZSTD_isError(compressedSize));
+            out->resize(compressedSize);
+            break;
+        }
+    }
+
+    return out->size() < size / 10 * 9 ? compressor : SorterSpillCompressor::kNone;
+}
+
+std::unique_ptr<char[]> decompressSpillBlock(SorterSpillCompressor compressor,
+                                             const char* data,
+                                             size_t size,
+                                             size_t* uncompressedSize) {
+    switch (compressor) {
+        case SorterSpillCompressor::kNone:
+            break;
+        case SorterSpillCompressor::kSnappy: {
+            dassert(snappy::IsValidCompressedBuffer(data, size));
+
+            uassert(17061,
+                    "couldn't get uncompressed length",
+                    snappy::GetUncompressedLength(data, size, uncompressedSize));
+
+            std::unique_ptr<char[]> out(new char[*uncompressedSize]);
+            uassert(17062, "decompression failed", snappy::RawUncompress(data, size, out.get()));
+            return out;
+        }
+        case SorterSpillCompressor::kZstd: {
+            auto contentSize = ZSTD_getFrameContentSize(data, size);
+            uassert(5843103,
+                    "couldn't get uncompressed length",
+                    contentSize != ZSTD_CONTENTSIZE_UNKNOWN &&
+                        contentSize != ZSTD_CONTENTSIZE_ERROR);
+            *uncompressedSize = contentSize;
+
+            std::unique_ptr<char[]> out(new char[*uncompressedSize]);
+            size_t decompressedSize = ZSTD_decompress(out.get(), *uncompressedSize, data, size);
+            uassert(5843104,
+                    "decompression failed",
+                    !ZSTD_isError(decompressedSize) && decompressedSize == *uncompressedSize);
+            return out;
+        }
+    }
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace sorter
+}  // namespace mongo
@@ -0,0 +1,78 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * The algorithm with which a sorter compresses the blocks it spills to disk.
+ */
+enum class SorterSpillCompressor { kNone, kSnappy, kZstd };
+
+/**
+ * Parses the name of a SorterSpillCompressor: "none", "snappy" or "zstd".
+ */
+StatusWith<SorterSpillCompressor> parseSorterSpillCompressor(StringData compressorName);
+
+/**
+ * Validates the name of a SorterSpillCompressor. This is intended for use as an IDL validator
+ * callback.
+ */
+Status validateSorterSpillCompressor(const std::string& compressorName);
+
+namespace sorter {
+
+/**
+ * Compresses the 'size' bytes at 'data' with 'compressor' into 'out', and returns the compressor
+ * that was used. Returns kNone, leaving 'out' unspecified, if the compressed block would not be at
+ * least a tenth smaller than 'data'.
+ */
+SorterSpillCompressor compressSpillBlock(SorterSpillCompressor compressor,
+                                         const char* data,
+                                         size_t size,
+                                         std::string* out);
+
+/**
+ * Decompresses the 'size' bytes at 'data', which were compressed with 'compressor', and sets
+ * 'uncompressedSize' to the size of the returned block. Throws if 'data' is corrupt.
+ */
+std::unique_ptr<char[]> decompressSpillBlock(SorterSpillCompressor compressor,
+                                             const char* data,
+                                             size_t size,
+                                             size_t* uncompressedSize);
+
+}  // namespace sorter
+}  // namespace mongo
@@ -45,6 +45,7 @@
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 
 namespace mongo {
@@ -305,6 +306,38 @@ public:
 
             ASSERT_TRUE(boost::filesystem::remove(fileName));
         }
+        for (auto compressor : {SorterSpillCompressor::kNone,
+                                SorterSpillCompressor::kSnappy,
+                                SorterSpillCompressor::kZstd}) {  // each compressor
+            std::string fileName = opts.tempDir + "/" + nextFileName();
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(
+                SortOptions(opts).SpillCompressor(compressor), fileName, 0);
+            // Repeat each pair, so that all of the compressors can compress the blocks.
+            for (int i = 0; i < 1000 * 1000; i++)
+                sorter.addAlreadySorted(i / 100, -(i / 100));
+
+            std::unique_ptr<IWIterator> iter(sorter.done());
+            iter->openSource();
+            for (int i = 0; i < 1000 * 1000; i++) {
+                ASSERT(iter->more());
+                auto next = iter->next();
+                ASSERT_EQ(static_cast<int>(next.first), i / 100);
+                ASSERT_EQ(static_cast<int>(next.second), -(i / 100));
+            }
+            ASSERT_FALSE(iter->more());
+            iter->closeSource();
+
+            // Each block of the file is preceded by its size.
+            ASSERT_EQ(sorter.getDataStorageSize(),
+                      static_cast<uint64_t>(sorter.getFileEndOffset()));
+            if (compressor == SorterSpillCompressor::kNone) {
+                ASSERT_GT(sorter.getDataStorageSize(), sorter.getDataSize());
+            } else {
+                ASSERT_LT(sorter.getDataStorageSize(), sorter.getDataSize());
+            }
+
+            ASSERT_TRUE(boost::filesystem::remove(fileName));
+        }
 
         ASSERT(boost::filesystem::is_empty(tempDir.path()));
     }
@@ -620,6 +653,31 @@ public:
     PseudoRandom _random;
 };
 
+template <bool Random = true>
+class LotsOfDataLittleMemoryAsyncSpill : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return Parent::adjustSortOptions(opts).AsyncSpill();
+    }
+    size_t correctNumRanges() const override {
+        // Spilling in the background halves the memory available to each run.
+        return Parent::NUM_ITEMS * sizeof(IWPair) / (Parent::MEM_LIMIT / 2) + 1;
+    }
+};
+
+template <bool Random = true>
+class LotsOfDataLittleMemoryMultiLevelMerge : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        MONGO_STATIC_ASSERT((Parent::NUM_ITEMS * sizeof(IWPair)) / Parent::MEM_LIMIT < 64);
+        return Parent::adjustSortOptions(opts).MaxMergeFanIn(4).ReadAhead(!Random);
+    }
+    size_t correctNumRanges() const override {
+        // The fewer than 64 runs are merged into at most 16 runs, and then into at most 4 runs.
+        return 4;
+    }
+};
+
 
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
@@ -667,6 +725,10 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataLittleMemoryAsyncSpill</*random=*/false>>();
+        add<SorterTests::LotsOfDataLittleMemoryAsyncSpill</*random=*/true>>();
+        add<SorterTests::LotsOfDataLittleMemoryMultiLevelMerge</*random=*/false>>();
+        add<SorterTests::LotsOfDataLittleMemoryMultiLevelMerge</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
@@ -698,6 +760,76 @@ mongo::unittest::OldStyleSuiteInitializer<SorterSuite> extSortTests;
  * This suite includes test cases for resumable index builds where the Sorter is reconstructed from
  * state persisted to disk during a previous clean shutdown.
  */
+TEST(SorterSpillCompressorTest, Parse) {
+    ASSERT(parseSorterSpillCompressor("none").getValue() == SorterSpillCompressor::kNone);
+    ASSERT(parseSorterSpillCompressor("snappy").getValue() == SorterSpillCompressor::kSnappy);
+    ASSERT(parseSorterSpillCompressor("zstd").getValue() == SorterSpillCompressor::kZstd);
+    ASSERT_EQ(parseSorterSpillCompressor("zlib").getStatus(), ErrorCodes::BadValue);
+}
+
+TEST(QueryMemoryReservationTest, ReportsWhenProcessWideLimitIsExceeded) {
+    const auto originalLimit = internalQueryGlobalBlockingMemoryLimitBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryGlobalBlockingMemoryLimitBytes.store(originalLimit); });
+    constexpr size_t kIncrement = QueryMemoryReservation::kIncrementBytes;
+
+    QueryMemoryReservation first;
+    QueryMemoryReservation second;
+
+    // Without a limit, stages are never asked to spill early.
+    internalQueryGlobalBlockingMemoryLimitBytes.store(0);
+    ASSERT_FALSE(first.update(10 * kIncrement));
+
+    internalQueryGlobalBlockingMemoryLimitBytes.store(15 * kIncrement);
+    ASSERT_FALSE(first.update(10 * kIncrement));
+    ASSERT_TRUE(second.update(6 * kIncrement));
+    ASSERT_TRUE(first.update(10 * kIncrement));
+
+    // A stage using less than one increment is not accounted for, nor asked to spill.
+    ASSERT_FALSE(second.update(kIncrement - 1));
+    ASSERT_FALSE(first.update(10 * kIncrement));
+
+    ASSERT_FALSE(first.update(0));
+    ASSERT_TRUE(second.update(16 * kIncrement));
+}
+
+TEST(QueryMemoryReservationTest, SorterSpillsEarlyWhenProcessWideLimitIsExceeded) {
+    const auto originalLimit = internalQueryGlobalBlockingMemoryLimitBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryGlobalBlockingMemoryLimitBytes.store(originalLimit); });
+    constexpr size_t kIncrement = QueryMemoryReservation::kIncrementBytes;
+    const int kNumValues = 3 * kIncrement / (2 * sizeof(IntWrapper));
+
+    unittest::TempDir tempDir("queryMemoryReservationTests");
+    const auto opts =
+        SortOptions().TempDir(tempDir.path()).ExtSortAllowed().UseQueryMemoryReservation();
+
+    // Another stage holds more memory than the process-wide limit.
+    QueryMemoryReservation otherStage;
+    otherStage.update(2 * kIncrement);
+
+    for (auto limit : {0LL, static_cast<long long>(kIncrement)}) {
+        internalQueryGlobalBlockingMemoryLimitBytes.store(limit);
+
+        std::unique_ptr<IWSorter> sorter(IWSorter::make(opts, IWComparator(ASC)));
+        for (int i = kNumValues - 1; i >= 0; --i) {
+            sorter->add(i, -i);
+        }
+        std::unique_ptr<IWIterator> iter(sorter->done());
+        for (int i = 0; i < kNumValues; ++i) {
+            ASSERT_TRUE(iter->more());
+            ASSERT_EQ(i, iter->next().first);
+        }
+        ASSERT_FALSE(iter->more());
+
+        // The sorter is far below its own memory limit, so it only spills because of the
+        // process-wide one.
+        if (limit == 0) {
+            ASSERT_EQ(0U, sorter->numSpills());
+        } else {
+            ASSERT_GTE(sorter->numSpills(), 2U);
+        }
+    }
+}
+
 class SorterMakeFromExistingRangesTest : public unittest::Test {
 public:
     static std::vector<SorterRange> makeSampleRanges();
@@ -59,6 +59,7 @@
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/quick_exit.h"
+#include "mongo/util/timer.h"
 
 #if !defined(_WIN32)
 #include <sys/file.h>
@@ -264,6 +265,7 @@ template <typename Func>
 void openDatabases(OperationContext* opCtx, const StorageEngine* storageEngine, Func&& onDatabase) {
     invariant(opCtx->lockState()->isW());
 
+    Timer timer;
     auto databaseHolder = DatabaseHolder::get(opCtx);
     auto dbNames = storageEngine->listDatabases();
     for (const auto& dbName : dbNames) {
@@ -273,6 +275,11 @@ void openDatabases(OperationContext* opCtx, const StorageEngine* storageEngine,
 
         onDatabase(db);
     }
+
+    LOGV2(5843214,
+          "Opened all databases",
+          "databases"_attr = dbNames.size(),
+          "durationMillis"_attr = timer.millis());
 }
 
 // Check for storage engine file compatibility. Exits the process if there is an incompatibility.
@@ -67,84 +67,62 @@ void OpCounters::gotOp(int op, bool isCommand) {
     }
 }
 
-void OpCounters::_checkWrap(CacheAligned<AtomicWord<long long>> OpCounters::*counter, int n) {
-    static constexpr auto maxCount = 1LL << 60;
-    auto oldValue = (this->*counter).fetchAndAddRelaxed(n);
-    if (oldValue > maxCount) {
-        _insert.store(0);
-        _query.store(0);
-        _update.store(0);
-        _delete.store(0);
-        _getmore.store(0);
-        _command.store(0);
+void OpCounters::_checkWrap(StripedCounter64 OpCounters::*counter, int n) {
+    static constexpr auto maxStripeCount = (1LL << 60) / StripedCounter64::kNumStripes;
+    auto oldValue = (this->*counter).incrementStripe(n);
+    if (oldValue > maxStripeCount) {
+        _insert.reset();
+        _query.reset();
+        _update.reset();
+        _delete.reset();
+        _getmore.reset();
+        _command.reset();
     }
 }
 
 BSONObj OpCounters::getObj() const {
     BSONObjBuilder b;
-    b.append("insert", _insert.loadRelaxed());
-    b.append("query", _query.loadRelaxed());
-    b.append("update", _update.loadRelaxed());
-    b.append("delete", _delete.loadRelaxed());
-    b.append("getmore", _getmore.loadRelaxed());
-    b.append("command", _command.loadRelaxed());
+    b.append("insert", _insert.get());
+    b.append("query", _query.get());
+    b.append("update", _update.get());
+    b.append("delete", _delete.get());
+    b.append("getmore", _getmore.get());
+    b.append("command", _command.get());
     return b.obj();
 }
 
-void NetworkCounter::hitPhysicalIn(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
-
-    // don't care about the race as its just a counter
-    const bool overflow = _physicalBytesIn.loadRelaxed() > MAX;
+namespace {
+// Resets the counters whose stripes are about to sum past 2^60. There is no need to be exact as
+// these are just counters.
+constexpr long long kMaxNetworkStripeCount = (1LL << 60) / StripedCounter64::kNumStripes;
+}  // namespace
 
-    if (overflow) {
-        _physicalBytesIn.store(bytes);
-    } else {
-        _physicalBytesIn.fetchAndAdd(bytes);
+void NetworkCounter::hitPhysicalIn(long long bytes) {
+    if (_physicalBytesIn.incrementStripe(bytes) > kMaxNetworkStripeCount) {
+        _physicalBytesIn.reset();
     }
 }
 
 void NetworkCounter::hitPhysicalOut(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
-
-    // don't care about the race as its just a counter
-    const bool overflow = _physicalBytesOut.loadRelaxed() > MAX;
-
-    if (overflow) {
-        _physicalBytesOut.store(bytes);
-    } else {
-        _physicalBytesOut.fetchAndAdd(bytes);
+    if (_physicalBytesOut.incrementStripe(bytes) > kMaxNetworkStripeCount) {
+        _physicalBytesOut.reset();
     }
 }
 
 void NetworkCounter::hitLogicalIn(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
-
-    // don't care about the race as its just a counter
-    const bool overflow = _together.logicalBytesIn.loadRelaxed() > MAX;
-
-    if (overflow) {
-        _together.logicalBytesIn.store(bytes);
-        // The requests field only gets incremented here (and not in hitPhysical) because the
-        // hitLogical and hitPhysical are each called for each operation. Incrementing it in both
-        // functions would double-count the number of operations.
-        _together.requests.store(1);
-    } else {
-        _together.logicalBytesIn.fetchAndAdd(bytes);
-        _together.requests.fetchAndAdd(1);
+    // The requests field only gets incremented here (and not in hitPhysical) because the
+    // hitLogical and hitPhysical are each called for each operation. Incrementing it in both
+    // functions would double-count the number of operations.
+    _requests.increment();
+    if (_logicalBytesIn.incrementStripe(bytes) > kMaxNetworkStripeCount) {
+        _logicalBytesIn.reset();
+        _requests.reset();
     }
 }
 
 void NetworkCounter::hitLogicalOut(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
-
-    // don't care about the race as its just a counter
-    const bool overflow = _logicalBytesOut.loadRelaxed() > MAX;
-
-    if (overflow) {
-        _logicalBytesOut.store(bytes);
-    } else {
-        _logicalBytesOut.fetchAndAdd(bytes);
+    if (_logicalBytesOut.incrementStripe(bytes) > kMaxNetworkStripeCount) {
+        _logicalBytesOut.reset();
     }
 }
 
@@ -156,18 +134,28 @@ void NetworkCounter::incrementNumSlowSSLOperations() {
     _numSlowSSLOperations.fetchAndAdd(1);
 }
 
+void NetworkCounter::hitAllocatedMessageBuffer() {
+    _numAllocatedMessageBuffers.increment();
+}
+
+void NetworkCounter::hitRecycledMessageBuffer() {
+    _numRecycledMessageBuffers.increment();
+}
+
 void NetworkCounter::acceptedTFOIngress() {
     _tfo.accepted.fetchAndAddRelaxed(1);
 }
 
 void NetworkCounter::append(BSONObjBuilder& b) {
-    b.append("bytesIn", static_cast<long long>(_together.logicalBytesIn.loadRelaxed()));
-    b.append("bytesOut", static_cast<long long>(_logicalBytesOut.loadRelaxed()));
-    b.append("physicalBytesIn", static_cast<long long>(_physicalBytesIn.loadRelaxed()));
-    b.append("physicalBytesOut", static_cast<long long>(_physicalBytesOut.loadRelaxed()));
+    b.append("bytesIn", _logicalBytesIn.get());
+    b.append("bytesOut", _logicalBytesOut.get());
+    b.append("physicalBytesIn", _physicalBytesIn.get());
+    b.append("physicalBytesOut", _physicalBytesOut.get());
     b.append("numSlowDNSOperations", static_cast<long long>(_numSlowDNSOperations.loadRelaxed()));
     b.append("numSlowSSLOperations", static_cast<long long>(_numSlowSSLOperations.loadRelaxed()));
-    b.append("numRequests", static_cast<long long>(_together.requests.loadRelaxed()));
+    b.append("numRequests", _requests.get());
+    b.append("numAllocatedMessageBuffers", _numAllocatedMessageBuffers.get());
+    b.append("numRecycledMessageBuffers", _numRecycledMessageBuffers.get());
 
     BSONObjBuilder tfo;
 #ifdef __linux__
@@ -262,12 +250,24 @@ Status AuthCounter::incClusterAuthenticateSuccessful(const std::string& mechanis
                           << " which is not enabled"};
 }
 
+Status AuthCounter::incSaslStep(const std::string& mechanism, long long micros) try {
+    auto& saslSteps = _mechanisms.at(mechanism).saslSteps;
+    saslSteps.count.fetchAndAddRelaxed(1);
+    saslSteps.totalMicros.fetchAndAddRelaxed(micros);
+    return Status::OK();
+} catch (const std::out_of_range&) {
+    return {ErrorCodes::BadValue,
+            str::stream() << "Received SASL step for mechanism " << mechanism
+                          << " which is unknown or not enabled"};
+}
+
 /**
  * authentication: {
  *   "mechanisms": {
  *     "SCRAM-SHA-256": {
  *       "speculativeAuthenticate": { received: ###, successful: ### },
  *       "authenticate": { received: ###, successful: ### },
+ *       "saslSteps": { count: ###, totalMicros: ### },
  *     },
  *     "MONGODB-X509": {
  *       "speculativeAuthenticate": { received: ###, successful: ### },
@@ -312,6 +312,16 @@ void AuthCounter::append(BSONObjBuilder* b) {
             authBuilder.done();
         }
 
+        {
+            const auto count = it.second.saslSteps.count.load();
+            const auto totalMicros = it.second.saslSteps.totalMicros.load();
+
+            BSONObjBuilder saslStepsBuilder(mechBuilder.subobjStart("saslSteps"));
+            saslStepsBuilder.append("count", count);
+            saslStepsBuilder.append("totalMicros", totalMicros);
+            saslStepsBuilder.done();
+        }
+
         mechBuilder.done();
     }
 
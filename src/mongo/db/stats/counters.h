@@ -31,6 +31,7 @@
 
 #include <map>
 
+#include "mongo/base/counter.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/atomic_word.h"
@@ -45,7 +46,8 @@ namespace mongo {
 
 /**
  * for storing operation counters
- * note: not thread safe.  ok with that for speed
+ * The counters are striped, so that the operations running on different cores don't contend for
+ * their cache lines; reading them sums the stripes.
  */
 class OpCounters {
 public:
@@ -96,56 +98,56 @@ public:
     }
 
     // thse are used by snmp, and other things, do not remove
-    const AtomicWord<long long>* getInsert() const {
+    const StripedCounter64* getInsert() const {
         return &_insert;
     }
-    const AtomicWord<long long>* getQuery() const {
+    const StripedCounter64* getQuery() const {
         return &_query;
     }
-    const AtomicWord<long long>* getUpdate() const {
+    const StripedCounter64* getUpdate() const {
         return &_update;
     }
-    const AtomicWord<long long>* getDelete() const {
+    const StripedCounter64* getDelete() const {
         return &_delete;
     }
-    const AtomicWord<long long>* getGetMore() const {
+    const StripedCounter64* getGetMore() const {
         return &_getmore;
     }
-    const AtomicWord<long long>* getCommand() const {
+    const StripedCounter64* getCommand() const {
         return &_command;
     }
-    const AtomicWord<long long>* getInsertOnExistingDoc() const {
+    const StripedCounter64* getInsertOnExistingDoc() const {
         return &_insertOnExistingDoc;
     }
-    const AtomicWord<long long>* getUpdateOnMissingDoc() const {
+    const StripedCounter64* getUpdateOnMissingDoc() const {
         return &_updateOnMissingDoc;
     }
-    const AtomicWord<long long>* getDeleteWasEmpty() const {
+    const StripedCounter64* getDeleteWasEmpty() const {
         return &_deleteWasEmpty;
     }
-    const AtomicWord<long long>* getDeleteFromMissingNamespace() const {
+    const StripedCounter64* getDeleteFromMissingNamespace() const {
         return &_deleteFromMissingNamespace;
     }
-    const AtomicWord<long long>* getAcceptableErrorInCommand() const {
+    const StripedCounter64* getAcceptableErrorInCommand() const {
         return &_acceptableErrorInCommand;
     }
 
 private:
     // Increment member `counter` by `n`, resetting all counters if it was > 2^60.
-    void _checkWrap(CacheAligned<AtomicWord<long long>> OpCounters::*counter, int n);
-
-    CacheAligned<AtomicWord<long long>> _insert;
-    CacheAligned<AtomicWord<long long>> _query;
-    CacheAligned<AtomicWord<long long>> _update;
-    CacheAligned<AtomicWord<long long>> _delete;
-    CacheAligned<AtomicWord<long long>> _getmore;
-    CacheAligned<AtomicWord<long long>> _command;
-
-    CacheAligned<AtomicWord<long long>> _insertOnExistingDoc;
-    CacheAligned<AtomicWord<long long>> _updateOnMissingDoc;
-    CacheAligned<AtomicWord<long long>> _deleteWasEmpty;
-    CacheAligned<AtomicWord<long long>> _deleteFromMissingNamespace;
-    CacheAligned<AtomicWord<long long>> _acceptableErrorInCommand;
+    void _checkWrap(StripedCounter64 OpCounters::*counter, int n);
+
+    StripedCounter64 _insert;
+    StripedCounter64 _query;
+    StripedCounter64 _update;
+    StripedCounter64 _delete;
+    StripedCounter64 _getmore;
+    StripedCounter64 _command;
+
+    StripedCounter64 _insertOnExistingDoc;
+    StripedCounter64 _updateOnMissingDoc;
+    StripedCounter64 _deleteWasEmpty;
+    StripedCounter64 _deleteFromMissingNamespace;
+    StripedCounter64 _acceptableErrorInCommand;
 };
 
 extern OpCounters globalOpCounters;
@@ -168,6 +170,11 @@ public:
     // Increment the counter for the number of slow ssl handshake operations.
     void incrementNumSlowSSLOperations();
 
+    // Increment the counters for the number of messages received into a newly allocated buffer,
+    // and into the recycled buffer of a previous message.
+    void hitAllocatedMessageBuffer();
+    void hitRecycledMessageBuffer();
+
     // TFO Counters and Status;
     void acceptedTFOIngress();
 
@@ -186,24 +193,19 @@ public:
     void append(BSONObjBuilder& b);
 
 private:
-    CacheAligned<AtomicWord<long long>> _physicalBytesIn{0};
-    CacheAligned<AtomicWord<long long>> _physicalBytesOut{0};
-
-    // These two counters are always incremented at the same time, so
-    // we place them on the same cache line.
-    struct Together {
-        AtomicWord<long long> logicalBytesIn{0};
-        AtomicWord<long long> requests{0};
-    };
-    CacheAligned<Together> _together{};
-    static_assert(sizeof(decltype(_together)) <= stdx::hardware_constructive_interference_size,
-                  "cache line spill");
-
-    CacheAligned<AtomicWord<long long>> _logicalBytesOut{0};
+    // The counters incremented for every message are striped.
+    StripedCounter64 _physicalBytesIn;
+    StripedCounter64 _physicalBytesOut;
+    StripedCounter64 _logicalBytesIn;
+    StripedCounter64 _requests;
+    StripedCounter64 _logicalBytesOut;
 
     CacheAligned<AtomicWord<long long>> _numSlowDNSOperations{0};
     CacheAligned<AtomicWord<long long>> _numSlowSSLOperations{0};
 
+    StripedCounter64 _numAllocatedMessageBuffers;
+    StripedCounter64 _numRecycledMessageBuffers;
+
     struct TFO {
         // Counter of inbound connections at runtime.
         AtomicWord<std::int64_t> accepted{0};
@@ -229,6 +231,9 @@ public:
     Status incClusterAuthenticateReceived(const std::string& mechanism);
     Status incClusterAuthenticateSuccessful(const std::string& mechanism);
 
+    // Records one server-side step of a SASL conversation for 'mechanism', which took 'micros'.
+    Status incSaslStep(const std::string& mechanism, long long micros);
+
     void append(BSONObjBuilder*);
 
     void initializeMechanismMap(const std::vector<std::string>&);
@@ -247,6 +252,10 @@ private:
             AtomicWord<long long> received;
             AtomicWord<long long> successful;
         } clusterAuthenticate;
+        struct {
+            AtomicWord<long long> count;
+            AtomicWord<long long> totalMicros;
+        } saslSteps;
     };
     using MechanismMap = std::map<std::string, MechanismData>;
 
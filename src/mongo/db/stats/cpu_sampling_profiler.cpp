@@ -0,0 +1,210 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/cpu_sampling_profiler.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/time.h>
+#endif
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/cpu_sampling_profiler_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/static_immortal.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+// The samples charged to the client attached to the sampled thread. Being a decoration, the
+// counter outlives any operation of the client, and is safe to reach from the signal handler.
+const auto getClientSamples = Client::declareDecoration<AtomicWord<long long>>();
+
+// The samples of the operation's client when the operation was created.
+const auto getSamplesAtStart = OperationContext::declareDecoration<long long>();
+
+AtomicWord<long long> totalSamples;
+AtomicWord<long long> samplesWithoutClient;
+
+class CPUSamplingProfilerClientObserver final : public ServiceContext::ClientObserver {
+public:
+    void onCreateClient(Client* client) override {}
+    void onDestroyClient(Client* client) override {}
+
+    void onCreateOperationContext(OperationContext* opCtx) override {
+        if (auto client = opCtx->getClient()) {
+            getSamplesAtStart(opCtx) = getClientSamples(client).load();
+        }
+    }
+
+    void onDestroyOperationContext(OperationContext* opCtx) override {}
+};
+
+ServiceContext::ConstructorActionRegisterer registerCPUSamplingProfilerClientObserver{
+    "CPUSamplingProfilerClientObserver", [](ServiceContext* service) {
+        service->registerClientObserver(std::make_unique<CPUSamplingProfilerClientObserver>());
+    }};
+
+#ifndef _WIN32
+void handleSample(int) {
+    // Only lock-free atomics and thread-local storage may be touched here. The client of this
+    // thread can't be destroyed while it is attached, as it is detached before its destruction.
+    totalSamples.fetchAndAddRelaxed(1);
+    if (auto client = Client::getCurrent()) {
+        getClientSamples(client).fetchAndAddRelaxed(1);
+    } else {
+        samplesWithoutClient.fetchAndAddRelaxed(1);
+    }
+}
+#endif
+
+class CPUSamplingProfilerServerStatusSection final : public ServerStatusSection {
+public:
+    CPUSamplingProfilerServerStatusSection() : ServerStatusSection("cpuSamplingProfiler") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        BSONObjBuilder builder;
+        CPUSamplingProfiler::get().appendStats(&builder);
+        return builder.obj();
+    }
+} cpuSamplingProfilerServerStatusSection;
+
+}  // namespace
+
+CPUSamplingProfiler& CPUSamplingProfiler::get() {
+    static StaticImmortal<CPUSamplingProfiler> profiler;
+    return *profiler;
+}
+
+void CPUSamplingProfiler::startup() {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        invariant(!_started);
+        _started = true;
+    }
+
+    uassertStatusOK(setInterval(Microseconds(gCPUSamplingProfilerIntervalMicros.load())));
+}
+
+Status CPUSamplingProfiler::setInterval(Microseconds interval) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (!_started || interval == _interval) {
+        return Status::OK();
+    }
+
+#ifdef _WIN32
+    if (interval > Microseconds(0)) {
+        return {ErrorCodes::IllegalOperation,
+                "The sampling CPU profiler is not supported on this platform"};
+    }
+    return Status::OK();
+#else
+    if (!_handlerInstalled && interval > Microseconds(0)) {
+        struct sigaction sa = {};
+        sa.sa_handler = &handleSample;
+        sa.sa_flags = SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        if (sigaction(SIGPROF, &sa, nullptr) != 0) {
+            auto ec = errno;
+            return {ErrorCodes::InternalError,
+                    str::stream() << "Failed to install the SIGPROF handler: "
+                                  << errnoWithDescription(ec)};
+        }
+        _handlerInstalled = true;
+    }
+
+    const auto micros = durationCount<Microseconds>(interval);
+    struct itimerval timer = {};
+    timer.it_interval.tv_sec = micros / 1000000;
+    timer.it_interval.tv_usec = micros % 1000000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        auto ec = errno;
+        return {ErrorCodes::InternalError,
+                str::stream() << "Failed to set the profiling timer: "
+                              << errnoWithDescription(ec)};
+    }
+
+    LOGV2(5843221,
+          "Changed the sampling interval of the CPU profiler",
+          "intervalMicros"_attr = micros);
+    _interval = interval;
+    return Status::OK();
+#endif
+}
+
+long long CPUSamplingProfiler::getOperationSamples(OperationContext* opCtx) {
+    auto client = opCtx->getClient();
+    if (!client) {
+        return 0;
+    }
+    return getClientSamples(client).load() - getSamplesAtStart(opCtx);
+}
+
+void CPUSamplingProfiler::recordCommandSamples(StringData commandName, long long samples) {
+    if (samples <= 0) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _commandSamples[commandName] += samples;
+}
+
+void CPUSamplingProfiler::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    builder->append("intervalMicros", durationCount<Microseconds>(_interval));
+    builder->append("samples", totalSamples.load());
+    builder->append("samplesWithoutClient", samplesWithoutClient.load());
+
+    BSONObjBuilder commandsBuilder(builder->subobjStart("commands"));
+    for (auto&& [commandName, samples] : _commandSamples) {
+        commandsBuilder.append(commandName, samples);
+    }
+}
+
+Status onUpdateCPUSamplingProfilerInterval(const int& intervalMicros) {
+    return CPUSamplingProfiler::get().setInterval(Microseconds(intervalMicros));
+}
+
+}  // namespace mongo
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+
+/**
+ * An opt-in, process-wide sampling CPU profiler. While it runs, the kernel sends the process a
+ * SIGPROF each time it has consumed another sampling interval of CPU time, and delivers it to a
+ * thread which is running at that moment. The signal handler charges the sample to the client
+ * attached to that thread, so the samples taken during an operation measure the CPU time it has
+ * consumed, with an overhead which only depends on the sampling interval.
+ *
+ * The profiler is not supported on Windows.
+ */
+class CPUSamplingProfiler {
+    CPUSamplingProfiler(const CPUSamplingProfiler&) = delete;
+    CPUSamplingProfiler& operator=(const CPUSamplingProfiler&) = delete;
+
+public:
+    CPUSamplingProfiler() = default;
+
+    static CPUSamplingProfiler& get();
+
+    /**
+     * Starts sampling at the interval of the 'cpuSamplingProfilerIntervalMicros' server parameter,
+     * and applies any later change of the parameter. Must be called once the server has forked,
+     * since the interval timer isn't inherited by child processes.
+     */
+    void startup();
+
+    /**
+     * Changes the sampling interval, if the profiler has been started. An interval of zero stops
+     * sampling.
+     */
+    Status setInterval(Microseconds interval);
+
+    /**
+     * Returns the number of samples charged to 'opCtx' since it was created.
+     */
+    static long long getOperationSamples(OperationContext* opCtx);
+
+    /**
+     * Adds the samples of a completed operation to the samples of its command.
+     */
+    void recordCommandSamples(StringData commandName, long long samples);
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CPUSamplingProfiler::_mutex");
+
+    // Whether startup() has been called.
+    bool _started = false;
+
+    // Whether the SIGPROF handler has been installed.
+    bool _handlerInstalled = false;
+
+    Microseconds _interval{0};
+
+    // The number of samples charged to the operations of each command.
+    StringMap<long long> _commandSamples;
+};
+
+Status onUpdateCPUSamplingProfilerInterval(const int& intervalMicros);
+
+}  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/wait_events.h"
 
 namespace mongo {
 namespace {
@@ -127,5 +128,23 @@ public:
 
 } lockStatsServerStatusSection;
 
+
+class WaitEventsServerStatusSection : public ServerStatusSection {
+public:
+    WaitEventsServerStatusSection() : ServerStatusSection("waitEvents") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder ret;
+        appendGlobalWaitTimes(&ret);
+        return ret.obj();
+    }
+
+} waitEventsServerStatusSection;
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include <absl/hash/hash.h>
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/query_shape_stats_gen.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryShapeStatsStore = ServiceContext::declareDecoration<QueryShapeStatsStore>();
+
+size_t latencyBucket(long long micros) {
+    // Bucket 'i' holds the latencies in [2^i, 2^(i+1)) microseconds, except for the first bucket,
+    // which also holds zero, and the last one, which holds everything above.
+    const auto bucket = 63 - countLeadingZeros64(static_cast<unsigned long long>(micros) | 1);
+    return std::min(static_cast<size_t>(bucket), QueryShapeStatsStore::kNumLatencyBuckets - 1);
+}
+
+}  // namespace
+
+QueryShapeStatsStore& QueryShapeStatsStore::get(ServiceContext* serviceContext) {
+    return getQueryShapeStatsStore(serviceContext);
+}
+
+QueryShapeStatsStore::QueryShapeStatsStore()
+    : QueryShapeStatsStore(static_cast<size_t>(gQueryShapeStatsCacheSize)) {}
+
+QueryShapeStatsStore::QueryShapeStatsStore(size_t capacity) {
+    if (capacity == 0) {
+        return;
+    }
+
+    const auto numPartitions = std::min(capacity, kNumPartitions);
+    const auto entriesPerPartition = (capacity + numPartitions - 1) / numPartitions;
+    _partitions.reserve(numPartitions);
+    for (size_t idx = 0; idx < numPartitions; ++idx) {
+        _partitions.push_back(std::make_unique<Partition>(entriesPerPartition));
+    }
+}
+
+std::size_t QueryShapeStatsStore::KeyHasher::operator()(const Key& key) const {
+    return absl::Hash<std::tuple<const NamespaceString&, uint32_t>>{}(
+        std::tie(key.nss, key.queryHash));
+}
+
+void QueryShapeStatsStore::Entry::add(const Sample& sample) {
+    const auto micros = durationCount<Microseconds>(sample.latency);
+    ++count;
+    totalMicros += micros;
+    maxMicros = std::max(maxMicros, micros);
+    docsExamined += sample.docsExamined;
+    keysExamined += sample.keysExamined;
+    nreturned += sample.nreturned;
+    docBytesRead += sample.docBytesRead;
+    cpuSamples += sample.cpuSamples;
+    for (size_t i = 0; i < kNumWaitClasses; ++i) {
+        waitMicros[i] += sample.waitMicros[i];
+    }
+    ++latencyHistogram[latencyBucket(micros)];
+}
+
+BSONObj QueryShapeStatsStore::Entry::toBSON(const Key& key) const {
+    BSONObjBuilder builder;
+    builder.append("ns", key.nss.ns());
+    builder.append("queryHash", zeroPaddedHex(key.queryHash));
+    builder.append("planCacheKey", zeroPaddedHex(planCacheKey));
+    builder.append("count", count);
+    builder.append("totalExecMicros", totalMicros);
+    builder.append("maxExecMicros", maxMicros);
+    builder.append("docsExamined", docsExamined);
+    builder.append("keysExamined", keysExamined);
+    builder.append("nreturned", nreturned);
+    builder.append("docBytesRead", docBytesRead);
+    builder.append("cpuSamples", cpuSamples);
+    {
+        BSONObjBuilder waitBuilder(builder.subobjStart("waitTimeMicros"));
+        for (size_t i = 0; i < kNumWaitClasses; ++i) {
+            waitBuilder.append(toString(static_cast<WaitClass>(i)), waitMicros[i]);
+        }
+    }
+    {
+        BSONArrayBuilder histogramBuilder(builder.subarrayStart("latencyHistogram"));
+        for (size_t i = 0; i < kNumLatencyBuckets; ++i) {
+            if (latencyHistogram[i] == 0) {
+                continue;
+            }
+            BSONObjBuilder entryBuilder(histogramBuilder.subobjStart());
+            entryBuilder.append("micros", i == 0 ? 0LL : 1LL << i);
+            entryBuilder.append("count", latencyHistogram[i]);
+        }
+    }
+    builder.append("firstSeen", firstSeen);
+    builder.append("lastSeen", lastSeen);
+    return builder.obj();
+}
+
+void QueryShapeStatsStore::record(const NamespaceString& nss,
+                                  uint32_t queryHash,
+                                  uint32_t planCacheKey,
+                                  const Sample& sample) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    // The query hash is already well distributed, so it picks the partition on its own.
+    auto& partition = *_partitions[queryHash % _partitions.size()];
+    const auto now = Date_t::now();
+    Key key{nss, queryHash};
+
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto it = partition.cache.promote(key);
+    if (it == partition.cache.end()) {
+        Entry entry;
+        entry.firstSeen = now;
+        partition.cache.add(key, std::move(entry));
+        it = partition.cache.begin();
+    }
+
+    auto& entry = it->second;
+    entry.planCacheKey = planCacheKey;
+    entry.lastSeen = now;
+    entry.add(sample);
+}
+
+std::vector<BSONObj> QueryShapeStatsStore::getStats(const NamespaceString& nss) const {
+    std::vector<BSONObj> results;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
+        for (auto&& [key, entry] : partition->cache) {
+            if (key.nss == nss) {
+                results.push_back(entry.toBSON(key));
+            }
+        }
+    }
+    return results;
+}
+
+void QueryShapeStatsStore::clear() {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
+        partition->cache.clear();
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/stats/wait_events.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Aggregates latency and resource statistics of the queries run against this node by query
+ * shape, where a shape is identified by the namespace and the 'queryHash' of the plan cache. Only
+ * the 'queryShapeStatsCacheSize' most recently seen shapes are retained.
+ *
+ * This class is thread-safe. The shapes are spread over several independently locked partitions,
+ * so that queries of different shapes completing concurrently rarely contend.
+ */
+class QueryShapeStatsStore {
+    QueryShapeStatsStore(const QueryShapeStatsStore&) = delete;
+    QueryShapeStatsStore& operator=(const QueryShapeStatsStore&) = delete;
+
+public:
+    static constexpr size_t kNumPartitions = 16;
+
+    // The latency histogram has power of two buckets, the last of which is unbounded.
+    static constexpr size_t kNumLatencyBuckets = 32;
+
+    /**
+     * The statistics of a single execution of a query.
+     */
+    struct Sample {
+        Microseconds latency{0};
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        long long docBytesRead = 0;
+        long long cpuSamples = 0;
+        std::array<long long, kNumWaitClasses> waitMicros{};
+    };
+
+    static QueryShapeStatsStore& get(ServiceContext* serviceContext);
+
+    /**
+     * Sizes the store from the 'queryShapeStatsCacheSize' server parameter.
+     */
+    QueryShapeStatsStore();
+
+    /**
+     * Creates a store retaining at most 'capacity' shapes. A 'capacity' of zero disables the store.
+     */
+    explicit QueryShapeStatsStore(size_t capacity);
+
+    bool isEnabled() const {
+        return !_partitions.empty();
+    }
+
+    /**
+     * Adds 'sample' to the statistics of the shape identified by 'nss' and 'queryHash', making
+     * it the most recently seen shape.
+     */
+    void record(const NamespaceString& nss,
+                uint32_t queryHash,
+                uint32_t planCacheKey,
+                const Sample& sample);
+
+    /**
+     * Returns one document for each shape of namespace 'nss', in no particular order.
+     */
+    std::vector<BSONObj> getStats(const NamespaceString& nss) const;
+
+    void clear();
+
+private:
+    struct Key {
+        bool operator==(const Key& other) const {
+            return queryHash == other.queryHash && nss == other.nss;
+        }
+
+        NamespaceString nss;
+        uint32_t queryHash;
+    };
+
+    struct KeyHasher {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        void add(const Sample& sample);
+
+        BSONObj toBSON(const Key& key) const;
+
+        uint32_t planCacheKey = 0;
+        long long count = 0;
+        long long totalMicros = 0;
+        long long maxMicros = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        long long docBytesRead = 0;
+        long long cpuSamples = 0;
+        std::array<long long, kNumWaitClasses> waitMicros{};
+        std::array<long long, kNumLatencyBuckets> latencyHistogram{};
+        Date_t firstSeen;
+        Date_t lastSeen;
+    };
+
+    struct Partition {
+        explicit Partition(size_t maxEntries) : cache(maxEntries) {}
+
+        LRUCache<Key, Entry, KeyHasher> cache;
+
+        // Protects 'cache'.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("QueryShapeStatsStore::Partition::mutex");
+    };
+
+    std::vector<std::unique_ptr<Partition>> _partitions;
+};
+
+}  // namespace mongo
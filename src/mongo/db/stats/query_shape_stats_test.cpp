@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+QueryShapeStatsStore::Sample makeSample(long long micros, long long docsExamined) {
+    QueryShapeStatsStore::Sample sample;
+    sample.latency = Microseconds(micros);
+    sample.docsExamined = docsExamined;
+    sample.keysExamined = 2 * docsExamined;
+    sample.nreturned = 1;
+    sample.docBytesRead = 100 * docsExamined;
+    sample.waitMicros[static_cast<size_t>(WaitClass::kLock)] = micros / 2;
+    return sample;
+}
+
+TEST(QueryShapeStatsTest, AggregatesSamplesOfTheSameShape) {
+    QueryShapeStatsStore store(10);
+    store.record(kNss, 1, 10, makeSample(3, 5));
+    store.record(kNss, 1, 11, makeSample(1000, 7));
+    store.record(kNss, 2, 20, makeSample(1, 1));
+
+    auto stats = store.getStats(kNss);
+    ASSERT_EQ(2U, stats.size());
+    auto shape = stats[0]["queryHash"].str() == "00000001" ? stats[0] : stats[1];
+
+    // The most recent plan cache key is reported.
+    ASSERT_EQ("0000000B", shape["planCacheKey"].str());
+    ASSERT_EQ(2, shape["count"].numberLong());
+    ASSERT_EQ(1003, shape["totalExecMicros"].numberLong());
+    ASSERT_EQ(1000, shape["maxExecMicros"].numberLong());
+    ASSERT_EQ(12, shape["docsExamined"].numberLong());
+    ASSERT_EQ(24, shape["keysExamined"].numberLong());
+    ASSERT_EQ(2, shape["nreturned"].numberLong());
+    ASSERT_EQ(1200, shape["docBytesRead"].numberLong());
+    ASSERT_EQ(501, shape["waitTimeMicros"]["lock"].numberLong());
+    ASSERT_EQ(0, shape["waitTimeMicros"]["ticket"].numberLong());
+    ASSERT_BSONOBJ_EQ(BSON("histogram" << BSON_ARRAY(BSON("micros" << 2LL << "count" << 1LL)
+                                                     << BSON("micros" << 512LL << "count" << 1LL))),
+                      BSON("histogram" << shape["latencyHistogram"]));
+}
+
+TEST(QueryShapeStatsTest, ShapesAreKeyedByNamespace) {
+    QueryShapeStatsStore store(10);
+    store.record(kNss, 1, 10, makeSample(1, 1));
+    store.record(NamespaceString("test.other"), 1, 10, makeSample(1, 1));
+
+    auto stats = store.getStats(kNss);
+    ASSERT_EQ(1U, stats.size());
+    ASSERT_EQ(kNss.ns(), stats[0]["ns"].str());
+    ASSERT_EQ(1, stats[0]["count"].numberLong());
+}
+
+TEST(QueryShapeStatsTest, EvictsTheLeastRecentlySeenShapes) {
+    // With a single entry per partition, each shape evicts the previous one of its partition.
+    QueryShapeStatsStore store(QueryShapeStatsStore::kNumPartitions);
+    store.record(kNss, 1, 10, makeSample(1, 1));
+    store.record(kNss, 1 + QueryShapeStatsStore::kNumPartitions, 10, makeSample(1, 1));
+
+    auto stats = store.getStats(kNss);
+    ASSERT_EQ(1U, stats.size());
+    ASSERT_EQ("00000011", stats[0]["queryHash"].str());
+}
+
+TEST(QueryShapeStatsTest, LongLatenciesFallInTheLastBucket) {
+    QueryShapeStatsStore store(10);
+    store.record(kNss, 1, 10, makeSample(0, 0));
+    store.record(kNss, 1, 10, makeSample(1LL << 40, 0));
+
+    auto histogram = store.getStats(kNss)[0]["latencyHistogram"].Array();
+    ASSERT_EQ(2U, histogram.size());
+    ASSERT_EQ(0, histogram[0]["micros"].numberLong());
+    ASSERT_EQ(1LL << (QueryShapeStatsStore::kNumLatencyBuckets - 1),
+              histogram[1]["micros"].numberLong());
+}
+
+TEST(QueryShapeStatsTest, ZeroCapacityDisablesTheStore) {
+    QueryShapeStatsStore store(0);
+    ASSERT_FALSE(store.isEnabled());
+    store.record(kNss, 1, 10, makeSample(1, 1));
+    ASSERT_TRUE(store.getStats(kNss).empty());
+}
+
+TEST(QueryShapeStatsTest, Clear) {
+    QueryShapeStatsStore store(10);
+    store.record(kNss, 1, 10, makeSample(1, 1));
+    store.clear();
+    ASSERT_TRUE(store.getStats(kNss).empty());
+}
+
+}  // namespace
+}  // namespace mongo
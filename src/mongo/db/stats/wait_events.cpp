@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_events.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+struct GlobalWaitTimes {
+    StripedCounter64 count;
+    StripedCounter64 totalMicros;
+};
+
+std::array<GlobalWaitTimes, kNumWaitClasses> globalWaitTimes;
+
+}  // namespace
+
+const OperationContext::Decoration<OperationWaitTimes> OperationWaitTimes::get =
+    OperationContext::declareDecoration<OperationWaitTimes>();
+
+StringData toString(WaitClass waitClass) {
+    switch (waitClass) {
+        case WaitClass::kTicket:
+            return "ticket"_sd;
+        case WaitClass::kLock:
+            return "lock"_sd;
+        case WaitClass::kPrepareConflict:
+            return "prepareConflict"_sd;
+        case WaitClass::kJournalFlush:
+            return "journalFlush"_sd;
+        case WaitClass::kReplication:
+            return "replication"_sd;
+        case WaitClass::kRemoteResponse:
+            return "remoteResponse"_sd;
+        case WaitClass::kNumWaitClasses:
+            break;
+    }
+    MONGO_UNREACHABLE;
+}
+
+void OperationWaitTimes::appendNonZero(BSONObjBuilder* builder) const {
+    for (size_t i = 0; i < kNumWaitClasses; ++i) {
+        if (auto micros = _micros[i].loadRelaxed(); micros > 0) {
+            builder->append(toString(static_cast<WaitClass>(i)), micros);
+        }
+    }
+}
+
+void recordWaitTime(OperationContext* opCtx, WaitClass waitClass, Microseconds elapsed) {
+    const auto i = static_cast<size_t>(waitClass);
+    const auto micros = durationCount<Microseconds>(elapsed);
+
+    if (opCtx) {
+        OperationWaitTimes::get(opCtx)._micros[i].fetchAndAddRelaxed(micros);
+    }
+
+    globalWaitTimes[i].count.increment();
+    globalWaitTimes[i].totalMicros.increment(micros);
+}
+
+void appendGlobalWaitTimes(BSONObjBuilder* builder) {
+    for (size_t i = 0; i < kNumWaitClasses; ++i) {
+        BSONObjBuilder sub(builder->subobjStart(toString(static_cast<WaitClass>(i))));
+        sub.append("count", globalWaitTimes[i].count.get());
+        sub.append("totalMicros", globalWaitTimes[i].totalMicros.get());
+    }
+}
+
+}  // namespace mongo
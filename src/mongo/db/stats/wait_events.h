@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/system_tick_source.h"
+#include "mongo/util/tick_source.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * The classes of events an operation can spend its wall time blocked on.
+ */
+enum class WaitClass {
+    kTicket,           // Waiting for a storage engine read or write ticket.
+    kLock,             // Waiting for a lock held by another operation.
+    kPrepareConflict,  // Waiting for a prepared transaction to commit or abort.
+    kJournalFlush,     // Waiting for the journal to be flushed, for a {j: true} write concern.
+    kReplication,      // Waiting for secondaries to satisfy the write concern.
+    kRemoteResponse,   // Waiting for the responses of the remote hosts an operation targets.
+    kNumWaitClasses,
+};
+
+constexpr size_t kNumWaitClasses = static_cast<size_t>(WaitClass::kNumWaitClasses);
+
+StringData toString(WaitClass waitClass);
+
+/**
+ * The time an operation has spent blocked in each wait class. It can be read while the operation
+ * runs, for instance by currentOp.
+ */
+class OperationWaitTimes {
+    OperationWaitTimes(const OperationWaitTimes&) = delete;
+    OperationWaitTimes& operator=(const OperationWaitTimes&) = delete;
+
+public:
+    static const OperationContext::Decoration<OperationWaitTimes> get;
+
+    OperationWaitTimes() = default;
+
+    Microseconds getWaitTime(WaitClass waitClass) const {
+        return Microseconds(_micros[static_cast<size_t>(waitClass)].loadRelaxed());
+    }
+
+    /**
+     * Appends the time spent in each wait class the operation has waited on, in microseconds.
+     */
+    void appendNonZero(BSONObjBuilder* builder) const;
+
+private:
+    friend void recordWaitTime(OperationContext* opCtx, WaitClass waitClass, Microseconds elapsed);
+
+    std::array<AtomicWord<long long>, kNumWaitClasses> _micros{};
+};
+
+/**
+ * Charges 'elapsed' to the 'waitClass' time of 'opCtx', if not null, and of the whole server.
+ */
+void recordWaitTime(OperationContext* opCtx, WaitClass waitClass, Microseconds elapsed);
+
+/**
+ * Appends, for each wait class, the number of waits and the total time spent in them since the
+ * server started.
+ */
+void appendGlobalWaitTimes(BSONObjBuilder* builder);
+
+/**
+ * Times the scope it lives in, and charges it to the 'waitClass' time of 'opCtx', if not null, and
+ * of the whole server.
+ */
+class WaitEventTimer {
+    WaitEventTimer(const WaitEventTimer&) = delete;
+    WaitEventTimer& operator=(const WaitEventTimer&) = delete;
+
+public:
+    WaitEventTimer(OperationContext* opCtx, WaitClass waitClass)
+        : _opCtx(opCtx),
+          _waitClass(waitClass),
+          _tickSource(opCtx ? opCtx->getServiceContext()->getTickSource()
+                            : SystemTickSource::get()),
+          _start(_tickSource->getTicks()) {}
+
+    ~WaitEventTimer() {
+        recordWaitTime(_opCtx,
+                       _waitClass,
+                       _tickSource->ticksTo<Microseconds>(_tickSource->getTicks() - _start));
+    }
+
+private:
+    OperationContext* const _opCtx;
+    const WaitClass _waitClass;
+    TickSource* const _tickSource;
+    const TickSource::Tick _start;
+};
+
+}  // namespace mongo
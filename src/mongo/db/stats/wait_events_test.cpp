@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_events.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/tick_source_mock.h"
+
+namespace mongo {
+namespace {
+
+class WaitEventsTest : public ServiceContextTest {
+public:
+    WaitEventsTest() {
+        auto tickSource = std::make_unique<TickSourceMock<Microseconds>>();
+        _tickSource = tickSource.get();
+        getServiceContext()->setTickSource(std::move(tickSource));
+    }
+
+    BSONObj globalWaitTimes() {
+        BSONObjBuilder builder;
+        appendGlobalWaitTimes(&builder);
+        return builder.obj();
+    }
+
+    TickSourceMock<Microseconds>* _tickSource;
+};
+
+TEST_F(WaitEventsTest, ChargesWaitsToTheOperationAndTheServer) {
+    auto opCtx = makeOperationContext();
+    auto before = globalWaitTimes();
+
+    recordWaitTime(opCtx.get(), WaitClass::kLock, Microseconds(10));
+    recordWaitTime(opCtx.get(), WaitClass::kLock, Microseconds(5));
+    recordWaitTime(nullptr, WaitClass::kTicket, Microseconds(7));
+    {
+        WaitEventTimer waitTimer(opCtx.get(), WaitClass::kReplication);
+        _tickSource->advance(Microseconds(100));
+    }
+
+    auto& waitTimes = OperationWaitTimes::get(opCtx.get());
+    ASSERT_EQ(Microseconds(15), waitTimes.getWaitTime(WaitClass::kLock));
+    ASSERT_EQ(Microseconds(0), waitTimes.getWaitTime(WaitClass::kTicket));
+    ASSERT_EQ(Microseconds(100), waitTimes.getWaitTime(WaitClass::kReplication));
+
+    BSONObjBuilder builder;
+    waitTimes.appendNonZero(&builder);
+    ASSERT_BSONOBJ_EQ(BSON("lock" << 15LL << "replication" << 100LL), builder.obj());
+
+    auto after = globalWaitTimes();
+    auto delta = [&](StringData waitClass, StringData field) {
+        return after[waitClass][field].numberLong() - before[waitClass][field].numberLong();
+    };
+    ASSERT_EQ(2, delta("lock", "count"));
+    ASSERT_EQ(15, delta("lock", "totalMicros"));
+    ASSERT_EQ(1, delta("ticket", "count"));
+    ASSERT_EQ(7, delta("ticket", "totalMicros"));
+    ASSERT_EQ(1, delta("replication", "count"));
+    ASSERT_EQ(100, delta("replication", "totalMicros"));
+    ASSERT_EQ(0, delta("journalFlush", "count"));
+}
+
+TEST_F(WaitEventsTest, ReportsEveryWaitClass) {
+    auto stats = globalWaitTimes();
+    ASSERT_EQ(static_cast<int>(kNumWaitClasses), stats.nFields());
+    for (size_t i = 0; i < kNumWaitClasses; ++i) {
+        ASSERT_TRUE(stats.hasField(toString(static_cast<WaitClass>(i))));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -35,7 +35,10 @@
 
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
@@ -48,6 +51,13 @@ const auto getCheckpointer = ServiceContext::declareDecoration<std::unique_ptr<C
 
 MONGO_FAIL_POINT_DEFINE(pauseCheckpointThread);
 
+// How often the checkpoint pressure is polled while a trigger threshold is set.
+const Seconds kCheckpointPressurePollInterval{1};
+
+bool pressureTriggersEnabled() {
+    return gCheckpointDirtyCacheTriggerMB.load() > 0 || gCheckpointJournalTriggerMB.load() > 0;
+}
+
 }  // namespace
 
 Checkpointer* Checkpointer::get(ServiceContext* serviceCtx) {
@@ -73,17 +83,40 @@ void Checkpointer::run() {
 
     while (true) {
         auto opCtx = tc->makeOperationContext();
+        Trigger trigger = Trigger::kPeriodic;
 
         {
             stdx::unique_lock<Latch> lock(_mutex);
             MONGO_IDLE_THREAD_BLOCK;
 
             // Wait for 'storageGlobalParams.checkpointDelaySecs' seconds; or until either shutdown
-            // is signaled or a checkpoint is triggered.
-            _sleepCV.wait_for(lock,
-                              stdx::chrono::seconds(static_cast<std::int64_t>(
-                                  storageGlobalParams.checkpointDelaySecs)),
-                              [&] { return _shuttingDown || _triggerCheckpoint; });
+            // is signaled, a checkpoint is triggered, or the checkpoint pressure reaches one of the
+            // trigger thresholds.
+            const Date_t deadline = Date_t::now() +
+                Seconds(static_cast<std::int64_t>(storageGlobalParams.checkpointDelaySecs));
+            while (!_shuttingDown && !_triggerCheckpoint &&
+                   storageGlobalParams.checkpointDelaySecs != 0) {
+                const Date_t now = Date_t::now();
+                if (now >= deadline) {
+                    break;
+                }
+
+                if (pressureTriggersEnabled()) {
+                    lock.unlock();
+                    auto pressureTrigger = _checkPressure();
+                    lock.lock();
+                    if (pressureTrigger) {
+                        trigger = *pressureTrigger;
+                        break;
+                    }
+                }
+
+                // Wake up periodically even without thresholds, as they can be set at runtime.
+                const Date_t wakeup = std::min(deadline, now + kCheckpointPressurePollInterval);
+                _sleepCV.wait_until(lock, wakeup.toSystemTimePoint(), [&] {
+                    return _shuttingDown || _triggerCheckpoint;
+                });
+            }
 
             // If the checkpointDelaySecs is set to 0, that means we should skip checkpointing.
             // However, checkpointDelaySecs is adjustable by a runtime server parameter, so we
@@ -105,25 +138,83 @@ void Checkpointer::run() {
                 return;
             }
 
+            if (_triggerCheckpoint) {
+                trigger = Trigger::kRequested;
+            }
+
             // Clear the trigger so we do not immediately checkpoint again after this.
             _triggerCheckpoint = false;
         }
 
         pauseCheckpointThread.pauseWhileSet();
 
+        // TODO SERVER-50861: Access the storage engine via the ServiceContext.
+        const auto pressure = _kvEngine->getCheckpointPressure();
         const Date_t startTime = Date_t::now();
 
-        // TODO SERVER-50861: Access the storage engine via the ServiceContext.
         _kvEngine->checkpoint();
 
-        const auto secondsElapsed = durationCount<Seconds>(Date_t::now() - startTime);
+        const auto elapsed = Date_t::now() - startTime;
+        const auto secondsElapsed = durationCount<Seconds>(elapsed);
         if (secondsElapsed >= 30) {
             LOGV2_DEBUG(22308,
                         1,
                         "Checkpoint was slow to complete",
                         "secondsElapsed"_attr = secondsElapsed);
         }
+
+        stdx::lock_guard<Latch> lock(_mutex);
+        switch (trigger) {
+            case Trigger::kPeriodic:
+                ++_periodicCheckpoints;
+                break;
+            case Trigger::kDirtyCache:
+                ++_dirtyCacheCheckpoints;
+                break;
+            case Trigger::kJournal:
+                ++_journalCheckpoints;
+                break;
+            case Trigger::kRequested:
+                ++_requestedCheckpoints;
+                break;
+        }
+        _lastCheckpointDuration = elapsed;
+        _totalCheckpointDuration += elapsed;
+        _lastCheckpointDirtyCacheBytes = pressure ? pressure->dirtyCacheBytes : 0;
+        _lastCheckpointJournalBytes = pressure ? pressure->journalBytesSinceCheckpoint : 0;
+    }
+}
+
+boost::optional<Checkpointer::Trigger> Checkpointer::_checkPressure() {
+    const auto pressure = _kvEngine->getCheckpointPressure();
+    if (!pressure) {
+        return boost::none;
     }
+
+    const long long kMB = 1024 * 1024;
+    const long long dirtyCacheTriggerMB = gCheckpointDirtyCacheTriggerMB.load();
+    if (dirtyCacheTriggerMB > 0 && pressure->dirtyCacheBytes >= dirtyCacheTriggerMB * kMB) {
+        return Trigger::kDirtyCache;
+    }
+    const long long journalTriggerMB = gCheckpointJournalTriggerMB.load();
+    if (journalTriggerMB > 0 && pressure->journalBytesSinceCheckpoint >= journalTriggerMB * kMB) {
+        return Trigger::kJournal;
+    }
+    return boost::none;
+}
+
+void Checkpointer::appendStats(BSONObjBuilder* builder) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    BSONObjBuilder triggers(builder->subobjStart("checkpoints"));
+    triggers.append("periodic", _periodicCheckpoints);
+    triggers.append("dirtyCache", _dirtyCacheCheckpoints);
+    triggers.append("journal", _journalCheckpoints);
+    triggers.append("requested", _requestedCheckpoints);
+    triggers.done();
+    builder->append("lastDurationMillis", durationCount<Milliseconds>(_lastCheckpointDuration));
+    builder->append("totalDurationMillis", durationCount<Milliseconds>(_totalCheckpointDuration));
+    builder->append("lastDirtyCacheBytes", _lastCheckpointDirtyCacheBytes);
+    builder->append("lastJournalBytes", _lastCheckpointJournalBytes);
 }
 
 void Checkpointer::triggerFirstStableCheckpoint(Timestamp prevStable,
@@ -29,12 +29,16 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/background.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class KVEngine;
 class OperationContext;
 class ServiceContext;
@@ -60,6 +64,9 @@ public:
 
     /**
      * Starts the checkpoint thread that runs every storageGlobalParams.checkpointDelaySecs seconds.
+     * In between, it checkpoints early once the KVEngine's checkpoint pressure reaches the
+     * 'checkpointDirtyCacheTriggerMB' or 'checkpointJournalTriggerMB' thresholds, which are polled
+     * every second when set.
      */
     void run() override;
 
@@ -87,7 +94,20 @@ public:
      */
     void shutdown(const Status& reason);
 
+    /**
+     * Appends statistics about the checkpoints taken by this thread, for serverStatus.
+     */
+    void appendStats(BSONObjBuilder* builder);
+
 private:
+    enum class Trigger { kPeriodic, kDirtyCache, kJournal, kRequested };
+
+    /**
+     * Returns the trigger whose threshold the KVEngine's checkpoint pressure has reached, if any.
+     * Must be called without '_mutex' held.
+     */
+    boost::optional<Trigger> _checkPressure();
+
     // A pointer to the KVEngine is maintained only due to unit testing limitations that don't fully
     // setup the ServiceContext.
     // TODO SERVER-50861: Remove this pointer.
@@ -109,6 +129,17 @@ private:
 
     // This flag allows the checkpoint thread to wake up early when _sleepCV is signaled.
     bool _triggerCheckpoint;
+
+    // Statistics of the checkpoints taken, by what triggered them.
+    long long _periodicCheckpoints = 0;
+    long long _dirtyCacheCheckpoints = 0;
+    long long _journalCheckpoints = 0;
+    long long _requestedCheckpoints = 0;
+    Milliseconds _lastCheckpointDuration{0};
+    Milliseconds _totalCheckpointDuration{0};
+    // The checkpoint pressure when the last checkpoint started, an estimate of what it wrote out.
+    long long _lastCheckpointDirtyCacheBytes = 0;
+    long long _lastCheckpointJournalBytes = 0;
 };
 
 }  // namespace mongo
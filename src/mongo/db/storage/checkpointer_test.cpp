@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/checkpointer.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/db/storage/devnull/devnull_kv_engine.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/str.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * A KVEngine whose checkpoint pressure is set by the test.
+ */
+class CheckpointPressureKVEngine : public DevNullKVEngine {
+public:
+    bool supportsCheckpoints() const override {
+        return true;
+    }
+
+    boost::optional<CheckpointPressure> getCheckpointPressure() override {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _pressure;
+    }
+
+    void setCheckpointPressure(long long dirtyCacheBytes, long long journalBytes) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _pressure.dirtyCacheBytes = dirtyCacheBytes;
+        _pressure.journalBytesSinceCheckpoint = journalBytes;
+    }
+
+    void checkpoint() override {
+        // Like a real checkpoint, this writes out the dirty data and restarts the journal count.
+        setCheckpointPressure(0, 0);
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("CheckpointPressureKVEngine::_mutex");
+    CheckpointPressure _pressure;
+};
+
+class CheckpointerTest : public ScopedGlobalServiceContextForTest, public unittest::Test {
+public:
+    void setUp() override {
+        // The periodic checkpoint is far enough away that only the pressure triggers can fire.
+        _stashedCheckpointDelaySecs = std::exchange(storageGlobalParams.checkpointDelaySecs, 3600);
+        _checkpointer = std::make_unique<Checkpointer>(&_engine);
+        _checkpointer->go();
+    }
+
+    void tearDown() override {
+        _checkpointer->shutdown({ErrorCodes::ShutdownInProgress, "Test finished"});
+        storageGlobalParams.checkpointDelaySecs = _stashedCheckpointDelaySecs;
+        gCheckpointDirtyCacheTriggerMB.store(0);
+        gCheckpointJournalTriggerMB.store(0);
+    }
+
+    BSONObj checkpointCounts() {
+        BSONObjBuilder builder;
+        _checkpointer->appendStats(&builder);
+        return builder.obj()["checkpoints"].Obj().getOwned();
+    }
+
+    /**
+     * Waits up to 10 seconds for the checkpoint count of the 'trigger' field to reach 'expected'.
+     */
+    void waitForCheckpoints(StringData trigger, long long expected) {
+        for (int i = 0; i < 100; ++i) {
+            if (checkpointCounts()[trigger].numberLong() >= expected) {
+                return;
+            }
+            sleepmillis(100);
+        }
+        FAIL(str::stream() << "Timed out waiting for " << expected << " '" << trigger
+                           << "' checkpoints: " << checkpointCounts());
+    }
+
+protected:
+    CheckpointPressureKVEngine _engine;
+    std::unique_ptr<Checkpointer> _checkpointer;
+
+private:
+    size_t _stashedCheckpointDelaySecs;
+};
+
+const long long kMB = 1024 * 1024;
+
+TEST_F(CheckpointerTest, DirtyCacheTriggersCheckpoint) {
+    _engine.setCheckpointPressure(3 * kMB, 0);
+    gCheckpointDirtyCacheTriggerMB.store(2);
+    waitForCheckpoints("dirtyCache", 1);
+
+    BSONObjBuilder builder;
+    _checkpointer->appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(3 * kMB, stats["lastDirtyCacheBytes"].numberLong()) << stats;
+    ASSERT_EQ(0, stats["checkpoints"]["periodic"].numberLong()) << stats;
+    ASSERT_EQ(0, stats["checkpoints"]["journal"].numberLong()) << stats;
+}
+
+TEST_F(CheckpointerTest, JournalTriggersCheckpoint) {
+    gCheckpointJournalTriggerMB.store(2);
+
+    // Below the threshold, no checkpoint is taken.
+    _engine.setCheckpointPressure(0, kMB);
+    sleepsecs(2);
+    ASSERT_EQ(0, checkpointCounts()["journal"].numberLong());
+
+    _engine.setCheckpointPressure(0, 2 * kMB);
+    waitForCheckpoints("journal", 1);
+    ASSERT_EQ(0, checkpointCounts()["dirtyCache"].numberLong());
+}
+
+TEST_F(CheckpointerTest, PressureIgnoredWithoutTriggers) {
+    _engine.setCheckpointPressure(100 * kMB, 100 * kMB);
+    sleepsecs(2);
+    auto counts = checkpointCounts();
+    ASSERT_EQ(0, counts["dirtyCache"].numberLong()) << counts;
+    ASSERT_EQ(0, counts["journal"].numberLong()) << counts;
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/clustered_key.h"
+
+#include <cmath>
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/util/debug_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace clustered_key {
+
+boost::optional<RecordId> keyForId(const BSONElement& id) {
+    long long repr;
+    switch (id.type()) {
+        case NumberInt:
+        case NumberLong:
+            repr = id.numberLong();
+            break;
+        case NumberDouble: {
+            const double value = id.numberDouble();
+            if (!(value >= 1 && value < static_cast<double>(RecordId::kMinReservedRepr)) ||
+                std::trunc(value) != value) {
+                return boost::none;
+            }
+            repr = static_cast<long long>(value);
+            break;
+        }
+        case NumberDecimal: {
+            std::uint32_t signalingFlags = Decimal128::SignalingFlag::kNoFlag;
+            repr = id.numberDecimal().toLongExact(&signalingFlags);
+            if (signalingFlags != Decimal128::SignalingFlag::kNoFlag) {
+                return boost::none;
+            }
+            break;
+        }
+        default:
+            return boost::none;
+    }
+
+    const RecordId out(repr);
+    if (!out.isNormal()) {
+        return boost::none;
+    }
+    return out;
+}
+
+StatusWith<RecordId> extractKey(const char* data, int len) {
+    if (kDebugBuild)
+        invariant(validateBSON(data, len).isOK());
+
+    const BSONObj obj(data);
+    const BSONElement elem = obj["_id"];
+    if (elem.eoo())
+        return StatusWith<RecordId>(ErrorCodes::BadValue, "no _id field");
+
+    auto key = keyForId(elem);
+    if (!key) {
+        return StatusWith<RecordId>(ErrorCodes::BadValue,
+                                    str::stream()
+                                        << "the _id of a document in a clustered collection must "
+                                           "be a positive 64-bit integer, found: "
+                                        << elem.toString(false));
+    }
+    return *key;
+}
+
+}  // namespace clustered_key
+}  // namespace mongo
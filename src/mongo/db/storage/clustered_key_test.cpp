@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/clustered_key.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+boost::optional<RecordId> keyFor(const BSONObj& obj) {
+    return clustered_key::keyForId(obj["_id"]);
+}
+
+TEST(ClusteredKeyTest, EqualNumbersMapToTheSameKey) {
+    ASSERT_EQ(RecordId(5), *keyFor(BSON("_id" << 5)));
+    ASSERT_EQ(RecordId(5), *keyFor(BSON("_id" << 5LL)));
+    ASSERT_EQ(RecordId(5), *keyFor(BSON("_id" << 5.0)));
+    ASSERT_EQ(RecordId(5), *keyFor(BSON("_id" << Decimal128("5.00"))));
+}
+
+TEST(ClusteredKeyTest, KeysFollowTheOrderOfTheIds) {
+    ASSERT_LT(*keyFor(BSON("_id" << 2)), *keyFor(BSON("_id" << 10LL)));
+    ASSERT_LT(*keyFor(BSON("_id" << 1)), *keyFor(BSON("_id" << (1LL << 40))));
+}
+
+TEST(ClusteredKeyTest, IdsWhichCannotBeKeysAreRejected) {
+    ASSERT_FALSE(keyFor(BSON("_id" << 0)));
+    ASSERT_FALSE(keyFor(BSON("_id" << -1)));
+    ASSERT_FALSE(keyFor(BSON("_id" << 1.5)));
+    ASSERT_FALSE(keyFor(BSON("_id" << Decimal128("2.5"))));
+    ASSERT_FALSE(keyFor(BSON("_id" << RecordId::kMinReservedRepr)));
+    ASSERT_FALSE(keyFor(BSON("_id" << std::numeric_limits<double>::quiet_NaN())));
+    ASSERT_FALSE(keyFor(BSON("_id" << 1e300)));
+    ASSERT_FALSE(keyFor(BSON("_id"
+                             << "1")));
+    ASSERT_FALSE(keyFor(BSON("_id" << OID::gen())));
+}
+
+TEST(ClusteredKeyTest, ExtractKeyRequiresAnIntegralId) {
+    BSONObj doc = BSON("_id" << 42 << "x" << 1);
+    auto swKey = clustered_key::extractKey(doc.objdata(), doc.objsize());
+    ASSERT_OK(swKey.getStatus());
+    ASSERT_EQ(RecordId(42), swKey.getValue());
+
+    doc = BSON("x" << 1);
+    ASSERT_EQ(ErrorCodes::BadValue,
+              clustered_key::extractKey(doc.objdata(), doc.objsize()).getStatus());
+
+    doc = BSON("_id" << OID::gen());
+    ASSERT_EQ(ErrorCodes::BadValue,
+              clustered_key::extractKey(doc.objdata(), doc.objsize()).getStatus());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -447,10 +447,15 @@ std::string DurableCatalogImpl::getFilesystemPathForDb(const std::string& dbName
     }
 }
 
-std::string DurableCatalogImpl::_newUniqueIdent(NamespaceString nss, const char* kind) {
+std::string DurableCatalogImpl::_newUniqueIdent(NamespaceString nss,
+                                                const char* kind,
+                                                StringData storageTier) {
     // If this changes to not put _rand at the end, _hasEntryCollidingWithRand will need fixing.
     stdx::lock_guard<Latch> lk(_randLock);
     StringBuilder buf;
+    if (!storageTier.empty()) {
+        buf << "tier-" << storageTier << '/';
+    }
     if (_directoryPerDb) {
         buf << escapeDbName(nss.db()) << '/';
     }
@@ -532,7 +537,7 @@ StatusWith<DurableCatalog::Entry> DurableCatalogImpl::_addEntry(OperationContext
                                                                 KVPrefix prefix) {
     invariant(opCtx->lockState()->isDbLockedForMode(nss.db(), MODE_IX));
 
-    const string ident = _newUniqueIdent(nss, "collection");
+    const string ident = _newUniqueIdent(nss, "collection", options.storageTier);
 
     BSONObj obj;
     {
@@ -648,7 +653,7 @@ void DurableCatalogImpl::putMetaData(OperationContext* opCtx,
                 continue;
             }
             // missing, create new
-            newIdentMap.append(name, _newUniqueIdent(nss, "index"));
+            newIdentMap.append(name, _newUniqueIdent(nss, "index", md.options.storageTier));
         }
         b.append("idxIdent", newIdentMap.obj());
 
@@ -246,8 +246,9 @@ private:
      * Generates a new unique identifier for a new "thing".
      * @param nss - the containing namespace
      * @param kind - what this "thing" is, likely collection or index
+     * @param storageTier - the tier directory to place the "thing" under, empty for the default
      */
-    std::string _newUniqueIdent(NamespaceString nss, const char* kind);
+    std::string _newUniqueIdent(NamespaceString nss, const char* kind, StringData storageTier);
 
     std::string _newInternalIdent(StringData identStem);
 
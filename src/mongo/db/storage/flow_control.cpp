@@ -221,6 +221,15 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLagged", _isLagged.load());
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
+    {
+        // As with locksPerOp, scale the controller state so FTDC keeps its significant figures.
+        BSONObjBuilder controller(bob.subobjStart("lagController"));
+        controller.append("enabled", gFlowControlUseLagController.load());
+        controller.append("thresholdLagMillis", static_cast<long long>(getThresholdLagMillis()));
+        controller.append("errorPerKilo", _lagControllerError.load() * 1000);
+        controller.append("accumulatedErrorPerKilo", _lagControllerAccumulatedError.load() * 1000);
+        controller.append("outputPerKilo", _lagControllerOutput.load() * 1000);
+    }
 
     return bob.obj();
 }
@@ -291,6 +300,11 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
         return std::min(static_cast<int>(locksUsedLastPeriod / 2.0), kMaxTickets);
     }
 
+    if (gFlowControlUseLagController.load()) {
+        return _calculateNewTicketsWithLagController(
+            sustainerAppliedCount, locksPerOp, lagMillis, thresholdLagMillis);
+    }
+
     // Given a "sustainer rate", this function wants to calculate what fraction the primary should
     // accept writes at to allow secondaries to catch up.
     //
@@ -326,6 +340,52 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
     return multiplyWithOverflowCheck(locksPerOp, sustainerAppliedPenalty, kMaxTickets);
 }
 
+int FlowControl::_calculateNewTicketsWithLagController(std::int64_t sustainerAppliedCount,
+                                                       double locksPerOp,
+                                                       std::uint64_t lagMillis,
+                                                       std::uint64_t thresholdLagMillis) {
+    invariant(lagMillis >= thresholdLagMillis);
+    invariant(sustainerAppliedCount >= 0);
+
+    // The sustainer rate is the rate at which the majority of the replica set is applying writes.
+    // Granting tickets at exactly that rate holds the commit point lag steady, so the controller
+    // outputs the fraction of the sustainer rate to grant. The proportional term reacts to how far
+    // the lag is above the threshold. The integral term keeps reducing the rate for as long as the
+    // lag has not been brought back under the threshold, which the proportional term alone cannot
+    // guarantee when secondaries consistently apply slower than the primary accepts writes.
+    const double error = static_cast<double>(lagMillis - thresholdLagMillis) /
+        static_cast<double>(thresholdLagMillis);
+    const double proportionalGain = gFlowControlLagControllerProportionalGain.load();
+    const double integralGain = gFlowControlLagControllerIntegralGain.load();
+
+    // Limit the accumulated error to what can bring the output to zero on its own, so a long lagged
+    // period does not keep the rate throttled after the lag has started to recover.
+    double accumulatedError = _lagControllerAccumulatedError.load() + error;
+    if (integralGain > 0.0) {
+        accumulatedError = std::min(accumulatedError, 1.0 / integralGain);
+    }
+
+    const double output =
+        std::clamp(1.0 - proportionalGain * error - integralGain * accumulatedError, 0.0, 1.0);
+
+    _lagControllerError.store(error);
+    _lagControllerAccumulatedError.store(accumulatedError);
+    _lagControllerOutput.store(output);
+
+    LOGV2_DEBUG(5843215,
+                DEBUG_LOG_LEVEL,
+                "Flow control lag controller",
+                "sustainerAppliedCount"_attr = sustainerAppliedCount,
+                "lagMillis"_attr = lagMillis,
+                "thresholdLagMillis"_attr = thresholdLagMillis,
+                "error"_attr = error,
+                "accumulatedError"_attr = accumulatedError,
+                "output"_attr = output);
+
+    return multiplyWithOverflowCheck(
+        locksPerOp, static_cast<double>(sustainerAppliedCount) * output, kMaxTickets);
+}
+
 int FlowControl::getNumTickets(Date_t now) {
     // Flow control can be disabled until a certain deadline is passed.
     const Date_t disabledUntil = _disableUntil.load();
@@ -383,6 +443,9 @@ int FlowControl::getNumTickets(Date_t now) {
                                         gFlowControlTicketMultiplierConstant.load(),
                                         kMaxTickets);
         _lastTimeSustainerAdvanced = Date_t::now();
+        _lagControllerError.store(0.0);
+        _lagControllerAccumulatedError.store(0.0);
+        _lagControllerOutput.store(1.0);
         if (_isLagged.load()) {
             _isLagged.store(false);
             auto waitTime = curTimeMicros64() - _startWaitTime;
@@ -132,6 +132,10 @@ public:
                                    double locksPerOp,
                                    std::uint64_t lagMillis,
                                    std::uint64_t thresholdLagMillis);
+    int _calculateNewTicketsWithLagController(std::int64_t sustainerAppliedCount,
+                                              double locksPerOp,
+                                              std::uint64_t lagMillis,
+                                              std::uint64_t thresholdLagMillis);
     void _trimSamples(const Timestamp trimSamplesTo);
 
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
@@ -155,6 +159,12 @@ private:
     AtomicWord<std::int64_t> _isLaggedTimeMicros{0};
     AtomicWord<Date_t> _disableUntil;
 
+    // State of the lag controller. The error and the accumulated error are expressed in multiples
+    // of the threshold lag, the output as the fraction of the sustainer rate that is granted.
+    AtomicWord<double> _lagControllerError{0.0};
+    AtomicWord<double> _lagControllerAccumulatedError{0.0};
+    AtomicWord<double> _lagControllerOutput{1.0};
+
     mutable Mutex _sampledOpsMutex = MONGO_MAKE_LATCH("FlowControl::_sampledOpsMutex");
     std::deque<Sample> _sampledOpsApplied;
 
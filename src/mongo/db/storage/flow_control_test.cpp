@@ -40,6 +40,7 @@
 #include "mongo/db/storage/flow_control_parameters_gen.h"
 #include "mongo/logv2/log_debug.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -266,6 +267,64 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       thresholdLag));
 }
 
+TEST_F(FlowControlTest, CalculatingTicketsWithLagController) {
+    // Use the same topology as above: the sustainer node applied 1,000 operations in the last
+    // period and each operation takes 2.0 locks.
+    gFlowControlUseLagController.store(true);
+    ON_BLOCK_EXIT([] { gFlowControlUseLagController.store(false); });
+    gFlowControlLagControllerProportionalGain.store(0.5);
+    gFlowControlLagControllerIntegralGain.store(0.1);
+
+    auto constructMemberData = [](Timestamp ts) -> repl::MemberData {
+        repl::MemberData ret;
+        ret.setLastAppliedOpTimeAndWallTime({{ts, 1}, Date_t()}, Date_t());
+        return ret;
+    };
+
+    std::vector<repl::MemberData> prevMemberData;
+    std::vector<repl::MemberData> currMemberData;
+    for (auto ts : {2000, 2000, 3000}) {
+        prevMemberData.emplace_back(constructMemberData(Timestamp(1000)));
+        currMemberData.emplace_back(constructMemberData(Timestamp(ts)));
+    }
+
+    for (int ts = 1; ts <= 3000; ++ts) {
+        flowControl->sample(Timestamp(ts), 1);
+    }
+
+    const std::int64_t locksUsedLastPeriod = -1;  // Irrelevant to this call.
+    const double locksPerOp = 2.0;
+    const std::uint64_t thresholdLag = 1000;
+    auto calculate = [&](std::uint64_t currLag) {
+        return flowControl->_calculateNewTicketsForLag(prevMemberData,
+                                                       currMemberData,
+                                                       locksUsedLastPeriod,
+                                                       locksPerOp,
+                                                       currLag,
+                                                       thresholdLag);
+    };
+
+    // At the threshold, with nothing accumulated yet, the primary tracks the sustainer rate.
+    ASSERT_EQ(2000, calculate(thresholdLag));
+
+    // At twice the threshold the error is 1.0: 1.0 - 0.5 * 1.0 - 0.1 * 1.0 = 0.4.
+    ASSERT_EQ(800, calculate(2 * thresholdLag));
+
+    // Staying lagged keeps reducing the rate through the accumulated error.
+    ASSERT_EQ(600, calculate(2 * thresholdLag));
+
+    auto serverStatus = flowControl->generateSection(opCtx.get(), BSONElement());
+    auto controller = serverStatus["lagController"].Obj();
+    ASSERT_TRUE(controller["enabled"].Bool());
+    ASSERT_EQ(1000, controller["errorPerKilo"].Double());
+    ASSERT_EQ(2000, controller["accumulatedErrorPerKilo"].Double());
+    ASSERT_APPROX_EQUAL(300, controller["outputPerKilo"].Double(), 1e-9);
+
+    // A lag far above the threshold throttles down to zero, before the minimum ticket floor that
+    // `getNumTickets` applies.
+    ASSERT_EQ(0, calculate(10 * thresholdLag));
+}
+
 TEST_F(FlowControlTest, DisableUntil) {
     const int ticketOverride = 52319;
 
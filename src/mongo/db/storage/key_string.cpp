@@ -2409,7 +2409,11 @@ Discriminator decodeDiscriminator(const char* buffer,
 }
 
 BSONObj toBsonSafe(const char* buffer, size_t len, Ordering ord, const TypeBits& typeBits) {
-    BSONObjBuilder builder;
+    // Size the buffer from the KeyString rather than allocate the default 512 bytes, as decoded
+    // keys are usually far smaller and may be held for a while, e.g. by covered plans or by sorts
+    // over index keys. Each component gains a type byte and an empty field name and small numbers
+    // widen when decoded, so the buffer seldom needs to grow from twice the KeyString's length.
+    BSONObjBuilder builder(static_cast<int>(2 * len + 16));
     BufReader reader(buffer, len);
     TypeBits::Reader typeBitsReader(typeBits);
     for (int i = 0; reader.remaining(); i++) {
@@ -575,6 +575,27 @@ public:
         memcpy(_buffer().skip(size), buffer, size);
     }
 
+    /**
+     * Resets to the elements appended so far to 'prefix', so that keys which share their leading
+     * components need only encode those components once. Nothing but BSON elements may have been
+     * appended to 'prefix'.
+     * Equivalent to but faster than resetting to empty and re-appending the same elements.
+     */
+    template <class OtherBuilderT>
+    void resetFromPrefix(const BuilderBase<OtherBuilderT>& prefix) {
+        invariant(prefix._state == BuildState::kEmpty ||
+                  prefix._state == BuildState::kAppendingBSONElements);
+        invariant(version == prefix.version);
+        _reinstantiateBufferIfNeeded();
+        resetFromBuffer(prefix.getBuffer(), prefix.getSize());
+        _typeBits = prefix._typeBits;
+
+        _elemCount = prefix._elemCount;
+        _ordering = prefix._ordering;
+        _discriminator = prefix._discriminator;
+        _state = prefix._state;
+    }
+
     const char* getBuffer() const {
         invariant(_state != BuildState::kReleased);
         return _buffer().buf();
@@ -618,6 +639,9 @@ public:
     const Version version;
 
 protected:
+    template <class>
+    friend class BuilderBase;
+
     void _appendAllElementsForIndexing(const BSONObj& obj, Discriminator discriminator);
 
     void _appendBool(bool val, bool invert);
@@ -35,6 +35,7 @@
 #include <random>
 #include <vector>
 
+#include "mongo/db/exec/sbe/values/slot.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/platform/decimal128.h"
 #include "mongo/util/bufreader.h"
@@ -207,6 +208,44 @@ void BM_KeyStringStackBuilderCopy(benchmark::State& state, BsonValueType bsonTyp
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+// Builds the compound keys {"": <element>, "": <i>} for each element of the sample, as an index
+// on a scalar field followed by an array field would for a multikey document. The leading component
+// is either encoded again for every key, or once up front and reused from a prefix.
+void BM_KeyStringCompoundKeys(benchmark::State& state,
+                              BsonValueType bsonType,
+                              bool reusePrefix) {
+    // The KeyString version does not matter for this test.
+    const auto version = KeyString::Version::V1;
+    const BsonsAndKeyStrings bsonsAndKeyStrings = generateBsonsAndKeyStrings(bsonType, version);
+    const int kNumArrayElements = 10;
+    std::vector<BSONObj> arrayElements;
+    for (int i = 0; i < kNumArrayElements; i++) {
+        arrayElements.push_back(BSON("" << i));
+    }
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (size_t i = 0; i < kSampleSize; i++) {
+            const BSONElement leading = bsonsAndKeyStrings.bsons[i].firstElement();
+            KeyString::Builder prefix(version, ALL_ASCENDING);
+            if (reusePrefix) {
+                prefix.appendBSONElement(leading);
+            }
+            for (const auto& arrayElement : arrayElements) {
+                KeyString::HeapBuilder builder(version, ALL_ASCENDING);
+                if (reusePrefix) {
+                    builder.resetFromPrefix(prefix);
+                } else {
+                    builder.appendBSONElement(leading);
+                }
+                builder.appendBSONElement(arrayElement.firstElement());
+                benchmark::DoNotOptimize(builder.release());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kSampleSize * kNumArrayElements);
+}
+
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Int, INT);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Double, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Decimal, DECIMAL);
@@ -225,6 +264,13 @@ BENCHMARK_CAPTURE(BM_KeyStringStackBuilderCopy, Decimal, DECIMAL);
 BENCHMARK_CAPTURE(BM_KeyStringStackBuilderCopy, String, STRING);
 BENCHMARK_CAPTURE(BM_KeyStringStackBuilderCopy, Array, ARRAY);
 
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeys, Int, INT, false);
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeys, Int_ReusePrefix, INT, true);
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeys, String, STRING, false);
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeys, String_ReusePrefix, STRING, true);
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeys, Array, ARRAY, false);
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeys, Array_ReusePrefix, ARRAY, true);
+
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Int, KeyString::Version::V0, INT);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Int, KeyString::Version::V1, INT);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Double, KeyString::Version::V0, DOUBLE);
@@ -235,6 +281,47 @@ BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_String, KeyString::Version::V1, STRING)
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Array, KeyString::Version::V1, ARRAY);
 
+// Decodes the compound keys {"": <element>, "": <i>, "": <i>} into BSON, as the classic engine does
+// for each key returned by an index scan, or into SBE values for either all of their components or
+// only the leading one, as an SBE index scan does when only the leading field is needed.
+void BM_KeyStringCompoundKeysDecode(benchmark::State& state,
+                                    BsonValueType bsonType,
+                                    int numComponentsToSBE) {
+    // The KeyString version does not matter for this test.
+    const auto version = KeyString::Version::V1;
+    const BsonsAndKeyStrings bsonsAndKeyStrings = generateBsonsAndKeyStrings(bsonType, version);
+
+    std::vector<KeyString::Value> values;
+    for (size_t i = 0; i < kSampleSize; i++) {
+        BSONObj key = BSON("" << bsonsAndKeyStrings.bsons[i].firstElement() << ""
+                              << static_cast<int>(i) << "" << static_cast<int>(i));
+        KeyString::HeapBuilder builder(version, key, ALL_ASCENDING);
+        values.emplace_back(builder.release());
+    }
+
+    sbe::IndexKeysInclusionSet indexKeysToInclude;
+    for (int i = 0; i < numComponentsToSBE; i++) {
+        indexKeysToInclude.set(i);
+    }
+    std::vector<sbe::value::ViewOfValueAccessor> accessors(numComponentsToSBE);
+    BufBuilder valueBuffer;
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (const auto& value : values) {
+            if (numComponentsToSBE == 0) {
+                benchmark::DoNotOptimize(KeyString::toBson(value, ALL_ASCENDING));
+            } else {
+                valueBuffer.reset();
+                sbe::value::readKeyStringValueIntoAccessors(
+                    value, ALL_ASCENDING, &valueBuffer, &accessors, indexKeysToInclude);
+                benchmark::DoNotOptimize(accessors.front().getViewOfValue());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kSampleSize);
+}
+
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Int, KeyString::Version::V0, INT);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Int, KeyString::Version::V1, INT);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Double, KeyString::Version::V0, DOUBLE);
@@ -245,5 +332,12 @@ BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_String, KeyString::Version::V1, STRING)
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Array, KeyString::Version::V1, ARRAY);
 
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeysDecode, Int_BSON, INT, 0);
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeysDecode, Int_AllToSBE, INT, 3);
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeysDecode, Int_LeadingToSBE, INT, 1);
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeysDecode, String_BSON, STRING, 0);
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeysDecode, String_AllToSBE, STRING, 3);
+BENCHMARK_CAPTURE(BM_KeyStringCompoundKeysDecode, String_LeadingToSBE, STRING, 1);
+
 }  // namespace
 }  // namespace mongo
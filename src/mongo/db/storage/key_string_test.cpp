@@ -608,6 +608,43 @@ TEST_F(KeyStringBuilderTest, KeyStringValueReleaseReusableTest) {
     COMPARE_KS_BSON(data2, bson2, ALL_ASCENDING);
 }
 
+TEST_F(KeyStringBuilderTest, ResetFromPrefix) {
+    // Test that a key built from a prefix matches one built by appending every element, including
+    // its type bits and the ordering of the elements that follow the prefix.
+    const Ordering ord = Ordering::make(BSON("a" << 1 << "b" << -1 << "c" << 1));
+    BSONObj doc = BSON("a" << 1.0 << "b" << 2LL << "c"
+                           << "x");
+    BSONObj other = BSON("" << 3);
+    KeyString::Builder prefix(version, ord);
+    prefix.appendBSONElement(doc["a"]);
+
+    for (const auto& elem : {doc["b"], other.firstElement()}) {
+        KeyString::HeapBuilder full(version, ord);
+        full.appendBSONElement(doc["a"]);
+        full.appendBSONElement(elem);
+        full.appendBSONElement(doc["c"]);
+        full.appendRecordId(RecordId(5));
+
+        KeyString::HeapBuilder fromPrefix(version);
+        fromPrefix.resetFromPrefix(prefix);
+        fromPrefix.appendBSONElement(elem);
+        fromPrefix.appendBSONElement(doc["c"]);
+        fromPrefix.appendRecordId(RecordId(5));
+
+        ASSERT_EQ(full.getValueCopy(), fromPrefix.getValueCopy());
+        ASSERT_EQ(full.getTypeBits().getSize(), fromPrefix.getTypeBits().getSize());
+        ASSERT_EQ(0,
+                  memcmp(full.getTypeBits().getBuffer(),
+                         fromPrefix.getTypeBits().getBuffer(),
+                         full.getTypeBits().getSize()));
+    }
+
+    // The prefix itself is left untouched.
+    KeyString::Builder expectedPrefix(version, ord);
+    expectedPrefix.appendBSONElement(doc["a"]);
+    ASSERT_EQ(0, prefix.compare(expectedPrefix));
+}
+
 TEST_F(KeyStringBuilderTest, KeyStringGetValueCopyTest) {
     // Test that KeyStringGetValueCopyTest creates a copy.
     BSONObj doc = BSON("fieldA" << 1);
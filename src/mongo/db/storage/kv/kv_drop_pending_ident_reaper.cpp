@@ -37,6 +37,7 @@
 
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/storage/ident.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
 
@@ -92,9 +93,11 @@ std::set<std::string> KVDropPendingIdentReaper::getAllIdentNames() const {
 void KVDropPendingIdentReaper::dropIdentsOlderThan(OperationContext* opCtx, const Timestamp& ts) {
     DropPendingIdents toDrop;
     {
+        const size_t maxIdents = gDropPendingIdentReaperMaxIdentsPerPass.load();
         stdx::lock_guard<Latch> lock(_mutex);
         for (auto it = _dropPendingIdents.cbegin();
-             it != _dropPendingIdents.cend() && (it->first < ts || it->first == Timestamp::min());
+             it != _dropPendingIdents.cend() && (it->first < ts || it->first == Timestamp::min()) &&
+             (!maxIdents || toDrop.size() < maxIdents);
              ++it) {
             // This collection/index satisfies the 'ts' requirement to be safe to drop, but we must
             // also check that there are no active operations remaining that still retain a
@@ -100,6 +100,8 @@ public:
      * Notifies this class that the storage engine has advanced its oldest timestamp.
      * Drops all unreferenced drop-pending idents with drop timestamps before 'ts', as well as all
      * unreferenced idents with Timestamp::min() drop timestamps (untimestamped on standalones).
+     * Drops at most 'dropPendingIdentReaperMaxIdentsPerPass' idents, if it is set, leaving the
+     * others to later calls.
      */
     void dropIdentsOlderThan(OperationContext* opCtx, const Timestamp& ts);
 
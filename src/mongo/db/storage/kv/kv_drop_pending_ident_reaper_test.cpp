@@ -35,8 +35,10 @@
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/storage/ident.h"
 #include "mongo/db/storage/kv/kv_drop_pending_ident_reaper.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -241,6 +243,34 @@ TEST_F(KVDropPendingIdentReaperTest,
     ASSERT_EQUALS(identName2, engine->droppedIdents.back());
 }
 
+TEST_F(KVDropPendingIdentReaperTest, DropIdentsOlderThanDropsAtMostMaxIdentsPerPass) {
+    auto opCtx = makeOpCtx();
+    auto engine = getEngine();
+    KVDropPendingIdentReaper reaper(engine);
+
+    const Timestamp dropTimestamp{Seconds(100), 0};
+    NamespaceString nss("test.foo");
+    std::string identNames[3] = {"ident1", "ident2", "ident3"};
+    for (auto&& identName : identNames) {
+        // The reaper must have the only references to the idents before it will drop them.
+        reaper.addDropPendingIdent(dropTimestamp, nss, std::make_shared<Ident>(identName));
+    }
+
+    gDropPendingIdentReaperMaxIdentsPerPass.store(2);
+    ON_BLOCK_EXIT([] { gDropPendingIdentReaperMaxIdentsPerPass.store(0); });
+
+    reaper.dropIdentsOlderThan(opCtx.get(), makeTimestampWithNextInc(dropTimestamp));
+    ASSERT_EQUALS(2U, engine->droppedIdents.size());
+    ASSERT_EQUALS(identNames[0], engine->droppedIdents[0]);
+    ASSERT_EQUALS(identNames[1], engine->droppedIdents[1]);
+    ASSERT_EQUALS(dropTimestamp, *reaper.getEarliestDropTimestamp());
+
+    reaper.dropIdentsOlderThan(opCtx.get(), makeTimestampWithNextInc(dropTimestamp));
+    ASSERT_EQUALS(3U, engine->droppedIdents.size());
+    ASSERT_EQUALS(identNames[2], engine->droppedIdents[2]);
+    ASSERT_FALSE(reaper.getEarliestDropTimestamp());
+}
+
 DEATH_TEST_F(KVDropPendingIdentReaperTest,
              AddDropPendingIdentTerminatesOnDuplicateDropTimestampAndIdent,
              "Failed to add drop-pending ident") {
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <memory>
 #include <string>
 #include <vector>
@@ -291,6 +292,24 @@ public:
 
     virtual void checkpoint() {}
 
+    /**
+     * How much data a checkpoint taken now would have to write out.
+     */
+    struct CheckpointPressure {
+        // Bytes of modified data in the cache.
+        long long dirtyCacheBytes = 0;
+        // Bytes written to the journal since the last checkpoint started.
+        long long journalBytesSinceCheckpoint = 0;
+    };
+
+    /**
+     * Returns the current checkpoint pressure, or boost::none if the KVEngine doesn't track it. The
+     * checkpoint thread uses it to checkpoint early when enough data has accumulated.
+     */
+    virtual boost::optional<CheckpointPressure> getCheckpointPressure() {
+        return boost::none;
+    }
+
     virtual bool isDurable() const = 0;
 
     /**
@@ -438,6 +457,13 @@ public:
         return false;
     }
 
+    /**
+     * See `StorageEngine::supportsClusteredCollections`
+     */
+    virtual bool supportsClusteredCollections() const {
+        return false;
+    }
+
     /**
      * See `StorageEngine::supportsOplogStones`
      */
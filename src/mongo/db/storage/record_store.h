@@ -30,6 +30,8 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <set>
+#include <string>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
@@ -156,6 +158,16 @@ public:
      * "saved" state, so callers must still call restoreState to use this object.
      */
     virtual void reattachToOperationContext(OperationContext* opCtx) = 0;
+
+    /**
+     * Informs the cursor that its caller only reads the top-level fields named in 'fields' from
+     * the Records it returns, so that the storage engine may return Records holding just those
+     * fields. Must be called before the cursor is first positioned. Implementations are free to
+     * keep returning whole Records, so callers must not rely on the other fields being absent.
+     *
+     * The default implementation does nothing.
+     */
+    virtual void setFieldsToReturn(std::set<std::string> fields) {}
 };
 
 /**
@@ -186,6 +198,15 @@ public:
     virtual void saveUnpositioned() {
         save();
     }
+
+    /**
+     * Hints that the Records with the provided ids will shortly be sought with seekExact(). The
+     * storage engine may start reading them into its cache in the background, so that the seeks
+     * do not have to wait on disk. No Records are returned and no errors are reported.
+     *
+     * The default implementation does nothing.
+     */
+    virtual void prefetch(std::vector<RecordId> ids) {}
 };
 
 /**
@@ -241,6 +262,14 @@ public:
 
     virtual bool isCapped() const = 0;
 
+    /**
+     * Returns true if the records are keyed by the _id of the documents they hold, rather than by
+     * RecordIds generated by the record store. See CollectionOptions::clustered.
+     */
+    virtual bool isClustered() const {
+        return false;
+    }
+
     virtual void setCappedCallback(CappedCallback*) {
         MONGO_UNREACHABLE;
     }
@@ -34,6 +34,7 @@
 #include <algorithm>
 
 #include "mongo/bson/util/builder.h"
+#include "mongo/db/jsobj.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/record_data.h"
 #include "mongo/db/storage/record_store.h"
@@ -483,5 +484,40 @@ TEST(RecordStoreTestHarness, SeekExactForMissingRecordReturnsNone) {
     ASSERT_FALSE(recordStore->findRecord(opCtx.get(), recordIds[1], &outputData));
 }
 
+// Insert a BSON record and read it back through a cursor asked for a subset of its fields. The
+// requested fields must be returned intact, whether or not the others are trimmed away.
+TEST(RecordStoreTestHarness, CursorReturnsRequestedFields) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const BSONObj doc = BSON("a" << 1 << "b" << BSON("c" << 2) << "d" << 3);
+    RecordId loc;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), doc.objdata(), doc.objsize(), Timestamp());
+        ASSERT_OK(res.getStatus());
+        loc = res.getValue();
+        uow.commit();
+    }
+
+    for (bool seek : {false, true}) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto cursor = rs->getCursor(opCtx.get());
+        cursor->setFieldsToReturn({"a", "b"});
+        const auto record = seek ? cursor->seekExact(loc) : cursor->next();
+        ASSERT(record);
+        ASSERT_EQUALS(loc, record->id);
+
+        const BSONObj returned = record->data.toBson();
+        ASSERT_BSONELT_EQ(doc["a"], returned["a"]);
+        ASSERT_BSONELT_EQ(doc["b"], returned["b"]);
+        if (!returned["d"].eoo()) {
+            ASSERT_BSONELT_EQ(doc["d"], returned["d"]);
+        }
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -30,6 +30,7 @@
 #include <boost/optional/optional.hpp>
 #include <boost/optional/optional_io.hpp>
 #include <memory>
+#include <vector>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
@@ -95,6 +96,25 @@ public:
                           const KeyString::Value& keyString,
                           bool dupsAllowed) = 0;
 
+    /**
+     * Insert each of 'keyStrings', which must be in ascending order and have a RecordId appended
+     * to the end, as if by insert(). Stops at, and returns, the first non-OK status.
+     *
+     * Storage engines may override this to insert consecutive keys without repositioning from
+     * scratch for every one of them.
+     */
+    virtual Status insertBatch(OperationContext* opCtx,
+                               const std::vector<KeyString::Value>& keyStrings,
+                               bool dupsAllowed) {
+        for (const auto& keyString : keyStrings) {
+            Status status = insert(opCtx, keyString, dupsAllowed);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        return Status::OK();
+    }
+
     /**
      * Remove the entry from the index with the specified KeyString, which must have a RecordId
      * appended to the end.
@@ -440,6 +440,12 @@ public:
 
     virtual bool supportsReadConcernMajority() const = 0;
 
+    /**
+     * Returns true if the storage engine can store the documents of a collection keyed by their
+     * _id, see CollectionOptions::clustered.
+     */
+    virtual bool supportsClusteredCollections() const = 0;
+
     /**
      * Returns true if the storage engine uses oplog stones to more finely control
      * deletion of oplog history, instead of the standard capped collection controls on
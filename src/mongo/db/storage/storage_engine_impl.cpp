@@ -53,6 +53,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 #define LOGV2_FOR_RECOVERY(ID, DLEVEL, MESSAGE, ...) \
     LOGV2_DEBUG_OPTIONS(ID, DLEVEL, {logv2::LogComponent::kStorageRecovery}, MESSAGE, ##__VA_ARGS__)
@@ -100,6 +101,7 @@ StorageEngineImpl::StorageEngineImpl(OperationContext* opCtx,
 }
 
 void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUncleanShutdown) {
+    Timer totalTimer;
     bool catalogExists = _engine->hasIdent(opCtx, catalogInfo);
     if (_options.forRepair && catalogExists) {
         auto repairObserver = StorageRepairObserver::get(getGlobalServiceContext());
@@ -139,9 +141,11 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
         _dumpCatalog(opCtx);
     }
 
+    Timer phaseTimer;
     _catalog.reset(new DurableCatalogImpl(
         _catalogRecordStore.get(), _options.directoryPerDB, _options.directoryForIndexes, this));
     _catalog->init(opCtx);
+    const auto durableCatalogInitMillis = phaseTimer.millis();
 
     // We populate 'identsKnownToStorageEngine' only if:
     // - doing repair; or
@@ -155,6 +159,7 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
         std::sort(identsKnownToStorageEngine.begin(), identsKnownToStorageEngine.end());
     }
 
+    phaseTimer.reset();
     std::vector<DurableCatalog::Entry> catalogEntries = _catalog->getAllCatalogEntries(opCtx);
     if (_options.forRepair) {
         // It's possible that there are collection files on disk that are unknown to the catalog. In
@@ -206,6 +211,14 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
         }
     }
 
+    const auto listIdentsMillis = phaseTimer.millis();
+
+    // The collections are registered with the CollectionCatalog in a single write once they have
+    // all been opened. Every write copies the catalog, so registering them one at a time would be
+    // quadratic in the number of collections.
+    phaseTimer.reset();
+    std::vector<std::pair<UUID, std::shared_ptr<Collection>>> collections;
+    collections.reserve(catalogEntries.size());
     KVPrefix maxSeenPrefix = KVPrefix::kNotPrefixed;
     for (DurableCatalog::Entry entry : catalogEntries) {
         if (loadingFromUncleanShutdownOrRepair) {
@@ -245,9 +258,10 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair);
-        auto maxPrefixForCollection = _catalog->getMetaData(opCtx, entry.catalogId).getMaxPrefix();
-        maxSeenPrefix = std::max(maxSeenPrefix, maxPrefixForCollection);
+        const auto md = _catalog->getMetaData(opCtx, entry.catalogId);
+        collections.push_back(
+            _makeCollection(opCtx, entry.catalogId, entry.nss, md, _options.forRepair));
+        maxSeenPrefix = std::max(maxSeenPrefix, md.getMaxPrefix());
 
         if (entry.nss.isOrphanCollection()) {
             LOGV2(22248,
@@ -257,15 +271,47 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
         }
     }
 
+    const auto openCollectionsMillis = phaseTimer.millis();
+
+    phaseTimer.reset();
+    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
+        for (auto&& [uuid, collection] : collections) {
+            catalog.registerCollection(uuid, std::move(collection));
+        }
+    });
+    const auto registerCollectionsMillis = phaseTimer.millis();
+
     KVPrefix::setLargestPrefix(maxSeenPrefix);
     opCtx->recoveryUnit()->abandonSnapshot();
+
+    LOGV2(5843213,
+          "Loaded the storage catalog",
+          "collections"_attr = collections.size(),
+          "durationMillis"_attr = totalTimer.millis(),
+          "durableCatalogInitMillis"_attr = durableCatalogInitMillis,
+          "listIdentsMillis"_attr = listIdentsMillis,
+          "openCollectionsMillis"_attr = openCollectionsMillis,
+          "registerCollectionsMillis"_attr = registerCollectionsMillis);
 }
 
 void StorageEngineImpl::_initCollection(OperationContext* opCtx,
                                         RecordId catalogId,
                                         const NamespaceString& nss,
                                         bool forRepair) {
-    BSONCollectionCatalogEntry::MetaData md = _catalog->getMetaData(opCtx, catalogId);
+    auto [uuid, collection] =
+        _makeCollection(opCtx, catalogId, nss, _catalog->getMetaData(opCtx, catalogId), forRepair);
+
+    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
+        catalog.registerCollection(uuid, std::move(collection));
+    });
+}
+
+std::pair<UUID, std::shared_ptr<Collection>> StorageEngineImpl::_makeCollection(
+    OperationContext* opCtx,
+    RecordId catalogId,
+    const NamespaceString& nss,
+    const BSONCollectionCatalogEntry::MetaData& md,
+    bool forRepair) {
     uassert(ErrorCodes::MustDowngrade,
             str::stream() << "Collection does not have UUID in KVCatalog. Collection: " << nss,
             md.options.uuid);
@@ -282,14 +328,10 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
         invariant(rs);
     }
 
-    auto uuid = _catalog->getCollectionOptions(opCtx, catalogId).uuid.get();
+    auto uuid = *md.options.uuid;
 
     auto collectionFactory = Collection::Factory::get(getGlobalServiceContext());
-    auto collection = collectionFactory->make(opCtx, nss, catalogId, uuid, std::move(rs));
-
-    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
-        catalog.registerCollection(uuid, std::move(collection));
-    });
+    return {uuid, collectionFactory->make(opCtx, nss, catalogId, uuid, std::move(rs))};
 }
 
 void StorageEngineImpl::closeCatalog(OperationContext* opCtx) {
@@ -989,6 +1031,10 @@ bool StorageEngineImpl::supportsReadConcernMajority() const {
     return _engine->supportsReadConcernMajority();
 }
 
+bool StorageEngineImpl::supportsClusteredCollections() const {
+    return _engine->supportsClusteredCollections();
+}
+
 bool StorageEngineImpl::supportsOplogStones() const {
     return _engine->supportsOplogStones();
 }
@@ -51,6 +51,7 @@
 
 namespace mongo {
 
+class Collection;
 class DurableCatalogImpl;
 class KVEngine;
 
@@ -157,6 +158,8 @@ public:
 
     bool supportsReadConcernMajority() const final;
 
+    bool supportsClusteredCollections() const final;
+
     bool supportsOplogStones() const final;
 
     bool supportsResumableIndexBuilds() const final;
@@ -371,6 +374,17 @@ private:
                          const NamespaceString& nss,
                          bool forRepair);
 
+    /**
+     * Opens the record store of the collection described by 'md' and instantiates the collection,
+     * without registering it with the CollectionCatalog.
+     */
+    std::pair<UUID, std::shared_ptr<Collection>> _makeCollection(
+        OperationContext* opCtx,
+        RecordId catalogId,
+        const NamespaceString& nss,
+        const BSONCollectionCatalogEntry::MetaData& md,
+        bool forRepair);
+
     Status _dropCollectionsNoTimestamp(OperationContext* opCtx,
                                        std::vector<NamespaceString>& toDrop);
 
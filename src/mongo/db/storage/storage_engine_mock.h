@@ -118,6 +118,9 @@ public:
     bool supportsReadConcernMajority() const final {
         return false;
     }
+    bool supportsClusteredCollections() const final {
+        return false;
+    }
     bool supportsOplogStones() const final {
         return false;
     }
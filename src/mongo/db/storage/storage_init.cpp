@@ -34,6 +34,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/backup_cursor_hooks.h"
+#include "mongo/db/storage/checkpointer.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/storage/storage_options.h"
 
@@ -74,6 +75,10 @@ public:
         if (serverGlobalParams.featureCompatibility.isVersionInitialized()) {
             bob.append("supportsResumableIndexBuilds", engine->supportsResumableIndexBuilds());
         }
+        if (auto checkpointer = Checkpointer::get(svcCtx)) {
+            BSONObjBuilder checkpointerBuilder(bob.subobjStart("checkpointer"));
+            checkpointer->appendStats(&checkpointerBuilder);
+        }
 
         return bob.obj();
     }
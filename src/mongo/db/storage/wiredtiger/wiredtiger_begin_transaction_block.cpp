@@ -31,8 +31,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include <array>
 #include <cstdio>
 #include <fmt/format.h>
+#include <iterator>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
 
@@ -42,36 +44,90 @@
 namespace mongo {
 using namespace fmt::literals;
 
-WiredTigerBeginTxnBlock::WiredTigerBeginTxnBlock(
-    WT_SESSION* session,
-    PrepareConflictBehavior prepareConflictBehavior,
-    RoundUpPreparedTimestamps roundUpPreparedTimestamps,
-    RoundUpReadTimestamp roundUpReadTimestamp)
-    : _session(session) {
-    invariant(!_rollback);
+namespace {
 
+using RoundPrepared = WiredTigerBeginTxnBlock::RoundUpPreparedTimestamps;
+using RoundRead = WiredTigerBeginTxnBlock::RoundUpReadTimestamp;
+
+// All of the values of the options, in the order of their underlying values.
+constexpr PrepareConflictBehavior kPrepareConflictBehaviors[] = {
+    PrepareConflictBehavior::kEnforce,
+    PrepareConflictBehavior::kIgnoreConflicts,
+    PrepareConflictBehavior::kIgnoreConflictsAllowWrites};
+constexpr RoundPrepared kRoundUpPreparedTimestamps[] = {RoundPrepared::kNoRound,
+                                                        RoundPrepared::kRound};
+constexpr RoundRead kRoundUpReadTimestamps[] = {
+    RoundRead::kNoRoundError, RoundRead::kNoRoundForce, RoundRead::kRound};
+
+size_t configStringIndex(PrepareConflictBehavior prepareConflictBehavior,
+                         RoundPrepared roundUpPreparedTimestamps,
+                         RoundRead roundUpReadTimestamp) {
+    return (static_cast<size_t>(prepareConflictBehavior) * std::size(kRoundUpPreparedTimestamps) +
+            static_cast<size_t>(roundUpPreparedTimestamps)) *
+        std::size(kRoundUpReadTimestamps) +
+        static_cast<size_t>(roundUpReadTimestamp);
+}
+
+std::string buildConfigString(PrepareConflictBehavior prepareConflictBehavior,
+                              RoundPrepared roundUpPreparedTimestamps,
+                              RoundRead roundUpReadTimestamp) {
     str::stream builder;
     if (prepareConflictBehavior == PrepareConflictBehavior::kIgnoreConflicts) {
         builder << "ignore_prepare=true,";
     } else if (prepareConflictBehavior == PrepareConflictBehavior::kIgnoreConflictsAllowWrites) {
         builder << "ignore_prepare=force,";
     }
-    if (roundUpPreparedTimestamps == RoundUpPreparedTimestamps::kRound ||
-        roundUpReadTimestamp == RoundUpReadTimestamp::kRound) {
+    if (roundUpPreparedTimestamps == RoundPrepared::kRound ||
+        roundUpReadTimestamp == RoundRead::kRound) {
         builder << "roundup_timestamps=(";
-        if (roundUpPreparedTimestamps == RoundUpPreparedTimestamps::kRound) {
+        if (roundUpPreparedTimestamps == RoundPrepared::kRound) {
             builder << "prepared=true,";
         }
-        if (roundUpReadTimestamp == RoundUpReadTimestamp::kRound) {
+        if (roundUpReadTimestamp == RoundRead::kRound) {
             builder << "read=true";
         }
         builder << "),";
     }
-    if (roundUpReadTimestamp == RoundUpReadTimestamp::kNoRoundForce) {
+    if (roundUpReadTimestamp == RoundRead::kNoRoundForce) {
         builder << "read_before_oldest=true,";
     }
+    return builder;
+}
+
+}  // namespace
 
-    const std::string beginTxnConfigString = builder;
+const std::string& WiredTigerBeginTxnBlock::getConfigString(
+    PrepareConflictBehavior prepareConflictBehavior,
+    RoundUpPreparedTimestamps roundUpPreparedTimestamps,
+    RoundUpReadTimestamp roundUpReadTimestamp) {
+    static const auto kConfigStrings = [] {
+        std::array<std::string,
+                   std::size(kPrepareConflictBehaviors) * std::size(kRoundUpPreparedTimestamps) *
+                       std::size(kRoundUpReadTimestamps)>
+            configStrings;
+        for (auto prepare : kPrepareConflictBehaviors) {
+            for (auto roundPrepared : kRoundUpPreparedTimestamps) {
+                for (auto roundRead : kRoundUpReadTimestamps) {
+                    configStrings[configStringIndex(prepare, roundPrepared, roundRead)] =
+                        buildConfigString(prepare, roundPrepared, roundRead);
+                }
+            }
+        }
+        return configStrings;
+    }();
+    return kConfigStrings[configStringIndex(
+        prepareConflictBehavior, roundUpPreparedTimestamps, roundUpReadTimestamp)];
+}
+
+WiredTigerBeginTxnBlock::WiredTigerBeginTxnBlock(
+    WT_SESSION* session,
+    PrepareConflictBehavior prepareConflictBehavior,
+    RoundUpPreparedTimestamps roundUpPreparedTimestamps,
+    RoundUpReadTimestamp roundUpReadTimestamp)
+    : _session(session) {
+    invariant(!_rollback);
+    const auto& beginTxnConfigString =
+        getConfigString(prepareConflictBehavior, roundUpPreparedTimestamps, roundUpReadTimestamp);
     invariantWTOK(_session->begin_transaction(_session, beginTxnConfigString.c_str()));
     _rollback = true;
 }
@@ -68,6 +68,15 @@ public:
     WiredTigerBeginTxnBlock(WT_SESSION* session, const char* config);
     ~WiredTigerBeginTxnBlock();
 
+    /**
+     * Returns the begin_transaction() configuration for the given options. The configurations of
+     * all of the combinations of options are only built once.
+     */
+    static const std::string& getConfigString(
+        PrepareConflictBehavior prepareConflictBehavior,
+        RoundUpPreparedTimestamps roundUpPreparedTimestamps,
+        RoundUpReadTimestamp roundUpReadTimestamp = RoundUpReadTimestamp::kNoRoundError);
+
     /**
      * Sets the read timestamp on the opened transaction. Cannot be called after a call to done().
      */
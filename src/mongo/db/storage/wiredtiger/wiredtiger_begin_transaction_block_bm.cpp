@@ -140,6 +140,18 @@ void BM_setTimestamp(benchmark::State& state) {
     }
 }
 
+void BM_beginTransactionOnCommittedSnapshot(benchmark::State& state) {
+    WiredTigerTestHelper helper;
+    auto& snapshotManager = helper.getSessionCache()->snapshotManager();
+    snapshotManager.setCommittedSnapshot(Timestamp(1));
+    for (auto _ : state) {
+        snapshotManager.beginTransactionOnCommittedSnapshot(helper.wtSession(),
+                                                            PrepareConflictBehavior::kEnforce,
+                                                            RoundUpPreparedTimestamps::kNoRound);
+        invariantWTOK(helper.wtSession()->rollback_transaction(helper.wtSession(), nullptr));
+    }
+}
+
 BENCHMARK(BM_WiredTigerBeginTxnBlock);
 BENCHMARK_TEMPLATE(BM_WiredTigerBeginTxnBlockWithArgs,
                    PrepareConflictBehavior::kEnforce,
@@ -161,6 +173,7 @@ BENCHMARK_TEMPLATE(BM_WiredTigerBeginTxnBlockWithArgs,
                    RoundUpPreparedTimestamps::kRound);
 
 BENCHMARK(BM_setTimestamp);
+BENCHMARK(BM_beginTransactionOnCommittedSnapshot);
 
 }  // namespace
 }  // namespace mongo
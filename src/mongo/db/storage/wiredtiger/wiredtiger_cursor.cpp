@@ -45,7 +45,7 @@ WiredTigerCursor::WiredTigerCursor(const std::string& uri,
                                    OperationContext* opCtx) {
     _tableID = tableID;
     _ru = WiredTigerRecoveryUnit::get(opCtx);
-    _session = _ru->getSession();
+    _session = _ru->getSession(tableID);
     _readOnce = _ru->getReadOnce();
 
     // Attempt to retrieve the cursor from the cache. Cursors using the 'read_once' option will
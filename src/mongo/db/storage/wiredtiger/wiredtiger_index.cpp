@@ -33,6 +33,7 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 
@@ -286,6 +287,32 @@ Status WiredTigerIndex::insert(OperationContext* opCtx,
     return _insert(opCtx, c, keyString, dupsAllowed);
 }
 
+Status WiredTigerIndex::insertBatch(OperationContext* opCtx,
+                                    const std::vector<KeyString::Value>& keyStrings,
+                                    bool dupsAllowed) {
+    dassert(opCtx->lockState()->isWriteLocked());
+    dassert(std::is_sorted(keyStrings.begin(),
+                           keyStrings.end(),
+                           [](const auto& lhs, const auto& rhs) { return lhs.compare(rhs) < 0; }));
+
+    WiredTigerCursor curwrap(_uri, _tableId, false, opCtx);
+    curwrap.assertInActiveTxn();
+    WT_CURSOR* c = curwrap.get();
+
+    for (const auto& keyString : keyStrings) {
+        dassert(
+            KeyString::decodeRecordIdAtEnd(keyString.getBuffer(), keyString.getSize()).isValid());
+
+        LOGV2_TRACE_INDEX(5843209, "KeyString: {keyString}", "keyString"_attr = keyString);
+
+        Status status = _insert(opCtx, c, keyString, dupsAllowed);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
 void WiredTigerIndex::unindex(OperationContext* opCtx,
                               const KeyString::Value& keyString,
                               bool dupsAllowed) {
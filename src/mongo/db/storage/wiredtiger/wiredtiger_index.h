@@ -102,6 +102,14 @@ public:
                           const KeyString::Value& keyString,
                           bool dupsAllowed);
 
+    /**
+     * Inserts all of 'keyStrings' through a single cursor, so that keys which land on the same
+     * page only pay for the cursor positioning once between them.
+     */
+    Status insertBatch(OperationContext* opCtx,
+                       const std::vector<KeyString::Value>& keyStrings,
+                       bool dupsAllowed) override;
+
     virtual void unindex(OperationContext* opCtx,
                          const KeyString::Value& keyString,
                          bool dupsAllowed);
@@ -44,6 +44,7 @@
 #include <fmt/format.h>
 #include <iomanip>
 #include <memory>
+#include <utility>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 
@@ -82,6 +83,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_prefetcher.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
@@ -120,6 +122,15 @@ namespace {
 MONGO_FAIL_POINT_DEFINE(WTPreserveSnapshotHistoryIndefinitely);
 MONGO_FAIL_POINT_DEFINE(WTSetOldestTSToStableTS);
 
+/**
+ * Returns the total number of bytes written to the journal, or 0 when it can't be read.
+ */
+long long getLogBytesWritten(WT_SESSION* session) {
+    auto logBytes = WiredTigerUtil::getStatisticsValue(
+        session, "statistics:", "statistics=(fast)", WT_STAT_CONN_LOG_BYTES_WRITTEN);
+    return logBytes.isOK() ? logBytes.getValue() : 0;
+}
+
 }  // namespace
 
 bool WiredTigerFileVersion::shouldDowngrade(bool readOnly,
@@ -194,8 +205,8 @@ namespace dps = ::mongo::dotted_path_support;
 
 class WiredTigerKVEngine::WiredTigerSessionSweeper : public BackgroundJob {
 public:
-    explicit WiredTigerSessionSweeper(WiredTigerSessionCache* sessionCache)
-        : BackgroundJob(false /* deleteSelf */), _sessionCache(sessionCache) {}
+    WiredTigerSessionSweeper(WiredTigerKVEngine* engine, WiredTigerSessionCache* sessionCache)
+        : BackgroundJob(false /* deleteSelf */), _engine(engine), _sessionCache(sessionCache) {}
 
     virtual string name() const {
         return "WTIdleSessionSweeper";
@@ -206,11 +217,19 @@ public:
         LOGV2_DEBUG(22303, 1, "starting {name} thread", "name"_attr = name());
 
         while (!_shuttingDown.load()) {
+            bool flushSizeStorer;
             {
                 stdx::unique_lock<Latch> lock(_mutex);
                 MONGO_IDLE_THREAD_BLOCK;
                 // Check every 10 seconds or sooner in the debug builds
-                _condvar.wait_for(lock, stdx::chrono::seconds(kDebugBuild ? 1 : 10));
+                if (!_sizeStorerFlushRequested) {
+                    _condvar.wait_for(lock, stdx::chrono::seconds(kDebugBuild ? 1 : 10));
+                }
+                flushSizeStorer = std::exchange(_sizeStorerFlushRequested, false);
+            }
+
+            if (flushSizeStorer) {
+                _engine->syncSizeInfo(false);
             }
 
             _sessionCache->closeExpiredIdleSessions(gWiredTigerSessionCloseIdleTimeSecs.load() *
@@ -230,9 +249,21 @@ public:
         wait();
     }
 
+    /**
+     * Wakes up the sweeper thread to write back the buffered size information, so that the
+     * operation which noticed that a flush was due doesn't have to wait for it.
+     */
+    void requestSizeStorerFlush() {
+        stdx::unique_lock<Latch> lock(_mutex);
+        _sizeStorerFlushRequested = true;
+        _condvar.notify_one();
+    }
+
 private:
+    WiredTigerKVEngine* _engine;
     WiredTigerSessionCache* _sessionCache;
     AtomicWord<bool> _shuttingDown{false};
+    bool _sizeStorerFlushRequested = false;  // protected by _mutex
 
     Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerSessionSweeper::_mutex");  // protects _condvar
     // The session sweeper thread idles on this condition variable for a particular time duration
@@ -476,9 +507,13 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     _sessionCache.reset(new WiredTigerSessionCache(this));
 
-    _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
+    _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(this, _sessionCache.get());
     _sessionSweeper->go();
 
+    if (!_ephemeral) {
+        _recordPrefetcher = std::make_unique<WiredTigerRecordPrefetcher>(_sessionCache.get());
+    }
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -541,16 +576,12 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
     BSONObjBuilder bb(b.subobjStart("concurrentTransactions"));
     {
         BSONObjBuilder bbb(bb.subobjStart("write"));
-        bbb.append("out", openWriteTransaction.used());
-        bbb.append("available", openWriteTransaction.available());
-        bbb.append("totalTickets", openWriteTransaction.outof());
+        openWriteTransaction.appendStats(bbb);
         bbb.done();
     }
     {
         BSONObjBuilder bbb(bb.subobjStart("read"));
-        bbb.append("out", openReadTransaction.used());
-        bbb.append("available", openReadTransaction.available());
-        bbb.append("totalTickets", openReadTransaction.outof());
+        openReadTransaction.appendStats(bbb);
         bbb.done();
     }
     bb.done();
@@ -668,6 +699,10 @@ void WiredTigerKVEngine::cleanShutdown() {
                        "Stable Timestamp"_attr = Timestamp(_stableTimestamp.load()),
                        "Initial Data Timestamp"_attr = Timestamp(_initialDataTimestamp.load()));
 
+    if (_recordPrefetcher) {
+        _recordPrefetcher->shutdown();
+    }
+
     _sizeStorer.reset();
     _sessionCache->shuttingDown();
 
@@ -1246,6 +1281,11 @@ StatusWith<std::vector<std::string>> WiredTigerKVEngine::extendBackupCursor(
     return getUniqueFiles(filePaths, _wtBackup.logFilePathsSeenByGetNextBatch);
 }
 
+void WiredTigerKVEngine::appendSizeStorerStats(BSONObjBuilder* builder) const {
+    if (_sizeStorer)
+        _sizeStorer->appendStats(builder);
+}
+
 void WiredTigerKVEngine::syncSizeInfo(bool sync) const {
     if (!_sizeStorer)
         return;
@@ -1417,6 +1457,7 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     params.ident = ident.toString();
     params.engineName = _canonicalName;
     params.isCapped = options.capped;
+    params.isClustered = options.clustered;
     params.isEphemeral = _ephemeral;
     params.cappedCallback = nullptr;
     params.sizeStorer = _sizeStorer.get();
@@ -1679,7 +1720,7 @@ bool WiredTigerKVEngine::haveDropsQueued() const {
 
     if (!_readOnly && _sizeStorerSyncTracker.intervalHasElapsed()) {
         _sizeStorerSyncTracker.resetLastTime();
-        syncSizeInfo(false);
+        _sessionSweeper->requestSizeStorerFlush();
     }
 
     // We only want to check the queue max once per second or we'll thrash
@@ -1776,6 +1817,7 @@ void WiredTigerKVEngine::checkpoint() {
         if (initialDataTimestamp.asULL() <= 1) {
             UniqueWiredTigerSession session = _sessionCache->getSession();
             WT_SESSION* s = session->getSession();
+            _logBytesWrittenAtLastCheckpoint.store(getLogBytesWritten(s));
             invariantWTOK(s->checkpoint(s, "use_timestamp=false"));
         } else if (stableTimestamp < initialDataTimestamp) {
             LOGV2_FOR_RECOVERY(
@@ -1795,6 +1837,7 @@ void WiredTigerKVEngine::checkpoint() {
 
             UniqueWiredTigerSession session = _sessionCache->getSession();
             WT_SESSION* s = session->getSession();
+            _logBytesWrittenAtLastCheckpoint.store(getLogBytesWritten(s));
             invariantWTOK(s->checkpoint(s, "use_timestamp=true"));
 
             if (oplogNeededForRollback.isOK()) {
@@ -1810,6 +1853,22 @@ void WiredTigerKVEngine::checkpoint() {
     }
 }
 
+boost::optional<KVEngine::CheckpointPressure> WiredTigerKVEngine::getCheckpointPressure() {
+    UniqueWiredTigerSession session = _sessionCache->getSession();
+    WT_SESSION* s = session->getSession();
+    auto dirtyBytes = WiredTigerUtil::getStatisticsValue(
+        s, "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    if (!dirtyBytes.isOK()) {
+        return boost::none;
+    }
+
+    CheckpointPressure pressure;
+    pressure.dirtyCacheBytes = dirtyBytes.getValue();
+    pressure.journalBytesSinceCheckpoint =
+        std::max(0LL, getLogBytesWritten(s) - _logBytesWrittenAtLastCheckpoint.load());
+    return pressure;
+}
+
 bool WiredTigerKVEngine::hasIdent(OperationContext* opCtx, StringData ident) const {
     return _hasUri(WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession(), _uri(ident));
 }
@@ -2276,6 +2335,10 @@ bool WiredTigerKVEngine::supportsReadConcernSnapshot() const {
     return true;
 }
 
+bool WiredTigerKVEngine::supportsClusteredCollections() const {
+    return true;
+}
+
 bool WiredTigerKVEngine::supportsReadConcernMajority() const {
     return _keepDataHistory;
 }
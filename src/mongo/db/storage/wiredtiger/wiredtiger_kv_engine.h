@@ -54,6 +54,7 @@ class ClockSource;
 class JournalListener;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
+class WiredTigerRecordPrefetcher;
 class WiredTigerSizeStorer;
 class WiredTigerEngineRuntimeConfigParameter;
 
@@ -119,6 +120,8 @@ public:
 
     void checkpoint() override;
 
+    boost::optional<CheckpointPressure> getCheckpointPressure() override;
+
     bool isDurable() const override {
         return _durable;
     }
@@ -288,6 +291,8 @@ public:
 
     bool supportsReadConcernSnapshot() const final override;
 
+    bool supportsClusteredCollections() const final override;
+
     bool supportsOplogStones() const final override;
 
     bool supportsReadConcernMajority() const final;
@@ -307,6 +312,11 @@ public:
 
     void syncSizeInfo(bool sync) const;
 
+    /**
+     * Appends statistics about the size storer's buffered entries and flushes.
+     */
+    void appendSizeStorerStats(BSONObjBuilder* builder) const;
+
     /*
      * The oplog manager is always accessible, but this method will start the background thread to
      * control oplog entry visibility for reads.
@@ -332,6 +342,14 @@ public:
         return _oplogManager.get();
     }
 
+    /**
+     * Returns the prefetcher reading records into the cache ahead of the cursors seeking them, or
+     * nullptr for the in-memory engine, which has nothing to prefetch.
+     */
+    WiredTigerRecordPrefetcher* getRecordPrefetcher() const {
+        return _recordPrefetcher.get();
+    }
+
     static void appendGlobalStats(BSONObjBuilder& b);
 
     Timestamp getStableTimestamp() const override;
@@ -473,6 +491,8 @@ private:
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
 
+    std::unique_ptr<WiredTigerRecordPrefetcher> _recordPrefetcher;
+
     std::string _rsOptions;
     std::string _indexOptions;
 
@@ -499,6 +519,9 @@ private:
 
     AtomicWord<std::uint64_t> _oplogNeededForCrashRecovery;
 
+    // The value of the "log bytes written" statistic when the last checkpoint started.
+    AtomicWord<long long> _logBytesWrittenAtLastCheckpoint{0};
+
     std::unique_ptr<WiredTigerEngineRuntimeConfigParameter> _runTimeConfigParam;
 
     mutable Mutex _highestDurableTimestampMutex =
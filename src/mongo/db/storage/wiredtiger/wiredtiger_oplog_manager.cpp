@@ -31,8 +31,11 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <cstring>
+#include <utility>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
@@ -102,6 +105,9 @@ void WiredTigerOplogManager::haltVisibilityThread() {
 
 void WiredTigerOplogManager::triggerOplogVisibilityUpdate() {
     stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+    if (!_oplogVisibilityUpdateTriggeredAtMicros) {
+        _oplogVisibilityUpdateTriggeredAtMicros = curTimeMicros64();
+    }
     if (!_triggerOplogVisibilityUpdate) {
         _triggerOplogVisibilityUpdate = true;
         _oplogVisibilityThreadCV.notify_one();
@@ -140,6 +146,10 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     invariant(_opsWaitingForOplogVisibilityUpdate > 0);
     auto exitGuard = makeGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
 
+    // Wake the visibility thread if it is delaying a triggered update, rather than letting it
+    // notice this waiter on its next periodic check.
+    _oplogVisibilityThreadCV.notify_one();
+
     // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
     // prompt the OplogVisibilityThread to run and update the oplog visibility. We simply need to
     // wait until all of the writes behind and including 'waitingFor' commit so there are no oplog
@@ -220,6 +230,7 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
 
         invariant(_triggerOplogVisibilityUpdate);
         _triggerOplogVisibilityUpdate = false;
+        const auto triggeredAtMicros = std::exchange(_oplogVisibilityUpdateTriggeredAtMicros, 0);
 
         lk.unlock();
 
@@ -235,6 +246,10 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
                         2,
                         "No new oplog entries became visible.",
                         "aNoHolesOplogTimestamp"_attr = Timestamp(newTimestamp));
+
+            // The commits which triggered this update are still waiting behind an oplog hole.
+            lk.lock();
+            _restoreVisibilityUpdateTriggeredAt(lk, triggeredAtMicros);
             continue;
         }
 
@@ -243,6 +258,11 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
         auto currentVisibleTimestamp = getOplogReadTimestamp();
         if (newTimestamp > currentVisibleTimestamp) {
             _setOplogReadTimestamp(lk, newTimestamp);
+            if (triggeredAtMicros) {
+                _recordVisibilityDelay(lk, curTimeMicros64() - triggeredAtMicros);
+            }
+        } else {
+            _restoreVisibilityUpdateTriggeredAt(lk, triggeredAtMicros);
         }
         lk.unlock();
 
@@ -264,6 +284,40 @@ void WiredTigerOplogManager::setOplogReadTimestamp(Timestamp ts) {
     _setOplogReadTimestamp(lk, ts.asULL());
 }
 
+void WiredTigerOplogManager::appendVisibilityDelayStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+    builder->append("latency", _visibilityDelayTotalMicros);
+    builder->append("ops", _visibilityUpdates);
+    BSONArrayBuilder histogram(builder->subarrayStart("histogram"));
+    for (size_t i = 0; i < _visibilityDelayBuckets.size(); ++i) {
+        if (_visibilityDelayBuckets[i] > 0) {
+            BSONObjBuilder entry(histogram.subobjStart());
+            entry.append("micros", kVisibilityDelayBucketsMicros[i]);
+            entry.append("count", _visibilityDelayBuckets[i]);
+        }
+    }
+}
+
+void WiredTigerOplogManager::_restoreVisibilityUpdateTriggeredAt(
+    WithLock, unsigned long long triggeredAtMicros) {
+    if (triggeredAtMicros &&
+        (!_oplogVisibilityUpdateTriggeredAtMicros ||
+         triggeredAtMicros < _oplogVisibilityUpdateTriggeredAtMicros)) {
+        _oplogVisibilityUpdateTriggeredAtMicros = triggeredAtMicros;
+    }
+}
+
+void WiredTigerOplogManager::_recordVisibilityDelay(WithLock, int64_t delayMicros) {
+    const auto micros = std::max(delayMicros, int64_t(0));
+    auto bucket = std::upper_bound(kVisibilityDelayBucketsMicros.begin(),
+                                   kVisibilityDelayBucketsMicros.end(),
+                                   micros) -
+        1;
+    ++_visibilityDelayBuckets[bucket - kVisibilityDelayBucketsMicros.begin()];
+    _visibilityDelayTotalMicros += micros;
+    ++_visibilityUpdates;
+}
+
 void WiredTigerOplogManager::_setOplogReadTimestamp(WithLock, uint64_t newTimestamp) {
     _oplogReadTimestamp.store(newTimestamp);
     _oplogEntriesBecameVisibleCV.notify_all();
@@ -29,14 +29,18 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
 
@@ -98,7 +102,25 @@ public:
     std::uint64_t getOplogReadTimestamp() const;
     void setOplogReadTimestamp(Timestamp ts);
 
+    /**
+     * Appends how long it took for out-of-order oplog commits to become visible, from the commit
+     * which triggered an update of the oplog read timestamp until the update was published.
+     */
+    void appendVisibilityDelayStats(BSONObjBuilder* builder) const;
+
 private:
+    // Inclusive lower bounds, in microseconds, of the buckets of the visibility delay histogram.
+    static constexpr std::array<int64_t, 7> kVisibilityDelayBucketsMicros = {
+        0, 100, 1000, 10 * 1000, 50 * 1000, 100 * 1000, 1000 * 1000};
+
+    void _recordVisibilityDelay(WithLock, int64_t delayMicros);
+
+    /**
+     * Puts back the trigger time taken by a visibility update which made no new oplog entries
+     * visible, unless a commit which is still waiting triggered an update earlier.
+     */
+    void _restoreVisibilityUpdateTriggeredAt(WithLock, unsigned long long triggeredAtMicros);
+
     /**
      * Runs the oplog visibility updates when signaled by triggerOplogVisibilityUpdate() until
      * _shuttingDown is set to true.
@@ -132,5 +154,14 @@ private:
     // Incremented when a caller is waiting for more of the oplog to become visible, to avoid update
     // delays for batching.
     int64_t _opsWaitingForOplogVisibilityUpdate = 0;
+
+    // When, in microseconds since the epoch, the earliest commit which is not visible yet triggered
+    // an oplog visibility update. 0 if there is no such commit.
+    unsigned long long _oplogVisibilityUpdateTriggeredAtMicros = 0;
+
+    // Histogram of the delays between triggering and publishing oplog visibility updates.
+    std::array<int64_t, kVisibilityDelayBucketsMicros.size()> _visibilityDelayBuckets{};
+    int64_t _visibilityDelayTotalMicros = 0;
+    int64_t _visibilityUpdates = 0;
 };
 }  // namespace mongo
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_prefetcher.h"
+
+#include <wiredtiger.h>
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+namespace {
+// Bounds the memory held by queued batches, and the I/O the prefetcher can have outstanding.
+constexpr int64_t kMaxQueuedRecords = 16 * 1024;
+constexpr size_t kMaxThreads = 4;
+}  // namespace
+
+WiredTigerRecordPrefetcher::WiredTigerRecordPrefetcher(WiredTigerSessionCache* sessionCache)
+    : _sessionCache(sessionCache) {
+    ThreadPool::Options options;
+    options.poolName = "WTRecordPrefetcher";
+    options.threadNamePrefix = "WTRecordPrefetcher-";
+    options.minThreads = 0;
+    options.maxThreads = kMaxThreads;
+    _pool = std::make_unique<ThreadPool>(std::move(options));
+    _pool->startup();
+}
+
+WiredTigerRecordPrefetcher::~WiredTigerRecordPrefetcher() {
+    shutdown();
+}
+
+void WiredTigerRecordPrefetcher::prefetch(const std::string& uri,
+                                          uint64_t tableId,
+                                          KVPrefix prefix,
+                                          std::vector<RecordId> ids) {
+    const auto numIds = static_cast<int64_t>(ids.size());
+    if (numIds == 0 || _shutDown.load()) {
+        return;
+    }
+    if (_queuedRecords.addAndFetch(numIds) > kMaxQueuedRecords) {
+        _queuedRecords.subtractAndFetch(numIds);
+        return;
+    }
+
+    _pool->schedule([this, uri, tableId, prefix, ids = std::move(ids)](Status status) {
+        if (status.isOK() && !_shutDown.load()) {
+            _prefetchBatch(uri, tableId, prefix, ids);
+        }
+        _queuedRecords.subtractAndFetch(static_cast<int64_t>(ids.size()));
+    });
+}
+
+void WiredTigerRecordPrefetcher::shutdown() {
+    if (_shutDown.swap(true)) {
+        return;
+    }
+    _pool->shutdown();
+    _pool->join();
+}
+
+void WiredTigerRecordPrefetcher::_prefetchBatch(const std::string& uri,
+                                                uint64_t tableId,
+                                                KVPrefix prefix,
+                                                const std::vector<RecordId>& ids) {
+    auto session = _sessionCache->getSession();
+    WT_CURSOR* cursor = session->getCachedCursor(uri, tableId);
+    try {
+        if (!cursor) {
+            cursor = session->getNewCursor(uri);
+        }
+    } catch (const DBException&) {
+        // The table is gone or busy, which makes the prefetch moot.
+        return;
+    }
+
+    for (auto&& id : ids) {
+        if (prefix.isPrefixed()) {
+            cursor->set_key(cursor, prefix.repr(), id.repr());
+        } else {
+            cursor->set_key(cursor, id.repr());
+        }
+
+        // The search runs in an implicit transaction of its own. Whatever it finds, or fails to
+        // find because of a concurrent writer, is of no interest beyond having paged the record
+        // in, and resetting the cursor releases the page.
+        cursor->search(cursor);
+        cursor->reset(cursor);
+    }
+    session->releaseCursor(tableId, cursor);
+}
+
+}  // namespace mongo
@@ -0,0 +1,86 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/kv/kv_prefix.h"
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+class ThreadPool;
+class WiredTigerSessionCache;
+
+/**
+ * Reads records into the WiredTiger cache in the background, ahead of the cursors which are about
+ * to seek them. Each batch of records is looked up by a pool thread through a session of its own:
+ * the records themselves are discarded, the purpose of the lookups being to page in the parts of
+ * the table the records live in. Lookups are best effort; batches are dropped when too many
+ * records are already queued, and errors such as the table having been dropped are ignored.
+ */
+class WiredTigerRecordPrefetcher {
+public:
+    explicit WiredTigerRecordPrefetcher(WiredTigerSessionCache* sessionCache);
+    ~WiredTigerRecordPrefetcher();
+
+    /**
+     * Queues the records 'ids' of the table 'uri' for prefetching. 'prefix' is the KVPrefix of the
+     * record store, or KVPrefix::kNotPrefixed.
+     */
+    void prefetch(const std::string& uri,
+                  uint64_t tableId,
+                  KVPrefix prefix,
+                  std::vector<RecordId> ids);
+
+    /**
+     * Waits for the queued lookups to finish and stops the pool threads. Must be called before the
+     * session cache shuts down. Later calls to prefetch() are ignored.
+     */
+    void shutdown();
+
+private:
+    void _prefetchBatch(const std::string& uri,
+                        uint64_t tableId,
+                        KVPrefix prefix,
+                        const std::vector<RecordId>& ids);
+
+    WiredTigerSessionCache* const _sessionCache;
+    std::unique_ptr<ThreadPool> _pool;
+
+    // The number of records queued for prefetching and not yet looked up.
+    AtomicWord<int64_t> _queuedRecords{0};
+    AtomicWord<bool> _shutDown{false};
+};
+
+}  // namespace mongo
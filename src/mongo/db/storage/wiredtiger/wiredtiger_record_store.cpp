@@ -38,9 +38,12 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "mongo/base/checked_cast.h"
+#include "mongo/base/counter.h"
 #include "mongo/base/static_assert.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/catalog/validate_results.h"
@@ -54,6 +57,8 @@
 #include "mongo/db/server_recovery.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/db/storage/clustered_key.h"
+#include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/storage/wiredtiger/oplog_stone_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor_helpers.h"
@@ -61,6 +66,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_prefetcher.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
@@ -68,6 +74,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
@@ -99,6 +106,12 @@ MONGO_STATIC_ASSERT(kCurrentRecordStoreVersion <= kMaximumRecordStoreVersion);
 
 const double kNumMSInHour = 1000 * 60 * 60;
 
+// The document updates applied with WT_CURSOR::modify, and those which rewrote the whole document.
+StripedCounter64 updatesModified;
+StripedCounter64 updatesModifiedBytes;
+StripedCounter64 updatesRewritten;
+StripedCounter64 updatesRewrittenBytes;
+
 void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
     StatusWith<BSONObj> appMetadata = WiredTigerUtil::getApplicationMetadata(opCtx, uri);
     fassert(39999, appMetadata);
@@ -125,6 +138,9 @@ const std::string kWiredTigerEngineName = "wiredTiger";
 // cursors will be available in the needed session caches.
 static int kCappedDocumentRemoveLimit = 3;
 
+// The size storer key prefix, followed by the table URI, of an oplog's persisted stones.
+static const std::string kPersistedOplogStonesKeyPrefix = "oplogStones:";
+
 class WiredTigerRecordStore::OplogStones::InsertChange final : public RecoveryUnit::Change {
 public:
     InsertChange(OplogStones* oplogStones,
@@ -189,6 +205,7 @@ public:
 
         stdx::lock_guard<Latch> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_persistStones_inlock();
     }
 
     void rollback() final {}
@@ -221,6 +238,7 @@ WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* opCtx, WiredTi
     invariant(_minBytesPerStone > 0);
 
     _calculateStones(opCtx, numStonesToKeep);
+    _persistStones_inlock();
     _pokeReclaimThreadIfNeeded();  // Reclaim stones if over the limit.
 }
 
@@ -263,30 +281,37 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
 }
 
 bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
+    return _numExcessStones_inlock(1) > 0;
+}
+
+size_t WiredTigerRecordStore::OplogStones::_numExcessStones_inlock(size_t maxStones) const {
     int64_t totalBytes = 0;
     for (auto&& stone : _stones) {
         totalBytes += stone.bytes;
     }
 
-    // check that oplog stones is at capacity
-    if (totalBytes <= _rs->cappedMaxSize()) {
-        return false;
-    }
-
     double minRetentionHours = storageGlobalParams.oplogMinRetentionHours.load();
-
-    // If we are not checking for time, then yes, there is a stone to be reaped
-    // because oplog is at capacity.
-    if (minRetentionHours == 0.0) {
-        return true;
-    }
-
     auto nowWall = Date_t::now();
-    auto lastStoneWall = _stones.front().wallTime;
 
-    auto currRetentionMS = durationCount<Milliseconds>(nowWall - lastStoneWall);
-    double currRetentionHours = currRetentionMS / kNumMSInHour;
-    return currRetentionHours >= minRetentionHours;
+    size_t numStones = 0;
+    // check that oplog stones is at capacity without the stones already counted
+    while (numStones < maxStones && numStones < _stones.size() &&
+           totalBytes > _rs->cappedMaxSize()) {
+        // If we are not checking for time, then yes, the stone can be reaped because the oplog is
+        // at capacity.
+        if (minRetentionHours != 0.0) {
+            auto currRetentionMS =
+                durationCount<Milliseconds>(nowWall - _stones[numStones].wallTime);
+            double currRetentionHours = currRetentionMS / kNumMSInHour;
+            if (currRetentionHours < minRetentionHours) {
+                break;
+            }
+        }
+
+        totalBytes -= _stones[numStones].bytes;
+        ++numStones;
+    }
+    return numStones;
 }
 
 boost::optional<WiredTigerRecordStore::OplogStones::Stone>
@@ -300,9 +325,22 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
     return _stones.front();
 }
 
+std::vector<WiredTigerRecordStore::OplogStones::Stone>
+WiredTigerRecordStore::OplogStones::peekOldestStonesIfNeeded(size_t maxStones) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    size_t numStones = _numExcessStones_inlock(maxStones);
+    return std::vector<Stone>(_stones.begin(), _stones.begin() + numStones);
+}
+
 void WiredTigerRecordStore::OplogStones::popOldestStone() {
+    popOldestStones(1);
+}
+
+void WiredTigerRecordStore::OplogStones::popOldestStones(size_t numStones) {
     stdx::lock_guard<Latch> lk(_mutex);
-    _stones.pop_front();
+    invariant(numStones <= _stones.size());
+    _stones.erase(_stones.begin(), _stones.begin() + numStones);
+    _persistStones_inlock();
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext* opCtx,
@@ -340,6 +378,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext
 
     OplogStones::Stone stone(_currentRecords.swap(0), _currentBytes.swap(0), lastRecord, wallTime);
     _stones.push_back(stone);
+    _persistStones_inlock();
 
     _pokeReclaimThreadIfNeeded();
 }
@@ -379,6 +418,7 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // Remove the stones corresponding to the records that were deleted.
     int64_t offset = _stones.size() - numStonesToRemove;
     _stones.erase(_stones.begin() + offset, _stones.end());
+    _persistStones_inlock();
 
     // Account for any remaining records from a partially truncated stone in the stone currently
     // being filled.
@@ -425,6 +465,10 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
         return;
     }
 
+    if (_loadPersistedStones(opCtx, numRecords, dataSize)) {
+        return;
+    }
+
     // Only use sampling to estimate where to place the oplog stones if the number of samples drawn
     // is less than 5% of the collection.
     const uint64_t kMinSampleRatioForRandCursor = 20;
@@ -600,6 +644,94 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
     _currentBytes.store(_rs->dataSize(opCtx) - estBytesPerStone * wholeStones);
 }
 
+bool WiredTigerRecordStore::OplogStones::_loadPersistedStones(OperationContext* opCtx,
+                                                              long long numRecords,
+                                                              long long dataSize) {
+    if (!_rs->_sizeStorer) {
+        return false;
+    }
+    auto persisted = _rs->_sizeStorer->loadDocument(kPersistedOplogStonesKeyPrefix + _rs->_uri);
+    if (!persisted) {
+        return false;
+    }
+
+    // The truncations and rollbacks since the stones were last persisted may have removed records
+    // from either end of the oplog. Only keep the stones which still end inside of it.
+    boost::optional<RecordId> firstRecordId;
+    boost::optional<RecordId> lastRecordId;
+    if (auto record = _rs->getCursor(opCtx, true)->next()) {
+        firstRecordId = record->id;
+    }
+    if (auto record = _rs->getCursor(opCtx, false)->next()) {
+        lastRecordId = record->id;
+    }
+    if (!firstRecordId || !lastRecordId) {
+        return false;
+    }
+
+    std::deque<Stone> stones;
+    try {
+        for (auto&& elem : (*persisted)["stones"].Obj()) {
+            BSONObj stoneObj = elem.Obj();
+            Stone stone(stoneObj["records"].safeNumberLong(),
+                        stoneObj["bytes"].safeNumberLong(),
+                        RecordId(stoneObj["lastRecord"].safeNumberLong()),
+                        stoneObj["wallTime"].Date());
+            if (!stones.empty() && stone.lastRecord <= stones.back().lastRecord) {
+                return false;
+            }
+            if (stone.lastRecord >= *firstRecordId && stone.lastRecord <= *lastRecordId) {
+                stones.push_back(stone);
+            }
+        }
+    } catch (const DBException& ex) {
+        LOGV2_WARNING(5843210,
+                      "Ignoring invalid persisted oplog truncation markers",
+                      "error"_attr = ex.toStatus());
+        return false;
+    }
+    if (stones.empty()) {
+        return false;
+    }
+
+    int64_t stonesRecords = 0;
+    int64_t stonesBytes = 0;
+    for (auto&& stone : stones) {
+        stonesRecords += stone.records;
+        stonesBytes += stone.bytes;
+    }
+
+    LOGV2(5843211,
+          "Loaded the persisted oplog truncation markers",
+          "numMarkers"_attr = stones.size(),
+          "firstMarker"_attr = stones.front().lastRecord,
+          "lastMarker"_attr = stones.back().lastRecord);
+    _processByLoading.store(true);
+    _stones = std::move(stones);
+
+    // The records after the last stone make up the stone being filled.
+    _currentRecords.store(std::max<int64_t>(0, numRecords - stonesRecords));
+    _currentBytes.store(std::max<int64_t>(0, dataSize - stonesBytes));
+    return true;
+}
+
+void WiredTigerRecordStore::OplogStones::_persistStones_inlock() {
+    if (!_rs->_sizeStorer) {
+        return;
+    }
+
+    BSONObjBuilder builder;
+    {
+        BSONArrayBuilder stonesBuilder(builder.subarrayStart("stones"));
+        for (auto&& stone : _stones) {
+            stonesBuilder.append(BSON("records" << stone.records << "bytes" << stone.bytes
+                                                << "lastRecord" << stone.lastRecord.repr()
+                                                << "wallTime" << stone.wallTime));
+        }
+    }
+    _rs->_sizeStorer->storeDocument(kPersistedOplogStonesKeyPrefix + _rs->_uri, builder.obj());
+}
+
 void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
     if (hasExcessStones_inlock()) {
         _oplogReclaimCv.notify_one();
@@ -810,6 +942,7 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
       _tableId(WiredTigerSession::genTableId()),
       _engineName(params.engineName),
       _isCapped(params.isCapped),
+      _isClustered(params.isClustered),
       _isEphemeral(params.isEphemeral),
       _isLogged(!isTemp() &&
                 WiredTigerUtil::useTableLogging(
@@ -1208,6 +1341,14 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded_inlock(OperationContext* op
     int64_t dataSize = _sizeInfo->dataSize.load();
     int64_t numRecords = _sizeInfo->numRecords.load();
 
+    // Don't delete past the oldest capped insert which hasn't committed yet, since the side
+    // transaction would conflict with it.
+    RecordId deleteBefore = justInserted;
+    if (auto oldestUncommitted = _oldestUncommittedCappedRecordId();
+        !oldestUncommitted.isNull() && oldestUncommitted < deleteBefore) {
+        deleteBefore = oldestUncommitted;
+    }
+
     int64_t sizeOverCap = (dataSize > _cappedMaxSize) ? dataSize - _cappedMaxSize : 0;
     int64_t sizeSaved = 0;
     int64_t docsOverCap = 0, docsRemoved = 0;
@@ -1247,8 +1388,8 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded_inlock(OperationContext* op
             positioned = false;
 
             newestIdToDelete = getKey(truncateEnd);
-            // don't go past the record we just inserted
-            if (newestIdToDelete >= justInserted)  // TODO: use oldest uncommitted instead
+            // don't go past the record we just inserted, or any other uncommitted one
+            if (newestIdToDelete >= deleteBefore)
                 break;
 
             WT_ITEM old_value;
@@ -1276,7 +1417,7 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded_inlock(OperationContext* op
 
         if (docsRemoved > 0) {
             // if we scanned to the end of the collection or past our insert, go back one
-            if (ret == WT_NOTFOUND || newestIdToDelete >= justInserted) {
+            if (ret == WT_NOTFOUND || newestIdToDelete >= deleteBefore) {
                 ret = wiredTigerPrepareConflictRetry(
                     opCtx, [&] { return truncateEnd->prev(truncateEnd); });
             }
@@ -1386,28 +1527,37 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
 
 void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayTruncateUpTo) {
     Timer timer;
-    while (auto stone = _oplogStones->peekOldestStoneIfNeeded()) {
-        invariant(stone->lastRecord.isValid());
+    bool paceTruncation = false;
+    while (true) {
+        // Truncate the records of several stones with each range truncation, pausing in between
+        // to spread out the cache pressure of reclaiming a large backlog.
+        auto stones = _oplogStones->peekOldestStonesIfNeeded(
+            static_cast<size_t>(gOplogTruncationMaxPointsPerBatch.load()));
+        if (stones.empty()) {
+            break;
+        }
 
-        if (static_cast<std::uint64_t>(stone->lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
-            // Do not truncate oplogs needed for replication recovery.
+        // Do not truncate oplogs needed for replication recovery.
+        while (!stones.empty() &&
+               static_cast<std::uint64_t>(stones.back().lastRecord.repr()) >=
+                   mayTruncateUpTo.asULL()) {
+            stones.pop_back();
+        }
+        if (stones.empty()) {
             return;
         }
 
-        LOGV2_DEBUG(
-            22399,
-            1,
-            "Truncating the oplog between {oplogStones_firstRecord} and {stone_lastRecord} to "
-            "remove approximately {stone_records} records totaling to {stone_bytes} bytes",
-            "oplogStones_firstRecord"_attr = _oplogStones->firstRecord,
-            "stone_lastRecord"_attr = stone->lastRecord,
-            "stone_records"_attr = stone->records,
-            "stone_bytes"_attr = stone->bytes);
+        if (std::exchange(paceTruncation, true)) {
+            if (auto pauseMillis = gOplogTruncationBatchPauseMillis.load()) {
+                sleepmillis(pauseMillis);
+            }
+        }
 
         WiredTigerRecoveryUnit* ru = WiredTigerRecoveryUnit::get(opCtx);
         WT_SESSION* session = ru->getSession()->getSession();
 
         try {
+            const OplogStones::Stone* stone = &stones.back();
             WriteUnitOfWork wuow(opCtx);
 
             WiredTigerCursor cwrap(_uri, _tableId, true, opCtx);
@@ -1433,31 +1583,60 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
             ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->search(cursor); });
             invariantWTOK(ret);
             ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->next(cursor); });
-            if (ret == WT_NOTFOUND) {
-                LOGV2_DEBUG(5140900, 0, "Will not truncate entire oplog");
-                return;
+            boost::optional<RecordId> nextRecord;
+            if (ret != WT_NOTFOUND) {
+                invariantWTOK(ret);
+                nextRecord = getKey(cursor);
             }
-            invariantWTOK(ret);
-            RecordId nextRecord = getKey(cursor);
-            if (static_cast<std::uint64_t>(nextRecord.repr()) > mayTruncateUpTo.asULL()) {
-                LOGV2_DEBUG(5140901,
-                            0,
-                            "Cannot truncate as there are no oplog entries after the stone but "
-                            "before the truncate-up-to point",
-                            "nextRecord"_attr = Timestamp(nextRecord.repr()),
-                            "mayTruncateUpTo"_attr = mayTruncateUpTo);
-                return;
+            if (!nextRecord ||
+                static_cast<std::uint64_t>(nextRecord->repr()) > mayTruncateUpTo.asULL()) {
+                if (stones.size() == 1) {
+                    if (!nextRecord) {
+                        LOGV2_DEBUG(5140900, 0, "Will not truncate entire oplog");
+                    } else {
+                        LOGV2_DEBUG(5140901,
+                                    0,
+                                    "Cannot truncate as there are no oplog entries after the "
+                                    "stone but before the truncate-up-to point",
+                                    "nextRecord"_attr = Timestamp(nextRecord->repr()),
+                                    "mayTruncateUpTo"_attr = mayTruncateUpTo);
+                    }
+                    return;
+                }
+
+                // The records of the last stone come after the previous one, and before the
+                // truncate-up-to point, so the earlier stones can still be truncated.
+                stones.pop_back();
+                stone = &stones.back();
+            }
+
+            int64_t records = 0;
+            int64_t bytes = 0;
+            for (auto&& truncatedStone : stones) {
+                records += truncatedStone.records;
+                bytes += truncatedStone.bytes;
             }
+
+            LOGV2_DEBUG(22399,
+                        1,
+                        "Truncating the oplog between {oplogStones_firstRecord} and "
+                        "{stone_lastRecord} to remove approximately {stone_records} records "
+                        "totaling to {stone_bytes} bytes",
+                        "oplogStones_firstRecord"_attr = _oplogStones->firstRecord,
+                        "stone_lastRecord"_attr = stone->lastRecord,
+                        "stone_records"_attr = records,
+                        "stone_bytes"_attr = bytes);
+
             invariantWTOK(cursor->reset(cursor));
             setKey(cursor, stone->lastRecord);
             invariantWTOK(session->truncate(session, nullptr, nullptr, cursor, nullptr));
-            _changeNumRecords(opCtx, -stone->records);
-            _increaseDataSize(opCtx, -stone->bytes);
+            _changeNumRecords(opCtx, -records);
+            _increaseDataSize(opCtx, -bytes);
 
             wuow.commit();
 
-            // Remove the stone after a successful truncation.
-            _oplogStones->popOldestStone();
+            // Remove the stones after a successful truncation.
+            _oplogStones->popOldestStones(stones.size());
 
             // Stash the truncate point for next time to cleanly skip over tombstones, etc.
             _oplogStones->firstRecord = stone->lastRecord;
@@ -1507,13 +1686,18 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     if (_isCapped && totalLength > _cappedMaxSize)
         return Status(ErrorCodes::BadValue, "object to insert exceeds cappedMaxSize");
 
-    WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
+    // Records of a clustered collection are keyed by _id, so inserting a record over an existing
+    // one must fail rather than overwrite it.
+    WiredTigerCursor curwrap(_uri, _tableId, !_isClustered, opCtx);
     curwrap.assertInActiveTxn();
     WT_CURSOR* c = curwrap.get();
     invariant(c);
 
     Record highestIdRecord;
     invariant(nRecords != 0);
+    if (_isCapped && !_isOplog && !_isClustered) {
+        _reserveCappedRecordIds(opCtx, records, nRecords);
+    }
     for (size_t i = 0; i < nRecords; i++) {
         auto& record = records[i];
         if (_isOplog) {
@@ -1522,11 +1706,20 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             if (!status.isOK())
                 return status.getStatus();
             record.id = status.getValue();
-        } else {
+        } else if (_isClustered) {
+            StatusWith<RecordId> status =
+                clustered_key::extractKey(record.data.data(), record.data.size());
+            if (!status.isOK())
+                return status.getStatus();
+            record.id = status.getValue();
+        } else if (!_isCapped) {
             record.id = _nextId(opCtx);
         }
-        dassert(record.id > highestIdRecord.id);
-        highestIdRecord = record;
+        // The _id values of a batch of documents of a clustered collection come in any order.
+        dassert(_isClustered || record.id > highestIdRecord.id);
+        if (record.id > highestIdRecord.id) {
+            highestIdRecord = record;
+        }
     }
 
     for (size_t i = 0; i < nRecords; i++) {
@@ -1552,6 +1745,14 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
         WiredTigerItem value(record.data.data(), record.data.size());
         c->set_value(c, value.Get());
         int ret = WT_OP_CHECK(wiredTigerCursorInsert(opCtx, c));
+        if (ret == WT_DUPLICATE_KEY && _isClustered) {
+            const BSONObj obj(record.data.data());
+            return buildDupKeyErrorStatus(BSON("" << obj["_id"]),
+                                          NamespaceString(ns()),
+                                          "_id_",
+                                          BSON("_id" << 1),
+                                          BSONObj());
+        }
         if (ret)
             return wtRCToStatus(ret, "WiredTigerRecordStore::insertRecord");
 
@@ -1677,12 +1878,13 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
     WiredTigerItem value(data, len);
 
     // Check if we should modify rather than doing a full update.  Look for deltas for documents
-    // larger than 1KB, up to 16 changes representing up to 10% of the data.
+    // larger than 1KB, representing up to 10% of the data. Up to 16 changes are allowed, plus one
+    // per 4KB of data, so that large documents with several updated fields still get modified.
     //
     // Skip modify for logged tables: don't trust WiredTiger's recovery with operations that are not
     // idempotent.
     const int kMinLengthForDiff = 1024;
-    const int kMaxEntries = 16;
+    const int kMaxEntries = 16 + len / 4096;
     const int kMaxDiffBytes = len / 10;
 
     bool skip_update = false;
@@ -1706,6 +1908,8 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
                 modifiedDataSize += entries[i].size + entries[i].data.size;
             };
             metricsCollector.incrementOneDocWritten(modifiedDataSize);
+            updatesModified.increment();
+            updatesModifiedBytes.increment(modifiedDataSize);
 
             WT_ITEM new_value;
             dassert(nentries == 0 ||
@@ -1721,6 +1925,8 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
         c->set_value(c, value.Get());
         ret = WT_OP_CHECK(wiredTigerCursorInsert(opCtx, c));
         metricsCollector.incrementOneDocWritten(value.size);
+        updatesRewritten.increment();
+        updatesRewrittenBytes.increment(value.size);
     }
     invariantWTOK(ret);
 
@@ -1732,6 +1938,13 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
     return Status::OK();
 }
 
+void WiredTigerRecordStore::appendUpdateStats(BSONObjBuilder* builder) {
+    builder->append("modified", updatesModified.get());
+    builder->append("modifiedBytes", updatesModifiedBytes.get());
+    builder->append("rewritten", updatesRewritten.get());
+    builder->append("rewrittenBytes", updatesRewrittenBytes.get());
+}
+
 bool WiredTigerRecordStore::updateWithDamagesSupported() const {
     return true;
 }
@@ -1773,6 +1986,8 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
 
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
     metricsCollector.incrementOneDocWritten(modifiedDataSize);
+    updatesModified.increment();
+    updatesModifiedBytes.increment(modifiedDataSize);
 
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
@@ -2006,6 +2221,96 @@ RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx) {
     return out;
 }
 
+class WiredTigerRecordStore::CappedInsertChange : public RecoveryUnit::Change {
+public:
+    CappedInsertChange(WiredTigerRecordStore* rs, const RecordId& first, const RecordId& last)
+        : _rs(rs), _first(first), _last(last) {}
+    virtual void commit(boost::optional<Timestamp>) {
+        stdx::lock_guard<Latch> lk(_rs->_uncommittedCappedRecordIdsMutex);
+        // Snapshots established before this commit may not see the records, so remember which
+        // RecordIds they must hide.
+        auto& history = _rs->_cappedCommitHistory;
+        if (history.size() == kMaxCappedCommitHistory) {
+            _rs->_cappedCommitHistoryDroppedEpoch = history.front().first;
+            history.pop_front();
+        }
+        history.emplace_back(WiredTigerRecoveryUnit::cappedInsertCommitEpoch.addAndFetch(1),
+                             _rs->_uncommittedCappedRecordIds.begin()->first);
+        _makeVisible(lk);
+    }
+    virtual void rollback() {
+        stdx::lock_guard<Latch> lk(_rs->_uncommittedCappedRecordIdsMutex);
+        _makeVisible(lk);
+    }
+
+private:
+    static constexpr size_t kMaxCappedCommitHistory = 1024;
+
+    void _makeVisible(WithLock) {
+        auto& ids = _rs->_uncommittedCappedRecordIds;
+        ids.erase(ids.lower_bound(_first), ids.upper_bound(_last));
+    }
+
+    WiredTigerRecordStore* _rs;
+    const RecordId _first;
+    const RecordId _last;
+};
+
+void WiredTigerRecordStore::_reserveCappedRecordIds(OperationContext* opCtx,
+                                                    Record* records,
+                                                    size_t nRecords) {
+    invariant(_isCapped && !_isOplog);
+    _initNextIdIfNeeded(opCtx);
+    {
+        stdx::lock_guard<Latch> lk(_uncommittedCappedRecordIdsMutex);
+        const auto firstId = _nextIdNum.fetchAndAdd(nRecords);
+        for (size_t i = 0; i < nRecords; i++) {
+            records[i].id = RecordId(firstId + i);
+            invariant(records[i].id.isNormal());
+            _uncommittedCappedRecordIds.emplace_hint(
+                _uncommittedCappedRecordIds.end(), records[i].id, opCtx->recoveryUnit());
+        }
+    }
+    opCtx->recoveryUnit()->registerChange(
+        std::make_unique<CappedInsertChange>(this, records[0].id, records[nRecords - 1].id));
+}
+
+RecordId WiredTigerRecordStore::_oldestUncommittedCappedRecordId() const {
+    stdx::lock_guard<Latch> lk(_uncommittedCappedRecordIdsMutex);
+    return _uncommittedCappedRecordIds.empty() ? RecordId()
+                                               : _uncommittedCappedRecordIds.begin()->first;
+}
+
+RecordId WiredTigerRecordStore::_cappedHiddenFromIdForSnapshot(OperationContext* opCtx) const {
+    const auto snapshotEpoch = WiredTigerRecoveryUnit::get(opCtx)->getCappedVisibilityEpoch();
+    stdx::lock_guard<Latch> lk(_uncommittedCappedRecordIdsMutex);
+
+    // If inserts committed after the snapshot was established, the oldest RecordId which was
+    // uncommitted before the first of them bounds what the snapshot can see.
+    auto firstLater = std::upper_bound(
+        _cappedCommitHistory.begin(),
+        _cappedCommitHistory.end(),
+        snapshotEpoch,
+        [](uint64_t epoch, const std::pair<uint64_t, RecordId>& commit) {
+            return epoch < commit.first;
+        });
+    if (firstLater != _cappedCommitHistory.end()) {
+        if (_cappedCommitHistoryDroppedEpoch > snapshotEpoch) {
+            throw WriteConflictException();
+        }
+        return firstLater->second;
+    }
+    return _uncommittedCappedRecordIds.empty() ? RecordId()
+                                               : _uncommittedCappedRecordIds.begin()->first;
+}
+
+bool WiredTigerRecordStore::_isOwnUncommittedCappedRecordId(OperationContext* opCtx,
+                                                            const RecordId& id) const {
+    stdx::lock_guard<Latch> lk(_uncommittedCappedRecordIdsMutex);
+    auto it = _uncommittedCappedRecordIds.find(id);
+    return it != _uncommittedCappedRecordIds.end() && it->second == opCtx->recoveryUnit();
+}
+
 WiredTigerRecoveryUnit* WiredTigerRecordStore::_getRecoveryUnit(OperationContext* opCtx) {
     return checked_cast<WiredTigerRecoveryUnit*>(opCtx->recoveryUnit());
 }
@@ -2218,6 +2523,8 @@ WiredTigerRecordStoreCursorBase::WiredTigerRecordStoreCursorBase(OperationContex
     : _rs(rs), _opCtx(opCtx), _forward(forward) {
     if (_rs._isOplog) {
         _oplogVisibleTs = WiredTigerRecoveryUnit::get(opCtx)->getOplogVisibilityTs();
+    } else if (_rs._isCapped && _forward) {
+        _cappedHiddenFromId = _rs._cappedHiddenFromIdForSnapshot(opCtx);
     }
     _cursor.emplace(rs.getURI(), rs.tableId(), true, opCtx);
 }
@@ -2262,6 +2569,12 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
         return {};
     }
 
+    if (_forward && !_cappedHiddenFromId.isNull() && id >= _cappedHiddenFromId &&
+        !_rs._isOwnUncommittedCappedRecordId(_opCtx, id)) {
+        _eof = true;
+        return {};
+    }
+
     if (_forward && _lastReturnedId >= id) {
         LOGV2(22406,
               "WTCursor::next -- c->next_key ( {next}) was not greater than _lastReturnedId "
@@ -2285,7 +2598,7 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     metricsCollector.incrementOneDocRead(value.size);
 
     _lastReturnedId = id;
-    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    return {{id, getRecordData(value)}};
 }
 
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
@@ -2322,9 +2635,17 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
 
     _lastReturnedId = id;
     _eof = false;
-    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    return {{id, getRecordData(value)}};
 }
 
+void WiredTigerRecordStoreCursorBase::prefetch(std::vector<RecordId> ids) {
+    if (!_rs._kvEngine) {
+        return;
+    }
+    if (auto prefetcher = _rs._kvEngine->getRecordPrefetcher()) {
+        prefetcher->prefetch(_rs.getURI(), _rs.tableId(), getPrefix(), std::move(ids));
+    }
+}
 
 void WiredTigerRecordStoreCursorBase::save() {
     try {
@@ -2348,6 +2669,8 @@ bool WiredTigerRecordStoreCursorBase::restore() {
         auto wtRu = WiredTigerRecoveryUnit::get(_opCtx);
         wtRu->setIsOplogReader();
         _oplogVisibleTs = wtRu->getOplogVisibilityTs();
+    } else if (_rs._isCapped && !_rs._isOplog && _forward) {
+        _cappedHiddenFromId = _rs._cappedHiddenFromIdForSnapshot(_opCtx);
     }
 
     if (!_cursor)
@@ -2415,6 +2738,28 @@ void WiredTigerRecordStoreCursorBase::reattachToOperationContext(OperationContex
     // _cursor recreated in restore() to avoid risk of WT_ROLLBACK issues.
 }
 
+void WiredTigerRecordStoreCursorBase::setFieldsToReturn(std::set<std::string> fields) {
+    invariant(_lastReturnedId.isNull());
+    _fieldsToReturn = std::move(fields);
+}
+
+RecordData WiredTigerRecordStoreCursorBase::getRecordData(const WT_ITEM& value) const {
+    RecordData data{static_cast<const char*>(value.data), static_cast<int>(value.size)};
+    if (!_fieldsToReturn) {
+        return data;
+    }
+
+    BSONObjBuilder builder;
+    for (auto&& elem : data.toBson()) {
+        if (_fieldsToReturn->count(elem.fieldName())) {
+            builder.append(elem);
+        }
+    }
+    BSONObj trimmed = builder.obj();
+    const int size = trimmed.objsize();
+    return {trimmed.releaseSharedBuffer().constCast(), size};
+}
+
 // Standard Implementations:
 
 
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -102,11 +104,19 @@ public:
                                                         StringData extraStrings,
                                                         bool prefixed);
 
+    /**
+     * Appends the number of document updates of all record stores which WiredTiger applied as
+     * modifications of the stored document, and of those which rewrote it in full, with the number
+     * of bytes each wrote.
+     */
+    static void appendUpdateStats(BSONObjBuilder* builder);
+
     struct Params {
         StringData ns;
         std::string ident;
         std::string engineName;
         bool isCapped;
+        bool isClustered = false;
         bool isEphemeral;
         int64_t cappedMaxSize;
         int64_t cappedMaxDocs;
@@ -133,6 +143,10 @@ public:
 
     virtual bool isCapped() const;
 
+    bool isClustered() const final {
+        return _isClustered;
+    }
+
     virtual int64_t storageSize(OperationContext* opCtx,
                                 BSONObjBuilder* extraInfo = nullptr,
                                 int infoLevel = 0) const;
@@ -289,6 +303,7 @@ private:
 
     class NumRecordsChange;
     class DataSizeChange;
+    class CappedInsertChange;
 
     static WiredTigerRecoveryUnit* _getRecoveryUnit(OperationContext* opCtx);
 
@@ -298,6 +313,37 @@ private:
                           size_t nRecords);
 
     RecordId _nextId(OperationContext* opCtx);
+
+    /**
+     * Assigns new RecordIds to the records of an insert into a capped collection. The records stay
+     * hidden from the forward cursors of other operations, together with all of the records after
+     * them, until the insert commits or rolls back. This lets capped inserts run concurrently
+     * while readers, in particular tailable cursors, only ever see a prefix of the collection in
+     * RecordId order.
+     */
+    void _reserveCappedRecordIds(OperationContext* opCtx, Record* records, size_t nRecords);
+
+    /**
+     * Returns the oldest RecordId reserved by a capped insert which has not committed or rolled
+     * back yet, or a null RecordId if there is none.
+     */
+    RecordId _oldestUncommittedCappedRecordId() const;
+
+    /**
+     * Returns the RecordId from which the forward cursors of 'opCtx' must hide the records of
+     * other operations, so that they only see a prefix of the collection in the operation's
+     * snapshot. This is the oldest RecordId which was uncommitted when the snapshot was
+     * established, even if the snapshot was established earlier, and establishes one if needed.
+     * Throws WriteConflictException if the snapshot is too old to tell.
+     */
+    RecordId _cappedHiddenFromIdForSnapshot(OperationContext* opCtx) const;
+
+    /**
+     * Returns true if 'id' was reserved by a capped insert of 'opCtx' which has not committed or
+     * rolled back yet. Operations can always read their own writes.
+     */
+    bool _isOwnUncommittedCappedRecordId(OperationContext* opCtx, const RecordId& id) const;
+
     bool cappedAndNeedDelete() const;
     RecordData _getData(const WiredTigerCursor& cursor) const;
 
@@ -355,6 +401,8 @@ private:
     const std::string _engineName;
     // The capped settings should not be updated once operations have started
     const bool _isCapped;
+    // True if the records are keyed by the _id of their documents
+    const bool _isClustered;
     // True if the storage engine is an in-memory storage engine
     const bool _isEphemeral;
     // True if WiredTiger is logging updates to this table
@@ -382,6 +430,20 @@ private:
     mutable Mutex _initNextIdMutex = MONGO_MAKE_LATCH("WiredTigerRecordStore::_initNextIdMutex");
     AtomicWord<long long> _nextIdNum{0};
 
+    // The RecordIds reserved by capped inserts which have not committed or rolled back yet, mapped
+    // to the RecoveryUnit of the insert. Capped RecordIds are reserved under this mutex, so that
+    // the oldest uncommitted one is never missed.
+    mutable Mutex _uncommittedCappedRecordIdsMutex =
+        MONGO_MAKE_LATCH("WiredTigerRecordStore::_uncommittedCappedRecordIdsMutex");
+    std::map<RecordId, const RecoveryUnit*> _uncommittedCappedRecordIds;
+
+    // For the latest capped insert commits, their WiredTigerRecoveryUnit::cappedInsertCommitEpoch
+    // and the oldest RecordId which was uncommitted just before them. Also guarded by
+    // '_uncommittedCappedRecordIdsMutex'.
+    std::deque<std::pair<uint64_t, RecordId>> _cappedCommitHistory;
+    // The epoch of the newest commit dropped from '_cappedCommitHistory'.
+    uint64_t _cappedCommitHistoryDroppedEpoch = 0;
+
     WiredTigerSizeStorer* _sizeStorer;  // not owned, can be NULL
     std::shared_ptr<WiredTigerSizeStorer::SizeInfo> _sizeInfo;
     bool _tracksSizeAdjustments;
@@ -450,6 +512,8 @@ public:
 
     boost::optional<Record> seekExact(const RecordId& id);
 
+    void prefetch(std::vector<RecordId> ids);
+
     void save();
 
     void saveUnpositioned();
@@ -460,11 +524,18 @@ public:
 
     void reattachToOperationContext(OperationContext* opCtx);
 
+    void setFieldsToReturn(std::set<std::string> fields);
+
 protected:
     virtual RecordId getKey(WT_CURSOR* cursor) const = 0;
 
     virtual void setKey(WT_CURSOR* cursor, RecordId id) const = 0;
 
+    /**
+     * Returns the prefix of the keys set by setKey(), or KVPrefix::kNotPrefixed.
+     */
+    virtual KVPrefix getPrefix() const = 0;
+
     /**
      * Callers must have already checked the return value of a positioning method against
      * 'WT_NOTFOUND'. This method allows for additional predicates to be considered on a validly
@@ -491,12 +562,30 @@ protected:
 private:
     bool isVisible(const RecordId& id);
 
+    /**
+     * Returns the record the cursor is positioned on. If the caller asked for a subset of its
+     * fields, the returned data is an owned copy holding only those fields.
+     */
+    RecordData getRecordData(const WT_ITEM& value) const;
+
+    // If set, the top-level fields the caller reads from the records this cursor returns.
+    boost::optional<std::set<std::string>> _fieldsToReturn;
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
      * established.
      */
     boost::optional<std::int64_t> _oplogVisibleTs = boost::none;
+
+    /**
+     * For a forward cursor over a capped collection other than the oplog, the oldest RecordId of
+     * an insert which had not committed when the cursor's snapshot was established. The records
+     * from it onwards are not returned, apart from the operation's own writes, so that a tailable
+     * cursor can't skip past a record which becomes visible later. It is taken again whenever the
+     * cursor is restored.
+     */
+    RecordId _cappedHiddenFromId;
 };
 
 class WiredTigerRecordStoreStandardCursor final : public WiredTigerRecordStoreCursorBase {
@@ -510,6 +599,10 @@ protected:
 
     virtual void setKey(WT_CURSOR* cursor, RecordId id) const override;
 
+    virtual KVPrefix getPrefix() const override {
+        return KVPrefix::kNotPrefixed;
+    }
+
     /**
      * Callers must have already checked the return value of a positioning method against
      * 'WT_NOTFOUND'. This method allows for additional predicates to be considered on a validly
@@ -534,6 +627,10 @@ protected:
 
     virtual void setKey(WT_CURSOR* cursor, RecordId id) const override;
 
+    virtual KVPrefix getPrefix() const override {
+        return _prefix;
+    }
+
     /**
      * Callers must have already checked the return value of a positioning method against
      * 'WT_NOTFOUND'. This method allows for additional predicates to be considered on a validly
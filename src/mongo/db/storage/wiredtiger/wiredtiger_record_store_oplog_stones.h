@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/platform/atomic_word.h"
@@ -67,7 +68,11 @@ public:
 
     void getOplogStonesStats(BSONObjBuilder& builder) const {
         builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
-        builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
+        if (_processByLoading.load()) {
+            builder.append("processingMethod", "loading");
+        } else {
+            builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
+        }
         if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
             builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
         }
@@ -75,8 +80,16 @@ public:
 
     boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
 
+    /**
+     * Returns up to 'maxStones' of the oldest stones, as many as can be removed while the oplog
+     * remains over its maximum size and past its minimum retention.
+     */
+    std::vector<OplogStones::Stone> peekOldestStonesIfNeeded(size_t maxStones) const;
+
     void popOldestStone();
 
+    void popOldestStones(size_t numStones);
+
     void createNewStoneIfNeeded(OperationContext* opCtx, RecordId lastRecord, Date_t wallTime);
 
     void updateCurrentStoneAfterInsertOnCommit(OperationContext* opCtx,
@@ -127,6 +140,22 @@ private:
                                     int64_t estRecordsPerStone,
                                     int64_t estBytesPerStone);
 
+    /**
+     * Replaces the stones with those saved in the size storer by a previous run, which avoids
+     * scanning or sampling the oplog. The saved stones are checked against the first and last
+     * records in the oplog, and the stones no longer describing its contents are discarded.
+     * Returns false if there were no usable saved stones.
+     */
+    bool _loadPersistedStones(OperationContext* opCtx, long long numRecords, long long dataSize);
+
+    /**
+     * Saves the current stones in the size storer, written with its next flush.
+     */
+    void _persistStones_inlock();
+
+    // The number of oldest stones that can be removed by reclaiming, up to 'maxStones'.
+    size_t _numExcessStones_inlock(size_t maxStones) const;
+
     void _pokeReclaimThreadIfNeeded();
 
     static const uint64_t kRandomSamplesPerStone = 10;
@@ -149,6 +178,7 @@ private:
     AtomicWord<int64_t> _totalTimeProcessing;  // Amount of time spent scanning and/or sampling the
                                                // oplog during start up, if any.
     AtomicWord<bool> _processBySampling;       // Whether the oplog was sampled or scanned.
+    AtomicWord<bool> _processByLoading;        // Whether the stones were loaded instead.
 
     // Protects against concurrent access to the deque of oplog stones.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogStones::_mutex");
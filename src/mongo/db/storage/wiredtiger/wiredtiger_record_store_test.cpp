@@ -260,6 +260,95 @@ TEST(WiredTigerRecordStoreTest, CappedCursorRollover) {
     ASSERT(!cursor->next());
 }
 
+TEST(WiredTigerRecordStoreTest, CappedRecordsAfterUncommittedInsertAreHidden) {
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore());
+
+    auto client1 = harnessHelper->serviceContext()->makeClient("c1");
+    auto slowCtx = harnessHelper->newOperationContext(client1.get());
+    WriteUnitOfWork slowUow(slowCtx.get());
+    RecordId slowId = uassertStatusOK(rs->insertRecord(slowCtx.get(), "a", 2, Timestamp()));
+
+    // A later insert commits before the earlier one.
+    RecordId fastId;
+    {
+        auto client2 = harnessHelper->serviceContext()->makeClient("c2");
+        auto opCtx = harnessHelper->newOperationContext(client2.get());
+        WriteUnitOfWork uow(opCtx.get());
+        fastId = uassertStatusOK(rs->insertRecord(opCtx.get(), "b", 2, Timestamp()));
+        uow.commit();
+    }
+    ASSERT_LT(slowId, fastId);
+
+    auto client3 = harnessHelper->serviceContext()->makeClient("c3");
+    auto readerCtx = harnessHelper->newOperationContext(client3.get());
+
+    // Forward cursors can't see past the uncommitted insert, but reverse cursors can.
+    ASSERT(!rs->getCursor(readerCtx.get(), true)->next());
+    auto record = rs->getCursor(readerCtx.get(), false)->next();
+    ASSERT(record);
+    ASSERT_EQ(record->id, fastId);
+    readerCtx->recoveryUnit()->abandonSnapshot();
+
+    // The inserting operation can read its own write.
+    record = rs->getCursor(slowCtx.get(), true)->next();
+    ASSERT(record);
+    ASSERT_EQ(record->id, slowId);
+
+    slowUow.commit();
+
+    auto cursor = rs->getCursor(readerCtx.get(), true);
+    record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(record->id, slowId);
+    record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(record->id, fastId);
+    ASSERT(!cursor->next());
+}
+
+TEST(WiredTigerRecordStoreTest, CappedCursorInOpenSnapshotHidesInsertsCommittedSinceIt) {
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore());
+
+    auto client1 = harnessHelper->serviceContext()->makeClient("c1");
+    auto slowCtx = harnessHelper->newOperationContext(client1.get());
+    WriteUnitOfWork slowUow(slowCtx.get());
+    RecordId slowId = uassertStatusOK(rs->insertRecord(slowCtx.get(), "a", 2, Timestamp()));
+
+    RecordId fastId;
+    {
+        auto client2 = harnessHelper->serviceContext()->makeClient("c2");
+        auto opCtx = harnessHelper->newOperationContext(client2.get());
+        WriteUnitOfWork uow(opCtx.get());
+        fastId = uassertStatusOK(rs->insertRecord(opCtx.get(), "b", 2, Timestamp()));
+        uow.commit();
+    }
+
+    // Establish the reader's snapshot while the earlier insert is still uncommitted.
+    auto client3 = harnessHelper->serviceContext()->makeClient("c3");
+    auto readerCtx = harnessHelper->newOperationContext(client3.get());
+    auto record = rs->getCursor(readerCtx.get(), false)->next();
+    ASSERT(record);
+    ASSERT_EQ(record->id, fastId);
+
+    slowUow.commit();
+
+    // The earlier insert is not visible in the snapshot, so a forward cursor opened in it must
+    // not return the later one either.
+    ASSERT(!rs->getCursor(readerCtx.get(), true)->next());
+    readerCtx->recoveryUnit()->abandonSnapshot();
+
+    auto cursor = rs->getCursor(readerCtx.get(), true);
+    record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(record->id, slowId);
+    record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(record->id, fastId);
+    ASSERT(!cursor->next());
+}
+
 RecordId _oplogOrderInsertOplog(OperationContext* opCtx,
                                 const unique_ptr<RecordStore>& rs,
                                 int inc) {
@@ -374,6 +463,58 @@ TEST(WiredTigerRecordStoreTest, AppendCustomStatsMetadata) {
     ASSERT_EQUALS(creationStringElement.type(), String);
 }
 
+BSONObj getUpdateStats() {
+    BSONObjBuilder builder;
+    WiredTigerRecordStore::appendUpdateStats(&builder);
+    return builder.obj();
+}
+
+TEST(WiredTigerRecordStoreTest, UpdateStatsCountModifiesAndRewrites) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+    const std::string data(4096, 'a');
+    RecordId id;
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        id = uassertStatusOK(
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp()));
+        uow.commit();
+    }
+
+    auto before = getUpdateStats();
+    {
+        mutablebson::DamageVector damages(1);
+        damages[0].sourceOffset = 0;
+        damages[0].targetOffset = 10;
+        damages[0].size = 2;
+
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->updateWithDamages(
+                        opCtx.get(), id, RecordData(data.c_str(), data.size() + 1), "bb", damages)
+                      .getStatus());
+        uow.commit();
+    }
+    auto after = getUpdateStats();
+    ASSERT_EQ(1, after["modified"].numberLong() - before["modified"].numberLong());
+    ASSERT_EQ(4, after["modifiedBytes"].numberLong() - before["modifiedBytes"].numberLong());
+    ASSERT_EQ(after["rewritten"].numberLong(), before["rewritten"].numberLong());
+
+    // Tables are logged when replication isn't enabled, so the update rewrites the record.
+    before = after;
+    const std::string updated(4096, 'b');
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->updateRecord(opCtx.get(), id, updated.c_str(), updated.size() + 1));
+        uow.commit();
+    }
+    after = getUpdateStats();
+    ASSERT_EQ(1, after["rewritten"].numberLong() - before["rewritten"].numberLong());
+    ASSERT_EQ(4097, after["rewrittenBytes"].numberLong() - before["rewrittenBytes"].numberLong());
+    ASSERT_EQ(after["modified"].numberLong(), before["modified"].numberLong());
+}
+
 TEST(WiredTigerRecordStoreTest, CappedCursorYieldFirst) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("a.b", 10000, 50));
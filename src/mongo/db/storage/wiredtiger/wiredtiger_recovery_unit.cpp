@@ -313,6 +313,13 @@ boost::optional<int64_t> WiredTigerRecoveryUnit::getOplogVisibilityTs() {
     return _oplogVisibleTs;
 }
 
+AtomicWord<uint64_t> WiredTigerRecoveryUnit::cappedInsertCommitEpoch{0};
+
+uint64_t WiredTigerRecoveryUnit::getCappedVisibilityEpoch() {
+    getSession();
+    return _cappedVisibilityEpoch;
+}
+
 WiredTigerSession* WiredTigerRecoveryUnit::getSession() {
     if (!_isActive()) {
         _txnOpen();
@@ -321,6 +328,13 @@ WiredTigerSession* WiredTigerRecoveryUnit::getSession() {
     return _session.get();
 }
 
+WiredTigerSession* WiredTigerRecoveryUnit::getSession(uint64_t tableId) {
+    if (!_session) {
+        _session = _sessionCache->getSession(tableId);
+    }
+    return getSession();
+}
+
 WiredTigerSession* WiredTigerRecoveryUnit::getSessionNoTxn() {
     _ensureSession();
     WiredTigerSession* session = _session.get();
@@ -570,6 +584,10 @@ void WiredTigerRecoveryUnit::_txnOpen() {
     }
     WT_SESSION* session = _session->getSession();
 
+    // Read before the transaction begins, so that every capped insert which committed with an
+    // epoch up to this one is visible in the snapshot.
+    _cappedVisibilityEpoch = cappedInsertCommitEpoch.load();
+
     switch (_timestampReadSource) {
         case ReadSource::kNoTimestamp: {
             if (_isOplogReader) {
@@ -45,6 +45,7 @@
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
@@ -179,6 +180,12 @@ public:
     // ---- WT STUFF
 
     WiredTigerSession* getSession();
+
+    /**
+     * Like getSession(), but if this recovery unit has yet to acquire a session, prefers one which
+     * has recently used a cursor on the table 'tableId'.
+     */
+    WiredTigerSession* getSession(uint64_t tableId);
     void setIsOplogReader() {
         _isOplogReader = true;
     }
@@ -216,6 +223,19 @@ public:
 
     boost::optional<int64_t> getOplogVisibilityTs();
 
+    /**
+     * Returns the value of 'cappedInsertCommitEpoch' from just before the current snapshot was
+     * established, establishing one if needed. Capped inserts which committed with a later epoch
+     * may not be visible in the snapshot.
+     */
+    uint64_t getCappedVisibilityEpoch();
+
+    /**
+     * Incremented by every commit of an insert into a capped collection other than the oplog,
+     * after the insert is visible to new snapshots.
+     */
+    static AtomicWord<uint64_t> cappedInsertCommitEpoch;
+
     static WiredTigerRecoveryUnit* get(OperationContext* opCtx) {
         return checked_cast<WiredTigerRecoveryUnit*>(opCtx->recoveryUnit());
     }
@@ -302,6 +322,7 @@ private:
     std::unique_ptr<Timer> _timer;
     bool _isOplogReader = false;
     boost::optional<int64_t> _oplogVisibleTs = boost::none;
+    uint64_t _cappedVisibilityEpoch = 0;
 };
 
 }  // namespace mongo
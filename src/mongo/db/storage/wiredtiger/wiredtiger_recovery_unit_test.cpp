@@ -39,6 +39,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
@@ -671,6 +672,90 @@ TEST_F(WiredTigerRecoveryUnitTestFixture, ReadOnceCursorsAreNotCached) {
     ASSERT(ru->getReadOnce());
 }
 
+TEST_F(WiredTigerRecoveryUnitTestFixture, SessionCachePrefersSessionThatUsedTable) {
+    auto sessionCache = ru1->getSessionCache();
+    const std::string uri = "table:session_affinity";
+    const uint64_t tableId = WiredTigerSession::genTableId();
+    auto affinityHits = [&] {
+        BSONObjBuilder builder;
+        sessionCache->appendStats(&builder);
+        return builder.obj()["session affinity hits"].numberLong();
+    };
+    const long long affinityHitsBefore = affinityHits();
+
+    // Release a session which used a cursor on the table, then one which didn't, so that the
+    // latter is the most recently released.
+    WiredTigerSession* sessionWithCursor;
+    WiredTigerSession* sessionWithoutCursor;
+    {
+        auto session1 = sessionCache->getSession();
+        auto session2 = sessionCache->getSession();
+        WT_SESSION* s = session1->getSession();
+        invariantWTOK(s->create(s, uri.c_str(), "key_format=S,value_format=S"));
+        session1->releaseCursor(tableId, session1->getNewCursor(uri));
+        sessionWithCursor = session1.get();
+        sessionWithoutCursor = session2.get();
+        ASSERT(sessionWithCursor->hasRecentlyUsedTable(tableId));
+        ASSERT_FALSE(session2->hasRecentlyUsedTable(tableId));
+
+        session1.reset();
+        session2.reset();
+    }
+
+    // Without a preference, the most recently released session is handed out.
+    {
+        auto session = sessionCache->getSession();
+        ASSERT_EQ(sessionWithoutCursor, session.get());
+    }
+
+    {
+        auto session = sessionCache->getSession(tableId);
+        ASSERT_EQ(sessionWithCursor, session.get());
+        ASSERT_EQ(affinityHitsBefore + 1, affinityHits());
+    }
+}
+
+TEST_F(WiredTigerRecoveryUnitTestFixture, WaitUntilDurableGroupsConcurrentWaiters) {
+    auto sessionCache = ru1->getSessionCache();
+    auto histogramCount = [&](StringData name) {
+        BSONObjBuilder builder;
+        sessionCache->appendStats(&builder);
+        long long count = 0;
+        for (auto&& bucket : builder.obj()[name].Obj()) {
+            count += bucket.numberLong();
+        }
+        return count;
+    };
+    const long long flushesBefore = histogramCount("journal group commit sizes");
+    const long long waitsBefore = histogramCount("journal group commit wait micros");
+    const long long flushTimesBefore = histogramCount("journal group commit flush micros");
+
+    const int kThreads = 16;
+    const int kWaitsPerThread = 20;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            auto clientAndCtx = makeClientAndOpCtx(harnessHelper.get(), "waiter");
+            for (int j = 0; j < kWaitsPerThread; ++j) {
+                sessionCache->waitUntilDurable(clientAndCtx.second.get(),
+                                               WiredTigerSessionCache::Fsync::kJournal,
+                                               WiredTigerSessionCache::UseJournalListener::kSkip);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every waiter is accounted for, and each flush made at least one of them durable.
+    const long long flushes = histogramCount("journal group commit sizes") - flushesBefore;
+    ASSERT_EQ(kThreads * kWaitsPerThread,
+              histogramCount("journal group commit wait micros") - waitsBefore);
+    ASSERT_GTE(flushes, 1);
+    ASSERT_LTE(flushes, kThreads * kWaitsPerThread);
+    ASSERT_EQ(flushes, histogramCount("journal group commit flush micros") - flushTimesBefore);
+}
+
 TEST_F(WiredTigerRecoveryUnitTestFixture, CommitWithDurableTimestamp) {
     auto opCtx = clientAndCtx1.second.get();
     Timestamp ts1(3, 3);
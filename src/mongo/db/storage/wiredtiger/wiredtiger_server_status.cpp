@@ -94,6 +94,29 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
         BSONObjBuilder subsection(bob.subobjStart("oplog"));
         subsection.append("visibility timestamp",
                           Timestamp(_engine->getOplogManager()->getOplogReadTimestamp()));
+        BSONObjBuilder delaySubsection(subsection.subobjStart("visibility delay"));
+        _engine->getOplogManager()->appendVisibilityDelayStats(&delaySubsection);
+    }
+
+    {
+        BSONObjBuilder subsection(bob.subobjStart("committed snapshot reads"));
+        auto sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+        sessionCache->snapshotManager().appendCommittedSnapshotStats(&subsection);
+    }
+
+    {
+        BSONObjBuilder subsection(bob.subobjStart("session cache"));
+        WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->appendStats(&subsection);
+    }
+
+    {
+        BSONObjBuilder subsection(bob.subobjStart("size storer"));
+        _engine->appendSizeStorerStats(&subsection);
+    }
+
+    {
+        BSONObjBuilder subsection(bob.subobjStart("document updates"));
+        WiredTigerRecordStore::appendUpdateStats(&subsection);
     }
 
     return bob.obj();
@@ -33,7 +33,9 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "mongo/base/error_codes.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
@@ -46,6 +48,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -118,9 +121,13 @@ WT_CURSOR* WiredTigerSession::getCachedCursor(const std::string& uri, uint64_t i
             WT_CURSOR* c = i->_cursor;
             _cursors.erase(i);
             _cursorsOut++;
+            if (_cache)
+                _cache->_cursorCacheHits.fetchAndAddRelaxed(1);
             return c;
         }
     }
+    if (_cache)
+        _cache->_cursorCacheMisses.fetchAndAddRelaxed(1);
     return nullptr;
 }
 
@@ -128,9 +135,16 @@ WT_CURSOR* WiredTigerSession::getNewCursor(const std::string& uri, const char* c
     WT_CURSOR* cursor = nullptr;
     _openCursor(_session, uri, config, &cursor);
     _cursorsOut++;
+    if (_cache)
+        _cache->_cursorsOpened.fetchAndAddRelaxed(1);
     return cursor;
 }
 
+bool WiredTigerSession::hasRecentlyUsedTable(uint64_t id) const {
+    return std::find(_recentTableIds.begin(), _recentTableIds.begin() + _numRecentTableIds, id) !=
+        _recentTableIds.begin() + _numRecentTableIds;
+}
+
 void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
     invariant(_session);
     invariant(cursor);
@@ -141,6 +155,12 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
     // Cursors are pushed to the front of the list and removed from the back
     _cursors.push_front(WiredTigerCachedCursor(id, _cursorGen++, cursor));
 
+    if (!hasRecentlyUsedTable(id)) {
+        _recentTableIds[_recentTableIdsPos] = id;
+        _recentTableIdsPos = (_recentTableIdsPos + 1) % kNumRecentTableIds;
+        _numRecentTableIds = std::min(_numRecentTableIds + 1, kNumRecentTableIds);
+    }
+
     // A negative value for wiredTigercursorCacheSize means to use hybrid caching.
     std::uint32_t cacheSize = abs(gWiredTigerCursorCacheSize.load());
 
@@ -322,20 +342,66 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         token = journalListener->getToken(opCtx);
     }
 
-    uint32_t start = _lastSyncTime.load();
-    // Do the remainder in a critical section that ensures only a single thread at a time
-    // will attempt to synchronize.
+    // Any flush started from now on covers our writes. Join the group of the next flush to start
+    // and wait until it completes, leading it if no flush is running.
+    Timer waitTimer;
     stdx::unique_lock<Latch> lk(_lastSyncMutex);
-    uint32_t current = _lastSyncTime.loadRelaxed();  // synchronized with writes through mutex
-    if (current != start) {
-        // Someone else synced already since we read lastSyncTime, so we're done!
-        return;
+    const uint64_t generation = _startedFlushGeneration + 1;
+    ++_pendingFlushWaiters;
+    _groupCommitLeaderCond.notify_one();
+
+    bool isLeader = false;
+    while (_completedFlushGeneration < generation) {
+        if (_flushInProgress) {
+            _flushCompletedCond.wait(lk);
+            continue;
+        }
+
+        isLeader = true;
+        _flushInProgress = true;
+
+        // When the previous flush was shared, waiters are arriving concurrently and it pays for
+        // the leader to wait a fraction of a flush for the group to fill up before flushing.
+        const long long maxWindowMicros = gWiredTigerJournalGroupCommitMaxWindowMicros.load();
+        if (maxWindowMicros > 0 && _lastGroupCommitSize > 1) {
+            const auto window = Microseconds(std::min(
+                maxWindowMicros, static_cast<long long>(_averageFlushMicros / 2)));
+            const long long target = _lastGroupCommitSize;
+            _groupCommitLeaderCond.wait_for(
+                lk, window.toSystemDuration(), [&] { return _pendingFlushWaiters >= target; });
+        }
+
+        _startedFlushGeneration = generation;
+        const long long groupSize = std::exchange(_pendingFlushWaiters, 0);
+
+        lk.unlock();
+        Timer flushTimer;
+        _flushForWaitUntilDurable();
+        const long long flushMicros = flushTimer.micros();
+        lk.lock();
+
+        _completedFlushGeneration = generation;
+        _flushInProgress = false;
+        _lastGroupCommitSize = groupSize;
+        _averageFlushMicros = _averageFlushMicros == 0
+            ? flushMicros
+            : 0.9 * _averageFlushMicros + 0.1 * flushMicros;
+        _groupCommitSizes.record(groupSize);
+        _groupCommitFlushMicros.record(flushMicros);
+        _flushCompletedCond.notify_all();
     }
-    _lastSyncTime.store(current + 1);
+    lk.unlock();
+    _groupCommitWaitMicros.record(waitTimer.micros());
 
-    // Nobody has synched yet, so we have to sync ourselves.
+    // Only the thread which flushed reports its token to the listener. The newer tokens of the
+    // rest of the group are reported by a later flush, at the latest by the journal flusher's.
+    if (isLeader && token) {
+        journalListener->onDurable(token.get());
+    }
+}
 
-    // Initialize on first use.
+void WiredTigerSessionCache::_flushForWaitUntilDurable() {
+    // Initialize on first use. Only a single leader flushes at a time.
     if (!_waitUntilDurableSession) {
         invariantWTOK(
             _conn->open_session(_conn, nullptr, "isolation=snapshot", &_waitUntilDurableSession));
@@ -349,9 +415,24 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         invariantWTOK(_waitUntilDurableSession->checkpoint(_waitUntilDurableSession, nullptr));
         LOGV2_DEBUG(22420, 4, "created checkpoint");
     }
+}
 
-    if (token) {
-        journalListener->onDurable(token.get());
+void WiredTigerSessionCache::GroupCommitHistogram::record(uint64_t value) {
+    size_t bucket = 0;
+    while (bucket + 1 < kBuckets && (value >> (bucket + 1))) {
+        ++bucket;
+    }
+    _counts[bucket].fetchAndAddRelaxed(1);
+}
+
+void WiredTigerSessionCache::GroupCommitHistogram::append(BSONObjBuilder* builder,
+                                                          StringData fieldName) const {
+    // Buckets are keyed by their lower bound, and empty buckets are omitted.
+    BSONObjBuilder histogram(builder->subobjStart(fieldName));
+    for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+        if (auto count = _counts[bucket].loadRelaxed()) {
+            histogram.append(std::to_string(bucket == 0 ? 0 : 1ULL << bucket), count);
+        }
     }
 }
 
@@ -437,7 +518,8 @@ bool WiredTigerSessionCache::isEphemeral() {
     return _engine && _engine->isEphemeral();
 }
 
-UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
+UniqueWiredTigerSession WiredTigerSessionCache::getSession(
+    boost::optional<uint64_t> preferredTableId) {
     // We should never be able to get here after _shuttingDown is set, because no new
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
@@ -446,9 +528,26 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
         stdx::lock_guard<Latch> lock(_cacheLock);
         if (!_sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            // discarding older ones. When the caller prefers a table, only look a few sessions
+            // further back for one which used it, both to keep the search short and so that
+            // sessions at the back of the pool can still age out.
+            auto sessionIt = std::prev(_sessions.end());
+            if (preferredTableId) {
+                const auto searchDepth = std::min<size_t>(
+                    std::max(gWiredTigerSessionAffinitySearchDepth.load(), 0), _sessions.size());
+                auto found = std::find_if(
+                    _sessions.rbegin(), _sessions.rbegin() + searchDepth, [&](auto session) {
+                        return session->hasRecentlyUsedTable(*preferredTableId);
+                    });
+                if (found != _sessions.rbegin() + searchDepth) {
+                    sessionIt = std::prev(found.base());
+                    _sessionAffinityHits.fetchAndAddRelaxed(1);
+                } else {
+                    _sessionAffinityMisses.fetchAndAddRelaxed(1);
+                }
+            }
+            WiredTigerSession* cachedSession = *sessionIt;
+            _sessions.erase(sessionIt);
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
             return UniqueWiredTigerSession(cachedSession);
@@ -526,6 +625,17 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
 }
 
 
+void WiredTigerSessionCache::appendStats(BSONObjBuilder* builder) const {
+    builder->append("cursor cache hits", _cursorCacheHits.loadRelaxed());
+    builder->append("cursor cache misses", _cursorCacheMisses.loadRelaxed());
+    builder->append("cursors opened", _cursorsOpened.loadRelaxed());
+    builder->append("session affinity hits", _sessionAffinityHits.loadRelaxed());
+    builder->append("session affinity misses", _sessionAffinityMisses.loadRelaxed());
+    _groupCommitSizes.append(builder, "journal group commit sizes");
+    _groupCommitWaitMicros.append(builder, "journal group commit wait micros");
+    _groupCommitFlushMicros.append(builder, "journal group commit flush micros");
+}
+
 void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     stdx::unique_lock<Latch> lk(_journalListenerMutex);
 
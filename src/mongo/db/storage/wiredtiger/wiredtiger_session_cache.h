@@ -29,11 +29,14 @@
 
 #pragma once
 
+#include <array>
+#include <boost/optional.hpp>
 #include <list>
 #include <string>
 
 #include <wiredtiger.h>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
@@ -145,6 +148,13 @@ public:
         return _cursors.size();
     }
 
+    /**
+     * Returns true if one of the last few cursors released into this session was on the table id
+     * 'id'. Such a cursor is likely to still be cached, either in this session's cursor cache or,
+     * when WiredTiger does the caching, in WiredTiger's own cache for this session.
+     */
+    bool hasRecentlyUsedTable(uint64_t id) const;
+
     bool isDropQueuedIdentsAtSessionEndAllowed() const {
         return _dropQueuedIdentsAtSessionEnd;
     }
@@ -194,13 +204,21 @@ private:
 
     const uint64_t _epoch;
     uint64_t _cursorEpoch;
-    WiredTigerSessionCache* _cache;  // not owned
-    WT_SESSION* _session;            // owned
-    CursorCache _cursors;            // owned
+    WiredTigerSessionCache* _cache = nullptr;  // not owned
+    WT_SESSION* _session;                      // owned
+    CursorCache _cursors;                      // owned
     uint64_t _cursorGen;
     int _cursorsOut;
     bool _dropQueuedIdentsAtSessionEnd = true;
     Date_t _idleExpireTime;
+
+    // The table ids of the last few distinct tables whose cursors were released into this session,
+    // used by the session cache to hand out sessions which are likely to have a cached cursor for
+    // the table an operation needs. '_recentTableIdsPos' is the next slot to overwrite.
+    static constexpr size_t kNumRecentTableIds = 8;
+    std::array<uint64_t, kNumRecentTableIds> _recentTableIds;
+    size_t _numRecentTableIds = 0;
+    size_t _recentTableIdsPos = 0;
 };
 
 /**
@@ -251,8 +269,12 @@ public:
      * Returns a smart pointer to a previously released session for reuse, or creates a new session.
      * This method must only be called while holding the global lock to avoid races with
      * shuttingDown, but otherwise is thread safe.
+     *
+     * If 'preferredTableId' is set, prefers one of the most recently released sessions which has
+     * recently used a cursor on that table, so that the caller is likely to find it cached.
      */
-    std::unique_ptr<WiredTigerSession, WiredTigerSessionDeleter> getSession();
+    std::unique_ptr<WiredTigerSession, WiredTigerSessionDeleter> getSession(
+        boost::optional<uint64_t> preferredTableId = boost::none);
 
     /**
      * Get a count of idle sessions in the session cache.
@@ -364,7 +386,15 @@ public:
         return _prepareCommitOrAbortCounter.loadRelaxed();
     }
 
+    /**
+     * Appends counters for the cursor caches of this cache's sessions, for the sessions handed out
+     * because of a table preference, and histograms of the journal group commits.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
+    friend class WiredTigerSession;
+
     WiredTigerKVEngine* _engine;      // not owned, might be NULL
     WT_CONNECTION* _conn;             // not owned
     ClockSource* const _clockSource;  // not owned
@@ -386,9 +416,56 @@ private:
     // Bumped when all open cursors need to be closed
     AtomicWord<unsigned long long> _cursorEpoch;  // atomic so we can check it outside of the lock
 
-    // Counter and critical section mutex for waitUntilDurable
-    AtomicWord<unsigned> _lastSyncTime;
+    // Cursor cache statistics of the sessions owned by this cache.
+    AtomicWord<long long> _cursorCacheHits{0};
+    AtomicWord<long long> _cursorCacheMisses{0};
+    AtomicWord<long long> _cursorsOpened{0};
+
+    // Counts of getSession() calls with a preferred table which did or did not find a session that
+    // had recently used it.
+    AtomicWord<long long> _sessionAffinityHits{0};
+    AtomicWord<long long> _sessionAffinityMisses{0};
+
+    /**
+     * Histogram with power-of-two buckets: bucket i counts the values in [2^i, 2^(i+1)), and the
+     * last bucket also counts everything larger.
+     */
+    class GroupCommitHistogram {
+    public:
+        void record(uint64_t value);
+        void append(BSONObjBuilder* builder, StringData fieldName) const;
+
+    private:
+        static constexpr size_t kBuckets = 24;
+        std::array<AtomicWord<long long>, kBuckets> _counts{};
+    };
+
+    /**
+     * Flushes the journal, or takes a checkpoint when there is no journal, on behalf of every
+     * waiter in the current group commit. Called by the group's leader without '_lastSyncMutex'.
+     */
+    void _flushForWaitUntilDurable();
+
+    // Group commit state for waitUntilDurable, protected by '_lastSyncMutex'. Waiters which arrive
+    // while no flush has been started for their generation join it, and the first of them becomes
+    // the leader which performs the flush for the whole group. A generation is durable once
+    // '_completedFlushGeneration' reaches it.
     Mutex _lastSyncMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_lastSyncMutex");
+    stdx::condition_variable _flushCompletedCond;
+    stdx::condition_variable _groupCommitLeaderCond;
+    uint64_t _startedFlushGeneration = 0;
+    uint64_t _completedFlushGeneration = 0;
+    bool _flushInProgress = false;
+    // The number of waiters which have joined the generation that hasn't been started yet.
+    long long _pendingFlushWaiters = 0;
+    // The size of the last group, and a moving average of the flush latency in microseconds, used
+    // to size the window in which the leader waits for more waiters to join.
+    long long _lastGroupCommitSize = 0;
+    double _averageFlushMicros = 0;
+
+    GroupCommitHistogram _groupCommitSizes;
+    GroupCommitHistogram _groupCommitWaitMicros;
+    GroupCommitHistogram _groupCommitFlushMicros;
 
     // Mutex and cond var for waiting on prepare commit or abort.
     Mutex _prepareCommittedOrAbortedMutex =
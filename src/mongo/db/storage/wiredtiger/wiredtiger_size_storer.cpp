@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <vector>
 #include <wiredtiger.h>
 
 #include "mongo/bson/bsonobj.h"
@@ -130,33 +132,84 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
                                       data["dataSize"].safeNumberLong());
 }
 
+void WiredTigerSizeStorer::storeDocument(StringData key, BSONObj doc) {
+    if (_readOnly)
+        return;
+
+    stdx::lock_guard<Latch> lk(_bufferMutex);
+    _documentBuffer[key] = doc.getOwned();
+}
+
+boost::optional<BSONObj> WiredTigerSizeStorer::loadDocument(StringData key) const {
+    {
+        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
+        auto it = _documentBuffer.find(key);
+        if (it != _documentBuffer.end())
+            return it->second;
+    }
+
+    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
+
+    WT_ITEM keyItem = {key.rawData(), key.size()};
+    _cursor->set_key(_cursor, &keyItem);
+    int ret = _cursor->search(_cursor);
+    if (ret == WT_NOTFOUND)
+        return boost::none;
+    invariantWTOK(ret);
+
+    WT_ITEM value;
+    invariantWTOK(_cursor->get_value(_cursor, &value));
+    return BSONObj(reinterpret_cast<const char*>(value.data)).getOwned();
+}
+
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
-    Buffer buffer;
+    std::vector<std::pair<std::string, std::shared_ptr<SizeInfo>>> entries;
+    std::vector<std::pair<std::string, BSONObj>> documents;
     {
         stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        _buffer.swap(buffer);
+        entries.reserve(_buffer.size());
+        for (auto& it : _buffer)
+            entries.emplace_back(it.first, std::move(it.second));
+        _buffer.clear();
+        for (auto& it : _documentBuffer)
+            documents.emplace_back(it.first, std::move(it.second));
+        _documentBuffer.clear();
     }
 
-    if (buffer.empty())
+    if (entries.empty() && documents.empty())
         return;  // Nothing to do.
 
     Timer t;
-    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
-    {
-        // On failure, place entries back into the map, unless a newer value already exists.
-        ON_BLOCK_EXIT([this, &buffer]() {
-            this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
+    auto batchBegin = entries.begin();
+    // On failure, place the entries which weren't written back into the map, unless a newer value
+    // already exists.
+    bool documentsWritten = documents.empty();
+    ON_BLOCK_EXIT([this, &entries, &batchBegin, &documents, &documentsWritten]() {
+        if (batchBegin != entries.end() || !documentsWritten) {
+            stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
+            for (auto it = batchBegin; it != entries.end(); ++it)
+                this->_buffer.try_emplace(it->first, it->second);
+            if (!documentsWritten) {
+                for (auto& document : documents)
+                    this->_documentBuffer.try_emplace(document.first, document.second);
             }
-        });
+        }
+    });
 
+    while (batchBegin != entries.end()) {
+        auto batchEnd = batchBegin + std::min<size_t>(kFlushBatchSize, entries.end() - batchBegin);
+
+        stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+        ON_BLOCK_EXIT([this]() { this->_cursor->reset(this->_cursor); });
+
+        // Syncing the commit of the last batch to disk also makes all of the earlier ones durable.
         WT_SESSION* session = _session.getSession();
-        WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
+        WiredTigerBeginTxnBlock txnOpen(
+            session,
+            syncToDisk && batchEnd == entries.end() && documents.empty() ? "sync=true" : nullptr);
 
-        for (auto it = buffer.begin(); it != buffer.end(); ++it) {
+        for (auto it = batchBegin; it != batchEnd; ++it) {
 
             // Ordering is important here: when the store method checks if the SizeInfo
             // is dirty and it returns true, the current values of numRecords and dataSize must
@@ -180,10 +233,49 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
         }
         txnOpen.done();
         invariantWTOK(session->commit_transaction(session, nullptr));
-        buffer.clear();
+        batchBegin = batchEnd;
+    }
+
+    // The documents are few, so they are written in a single transaction after the sizes.
+    if (!documents.empty()) {
+        stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+        ON_BLOCK_EXIT([this]() { this->_cursor->reset(this->_cursor); });
+
+        WT_SESSION* session = _session.getSession();
+        WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
+        for (auto& document : documents) {
+            WiredTigerItem key(document.first.c_str(), document.first.size());
+            WiredTigerItem value(document.second.objdata(), document.second.objsize());
+            _cursor->set_key(_cursor, key.Get());
+            _cursor->set_value(_cursor, value.Get());
+            invariantWTOK(_cursor->insert(_cursor));
+        }
+        txnOpen.done();
+        invariantWTOK(session->commit_transaction(session, nullptr));
+        documentsWritten = true;
     }
 
     auto micros = t.micros();
+    _numFlushes.fetchAndAdd(1);
+    _numEntriesFlushed.fetchAndAdd(entries.size() + documents.size());
+    _totalFlushMicros.fetchAndAdd(micros);
+    _lastFlushMicros.store(micros);
+    for (auto maxMicros = _maxFlushMicros.load();
+         micros > maxMicros && !_maxFlushMicros.compareAndSwap(&maxMicros, micros);) {
+    }
     LOGV2_DEBUG(22426, 2, "WiredTigerSizeStorer flush took {micros} µs", "micros"_attr = micros);
 }
+
+void WiredTigerSizeStorer::appendStats(BSONObjBuilder* builder) const {
+    {
+        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
+        builder->appendNumber("pending entries",
+                              static_cast<long long>(_buffer.size() + _documentBuffer.size()));
+    }
+    builder->append("flushes", _numFlushes.load());
+    builder->append("entries flushed", _numEntriesFlushed.load());
+    builder->append("total flush time micros", _totalFlushMicros.load());
+    builder->append("last flush time micros", _lastFlushMicros.load());
+    builder->append("max flush time micros", _maxFlushMicros.load());
+}
 }  // namespace mongo
@@ -34,6 +34,7 @@
 #include <wiredtiger.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
@@ -90,10 +91,30 @@ public:
     std::shared_ptr<SizeInfo> load(StringData uri) const;
 
     /**
-     * Writes all changes to the underlying table.
+     * Ensure that 'doc' will be stored under 'key' by the next call to flush, replacing any
+     * document pending for the same key. For metadata which, like the sizes, only needs to be
+     * approximately up to date after a crash. The key must not be the URI of a table.
+     */
+    void storeDocument(StringData key, BSONObj doc);
+
+    /**
+     * Returns the document most recently stored under 'key', or boost::none if there is none.
+     */
+    boost::optional<BSONObj> loadDocument(StringData key) const;
+
+    /**
+     * Writes all changes to the underlying table, 'kFlushBatchSize' entries per transaction so
+     * that loads of entries which aren't buffered never wait on a whole flush.
      */
     void flush(bool syncToDisk);
 
+    /**
+     * Appends the number of pending entries and statistics about the flushes performed so far.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+    static constexpr size_t kFlushBatchSize = 1000;
+
 private:
     const WiredTigerSession _session;
     const bool _readOnly;
@@ -106,5 +127,12 @@ private:
     mutable Mutex _bufferMutex =
         MONGO_MAKE_LATCH("WiredTigerSessionStorer::_bufferMutex");  // Guards _buffer
     Buffer _buffer;
+    StringMap<BSONObj> _documentBuffer;  // Guarded by _bufferMutex
+
+    AtomicWord<long long> _numFlushes{0};
+    AtomicWord<long long> _numEntriesFlushed{0};
+    AtomicWord<long long> _totalFlushMicros{0};
+    AtomicWord<long long> _lastFlushMicros{0};
+    AtomicWord<long long> _maxFlushMicros{0};
 };
 }  // namespace mongo
@@ -33,6 +33,9 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 
+#include <fmt/format.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
@@ -40,11 +43,15 @@
 #include "mongo/logv2/log.h"
 
 namespace mongo {
+using namespace fmt::literals;
 
 void WiredTigerSnapshotManager::setCommittedSnapshot(const Timestamp& timestamp) {
     stdx::lock_guard<Latch> lock(_committedSnapshotMutex);
 
     invariant(!_committedSnapshot || *_committedSnapshot <= timestamp);
+    if (_committedSnapshot != timestamp) {
+        _clearCommittedSnapshotConfigs(lock);
+    }
     _committedSnapshot = timestamp;
 }
 
@@ -64,6 +71,13 @@ boost::optional<Timestamp> WiredTigerSnapshotManager::getLastApplied() {
 void WiredTigerSnapshotManager::clearCommittedSnapshot() {
     stdx::lock_guard<Latch> lock(_committedSnapshotMutex);
     _committedSnapshot = boost::none;
+    _clearCommittedSnapshotConfigs(lock);
+}
+
+void WiredTigerSnapshotManager::_clearCommittedSnapshotConfigs(WithLock) {
+    for (auto& config : _committedSnapshotConfigs) {
+        config.clear();
+    }
 }
 
 boost::optional<Timestamp> WiredTigerSnapshotManager::getMinSnapshotForNextCommittedRead() const {
@@ -79,18 +93,30 @@ Timestamp WiredTigerSnapshotManager::beginTransactionOnCommittedSnapshot(
     WT_SESSION* session,
     PrepareConflictBehavior prepareConflictBehavior,
     RoundUpPreparedTimestamps roundUpPreparedTimestamps) const {
-    WiredTigerBeginTxnBlock txnOpen(session, prepareConflictBehavior, roundUpPreparedTimestamps);
-
     stdx::lock_guard<Latch> lock(_committedSnapshotMutex);
     uassert(ErrorCodes::ReadConcernMajorityNotAvailableYet,
             "Committed view disappeared while running operation",
             _committedSnapshot);
 
-    auto status = txnOpen.setReadSnapshot(_committedSnapshot.get());
-    fassert(30635, status);
+    // Begin the transaction with its read timestamp in one call, using the configuration built by
+    // an earlier read at the same snapshot if there was one.
+    auto& config = _committedSnapshotConfigs[static_cast<size_t>(prepareConflictBehavior) * 2 +
+                                             static_cast<size_t>(roundUpPreparedTimestamps)];
+    if (config.empty()) {
+        config = WiredTigerBeginTxnBlock::getConfigString(prepareConflictBehavior,
+                                                          roundUpPreparedTimestamps) +
+            "read_timestamp={:x}"_format(_committedSnapshot->asULL());
+        _committedSnapshotConfigsBuilt.fetchAndAddRelaxed(1);
+    }
+    _committedSnapshotTransactions.fetchAndAddRelaxed(1);
 
-    txnOpen.done();
+    fassert(30635, wtRCToStatus(session->begin_transaction(session, config.c_str())));
     return *_committedSnapshot;
 }
 
+void WiredTigerSnapshotManager::appendCommittedSnapshotStats(BSONObjBuilder* builder) const {
+    builder->append("transactions begun", _committedSnapshotTransactions.loadRelaxed());
+    builder->append("configurations built", _committedSnapshotConfigsBuilt.loadRelaxed());
+}
+
 }  // namespace mongo
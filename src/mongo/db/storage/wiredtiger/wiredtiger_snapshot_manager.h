@@ -29,16 +29,22 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
+#include <string>
 #include <wiredtiger.h>
 
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/storage/snapshot_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
+
 using RoundUpPreparedTimestamps = WiredTigerBeginTxnBlock::RoundUpPreparedTimestamps;
 
 class WiredTigerOplogManager;
@@ -79,12 +85,29 @@ public:
      */
     boost::optional<Timestamp> getMinSnapshotForNextCommittedRead() const;
 
+    /**
+     * Appends how many transactions began on the committed snapshot, and how many of them had to
+     * build their configuration rather than reuse that of an earlier one at the same snapshot.
+     */
+    void appendCommittedSnapshotStats(BSONObjBuilder* builder) const;
+
 private:
+    void _clearCommittedSnapshotConfigs(WithLock);
+
     // Snapshot to use for reads at a commit timestamp.
     mutable Mutex _committedSnapshotMutex =  // Guards _committedSnapshot.
         MONGO_MAKE_LATCH("WiredTigerSnapshotManager::_committedSnapshotMutex");
     boost::optional<Timestamp> _committedSnapshot;
 
+    // The begin_transaction() configurations for reads at '_committedSnapshot', indexed by the
+    // prepare conflict options of the reads. Each is built by the first read with its options after
+    // the committed snapshot moves, and reused by the later ones. Guarded by
+    // _committedSnapshotMutex.
+    mutable std::array<std::string, 6> _committedSnapshotConfigs;
+
+    mutable AtomicWord<long long> _committedSnapshotTransactions;
+    mutable AtomicWord<long long> _committedSnapshotConfigsBuilt;
+
     // Timestamp to use for reads at a the lastApplied timestamp.
     mutable Mutex _lastAppliedMutex =  // Guards _lastApplied.
         MONGO_MAKE_LATCH("WiredTigerSnapshotManager::_lastAppliedMutex");
@@ -346,5 +346,61 @@ TEST_F(SizeStorerUpdateTest, Basic) {
     ASSERT_EQUALS(getDataSize(), val);
 }
 
+// Flushing more entries than fit in a single batch writes all of them back, and is reported in the
+// size storer's statistics.
+TEST_F(SizeStorerUpdateTest, FlushInBatches) {
+    const size_t numEntries = 2 * WiredTigerSizeStorer::kFlushBatchSize + 1;
+    for (size_t i = 0; i < numEntries; ++i) {
+        sizeStorer->store(uri + std::to_string(i),
+                          std::make_shared<WiredTigerSizeStorer::SizeInfo>(i, 2 * i));
+    }
+    ASSERT_EQUALS(static_cast<long long>(numEntries), [&] {
+        BSONObjBuilder builder;
+        sizeStorer->appendStats(&builder);
+        return builder.obj()["pending entries"].numberLong();
+    }());
+
+    sizeStorer->flush(true);
+
+    BSONObjBuilder builder;
+    sizeStorer->appendStats(&builder);
+    BSONObj stats = builder.obj();
+    ASSERT_EQUALS(0, stats["pending entries"].numberLong());
+    ASSERT_EQUALS(1, stats["flushes"].numberLong());
+    ASSERT_EQUALS(static_cast<long long>(numEntries), stats["entries flushed"].numberLong());
+
+    // The values are read back from the table rather than from the buffer.
+    const bool enableWtLogging = false;
+    WiredTigerSizeStorer reloaded(harnessHelper->conn(),
+                                  WiredTigerKVEngine::kTableUriPrefix + "sizeStorer",
+                                  enableWtLogging);
+    for (size_t i = 0; i < numEntries; ++i) {
+        auto info = reloaded.load(uri + std::to_string(i));
+        ASSERT_EQUALS(static_cast<long long>(i), info->numRecords.load());
+        ASSERT_EQUALS(static_cast<long long>(2 * i), info->dataSize.load());
+    }
+}
+
+// Documents stored alongside the sizes are readable before and after they are flushed.
+TEST_F(SizeStorerUpdateTest, StoreDocument) {
+    const std::string key = "oplogStones:" + uri;
+    ASSERT_FALSE(sizeStorer->loadDocument(key));
+
+    sizeStorer->storeDocument(key, BSON("stones" << BSON_ARRAY(BSON("records" << 1))));
+    auto buffered = sizeStorer->loadDocument(key);
+    ASSERT(buffered);
+    ASSERT_BSONOBJ_EQ(BSON("stones" << BSON_ARRAY(BSON("records" << 1))), *buffered);
+
+    sizeStorer->flush(true);
+
+    const bool enableWtLogging = false;
+    WiredTigerSizeStorer reloaded(harnessHelper->conn(),
+                                  WiredTigerKVEngine::kTableUriPrefix + "sizeStorer",
+                                  enableWtLogging);
+    auto persisted = reloaded.loadDocument(key);
+    ASSERT(persisted);
+    ASSERT_BSONOBJ_EQ(*buffered, *persisted);
+}
+
 }  // namespace
 }  // namespace mongo
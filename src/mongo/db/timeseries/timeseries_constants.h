@@ -0,0 +1,71 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/string_data.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * Field names and limits describing the layout of the buckets stored in a time-series collection's
+ * 'system.buckets' namespace. A bucket looks like:
+ *
+ *   {_id: <ObjectId>,
+ *    meta: <metaField value, absent when there is no metaField>,
+ *    control: {version: 1, count: <n>, size: <bytes>, min: {...}, max: {...}},
+ *    data: {<field>: {"0": <value>, "1": <value>, ...}, ...}}
+ *
+ * Each measurement is spread across the 'data' columns under its position in the bucket. The
+ * 'control.min' and 'control.max' documents hold the per-field extremes of the measurements.
+ */
+constexpr StringData kBucketIdFieldName = "_id"_sd;
+constexpr StringData kBucketMetaFieldName = "meta"_sd;
+constexpr StringData kBucketControlFieldName = "control"_sd;
+constexpr StringData kBucketDataFieldName = "data"_sd;
+
+constexpr StringData kControlVersionFieldName = "version"_sd;
+constexpr StringData kControlCountFieldName = "count"_sd;
+constexpr StringData kControlSizeFieldName = "size"_sd;
+constexpr StringData kControlMinFieldName = "min"_sd;
+constexpr StringData kControlMaxFieldName = "max"_sd;
+
+constexpr int kBucketControlVersion = 1;
+
+// A bucket is closed to further measurements once it reaches any of these limits. The time range
+// limit also bounds how far 'control.min' of the time field may lag 'control.max', which lets
+// queries on the time field be answered with a range on either bound.
+constexpr int kBucketMaxCount = 1000;
+constexpr int kBucketMaxSizeBytes = 125 * 1024;
+constexpr Hours kBucketMaxTimeRange{1};
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include <fcntl.h>
 #include <iostream>
+#include <map>
 #include <string>
 #include <sys/types.h>
 #include <vector>
@@ -250,4 +251,41 @@ void trafficRecordingFileToMongoReplayFile(int inputFd, std::ostream& outputStre
     }
 }
 
+std::vector<TrafficRecordingRequest> trafficRecordingFileToRequests(int inputFd) {
+    std::vector<TrafficRecordingRequest> requests;
+
+    // Maps the session and request id of each recorded request to its position in 'requests', so
+    // that the cursor ids returned in responses can be attributed to the requests which made them.
+    std::map<std::pair<uint64_t, int32_t>, size_t> requestPositions;
+
+    auto buf = SharedBuffer::allocate(MaxMessageSizeBytes);
+    while (auto packet = readPacket(buf.get(), inputFd)) {
+        auto responseTo = packet->message.getResponseToMsgId();
+        if (!responseTo) {
+            auto len = packet->message.getLen();
+            auto messageBuf = SharedBuffer::allocate(len);
+            std::memcpy(messageBuf.get(), packet->message.view2ptr(), len);
+
+            requestPositions[{packet->id, packet->message.getId()}] = requests.size();
+            requests.push_back({packet->id, packet->date, Message(std::move(messageBuf))});
+            continue;
+        }
+
+        auto it = requestPositions.find({packet->id, responseTo});
+        if (it == requestPositions.end() || packet->message.getNetworkOp() != dbMsg) {
+            continue;
+        }
+
+        Message response;
+        response.setData(dbMsg, packet->message.data(), packet->message.dataLen());
+        OpMsg::removeChecksum(&response);
+        auto cursor = OpMsg::parse(response).body["cursor"];
+        if (cursor.type() == Object && cursor["id"].isNumber()) {
+            requests[it->second].recordedCursorId = cursor["id"].numberLong();
+        }
+    }
+
+    return requests;
+}
+
 }  // namespace mongo
@@ -27,7 +27,10 @@
  *    it in the license file.
  */
 
+#include "mongo/db/cursor_id.h"
+#include "mongo/rpc/message.h"
 #include "mongo/rpc/op_msg.h"
+#include "mongo/util/time_support.h"
 
 #pragma once
 
@@ -38,4 +41,17 @@ BSONArray trafficRecordingFileToBSONArr(const std::string& inputFile);
 
 // This is the function that traffic_reader_main.cpp calls
 void trafficRecordingFileToMongoReplayFile(int inFile, std::ostream& outFile);
+
+// A request sent by a recorded session, along with the id of the cursor, if any, which the recorded
+// server returned in its response.
+struct TrafficRecordingRequest {
+    uint64_t sessionId;
+    Date_t date;
+    Message message;
+    CursorId recordedCursorId = 0;
+};
+
+// This is the function that traffic_replay_main.cpp calls, returns the requests of a recording in
+// the order they were recorded
+std::vector<TrafficRecordingRequest> trafficRecordingFileToRequests(int inFile);
 }  // namespace mongo
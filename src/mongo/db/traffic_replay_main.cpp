@@ -0,0 +1,340 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#endif
+
+#include "mongo/base/initializer.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/client/dbclient_connection.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/traffic_reader.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/net/hostandport.h"
+#include "mongo/util/signal_handlers.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+using namespace mongo;
+
+namespace {
+
+/**
+ * The state shared by the threads replaying each of the recorded sessions.
+ */
+class TrafficReplayer {
+public:
+    TrafficReplayer(HostAndPort host, double speedup) : _host(std::move(host)), _speedup(speedup) {}
+
+    /**
+     * Replays the requests of a single session, in order, on a connection of its own. Each request
+     * is sent at the same offset from the start of the replay as it was from the start of the
+     * recording, divided by the speedup.
+     */
+    void replaySession(const std::vector<const TrafficRecordingRequest*>& requests,
+                       Date_t recordingStart,
+                       Date_t replayStart) {
+        DBClientConnection conn;
+        auto status = conn.connect(_host, "mongotrafficreplay");
+        if (!status.isOK()) {
+            std::cerr << "Failed to connect to " << _host << ": " << status << std::endl;
+            return;
+        }
+
+        for (auto request : requests) {
+            if (_speedup > 0) {
+                auto offset = Milliseconds(static_cast<long long>(
+                    durationCount<Milliseconds>(request->date - recordingStart) / _speedup));
+                auto now = Date_t::now();
+                if (replayStart + offset > now) {
+                    sleepFor(replayStart + offset - now);
+                }
+            }
+
+            _replayRequest(conn, *request);
+        }
+    }
+
+    /**
+     * Returns the number of requests replayed, the number of them which failed and the latency
+     * distribution of each command.
+     */
+    BSONObj report() const {
+        stdx::lock_guard<Latch> lk(_mutex);
+
+        BSONObjBuilder bob;
+        long long total = 0;
+        long long errors = 0;
+        BSONObjBuilder commandsBuilder(bob.subobjStart("commands"));
+        for (auto&& [commandName, stats] : _stats) {
+            auto latencies = stats.latencyMicros;
+            std::sort(latencies.begin(), latencies.end());
+            auto percentile = [&](double p) {
+                return latencies.empty()
+                    ? 0
+                    : latencies[std::min(latencies.size() - 1,
+                                         static_cast<size_t>(p * latencies.size()))];
+            };
+
+            BSONObjBuilder commandBuilder(commandsBuilder.subobjStart(commandName));
+            commandBuilder.append("count", static_cast<long long>(latencies.size()));
+            commandBuilder.append("errors", stats.errors);
+            commandBuilder.append("p50Micros", percentile(0.5));
+            commandBuilder.append("p90Micros", percentile(0.9));
+            commandBuilder.append("p99Micros", percentile(0.99));
+            commandBuilder.append("maxMicros", latencies.empty() ? 0 : latencies.back());
+            commandBuilder.doneFast();
+
+            total += latencies.size();
+            errors += stats.errors;
+        }
+        commandsBuilder.doneFast();
+        bob.append("replayed", total);
+        bob.append("errors", errors);
+        bob.append("skipped", _skipped);
+        return bob.obj();
+    }
+
+private:
+    struct CommandStats {
+        std::vector<long long> latencyMicros;
+        long long errors = 0;
+    };
+
+    void _replayRequest(DBClientConnection& conn, const TrafficRecordingRequest& request) {
+        // Only OP_MSG requests are replayed, the legacy opcodes carry no command to attribute the
+        // latency to and compressed messages were recorded before decompression.
+        if (request.message.operation() != dbMsg) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            ++_skipped;
+            return;
+        }
+
+        Message recorded = request.message;
+        OpMsg::removeChecksum(&recorded);
+        const bool moreToCome = OpMsg::isFlagSet(recorded, OpMsg::kMoreToCome);
+
+        // Serializing the request anew drops the exhaust flag, so exhaust cursors are replayed as
+        // getMores, and lets the cursor ids of the recording be replaced with the replayed ones.
+        auto opMsg = OpMsgRequest::parse(recorded);
+        opMsg.body = _remapCursorIds(opMsg.body);
+        auto toSend = opMsg.serialize();
+        if (moreToCome) {
+            OpMsg::setFlag(&toSend, OpMsg::kMoreToCome);
+        }
+
+        Timer timer;
+        bool ok = true;
+        BSONObj reply;
+        try {
+            if (moreToCome) {
+                conn.say(toSend);
+            } else {
+                Message response;
+                conn.call(toSend, response, true, nullptr);
+                reply = OpMsg::parse(response).body.getOwned();
+                ok = reply["ok"].trueValue();
+            }
+        } catch (const DBException& ex) {
+            std::cerr << "Failed to replay " << opMsg.getCommandName() << ": " << ex.toStatus()
+                      << std::endl;
+            ok = false;
+        }
+        auto micros = timer.micros();
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto& stats = _stats[opMsg.getCommandName().toString()];
+        stats.latencyMicros.push_back(micros);
+        if (!ok) {
+            ++stats.errors;
+        }
+
+        auto cursor = reply["cursor"];
+        if (request.recordedCursorId && cursor.type() == Object && cursor["id"].isNumber()) {
+            _cursorIds[request.recordedCursorId] = cursor["id"].numberLong();
+        }
+    }
+
+    /**
+     * Replaces the recorded cursor ids in a getMore or killCursors command with those of the
+     * cursors the replay opened in their place.
+     */
+    BSONObj _remapCursorIds(const BSONObj& body) {
+        auto commandName = body.firstElementFieldNameStringData();
+        if (commandName != "getMore" && commandName != "killCursors") {
+            return body;
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto remap = [&](const BSONElement& elem) {
+            auto it = _cursorIds.find(elem.numberLong());
+            return it == _cursorIds.end() ? elem.numberLong() : it->second;
+        };
+
+        BSONObjBuilder bob;
+        for (auto&& elem : body) {
+            if (commandName == "getMore" && elem.fieldNameStringData() == "getMore") {
+                bob.append("getMore", remap(elem));
+            } else if (commandName == "killCursors" && elem.fieldNameStringData() == "cursors") {
+                BSONArrayBuilder cursors(bob.subarrayStart("cursors"));
+                for (auto&& cursorId : elem.Obj()) {
+                    cursors.append(remap(cursorId));
+                }
+            } else {
+                bob.append(elem);
+            }
+        }
+        return bob.obj();
+    }
+
+    const HostAndPort _host;
+    const double _speedup;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("TrafficReplayer::_mutex");
+    std::map<std::string, CommandStats> _stats;
+    std::map<CursorId, CursorId> _cursorIds;
+    long long _skipped = 0;
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+
+    setupSignalHandlers();
+
+    Status status = mongo::runGlobalInitializers(std::vector<std::string>(argv, argv + argc));
+    if (!status.isOK()) {
+        std::cerr << "Failed global initialization: " << status << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    setGlobalServiceContext(ServiceContext::make());
+
+    startSignalProcessingThread();
+
+    // Handle program options
+    boost::program_options::variables_map vm;
+
+    // input file for the replay (defaults to stdin)
+    int inputFd = 0;
+
+    try {
+        // Define the program options
+        auto inputStr = "Path to file input file (defaults to stdin)";
+        auto hostStr = "Address of the server to replay the recorded traffic against";
+        auto speedupStr =
+            "Factor by which to shorten the delays between recorded requests, 0 to replay them "
+            "without delay";
+        boost::program_options::options_description desc{"Options"};
+        desc.add_options()("help,h", "help")(
+            "input,i", boost::program_options::value<std::string>(), inputStr)(
+            "host",
+            boost::program_options::value<std::string>()->default_value("localhost:27017"),
+            hostStr)("speedup",
+                     boost::program_options::value<double>()->default_value(1),
+                     speedupStr);
+
+        // Parse the program options
+        store(parse_command_line(argc, argv, desc), vm);
+        notify(vm);
+
+        // Handle the help option
+        if (vm.count("help")) {
+            std::cout << "Mongo Traffic Replay Help: \n\n\t./mongotrafficreplay "
+                         "-i trafficinput.txt --host localhost:27017 --speedup 2 \n\n"
+                      << desc << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        // User can specify a --input param and it must point to a valid file
+        if (vm.count("input")) {
+            auto inputFile = vm["input"].as<std::string>();
+            if (!boost::filesystem::exists(inputFile.c_str())) {
+                std::cout << "Error: Specified file does not exist (" << inputFile.c_str() << ")"
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+
+// Open the connection to the input file
+#ifdef _WIN32
+            inputFd = open(inputFile.c_str(), O_RDONLY | O_BINARY);
+#else
+            inputFd = open(inputFile.c_str(), O_RDONLY);
+#endif
+        }
+    } catch (const boost::program_options::error& ex) {
+        std::cerr << ex.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    auto speedup = vm["speedup"].as<double>();
+    auto swHost = HostAndPort::parse(vm["host"].as<std::string>());
+    if (!swHost.isOK() || speedup < 0) {
+        std::cerr << "Error: Invalid --host or --speedup" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto requests = mongo::trafficRecordingFileToRequests(inputFd);
+    std::map<uint64_t, std::vector<const TrafficRecordingRequest*>> sessions;
+    for (auto&& request : requests) {
+        sessions[request.sessionId].push_back(&request);
+    }
+
+    TrafficReplayer replayer(swHost.getValue(), speedup);
+    const auto recordingStart = requests.empty() ? Date_t() : requests.front().date;
+    const auto replayStart = Date_t::now();
+
+    std::vector<stdx::thread> threads;
+    for (auto&& [sessionId, sessionRequests] : sessions) {
+        threads.emplace_back([&, &sessionRequests = sessionRequests] {
+            replayer.replaySession(sessionRequests, recordingStart, replayStart);
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    std::cout << replayer.report().jsonString() << std::endl;
+
+    return 0;
+}
@@ -254,13 +254,12 @@ void updateSessionEntry(OperationContext* opCtx, const UpdateRequest& updateRequ
     auto originalRecordData = collection->getRecordStore()->dataFor(opCtx, recordId);
     auto originalDoc = originalRecordData.toBson();
 
+    // The query only consists of the _id, so comparing it directly is enough to check that the
+    // document still matches, without building an ExpressionContext and parsing a matcher for
+    // every retryable write.
     invariant(collection->getDefaultCollator() == nullptr);
-    boost::intrusive_ptr<ExpressionContext> expCtx(
-        new ExpressionContext(opCtx, nullptr, updateRequest.getNamespaceString()));
-
-    auto matcher =
-        fassert(40673, MatchExpressionParser::parse(updateRequest.getQuery(), std::move(expCtx)));
-    if (!matcher->matchesBSON(originalDoc)) {
+    dassert(updateRequest.getQuery().nFields() == 1);
+    if (originalDoc["_id"].woCompare(idToFetch, false) != 0) {
         // Document no longer match what we expect so throw WCE to make the caller re-examine.
         throw WriteConflictException();
     }
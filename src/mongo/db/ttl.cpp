@@ -36,15 +36,16 @@
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/fsync_locked.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
-#include "mongo/db/exec/delete.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/insert.h"
@@ -58,6 +59,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
 
 namespace mongo {
 
@@ -78,6 +80,71 @@ ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
 
+/**
+ * Reports the outcome of the last pass over each TTL index. The lag of an index is how long after
+ * its expiration the oldest expired document removed by the pass was removed, which identifies the
+ * indexes whose documents are not removed as fast as they expire.
+ */
+class TTLIndexesSSS : public ServerStatusSection {
+public:
+    struct IndexStats {
+        Date_t lastPass;
+        long long deletedDocuments = 0;
+        Milliseconds duration{0};
+        Milliseconds lag{0};
+    };
+
+    TTLIndexesSSS() : ServerStatusSection("ttlIndexes") {}
+
+    bool includeByDefault() const override {
+        // A node can have hundreds of TTL indexes, too many for every serverStatus to report.
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder bob;
+        BSONArrayBuilder indexes(bob.subarrayStart("indexes"));
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (const auto& [key, stats] : _stats) {
+            BSONObjBuilder index(indexes.subobjStart());
+            index.append("ns", key.first.ns());
+            index.append("name", key.second);
+            index.append("lastPass", stats.lastPass);
+            index.append("deletedDocuments", stats.deletedDocuments);
+            index.append("durationMillis", durationCount<Milliseconds>(stats.duration));
+            index.append("lagMillis", durationCount<Milliseconds>(stats.lag));
+        }
+        indexes.done();
+        return bob.obj();
+    }
+
+    void record(const NamespaceString& nss, const std::string& indexName, IndexStats stats) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stats[{nss, indexName}] = std::move(stats);
+    }
+
+    /**
+     * Drops the statistics of the indexes which are no longer TTL indexes.
+     */
+    void retain(const std::vector<std::pair<NamespaceString, BSONObj>>& ttlIndexes) {
+        std::set<std::pair<NamespaceString, std::string>> keys;
+        for (const auto& [nss, spec] : ttlIndexes) {
+            keys.emplace(nss, spec["name"].str());
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto it = _stats.begin(); it != _stats.end();) {
+            it = keys.count(it->first) ? std::next(it) : _stats.erase(it);
+        }
+    }
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("TTLIndexesSSS::_mutex");
+    std::map<std::pair<NamespaceString, std::string>, IndexStats> _stats;
+} ttlIndexesSSS;
+
 class TTLMonitor : public BackgroundJob {
 public:
     explicit TTLMonitor() : BackgroundJob(false /* selfDelete */) {}
@@ -171,26 +238,83 @@ private:
      * Gets all TTL indexes from every collection and performs doTTLForIndex().
      */
     void doTTLPass() {
-        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
-        OperationContext& opCtx = *opCtxPtr;
+        // Increment the metric after the TTL work has been finished.
+        ON_BLOCK_EXIT([&] { ttlPasses.increment(); });
+
+        std::vector<std::pair<NamespaceString, BSONObj>> ttlIndexes;
+        {
+            const ServiceContext::UniqueOperationContext opCtx = cc().makeOperationContext();
 
-        // If part of replSet but not in a readable state (e.g. during initial sync), skip.
-        if (repl::ReplicationCoordinator::get(&opCtx)->getReplicationMode() ==
-                repl::ReplicationCoordinator::modeReplSet &&
-            !repl::ReplicationCoordinator::get(&opCtx)->getMemberState().readable())
+            // If part of replSet but not in a readable state (e.g. during initial sync), skip.
+            if (repl::ReplicationCoordinator::get(opCtx.get())->getReplicationMode() ==
+                    repl::ReplicationCoordinator::modeReplSet &&
+                !repl::ReplicationCoordinator::get(opCtx.get())->getMemberState().readable())
+                return;
+
+            ttlIndexes = getTTLIndexes(opCtx.get());
+        }
+        ttlIndexesSSS.retain(ttlIndexes);
+
+        // The indexes of a collection are processed one after the other, and the collections are
+        // distributed among up to 'ttlMonitorMaxConcurrentCollections' threads.
+        std::map<NamespaceString, std::vector<BSONObj>> ttlIndexesByCollection;
+        for (auto& [nss, spec] : ttlIndexes) {
+            ttlIndexesByCollection[nss].push_back(std::move(spec));
+        }
+
+        const auto maxThreads = static_cast<std::size_t>(ttlMonitorMaxConcurrentCollections.load());
+        if (maxThreads == 1 || ttlIndexesByCollection.size() <= 1) {
+            for (const auto& [nss, specs] : ttlIndexesByCollection) {
+                if (!doTTLForCollection(nss, specs)) {
+                    return;
+                }
+            }
             return;
+        }
+
+        ThreadPool::Options options;
+        options.poolName = "TTLMonitorThreadPool";
+        options.threadNamePrefix = "TTLMonitor-";
+        options.minThreads = 0;
+        options.maxThreads = std::min(maxThreads, ttlIndexesByCollection.size());
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName);
+            AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+            stdx::lock_guard<Client> lk(cc());
+            cc().setSystemOperationKillableByStepdown(lk);
+        };
+        ThreadPool pool(options);
+        pool.startup();
+
+        // Once a thread is interrupted, by a stepdown for example, the remaining collections are
+        // left for the next pass.
+        AtomicWord<bool> interrupted{false};
+        for (const auto& [nss, specs] : ttlIndexesByCollection) {
+            pool.schedule([&, &nss = nss, &specs = specs](Status status) {
+                if (!status.isOK() || interrupted.load()) {
+                    return;
+                }
+                if (!doTTLForCollection(nss, specs)) {
+                    interrupted.store(true);
+                }
+            });
+        }
+        pool.shutdown();
+        pool.join();
+    }
 
+    /**
+     * Gets all TTL indexes from every collection, as pairs of collection namespace and index spec.
+     */
+    std::vector<std::pair<NamespaceString, BSONObj>> getTTLIndexes(OperationContext* opCtxPtr) {
+        OperationContext& opCtx = *opCtxPtr;
         TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
         std::vector<std::pair<UUID, std::string>> ttlInfos = ttlCollectionCache.getTTLInfos();
 
-        // Pair of collection namespace and index spec.
         std::vector<std::pair<NamespaceString, BSONObj>> ttlIndexes;
 
-        // Increment the metric after the TTL work has been finished.
-        ON_BLOCK_EXIT([&] { ttlPasses.increment(); });
-
         // Get all TTL indexes from every collection.
-        auto collectionCatalog = CollectionCatalog::get(opCtxPtr.get());
+        auto collectionCatalog = CollectionCatalog::get(opCtxPtr);
         for (const std::pair<UUID, std::string>& ttlInfo : ttlInfos) {
             auto uuid = ttlInfo.first;
             auto indexName = ttlInfo.second;
@@ -220,46 +344,56 @@ private:
             if (!coll || coll->uuid() != uuid)
                 continue;
 
-            if (!DurableCatalog::get(opCtxPtr.get())
+            if (!DurableCatalog::get(opCtxPtr)
                      ->isIndexPresent(&opCtx, coll->getCatalogId(), indexName)) {
                 ttlCollectionCache.deregisterTTLInfo(ttlInfo);
                 continue;
             }
 
-            BSONObj spec = DurableCatalog::get(opCtxPtr.get())
+            BSONObj spec = DurableCatalog::get(opCtxPtr)
                                ->getIndexSpec(&opCtx, coll->getCatalogId(), indexName);
             if (!spec.hasField(IndexDescriptor::kExpireAfterSecondsFieldName)) {
                 ttlCollectionCache.deregisterTTLInfo(ttlInfo);
                 continue;
             }
 
-            if (!DurableCatalog::get(opCtxPtr.get())
+            if (!DurableCatalog::get(opCtxPtr)
                      ->isIndexReady(&opCtx, coll->getCatalogId(), indexName))
                 continue;
 
             ttlIndexes.push_back(std::make_pair(*nss, spec.getOwned()));
         }
 
-        for (const auto& it : ttlIndexes) {
+        return ttlIndexes;
+    }
+
+    /**
+     * Performs doTTLForIndex() for each of the TTL indexes of a collection, on an operation of the
+     * current thread's client. Returns false if the pass was interrupted.
+     */
+    bool doTTLForCollection(const NamespaceString& nss, const std::vector<BSONObj>& specs) {
+        const ServiceContext::UniqueOperationContext opCtx = cc().makeOperationContext();
+        for (const auto& spec : specs) {
             try {
-                doTTLForIndex(&opCtx, it.first, it.second);
+                doTTLForIndex(opCtx.get(), nss, spec);
             } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
                 LOGV2_WARNING(22537,
                               "TTLMonitor was interrupted, waiting {ttlMonitorSleepSecs_load} "
                               "seconds before doing another pass",
                               "TTLMonitor was interrupted, waiting before doing another pass",
                               "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
-                return;
+                return false;
             } catch (const DBException& dbex) {
                 LOGV2_ERROR(22538,
                             "Error processing ttl index: {it_second} -- {dbex}",
                             "Error processing TTL index",
-                            "index"_attr = it.second,
+                            "index"_attr = spec,
                             "error"_attr = dbex);
                 // Continue on to the next index.
                 continue;
             }
         }
+        return true;
     }
 
     /**
@@ -360,9 +494,9 @@ private:
             ? InternalPlanner::Direction::FORWARD
             : InternalPlanner::Direction::BACKWARD;
 
-        // We need to pass into the DeleteStageParams (below) a CanonicalQuery with a BSONObj that
-        // queries for the expired documents correctly so that we do not delete documents that are
-        // not actually expired when our snapshot changes during deletion.
+        // Each document is checked against a CanonicalQuery with a BSONObj that queries for the
+        // expired documents correctly so that we do not delete documents that are not actually
+        // expired when our snapshot changes during deletion.
         const char* keyFieldName = key.firstElement().fieldName();
         BSONObj query =
             BSON(keyFieldName << BSON("$gte" << kDawnOfTime << "$lte" << expirationTime));
@@ -371,25 +505,60 @@ private:
         auto canonicalQuery = CanonicalQuery::canonicalize(opCtx, std::move(qr));
         invariant(canonicalQuery.getStatus());
 
-        auto params = std::make_unique<DeleteStageParams>();
-        params->isMulti = true;
-        params->canonicalQuery = canonicalQuery.getValue().get();
-
-        auto exec =
-            InternalPlanner::deleteWithIndexScan(opCtx,
-                                                 &collection.getCollection(),
-                                                 std::move(params),
-                                                 desc,
-                                                 startKey,
-                                                 endKey,
-                                                 BoundInclusion::kIncludeBothStartAndEndKeys,
-                                                 PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
-                                                 direction);
-
+        const MatchExpression* expiredFilter = canonicalQuery.getValue()->root();
+
+        auto exec = InternalPlanner::indexScan(opCtx,
+                                               &collection.getCollection(),
+                                               desc,
+                                               startKey,
+                                               endKey,
+                                               BoundInclusion::kIncludeBothStartAndEndKeys,
+                                               PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                               direction,
+                                               InternalPlanner::IXSCAN_FETCH);
+
+        const auto startTime = Date_t::now();
+        boost::optional<Date_t> oldestExpired;
+        long long numDeleted = 0;
         try {
-            const auto numDeleted = exec->executeDelete();
+            const auto batchSize = static_cast<std::size_t>(ttlMonitorBatchSize.load());
+            std::vector<RecordId> batch;
+            BSONObj doc;
+            RecordId recordId;
+            PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
+            while (state == PlanExecutor::ADVANCED) {
+                batch.clear();
+                while (batch.size() < batchSize &&
+                       PlanExecutor::ADVANCED == (state = exec->getNext(&doc, &recordId))) {
+                    batch.push_back(recordId);
+                    auto elt = dotted_path_support::extractElementAtPath(doc, keyFieldName);
+                    if (elt.type() == BSONType::Date) {
+                        oldestExpired = std::min(oldestExpired.value_or(Date_t::max()), elt.date());
+                    }
+                }
+                if (batch.empty()) {
+                    break;
+                }
+
+                // The scan is saved across the deletes, as its cursors can't be used in the
+                // WriteUnitOfWork which removes the batch.
+                exec->saveState();
+                numDeleted += deleteExpiredBatch(
+                    opCtx, collection.getCollection(), expiredFilter, batch);
+                exec->restoreState(&collection.getCollection());
+            }
             ttlDeletedDocuments.increment(numDeleted);
             LOGV2_DEBUG(22536, 1, "deleted: {numDeleted}", "numDeleted"_attr = numDeleted);
+
+            TTLIndexesSSS::IndexStats stats;
+            stats.lastPass = startTime;
+            stats.deletedDocuments = numDeleted;
+            stats.duration = Date_t::now() - startTime;
+            if (oldestExpired) {
+                stats.lag = Date_t::now() -
+                    (*oldestExpired + Seconds(secondsExpireElt.numberLong()));
+            }
+            ttlIndexesSSS.record(collectionNSS, name.toString(), std::move(stats));
         } catch (const ExceptionFor<ErrorCodes::QueryPlanKilled>&) {
             // It is expected that a collection drop can kill a query plan while the TTL monitor is
             // deleting an old document, so ignore this error.
@@ -404,6 +573,40 @@ private:
         }
     }
 
+    /**
+     * Removes the documents of 'batch' which still match 'expiredFilter' in a single
+     * WriteUnitOfWork, and returns the number removed.
+     */
+    long long deleteExpiredBatch(OperationContext* opCtx,
+                                 const CollectionPtr& collection,
+                                 const MatchExpression* expiredFilter,
+                                 const std::vector<RecordId>& batch) {
+        // The node may have stepped down while the scan yielded.
+        uassert(ErrorCodes::PrimarySteppedDown,
+                str::stream() << "Demoted from primary while removing from "
+                              << collection->ns().ns(),
+                repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx,
+                                                                             collection->ns()));
+
+        return writeConflictRetry(opCtx, "ttlDeleteExpiredBatch", collection->ns().ns(), [&] {
+            long long numDeleted = 0;
+            WriteUnitOfWork wuow(opCtx);
+            for (const auto& recordId : batch) {
+                // The document must be read again in this snapshot, as it can have been removed or
+                // updated so that it no longer expires since the scan returned it.
+                Snapshotted<BSONObj> doc;
+                if (!collection->findDoc(opCtx, recordId, &doc) ||
+                    !expiredFilter->matchesBSON(doc.value())) {
+                    continue;
+                }
+                collection->deleteDocument(opCtx, doc, kUninitializedStmtId, recordId, nullptr);
+                ++numDeleted;
+            }
+            wuow.commit();
+            return numDeleted;
+        });
+    }
+
     // Protects the state below.
     mutable Mutex _stateMutex = MONGO_MAKE_LATCH("TTLMonitorStateMutex");
 
@@ -122,6 +122,14 @@ bool parseUpdateExpression(
 UpdateDriver::UpdateDriver(const boost::intrusive_ptr<ExpressionContext>& expCtx)
     : _expCtx(expCtx) {}
 
+UpdateDriver::~UpdateDriver() {
+    if (_updateTreeCacheKey) {
+        auto exec = static_cast<UpdateTreeExecutor*>(_updateExecutor.get());
+        UpdateTreeCache::get()->checkIn(
+            *_updateTreeCacheKey, {exec->releaseUpdateTree(), std::move(_updateTreeLeaves)});
+    }
+}
+
 void UpdateDriver::parse(
     const write_ops::UpdateModification& updateMod,
     const std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>>& arrayFilters,
@@ -186,8 +194,31 @@ void UpdateDriver::parse(
                   static_cast<int>(UpdateOplogEntryVersion::kUpdateNodeV1));
     }
 
+    // Updates whose shape was parsed before only need the values of their leaves replaced.
+    auto* const cache = UpdateTreeCache::get();
+    auto cacheKey = cache && arrayFilters.empty() ? UpdateTreeCache::makeShapeKey(updateExpr)
+                                                  : boost::none;
+    if (cacheKey) {
+        if (auto tree = cache->checkOut(*cacheKey)) {
+            if (UpdateTreeCache::bind(*tree, updateExpr, _expCtx)) {
+                _updateTreeCacheKey = std::move(cacheKey);
+                _updateTreeLeaves = std::move(tree->leaves);
+                _updateExecutor = std::make_unique<UpdateTreeExecutor>(std::move(tree->root));
+                return;
+            }
+            // Leave it to the parser to report the invalid value.
+        }
+    }
+
     auto root = std::make_unique<UpdateObjectNode>();
     _positional = parseUpdateExpression(updateExpr, root.get(), _expCtx, arrayFilters);
+    if (cacheKey) {
+        invariant(!_positional);
+        if (auto leaves = UpdateTreeCache::findLeaves(*root, updateExpr)) {
+            _updateTreeCacheKey = std::move(cacheKey);
+            _updateTreeLeaves = std::move(*leaves);
+        }
+    }
     _updateExecutor = std::make_unique<UpdateTreeExecutor>(std::move(root));
 }
 
@@ -46,6 +46,7 @@
 #include "mongo/db/update/pipeline_executor.h"
 #include "mongo/db/update/update_node_visitor.h"
 #include "mongo/db/update/update_object_node.h"
+#include "mongo/db/update/update_tree_cache.h"
 #include "mongo/db/update/update_tree_executor.h"
 #include "mongo/db/update_index_data.h"
 
@@ -60,6 +61,8 @@ public:
 
     UpdateDriver(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
+    ~UpdateDriver();
+
     /**
      * Parses the 'updateExpr' update expression into the '_updateExecutor' member variable.
      * Uasserts if 'updateExpr' fails to parse.
@@ -238,6 +241,11 @@ private:
     // Do any of the mods require positional match details when calling 'prepare'?
     bool _positional = false;
 
+    // Set if the update tree was parsed for, or taken from, the UpdateTreeCache under this key. The
+    // tree and its leaves are handed back to the cache when the driver is destroyed.
+    boost::optional<std::string> _updateTreeCacheKey;
+    std::vector<UpdateLeafNode*> _updateTreeLeaves;
+
     // The document used to represent or store the object being updated.
     mutablebson::Document _objDoc;
 
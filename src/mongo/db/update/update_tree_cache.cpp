@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/update_tree_cache.h"
+
+#include "mongo/db/field_ref.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/update/modifier_table.h"
+
+namespace mongo {
+
+namespace {
+
+bool isCacheableModifier(modifiertable::ModifierType type) {
+    switch (type) {
+        case modifiertable::MOD_SET:
+        case modifiertable::MOD_INC:
+        case modifiertable::MOD_MUL:
+        case modifiertable::MOD_UNSET:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+UpdateTreeCache::UpdateTreeCache(size_t maxShapes) : _trees(maxShapes) {}
+
+UpdateTreeCache* UpdateTreeCache::get() {
+    static const auto maxShapes = internalQueryUpdateTreeCacheSize.load();
+    if (maxShapes <= 0) {
+        return nullptr;
+    }
+    static UpdateTreeCache cache(maxShapes);
+    return &cache;
+}
+
+boost::optional<std::string> UpdateTreeCache::makeShapeKey(const BSONObj& updateExpr) {
+    std::string key;
+    for (auto&& mod : updateExpr) {
+        // Anything which doesn't parse, including a "$v" field, is left to the parser to reject.
+        if (mod.type() != BSONType::Object ||
+            !isCacheableModifier(modifiertable::getType(mod.fieldName()))) {
+            return boost::none;
+        }
+        auto fields = mod.Obj();
+        if (fields.isEmpty()) {
+            return boost::none;
+        }
+        // Each name is appended along with its terminating NUL. Operators start with '$' but paths
+        // don't contain one, so a key can't be read more than one way.
+        key.append(mod.fieldName(), mod.fieldNameSize());
+        for (auto&& field : fields) {
+            // Positional paths are merged with their siblings at execution, using copies of their
+            // leaves which the cached tree would keep across updates.
+            auto fieldName = field.fieldNameStringData();
+            if (fieldName.empty() || fieldName.find('$') != std::string::npos) {
+                return boost::none;
+            }
+            key.append(field.fieldName(), field.fieldNameSize());
+        }
+    }
+    if (key.empty()) {
+        return boost::none;
+    }
+    return key;
+}
+
+boost::optional<std::vector<UpdateLeafNode*>> UpdateTreeCache::findLeaves(
+    const UpdateObjectNode& root, const BSONObj& updateExpr) {
+    std::vector<UpdateLeafNode*> leaves;
+    for (auto&& mod : updateExpr) {
+        for (auto&& field : mod.Obj()) {
+            FieldRef path(field.fieldNameStringData());
+            const UpdateNode* node = &root;
+            for (FieldIndex i = 0; node && i < path.numParts(); ++i) {
+                if (node->type != UpdateNode::Type::Object) {
+                    return boost::none;
+                }
+                node = static_cast<const UpdateObjectNode*>(node)->getChild(
+                    path.getPart(i).toString());
+            }
+            if (!node || node->type != UpdateNode::Type::Leaf) {
+                return boost::none;
+            }
+            leaves.push_back(const_cast<UpdateLeafNode*>(static_cast<const UpdateLeafNode*>(node)));
+        }
+    }
+    return leaves;
+}
+
+bool UpdateTreeCache::bind(const Tree& tree,
+                           const BSONObj& updateExpr,
+                           const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    auto leaf = tree.leaves.begin();
+    for (auto&& mod : updateExpr) {
+        for (auto&& field : mod.Obj()) {
+            invariant(leaf != tree.leaves.end());
+            if (!(*leaf++)->init(field, expCtx).isOK()) {
+                return false;
+            }
+        }
+    }
+    invariant(leaf == tree.leaves.end());
+    return true;
+}
+
+boost::optional<UpdateTreeCache::Tree> UpdateTreeCache::checkOut(const std::string& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _trees.find(key);
+    if (it == _trees.end() || it->second.empty()) {
+        return boost::none;
+    }
+    _trees.promote(it);
+    auto tree = std::move(it->second.back());
+    it->second.pop_back();
+    return std::move(tree);
+}
+
+void UpdateTreeCache::checkIn(const std::string& key, Tree tree) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _trees.find(key);
+    if (it == _trees.end()) {
+        std::vector<Tree> trees;
+        trees.push_back(std::move(tree));
+        _trees.add(key, std::move(trees));
+    } else if (it->second.size() < kMaxTreesPerShape) {
+        it->second.push_back(std::move(tree));
+    }
+}
+
+size_t UpdateTreeCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _trees.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/update/update_leaf_node.h"
+#include "mongo/db/update/update_object_node.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+
+namespace mongo {
+
+/**
+ * A process-wide cache of the parsed trees of modifier-style updates, keyed by the shape of the
+ * update: its operators and the paths they modify, but not the values they apply. An update of a
+ * cached shape takes a tree out of the cache and binds its own values to the leaves, instead of
+ * building a new tree and validating all of its paths again. The tree is put back once the update
+ * is done with it.
+ *
+ * Only updates whose leaves merely hold on to their value are cached: $set, $inc, $mul and $unset
+ * on paths without positional or array filter components.
+ */
+class UpdateTreeCache {
+    UpdateTreeCache(const UpdateTreeCache&) = delete;
+    UpdateTreeCache& operator=(const UpdateTreeCache&) = delete;
+
+public:
+    /**
+     * A parsed update tree, along with the leaf of each field of the update in the order of the
+     * update document.
+     */
+    struct Tree {
+        std::unique_ptr<UpdateObjectNode> root;
+        std::vector<UpdateLeafNode*> leaves;
+    };
+
+    // The maximum number of idle trees the cache keeps for a single shape.
+    static constexpr size_t kMaxTreesPerShape = 16;
+
+    explicit UpdateTreeCache(size_t maxShapes);
+
+    /**
+     * Returns the cache used by all UpdateDrivers, or nullptr if it's disabled by setting
+     * internalQueryUpdateTreeCacheSize to 0.
+     */
+    static UpdateTreeCache* get();
+
+    /**
+     * Returns the key under which the tree of 'updateExpr' is cached, or boost::none if updates of
+     * its shape aren't cached.
+     */
+    static boost::optional<std::string> makeShapeKey(const BSONObj& updateExpr);
+
+    /**
+     * Returns the leaf of each field of 'updateExpr' in the tree 'root' parsed from it, or
+     * boost::none if a leaf can't be found.
+     */
+    static boost::optional<std::vector<UpdateLeafNode*>> findLeaves(const UpdateObjectNode& root,
+                                                                  const BSONObj& updateExpr);
+
+    /**
+     * Initializes the leaves of 'tree' with the values of 'updateExpr', whose shape the tree must
+     * have been cached under. Returns false if any value is invalid for its operator, in which case
+     * the tree must not be used.
+     */
+    static bool bind(const Tree& tree,
+                     const BSONObj& updateExpr,
+                     const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    /**
+     * Takes an idle tree cached under 'key' out of the cache, if there is one.
+     */
+    boost::optional<Tree> checkOut(const std::string& key);
+
+    /**
+     * Returns 'tree' to the cache under 'key'. The tree is dropped if enough trees of its shape are
+     * already idle.
+     */
+    void checkIn(const std::string& key, Tree tree);
+
+    size_t size() const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("UpdateTreeCache::_mutex");
+    LRUCache<std::string, std::vector<Tree>> _trees;
+};
+
+}  // namespace mongo
@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/update_tree_cache.h"
+
+#include "mongo/bson/mutable/document.h"
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/update/update_driver.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> kNoArrayFilters;
+
+BSONObj applyUpdate(const BSONObj& update, const BSONObj& original) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    UpdateDriver driver(expCtx);
+    driver.parse(write_ops::UpdateModification::parseFromClassicUpdate(update), kNoArrayFilters);
+
+    mutablebson::Document doc(original);
+    bool modified = false;
+    ASSERT_OK(driver.update(
+        expCtx->opCtx, StringData(), &doc, true, FieldRefSet(), false, nullptr, &modified));
+    return doc.getObject();
+}
+
+TEST(UpdateTreeCacheTest, ShapeKeyIgnoresValues) {
+    auto key = UpdateTreeCache::makeShapeKey(fromjson("{$set: {a: 1, 'b.c': 'x'}, $inc: {d: 1}}"));
+    ASSERT(key);
+    ASSERT_EQ(*key,
+              *UpdateTreeCache::makeShapeKey(
+                  fromjson("{$set: {a: {x: 1}, 'b.c': null}, $inc: {d: 2.5}}")));
+}
+
+TEST(UpdateTreeCacheTest, ShapeKeyDependsOnOperatorsAndPaths) {
+    auto key = *UpdateTreeCache::makeShapeKey(fromjson("{$set: {ab: 1}}"));
+    ASSERT_NE(key, *UpdateTreeCache::makeShapeKey(fromjson("{$set: {a: 1, b: 1}}")));
+    ASSERT_NE(key, *UpdateTreeCache::makeShapeKey(fromjson("{$set: {'a.b': 1}}")));
+    ASSERT_NE(key, *UpdateTreeCache::makeShapeKey(fromjson("{$inc: {ab: 1}}")));
+    ASSERT_NE(*UpdateTreeCache::makeShapeKey(fromjson("{$set: {a: 1}, $unset: {b: 1}}")),
+              *UpdateTreeCache::makeShapeKey(fromjson("{$set: {a: 1, b: 1}}")));
+}
+
+TEST(UpdateTreeCacheTest, OnlySimpleUpdatesHaveShapeKey) {
+    ASSERT_FALSE(UpdateTreeCache::makeShapeKey(fromjson("{$push: {a: 1}}")));
+    ASSERT_FALSE(UpdateTreeCache::makeShapeKey(fromjson("{$set: {a: 1}, $max: {b: 1}}")));
+    ASSERT_FALSE(UpdateTreeCache::makeShapeKey(fromjson("{$set: {'a.$': 1}}")));
+    ASSERT_FALSE(UpdateTreeCache::makeShapeKey(fromjson("{$set: {'a.$[]': 1}}")));
+    ASSERT_FALSE(UpdateTreeCache::makeShapeKey(fromjson("{$set: {'a.$[i].b': 1}}")));
+    ASSERT_FALSE(UpdateTreeCache::makeShapeKey(fromjson("{$v: 1, $set: {a: 1}}")));
+    ASSERT_FALSE(UpdateTreeCache::makeShapeKey(fromjson("{$set: {}}")));
+    ASSERT_FALSE(UpdateTreeCache::makeShapeKey(fromjson("{$set: 1}")));
+    ASSERT_FALSE(UpdateTreeCache::makeShapeKey(BSONObj()));
+}
+
+TEST(UpdateTreeCacheTest, CheckOutReturnsCheckedInTree) {
+    UpdateTreeCache cache(2);
+    ASSERT_FALSE(cache.checkOut("key"));
+
+    for (size_t i = 0; i < UpdateTreeCache::kMaxTreesPerShape + 1; ++i) {
+        cache.checkIn("key", {std::make_unique<UpdateObjectNode>(), {}});
+    }
+    ASSERT_EQ(1U, cache.size());
+
+    // Only the maximum number of idle trees per shape was kept.
+    for (size_t i = 0; i < UpdateTreeCache::kMaxTreesPerShape; ++i) {
+        ASSERT(cache.checkOut("key"));
+    }
+    ASSERT_FALSE(cache.checkOut("key"));
+}
+
+TEST(UpdateTreeCacheTest, LeastRecentlyUsedShapeIsEvicted) {
+    UpdateTreeCache cache(2);
+    cache.checkIn("a", {std::make_unique<UpdateObjectNode>(), {}});
+    cache.checkIn("b", {std::make_unique<UpdateObjectNode>(), {}});
+    auto tree = cache.checkOut("a");
+    ASSERT(tree);
+    cache.checkIn("a", std::move(*tree));
+    cache.checkIn("c", {std::make_unique<UpdateObjectNode>(), {}});
+    ASSERT_EQ(2U, cache.size());
+    ASSERT(cache.checkOut("a"));
+    ASSERT_FALSE(cache.checkOut("b"));
+}
+
+TEST(UpdateTreeCacheTest, CachedTreeAppliesNewValues) {
+    auto* cache = UpdateTreeCache::get();
+    ASSERT(cache);
+    for (int i = 1; i <= 3; ++i) {
+        auto updateObj = fromjson(str::stream() << "{$inc: {treeCacheCounter: " << i
+                                                << "}, $set: {'treeCacheSub.x': " << i << "}}");
+        ASSERT_BSONOBJ_EQ(fromjson(str::stream() << "{treeCacheCounter: " << 10 + i
+                                                 << ", treeCacheSub: {x: " << i << "}}"),
+                          applyUpdate(updateObj, fromjson("{treeCacheCounter: 10}")));
+    }
+
+    // The tree is back in the cache once the update is done with it.
+    auto key = UpdateTreeCache::makeShapeKey(fromjson("{$inc: {treeCacheCounter: 1}, $set: "
+                                                      "{'treeCacheSub.x': 1}}"));
+    auto tree = cache->checkOut(*key);
+    ASSERT(tree);
+    ASSERT_EQ(2U, tree->leaves.size());
+    cache->checkIn(*key, std::move(*tree));
+}
+
+TEST(UpdateTreeCacheTest, CachedShapeStillRejectsInvalidValues) {
+    ASSERT_BSONOBJ_EQ(fromjson("{treeCacheMul: 6}"),
+                      applyUpdate(fromjson("{$mul: {treeCacheMul: 2}}"),
+                                  fromjson("{treeCacheMul: 3}")));
+    ASSERT_THROWS_CODE(applyUpdate(fromjson("{$mul: {treeCacheMul: 'x'}}"), BSONObj()),
+                       DBException,
+                       ErrorCodes::TypeMismatch);
+    ASSERT_BSONOBJ_EQ(fromjson("{treeCacheMul: 12}"),
+                      applyUpdate(fromjson("{$mul: {treeCacheMul: 4}}"),
+                                  fromjson("{treeCacheMul: 3}")));
+}
+
+}  // namespace
+}  // namespace mongo
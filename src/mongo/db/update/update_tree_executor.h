@@ -84,6 +84,10 @@ public:
         return static_cast<UpdateNode*>(_updateTree.get());
     }
 
+    std::unique_ptr<UpdateObjectNode> releaseUpdateTree() {
+        return std::move(_updateTree);
+    }
+
     /**
      * Gather all update operators in the subtree rooted from '_updateTree' into a BSONObj in the
      * format of the update command's update parameter.
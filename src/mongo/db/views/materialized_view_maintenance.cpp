@@ -0,0 +1,603 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view_maintenance.h"
+
+#include <algorithm>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/client/dbclient_cursor.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/repl/storage_interface.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace materialized_view_maintenance {
+namespace {
+Counter64 materializedViewIncrementalRefreshes;
+Counter64 materializedViewFullRefreshes;
+Counter64 materializedViewRefreshFailures;
+
+ServerStatusMetricField<Counter64> materializedViewIncrementalRefreshesMetric(
+    "query.materializedViews.incrementalRefreshes", &materializedViewIncrementalRefreshes);
+ServerStatusMetricField<Counter64> materializedViewFullRefreshesMetric(
+    "query.materializedViews.fullRefreshes", &materializedViewFullRefreshes);
+ServerStatusMetricField<Counter64> materializedViewRefreshFailuresMetric(
+    "query.materializedViews.refreshFailures", &materializedViewRefreshFailures);
+
+// The number of bytes of documents above which a batch of writes to the backing collection is
+// sent as a separate command.
+constexpr int kMaxWriteBatchBytes = BSONObjMaxUserSize / 2;
+
+/**
+ * What this node knows about the contents of the backing collection of a materialized view.
+ */
+struct RefreshState {
+    // Serializes the refreshes of the view.
+    Mutex mutex = MONGO_MAKE_LATCH("MaterializedViewRefreshState::mutex");
+
+    // The backing collection written by the last refresh and the term it was written in. If
+    // either changed, the backing collection may not reflect 'refreshedThrough'.
+    boost::optional<UUID> backingUUID;
+    long long term = repl::OpTime::kUninitializedTerm;
+
+    // The timestamp of the last oplog entry reflected in the backing collection.
+    Timestamp refreshedThrough;
+};
+
+Mutex refreshStatesMutex = MONGO_MAKE_LATCH("materializedViewRefreshStates");
+StringMap<std::shared_ptr<RefreshState>> refreshStates;
+
+std::shared_ptr<RefreshState> getRefreshState(const NamespaceString& viewNss) {
+    stdx::lock_guard<Latch> lk(refreshStatesMutex);
+    auto& state = refreshStates[viewNss.ns()];
+    if (!state) {
+        state = std::make_shared<RefreshState>();
+    }
+    return state;
+}
+
+bool isIdPath(StringData path) {
+    return path == "_id"_sd || path.startsWith("_id."_sd);
+}
+
+/**
+ * Returns true if 'stage' produces at most one result per input document. If 'mustPreserveId' is
+ * true, the result must also have the _id of its input document.
+ */
+bool isPerDocumentStage(const BSONObj& stage, bool mustPreserveId) {
+    if (stage.nFields() != 1) {
+        return false;
+    }
+
+    auto spec = stage.firstElement();
+    auto name = spec.fieldNameStringData();
+    if (name == "$match"_sd) {
+        return true;
+    }
+
+    if (name == "$project"_sd || name == "$addFields"_sd || name == "$set"_sd) {
+        if (spec.type() != Object) {
+            return false;
+        }
+        if (!mustPreserveId) {
+            return true;
+        }
+        const bool isProjection = name == "$project"_sd;
+        return std::none_of(spec.Obj().begin(), spec.Obj().end(), [&](const BSONElement& field) {
+            // An inclusion projection of _id leaves it unchanged.
+            if (isProjection && field.fieldNameStringData() == "_id"_sd &&
+                (field.isBoolean() || field.isNumber())) {
+                return !field.trueValue();
+            }
+            return isIdPath(field.fieldNameStringData());
+        });
+    }
+
+    if (name == "$unset"_sd) {
+        auto unsetsId = [&](const BSONElement& path) {
+            return path.type() != String || (mustPreserveId && isIdPath(path.valueStringData()));
+        };
+        if (spec.type() == Array) {
+            return std::none_of(spec.Obj().begin(), spec.Obj().end(), unsetsId);
+        }
+        return !unsetsId(spec);
+    }
+
+    return false;
+}
+
+/**
+ * The source documents written between two refreshes.
+ */
+struct Changes {
+    // The _id of each written document, wrapped in an object.
+    SimpleBSONObjComparator::Set ids = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+
+    // Whether every write was an insert.
+    bool onlyInserts = true;
+};
+
+/**
+ * Adds the source documents written by the oplog entry 'entry' to 'changes'. Returns false if the
+ * entry changes the source collection in a way that requires recomputing the view.
+ */
+bool addChanges(const BSONObj& entry, const NamespaceString& source, Changes* changes) {
+    auto op = entry["op"].str();
+    if (op == "c") {
+        auto command = entry["o"].Obj();
+        auto name = command.firstElementFieldNameStringData();
+        if (name == "applyOps"_sd) {
+            for (auto&& nested : command["applyOps"].Obj()) {
+                if (nested.type() != Object || !addChanges(nested.Obj(), source, changes)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        if (name == "commitTransaction"_sd || name == "abortTransaction"_sd ||
+            name == "createIndexes"_sd || name == "startIndexBuild"_sd ||
+            name == "commitIndexBuild"_sd || name == "abortIndexBuild"_sd ||
+            name == "dropIndexes"_sd) {
+            return true;
+        }
+        if (name == "renameCollection"_sd) {
+            return command["renameCollection"].str() != source.ns() &&
+                command["to"].str() != source.ns();
+        }
+        // Any other command on the source collection, such as a drop or a collMod, can change
+        // its contents without logging the documents it changed.
+        return command.firstElement().type() != String ||
+            command.firstElement().valueStringData() != source.coll();
+    }
+
+    if (entry["ns"].str() != source.ns() || (op != "i" && op != "u" && op != "d")) {
+        return true;
+    }
+
+    auto id = (op == "u" ? entry["o2"] : entry["o"])["_id"];
+    if (id.eoo()) {
+        return false;
+    }
+
+    changes->ids.insert(id.wrap("_id"));
+    changes->onlyInserts = changes->onlyInserts && op == "i";
+    return true;
+}
+
+/**
+ * Returns the source documents written by the oplog entries after 'after' through 'through', or
+ * boost::none if the view must be recomputed instead.
+ */
+boost::optional<Changes> collectChanges(DBDirectClient& client,
+                                        const NamespaceString& source,
+                                        Timestamp after,
+                                        Timestamp through) {
+    // The oplog may have been truncated past the previous refresh.
+    auto oldest = client.findOne(NamespaceString::kRsOplogNamespace.ns(),
+                                 Query().sort(BSON("$natural" << 1)));
+    if (oldest.isEmpty() || oldest["ts"].timestamp() > after) {
+        return boost::none;
+    }
+
+    const auto maxDocuments =
+        static_cast<size_t>(internalQueryMaterializedViewMaxIncrementalDocuments.load());
+    auto cursor = client.query(
+        NamespaceString::kRsOplogNamespace,
+        BSON("ts" << BSON("$gt" << after << "$lte" << through) << "ns"
+                  << BSON("$in" << BSON_ARRAY(source.ns() << source.getCommandNS().ns()))));
+    Changes changes;
+    while (cursor->more()) {
+        if (!addChanges(cursor->nextSafe(), source, &changes) ||
+            changes.ids.size() > maxDocuments) {
+            return boost::none;
+        }
+    }
+    return changes;
+}
+
+std::unique_ptr<DBClientCursor> aggregateSource(DBDirectClient& client,
+                                                const ViewDefinition& view,
+                                                std::vector<BSONObj> pipeline) {
+    AggregationRequest request(view.materialization()->from, std::move(pipeline));
+    if (view.defaultCollator()) {
+        request.setCollation(view.defaultCollator()->getSpec().toBSON());
+    }
+    request.setAllowDiskUse(true);
+    return uassertStatusOK(DBClientCursor::fromAggregationRequest(
+        &client, std::move(request), false /* secondaryOk */, false /* useExhaust */));
+}
+
+/**
+ * Returns the results of the view's pipeline for the source documents in 'changes'.
+ */
+std::vector<BSONObj> aggregateChanges(DBDirectClient& client,
+                                      const ViewDefinition& view,
+                                      const Changes& changes) {
+    BSONArrayBuilder ids;
+    for (auto&& id : changes.ids) {
+        ids.append(id.firstElement());
+    }
+
+    std::vector<BSONObj> pipeline{BSON("$match" << BSON("_id" << BSON("$in" << ids.arr())))};
+    const auto& viewPipeline = view.materialization()->pipeline;
+    pipeline.insert(pipeline.end(), viewPipeline.begin(), viewPipeline.end());
+
+    std::vector<BSONObj> results;
+    auto cursor = aggregateSource(client, view, std::move(pipeline));
+    while (cursor->more()) {
+        results.push_back(cursor->nextSafe().getOwned());
+    }
+    return results;
+}
+
+void runWriteCommand(DBDirectClient& client, OpMsgRequest request) {
+    auto reply = client.runCommand(std::move(request));
+    uassertStatusOK(getStatusFromWriteCommandReply(reply->getCommandReply()));
+}
+
+OpMsgRequest makeWriteCommand(const NamespaceString& nss, std::vector<BSONObj> documents) {
+    write_ops::Insert insertOp(nss);
+    insertOp.setDocuments(std::move(documents));
+    return insertOp.serialize({});
+}
+
+OpMsgRequest makeWriteCommand(const NamespaceString& nss,
+                              std::vector<write_ops::UpdateOpEntry> updates) {
+    write_ops::Update updateOp(nss);
+    updateOp.setUpdates(std::move(updates));
+    return updateOp.serialize({});
+}
+
+OpMsgRequest makeWriteCommand(const NamespaceString& nss,
+                              std::vector<write_ops::DeleteOpEntry> deletes) {
+    write_ops::Delete deleteOp(nss);
+    deleteOp.setDeletes(std::move(deletes));
+    return deleteOp.serialize({});
+}
+
+/**
+ * Sends write operations against 'nss' in as few commands as the size of the documents they carry
+ * allows.
+ */
+template <typename Op>
+class WriteBatcher {
+public:
+    WriteBatcher(DBDirectClient* client, NamespaceString nss)
+        : _client(client), _nss(std::move(nss)) {}
+
+    void add(Op op, int bytes) {
+        if (_batchBytes + bytes > kMaxWriteBatchBytes) {
+            flush();
+        }
+        _batch.push_back(std::move(op));
+        _batchBytes += bytes;
+    }
+
+    void flush() {
+        if (_batch.empty()) {
+            return;
+        }
+        runWriteCommand(*_client, makeWriteCommand(_nss, std::exchange(_batch, {})));
+        _batchBytes = 0;
+    }
+
+private:
+    DBDirectClient* const _client;
+    const NamespaceString _nss;
+    std::vector<Op> _batch;
+    int _batchBytes = 0;
+};
+
+write_ops::UpdateOpEntry makeUpsert(const BSONElement& id, write_ops::UpdateModification update) {
+    write_ops::UpdateOpEntry entry;
+    entry.setQ(BSON("_id" << id));
+    entry.setU(std::move(update));
+    entry.setUpsert(true);
+    return entry;
+}
+
+/**
+ * Replaces the results for the source documents in 'changes' in the backing collection.
+ */
+void applyPerDocumentChanges(DBDirectClient& client,
+                             const ViewDefinition& view,
+                             const Changes& changes) {
+    auto deletedIds = changes.ids;
+    WriteBatcher<write_ops::UpdateOpEntry> updates(&client, view.viewOn());
+    for (auto&& result : aggregateChanges(client, view, changes)) {
+        auto id = result["_id"];
+        uassert(5843121,
+                str::stream() << "Result of materialized view " << view.name()
+                              << " has no _id: " << result,
+                !id.eoo());
+        deletedIds.erase(id.wrap("_id"));
+        updates.add(makeUpsert(id, write_ops::UpdateModification::parseFromClassicUpdate(result)),
+                    result.objsize());
+    }
+    updates.flush();
+
+    WriteBatcher<write_ops::DeleteOpEntry> deletes(&client, view.viewOn());
+    for (auto&& id : deletedIds) {
+        write_ops::DeleteOpEntry entry;
+        entry.setQ(id);
+        entry.setMulti(false);
+        deletes.add(std::move(entry), id.objsize());
+    }
+    deletes.flush();
+}
+
+/**
+ * Merges the groups computed from the source documents inserted in 'changes' into the groups
+ * stored in the backing collection.
+ */
+void applyInsertedToGroups(DBDirectClient& client,
+                           const ViewDefinition& view,
+                           const MaintenancePlan& plan,
+                           const Changes& changes) {
+    WriteBatcher<write_ops::UpdateOpEntry> updates(&client, view.viewOn());
+    for (auto&& partial : aggregateChanges(client, view, changes)) {
+        if (plan.accumulators.empty()) {
+            updates.add(makeUpsert(partial["_id"],
+                                   write_ops::UpdateModification::parseFromClassicUpdate(partial)),
+                        partial.objsize());
+            continue;
+        }
+
+        BSONObjBuilder merged;
+        for (auto&& [field, accumulator] : plan.accumulators) {
+            auto stored = "$" + field;
+            auto value = BSON("$literal" << partial[field]);
+            if (accumulator == "$sum") {
+                merged.append(field,
+                              BSON("$add" << BSON_ARRAY(BSON("$ifNull" << BSON_ARRAY(stored << 0))
+                                                        << value)));
+            } else {
+                merged.append(field, BSON(accumulator << BSON_ARRAY(stored << value)));
+            }
+        }
+        updates.add(
+            makeUpsert(partial["_id"], std::vector<BSONObj>{BSON("$set" << merged.obj())}),
+            partial.objsize());
+    }
+    updates.flush();
+}
+
+/**
+ * Replaces the backing collection with the results of running the view's pipeline on all of its
+ * source collection.
+ */
+void recompute(DBDirectClient& client, const ViewDefinition& view) {
+    const NamespaceString tempNss(view.name().db(),
+                                  "tmp.materialized." + UUID::gen().toString());
+
+    BSONObjBuilder createCmd;
+    createCmd.append("create", tempNss.coll());
+    createCmd.append("temp", true);
+    if (view.defaultCollator()) {
+        createCmd.append("collation", view.defaultCollator()->getSpec().toBSON());
+    }
+    BSONObj info;
+    client.runCommand(tempNss.db().toString(), createCmd.obj(), info);
+    uassertStatusOK(getStatusFromCommandResult(info));
+
+    try {
+        WriteBatcher<BSONObj> inserts(&client, tempNss);
+        auto cursor = aggregateSource(client, view, view.materialization()->pipeline);
+        while (cursor->more()) {
+            auto result = cursor->nextSafe().getOwned();
+            const auto bytes = result.objsize();
+            inserts.add(std::move(result), bytes);
+        }
+        inserts.flush();
+
+        client.runCommand("admin",
+                          BSON("renameCollection" << tempNss.ns() << "to" << view.viewOn().ns()
+                                                  << "dropTarget" << true),
+                          info);
+        uassertStatusOK(getStatusFromCommandResult(info));
+    } catch (const DBException&) {
+        // The temporary collection is also dropped on restart.
+        client.dropCollection(tempNss.ns());
+        throw;
+    }
+}
+
+void refreshWithInternalClient(OperationContext* opCtx,
+                               const ViewDefinition& view,
+                               RefreshState* state) {
+    const auto& source = view.materialization()->from;
+    const auto& backingNss = view.viewOn();
+
+    // Block writes to the source collection for the whole refresh, so that the backing collection
+    // reflects exactly the writes logged up to the timestamp recorded for it. Locking the backing
+    // collection keeps the view from being dropped in the middle of the refresh.
+    Lock::DBLock dbLock(opCtx, source.db(), MODE_IX);
+    Lock::CollectionLock sourceLock(opCtx, source, MODE_S);
+    Lock::CollectionLock backingLock(opCtx, backingNss, MODE_IX);
+
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    uassert(ErrorCodes::NotWritablePrimary,
+            str::stream() << "Not primary while refreshing materialized view " << view.name(),
+            replCoord->canAcceptWritesFor(opCtx, backingNss));
+    const auto term = replCoord->getTerm();
+
+    auto backingUUID = CollectionCatalog::get(opCtx)->lookupUUIDByNSS(opCtx, backingNss);
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Backing collection " << backingNss << " of materialized view "
+                          << view.name() << " does not exist",
+            backingUUID);
+
+    // Every write to the source committed before the lock was granted. Once the oplog entries
+    // before the last one are visible, all of those writes are at or before it.
+    repl::StorageInterface::get(opCtx)->waitForAllEarlierOplogWritesToBeVisible(opCtx);
+    DBDirectClient client(opCtx);
+    auto top = client.findOne(NamespaceString::kRsOplogNamespace.ns(),
+                              Query().sort(BSON("$natural" << -1)));
+    uassert(ErrorCodes::NoMatchingDocument, "The oplog is empty", !top.isEmpty());
+    const auto through = top["ts"].timestamp();
+
+    const bool isRefreshed = state->backingUUID == backingUUID && state->term == term &&
+        !state->refreshedThrough.isNull();
+    if (isRefreshed && state->refreshedThrough == through) {
+        return;
+    }
+
+    const auto plan = analyzePipeline(view.materialization()->pipeline);
+    boost::optional<Changes> changes;
+    if (isRefreshed && plan.kind != MaintenancePlan::Kind::kRecompute) {
+        changes = collectChanges(client, source, state->refreshedThrough, through);
+    }
+    if (changes && plan.kind == MaintenancePlan::Kind::kMergeableGroup && !changes->onlyInserts) {
+        changes.reset();
+    }
+
+    // Forget the previous refresh while the backing collection is being written.
+    state->backingUUID.reset();
+    if (!changes) {
+        recompute(client, view);
+        materializedViewFullRefreshes.increment();
+    } else if (!changes->ids.empty()) {
+        if (plan.kind == MaintenancePlan::Kind::kPerDocument) {
+            applyPerDocumentChanges(client, view, *changes);
+        } else {
+            applyInsertedToGroups(client, view, plan, *changes);
+        }
+        materializedViewIncrementalRefreshes.increment();
+    }
+
+    state->backingUUID = CollectionCatalog::get(opCtx)->lookupUUIDByNSS(opCtx, backingNss);
+    state->term = term;
+    state->refreshedThrough = through;
+}
+}  // namespace
+
+MaintenancePlan analyzePipeline(const std::vector<BSONObj>& pipeline) {
+    MaintenancePlan plan;
+    if (std::all_of(pipeline.begin(), pipeline.end(), [](const BSONObj& stage) {
+            return isPerDocumentStage(stage, true /* mustPreserveId */);
+        })) {
+        plan.kind = MaintenancePlan::Kind::kPerDocument;
+        return plan;
+    }
+
+    const auto& last = pipeline.back();
+    if (last.nFields() != 1 || last.firstElementFieldNameStringData() != "$group"_sd ||
+        last.firstElement().type() != Object ||
+        !std::all_of(pipeline.begin(), std::prev(pipeline.end()), [](const BSONObj& stage) {
+            return isPerDocumentStage(stage, false /* mustPreserveId */);
+        })) {
+        return plan;
+    }
+
+    for (auto&& field : last.firstElement().Obj()) {
+        if (field.fieldNameStringData() == "_id"_sd) {
+            continue;
+        }
+        if (field.type() != Object || field.Obj().nFields() != 1) {
+            return {};
+        }
+        auto accumulator = field.Obj().firstElementFieldNameStringData();
+        if (accumulator != "$sum"_sd && accumulator != "$min"_sd && accumulator != "$max"_sd) {
+            return {};
+        }
+        plan.accumulators.emplace_back(field.fieldName(), accumulator.toString());
+    }
+
+    plan.kind = MaintenancePlan::Kind::kMergeableGroup;
+    return plan;
+}
+
+Status refresh(OperationContext* opCtx, const ViewDefinition& view) {
+    invariant(view.materialization());
+    invariant(!opCtx->lockState()->isLocked());
+
+    // The backing collection can only be maintained from the oplog of a primary, and it only
+    // serves reads of its latest state.
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+        return {ErrorCodes::NoReplicationEnabled,
+                "Materialized views are only refreshed on replica set members"};
+    }
+    if (opCtx->inMultiDocumentTransaction()) {
+        return {ErrorCodes::OperationNotSupportedInTransaction,
+                "Materialized views are not refreshed in a multi-document transaction"};
+    }
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if ((readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern &&
+         readConcernArgs.getLevel() != repl::ReadConcernLevel::kAvailableReadConcern) ||
+        readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime() ||
+        readConcernArgs.getArgsOpTime()) {
+        return {ErrorCodes::InvalidOptions,
+                "Materialized views are only refreshed for reads of the latest local data"};
+    }
+
+    auto state = getRefreshState(view.name());
+    stdx::lock_guard<Latch> lk(state->mutex);
+
+    // Refresh on behalf of the system, since the backing collection is written regardless of the
+    // privileges of the reader.
+    auto newClient = opCtx->getServiceContext()->makeClient("MaterializedViewRefresh");
+    AuthorizationSession::get(newClient.get())->grantInternalAuthorization(newClient.get());
+    AlternativeClientRegion acr(newClient);
+    auto refreshOpCtx = cc().makeOperationContext();
+
+    try {
+        refreshWithInternalClient(refreshOpCtx.get(), view, state.get());
+    } catch (const DBException& ex) {
+        materializedViewRefreshFailures.increment();
+        LOGV2_DEBUG(5843207,
+                    1,
+                    "Could not refresh materialized view",
+                    "view"_attr = view.name(),
+                    "error"_attr = ex.toStatus());
+        return ex.toStatus();
+    }
+    return Status::OK();
+}
+
+}  // namespace materialized_view_maintenance
+}  // namespace mongo
@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/views/view.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Keeps the backing collections of materialized views up to date with their source collections.
+ *
+ * A materialized view is refreshed when it is read on a replica set primary. The refresh scans the
+ * oplog for writes to the source collection since the previous refresh and, if the view's pipeline
+ * allows it, applies only their effect to the backing collection. Otherwise, the backing
+ * collection is recomputed from scratch by running the whole pipeline.
+ */
+namespace materialized_view_maintenance {
+
+/**
+ * Describes how the results of a materialization pipeline can follow changes to its source.
+ */
+struct MaintenancePlan {
+    enum class Kind {
+        // Every stage maps a source document to at most one result with the same _id, so the
+        // results for the changed source documents can be recomputed and replaced individually.
+        kPerDocument,
+        // Per-document stages followed by a final $group whose accumulators can merge a partial
+        // result into the stored one. Only inserts into the source can be applied incrementally.
+        kMergeableGroup,
+        // The backing collection can only be recomputed from scratch.
+        kRecompute,
+    };
+
+    Kind kind = Kind::kRecompute;
+
+    // For 'kMergeableGroup', the name of each accumulated output field and of its accumulator.
+    std::vector<std::pair<std::string, std::string>> accumulators;
+};
+
+/**
+ * Determines how the backing collection of a view materialized with 'pipeline' is maintained.
+ */
+MaintenancePlan analyzePipeline(const std::vector<BSONObj>& pipeline);
+
+/**
+ * Brings the backing collection of the materialized view 'view' up to date with the writes that
+ * committed on its source collection before this call. Returns a non-OK status if this node cannot
+ * refresh the view for this operation, in which case the caller must compute the view's contents
+ * from its source collection instead of reading the backing collection.
+ *
+ * Must be called without holding any locks.
+ */
+Status refresh(OperationContext* opCtx, const ViewDefinition& view);
+
+}  // namespace materialized_view_maintenance
+}  // namespace mongo
@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/views/materialized_view_maintenance.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using materialized_view_maintenance::analyzePipeline;
+using Kind = materialized_view_maintenance::MaintenancePlan::Kind;
+
+std::vector<BSONObj> makePipeline(std::vector<std::string> stages) {
+    std::vector<BSONObj> pipeline;
+    for (auto&& stage : stages) {
+        pipeline.push_back(fromjson(stage));
+    }
+    return pipeline;
+}
+
+TEST(MaterializedViewMaintenanceTest, EmptyPipelineIsMaintainedPerDocument) {
+    ASSERT(analyzePipeline({}).kind == Kind::kPerDocument);
+}
+
+TEST(MaterializedViewMaintenanceTest, StagesPreservingIdAreMaintainedPerDocument) {
+    auto plan = analyzePipeline(makePipeline({"{$match: {a: {$gt: 1}}}",
+                                              "{$project: {_id: 1, a: 1, b: {$add: ['$a', 1]}}}",
+                                              "{$addFields: {c: '$b'}}",
+                                              "{$set: {d: 1}}",
+                                              "{$unset: ['c', 'd']}"}));
+    ASSERT(plan.kind == Kind::kPerDocument);
+    ASSERT(plan.accumulators.empty());
+}
+
+TEST(MaterializedViewMaintenanceTest, StagesChangingIdAreRecomputed) {
+    ASSERT(analyzePipeline(makePipeline({"{$project: {_id: 0, a: 1}}"})).kind ==
+           Kind::kRecompute);
+    ASSERT(analyzePipeline(makePipeline({"{$addFields: {_id: '$a'}}"})).kind == Kind::kRecompute);
+    ASSERT(analyzePipeline(makePipeline({"{$set: {'_id.x': 1}}"})).kind == Kind::kRecompute);
+    ASSERT(analyzePipeline(makePipeline({"{$unset: '_id'}"})).kind == Kind::kRecompute);
+}
+
+TEST(MaterializedViewMaintenanceTest, StagesChangingDocumentCountAreRecomputed) {
+    ASSERT(analyzePipeline(makePipeline({"{$unwind: '$a'}"})).kind == Kind::kRecompute);
+    ASSERT(analyzePipeline(makePipeline({"{$limit: 10}"})).kind == Kind::kRecompute);
+    ASSERT(analyzePipeline(makePipeline({"{$sort: {a: 1}}"})).kind == Kind::kRecompute);
+}
+
+TEST(MaterializedViewMaintenanceTest, FinalGroupWithMergeableAccumulatorsIsMerged) {
+    auto plan = analyzePipeline(
+        makePipeline({"{$match: {a: 1}}",
+                      "{$set: {_id: '$b'}}",
+                      "{$group: {_id: '$k', n: {$sum: 1}, lo: {$min: '$v'}, hi: {$max: '$v'}}}"}));
+    ASSERT(plan.kind == Kind::kMergeableGroup);
+    ASSERT_EQ(plan.accumulators.size(), 3U);
+    ASSERT_EQ(plan.accumulators[0].first, "n");
+    ASSERT_EQ(plan.accumulators[0].second, "$sum");
+    ASSERT_EQ(plan.accumulators[1].first, "lo");
+    ASSERT_EQ(plan.accumulators[1].second, "$min");
+    ASSERT_EQ(plan.accumulators[2].first, "hi");
+    ASSERT_EQ(plan.accumulators[2].second, "$max");
+}
+
+TEST(MaterializedViewMaintenanceTest, GroupWithoutAccumulatorsIsMerged) {
+    auto plan = analyzePipeline(makePipeline({"{$group: {_id: '$k'}}"}));
+    ASSERT(plan.kind == Kind::kMergeableGroup);
+    ASSERT(plan.accumulators.empty());
+}
+
+TEST(MaterializedViewMaintenanceTest, GroupWithNonMergeableAccumulatorIsRecomputed) {
+    auto plan = analyzePipeline(
+        makePipeline({"{$group: {_id: '$k', n: {$sum: 1}, avg: {$avg: '$v'}}}"}));
+    ASSERT(plan.kind == Kind::kRecompute);
+    ASSERT(plan.accumulators.empty());
+}
+
+TEST(MaterializedViewMaintenanceTest, GroupFollowedByOtherStagesIsRecomputed) {
+    ASSERT(analyzePipeline(makePipeline({"{$group: {_id: '$k', n: {$sum: 1}}}",
+                                         "{$match: {n: {$gt: 1}}}"}))
+               .kind == Kind::kRecompute);
+    ASSERT(analyzePipeline(makePipeline(
+                               {"{$unwind: '$a'}", "{$group: {_id: '$a', n: {$sum: 1}}}"}))
+               .kind == Kind::kRecompute);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -34,9 +34,45 @@
 #include <memory>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
 
 namespace mongo {
 
+ViewDefinition::Materialization ViewDefinition::Materialization::parse(StringData dbName,
+                                                                       const BSONObj& obj) {
+    Materialization materialization;
+    auto from = obj["from"];
+    uassert(ErrorCodes::InvalidViewDefinition,
+            str::stream() << "materialized view definition must have a string 'from': " << obj,
+            from.type() == String && !from.valueStringData().empty());
+    materialization.from = NamespaceString(dbName, from.valueStringData());
+
+    auto pipeline = obj["pipeline"];
+    uassert(ErrorCodes::InvalidViewDefinition,
+            str::stream() << "materialized view definition must have an array 'pipeline': "
+                          << obj,
+            pipeline.type() == Array);
+    for (auto&& stage : pipeline.Obj()) {
+        uassert(ErrorCodes::InvalidViewDefinition,
+                "materialized view pipeline stages must be objects",
+                stage.type() == Object);
+        materialization.pipeline.push_back(stage.Obj().getOwned());
+    }
+    return materialization;
+}
+
+BSONObj ViewDefinition::Materialization::toBSON() const {
+    BSONObjBuilder builder;
+    builder.append("from", from.coll());
+    BSONArrayBuilder pipelineBuilder(builder.subarrayStart("pipeline"));
+    for (auto&& stage : pipeline) {
+        pipelineBuilder.append(stage);
+    }
+    pipelineBuilder.doneFast();
+    return builder.obj();
+}
+
 ViewDefinition::ViewDefinition(StringData dbName,
                                StringData viewName,
                                StringData viewOnName,
@@ -52,13 +88,15 @@ ViewDefinition::ViewDefinition(const ViewDefinition& other)
     : _viewNss(other._viewNss),
       _viewOnNss(other._viewOnNss),
       _collator(CollatorInterface::cloneCollator(other._collator.get())),
-      _pipeline(other._pipeline) {}
+      _pipeline(other._pipeline),
+      _materialization(other._materialization) {}
 
 ViewDefinition& ViewDefinition::operator=(const ViewDefinition& other) {
     _viewNss = other._viewNss;
     _viewOnNss = other._viewOnNss;
     _collator = CollatorInterface::cloneCollator(other._collator.get());
     _pipeline = other._pipeline;
+    _materialization = other._materialization;
 
     return *this;
 }
@@ -68,6 +106,11 @@ bool ViewDefinition::isTimeseries() const {
     return bucketsNs == _viewOnNss;
 }
 
+void ViewDefinition::setMaterialization(boost::optional<Materialization> materialization) {
+    invariant(!materialization || materialization->from.db() == _viewNss.db());
+    _materialization = std::move(materialization);
+}
+
 void ViewDefinition::setViewOn(const NamespaceString& viewOnNss) {
     invariant(_viewNss.db() == viewOnNss.db());
     _viewOnNss = viewOnNss;
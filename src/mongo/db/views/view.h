@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <memory>
 #include <vector>
 
@@ -44,6 +45,22 @@ namespace mongo {
  */
 class ViewDefinition {
 public:
+    /**
+     * Describes how the collection backing a materialized view is computed. A materialized view
+     * is stored as a view with an empty pipeline on its backing collection, which holds the
+     * results of running 'pipeline' on the collection 'from'.
+     */
+    struct Materialization {
+        NamespaceString from;
+        std::vector<BSONObj> pipeline;
+
+        /**
+         * Parses the 'materialized' field of a view's system.views document.
+         */
+        static Materialization parse(StringData dbName, const BSONObj& obj);
+        BSONObj toBSON() const;
+    };
+
     /**
      * In the database 'dbName', create a new view 'viewName' on the view or collection
      * 'viewOnName'. Neither 'viewName' nor 'viewOnName' should include the name of the database.
@@ -95,6 +112,16 @@ public:
      */
     bool isTimeseries() const;
 
+    /**
+     * Returns the definition of the backing collection if this is a materialized view, or
+     * boost::none otherwise.
+     */
+    const boost::optional<Materialization>& materialization() const {
+        return _materialization;
+    }
+
+    void setMaterialization(boost::optional<Materialization> materialization);
+
     void setViewOn(const NamespaceString& viewOnNss);
 
     /**
@@ -107,5 +134,6 @@ private:
     NamespaceString _viewOnNss;
     std::unique_ptr<CollatorInterface> _collator;
     std::vector<BSONObj> _pipeline;
+    boost::optional<Materialization> _materialization;
 };
 }  // namespace mongo
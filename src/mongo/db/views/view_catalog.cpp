@@ -100,6 +100,7 @@ Status ViewCatalog::_reload(WithLock,
     LOGV2_DEBUG(22546, 1, "Reloading view catalog for database", "db"_attr = _durable->getName());
 
     _viewMap.clear();
+    _resolvedViews.clear();
     _valid = false;
     _viewGraphNeedsRefresh = true;
 
@@ -122,11 +123,16 @@ Status ViewCatalog::_reload(WithLock,
             }
         }
 
-        _viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(viewName.db(),
-                                                                   viewName.coll(),
-                                                                   view["viewOn"].str(),
-                                                                   pipeline,
-                                                                   std::move(collator.getValue()));
+        auto viewDef = std::make_shared<ViewDefinition>(viewName.db(),
+                                                        viewName.coll(),
+                                                        view["viewOn"].str(),
+                                                        pipeline,
+                                                        std::move(collator.getValue()));
+        if (auto materialized = view["materialized"]) {
+            viewDef->setMaterialization(
+                ViewDefinition::Materialization::parse(viewName.db(), materialized.Obj()));
+        }
+        _viewMap[viewName.ns()] = std::move(viewDef);
         return Status::OK();
     };
 
@@ -155,6 +161,7 @@ void ViewCatalog::clear() {
     stdx::unique_lock<Latch> lk(_mutex);
 
     _viewMap.clear();
+    _resolvedViews.clear();
     _viewGraph.clear();
     _valid = true;
     _viewGraphNeedsRefresh = false;
@@ -185,7 +192,9 @@ Status ViewCatalog::_createOrUpdateView(WithLock lk,
                                         const NamespaceString& viewName,
                                         const NamespaceString& viewOn,
                                         const BSONArray& pipeline,
-                                        std::unique_ptr<CollatorInterface> collator) {
+                                        std::unique_ptr<CollatorInterface> collator,
+                                        boost::optional<ViewDefinition::Materialization>
+                                            materialization) {
     invariant(opCtx->lockState()->isDbLockedForMode(viewName.db(), MODE_IX));
     invariant(opCtx->lockState()->isCollectionLockedForMode(viewName, MODE_IX));
     invariant(opCtx->lockState()->isCollectionLockedForMode(
@@ -206,10 +215,14 @@ Status ViewCatalog::_createOrUpdateView(WithLock lk,
     if (collator) {
         viewDefBuilder.append("collation", collator->getSpec().toBSON());
     }
+    if (materialization) {
+        viewDefBuilder.append("materialized", materialization->toBSON());
+    }
 
     BSONObj ownedPipeline = pipeline.getOwned();
     auto view = std::make_shared<ViewDefinition>(
         viewName.db(), viewName.coll(), viewOn.coll(), ownedPipeline, std::move(collator));
+    view->setMaterialization(std::move(materialization));
 
     // Check that the resulting dependency graph is acyclic and within the maximum depth.
     Status graphStatus = _upsertIntoGraph(lk, opCtx, *(view.get()));
@@ -229,6 +242,7 @@ Status ViewCatalog::_createOrUpdateView(WithLock lk,
         {
             stdx::lock_guard<Latch> lk(_mutex);
             this->_viewMap.erase(viewName.ns());
+            this->_resolvedViews.clear();
             this->_viewGraphNeedsRefresh = true;
         }
 
@@ -399,11 +413,58 @@ Status ViewCatalog::_validateCollation(WithLock lk,
     return Status::OK();
 }
 
+Status ViewCatalog::_validateMaterialization(
+    WithLock lk,
+    OperationContext* opCtx,
+    const NamespaceString& viewName,
+    const ViewDefinition::Materialization& materialization,
+    const CollatorInterface* collator) const {
+    if (materialization.from.db() != viewName.db())
+        return Status(ErrorCodes::BadValue,
+                      "Materialized view must be created on a collection in the same database");
+
+    if (!NamespaceString::validCollectionName(materialization.from.coll()))
+        return Status(ErrorCodes::InvalidNamespace,
+                      str::stream()
+                          << "invalid name for 'viewOn': " << materialization.from.coll());
+
+    if (materialization.from.isMaterializedViewCollection())
+        return Status(ErrorCodes::InvalidNamespace,
+                      "Materialized views cannot be defined on the backing collection of a "
+                      "materialized view");
+
+    if (_viewMap.count(materialization.from.ns()))
+        return Status(ErrorCodes::OptionNotSupportedOnView,
+                      "Materialized views must be defined on a collection, not on a view");
+
+    BSONArrayBuilder pipelineBuilder;
+    for (auto&& stage : materialization.pipeline) {
+        pipelineBuilder.append(stage);
+    }
+    const ViewDefinition definition(viewName.db(),
+                                    viewName.coll(),
+                                    materialization.from.coll(),
+                                    pipelineBuilder.arr(),
+                                    CollatorInterface::cloneCollator(collator));
+    auto involvedNamespaces = _validatePipeline(lk, opCtx, definition);
+    if (!involvedNamespaces.isOK())
+        return involvedNamespaces.getStatus();
+
+    // The backing collection is only refreshed in response to writes on 'from', so the
+    // materialized results may not depend on the contents of any other namespace.
+    if (!involvedNamespaces.getValue().empty())
+        return Status(ErrorCodes::OptionNotSupportedOnView,
+                      "The pipeline of a materialized view may not read from other namespaces");
+
+    return Status::OK();
+}
+
 Status ViewCatalog::createView(OperationContext* opCtx,
                                const NamespaceString& viewName,
                                const NamespaceString& viewOn,
                                const BSONArray& pipeline,
-                               const BSONObj& collation) {
+                               const BSONObj& collation,
+                               boost::optional<ViewDefinition::Materialization> materialization) {
     invariant(opCtx->lockState()->isDbLockedForMode(viewName.db(), MODE_IX));
     invariant(opCtx->lockState()->isCollectionLockedForMode(viewName, MODE_IX));
     invariant(opCtx->lockState()->isCollectionLockedForMode(
@@ -427,8 +488,21 @@ Status ViewCatalog::createView(OperationContext* opCtx,
     if (!collator.isOK())
         return collator.getStatus();
 
-    return _createOrUpdateView(
-        lk, opCtx, viewName, viewOn, pipeline, std::move(collator.getValue()));
+    if (materialization) {
+        auto status = _validateMaterialization(
+            lk, opCtx, viewName, *materialization, collator.getValue().get());
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    return _createOrUpdateView(lk,
+                               opCtx,
+                               viewName,
+                               viewOn,
+                               pipeline,
+                               std::move(collator.getValue()),
+                               std::move(materialization));
 }
 
 Status ViewCatalog::modifyView(OperationContext* opCtx,
@@ -455,6 +529,10 @@ Status ViewCatalog::modifyView(OperationContext* opCtx,
         return Status(ErrorCodes::InvalidNamespace,
                       str::stream() << "invalid name for 'viewOn': " << viewOn.coll());
 
+    if (viewPtr->materialization())
+        return Status(ErrorCodes::OptionNotSupportedOnView,
+                      str::stream() << "cannot modify materialized view " << viewName.ns());
+
     ViewDefinition savedDefinition = *viewPtr;
 
     opCtx->recoveryUnit()->onRollback([this, viewName, savedDefinition, opCtx]() {
@@ -462,6 +540,7 @@ Status ViewCatalog::modifyView(OperationContext* opCtx,
         {
             stdx::lock_guard<Latch> lk(_mutex);
             this->_viewMap[viewName.ns()] = std::move(definition);
+            this->_resolvedViews.clear();
         }
         auto viewRid = ResourceId(RESOURCE_COLLECTION, viewName.ns());
 
@@ -475,7 +554,8 @@ Status ViewCatalog::modifyView(OperationContext* opCtx,
                                viewName,
                                viewOn,
                                pipeline,
-                               CollatorInterface::cloneCollator(savedDefinition.defaultCollator()));
+                               CollatorInterface::cloneCollator(savedDefinition.defaultCollator()),
+                               boost::none);
 }
 
 Status ViewCatalog::dropView(OperationContext* opCtx, const NamespaceString& viewName) {
@@ -513,6 +593,7 @@ Status ViewCatalog::dropView(OperationContext* opCtx, const NamespaceString& vie
     opCtx->recoveryUnit()->onRollback([this, viewName, savedDefinition, opCtx, viewRid]() {
         this->_viewGraphNeedsRefresh = true;
         this->_viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(savedDefinition);
+        this->_resolvedViews.clear();
 
         CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
             catalog.addResource(viewRid, viewName.ns());
@@ -563,6 +644,11 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
 
     _requireValidCatalog(lock);
 
+    auto cached = _resolvedViews.find(nss.ns());
+    if (cached != _resolvedViews.end()) {
+        return cached->second;
+    }
+
     // Keep looping until the resolution completes. If the catalog is invalidated during the
     // resolution, we start over from the beginning.
     while (true) {
@@ -595,10 +681,17 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                             str::stream() << "View pipeline exceeds maximum size; maximum size is "
                                           << ViewGraph::kMaxViewPipelineSizeBytes};
                 }
-                return StatusWith<ResolvedView>(
-                    {*resolvedNss,
-                     std::move(resolvedPipeline),
-                     collation ? std::move(collation.get()) : CollationSpec::kSimpleSpec});
+                ResolvedView resolvedView{
+                    *resolvedNss,
+                    std::move(resolvedPipeline),
+                    collation ? std::move(collation.get()) : CollationSpec::kSimpleSpec};
+
+                // Only the resolutions of views are cached, so that there are no more of them than
+                // there are views.
+                if (depth > 0) {
+                    _resolvedViews.emplace(nss.ns(), resolvedView);
+                }
+                return resolvedView;
             }
 
             resolvedNss = &view->viewOn();
@@ -613,8 +706,10 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
 
             // If the first stage is a $collStats, then we return early with the viewOn namespace.
             if (toPrepend.size() > 0 && !toPrepend[0]["$collStats"].eoo()) {
-                return StatusWith<ResolvedView>(
-                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
+                ResolvedView resolvedView{
+                    *resolvedNss, std::move(resolvedPipeline), std::move(collation.get())};
+                _resolvedViews.emplace(nss.ns(), resolvedView);
+                return resolvedView;
             }
         }
 
@@ -96,13 +96,20 @@ public:
      * database's catalog, so the check for an existing collection with the same name must be done
      * before calling createView.
      *
+     * If 'materialization' is set, the view is a materialized view whose backing collection
+     * 'viewOn' holds the results of the materialization pipeline. In that case 'pipeline' is
+     * expected to be empty and the materialization must read from a collection with no other
+     * involved namespaces, so that its results depend only on the contents of that collection.
+     *
      * Must be in WriteUnitOfWork. View creation rolls back if the unit of work aborts.
      */
-    Status createView(OperationContext* opCtx,
-                      const NamespaceString& viewName,
-                      const NamespaceString& viewOn,
-                      const BSONArray& pipeline,
-                      const BSONObj& collation);
+    Status createView(
+        OperationContext* opCtx,
+        const NamespaceString& viewName,
+        const NamespaceString& viewOn,
+        const BSONArray& pipeline,
+        const BSONObj& collation,
+        boost::optional<ViewDefinition::Materialization> materialization = boost::none);
 
     /**
      * Drop the view named 'viewName'.
@@ -112,7 +119,8 @@ public:
     Status dropView(OperationContext* opCtx, const NamespaceString& viewName);
 
     /**
-     * Modify the view named 'viewName' to have the new 'viewOn' and 'pipeline'.
+     * Modify the view named 'viewName' to have the new 'viewOn' and 'pipeline'. Materialized views
+     * cannot be modified.
      *
      * Must be in WriteUnitOfWork. The modification rolls back if the unit of work aborts.
      */
@@ -138,6 +146,9 @@ public:
      * Resolve the views on 'nss', transforming the pipeline appropriately. This function returns a
      * fully-resolved view definition containing the backing namespace, the resolved pipeline and
      * the collation to use for the operation.
+     *
+     * The resolution of each view is cached until the view catalog next changes, so that queries
+     * on a view don't have to walk the chain of views it is defined on each time.
      */
     StatusWith<ResolvedView> resolveView(OperationContext* opCtx, const NamespaceString& nss);
 
@@ -168,7 +179,8 @@ private:
                                const NamespaceString& viewName,
                                const NamespaceString& viewOn,
                                const BSONArray& pipeline,
-                               std::unique_ptr<CollatorInterface> collator);
+                               std::unique_ptr<CollatorInterface> collator,
+                               boost::optional<ViewDefinition::Materialization> materialization);
     /**
      * Parses the view definition pipeline, attempts to upsert into the view graph, and refreshes
      * the graph if necessary. Returns an error status if the resulting graph would be invalid.
@@ -182,6 +194,16 @@ private:
     StatusWith<stdx::unordered_set<NamespaceString>> _validatePipeline(
         WithLock, OperationContext* opCtx, const ViewDefinition& viewDef) const;
 
+    /**
+     * Returns Status::OK if 'materialization' can define the backing collection of the
+     * materialized view 'viewName'. Otherwise, returns an error status.
+     */
+    Status _validateMaterialization(WithLock,
+                                    OperationContext* opCtx,
+                                    const NamespaceString& viewName,
+                                    const ViewDefinition::Materialization& materialization,
+                                    const CollatorInterface* collator) const;
+
     /**
      * Returns Status::OK if each view namespace in 'refs' has the same default collation as 'view'.
      * Otherwise, returns ErrorCodes::OptionNotSupportedOnView.
@@ -213,5 +235,9 @@ private:
     ViewGraph _viewGraph;
     bool _viewGraphNeedsRefresh;
     bool _ignoreExternalChange;
+
+    // The resolutions of the views of '_viewMap', by view namespace. Cleared whenever '_viewMap'
+    // changes, since a view's resolution depends on every view in its chain.
+    StringMap<ResolvedView> _resolvedViews;
 };
 }  // namespace mongo
@@ -110,11 +110,13 @@ public:
         return _viewCatalog;
     }
 
-    Status createView(OperationContext* opCtx,
-                      const NamespaceString& viewName,
-                      const NamespaceString& viewOn,
-                      const BSONArray& pipeline,
-                      const BSONObj& collation) {
+    Status createView(
+        OperationContext* opCtx,
+        const NamespaceString& viewName,
+        const NamespaceString& viewOn,
+        const BSONArray& pipeline,
+        const BSONObj& collation,
+        boost::optional<ViewDefinition::Materialization> materialization = boost::none) {
         Lock::DBLock dbLock(operationContext(), viewName.db(), MODE_IX);
         Lock::CollectionLock collLock(operationContext(), viewName, MODE_IX);
         Lock::CollectionLock sysCollLock(
@@ -123,7 +125,8 @@ public:
             MODE_X);
 
         WriteUnitOfWork wuow(opCtx);
-        Status s = _viewCatalog->createView(opCtx, viewName, viewOn, pipeline, collation);
+        Status s = _viewCatalog->createView(
+            opCtx, viewName, viewOn, pipeline, collation, std::move(materialization));
         wuow.commit();
 
         return s;
@@ -517,6 +520,87 @@ TEST_F(ViewCatalogFixture, LookupRIDExistingView) {
     ASSERT(collectionCatalog->lookupResourceName(resourceID).get() == "db.view");
 }
 
+TEST_F(ViewCatalogFixture, LookupExistingMaterializedView) {
+    const NamespaceString viewName("db.view");
+    const NamespaceString source("db.coll");
+    const auto pipeline = BSON("$match" << BSON("x" << 1));
+
+    ASSERT_OK(createView(operationContext(),
+                         viewName,
+                         viewName.makeMaterializedViewNamespace(),
+                         emptyPipeline,
+                         emptyCollation,
+                         ViewDefinition::Materialization{source, {pipeline}}));
+
+    auto view = lookup(operationContext(), "db.view"_sd);
+    ASSERT(view);
+    ASSERT_EQ(view->viewOn(), NamespaceString("db.system.materialized.view"));
+    ASSERT(view->pipeline().empty());
+    ASSERT(view->materialization());
+    ASSERT_EQ(view->materialization()->from, source);
+    ASSERT_EQ(view->materialization()->pipeline.size(), 1U);
+    ASSERT_BSONOBJ_EQ(view->materialization()->pipeline[0], pipeline);
+
+    // The definition of the backing collection survives reloading the catalog.
+    {
+        Lock::DBLock dbLock(operationContext(), viewName.db(), MODE_IS);
+        ASSERT_OK(getViewCatalog()->reload(operationContext(),
+                                           ViewCatalogLookupBehavior::kValidateDurableViews));
+    }
+    view = lookup(operationContext(), "db.view"_sd);
+    ASSERT(view && view->materialization());
+    ASSERT_EQ(view->materialization()->from, source);
+}
+
+TEST_F(ViewCatalogFixture, CannotMaterializeViewOfView) {
+    const NamespaceString viewName("db.view");
+    const NamespaceString otherView("db.other");
+
+    ASSERT_OK(createView(
+        operationContext(), otherView, NamespaceString("db.coll"), emptyPipeline, emptyCollation));
+    ASSERT_EQ(createView(operationContext(),
+                         viewName,
+                         viewName.makeMaterializedViewNamespace(),
+                         emptyPipeline,
+                         emptyCollation,
+                         ViewDefinition::Materialization{otherView, {}}),
+              ErrorCodes::OptionNotSupportedOnView);
+}
+
+TEST_F(ViewCatalogFixture, CannotMaterializePipelineReadingOtherNamespaces) {
+    const NamespaceString viewName("db.view");
+    const NamespaceString source("db.coll");
+    const auto lookupStage = BSON("$lookup" << BSON("from"
+                                                    << "other"
+                                                    << "localField"
+                                                    << "a"
+                                                    << "foreignField"
+                                                    << "b"
+                                                    << "as"
+                                                    << "c"));
+
+    ASSERT_EQ(createView(operationContext(),
+                         viewName,
+                         viewName.makeMaterializedViewNamespace(),
+                         emptyPipeline,
+                         emptyCollation,
+                         ViewDefinition::Materialization{source, {lookupStage}}),
+              ErrorCodes::OptionNotSupportedOnView);
+}
+
+TEST_F(ViewCatalogFixture, CannotModifyMaterializedView) {
+    const NamespaceString viewName("db.view");
+
+    ASSERT_OK(createView(operationContext(),
+                         viewName,
+                         viewName.makeMaterializedViewNamespace(),
+                         emptyPipeline,
+                         emptyCollation,
+                         ViewDefinition::Materialization{NamespaceString("db.coll"), {}}));
+    ASSERT_EQ(modifyView(operationContext(), viewName, NamespaceString("db.coll"), emptyPipeline),
+              ErrorCodes::OptionNotSupportedOnView);
+}
+
 TEST_F(ViewCatalogFixture, LookupRIDExistingViewRollback) {
     const NamespaceString viewName("db.view");
     const NamespaceString viewOn("db.coll");
@@ -733,5 +817,46 @@ TEST_F(ViewCatalogFixture, ResolveViewCorrectlyExtractsDefaultCollation) {
                       expectedCollation.getValue()->getSpec().toBSON());
 }
 
+TEST_F(ViewCatalogFixture, ResolveViewReflectsChangesToTheViewChain) {
+    const NamespaceString view1("db.view1");
+    const NamespaceString view2("db.view2");
+    const NamespaceString viewOn("db.coll");
+    const NamespaceString otherViewOn("db.otherColl");
+    auto pipeline1 = BSON_ARRAY(BSON("$match" << BSON("foo" << 1)));
+    auto pipeline2 = BSON_ARRAY(BSON("$match" << BSON("foo" << 2)));
+
+    ASSERT_OK(createView(operationContext(), view1, viewOn, pipeline1, emptyCollation));
+    ASSERT_OK(createView(operationContext(), view2, view1, pipeline2, emptyCollation));
+
+    auto resolve = [&](const NamespaceString& nss) {
+        Lock::DBLock dbLock(operationContext(), "db", MODE_IS);
+        return uassertStatusOK(getViewCatalog()->resolveView(operationContext(), nss));
+    };
+
+    // Resolving the view again returns the same resolution.
+    auto resolvedView = resolve(view2);
+    ASSERT_EQ(viewOn, resolvedView.getNamespace());
+    ASSERT_EQ(2U, resolvedView.getPipeline().size());
+    resolvedView = resolve(view2);
+    ASSERT_EQ(viewOn, resolvedView.getNamespace());
+    ASSERT_EQ(2U, resolvedView.getPipeline().size());
+
+    // Modifying a view further down the chain changes the resolution.
+    ASSERT_OK(modifyView(operationContext(),
+                         view1,
+                         otherViewOn,
+                         BSON_ARRAY(BSON("$limit" << 1) << BSON("$skip" << 1))));
+    resolvedView = resolve(view2);
+    ASSERT_EQ(otherViewOn, resolvedView.getNamespace());
+    ASSERT_EQ(3U, resolvedView.getPipeline().size());
+    ASSERT_BSONOBJ_EQ(BSON("$limit" << 1), resolvedView.getPipeline()[0]);
+
+    // Once the view is dropped, the namespace resolves to itself.
+    ASSERT_OK(dropView(operationContext(), view1));
+    resolvedView = resolve(view1);
+    ASSERT_EQ(view1, resolvedView.getNamespace());
+    ASSERT_EQ(0U, resolvedView.getPipeline().size());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -45,6 +45,7 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/db/storage/control/journal_flusher.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/transaction_validation.h"
@@ -314,14 +315,17 @@ Status waitForWriteConcern(OperationContext* opCtx,
                     result->fsyncFiles = 1;
                 } else {
                     // We only need to commit the journal if we're durable
+                    WaitEventTimer waitTimer(opCtx, WaitClass::kJournalFlush);
                     JournalFlusher::get(opCtx)->waitForJournalFlush();
                 }
                 break;
             }
-            case WriteConcernOptions::SyncMode::JOURNAL:
+            case WriteConcernOptions::SyncMode::JOURNAL: {
                 waitForNoOplogHolesIfNeeded(opCtx);
+                WaitEventTimer waitTimer(opCtx, WaitClass::kJournalFlush);
                 JournalFlusher::get(opCtx)->waitForJournalFlush();
                 break;
+            }
         }
     } catch (const DBException& ex) {
         return ex.toStatus();
@@ -343,8 +347,10 @@ Status waitForWriteConcern(OperationContext* opCtx,
     }
 
     // Replica set stepdowns and gle mode changes are thrown as errors
-    repl::ReplicationCoordinator::StatusAndDuration replStatus =
-        replCoord->awaitReplication(opCtx, replOpTime, writeConcernWithPopulatedSyncMode);
+    repl::ReplicationCoordinator::StatusAndDuration replStatus = [&] {
+        WaitEventTimer waitTimer(opCtx, WaitClass::kReplication);
+        return replCoord->awaitReplication(opCtx, replOpTime, writeConcernWithPopulatedSyncMode);
+    }();
     if (replStatus.status == ErrorCodes::WriteConcernFailed) {
         gleWtimeouts.increment();
         if (!writeConcern.getProvenance().isClientSupplied()) {
@@ -97,5 +97,29 @@ TEST_F(InsertTest, FixDocumentForInsertFailsOnDeeplyNestedDocuments) {
                                    makeNestedArray(BSONDepth::getMaxDepthForUserStorage() + 1)),
               ErrorCodes::Overflow);
 }
+
+TEST_F(InsertTest, FixDocumentForInsertAddsIdFirst) {
+    auto fixed = unittest::assertGet(
+        fixDocumentForInsert(getOperationContext(), BSON("a" << 1 << "b" << BSON("c" << 2))));
+    ASSERT_EQ(fixed.firstElement().fieldNameStringData(), "_id");
+    ASSERT_EQ(fixed.firstElement().type(), jstOID);
+    ASSERT_BSONOBJ_EQ(fixed.removeField("_id"), BSON("a" << 1 << "b" << BSON("c" << 2)));
+}
+
+TEST_F(InsertTest, FixDocumentForInsertMovesIdFirst) {
+    ASSERT_BSONOBJ_EQ(
+        unittest::assertGet(fixDocumentForInsert(getOperationContext(),
+                                                 BSON("a" << 1 << "_id" << 0 << "b" << 2))),
+        BSON("_id" << 0 << "a" << 1 << "b" << 2));
+    auto fixed = unittest::assertGet(
+        fixDocumentForInsert(getOperationContext(), BSON("a" << 1 << "_id" << 0)));
+    ASSERT_BSONOBJ_EQ(fixed, BSON("_id" << 0 << "a" << 1));
+}
+
+TEST_F(InsertTest, FixDocumentForInsertLeavesDocumentsWithIdFirstAlone) {
+    auto fixed = unittest::assertGet(
+        fixDocumentForInsert(getOperationContext(), BSON("_id" << 0 << "a" << 1)));
+    ASSERT_BSONOBJ_EQ(fixed, BSONObj());
+}
 }  // namespace
 }  // namespace mongo
@@ -45,8 +45,10 @@
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/util/scopeguard.h"
 
 namespace QueryStageDelete {
 
@@ -145,7 +147,9 @@ public:
         collScanParams.direction = CollectionScanParams::FORWARD;
         collScanParams.tailable = false;
 
-        // Configure the delete stage.
+        // Configure the delete stage to remove one document at a time.
+        const auto originalBatchSize = internalQueryMultiDeleteBatchSize.swap(1);
+        ON_BLOCK_EXIT([&] { internalQueryMultiDeleteBatchSize.store(originalBatchSize); });
         auto deleteStageParams = std::make_unique<DeleteStageParams>();
         deleteStageParams->isMulti = true;
 
@@ -185,6 +189,71 @@ public:
     }
 };
 
+// Delete objects in batches, and separately delete an object of the batch being gathered. We expect
+// the batch to skip over it when it is deleted.
+class QueryStageDeleteBatched : public QueryStageDeleteBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+
+        const CollectionPtr& coll = ctx.getCollection();
+        ASSERT(coll);
+
+        vector<RecordId> recordIds;
+        getRecordIds(coll, CollectionScanParams::FORWARD, &recordIds);
+
+        CollectionScanParams collScanParams;
+        collScanParams.direction = CollectionScanParams::FORWARD;
+        collScanParams.tailable = false;
+
+        const size_t batchSize = 10;
+        const auto originalBatchSize = internalQueryMultiDeleteBatchSize.swap(batchSize);
+        ON_BLOCK_EXIT([&] { internalQueryMultiDeleteBatchSize.store(originalBatchSize); });
+        auto deleteStageParams = std::make_unique<DeleteStageParams>();
+        deleteStageParams->isMulti = true;
+
+        WorkingSet ws;
+        DeleteStage deleteStage(
+            _expCtx.get(),
+            std::move(deleteStageParams),
+            &ws,
+            coll,
+            new CollectionScan(_expCtx.get(), coll, collScanParams, &ws, nullptr));
+
+        const DeleteStats* stats = static_cast<const DeleteStats*>(deleteStage.getSpecificStats());
+
+        // Nothing is deleted until a whole batch has been gathered.
+        for (size_t i = 0; i < batchSize - 1; ++i) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            ASSERT_EQUALS(PlanStage::NEED_TIME, deleteStage.work(&id));
+            ASSERT_EQUALS(0U, stats->docsDeleted);
+        }
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        ASSERT_EQUALS(PlanStage::NEED_TIME, deleteStage.work(&id));
+        ASSERT_EQUALS(batchSize, stats->docsDeleted);
+
+        // Gather part of the second batch, then remove one of its documents.
+        const size_t targetDocIndex = batchSize + 2;
+        for (size_t i = 0; i < 5; ++i) {
+            ASSERT_EQUALS(PlanStage::NEED_TIME, deleteStage.work(&id));
+        }
+        static_cast<PlanStage*>(&deleteStage)->saveState();
+        BSONObj targetDoc = coll->docFor(&_opCtx, recordIds[targetDocIndex]).value();
+        ASSERT(!targetDoc.isEmpty());
+        remove(targetDoc);
+        static_cast<PlanStage*>(&deleteStage)->restoreState(&coll);
+
+        while (!deleteStage.isEOF()) {
+            PlanStage::StageState state = deleteStage.work(&id);
+            invariant(PlanStage::NEED_TIME == state || PlanStage::IS_EOF == state);
+        }
+
+        // The last, partial batch is deleted once the scan is exhausted.
+        ASSERT_EQUALS(numObj() - 1, stats->docsDeleted);
+        ASSERT_EQUALS(0U, coll->numRecords(&_opCtx));
+    }
+};
+
 /**
  * Test that the delete stage returns an owned copy of the original document if returnDeleted is
  * specified.
@@ -260,6 +329,7 @@ public:
     void setupTests() {
         // Stage-specific tests below.
         add<QueryStageDeleteUpcomingObjectWasDeleted>();
+        add<QueryStageDeleteBatched>();
         add<QueryStageDeleteReturnOldDoc>();
     }
 };
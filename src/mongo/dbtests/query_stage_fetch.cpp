@@ -46,6 +46,7 @@
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/dbtests/dbtests.h"
 
 namespace QueryStageFetch {
@@ -226,6 +227,72 @@ public:
     }
 };
 
+//
+// Test that members taken ahead of the one being fetched are returned in their original order.
+//
+class FetchStagePrefetchWindow : public QueryStageFetchBase {
+public:
+    FetchStagePrefetchWindow() : _prefetchWindow(internalQueryFetchPrefetchWindow.load()) {
+        internalQueryFetchPrefetchWindow.store(4);
+    }
+
+    ~FetchStagePrefetchWindow() {
+        internalQueryFetchPrefetchWindow.store(_prefetchWindow);
+    }
+
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        CollectionPtr coll =
+            CollectionCatalog::get(&_opCtx)->lookupCollectionByNamespace(&_opCtx, nss());
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        WorkingSet ws;
+
+        const int numDocs = 10;
+        for (int i = 0; i < numDocs; ++i) {
+            insert(BSON("foo" << i));
+        }
+        set<RecordId> recordIds;
+        getRecordIds(&recordIds, coll);
+        ASSERT_EQUALS(size_t(numDocs), recordIds.size());
+
+        // Queue the RecordIds in reverse so that the order of the results depends on the order
+        // the child returned them rather than on the order of the collection.
+        auto mockStage = std::make_unique<QueuedDataStage>(_expCtx.get(), &ws);
+        for (auto it = recordIds.rbegin(); it != recordIds.rend(); ++it) {
+            WorkingSetID id = ws.allocate();
+            ws.get(id)->recordId = *it;
+            ws.transitionToRecordIdAndIdx(id);
+            mockStage->pushBack(id);
+        }
+
+        auto fetchStage =
+            std::make_unique<FetchStage>(_expCtx.get(), &ws, std::move(mockStage), nullptr, coll);
+
+        int expected = numDocs - 1;
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state;
+        while ((state = fetchStage->work(&id)) != PlanStage::IS_EOF) {
+            if (state != PlanStage::ADVANCED) {
+                ASSERT_EQUALS(PlanStage::NEED_TIME, state);
+                continue;
+            }
+            ASSERT_EQUALS(expected, ws.get(id)->doc.value()["foo"].getInt());
+            --expected;
+        }
+        ASSERT_EQUALS(-1, expected);
+        ASSERT_TRUE(fetchStage->isEOF());
+    }
+
+private:
+    const int _prefetchWindow;
+};
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_fetch") {}
@@ -233,6 +300,7 @@ public:
     void setupTests() {
         add<FetchStageAlreadyFetched>();
         add<FetchStageFilter>();
+        add<FetchStagePrefetchWindow>();
     }
 };
 
@@ -49,6 +49,7 @@
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/mock_yield_policies.h"
+#include "mongo/db/query/plan_cache_persistence.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_executor_impl.h"
 #include "mongo/db/query/plan_summary_stats.h"
@@ -277,6 +278,36 @@ TEST_F(QueryStageMultiPlanTest, MPSCollectionScanVsHighlySelectiveIXScan) {
     ASSERT_EQUALS(results, N / 10);
 }
 
+TEST_F(QueryStageMultiPlanTest, MPSPrunesCandidatesFarBehindTheBestCandidate) {
+    const int N = 5000;
+    for (int i = 0; i < N; ++i) {
+        insert(BSON("foo" << (i % 10)));
+    }
+
+    addIndex(BSON("foo" << 1));
+
+    const double pruneGapOldValue = internalQueryPlanEvaluationPruneGap.load();
+    const int minWorksOldValue = internalQueryPlanEvaluationMinWorksBeforePruning.load();
+    internalQueryPlanEvaluationPruneGap.store(0.5);
+    internalQueryPlanEvaluationMinWorksBeforePruning.store(20);
+    ON_BLOCK_EXIT([&] {
+        internalQueryPlanEvaluationPruneGap.store(pruneGapOldValue);
+        internalQueryPlanEvaluationMinWorksBeforePruning.store(minWorksOldValue);
+    });
+
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+
+    // The index scan produces a result for almost every work, and the collection scan for about one
+    // work in ten, so the collection scan is pruned once both have been worked 20 times.
+    auto mps = runMultiPlanner(_expCtx.get(), nss, ctx.getCollection(), 7);
+    ASSERT_FALSE(mps->candidatePruned(0));
+    ASSERT_TRUE(mps->candidatePruned(1));
+    ASSERT_EQ(1U, static_cast<const MultiPlanStats*>(mps->getSpecificStats())->candidatesPruned);
+
+    auto collScanWorks = mps->getChildren()[1]->getStats()->common.works;
+    ASSERT_LT(collScanWorks, getBestPlanWorks(mps.get()));
+}
+
 TEST_F(QueryStageMultiPlanTest, MPSDoesNotCreateActiveCacheEntryImmediately) {
     const int N = 100;
     for (int i = 0; i < N; ++i) {
@@ -360,6 +391,47 @@ TEST_F(QueryStageMultiPlanTest, MPSDoesCreatesActiveEntryWhenInactiveEntriesDisa
     ASSERT_EQ(cache->get(*cq).state, PlanCache::CacheEntryState::kPresentActive);
 }
 
+TEST_F(QueryStageMultiPlanTest, PlanCacheEntryIsRestoredFromSnapshotRecord) {
+    for (int i = 0; i < 100; ++i) {
+        insert(BSON("a" << 1 << "b" << i));
+    }
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+
+    // Run the query so that the index on 'b' wins the multi-planning and gets cached.
+    auto cursor = _client.query(nss, BSON("a" << 1 << "b" << 5));
+    while (cursor->more()) {
+        cursor->next();
+    }
+
+    boost::optional<BSONObj> record;
+    {
+        AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+        const CollectionPtr& coll = ctx.getCollection();
+        PlanCache* cache = CollectionQueryInfo::get(coll).getPlanCache();
+        auto entries = cache->getAllEntries();
+        ASSERT_EQ(entries.size(), 1U);
+        record = plan_cache_persistence::serializeEntry(nss, coll->uuid(), *entries[0]);
+        ASSERT(record);
+
+        // Restoring the record into the emptied cache re-creates the same entry.
+        cache->clear();
+        ASSERT_OK(plan_cache_persistence::restoreEntry(_opCtx.get(), coll, *record));
+        entries = cache->getAllEntries();
+        ASSERT_EQ(entries.size(), 1U);
+        ASSERT_BSONOBJ_EQ(*record,
+                          *plan_cache_persistence::serializeEntry(nss, coll->uuid(), *entries[0]));
+        cache->clear();
+    }
+
+    // Once the winning index is gone, the record can no longer be restored.
+    _client.dropIndex(nss.ns(), BSON("b" << 1));
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+    ASSERT_EQ(plan_cache_persistence::restoreEntry(_opCtx.get(), ctx.getCollection(), *record),
+              ErrorCodes::NoQueryExecutionPlans);
+    ASSERT_EQ(CollectionQueryInfo::get(ctx.getCollection()).getPlanCache()->size(), 0U);
+}
+
 // Case in which we select a blocking plan as the winner, and a non-blocking plan
 // is available as a backup.
 TEST_F(QueryStageMultiPlanTest, MPSBackupPlan) {
@@ -52,9 +52,11 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/update_request.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/update/update_driver.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/util/scopeguard.h"
 
 #define ASSERT_DOES_NOT_THROW(EXPRESSION)                                          \
     try {                                                                          \
@@ -307,7 +309,9 @@ public:
             collScanParams.direction = CollectionScanParams::FORWARD;
             collScanParams.tailable = false;
 
-            // Configure the update.
+            // Configure the update to modify one document at a time.
+            const auto originalBatchSize = internalQueryMultiUpdateBatchSize.swap(1);
+            ON_BLOCK_EXIT([&] { internalQueryMultiUpdateBatchSize.store(originalBatchSize); });
             UpdateStageParams updateParams(&request, &driver, opDebug);
             unique_ptr<CanonicalQuery> cq(canonicalize(query));
             updateParams.canonicalQuery = cq.get();
@@ -370,6 +374,165 @@ public:
     }
 };
 
+/**
+ * Test a multi-update which modifies documents in batches, with a document of the batch being
+ * gathered deleted before the batch is updated.
+ */
+class QueryStageUpdateBatched : public QueryStageUpdateBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+
+        for (int i = 0; i < 10; ++i) {
+            insert(BSON("_id" << i << "foo" << i));
+        }
+
+        CurOp& curOp = *CurOp::get(_opCtx);
+        OpDebug* opDebug = &curOp.debug();
+        UpdateDriver driver(_expCtx);
+        CollectionPtr coll =
+            CollectionCatalog::get(&_opCtx)->lookupCollectionByNamespace(&_opCtx, nss);
+        ASSERT(coll);
+
+        vector<RecordId> recordIds;
+        getRecordIds(coll, CollectionScanParams::FORWARD, &recordIds);
+
+        auto request = UpdateRequest();
+        request.setNamespaceString(nss);
+
+        BSONObj query = fromjson("{foo: {$lt: 8}}");
+        BSONObj updates = fromjson("{$set: {bar: 3}}");
+
+        request.setMulti();
+        request.setQuery(query);
+        request.setUpdateModification(
+            write_ops::UpdateModification::parseFromClassicUpdate(updates));
+
+        const std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+        const auto constants = boost::none;
+
+        ASSERT_DOES_NOT_THROW(driver.parse(
+            request.getUpdateModification(), arrayFilters, constants, request.isMulti()));
+
+        CollectionScanParams collScanParams;
+        collScanParams.direction = CollectionScanParams::FORWARD;
+        collScanParams.tailable = false;
+
+        const size_t batchSize = 3;
+        const auto originalBatchSize = internalQueryMultiUpdateBatchSize.swap(batchSize);
+        ON_BLOCK_EXIT([&] { internalQueryMultiUpdateBatchSize.store(originalBatchSize); });
+        UpdateStageParams updateParams(&request, &driver, opDebug);
+        unique_ptr<CanonicalQuery> cq(canonicalize(query));
+        updateParams.canonicalQuery = cq.get();
+
+        auto ws = make_unique<WorkingSet>();
+        auto cs = make_unique<CollectionScan>(
+            _expCtx.get(), coll, collScanParams, ws.get(), cq->root());
+
+        auto updateStage =
+            make_unique<UpdateStage>(_expCtx.get(), updateParams, ws.get(), coll, cs.release());
+
+        const UpdateStats* stats = static_cast<const UpdateStats*>(updateStage->getSpecificStats());
+
+        // Nothing is updated until a whole batch has been gathered.
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        for (size_t i = 0; i < batchSize - 1; ++i) {
+            ASSERT_EQUALS(PlanStage::NEED_TIME, updateStage->work(&id));
+            ASSERT_EQUALS(0U, stats->nModified);
+        }
+        ASSERT_EQUALS(PlanStage::NEED_TIME, updateStage->work(&id));
+        ASSERT_EQUALS(batchSize, stats->nModified);
+        ASSERT_EQUALS(batchSize, stats->nMatched);
+
+        // Gather part of the second batch, then remove one of its documents.
+        const size_t targetDocIndex = batchSize + 1;
+        for (size_t i = 0; i < 2; ++i) {
+            ASSERT_EQUALS(PlanStage::NEED_TIME, updateStage->work(&id));
+        }
+        static_cast<PlanStage*>(updateStage.get())->saveState();
+        BSONObj targetDoc = coll->docFor(&_opCtx, recordIds[targetDocIndex]).value();
+        ASSERT(!targetDoc.isEmpty());
+        remove(targetDoc);
+        static_cast<PlanStage*>(updateStage.get())->restoreState(&coll);
+
+        while (!updateStage->isEOF()) {
+            PlanStage::StageState state = updateStage->work(&id);
+            ASSERT(PlanStage::NEED_TIME == state || PlanStage::IS_EOF == state);
+        }
+
+        // 7 of the 8 matching documents should have been modified (one was deleted).
+        ASSERT_EQUALS(7U, stats->nModified);
+        ASSERT_EQUALS(7U, stats->nMatched);
+        ASSERT_EQUALS(7U, count(BSON("bar" << 3)));
+        ASSERT_EQUALS(0U, count(BSON("_id" << static_cast<int>(targetDocIndex))));
+    }
+};
+
+/**
+ * Test that when a document of a batch fails to update, the documents in front of it in the batch
+ * are still updated, as they are when each document is updated on its own.
+ */
+class QueryStageUpdateBatchedError : public QueryStageUpdateBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+
+        const int failingDocId = 5;
+        for (int i = 0; i < 10; ++i) {
+            insert(i == failingDocId ? BSON("_id" << i << "foo"
+                                                  << "string")
+                                     : BSON("_id" << i << "foo" << i));
+        }
+
+        CurOp& curOp = *CurOp::get(_opCtx);
+        OpDebug* opDebug = &curOp.debug();
+        UpdateDriver driver(_expCtx);
+        CollectionPtr coll =
+            CollectionCatalog::get(&_opCtx)->lookupCollectionByNamespace(&_opCtx, nss);
+        ASSERT(coll);
+
+        auto request = UpdateRequest();
+        request.setNamespaceString(nss);
+
+        BSONObj query = BSONObj();
+        BSONObj updates = fromjson("{$inc: {foo: 100}}");
+
+        request.setMulti();
+        request.setQuery(query);
+        request.setUpdateModification(
+            write_ops::UpdateModification::parseFromClassicUpdate(updates));
+
+        const std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+        const auto constants = boost::none;
+
+        ASSERT_DOES_NOT_THROW(driver.parse(
+            request.getUpdateModification(), arrayFilters, constants, request.isMulti()));
+
+        CollectionScanParams collScanParams;
+        collScanParams.direction = CollectionScanParams::FORWARD;
+        collScanParams.tailable = false;
+
+        const auto originalBatchSize = internalQueryMultiUpdateBatchSize.swap(4);
+        ON_BLOCK_EXIT([&] { internalQueryMultiUpdateBatchSize.store(originalBatchSize); });
+        UpdateStageParams updateParams(&request, &driver, opDebug);
+        unique_ptr<CanonicalQuery> cq(canonicalize(query));
+        updateParams.canonicalQuery = cq.get();
+
+        auto ws = make_unique<WorkingSet>();
+        auto cs = make_unique<CollectionScan>(
+            _expCtx.get(), coll, collScanParams, ws.get(), cq->root());
+
+        auto updateStage =
+            make_unique<UpdateStage>(_expCtx.get(), updateParams, ws.get(), coll, cs.release());
+
+        const UpdateStats* stats = static_cast<const UpdateStats*>(updateStage->getSpecificStats());
+
+        ASSERT_THROWS_CODE(runUpdate(updateStage.get()), DBException, ErrorCodes::TypeMismatch);
+        ASSERT_EQUALS(static_cast<size_t>(failingDocId), stats->nModified);
+        ASSERT_EQUALS(static_cast<size_t>(failingDocId), count(BSON("foo" << BSON("$gte" << 100))));
+    }
+};
+
 /**
  * Test that the update stage returns an owned copy of the original document if
  * ReturnDocOption::RETURN_OLD is specified.
@@ -564,6 +727,8 @@ public:
         // Stage-specific tests below.
         add<QueryStageUpdateUpsertEmptyColl>();
         add<QueryStageUpdateSkipDeletedDoc>();
+        add<QueryStageUpdateBatched>();
+        add<QueryStageUpdateBatchedError>();
         add<QueryStageUpdateReturnOldDoc>();
         add<QueryStageUpdateReturnNewDoc>();
     }
@@ -31,6 +31,7 @@
 
 #include <boost/optional.hpp>
 #include <iostream>
+#include <set>
 
 #include "mongo/client/dbclient_cursor.h"
 #include "mongo/db/catalog/collection.h"
@@ -1239,6 +1240,33 @@ public:
     }
 };
 
+class IdInReturnsEachMatchOnce : public ClientBase {
+public:
+    ~IdInReturnsEachMatchOnce() {
+        _client.dropCollection("unittests.querytests.IdInReturnsEachMatchOnce");
+    }
+    void run() {
+        const char* ns = "unittests.querytests.IdInReturnsEachMatchOnce";
+        for (int i = 0; i < 20; ++i) {
+            _client.insert(ns, BSON("_id" << i << "v" << i * 10));
+        }
+
+        // The batched _id lookup drops the values which compare equal and the ones with no match.
+        std::set<int> ids;
+        unique_ptr<DBClientCursor> cursor =
+            _client.query(NamespaceString(ns),
+                          fromjson("{_id: {$in: [17, 3, 3.0, 200, 'x', 9, NumberLong(17)]}}"));
+        while (cursor->more()) {
+            BSONObj o = cursor->next();
+            ASSERT_EQUALS(o["v"].numberInt(), o["_id"].numberInt() * 10);
+            ASSERT(ids.insert(o["_id"].numberInt()).second);
+        }
+        ASSERT(ids == std::set<int>({3, 9, 17}));
+        ASSERT_EQUALS(3U,
+                      _client.count(NamespaceString(ns), fromjson("{_id: {$in: [3, 9, 17, 17]}}")));
+    }
+};
+
 class EmbeddedArray : public ClientBase {
 public:
     ~EmbeddedArray() {
@@ -2045,6 +2073,7 @@ public:
         add<MatchDBRefType>();
         add<DirectLocking>();
         add<FastCountIn>();
+        add<IdInReturnsEachMatchOnce>();
         add<EmbeddedArray>();
         add<DifferentNumbers>();
         add<SymbolStringSame>();
@@ -32,13 +32,20 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #include <boost/make_shared.hpp>
 #include <fmt/format.h>
 #include <fstream>
+#include <vector>
 
+#include "mongo/logv2/attributes.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log_detail.h"
 #include "mongo/logv2/shared_access_fstream.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/string_map.h"
 
 
@@ -68,16 +75,173 @@ StatusWith<boost::shared_ptr<stream_t>> openFile(const std::string& filename, bo
 }  // namespace
 
 struct FileRotateSink::Impl {
-    Impl(LogTimestampFormat tsFormat) : timestampFormat(tsFormat) {}
+    Impl(LogTimestampFormat tsFormat, size_t asyncBufferSize)
+        : timestampFormat(tsFormat), asyncBufferSizeBytes(asyncBufferSize) {}
+
+    bool isAsync() const {
+        return asyncBufferSizeBytes > 0;
+    }
+
+    // Aborts the application if writing to any of the files failed.
+    void checkForFailedFiles();
+
+    // Writes the lines queued so far to the files. The caller must hold 'streamMutex'.
+    void writeQueued(const stdx::lock_guard<stdx::mutex>&);
+
+    void writerLoop();
+
     StringMap<boost::shared_ptr<stream_t>> files;
     LogTimestampFormat timestampFormat;
+    const size_t asyncBufferSizeBytes;
+
+    // When writing asynchronously, serializes the writes to 'files' and their changes. It is
+    // acquired before 'queueMutex'.
+    stdx::mutex streamMutex;  // NOLINT
+
+    // Protects the members below.
+    mutable stdx::mutex queueMutex;  // NOLINT
+    stdx::condition_variable queueChanged;
+    std::vector<std::string> queue;
+    size_t queuedBytes = 0;
+    long long droppedSinceReported = 0;
+    long long totalDropped = 0;
+    bool inShutdown = false;
+
+    stdx::thread writer;
 };
 
-FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat)
-    : _impl(std::make_unique<Impl>(timestampFormat)) {}
-FileRotateSink::~FileRotateSink() {}
+void FileRotateSink::Impl::checkForFailedFiles() {
+    auto isFailed = [](const auto& file) { return file.second->fail(); };
+    if (std::any_of(files.begin(), files.end(), isFailed)) {
+        try {
+            auto failedBegin = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+            auto failedEnd = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+
+            auto getFilename = [](const auto& file) -> const auto& {
+                return file.first;
+            };
+            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
+            auto end = boost::make_transform_iterator(failedEnd, getFilename);
+            auto sequence = logv2::seqLog(begin, end);
+
+            DynamicAttributes attrs;
+            attrs.add("files", sequence);
+
+            fmt::memory_buffer buffer;
+            JSONFormatter(nullptr, timestampFormat)
+                .format(buffer,
+                        LogSeverity::Severe(),
+                        LogComponent::kControl,
+                        Date_t::now(),
+                        4522200,
+                        getThreadName(),
+                        "Writing to log file failed, aborting application",
+                        TypeErasedAttributeStorage(attrs),
+                        LogTag::kNone,
+                        LogTruncation::Disabled);
+            // Commented out log line below to get validation of the log id with the errorcodes
+            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
+            std::cout << StringData(buffer.data(), buffer.size()) << std::endl;
+        } catch (...) {
+            // If the formatting code throws for any reason, ignore and proceed with aborting the
+            // application.
+        }
+
+        std::abort();
+    }
+}
+
+void FileRotateSink::Impl::writeQueued(const stdx::lock_guard<stdx::mutex>&) {
+    std::vector<std::string> lines;
+    long long dropped;
+    long long total;
+    {
+        stdx::lock_guard<stdx::mutex> lk(queueMutex);
+        lines.swap(queue);
+        queuedBytes = 0;
+        dropped = std::exchange(droppedSinceReported, 0);
+        total = totalDropped;
+    }
+
+    if (dropped > 0) {
+        // The lines were dropped after those still queued, so they are reported after them.
+        DynamicAttributes attrs;
+        attrs.add("dropped", dropped);
+        attrs.add("totalDropped", total);
+
+        fmt::memory_buffer buffer;
+        JSONFormatter(nullptr, timestampFormat)
+            .format(buffer,
+                    LogSeverity::Warning(),
+                    LogComponent::kControl,
+                    Date_t::now(),
+                    5843222,
+                    getThreadName(),
+                    "Dropped log lines because the asynchronous log buffer was full",
+                    TypeErasedAttributeStorage(attrs),
+                    LogTag::kNone,
+                    LogTruncation::Disabled);
+        // Commented out log line below to get validation of the log id with the errorcodes
+        // linter LOGV2(5843222, "Dropped log lines because the asynchronous log buffer was full");
+        lines.push_back(fmt::to_string(buffer));
+    }
+
+    if (lines.empty()) {
+        return;
+    }
+
+    for (auto& file : files) {
+        for (const auto& line : lines) {
+            file.second->write(line.data(), line.size());
+            file.second->put('\n');
+        }
+        file.second->flush();
+    }
+    checkForFailedFiles();
+}
+
+void FileRotateSink::Impl::writerLoop() {
+    setThreadName("LogWriter");
+
+    while (true) {
+        {
+            stdx::unique_lock<stdx::mutex> lk(queueMutex);
+            queueChanged.wait(lk, [&] {
+                return inShutdown || !queue.empty() || droppedSinceReported > 0;
+            });
+            if (inShutdown) {
+                return;
+            }
+        }
+
+        stdx::lock_guard<stdx::mutex> streamLock(streamMutex);
+        writeQueued(streamLock);
+    }
+}
+
+FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat, size_t asyncBufferSizeBytes)
+    : _impl(std::make_unique<Impl>(timestampFormat, asyncBufferSizeBytes)) {
+    if (_impl->isAsync()) {
+        _impl->writer = stdx::thread([impl = _impl.get()] { impl->writerLoop(); });
+    }
+}
+
+FileRotateSink::~FileRotateSink() {
+    if (_impl->isAsync()) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_impl->queueMutex);
+            _impl->inShutdown = true;
+        }
+        _impl->queueChanged.notify_one();
+        _impl->writer.join();
+
+        stdx::lock_guard<stdx::mutex> streamLock(_impl->streamMutex);
+        _impl->writeQueued(streamLock);
+    }
+}
 
 Status FileRotateSink::addFile(const std::string& filename, bool append) {
+    stdx::lock_guard<stdx::mutex> streamLock(_impl->streamMutex);
     auto statusWithFile = openFile(filename, append);
     if (statusWithFile.isOK()) {
         add_stream(statusWithFile.getValue());
@@ -87,6 +251,8 @@ Status FileRotateSink::addFile(const std::string& filename, bool append) {
     return statusWithFile.getStatus().withContext("Can't initialize rotatable log file");
 }
 void FileRotateSink::removeFile(const std::string& filename) {
+    stdx::lock_guard<stdx::mutex> streamLock(_impl->streamMutex);
+    _impl->writeQueued(streamLock);
     auto it = _impl->files.find(filename);
     if (it != _impl->files.cend()) {
         remove_stream(it->second);
@@ -95,6 +261,10 @@ void FileRotateSink::removeFile(const std::string& filename) {
 }
 
 Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
+    // The lines logged before the rotation belong to the old file.
+    stdx::lock_guard<stdx::mutex> streamLock(_impl->streamMutex);
+    _impl->writeQueued(streamLock);
+
     for (auto& file : _impl->files) {
         const std::string& filename = file.first;
         if (rename) {
@@ -140,47 +310,47 @@ Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
 
 void FileRotateSink::consume(const boost::log::record_view& rec,
                              const string_type& formatted_string) {
-    auto isFailed = [](const auto& file) { return file.second->fail(); };
-    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
-    if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed)) {
-        try {
-            auto failedBegin =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-            auto failedEnd =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-
-            auto getFilename = [](const auto& file) -> const auto& {
-                return file.first;
-            };
-            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
-            auto end = boost::make_transform_iterator(failedEnd, getFilename);
-            auto sequence = logv2::seqLog(begin, end);
-
-            DynamicAttributes attrs;
-            attrs.add("files", sequence);
+    if (!_impl->isAsync()) {
+        boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+        _impl->checkForFailedFiles();
+        return;
+    }
 
-            fmt::memory_buffer buffer;
-            JSONFormatter(nullptr, _impl->timestampFormat)
-                .format(buffer,
-                        LogSeverity::Severe(),
-                        LogComponent::kControl,
-                        Date_t::now(),
-                        4522200,
-                        getThreadName(),
-                        "Writing to log file failed, aborting application",
-                        TypeErasedAttributeStorage(attrs),
-                        LogTag::kNone,
-                        LogTruncation::Disabled);
-            // Commented out log line below to get validation of the log id with the errorcodes
-            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
-            std::cout << StringData(buffer.data(), buffer.size()) << std::endl;
-        } catch (...) {
-            // If the formatting code throws for any reason, ignore and proceed with aborting the
-            // application.
+    auto severity = boost::log::extract<LogSeverity>(attributes::severity(), rec);
+    if (severity && severity.get() >= LogSeverity::Error()) {
+        // Errors, and the fatal messages which precede an abort, must reach the file before the
+        // logging thread moves on.
+        stdx::lock_guard<stdx::mutex> streamLock(_impl->streamMutex);
+        {
+            stdx::lock_guard<stdx::mutex> lk(_impl->queueMutex);
+            _impl->queue.push_back(formatted_string);
         }
+        _impl->writeQueued(streamLock);
+        return;
+    }
 
-        std::abort();
+    {
+        stdx::lock_guard<stdx::mutex> lk(_impl->queueMutex);
+        if (_impl->queuedBytes + formatted_string.size() > _impl->asyncBufferSizeBytes) {
+            ++_impl->droppedSinceReported;
+            ++_impl->totalDropped;
+            return;
+        }
+        _impl->queuedBytes += formatted_string.size();
+        _impl->queue.push_back(formatted_string);
     }
+    _impl->queueChanged.notify_one();
+}
+
+void FileRotateSink::flush() {
+    stdx::lock_guard<stdx::mutex> streamLock(_impl->streamMutex);
+    _impl->writeQueued(streamLock);
+    boost::log::sinks::text_ostream_backend::flush();
+}
+
+long long FileRotateSink::droppedLines() const {
+    stdx::lock_guard<stdx::mutex> lk(_impl->queueMutex);
+    return _impl->totalDropped;
 }
 
 }  // namespace mongo::logv2
@@ -40,9 +40,15 @@ namespace mongo::logv2 {
 // boost::log backend sink to provide MongoDB style file rotation.
 // Uses custom stream type to open log files with shared access on Windows, somthing the built-in
 // boost file rotation sink does not do.
+//
+// With a non-zero 'asyncBufferSizeBytes', the lines formatted by the logging threads are queued
+// and written to the files by a background thread, so that the logging threads don't wait on file
+// I/O. Lines which would grow the queue beyond 'asyncBufferSizeBytes' are dropped and counted, and
+// the number of dropped lines is reported in the log. Lines of severity Error or above are never
+// dropped: they are written synchronously, after the lines queued before them.
 class FileRotateSink : public boost::log::sinks::text_ostream_backend {
 public:
-    FileRotateSink(LogTimestampFormat timestampFormat);
+    FileRotateSink(LogTimestampFormat timestampFormat, size_t asyncBufferSizeBytes = 0);
     ~FileRotateSink();
 
     Status addFile(const std::string& filename, bool append);
@@ -52,6 +58,12 @@ public:
 
     void consume(const boost::log::record_view& rec, const string_type& formatted_string);
 
+    // Writes out the queued lines, and flushes the files.
+    void flush();
+
+    // Returns the number of lines dropped because the queue was full.
+    long long droppedLines() const;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> _impl;
@@ -50,6 +50,8 @@ public:
         int syslogFacility{-1};  // invalid facility by default, must be set
         LogFormat format{LogFormat::kDefault};
         const AtomicWord<int32_t>* maxAttributeSizeKB = nullptr;
+        // Zero writes to the log file on the logging thread, see FileRotateSink.
+        size_t fileAsyncBufferSizeBytes{0};
 
         void makeDisabled();
     };
@@ -62,6 +64,9 @@ public:
     Status configure(ConfigurationOptions const& options);
     Status rotate(bool rename, StringData renameSuffix);
 
+    // Writes out the log lines which are still queued for the log file.
+    void flush();
+
     const ConfigurationOptions& config() const;
 
     LogComponentSettings& settings();
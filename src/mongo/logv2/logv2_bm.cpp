@@ -36,6 +36,7 @@
 #include "mongo/platform/basic.h"
 
 #include <benchmark/benchmark.h>
+#include <boost/filesystem/operations.hpp>
 #include <boost/iostreams/device/null.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/log/sinks/sync_frontend.hpp>
@@ -97,6 +98,38 @@ private:
     bool _shouldInit;
 };
 
+// RAII style helper class logging to a file, written asynchronously when the benchmark's argument,
+// a buffer size in KB, is non-zero.
+class ScopedFileLogV2Bench {
+public:
+    ScopedFileLogV2Bench(benchmark::State& state) {
+        _shouldInit = state.thread_index == 0;
+        if (_shouldInit) {
+            _path = boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("logv2_bm-%%%%-%%%%-%%%%-%%%%.log");
+
+            logv2::LogDomainGlobal::ConfigurationOptions config;
+            config.consoleEnabled = false;
+            config.fileEnabled = true;
+            config.filePath = _path.string();
+            config.fileAsyncBufferSizeBytes = state.range(0) * 1024;
+            invariant(
+                logv2::LogManager::global().getGlobalDomainInternal().configure(config).isOK());
+        }
+    }
+
+    ~ScopedFileLogV2Bench() {
+        if (_shouldInit) {
+            invariant(logv2::LogManager::global().getGlobalDomainInternal().configure({}).isOK());
+            boost::filesystem::remove(_path);
+        }
+    }
+
+private:
+    boost::filesystem::path _path;
+    bool _shouldInit;
+};
+
 // "Expensive" way to create a string.
 std::string createLongString() {
     return std::string(1000, 'a') + std::string(1000, 'b') + std::string(1000, 'c') +
@@ -150,6 +183,20 @@ void BM_EnabledLogV2ManySmallArg(benchmark::State& state) {
     }
 }
 
+void BM_FileLogV2ManySmallArg(benchmark::State& state) {
+    ScopedFileLogV2Bench init(state);
+
+    for (auto _ : state) {
+        LOGV2(5843223,
+              "file log {}{}{}{}{}",
+              "1"_attr = 1,
+              "2"_attr = "2",
+              "3"_attr = 3.0,
+              "4"_attr = "4"_sd,
+              "5"_attr = 5);
+    }
+}
+
 void ThreadCounts(benchmark::internal::Benchmark* b) {
     int tc[] = {1, 2, 4, 8};
     for (int t : tc)
@@ -161,6 +208,7 @@ BENCHMARK(BM_NoopLogV2Arg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ExpensiveArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ManySmallArg)->Apply(ThreadCounts);
+BENCHMARK(BM_FileLogV2ManySmallArg)->Arg(0)->Arg(1024)->Apply(ThreadCounts);
 
 }  // namespace
 }  // namespace mongo
@@ -323,14 +323,14 @@ void enableClientChecksum() {
     failPoint->setMode(FailPoint::off);
 }
 
-void exhaustGetMoreTest(bool enableChecksum) {
+void exhaustGetMoreTest(bool enableChecksum, bool useAggregate = false) {
     std::string errMsg;
     auto conn = std::unique_ptr<DBClientBase>(
         unittest::getFixtureConnectionString().connect("integration_test", errMsg));
     uassert(ErrorCodes::SocketException, errMsg, conn);
 
-    // Only test exhaust against a standalone.
-    if (conn->isReplicaSetMember() || conn->isMongos()) {
+    // Only test exhaust against a standalone and mongos.
+    if (conn->isReplicaSetMember()) {
         return;
     }
 
@@ -349,10 +349,14 @@ void exhaustGetMoreTest(bool enableChecksum) {
         conn->insert(nss.toString(), BSON("_id" << i));
     }
 
-    // Issue a find request to open a cursor but return 0 documents. Specify a sort in order to
-    // guarantee their return order.
-    auto findCmd = BSON("find" << nss.coll() << "batchSize" << 0 << "sort" << BSON("_id" << 1));
-    auto opMsgRequest = OpMsgRequest::fromDBAndBody(nss.db(), findCmd);
+    // Issue a find or aggregate request to open a cursor but return 0 documents. Specify a sort in
+    // order to guarantee their return order.
+    auto cursorCmd = useAggregate
+        ? BSON("aggregate" << nss.coll() << "pipeline"
+                           << BSON_ARRAY(BSON("$sort" << BSON("_id" << 1))) << "cursor"
+                           << BSON("batchSize" << 0))
+        : BSON("find" << nss.coll() << "batchSize" << 0 << "sort" << BSON("_id" << 1));
+    auto opMsgRequest = OpMsgRequest::fromDBAndBody(nss.db(), cursorCmd);
     auto request = opMsgRequest.serialize();
 
     Message reply;
@@ -418,6 +422,10 @@ TEST(OpMsg, ServerHandlesExhaustGetMoreCorrectlyWithChecksum) {
     exhaustGetMoreTest(true);
 }
 
+TEST(OpMsg, ServerHandlesExhaustGetMoreOnAggregateCursorCorrectly) {
+    exhaustGetMoreTest(false, true /* useAggregate */);
+}
+
 TEST(OpMsg, FindIgnoresExhaust) {
     std::string errMsg;
     auto conn = std::unique_ptr<DBClientBase>(
@@ -503,58 +511,6 @@ TEST(OpMsg, ServerDoesNotSetMoreToComeOnErrorInGetMore) {
     ASSERT_NOT_OK(getStatusFromCommandResult(res));
 }
 
-TEST(OpMsg, MongosIgnoresExhaustForGetMore) {
-    std::string errMsg;
-    auto conn = std::unique_ptr<DBClientBase>(
-        unittest::getFixtureConnectionString().connect("integration_test", errMsg));
-    uassert(ErrorCodes::SocketException, errMsg, conn);
-
-    if (!conn->isMongos()) {
-        return;
-    }
-
-    NamespaceString nss("test", "coll");
-
-    conn->dropCollection(nss.toString());
-
-    // Insert a few documents.
-    for (int i = 0; i < 5; i++) {
-        conn->insert(nss.toString(), BSON("_id" << i));
-    }
-
-    // Issue a find request to open a cursor but return 0 documents. Specify a sort in order to
-    // guarantee their return order.
-    auto findCmd = BSON("find" << nss.coll() << "batchSize" << 0 << "sort" << BSON("_id" << 1));
-    auto opMsgRequest = OpMsgRequest::fromDBAndBody(nss.db(), findCmd);
-    auto request = opMsgRequest.serialize();
-
-    Message reply;
-    ASSERT(conn->call(request, reply));
-    auto res = OpMsg::parse(reply).body;
-    const long long cursorId = res["cursor"]["id"].numberLong();
-    ASSERT(res["cursor"]["firstBatch"].Array().empty());
-    ASSERT(!OpMsg::isFlagSet(reply, OpMsg::kMoreToCome));
-
-    // Construct getMore request with exhaust flag.
-    int batchSize = 2;
-    GetMoreRequest gmr(nss, cursorId, batchSize, boost::none, boost::none, boost::none);
-    opMsgRequest = OpMsgRequest::fromDBAndBody(nss.db(), gmr.toBSON());
-    request = opMsgRequest.serialize();
-    OpMsg::setFlag(&request, OpMsg::kExhaustSupported);
-
-    // Run getMore. This should not start an exhaust stream.
-    ASSERT(conn->call(request, reply));
-    // The response should not have set moreToCome.
-    ASSERT(!OpMsg::isFlagSet(reply, OpMsg::kMoreToCome));
-    res = OpMsg::parse(reply).body;
-    ASSERT_OK(getStatusFromCommandResult(res));
-    ASSERT_EQ(res["cursor"]["id"].numberLong(), cursorId);
-    std::vector<BSONElement> nextBatch = res["cursor"]["nextBatch"].Array();
-    ASSERT_EQ(nextBatch.size(), 2U);
-    ASSERT_BSONOBJ_EQ(nextBatch[0].embeddedObject(), BSON("_id" << 0));
-    ASSERT_BSONOBJ_EQ(nextBatch[1].embeddedObject(), BSON("_id" << 1));
-}
-
 TEST(OpMsg, ServerHandlesExhaustIsMasterCorrectly) {
     std::string errMsg;
     auto fixtureConn = std::unique_ptr<DBClientBase>(
@@ -359,6 +359,25 @@ void CatalogCache::purgeAllDatabases() {
     _collectionCache.invalidateAll();
 }
 
+void CatalogCache::invalidateDatabasesForIncrementalRefresh(boost::optional<StringData> dbName) {
+    if (dbName) {
+        _databaseCache.invalidate(*dbName);
+    } else {
+        _databaseCache.invalidateAll();
+    }
+
+    for (const auto& cachedItem : _collectionCache.getCacheInfo()) {
+        if (!dbName || cachedItem.key.db() == *dbName) {
+            invalidateCollectionEntryForIncrementalRefresh(cachedItem.key);
+        }
+    }
+}
+
+void CatalogCache::invalidateCollectionEntryForIncrementalRefresh(const NamespaceString& nss) {
+    _collectionCache.advanceTimeInStore(
+        nss, ComparableChunkVersion::makeComparableChunkVersionForForcedRefresh());
+}
+
 void CatalogCache::report(BSONObjBuilder* builder) const {
     BSONObjBuilder cacheStatsBuilder(builder->subobjStart("catalogCache"));
 
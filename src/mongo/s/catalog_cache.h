@@ -268,6 +268,22 @@ public:
      */
     void purgeAllDatabases();
 
+    /**
+     * Non-blocking method, which removes the specified database, or all databases if 'dbName' is
+     * not specified, from the cache, but only marks the routing tables of their collections as
+     * needing refresh rather than removing them. Unlike after purgeDatabase and purgeAllDatabases,
+     * the next access to each collection refreshes incrementally, fetching only the chunks which
+     * changed since its cached collection version instead of its entire routing table.
+     */
+    void invalidateDatabasesForIncrementalRefresh(boost::optional<StringData> dbName);
+
+    /**
+     * Non-blocking method, which marks the routing table of the specified collection as needing
+     * refresh without removing it, so that the next access to the collection refreshes
+     * incrementally.
+     */
+    void invalidateCollectionEntryForIncrementalRefresh(const NamespaceString& nss);
+
     /**
      * Reports statistics about the catalog cache to be used by serverStatus
      */
@@ -270,6 +270,26 @@ TEST_F(CatalogCacheTest, OnStaleShardVersionWithGraterVersion) {
     ASSERT(status == ErrorCodes::InternalError);
 }
 
+TEST_F(CatalogCacheTest, InvalidateDatabasesForIncrementalRefresh) {
+    const auto dbVersion = DatabaseVersion(UUID::gen(), 1);
+    const auto collVersion = ChunkVersion(1, 0, OID::gen());
+    const DatabaseType db(kNss.db().toString(), kShards[0], true, dbVersion);
+
+    loadDatabases({db});
+    loadCollection(collVersion);
+    _catalogCache->invalidateDatabasesForIncrementalRefresh(boost::none);
+
+    // The database entry must be reloaded and the collection refreshed from its cached version.
+    loadDatabases({db});
+    loadCollection(collVersion);
+
+    BSONObjBuilder builder;
+    _catalogCache->report(&builder);
+    const auto stats = builder.obj()["catalogCache"].Obj();
+    ASSERT_EQ(1, stats["countFullRefreshesStarted"].numberLong());
+    ASSERT_EQ(1, stats["countIncrementalRefreshesStarted"].numberLong());
+}
+
 TEST_F(CatalogCacheTest, CheckEpochNoDatabase) {
     const auto collVersion = ChunkVersion(1, 0, OID::gen());
     ASSERT_THROWS_WITH_CHECK(_catalogCache->checkEpochOrThrow(kNss, collVersion, kShards[0]),
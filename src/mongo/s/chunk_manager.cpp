@@ -33,6 +33,8 @@
 
 #include "mongo/s/chunk_manager.h"
 
+#include <numeric>
+
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
@@ -113,56 +115,38 @@ std::vector<std::shared_ptr<ChunkInfo>> flatten(const std::vector<ChunkType>& ch
 
 }  // namespace
 
+ChunkMap::ChunkMap(OID epoch) : ChunkMap(epoch, gRoutingTableCacheChunkBucketSize) {}
+
 ShardVersionMap ChunkMap::constructShardVersionMap() const {
     ShardVersionMap shardVersions;
-    ChunkVector::const_iterator current = _chunkMap.cbegin();
 
     boost::optional<BSONObj> firstMin = boost::none;
     boost::optional<BSONObj> lastMax = boost::none;
 
-    while (current != _chunkMap.cend()) {
-        const auto& firstChunkInRange = *current;
-        const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
-
-        // Tracks the max shard version for the shard on which the current range will reside
-        auto shardVersionIt = shardVersions.find(currentRangeShardId);
-        if (shardVersionIt == shardVersions.end()) {
-            shardVersionIt =
-                shardVersions.emplace(currentRangeShardId, _collectionVersion.epoch()).first;
-        }
-
-        auto& maxShardVersion = shardVersionIt->second.shardVersion;
-
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId, &maxShardVersion](const auto& currentChunk) {
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
-
-                             if (currentChunk->getLastmod() > maxShardVersion)
-                                 maxShardVersion = currentChunk->getLastmod();
-
-                             return false;
-                         });
-
-        const auto rangeLast = *std::prev(current);
+    // The current range of consecutive chunks which reside on the same shard, and the max shard
+    // version of that shard.
+    const ChunkInfo* firstChunkInRange = nullptr;
+    const ChunkInfo* lastChunkInRange = nullptr;
+    ChunkVersion* maxShardVersion = nullptr;
 
+    auto processRange = [&] {
         const auto& rangeMin = firstChunkInRange->getMin();
-        const auto& rangeMax = rangeLast->getMax();
+        const auto& rangeMax = lastChunkInRange->getMax();
 
         // Check the continuity of the chunks map
         if (lastMax && !SimpleBSONObjComparator::kInstance.evaluate(*lastMax == rangeMin)) {
             if (SimpleBSONObjComparator::kInstance.evaluate(*lastMax < rangeMin))
                 uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Gap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
+                          str::stream()
+                              << "Gap exists in the routing table between chunks "
+                              << findIntersectingChunk(*lastMax)->getRange().toString() << " and "
+                              << lastChunkInRange->getRange().toString());
             else
                 uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Overlap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
+                          str::stream()
+                              << "Overlap exists in the routing table between chunks "
+                              << findIntersectingChunk(*lastMax)->getRange().toString() << " and "
+                              << lastChunkInRange->getRange().toString());
         }
 
         if (!firstMin)
@@ -172,10 +156,34 @@ ShardVersionMap ChunkMap::constructShardVersionMap() const {
 
         // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
         // somewhere, which should have been caught at chunk load time
-        invariant(maxShardVersion.isSet());
-    }
+        invariant(maxShardVersion->isSet());
+    };
+
+    forEach([&](const std::shared_ptr<ChunkInfo>& chunk) {
+        const auto& shardId = chunk->getShardIdAt(boost::none);
+        if (!firstChunkInRange || firstChunkInRange->getShardIdAt(boost::none) != shardId) {
+            if (firstChunkInRange)
+                processRange();
+
+            // Tracks the max shard version for the shard on which the current range will reside
+            auto shardVersionIt = shardVersions.find(shardId);
+            if (shardVersionIt == shardVersions.end()) {
+                shardVersionIt = shardVersions.emplace(shardId, _collectionVersion.epoch()).first;
+            }
+            maxShardVersion = &shardVersionIt->second.shardVersion;
+            firstChunkInRange = chunk.get();
+        }
+
+        if (chunk->getLastmod() > *maxShardVersion)
+            *maxShardVersion = chunk->getLastmod();
+
+        lastChunkInRange = chunk.get();
+        return true;
+    });
+
+    if (firstChunkInRange) {
+        processRange();
 
-    if (!_chunkMap.empty()) {
         invariant(!shardVersions.empty());
         invariant(firstMin.is_initialized());
         invariant(lastMax.is_initialized());
@@ -187,19 +195,64 @@ ShardVersionMap ChunkMap::constructShardVersionMap() const {
     return shardVersions;
 }
 
-void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
-    appendChunkTo(_chunkMap, chunk);
+std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
+    const auto pos = _findIntersectingChunk(shardKey);
 
-    _collectionVersion = std::max(_collectionVersion, chunk->getLastmod());
+    if (pos.first != _chunkVectors.end())
+        return *pos.second;
+
+    return std::shared_ptr<ChunkInfo>();
 }
 
-std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
-    const auto it = _findIntersectingChunk(shardKey);
+std::vector<std::shared_ptr<ChunkInfo>> ChunkMap::findIntersectingChunks(
+    const std::vector<BSONObj>& shardKeys) const {
+    std::vector<std::string> shardKeyStrings;
+    shardKeyStrings.reserve(shardKeys.size());
+    for (const auto& shardKey : shardKeys) {
+        shardKeyStrings.push_back(ShardKeyPattern::toKeyString(shardKey));
+    }
 
-    if (it != _chunkMap.end())
-        return *it;
+    std::vector<size_t> keyOrder(shardKeys.size());
+    std::iota(keyOrder.begin(), keyOrder.end(), 0);
+    std::sort(keyOrder.begin(), keyOrder.end(), [&](size_t a, size_t b) {
+        return shardKeyStrings[a] < shardKeyStrings[b];
+    });
 
-    return std::shared_ptr<ChunkInfo>();
+    // Since the keys are visited in ascending order, the search for each key resumes from the
+    // chunk found for the previous one.
+    std::vector<std::shared_ptr<ChunkInfo>> chunks(shardKeys.size());
+    if (_chunkVectors.empty())
+        return chunks;
+
+    auto vectorIt = _chunkVectors.begin();
+    auto chunkIt = (*vectorIt)->begin();
+    for (auto i : keyOrder) {
+        const auto& shardKeyString = shardKeyStrings[i];
+        if (shardKeyString >= (*vectorIt)->back()->getMaxKeyString()) {
+            vectorIt = std::upper_bound(std::next(vectorIt),
+                                        _chunkVectors.end(),
+                                        shardKeyString,
+                                        [](const std::string& keyString, const auto& chunkVector) {
+                                            return keyString <
+                                                chunkVector->back()->getMaxKeyString();
+                                        });
+            if (vectorIt == _chunkVectors.end())
+                break;
+            chunkIt = (*vectorIt)->begin();
+        }
+
+        if (shardKeyString >= (*chunkIt)->getMaxKeyString()) {
+            chunkIt = std::upper_bound(std::next(chunkIt),
+                                       (*vectorIt)->end(),
+                                       shardKeyString,
+                                       [](const std::string& keyString, const auto& chunkInfo) {
+                                           return keyString < chunkInfo->getMaxKeyString();
+                                       });
+        }
+        chunks[i] = *chunkIt;
+    }
+
+    return chunks;
 }
 
 void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion& version) {
@@ -213,40 +266,86 @@ void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion&
 
 ChunkMap ChunkMap::createMerged(
     const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const {
-    size_t chunkMapIndex = 0;
     size_t changedChunkIndex = 0;
 
-    ChunkMap updatedChunkMap(getVersion().epoch(), _chunkMap.size() + changedChunks.size());
+    ChunkMap updatedChunkMap(getVersion().epoch(), _maxChunkVectorSize);
+    updatedChunkMap._collectionVersion = _collectionVersion;
 
-    while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
-        if (chunkMapIndex >= _chunkMap.size()) {
-            validateChunk(changedChunks[changedChunkIndex], getVersion());
-            updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
-            continue;
+    // The chunks gathered for the next ChunkVector of the updated map.
+    auto pendingChunks = std::make_shared<ChunkVector>();
+
+    auto flushPendingChunks = [&] {
+        if (pendingChunks->empty())
+            return;
+        updatedChunkMap._size += pendingChunks->size();
+        updatedChunkMap._chunkVectors.push_back(std::move(pendingChunks));
+        pendingChunks = std::make_shared<ChunkVector>();
+    };
+
+    auto appendChunk = [&](const std::shared_ptr<ChunkInfo>& chunk) {
+        // Of two overlapping chunks, only the most recent one is kept.
+        if (!pendingChunks->empty() &&
+            chunk->getRange().overlaps(pendingChunks->back()->getRange())) {
+            if (chunk->getLastmod() > pendingChunks->back()->getLastmod())
+                pendingChunks->back() = chunk;
+            return;
         }
 
-        if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+        if (pendingChunks->size() >= _maxChunkVectorSize)
+            flushPendingChunks();
+        if (pendingChunks->empty())
+            pendingChunks->reserve(_maxChunkVectorSize);
+
+        pendingChunks->push_back(chunk);
+        updatedChunkMap._collectionVersion =
+            std::max(updatedChunkMap._collectionVersion, chunk->getLastmod());
+    };
+
+    for (const auto& chunkVector : _chunkVectors) {
+        const ChunkRange chunkVectorRange(chunkVector->front()->getMin(),
+                                          chunkVector->back()->getMax());
+        const bool isChanged = (changedChunkIndex < changedChunks.size() &&
+                                changedChunks[changedChunkIndex]->getRange().overlaps(
+                                    chunkVectorRange)) ||
+            (!pendingChunks->empty() &&
+             pendingChunks->back()->getRange().overlaps(chunkVectorRange));
+
+        if (!isChanged) {
+            if (pendingChunks->empty() ||
+                pendingChunks->size() + chunkVector->size() > _maxChunkVectorSize) {
+                flushPendingChunks();
+                updatedChunkMap._size += chunkVector->size();
+                updatedChunkMap._chunkVectors.push_back(chunkVector);
+            } else {
+                // Fold the chunks into the ChunkVector being built, rather than leave a small
+                // ChunkVector behind after every refresh.
+                pendingChunks->insert(
+                    pendingChunks->end(), chunkVector->begin(), chunkVector->end());
+            }
             continue;
         }
 
-        auto overlap = _chunkMap[chunkMapIndex]->getRange().overlaps(
-            changedChunks[changedChunkIndex]->getRange());
-
-        if (overlap) {
-            auto& changedChunk = changedChunks[changedChunkIndex++];
-            auto& chunkInfo = _chunkMap[chunkMapIndex];
+        for (const auto& chunkInfo : *chunkVector) {
+            while (changedChunkIndex < changedChunks.size() &&
+                   chunkInfo->getRange().overlaps(changedChunks[changedChunkIndex]->getRange())) {
+                auto& changedChunk = changedChunks[changedChunkIndex++];
 
-            auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
-            changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
+                auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
+                changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
 
-            validateChunk(changedChunk, getVersion());
-            updatedChunkMap.appendChunk(changedChunk);
-        } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+                validateChunk(changedChunk, getVersion());
+                appendChunk(changedChunk);
+            }
+            appendChunk(chunkInfo);
         }
     }
 
+    for (; changedChunkIndex < changedChunks.size(); ++changedChunkIndex) {
+        validateChunk(changedChunks[changedChunkIndex], getVersion());
+        appendChunk(changedChunks[changedChunkIndex]);
+    }
+    flushPendingChunks();
+
     return updatedChunkMap;
 }
 
@@ -254,48 +353,67 @@ BSONObj ChunkMap::toBSON() const {
     BSONObjBuilder builder;
 
     builder.append("startingVersion"_sd, getVersion().toBSON());
-    builder.append("chunkCount", static_cast<int64_t>(_chunkMap.size()));
+    builder.append("chunkCount", static_cast<int64_t>(_size));
 
     {
         BSONArrayBuilder arrayBuilder(builder.subarrayStart("chunks"_sd));
-        for (const auto& chunk : _chunkMap) {
+        forEach([&](const auto& chunk) {
             arrayBuilder.append(chunk->toString());
-        }
+            return true;
+        });
     }
 
     return builder.obj();
 }
 
-ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
-                                                                       bool isMaxInclusive) const {
+ChunkMap::ChunkPosition ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
+                                                         bool isMaxInclusive) const {
     auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
 
-    if (!isMaxInclusive) {
-        return std::lower_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
-                                });
-    } else {
-        return std::upper_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
-                                });
-    }
-}
-
-std::pair<ChunkMap::ChunkVector::const_iterator, ChunkMap::ChunkVector::const_iterator>
-ChunkMap::_overlappingBounds(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
-    const auto itMin = _findIntersectingChunk(min);
-    const auto itMax = [&]() {
-        auto it = _findIntersectingChunk(max, isMaxInclusive);
-        return it == _chunkMap.end() ? it : ++it;
+    // The first chunk is searched for among the last chunks of the ChunkVectors, and then within
+    // the ChunkVector found.
+    auto findChunk = [&](auto begin, auto end, auto getChunk) {
+        if (!isMaxInclusive) {
+            return std::lower_bound(
+                begin, end, shardKey, [&](const auto& entry, const BSONObj& shardKey) {
+                    return getChunk(entry)->getMaxKeyString() < shardKeyString;
+                });
+        } else {
+            return std::upper_bound(
+                begin, end, shardKey, [&](const BSONObj& shardKey, const auto& entry) {
+                    return shardKeyString < getChunk(entry)->getMaxKeyString();
+                });
+        }
+    };
+
+    const auto vectorIt = findChunk(_chunkVectors.begin(),
+                                    _chunkVectors.end(),
+                                    [](const auto& chunkVector) -> const auto& {
+                                        return chunkVector->back();
+                                    });
+    if (vectorIt == _chunkVectors.end())
+        return _end();
+
+    const auto& chunkVector = **vectorIt;
+    const auto chunkIt =
+        findChunk(chunkVector.begin(), chunkVector.end(), [](const auto& chunkInfo) -> const auto& {
+            return chunkInfo;
+        });
+    invariant(chunkIt != chunkVector.end());
+    return {vectorIt, chunkIt};
+}
+
+std::pair<ChunkMap::ChunkPosition, ChunkMap::ChunkPosition> ChunkMap::_overlappingBounds(
+    const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+    const auto posMin = _findIntersectingChunk(min);
+    const auto posMax = [&]() {
+        auto pos = _findIntersectingChunk(max, isMaxInclusive);
+        if (pos.first != _chunkVectors.end())
+            _advance(pos);
+        return pos;
     }();
 
-    return {itMin, itMax};
+    return {posMin, posMax};
 }
 
 ShardVersionTargetingInfo::ShardVersionTargetingInfo(const OID& epoch)
@@ -360,6 +478,26 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj
     return Chunk(*chunkInfo, _clusterTime);
 }
 
+std::vector<StatusWith<Chunk>> ChunkManager::findIntersectingChunksWithSimpleCollation(
+    const std::vector<BSONObj>& shardKeys) const {
+    auto chunkInfos = _rt->optRt->findIntersectingChunks(shardKeys);
+
+    std::vector<StatusWith<Chunk>> chunks;
+    chunks.reserve(shardKeys.size());
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        if (chunkInfos[i] && chunkInfos[i]->containsKey(shardKeys[i])) {
+            chunks.emplace_back(Chunk(*chunkInfos[i], _clusterTime));
+        } else {
+            chunks.emplace_back(ErrorCodes::ShardKeyNotFound,
+                                str::stream() << "Cannot target single shard using key "
+                                              << shardKeys[i] << " for namespace "
+                                              << _rt->optRt->nss());
+        }
+    }
+
+    return chunks;
+}
+
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
@@ -75,13 +75,29 @@ class ChunkMap {
     // Vector of chunks ordered by max key.
     using ChunkVector = std::vector<std::shared_ptr<ChunkInfo>>;
 
+    // Vector of ChunkVectors ordered by the max key of their last chunk. A ChunkVector is never
+    // modified once it is part of a ChunkMap, so createMerged() shares the ChunkVectors which no
+    // changed chunk falls into with the ChunkMap it builds, instead of copying every chunk.
+    using ChunkVectorMap = std::vector<std::shared_ptr<ChunkVector>>;
+
+    // Identifies a chunk by the ChunkVector holding it and its position within that ChunkVector.
+    // The end position is {_chunkVectors.end(), ChunkVector::const_iterator()}.
+    using ChunkPosition = std::pair<ChunkVectorMap::const_iterator, ChunkVector::const_iterator>;
+
 public:
-    explicit ChunkMap(OID epoch, size_t initialCapacity = 0) : _collectionVersion(0, 0, epoch) {
-        _chunkMap.reserve(initialCapacity);
+    /**
+     * Makes an empty map whose ChunkVectors hold at most 'routingTableCacheChunkBucketSize'
+     * chunks.
+     */
+    explicit ChunkMap(OID epoch);
+
+    ChunkMap(OID epoch, size_t maxChunkVectorSize)
+        : _collectionVersion(0, 0, epoch), _maxChunkVectorSize(maxChunkVectorSize) {
+        invariant(_maxChunkVectorSize > 0);
     }
 
     size_t size() const {
-        return _chunkMap.size();
+        return _size;
     }
 
     ChunkVersion getVersion() const {
@@ -90,10 +106,10 @@ public:
 
     template <typename Callable>
     void forEach(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
-        auto it = shardKey.isEmpty() ? _chunkMap.begin() : _findIntersectingChunk(shardKey);
+        auto pos = shardKey.isEmpty() ? _begin() : _findIntersectingChunk(shardKey);
 
-        for (; it != _chunkMap.end(); ++it) {
-            if (!handler(*it))
+        for (; pos.first != _chunkVectors.end(); _advance(pos)) {
+            if (!handler(*pos.second))
                 break;
         }
     }
@@ -103,10 +119,10 @@ public:
                                  const BSONObj& max,
                                  bool isMaxInclusive,
                                  Callable&& handler) const {
-        const auto bounds = _overlappingBounds(min, max, isMaxInclusive);
+        auto [pos, end] = _overlappingBounds(min, max, isMaxInclusive);
 
-        for (auto it = bounds.first; it != bounds.second; ++it) {
-            if (!handler(*it))
+        for (; pos != end; _advance(pos)) {
+            if (!handler(*pos.second))
                 break;
         }
     }
@@ -114,22 +130,59 @@ public:
     ShardVersionMap constructShardVersionMap() const;
     std::shared_ptr<ChunkInfo> findIntersectingChunk(const BSONObj& shardKey) const;
 
-    void appendChunk(const std::shared_ptr<ChunkInfo>& chunk);
+    /**
+     * Same as findIntersectingChunk, for each of 'shardKeys'. The keys are encoded once and looked
+     * up in key order, so that the chunks are found in a single pass over the map.
+     */
+    std::vector<std::shared_ptr<ChunkInfo>> findIntersectingChunks(
+        const std::vector<BSONObj>& shardKeys) const;
 
+    /**
+     * Returns a new map with the chunks of this one replaced by the overlapping 'changedChunks',
+     * which must be sorted by max key and not overlap each other. Only the ChunkVectors which
+     * changed chunks fall into are rebuilt; the others are shared with this map.
+     */
     ChunkMap createMerged(const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const;
 
     BSONObj toBSON() const;
 
 private:
-    ChunkVector::const_iterator _findIntersectingChunk(const BSONObj& shardKey,
-                                                       bool isMaxInclusive = true) const;
-    std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
-        const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
+    ChunkPosition _begin() const {
+        return _chunkVectors.empty() ? _end() : ChunkPosition{_chunkVectors.begin(),
+                                                              _chunkVectors.front()->begin()};
+    }
+
+    ChunkPosition _end() const {
+        return {_chunkVectors.end(), ChunkVector::const_iterator()};
+    }
 
-    ChunkVector _chunkMap;
+    void _advance(ChunkPosition& pos) const {
+        if (++pos.second != (*pos.first)->end())
+            return;
+
+        if (++pos.first == _chunkVectors.end()) {
+            pos = _end();
+        } else {
+            pos.second = (*pos.first)->begin();
+        }
+    }
+
+    ChunkPosition _findIntersectingChunk(const BSONObj& shardKey,
+                                         bool isMaxInclusive = true) const;
+    std::pair<ChunkPosition, ChunkPosition> _overlappingBounds(const BSONObj& min,
+                                                               const BSONObj& max,
+                                                               bool isMaxInclusive) const;
+
+    ChunkVectorMap _chunkVectors;
+
+    // Total number of chunks across all ChunkVectors
+    size_t _size{0};
 
     // Max version across all chunks
     ChunkVersion _collectionVersion;
+
+    // Max number of chunks in a ChunkVector built by createMerged()
+    size_t _maxChunkVectorSize;
 };
 
 /**
@@ -253,6 +306,11 @@ public:
         return _chunkMap.findIntersectingChunk(shardKey);
     }
 
+    std::vector<std::shared_ptr<ChunkInfo>> findIntersectingChunks(
+        const std::vector<BSONObj>& shardKeys) const {
+        return _chunkMap.findIntersectingChunks(shardKeys);
+    }
+
     /**
      * Returns the ids of all shards on which the collection has any chunks.
      */
@@ -566,6 +624,14 @@ public:
         return findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
     }
 
+    /**
+     * Same as findIntersectingChunkWithSimpleCollation, for a batch of shard keys. Instead of
+     * throwing, returns the ShardKeyNotFound error in place of the chunk of any key which can't be
+     * targeted.
+     */
+    std::vector<StatusWith<Chunk>> findIntersectingChunksWithSimpleCollation(
+        const std::vector<BSONObj>& shardKeys) const;
+
     /**
      * Finds the shard id of the shard that owns the chunk minKey belongs to, assuming the simple
      * collation because shard keys do not support non-simple collations.
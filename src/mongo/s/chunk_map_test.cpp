@@ -165,4 +165,119 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestMergeAcrossChunkVectors) {
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch};
+
+    auto makeChunk = [&](const BSONObj& min, const BSONObj& max, const ChunkVersion& lastmod) {
+        return std::make_shared<ChunkInfo>(
+            ChunkType{kNss, ChunkRange{min, max}, lastmod, kThisShard});
+    };
+
+    auto assertChunks = [&](const ChunkMap& chunkMap, const std::vector<BSONObj>& bounds) {
+        ASSERT_EQ(chunkMap.size(), bounds.size() - 1);
+        size_t i = 0;
+        chunkMap.forEach([&](const auto& chunkInfo) {
+            ASSERT_BSONOBJ_EQ(chunkInfo->getMin(), bounds[i]);
+            ASSERT_BSONOBJ_EQ(chunkInfo->getMax(), bounds[i + 1]);
+            auto intersectingChunk = chunkMap.findIntersectingChunk(chunkInfo->getMin());
+            ASSERT_BSONOBJ_EQ(intersectingChunk->getMin(), bounds[i]);
+            i++;
+            return true;
+        });
+        ASSERT_EQ(i, chunkMap.size());
+    };
+
+    // Each ChunkVector holds at most two chunks.
+    ChunkMap chunkMap{epoch, 2};
+    auto initialChunkMap = chunkMap.createMerged(
+        {makeChunk(getShardKeyPattern().globalMin(), BSON("a" << 0), version),
+         makeChunk(BSON("a" << 0), BSON("a" << 10), version),
+         makeChunk(BSON("a" << 10), BSON("a" << 20), version),
+         makeChunk(BSON("a" << 20), BSON("a" << 30), version),
+         makeChunk(BSON("a" << 30), getShardKeyPattern().globalMax(), version)});
+    assertChunks(initialChunkMap,
+                 {getShardKeyPattern().globalMin(),
+                  BSON("a" << 0),
+                  BSON("a" << 10),
+                  BSON("a" << 20),
+                  BSON("a" << 30),
+                  getShardKeyPattern().globalMax()});
+
+    // Split a chunk in the middle of the key space.
+    ChunkVersion splitVersion{2, 0, epoch};
+    auto splitChunkMap =
+        initialChunkMap.createMerged({makeChunk(BSON("a" << 10), BSON("a" << 15), splitVersion),
+                                      makeChunk(BSON("a" << 15), BSON("a" << 20), splitVersion)});
+    ASSERT_EQ(splitChunkMap.getVersion(), splitVersion);
+    assertChunks(splitChunkMap,
+                 {getShardKeyPattern().globalMin(),
+                  BSON("a" << 0),
+                  BSON("a" << 10),
+                  BSON("a" << 15),
+                  BSON("a" << 20),
+                  BSON("a" << 30),
+                  getShardKeyPattern().globalMax()});
+
+    int count = 0;
+    splitChunkMap.forEachOverlappingChunk(
+        BSON("a" << 5), BSON("a" << 25), true, [&](const auto& chunk) {
+            count++;
+            return true;
+        });
+    ASSERT_EQ(count, 4);
+
+    // Merge chunks which span several ChunkVectors.
+    ChunkVersion mergeVersion{3, 0, epoch};
+    auto mergedChunkMap = splitChunkMap.createMerged(
+        {makeChunk(BSON("a" << 0), BSON("a" << 30), mergeVersion)});
+    ASSERT_EQ(mergedChunkMap.getVersion(), mergeVersion);
+    assertChunks(mergedChunkMap,
+                 {getShardKeyPattern().globalMin(),
+                  BSON("a" << 0),
+                  BSON("a" << 30),
+                  getShardKeyPattern().globalMax()});
+
+    // The maps the merged ones were built from are unchanged.
+    ASSERT_EQ(splitChunkMap.size(), 6);
+    ASSERT_EQ(initialChunkMap.size(), 5);
+    ASSERT_BSONOBJ_EQ(initialChunkMap.findIntersectingChunk(BSON("a" << 15))->getMin(),
+                      BSON("a" << 10));
+}
+
+TEST_F(ChunkMapTest, TestIntersectingChunksForUnsortedKeys) {
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch};
+
+    auto makeChunk = [&](const BSONObj& min, const BSONObj& max) {
+        return std::make_shared<ChunkInfo>(
+            ChunkType{kNss, ChunkRange{min, max}, version, kThisShard});
+    };
+
+    // Each ChunkVector holds at most two chunks, so the lookups cross ChunkVector boundaries.
+    ChunkMap chunkMap = ChunkMap{epoch, 2}.createMerged(
+        {makeChunk(getShardKeyPattern().globalMin(), BSON("a" << 0)),
+         makeChunk(BSON("a" << 0), BSON("a" << 10)),
+         makeChunk(BSON("a" << 10), BSON("a" << 20)),
+         makeChunk(BSON("a" << 20), BSON("a" << 30)),
+         makeChunk(BSON("a" << 30), getShardKeyPattern().globalMax())});
+
+    std::vector<BSONObj> shardKeys{BSON("a" << 25),
+                                   BSON("a" << -5),
+                                   BSON("a" << 30),
+                                   BSON("a" << 10),
+                                   BSON("a" << 25),
+                                   BSON("a" << 9),
+                                   BSON("a" << 100)};
+    auto chunks = chunkMap.findIntersectingChunks(shardKeys);
+    ASSERT_EQ(chunks.size(), shardKeys.size());
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        ASSERT(chunks[i]);
+        ASSERT_BSONOBJ_EQ(chunks[i]->getMin(),
+                          chunkMap.findIntersectingChunk(shardKeys[i])->getMin());
+    }
+
+    ASSERT(chunkMap.findIntersectingChunks({}).empty());
+}
+
 }  // namespace mongo
\ No newline at end of file
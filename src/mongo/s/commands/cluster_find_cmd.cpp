@@ -242,6 +242,7 @@ public:
                     options.atClusterTime =
                         repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime();
                 }
+                result->reserveBytes(CursorResponse::estimateBatchBytes(batch));
                 CursorResponseBuilder firstBatch(result, options);
                 for (const auto& obj : batch) {
                     firstBatch.append(obj);
@@ -99,9 +99,16 @@ public:
         void run(OperationContext* opCtx, rpc::ReplyBuilderInterface* reply) override {
             // Counted as a getMore, not as a command.
             globalOpCounters.gotGetMore();
-            auto bob = reply->getBodyBuilder();
             auto response = uassertStatusOK(ClusterFind::runGetMore(opCtx, _request));
+            reply->reserveBytes(CursorResponse::estimateBatchBytes(response.getBatch()));
+            auto bob = reply->getBodyBuilder();
             response.addToBSON(CursorResponse::ResponseType::SubsequentResponse, &bob);
+
+            if (opCtx->isExhaust() && response.getCursorId() != 0) {
+                // Indicate that an exhaust message should be generated and the previous BSONObj
+                // command parameters should be reused as the next BSONObj command parameters.
+                reply->setNextInvocation(boost::none);
+            }
         }
 
         const GetMoreRequest _request;
@@ -62,7 +62,9 @@ public:
                "Usage:\n"
                "{flushRouterConfig: 1} flushes all databases\n"
                "{flushRouterConfig: 'db'} flushes only the given database (and its collections)\n"
-               "{flushRouterconfig: 'db.coll'} flushes only the given collection";
+               "{flushRouterconfig: 'db.coll'} flushes only the given collection\n"
+               "Adding {incremental: true} keeps the cached routing tables of the collections, "
+               "so the next access to each of them only fetches the chunks which changed since.";
     }
 
     void addRequiredPrivileges(const std::string& dbname,
@@ -84,25 +86,43 @@ public:
 
         auto const catalogCache = grid->catalogCache();
 
+        const bool incremental = cmdObj["incremental"].trueValue();
+
         const auto argumentElem = cmdObj.firstElement();
         if (argumentElem.isNumber() || argumentElem.isBoolean()) {
-            LOGV2(22761, "Routing metadata flushed for all databases");
-            catalogCache->purgeAllDatabases();
+            LOGV2(22761,
+                  "Routing metadata flushed for all databases",
+                  "incremental"_attr = incremental);
+            if (incremental) {
+                catalogCache->invalidateDatabasesForIncrementalRefresh(boost::none);
+            } else {
+                catalogCache->purgeAllDatabases();
+            }
         } else {
             const auto ns = argumentElem.checkAndGetStringData();
             if (nsIsDbOnly(ns)) {
                 LOGV2(22762,
                       "Routing metadata flushed for database {db}",
                       "Routing metadata flushed for database",
-                      "db"_attr = ns);
-                catalogCache->purgeDatabase(ns);
+                      "db"_attr = ns,
+                      "incremental"_attr = incremental);
+                if (incremental) {
+                    catalogCache->invalidateDatabasesForIncrementalRefresh(ns);
+                } else {
+                    catalogCache->purgeDatabase(ns);
+                }
             } else {
                 const NamespaceString nss(ns);
                 LOGV2(22763,
                       "Routing metadata flushed for collection {namespace}",
                       "Routing metadata flushed for collection",
-                      "namespace"_attr = nss);
-                catalogCache->invalidateCollectionEntry_LINEARIZABLE(nss);
+                      "namespace"_attr = nss,
+                      "incremental"_attr = incremental);
+                if (incremental) {
+                    catalogCache->invalidateCollectionEntryForIncrementalRefresh(nss);
+                } else {
+                    catalogCache->invalidateCollectionEntry_LINEARIZABLE(nss);
+                }
             }
         }
 
@@ -39,6 +39,7 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/kill_cursors_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/s/catalog/type_shard.h"
@@ -105,8 +106,7 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
+      _mergeQueue(MergingComparator(_params.getSort().value_or(BSONObj()))),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
@@ -311,10 +311,7 @@ bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
         return false;
     }
 
-    auto smallestRemote = _mergeQueue.top();
-    auto smallestResult = _remotes[smallestRemote].docBuffer.front();
-    auto keyWeWantToReturn =
-        extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
+    const auto& keyWeWantToReturn = _mergeQueue.top().first;
     // We should always have a minPromisedSortKey from every shard in the sorted tailable case.
     auto minPromisedSortKey = _getMinPromisedSortKey(lk);
     invariant(minPromisedSortKey);
@@ -355,7 +352,7 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
@@ -363,19 +360,18 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
         return {};
     }
 
-    size_t smallestRemote = _mergeQueue.top();
+    size_t smallestRemote = _mergeQueue.top().second;
     _mergeQueue.pop();
 
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
-    _remotes[smallestRemote].docBuffer.pop();
+    ClusterQueryResult front = _popBufferedResult(lk, smallestRemote);
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
     if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
+        _pushToMergeQueue(lk, smallestRemote);
     }
 
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
@@ -389,15 +385,14 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     return front;
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock lk) {
     size_t remotesAttempted = 0;
     while (remotesAttempted < _remotes.size()) {
         // It is illegal to call this method if there is an error received from any shard.
         invariant(_remotes[_gettingFromRemote].status.isOK());
 
         if (_remotes[_gettingFromRemote].hasNext()) {
-            ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
-            _remotes[_gettingFromRemote].docBuffer.pop();
+            ClusterQueryResult front = _popBufferedResult(lk, _gettingFromRemote);
 
             if (_tailableMode == TailableModeEnum::kTailable &&
                 !_remotes[_gettingFromRemote].hasNext()) {
@@ -420,6 +415,20 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
     return {};
 }
 
+ClusterQueryResult AsyncResultsMerger::_popBufferedResult(WithLock lk, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+    ClusterQueryResult front = remote.docBuffer.front();
+    remote.docBuffer.pop();
+    remote.bufferedBytes -= front.getResult()->objsize();
+
+    // Ask for the remote's next batch ahead of consumption, so that results from the slowest
+    // remote are already on their way by the time the merge needs them.
+    if (remote.hasNext() && _opCtx && _shouldAskForNextBatch(lk, remote)) {
+        remote.status = _askForNextBatch(lk, remoteIndex);
+    }
+    return front;
+}
+
 Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
     invariant(_opCtx, "Cannot schedule a getMore without an OperationContext");
     auto& remote = _remotes[remoteIndex];
@@ -496,7 +505,7 @@ Status AsyncResultsMerger::_scheduleGetMores(WithLock lk) {
             return remote.status;
         }
 
-        if (!remote.hasNext() && !remote.exhausted() && !remote.cbHandle.isValid()) {
+        if (_shouldAskForNextBatch(lk, remote)) {
             // If this remote is not exhausted and there is no outstanding request for it, schedule
             // work to retrieve the next batch.
             auto nextBatchStatus = _askForNextBatch(lk, i);
@@ -508,6 +517,34 @@ Status AsyncResultsMerger::_scheduleGetMores(WithLock lk) {
     return Status::OK();
 }
 
+void AsyncResultsMerger::_pushToMergeQueue(WithLock, size_t remoteIndex) {
+    const auto& front = _remotes[remoteIndex].docBuffer.front();
+    _mergeQueue.push(
+        {extractSortKey(*front.getResult(), _params.getCompareWholeSortKey()), remoteIndex});
+}
+
+bool AsyncResultsMerger::_shouldAskForNextBatch(WithLock, const RemoteCursorData& remote) {
+    if (!remote.status.isOK() || remote.exhausted() || remote.cbHandle.isValid()) {
+        return false;
+    }
+    if (!remote.hasNext()) {
+        return true;
+    }
+
+    // Batches received from tailable cursors are passed through to the client as they are, so
+    // never ask a tailable cursor for more results while some are still buffered.
+    if (_tailableMode != TailableModeEnum::kNormal ||
+        remote.bufferedBytes >= internalQueryAsyncResultsMergerPrefetchBytesPerRemote.load()) {
+        return false;
+    }
+
+    long long totalBufferedBytes = 0;
+    for (const auto& r : _remotes) {
+        totalBufferedBytes += r.bufferedBytes;
+    }
+    return totalBufferedBytes < internalQueryAsyncResultsMergerMaxBufferedBytes.load();
+}
+
 /*
  * Note: When nextEvent() is called to do retries, only the remotes with retriable errors will
  * be rescheduled because:
@@ -709,6 +746,7 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        remote.bufferedBytes = 0;
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -750,11 +788,12 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
     if (_tailableMode == TailableModeEnum::kTailable && !remote.hasNext()) {
         invariant(_remotes.size() == 1);
         _eofNext = true;
-    } else if (!remote.hasNext() && !remote.exhausted() && _lifecycleState == kAlive && _opCtx) {
+    } else if (_lifecycleState == kAlive && _opCtx && _shouldAskForNextBatch(lk, remote)) {
         // If this is normal or tailable-awaitData cursor and we still don't have anything buffered
-        // after receiving this batch, we can schedule work to retrieve the next batch right away.
-        // Be careful only to do this when '_opCtx' is non-null, since it is illegal to schedule a
-        // remote command on a user's behalf without a non-null OperationContext.
+        // after receiving this batch, or this cursor prefetches and the buffer is still below its
+        // target, we can schedule work to retrieve the next batch right away. Be careful only to
+        // do this when '_opCtx' is non-null, since it is illegal to schedule a remote command on a
+        // user's behalf without a non-null OperationContext.
         remote.status = _askForNextBatch(lk, remoteIndex);
     }
 }
@@ -763,6 +802,7 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            size_t remoteIndex,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
+    const bool wasBufferEmpty = remote.docBuffer.empty();
     _updateRemoteMetadata(lk, remoteIndex, response);
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
@@ -785,13 +825,15 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
 
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
+        remote.bufferedBytes += obj.objsize();
         ++remote.fetchedCount;
     }
 
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
-    if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+    // queue. A remote whose batch was prefetched while results were still buffered is already on
+    // it.
+    if (_params.getSort() && wasBufferEmpty && !response.getBatch().empty()) {
+        _pushToMergeQueue(lk, remoteIndex);
     }
     return true;
 }
@@ -897,13 +939,9 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 // AsyncResultsMerger::MergingComparator
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
-
-    return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
-                           extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
+bool AsyncResultsMerger::MergingComparator::operator()(const MergeQueueEntry& lhs,
+                                                       const MergeQueueEntry& rhs) const {
+    return compareSortKeys(lhs.first, rhs.first, _sort) > 0;
 }
 
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
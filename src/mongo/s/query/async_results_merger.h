@@ -306,6 +306,9 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // The total size in bytes of the documents in 'docBuffer'.
+        long long bufferedBytes = 0;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -318,24 +321,19 @@ private:
         long long fetchedCount = 0;
     };
 
+    // The sort key of the next buffered result of a remote, and the index of that remote. The sort
+    // key is extracted once, when the remote is pushed onto the merge queue, rather than on every
+    // comparison made by the queue.
+    using MergeQueueEntry = std::pair<BSONObj, size_t>;
+
     class MergingComparator {
     public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes,
-                          const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
+        MergingComparator(const BSONObj& sort) : _sort(sort) {}
 
-        bool operator()(const size_t& lhs, const size_t& rhs);
+        bool operator()(const MergeQueueEntry& lhs, const MergeQueueEntry& rhs) const;
 
     private:
-        const std::vector<RemoteCursorData>& _remotes;
-
         const BSONObj _sort;
-
-        // When '_compareWholeSortKey' is true, $sortKey is a scalar value, rather than an object.
-        // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
-        // be {$sortKey: 1}.
-        const bool _compareWholeSortKey;
     };
 
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
@@ -449,6 +447,25 @@ private:
      */
     Status _scheduleGetMores(WithLock);
 
+    /**
+     * Returns true if a getMore should be scheduled for the given remote. This is the case when
+     * its buffer is empty, or, for non-tailable cursors, when the buffer holds fewer bytes than
+     * 'internalQueryAsyncResultsMergerPrefetchBytesPerRemote' and the results buffered by this
+     * merger in total stay below 'internalQueryAsyncResultsMergerMaxBufferedBytes'.
+     */
+    bool _shouldAskForNextBatch(WithLock, const RemoteCursorData& remote);
+
+    /**
+     * Removes and returns the next buffered result of the given remote. If the cursor prefetches,
+     * schedules the remote's next batch once its buffer drains below the prefetch target.
+     */
+    ClusterQueryResult _popBufferedResult(WithLock, size_t remoteIndex);
+
+    /**
+     * Pushes the given remote, which must have a buffered result, onto the merge queue.
+     */
+    void _pushToMergeQueue(WithLock, size_t remoteIndex);
+
     /**
      * Schedules a killCursors command to be run on all remote hosts that have open cursors.
      */
@@ -484,9 +501,10 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // The top of this priority queue holds the index into '_remotes' for the remote host that has
+    // the next document to return, according to the sort order. Used only if there is a sort.
+    std::priority_queue<MergeQueueEntry, std::vector<MergeQueueEntry>, MergingComparator>
+        _mergeQueue;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
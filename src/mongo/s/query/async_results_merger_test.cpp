@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/resume_token.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/catalog/type_shard.h"
@@ -45,6 +46,7 @@
 #include "mongo/s/query/results_merger_test_fixture.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -385,6 +387,91 @@ TEST_F(AsyncResultsMergerTest, MultiShardMultipleGets) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, PrefetchesNextBatchBeforeBufferIsEmpty) {
+    internalQueryAsyncResultsMergerPrefetchBytesPerRemote.store(1024 * 1024);
+    ON_BLOCK_EXIT([] { internalQueryAsyncResultsMergerPrefetchBytesPerRemote.store(0); });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: [1]}"), fromjson("{$sortKey: [4]}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: [2]}"), fromjson("{$sortKey: [3]}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, batch2)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // Both remotes have results buffered, but fewer bytes than the prefetch target, so the ARM
+    // asks both of them for their next batch.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_OK(arm->scheduleGetMores());
+    ASSERT_TRUE(networkHasReadyRequests());
+
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [1]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [2]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [3]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: [5]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch3);
+    std::vector<BSONObj> batch4 = {fromjson("{$sortKey: [6]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch4);
+    scheduleNetworkResponses(std::move(responses));
+    ASSERT_TRUE(arm->remotesExhausted());
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [4]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [5]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [6]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, DoesNotPrefetchBeyondMaxBufferedBytes) {
+    internalQueryAsyncResultsMergerPrefetchBytesPerRemote.store(1024 * 1024);
+    internalQueryAsyncResultsMergerMaxBufferedBytes.store(1);
+    ON_BLOCK_EXIT([] {
+        internalQueryAsyncResultsMergerPrefetchBytesPerRemote.store(0);
+        internalQueryAsyncResultsMergerMaxBufferedBytes.store(100 * 1024 * 1024);
+    });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: [1]}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: [2]}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, batch2)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // The results already buffered exceed the cap, so no remote is asked for more.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_OK(arm->scheduleGetMores());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    // Once a remote's buffer is empty, it is asked for its next batch regardless of the cap.
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [1]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(arm->ready());
+    ASSERT_OK(arm->scheduleGetMores());
+    ASSERT_TRUE(networkHasReadyRequests());
+    auto cmd = GetMoreRequest::parseFromBSON("anydbname", getNthPendingRequest(0u).cmdObj);
+    ASSERT_OK(cmd.getStatus());
+    ASSERT_EQ(5, cmd.getValue().cursorid);
+
+    // Run the callback of the canceled getMore.
+    auto killFuture = arm->kill(operationContext());
+    runReadyCallbacks();
+    killFuture.wait();
+}
+
 TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
@@ -344,6 +344,37 @@ BSONObj ShardKeyPattern::extractShardKeyFromIndexKeyData(
 }
 
 BSONObj ShardKeyPattern::extractShardKeyFromDoc(const BSONObj& doc) const {
+    return _extractShardKeyFromDoc(doc, boost::none);
+}
+
+std::vector<BSONObj> ShardKeyPattern::extractShardKeysFromDocs(
+    const std::vector<BSONObj>& docs) const {
+    std::vector<BSONObj> shardKeys;
+    shardKeys.reserve(docs.size());
+    if (!isHashedPattern()) {
+        for (const auto& doc : docs) {
+            shardKeys.push_back(extractShardKeyFromDoc(doc));
+        }
+        return shardKeys;
+    }
+
+    std::vector<BSONElement> hashedFieldValues;
+    hashedFieldValues.reserve(docs.size());
+    for (const auto& doc : docs) {
+        BSONElement matchEl = extractKeyElementFromDoc(doc, _hashedField.fieldNameStringData());
+        hashedFieldValues.push_back(matchEl.eoo() ? kNullObj.firstElement() : matchEl);
+    }
+    auto hashes =
+        BSONElementHasher::hash64(hashedFieldValues, BSONElementHasher::DEFAULT_HASH_SEED);
+
+    for (size_t i = 0; i < docs.size(); ++i) {
+        shardKeys.push_back(_extractShardKeyFromDoc(docs[i], hashes[i]));
+    }
+    return shardKeys;
+}
+
+BSONObj ShardKeyPattern::_extractShardKeyFromDoc(const BSONObj& doc,
+                                                 boost::optional<long long> hashedValue) const {
     BSONObjBuilder keyBuilder;
     for (auto&& patternEl : _keyPattern.toBSON()) {
         BSONElement matchEl = extractKeyElementFromDoc(doc, patternEl.fieldNameStringData());
@@ -357,9 +388,10 @@ BSONObj ShardKeyPattern::extractShardKeyFromDoc(const BSONObj& doc) const {
         }
 
         if (isHashedPatternEl(patternEl)) {
-            keyBuilder.append(
-                patternEl.fieldName(),
-                BSONElementHasher::hash64(matchEl, BSONElementHasher::DEFAULT_HASH_SEED));
+            keyBuilder.append(patternEl.fieldName(),
+                              hashedValue ? *hashedValue
+                                          : BSONElementHasher::hash64(
+                                                matchEl, BSONElementHasher::DEFAULT_HASH_SEED));
         } else {
             // NOTE: The matched element may *not* have the same field name as the path -
             // index keys don't contain field names, for example
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <memory>
 #include <vector>
 
@@ -186,6 +187,13 @@ public:
      */
     BSONObj extractShardKeyFromDoc(const BSONObj& doc) const;
 
+    /**
+     * Returns extractShardKeyFromDoc() of each of 'docs'. For a hashed shard key, the values of
+     * the hashed field of all of the documents are hashed together, which is faster than hashing
+     * them one at a time.
+     */
+    std::vector<BSONObj> extractShardKeysFromDocs(const std::vector<BSONObj>& docs) const;
+
     /**
      * Returns the document with missing shard key values set to null.
      */
@@ -287,6 +295,13 @@ public:
     };
 
 private:
+    /**
+     * Implements extractShardKeyFromDoc(). If 'hashedValue' is set, it is used as the value of the
+     * hashed field instead of hashing the value in 'doc'.
+     */
+    BSONObj _extractShardKeyFromDoc(const BSONObj& doc,
+                                    boost::optional<long long> hashedValue) const;
+
     KeyPattern _keyPattern;
 
     // Ordered, parsed paths
@@ -301,6 +301,33 @@ TEST_F(ShardKeyPatternTest, ExtractDocShardKeyHashed) {
     ASSERT_BSONOBJ_EQ(docKey(pattern, BSON("a" << BSON_ARRAY(BSON("b" << value)))), BSONObj());
 }
 
+TEST_F(ShardKeyPatternTest, ExtractDocShardKeysMatchesExtractDocShardKey) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 11; ++i) {
+        docs.push_back(BSON("a" << BSON("b" << i << "c" << std::string(i * 10, 'x'))));
+    }
+    docs.push_back(BSON("a" << BSON("c" << 1)));
+    docs.push_back(BSON("a" << BSON("b" << BSON_ARRAY(1 << 2))));
+    docs.push_back(BSON("a" << BSON("b" << BSON("x" << 1 << "y" << BSON_ARRAY("z")))));
+    docs.push_back(BSON("a" << BSON("b" << std::string(1000, 'y'))));
+
+    for (auto&& keyPattern : {BSON("a.b"
+                                   << "hashed"),
+                              BSON("a.b"
+                                   << "hashed"
+                                   << "a.c" << 1),
+                              BSON("a.c" << 1 << "a.b"
+                                         << "hashed"),
+                              BSON("a.b" << 1)}) {
+        ShardKeyPattern pattern(keyPattern);
+        auto shardKeys = pattern.extractShardKeysFromDocs(docs);
+        ASSERT_EQ(shardKeys.size(), docs.size());
+        for (size_t i = 0; i < docs.size(); ++i) {
+            ASSERT_BSONOBJ_EQ(shardKeys[i], docKey(pattern, docs[i]));
+        }
+    }
+}
+
 TEST_F(ShardKeyPatternTest, ExtractQueryShardKeySingle) {
     //
     // Single field ShardKeyPatterns
@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <cmath>
+
 #include "mongo/client/replica_set_monitor.h"
 #include "mongo/s/sharding_task_executor_pool_controller.h"
 
@@ -218,6 +220,16 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
     // Update the target for just the pool first
     poolData.target = stats.requests + stats.active;
 
+    if (auto halfLifeMS = gParameters.demandHalfLifeMS.load(); halfLifeMS > 0) {
+        auto now = Date_t::now();
+        auto elapsedMS = durationCount<Milliseconds>(now - poolData.demandUpdated);
+        poolData.demand = std::max(
+            static_cast<double>(poolData.target),
+            poolData.demand * std::exp2(-static_cast<double>(elapsedMS) / halfLifeMS));
+        poolData.demandUpdated = now;
+        poolData.target = static_cast<size_t>(std::ceil(poolData.demand));
+    }
+
     if (poolData.target < minConns) {
         poolData.target = minConns;
     } else if (poolData.target > maxConns) {
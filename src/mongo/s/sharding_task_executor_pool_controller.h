@@ -59,6 +59,11 @@ namespace mongo {
  * When the MatchingStrategy is kMatchBusiestNode, it operates like kMatchPrimaryNode, but any pool
  * can be responsible for increasing the targetConnections of each member of its set.
  *
+ * By Little's law, the number of connections a pool needs is the rate of its requests times their
+ * latency, which is its average number of requests in progress. When demandHalfLifeMS is positive,
+ * the target of a pool follows its peak demand, decaying exponentially with that half-life, so that
+ * a pool stays sized for its recent load rather than reconnecting each time the load comes back.
+ *
  * Note that, in essence, there are three outside elements that can mutate the state of this class:
  * * The ReplicaSetChangeNotifier can notify the listener which updates the host groups
  * * The ServerParameters can update the Parameters which will used in the next update
@@ -82,6 +87,7 @@ public:
         AtomicWord<int> minConnections;
         AtomicWord<int> maxConnections;
         AtomicWord<int> maxConnecting;
+        AtomicWord<int> demandHalfLifeMS;
 
         AtomicWord<int> hostTimeoutMS;
         AtomicWord<int> pendingTimeoutMS;
@@ -177,6 +183,10 @@ private:
         // The number of connections the host should maintain
         size_t target = 0;
 
+        // The decaying peak of the number of connections the host needed, and when it was updated
+        double demand = 0;
+        Date_t demandUpdated;
+
         // This host is able to shutdown
         bool isAbleToShutdown = false;
     };
@@ -49,6 +49,7 @@
 #include "mongo/s/async_requests_sender.h"
 #include "mongo/s/cluster_commands_helpers.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/mongod_and_mongos_server_parameters_gen.h"
 #include "mongo/s/multi_statement_transaction_requests_sender.h"
 #include "mongo/s/router_transactions_metrics.h"
 #include "mongo/util/assert_util.h"
@@ -1161,6 +1162,34 @@ BSONObj TransactionRouter::Router::_commitTransaction(
         return sendCommitDirectlyToShards(opCtx, readOnlyShards);
     }
 
+    if (writeShards.size() == 1 && gEnableSingleWriteShardCommitOptimization.load()) {
+        LOGV2_DEBUG(5843230,
+                    3,
+                    "{sessionId}:{txnNumber} Committing single-write-shard transaction with "
+                    "{numReadOnlyShards} read-only shards, write shard: {writeShardId}",
+                    "Committing single-write-shard transaction",
+                    "sessionId"_attr = _sessionId().getId(),
+                    "txnNumber"_attr = o().txnNumber,
+                    "numReadOnlyShards"_attr = readOnlyShards.size(),
+                    "writeShardId"_attr = writeShards.front());
+        {
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            o(lk).commitType = CommitType::kSingleWriteShard;
+            _onStartCommit(lk, opCtx);
+        }
+
+        // The read-only participants commit first, so that the transaction is only committed on
+        // the write shard once none of its reads can fail anymore.
+        auto readOnlyShardsResponse = sendCommitDirectlyToShards(opCtx, readOnlyShards);
+
+        if (!getStatusFromCommandResult(readOnlyShardsResponse).isOK() ||
+            !getWriteConcernStatusFromCommandResult(readOnlyShardsResponse).isOK()) {
+            return readOnlyShardsResponse;
+        }
+
+        return sendCommitDirectlyToShards(opCtx, writeShards);
+    }
+
     {
         stdx::lock_guard<Client> lk(*opCtx->getClient());
         o(lk).commitType = CommitType::kTwoPhaseCommit;
@@ -41,6 +41,7 @@
 #include "mongo/db/vector_clock.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/mongod_and_mongos_server_parameters_gen.h"
 #include "mongo/s/router_transactions_metrics.h"
 #include "mongo/s/session_catalog_router.h"
 #include "mongo/s/sharding_router_test_fixture.h"
@@ -3472,6 +3473,40 @@ TEST_F(TransactionRouterMetricsTest, SlowLoggingCommitType_SingleWriteShard) {
                                           << BSONUndefined << "coordinator" << BSONUndefined))));
 }
 
+TEST_F(TransactionRouterMetricsTest, SlowLoggingCommitType_SingleWriteShardOptimizationEnabled) {
+    gEnableSingleWriteShardCommitOptimization.store(true);
+    ON_BLOCK_EXIT([] { gEnableSingleWriteShardCommitOptimization.store(false); });
+
+    beginSlowTxnWithDefaultTxnNumber();
+    txnRouter().attachTxnFieldsIfNeeded(operationContext(), shard1, {});
+    txnRouter().processParticipantResponse(operationContext(), shard1, kOkReadOnlyTrueResponse);
+    txnRouter().attachTxnFieldsIfNeeded(operationContext(), shard2, {});
+    txnRouter().processParticipantResponse(operationContext(), shard2, kOkReadOnlyFalseResponse);
+
+    startCapturingLogMessages();
+    auto future = launchAsync(
+        [&] { txnRouter().commitTransaction(operationContext(), kDummyRecoveryToken); });
+
+    // The read-only participant commits before the write shard.
+    for (const auto& hostAndPort : {hostAndPort1, hostAndPort2}) {
+        onCommand([&](const RemoteCommandRequest& request) {
+            ASSERT_EQ(hostAndPort, request.target);
+            ASSERT_EQ("commitTransaction", request.cmdObj.firstElement().fieldNameStringData());
+            return BSON("ok" << 1);
+        });
+    }
+    future.default_timed_get();
+    stopCapturingLogMessages();
+
+    ASSERT_EQUALS(1,
+                  countBSONFormatLogLinesIsSubset(
+                      BSON("attr" << BSON("commitType"
+                                          << "singleWriteShard"
+                                          << "numParticipants" << 2 << "commitDurationMicros"
+                                          << BSONUndefined))));
+    ASSERT_EQUALS(0, countTextFormatLogLinesContaining("coordinator:"));
+}
+
 TEST_F(TransactionRouterMetricsTest, SlowLoggingCommitType_ReadOnly) {
     beginSlowTxnWithDefaultTxnNumber();
     runReadOnlyCommit();
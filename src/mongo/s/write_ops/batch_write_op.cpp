@@ -301,6 +301,29 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // The documents of an unordered insert batch are targeted all at once, which lets the targeter
+    // locate their chunks in one pass over the routing table. An ordered batch stops at the first
+    // write which goes to a different shard, so its writes are still targeted one at a time.
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> insertEndpoints;
+    if (_clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert && !ordered) {
+        std::vector<size_t> readyOps;
+        std::vector<BSONObj> docs;
+        for (size_t i = 0; i < numWriteOps; ++i) {
+            if (_writeOps[i].getWriteState() == WriteOpState_Ready) {
+                readyOps.push_back(i);
+                docs.push_back(_writeOps[i].getWriteItem().getDocument());
+            }
+        }
+
+        if (docs.size() > 1) {
+            auto endpoints = targeter.targetInserts(_opCtx, docs);
+            insertEndpoints.resize(numWriteOps);
+            for (size_t i = 0; i < readyOps.size(); ++i) {
+                insertEndpoints[readyOps[i]] = std::move(endpoints[i]);
+            }
+        }
+    }
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -318,7 +341,12 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
         Status targetStatus = Status::OK();
         try {
-            writeOp.targetWrites(_opCtx, targeter, &writes);
+            if (!insertEndpoints.empty()) {
+                writeOp.targetInsert(
+                    _opCtx, uassertStatusOK(std::move(*insertEndpoints[i])), &writes);
+            } else {
+                writeOp.targetWrites(_opCtx, targeter, &writes);
+            }
         } catch (const DBException& ex) {
             targetStatus = ex.toStatus();
         }
@@ -383,6 +383,52 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
     return ShardEndpoint(_cm->dbPrimary(), ChunkVersion::UNSHARDED(), _cm->dbVersion());
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    std::vector<StatusWith<ShardEndpoint>> endpoints;
+    endpoints.reserve(docs.size());
+
+    if (!_cm->isSharded()) {
+        for (size_t i = 0; i < docs.size(); ++i) {
+            endpoints.emplace_back(
+                ShardEndpoint(_cm->dbPrimary(), ChunkVersion::UNSHARDED(), _cm->dbVersion()));
+        }
+        return endpoints;
+    }
+
+    // Extract the shard keys of all the documents first, so that their chunks can be located in a
+    // single pass over the routing table.
+    auto shardKeys = _cm->getShardKeyPattern().extractShardKeysFromDocs(docs);
+
+    // See targetInsert() for why an empty key is an error.
+    std::vector<BSONObj> validShardKeys;
+    validShardKeys.reserve(shardKeys.size());
+    std::copy_if(shardKeys.begin(),
+                 shardKeys.end(),
+                 std::back_inserter(validShardKeys),
+                 [](const BSONObj& shardKey) { return !shardKey.isEmpty(); });
+    auto chunks = _cm->findIntersectingChunksWithSimpleCollation(validShardKeys);
+
+    auto chunkIt = chunks.begin();
+    for (const auto& shardKey : shardKeys) {
+        if (shardKey.isEmpty()) {
+            endpoints.emplace_back(ErrorCodes::ShardKeyNotFound,
+                                   "Shard key cannot contain array values or array descendants.");
+            continue;
+        }
+
+        auto& swChunk = *chunkIt++;
+        if (!swChunk.isOK()) {
+            endpoints.emplace_back(swChunk.getStatus());
+            continue;
+        }
+        const auto& shardId = swChunk.getValue().getShardId();
+        endpoints.emplace_back(ShardEndpoint(shardId, _cm->getVersion(shardId)));
+    }
+
+    return endpoints;
+}
+
 std::vector<ShardEndpoint> ChunkManagerTargeter::targetUpdate(OperationContext* opCtx,
                                                               const BatchItemRef& itemRef) const {
     // If the update is replacement-style:
@@ -185,6 +185,37 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertsWithConstantHashedPrefixAndVarying
     ASSERT_EQUALS(res.shardName, "1");
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsInBatchMatchesTargetInsert) {
+    std::vector<BSONObj> splitPoints = {
+        BSON("a.b" << BSONNULL), BSON("a.b" << -100), BSON("a.b" << 0), BSON("a.b" << 100)};
+    auto cmTargeter = prepare(BSON("a.b" << 1 << "c.d"
+                                         << "hashed"),
+                              splitPoints);
+
+    std::vector<BSONObj> docs{fromjson("{a: {b: 1000}, c: null, d: {}}"),
+                              fromjson("{a: {b: -111}, c: {d: '1'}}"),
+                              fromjson("{a: [1,2]}"),
+                              BSONObj(),
+                              fromjson("{a: {b: 0}, c: {d: 4}}"),
+                              fromjson("{a: {b: -10}}"),
+                              fromjson("{c: {d: [1,2]}}"),
+                              fromjson("{a: {b: -111}}")};
+    auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQ(endpoints.size(), docs.size());
+
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (i == 2 || i == 6) {
+            // Arrays along shard key path are not allowed.
+            ASSERT_EQ(endpoints[i].getStatus(), ErrorCodes::ShardKeyNotFound);
+            continue;
+        }
+        auto expected = cmTargeter.targetInsert(operationContext(), docs[i]);
+        ASSERT_OK(endpoints[i].getStatus());
+        ASSERT_EQUALS(endpoints[i].getValue().shardName, expected.shardName);
+        ASSERT_EQUALS(endpoints[i].getValue().shardVersion, expected.shardVersion);
+    }
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetUpdateWithRangePrefixHashedShardKey) {
     // Create 5 chunks and 5 shards such that shardId '0' has chunk [MinKey, null), '1' has chunk
     // [null, -100), '2' has chunk [-100, 0), '3' has chunk ['0', 100) and '4' has chunk
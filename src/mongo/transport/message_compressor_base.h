@@ -33,6 +33,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/base/string_data.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
 
 #include <type_traits>
 
@@ -117,6 +118,46 @@ public:
         return _decompressBytesOut.loadRelaxed();
     }
 
+    /*
+     * This returns the number of messages compressed by compressData
+     */
+    int64_t getCompressorMessages() const {
+        return _compressMessages.loadRelaxed();
+    }
+
+    /*
+     * This returns the number of messages decompressed by decompressData
+     */
+    int64_t getDecompressorMessages() const {
+        return _decompressMessages.loadRelaxed();
+    }
+
+    /*
+     * This returns the time spent in compressData
+     */
+    Microseconds getCompressorTime() const {
+        return Microseconds{_compressMicros.loadRelaxed()};
+    }
+
+    /*
+     * This returns the time spent in decompressData
+     */
+    Microseconds getDecompressorTime() const {
+        return Microseconds{_decompressMicros.loadRelaxed()};
+    }
+
+    /*
+     * Called by the MessageCompressorManager to account for the time spent in compressData and
+     * decompressData respectively
+     */
+    void counterHitCompressTime(Microseconds elapsed) {
+        _compressMicros.addAndFetch(durationCount<Microseconds>(elapsed));
+    }
+
+    void counterHitDecompressTime(Microseconds elapsed) {
+        _decompressMicros.addAndFetch(durationCount<Microseconds>(elapsed));
+    }
+
 
 protected:
     /*
@@ -130,6 +171,7 @@ protected:
      * Called by sub-classes to bump their bytesIn/bytesOut counters for compression
      */
     void counterHitCompress(int64_t bytesIn, int64_t bytesOut) {
+        _compressMessages.addAndFetch(1);
         _compressBytesIn.addAndFetch(bytesIn);
         _compressBytesOut.addAndFetch(bytesOut);
     }
@@ -138,6 +180,7 @@ protected:
      * Called by sub-classes to bump their bytesIn/bytesOut counters for decompression
      */
     void counterHitDecompress(int64_t bytesIn, int64_t bytesOut) {
+        _decompressMessages.addAndFetch(1);
         _decompressBytesIn.addAndFetch(bytesIn);
         _decompressBytesOut.addAndFetch(bytesOut);
     }
@@ -146,10 +189,14 @@ private:
     const MessageCompressorId _id;
     const std::string _name;
 
+    AtomicWord<long long> _compressMessages;
     AtomicWord<long long> _compressBytesIn;
     AtomicWord<long long> _compressBytesOut;
+    AtomicWord<long long> _compressMicros;
 
+    AtomicWord<long long> _decompressMessages;
     AtomicWord<long long> _decompressBytesIn;
     AtomicWord<long long> _decompressBytesOut;
+    AtomicWord<long long> _decompressMicros;
 };
 }  // namespace mongo
@@ -130,6 +130,10 @@ void checkFidelity(const Message& msg, std::unique_ptr<MessageCompressorBase> co
     ASSERT_EQ(decompressedMsgView.getLen(), originalView.getLen());
 
     ASSERT_EQ(memcmp(decompressedMsgView.data(), originalView.data(), originalView.dataLen()), 0);
+
+    auto registered = registry.getCompressor(compressorName);
+    ASSERT_EQ(registered->getCompressorMessages(), 1);
+    ASSERT_EQ(registered->getDecompressorMessages(), 1);
 }
 
 void checkOverflow(std::unique_ptr<MessageCompressorBase> compressor) {
@@ -252,6 +256,12 @@ TEST(ZstdMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, FidelityAfterOverflow) {
+    // The zstd contexts of this thread outlive the failed calls and must still round trip.
+    checkOverflow(std::make_unique<ZstdMessageCompressor>());
+    checkFidelity(buildMessage(), std::make_unique<ZstdMessageCompressor>());
+}
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
@@ -38,6 +38,24 @@
 #include "mongo/transport/message_compressor_zstd.h"
 
 namespace mongo {
+namespace {
+struct ZstdCCtxDeleter {
+    void operator()(ZSTD_CCtx* ctx) const {
+        ZSTD_freeCCtx(ctx);
+    }
+};
+
+struct ZstdDCtxDeleter {
+    void operator()(ZSTD_DCtx* ctx) const {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+// The compressor is shared by every session, so each thread keeps the zstd contexts it compresses
+// and decompresses with, instead of having zstd allocate and initialize fresh ones per message.
+thread_local std::unique_ptr<ZSTD_CCtx, ZstdCCtxDeleter> compressionContext;
+thread_local std::unique_ptr<ZSTD_DCtx, ZstdDCtxDeleter> decompressionContext;
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +65,19 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    if (!compressionContext) {
+        compressionContext.reset(ZSTD_createCCtx());
+        if (!compressionContext) {
+            return Status{ErrorCodes::ExceededMemoryLimit, "Could not create zstd context"};
+        }
+    }
+
+    size_t ret = ZSTD_compressCCtx(compressionContext.get(),
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   ZSTD_CLEVEL_DEFAULT);
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +89,18 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    if (!decompressionContext) {
+        decompressionContext.reset(ZSTD_createDCtx());
+        if (!decompressionContext) {
+            return Status{ErrorCodes::ExceededMemoryLimit, "Could not create zstd context"};
+        }
+    }
+
+    size_t ret = ZSTD_decompressDCtx(decompressionContext.get(),
+                                     const_cast<char*>(output.data()),
+                                     output.length(),
+                                     input.data(),
+                                     input.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -37,6 +37,7 @@
 #include "mongo/transport/session.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/thread_safety_context.h"
 
 namespace mongo {
@@ -48,6 +49,8 @@ MONGO_FAIL_POINT_DEFINE(hangBeforeServiceExecutorFixedLastExecutorThreadReturns)
 namespace transport {
 namespace {
 constexpr auto kThreadsRunning = "threadsRunning"_sd;
+constexpr auto kTasksQueued = "tasksQueued"_sd;
+constexpr auto kTasksStolen = "tasksStolen"_sd;
 constexpr auto kExecutorLabel = "executor"_sd;
 constexpr auto kExecutorName = "fixed"_sd;
 
@@ -56,13 +59,24 @@ const auto getServiceExecutorFixed =
 
 const auto serviceExecutorFixedRegisterer = ServiceContext::ConstructorActionRegisterer{
     "ServiceExecutorFixed", [](ServiceContext* ctx) {
-        getServiceExecutorFixed(ctx) =
-            std::make_unique<ServiceExecutorFixed>(ThreadPool::Options{});
+        ThreadPool::Options options;
+        options.maxThreads = ThreadPool::Options::kUnlimited;
+        getServiceExecutorFixed(ctx) = std::make_unique<ServiceExecutorFixed>(std::move(options));
     }};
 }  // namespace
 
 ServiceExecutorFixed::ServiceExecutorFixed(ThreadPool::Options options)
     : _options(std::move(options)) {
+    // Every executor thread runs the tasks of its own run queue for as long as the executor runs,
+    // so the thread pool never grows nor shrinks. An unlimited pool gets one thread per core.
+    if (_options.maxThreads == ThreadPool::Options::kUnlimited) {
+        _options.maxThreads = ProcessInfo::getNumAvailableCores();
+    }
+    _options.minThreads = _options.maxThreads;
+    for (size_t i = 0; i < _options.maxThreads; ++i) {
+        _runQueues.push_back(std::make_unique<RunQueue>());
+    }
+
     _options.onCreateThread =
         [this, onCreate = std::move(_options.onCreateThread)](const std::string& name) mutable {
             _executorContext = std::make_unique<ExecutorThreadContext>(this->weak_from_this());
@@ -91,6 +105,14 @@ Status ServiceExecutorFixed::start() {
     invariant(oldState == State::kNotStarted);
     _threadPool->startup();
     _canScheduleWork.store(true);
+    for (size_t i = 0; i < _runQueues.size(); ++i) {
+        _threadPool->schedule([this, i](Status status) {
+            if (!status.isOK()) {
+                return;
+            }
+            _runWorker(i);
+        });
+    }
     LOGV2_DEBUG(
         4910501, 3, "Started fixed thread-pool service executor", "name"_attr = _options.poolName);
     return Status::OK();
@@ -124,10 +146,21 @@ Status ServiceExecutorFixed::shutdown(Milliseconds timeout) {
 
         auto oldState = std::exchange(_state, State::kStopped);
         if (oldState != State::kStopped) {
+            _workAvailable.notify_all();
             _threadPool->shutdown();
         }
     }
 
+    // The tasks left in the run queues are dropped rather than run, releasing what they hold.
+    for (auto& runQueue : _runQueues) {
+        std::deque<Task> tasks;
+        {
+            stdx::lock_guard<Latch> lk(runQueue->mutex);
+            tasks.swap(runQueue->tasks);
+        }
+        _numQueuedTasks.subtractAndFetch(tasks.size());
+    }
+
     return waitForShutdown();
 }
 
@@ -157,20 +190,89 @@ Status ServiceExecutorFixed::scheduleTask(Task task, ScheduleFlags flags) {
 
     hangBeforeSchedulingServiceExecutorFixedTask.pauseWhileSet();
 
-    // May throw if an attempt is made to schedule after the thread pool is shutdown.
-    try {
-        _threadPool->schedule([task = std::move(task)](Status status) mutable {
-            iassert(status);
-            invariant(_executorContext);
-            _executorContext->run(std::move(task));
-        });
-    } catch (DBException& e) {
-        return e.toStatus();
+    return _enqueue(std::move(task));
+}
+
+Status ServiceExecutorFixed::_enqueue(Task task) {
+    // Tasks scheduled by an executor thread stay on it, which keeps the state of the session it
+    // serves warm in the caches of its core.
+    boost::optional<size_t> ownRunQueue;
+    if (_executorContext) {
+        ownRunQueue = _executorContext->getRunQueueIndex(this);
+    }
+    auto index = ownRunQueue ? *ownRunQueue : _nextRunQueue.fetchAndAdd(1) % _runQueues.size();
+
+    {
+        auto& runQueue = *_runQueues[index];
+        stdx::lock_guard<Latch> lk(runQueue.mutex);
+        // Checked with the run queue locked, so that "shutdown()" drains any task queued here.
+        if (!_canScheduleWork.load()) {
+            return Status(ErrorCodes::ShutdownInProgress, "Executor is not running");
+        }
+        runQueue.tasks.push_back(std::move(task));
+    }
+    _numQueuedTasks.addAndFetch(1);
+
+    // An executor thread registers as sleeping before it checks for queued tasks, and the task is
+    // counted above before checking for sleeping threads, so either the thread sees the task or it
+    // is woken up here.
+    if (_numSleepingExecutorThreads.load() > 0) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _workAvailable.notify_one();
     }
 
     return Status::OK();
 }
 
+boost::optional<ServiceExecutor::Task> ServiceExecutorFixed::_dequeue(size_t index) {
+    auto popFront = [&](RunQueue& runQueue) -> boost::optional<Task> {
+        stdx::lock_guard<Latch> lk(runQueue.mutex);
+        if (runQueue.tasks.empty()) {
+            return boost::none;
+        }
+        auto task = std::move(runQueue.tasks.front());
+        runQueue.tasks.pop_front();
+        _numQueuedTasks.subtractAndFetch(1);
+        return task;
+    };
+
+    if (auto task = popFront(*_runQueues[index])) {
+        return task;
+    }
+
+    if (_numQueuedTasks.load() == 0) {
+        return boost::none;
+    }
+
+    // Steal from the other run queues, starting with the next one so that the threads spread out.
+    for (size_t i = 1; i < _runQueues.size(); ++i) {
+        if (auto task = popFront(*_runQueues[(index + i) % _runQueues.size()])) {
+            _numStolenTasks.addAndFetch(1);
+            return task;
+        }
+    }
+
+    return boost::none;
+}
+
+void ServiceExecutorFixed::_runWorker(size_t index) {
+    invariant(_executorContext);
+    _executorContext->setRunQueue(this, index);
+
+    while (_canScheduleWork.load()) {
+        if (auto task = _dequeue(index)) {
+            _executorContext->run(std::move(*task));
+            continue;
+        }
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        _numSleepingExecutorThreads.addAndFetch(1);
+        _workAvailable.wait(
+            lk, [&] { return _state == State::kStopped || _numQueuedTasks.load() > 0; });
+        _numSleepingExecutorThreads.subtractAndFetch(1);
+    }
+}
+
 void ServiceExecutorFixed::runOnDataAvailable(Session* session,
                                               OutOfLineExecutor::Task onCompletionCallback) {
     invariant(session);
@@ -179,7 +281,9 @@ void ServiceExecutorFixed::runOnDataAvailable(Session* session,
 
 void ServiceExecutorFixed::appendStats(BSONObjBuilder* bob) const {
     *bob << kExecutorLabel << kExecutorName << kThreadsRunning
-         << static_cast<int>(_numRunningExecutorThreads.load());
+         << static_cast<int>(_numRunningExecutorThreads.load()) << kTasksQueued
+         << static_cast<long long>(_numQueuedTasks.load()) << kTasksStolen
+         << _numStolenTasks.load();
 }
 
 int ServiceExecutorFixed::getRecursionDepthForExecutorThread() const {
@@ -198,6 +302,10 @@ ServiceExecutorFixed::ExecutorThreadContext::~ExecutorThreadContext() {
     if (auto threadsRunning = _adjustRunningExecutorThreads(-1);
         threadsRunning.has_value() && threadsRunning.value() == 0) {
         hangBeforeServiceExecutorFixedLastExecutorThreadReturns.pauseWhileSet();
+        if (auto executor = _executor.lock()) {
+            stdx::lock_guard<Latch> lk(executor->_mutex);
+            executor->_shutdownCondition.notify_all();
+        }
     }
 }
 
@@ -30,7 +30,9 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 #include <memory>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/db/service_context.h"
@@ -49,6 +51,11 @@ namespace transport {
  * A service executor that uses a fixed (configurable) number of threads to execute tasks.
  * This executor always yields before executing scheduled tasks, and never yields before scheduling
  * new tasks (i.e., `ScheduleFlags::kMayYieldBeforeSchedule` is a no-op for this executor).
+ *
+ * Each executor thread has a run queue of its own. A task scheduled by an executor thread, such as
+ * the next step of the session it is serving, goes to the queue of that thread, and other tasks
+ * are spread over the queues in turn. An executor thread whose queue is empty steals the oldest
+ * task of another queue before going to sleep.
  */
 class ServiceExecutorFixed : public ServiceExecutor,
                              public std::enable_shared_from_this<ServiceExecutorFixed> {
@@ -100,6 +107,22 @@ private:
             return _recursionDepth;
         }
 
+        void setRunQueue(const ServiceExecutorFixed* executor, size_t index) {
+            _runQueueOwner = executor;
+            _runQueueIndex = index;
+        }
+
+        /**
+         * Returns the index of the run queue this thread serves for 'executor', if any. A task may
+         * schedule work on an executor other than the one running it.
+         */
+        boost::optional<size_t> getRunQueueIndex(const ServiceExecutorFixed* executor) const {
+            if (_runQueueOwner != executor) {
+                return boost::none;
+            }
+            return _runQueueIndex;
+        }
+
     private:
         boost::optional<int> _adjustRunningExecutorThreads(int adjustment) {
             if (auto executor = _executor.lock()) {
@@ -109,9 +132,35 @@ private:
         }
 
         int _recursionDepth = 0;
+        const ServiceExecutorFixed* _runQueueOwner = nullptr;
+        boost::optional<size_t> _runQueueIndex;
         std::weak_ptr<ServiceExecutorFixed> _executor;
     };
 
+    // The tasks waiting to run on one executor thread.
+    struct RunQueue {
+        Mutex mutex = MONGO_MAKE_LATCH("ServiceExecutorFixed::RunQueue::mutex");
+        std::deque<Task> tasks;
+    };
+
+    /**
+     * Adds 'task' to the run queue of the calling executor thread, or to the next run queue in
+     * turn, and wakes up an executor thread if one is sleeping.
+     */
+    Status _enqueue(Task task);
+
+    /**
+     * Returns the next task of the run queue 'index', or else a task stolen from another run
+     * queue, or nothing if all the run queues are empty.
+     */
+    boost::optional<Task> _dequeue(size_t index);
+
+    /**
+     * Runs the tasks of the run queue 'index', and those it steals, until the executor is shut
+     * down. Runs on an executor thread for as long as the executor is running.
+     */
+    void _runWorker(size_t index);
+
 private:
     AtomicWord<size_t> _numRunningExecutorThreads{0};
     AtomicWord<bool> _canScheduleWork{false};
@@ -129,6 +178,17 @@ private:
     ThreadPool::Options _options;
     std::unique_ptr<ThreadPool> _threadPool;
 
+    // One run queue per executor thread.
+    std::vector<std::unique_ptr<RunQueue>> _runQueues;
+    AtomicWord<size_t> _nextRunQueue{0};
+
+    AtomicWord<size_t> _numQueuedTasks{0};
+    AtomicWord<size_t> _numSleepingExecutorThreads{0};
+    AtomicWord<long long> _numStolenTasks{0};
+
+    // Signaled, with '_mutex' held, when tasks are queued while some executor threads sleep.
+    stdx::condition_variable _workAvailable;
+
     static inline thread_local std::unique_ptr<ExecutorThreadContext> _executorContext;
 };
 
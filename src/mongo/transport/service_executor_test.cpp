@@ -331,6 +331,30 @@ TEST_F(ServiceExecutorFixedFixture, Stats) {
     returnBarrier->countDownAndWait();
 }
 
+TEST_F(ServiceExecutorFixedFixture, IdleExecutorThreadStealsQueuedTasks) {
+    ServiceExecutorHandle executorHandle(ServiceExecutorHandle::kStartExecutor);
+    auto stolenTaskRan = std::make_shared<SharedPromise<void>>();
+    auto done = std::make_shared<SharedPromise<void>>();
+
+    // The second task is queued behind the first one, which blocks its executor thread until the
+    // second task runs. Only the other executor thread can run it, by stealing it.
+    ASSERT_OK(executorHandle->scheduleTask(
+        [executor = *executorHandle, stolenTaskRan, done]() mutable {
+            ASSERT_OK(executor->scheduleTask([stolenTaskRan] { stolenTaskRan->emplaceValue(); },
+                                             ServiceExecutor::kEmptyFlags));
+            stolenTaskRan->getFuture().get();
+            done->emplaceValue();
+        },
+        ServiceExecutor::kEmptyFlags));
+    done->getFuture().get();
+
+    BSONObjBuilder bob;
+    executorHandle->appendStats(&bob);
+    auto obj = bob.obj();
+    ASSERT_GTE(obj.getField("tasksStolen").numberLong(), 1);
+    ASSERT_EQ(obj.getField("tasksQueued").numberLong(), 0);
+}
+
 TEST_F(ServiceExecutorFixedFixture, ScheduleFailsAfterShutdown) {
     ServiceExecutorHandle executorHandle(ServiceExecutorHandle::kStartExecutor);
     std::unique_ptr<stdx::thread> schedulerThread;
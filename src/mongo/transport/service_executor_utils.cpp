@@ -38,10 +38,13 @@
 #include <memory>
 
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_gen.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/debug_util.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/thread_safety_context.h"
 
@@ -70,6 +73,14 @@ void* runFunc(void* ctx) {
 Status launchServiceWorkerThread(unique_function<void()> task) noexcept {
 
     try {
+        if (transport::gServiceExecutorBindThreadsToNumaNodes) {
+            static AtomicWord<size_t> nextNumaNode{0};
+            task = [node = nextNumaNode.fetchAndAdd(1), f = std::move(task)]() mutable {
+                ProcessInfo::bindCurrentThreadToNumaNode(node);
+                f();
+            };
+        }
+
 #if defined(_WIN32)
         stdx::thread([task = std::move(task)]() mutable { task(); }).detach();
 #else
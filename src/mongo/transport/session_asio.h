@@ -38,6 +38,7 @@
 #include "mongo/transport/baton.h"
 #include "mongo/transport/ssl_connection_context.h"
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
 #ifdef MONGO_CONFIG_SSL
@@ -181,6 +182,9 @@ public:
     }
 
     Future<void> waitForData() override {
+        if (_readAheadBegin < _readAheadEnd) {
+            return Future<void>::makeReady();
+        }
 #ifdef MONGO_CONFIG_SSL
         if (_sslSocket)
             return asio::async_read(*_sslSocket, asio::null_buffers(), UseFuture{}).ignoreValue();
@@ -235,6 +239,10 @@ public:
         if (!getSocket().is_open())
             return false;
 
+        // Data which was read ahead is data the peer sent and we haven't consumed yet.
+        if (_readAheadBegin < _readAheadEnd)
+            return true;
+
         auto swPollEvents = pollASIOSocket(getSocket(), POLLIN, Milliseconds{0});
         if (!swPollEvents.isOK()) {
             if (swPollEvents != ErrorCodes::NetworkTimeout) {
@@ -294,6 +302,9 @@ protected:
         }
 
         _sslSocket.emplace(std::move(_socket), *_sslContext->egress, removeFQDNRoot(target.host()));
+        if (_sslContext->manager) {
+            _sslContext->manager->prepareEgressConnection(_sslSocket->native_handle(), target);
+        }
         lk.unlock();
 
         auto doHandshake = [&] {
@@ -419,15 +430,16 @@ private:
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
         static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
 
-        auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
-        auto ptr = headerBuffer.get();
-        return read(asio::buffer(ptr, kHeaderSize), baton)
-            .then([headerBuffer = std::move(headerBuffer), this, baton]() mutable {
-                if (checkForHTTPRequest(asio::buffer(headerBuffer.get(), kHeaderSize))) {
+        // A session sources one message at a time, so the header is read into the session rather
+        // than into a buffer of its own.
+        static_assert(sizeof(_headerBuffer) == kHeaderSize);
+        return readBuffered(asio::buffer(_headerBuffer, kHeaderSize), baton)
+            .then([this, baton]() mutable {
+                if (checkForHTTPRequest(asio::buffer(_headerBuffer, kHeaderSize))) {
                     return sendHTTPResponse(baton);
                 }
 
-                const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
+                const auto msgLen = size_t(MSGHEADER::View(_headerBuffer).getMessageLength());
                 if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
                     StringBuilder sb;
                     sb << "recv(): message msgLen " << msgLen << " is invalid. "
@@ -448,14 +460,16 @@ private:
                     if (_isIngressSession) {
                         networkCounter.hitPhysicalIn(msgLen);
                     }
-                    return Future<Message>::makeReady(Message(std::move(headerBuffer)));
+                    auto buffer = SharedBuffer::allocate(kHeaderSize);
+                    memcpy(buffer.get(), _headerBuffer, kHeaderSize);
+                    return Future<Message>::makeReady(Message(std::move(buffer)));
                 }
 
-                auto buffer = SharedBuffer::allocate(msgLen);
-                memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
+                auto buffer = allocateMessageBuffer(msgLen);
+                memcpy(buffer.get(), _headerBuffer, kHeaderSize);
 
                 MsgData::View msgView(buffer.get());
-                return read(asio::buffer(msgView.data(), msgView.dataLen()), baton)
+                return readBuffered(asio::buffer(msgView.data(), msgView.dataLen()), baton)
                     .then([this, buffer = std::move(buffer), msgLen]() mutable {
                         if (_isIngressSession) {
                             networkCounter.hitPhysicalIn(msgLen);
@@ -465,6 +479,113 @@ private:
             });
     }
 
+    /**
+     * Returns a buffer for a message of 'msgLen' bytes. The buffer of the previous message is kept
+     * and handed out again once nothing else references it, as long as it is large enough, so that
+     * a session exchanging messages of similar sizes stops allocating a buffer for each of them.
+     */
+    SharedBuffer allocateMessageBuffer(size_t msgLen) {
+        if (_recycledMessageBuffer && !_recycledMessageBuffer.isShared() &&
+            _recycledMessageBuffer.capacity() >= msgLen) {
+            networkCounter.hitRecycledMessageBuffer();
+            return _recycledMessageBuffer;
+        }
+
+        networkCounter.hitAllocatedMessageBuffer();
+        auto buffer = SharedBuffer::allocate(msgLen);
+        if (msgLen <= static_cast<size_t>(gRecycledMessageBufferMaxSizeBytes)) {
+            _recycledMessageBuffer = buffer;
+        } else {
+            _recycledMessageBuffer = {};
+        }
+        return buffer;
+    }
+
+    /**
+     * Reads into 'buffer', starting with the bytes left over in the read-ahead buffer. If there
+     * aren't enough of them and the rest is smaller than the read-ahead buffer, as much as the
+     * socket has is received into the read-ahead buffer first. This way a small message and its
+     * header, or several pipelined messages, take a single receive rather than two per message.
+     */
+    Future<void> readBuffered(asio::mutable_buffer buffer, const BatonHandle& baton) {
+        const auto available = std::min(_readAheadEnd - _readAheadBegin, buffer.size());
+        if (available) {
+            memcpy(buffer.data(), _readAheadBuffer.get() + _readAheadBegin, available);
+            _readAheadBegin += available;
+            buffer += available;
+        }
+
+        if (buffer.size() == 0) {
+            return Future<void>::makeReady();
+        }
+
+        if (!canReadAhead() || buffer.size() >= size_t(gReadAheadBufferSizeBytes)) {
+            return read(buffer, baton);
+        }
+
+        return fillReadAheadBuffer(baton).then(
+            [this, buffer, baton] { return readBuffered(buffer, baton); });
+    }
+
+    bool canReadAhead() const {
+#ifdef MONGO_CONFIG_SSL
+        // TLS records are decrypted into the stream's own buffers, and the first bytes of an
+        // ingress session must be left for the TLS handshake detection.
+        if (_sslSocket || !_ranHandshake) {
+            return false;
+        }
+#endif
+        return gReadAheadBufferSizeBytes > 0;
+    }
+
+    /**
+     * Receives whatever the socket has, up to the size of the read-ahead buffer, which must be
+     * empty, waiting for the socket to become readable if it has nothing yet.
+     */
+    Future<void> fillReadAheadBuffer(const BatonHandle& baton) {
+        invariant(_readAheadBegin == _readAheadEnd);
+        if (!_readAheadBuffer) {
+            _readAheadBuffer = SharedBuffer::allocate(gReadAheadBufferSizeBytes);
+        }
+
+        std::error_code ec;
+        size_t size;
+        do {
+            size = _socket.read_some(
+                asio::buffer(_readAheadBuffer.get(), _readAheadBuffer.capacity()), ec);
+        } while (ec == asio::error::interrupted);  // retry syscall EINTR
+
+        if (!ec) {
+            _readAheadBegin = 0;
+            _readAheadEnd = size;
+            return Future<void>::makeReady();
+        }
+
+        if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+            (_blockingMode == Async)) {
+            if (auto networkingBaton = baton ? baton->networking() : nullptr;
+                networkingBaton && networkingBaton->canWait()) {
+                return networkingBaton->addSession(*this, NetworkingBaton::Type::In)
+                    .onError([](Status error) {
+                        // If the baton has detached, it has canceled its polling. Wait for the
+                        // socket through asio instead, as opportunisticRead() does.
+                        if (ErrorCodes::isShutdownError(error)) {
+                            return Status::OK();
+                        }
+
+                        return error;
+                    })
+                    .then([this, baton] { return fillReadAheadBuffer(baton); });
+            }
+
+            return asio::async_read(_socket, asio::null_buffers(), UseFuture{})
+                .ignoreValue()
+                .then([this, baton] { return fillReadAheadBuffer(baton); });
+        }
+
+        return futurize(ec);
+    }
+
     template <typename MutableBufferSequence>
     Future<void> read(const MutableBufferSequence& buffers, const BatonHandle& baton = nullptr) {
         // TODO SERVER-47229 Guard active ops for cancelation here.
@@ -825,6 +946,17 @@ private:
     boost::optional<Milliseconds> _socketTimeout;
 
     GenericSocket _socket;
+
+    // Bytes received from '_socket' beyond the end of the message being read, which are the
+    // beginning of the next messages. Only the bytes in [_readAheadBegin, _readAheadEnd) are left.
+    SharedBuffer _readAheadBuffer;
+    size_t _readAheadBegin = 0;
+    size_t _readAheadEnd = 0;
+
+    // The header of the message being sourced, and the buffer of the last message sourced.
+    char _headerBuffer[sizeof(MSGHEADER::Value)];
+    SharedBuffer _recycledMessageBuffer;
+
 #ifdef MONGO_CONFIG_SSL
     boost::optional<asio::ssl::stream<decltype(_socket)>> _sslSocket;
     bool _ranHandshake = false;
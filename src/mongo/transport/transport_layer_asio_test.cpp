@@ -275,16 +275,37 @@ public:
     }
 
     void sendMessage() {
+        Message msg = makeMessage(1);
+
+        std::error_code ec;
+        asio::write(_sock, asio::buffer(msg.buf(), msg.size()), ec);
+        ASSERT_FALSE(ec);
+    }
+
+    /**
+     * Sends 'count' messages with a single write, the body of the i-th one being {ping: i}.
+     */
+    void sendPipelinedMessages(int count) {
+        std::string bytes;
+        for (int i = 0; i < count; ++i) {
+            Message msg = makeMessage(i);
+            bytes.append(msg.buf(), msg.size());
+        }
+
+        std::error_code ec;
+        asio::write(_sock, asio::buffer(bytes.data(), bytes.size()), ec);
+        ASSERT_FALSE(ec);
+    }
+
+private:
+    static Message makeMessage(int ping) {
         OpMsgBuilder builder;
-        builder.setBody(BSON("ping" << 1));
+        builder.setBody(BSON("ping" << ping));
         Message msg = builder.finish();
         msg.header().setResponseToMsgId(0);
         msg.header().setId(0);
         OpMsg::appendChecksum(&msg);
-
-        std::error_code ec;
-        asio::write(_sock, asio::buffer(msg.buf(), msg.size()), ec);
-        ASSERT_FALSE(ec);
+        return msg;
     }
 
 private:
@@ -331,6 +352,48 @@ TEST(TransportLayerASIO, SourceSyncTimeoutSucceeds) {
     tla->shutdown();
 }
 
+/* check that messages received with a single read are each sourced whole and in order */
+class PipelinedMessagesSEP : public TimeoutSEP {
+public:
+    static constexpr int kNumMessages = 3;
+
+    void startSession(transport::SessionHandle session) override {
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            const char* firstMessageBuffer = nullptr;
+            for (int i = 0; i < kNumMessages; ++i) {
+                auto swMessage = session->sourceMessage();
+                ASSERT_OK(swMessage.getStatus());
+                auto opMsg = OpMsg::parse(swMessage.getValue());
+                ASSERT_EQ(i, opMsg.body["ping"].numberInt());
+
+                // Each message is released before the next one is sourced, so the messages, which
+                // all have the same size, are received into the same recycled buffer.
+                if (i == 0) {
+                    firstMessageBuffer = swMessage.getValue().buf();
+                } else {
+                    ASSERT_EQ(firstMessageBuffer, swMessage.getValue().buf());
+                }
+            }
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+};
+
+TEST(TransportLayerASIO, SourcePipelinedMessages) {
+    PipelinedMessagesSEP sep;
+    auto tla = makeAndStartTL(&sep);
+
+    // Only the header of the first message is read on its own, as the session checks whether it
+    // begins a TLS handshake. The rest is received into the read-ahead buffer.
+    TimeoutConnector connector(tla->listenerPort(), false);
+    connector.sendPipelinedMessages(PipelinedMessagesSEP::kNumMessages);
+    ASSERT_TRUE(sep.waitForTimeout());
+
+    tla->shutdown();
+}
+
 /* check that switching from timeouts to no timeouts correctly resets the timeout to unlimited */
 class TimeoutSwitchModesSEP : public TimeoutSEP {
 public:
@@ -363,7 +363,15 @@ void ThreadPool::Impl::schedule(Task task) {
     if (_numIdleThreads <= _pendingTasks.size()) {
         _lastFullUtilizationDate = Date_t::now();
     }
-    _workAvailable.notify_one();
+
+    // Only idle threads wait on _workAvailable, and a busy thread checks _pendingTasks before it
+    // goes to sleep. Signaling after unlocking spares the woken thread from blocking on _mutex
+    // right away, which the scheduling thread would otherwise still hold.
+    const bool mayHaveWaiters = _numIdleThreads > 0;
+    lk.unlock();
+    if (mayHaveWaiters) {
+        _workAvailable.notify_one();
+    }
 }
 
 void ThreadPool::Impl::waitForIdle() {
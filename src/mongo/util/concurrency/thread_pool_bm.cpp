@@ -0,0 +1,79 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Schedules empty tasks onto a thread pool of state.range(0) threads from each benchmark thread,
+ * measuring the cost of scheduling when many threads contend on the pool, like the completions of
+ * a scatter-gather read do on mongos.
+ */
+void BM_ThreadPoolSchedule(benchmark::State& state) {
+    static std::unique_ptr<ThreadPool> pool;
+    static AtomicWord<long long> tasksRun;
+
+    if (state.thread_index == 0) {
+        ThreadPool::Options options;
+        options.poolName = "ThreadPoolScheduleBenchmark";
+        options.minThreads = options.maxThreads = state.range(0);
+        pool = std::make_unique<ThreadPool>(options);
+        pool->startup();
+        tasksRun.store(0);
+    }
+
+    for (auto keepRunning : state) {
+        pool->schedule([](Status status) { tasksRun.addAndFetch(1); });
+    }
+
+    if (state.thread_index == 0) {
+        pool->waitForIdle();
+        pool->shutdown();
+        pool->join();
+        pool.reset();
+    }
+}
+
+BENCHMARK(BM_ThreadPoolSchedule)
+    ->ThreadRange(1, 2 * ProcessInfo::getNumAvailableCores())
+    ->ArgName("pool threads")
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16);
+
+}  // namespace
+}  // namespace mongo
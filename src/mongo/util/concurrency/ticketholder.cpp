@@ -35,11 +35,120 @@
 
 #include <iostream>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
+TicketHolder::TicketHolder(int num) : TicketHolder(num, LowPriorityShareTag{}) {
+    _lowPriority.reset(new TicketHolder(_lowPriorityShare(num), LowPriorityShareTag{}));
+}
+
+bool TicketHolder::tryAcquire(AdmissionPriority priority) {
+    const bool lowPriority = _lowPriority && priority == AdmissionPriority::kLow;
+    if (lowPriority && !_lowPriority->_tryAcquire()) {
+        return false;
+    }
+    if (_tryAcquire()) {
+        return true;
+    }
+    if (lowPriority) {
+        _lowPriority->_release();
+    }
+    return false;
+}
+
+void TicketHolder::waitForTicket(OperationContext* opCtx, AdmissionPriority priority) {
+    invariant(waitForTicketUntil(opCtx, Date_t::max(), priority));
+}
+
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx,
+                                      Date_t until,
+                                      AdmissionPriority priority) {
+    // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
+    if (tryAcquire(priority)) {
+        return true;
+    }
+
+    Timer timer;
+    ON_BLOCK_EXIT([&] { _recordWait(Microseconds(timer.micros())); });
+
+    const bool lowPriority = _lowPriority && priority == AdmissionPriority::kLow;
+    if (lowPriority && !_lowPriority->_waitForTicketUntil(opCtx, until)) {
+        return false;
+    }
+
+    // If the wait for the ticket itself is interrupted or times out, hand back the low priority
+    // share's ticket.
+    auto releaseLowPriorityGuard = makeGuard([&] {
+        if (lowPriority) {
+            _lowPriority->_release();
+        }
+    });
+    if (!_waitForTicketUntil(opCtx, until)) {
+        return false;
+    }
+    releaseLowPriorityGuard.dismiss();
+    return true;
+}
+
+void TicketHolder::release(AdmissionPriority priority) {
+    _release();
+    if (_lowPriority && priority == AdmissionPriority::kLow) {
+        _lowPriority->_release();
+    }
+}
+
+Status TicketHolder::resize(int newSize) {
+    auto status = _resize(newSize);
+    if (!status.isOK() || !_lowPriority) {
+        return status;
+    }
+
+    // The low priority share is resized after this holder rather than under its mutex. If more low
+    // priority tickets are in use than the new share allows, the share keeps its previous size.
+    _lowPriority->_resize(_lowPriorityShare(newSize)).ignore();
+    return status;
+}
+
+void TicketHolder::appendStats(BSONObjBuilder& b) const {
+    b.append("out", used());
+    b.append("available", available());
+    b.append("totalTickets", outof());
+    if (_lowPriority) {
+        BSONObjBuilder lowPriorityBuilder(b.subobjStart("lowPriority"));
+        lowPriorityBuilder.append("out", _lowPriority->used());
+        lowPriorityBuilder.append("totalTickets", _lowPriority->outof());
+    }
+
+    BSONObjBuilder waitsBuilder(b.subobjStart("queueWaits"));
+    waitsBuilder.append("totalWaits", _totalWaits.load());
+    waitsBuilder.append("totalWaitMicros", _totalWaitMicros.load());
+    BSONArrayBuilder histogramBuilder(waitsBuilder.subarrayStart("histogram"));
+    for (size_t i = 0; i < _waitHistogram.size(); ++i) {
+        if (auto count = _waitHistogram[i].load()) {
+            BSONObjBuilder bucketBuilder(histogramBuilder.subobjStart());
+            bucketBuilder.append("micros", kWaitHistogramLowerBoundsMicros[i]);
+            bucketBuilder.append("count", count);
+        }
+    }
+}
+
+void TicketHolder::_recordWait(Microseconds wait) {
+    _totalWaits.fetchAndAddRelaxed(1);
+    const auto waitMicros = durationCount<Microseconds>(wait);
+    _totalWaitMicros.fetchAndAddRelaxed(waitMicros);
+
+    size_t bucket = kWaitHistogramLowerBoundsMicros.size() - 1;
+    while (bucket > 0 && waitMicros < kWaitHistogramLowerBoundsMicros[bucket]) {
+        --bucket;
+    }
+    _waitHistogram[bucket].fetchAndAddRelaxed(1);
+}
+
 #if defined(__linux__)
 namespace {
 
@@ -71,7 +180,7 @@ void tsFromDate(const Date_t& deadline, struct timespec& ts) {
 }
 }  // namespace
 
-TicketHolder::TicketHolder(int num) : _outof(num) {
+TicketHolder::TicketHolder(int num, LowPriorityShareTag) : _outof(num) {
     check(sem_init(&_sem, 0, num));
 }
 
@@ -79,7 +188,7 @@ TicketHolder::~TicketHolder() {
     check(sem_destroy(&_sem));
 }
 
-bool TicketHolder::tryAcquire() {
+bool TicketHolder::_tryAcquire() {
     while (0 != sem_trywait(&_sem)) {
         if (errno == EAGAIN)
             return false;
@@ -89,11 +198,7 @@ bool TicketHolder::tryAcquire() {
     return true;
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
-}
-
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+bool TicketHolder::_waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
     if (sem_trywait(&_sem) == 0) {
         return true;
@@ -129,14 +234,15 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     return true;
 }
 
-void TicketHolder::release() {
+void TicketHolder::_release() {
     check(sem_post(&_sem));
 }
 
-Status TicketHolder::resize(int newSize) {
+Status TicketHolder::_resize(int newSize) {
     stdx::lock_guard<Latch> lk(_resizeMutex);
 
-    if (newSize < 5)
+    // The low priority share may be smaller than the minimum which can be configured.
+    if (_lowPriority && newSize < 5)
         return Status(ErrorCodes::BadValue,
                       str::stream() << "Minimum value for semaphore is 5; given " << newSize);
 
@@ -146,12 +252,12 @@ Status TicketHolder::resize(int newSize) {
                                     << "; given " << newSize);
 
     while (_outof.load() < newSize) {
-        release();
+        _release();
         _outof.fetchAndAdd(1);
     }
 
     while (_outof.load() > newSize) {
-        waitForTicket();
+        invariant(_waitForTicketUntil(nullptr, Date_t::max()));
         _outof.subtractAndFetch(1);
     }
 
@@ -175,38 +281,31 @@ int TicketHolder::outof() const {
 
 #else
 
-TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
+TicketHolder::TicketHolder(int num, LowPriorityShareTag) : _outof(num), _num(num) {}
 
 TicketHolder::~TicketHolder() = default;
 
-bool TicketHolder::tryAcquire() {
+bool TicketHolder::_tryAcquire() {
     stdx::lock_guard<Latch> lk(_mutex);
-    return _tryAcquire();
-}
-
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
-    }
+    return _tryAcquireLocked();
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+bool TicketHolder::_waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     stdx::unique_lock<Latch> lk(_mutex);
 
     if (opCtx) {
         return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
+            _newTicket, lk, until, [this] { return _tryAcquireLocked(); });
+    } else if (until == Date_t::max()) {
+        _newTicket.wait(lk, [this] { return _tryAcquireLocked(); });
+        return true;
     } else {
         return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+            lk, until.toSystemTimePoint(), [this] { return _tryAcquireLocked(); });
     }
 }
 
-void TicketHolder::release() {
+void TicketHolder::_release() {
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _num++;
@@ -214,7 +313,7 @@ void TicketHolder::release() {
     _newTicket.notify_one();
 }
 
-Status TicketHolder::resize(int newSize) {
+Status TicketHolder::_resize(int newSize) {
     stdx::lock_guard<Latch> lk(_mutex);
 
     int used = _outof.load() - _num;
@@ -248,7 +347,7 @@ int TicketHolder::outof() const {
     return _outof.load();
 }
 
-bool TicketHolder::_tryAcquire() {
+bool TicketHolder::_tryAcquireLocked() {
     if (_num <= 0) {
         if (_num < 0) {
             std::cerr << "DISASTER! in TicketHolder" << std::endl;
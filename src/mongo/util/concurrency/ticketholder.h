@@ -32,15 +32,23 @@
 #include <semaphore.h>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <memory>
+
 #include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/admission_priority.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
+
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
@@ -49,14 +57,18 @@ public:
     explicit TicketHolder(int num);
     ~TicketHolder();
 
-    bool tryAcquire();
+    bool tryAcquire(AdmissionPriority priority = AdmissionPriority::kNormal);
 
     /**
      * Attempts to acquire a ticket. Blocks until a ticket is acquired or the OperationContext
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
+     *
+     * A ticket acquired with AdmissionPriority::kLow also takes one of the low priority share,
+     * which is half of the tickets, and must be released with the same priority.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx,
+                       AdmissionPriority priority = AdmissionPriority::kNormal);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,11 +80,13 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            AdmissionPriority priority = AdmissionPriority::kNormal);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
-    void release();
+    void release(AdmissionPriority priority = AdmissionPriority::kNormal);
 
     Status resize(int newSize);
 
@@ -82,7 +96,44 @@ public:
 
     int outof() const;
 
+    /**
+     * Appends the ticket usage, including that of the low priority share, and a histogram of the
+     * time spent waiting for tickets which could not be acquired immediately.
+     */
+    void appendStats(BSONObjBuilder& b) const;
+
 private:
+    // Lower bounds, in microseconds, of the buckets of the wait time histogram.
+    static constexpr std::array<long long, 7> kWaitHistogramLowerBoundsMicros{
+        0, 100, 1000, 10 * 1000, 100 * 1000, 1000 * 1000, 10 * 1000 * 1000};
+
+    struct LowPriorityShareTag {};
+
+    /**
+     * Constructs the holder of a low priority share, which doesn't have a share of its own.
+     */
+    TicketHolder(int num, LowPriorityShareTag);
+
+    static int _lowPriorityShare(int num) {
+        return std::max(1, num / 2);
+    }
+
+    void _recordWait(Microseconds wait);
+
+    // The platform specific implementation of the ticket accounting, without priorities.
+    bool _tryAcquire();
+    bool _waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    void _release();
+    Status _resize(int newSize);
+
+    // Low priority admissions take a ticket from here before taking one from this holder. Only set
+    // on holders which aren't themselves a low priority share.
+    std::unique_ptr<TicketHolder> _lowPriority;
+
+    AtomicWord<long long> _totalWaits;
+    AtomicWord<long long> _totalWaitMicros;
+    std::array<AtomicWord<long long>, kWaitHistogramLowerBoundsMicros.size()> _waitHistogram;
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
@@ -91,7 +142,7 @@ private:
     Mutex _resizeMutex =
         MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_resizeMutex");
 #else
-    bool _tryAcquire();
+    bool _tryAcquireLocked();
 
     AtomicWord<int> _outof;
     int _num;
@@ -32,6 +32,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
 
@@ -72,4 +73,59 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+TEST(TicketholderTest, LowPriorityAdmissionsAreLimitedToHalfOfTheTickets) {
+    TicketHolder holder(10);
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT(holder.tryAcquire(AdmissionPriority::kLow));
+    }
+    ASSERT_FALSE(holder.tryAcquire(AdmissionPriority::kLow));
+    ASSERT_FALSE(holder.waitForTicketUntil(
+        nullptr, Date_t::now() + Milliseconds(1), AdmissionPriority::kLow));
+    ASSERT_EQ(holder.used(), 5);
+
+    // Normal priority admissions still have the rest of the tickets.
+    ASSERT(holder.tryAcquire());
+    ASSERT_EQ(holder.used(), 6);
+
+    holder.release(AdmissionPriority::kLow);
+    ASSERT(holder.waitForTicketUntil(nullptr, Date_t::now(), AdmissionPriority::kLow));
+    ASSERT_EQ(holder.used(), 6);
+
+    for (int i = 0; i < 5; ++i) {
+        holder.release(AdmissionPriority::kLow);
+    }
+    holder.release();
+    ASSERT_EQ(holder.used(), 0);
+}
+
+TEST(TicketholderTest, StatsReportLowPriorityShareAndQueueWaits) {
+    TicketHolder holder(2);
+
+    ASSERT(holder.tryAcquire(AdmissionPriority::kLow));
+    ASSERT(holder.tryAcquire());
+    ASSERT_FALSE(holder.waitForTicketUntil(Date_t::now() + Milliseconds(2)));
+
+    BSONObjBuilder builder;
+    holder.appendStats(builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["out"].numberInt(), 2);
+    ASSERT_EQ(stats["available"].numberInt(), 0);
+    ASSERT_EQ(stats["totalTickets"].numberInt(), 2);
+    ASSERT_EQ(stats["lowPriority"]["out"].numberInt(), 1);
+    ASSERT_EQ(stats["lowPriority"]["totalTickets"].numberInt(), 1);
+
+    // Only the wait which couldn't acquire a ticket immediately is counted.
+    auto queueWaits = stats["queueWaits"].Obj();
+    ASSERT_EQ(queueWaits["totalWaits"].numberLong(), 1);
+    ASSERT_GTE(queueWaits["totalWaitMicros"].numberLong(), 1000);
+    auto histogram = queueWaits["histogram"].Array();
+    ASSERT_EQ(histogram.size(), 1U);
+    ASSERT_GTE(histogram[0]["micros"].numberLong(), 1000);
+    ASSERT_EQ(histogram[0]["count"].numberLong(), 1);
+
+    holder.release(AdmissionPriority::kLow);
+    holder.release();
+}
 }  // namespace
@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/exec/sbe/values/row_hash_table.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/string_map.h"
 
 #include <absl/container/flat_hash_map.h>
@@ -58,6 +60,15 @@ using AbslFlatHashMapString = absl::flat_hash_map<std::string, bool>;
 using AbslNodeHashMapInt = absl::node_hash_map<uint32_t, bool>;
 using AbslNodeHashMapString = absl::node_hash_map<std::string, bool>;
 
+// Tables keyed by SBE rows, as used by the hash aggregation and hash join stages.
+using StdxUnorderedRow = stdx::unordered_map<sbe::value::MaterializedRow,
+                                             sbe::value::MaterializedRow,
+                                             sbe::value::MaterializedRowHasher>;
+using StdUnorderedMultiRow = std::unordered_multimap<sbe::value::MaterializedRow,  // NOLINT
+                                                     sbe::value::MaterializedRow,
+                                                     sbe::value::MaterializedRowHasher>;
+using SbeRowHashTable = sbe::value::RowHashTable;
+
 template <typename>
 struct IsAbslHashMap : std::false_type {};
 
@@ -236,6 +247,92 @@ void BM_Insert(benchmark::State& state) {
         state);
 }
 
+sbe::value::MaterializedRow makeRow(uint32_t i) {
+    sbe::value::MaterializedRow row{1};
+    row.reset(0, false, sbe::value::TypeTags::NumberInt64, sbe::value::bitcastFrom<int64_t>(i));
+    return row;
+}
+
+// Adapters hiding the differences between the row table interfaces.
+template <class Container>
+auto& findOrInsertGroup(Container& container, sbe::value::MaterializedRow key) {
+    return container.try_emplace(std::move(key), sbe::value::MaterializedRow{1}).first->second;
+}
+
+size_t countMatches(StdUnorderedMultiRow& container, const sbe::value::MaterializedRow& key) {
+    auto [low, high] = container.equal_range(key);
+    return std::distance(low, high);
+}
+
+size_t countMatches(SbeRowHashTable& container, const sbe::value::MaterializedRow& key) {
+    size_t count = 0;
+    for (auto it = container.find(key); it != container.end(); it = container.nextDuplicate(it)) {
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * Mimics a hash aggregation: 'state.range(0)' groups receive four input rows each, which are
+ * counted in the value of their group.
+ */
+template <class Container>
+void BM_GroupBy(benchmark::State& state) {
+    const uint32_t numGroups = state.range(0);
+    std::vector<uint32_t> input;
+    for (uint32_t i = 0; i < numGroups * 4; ++i) {
+        input.push_back(i % numGroups);
+    }
+    std::shuffle(input.begin(), input.end(), std::default_random_engine(kDefaultSeed));
+
+    for (auto _ : state) {
+        Container container;
+        for (auto key : input) {
+            auto& group = findOrInsertGroup(container, makeRow(key));
+            auto [tag, val] = group.getViewOfValue(0);
+            int64_t count =
+                tag == sbe::value::TypeTags::Nothing ? 0 : sbe::value::bitcastTo<int64_t>(val);
+            group.reset(0,
+                        false,
+                        sbe::value::TypeTags::NumberInt64,
+                        sbe::value::bitcastFrom<int64_t>(count + 1));
+        }
+        benchmark::DoNotOptimize(container.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * input.size());
+    state.counters["size"] = state.range(0);
+}
+
+/**
+ * Mimics the probe side of a hash join: a build side of 'state.range(0)' rows, with two rows per
+ * key, is probed by a mix of matching and non-matching keys.
+ */
+template <class Container>
+void BM_JoinProbe(benchmark::State& state) {
+    const uint32_t numRows = state.range(0);
+    Container container;
+    for (uint32_t i = 0; i < numRows; ++i) {
+        container.emplace(makeRow(i / 2), makeRow(i));
+    }
+
+    std::vector<sbe::value::MaterializedRow> probes;
+    UniformDistribution<kOtherSeed> gen;
+    for (uint32_t i = 0; i < numRows; ++i) {
+        probes.push_back(makeRow(gen.generate<uint32_t>() % numRows));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(countMatches(container, probes[i++]));
+        if (i == probes.size()) {
+            i = 0;
+        }
+    }
+
+    state.counters["size"] = state.range(0);
+}
+
 template <uint32_t Start = 0>
 static void Range(benchmark::internal::Benchmark* b) {
     uint32_t n0 = Start, n1 = kMaxContainerSize;
@@ -279,5 +376,16 @@ BENCHMARK_TEMPLATE(BM_Insert, StdUnorderedString)->Apply(Range<1>);
 BENCHMARK_TEMPLATE(BM_Insert, AbslFlatHashMapString)->Apply(Range<1>);
 BENCHMARK_TEMPLATE(BM_Insert, AbslNodeHashMapString)->Apply(Range<1>);
 
+// SBE row key tests
+BENCHMARK_TEMPLATE(BM_GroupBy, StdxUnorderedRow)->RangeMultiplier(10)->Range(10, kMaxContainerSize);
+BENCHMARK_TEMPLATE(BM_GroupBy, SbeRowHashTable)->RangeMultiplier(10)->Range(10, kMaxContainerSize);
+
+BENCHMARK_TEMPLATE(BM_JoinProbe, StdUnorderedMultiRow)
+    ->RangeMultiplier(10)
+    ->Range(10, kMaxContainerSize);
+BENCHMARK_TEMPLATE(BM_JoinProbe, SbeRowHashTable)
+    ->RangeMultiplier(10)
+    ->Range(10, kMaxContainerSize);
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/hyper_log_log.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+HyperLogLog::HyperLogLog(int precision)
+    : _precision(precision), _registers(size_t{1} << precision, 0) {
+    invariant(precision >= kMinPrecision && precision <= kMaxPrecision);
+}
+
+void HyperLogLog::add(uint64_t hash) {
+    // The top bits of the hash pick the register, and the number of leading zeros of the remaining
+    // bits, plus one, is the rank kept in it. The set bit below the remaining bits bounds the rank.
+    const size_t index = hash >> (64 - _precision);
+    const uint64_t rest = (hash << _precision) | (uint64_t{1} << (_precision - 1));
+    const auto rank = static_cast<uint8_t>(countLeadingZeros64(rest) + 1);
+    if (rank > _registers[index]) {
+        _registers[index] = rank;
+    }
+}
+
+void HyperLogLog::merge(const std::vector<uint8_t>& registers) {
+    invariant(registers.size() == _registers.size());
+    for (size_t i = 0; i < _registers.size(); ++i) {
+        if (registers[i] > _registers[i]) {
+            _registers[i] = registers[i];
+        }
+    }
+}
+
+long long HyperLogLog::estimate() const {
+    const double m = _registers.size();
+    double harmonicSum = 0;
+    size_t zeros = 0;
+    for (auto rank : _registers) {
+        harmonicSum += std::ldexp(1.0, -rank);
+        zeros += rank == 0;
+    }
+
+    const double alpha = 0.7213 / (1 + 1.079 / m);
+    const double rawEstimate = alpha * m * m / harmonicSum;
+
+    // Small cardinalities are estimated better by linear counting of the empty registers. With
+    // 64-bit hashes, no correction is needed for large cardinalities.
+    if (rawEstimate <= 2.5 * m && zeros > 0) {
+        return std::llround(m * std::log(m / zeros));
+    }
+    return std::llround(rawEstimate);
+}
+
+void HyperLogLog::reset() {
+    std::fill(_registers.begin(), _registers.end(), 0);
+}
+
+uint64_t HyperLogLog::mix(uint64_t x) {
+    // The finalizer of MurmurHash3.
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+}  // namespace mongo
@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace mongo {
+
+/**
+ * A HyperLogLog sketch, which estimates the number of distinct 64-bit hashes added to it using a
+ * fixed amount of memory: one byte per register, with 2**precision registers. The relative
+ * standard error of the estimate is about 1.04 / sqrt(2**precision).
+ *
+ * See Philippe Flajolet, Eric Fusy, Olivier Gandouet, Frederic Meunier. HyperLogLog: the analysis
+ * of a near-optimal cardinality estimation algorithm. 2007.
+ *
+ * Sketches with the same precision can be merged, giving the sketch of the union of their inputs.
+ */
+class HyperLogLog {
+public:
+    // 4096 registers, for a standard error of about 1.6%.
+    static constexpr int kDefaultPrecision = 12;
+    static constexpr int kMinPrecision = 4;
+    static constexpr int kMaxPrecision = 18;
+
+    explicit HyperLogLog(int precision = kDefaultPrecision);
+
+    /**
+     * Adds a hash to the sketch. The hash should be uniformly distributed over all 64-bit values.
+     */
+    void add(uint64_t hash);
+
+    /**
+     * Merges the registers of another sketch with the same precision into this one.
+     */
+    void merge(const std::vector<uint8_t>& registers);
+
+    /**
+     * Returns the estimated number of distinct hashes added to the sketch.
+     */
+    long long estimate() const;
+
+    void reset();
+
+    const std::vector<uint8_t>& registers() const {
+        return _registers;
+    }
+
+    /**
+     * Mixes the bits of 'x', so that a hash with poorly distributed bits can be added to the
+     * sketch.
+     */
+    static uint64_t mix(uint64_t x);
+
+private:
+    const int _precision;
+    std::vector<uint8_t> _registers;
+};
+
+}  // namespace mongo
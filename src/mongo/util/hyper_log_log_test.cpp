@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cmath>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/hyper_log_log.h"
+
+namespace mongo {
+namespace {
+
+void addRange(HyperLogLog& sketch, uint64_t begin, uint64_t end) {
+    for (uint64_t i = begin; i < end; ++i) {
+        sketch.add(HyperLogLog::mix(i));
+    }
+}
+
+// Asserts that 'estimate' is within 5% of 'expected', about three times the standard error of a
+// sketch with the default precision.
+void assertClose(long long expected, long long estimate) {
+    ASSERT_LTE(std::abs(estimate - expected), expected * 0.05)
+        << "expected about " << expected << " but got " << estimate;
+}
+
+TEST(HyperLogLogTest, EmptySketchEstimatesZero) {
+    HyperLogLog sketch;
+    ASSERT_EQ(0, sketch.estimate());
+}
+
+TEST(HyperLogLogTest, SmallCardinalitiesAreNearlyExact) {
+    HyperLogLog sketch;
+    addRange(sketch, 0, 1);
+    ASSERT_EQ(1, sketch.estimate());
+
+    sketch.reset();
+    addRange(sketch, 0, 10);
+    ASSERT_EQ(10, sketch.estimate());
+}
+
+TEST(HyperLogLogTest, DuplicatesAreNotCounted) {
+    HyperLogLog sketch;
+    for (int i = 0; i < 10; ++i) {
+        addRange(sketch, 0, 1000);
+    }
+    assertClose(1000, sketch.estimate());
+}
+
+TEST(HyperLogLogTest, LargeCardinalities) {
+    HyperLogLog sketch;
+    addRange(sketch, 0, 1'000'000);
+    assertClose(1'000'000, sketch.estimate());
+}
+
+TEST(HyperLogLogTest, MergeEstimatesTheUnion) {
+    HyperLogLog left;
+    HyperLogLog right;
+    addRange(left, 0, 60'000);
+    addRange(right, 40'000, 100'000);
+    left.merge(right.registers());
+    assertClose(100'000, left.estimate());
+}
+
+TEST(HyperLogLogTest, MemoryDependsOnlyOnPrecision) {
+    HyperLogLog sketch(HyperLogLog::kMinPrecision);
+    addRange(sketch, 0, 100'000);
+    ASSERT_EQ(size_t{1} << HyperLogLog::kMinPrecision, sketch.registers().size());
+}
+
+}  // namespace
+}  // namespace mongo
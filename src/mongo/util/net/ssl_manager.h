@@ -313,6 +313,12 @@ public:
                                                                 const HostAndPort& hostForLogging,
                                                                 const ExecutorPtr& reactor) = 0;
 
+    /**
+     * Prepares a new egress connection to `target` before its handshake, offering the session last
+     * negotiated with that host for resumption. No-op for SChannel and SecureTransport.
+     */
+    virtual void prepareEgressConnection(SSLConnectionType ssl, const HostAndPort& target) {}
+
     /**
      * No-op function for SChannel and SecureTransport. Attaches stapled OCSP response to the
      * SSL_CTX obect.
@@ -342,6 +342,10 @@ const OCSP_CERTID* OCSP_SINGLERESP_get0_id(const OCSP_SINGLERESP* single) {
     return single->certId;
 }
 
+inline int SSL_SESSION_up_ref(SSL_SESSION* session) {
+    return CRYPTO_add(&session->references, 1, CRYPTO_LOCK_SSL_SESSION) > 1;
+}
+
 #if OPENSSL_VERSION_NUMBER < 0x10002000L
 inline bool ASN1_TIME_diff(int*, int*, const ASN1_TIME*, const ASN1_TIME*) {
     return false;
@@ -1078,6 +1082,101 @@ struct OCSPStaplingContext {
     Date_t sharedResponseNextUpdate;
 };
 
+using UniqueSSLSession =
+    std::unique_ptr<SSL_SESSION, OpenSSLDeleter<decltype(::SSL_SESSION_free), ::SSL_SESSION_free>>;
+
+/**
+ * Remembers the most recent resumable session negotiated with each remote host, so that later
+ * egress connections to the same host can skip the full handshake. One cache is attached to each
+ * outgoing SSL_CTX, and is freed along with it.
+ */
+class TLSClientSessionCache {
+public:
+    explicit TLSClientSessionCache(size_t capacity) : _capacity(capacity) {}
+
+    /**
+     * Takes ownership of `session` as the latest session negotiated with `host`.
+     */
+    void put(const std::string& host, SSL_SESSION* session) {
+        UniqueSSLSession newSession(session);
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _sessions.find(host);
+        if (it != _sessions.end()) {
+            // Release the session we replace after dropping the lock.
+            newSession.swap(it->second);
+            return;
+        }
+        if (_sessions.size() >= _capacity) {
+            _sessions.erase(_sessions.begin());
+        }
+        _sessions.emplace(host, std::move(newSession));
+    }
+
+    /**
+     * Returns a new reference to the session last negotiated with `host`, or an empty pointer.
+     */
+    UniqueSSLSession get(const std::string& host) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _sessions.find(host);
+        if (it == _sessions.end()) {
+            return nullptr;
+        }
+        ::SSL_SESSION_up_ref(it->second.get());
+        return UniqueSSLSession(it->second.get());
+    }
+
+    static TLSClientSessionCache* fromContext(SSL_CTX* context) {
+        return static_cast<TLSClientSessionCache*>(
+            ::SSL_CTX_get_ex_data(context, contextExDataIndex()));
+    }
+
+    static void attach(SSL_CTX* context, size_t capacity) {
+        ::SSL_CTX_set_ex_data(
+            context, contextExDataIndex(), new TLSClientSessionCache(capacity));
+    }
+
+    /**
+     * Index of the SSL ex_data slot holding the cache key of a connection, a std::string owned by
+     * the SSL object.
+     */
+    static int connectionExDataIndex() {
+        static const int index = ::SSL_get_ex_new_index(
+            0, nullptr, nullptr, nullptr, [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+                delete static_cast<std::string*>(ptr);
+            });
+        return index;
+    }
+
+private:
+    static int contextExDataIndex() {
+        static const int index = ::SSL_CTX_get_ex_new_index(
+            0, nullptr, nullptr, nullptr, [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+                delete static_cast<TLSClientSessionCache*>(ptr);
+            });
+        return index;
+    }
+
+    const size_t _capacity;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("TLSClientSessionCache::_mutex");
+    stdx::unordered_map<std::string, UniqueSSLSession> _sessions;
+};
+
+/**
+ * Invoked by OpenSSL whenever an egress connection receives a new session, including TLS 1.3
+ * session tickets which arrive after the handshake has completed.
+ */
+int newClientSessionCallback(SSL* ssl, SSL_SESSION* session) {
+    auto cache = TLSClientSessionCache::fromContext(::SSL_get_SSL_CTX(ssl));
+    auto host = static_cast<std::string*>(
+        ::SSL_get_ex_data(ssl, TLSClientSessionCache::connectionExDataIndex()));
+    if (!cache || !host) {
+        return 0;
+    }
+    cache->put(*host, session);
+    return 1;
+}
+
 class SSLManagerOpenSSL;
 
 /**
@@ -1155,6 +1254,8 @@ public:
                                                         const HostAndPort& hostForLogging,
                                                         const ExecutorPtr& reactor) final;
 
+    void prepareEgressConnection(SSL* conn, const HostAndPort& target) final;
+
     /**
      * Sets the OCSP Response to be stapled to the TLS Connection. Sets the _ocspStaplingAnchor
      * object in the class.
@@ -2174,6 +2275,15 @@ Status SSLManagerOpenSSL::initSSLContext(SSL_CTX* context,
                                     << getSSLErrorMessage(ERR_get_error()));
     }
 
+    // Outgoing connections keep their sessions in a cache of our own, keyed by remote host, so
+    // that prepareEgressConnection() can offer them for resumption.
+    if (direction == ConnectionDirection::kOutgoing && gTLSClientSessionCacheSize > 0) {
+        TLSClientSessionCache::attach(context, gTLSClientSessionCacheSize);
+        ::SSL_CTX_set_session_cache_mode(context,
+                                         SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        ::SSL_CTX_sess_set_new_cb(context, newClientSessionCallback);
+    }
+
 
     if (direction == ConnectionDirection::kOutgoing &&
         !transientParams.sslClusterPEMPayload.empty()) {
@@ -2799,6 +2909,22 @@ Status _validatePeerRoles(const stdx::unordered_set<RoleName>& embeddedRoles, SS
 
 }  // namespace
 
+void SSLManagerOpenSSL::prepareEgressConnection(SSL* conn, const HostAndPort& target) {
+    auto cache = TLSClientSessionCache::fromContext(::SSL_get_SSL_CTX(conn));
+    if (!cache) {
+        return;
+    }
+
+    auto host = std::make_unique<std::string>(target.toString());
+    if (auto session = cache->get(*host)) {
+        // A session the server no longer accepts just leads to a full handshake.
+        ::SSL_set_session(conn, session.get());
+    }
+    if (::SSL_set_ex_data(conn, TLSClientSessionCache::connectionExDataIndex(), host.get())) {
+        host.release();
+    }
+}
+
 Future<SSLPeerInfo> SSLManagerOpenSSL::parseAndValidatePeerCertificate(
     SSL* conn,
     boost::optional<std::string> sni,
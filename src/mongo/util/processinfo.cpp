@@ -39,6 +39,10 @@
 #include <fstream>
 #include <iostream>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "mongo/logv2/log.h"
 
 namespace mongo {
@@ -102,4 +106,27 @@ private:
 bool writePidFile(const std::string& path) {
     return pidFileWiper.write(path);
 }
+
+bool ProcessInfo::bindCurrentThreadToNumaNode(size_t node) {
+    const auto& nodeCpus = getNumaNodeCpus();
+    if (nodeCpus.empty()) {
+        return false;
+    }
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : nodeCpus[node % nodeCpus.size()]) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (CPU_COUNT(&set) == 0) {
+        return false;
+    }
+    return sched_setaffinity(0, sizeof(cpu_set_t), &set) == 0;
+#else
+    return false;
+#endif
+}
 }  // namespace mongo
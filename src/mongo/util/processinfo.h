@@ -32,6 +32,7 @@
 #include <boost/optional.hpp>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/mutex.h"
@@ -141,6 +142,21 @@ public:
         return sysInfo().hasNuma;
     }
 
+    /**
+     * Get the CPUs of each of the host's NUMA nodes, indexed by node. Empty if the topology is
+     * unknown, which it is on platforms other than Linux.
+     */
+    static const std::vector<std::vector<unsigned>>& getNumaNodeCpus() {
+        return sysInfo().numaNodeCpus;
+    }
+
+    /**
+     * Restrict the calling thread to the CPUs of NUMA node 'node' modulo the number of nodes, so
+     * that the memory it first touches is allocated local to that node.
+     * @return false if the topology is unknown or the thread could not be bound
+     */
+    static bool bindCurrentThreadToNumaNode(size_t node);
+
     /**
      * Determine if we need to workaround slow msync performance on Illumos/Solaris
      */
@@ -207,6 +223,7 @@ private:
         unsigned long long pageSize;
         std::string cpuArch;
         bool hasNuma;
+        std::vector<std::vector<unsigned>> numaNodeCpus;
         BSONObj _extraStats;
 
         // On non-Solaris (ie, Linux, Darwin, *BSD) kernels, prefer msync.
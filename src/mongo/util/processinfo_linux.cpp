@@ -37,6 +37,7 @@
 #include <malloc.h>
 #include <pcrecpp.h>
 #include <sched.h>
+#include <sstream>
 #include <stdio.h>
 #include <sys/mman.h>
 #include <sys/resource.h>
@@ -405,6 +406,38 @@ public:
         physicalCores = cpuIds.size();
     }
 
+    /**
+     * Get the CPUs of each NUMA node, parsed from lists like "0-15,32-47" in
+     * /sys/devices/system/node/node<N>/cpulist
+     */
+    static std::vector<std::vector<unsigned>> getNumaNodeCpus() {
+        std::vector<std::vector<unsigned>> nodeCpus;
+        for (size_t node = 0;; ++node) {
+            auto path = "/sys/devices/system/node/node{}/cpulist"_format(node);
+            if (!boost::filesystem::exists(path)) {
+                break;
+            }
+
+            std::vector<unsigned> cpus;
+            std::string cpuList = readLineFromFile(path.c_str());
+            std::string range;
+            std::istringstream ranges(cpuList);
+            while (std::getline(ranges, range, ',')) {
+                unsigned first = 0;
+                unsigned last = 0;
+                int scanned = sscanf(range.c_str(), "%u-%u", &first, &last);
+                if (scanned < 1) {
+                    continue;
+                }
+                for (auto cpu = first; cpu <= (scanned == 2 ? last : first); ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+            nodeCpus.push_back(std::move(cpus));
+        }
+        return nodeCpus;
+    }
+
     /**
      * Get some details about the CPU
      */
@@ -674,6 +707,14 @@ void ProcessInfo::SystemInfo::collectSystemInfo() {
     pageSize = static_cast<unsigned long long>(sysconf(_SC_PAGESIZE));
     cpuArch = unameData.machine;
     hasNuma = checkNumaEnabled();
+    try {
+        numaNodeCpus = LinuxSysHelper::getNumaNodeCpus();
+    } catch (boost::filesystem::filesystem_error& e) {
+        LOGV2(5843227,
+              "Cannot detect the NUMA topology. Failed to probe",
+              "path"_attr = e.path1().string(),
+              "reason"_attr = e.code().message());
+    }
 
     BSONObjBuilder bExtra;
     bExtra.append("versionString", LinuxSysHelper::readLineFromFile("/proc/version"));
@@ -699,6 +740,15 @@ void ProcessInfo::SystemInfo::collectSystemInfo() {
     bExtra.append("numPages", static_cast<int>(sysconf(_SC_PHYS_PAGES)));
     bExtra.append("maxOpenFiles", static_cast<int>(sysconf(_SC_OPEN_MAX)));
     bExtra.append("physicalCores", physicalCores);
+    {
+        BSONArrayBuilder numaNodes(bExtra.subarrayStart("numaNodes"));
+        for (auto&& cpus : numaNodeCpus) {
+            BSONArrayBuilder node(numaNodes.subarrayStart());
+            for (auto cpu : cpus) {
+                node.append(static_cast<int>(cpu));
+            }
+        }
+    }
 
     appendMountInfo(bExtra);
 
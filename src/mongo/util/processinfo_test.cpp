@@ -31,8 +31,10 @@
 
 #include <boost/optional.hpp>
 #include <iostream>
+#include <set>
 #include <vector>
 
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/processinfo.h"
 
@@ -65,4 +67,33 @@ TEST(ProcessInfo, GetNumAvailableCores) {
 TEST(ProcessInfo, GetNumCoresReturnsNonZeroNumberOfProcessors) {
     ASSERT_GREATER_THAN(ProcessInfo::getNumCores(), 0u);
 }
+
+TEST(ProcessInfo, NumaNodesHaveDistinctCpus) {
+    std::set<unsigned> cpus;
+    size_t numCpus = 0;
+    for (auto&& nodeCpus : ProcessInfo::getNumaNodeCpus()) {
+        cpus.insert(nodeCpus.begin(), nodeCpus.end());
+        numCpus += nodeCpus.size();
+    }
+    ASSERT_EQ(cpus.size(), numCpus);
+}
+
+TEST(ProcessInfo, BindCurrentThreadToNumaNode) {
+    const auto& nodeCpus = ProcessInfo::getNumaNodeCpus();
+    if (nodeCpus.empty()) {
+        ASSERT_FALSE(ProcessInfo::bindCurrentThreadToNumaNode(0));
+        return;
+    }
+
+    // Bind a thread of its own, so the affinity of the test thread is left as is. The binding may
+    // be refused when the node's CPUs are outside the process' cpuset.
+    for (size_t node = 0; node < nodeCpus.size(); ++node) {
+        mongo::stdx::thread([&] {
+            if (ProcessInfo::bindCurrentThreadToNumaNode(node + nodeCpus.size())) {
+                ASSERT_LESS_THAN_OR_EQUALS(ProcessInfo::getNumAvailableCores(),
+                                           nodeCpus[node].size());
+            }
+        }).join();
+    }
+}
 }  // namespace mongo_test
@@ -31,8 +31,11 @@
 
 #include "summation.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
+#include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -45,6 +48,35 @@ void DoubleDoubleSummation::addLong(long long x) {
     addDouble(high);
 }
 
+void DoubleDoubleSummation::addInts(const int* values, size_t count) {
+    // The sum of fewer than 2**32 32-bit integers cannot overflow a 64-bit integer, so batches of
+    // at most that many values need no overflow checks.
+    constexpr size_t kMaxBatch = std::numeric_limits<uint32_t>::max();
+    while (count > 0) {
+        const size_t batch = std::min(count, kMaxBatch);
+        long long partialSum = 0;
+        for (size_t i = 0; i < batch; ++i) {
+            partialSum += values[i];
+        }
+        addLong(partialSum);
+        values += batch;
+        count -= batch;
+    }
+}
+
+void DoubleDoubleSummation::addLongs(const long long* values, size_t count) {
+    long long partialSum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        long long nextSum;
+        if (overflow::add(partialSum, values[i], &nextSum)) {
+            addLong(partialSum);
+            nextSum = values[i];
+        }
+        partialSum = nextSum;
+    }
+    addLong(partialSum);
+}
+
 /**
  * Returns whether the sum is in range of the 64-bit signed integer long long type.
  */
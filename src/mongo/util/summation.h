@@ -71,6 +71,30 @@ public:
         addDouble(x);
     }
 
+    /**
+     * Adds the 'count' values starting at 'values' to the sum, as calling addDouble() on each of
+     * them in turn would.
+     */
+    void addDoubles(const double* values, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            addDouble(values[i]);
+        }
+    }
+
+    /**
+     * Adds the 'count' values starting at 'values' to the sum. The values are first summed exactly
+     * in 64-bit integer arithmetic, which compilers vectorize, so that the compensated addition
+     * only runs once per batch rather than once per value.
+     */
+    void addInts(const int* values, size_t count);
+
+    /**
+     * Same as addInts(), for 64-bit integers. The values are summed in integer arithmetic until the
+     * partial sum would overflow, at which point it is added to the sum and a new partial sum is
+     * started.
+     */
+    void addLongs(const long long* values, size_t count);
+
     /**
      * Returns the double nearest to the accumulated sum.
      */
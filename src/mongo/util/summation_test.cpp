@@ -205,6 +205,54 @@ TEST(Summation, AddDoubles) {
     ASSERT(straightSum != sum.getDouble());
 }
 
+TEST(Summation, AddBatchesOfInts) {
+    std::vector<int> ints;
+    for (int i = 0; i < 1000; ++i) {
+        ints.push_back(i % 2 ? std::numeric_limits<int>::max() - i
+                             : std::numeric_limits<int>::min());
+    }
+
+    DoubleDoubleSummation sum;
+    DoubleDoubleSummation batchSum;
+    for (int x : ints) {
+        sum.addLong(x);
+    }
+    batchSum.addInts(ints.data(), ints.size());
+    ASSERT_EQUALS(sum.getLong(), batchSum.getLong());
+    ASSERT_EQUALS(sum.getDouble(), batchSum.getDouble());
+}
+
+TEST(Summation, AddBatchesOfLongs) {
+    // The partial sums of these values overflow in both directions.
+    std::vector<long long> longs = longValues;
+    longs.insert(longs.end(), longValues.rbegin(), longValues.rend());
+    longs.insert(longs.end(), 10, limits::max());
+    longs.insert(longs.end(), 20, limits::min());
+
+    DoubleDoubleSummation sum;
+    DoubleDoubleSummation batchSum;
+    for (long long x : longs) {
+        sum.addLong(x);
+    }
+    batchSum.addLongs(longs.data(), longs.size());
+    ASSERT_EQUALS(sum.fitsLong(), batchSum.fitsLong());
+    ASSERT_EQUALS(sum.getDecimal().toString(), batchSum.getDecimal().toString());
+
+    DoubleDoubleSummation emptySum;
+    emptySum.addLongs(nullptr, 0);
+    ASSERT_EQUALS(emptySum.getLong(), 0);
+}
+
+TEST(Summation, AddBatchesOfDoubles) {
+    DoubleDoubleSummation sum;
+    DoubleDoubleSummation batchSum;
+    for (double x : doubleValues) {
+        sum.addDouble(x);
+    }
+    batchSum.addDoubles(doubleValues.data(), doubleValues.size());
+    ASSERT_EQUALS(sum.getDouble(), batchSum.getDouble());
+}
+
 TEST(Summation, ConvertInfinityToDecimal) {
     constexpr double infinity = std::numeric_limits<double>::infinity();
     DoubleDoubleSummation sum;
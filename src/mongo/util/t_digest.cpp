@@ -0,0 +1,174 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/t_digest.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// The number of values buffered per unit of compression before the buffer is merged.
+constexpr double kBufferFactor = 5;
+
+}  // namespace
+
+TDigest::TDigest(double compression) : _compression(compression) {
+    invariant(compression > 0);
+}
+
+void TDigest::add(double value, double weight) {
+    dassert(!std::isnan(value));
+    dassert(weight > 0);
+    _buffer.push_back({value, weight});
+    _totalWeight += weight;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+    if (_buffer.size() >= kBufferFactor * _compression) {
+        _compress();
+    }
+}
+
+void TDigest::merge(const std::vector<Centroid>& centroids, double min, double max) {
+    for (auto&& centroid : centroids) {
+        _buffer.push_back(centroid);
+        _totalWeight += centroid.weight;
+        if (_buffer.size() >= kBufferFactor * _compression) {
+            _compress();
+        }
+    }
+    if (!centroids.empty()) {
+        _min = std::min(_min, min);
+        _max = std::max(_max, max);
+    }
+}
+
+void TDigest::_compress() {
+    if (_buffer.empty()) {
+        return;
+    }
+
+    std::vector<Centroid> all;
+    all.reserve(_centroids.size() + _buffer.size());
+    all.insert(all.end(), _centroids.begin(), _centroids.end());
+    all.insert(all.end(), _buffer.begin(), _buffer.end());
+    _buffer.clear();
+    std::sort(all.begin(), all.end(), [](const Centroid& lhs, const Centroid& rhs) {
+        return lhs.mean < rhs.mean;
+    });
+
+    // Uses the scale function k(q) = compression / (2 * pi) * asin(2q - 1): a centroid may grow
+    // while the k-values of its two ends differ by at most one.
+    const double kMax = _compression / 4;
+    auto weightLimit = [&](double weightSoFar) {
+        const double k = _compression / (2 * kPi) * std::asin(2 * weightSoFar / _totalWeight - 1);
+        if (k + 1 >= kMax) {
+            return _totalWeight;
+        }
+        return _totalWeight * (std::sin((k + 1) * 2 * kPi / _compression) + 1) / 2;
+    };
+
+    _centroids.clear();
+    double weightSoFar = 0;
+    double limit = weightLimit(0);
+    Centroid current = all.front();
+    for (size_t i = 1; i < all.size(); ++i) {
+        const double proposedWeight = current.weight + all[i].weight;
+        if (weightSoFar + proposedWeight <= limit) {
+            current.mean += (all[i].mean - current.mean) * all[i].weight / proposedWeight;
+            current.weight = proposedWeight;
+        } else {
+            weightSoFar += current.weight;
+            _centroids.push_back(current);
+            limit = weightLimit(weightSoFar);
+            current = all[i];
+        }
+    }
+    _centroids.push_back(current);
+}
+
+const std::vector<TDigest::Centroid>& TDigest::centroids() {
+    _compress();
+    return _centroids;
+}
+
+double TDigest::quantile(double q) {
+    invariant(!empty());
+    _compress();
+
+    // Each centroid is taken to sit at the middle of its weight, with the values interpolated
+    // linearly between neighbouring centroids, and between the outer centroids and the extremes.
+    const double index = std::max(0.0, std::min(1.0, q)) * _totalWeight;
+    if (index == 0) {
+        return _min;
+    }
+    if (index == _totalWeight) {
+        return _max;
+    }
+    if (_centroids.size() == 1) {
+        return _centroids.front().mean;
+    }
+
+    const auto& first = _centroids.front();
+    if (index < first.weight / 2) {
+        return _min + (first.mean - _min) * index / (first.weight / 2);
+    }
+
+    double midpoint = first.weight / 2;
+    for (size_t i = 0; i + 1 < _centroids.size(); ++i) {
+        const auto& left = _centroids[i];
+        const auto& right = _centroids[i + 1];
+        const double gap = (left.weight + right.weight) / 2;
+        if (index < midpoint + gap) {
+            return left.mean + (right.mean - left.mean) * (index - midpoint) / gap;
+        }
+        midpoint += gap;
+    }
+
+    const auto& last = _centroids.back();
+    const double remaining = last.weight / 2;
+    return last.mean + (_max - last.mean) * std::min(1.0, (index - midpoint) / remaining);
+}
+
+void TDigest::reset() {
+    _centroids.clear();
+    _buffer.clear();
+    _totalWeight = 0;
+    _min = std::numeric_limits<double>::infinity();
+    _max = -std::numeric_limits<double>::infinity();
+}
+
+}  // namespace mongo
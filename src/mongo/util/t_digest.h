@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace mongo {
+
+/**
+ * A merging t-digest, which estimates quantiles of a stream of numbers by summarizing it as a
+ * bounded number of weighted centroids. Centroids near the tails of the distribution are kept
+ * small, so extreme quantiles are more accurate than those near the median. The number of
+ * centroids is bounded by about 'compression' / 2.
+ *
+ * See Ted Dunning, Otmar Ertl. Computing Extremely Accurate Quantiles Using t-Digests. 2019.
+ * https://arxiv.org/abs/1902.04023
+ *
+ * Digests can be merged by adding the centroids of one to the other.
+ */
+class TDigest {
+public:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    static constexpr double kDefaultCompression = 100;
+
+    explicit TDigest(double compression = kDefaultCompression);
+
+    /**
+     * Adds 'value' with the given weight. The value must not be NaN, and the weight must be
+     * positive.
+     */
+    void add(double value, double weight = 1);
+
+    /**
+     * Adds the centroids of another digest, whose smallest and largest values were 'min' and 'max'.
+     */
+    void merge(const std::vector<Centroid>& centroids, double min, double max);
+
+    /**
+     * Returns the estimated value at quantile 'q', where 'q' is in [0, 1]. The digest must not be
+     * empty.
+     */
+    double quantile(double q);
+
+    /**
+     * Returns the centroids of the digest, ordered by mean.
+     */
+    const std::vector<Centroid>& centroids();
+
+    bool empty() const {
+        return _totalWeight == 0;
+    }
+
+    double min() const {
+        return _min;
+    }
+
+    double max() const {
+        return _max;
+    }
+
+    void reset();
+
+    /**
+     * Returns an estimate of the memory used by the digest, including its own size.
+     */
+    size_t memUsageBytes() const {
+        return sizeof(*this) + (_centroids.capacity() + _buffer.capacity()) * sizeof(Centroid);
+    }
+
+private:
+    // Merges the buffered values into the centroids.
+    void _compress();
+
+    const double _compression;
+
+    // The compressed centroids, ordered by mean.
+    std::vector<Centroid> _centroids;
+
+    // Values and centroids added since the last compression, in no particular order.
+    std::vector<Centroid> _buffer;
+
+    double _totalWeight = 0;
+    double _min = std::numeric_limits<double>::infinity();
+    double _max = -std::numeric_limits<double>::infinity();
+};
+
+}  // namespace mongo
@@ -0,0 +1,108 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/t_digest.h"
+
+namespace mongo {
+namespace {
+
+TEST(TDigestTest, SmallInputsGiveExactQuantiles) {
+    TDigest digest;
+    for (int i = 1; i <= 5; ++i) {
+        digest.add(i);
+    }
+    ASSERT_EQ(1, digest.quantile(0));
+    ASSERT_EQ(3, digest.quantile(0.5));
+    ASSERT_EQ(5, digest.quantile(1));
+}
+
+TEST(TDigestTest, SingleValue) {
+    TDigest digest;
+    digest.add(42);
+    ASSERT_EQ(42, digest.quantile(0));
+    ASSERT_EQ(42, digest.quantile(0.5));
+    ASSERT_EQ(42, digest.quantile(1));
+}
+
+TEST(TDigestTest, ExtremesAreExact) {
+    TDigest digest;
+    for (int i = 0; i < 100'000; ++i) {
+        digest.add((i * 7919) % 100'000);
+    }
+    ASSERT_EQ(0, digest.quantile(0));
+    ASSERT_EQ(99'999, digest.quantile(1));
+}
+
+TEST(TDigestTest, QuantilesOfUniformInputAreAccurate) {
+    TDigest digest;
+    for (int i = 0; i < 100'000; ++i) {
+        digest.add((i * 7919) % 100'000);
+    }
+    for (double q : {0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999}) {
+        ASSERT_APPROX_EQUAL(q * 100'000, digest.quantile(q), 100'000 * 0.005);
+    }
+}
+
+TEST(TDigestTest, NumberOfCentroidsIsBounded) {
+    TDigest digest;
+    for (int i = 0; i < 100'000; ++i) {
+        digest.add(i);
+    }
+    ASSERT_LTE(digest.centroids().size(), TDigest::kDefaultCompression);
+}
+
+TEST(TDigestTest, MergedDigestsMatchTheDigestOfTheUnion) {
+    TDigest left;
+    TDigest right;
+    for (int i = 0; i < 100'000; ++i) {
+        (i % 2 ? left : right).add((i * 7919) % 100'000);
+    }
+    left.merge(right.centroids(), right.min(), right.max());
+
+    ASSERT_EQ(0, left.quantile(0));
+    ASSERT_EQ(99'999, left.quantile(1));
+    for (double q : {0.01, 0.5, 0.99}) {
+        ASSERT_APPROX_EQUAL(q * 100'000, left.quantile(q), 100'000 * 0.005);
+    }
+}
+
+TEST(TDigestTest, ResetEmptiesTheDigest) {
+    TDigest digest;
+    digest.add(1);
+    digest.reset();
+    ASSERT_TRUE(digest.empty());
+    digest.add(2);
+    ASSERT_EQ(2, digest.quantile(0.5));
+}
+
+}  // namespace
+}  // namespace mongo